@@ -211,6 +211,21 @@ class UtilTestTest(ScriptedLoadableModuleTest):
         voxelValueVtk = volumeNode.GetImageData().GetScalarComponentAsDouble(voxelPos[0], voxelPos[1], voxelPos[2], 0)
         self.assertEqual(voxelValueVtk, voxelValueNumpy)
 
+        self.delayDisplay('Test voxel value write with modified extent')
+        modifiedExtents = []
+
+        def onImageDataModified(caller, event):
+            modifiedExtent = [0] * 6
+            caller.GetImageDataModifiedExtent(modifiedExtent)
+            modifiedExtents.append(modifiedExtent)
+
+        observerTag = volumeNode.AddObserver(slicer.vtkMRMLVolumeNode.ImageDataModifiedEvent, onImageDataModified)
+        with slicer.util.modifyArrayFromVolume(volumeNode, modifiedExtent=[120, 120, 135, 135, 89, 89]) as narray:
+            narray[voxelPos[2], voxelPos[1], voxelPos[0]] = 100
+        volumeNode.RemoveObserver(observerTag)
+        self.assertEqual(volumeNode.GetImageData().GetScalarComponentAsDouble(voxelPos[0], voxelPos[1], voxelPos[2], 0), 100)
+        self.assertEqual(modifiedExtents, [[120, 120, 135, 135, 89, 89]])
+
         self.delayDisplay('Testing slicer.util.test_arrayFromVolume passed')
 
     def test_updateVolumeFromArray(self):
@@ -0,0 +1,122 @@
+#ifndef itkPluginVoxelwiseOperations_h
+#define itkPluginVoxelwiseOperations_h
+
+// ITK includes
+#include <itkImage.h>
+#include <itkImageRegion.h>
+#include <itkMultiThreaderBase.h>
+#include <itkNumericTraits.h>
+
+// Voxelwise operations of the scalar volume arithmetic modules.
+//
+// The operations are applied directly on the pixel buffers, in a single pass
+// and in parallel. Operations are given as functors (lambdas) so that several
+// chained voxelwise operations can be fused into one functor, which the compiler
+// inlines in the loop over the buffer and can vectorize.
+// Images must have the same buffered region, see ImageGeometriesMatch().
+
+namespace itk
+{
+  //-----------------------------------------------------------------------------
+  /// Return true if the images have exactly the same grid (origin, spacing,
+  /// directions and regions), so that voxels that have the same offset in the
+  /// pixel buffers are at the same position and no interpolation is needed.
+  template <class TImage1, class TImage2>
+  bool ImageGeometriesMatch(const TImage1* image1, const TImage2* image2)
+    {
+    return image1->GetLargestPossibleRegion() == image2->GetLargestPossibleRegion()
+      && image1->GetBufferedRegion() == image1->GetLargestPossibleRegion()
+      && image2->GetBufferedRegion() == image2->GetLargestPossibleRegion()
+      && image1->GetOrigin() == image2->GetOrigin()
+      && image1->GetSpacing() == image2->GetSpacing()
+      && image1->GetDirection() == image2->GetDirection();
+    }
+
+  //-----------------------------------------------------------------------------
+  /// Clamp the value to the range of the pixel type, as the ConstrainedValue*ImageFilter filters do.
+  template <class TPixel>
+  inline TPixel ClampToPixelType(double value)
+    {
+    value = (value < static_cast<double>(NumericTraits<TPixel>::NonpositiveMin())) ?
+      static_cast<double>(NumericTraits<TPixel>::NonpositiveMin()) : value;
+    value = (value > static_cast<double>(NumericTraits<TPixel>::max())) ?
+      static_cast<double>(NumericTraits<TPixel>::max()) : value;
+    return static_cast<TPixel>(value);
+    }
+
+  //-----------------------------------------------------------------------------
+  /// Call chunkOperation(begin, end) on chunks of [0, numberOfVoxels) in parallel.
+  template <class TChunkOperation>
+  void ParallelizeVoxels(SizeValueType numberOfVoxels, TChunkOperation chunkOperation)
+    {
+    ImageRegion<1> region;
+    region.SetIndex(0, 0);
+    region.SetSize(0, numberOfVoxels);
+    MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+    threader->template ParallelizeImageRegion<1>(region,
+      [&chunkOperation](const ImageRegion<1>& chunk)
+        {
+        SizeValueType begin = static_cast<SizeValueType>(chunk.GetIndex(0));
+        chunkOperation(begin, begin + chunk.GetSize(0));
+        },
+      nullptr);
+    }
+
+  //-----------------------------------------------------------------------------
+  /// Replace each voxel of the image by operation(voxel).
+  template <class TImage, class TOperation>
+  void UnaryVoxelwiseOperationInPlace(TImage* image, TOperation operation)
+    {
+    typename TImage::PixelType* buffer = image->GetBufferPointer();
+    ParallelizeVoxels(image->GetBufferedRegion().GetNumberOfPixels(),
+      [buffer, &operation](SizeValueType begin, SizeValueType end)
+        {
+        for (SizeValueType i = begin; i < end; ++i)
+          {
+          buffer[i] = operation(buffer[i]);
+          }
+        });
+    }
+
+  //-----------------------------------------------------------------------------
+  /// Set each voxel of the output image to operation(input voxel).
+  /// The output image is allocated with the grid of the input image.
+  template <class TInputImage, class TOutputImage, class TOperation>
+  void UnaryVoxelwiseOperation(const TInputImage* input, TOutputImage* output, TOperation operation)
+    {
+    output->CopyInformation(input);
+    output->SetRegions(input->GetBufferedRegion());
+    output->Allocate();
+    const typename TInputImage::PixelType* inputBuffer = input->GetBufferPointer();
+    typename TOutputImage::PixelType* outputBuffer = output->GetBufferPointer();
+    ParallelizeVoxels(input->GetBufferedRegion().GetNumberOfPixels(),
+      [inputBuffer, outputBuffer, &operation](SizeValueType begin, SizeValueType end)
+        {
+        for (SizeValueType i = begin; i < end; ++i)
+          {
+          outputBuffer[i] = operation(inputBuffer[i]);
+          }
+        });
+    }
+
+  //-----------------------------------------------------------------------------
+  /// Replace each voxel of image1 by operation(image1 voxel, image2 voxel).
+  /// Image1 is used as output, so it must not be needed afterwards.
+  template <class TImage1, class TImage2, class TOperation>
+  void BinaryVoxelwiseOperationInPlace(TImage1* image1, const TImage2* image2, TOperation operation)
+    {
+    typename TImage1::PixelType* buffer1 = image1->GetBufferPointer();
+    const typename TImage2::PixelType* buffer2 = image2->GetBufferPointer();
+    ParallelizeVoxels(image1->GetBufferedRegion().GetNumberOfPixels(),
+      [buffer1, buffer2, &operation](SizeValueType begin, SizeValueType end)
+        {
+        for (SizeValueType i = begin; i < end; ++i)
+          {
+          buffer1[i] = operation(buffer1[i], buffer2[i]);
+          }
+        });
+    }
+
+} // end namespace itk
+
+#endif
@@ -14,6 +14,7 @@
 #include <vtkCallbackCommand.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
+#include <vtkSmartPointer.h>
 
 // VTKsys includes
 #include <vtksys/SystemTools.hxx>
@@ -22,6 +23,8 @@
 
 // STD includes
 #include <cassert>
+#include <string>
+#include <vector>
 
 #ifdef linux
 #include "unistd.h"
@@ -384,6 +387,10 @@ int vtkDataIOManagerLogic::QueueRead ( vtkMRMLNode *node )
     return 0;
     }
 
+  //--- in synchronous mode all the files of the storage node are staged
+  //--- with a single call, so that the handler can transfer them concurrently
+  std::vector<vtkSmartPointer<vtkDataTransfer> > synchronousTransfers;
+
   //--- construct and add a record of the transfer
   //--- which includes the ID of associated node
   vtkNew<vtkDataTransfer> transfer0;
@@ -403,6 +410,39 @@ int vtkDataIOManagerLogic::QueueRead ( vtkMRMLNode *node )
 
   vtkDebugMacro("QueueRead: asynchronous enabled = " << this->GetDataIOManager()->GetEnableAsynchronousIO());
 
+  const char *previewSource = dnode->GetNthStorageNode(storageNodeIndex)->GetPreviewURI();
+  if ( this->GetDataIOManager()->GetEnableAsynchronousIO() && previewSource && strlen(previewSource) > 0 )
+    {
+    //---
+    //--- Schedule the download of the low resolution preview first, so that
+    //--- the data can be shown while the full resolution file is downloaded.
+    //---
+    const char *previewDest = cm->GetFilenameFromURI ( previewSource );
+    if ( previewDest )
+      {
+      vtkDebugMacro("QueueRead: Schedule an ASYNCHRONOUS preview data transfer, source = " << previewSource);
+      vtkNew<vtkDataTransfer> previewTransfer;
+      previewTransfer->SetTransferID ( this->GetDataIOManager()->GetUniqueTransferID() );
+      previewTransfer->SetTransferNodeID ( node->GetID() );
+      previewTransfer->SetSourceURI ( previewSource );
+      previewTransfer->SetDestinationURI ( previewDest );
+      previewTransfer->SetHandler ( handler );
+      previewTransfer->SetTransferType ( vtkDataTransfer::RemotePreviewDownload );
+      previewTransfer->SetCancelRequested ( 0 );
+      previewTransfer->SetTransferStatus ( vtkDataTransfer::Pending );
+      this->AddNewDataTransfer ( previewTransfer.GetPointer(), node );
+      vtkNew<vtkSlicerTask> task;
+      task->SetTypeToNetworking();
+      task->SetTaskFunction(this, (vtkSlicerTask::TaskFunctionPointer)
+                            &vtkDataIOManagerLogic::ApplyTransfer, previewTransfer.GetPointer());
+      if ( ! this->GetApplicationLogic()->ScheduleTask( task.GetPointer() ) )
+        {
+        // the full resolution data is still downloaded
+        previewTransfer->SetTransferStatus( vtkDataTransfer::CompletedWithErrors);
+        }
+      }
+    }
+
   if ( this->GetDataIOManager()->GetEnableAsynchronousIO() )
     {
     vtkDebugMacro("QueueRead: Schedule an ASYNCHRONOUS data transfer");
@@ -429,15 +469,7 @@ int vtkDataIOManagerLogic::QueueRead ( vtkMRMLNode *node )
     //--- Execute a SYNCHRONOUS data transfer
     //---
     transfer0->SetTransferStatus( vtkDataTransfer::Running);
-    this->ApplyTransfer ( transfer0.GetPointer() );
-    transfer0->SetTransferStatus( vtkDataTransfer::Completed);
-    // now set the node's storage node state to ready
-    vtkDebugMacro("QueueRead: setting storage node state to transferdone: " << dnode->GetNthStorageNode(storageNodeIndex)->GetURI());
-    if (dnode->GetNthStorageNode(storageNodeIndex)->GetNumberOfURIs() == 0)
-      {
-      // done
-      dnode->GetNthStorageNode(storageNodeIndex)->SetReadStateTransferDone();
-      }
+    synchronousTransfers.push_back(transfer0.GetPointer());
     }
 //  this->DebugOff();
 
@@ -480,15 +512,31 @@ int vtkDataIOManagerLogic::QueueRead ( vtkMRMLNode *node )
       {
       vtkDebugMacro("QueueRead: Schedule a SYNCHRONOUS data transfer, n = " << n);
       transfer1->SetTransferStatus( vtkDataTransfer::Running);
-      this->ApplyTransfer ( transfer1.GetPointer() );
-      transfer1->SetTransferStatus( vtkDataTransfer::Completed);
-      // now set the node's storage node state to ready
-
+      synchronousTransfers.push_back(transfer1.GetPointer());
       }
     }
-  if ( dnode->GetNthStorageNode(storageNodeIndex)->GetNumberOfURIs() > 0 &&
-       !this->GetDataIOManager()->GetEnableAsynchronousIO())
+  if ( !synchronousTransfers.empty() )
     {
+    std::vector<std::string> sources;
+    std::vector<std::string> destinations;
+    for (vtkDataTransfer* transfer : synchronousTransfers)
+      {
+      if (transfer->GetSourceURI() && transfer->GetDestinationURI())
+        {
+        sources.push_back(transfer->GetSourceURI());
+        destinations.push_back(transfer->GetDestinationURI());
+        }
+      }
+    handler->StageFilesRead(sources, destinations);
+    for (const std::string& destination : destinations)
+      {
+      cm->RegisterCachedFile(destination.c_str());
+      }
+    for (vtkDataTransfer* transfer : synchronousTransfers)
+      {
+      transfer->SetTransferStatus( vtkDataTransfer::Completed);
+      }
+    // now set the node's storage node state to ready
     vtkDebugMacro("QueueRead: setting storage node state to transferdone after synchronous transfer of all files: " << dnode->GetNthStorageNode(storageNodeIndex)->GetURI());
     dnode->GetNthStorageNode(storageNodeIndex)->SetReadStateTransferDone();
     }
@@ -717,6 +765,10 @@ void vtkDataIOManagerLogic::ApplyTransfer( void *clientdata )
         dt->SetTransferStatusNoModify ( vtkDataTransfer::Running );
         this->GetApplicationLogic()->RequestModified( dt );
         handler->StageFileRead( source, dest);
+        if (iom->GetCacheManager())
+          {
+          iom->GetCacheManager()->RegisterCachedFile( dest );
+          }
         dt->SetTransferStatusNoModify ( vtkDataTransfer::Completed );
         this->GetApplicationLogic()->RequestModified( dt );
 
@@ -759,7 +811,33 @@ void vtkDataIOManagerLogic::ApplyTransfer( void *clientdata )
         {
         vtkDebugMacro("ApplyTransfer: stage file read on the handler..., source = " << source << ", dest = " << dest);
         handler->StageFileRead( source, dest);
+        if (iom && iom->GetCacheManager())
+          {
+          iom->GetCacheManager()->RegisterCachedFile( dest );
+          }
+        }
+      }
+    }
+  else if ( dt->GetTransferType() == vtkDataTransfer::RemotePreviewDownload  )
+    {
+    //---
+    //--- Download the preview and read it in the main thread, the state
+    //--- of the storage node is not changed: it is still waiting for the
+    //--- full resolution data.
+    //---
+    vtkURIHandler *handler = dt->GetHandler();
+    if ( handler != nullptr && source != nullptr && dest != nullptr )
+      {
+      dt->SetTransferStatusNoModify ( vtkDataTransfer::Running );
+      this->GetApplicationLogic()->RequestModified( dt );
+      handler->StageFileRead( source, dest );
+      if (iom && iom->GetCacheManager())
+        {
+        iom->GetCacheManager()->RegisterCachedFile( dest );
         }
+      dt->SetTransferStatusNoModify ( vtkDataTransfer::Completed );
+      this->GetApplicationLogic()->RequestModified( dt );
+      this->GetApplicationLogic()->RequestReadPreviewFile( node->GetID(), dest );
       }
     }
   else if ( dt->GetTransferType() == vtkDataTransfer::RemoteUpload  )
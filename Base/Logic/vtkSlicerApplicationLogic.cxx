@@ -41,13 +41,23 @@
 # include <sys/resource.h>
 #endif
 
+#include <chrono>
+#include <deque>
 #include <queue>
+#include <set>
+#include <thread>
 
 #include "vtkSlicerApplicationLogicRequests.h"
 
 //----------------------------------------------------------------------------
-class ProcessingTaskQueue : public std::queue<vtkSmartPointer<vtkSlicerTask> > {};
-class ModifiedQueue : public std::queue<vtkSmartPointer<vtkObject> > {};
+// Tasks are sorted by decreasing priority
+class ProcessingTaskQueue : public std::deque<vtkSmartPointer<vtkSlicerTask> > {};
+class ModifiedQueue : public std::queue<vtkSmartPointer<vtkObject> >
+{
+public:
+  /// Objects that are in the queue, an object is queued only once
+  std::set<vtkObject*> QueuedObjects;
+};
 class ReadDataQueue : public std::queue<DataRequest*> {};
 class WriteDataQueue : public std::queue<DataRequest*> {};
 
@@ -58,8 +68,13 @@ vtkStandardNewMacro(vtkSlicerApplicationLogic);
 vtkSlicerApplicationLogic::vtkSlicerApplicationLogic()
 {
   this->ProcessingThreader = itk::PlatformMultiThreader::New();
-  this->ProcessingThreadId = -1;
   this->ProcessingThreadActive = false;
+  this->NumberOfProcessingThreads = 1;
+  this->NumberOfDecodingThreads = 2;
+  this->MaximumNumberOfInProcessTasks = 1;
+  this->MaximumNumberOfThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  this->ModifiedQueueTimeBudget = 20.0;
+  this->NumberOfRunningInProcessTasks = 0;
 
   this->ModifiedQueueActive = false;
 
@@ -80,19 +95,11 @@ vtkSlicerApplicationLogic::vtkSlicerApplicationLogic()
 vtkSlicerApplicationLogic::~vtkSlicerApplicationLogic()
 {
   // Note that TerminateThread does not kill a thread, it only waits
-  // for the thread to finish.  We need to signal the thread that we
-  // want to terminate
-  if (this->ProcessingThreadId != -1 && this->ProcessingThreader)
+  // for the thread to finish. TerminateProcessingThread() signals the
+  // processing and networking threads that we want to terminate.
+  if (this->ProcessingThreader)
     {
-    // Signal the processingThread that we are terminating.
-    this->ProcessingThreadActiveLock.lock();
-    this->ProcessingThreadActive = false;
-    this->ProcessingThreadActiveLock.unlock();
-
-    // Wait for the thread to finish and clean up the state of the threader
-    this->ProcessingThreader->TerminateThread( this->ProcessingThreadId );
-
-    this->ProcessingThreadId = -1;
+    this->TerminateProcessingThread();
     }
 
   delete this->InternalTaskQueue;
@@ -158,21 +165,36 @@ void vtkSlicerApplicationLogic::PrintSelf(ostream& os, vtkIndent indent)
   this->vtkObject::PrintSelf(os, indent);
 
   os << indent << "SlicerApplicationLogic:             " << this->GetClassName() << "\n";
+  os << indent << "NumberOfProcessingThreads:          " << this->NumberOfProcessingThreads << "\n";
+  os << indent << "NumberOfDecodingThreads:            " << this->NumberOfDecodingThreads << "\n";
+  os << indent << "MaximumNumberOfInProcessTasks:      " << this->MaximumNumberOfInProcessTasks << "\n";
+  os << indent << "MaximumNumberOfThreads:             " << this->MaximumNumberOfThreads << "\n";
 }
 
 //----------------------------------------------------------------------------
 void vtkSlicerApplicationLogic::CreateProcessingThread()
 {
-  if (this->ProcessingThreadId == -1)
+  if (this->ProcessingThreadIDs.empty())
     {
     this->ProcessingThreadActiveLock.lock();
     this->ProcessingThreadActive = true;
     this->ProcessingThreadActiveLock.unlock();
 
-    this->ProcessingThreadId
-      = this->ProcessingThreader
-      ->SpawnThread(vtkSlicerApplicationLogic::ProcessingThreaderCallback,
-                    this);
+    for (int i = 0; i < this->NumberOfProcessingThreads; ++i)
+      {
+      this->ProcessingThreadIDs.push_back( this->ProcessingThreader
+        ->SpawnThread(vtkSlicerApplicationLogic::ProcessingThreaderCallback,
+                      this) );
+      }
+
+    // Decoding threads are separate from processing threads so that reading
+    // files is not delayed by long running processing tasks
+    for (int i = 0; i < this->NumberOfDecodingThreads; ++i)
+      {
+      this->DecodingThreadIDs.push_back( this->ProcessingThreader
+        ->SpawnThread(vtkSlicerApplicationLogic::DecodingThreaderCallback,
+                      this) );
+      }
 
     // Start four network threads (TODO: make the number of threads a setting)
     this->NetworkingThreadIDs.push_back ( this->ProcessingThreader
@@ -215,7 +237,7 @@ void vtkSlicerApplicationLogic::CreateProcessingThread()
 //----------------------------------------------------------------------------
 void vtkSlicerApplicationLogic::TerminateProcessingThread()
 {
-  if (this->ProcessingThreadId != -1)
+  if (!this->ProcessingThreadIDs.empty())
     {
     this->ModifiedQueueActiveLock.lock();
     this->ModifiedQueueActive = false;
@@ -233,10 +255,20 @@ void vtkSlicerApplicationLogic::TerminateProcessingThread()
     this->ProcessingThreadActive = false;
     this->ProcessingThreadActiveLock.unlock();
 
-    this->ProcessingThreader->TerminateThread( this->ProcessingThreadId );
-    this->ProcessingThreadId = -1;
+    // Wake up the threads waiting for a task so that they can exit
+    this->ProcessingTaskQueueLock.lock();
+    this->ProcessingTaskQueueCondition.notify_all();
+    this->ProcessingTaskQueueLock.unlock();
 
     std::vector<int>::const_iterator idIterator;
+    for (idIterator = this->ProcessingThreadIDs.begin();
+         idIterator != this->ProcessingThreadIDs.end();
+         ++idIterator)
+      {
+      this->ProcessingThreader->TerminateThread( *idIterator );
+      }
+    this->ProcessingThreadIDs.clear();
+
     idIterator = this->NetworkingThreadIDs.begin();
     while (idIterator != this->NetworkingThreadIDs.end())
       {
@@ -245,6 +277,14 @@ void vtkSlicerApplicationLogic::TerminateProcessingThread()
       }
     this->NetworkingThreadIDs.clear();
 
+    for (idIterator = this->DecodingThreadIDs.begin();
+         idIterator != this->DecodingThreadIDs.end();
+         ++idIterator)
+      {
+      this->ProcessingThreader->TerminateThread( *idIterator );
+      }
+    this->DecodingThreadIDs.clear();
+
     }
 }
 
@@ -270,116 +310,159 @@ vtkSlicerApplicationLogic::ProcessingThreaderCallback(void* arg)
 //----------------------------------------------------------------------------
 void vtkSlicerApplicationLogic::ProcessProcessingTasks()
 {
-  int active = true;
-  vtkSmartPointer<vtkSlicerTask> task = nullptr;
-
-  while (active)
+  // only handle processing tasks in this thread
+  vtkSmartPointer<vtkSlicerTask> task;
+  while ((task = this->WaitForTask(vtkSlicerTask::Processing)) != nullptr)
     {
-    // Check to see if we should be shutting down
-    this->ProcessingThreadActiveLock.lock();
-    active = this->ProcessingThreadActive;
-    this->ProcessingThreadActiveLock.unlock();
+    task->Execute();
+    this->FinishTask(task);
+    task = nullptr;
+    }
+}
 
-    if (active)
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkSlicerTask> vtkSlicerApplicationLogic::WaitForTask(int taskType)
+{
+  std::unique_lock<std::mutex> lock(this->ProcessingTaskQueueLock);
+  ProcessingTaskQueue::iterator taskIt;
+  // sleep until there is a task for this thread or we should be shutting down
+  this->ProcessingTaskQueueCondition.wait(lock, [this, taskType, &taskIt]
+    {
+    if (!this->IsProcessingThreadActive())
       {
-      // pull a task off the queue
-      this->ProcessingTaskQueueLock.lock();
-      if ((*this->InternalTaskQueue).size() > 0)
-        {
-        // std::cout << "Number of queued tasks: " << (*this->InternalTaskQueue).size() << std::endl;
-
-        // only handle processing tasks in this thread
-        task = (*this->InternalTaskQueue).front();
-        if ( task->GetType() == vtkSlicerTask::Processing )
-          {
-          (*this->InternalTaskQueue).pop();
-          }
-        else
-          {
-          task = nullptr;
-          }
-        }
-      this->ProcessingTaskQueueLock.unlock();
-
-      // process the task (should this be in a separate thread?)
-      if (task)
+      return true;
+      }
+    // find the first task (highest priority) that can be started now
+    // each running in-process task uses at least one thread
+    bool inProcessAllowed =
+      (this->NumberOfRunningInProcessTasks < this->MaximumNumberOfInProcessTasks
+       && this->NumberOfRunningInProcessTasks < this->MaximumNumberOfThreads);
+    for (taskIt = (*this->InternalTaskQueue).begin(); taskIt != (*this->InternalTaskQueue).end(); ++taskIt)
+      {
+      if ((*taskIt)->GetType() == taskType && (inProcessAllowed || !(*taskIt)->GetInProcess()))
         {
-        task->Execute();
-        task = nullptr;
+        return true;
         }
       }
+    return false;
+    });
+  if (!this->IsProcessingThreadActive())
+    {
+    return nullptr;
+    }
 
-    // busy wait
-    itksys::SystemTools::Delay(100);
+  // std::cout << "Number of queued tasks: " << (*this->InternalTaskQueue).size() << std::endl;
+  vtkSmartPointer<vtkSlicerTask> task = *taskIt;
+  (*this->InternalTaskQueue).erase(taskIt);
+  if (task->GetInProcess())
+    {
+    ++this->NumberOfRunningInProcessTasks;
+    task->SetNumberOfThreads(this->GetInProcessTaskNumberOfThreads());
     }
+  return task;
+}
+
+//----------------------------------------------------------------------------
+int vtkSlicerApplicationLogic::GetInProcessTaskNumberOfThreads()
+{
+  return std::max(1, this->MaximumNumberOfThreads / this->MaximumNumberOfInProcessTasks);
 }
 
+//----------------------------------------------------------------------------
+void vtkSlicerApplicationLogic::FinishTask(vtkSlicerTask* task)
+{
+  if (!task || !task->GetInProcess())
+    {
+    return;
+    }
+  this->ProcessingTaskQueueLock.lock();
+  --this->NumberOfRunningInProcessTasks;
+  // a queued in-process task may be started now
+  this->ProcessingTaskQueueCondition.notify_all();
+  this->ProcessingTaskQueueLock.unlock();
+}
+
+//----------------------------------------------------------------------------
+bool vtkSlicerApplicationLogic::IsProcessingThreadActive()
+{
+  std::lock_guard<std::mutex> lock(this->ProcessingThreadActiveLock);
+  return this->ProcessingThreadActive;
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerApplicationLogic::ProcessNetworkingTasks()
+{
+  // only handle networking tasks in this thread
+  vtkSmartPointer<vtkSlicerTask> task;
+  while ((task = this->WaitForTask(vtkSlicerTask::Networking)) != nullptr)
+    {
+    task->Execute();
+    this->FinishTask(task);
+    task = nullptr;
+    }
+}
+
+//----------------------------------------------------------------------------
 itk::ITK_THREAD_RETURN_TYPE
-vtkSlicerApplicationLogic::NetworkingThreaderCallback(void* arg)
+vtkSlicerApplicationLogic::DecodingThreaderCallback(void* arg)
 {
   vtkSlicerApplicationLogic* appLogic = (vtkSlicerApplicationLogic*)(((itk::PlatformMultiThreader::WorkUnitInfo*)(arg))->UserData);
   if (!appLogic)
     {
-    vtkGenericWarningMacro("vtkSlicerApplicationLogic::NetworkingThreaderCallback failed: invalid appLogic");
+    vtkGenericWarningMacro("vtkSlicerApplicationLogic::DecodingThreaderCallback failed: invalid appLogic");
     return itk::ITK_THREAD_RETURN_DEFAULT_VALUE;
     }
 
   appLogic->SetCurrentThreadPriorityToBackground();
 
-  // Start network communication tasks in this thread
-  appLogic->ProcessNetworkingTasks();
+  // Start file decoding tasks in this thread
+  appLogic->ProcessDecodingTasks();
 
   return itk::ITK_THREAD_RETURN_DEFAULT_VALUE;
 }
 
 //----------------------------------------------------------------------------
-void vtkSlicerApplicationLogic::ProcessNetworkingTasks()
+void vtkSlicerApplicationLogic::ProcessDecodingTasks()
 {
-  int active = true;
-  vtkSmartPointer<vtkSlicerTask> task = nullptr;
-
-  while (active)
+  // only handle decoding tasks in this thread
+  vtkSmartPointer<vtkSlicerTask> task;
+  while ((task = this->WaitForTask(vtkSlicerTask::Decoding)) != nullptr)
     {
-    // Check to see if we should be shutting down
-    this->ProcessingThreadActiveLock.lock();
-    active = this->ProcessingThreadActive;
-    this->ProcessingThreadActiveLock.unlock();
-
-    if (active)
-      {
-      // pull a task off the queue
-      this->ProcessingTaskQueueLock.lock();
-      if ((*this->InternalTaskQueue).size() > 0)
-        {
-        // std::cout << "Number of queued tasks: " << (*this->InternalTaskQueue).size() << std::endl;
-        task = (*this->InternalTaskQueue).front();
-        if ( task->GetType() == vtkSlicerTask::Networking )
-          {
-          (*this->InternalTaskQueue).pop();
-          }
-        else
-          {
-          task = nullptr;
-          }
-        }
-      this->ProcessingTaskQueueLock.unlock();
+    task->Execute();
+    this->FinishTask(task);
+    task = nullptr;
+    }
+}
 
-      // process the task (should this be in a separate thread?)
-      if (task)
-        {
-        task->Execute();
-        task = nullptr;
-        }
-      }
+//----------------------------------------------------------------------------
+void vtkSlicerApplicationLogic::DecodeReadData(void* clientdata)
+{
+  DataRequest* req = reinterpret_cast<DataRequest*>(clientdata);
+  req->Decode();
 
-    // busy wait
-    itksys::SystemTools::Delay(100);
+  // Queue the request again to update the scene in the main thread
+  this->ReadDataQueueActiveLock.lock();
+  int active = this->ReadDataQueueActive;
+  this->ReadDataQueueActiveLock.unlock();
+  if (!active)
+    {
+    delete req;
+    return;
     }
+  this->ReadDataQueueLock.lock();
+  (*this->InternalReadDataQueue).push(req);
+  this->ReadDataQueueLock.unlock();
 }
 
 //----------------------------------------------------------------------------
 int vtkSlicerApplicationLogic::ScheduleTask( vtkSlicerTask *task )
 {
+  if (!task)
+    {
+    vtkErrorMacro("ScheduleTask failed: invalid task");
+    return false;
+    }
+
   // only schedule a task if the processing task is up
   this->ProcessingThreadActiveLock.lock();
   int active = this->ProcessingThreadActive;
@@ -390,11 +473,40 @@ int vtkSlicerApplicationLogic::ScheduleTask( vtkSlicerTask *task )
     }
 
   this->ProcessingTaskQueueLock.lock();
-  (*this->InternalTaskQueue).push( task );
+  // insert after all the tasks that have the same or higher priority
+  ProcessingTaskQueue::iterator taskIt = (*this->InternalTaskQueue).begin();
+  while (taskIt != (*this->InternalTaskQueue).end() && (*taskIt)->GetPriority() >= task->GetPriority())
+    {
+    ++taskIt;
+    }
+  (*this->InternalTaskQueue).insert(taskIt, task);
+  // wake up the threads that handle this type of task
+  this->ProcessingTaskQueueCondition.notify_all();
   this->ProcessingTaskQueueLock.unlock();
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkSlicerApplicationLogic::CancelTask( vtkSlicerTask *task )
+{
+  std::lock_guard<std::mutex> lock(this->ProcessingTaskQueueLock);
+  ProcessingTaskQueue::iterator taskIt =
+    std::find((*this->InternalTaskQueue).begin(), (*this->InternalTaskQueue).end(), task);
+  if (taskIt == (*this->InternalTaskQueue).end())
+    {
+    return false;
+    }
+  (*this->InternalTaskQueue).erase(taskIt);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkSlicerApplicationLogic::GetNumberOfQueuedTasks()
+{
+  std::lock_guard<std::mutex> lock(this->ProcessingTaskQueueLock);
+  return static_cast<int>((*this->InternalTaskQueue).size());
+}
+
 //----------------------------------------------------------------------------
 vtkMTimeType vtkSlicerApplicationLogic::RequestModified(vtkObject *obj)
 {
@@ -408,11 +520,14 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestModified(vtkObject *obj)
     return 0;
     }
 
-  obj->Register(this);
   this->ModifiedQueueLock.lock();
   this->RequestTimeStamp.Modified();
   vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
-  (*this->InternalModifiedQueue).push(obj);
+  if (this->InternalModifiedQueue->QueuedObjects.insert(obj).second)
+    {
+    obj->Register(this);
+    (*this->InternalModifiedQueue).push(obj);
+    }
   this->ModifiedQueueLock.unlock();
   return uid;
 }
@@ -433,12 +548,35 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestReadFile(const char *refNode, con
   this->ReadDataQueueLock.lock();
   this->RequestTimeStamp.Modified();
   vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
+  this->AddPendingRequest(uid);
   (*this->InternalReadDataQueue).push(
     new ReadDataRequestFile(refNode, filename, displayData, deleteFile, uid));
   this->ReadDataQueueLock.unlock();
   return uid;
 }
 
+//----------------------------------------------------------------------------
+vtkMTimeType vtkSlicerApplicationLogic::RequestReadPreviewFile(const char *refNode, const char *filename)
+{
+  // only request to read a file if the ReadData queue is up
+  this->ReadDataQueueActiveLock.lock();
+  int active = this->ReadDataQueueActive;
+  this->ReadDataQueueActiveLock.unlock();
+  if (!active)
+    {
+    // could not request the record be added to the queue
+    return 0;
+    }
+
+  this->ReadDataQueueLock.lock();
+  this->RequestTimeStamp.Modified();
+  vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
+  this->AddPendingRequest(uid);
+  (*this->InternalReadDataQueue).push(new ReadDataRequestPreviewFile(refNode, filename, uid));
+  this->ReadDataQueueLock.unlock();
+  return uid;
+}
+
 //----------------------------------------------------------------------------
 vtkMTimeType vtkSlicerApplicationLogic::RequestUpdateParentTransform(const std::string &refNode, const std::string& parentTransformNode)
 {
@@ -455,6 +593,7 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestUpdateParentTransform(const std::
   this->ReadDataQueueLock.lock();
   this->RequestTimeStamp.Modified();
   vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
+  this->AddPendingRequest(uid);
   (*this->InternalReadDataQueue).push(new ReadDataRequestUpdateParentTransform(refNode, parentTransformNode, uid));
   this->ReadDataQueueLock.unlock();
   return uid;
@@ -476,6 +615,7 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestUpdateSubjectHierarchyLocation(co
   this->ReadDataQueueLock.lock();
   this->RequestTimeStamp.Modified();
   vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
+  this->AddPendingRequest(uid);
   (*this->InternalReadDataQueue).push(new ReadDataRequestUpdateSubjectHierarchyLocation(updatedNode, siblingNode, uid));
   this->ReadDataQueueLock.unlock();
   return uid;
@@ -497,6 +637,7 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestAddNodeReference(const std::strin
   this->ReadDataQueueLock.lock();
   this->RequestTimeStamp.Modified();
   vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
+  this->AddPendingRequest(uid);
   (*this->InternalReadDataQueue).push(new ReadDataRequestAddNodeReference(referencingNode, referencedNode, role, uid));
   this->ReadDataQueueLock.unlock();
   return uid;
@@ -518,6 +659,7 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestWriteData(const char *refNode, co
   this->WriteDataQueueLock.lock();
   this->RequestTimeStamp.Modified();
   vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
+  this->AddPendingRequest(uid);
   (*this->InternalWriteDataQueue).push(
     new WriteDataRequestFile(refNode, filename, uid) );
   this->WriteDataQueueLock.unlock();
@@ -544,6 +686,7 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestReadScene(
   this->ReadDataQueueLock.lock();
   this->RequestTimeStamp.Modified();
   vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
+  this->AddPendingRequest(uid);
   (*this->InternalReadDataQueue).push(
     new ReadDataRequestScene(targetIDs, sourceIDs, filename, displayData, deleteFile, uid));
   this->ReadDataQueueLock.unlock();
@@ -562,28 +705,32 @@ void vtkSlicerApplicationLogic::ProcessModified()
     return;
     }
 
-  vtkSmartPointer<vtkObject> obj = nullptr;
-  // pull an object off the queue to modify
-  this->ModifiedQueueLock.lock();
-  if ((*this->InternalModifiedQueue).size() > 0)
+  // Process all the queued objects, or as many as possible within the time budget
+  std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now()
+    + std::chrono::microseconds(static_cast<long long>(this->ModifiedQueueTimeBudget * 1000.0));
+  bool queueEmpty = false;
+  while (true)
     {
-    obj = (*this->InternalModifiedQueue).front();
-    (*this->InternalModifiedQueue).pop();
-
-    // pop off any extra copies of the same object to save some updates
-    while (!(*this->InternalModifiedQueue).empty()
-           && (obj == (*this->InternalModifiedQueue).front()))
+    vtkSmartPointer<vtkObject> obj = nullptr;
+    // pull an object off the queue to modify
+    this->ModifiedQueueLock.lock();
+    if ((*this->InternalModifiedQueue).size() > 0)
       {
+      obj = (*this->InternalModifiedQueue).front();
       (*this->InternalModifiedQueue).pop();
-      obj->Delete(); // decrement ref count
+      // the object can be queued again from now on
+      this->InternalModifiedQueue->QueuedObjects.erase(obj);
       }
-    }
-  this->ModifiedQueueLock.unlock();
+    queueEmpty = (*this->InternalModifiedQueue).empty();
+    this->ModifiedQueueLock.unlock();
 
-  // Modify the object
-  //  - decrement reference count that was increased when it was added to the queue
-  if (obj.GetPointer())
-    {
+    if (!obj.GetPointer())
+      {
+      break;
+      }
+
+    // Modify the object
+    //  - decrement reference count that was increased when it was added to the queue
     vtkMRMLNode* node = vtkMRMLNode::SafeDownCast(obj);
     if (node)
       {
@@ -599,11 +746,16 @@ void vtkSlicerApplicationLogic::ProcessModified()
       }
     obj->Delete();
     obj = nullptr;
+
+    if (queueEmpty || std::chrono::steady_clock::now() >= endTime)
+      {
+      break;
+      }
     }
 
   // schedule the next timer sooner in case there is stuff in the queue
   // otherwise for a while later
-  int delay = (*this->InternalModifiedQueue).size() > 0 ? 0: 200;
+  int delay = queueEmpty ? 200 : 0;
   this->InvokeEvent(vtkSlicerApplicationLogic::RequestModifiedEvent, &delay);
 }
 
@@ -629,11 +781,28 @@ void vtkSlicerApplicationLogic::ProcessReadData()
     }
   this->ReadDataQueueLock.unlock();
 
+  if (req && req->PrepareDecode(this))
+    {
+    // Read the file in a decoding thread, the request is queued again
+    // when reading is completed
+    vtkNew<vtkSlicerTask> task;
+    task->SetTypeToDecoding();
+    task->SetTaskFunction(this, (vtkSlicerTask::TaskFunctionPointer)
+                          &vtkSlicerApplicationLogic::DecodeReadData, req);
+    if (this->ScheduleTask(task.GetPointer()))
+      {
+      req = nullptr;
+      }
+    // otherwise the file is read in the main thread
+    }
+
   vtkMTimeType uid = 0;
+  bool success = true;
   if (req)
     {
     uid = req->GetUID();
     req->Execute(this);
+    success = req->GetSuccess();
     delete req;
     }
 
@@ -645,6 +814,7 @@ void vtkSlicerApplicationLogic::ProcessReadData()
     {
     this->InvokeEvent(vtkSlicerApplicationLogic::RequestProcessedEvent,
                       reinterpret_cast<void*>(uid));
+    this->CompletePendingRequest(uid, success);
     }
 }
 
@@ -674,6 +844,7 @@ void vtkSlicerApplicationLogic::ProcessWriteData()
   {
     vtkMTimeType uid = req->GetUID();
     req->Execute(this);
+    bool success = req->GetSuccess();
     delete req;
 
     // schedule the next timer sooner in case there is stuff in the queue
@@ -684,10 +855,57 @@ void vtkSlicerApplicationLogic::ProcessWriteData()
       {
       this->InvokeEvent(vtkSlicerApplicationLogic::RequestProcessedEvent,
         reinterpret_cast<void*>(uid));
+      this->CompletePendingRequest(uid, success);
       }
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSlicerApplicationLogic::AddPendingRequest(vtkMTimeType uid)
+{
+  std::lock_guard<std::mutex> lock(this->PendingRequestsLock);
+  this->PendingRequests[uid] = nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerApplicationLogic::CompletePendingRequest(vtkMTimeType uid, bool success)
+{
+  RequestCompletionCallback callback;
+  this->PendingRequestsLock.lock();
+  std::map<vtkMTimeType, RequestCompletionCallback>::iterator requestIt = this->PendingRequests.find(uid);
+  if (requestIt != this->PendingRequests.end())
+    {
+    callback = requestIt->second;
+    this->PendingRequests.erase(requestIt);
+    }
+  this->PendingRequestsLock.unlock();
+  // the callback may queue new requests
+  if (callback)
+    {
+    callback(uid, success);
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkSlicerApplicationLogic::IsRequestPending(vtkMTimeType uid)
+{
+  std::lock_guard<std::mutex> lock(this->PendingRequestsLock);
+  return this->PendingRequests.find(uid) != this->PendingRequests.end();
+}
+
+//----------------------------------------------------------------------------
+bool vtkSlicerApplicationLogic::SetRequestCompletionCallback(vtkMTimeType uid, RequestCompletionCallback callback)
+{
+  std::lock_guard<std::mutex> lock(this->PendingRequestsLock);
+  std::map<vtkMTimeType, RequestCompletionCallback>::iterator requestIt = this->PendingRequests.find(uid);
+  if (requestIt == this->PendingRequests.end())
+    {
+    return false;
+    }
+  requestIt->second = callback;
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool vtkSlicerApplicationLogic::IsEmbeddedModule(const std::string& filePath,
                                                  const std::string& applicationHomeDir,
@@ -26,11 +26,15 @@
 
 // VTK includes
 #include <vtkCollection.h>
+#include <vtkSmartPointer.h>
 
 // ITK includes
 #include <itkPlatformMultiThreader.h>
 
 // STL includes
+#include <condition_variable>
+#include <functional>
+#include <map>
 #include <mutex>
 
 class vtkMRMLSelectionNode;
@@ -68,11 +72,55 @@ class VTK_SLICER_BASE_LOGIC_EXPORT vtkSlicerApplicationLogic
                           vtkDataIOManagerLogic *dataIOManagerLogic);
 
 
-  /// Create a thread for processing
+  /// Create the threads for processing (and networking)
   void CreateProcessingThread();
 
-  /// Shutdown the processing thread
+  /// Shutdown the processing threads
   void TerminateProcessingThread();
+
+  /// Number of threads that execute processing tasks (such as CLI modules)
+  /// concurrently. Default is 1, which executes tasks one after the other.
+  /// Changes take effect the next time CreateProcessingThread() is called.
+  vtkSetClampMacro(NumberOfProcessingThreads, int, 1, 64);
+  vtkGetMacro(NumberOfProcessingThreads, int);
+
+  /// Number of threads that read files of RequestReadFile() requests, if the storage
+  /// node supports reading in a worker thread (see vtkMRMLStorageNode::IsReadDataThreadSafe()).
+  /// Only the update of the scene is performed in the main thread. Default is 2.
+  /// Changes take effect the next time CreateProcessingThread() is called.
+  vtkSetClampMacro(NumberOfDecodingThreads, int, 1, 64);
+  vtkGetMacro(NumberOfDecodingThreads, int);
+
+  /// Maximum number of in-process tasks (such as shared object CLI modules)
+  /// that may run at the same time. Other tasks can still be started while
+  /// this limit is reached. Default is 1.
+  /// \warning Shared object CLI modules redirect the process-wide standard
+  /// output streams, so the limit should only be increased if output
+  /// redirection is disabled.
+  /// \sa vtkSlicerTask::SetInProcess()
+  vtkSetClampMacro(MaximumNumberOfInProcessTasks, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfInProcessTasks, int);
+
+  /// Total number of threads that the running in-process tasks may use for
+  /// their computations. Each in-process task is given an equal share of
+  /// the threads (at least one) when it is started, and no more in-process
+  /// tasks are started at the same time than there are threads, so that
+  /// concurrent tasks do not oversubscribe the CPU.
+  /// Default is the number of cores of the computer.
+  /// \sa vtkSlicerTask::GetNumberOfThreads(), GetInProcessTaskNumberOfThreads()
+  vtkSetClampMacro(MaximumNumberOfThreads, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfThreads, int);
+
+  /// Number of threads given to each in-process task.
+  int GetInProcessTaskNumberOfThreads();
+
+  /// Maximum time (in milliseconds) that ProcessModified() spends calling
+  /// Modified() on the queued objects. Objects that are not processed within
+  /// this time are processed at the next call, so that a burst of requests
+  /// does not block the event loop. Default is 20 ms.
+  vtkSetClampMacro(ModifiedQueueTimeBudget, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(ModifiedQueueTimeBudget, double);
+
   /// List of events potentially fired by the application logic
   enum RequestEvents
     {
@@ -89,13 +137,25 @@ class VTK_SLICER_BASE_LOGIC_EXPORT vtkSlicerApplicationLogic
   /// Schedule a task to run in the processing thread. Returns true if
   /// task was successfully scheduled. ScheduleTask() is called from the
   /// main thread to run something in the processing thread.
+  /// Tasks are started in order of decreasing priority.
+  /// \sa vtkSlicerTask::SetPriority(), CancelTask()
   int ScheduleTask( vtkSlicerTask* );
 
+  /// Remove a task from the queue of scheduled tasks.
+  /// Returns false if the task is not in the queue (it has not been scheduled
+  /// or it is already started).
+  bool CancelTask( vtkSlicerTask* );
+
+  /// Return the number of tasks that are scheduled but not started yet.
+  int GetNumberOfQueuedTasks();
+
   /// Request a Modified call on an object.  This method allows a
   /// processing thread to request a Modified call on an object to be
   /// performed in the main thread.  This allows the call to Modified
   /// to trigger GUI changes. RequestModified() is called from the
   /// processing thread to modify an object in the main thread.
+  /// An object that is already in the queue is not queued again, it is
+  /// modified only once.
   /// Return the request UID (monotonically increasing) of the request or 0 if
   /// the request failed to be registered.
   /// \todo Fire RequestProcessedEvent when processing Modified requests.
@@ -113,6 +173,12 @@ class VTK_SLICER_BASE_LOGIC_EXPORT vtkSlicerApplicationLogic
   vtkMTimeType RequestReadFile(const char *refNode, const char *filename,
     int displayData = false, int deleteFile = false);
 
+  /// Request that a low resolution preview of the data be read from a file and
+  /// set on the referenced node, while the full resolution data is downloaded.
+  /// The preview is not read if the full resolution data has been read already.
+  /// \sa vtkMRMLStorageNode::ReadPreviewData(), RequestReadFile()
+  vtkMTimeType RequestReadPreviewFile(const char *refNode, const char *filename);
+
   /// Request setting of parent transform.
   /// The request will executed on the main thread.
   /// Return the request UID (monotonically increasing) of the request or 0 if
@@ -166,10 +232,29 @@ class VTK_SLICER_BASE_LOGIC_EXPORT vtkSlicerApplicationLogic
                        int displayData = false,
                        int deleteFile = false);
 
-  /// Process a request on the Modified queue.  This method is called
+  /// Return true if the request identified by \a uid is queued or being
+  /// processed, false if it has been processed already.
+  /// \sa RequestReadFile(), RequestWriteData(), RequestReadScene()
+  bool IsRequestPending(vtkMTimeType uid);
+
+#ifndef __VTK_WRAP__
+  /// Function called in the main thread when a request is processed.
+  /// \a success is false if the data could not be read or written.
+  typedef std::function<void(vtkMTimeType uid, bool success)> RequestCompletionCallback;
+
+  /// Set a function that is called when the request identified by \a uid is processed,
+  /// after RequestProcessedEvent is invoked.
+  /// Returns false if the request is not pending, in this case the callback is not called.
+  /// \sa IsRequestPending()
+  bool SetRequestCompletionCallback(vtkMTimeType uid, RequestCompletionCallback callback);
+#endif
+
+  /// Process the requests on the Modified queue.  This method is called
   /// in the main thread of the application because calls to Modified()
   /// can cause an update to the GUI. (Method needs to be public to fit
   /// in the event callback chain.)
+  /// All the queued objects are processed, until the time budget is spent.
+  /// \sa SetModifiedQueueTimeBudget()
   void ProcessModified();
 
   /// Process a request to read data and set it on a referenced node.
@@ -239,6 +324,30 @@ protected:
   /// Networking Task processing loop that is run in a networking thread
   void ProcessNetworkingTasks();
 
+   /// Callback used by a MultiThreader to start a decoding thread
+  static itk::ITK_THREAD_RETURN_TYPE DecodingThreaderCallback( void * );
+
+  /// Decoding task processing loop that is run in a decoding thread
+  void ProcessDecodingTasks();
+
+  /// Read the file of a read data request in a decoding thread, then queue
+  /// the request again to update the scene in the main thread.
+  void DecodeReadData(void* clientdata);
+
+  /// Block the calling thread until a task of type \a taskType can be started,
+  /// and remove it from the task queue.
+  /// The task with the highest priority is returned. In-process tasks are
+  /// skipped while MaximumNumberOfInProcessTasks tasks are running.
+  /// Returns nullptr if the processing thread is shutting down.
+  /// \sa ScheduleTask(), TerminateProcessingThread(), FinishTask()
+  vtkSmartPointer<vtkSlicerTask> WaitForTask(int taskType);
+
+  /// Must be called when a task returned by WaitForTask() is completed.
+  void FinishTask(vtkSlicerTask* task);
+
+  /// Return true if the processing and networking threads should keep running.
+  bool IsProcessingThreadActive();
+
   /// Process a request to read data into a scene.  This method is
   /// called by ProcessReadData() in the application main thread
   /// because calls to load data will cause a Modified() on a node
@@ -246,6 +355,12 @@ protected:
   void ProcessReadSceneData( ReadDataRequest &req );
   void ProcessWriteSceneData( WriteDataRequest &req );
 
+  /// Add a request to the pending requests. Must be called before the request is queued.
+  void AddPendingRequest(vtkMTimeType uid);
+
+  /// Remove a request from the pending requests and call its completion callback.
+  void CompletePendingRequest(vtkMTimeType uid, bool success);
+
   /// Set background thread (background processing, networking) priority, which
   /// can be set via an environment variable SLICER_BACKGROUND_THREAD_PRIORITY.
   /// Value of the variable must be an integer
@@ -259,15 +374,27 @@ private:
   itk::PlatformMultiThreader::Pointer ProcessingThreader;
   std::mutex ProcessingThreadActiveLock;
   std::mutex ProcessingTaskQueueLock;
+  /// Notified when a task is scheduled, a task is taken off the queue
+  /// or when the processing thread is terminated.
+  std::condition_variable ProcessingTaskQueueCondition;
   std::mutex ModifiedQueueActiveLock;
   std::mutex ModifiedQueueLock;
   std::mutex ReadDataQueueActiveLock;
   std::mutex ReadDataQueueLock;
   std::mutex WriteDataQueueActiveLock;
   std::mutex WriteDataQueueLock;
+  std::mutex PendingRequestsLock;
   vtkTimeStamp RequestTimeStamp;
-  int ProcessingThreadId;
+  std::vector<int> ProcessingThreadIDs;
   std::vector<int> NetworkingThreadIDs;
+  std::vector<int> DecodingThreadIDs;
+  int NumberOfProcessingThreads;
+  int NumberOfDecodingThreads;
+  int MaximumNumberOfInProcessTasks;
+  int MaximumNumberOfThreads;
+  double ModifiedQueueTimeBudget;
+  /// Number of in-process tasks being executed, protected by ProcessingTaskQueueLock
+  int NumberOfRunningInProcessTasks;
   int ProcessingThreadActive;
   int ModifiedQueueActive;
   int ReadDataQueueActive;
@@ -278,6 +405,10 @@ private:
   ReadDataQueue*       InternalReadDataQueue;
   WriteDataQueue*      InternalWriteDataQueue;
 
+  /// Completion callbacks of the requests that are not processed yet (an empty
+  /// function if no callback is set), protected by PendingRequestsLock
+  std::map<vtkMTimeType, std::function<void(vtkMTimeType, bool)> > PendingRequests;
+
   vtkPersonInformation* UserInformation;
 
   /// For use with external tracing tool (such as AQTime)
@@ -37,10 +37,22 @@ public:
 
   virtual void Execute(vtkSlicerApplicationLogic*) {};
 
+  /// Prepare reading the data in a decoding thread. Called in the main thread.
+  /// Returns false if the request must be executed in the main thread only.
+  virtual bool PrepareDecode(vtkSlicerApplicationLogic*) { return false; };
+
+  /// Read the data. Called in a decoding thread, if PrepareDecode() returned true;
+  /// Execute() is called in the main thread after that.
+  virtual void Decode() {};
+
   int GetUID()const{return m_UID;}
 
+  /// Return false if the request failed to read data.
+  bool GetSuccess()const{return m_Success;}
+
 protected:
   vtkMTimeType m_UID;
+  bool m_Success{true};
 };
 
 //----------------------------------------------------------------------------
@@ -57,8 +69,101 @@ public:
     m_DeleteFile = deleteFile;
   }
 
+  bool PrepareDecode(vtkSlicerApplicationLogic* appLogic) override
+  {
+    if (m_Decoded || appLogic->GetMRMLScene()->GetCacheManager()->IsRemoteReference(m_Filename.c_str()))
+      {
+      return false;
+      }
+    vtkMRMLStorableNode *storableNode = vtkMRMLStorableNode::SafeDownCast(
+      appLogic->GetMRMLScene()->GetNodeByID(m_TargetNode.c_str()));
+    if (!storableNode || !storableNode->HasCopyContent())
+      {
+      return false;
+      }
+
+    // The file is read into temporary nodes that are not in the scene
+    vtkMRMLStorageNode *storageNode = nullptr;
+    for (int n = 0; n < storableNode->GetNumberOfStorageNodes(); n++)
+      {
+      vtkMRMLStorageNode *testStorageNode = storableNode->GetNthStorageNode(n);
+      if (testStorageNode && testStorageNode->GetFileName() != nullptr &&
+        m_Filename.compare(testStorageNode->GetFileName()) == 0)
+        {
+        storageNode = testStorageNode;
+        break;
+        }
+      }
+    if (storageNode)
+      {
+      m_DecodeStorageNode = vtkSmartPointer<vtkMRMLStorageNode>::Take(
+        vtkMRMLStorageNode::SafeDownCast(storageNode->CreateNodeInstance()));
+      if (m_DecodeStorageNode)
+        {
+        m_DecodeStorageNode->Copy(storageNode);
+        }
+      m_StorageNodeID = storageNode->GetID();
+      }
+    else if (storableNode->GetNumberOfStorageNodes() == 0 && itksys::SystemTools::FileExists(m_Filename.c_str()))
+      {
+      // the default storage node is added to the scene when the file is read
+      std::string storageNodeClassName = storableNode->GetDefaultStorageNodeClassName(m_Filename.c_str());
+      if (!storageNodeClassName.empty())
+        {
+        vtkSmartPointer<vtkMRMLNode> newStorageNode = vtkSmartPointer<vtkMRMLNode>::Take(
+          appLogic->GetMRMLScene()->CreateNodeByClass(storageNodeClassName.c_str()));
+        m_DecodeStorageNode = vtkMRMLStorageNode::SafeDownCast(newStorageNode);
+        }
+      m_StorageNodeID.clear();
+      }
+    if (!m_DecodeStorageNode || !m_DecodeStorageNode->IsReadDataThreadSafe())
+      {
+      m_DecodeStorageNode = nullptr;
+      return false;
+      }
+    m_DecodeStorageNode->SetURI(nullptr);
+    m_DecodeStorageNode->SetFileName(m_Filename.c_str());
+
+    // Content of the target node (attributes, etc.) is preserved, it is usually empty
+    // before reading, so a deep copy is not expensive.
+    m_DecodedNode = vtkSmartPointer<vtkMRMLStorableNode>::Take(
+      vtkMRMLStorableNode::SafeDownCast(storableNode->CreateNodeInstance()));
+    if (!m_DecodedNode)
+      {
+      m_DecodeStorageNode = nullptr;
+      return false;
+      }
+    m_DecodedNode->CopyContent(storableNode, /*deepCopy*/true);
+    return true;
+  }
+
+  void Decode() override
+  {
+    try
+      {
+      m_Success = (m_DecodeStorageNode->ReadData(m_DecodedNode, /*temporary*/true) != 0);
+      }
+    catch (itk::ExceptionObject& exc)
+      {
+      vtkErrorWithObjectMacro(m_DecodeStorageNode, "Exception while reading " << m_Filename << ", " << exc);
+      m_Success = false;
+      }
+    catch (...)
+      {
+      vtkErrorWithObjectMacro(m_DecodeStorageNode, "Unknown exception while reading " << m_Filename);
+      m_Success = false;
+      }
+    m_Decoded = true;
+  }
+
   void Execute(vtkSlicerApplicationLogic* appLogic) override
   {
+    if (m_Decoded)
+      {
+      this->ExecuteDecoded(appLogic);
+      return;
+      }
+
     // This method needs to read the data into the specific type of node and set up an
     // appropriate storage and display node.
 
@@ -128,7 +233,7 @@ public:
             storageNode->SetURI(m_Filename.c_str());
             vtkDebugWithObjectMacro(appLogic, "ProcessReadNodeData: calling ReadData on the storage node " \
               << storageNode->GetID() << ", uri = " << storageNode->GetURI());
-            storageNode->ReadData(nd, /*temporary*/true);
+            m_Success = (storageNode->ReadData(nd, /*temporary*/true) != 0);
             if (createdNewStorageNode)
               {
               storageNode->SetURI(nullptr); // clear temporary URI
@@ -139,7 +244,7 @@ public:
             storageNode->SetFileName(m_Filename.c_str());
             vtkDebugWithObjectMacro(appLogic, "ProcessReadNodeData: calling ReadData on the storage node " \
               << storageNode->GetID() << ", filename = " << storageNode->GetFileName());
-            storageNode->ReadData(nd, /*temporary*/true);
+            m_Success = (storageNode->ReadData(nd, /*temporary*/true) != 0);
             if (createdNewStorageNode)
               {
               storageNode->SetFileName(nullptr); // clear temp file name
@@ -149,12 +254,18 @@ public:
         catch (itk::ExceptionObject& exc)
           {
           vtkErrorWithObjectMacro(appLogic, "Exception while reading " << m_Filename << ", " << exc);
+          m_Success = false;
           }
         catch (...)
           {
           vtkErrorWithObjectMacro(appLogic, "Unknown exception while reading " << m_Filename);
+          m_Success = false;
           }
         }
+      else
+        {
+        m_Success = false;
+        }
       }
 #ifdef Slicer_BUILD_CLI_SUPPORT
     // if the node was a CommandLineModule node, then read the file
@@ -165,6 +276,53 @@ public:
       }
 #endif
 
+    this->FinishRead(appLogic, nd);
+  }
+
+protected:
+  /// Update the scene in the main thread after the data is read into the target node
+  void ExecuteDecoded(vtkSlicerApplicationLogic* appLogic)
+  {
+    vtkMRMLStorableNode *storableNode = vtkMRMLStorableNode::SafeDownCast(
+      appLogic->GetMRMLScene()->GetNodeByID(m_TargetNode.c_str()));
+    if (!storableNode)
+      {
+      // the node has been removed while the file was read
+      m_Success = false;
+      }
+    else if (m_Success)
+      {
+      vtkMRMLStorageNode *storageNode = nullptr;
+      if (m_StorageNodeID.empty())
+        {
+        storableNode->AddDefaultStorageNode(m_Filename.c_str());
+        storageNode = storableNode->GetStorageNode();
+        if (storageNode)
+          {
+          storageNode->SetFileName(nullptr); // clear temp file name
+          }
+        }
+      else
+        {
+        storageNode = vtkMRMLStorageNode::SafeDownCast(
+          appLogic->GetMRMLScene()->GetNodeByID(m_StorageNodeID.c_str()));
+        }
+      // only the content is copied, the node keeps its name, references and display nodes
+      storableNode->CopyContent(m_DecodedNode, /*deepCopy*/false);
+      if (storageNode)
+        {
+        storageNode->SetReadStateIdle();
+        }
+      }
+    m_DecodedNode = nullptr;
+    m_DecodeStorageNode = nullptr;
+    this->FinishRead(appLogic, storableNode);
+  }
+
+  /// Delete the file if requested, create display nodes and select the node,
+  /// after the data is read into node \a nd. Only the file is deleted if \a nd is nullptr.
+  void FinishRead(vtkSlicerApplicationLogic* appLogic, vtkMRMLNode* nd)
+  {
     // Delete the file if requested
     if (m_DeleteFile)
      {
@@ -183,7 +341,10 @@ public:
         vtkGenericWarningMacro("Unable to delete temporary file " << m_Filename);
         }
       }
-
+    if (!nd)
+      {
+      return;
+      }
 
     // Get the right type of display node. Only create a display node
     // if one does not exist already
@@ -233,11 +394,65 @@ public:
       }
   }
 
-protected:
   std::string m_TargetNode;
   std::string m_Filename;
   int m_DisplayData;
   int m_DeleteFile;
+
+  /// Temporary nodes the file is read into in a decoding thread
+  vtkSmartPointer<vtkMRMLStorableNode> m_DecodedNode;
+  vtkSmartPointer<vtkMRMLStorageNode> m_DecodeStorageNode;
+  /// Storage node of the target node that refers to the file, empty if a new one is added
+  std::string m_StorageNodeID;
+  bool m_Decoded{false};
+};
+
+//----------------------------------------------------------------------------
+class ReadDataRequestPreviewFile : public DataRequest
+{
+public:
+  ReadDataRequestPreviewFile(const std::string& node, const std::string& filename, int uid = 0)
+    : DataRequest(uid)
+  {
+    m_TargetNode = node;
+    m_Filename = filename;
+  }
+
+  void Execute(vtkSlicerApplicationLogic* appLogic) override
+  {
+    vtkMRMLStorableNode *storableNode = vtkMRMLStorableNode::SafeDownCast(
+      appLogic->GetMRMLScene()->GetNodeByID(m_TargetNode.c_str()));
+    if (!storableNode)
+      {
+      return;
+      }
+    for (int n = 0; n < storableNode->GetNumberOfStorageNodes(); n++)
+      {
+      vtkMRMLStorageNode *storageNode = storableNode->GetNthStorageNode(n);
+      // the preview is not needed anymore if the full resolution data has been read already
+      if (!storageNode || !storageNode->GetPreviewURI()
+        || storageNode->GetReadState() == vtkMRMLStorageNode::Idle)
+        {
+        continue;
+        }
+      vtkDebugWithObjectMacro(appLogic, "ProcessReadNodeData: reading preview " << m_Filename
+        << " into node " << m_TargetNode);
+      if (storageNode->ReadPreviewData(storableNode, m_Filename.c_str()))
+        {
+        vtkMRMLDisplayableNode *displayableNode = vtkMRMLDisplayableNode::SafeDownCast(storableNode);
+        if (displayableNode)
+          {
+          displayableNode->CreateDefaultDisplayNodes();
+          }
+        storableNode->Modified();
+        }
+      break;
+      }
+  }
+
+protected:
+  std::string m_TargetNode;
+  std::string m_Filename;
 };
 
 //----------------------------------------------------------------------------
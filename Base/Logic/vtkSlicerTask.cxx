@@ -6,6 +6,11 @@
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSlicerTask);
 
+namespace
+{
+thread_local vtkSlicerTask* CurrentTask = nullptr;
+}
+
 //----------------------------------------------------------------------------
 vtkSlicerTask::vtkSlicerTask()
 {
@@ -13,6 +18,9 @@ vtkSlicerTask::vtkSlicerTask()
   this->TaskFunction = nullptr;
   this->TaskClientData = nullptr;
   this->Type = vtkSlicerTask::Undefined;
+  this->Priority = 0;
+  this->InProcess = false;
+  this->NumberOfThreads = 0;
 }
 //----------------------------------------------------------------------------
 vtkSlicerTask::~vtkSlicerTask() = default;
@@ -32,12 +40,25 @@ void vtkSlicerTask::Execute()
 {
   if (this->TaskObject)
     {
+    vtkSlicerTask* previousTask = CurrentTask;
+    CurrentTask = this;
     ((*this->TaskObject).*(this->TaskFunction))(this->TaskClientData);
+    CurrentTask = previousTask;
     }
 }
 
+//----------------------------------------------------------------------------
+vtkSlicerTask* vtkSlicerTask::GetCurrentTask()
+{
+  return CurrentTask;
+}
+
 //----------------------------------------------------------------------------
 void vtkSlicerTask::PrintSelf(ostream& os, vtkIndent indent)
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "Type: " << this->GetTypeAsString() << "\n";
+  os << indent << "Priority: " << this->Priority << "\n";
+  os << indent << "InProcess: " << this->InProcess << "\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
 }
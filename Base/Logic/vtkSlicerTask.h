@@ -30,13 +30,45 @@ public:
     {
     Undefined = 0,
     Processing,
-    Networking
+    Networking,
+    Decoding
     };
 
-  vtkSetClampMacro (Type, int, vtkSlicerTask::Undefined, vtkSlicerTask::Networking);
+  vtkSetClampMacro (Type, int, vtkSlicerTask::Undefined, vtkSlicerTask::Decoding);
   vtkGetMacro (Type, int);
   void SetTypeToProcessing() {this->SetType(vtkSlicerTask::Processing);};
   void SetTypeToNetworking() {this->SetType(vtkSlicerTask::Networking);};
+  void SetTypeToDecoding() {this->SetType(vtkSlicerTask::Decoding);};
+
+  ///
+  /// Priority of the task. Tasks with higher priority are started first,
+  /// tasks with the same priority are started in the order they were scheduled.
+  /// Default is 0.
+  vtkSetMacro(Priority, int);
+  vtkGetMacro(Priority, int);
+
+  ///
+  /// Set to true if the task runs code in the application process that uses
+  /// process-wide resources (for example, shared object CLI modules redirect
+  /// the standard output streams). The number of such tasks that may run
+  /// concurrently is limited.
+  /// \sa vtkSlicerApplicationLogic::SetMaximumNumberOfInProcessTasks()
+  vtkSetMacro(InProcess, bool);
+  vtkGetMacro(InProcess, bool);
+  vtkBooleanMacro(InProcess, bool);
+
+  ///
+  /// Maximum number of threads that the task may use for its computations
+  /// (for example, in ITK filters and vtkSMPTools). It is set by the scheduler
+  /// when the task is started. 0 (default) means no limit.
+  /// \sa vtkSlicerApplicationLogic::SetMaximumNumberOfThreads()
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+
+  ///
+  /// Return the task that is being executed in the calling thread,
+  /// nullptr if the calling thread does not execute a task.
+  static vtkSlicerTask* GetCurrentTask();
 
   const char* GetTypeAsString( ) {
     switch (this->Type)
@@ -44,6 +76,7 @@ public:
       case vtkSlicerTask::Undefined: return "Undefined";
       case vtkSlicerTask::Processing: return "Processing";
       case vtkSlicerTask::Networking: return "Networking";
+      case vtkSlicerTask::Decoding: return "Decoding";
       }
     return "Unknown";
   }
@@ -60,6 +93,9 @@ private:
   void *TaskClientData;
 
   int Type;
+  int Priority;
+  bool InProcess;
+  int NumberOfThreads;
 
 };
 #endif
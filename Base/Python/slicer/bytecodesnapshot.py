@@ -0,0 +1,64 @@
+""" This module creates and uses a bytecode snapshot of the Python modules bundled with Slicer.
+
+Importing a module requires many file system calls (listing the ``sys.path`` directories,
+checking for source and cached bytecode files), which is slow when Slicer is installed on
+a network file system. The snapshot is a single zip file that contains the compiled bytecode
+of the bundled modules and packages: when it is at the front of ``sys.path``, these modules
+are imported from the zip file.
+
+The snapshot does not check whether the modules are modified after it is created, therefore
+it is only used with an installed Slicer, and a snapshot is created for each Slicer revision.
+It is enabled by the ``Python/BytecodeSnapshot`` setting.
+"""
+
+import logging
+import os
+import sys
+import tempfile
+import zipfile
+
+
+def createSnapshot(snapshotFilePath, directories):
+    """Compile the modules and packages found in the directories into a zip file.
+
+    Top-level modules and packages (subdirectories that contain ``__init__.py``) of each
+    directory are added. The snapshot file is replaced atomically.
+    """
+    snapshotDirectory = os.path.dirname(os.path.abspath(snapshotFilePath))
+    os.makedirs(snapshotDirectory, exist_ok=True)
+    fileDescriptor, temporaryFilePath = tempfile.mkstemp(suffix=".zip", dir=snapshotDirectory)
+    os.close(fileDescriptor)
+    try:
+        with zipfile.PyZipFile(temporaryFilePath, "w") as snapshot:
+            for directory in directories:
+                if not os.path.isdir(directory):
+                    continue
+                # Top-level modules
+                snapshot.writepy(directory)
+                # Packages
+                for entry in sorted(os.listdir(directory)):
+                    packageDirectory = os.path.join(directory, entry)
+                    if os.path.isfile(os.path.join(packageDirectory, "__init__.py")):
+                        snapshot.writepy(packageDirectory)
+        os.replace(temporaryFilePath, snapshotFilePath)
+    except Exception:
+        os.remove(temporaryFilePath)
+        raise
+
+
+def enableSnapshot(snapshotFilePath):
+    """Import the modules from the snapshot instead of their directories."""
+    if snapshotFilePath not in sys.path:
+        sys.path.insert(0, snapshotFilePath)
+
+
+def setup(snapshotFilePath):
+    """Enable the snapshot if it exists.
+
+    Returns True if the snapshot is enabled, False if it has to be created (see createSnapshot()).
+    """
+    if not os.path.isfile(snapshotFilePath):
+        return False
+    enableSnapshot(snapshotFilePath)
+    logging.debug(f"Python modules are imported from bytecode snapshot {snapshotFilePath}")
+    return True
@@ -0,0 +1,269 @@
+""" This module allows running a CLI module on a cohort of inputs, without a Slicer scene.
+
+Each job runs the CLI module executable in a separate process. Jobs are started on a pool of
+worker threads, the number of threads that each job may use is limited and the memory
+that the running jobs are expected to need is kept below a budget.
+
+The module can be used as a command-line tool::
+
+  PythonSlicer -m slicer.clibatch --module /path/to/cli-modules/AddScalarVolumes \\
+    --parameters template.json --inputs subjects.csv --report report.csv
+
+``template.json`` contains the parameters of the module, for example
+``{"inputVolume1": "{subject}/T1.nrrd", "inputVolume2": "{subject}/T2.nrrd", "outputVolume": "{subject}/sum.nrrd"}``,
+where ``{subject}`` is replaced by the ``subject`` column of ``subjects.csv``.
+"""
+
+import csv
+import json
+import logging
+import os
+import subprocess
+import threading
+import time
+import xml.etree.ElementTree as ElementTree
+from concurrent.futures import ThreadPoolExecutor
+
+
+# Parameter types that refer to files read by the module (when their channel is input)
+_fileParameterTypes = ("file", "image", "geometry", "transform", "table", "measurement", "pointfile")
+
+_moduleDescriptionCache = {}
+_moduleDescriptionCacheLock = threading.Lock()
+
+
+def _commandPrefix(module):
+    if isinstance(module, str):
+        return [module]
+    return list(module)
+
+
+def getModuleDescription(module):
+    """Get the parameters of a CLI module from its XML description.
+
+    module: path of the module executable, or list of the program and arguments that start the module.
+
+    The description is retrieved by running the module with ``--xml`` the first time, then it is
+    cached, so that it is not retrieved again for each job.
+
+    Returns a dictionary that maps parameter names to dictionaries with ``type``, ``channel``,
+    ``flag``, ``longflag`` and ``index`` keys.
+    """
+    key = tuple(_commandPrefix(module))
+    with _moduleDescriptionCacheLock:
+        if key in _moduleDescriptionCache:
+            return _moduleDescriptionCache[key]
+    xmlDescription = subprocess.run(list(key) + ["--xml"], check=True, capture_output=True).stdout
+    description = parseModuleDescription(xmlDescription)
+    with _moduleDescriptionCacheLock:
+        _moduleDescriptionCache[key] = description
+    return description
+
+
+def parseModuleDescription(xmlDescription):
+    """Get the parameters of a CLI module from its XML description (string or bytes).
+    See getModuleDescription().
+    """
+    root = ElementTree.fromstring(xmlDescription)
+    parameters = {}
+    for parameterGroup in root.iter("parameters"):
+        for parameter in parameterGroup:
+            name = parameter.findtext("name")
+            if not name:
+                continue
+            index = parameter.findtext("index")
+            parameters[name.strip()] = {
+                "type": parameter.tag,
+                "channel": (parameter.findtext("channel") or "input").strip(),
+                "flag": (parameter.findtext("flag") or "").strip(),
+                "longflag": (parameter.findtext("longflag") or "").strip(),
+                "index": int(index) if index is not None else None,
+            }
+    return parameters
+
+
+def buildCommandLine(module, description, parameters):
+    """Build the command line that runs the module with the given parameters.
+
+    description: parameters of the module, see getModuleDescription().
+    parameters: dictionary of (parameterName, parameterValue) pairs. Lists and tuples are passed as
+      comma-separated strings, boolean parameters are passed as a flag if they are True.
+    """
+    flagArguments = []
+    indexArguments = []
+    for name, value in parameters.items():
+        if name not in description:
+            raise ValueError(f"Module has no parameter named '{name}'")
+        parameter = description[name]
+        if isinstance(value, (list, tuple)):
+            value = ",".join(str(item) for item in value)
+        if parameter["index"] is not None:
+            indexArguments.append((parameter["index"], str(value)))
+            continue
+        flag = ("--" + parameter["longflag"].lstrip("-")) if parameter["longflag"] else ("-" + parameter["flag"].lstrip("-"))
+        if parameter["type"] == "boolean":
+            if value is True or str(value).lower() == "true":
+                flagArguments.append(flag)
+            continue
+        flagArguments += [flag, str(value)]
+    return _commandPrefix(module) + flagArguments + [value for index, value in sorted(indexArguments)]
+
+
+def _substitute(value, variables):
+    if isinstance(value, str):
+        return value.format_map(variables)
+    if isinstance(value, (list, tuple)):
+        return [_substitute(item, variables) for item in value]
+    return value
+
+
+class _MemoryBudget:
+    """Block jobs until the estimated memory of the running jobs fits in the budget.
+    A job that needs more than the whole budget is run when no other job is running."""
+
+    def __init__(self, budget):
+        self.budget = budget
+        self.used = 0
+        self.condition = threading.Condition()
+
+    def acquire(self, size):
+        if not self.budget:
+            return
+        with self.condition:
+            self.condition.wait_for(lambda: self.used == 0 or self.used + size <= self.budget)
+            self.used += size
+
+    def release(self, size):
+        if not self.budget:
+            return
+        with self.condition:
+            self.used -= size
+            self.condition.notify_all()
+
+
+def runBatch(module, parameterTemplate, inputs, numberOfWorkers=None, numberOfThreadsPerJob=None,
+             memoryBudgetMB=None, memoryFactor=4.0, timeout=None, reportFilePath=None):
+    """Run a CLI module once for each item of the inputs, without using a Slicer scene.
+
+    module: path of the module executable, or list of the program and arguments that start the module.
+    parameterTemplate: dictionary of (parameterName, parameterValue) pairs. ``{key}`` placeholders in
+      string values are replaced by the values of the input.
+    inputs: list of dictionaries, one for each job, that contain the values of the placeholders.
+    numberOfWorkers: number of jobs that run concurrently, the number of cores by default.
+    numberOfThreadsPerJob: number of threads that each job may use (applied to ITK and vtkSMPTools through
+      environment variables). By default the cores are shared equally between the workers.
+    memoryBudgetMB: jobs are not started while the estimated memory of the running jobs would exceed
+      this budget (in megabytes). No limit by default.
+    memoryFactor: estimated memory of a job is the total size of its input files multiplied by this factor.
+    timeout: a job is stopped if it runs for more than this number of seconds.
+    reportFilePath: if specified, the results of the jobs are written to this CSV file.
+
+    Returns the list of job results (dictionaries), in the order of the inputs.
+    """
+    description = getModuleDescription(module)
+    numberOfCores = os.cpu_count() or 1
+    if not numberOfWorkers:
+        numberOfWorkers = numberOfCores
+    if not numberOfThreadsPerJob:
+        numberOfThreadsPerJob = max(1, numberOfCores // numberOfWorkers)
+    memoryBudget = _MemoryBudget(int(memoryBudgetMB * 1024 * 1024) if memoryBudgetMB else None)
+
+    environment = dict(os.environ)
+    environment["ITK_GLOBAL_DEFAULT_NUMBER_OF_THREADS"] = str(numberOfThreadsPerJob)
+    environment["VTK_SMP_MAX_THREADS"] = str(numberOfThreadsPerJob)
+
+    batchStartTime = time.perf_counter()
+    completedJobs = [0]
+    completedJobsLock = threading.Lock()
+
+    def runJob(jobIndex, variables):
+        result = {"job": jobIndex, "status": "", "returnCode": "", "startTime": "", "duration": "",
+                  "estimatedMemoryMB": "", "throughput": "", "error": ""}
+        try:
+            parameters = {name: _substitute(value, variables) for name, value in parameterTemplate.items()}
+            command = buildCommandLine(module, description, parameters)
+        except (KeyError, ValueError) as e:
+            result["status"] = "Failed"
+            result["error"] = str(e)
+            return result
+        estimatedMemory = 0
+        for name, value in parameters.items():
+            parameter = description[name]
+            if parameter["channel"] == "input" and parameter["type"] in _fileParameterTypes and os.path.isfile(str(value)):
+                estimatedMemory += os.path.getsize(str(value))
+        estimatedMemory = int(estimatedMemory * memoryFactor)
+        result["estimatedMemoryMB"] = f"{estimatedMemory / (1024 * 1024):.1f}"
+
+        memoryBudget.acquire(estimatedMemory)
+        try:
+            startTime = time.perf_counter()
+            result["startTime"] = f"{startTime - batchStartTime:.3f}"
+            try:
+                process = subprocess.run(command, env=environment, capture_output=True, text=True, timeout=timeout)
+                result["returnCode"] = process.returncode
+                result["status"] = "Completed" if process.returncode == 0 else "CompletedWithErrors"
+                if process.returncode != 0:
+                    result["error"] = process.stderr.strip()
+            except subprocess.TimeoutExpired:
+                result["status"] = "TimedOut"
+            except OSError as e:
+                result["status"] = "Failed"
+                result["error"] = str(e)
+            endTime = time.perf_counter()
+            result["duration"] = f"{endTime - startTime:.3f}"
+        finally:
+            memoryBudget.release(estimatedMemory)
+
+        with completedJobsLock:
+            completedJobs[0] += 1
+            # jobs per minute since the start of the batch
+            result["throughput"] = f"{completedJobs[0] * 60.0 / (endTime - batchStartTime):.3f}"
+        logging.info(f"Job {jobIndex}: {result['status']} in {result['duration']}s")
+        return result
+
+    with ThreadPoolExecutor(max_workers=numberOfWorkers) as executor:
+        futures = [executor.submit(runJob, jobIndex, variables) for jobIndex, variables in enumerate(inputs)]
+        results = [future.result() for future in futures]
+
+    if reportFilePath:
+        with open(reportFilePath, "w", newline="") as reportFile:
+            writer = csv.DictWriter(reportFile, fieldnames=list(results[0].keys()) if results else ["job"])
+            writer.writeheader()
+            writer.writerows(results)
+
+    return results
+
+
+def main(argv=None):
+    import argparse
+    parser = argparse.ArgumentParser(description="Run a CLI module on a list of inputs.")
+    parser.add_argument("--module", required=True, help="path of the CLI module executable")
+    parser.add_argument("--parameters", required=True,
+                        help="JSON file that contains the parameters of the module, with {column} placeholders")
+    parser.add_argument("--inputs", required=True, help="CSV file that contains one row of placeholder values per job")
+    parser.add_argument("--workers", type=int, default=None, help="number of jobs that run concurrently")
+    parser.add_argument("--threads-per-job", type=int, default=None, help="number of threads of each job")
+    parser.add_argument("--memory-budget", type=float, default=None, help="memory budget of the running jobs, in MB")
+    parser.add_argument("--memory-factor", type=float, default=4.0,
+                        help="estimated memory of a job, relative to the size of its input files")
+    parser.add_argument("--timeout", type=float, default=None, help="maximum duration of a job, in seconds")
+    parser.add_argument("--report", default=None, help="CSV file where the result of each job is written")
+    args = parser.parse_args(argv)
+
+    with open(args.parameters) as parametersFile:
+        parameterTemplate = json.load(parametersFile)
+    with open(args.inputs, newline="") as inputsFile:
+        inputs = list(csv.DictReader(inputsFile))
+
+    logging.basicConfig(level=logging.INFO)
+    results = runBatch(args.module, parameterTemplate, inputs, numberOfWorkers=args.workers,
+                       numberOfThreadsPerJob=args.threads_per_job, memoryBudgetMB=args.memory_budget,
+                       memoryFactor=args.memory_factor, timeout=args.timeout, reportFilePath=args.report)
+    failedJobs = [result for result in results if result["status"] != "Completed"]
+    logging.info(f"{len(results) - len(failedJobs)} of {len(results)} jobs completed successfully")
+    return 1 if failedJobs else 0
+
+
+if __name__ == "__main__":
+    import sys
+    sys.exit(main())
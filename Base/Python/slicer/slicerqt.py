@@ -151,6 +151,8 @@ class _Internal:
             factoryManager.connect('modulesRegistered(QStringList)', self.setSlicerModuleNames)
             moduleManager.connect('moduleLoaded(QString)', self.setSlicerModules)
             moduleManager.connect('moduleAboutToBeUnloaded(QString)', self.unsetSlicerModule)
+            # Modules whose instantiation has been deferred are loaded when they are accessed
+            slicer.modules.__getattr__ = self.getDeferredSlicerModule
 
         # Retrieve current instance of the scene and set 'slicer.mrmlScene'
         setattr(slicer, 'mrmlScene', slicer.app.mrmlScene())
@@ -190,6 +192,21 @@ class _Internal:
         if moduleName == 'DWIConvert':
             setattr(slicer.modules, 'dicomtonrrdconverter', moduleManager.module(moduleName))
 
+    def getDeferredSlicerModule(self, attributeName):
+        """Load the module when ``slicer.modules.<modulename>`` or ``slicer.modules.<ModuleName>Instance``
+        is accessed and the instantiation of the module has been deferred.
+        """
+        moduleManager = slicer.app.moduleManager()
+        if not attributeName.startswith("__"):
+            for moduleName in moduleManager.factoryManager().deferredModuleNames():
+                if attributeName in (moduleName.lower(), moduleName + "Instance"):
+                    # Loading the module sets the attributes, see setSlicerModules()
+                    moduleManager.module(moduleName)
+                    break
+        if attributeName in vars(slicer.modules):
+            return vars(slicer.modules)[attributeName]
+        raise AttributeError(f"module 'slicer.modules' has no attribute '{attributeName}'")
+
     def unsetSlicerModule(self, moduleName):
         """Remove attribute from ``slicer.modules``
         """
@@ -0,0 +1,45 @@
+import importlib
+import os
+import sys
+import tempfile
+import unittest
+import zipfile
+
+import slicer.bytecodesnapshot
+
+
+class SlicerBytecodeSnapshotTests(unittest.TestCase):
+
+    def setUp(self):
+        self.tempDir = tempfile.TemporaryDirectory()
+        self.modulesDir = os.path.join(self.tempDir.name, "modules")
+        os.makedirs(os.path.join(self.modulesDir, "SnapshotTestPackage"))
+        with open(os.path.join(self.modulesDir, "SnapshotTestModule.py"), "w") as moduleFile:
+            moduleFile.write("value = 1\n")
+        with open(os.path.join(self.modulesDir, "SnapshotTestPackage", "__init__.py"), "w") as moduleFile:
+            moduleFile.write("value = 2\n")
+        self.snapshotFilePath = os.path.join(self.tempDir.name, "cache", "snapshot.zip")
+
+    def tearDown(self):
+        if self.snapshotFilePath in sys.path:
+            sys.path.remove(self.snapshotFilePath)
+        for name in ["SnapshotTestModule", "SnapshotTestPackage"]:
+            sys.modules.pop(name, None)
+        self.tempDir.cleanup()
+
+    def test_snapshot(self):
+        self.assertFalse(slicer.bytecodesnapshot.setup(self.snapshotFilePath))
+        slicer.bytecodesnapshot.createSnapshot(self.snapshotFilePath, [self.modulesDir, "/nonexistent"])
+        with zipfile.ZipFile(self.snapshotFilePath) as snapshot:
+            names = snapshot.namelist()
+        self.assertTrue(any(name.startswith("SnapshotTestModule.") for name in names))
+        self.assertTrue(any(name.startswith("SnapshotTestPackage/__init__.") for name in names))
+
+        self.assertTrue(slicer.bytecodesnapshot.setup(self.snapshotFilePath))
+        self.assertEqual(sys.path[0], self.snapshotFilePath)
+        importlib.invalidate_caches()
+        module = importlib.import_module("SnapshotTestModule")
+        self.assertEqual(module.value, 1)
+        self.assertTrue(module.__file__.startswith(self.snapshotFilePath))
+        package = importlib.import_module("SnapshotTestPackage")
+        self.assertEqual(package.value, 2)
@@ -0,0 +1,96 @@
+import csv
+import os
+import sys
+import tempfile
+import textwrap
+import unittest
+
+import slicer.clibatch
+
+
+# Minimal CLI module that copies the input file to the output file
+_moduleScript = textwrap.dedent('''
+    import shutil
+    import sys
+    if sys.argv[1:] == ["--xml"]:
+        print("""<?xml version="1.0" encoding="utf-8"?>
+    <executable>
+      <title>Copy</title>
+      <parameters>
+        <label>IO</label>
+        <boolean>
+          <name>fail</name>
+          <longflag>--fail</longflag>
+          <default>false</default>
+        </boolean>
+        <file>
+          <name>inputFile</name>
+          <channel>input</channel>
+          <index>0</index>
+        </file>
+        <file>
+          <name>outputFile</name>
+          <channel>output</channel>
+          <index>1</index>
+        </file>
+      </parameters>
+    </executable>""")
+        sys.exit(0)
+    if sys.argv[1] == "--fail":
+        sys.exit(2)
+    shutil.copyfile(sys.argv[1], sys.argv[2])
+    ''')
+
+
+class SlicerCLIBatchTests(unittest.TestCase):
+
+    def setUp(self):
+        self.tempDir = tempfile.TemporaryDirectory()
+        self.moduleScriptPath = os.path.join(self.tempDir.name, "CopyModule.py")
+        with open(self.moduleScriptPath, "w") as moduleScript:
+            moduleScript.write(_moduleScript)
+        self.module = [sys.executable, self.moduleScriptPath]
+        for subject in ["a", "b", "c"]:
+            with open(os.path.join(self.tempDir.name, f"{subject}.txt"), "w") as inputFile:
+                inputFile.write(subject)
+
+    def tearDown(self):
+        self.tempDir.cleanup()
+
+    def test_buildCommandLine(self):
+        description = slicer.clibatch.getModuleDescription(self.module)
+        self.assertEqual(description["inputFile"]["index"], 0)
+        self.assertEqual(description["fail"]["type"], "boolean")
+        command = slicer.clibatch.buildCommandLine(self.module, description,
+                                                   {"outputFile": "out", "inputFile": "in", "fail": False})
+        self.assertEqual(command, self.module + ["in", "out"])
+        command = slicer.clibatch.buildCommandLine(self.module, description, {"fail": True})
+        self.assertEqual(command, self.module + ["--fail"])
+        with self.assertRaises(ValueError):
+            slicer.clibatch.buildCommandLine(self.module, description, {"unknown": 1})
+
+    def test_runBatch(self):
+        template = {
+            "inputFile": os.path.join(self.tempDir.name, "{subject}.txt"),
+            "outputFile": os.path.join(self.tempDir.name, "{subject}_copy.txt"),
+        }
+        inputs = [{"subject": "a"}, {"subject": "b"}, {"subject": "c"}]
+        reportFilePath = os.path.join(self.tempDir.name, "report.csv")
+        results = slicer.clibatch.runBatch(self.module, template, inputs, numberOfWorkers=2,
+                                           memoryBudgetMB=1, reportFilePath=reportFilePath)
+        self.assertEqual([result["status"] for result in results], ["Completed"] * 3)
+        for subject in ["a", "b", "c"]:
+            with open(os.path.join(self.tempDir.name, f"{subject}_copy.txt")) as outputFile:
+                self.assertEqual(outputFile.read(), subject)
+        with open(reportFilePath, newline="") as reportFile:
+            report = list(csv.DictReader(reportFile))
+        self.assertEqual(len(report), 3)
+        self.assertGreater(float(report[0]["duration"]), 0.0)
+
+        results = slicer.clibatch.runBatch(self.module, {"fail": True}, [{}])
+        self.assertEqual(results[0]["status"], "CompletedWithErrors")
+        self.assertEqual(results[0]["returnCode"], 2)
+
+        # missing placeholder value
+        results = slicer.clibatch.runBatch(self.module, template, [{"other": "a"}])
+        self.assertEqual(results[0]["status"], "Failed")
@@ -1621,8 +1621,11 @@ def arrayFromVolume(volumeNode):
     """Return voxel array from volume node as numpy array.
 
     Voxels values are not copied. Voxel values in the volume node can be modified
-    by changing values in the numpy array.
-    After all modifications has been completed, call :py:meth:`arrayFromVolumeModified`.
+    by changing values in the numpy array. If the voxels are shared with another volume
+    (e.g., the volume was created by cloning) then they are copied once, so that modifying
+    the array does not change the other volume.
+    After all modifications has been completed, call :py:meth:`arrayFromVolumeModified`,
+    or make the modifications within :py:meth:`modifyArrayFromVolume`, which calls it automatically.
 
     :raises RuntimeError: in case of failure
 
@@ -1638,8 +1641,8 @@ def arrayFromVolume(volumeNode):
     scalarTypes = ['vtkMRMLScalarVolumeNode', 'vtkMRMLLabelMapVolumeNode']
     vectorTypes = ['vtkMRMLVectorVolumeNode', 'vtkMRMLMultiVolumeNode', 'vtkMRMLDiffusionWeightedVolumeNode']
     tensorTypes = ['vtkMRMLDiffusionTensorVolumeNode']
-    vimage = volumeNode.GetImageData()
-    nshape = tuple(reversed(volumeNode.GetImageData().GetDimensions()))
+    vimage = volumeNode.GetImageDataForModification()
+    nshape = tuple(reversed(vimage.GetDimensions()))
     import vtk.util.numpy_support
     narray = None
     if volumeNode.GetClassName() in scalarTypes:
@@ -1656,8 +1659,17 @@ def arrayFromVolume(volumeNode):
     return narray
 
 
-def arrayFromVolumeModified(volumeNode):
-    """Indicate that modification of a numpy array returned by :py:meth:`arrayFromVolume` has been completed."""
+def arrayFromVolumeModified(volumeNode, modifiedExtent=None):
+    """Indicate that modification of a numpy array returned by :py:meth:`arrayFromVolume` has been completed.
+
+    :param modifiedExtent: IJK extent ``[iMin, iMax, jMin, jMax, kMin, kMax]`` of the voxels that have
+      been modified (note that the numpy array is indexed as ``[k, j, i]``). If specified, observers of the
+      volume may update only this region (see ``vtkMRMLVolumeNode::GetImageDataModifiedExtent``).
+      By default the whole volume is considered modified.
+    """
+    if modifiedExtent is not None:
+        volumeNode.ImageDataModifiedInExtent([int(bound) for bound in modifiedExtent])
+        return
     imageData = volumeNode.GetImageData()
     pointData = imageData.GetPointData() if imageData else None
     if pointData:
@@ -2957,6 +2969,48 @@ def tryWithErrorDisplay(message=None, show=True, waitCursor=False):
         raise
 
 
+@contextmanager
+def modifyArrayFromVolume(volumeNode, modifiedExtent=None):
+    """Give access to the voxel array of a volume node as a numpy array for modification.
+
+    Voxels are not copied (see :py:meth:`arrayFromVolume`). When the context manager exits,
+    :py:meth:`arrayFromVolumeModified` is called, even if an exception is raised.
+
+    :param modifiedExtent: IJK extent ``[iMin, iMax, jMin, jMax, kMin, kMax]`` of the voxels that are modified.
+      Observers of the volume may update only this region. By default the whole volume is considered modified.
+
+    .. code-block:: python
+
+      # Set a 10x10x10 block of voxels to 0
+      with slicer.util.modifyArrayFromVolume(volumeNode, modifiedExtent=[20, 29, 40, 49, 10, 19]) as voxels:
+        voxels[10:20, 40:50, 20:30] = 0
+    """
+    narray = arrayFromVolume(volumeNode)
+    try:
+        yield narray
+    finally:
+        arrayFromVolumeModified(volumeNode, modifiedExtent)
+
+
+@contextmanager
+def modifyArrayFromModelPoints(modelNode):
+    """Give access to the point positions of a model node as a numpy array for modification.
+
+    Points are not copied (see :py:meth:`arrayFromModelPoints`). When the context manager exits,
+    :py:meth:`arrayFromModelPointsModified` is called, even if an exception is raised.
+
+    .. code-block:: python
+
+      with slicer.util.modifyArrayFromModelPoints(modelNode) as points:
+        points[:, 2] += 10.0
+    """
+    narray = arrayFromModelPoints(modelNode)
+    try:
+        yield narray
+    finally:
+        arrayFromModelPointsModified(modelNode)
+
+
 def toBool(value):
     """Convert any type of value to a boolean.
 
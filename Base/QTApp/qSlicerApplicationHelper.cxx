@@ -21,6 +21,8 @@
 #include "qSlicerApplicationHelper.h"
 
 // Qt includes
+#include <QDir>
+#include <QFileInfo>
 #include <QFont>
 #include <QLabel>
 #include <QSettings>
@@ -40,6 +42,7 @@
 #include "qSlicerLoadableModuleFactory.h"
 #include "qSlicerModuleFactoryManager.h"
 #include "qSlicerModuleManager.h"
+#include "qSlicerStartupTracer.h"
 
 #ifdef Slicer_USE_PYTHONQT
 # include "qSlicerScriptedLoadableModuleFactory.h"
@@ -89,7 +92,10 @@ void qSlicerApplicationHelper::preInitializeApplication(
     const char* argv0, ctkProxyStyle* style)
 {
   vtkLogger::SetStderrVerbosity(vtkLogger::VERBOSITY_OFF);
-  itk::itkFactoryRegistration();
+  {
+    qSlicerStartupTracer::Span span("ITK factory registration");
+    itk::itkFactoryRegistration();
+  }
   qMRMLWidget::preInitializeApplication();
 
   // Allow a custom application name so that the settings
@@ -183,6 +189,8 @@ void qSlicerApplicationHelper::setupModuleFactoryManager(qSlicerModuleFactoryMan
 
     qSlicerCLIExecutableModuleFactory* cliExecutableFactory = new qSlicerCLIExecutableModuleFactory();
     cliExecutableFactory->setTempDirectory(tempDirectory);
+    cliExecutableFactory->setXmlModuleDescriptionCacheDirectory(
+      QDir(app->cachePath()).filePath("CLIModuleDescriptions"));
     moduleFactoryManager->registerFactory(cliExecutableFactory, preferExecutableCLIs ? 1 : 0);
 
     if (!options->disableBuiltInModules() &&
@@ -215,6 +223,15 @@ void qSlicerApplicationHelper::setupModuleFactoryManager(qSlicerModuleFactoryMan
   QStringList modulesToIgnore = modulesToAlwaysIgnore << modulesToTemporarlyIgnore;
   moduleFactoryManager->setModulesToIgnore(modulesToIgnore);
 
+  // Metadata of the modules is cached so that, if lazy loading is enabled, modules
+  // are only instantiated when they are first needed.
+  QString cacheDirectory = QFileInfo(app->slicerRevisionUserSettingsFilePath()).absolutePath();
+  moduleFactoryManager->setModuleMetadataCacheFilePath(cacheDirectory + "/ModuleMetadataCache.ini");
+  moduleFactoryManager->setModuleDiscoveryCacheFilePath(cacheDirectory + "/ModuleDiscoveryCache.ini");
+  moduleFactoryManager->setLazyInstantiation(
+    app->revisionUserSettings()->value("Modules/LazyLoading", false).toBool()
+    && !app->testAttribute(qSlicerCoreApplication::AA_EnableTesting));
+
   moduleFactoryManager->setVerboseModuleDiscovery(app->commandOptions()->verboseModuleDiscovery());
 }
 
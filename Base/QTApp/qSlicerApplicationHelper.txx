@@ -45,6 +45,7 @@
 #include "qSlicerCommandOptions.h"
 #include "qSlicerModuleFactoryManager.h"
 #include "qSlicerModuleManager.h"
+#include "qSlicerStartupTracer.h"
 
 namespace
 {
@@ -153,14 +154,20 @@ int qSlicerApplicationHelper::postInitializeApplication(
 
   // Register and instantiate modules
   splashMessage(splashScreen, "Registering modules...");
-  moduleFactoryManager->registerModules();
+  {
+    qSlicerStartupTracer::Span span("Module registration");
+    moduleFactoryManager->registerModules();
+  }
   if (app.commandOptions()->verboseModuleDiscovery())
     {
     qDebug() << "Number of registered modules:"
              << moduleFactoryManager->registeredModuleNames().count();
     }
   splashMessage(splashScreen, "Instantiating modules...");
-  moduleFactoryManager->instantiateModules();
+  {
+    qSlicerStartupTracer::Span span("Module instantiation");
+    moduleFactoryManager->instantiateModules();
+  }
   if (app.commandOptions()->verboseModuleDiscovery())
     {
     qDebug() << "Number of instantiated modules:"
@@ -168,7 +175,9 @@ int qSlicerApplicationHelper::postInitializeApplication(
     }
 
   QStringList failedToBeInstantiatedModuleNames = ctk::qSetToQStringList(
-        ctk::qStringListToQSet(moduleFactoryManager->registeredModuleNames()) - ctk::qStringListToQSet(moduleFactoryManager->instantiatedModuleNames()));
+        ctk::qStringListToQSet(moduleFactoryManager->registeredModuleNames())
+        - ctk::qStringListToQSet(moduleFactoryManager->instantiatedModuleNames())
+        - ctk::qStringListToQSet(moduleFactoryManager->deferredModuleNames()));
   if (!failedToBeInstantiatedModuleNames.isEmpty())
     {
     qCritical() << "The following modules failed to be instantiated:";
@@ -188,6 +197,7 @@ int qSlicerApplicationHelper::postInitializeApplication(
   splashMessage(splashScreen, "Initializing user interface...");
   if (enableMainWindow)
     {
+    qSlicerStartupTracer::Span span("Main window creation");
     window.reset(new SlicerMainWindowType);
     }
   else if (app.commandOptions()->showPythonInteractor()
@@ -205,12 +215,15 @@ int qSlicerApplicationHelper::postInitializeApplication(
     }
 
   // Load all available modules
+  {
+  qSlicerStartupTracer::Span span("Module loading");
   foreach(const QString& name, moduleFactoryManager->instantiatedModuleNames())
     {
     Q_ASSERT(!name.isNull());
     splashMessage(splashScreen, "Loading module \"" + name + "\"...");
     moduleFactoryManager->loadModule(name);
     }
+  }
   if (app.commandOptions()->verboseModuleDiscovery())
     {
     qDebug() << "Number of loaded modules:" << moduleManager->modulesNames().count();
@@ -218,6 +231,23 @@ int qSlicerApplicationHelper::postInitializeApplication(
 
   splashMessage(splashScreen, QString());
 
+  QString startupTraceFilePath = app.commandOptions()->startupTraceFilePath();
+  if (!startupTraceFilePath.isEmpty())
+    {
+    // Startup ends when the application is idle with the main window shown
+    qint64 showStartTime = qSlicerStartupTracer::currentTime();
+    QObject::connect(&app, &qSlicerApplication::startupCompleted, [startupTraceFilePath, showStartTime]()
+      {
+      qSlicerStartupTracer::addSpan("Main window show and layout", "startup",
+        showStartTime, qSlicerStartupTracer::currentTime() - showStartTime);
+      if (!qSlicerStartupTracer::writeTrace(startupTraceFilePath))
+        {
+        qWarning() << "Failed to write startup trace to" << startupTraceFilePath;
+        }
+      qSlicerStartupTracer::setEnabled(false);
+      });
+    }
+
   if (window)
     {
     QObject::connect(window.data(), SIGNAL(initialWindowShown()), &app, SIGNAL(startupCompleted()));
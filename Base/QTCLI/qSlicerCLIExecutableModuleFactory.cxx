@@ -19,13 +19,19 @@
 ==============================================================================*/
 
 // Qt includes
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QProcess>
+#include <QRunnable>
+#include <QSaveFile>
 #include <QStandardPaths>
+#include <QThreadPool>
 
 // Slicer includes
 #include "qSlicerCLIExecutableModuleFactory.h"
 #include "qSlicerCLIModule.h"
 #include "qSlicerCLIModuleFactoryHelper.h"
+#include "qSlicerStartupTracer.h"
 #include "qSlicerUtils.h"
 #include <vtkSlicerCLIModuleLogic.h>
 
@@ -47,17 +53,54 @@ QString findPython()
 
 }
 
+//-----------------------------------------------------------------------------
+class qSlicerCLIExecutableModuleXmlDescriptionRunnable : public QRunnable
+{
+public:
+  qSlicerCLIExecutableModuleXmlDescriptionRunnable(qSlicerCLIExecutableModuleFactoryItem* item)
+    : Item(item)
+  {
+  }
+  void run() override
+  {
+    this->Item->retrieveXmlDescription();
+  }
+private:
+  qSlicerCLIExecutableModuleFactoryItem* Item;
+};
+
 //-----------------------------------------------------------------------------
 qSlicerCLIExecutableModuleFactoryItem::qSlicerCLIExecutableModuleFactoryItem(
-  const QString& newTempDirectory)
+  const QString& newTempDirectory, const QString& xmlCacheDirectory, QThreadPool* threadPool)
   : TempDirectory(newTempDirectory)
+  , XmlCacheDirectory(xmlCacheDirectory)
+  , ThreadPool(threadPool)
   , CLIModule(nullptr)
+  , XmlDescriptionPending(false)
 {
 }
 
+//-----------------------------------------------------------------------------
+qSlicerCLIExecutableModuleFactoryItem::~qSlicerCLIExecutableModuleFactoryItem()
+{
+  // The background thread must not outlive the item
+  if (this->XmlDescriptionPending)
+    {
+    this->XmlDescriptionRetrieved.acquire();
+    }
+}
+
 //-----------------------------------------------------------------------------
 bool qSlicerCLIExecutableModuleFactoryItem::load()
 {
+  // Items are loaded when registered, long before modules are instantiated:
+  // start retrieving XML descriptions now so that executables run concurrently.
+  if (this->ThreadPool && !this->XmlDescriptionPending
+      && !QFile::exists(this->xmlModuleDescriptionFilePath()))
+    {
+    this->XmlDescriptionPending = true;
+    this->ThreadPool->start(new qSlicerCLIExecutableModuleXmlDescriptionRunnable(this));
+    }
   return true;
 }
 
@@ -68,6 +111,82 @@ QString qSlicerCLIExecutableModuleFactoryItem::xmlModuleDescriptionFilePath()
   return QDir(info.path()).filePath(info.baseName() + ".xml");
 }
 
+//-----------------------------------------------------------------------------
+QString qSlicerCLIExecutableModuleFactoryItem::xmlModuleDescriptionCacheFilePath()
+{
+  QString absolutePath = QFileInfo(this->path()).absoluteFilePath();
+  QString hash = QCryptographicHash::hash(absolutePath.toUtf8(), QCryptographicHash::Md5).toHex();
+  return QDir(this->XmlCacheDirectory).filePath(
+    QFileInfo(this->path()).baseName() + "-" + hash + ".xml");
+}
+
+//-----------------------------------------------------------------------------
+QString qSlicerCLIExecutableModuleFactoryItem::xmlModuleDescriptionCacheKey()
+{
+  QFileInfo info(this->path());
+  return QString("%1|%2|%3").arg(info.absoluteFilePath())
+    .arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+}
+
+//-----------------------------------------------------------------------------
+QString qSlicerCLIExecutableModuleFactoryItem::readCachedXmlDescription()
+{
+  if (this->XmlCacheDirectory.isEmpty())
+    {
+    return QString();
+    }
+  QFile cacheFile(this->xmlModuleDescriptionCacheFilePath());
+  if (!cacheFile.open(QIODevice::ReadOnly))
+    {
+    return QString();
+    }
+  // First line identifies the executable the description was retrieved from
+  QTextStream stream(&cacheFile);
+  stream.setCodec("UTF-8");
+  if (stream.readLine() != this->xmlModuleDescriptionCacheKey())
+    {
+    return QString();
+    }
+  return stream.readAll();
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerCLIExecutableModuleFactoryItem::writeCachedXmlDescription(const QString& xmlDescription)
+{
+  if (this->XmlCacheDirectory.isEmpty() || !QDir().mkpath(this->XmlCacheDirectory))
+    {
+    return;
+    }
+  // Write in a temporary file first so that concurrent application
+  // instances never read a partially written description.
+  QSaveFile cacheFile(this->xmlModuleDescriptionCacheFilePath());
+  if (!cacheFile.open(QIODevice::WriteOnly))
+    {
+    return;
+    }
+  QTextStream stream(&cacheFile);
+  stream.setCodec("UTF-8");
+  stream << this->xmlModuleDescriptionCacheKey() << "\n" << xmlDescription;
+  stream.flush();
+  cacheFile.commit();
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerCLIExecutableModuleFactoryItem::retrieveXmlDescription()
+{
+  QString xmlDescription = this->readCachedXmlDescription();
+  if (xmlDescription.isEmpty())
+    {
+    xmlDescription = this->runCLIWithXmlArgument();
+    if (!xmlDescription.isEmpty())
+      {
+      this->writeCachedXmlDescription(xmlDescription);
+      }
+    }
+  this->XmlDescription = xmlDescription;
+  this->XmlDescriptionRetrieved.release();
+}
+
 //-----------------------------------------------------------------------------
 qSlicerAbstractCoreModule* qSlicerCLIExecutableModuleFactoryItem::instanciator()
 {
@@ -116,7 +235,15 @@ qSlicerAbstractCoreModule* qSlicerCLIExecutableModuleFactoryItem::instanciator()
     }
   else
     {
-    xmlDescription = this->runCLIWithXmlArgument();
+    if (!this->XmlDescriptionPending)
+      {
+      this->retrieveXmlDescription();
+      }
+    // wait for the background thread if it was started in load()
+    this->XmlDescriptionRetrieved.acquire();
+    this->XmlDescriptionPending = false;
+    xmlDescription = this->XmlDescription;
+    this->XmlDescription.clear();
     }
   if (xmlDescription.isEmpty())
     {
@@ -137,13 +264,15 @@ qSlicerAbstractCoreModule* qSlicerCLIExecutableModuleFactoryItem::instanciator()
 //-----------------------------------------------------------------------------
 QString qSlicerCLIExecutableModuleFactoryItem::runCLIWithXmlArgument()
 {
-  ctkScopedCurrentDir scopedCurrentDir(QFileInfo(this->path()).path());
-
   int cliProcessTimeoutInMs = 5000;
   QProcess cli;
+  // Do not change the current directory of the application: this may be
+  // called from several threads at the same time.
+  cli.setWorkingDirectory(QFileInfo(this->path()).path());
   QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
   env.insert("ITK_AUTOLOAD_PATH", "");
   cli.setProcessEnvironment(env);
+  qSlicerStartupTracer::Span span(QFileInfo(this->path()).fileName() + " --xml", "cli");
   cli.start(this->path(), QStringList(QString("--xml")));
   bool res = cli.waitForFinished(cliProcessTimeoutInMs);
   if (!res)
@@ -235,6 +364,10 @@ public:
 
 private:
   QString TempDirectory;
+  QString XmlCacheDirectory;
+
+  /// Thread pool used to run the executables with "--xml" concurrently.
+  QThreadPool ThreadPool;
 };
 
 //-----------------------------------------------------------------------------
@@ -285,7 +418,7 @@ ctkAbstractFactoryItem<qSlicerAbstractCoreModule>* qSlicerCLIExecutableModuleFac
 ::createFactoryFileBasedItem()
 {
   Q_D(qSlicerCLIExecutableModuleFactory);
-  return new qSlicerCLIExecutableModuleFactoryItem(d->TempDirectory);
+  return new qSlicerCLIExecutableModuleFactoryItem(d->TempDirectory, d->XmlCacheDirectory, &d->ThreadPool);
 }
 
 //-----------------------------------------------------------------------------
@@ -300,3 +433,17 @@ void qSlicerCLIExecutableModuleFactory::setTempDirectory(const QString& newTempD
   Q_D(qSlicerCLIExecutableModuleFactory);
   d->TempDirectory = newTempDirectory;
 }
+
+//-----------------------------------------------------------------------------
+void qSlicerCLIExecutableModuleFactory::setXmlModuleDescriptionCacheDirectory(const QString& cacheDirectory)
+{
+  Q_D(qSlicerCLIExecutableModuleFactory);
+  d->XmlCacheDirectory = cacheDirectory;
+}
+
+//-----------------------------------------------------------------------------
+QString qSlicerCLIExecutableModuleFactory::xmlModuleDescriptionCacheDirectory()const
+{
+  Q_D(const qSlicerCLIExecutableModuleFactory);
+  return d->XmlCacheDirectory;
+}
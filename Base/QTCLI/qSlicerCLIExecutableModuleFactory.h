@@ -30,23 +30,59 @@ class qSlicerCLIModule;
 #include <ctkPimpl.h>
 #include <ctkAbstractPluginFactory.h>
 
+// Qt includes
+#include <QSemaphore>
+class QThreadPool;
+
 //-----------------------------------------------------------------------------
 class qSlicerCLIExecutableModuleFactoryItem
   : public ctkAbstractFactoryFileBasedItem<qSlicerAbstractCoreModule>
 {
 public:
-  qSlicerCLIExecutableModuleFactoryItem(const QString& newTempDirectory);
+  /// If \a threadPool is set, the XML description of executables without
+  /// XML file is retrieved in a background thread as soon as the item is loaded.
+  /// If \a xmlCacheDirectory is not empty, XML descriptions retrieved by running
+  /// the executables are cached in this directory.
+  qSlicerCLIExecutableModuleFactoryItem(const QString& newTempDirectory,
+                                        const QString& xmlCacheDirectory = QString(),
+                                        QThreadPool* threadPool = nullptr);
+  ~qSlicerCLIExecutableModuleFactoryItem() override;
   bool load() override;
   void uninstantiate() override;
+
+  /// Retrieve the XML description from the cache or by running the executable.
+  /// Called from a background thread if a thread pool is set.
+  void retrieveXmlDescription();
+
 protected:
   /// Return path of the expected XML file.
   QString xmlModuleDescriptionFilePath();
 
+  /// Return path of the cached XML description.
+  QString xmlModuleDescriptionCacheFilePath();
+
+  /// Return a string identifying the current version of the executable
+  /// (path, size and last modification time).
+  QString xmlModuleDescriptionCacheKey();
+
+  /// Return the cached XML description or an empty string if there is none
+  /// or if the executable changed since it was cached.
+  QString readCachedXmlDescription();
+  void writeCachedXmlDescription(const QString& xmlDescription);
+
   qSlicerAbstractCoreModule* instanciator() override;
   QString runCLIWithXmlArgument();
 private:
   QString TempDirectory;
+  QString XmlCacheDirectory;
+  QThreadPool* ThreadPool;
   qSlicerCLIModule* CLIModule;
+
+  /// XML description retrieved by retrieveXmlDescription()
+  QString XmlDescription;
+  /// Released when XmlDescription is set by a background thread
+  QSemaphore XmlDescriptionRetrieved;
+  bool XmlDescriptionPending;
 };
 
 class qSlicerCLIExecutableModuleFactoryPrivate;
@@ -71,6 +107,13 @@ public:
 
   void setTempDirectory(const QString& newTempDirectory);
 
+  /// Directory where the XML descriptions of the executables are cached
+  /// between application sessions. Cached descriptions are invalidated when
+  /// the size or modification time of the executable changes.
+  /// The cache is disabled if the directory is empty (default).
+  void setXmlModuleDescriptionCacheDirectory(const QString& cacheDirectory);
+  QString xmlModuleDescriptionCacheDirectory()const;
+
 protected:
   bool isValidFile(const QFileInfo& file)const override;
 
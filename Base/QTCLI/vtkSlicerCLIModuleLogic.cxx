@@ -12,6 +12,7 @@
 
 #include "vtkSlicerCLIModuleLogic.h"
 
+#include "vtkSlicerApplicationLogic.h"
 #include "vtkSlicerTask.h"
 
 // SlicerExecutionModel includes
@@ -28,6 +29,7 @@
 #include <vtkMRMLROIListNode.h>
 #include <vtkMRMLStorageNode.h>
 #include <vtkMRMLModelStorageNode.h>
+#include <vtkMRMLTraceRecorder.h>
 #include <vtkMRMLTransformNode.h>
 
 // VTK includes
@@ -36,9 +38,14 @@
 #include <vtkMultiThreader.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
+#include <vtkSMPTools.h>
 #include <vtkStringArray.h>
+#include <vtkWeakPointer.h>
 #include <vtksys/SystemTools.hxx>
 
+// ITK includes
+#include <itkMultiThreaderBase.h>
+
 // ITKSYS includes
 #include <itksys/Process.h>
 #include <itksys/SystemTools.hxx>
@@ -51,9 +58,11 @@
 #include <algorithm>
 #include <cassert>
 #include <ctime>
+#include <map>
 #include <mutex>
 #include <random>
 #include <set>
+#include <vector>
 
 #ifdef _WIN32
 #else
@@ -61,6 +70,18 @@
 #include <unistd.h>
 #endif
 
+//----------------------------------------------------------------------------
+// Encode a node as slicer:%p#%s where the pointer is the address of the
+// scene which contains the node and the string is the MRML node ID.
+static std::string MemoryReference(vtkMRMLScene* scene, const std::string& nodeID)
+{
+  // Must be large enough to hold slicer:, #, an ascii
+  // representation of the scene pointer and the MRML node ID.
+  std::vector<char> tname(nodeID.size() + 100);
+  snprintf(tname.data(), tname.size(), "slicer:%p#%s", scene, nodeID.c_str());
+  return std::string(tname.data());
+}
+
 //----------------------------------------------------------------------------
 struct DigitsToCharacters
 {
@@ -188,6 +209,57 @@ public:
   ~vtkSlicerCLIOneShotCallbackCallback() override  = default;
 };
 
+//----------------------------------------------------------------------------
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Set the default number of ITK threads while shared object modules are running.
+/// The ITK default is process-wide, therefore it is only restored when the last
+/// running module is completed (concurrent modules are given the same number of threads).
+class ITKThreadBudgetGuard
+{
+public:
+  ITKThreadBudgetGuard(int numberOfThreads)
+    : NumberOfThreads(numberOfThreads)
+  {
+    if (this->NumberOfThreads <= 0)
+      {
+      return;
+      }
+    std::lock_guard<std::mutex> lock(Lock);
+    if (NumberOfGuards++ == 0)
+      {
+      PreviousNumberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+      }
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(this->NumberOfThreads);
+  }
+  ~ITKThreadBudgetGuard()
+  {
+    if (this->NumberOfThreads <= 0)
+      {
+      return;
+      }
+    std::lock_guard<std::mutex> lock(Lock);
+    if (--NumberOfGuards == 0)
+      {
+      itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(PreviousNumberOfThreads);
+      }
+  }
+
+private:
+  int NumberOfThreads;
+  static std::mutex Lock;
+  static int NumberOfGuards;
+  static itk::ThreadIdType PreviousNumberOfThreads;
+};
+
+std::mutex ITKThreadBudgetGuard::Lock;
+int ITKThreadBudgetGuard::NumberOfGuards = 0;
+itk::ThreadIdType ITKThreadBudgetGuard::PreviousNumberOfThreads = 0;
+
+}
+
 //----------------------------------------------------------------------------
 class vtkSlicerCLIModuleLogic::vtkInternal
 {
@@ -292,6 +364,11 @@ public:
   /// being executed with their.
   RequestType LastRequests;
 
+  /// Tasks of the CLI nodes that are scheduled but may not be started yet.
+  /// Only accessed from the main thread.
+  typedef std::map<vtkMRMLCommandLineModuleNode*, vtkWeakPointer<vtkSlicerTask> > ScheduledTasksType;
+  ScheduledTasksType ScheduledTasks;
+
   vtkSmartPointer<vtkSlicerCLIRescheduleCallback> RescheduleCallback;
   vtkSmartPointer<vtkSlicerCLIOneShotCallbackCallback>OneShotCallbackCallback;
 };
@@ -574,30 +651,34 @@ vtkSlicerCLIModuleLogic
       // tree.
 
       // Redefine the filename to be a reference to a slicer node.
-
-      // Must be large enough to hold slicer:, #, an ascii
-      // representation of the scene pointer and the MRML node ID.
-      char *tname = new char[name.size() + 100];
-
-      sprintf(tname, "slicer:%p#%s", this->GetMRMLScene(), name.c_str());
-
-      fname = tname;
-
-      delete [] tname;
+      fname = MemoryReference(this->GetMRMLScene(), name);
       }
     }
 
   if (tag == "geometry")
     {
-    // geometry is currently always passed via files
-
     // Use default fname construction, tack on extension
     std::string ext = ".vtp";
     if (extensions.size() != 0)
       {
       ext = extensions[0];
       }
-    fname = fname + ext;
+
+    // Shared object modules read and write models with
+    // vtkMRMLModelStorageNode, which shares the mesh of a referenced
+    // slicer node. Fiber bundles and aggregated models (.mrml) are
+    // passed via files.
+    if (commandType == CommandLineModule
+        || type == "fiberbundle"
+        || ext == ".mrml"
+        || this->GetAllowInMemoryTransfer() == 0)
+      {
+      fname = fname + ext;
+      }
+    else
+      {
+      fname = MemoryReference(this->GetMRMLScene(), name);
+      }
     }
 
   if (tag == "transform")
@@ -698,12 +779,16 @@ void vtkSlicerCLIModuleLogic::KillProcesses()
 }
 
 //-----------------------------------------------------------------------------
-void vtkSlicerCLIModuleLogic::Apply ( vtkMRMLCommandLineModuleNode* node, bool updateDisplay )
+void vtkSlicerCLIModuleLogic::Apply ( vtkMRMLCommandLineModuleNode* node, bool updateDisplay, int priority )
 {
   bool ret;
 
   vtkNew<vtkSlicerTask> task;
   task->SetTypeToProcessing();
+  task->SetPriority(priority);
+  // Shared object modules run in the application process and redirect its
+  // standard output streams, so the number of them running concurrently is limited.
+  task->SetInProcess(node->GetModuleDescription().GetType() == "SharedObjectModule");
 
   // Pass the current node as client data to the task.  This allows
   // the user to switch to another parameter set after the task is
@@ -728,6 +813,7 @@ void vtkSlicerCLIModuleLogic::Apply ( vtkMRMLCommandLineModuleNode* node, bool u
     }
   else
     {
+    this->Internal->ScheduledTasks[node] = task.GetPointer();
     node->SetOutputText("", false);
     node->SetErrorText("", false);
     node->SetStatus(vtkMRMLCommandLineModuleNode::Scheduled);
@@ -824,6 +910,7 @@ void vtkSlicerCLIModuleLogic
 //
 void vtkSlicerCLIModuleLogic::ApplyTask(void *clientdata)
 {
+  vtkMRMLTraceScopeMacro("vtkSlicerCLIModuleLogic::ApplyTask");
   // check if MRML node is present
   if (clientdata == nullptr)
     {
@@ -1011,6 +1098,7 @@ void vtkSlicerCLIModuleLogic::ApplyTask(void *clientdata)
   MemoryTransferPossible.insert("vtkMRMLVectorVolumeNode");
   MemoryTransferPossible.insert("vtkMRMLDiffusionWeightedVolumeNode");
   MemoryTransferPossible.insert("vtkMRMLDiffusionTensorVolumeNode");
+  MemoryTransferPossible.insert("vtkMRMLModelNode");
 
   MRMLIDToFileNameMap::const_iterator id2fn0;
 
@@ -1079,7 +1167,8 @@ void vtkSlicerCLIModuleLogic::ApplyTask(void *clientdata)
       // Check if we can transfer the datatype using a direct memory transfer
       if ((this->GetAllowInMemoryTransfer() == 0) ||
           std::find(MemoryTransferPossible.begin(), MemoryTransferPossible.end(),
-                    nd->GetClassName()) == MemoryTransferPossible.end())
+                    nd->GetClassName()) == MemoryTransferPossible.end() ||
+          (*id2fn0).second.find("slicer:") != 0)
         {
         // Cannot use a memory transfer, use a StorageNode
         out = defaultOut;
@@ -2091,9 +2180,22 @@ void vtkSlicerCLIModuleLogic::ApplyTask(void *clientdata)
         std::cerr.rdbuf( cerrstringstream.rdbuf() );
         }
 
-      // run the module
+      // run the module, limiting the number of threads to the budget given by the scheduler
       if ( entryPoint != nullptr ) {
-        returnValue = (*entryPoint)(commandLineAsString.size(), command);
+        vtkSlicerTask* task = vtkSlicerTask::GetCurrentTask();
+        int numberOfThreads = (task ? task->GetNumberOfThreads() : 0);
+        if (numberOfThreads > 0)
+          {
+          ITKThreadBudgetGuard itkThreadBudget(numberOfThreads);
+          vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads }, [&]()
+            {
+            returnValue = (*entryPoint)(commandLineAsString.size(), command);
+            });
+          }
+        else
+          {
+          returnValue = (*entryPoint)(commandLineAsString.size(), command);
+          }
       }
 
       // report the output
@@ -2634,7 +2736,32 @@ void vtkSlicerCLIModuleLogic
     switch(event)
       {
       case vtkCommand::ModifiedEvent:
+        {
+        vtkInternal::ScheduledTasksType::iterator taskIt = this->Internal->ScheduledTasks.find(cliNode);
+        if (taskIt == this->Internal->ScheduledTasks.end())
+          {
+          break;
+          }
+        if (cliNode->GetStatus() == vtkMRMLCommandLineModuleNode::Cancelling)
+          {
+          vtkSmartPointer<vtkSlicerTask> task = taskIt->second.GetPointer();
+          this->Internal->ScheduledTasks.erase(taskIt);
+          // If the module is not started yet, remove it from the queue
+          // instead of waiting for a processing thread to skip it.
+          if (task && this->GetApplicationLogic()->CancelTask(task))
+            {
+            cliNode->SetStatus(vtkMRMLCommandLineModuleNode::Cancelled);
+            // release the reference that ApplyTask() would have released
+            cliNode->UnRegister(this);
+            }
+          }
+        else if (cliNode->GetStatus() != vtkMRMLCommandLineModuleNode::Scheduled)
+          {
+          // the task has been started
+          this->Internal->ScheduledTasks.erase(taskIt);
+          }
         break;
+        }
       case vtkMRMLCommandLineModuleNode::AutoRunEvent:
         {
         vtkMTimeType requestTime = reinterpret_cast<vtkMTimeType>(callData);
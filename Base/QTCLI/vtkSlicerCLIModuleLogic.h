@@ -103,7 +103,12 @@ public:
   /// If \a updateDisplay is 'true' the selection node will be updated with the
   /// the created nodes, which would automatically select the created nodes
   /// in the node selectors.
-  void Apply( vtkMRMLCommandLineModuleNode* node, bool updateDisplay = true );
+  /// Modules scheduled with a higher \a priority are started first when
+  /// several modules are waiting for a processing thread.
+  /// Cancelling the node (vtkMRMLCommandLineModuleNode::Cancel()) before the
+  /// module is started removes it from the queue.
+  /// \sa vtkSlicerApplicationLogic::SetNumberOfProcessingThreads()
+  void Apply( vtkMRMLCommandLineModuleNode* node, bool updateDisplay = true, int priority = 0 );
 
   /// Don't start the CLI in a separate thread, but run it in the main thread.
   /// This methods is blocking until the CLI finishes to execute, the UI being
@@ -19,16 +19,119 @@
 ==============================================================================*/
 
 // Qt includes
+#include <QDateTime>
 #include <QDir>
+#include <QFile>
+#include <QLibrary>
+#include <QRunnable>
+#include <QSettings>
+#include <QThreadPool>
 
 // Slicer includes
 #include "qSlicerCoreApplication.h"
 #include "qSlicerAbstractModuleFactoryManager.h"
 #include "qSlicerAbstractCoreModule.h"
+#include "qSlicerStartupTracer.h"
 
 // STD includes
 #include <csignal>
 #include <typeinfo>
+#include <vector>
+
+namespace
+{
+
+typedef qSlicerAbstractModuleFactoryManager::qSlicerFileBasedModuleFactory qSlicerFileBasedModuleFactory;
+
+//-----------------------------------------------------------------------------
+/// Return the first factory that can register the file, nullptr if none.
+qSlicerFileBasedModuleFactory* moduleFileFactory(const QFileInfo& file,
+  const QVector<qSlicerFileBasedModuleFactory*>& factories)
+{
+  foreach(qSlicerFileBasedModuleFactory* factory, factories)
+    {
+    if (factory->isValidFile(file))
+      {
+      return factory;
+      }
+    }
+  return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+/// Module files found in a search path
+struct qSlicerModuleDirectoryScan
+{
+  QString Path;
+  QList<QFileInfo> Files;
+  /// Factory that recognized each file. Not set if the files are retrieved from the cache.
+  QList<qSlicerFileBasedModuleFactory*> FileFactories;
+  bool Cached = false;
+};
+
+//-----------------------------------------------------------------------------
+/// List the files of a search path and find the factory that recognizes each file.
+/// Factories only check the file names and contents, which can be done concurrently.
+class qSlicerModuleDirectoryScanRunnable : public QRunnable
+{
+public:
+  qSlicerModuleDirectoryScanRunnable(qSlicerModuleDirectoryScan* scan,
+                                     const QVector<qSlicerFileBasedModuleFactory*>& factories)
+    : Scan(scan)
+    , Factories(factories)
+  {
+  }
+
+  void run() override
+  {
+    qSlicerStartupTracer::Span span(this->Scan->Path, "module discovery");
+    foreach(const QFileInfo& file, QDir(this->Scan->Path).entryInfoList(QDir::Files))
+      {
+      qSlicerFileBasedModuleFactory* factory = moduleFileFactory(file, this->Factories);
+      if (factory)
+        {
+        this->Scan->Files << file;
+        this->Scan->FileFactories << factory;
+        }
+      }
+  }
+
+private:
+  qSlicerModuleDirectoryScan* Scan;
+  QVector<qSlicerFileBasedModuleFactory*> Factories;
+};
+
+//-----------------------------------------------------------------------------
+/// Read a library so that it is in the file system cache when it is loaded.
+/// Libraries are loaded (and their symbols resolved) on the main thread,
+/// because their static initializers (e.g. VTK object factory overrides) are
+/// not thread-safe.
+class qSlicerModuleLibraryPrefetchRunnable : public QRunnable
+{
+public:
+  qSlicerModuleLibraryPrefetchRunnable(const QString& filePath)
+    : FilePath(filePath)
+  {
+  }
+
+  void run() override
+  {
+    QFile file(this->FilePath);
+    if (!file.open(QIODevice::ReadOnly))
+      {
+      return;
+      }
+    std::vector<char> buffer(1 << 20);
+    while (file.read(buffer.data(), static_cast<qint64>(buffer.size())) > 0)
+      {
+      }
+  }
+
+private:
+  QString FilePath;
+};
+
+} // end of anonymous namespace
 
 //-----------------------------------------------------------------------------
 class qSlicerAbstractModuleFactoryManagerPrivate
@@ -52,6 +155,25 @@ public:
   // the risk of creating a nullptr entry if the module is not registered.
   qSlicerModuleFactory* registeredModuleFactory(const QString& moduleName)const;
 
+  /// Metadata of a module instance, as stored in the cache
+  QVariantMap moduleMetadata(qSlicerAbstractCoreModule* module)const;
+
+  /// Return the cached metadata of the module if the module file has not been
+  /// modified since it was cached, an empty map otherwise.
+  QVariantMap upToDateCachedModuleMetadata(const QString& moduleName)const;
+
+  void readModuleMetadataCache();
+  void writeModuleMetadataCache();
+
+  /// Identifies the registered file based factories. The discovery cache is
+  /// only valid for the same factories.
+  QString fileBasedFactoriesKey()const;
+  void readModuleDiscoveryCache();
+  void writeModuleDiscoveryCache();
+
+  /// Register the file with the factory that recognized it
+  void registerModule(const QFileInfo& file, qSlicerFileBasedModuleFactory* moduleFactory);
+
   QStringList SearchPaths;
   QStringList ExplicitModules;
   QStringList ModulesToIgnore;
@@ -59,6 +181,16 @@ public:
   QMap<qSlicerModuleFactory*, int> Factories;
   QMap<QString, qSlicerModuleFactory*> RegisteredModules;
   QMap<QString, QStringList> ModuleDependees;
+  QMap<QString, QFileInfo> ModuleFiles;
+
+  bool LazyInstantiation;
+  QString ModuleMetadataCacheFilePath;
+  QMap<QString, QVariantMap> CachedModuleMetadata;
+  QStringList DeferredModules;
+
+  QString ModuleDiscoveryCacheFilePath;
+  /// Module file names and modification time of each scanned search path
+  QMap<QString, QVariantMap> CachedModuleDirectories;
 
   bool Verbose;
 };
@@ -68,6 +200,7 @@ public:
 qSlicerAbstractModuleFactoryManagerPrivate::qSlicerAbstractModuleFactoryManagerPrivate(qSlicerAbstractModuleFactoryManager& object)
   : q_ptr(&object)
 {
+  this->LazyInstantiation = false;
   this->Verbose = false;
 }
 
@@ -116,6 +249,147 @@ qSlicerAbstractModuleFactoryManagerPrivate
   return this->RegisteredModules[moduleName];
 }
 
+//-----------------------------------------------------------------------------
+QVariantMap qSlicerAbstractModuleFactoryManagerPrivate::moduleMetadata(qSlicerAbstractCoreModule* module)const
+{
+  QVariantMap metadata;
+  metadata["title"] = module->title();
+  metadata["categories"] = module->categories();
+  metadata["dependencies"] = module->dependencies();
+  metadata["associatedNodeTypes"] = module->associatedNodeTypes();
+  metadata["hidden"] = module->isHidden();
+  metadata["index"] = module->index();
+  metadata["builtIn"] = module->isBuiltIn();
+  QFileInfo file = this->ModuleFiles.value(module->name());
+  if (!file.filePath().isEmpty())
+    {
+    metadata["path"] = file.absoluteFilePath();
+    metadata["lastModified"] = file.lastModified().toMSecsSinceEpoch();
+    }
+  return metadata;
+}
+
+//-----------------------------------------------------------------------------
+QVariantMap qSlicerAbstractModuleFactoryManagerPrivate::upToDateCachedModuleMetadata(const QString& moduleName)const
+{
+  QVariantMap metadata = this->CachedModuleMetadata.value(moduleName);
+  QFileInfo file = this->ModuleFiles.value(moduleName);
+  // Modules that are not file based (e.g. core modules) are never cached
+  if (metadata.isEmpty() || file.filePath().isEmpty())
+    {
+    return QVariantMap();
+    }
+  if (metadata.value("path").toString() != file.absoluteFilePath()
+    || metadata.value("lastModified").toLongLong() != file.lastModified().toMSecsSinceEpoch())
+    {
+    return QVariantMap();
+    }
+  return metadata;
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerAbstractModuleFactoryManagerPrivate::readModuleMetadataCache()
+{
+  this->CachedModuleMetadata.clear();
+  if (this->ModuleMetadataCacheFilePath.isEmpty())
+    {
+    return;
+    }
+  QSettings cache(this->ModuleMetadataCacheFilePath, QSettings::IniFormat);
+  foreach(const QString& moduleName, cache.childGroups())
+    {
+    cache.beginGroup(moduleName);
+    QVariantMap metadata;
+    foreach(const QString& key, cache.childKeys())
+      {
+      metadata[key] = cache.value(key);
+      }
+    cache.endGroup();
+    this->CachedModuleMetadata[moduleName] = metadata;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerAbstractModuleFactoryManagerPrivate::writeModuleMetadataCache()
+{
+  if (this->ModuleMetadataCacheFilePath.isEmpty())
+    {
+    return;
+    }
+  QSettings cache(this->ModuleMetadataCacheFilePath, QSettings::IniFormat);
+  cache.clear();
+  foreach(const QString& moduleName, this->CachedModuleMetadata.keys())
+    {
+    const QVariantMap& metadata = this->CachedModuleMetadata[moduleName];
+    cache.beginGroup(moduleName);
+    foreach(const QString& key, metadata.keys())
+      {
+      cache.setValue(key, metadata[key]);
+      }
+    cache.endGroup();
+    }
+}
+
+//-----------------------------------------------------------------------------
+QString qSlicerAbstractModuleFactoryManagerPrivate::fileBasedFactoriesKey()const
+{
+  QStringList factoryNames;
+  foreach(qSlicerFileBasedModuleFactory* factory, this->fileBasedFactories())
+    {
+    factoryNames << typeid(*factory).name();
+    }
+  factoryNames.sort();
+  return factoryNames.join(";");
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerAbstractModuleFactoryManagerPrivate::readModuleDiscoveryCache()
+{
+  this->CachedModuleDirectories.clear();
+  if (this->ModuleDiscoveryCacheFilePath.isEmpty())
+    {
+    return;
+    }
+  QSettings cache(this->ModuleDiscoveryCacheFilePath, QSettings::IniFormat);
+  if (cache.value("factories").toString() != this->fileBasedFactoriesKey())
+    {
+    return;
+    }
+  int size = cache.beginReadArray("directories");
+  for (int i = 0; i < size; ++i)
+    {
+    cache.setArrayIndex(i);
+    QVariantMap directory;
+    directory["lastModified"] = cache.value("lastModified");
+    directory["files"] = cache.value("files").toStringList();
+    this->CachedModuleDirectories[cache.value("path").toString()] = directory;
+    }
+  cache.endArray();
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerAbstractModuleFactoryManagerPrivate::writeModuleDiscoveryCache()
+{
+  if (this->ModuleDiscoveryCacheFilePath.isEmpty())
+    {
+    return;
+    }
+  QSettings cache(this->ModuleDiscoveryCacheFilePath, QSettings::IniFormat);
+  cache.clear();
+  cache.setValue("factories", this->fileBasedFactoriesKey());
+  cache.beginWriteArray("directories", this->CachedModuleDirectories.count());
+  int i = 0;
+  foreach(const QString& path, this->CachedModuleDirectories.keys())
+    {
+    const QVariantMap& directory = this->CachedModuleDirectories[path];
+    cache.setArrayIndex(i++);
+    cache.setValue("path", path);
+    cache.setValue("lastModified", directory.value("lastModified"));
+    cache.setValue("files", directory.value("files"));
+    }
+  cache.endArray();
+}
+
 //-----------------------------------------------------------------------------
 QVector<qSlicerAbstractModuleFactoryManagerPrivate::qSlicerModuleFactory*>
 qSlicerAbstractModuleFactoryManagerPrivate
@@ -132,6 +406,62 @@ qSlicerAbstractModuleFactoryManagerPrivate
   return factories;
 }
 
+//-----------------------------------------------------------------------------
+void qSlicerAbstractModuleFactoryManagerPrivate::registerModule(const QFileInfo& file,
+                                                               qSlicerFileBasedModuleFactory* moduleFactory)
+{
+  Q_Q(qSlicerAbstractModuleFactoryManager);
+  QString moduleName = moduleFactory->itemKey(file);
+  bool dontEmitSignal = false;
+  // Has the module been already registered
+  qSlicerModuleFactory* existingModuleFactory = this->registeredModuleFactory(moduleName);
+  if (existingModuleFactory)
+    {
+    if (this->Factories[existingModuleFactory] >=
+        this->Factories[moduleFactory])
+      {
+      if (this->Verbose)
+        {
+        qDebug() << " file: " << file.absoluteFilePath() << " already registered";
+        }
+      return;
+      }
+    // Replace the factory of the registered module with this higher priority
+    // factory.
+    //existingModuleFactory->unregisterItem(file);
+    dontEmitSignal = true;
+    }
+  if (this->ModulesToIgnore.contains(moduleName))
+    {
+    //qDebug() << "Ignore module" << moduleName;
+    if (this->Verbose)
+      {
+      qDebug() << " file: " << file.absoluteFilePath() << " is in ignore list";
+      }
+    this->IgnoredModules[moduleName] = file;
+    emit q->moduleIgnored(moduleName);
+    return;
+    }
+  QString registeredModuleName = moduleFactory->registerFileItem(file);
+  if (registeredModuleName != moduleName)
+    {
+    //qDebug() << "Ignore module" << moduleName;
+    if (this->Verbose)
+      {
+      qDebug() << " file: " << file.absoluteFilePath() << " ignored because moduleName does not match registeredModuleName";
+      }
+    this->IgnoredModules[moduleName] = file;
+    emit q->moduleIgnored(moduleName);
+    return;
+    }
+  this->RegisteredModules[moduleName] = moduleFactory;
+  this->ModuleFiles[moduleName] = file;
+  if (!dontEmitSignal)
+    {
+    emit q->moduleRegistered(moduleName);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // qSlicerAbstractModuleFactoryManager methods
 
@@ -266,17 +596,91 @@ void qSlicerAbstractModuleFactoryManager::registerModules()
       }
     }
   // then register file based factories
-  foreach(const QString& path, d->SearchPaths)
+  QVector<qSlicerFileBasedModuleFactory*> factories = d->fileBasedFactories();
+  d->readModuleDiscoveryCache();
+  QThreadPool threadPool;
+  QVector<qSlicerModuleDirectoryScan> scans(d->SearchPaths.count());
+  for (int i = 0; i < d->SearchPaths.count(); ++i)
+    {
+    qSlicerModuleDirectoryScan& scan = scans[i];
+    scan.Path = d->SearchPaths[i];
+    QVariantMap cachedDirectory = d->CachedModuleDirectories.value(scan.Path);
+    if (!cachedDirectory.isEmpty()
+      && cachedDirectory.value("lastModified").toLongLong() == QFileInfo(scan.Path).lastModified().toMSecsSinceEpoch())
+      {
+      QDir directory(scan.Path);
+      foreach(const QString& fileName, cachedDirectory.value("files").toStringList())
+        {
+        scan.Files << QFileInfo(directory, fileName);
+        }
+      scan.Cached = true;
+      continue;
+      }
+    threadPool.start(new qSlicerModuleDirectoryScanRunnable(&scan, factories));
+    }
+  threadPool.waitForDone();
+
+  // Read the libraries in the background while they are loaded in order
+  foreach(const qSlicerModuleDirectoryScan& scan, scans)
+    {
+    foreach(const QFileInfo& file, scan.Files)
+      {
+      if (QLibrary::isLibrary(file.fileName()))
+        {
+        threadPool.start(new qSlicerModuleLibraryPrefetchRunnable(file.absoluteFilePath()));
+        }
+      }
+    }
+
+  d->CachedModuleDirectories.clear();
+  foreach(const qSlicerModuleDirectoryScan& scan, scans)
     {
     if (d->Verbose)
       {
-      qDebug() << "Searching path: " << path;
+      qDebug() << "Searching path: " << scan.Path << (scan.Cached ? "(cached)" : "");
       }
-    this->registerModules(path);
+    QStringList fileNames;
+    for (int i = 0; i < scan.Files.count(); ++i)
+      {
+      const QFileInfo& file = scan.Files[i];
+      qSlicerFileBasedModuleFactory* moduleFactory =
+        scan.Cached ? moduleFileFactory(file, factories) : scan.FileFactories[i];
+      if (!moduleFactory)
+        {
+        continue;
+        }
+      if (d->Verbose)
+        {
+        qDebug() << " recognized file: " << file.absoluteFilePath() << " as a " << typeid(*moduleFactory).name();
+        }
+      fileNames << file.fileName();
+      d->registerModule(file, moduleFactory);
+      }
+    QVariantMap directory;
+    directory["lastModified"] = QFileInfo(scan.Path).lastModified().toMSecsSinceEpoch();
+    directory["files"] = fileNames;
+    d->CachedModuleDirectories[scan.Path] = directory;
     }
+  threadPool.waitForDone();
+  d->writeModuleDiscoveryCache();
+
   emit this->modulesRegistered(d->RegisteredModules.keys());
 }
 
+//-----------------------------------------------------------------------------
+void qSlicerAbstractModuleFactoryManager::setModuleDiscoveryCacheFilePath(const QString& filePath)
+{
+  Q_D(qSlicerAbstractModuleFactoryManager);
+  d->ModuleDiscoveryCacheFilePath = filePath;
+}
+
+//-----------------------------------------------------------------------------
+QString qSlicerAbstractModuleFactoryManager::moduleDiscoveryCacheFilePath()const
+{
+  Q_D(const qSlicerAbstractModuleFactoryManager);
+  return d->ModuleDiscoveryCacheFilePath;
+}
+
 //-----------------------------------------------------------------------------
 void qSlicerAbstractModuleFactoryManager::registerModules(const QString& path)
 {
@@ -317,64 +721,45 @@ void qSlicerAbstractModuleFactoryManager::registerModule(const QFileInfo& file)
     {
     return;
     }
-  QString moduleName = moduleFactory->itemKey(file);
-  bool dontEmitSignal = false;
-  // Has the module been already registered
-  qSlicerModuleFactory* existingModuleFactory = d->registeredModuleFactory(moduleName);
-  if (existingModuleFactory)
-    {
-    if (d->Factories[existingModuleFactory] >=
-        d->Factories[moduleFactory])
-      {
-      if (d->Verbose)
-        {
-        qDebug() << " file: " << file.absoluteFilePath() << " already registered";
-        }
-      return;
-      }
-    // Replace the factory of the registered module with this higher priority
-    // factory.
-    //existingModuleFactory->unregisterItem(file);
-    dontEmitSignal = true;
-    }
-  if (d->ModulesToIgnore.contains(moduleName))
-    {
-    //qDebug() << "Ignore module" << moduleName;
-    if (d->Verbose)
-      {
-      qDebug() << " file: " << file.absoluteFilePath() << " is in ignore list";
-      }
-    d->IgnoredModules[moduleName] = file;
-    emit moduleIgnored(moduleName);
-    return;
-    }
-  QString registeredModuleName = moduleFactory->registerFileItem(file);
-  if (registeredModuleName != moduleName)
-    {
-    //qDebug() << "Ignore module" << moduleName;
-    if (d->Verbose)
-      {
-      qDebug() << " file: " << file.absoluteFilePath() << " ignored because moduleName does not match registeredModuleName";
-      }
-    d->IgnoredModules[moduleName] = file;
-    emit moduleIgnored(moduleName);
-    return;
-    }
-  d->RegisteredModules[moduleName] = moduleFactory;
-  if (!dontEmitSignal)
-    {
-    emit moduleRegistered(moduleName);
-    }
+  d->registerModule(file, moduleFactory);
 }
 
 //-----------------------------------------------------------------------------
 void qSlicerAbstractModuleFactoryManager::instantiateModules()
 {
   Q_D(qSlicerAbstractModuleFactoryManager);
+  d->readModuleMetadataCache();
   foreach (const QString& moduleName, d->RegisteredModules.keys())
     {
+    QVariantMap metadata = d->upToDateCachedModuleMetadata(moduleName);
+    if (d->LazyInstantiation && !metadata.isEmpty() && !metadata.value("hidden").toBool())
+      {
+      if (d->Verbose)
+        {
+        qDebug() << "Deferring instantiation of:" << moduleName;
+        }
+      // Make the module discoverable as if it was instantiated
+      foreach(const QString& associatedNodeType, metadata.value("associatedNodeTypes").toStringList())
+        {
+        qSlicerCoreApplication::application()->addModuleAssociatedNodeType(associatedNodeType, moduleName);
+        }
+      foreach(const QString& dependency, metadata.value("dependencies").toStringList())
+        {
+        QStringList dependees = d->ModuleDependees.value(dependency);
+        if (!dependees.contains(moduleName))
+          {
+          d->ModuleDependees.insert(dependency, dependees << moduleName);
+          }
+        }
+      if (!d->DeferredModules.contains(moduleName))
+        {
+        d->DeferredModules << moduleName;
+        }
+      continue;
+      }
     this->instantiateModule(moduleName);
     }
+  d->writeModuleMetadataCache();
 
   // XXX See issue #3804
   // Python maps SIGINT (control-c) to its own handler.  We will remap it
@@ -400,6 +785,16 @@ qSlicerAbstractCoreModule* qSlicerAbstractModuleFactoryManager
     qCritical() << "Fail to instantiate module " << moduleName << " (not registered)";
     return nullptr;
     }
+  if (d->DeferredModules.contains(moduleName))
+    {
+    // Associations registered from the cached metadata are replaced by the ones of the instance
+    foreach(const QString& associatedNodeType,
+            d->CachedModuleMetadata.value(moduleName).value("associatedNodeTypes").toStringList())
+      {
+      qSlicerCoreApplication::application()->removeModuleAssociatedNodeType(associatedNodeType, moduleName);
+      }
+    }
+  qSlicerStartupTracer::Span span(moduleName, "module instantiation");
   qSlicerAbstractCoreModule* module = factory->instantiate(moduleName);
   if (!module)
     {
@@ -408,6 +803,10 @@ qSlicerAbstractCoreModule* qSlicerAbstractModuleFactoryManager
     }
   module->setName(moduleName);
   module->setObjectName(QString("%1Module").arg(moduleName));
+  if (d->ModuleFiles.contains(moduleName))
+    {
+    d->CachedModuleMetadata[moduleName] = d->moduleMetadata(module);
+    }
   foreach(const QString& associatedNodeType, module->associatedNodeTypes())
     {
     qSlicerCoreApplication::application()->addModuleAssociatedNodeType(associatedNodeType, moduleName);
@@ -424,6 +823,69 @@ qSlicerAbstractCoreModule* qSlicerAbstractModuleFactoryManager
   return module;
 }
 
+//-----------------------------------------------------------------------------
+void qSlicerAbstractModuleFactoryManager::setLazyInstantiation(bool lazy)
+{
+  Q_D(qSlicerAbstractModuleFactoryManager);
+  d->LazyInstantiation = lazy;
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerAbstractModuleFactoryManager::lazyInstantiation()const
+{
+  Q_D(const qSlicerAbstractModuleFactoryManager);
+  return d->LazyInstantiation;
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerAbstractModuleFactoryManager::setModuleMetadataCacheFilePath(const QString& filePath)
+{
+  Q_D(qSlicerAbstractModuleFactoryManager);
+  d->ModuleMetadataCacheFilePath = filePath;
+}
+
+//-----------------------------------------------------------------------------
+QString qSlicerAbstractModuleFactoryManager::moduleMetadataCacheFilePath()const
+{
+  Q_D(const qSlicerAbstractModuleFactoryManager);
+  return d->ModuleMetadataCacheFilePath;
+}
+
+//-----------------------------------------------------------------------------
+QStringList qSlicerAbstractModuleFactoryManager::deferredModuleNames() const
+{
+  Q_D(const qSlicerAbstractModuleFactoryManager);
+  QStringList deferredModules;
+  foreach(const QString& moduleName, d->DeferredModules)
+    {
+    if (this->isRegistered(moduleName) && !this->isInstantiated(moduleName))
+      {
+      deferredModules << moduleName;
+      }
+    }
+  return deferredModules;
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerAbstractModuleFactoryManager::isDeferred(const QString& moduleName)const
+{
+  Q_D(const qSlicerAbstractModuleFactoryManager);
+  return d->DeferredModules.contains(moduleName)
+    && this->isRegistered(moduleName) && !this->isInstantiated(moduleName);
+}
+
+//-----------------------------------------------------------------------------
+QVariantMap qSlicerAbstractModuleFactoryManager::moduleMetadata(const QString& moduleName)const
+{
+  Q_D(const qSlicerAbstractModuleFactoryManager);
+  qSlicerAbstractCoreModule* module = this->moduleInstance(moduleName);
+  if (module)
+    {
+    return d->moduleMetadata(module);
+    }
+  return d->upToDateCachedModuleMetadata(moduleName);
+}
+
 //-----------------------------------------------------------------------------
 QStringList qSlicerAbstractModuleFactoryManager::registeredModuleNames() const
 {
@@ -24,6 +24,7 @@
 // Qt includes
 #include <QObject>
 #include <QString>
+#include <QVariantMap>
 
 // CTK includes
 #include <ctkAbstractFileBasedFactory.h>
@@ -62,6 +63,12 @@ class qSlicerAbstractModuleFactoryManagerPrivate;
 /// The order of initialization is defined with the dependencies of the modules.
 /// If module B depends of module A, it is assured that module B is initialized/setup after A.
 ///   factoryManager->loadModules();
+///
+/// If \a lazyInstantiation is enabled, the modules that have up-to-date metadata
+/// in the \a moduleMetadataCacheFilePath cache are not instantiated by
+/// instantiateModules(). Their metadata (title, categories, dependencies,
+/// associated node types) is read from the cache, and each of these modules is
+/// instantiated the first time it is requested (see qSlicerModuleFactoryManager::loadModule()).
 class Q_SLICER_BASE_QTCORE_EXPORT qSlicerAbstractModuleFactoryManager : public QObject
 {
   Q_OBJECT
@@ -82,6 +89,26 @@ class Q_SLICER_BASE_QTCORE_EXPORT qSlicerAbstractModuleFactoryManager : public Q
   /// Due to the large amount of modules to load, it can be faster (and less
   /// overwhelming) to load only a subset of the modules.
   Q_PROPERTY(QStringList modulesToIgnore READ modulesToIgnore WRITE setModulesToIgnore NOTIFY modulesToIgnoreChanged)
+
+  /// This property controls whether instantiateModules() defers the instantiation
+  /// of the modules that have up-to-date metadata in the cache.
+  /// Hidden modules are always instantiated.
+  /// False by default.
+  /// \sa moduleMetadataCacheFilePath, deferredModuleNames()
+  Q_PROPERTY(bool lazyInstantiation READ lazyInstantiation WRITE setLazyInstantiation)
+
+  /// This property holds the path of the file where the metadata of the instantiated
+  /// modules is cached. The metadata of a module is up-to-date if the file of the module
+  /// has not been modified since the metadata was cached.
+  /// The metadata is not cached if the path is empty (default).
+  Q_PROPERTY(QString moduleMetadataCacheFilePath READ moduleMetadataCacheFilePath WRITE setModuleMetadataCacheFilePath)
+
+  /// This property holds the path of the file where the result of the search path
+  /// scanning is cached. The module files of a search path are retrieved from the
+  /// cache if the directory has not been modified (i.e. no file has been added,
+  /// removed or renamed) since it was scanned.
+  /// The result is not cached if the path is empty (default).
+  Q_PROPERTY(QString moduleDiscoveryCacheFilePath READ moduleDiscoveryCacheFilePath WRITE setModuleDiscoveryCacheFilePath)
 public:
   typedef ctkAbstractFileBasedFactory<qSlicerAbstractCoreModule> qSlicerFileBasedModuleFactory;
   typedef ctkAbstractFactory<qSlicerAbstractCoreModule> qSlicerModuleFactory;
@@ -158,8 +185,13 @@ public:
 
   /// Scan the paths in \a searchPaths and for each file, attempt to register
   /// using one of the registered factories.
+  /// The paths are scanned concurrently, the modules are registered in the
+  /// order of the search paths.
   void registerModules();
 
+  void setModuleDiscoveryCacheFilePath(const QString& filePath);
+  QString moduleDiscoveryCacheFilePath()const;
+
   Q_INVOKABLE void registerModule(const QFileInfo& file);
 
   /// Convenient method returning the list of all registered module names
@@ -169,8 +201,30 @@ public:
   Q_INVOKABLE bool isRegistered(const QString& name)const;
 
   /// Instantiate all previously registered modules.
+  /// If \a lazyInstantiation is enabled, modules that have up-to-date cached
+  /// metadata are not instantiated.
   virtual void instantiateModules();
 
+  void setLazyInstantiation(bool lazy);
+  bool lazyInstantiation()const;
+
+  void setModuleMetadataCacheFilePath(const QString& filePath);
+  QString moduleMetadataCacheFilePath()const;
+
+  /// List of registered modules whose instantiation has been deferred and
+  /// that are not instantiated yet.
+  Q_INVOKABLE QStringList deferredModuleNames() const;
+
+  /// Return true if the instantiation of the module has been deferred and
+  /// the module is not instantiated yet.
+  Q_INVOKABLE bool isDeferred(const QString& name)const;
+
+  /// Return the metadata of a registered module: "title", "categories",
+  /// "dependencies", "associatedNodeTypes", "hidden", "index" and "builtIn".
+  /// The metadata is retrieved from the module instance if it is instantiated,
+  /// from the cache otherwise. Returns an empty map if it is not available.
+  Q_INVOKABLE QVariantMap moduleMetadata(const QString& name)const;
+
   /// List of registered and instantiated modules
   Q_INVOKABLE QStringList instantiatedModuleNames() const;
 
@@ -33,6 +33,7 @@
 #include <QTranslator>
 #include <QStandardPaths>
 #include <QTemporaryFile>
+#include <QThread>
 
 // For:
 //  - Slicer_QTLOADABLEMODULES_LIB_DIR
@@ -78,6 +79,7 @@
 #include "qSlicerLoadableModuleFactory.h"
 #include "qSlicerModuleFactoryManager.h"
 #include "qSlicerModuleManager.h"
+#include "qSlicerStartupTracer.h"
 #include "qSlicerUtils.h"
 
 // SlicerLogic includes
@@ -149,6 +151,22 @@ wchar_t* QStringToPythonWCharPointer(QString str)
 }
 #endif
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Called by the event broker in coalescing mode to schedule processing of queued events
+// from the Qt event loop.
+void FlushEventQueueCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* vtkNotUsed(clientData), void* callData)
+{
+  double delaySec = callData ? *reinterpret_cast<double*>(callData) : 0.0;
+  QTimer::singleShot(static_cast<int>(delaySec * 1000.0 + 0.5), []()
+    {
+    vtkEventBroker::GetInstance()->ProcessEventQueue();
+    });
+}
+}
+
 //-----------------------------------------------------------------------------
 // qSlicerCoreApplicationPrivate methods
 
@@ -195,6 +213,7 @@ qSlicerCoreApplicationPrivate::~qSlicerCoreApplicationPrivate()
 void qSlicerCoreApplicationPrivate::init()
 {
   Q_Q(qSlicerCoreApplication);
+  qSlicerStartupTracer::Span span("Core application initialization");
 
   // Minimize the number of call to 'systemEnvironment()' by keeping
   // a reference to 'Environment'. Indeed, re-creating QProcessEnvironment is a non-trivial
@@ -330,6 +349,11 @@ void qSlicerCoreApplicationPrivate::init()
     modifiedRequestCallback->SetClientData(this->AppLogic);
     modifiedRequestCallback->SetCallback(vtkSlicerApplicationLogic::RequestModifiedCallback);
     vtkEventBroker::GetInstance()->SetRequestModifiedCallback(modifiedRequestCallback);
+
+    // Process queued events from the event loop if the event broker is in coalescing mode
+    vtkNew<vtkCallbackCommand> flushEventQueueCallback;
+    flushEventQueueCallback->SetCallback(FlushEventQueueCallback);
+    vtkEventBroker::GetInstance()->SetFlushEventQueueCallback(flushEventQueueCallback);
   }
 
   // Ensure that temporary folder is writable
@@ -371,6 +395,8 @@ void qSlicerCoreApplicationPrivate::init()
               q, SLOT(resumeRender()));
   q->qvtkConnect(this->AppLogic, vtkSlicerApplicationLogic::EditNodeEvent,
               q, SLOT(editNode(vtkObject*, void*, ulong)));
+  q->qvtkConnect(this->AppLogic, vtkMRMLApplicationLogic::ModuleLogicRequestedEvent,
+                 q, SLOT(onModuleLogicRequested(vtkObject*,void*)), 0.0, Qt::DirectConnection);
   q->qvtkConnect(this->AppLogic->GetUserInformation(), vtkCommand::ModifiedEvent,
     q, SLOT(onUserInformationModified()));
 
@@ -418,7 +444,12 @@ void qSlicerCoreApplicationPrivate::init()
     {
     if (q->corePythonManager())
       {
+      qSlicerStartupTracer::Span pythonSpan("Python initialization");
       q->corePythonManager()->mainContext(); // Initialize python
+      if (q->isInstalled() && q->revisionUserSettings()->value("Python/BytecodeSnapshot", false).toBool())
+        {
+        this->setupPythonBytecodeSnapshot();
+        }
       q->corePythonManager()->setSystemExitExceptionHandlerEnabled(true);
       q->connect(q->corePythonManager(), SIGNAL(systemExitExceptionRaised(int)),
                  q, SLOT(terminate(int)));
@@ -663,6 +694,47 @@ void qSlicerCoreApplicationPrivate::setPythonOsEnviron(const QString& key, const
           .arg(qSlicerCorePythonManager::toPythonStringLiteral(key))
           .arg(qSlicerCorePythonManager::toPythonStringLiteral(value)));
 }
+
+//-----------------------------------------------------------------------------
+void qSlicerCoreApplicationPrivate::setupPythonBytecodeSnapshot()
+{
+  Q_Q(qSlicerCoreApplication);
+  // Bundled modules only change with the revision
+  QString snapshotFilePath = QDir(q->cachePath()).filePath(
+    QString("PythonBytecodeSnapshot-%1.zip").arg(q->revision()));
+  QStringList directories;
+  directories << this->SlicerHome + "/" + Slicer_BIN_DIR + "/Python"
+              << this->SlicerHome + "/" + Slicer_QTSCRIPTEDMODULES_LIB_DIR
+              << this->SlicerHome + "/" + Slicer_QTLOADABLEMODULES_PYTHON_LIB_DIR;
+  QStringList directoryLiterals;
+  foreach(const QString& directory, directories)
+    {
+    directoryLiterals << qSlicerCorePythonManager::toPythonStringLiteral(directory);
+    }
+
+  this->CorePythonManager->executeString("import slicer.bytecodesnapshot");
+  QVariant enabled = this->CorePythonManager->executeString(
+    QString("slicer.bytecodesnapshot.setup(%1)")
+      .arg(qSlicerCorePythonManager::toPythonStringLiteral(snapshotFilePath)),
+    ctkAbstractPythonManager::EvalInput);
+  if (enabled.toBool())
+    {
+    return;
+    }
+  QString createSnapshotCode = QString(
+    "try:\n"
+    "  slicer.bytecodesnapshot.createSnapshot(%1, [%2])\n"
+    "except Exception as e:\n"
+    "  import logging\n"
+    "  logging.warning(f'Failed to create Python bytecode snapshot: {e}')\n")
+    .arg(qSlicerCorePythonManager::toPythonStringLiteral(snapshotFilePath))
+    .arg(directoryLiterals.join(", "));
+  qSlicerCorePythonManager* pythonManager = this->CorePythonManager.data();
+  QTimer::singleShot(0, q, [pythonManager, createSnapshotCode]()
+    {
+    pythonManager->executeString(createSnapshotCode);
+    });
+}
 #endif
 
 //-----------------------------------------------------------------------------
@@ -804,6 +876,10 @@ void qSlicerCoreApplicationPrivate::parseArguments()
     q->showConsoleMessage("Problem parsing command line arguments.  Try with --help.");
     this->quickExit(EXIT_FAILURE);
     }
+  if (options->startupTraceFilePath().isEmpty())
+    {
+    qSlicerStartupTracer::setEnabled(false);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -1859,6 +1935,22 @@ void qSlicerCoreApplication::onUserInformationModified()
   this->userSettings()->setValue("UserInformation", userInfo->GetAsString().c_str());
 }
 
+//-----------------------------------------------------------------------------
+void qSlicerCoreApplication::onModuleLogicRequested(vtkObject* vtkNotUsed(caller), void* callData)
+{
+  const char* moduleName = reinterpret_cast<const char*>(callData);
+  // Modules can only be loaded from the main thread
+  if (!moduleName || QThread::currentThread() != this->thread())
+    {
+    return;
+    }
+  qSlicerModuleManager* moduleManager = this->moduleManager();
+  if (moduleManager && moduleManager->factoryManager()->isDeferred(moduleName))
+    {
+    moduleManager->factoryManager()->loadModule(moduleName);
+    }
+}
+
 //-----------------------------------------------------------------------------
 void qSlicerCoreApplication
 ::requestInvokeEvent(vtkObject* caller, void* callData)
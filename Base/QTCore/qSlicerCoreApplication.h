@@ -614,6 +614,10 @@ protected slots:
   void processAppLogicReadData();
   void processAppLogicWriteData();
 
+  /// Load a module whose instantiation has been deferred when its logic is requested.
+  /// \sa vtkMRMLApplicationLogic::ModuleLogicRequestedEvent
+  void onModuleLogicRequested(vtkObject* caller, void* callData);
+
   /// Editing of a MRML node has been requested.
   /// Implemented in qSlicerApplication.
   virtual void editNode(vtkObject*, void*, unsigned long) {};
@@ -88,6 +88,12 @@ public:
 
 #ifdef Slicer_USE_PYTHONQT
   void setPythonOsEnviron(const QString& key, const QString& value);
+
+  /// Import the Python modules bundled with Slicer from a bytecode snapshot.
+  /// If the snapshot does not exist, it is created after the event loop is
+  /// started and used at the next startup.
+  /// \sa slicer.bytecodesnapshot
+  void setupPythonBytecodeSnapshot();
 #endif
 
 #ifdef Q_WS_WIN
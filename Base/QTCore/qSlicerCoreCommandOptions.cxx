@@ -308,6 +308,13 @@ bool qSlicerCoreCommandOptions::verboseModuleDiscovery() const
   return d->ParsedArgs.value("verbose-module-discovery").toBool();
 }
 
+//-----------------------------------------------------------------------------
+QString qSlicerCoreCommandOptions::startupTraceFilePath() const
+{
+  Q_D(const qSlicerCoreCommandOptions);
+  return d->ParsedArgs.value("startup-trace").toString();
+}
+
 //-----------------------------------------------------------------------------
 bool qSlicerCoreCommandOptions::verbose()const
 {
@@ -457,6 +464,10 @@ void qSlicerCoreCommandOptions::addArguments()
   this->addArgument("verbose-module-discovery", "", QVariant::Bool,
                     "Enable verbose output during module discovery process.");
 
+  this->addArgument("startup-trace", "", QVariant::String,
+                    "Record the duration of the startup phases and write them to the given file "
+                    "(Chrome trace JSON format, can be displayed in chrome://tracing or https://ui.perfetto.dev).");
+
   this->addArgument("disable-settings", "", QVariant::Bool,
                     "Start application ignoring user settings and using new temporary settings.");
 
@@ -53,6 +53,7 @@ class Q_SLICER_BASE_QTCORE_EXPORT qSlicerCoreCommandOptions : public ctkCommandL
   Q_PROPERTY(bool displayTemporaryPathAndExit READ displayTemporaryPathAndExit CONSTANT)
   Q_PROPERTY(bool displayMessageAndExit READ displayMessageAndExit STORED false CONSTANT)
   Q_PROPERTY(bool verboseModuleDiscovery READ verboseModuleDiscovery CONSTANT)
+  Q_PROPERTY(QString startupTraceFilePath READ startupTraceFilePath CONSTANT)
   Q_PROPERTY(bool disableMessageHandlers READ disableMessageHandlers CONSTANT)
   Q_PROPERTY(bool testingEnabled READ isTestingEnabled CONSTANT)
 #ifdef Slicer_USE_PYTHONQT
@@ -157,6 +158,11 @@ public:
   /// Return True if slicer should display details regarding the module discovery process
   bool verboseModuleDiscovery()const;
 
+  /// Return the file where the duration of the startup phases should be written
+  /// (Chrome trace format), empty if startup tracing is disabled.
+  /// \sa qSlicerStartupTracer
+  QString startupTraceFilePath()const;
+
   /// Return True if slicer should display information at startup
   bool verbose()const;
 
@@ -47,9 +47,14 @@
 #include <vtkCollection.h>
 #include <vtkDataFileFormatHelper.h> // for GetFileExtensionFromFormatString()
 #include <vtkNew.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
 #include <vtkStringArray.h>
 #include <vtkGeneralTransform.h>
 
+// STD includes
+#include <vector>
+
 //-----------------------------------------------------------------------------
 class qSlicerCoreIOManagerPrivate
 {
@@ -67,6 +72,23 @@ public:
     vtkMRMLScene* scene = nullptr
   ) const;
 
+  /// Get the data that the reader decoded from the file in a worker thread and
+  /// add the messages of decoding to userMessages.
+  /// Returns nullptr if the file was not decoded (or decoding failed).
+  vtkSmartPointer<vtkObject> takeDecodedData(qSlicerFileReader* reader, const QString& fileName,
+    vtkMRMLMessageCollection* userMessages);
+
+  struct DecodedFile
+    {
+    qSlicerIO::IOProperties Properties;
+    qSlicerFileReader* Reader{nullptr};
+    vtkSmartPointer<vtkObject> DecodedData;
+    vtkSmartPointer<vtkMRMLMessageCollection> UserMessages;
+    };
+
+  /// Files that are decoded in worker threads and not yet added to the scene
+  std::vector<DecodedFile> DecodedFiles;
+
   QSettings*        ExtensionFileType;
   QList<qSlicerFileReader*> Readers;
   QList<qSlicerFileWriter*> Writers;
@@ -124,6 +146,28 @@ QList<qSlicerFileReader*> qSlicerCoreIOManagerPrivate::readers(const QString& fi
   return matchingReaders;
 }
 
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkObject> qSlicerCoreIOManagerPrivate::takeDecodedData(
+  qSlicerFileReader* reader, const QString& fileName, vtkMRMLMessageCollection* userMessages)
+{
+  for (std::vector<DecodedFile>::iterator decodedFileIt = this->DecodedFiles.begin();
+    decodedFileIt != this->DecodedFiles.end(); ++decodedFileIt)
+    {
+    if (decodedFileIt->Reader != reader || decodedFileIt->Properties["fileName"].toString() != fileName)
+      {
+      continue;
+      }
+    vtkSmartPointer<vtkObject> decodedData = decodedFileIt->DecodedData;
+    if (decodedData && userMessages)
+      {
+      userMessages->AddMessages(decodedFileIt->UserMessages);
+      }
+    this->DecodedFiles.erase(decodedFileIt);
+    return decodedData;
+    }
+  return nullptr;
+}
+
 //-----------------------------------------------------------------------------
 QList<qSlicerFileWriter*> qSlicerCoreIOManagerPrivate::writers(
   const qSlicerIO::IOFileType& fileType,
@@ -588,7 +632,17 @@ bool qSlicerCoreIOManager::loadNodes(const qSlicerIO::IOFileType& fileType,
       {
       continue;
       }
-    bool currentFileSuccess = reader->load(parameters);
+    bool currentFileSuccess = false;
+    vtkSmartPointer<vtkObject> decodedData = d->takeDecodedData(
+      reader, parameters["fileName"].toString(), reader->userMessages());
+    if (decodedData)
+      {
+      currentFileSuccess = reader->loadDecoded(parameters, decodedData);
+      }
+    else
+      {
+      currentFileSuccess = reader->load(parameters);
+      }
     if (userMessages)
       {
       userMessages->AddMessages(reader->userMessages(), userMessagePrefix.toStdString());
@@ -638,6 +692,59 @@ bool qSlicerCoreIOManager::loadNodes(const qSlicerIO::IOFileType& fileType,
 bool qSlicerCoreIOManager::loadNodes(const QList<qSlicerIO::IOProperties>& files,
           vtkCollection* loadedNodes, vtkMRMLMessageCollection* userMessages/*=nullptr*/)
 {
+  Q_D(qSlicerCoreIOManager);
+
+  // Find files that their reader can decode in worker threads.
+  // Only the first reader that can load the file is considered, as that is the one
+  // that loadNodes() tries first.
+  std::vector<qSlicerCoreIOManagerPrivate::DecodedFile> filesToDecode;
+  foreach(const qSlicerIO::IOProperties& fileProperties, files)
+    {
+    if (fileProperties["fileName"].type() == QVariant::StringList)
+      {
+      continue;
+      }
+    QString fileName = fileProperties["fileName"].toString();
+    foreach(qSlicerFileReader* reader, this->readers(fileProperties["fileType"].toString()))
+      {
+      reader->setMRMLScene(d->currentScene());
+      if (!reader->canLoadFile(fileName))
+        {
+        continue;
+        }
+      if (reader->canDecodeInParallel(fileProperties))
+        {
+        qSlicerCoreIOManagerPrivate::DecodedFile fileToDecode;
+        fileToDecode.Properties = fileProperties;
+        fileToDecode.Reader = reader;
+        fileToDecode.UserMessages = vtkSmartPointer<vtkMRMLMessageCollection>::New();
+        filesToDecode.push_back(fileToDecode);
+        }
+      break;
+      }
+    }
+
+  // Decode the files concurrently. The scene is not modified until all the files are decoded,
+  // then the decoded files are added to the scene in the main thread (in the original order).
+  if (filesToDecode.size() > 1)
+    {
+    QElapsedTimer timeProbe;
+    timeProbe.start();
+    vtkSMPTools::For(0, static_cast<vtkIdType>(filesToDecode.size()), 1,
+      [&](vtkIdType beginFileIndex, vtkIdType endFileIndex)
+      {
+      for (vtkIdType fileIndex = beginFileIndex; fileIndex < endFileIndex; ++fileIndex)
+        {
+        qSlicerCoreIOManagerPrivate::DecodedFile& fileToDecode = filesToDecode[fileIndex];
+        fileToDecode.DecodedData = fileToDecode.Reader->decode(fileToDecode.Properties, fileToDecode.UserMessages);
+        }
+      });
+    float elapsedTimeInSeconds = timeProbe.elapsed() / 1000.0;
+    qDebug() << "Decoded" << filesToDecode.size() << "files in parallel"
+             << QString("[%1s]").arg(QString::number(elapsedTimeInSeconds, 'f', 2));
+    d->DecodedFiles = filesToDecode;
+    }
+
   bool success = true;
   foreach(qSlicerIO::IOProperties fileProperties, files)
     {
@@ -652,6 +759,8 @@ bool qSlicerCoreIOManager::loadNodes(const QList<qSlicerIO::IOProperties>& files
       userMessages->AddSeparator();
       }
     }
+  // Release decoded data that was not used (e.g., if the reader did not succeed)
+  d->DecodedFiles.clear();
   return success;
 }
 
@@ -199,6 +199,12 @@ public:
 
   QStringList dependenciesToInstall(const QStringList& directDependencies, QStringList& unresolvedDependencies);
 
+  /// Resolve all dependencies of an extension, ask the user for confirmation if needed,
+  /// and start downloading and installing the missing ones. The download requests are
+  /// all issued before returning, so they are served in parallel by the network manager.
+  /// Returns false if some of the dependencies could not be resolved or installed.
+  bool installDependencies(const QString& extensionName, const QStringList& directDependencies);
+
   /// Update (reinstall) specified extension.
   ///
   /// This updates the specified extension
@@ -266,6 +272,7 @@ public:
 
   // Restore previous extension tab may want to run lots of queries.
   // Results are cached in this variable to improve performance.
+  // Key is the item_id of the extension, value is the file metadata returned by the server.
   QMap<QString, ExtensionMetadataType> ServerResponseCache;
 
   QMap<qSlicerExtensionDownloadTask*, QString> ActiveTasks;
@@ -526,6 +533,87 @@ QStringList qSlicerExtensionsManagerModelPrivate::dependenciesToInstall(const QS
   return toInstall;
 }
 
+// --------------------------------------------------------------------------
+bool qSlicerExtensionsManagerModelPrivate::installDependencies(const QString& extensionName, const QStringList& directDependencies)
+{
+  Q_Q(qSlicerExtensionsManagerModel);
+
+  bool success = true;
+  QStringList unresolvedDependencies;
+  QStringList dependenciesToInstall = this->dependenciesToInstall(directDependencies, unresolvedDependencies);
+
+  // Prompt to install dependencies (if any)
+  if (!dependenciesToInstall.isEmpty())
+    {
+    QMessageBox::StandardButton result = QMessageBox::Yes;
+    if (this->Interactive && !this->AutoInstallDependencies)
+      {
+      QString msg = QString("<p>%1 depends on the following extensions:</p><ul>").arg(extensionName);
+      foreach (const QString& dependencyName, dependenciesToInstall)
+        {
+        msg += QString("<li>%1</li>").arg(dependencyName);
+        }
+      msg += "</ul><p>Would you like to install them now?</p>";
+      result = QMessageBox::question(nullptr, "Install dependencies", msg, QMessageBox::Yes | QMessageBox::No);
+      }
+    else
+      {
+      QString msg = QString("The following extensions are required by %1 extension therefore they will be installed now: %2")
+        .arg(extensionName)
+        .arg(dependenciesToInstall.join(", "));
+      qDebug() << msg;
+      }
+
+    if (result == QMessageBox::Yes)
+      {
+      // Install dependencies
+      QString msg;
+      foreach (const QString& dependency, dependenciesToInstall)
+        {
+        bool res = q->downloadAndInstallExtensionByName(dependency, false /*installation of dependencies already confirmed*/);
+        if (!res)
+          {
+          msg += QString("<li>%1</li>").arg(dependency);
+          success = false;
+          }
+        }
+      if (!msg.isEmpty())
+        {
+        this->critical(qSlicerExtensionsManagerModel::tr("Error while installing dependent extensions:<ul>%1<ul>").arg(msg));
+        }
+      }
+    else
+      {
+      // Skip installing dependencies
+      qWarning() << QString("%1 extension requires extensions %2 but the user chose not to install them.")
+        .arg(extensionName)
+        .arg(dependenciesToInstall.join(", "));
+      success = false;
+      }
+    }
+
+  // Warn about unresolved dependencies
+  if (!unresolvedDependencies.isEmpty())
+    {
+    success = false;
+    qWarning() << qSlicerExtensionsManagerModel::tr("%1 extension depends on the following extensions, which could not be found: %2")
+      .arg(extensionName)
+      .arg(unresolvedDependencies.join(", "));
+    if (this->Interactive)
+      {
+      QString msg = QString("<p>%1 depends on the following extensions, which could not be found:</p><ul>").arg(extensionName);
+      foreach(const QString & dependencyName, unresolvedDependencies)
+        {
+        msg += QString("<li>%1</li>").arg(dependencyName);
+        }
+      msg += "</ul><p>The extension may not function properly.</p>";
+      QMessageBox::warning(nullptr, "Unresolved dependencies", msg);
+      }
+    }
+
+  return success;
+}
+
 // --------------------------------------------------------------------------
 void qSlicerExtensionsManagerModelPrivate::addExtensionModelRow(const ExtensionMetadataType &metadata)
 {
@@ -1595,29 +1683,47 @@ qSlicerExtensionsManagerModelPrivate::downloadExtensionByName(const QString& ext
     QString file_id;
     QString archivename;
 
-    this->debug(qSlicerExtensionsManagerModel::tr("Retrieving %1 extension files (extensionId: %2)").arg(extensionName).arg(item_id));
-    qRestAPI getItemFilesApi;
-    getItemFilesApi.setServerUrl(q->serverUrl().toString() + QString("/api/v1/item/%1/files").arg(item_id));
-    const QUuid& queryUuid = getItemFilesApi.get("");
-    QScopedPointer<qRestResult> restResult(getItemFilesApi.takeResult(queryUuid));
-    if(restResult)
+    // Item ID changes when a new revision of the extension is uploaded, therefore the file list
+    // of an item can be reused (for example, when an update is downloaded after reinstalling).
+    const ExtensionMetadataType& cachedItemFile = this->ServerResponseCache.value(item_id);
+    if (!cachedItemFile.isEmpty())
       {
-      qGirderAPI::parseGirderAPIv1Response(restResult.data(), restResult->response());
-      QList<QVariantMap> results = restResult->results();
-      if (results.isEmpty())
-        {
-        // extension manager returned 0 file, this is not expected
-        return nullptr;
-        }
-      else if (results.count() == 1)
+      file_id = cachedItemFile.value("_id").toString();
+      archivename = cachedItemFile.value("name").toString();
+      }
+    else
+      {
+      this->debug(qSlicerExtensionsManagerModel::tr("Retrieving %1 extension files (extensionId: %2)").arg(extensionName).arg(item_id));
+      qRestAPI getItemFilesApi;
+      getItemFilesApi.setServerUrl(q->serverUrl().toString() + QString("/api/v1/item/%1/files").arg(item_id));
+      const QUuid& queryUuid = getItemFilesApi.get("");
+      QScopedPointer<qRestResult> restResult(getItemFilesApi.takeResult(queryUuid));
+      if(restResult)
         {
-        file_id = results.at(0).value("_id").toString();
-        archivename = results.at(0).value("name").toString();
+        qGirderAPI::parseGirderAPIv1Response(restResult.data(), restResult->response());
+        QList<QVariantMap> results = restResult->results();
+        if (results.isEmpty())
+          {
+          // extension manager returned 0 file, this is not expected
+          return nullptr;
+          }
+        else if (results.count() == 1)
+          {
+          file_id = results.at(0).value("_id").toString();
+          archivename = results.at(0).value("name").toString();
+          }
+        else
+          {
+          // extension manager returned multiple files, this is not expected, do not use the results
+          return nullptr;
+          }
         }
-      else
+      if (!file_id.isEmpty() && !archivename.isEmpty())
         {
-        // extension manager returned multiple files, this is not expected, do not use the results
-        return nullptr;
+        ExtensionMetadataType itemFile;
+        itemFile.insert("_id", file_id);
+        itemFile.insert("name", archivename);
+        this->ServerResponseCache.insert(item_id, itemFile);
         }
       }
 
@@ -1694,6 +1800,18 @@ bool qSlicerExtensionsManagerModel::downloadAndInstallExtensionByName(const QStr
     d->critical(error);
     return false;
     }
+  if (installDependencies)
+    {
+    // If dependencies are known from the server metadata then resolve them now, before any download is started,
+    // so that the user is asked only once and all the archives are downloaded in parallel.
+    // Otherwise, dependencies are read from the extension description file after the archive is extracted.
+    const ExtensionMetadataType& extensionMetadataOnServer = d->ExtensionsMetadataFromServer.value(extensionName);
+    if (extensionMetadataOnServer.contains("depends"))
+      {
+      d->installDependencies(extensionName, extensionMetadataOnServer.value("depends").toString().split(" "));
+      installDependencies = false;
+      }
+    }
   qSlicerExtensionDownloadTask* const task = d->downloadExtensionByName(extensionName);
   if (!task)
     {
@@ -1885,78 +2003,8 @@ bool qSlicerExtensionsManagerModel::installExtension(
   bool success = true;
   if (withDependencies)
     {
-    QStringList unresolvedDependencies;
     QStringList directDependencies = extensionMetadata.value("depends").toString().split(" ");
-    QStringList dependenciesToInstall = d->dependenciesToInstall(directDependencies, unresolvedDependencies);
-
-    // Prompt to install dependencies (if any)
-    if (!dependenciesToInstall.isEmpty())
-      {
-      QMessageBox::StandardButton result = QMessageBox::Yes;
-      if (d->Interactive && !d->AutoInstallDependencies)
-        {
-        QString msg = QString("<p>%1 depends on the following extensions:</p><ul>").arg(extensionName);
-        foreach (const QString& dependencyName, dependenciesToInstall)
-          {
-          msg += QString("<li>%1</li>").arg(dependencyName);
-          }
-        msg += "</ul><p>Would you like to install them now?</p>";
-        result = QMessageBox::question(nullptr, "Install dependencies", msg, QMessageBox::Yes | QMessageBox::No);
-        }
-      else
-        {
-        QString msg = QString("The following extensions are required by %1 extension therefore they will be installed now: %2")
-          .arg(extensionName)
-          .arg(dependenciesToInstall.join(", "));
-        qDebug() << msg;
-        }
-
-      if (result == QMessageBox::Yes)
-        {
-        // Install dependencies
-        QString msg;
-        foreach (const QString& dependency, dependenciesToInstall)
-          {
-          bool res = this->downloadAndInstallExtensionByName(dependency, false /*installation of dependencies already confirmed*/);
-          if (!res)
-            {
-            msg += QString("<li>%1</li>").arg(dependency);
-            success = false;
-            }
-          }
-        if (!msg.isEmpty())
-          {
-          d->critical(tr("Error while installing dependent extensions:<ul>%1<ul>").arg(msg));
-          }
-        }
-      else
-        {
-        // Skip installing dependencies
-        qWarning() << QString("%1 extension requires extensions %2 but the user chose not to install them.")
-          .arg(extensionName)
-          .arg(dependenciesToInstall.join(", "));
-        success = false;
-        }
-      }
-
-    // Warn about unresolved dependencies
-    if (!unresolvedDependencies.isEmpty())
-      {
-      success = false;
-      qWarning() << tr("%1 extension depends on the following extensions, which could not be found: %2")
-        .arg(extensionName)
-        .arg(unresolvedDependencies.join(", "));
-      if (d->Interactive)
-        {
-        QString msg = QString("<p>%1 depends on the following extensions, which could not be found:</p><ul>").arg(extensionName);
-        foreach(const QString & dependencyName, unresolvedDependencies)
-          {
-          msg += QString("<li>%1</li>").arg(dependencyName);
-          }
-        msg += "</ul><p>The extension may not function properly.</p>";
-        QMessageBox::warning(nullptr, "Unresolved dependencies", msg);
-        }
-      }
+    success = d->installDependencies(extensionName, directDependencies);
     }
 
   // Finish installing the extension
@@ -27,6 +27,9 @@
 /// QtCore includes
 #include "qSlicerFileReader.h"
 
+// VTK includes
+#include <vtkObject.h>
+
 //-----------------------------------------------------------------------------
 class qSlicerFileReaderPrivate
 {
@@ -104,6 +107,32 @@ bool qSlicerFileReader::load(const IOProperties& properties)
   return false;
 }
 
+//----------------------------------------------------------------------------
+bool qSlicerFileReader::canDecodeInParallel(const IOProperties& properties)const
+{
+  Q_UNUSED(properties);
+  return false;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkObject> qSlicerFileReader::decode(const IOProperties& properties,
+  vtkMRMLMessageCollection* userMessages)const
+{
+  Q_UNUSED(properties);
+  Q_UNUSED(userMessages);
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+bool qSlicerFileReader::loadDecoded(const IOProperties& properties, vtkObject* decodedData)
+{
+  Q_D(qSlicerFileReader);
+  Q_UNUSED(properties);
+  Q_UNUSED(decodedData);
+  d->LoadedNodes.clear();
+  return false;
+}
+
 //----------------------------------------------------------------------------
 void qSlicerFileReader::setLoadedNodes(const QStringList& nodes)
 {
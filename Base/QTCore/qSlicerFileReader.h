@@ -28,6 +28,10 @@
 #include "qSlicerIO.h"
 #include "qSlicerBaseQTCoreExport.h"
 
+// VTK includes
+#include <vtkSmartPointer.h>
+
+class vtkObject;
 class qSlicerFileReaderOptions;
 class qSlicerFileReaderPrivate;
 
@@ -62,6 +66,26 @@ public:
   /// Properties availables : fileMode, multipleFiles, fileType.
   virtual bool load(const IOProperties& properties);
 
+  /// Returns true if the file can be read by decode() in a worker thread.
+  /// When multiple files are loaded at once, files that can be decoded in parallel
+  /// are decoded concurrently by decode() and then added to the scene in the main
+  /// thread by loadDecoded(). Other files are loaded by load() in the main thread.
+  /// Default implementation returns false. Readers that are not thread-safe must
+  /// not override this method.
+  /// \sa decode(), loadDecoded()
+  virtual bool canDecodeInParallel(const IOProperties& properties)const;
+
+  /// Read the file without modifying the scene. This method is called from worker threads,
+  /// concurrently for different files, therefore it must not access the scene or any
+  /// other object that may be used by other threads.
+  /// \param userMessages Warning or error messages occurred while decoding this file.
+  /// eturn Decoded data that is passed to loadDecoded(). nullptr on failure.
+  virtual vtkSmartPointer<vtkObject> decode(const IOProperties& properties, vtkMRMLMessageCollection* userMessages)const;
+
+  /// Add the data read by decode() to the scene. Called from the main thread.
+  /// Must call setLoadedNodes() on success, similarly to load().
+  virtual bool loadDecoded(const IOProperties& properties, vtkObject* decodedData);
+
   /// Return the list of generated nodes from loading the file(s) in load().
   /// Empty list if load() failed
   /// \sa setLoadedNodes(), load()
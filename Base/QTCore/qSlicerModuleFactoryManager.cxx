@@ -21,6 +21,7 @@
 // Slicer includes
 #include "qSlicerModuleFactoryManager.h"
 #include "qSlicerAbstractCoreModule.h"
+#include "qSlicerStartupTracer.h"
 
 #include "vtkSlicerConfigure.h" // XXX For modulePaths() function.
 
@@ -132,6 +133,13 @@ bool qSlicerModuleFactoryManager::loadModule(const QString& name, const QString&
     return false;
     }
 
+  // Modules whose instantiation has been deferred are instantiated when
+  // they are first needed.
+  if (this->isDeferred(name))
+    {
+    this->instantiateModule(name);
+    }
+
   // A module should be registered when attempting to load it
   if (!this->isRegistered(name) ||
       !this->isInstantiated(name))
@@ -150,6 +158,7 @@ bool qSlicerModuleFactoryManager::loadModule(const QString& name, const QString&
     {
     qDebug() << "Loading module" << name;
     }
+  qSlicerStartupTracer::Span span(name, "module loading");
 
   // Instantiate the module if needed
   qSlicerAbstractCoreModule* instance = this->moduleInstance(name);
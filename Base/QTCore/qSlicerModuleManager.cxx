@@ -25,6 +25,7 @@
 #include "qSlicerCoreApplication.h"
 #include "qSlicerAbstractCoreModule.h"
 #include "qSlicerModuleFactoryManager.h"
+#include "qSlicerStartupTracer.h"
 
 // MRML includes
 
@@ -69,6 +70,12 @@ qSlicerModuleFactoryManager* qSlicerModuleManager::factoryManager()const
 qSlicerAbstractCoreModule* qSlicerModuleManager::module(const QString& name)const
 {
   Q_D(const qSlicerModuleManager);
+  // Load the module on demand if its instantiation has been deferred
+  if (d->ModuleFactoryManager->isDeferred(name))
+    {
+    qSlicerStartupTracer::Span span(name, "module loading on demand");
+    d->ModuleFactoryManager->loadModule(name);
+    }
   return d->ModuleFactoryManager->loadedModule(name);
 }
 
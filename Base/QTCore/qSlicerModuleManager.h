@@ -53,6 +53,8 @@ public:
   Q_INVOKABLE QStringList modulesNames()const;
 
   /// Return the loaded module identified by \a name
+  /// If the instantiation of the module has been deferred, the module is loaded.
+  /// \sa qSlicerAbstractModuleFactoryManager::lazyInstantiation
   Q_INVOKABLE qSlicerAbstractCoreModule* module(const QString& name)const;
 
 signals:
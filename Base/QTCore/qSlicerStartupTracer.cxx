@@ -0,0 +1,169 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+
+// Slicer includes
+#include "qSlicerStartupTracer.h"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+struct qSlicerStartupTracerSpan
+{
+  QString Name;
+  const char* Category;
+  qint64 StartTime;
+  qint64 Duration;
+  Qt::HANDLE Thread;
+};
+
+//-----------------------------------------------------------------------------
+struct qSlicerStartupTracerState
+{
+  qSlicerStartupTracerState()
+  {
+    this->Timer.start();
+  }
+
+  QMutex Mutex;
+  QElapsedTimer Timer;
+  bool Enabled = true;
+  QVector<qSlicerStartupTracerSpan> Spans;
+};
+
+//-----------------------------------------------------------------------------
+qSlicerStartupTracerState& tracerState()
+{
+  static qSlicerStartupTracerState state;
+  return state;
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+qSlicerStartupTracer::Span::Span(const QString& name, const char* category)
+  : Name(name)
+  , Category(category)
+  , StartTime(qSlicerStartupTracer::isEnabled() ? qSlicerStartupTracer::currentTime() : -1)
+{
+}
+
+//-----------------------------------------------------------------------------
+qSlicerStartupTracer::Span::~Span()
+{
+  if (this->StartTime < 0)
+    {
+    return;
+    }
+  qSlicerStartupTracer::addSpan(this->Name, this->Category,
+    this->StartTime, qSlicerStartupTracer::currentTime() - this->StartTime);
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerStartupTracer::setEnabled(bool enabled)
+{
+  qSlicerStartupTracerState& state = tracerState();
+  QMutexLocker locker(&state.Mutex);
+  state.Enabled = enabled;
+  if (!enabled)
+    {
+    state.Spans.clear();
+    state.Spans.squeeze();
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerStartupTracer::isEnabled()
+{
+  qSlicerStartupTracerState& state = tracerState();
+  QMutexLocker locker(&state.Mutex);
+  return state.Enabled;
+}
+
+//-----------------------------------------------------------------------------
+qint64 qSlicerStartupTracer::currentTime()
+{
+  return tracerState().Timer.nsecsElapsed() / 1000;
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerStartupTracer::addSpan(const QString& name, const char* category, qint64 startTime, qint64 duration)
+{
+  qSlicerStartupTracerState& state = tracerState();
+  QMutexLocker locker(&state.Mutex);
+  if (!state.Enabled)
+    {
+    return;
+    }
+  qSlicerStartupTracerSpan span;
+  span.Name = name;
+  span.Category = category;
+  span.StartTime = startTime;
+  span.Duration = duration;
+  span.Thread = QThread::currentThreadId();
+  state.Spans.append(span);
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerStartupTracer::writeTrace(const QString& filePath)
+{
+  qSlicerStartupTracerState& state = tracerState();
+  QJsonArray events;
+  {
+    QMutexLocker locker(&state.Mutex);
+    // Threads are numbered in the order of their first span, the main thread
+    // records the first spans.
+    QHash<Qt::HANDLE, int> threadIds;
+    foreach(const qSlicerStartupTracerSpan& span, state.Spans)
+      {
+      if (!threadIds.contains(span.Thread))
+        {
+        threadIds.insert(span.Thread, threadIds.count() + 1);
+        }
+      QJsonObject event;
+      event["name"] = span.Name;
+      event["cat"] = QString::fromLatin1(span.Category);
+      event["ph"] = QString("X");
+      event["ts"] = static_cast<double>(span.StartTime);
+      event["dur"] = static_cast<double>(span.Duration);
+      event["pid"] = static_cast<double>(QCoreApplication::applicationPid());
+      event["tid"] = threadIds.value(span.Thread);
+      events.append(event);
+      }
+  }
+  QJsonObject trace;
+  trace["traceEvents"] = events;
+  trace["displayTimeUnit"] = QString("ms");
+
+  QFile file(filePath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+    return false;
+    }
+  return file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact)) >= 0;
+}
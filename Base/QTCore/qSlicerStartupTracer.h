@@ -0,0 +1,70 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __qSlicerStartupTracer_h
+#define __qSlicerStartupTracer_h
+
+// Qt includes
+#include <QString>
+
+#include "qSlicerBaseQTCoreExport.h"
+
+/// \brief Record the duration of the application startup phases.
+///
+/// Spans (name, category, start time and duration) are recorded from any
+/// thread and written in the Chrome trace event format by writeTrace(). The
+/// trace can be displayed in chrome://tracing or https://ui.perfetto.dev.
+///
+/// Spans are recorded from the start of the process until the command-line
+/// arguments are parsed, then only if the --startup-trace option is specified
+/// (see qSlicerCoreCommandOptions::startupTraceFilePath()).
+///
+/// \code{.cpp}
+/// {
+///   qSlicerStartupTracer::Span span("Module discovery");
+///   factoryManager->registerModules();
+/// }
+/// \endcode
+class Q_SLICER_BASE_QTCORE_EXPORT qSlicerStartupTracer
+{
+public:
+  /// Record a span from its construction to its destruction.
+  class Q_SLICER_BASE_QTCORE_EXPORT Span
+  {
+  public:
+    Span(const QString& name, const char* category = "startup");
+    ~Span();
+  private:
+    QString Name;
+    const char* Category;
+    qint64 StartTime;
+  };
+
+  /// Enable or disable the recording. Disabling discards the recorded spans.
+  static void setEnabled(bool enabled);
+  static bool isEnabled();
+
+  /// Time elapsed since the tracer was first used, in microseconds.
+  static qint64 currentTime();
+
+  /// Record a span. Times are in microseconds, see currentTime().
+  static void addSpan(const QString& name, const char* category, qint64 startTime, qint64 duration);
+
+  /// Write the recorded spans in Chrome trace JSON format.
+  /// \return False if the file could not be written.
+  static bool writeTrace(const QString& filePath);
+};
+
+#endif
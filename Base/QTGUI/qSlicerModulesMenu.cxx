@@ -24,6 +24,7 @@
 
 // CTK includes
 #include "qSlicerAbstractModule.h"
+#include "qSlicerModuleFactoryManager.h"
 #include "qSlicerModuleManager.h"
 
 // Slicer includes
@@ -42,6 +43,12 @@ public:
   void addDefaultCategories();
 
   void addModuleAction(QMenu* menu, QAction* moduleAction, bool useIndex = true, bool builtIn = true);
+
+  /// Add a placeholder action for a module whose instantiation has been deferred.
+  /// The module is loaded when the action is selected.
+  void addDeferredModuleAction(const QString& moduleName);
+  /// Remove the placeholder action of the module, if any.
+  void removeDeferredModuleAction(const QString& moduleName);
   QMenu* menu(QMenu* parentMenu, QStringList subCategories, bool builtIn = true);
 
   bool removeTopLevelModuleAction(QAction* moduleAction);
@@ -248,6 +255,65 @@ void qSlicerModulesMenuPrivate::addModuleAction(QMenu* menu, QAction* moduleActi
   menu->addAction(moduleAction);
 }
 
+//---------------------------------------------------------------------------
+void qSlicerModulesMenuPrivate::addDeferredModuleAction(const QString& moduleName)
+{
+  Q_Q(qSlicerModulesMenu);
+  QVariantMap metadata = this->ModuleManager->factoryManager()->moduleMetadata(moduleName);
+  if (metadata.isEmpty()
+    || (metadata.value("hidden").toBool() && !this->ShowHiddenModules))
+    {
+    return;
+    }
+  QStringList categories = metadata.value("categories").toStringList();
+  bool developerModeEnabled = QSettings().value("Developer/DeveloperMode", false).toBool();
+  if (!developerModeEnabled)
+    {
+    // Same as qSlicerUtils::isTestingModule()
+    bool testOnlyModule = true;
+    foreach(const QString& category, categories)
+      {
+      if (category.split('.').takeFirst() != "Testing")
+        {
+        testOnlyModule = false;
+        break;
+        }
+      }
+    if (testOnlyModule)
+      {
+      return;
+      }
+    }
+  bool builtIn = metadata.value("builtIn").toBool();
+  QAction* moduleAction = new QAction(metadata.value("title").toString(), q);
+  moduleAction->setData(moduleName);
+  moduleAction->setProperty("index", metadata.value("index"));
+  moduleAction->setProperty("deferred", true);
+  QObject::connect(moduleAction, SIGNAL(triggered(bool)),
+                   q, SLOT(onActionTriggered()));
+  foreach(const QString& category, categories)
+    {
+    QMenu* menu = this->menu(q, category.split('.'), builtIn);
+    this->addModuleAction(menu, moduleAction, true, builtIn);
+    }
+}
+
+//---------------------------------------------------------------------------
+void qSlicerModulesMenuPrivate::removeDeferredModuleAction(const QString& moduleName)
+{
+  QAction* moduleAction = this->action(QVariant(moduleName));
+  if (!moduleAction || !moduleAction->property("deferred").toBool())
+    {
+    return;
+    }
+  // The action may be in several categories
+  while (this->removeTopLevelModuleAction(moduleAction))
+    {
+    }
+  // The action may be being triggered
+  moduleAction->deleteLater();
+}
+
 //---------------------------------------------------------------------------
 bool qSlicerModulesMenuPrivate::removeTopLevelModuleAction(QAction* moduleAction)
 {
@@ -474,6 +540,11 @@ void qSlicerModulesMenu::setModuleManager(qSlicerModuleManager* moduleManager)
                    SIGNAL(moduleAboutToBeUnloaded(QString)),
                    this, SLOT(removeModule(QString)));
   this->addModules(d->ModuleManager->modulesNames());
+  // Modules that are not loaded yet are loaded when they are selected
+  foreach(const QString& moduleName, d->ModuleManager->factoryManager()->deferredModuleNames())
+    {
+    d->addDeferredModuleAction(moduleName);
+    }
 }
 
 //---------------------------------------------------------------------------
@@ -528,6 +599,8 @@ void qSlicerModulesMenu::addModule(qSlicerAbstractCoreModule* moduleToAdd)
       }
     }
 
+  d->removeDeferredModuleAction(module->name());
+
   QAction* moduleAction = module->action();
   Q_ASSERT(moduleAction);
   if (d->DuplicateActions)
@@ -0,0 +1,92 @@
+################################################################################
+#
+#  Program: 3D Slicer
+#
+#  See COPYRIGHT.txt
+#  or http://www.slicer.org/copyright/copyright.txt for details.
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+#
+################################################################################
+
+#! Usage:
+#! \code
+#! slicer_add_performance_test(<testname>
+#!   [REPETITIONS <count>]
+#!   [TOLERANCE <percent>]
+#!   [MINIMUM_DIFFERENCE <value>]
+#!   [BENCHMARK_JSON <file> [<file> ...]]
+#!   )
+#! \endcode
+#!
+#! Add a test named perf_<testname> that runs the test <testname> (already added in the current
+#! directory, for example by simple_test() or slicer_add_python_unittest()) several times, and
+#! compares the median of each reported measurement with the baseline stored in
+#! Slicer_PERFORMANCE_TEST_BASELINE_DIR. The test fails if a median is more than TOLERANCE percent
+#! higher than the baseline. Measurements are read from <DartMeasurement> tags printed by the test
+#! and from Google Benchmark compatible JSON files written by the test (BENCHMARK_JSON).
+#!
+#! The baseline is written when it does not exist yet, or when the test is run with the
+#! SLICER_PERFORMANCE_UPDATE_BASELINES environment variable set to 1.
+#!
+#! Performance tests are only added if Slicer_BUILD_PERFORMANCE_TESTING is enabled. They have the
+#! "Performance" label and can be run by "ctest -L Performance".
+#!
+#! \ingroup CMakeUtilities
+function(slicer_add_performance_test testname)
+  if(NOT Slicer_BUILD_PERFORMANCE_TESTING)
+    return()
+  endif()
+  set(options)
+  set(oneValueArgs REPETITIONS TOLERANCE MINIMUM_DIFFERENCE)
+  set(multiValueArgs BENCHMARK_JSON)
+  cmake_parse_arguments(MY "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+  if(MY_UNPARSED_ARGUMENTS)
+    message(FATAL_ERROR "error: Unknown arguments: ${MY_UNPARSED_ARGUMENTS}")
+  endif()
+  if(NOT TEST ${testname})
+    message(FATAL_ERROR "error: Test '${testname}' is not defined !")
+  endif()
+  if("${PYTHON_EXECUTABLE}" STREQUAL "")
+    message(FATAL_ERROR "error: PYTHON_EXECUTABLE variable is not set !")
+  endif()
+
+  if("${MY_REPETITIONS}" STREQUAL "")
+    set(MY_REPETITIONS ${Slicer_PERFORMANCE_TEST_REPETITIONS})
+  endif()
+  if("${MY_TOLERANCE}" STREQUAL "")
+    set(MY_TOLERANCE ${Slicer_PERFORMANCE_TEST_TOLERANCE})
+  endif()
+  if("${MY_MINIMUM_DIFFERENCE}" STREQUAL "")
+    set(MY_MINIMUM_DIFFERENCE 0)
+  endif()
+
+  set(_driver_args)
+  foreach(_file IN LISTS MY_BENCHMARK_JSON)
+    list(APPEND _driver_args --benchmark-json ${_file})
+  endforeach()
+
+  # The test is run by ctest so that it gets exactly the same command, environment and data
+  # as when it is run as a regular test.
+  add_test(
+    NAME perf_${testname}
+    COMMAND ${PYTHON_EXECUTABLE} ${Slicer_CMAKE_DIR}/SlicerPerformanceTestDriver.py
+      --name ${testname}
+      --baseline-dir ${Slicer_PERFORMANCE_TEST_BASELINE_DIR}
+      --repetitions ${MY_REPETITIONS}
+      --tolerance ${MY_TOLERANCE}
+      --minimum-difference ${MY_MINIMUM_DIFFERENCE}
+      ${_driver_args}
+      -- ${CMAKE_CTEST_COMMAND} -C $<CONFIG> -R "^${testname}$" -V
+    WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
+    )
+  set_tests_properties(perf_${testname} PROPERTIES
+    LABELS Performance
+    RUN_SERIAL TRUE
+    )
+endfunction()
@@ -0,0 +1,151 @@
+#!/usr/bin/env python
+
+"""
+Run a performance test several times and compare the median of each measurement
+with a stored baseline.
+
+Usage:
+    SlicerPerformanceTestDriver.py --name <name> --baseline-dir <dir> [options] -- <command> [<arg> ...]
+
+Measurements are collected from the output of the command, from lines of the form
+'<DartMeasurement name="..." type="numeric/...">value</DartMeasurement>', and from
+Google Benchmark compatible JSON files (specified with --benchmark-json).
+All measurements are expected to be durations, therefore higher values are regressions.
+
+If there is no baseline yet, or if baselines update is requested (by --update-baselines
+or by setting SLICER_PERFORMANCE_UPDATE_BASELINES environment variable to 1), the
+baseline file is written and the test passes.
+
+The tolerance may be overridden by the SLICER_PERFORMANCE_TEST_TOLERANCE environment
+variable, which allows rerunning tests on a noisy machine without reconfiguring.
+"""
+
+import argparse
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+
+
+DART_MEASUREMENT_RE = re.compile(
+    r'<DartMeasurement\s+name="([^"]+)"\s+type="numeric/[a-z]+">\s*([-+0-9.eE]+)\s*</DartMeasurement>')
+
+
+# -----------------------------------------------------------------------------
+def parseDartMeasurements(output, measurements):
+    for name, value in DART_MEASUREMENT_RE.findall(output):
+        try:
+            measurements.setdefault(name, []).append(float(value))
+        except ValueError:
+            pass
+
+
+# -----------------------------------------------------------------------------
+def parseBenchmarkJSON(path, measurements):
+    with open(path) as f:
+        results = json.load(f)
+    for benchmark in results.get("benchmarks", []):
+        name = "{}-{}".format(benchmark["name"], benchmark.get("time_unit", "ns"))
+        measurements.setdefault(name, []).append(float(benchmark["real_time"]))
+
+
+# -----------------------------------------------------------------------------
+def readBaseline(path):
+    if not os.path.exists(path):
+        return None
+    with open(path) as f:
+        return json.load(f).get("measurements", {})
+
+
+# -----------------------------------------------------------------------------
+def writeBaseline(path, name, medians):
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "w") as f:
+        json.dump({"name": name, "measurements": medians}, f, indent=2, sort_keys=True)
+        f.write("\n")
+
+
+# -----------------------------------------------------------------------------
+def compare(medians, baseline, tolerance, minimumDifference):
+    """Print comparison of medians with the baseline and return the list of regressed measurements."""
+    regressions = []
+    for name in sorted(medians):
+        value = medians[name]
+        if name not in baseline:
+            print(f"{name}: {value:g} (no baseline)")
+            continue
+        reference = baseline[name]
+        change = (value - reference) / reference * 100.0 if reference > 0 else 0.0
+        regressed = value > reference * (1.0 + tolerance / 100.0) and value - reference > minimumDifference
+        print("{}: {:g} (baseline {:g}, {:+.1f}%){}".format(
+            name, value, reference, change, " REGRESSION" if regressed else ""))
+        if regressed:
+            regressions.append(name)
+    for name in sorted(set(baseline) - set(medians)):
+        print(f"{name}: not measured (baseline {baseline[name]:g})")
+    return regressions
+
+
+# -----------------------------------------------------------------------------
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--name", required=True, help="name of the test, used as baseline file name")
+    parser.add_argument("--baseline-dir", required=True, help="directory of baseline files")
+    parser.add_argument("--repetitions", type=int, default=5, help="number of times the command is run")
+    parser.add_argument("--tolerance", type=float, default=20.0,
+                        help="allowed increase of the median compared to the baseline, in percent")
+    parser.add_argument("--minimum-difference", type=float, default=0.0,
+                        help="increases smaller than this value are not reported as regressions")
+    parser.add_argument("--benchmark-json", action="append", default=[],
+                        help="Google Benchmark compatible JSON file written by the command")
+    parser.add_argument("--update-baselines", action="store_true", help="write medians as new baseline")
+    parser.add_argument("command", nargs=argparse.REMAINDER, help="command to run, after '--'")
+    args = parser.parse_args(argv)
+
+    command = args.command[1:] if args.command[:1] == ["--"] else args.command
+    if not command:
+        parser.error("command is not specified")
+    tolerance = float(os.environ.get("SLICER_PERFORMANCE_TEST_TOLERANCE", args.tolerance))
+    updateBaselines = args.update_baselines or os.environ.get("SLICER_PERFORMANCE_UPDATE_BASELINES") == "1"
+
+    measurements = {}
+    for repetition in range(max(args.repetitions, 1)):
+        for path in args.benchmark_json:
+            if os.path.exists(path):
+                os.remove(path)
+        process = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        if process.returncode != 0:
+            print(process.stdout)
+            print(f"error: run {repetition + 1} of {args.name} failed with exit code {process.returncode}")
+            return 1
+        parseDartMeasurements(process.stdout, measurements)
+        for path in args.benchmark_json:
+            parseBenchmarkJSON(path, measurements)
+
+    if not measurements:
+        print(f"error: {args.name} did not report any measurement")
+        return 1
+
+    medians = {name: statistics.median(values) for name, values in measurements.items()}
+    for name in sorted(medians):
+        print(f'<DartMeasurement name="{name}" type="numeric/double">{medians[name]:g}</DartMeasurement>')
+
+    baselinePath = os.path.join(args.baseline_dir, args.name + ".json")
+    baseline = readBaseline(baselinePath)
+    if baseline is None or updateBaselines:
+        writeBaseline(baselinePath, args.name, medians)
+        print(f"Baseline written: {baselinePath}")
+        return 0
+
+    print(f"Comparing medians of {args.repetitions} runs with {baselinePath} (tolerance {tolerance:g}%)")
+    regressions = compare(medians, baseline, tolerance, args.minimum_difference)
+    if regressions:
+        print("error: performance regression in {}".format(", ".join(regressions)))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,503 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+  All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// Micro-benchmarks of MRML core operations.
+//
+// Usage:
+//   MRMLCoreBenchmarks [--scales=1000,10000,100000] [--benchmark_filter=<substring>]
+//                      [--benchmark_out=<file.json>]
+//
+// Each benchmark is run once for each scale (number of nodes, observations or sequence items).
+// Results are printed on the standard output and, if --benchmark_out is specified, written
+// in the JSON format of Google Benchmark, so that existing tools can be used for tracking them.
+
+// MRML includes
+#include "vtkEventBroker.h"
+#include "vtkMRMLModelNode.h"
+#include "vtkMRMLScene.h"
+#include "vtkMRMLSequenceNode.h"
+#include "vtkMRMLTransformNode.h"
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+#include <vtkTimerLog.h>
+
+// STD includes
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+//---------------------------------------------------------------------------
+struct BenchmarkResult
+{
+  std::string Name;
+  int Iterations;
+  double RealTime; // seconds, for all iterations
+  double CPUTime; // seconds, for all iterations
+};
+
+//---------------------------------------------------------------------------
+/// Measures the function that is passed to Measure() and stores the result.
+/// Setup that is not measured is done by the benchmark functions before calling Measure().
+class BenchmarkRunner
+{
+public:
+  void Measure(const std::string& name, int scale, int iterations, const std::function<void()>& function)
+  {
+    vtkNew<vtkTimerLog> timer;
+    std::clock_t cpuStart = std::clock();
+    timer->StartTimer();
+    function();
+    timer->StopTimer();
+    std::clock_t cpuStop = std::clock();
+
+    BenchmarkResult result;
+    std::stringstream ss;
+    ss << name << "/" << scale;
+    result.Name = ss.str();
+    result.Iterations = iterations;
+    result.RealTime = timer->GetElapsedTime();
+    result.CPUTime = static_cast<double>(cpuStop - cpuStart) / CLOCKS_PER_SEC;
+    this->Results.push_back(result);
+
+    std::cout << std::left << std::setw(40) << result.Name << std::right
+              << std::setw(14) << std::fixed << std::setprecision(1) << this->TimePerIteration(result.RealTime, iterations) << " ns"
+              << std::setw(14) << this->TimePerIteration(result.CPUTime, iterations) << " ns"
+              << std::setw(10) << iterations << std::endl;
+  }
+
+  /// Return per-iteration time in nanoseconds.
+  static double TimePerIteration(double time, int iterations)
+  {
+    return iterations > 0 ? time * 1e9 / iterations : 0.0;
+  }
+
+  bool WriteJSON(const std::string& fileName, const std::string& executableName) const
+  {
+    std::ofstream out(fileName.c_str());
+    if (!out)
+      {
+      std::cerr << "Failed to open " << fileName << " for writing" << std::endl;
+      return false;
+      }
+    std::time_t now = std::time(nullptr);
+    char date[64];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"executable\": \"" << JSONEscape(executableName) << "\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    out << "    \"library_build_type\": \"release\"\n";
+#else
+    out << "    \"library_build_type\": \"debug\"\n";
+#endif
+    out << "  },\n";
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < this->Results.size(); ++i)
+      {
+      const BenchmarkResult& result = this->Results[i];
+      out << "    {\n";
+      out << "      \"name\": \"" << JSONEscape(result.Name) << "\",\n";
+      out << "      \"run_name\": \"" << JSONEscape(result.Name) << "\",\n";
+      out << "      \"run_type\": \"iteration\",\n";
+      out << "      \"iterations\": " << result.Iterations << ",\n";
+      out << "      \"real_time\": " << std::setprecision(3) << TimePerIteration(result.RealTime, result.Iterations) << ",\n";
+      out << "      \"cpu_time\": " << TimePerIteration(result.CPUTime, result.Iterations) << ",\n";
+      out << "      \"time_unit\": \"ns\"\n";
+      out << "    }" << (i + 1 < this->Results.size() ? "," : "") << "\n";
+      }
+    out << "  ]\n";
+    out << "}\n";
+    return true;
+  }
+
+  static std::string JSONEscape(const std::string& str)
+  {
+    std::string escaped;
+    for (char c : str)
+      {
+      if (c == '"' || c == '\\')
+        {
+        escaped += '\\';
+        }
+      escaped += c;
+      }
+    return escaped;
+  }
+
+  std::vector<BenchmarkResult> Results;
+};
+
+//---------------------------------------------------------------------------
+/// Add nodes of a few different classes, as in a typical scene.
+void populateScene(vtkMRMLScene* scene, int numberOfNodes, std::vector<std::string>* nodeIDs = nullptr)
+{
+  for (int i = 0; i < numberOfNodes; ++i)
+    {
+    vtkSmartPointer<vtkMRMLNode> node;
+    if (i % 2)
+      {
+      node = vtkSmartPointer<vtkMRMLModelNode>::New();
+      }
+    else
+      {
+      node = vtkSmartPointer<vtkMRMLTransformNode>::New();
+      }
+    std::stringstream ss;
+    ss << "Node" << i;
+    node->SetName(ss.str().c_str());
+    scene->AddNode(node);
+    if (nodeIDs)
+      {
+      nodeIDs->push_back(node->GetID());
+      }
+    }
+}
+
+//---------------------------------------------------------------------------
+void benchmarkAddRemoveNode(BenchmarkRunner& runner, int numberOfNodes)
+{
+  vtkNew<vtkMRMLScene> scene;
+  std::vector<vtkSmartPointer<vtkMRMLNode> > nodes;
+  for (int i = 0; i < numberOfNodes; ++i)
+    {
+    nodes.push_back(vtkSmartPointer<vtkMRMLTransformNode>::New());
+    }
+  runner.Measure("AddNode", numberOfNodes, numberOfNodes, [&]()
+    {
+    for (vtkMRMLNode* node : nodes)
+      {
+      scene->AddNode(node);
+      }
+    });
+  runner.Measure("RemoveNode", numberOfNodes, numberOfNodes, [&]()
+    {
+    for (vtkMRMLNode* node : nodes)
+      {
+      scene->RemoveNode(node);
+      }
+    });
+}
+
+//---------------------------------------------------------------------------
+void benchmarkGetNodeByID(BenchmarkRunner& runner, int numberOfNodes)
+{
+  vtkNew<vtkMRMLScene> scene;
+  std::vector<std::string> nodeIDs;
+  populateScene(scene, numberOfNodes, &nodeIDs);
+  const int numberOfQueries = 100000;
+  std::mt19937 randomGenerator(1);
+  std::uniform_int_distribution<int> nodeIndexDistribution(0, numberOfNodes - 1);
+  std::vector<const char*> queriedIDs;
+  for (int i = 0; i < numberOfQueries; ++i)
+    {
+    queriedIDs.push_back(nodeIDs[nodeIndexDistribution(randomGenerator)].c_str());
+    }
+  int numberOfFoundNodes = 0;
+  runner.Measure("GetNodeByID", numberOfNodes, numberOfQueries, [&]()
+    {
+    for (const char* nodeID : queriedIDs)
+      {
+      numberOfFoundNodes += (scene->GetNodeByID(nodeID) != nullptr);
+      }
+    });
+  if (numberOfFoundNodes != numberOfQueries)
+    {
+    std::cerr << "GetNodeByID: only " << numberOfFoundNodes << " nodes were found" << std::endl;
+    }
+}
+
+//---------------------------------------------------------------------------
+void benchmarkGetNodesByClass(BenchmarkRunner& runner, int numberOfNodes)
+{
+  vtkNew<vtkMRMLScene> scene;
+  populateScene(scene, numberOfNodes);
+  const int numberOfQueries = 100;
+  std::vector<vtkMRMLNode*> nodes;
+  runner.Measure("GetNodesByClass", numberOfNodes, numberOfQueries, [&]()
+    {
+    for (int i = 0; i < numberOfQueries; ++i)
+      {
+      scene->GetNodesByClass("vtkMRMLModelNode", nodes);
+      }
+    });
+}
+
+//---------------------------------------------------------------------------
+void benchmarkUndoRedo(BenchmarkRunner& runner, int numberOfNodes)
+{
+  vtkNew<vtkMRMLScene> scene;
+  scene->SetUndoOn();
+  std::vector<vtkSmartPointer<vtkMRMLModelNode> > nodes;
+  for (int i = 0; i < numberOfNodes; ++i)
+    {
+    vtkNew<vtkMRMLModelNode> node;
+    node->SetUndoEnabled(true);
+    scene->AddNode(node);
+    nodes.emplace_back(node.GetPointer());
+    }
+  const int numberOfCycles = 10;
+  runner.Measure("UndoRedo", numberOfNodes, numberOfCycles, [&]()
+    {
+    for (int i = 0; i < numberOfCycles; ++i)
+      {
+      scene->SaveStateForUndo();
+      nodes[i % numberOfNodes]->SetName("Changed");
+      scene->Undo();
+      scene->Redo();
+      }
+    });
+}
+
+//---------------------------------------------------------------------------
+void benchmarkNodeReferences(BenchmarkRunner& runner, int numberOfNodes)
+{
+  vtkNew<vtkMRMLScene> scene;
+  std::vector<std::string> nodeIDs;
+  populateScene(scene, numberOfNodes, &nodeIDs);
+  std::vector<vtkMRMLNode*> nodes;
+  scene->GetNodesByClass("vtkMRMLNode", nodes);
+  runner.Measure("AddNodeReference", numberOfNodes, numberOfNodes, [&]()
+    {
+    for (int i = 0; i < numberOfNodes; ++i)
+      {
+      nodes[i]->AddNodeReferenceID("benchmark", nodeIDs[(i + 1) % numberOfNodes].c_str());
+      }
+    });
+  runner.Measure("UpdateNodeReference", numberOfNodes, numberOfNodes, [&]()
+    {
+    for (int i = 0; i < numberOfNodes; ++i)
+      {
+      nodes[i]->SetNodeReferenceID("benchmark", nodeIDs[(i + 2) % numberOfNodes].c_str());
+      }
+    });
+  std::vector<vtkMRMLNode*> referencingNodes;
+  runner.Measure("GetReferencingNodes", numberOfNodes, numberOfNodes, [&]()
+    {
+    for (int i = 0; i < numberOfNodes; ++i)
+      {
+      scene->GetReferencingNodes(nodes[i], referencingNodes);
+      }
+    });
+}
+
+//---------------------------------------------------------------------------
+void CountingCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+                      void* clientData, void* vtkNotUsed(callData))
+{
+  int* numberOfCalls = reinterpret_cast<int*>(clientData);
+  (*numberOfCalls)++;
+}
+
+//---------------------------------------------------------------------------
+void benchmarkEventBroker(BenchmarkRunner& runner, int numberOfObservations)
+{
+  vtkEventBroker* broker = vtkEventBroker::GetInstance();
+  std::vector<vtkSmartPointer<vtkObject> > subjects;
+  for (int i = 0; i < numberOfObservations; ++i)
+    {
+    subjects.push_back(vtkSmartPointer<vtkObject>::New());
+    }
+  vtkNew<vtkObject> observer;
+  int numberOfCalls = 0;
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(CountingCallback);
+  callback->SetClientData(&numberOfCalls);
+  for (vtkObject* subject : subjects)
+    {
+    broker->AddObservation(subject, vtkCommand::ModifiedEvent, observer, callback);
+    }
+  runner.Measure("EventBrokerDispatch", numberOfObservations, numberOfObservations, [&]()
+    {
+    for (vtkObject* subject : subjects)
+      {
+      subject->Modified();
+      }
+    });
+  if (numberOfCalls != numberOfObservations)
+    {
+    std::cerr << "EventBrokerDispatch: " << numberOfCalls << " calls instead of " << numberOfObservations << std::endl;
+    }
+  broker->RemoveObservations(observer);
+}
+
+//---------------------------------------------------------------------------
+void benchmarkXMLRoundTrip(BenchmarkRunner& runner, int numberOfNodes)
+{
+  vtkNew<vtkMRMLScene> scene;
+  populateScene(scene, numberOfNodes);
+  scene->SetSaveToXMLString(1);
+  std::string xml;
+  runner.Measure("WriteXML", numberOfNodes, 1, [&]()
+    {
+    scene->Commit();
+    xml = scene->GetSceneXMLString();
+    });
+  vtkNew<vtkMRMLScene> importedScene;
+  importedScene->SetLoadFromXMLString(1);
+  importedScene->SetSceneXMLString(xml);
+  runner.Measure("ParseXML", numberOfNodes, 1, [&]()
+    {
+    importedScene->Import();
+    });
+  if (importedScene->GetNumberOfNodesByClass("vtkMRMLModelNode") != scene->GetNumberOfNodesByClass("vtkMRMLModelNode"))
+    {
+    std::cerr << "ParseXML: the number of imported model nodes does not match" << std::endl;
+    }
+}
+
+//---------------------------------------------------------------------------
+void benchmarkSequenceLookup(BenchmarkRunner& runner, int numberOfItems)
+{
+  vtkNew<vtkMRMLSequenceNode> sequenceNode;
+  sequenceNode->SetIndexType(vtkMRMLSequenceNode::NumericIndex);
+  vtkNew<vtkMRMLTransformNode> dataNode;
+  std::vector<std::string> indexValues;
+  for (int i = 0; i < numberOfItems; ++i)
+    {
+    std::stringstream ss;
+    ss << i * 0.5;
+    indexValues.push_back(ss.str());
+    sequenceNode->SetDataNodeAtValue(dataNode, indexValues.back());
+    }
+  const int numberOfQueries = 100000;
+  std::mt19937 randomGenerator(1);
+  std::uniform_int_distribution<int> itemIndexDistribution(0, numberOfItems - 1);
+  std::vector<std::string> queriedValues;
+  for (int i = 0; i < numberOfQueries; ++i)
+    {
+    queriedValues.push_back(indexValues[itemIndexDistribution(randomGenerator)]);
+    }
+  int numberOfFoundItems = 0;
+  runner.Measure("SequenceItemNumberFromIndexValue", numberOfItems, numberOfQueries, [&]()
+    {
+    for (const std::string& indexValue : queriedValues)
+      {
+      numberOfFoundItems += (sequenceNode->GetItemNumberFromIndexValue(indexValue) >= 0);
+      }
+    });
+  runner.Measure("SequenceDataNodeAtValue", numberOfItems, numberOfQueries, [&]()
+    {
+    for (const std::string& indexValue : queriedValues)
+      {
+      numberOfFoundItems += (sequenceNode->GetDataNodeAtValue(indexValue) != nullptr);
+      }
+    });
+  if (numberOfFoundItems != 2 * numberOfQueries)
+    {
+    std::cerr << "Sequence lookup: only " << numberOfFoundItems << " items were found" << std::endl;
+    }
+}
+
+//---------------------------------------------------------------------------
+bool parseScales(const std::string& scalesStr, std::vector<int>& scales)
+{
+  scales.clear();
+  std::stringstream ss(scalesStr);
+  std::string scaleStr;
+  while (std::getline(ss, scaleStr, ','))
+    {
+    int scale = atoi(scaleStr.c_str());
+    if (scale <= 0)
+      {
+      return false;
+      }
+    scales.push_back(scale);
+    }
+  return !scales.empty();
+}
+
+} // end of anonymous namespace
+
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  std::vector<int> scales = { 1000, 10000, 100000 };
+  std::string filter;
+  std::string outputFileName;
+  for (int i = 1; i < argc; ++i)
+    {
+    std::string arg = argv[i];
+    if (arg.compare(0, 9, "--scales=") == 0)
+      {
+      if (!parseScales(arg.substr(9), scales))
+        {
+        std::cerr << "Invalid scales: " << arg.substr(9) << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    else if (arg.compare(0, 19, "--benchmark_filter=") == 0)
+      {
+      filter = arg.substr(19);
+      }
+    else if (arg.compare(0, 16, "--benchmark_out=") == 0)
+      {
+      outputFileName = arg.substr(16);
+      }
+    else
+      {
+      std::cerr << "Usage: " << argv[0]
+                << " [--scales=1000,10000,100000] [--benchmark_filter=<substring>] [--benchmark_out=<file.json>]" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  typedef std::function<void(BenchmarkRunner&, int)> BenchmarkFunction;
+  std::vector<std::pair<std::string, BenchmarkFunction> > benchmarks =
+    {
+      { "AddRemoveNode", benchmarkAddRemoveNode },
+      { "GetNodeByID", benchmarkGetNodeByID },
+      { "GetNodesByClass", benchmarkGetNodesByClass },
+      { "UndoRedo", benchmarkUndoRedo },
+      { "NodeReferences", benchmarkNodeReferences },
+      { "EventBroker", benchmarkEventBroker },
+      { "XMLRoundTrip", benchmarkXMLRoundTrip },
+      { "SequenceLookup", benchmarkSequenceLookup },
+    };
+
+  std::cout << std::left << std::setw(40) << "Benchmark" << std::right
+            << std::setw(17) << "Time" << std::setw(17) << "CPU" << std::setw(10) << "Iterations" << std::endl;
+  BenchmarkRunner runner;
+  for (const auto& benchmark : benchmarks)
+    {
+    if (!filter.empty() && benchmark.first.find(filter) == std::string::npos)
+      {
+      continue;
+      }
+    for (int scale : scales)
+      {
+      benchmark.second(runner, scale);
+      }
+    }
+
+  if (!outputFileName.empty() && !runner.WriteJSON(outputFileName, argv[0]))
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
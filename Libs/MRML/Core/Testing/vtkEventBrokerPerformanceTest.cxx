@@ -0,0 +1,126 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+  All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRML includes
+#include "vtkEventBroker.h"
+#include "vtkMRMLCoreTestingMacros.h"
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+#include <vtkTimerLog.h>
+
+// STD includes
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+void CountingCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+                      void* clientData, void* vtkNotUsed(callData))
+{
+  int* numberOfCalls = reinterpret_cast<int*>(clientData);
+  (*numberOfCalls)++;
+}
+
+//----------------------------------------------------------------------------
+void printMeasurement(const char* name, int numberOfObservations, double value)
+{
+  std::cout << "<DartMeasurement name=\"vtkEventBroker-" << name << "-"
+            << numberOfObservations << "\" type=\"numeric/double\">"
+            << value << "</DartMeasurement>" << std::endl;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkEventBrokerPerformanceTest(int argc, char* argv[])
+{
+  int numberOfObservations = 100000;
+  if (argc > 1)
+    {
+    numberOfObservations = atoi(argv[1]);
+    }
+  const int numberOfSubjects = 1000;
+  const int numberOfObservers = 100;
+
+  vtkEventBroker* broker = vtkEventBroker::GetInstance();
+  int numberOfObservationsBefore = broker->GetNumberOfObservations();
+
+  std::vector<vtkSmartPointer<vtkObject> > subjects;
+  for (int i = 0; i < numberOfSubjects; ++i)
+    {
+    subjects.push_back(vtkSmartPointer<vtkObject>::New());
+    }
+  std::vector<vtkSmartPointer<vtkObject> > observers;
+  for (int i = 0; i < numberOfObservers; ++i)
+    {
+    observers.push_back(vtkSmartPointer<vtkObject>::New());
+    }
+
+  int numberOfCalls = 0;
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(CountingCallback);
+  callback->SetClientData(&numberOfCalls);
+
+  vtkNew<vtkTimerLog> timer;
+
+  // Add
+  timer->StartTimer();
+  for (int i = 0; i < numberOfObservations; ++i)
+    {
+    broker->AddObservation(subjects[i % numberOfSubjects], vtkCommand::ModifiedEvent,
+                           observers[i % numberOfObservers], callback);
+    }
+  timer->StopTimer();
+  double addTime = timer->GetElapsedTime();
+  CHECK_INT(broker->GetNumberOfObservations() - numberOfObservationsBefore, numberOfObservations);
+  CHECK_BOOL(broker->GetObservationExist(subjects[0], vtkCommand::ModifiedEvent, observers[0], callback), true);
+
+  // Dispatch
+  timer->StartTimer();
+  for (int i = 0; i < numberOfSubjects; ++i)
+    {
+    subjects[i]->Modified();
+    }
+  timer->StopTimer();
+  double dispatchTime = timer->GetElapsedTime();
+  CHECK_INT(numberOfCalls, numberOfObservations);
+
+  // Remove a few observations one by one, then all the others by observer
+  timer->StartTimer();
+  for (int i = 0; i < numberOfSubjects; ++i)
+    {
+    broker->RemoveObservations(subjects[i], vtkCommand::ModifiedEvent, observers[i % numberOfObservers], callback);
+    }
+  for (int i = 0; i < numberOfObservers; ++i)
+    {
+    broker->RemoveObservations(observers[i]);
+    }
+  timer->StopTimer();
+  double removeTime = timer->GetElapsedTime();
+  CHECK_INT(broker->GetNumberOfObservations(), numberOfObservationsBefore);
+  CHECK_BOOL(broker->GetObservationExist(subjects[0], vtkCommand::ModifiedEvent), false);
+
+  // Removed observations are not invoked anymore
+  numberOfCalls = 0;
+  subjects[0]->Modified();
+  CHECK_INT(numberOfCalls, 0);
+
+  printMeasurement("Add", numberOfObservations, addTime);
+  printMeasurement("Dispatch", numberOfObservations, dispatchTime);
+  printMeasurement("Remove", numberOfObservations, removeTime);
+
+  return EXIT_SUCCESS;
+}
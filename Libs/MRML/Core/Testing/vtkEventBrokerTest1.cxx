@@ -0,0 +1,182 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+  All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRML includes
+#include "vtkEventBroker.h"
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLModelNode.h"
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkNew.h>
+#include <vtkTable.h>
+#include <vtkVariant.h>
+
+namespace
+{
+
+struct CallbackCounter
+{
+  int NumberOfCalls{0};
+  void* LastCallData{nullptr};
+  double LastDelay{-1.0};
+};
+
+//----------------------------------------------------------------------------
+void CountingCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+                      void* clientData, void* callData)
+{
+  CallbackCounter* counter = reinterpret_cast<CallbackCounter*>(clientData);
+  counter->NumberOfCalls++;
+  counter->LastCallData = callData;
+}
+
+//----------------------------------------------------------------------------
+void FlushRequestCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+                          void* clientData, void* callData)
+{
+  CallbackCounter* counter = reinterpret_cast<CallbackCounter*>(clientData);
+  counter->NumberOfCalls++;
+  counter->LastDelay = *reinterpret_cast<double*>(callData);
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkEventBrokerTest1(int argc, char* argv[])
+{
+  vtkEventBroker* broker = vtkEventBroker::GetInstance();
+  CHECK_INT(broker->GetEventMode(), vtkEventBroker::Synchronous);
+
+  vtkNew<vtkMRMLModelNode> subject;
+  vtkNew<vtkMRMLModelNode> observer;
+
+  CallbackCounter observationCounter;
+  vtkNew<vtkCallbackCommand> observationCallback;
+  observationCallback->SetCallback(CountingCallback);
+  observationCallback->SetClientData(&observationCounter);
+  broker->AddObservation(subject, vtkCommand::ModifiedEvent, observer, observationCallback);
+
+  CallbackCounter flushCounter;
+  vtkNew<vtkCallbackCommand> flushCallback;
+  flushCallback->SetCallback(FlushRequestCallback);
+  flushCallback->SetClientData(&flushCounter);
+  broker->SetFlushEventQueueCallback(flushCallback);
+
+  // Synchronous mode: each event is invoked immediately
+  for (int i = 0; i < 10; ++i)
+    {
+    subject->InvokeEvent(vtkCommand::ModifiedEvent, &i);
+    }
+  CHECK_INT(observationCounter.NumberOfCalls, 10);
+  CHECK_INT(flushCounter.NumberOfCalls, 0);
+
+  // Coalescing mode: a burst of events results in a single invocation with the latest call data
+  observationCounter.NumberOfCalls = 0;
+  broker->SetEventModeToCoalescing();
+  CHECK_STRING(broker->GetEventModeAsString(), "Coalescing");
+  broker->SetMaximumFlushRate(0.0);
+  int callData[500];
+  for (int i = 0; i < 500; ++i)
+    {
+    subject->InvokeEvent(vtkCommand::ModifiedEvent, &callData[i]);
+    }
+  CHECK_INT(observationCounter.NumberOfCalls, 0);
+  CHECK_INT(broker->GetNumberOfQueuedObservations(), 1);
+  CHECK_INT(flushCounter.NumberOfCalls, 1);
+  CHECK_DOUBLE_TOLERANCE(flushCounter.LastDelay, 0.0, 1e-9);
+
+  broker->ProcessEventQueue();
+  CHECK_INT(observationCounter.NumberOfCalls, 1);
+  CHECK_POINTER(observationCounter.LastCallData, &callData[499]);
+  CHECK_INT(broker->GetNumberOfQueuedObservations(), 0);
+
+  // A new flush is requested after the queue is processed, delayed according to the maximum flush rate
+  broker->SetMaximumFlushRate(1.0);
+  subject->Modified();
+  subject->Modified();
+  CHECK_INT(flushCounter.NumberOfCalls, 2);
+  CHECK_BOOL(flushCounter.LastDelay > 0.0 && flushCounter.LastDelay <= 1.0, true);
+  CHECK_INT(broker->GetNumberOfQueuedObservations(), 1);
+
+  // Switching mode processes pending events
+  broker->SetEventModeToSynchronous();
+  CHECK_INT(observationCounter.NumberOfCalls, 2);
+  CHECK_INT(broker->GetNumberOfQueuedObservations(), 0);
+
+  // Profiling records invocation statistics for each (subject class, event, observer class)
+  broker->EventProfilingOn();
+  for (int i = 0; i < 5; ++i)
+    {
+    subject->Modified();
+    }
+  broker->EventProfilingOff();
+  subject->Modified();
+  vtkNew<vtkTable> statistics;
+  broker->GetProfilingStatistics(statistics);
+  CHECK_INT(statistics->GetNumberOfRows(), 1);
+  CHECK_STD_STRING(statistics->GetValueByName(0, "SubjectClass").ToString(), "vtkMRMLModelNode");
+  CHECK_STD_STRING(statistics->GetValueByName(0, "Event").ToString(), "ModifiedEvent");
+  CHECK_INT(statistics->GetValueByName(0, "Count").ToInt(), 5);
+  if (argc > 1)
+    {
+    std::string traceFileName = std::string(argv[1]) + "/vtkEventBrokerTest1_trace.json";
+    CHECK_BOOL(broker->WriteProfilingTrace(traceFileName.c_str()), true);
+    }
+  broker->ResetProfiling();
+  broker->GetProfilingStatistics(statistics);
+  CHECK_INT(statistics->GetNumberOfRows(), 0);
+
+  // Observation diagnostics
+  vtkNew<vtkMRMLModelNode> observer2;
+  broker->AddObservation(subject, vtkCommand::ModifiedEvent, observer2, observationCallback);
+  broker->AddObservation(subject, vtkCommand::DeleteEvent, observer2, observationCallback);
+  CHECK_INT(broker->GetNumberOfObservationsForSubject(subject), 3);
+  CHECK_INT(broker->GetNumberOfObservationsForSubject(subject, vtkCommand::ModifiedEvent), 2);
+  CHECK_INT(broker->GetNumberOfObservationsForSubject(observer), 0);
+  vtkNew<vtkTable> mostObserved;
+  broker->GetMostObservedSubjects(mostObserved, 1);
+  CHECK_INT(mostObserved->GetNumberOfRows(), 2); // one row for each event of the subject
+  for (int row = 0; row < mostObserved->GetNumberOfRows(); ++row)
+    {
+    CHECK_STD_STRING(mostObserved->GetValueByName(row, "SubjectClass").ToString(), "vtkMRMLModelNode");
+    CHECK_INT(mostObserved->GetValueByName(row, "SubjectCount").ToInt(), 3);
+    }
+  CHECK_INT(mostObserved->GetValueByName(0, "EventId").ToInt(), vtkCommand::DeleteEvent);
+  CHECK_INT(mostObserved->GetValueByName(1, "Count").ToInt(), 2);
+  CHECK_INT(mostObserved->GetValueByName(1, "NumberOfObservers").ToInt(), 2);
+
+  // Warning is reported when the observation count reaches the threshold
+  CallbackCounter warningCounter;
+  vtkNew<vtkCallbackCommand> warningCallback;
+  warningCallback->SetCallback(CountingCallback);
+  warningCallback->SetClientData(&warningCounter);
+  broker->AddObserver(vtkEventBroker::ObservationCountWarningEvent, warningCallback);
+  broker->SetObservationCountWarningThreshold(4);
+  TESTING_OUTPUT_ASSERT_WARNINGS_BEGIN();
+  broker->AddObservation(subject, vtkCommand::AnyEvent, observer2, observationCallback);
+  TESTING_OUTPUT_ASSERT_WARNINGS_END();
+  CHECK_INT(warningCounter.NumberOfCalls, 1);
+  CHECK_POINTER(warningCounter.LastCallData, subject.GetPointer());
+  // no warning until the count doubles
+  broker->AddObservation(subject, vtkCommand::StartEvent, observer2, observationCallback);
+  CHECK_INT(warningCounter.NumberOfCalls, 1);
+  broker->SetObservationCountWarningThreshold(0);
+  broker->RemoveObserver(warningCallback);
+  broker->RemoveObservations(observer2);
+
+  broker->SetFlushEventQueueCallback(nullptr);
+  broker->RemoveObservations(observer);
+
+  std::cout << "vtkEventBrokerTest1 passed" << std::endl;
+  return EXIT_SUCCESS;
+}
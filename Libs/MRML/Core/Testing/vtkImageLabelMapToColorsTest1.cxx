@@ -0,0 +1,84 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkImageLabelMapToColors.h"
+#include "vtkMRMLCoreTestingMacros.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkLookupTable.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkUnsignedCharArray.h>
+
+//----------------------------------------------------------------------------
+int vtkImageLabelMapToColorsTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkImageLabelMapToColors> mapper;
+  EXERCISE_BASIC_OBJECT_METHODS(mapper);
+
+  const int numberOfColors = 8;
+  vtkNew<vtkLookupTable> lut;
+  lut->SetNumberOfTableValues(numberOfColors);
+  lut->SetTableRange(0, numberOfColors - 1);
+  for (int i = 0; i < numberOfColors; ++i)
+    {
+    lut->SetTableValue(i, i / 8.0, 1.0 - i / 8.0, 0.5, i == 0 ? 0.0 : 1.0);
+    }
+
+  // labels include values below and above the table range
+  vtkNew<vtkImageData> labelMap;
+  labelMap->SetDimensions(13, 7, 3);
+  labelMap->AllocateScalars(VTK_SHORT, 1);
+  short* labels = static_cast<short*>(labelMap->GetScalarPointer());
+  for (vtkIdType i = 0; i < labelMap->GetNumberOfPoints(); ++i)
+    {
+    labels[i] = static_cast<short>(i % (numberOfColors + 4) - 2);
+    }
+
+  mapper->SetInputData(labelMap);
+  mapper->SetLookupTable(lut);
+  mapper->SetOutputFormatToRGBA();
+  CHECK_BOOL(mapper->CanUseDirectIndexing(labelMap), true);
+  mapper->Update();
+  vtkNew<vtkImageData> directOutput;
+  directOutput->DeepCopy(mapper->GetOutput());
+
+  mapper->DirectIndexingOff();
+  CHECK_BOOL(mapper->CanUseDirectIndexing(labelMap), false);
+  mapper->Update();
+  vtkImageData* referenceOutput = mapper->GetOutput();
+
+  CHECK_INT(directOutput->GetNumberOfScalarComponents(), 4);
+  vtkUnsignedCharArray* directColors = vtkUnsignedCharArray::SafeDownCast(directOutput->GetPointData()->GetScalars());
+  vtkUnsignedCharArray* referenceColors = vtkUnsignedCharArray::SafeDownCast(referenceOutput->GetPointData()->GetScalars());
+  CHECK_NOT_NULL(directColors);
+  CHECK_NOT_NULL(referenceColors);
+  CHECK_INT(directColors->GetNumberOfValues(), referenceColors->GetNumberOfValues());
+  for (vtkIdType i = 0; i < directColors->GetNumberOfValues(); ++i)
+    {
+    CHECK_INT(directColors->GetValue(i), referenceColors->GetValue(i));
+    }
+
+  // Floating-point labels are not mapped by direct indexing
+  mapper->DirectIndexingOn();
+  vtkNew<vtkImageData> floatImage;
+  floatImage->SetDimensions(2, 2, 1);
+  floatImage->AllocateScalars(VTK_FLOAT, 1);
+  CHECK_BOOL(mapper->CanUseDirectIndexing(floatImage), false);
+
+  return EXIT_SUCCESS;
+}
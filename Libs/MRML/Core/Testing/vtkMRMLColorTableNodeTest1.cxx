@@ -18,8 +18,10 @@
 #include "vtkMRMLScene.h"
 
 // VTK includes
+#include <vtkDoubleArray.h>
 #include <vtkNew.h>
 #include <vtkSmartPointer.h>
+#include <vtkStringArray.h>
 
 using namespace vtkMRMLCoreTestingUtilities;
 
@@ -106,5 +108,49 @@ int vtkMRMLColorTableNodeTest1(int argc, char * argv[])
     CHECK_STRING(colorNode->GetColorName(2), "two")
   }
 
+  // Name lookup and bulk setting of colors
+  {
+    vtkNew<vtkMRMLColorTableNode> colorNode;
+    colorNode->SetTypeToUser();
+    colorNode->SetNumberOfColors(4);
+    colorNode->NamesInitialisedOn();
+    CHECK_INT(colorNode->GetColorIndexByName(colorNode->GetNoName()), 0);
+    CHECK_INT(colorNode->GetColorIndexByName("one"), -1);
+
+    vtkNew<vtkStringArray> names;
+    names->InsertNextValue("zero");
+    names->InsertNextValue("one");
+    names->InsertNextValue("one");
+    vtkNew<vtkDoubleArray> colors;
+    colors->SetNumberOfComponents(3);
+    colors->InsertNextTuple3(0.0, 0.0, 0.0);
+    colors->InsertNextTuple3(1.0, 0.0, 0.0);
+    colors->InsertNextTuple3(0.0, 1.0, 0.0);
+    CHECK_INT(colorNode->SetColors(0, names, colors), 1);
+    CHECK_INT(colorNode->GetColorIndexByName("zero"), 0);
+    CHECK_INT(colorNode->GetColorIndexByName("one"), 1);
+    CHECK_INT(colorNode->GetColorIndexByName(colorNode->GetNoName()), 3);
+    double color[4] = { 0.0, 0.0, 0.0, 0.0 };
+    CHECK_BOOL(colorNode->GetColor(2, color), true);
+    CHECK_DOUBLE_TOLERANCE(color[1], 1.0, 1e-6);
+    CHECK_DOUBLE_TOLERANCE(color[3], 1.0, 1e-6);
+
+    // entries out of the table are rejected
+    TESTING_OUTPUT_ASSERT_ERRORS_BEGIN();
+    CHECK_INT(colorNode->SetColors(2, names, colors), 0);
+    TESTING_OUTPUT_ASSERT_ERRORS_END();
+
+    // renaming keeps the lookup up-to-date
+    colorNode->SetColorName(1, "first");
+    CHECK_INT(colorNode->GetColorIndexByName("first"), 1);
+    CHECK_INT(colorNode->GetColorIndexByName("one"), 2);
+    colorNode->SetColorName(0, "one");
+    CHECK_INT(colorNode->GetColorIndexByName("one"), 0);
+    colorNode->SetColorName(3, "three");
+    CHECK_INT(colorNode->GetColorIndexByName("three"), 3);
+    CHECK_INT(colorNode->GetColorIndexByName(colorNode->GetNoName()), -1);
+    CHECK_INT(colorNode->GetColorIndexByName("zero"), -1);
+  }
+
   return EXIT_SUCCESS;
 }
@@ -13,12 +13,141 @@
 #include "vtkMRMLCoreTestingMacros.h"
 #include "vtkMRMLGridTransformNode.h"
 #include "vtkMRMLScene.h"
+#include "vtkOrientedGridTransform.h"
 
+// VTK includes
+#include <vtkGeneralTransform.h>
+#include <vtkImageData.h>
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+int TestCachedInverseDisplacementField()
+{
+  // Smooth displacement field on a 20x20x20 grid
+  vtkNew<vtkImageData> displacementField;
+  displacementField->SetExtent(0, 19, 0, 19, 0, 19);
+  displacementField->SetSpacing(5.0, 5.0, 5.0);
+  displacementField->SetOrigin(-50.0, -50.0, -50.0);
+  displacementField->AllocateScalars(VTK_DOUBLE, 3);
+  for (int k = 0; k < 20; k++)
+    {
+    for (int j = 0; j < 20; j++)
+      {
+      for (int i = 0; i < 20; i++)
+        {
+        displacementField->SetScalarComponentFromDouble(i, j, k, 0, 3.0 * sin(j * 0.3));
+        displacementField->SetScalarComponentFromDouble(i, j, k, 1, 2.0 * cos(k * 0.2));
+        displacementField->SetScalarComponentFromDouble(i, j, k, 2, 1.0 * sin(i * 0.4));
+        }
+      }
+    }
+  vtkNew<vtkOrientedGridTransform> gridTransform;
+  gridTransform->SetDisplacementGridData(displacementField);
+
+  vtkNew<vtkMRMLGridTransformNode> transformNode;
+  transformNode->SetAndObserveTransformToParent(gridTransform);
+  transformNode->CacheInverseDisplacementFieldOn();
+
+  vtkNew<vtkGeneralTransform> transformToWorld;
+  transformNode->GetTransformToWorld(transformToWorld);
+  vtkNew<vtkGeneralTransform> transformFromWorld;
+  transformNode->GetTransformFromWorld(transformFromWorld);
+
+  // Inverse must match the forward transform within the grid
+  double point[3] = { 10.0, -5.0, 20.0 };
+  double transformedPoint[3] = { 0.0, 0.0, 0.0 };
+  transformToWorld->TransformPoint(point, transformedPoint);
+  double inverseTransformedPoint[3] = { 0.0, 0.0, 0.0 };
+  transformFromWorld->TransformPoint(transformedPoint, inverseTransformedPoint);
+  CHECK_BOOL(sqrt(vtkMath::Distance2BetweenPoints(point, inverseTransformedPoint)) < 0.5, true);
+
+  // Inverse is cached until the forward transform is modified
+  vtkNew<vtkGeneralTransform> transformFromWorld2;
+  transformNode->GetTransformFromWorld(transformFromWorld2);
+  CHECK_BOOL(vtkMRMLTransformNode::AreTransformsEqual(transformFromWorld, transformFromWorld2), true);
+  displacementField->Modified();
+  gridTransform->Modified();
+  transformNode->GetTransformFromWorld(transformFromWorld2);
+  CHECK_BOOL(vtkMRMLTransformNode::AreTransformsEqual(transformFromWorld, transformFromWorld2), false);
+
+  return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+int TestBakedTransform()
+{
+  vtkNew<vtkImageData> displacementField;
+  displacementField->SetExtent(0, 9, 0, 9, 0, 9);
+  displacementField->SetSpacing(10.0, 10.0, 10.0);
+  displacementField->SetOrigin(-50.0, -50.0, -50.0);
+  displacementField->AllocateScalars(VTK_DOUBLE, 3);
+  for (int k = 0; k < 10; k++)
+    {
+    for (int j = 0; j < 10; j++)
+      {
+      for (int i = 0; i < 10; i++)
+        {
+        displacementField->SetScalarComponentFromDouble(i, j, k, 0, 0.5 * j);
+        displacementField->SetScalarComponentFromDouble(i, j, k, 1, 0.0);
+        displacementField->SetScalarComponentFromDouble(i, j, k, 2, -0.5 * i);
+        }
+      }
+    }
+  vtkNew<vtkOrientedGridTransform> gridTransform;
+  gridTransform->SetDisplacementGridData(displacementField);
+
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkMRMLGridTransformNode> parentTransformNode;
+  scene->AddNode(parentTransformNode);
+  parentTransformNode->SetAndObserveTransformToParent(gridTransform);
+  vtkNew<vtkMRMLGridTransformNode> transformNode;
+  scene->AddNode(transformNode);
+  transformNode->SetAndObserveTransformToParent(gridTransform);
+  transformNode->SetAndObserveTransformNodeID(parentTransformNode->GetID());
+
+  // Bake the two chained transforms on a grid that matches the displacement field
+  vtkNew<vtkMatrix4x4> gridToWorld;
+  gridToWorld->SetElement(0, 0, 10.0);
+  gridToWorld->SetElement(1, 1, 10.0);
+  gridToWorld->SetElement(2, 2, 10.0);
+  gridToWorld->SetElement(0, 3, -50.0);
+  gridToWorld->SetElement(1, 3, -50.0);
+  gridToWorld->SetElement(2, 3, -50.0);
+  int extent[6] = { 0, 9, 0, 9, 0, 9 };
+  vtkOrientedGridTransform* bakedTransform = transformNode->GetBakedTransformToWorld(gridToWorld, extent);
+  CHECK_NOT_NULL(bakedTransform);
+
+  vtkNew<vtkGeneralTransform> transformToWorld;
+  transformNode->GetTransformToWorld(transformToWorld);
+  double point[3] = { 0.0, 0.0, 0.0 };
+  double expectedPoint[3] = { 0.0, 0.0, 0.0 };
+  transformToWorld->TransformPoint(point, expectedPoint);
+  double bakedPoint[3] = { 0.0, 0.0, 0.0 };
+  bakedTransform->TransformPoint(point, bakedPoint);
+  CHECK_BOOL(sqrt(vtkMath::Distance2BetweenPoints(expectedPoint, bakedPoint)) < 1e-3, true);
+
+  // Cached until the transforms change
+  CHECK_POINTER(transformNode->GetBakedTransformToWorld(gridToWorld, extent), bakedTransform);
+  displacementField->Modified();
+  CHECK_POINTER_DIFFERENT(transformNode->GetBakedTransformToWorld(gridToWorld, extent), bakedTransform);
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+//----------------------------------------------------------------------------
 int vtkMRMLGridTransformNodeTest1(int , char * [] )
 {
   vtkNew<vtkMRMLGridTransformNode> node1;
   vtkNew<vtkMRMLScene> scene;
   scene->AddNode(node1.GetPointer());
   EXERCISE_ALL_BASIC_MRML_METHODS(node1.GetPointer());
+  CHECK_EXIT_SUCCESS(TestCachedInverseDisplacementField());
+  CHECK_EXIT_SUCCESS(TestBakedTransform());
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,127 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLImageBufferPool.h"
+
+// VTK includes
+#include <vtkImageCast.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> createImage(int size)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(size, size, 1);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+  unsigned char* pixels = static_cast<unsigned char*>(image->GetScalarPointer());
+  for (vtkIdType i = 0; i < static_cast<vtkIdType>(size) * size * 4; ++i)
+    {
+    pixels[i] = static_cast<unsigned char>(i % 251);
+    }
+  return image;
+}
+
+//----------------------------------------------------------------------------
+bool checkOutput(vtkImageData* input, vtkImageData* output)
+{
+  vtkIdType numberOfValues = input->GetPointData()->GetScalars()->GetNumberOfValues();
+  if (output->GetPointData()->GetScalars()->GetNumberOfValues() != numberOfValues)
+    {
+    std::cerr << "Line " << __LINE__ << ": number of values mismatch" << std::endl;
+    return false;
+    }
+  const unsigned char* inputPixels = static_cast<unsigned char*>(input->GetScalarPointer());
+  const short* outputPixels = static_cast<short*>(output->GetScalarPointer());
+  for (vtkIdType i = 0; i < numberOfValues; ++i)
+    {
+    if (outputPixels[i] != inputPixels[i])
+      {
+      std::cerr << "Line " << __LINE__ << ": value mismatch at " << i << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkMRMLImageBufferPoolTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkMRMLImageBufferPool> pool;
+  EXERCISE_BASIC_OBJECT_METHODS(pool.GetPointer());
+
+  vtkMRMLImageBufferPool::Clear();
+  CHECK_INT(vtkMRMLImageBufferPool::GetFreeBuffersSize(), 0);
+
+  vtkNew<vtkMRMLPooledOutputImageFilter<vtkImageCast>> cast;
+  cast->SetOutputScalarTypeToShort();
+
+  // First update allocates a new buffer
+  vtkSmartPointer<vtkImageData> image = createImage(200);
+  cast->SetInputData(image);
+  cast->Update();
+  CHECK_BOOL(checkOutput(image, cast->GetOutput()), true);
+  void* firstBuffer = cast->GetOutput()->GetScalarPointer();
+
+  // Buffer of the previous output is reused
+  image->Modified();
+  cast->Update();
+  CHECK_BOOL(checkOutput(image, cast->GetOutput()), true);
+  CHECK_POINTER(cast->GetOutput()->GetScalarPointer(), firstBuffer);
+
+  // Slightly smaller output is in the same size class
+  vtkSmartPointer<vtkImageData> smallerImage = createImage(196);
+  cast->SetInputData(smallerImage);
+  cast->Update();
+  CHECK_BOOL(checkOutput(smallerImage, cast->GetOutput()), true);
+  CHECK_POINTER(cast->GetOutput()->GetScalarPointer(), firstBuffer);
+
+  // Much larger output needs a new buffer and the previous one is kept for reuse
+  vtkSmartPointer<vtkImageData> largerImage = createImage(400);
+  cast->SetInputData(largerImage);
+  cast->Update();
+  CHECK_BOOL(checkOutput(largerImage, cast->GetOutput()), true);
+  CHECK_BOOL(vtkMRMLImageBufferPool::GetFreeBuffersSize() > 0, true);
+
+  // Small images are not pooled
+  vtkSmartPointer<vtkImageData> smallImage = createImage(10);
+  cast->SetInputData(smallImage);
+  cast->Update();
+  CHECK_BOOL(checkOutput(smallImage, cast->GetOutput()), true);
+
+  vtkMRMLImageBufferPool::Clear();
+  CHECK_INT(vtkMRMLImageBufferPool::GetFreeBuffersSize(), 0);
+
+  // Released buffers are freed when the pool is full
+  vtkMRMLImageBufferPool::SetMaximumFreeBuffersSize(0);
+  CHECK_INT(vtkMRMLImageBufferPool::GetMaximumFreeBuffersSize(), 0);
+  cast->SetInputData(image);
+  cast->Update();
+  cast->SetInputData(smallImage);
+  cast->Update();
+  CHECK_INT(vtkMRMLImageBufferPool::GetFreeBuffersSize(), 0);
+  vtkMRMLImageBufferPool::SetMaximumFreeBuffersSize(262144);
+
+  return EXIT_SUCCESS;
+}
@@ -23,10 +23,12 @@ Program:   3D Slicer
 #include <vtkVoxel.h>
 
 #include <array>
+#include <cstdio>
 
 //---------------------------------------------------------------------------
 int TestReadWriteData(vtkMRMLScene* scene, const char* extension, vtkPointSet* mesh, int coordinateSystem, bool cellsMayBeSubdivided = false);
 void CreateVoxelMeshes(vtkUnstructuredGrid* ug, vtkPolyData* poly);
+int TestMemoryReference(vtkMRMLScene* scene, vtkPointSet* mesh);
 
 //---------------------------------------------------------------------------
 int vtkMRMLModelStorageNodeTest1(int argc, char * argv[])
@@ -57,6 +59,7 @@ int vtkMRMLModelStorageNodeTest1(int argc, char * argv[])
     CHECK_EXIT_SUCCESS(TestReadWriteData(scene.GetPointer(), ".vtk", ug.GetPointer(), coordinateSystem));
     CHECK_EXIT_SUCCESS(TestReadWriteData(scene.GetPointer(), ".vtu", ug.GetPointer(), coordinateSystem));
     }
+  CHECK_EXIT_SUCCESS(TestMemoryReference(scene.GetPointer(), poly.GetPointer()));
 
   std::cout << "Test passed." << std::endl;
   return EXIT_SUCCESS;
@@ -141,3 +144,35 @@ int TestReadWriteData(vtkMRMLScene* scene, const char *extension, vtkPointSet *m
 
   return EXIT_SUCCESS;
 }
+
+//---------------------------------------------------------------------------
+int TestMemoryReference(vtkMRMLScene* scene, vtkPointSet* mesh)
+{
+  vtkNew<vtkMRMLModelNode> inputModelNode;
+  inputModelNode->SetAndObserveMesh(mesh);
+  CHECK_NOT_NULL(scene->AddNode(inputModelNode.GetPointer()));
+  vtkNew<vtkMRMLModelNode> outputModelNode;
+  CHECK_NOT_NULL(scene->AddNode(outputModelNode.GetPointer()));
+
+  char inputReference[256];
+  snprintf(inputReference, sizeof(inputReference), "slicer:%p#%s", scene, inputModelNode->GetID());
+  char outputReference[256];
+  snprintf(outputReference, sizeof(outputReference), "slicer:%p#%s", scene, outputModelNode->GetID());
+  CHECK_POINTER(vtkMRMLStorageNode::GetNodeFromMemoryReference(inputReference), inputModelNode.GetPointer());
+  CHECK_NULL(vtkMRMLStorageNode::GetNodeFromMemoryReference("slicer:"));
+  CHECK_NULL(vtkMRMLStorageNode::GetNodeFromMemoryReference("/tmp/model.vtk"));
+
+  // Reading a memory reference shares the mesh without any copy
+  vtkNew<vtkMRMLModelStorageNode> storageNode;
+  vtkNew<vtkMRMLModelNode> moduleModelNode;
+  storageNode->SetFileName(inputReference);
+  CHECK_BOOL(storageNode->ReadData(moduleModelNode.GetPointer()), true);
+  CHECK_POINTER(moduleModelNode->GetMesh(), mesh);
+
+  // Writing a memory reference sets the mesh in the referenced node
+  storageNode->SetFileName(outputReference);
+  CHECK_BOOL(storageNode->WriteData(moduleModelNode.GetPointer()), true);
+  CHECK_POINTER(outputModelNode->GetMesh(), mesh);
+
+  return EXIT_SUCCESS;
+}
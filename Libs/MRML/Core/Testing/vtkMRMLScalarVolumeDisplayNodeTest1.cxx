@@ -12,10 +12,75 @@
 
 #include "vtkMRMLCoreTestingMacros.h"
 #include "vtkMRMLScalarVolumeDisplayNode.h"
+#include "vtkMRMLScalarVolumeNode.h"
+#include "vtkMRMLScene.h"
 
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+int TestAutoLevels()
+{
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(200, 200, 10);
+  imageData->AllocateScalars(VTK_UNSIGNED_SHORT, 1);
+  unsigned short* voxels = static_cast<unsigned short*>(imageData->GetScalarPointer());
+  for (vtkIdType i = 0; i < imageData->GetNumberOfPoints(); ++i)
+    {
+    voxels[i] = static_cast<unsigned short>(i % 1000);
+    }
+
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkMRMLScalarVolumeNode> volumeNode;
+  volumeNode->SetAndObserveImageData(imageData);
+  scene->AddNode(volumeNode);
+  vtkNew<vtkMRMLScalarVolumeDisplayNode> displayNode;
+  scene->AddNode(displayNode);
+  volumeNode->SetAndObserveDisplayNodeID(displayNode->GetID());
+
+  displayNode->AutoWindowLevelOn();
+  double exactMin = displayNode->GetWindowLevelMin();
+  double exactMax = displayNode->GetWindowLevelMax();
+  CHECK_DOUBLE_TOLERANCE(exactMin, 1.0, 2.0);
+  CHECK_DOUBLE_TOLERANCE(exactMax, 998.0, 2.0);
+
+  // Estimation from a subset of the voxels
+  displayNode->SetAutoLevelsMaximumNumberOfSamples(10000);
+  displayNode->AutoWindowLevelOff();
+  displayNode->AutoWindowLevelOn();
+  CHECK_DOUBLE_TOLERANCE(displayNode->GetWindowLevelMin(), exactMin, 10.0);
+  CHECK_DOUBLE_TOLERANCE(displayNode->GetWindowLevelMax(), exactMax, 10.0);
+
+  // Cached result is reused for the same voxels, and updated when voxels are modified
+  displayNode->SetAutoLevelsMaximumNumberOfSamples(0);
+  displayNode->AutoWindowLevelOff();
+  displayNode->AutoWindowLevelOn();
+  CHECK_DOUBLE_TOLERANCE(displayNode->GetWindowLevelMax(), exactMax, 1e-6);
+  for (vtkIdType i = 0; i < imageData->GetNumberOfPoints(); ++i)
+    {
+    voxels[i] = static_cast<unsigned short>(i % 100);
+    }
+  imageData->GetPointData()->GetScalars()->Modified();
+  imageData->Modified();
+  displayNode->AutoWindowLevelOff();
+  displayNode->AutoWindowLevelOn();
+  CHECK_BOOL(displayNode->GetWindowLevelMax() < 100.0, true);
+
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
 int vtkMRMLScalarVolumeDisplayNodeTest1(int , char * [] )
 {
   vtkNew<vtkMRMLScalarVolumeDisplayNode> node1;
   EXERCISE_ALL_BASIC_MRML_METHODS(node1.GetPointer());
+  CHECK_EXIT_SUCCESS(TestAutoLevels());
   return EXIT_SUCCESS;
 }
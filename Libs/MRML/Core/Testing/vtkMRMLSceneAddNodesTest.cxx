@@ -0,0 +1,79 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+  All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLCoreTestingUtilities.h"
+#include "vtkMRMLModelDisplayNode.h"
+#include "vtkMRMLModelNode.h"
+#include "vtkMRMLScene.h"
+
+// VTK includes
+#include <vtkCollection.h>
+#include <vtkNew.h>
+
+using namespace vtkMRMLCoreTestingUtilities;
+
+//---------------------------------------------------------------------------
+int vtkMRMLSceneAddNodesTest(int vtkNotUsed(argc), char * vtkNotUsed(argv)[])
+{
+  vtkNew<vtkMRMLScene> scene;
+
+  vtkNew<vtkMRMLModelNode> existingModelNode;
+  scene->AddNode(existingModelNode);
+
+  vtkNew<vtkMRMLNodeCallback> callback;
+  scene->AddObserver(vtkMRMLScene::NodeAboutToBeAddedEvent, callback);
+  scene->AddObserver(vtkMRMLScene::NodeAddedEvent, callback);
+  scene->AddObserver(vtkMRMLScene::NodesAddedEvent, callback);
+
+  // The model node references a display node that comes later in the collection
+  vtkNew<vtkCollection> nodes;
+  vtkNew<vtkMRMLModelNode> modelNode1;
+  vtkNew<vtkMRMLModelNode> modelNode2;
+  vtkNew<vtkMRMLModelDisplayNode> displayNode;
+  displayNode->SetID("vtkMRMLModelDisplayNodeBatch");
+  modelNode2->SetAndObserveDisplayNodeID("vtkMRMLModelDisplayNodeBatch");
+  nodes->AddItem(modelNode1);
+  nodes->AddItem(modelNode2);
+  nodes->AddItem(displayNode);
+
+  vtkNew<vtkCollection> addedNodes;
+  CHECK_INT(scene->AddNodes(nodes, addedNodes), 3);
+  CHECK_BOOL(scene->IsAddingNodes(), false);
+  CHECK_INT(addedNodes->GetNumberOfItems(), 3);
+  CHECK_INT(callback->GetNumberOfEvents(vtkMRMLScene::NodeAboutToBeAddedEvent), 3);
+  CHECK_INT(callback->GetNumberOfEvents(vtkMRMLScene::NodeAddedEvent), 3);
+  CHECK_INT(callback->GetNumberOfEvents(vtkMRMLScene::NodesAddedEvent), 1);
+
+  // Unique IDs and names are generated, references are resolved
+  CHECK_INT(scene->GetNumberOfNodesByClass("vtkMRMLModelNode"), 3);
+  CHECK_BOOL(modelNode1->GetID() != nullptr && modelNode2->GetID() != nullptr, true);
+  CHECK_BOOL(std::string(modelNode1->GetID()) != std::string(existingModelNode->GetID()), true);
+  CHECK_BOOL(std::string(modelNode1->GetID()) != std::string(modelNode2->GetID()), true);
+  CHECK_BOOL(std::string(modelNode1->GetName()) != std::string(modelNode2->GetName()), true);
+  CHECK_POINTER(scene->GetNodeByID(modelNode2->GetID()), modelNode2.GetPointer());
+  CHECK_STRING(displayNode->GetID(), "vtkMRMLModelDisplayNodeBatch");
+  CHECK_POINTER(modelNode2->GetDisplayNode(), displayNode.GetPointer());
+
+  // Adding an empty collection does not invoke any event
+  callback->ResetNumberOfEvents();
+  vtkNew<vtkCollection> emptyCollection;
+  CHECK_INT(scene->AddNodes(emptyCollection), 0);
+  CHECK_INT(callback->GetTotalNumberOfEvents(), 0);
+
+  TESTING_OUTPUT_ASSERT_ERRORS_BEGIN();
+  CHECK_INT(scene->AddNodes(nullptr), 0);
+  TESTING_OUTPUT_ASSERT_ERRORS_END();
+
+  return EXIT_SUCCESS;
+}
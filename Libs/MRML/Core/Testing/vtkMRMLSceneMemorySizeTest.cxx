@@ -0,0 +1,121 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+  All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLScalarVolumeNode.h"
+#include "vtkMRMLScene.h"
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkDoubleArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+#include <vtkStringArray.h>
+
+namespace
+{
+
+// Size of the test images in kibibytes
+const double ImageMemorySize = 64 * 64 * 64 * sizeof(short) / 1024.0;
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> createImage()
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(64, 64, 64);
+  image->AllocateScalars(VTK_SHORT, 1);
+  return image;
+}
+
+//----------------------------------------------------------------------------
+void onMemorySizeWarning(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* callData)
+{
+  double* reportedMemorySize = reinterpret_cast<double*>(clientData);
+  *reportedMemorySize = *reinterpret_cast<double*>(callData);
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkMRMLSceneMemorySizeTest(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkMRMLScene> scene;
+  CHECK_DOUBLE_TOLERANCE(scene->GetMemorySize(), 0.0, 1e-6);
+
+  vtkSmartPointer<vtkImageData> image = createImage();
+  vtkNew<vtkMRMLScalarVolumeNode> volumeNode1;
+  volumeNode1->SetAndObserveImageData(image);
+  scene->AddNode(volumeNode1);
+  CHECK_DOUBLE_TOLERANCE(scene->GetNodeMemorySize(volumeNode1), ImageMemorySize, 1e-6);
+
+  // Image shared between nodes
+  vtkNew<vtkMRMLScalarVolumeNode> volumeNode2;
+  volumeNode2->SetAndObserveImageData(image);
+  scene->AddNode(volumeNode2);
+  CHECK_DOUBLE_TOLERANCE(scene->GetNodeMemorySize(volumeNode1), ImageMemorySize / 2, 1e-6);
+  CHECK_DOUBLE_TOLERANCE(scene->GetNodeMemorySize(volumeNode2), ImageMemorySize / 2, 1e-6);
+
+  // Shallow copy of the image shares the voxel buffer
+  vtkNew<vtkImageData> shallowCopiedImage;
+  shallowCopiedImage->ShallowCopy(image);
+  vtkNew<vtkMRMLScalarVolumeNode> volumeNode3;
+  volumeNode3->SetAndObserveImageData(shallowCopiedImage);
+  scene->AddNode(volumeNode3);
+
+  vtkNew<vtkStringArray> nodeIDs;
+  vtkNew<vtkDoubleArray> nodeMemorySizes;
+  CHECK_DOUBLE_TOLERANCE(scene->GetNodesMemorySize(nodeIDs, nodeMemorySizes), ImageMemorySize, 1e-6);
+  CHECK_INT(nodeIDs->GetNumberOfValues(), 3);
+  CHECK_INT(nodeMemorySizes->GetNumberOfValues(), 3);
+  for (int i = 0; i < 3; ++i)
+    {
+    CHECK_DOUBLE_TOLERANCE(nodeMemorySizes->GetValue(i), ImageMemorySize / 3, 1e-6);
+    }
+
+  // Data that is only in the undo stack
+  scene->SetUndoOn();
+  volumeNode1->SetUndoEnabled(true);
+  scene->SaveStateForUndo();
+  CHECK_DOUBLE_TOLERANCE(scene->GetUndoRedoStacksMemorySize(), 0.0, 1e-6);
+  vtkSmartPointer<vtkImageData> newImage = createImage();
+  volumeNode1->SetAndObserveImageData(newImage);
+  // old image is still used by volumeNode2 and volumeNode3
+  CHECK_DOUBLE_TOLERANCE(scene->GetUndoRedoStacksMemorySize(), 0.0, 1e-6);
+  volumeNode2->SetAndObserveImageData(newImage);
+  volumeNode3->SetAndObserveImageData(newImage);
+  CHECK_DOUBLE_TOLERANCE(scene->GetUndoRedoStacksMemorySize(), ImageMemorySize, 1e-6);
+  CHECK_DOUBLE_TOLERANCE(scene->GetNodesMemorySize(), ImageMemorySize, 1e-6);
+  CHECK_DOUBLE_TOLERANCE(scene->GetMemorySize(), 2 * ImageMemorySize, 1e-6);
+  scene->ClearUndoStack();
+  CHECK_DOUBLE_TOLERANCE(scene->GetUndoRedoStacksMemorySize(), 0.0, 1e-6);
+
+  // Warning threshold
+  double reportedMemorySize = 0.0;
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(onMemorySizeWarning);
+  callback->SetClientData(&reportedMemorySize);
+  scene->AddObserver(vtkMRMLScene::MemorySizeWarningEvent, callback);
+
+  CHECK_BOOL(scene->CheckMemorySize(), true); // disabled by default
+  scene->SetMemorySizeWarningThreshold(ImageMemorySize * 2);
+  CHECK_BOOL(scene->CheckMemorySize(), true);
+  CHECK_DOUBLE_TOLERANCE(reportedMemorySize, 0.0, 1e-6);
+  scene->SetMemorySizeWarningThreshold(ImageMemorySize / 2);
+  TESTING_OUTPUT_ASSERT_WARNINGS_BEGIN();
+  CHECK_BOOL(scene->CheckMemorySize(), false);
+  TESTING_OUTPUT_ASSERT_WARNINGS_END();
+  CHECK_DOUBLE_TOLERANCE(reportedMemorySize, ImageMemorySize, 1e-6);
+
+  return EXIT_SUCCESS;
+}
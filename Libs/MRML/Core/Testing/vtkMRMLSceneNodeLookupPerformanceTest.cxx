@@ -0,0 +1,247 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+  All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLLabelMapVolumeNode.h"
+#include "vtkMRMLModelNode.h"
+#include "vtkMRMLScalarVolumeNode.h"
+#include "vtkMRMLScene.h"
+#include "vtkMRMLTransformNode.h"
+
+// VTK includes
+#include <vtkCollection.h>
+#include <vtkNew.h>
+#include <vtkTimerLog.h>
+
+// STD includes
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+int testLookupConsistency();
+int testLookupPerformance(int numberOfNodes, int numberOfQueries);
+
+//---------------------------------------------------------------------------
+// Reference implementation: linear walk over all the nodes of the scene.
+int linearGetNodesByClass(vtkMRMLScene* scene, const char* className, std::vector<vtkMRMLNode*>& nodes)
+{
+  nodes.clear();
+  vtkCollection* sceneNodes = scene->GetNodes();
+  vtkMRMLNode *node;
+  vtkCollectionSimpleIterator it;
+  for (sceneNodes->InitTraversal(it);
+       (node = (vtkMRMLNode*)sceneNodes->GetNextItemAsObject(it)) ;)
+    {
+    if (node->IsA(className))
+      {
+      nodes.push_back(node);
+      }
+    }
+  return static_cast<int>(nodes.size());
+}
+
+//---------------------------------------------------------------------------
+vtkMRMLNode* linearGetFirstNodeByName(vtkMRMLScene* scene, const char* name)
+{
+  vtkCollection* sceneNodes = scene->GetNodes();
+  vtkMRMLNode *node;
+  vtkCollectionSimpleIterator it;
+  for (sceneNodes->InitTraversal(it);
+       (node = (vtkMRMLNode*)sceneNodes->GetNextItemAsObject(it)) ;)
+    {
+    if (node->GetName() != nullptr && !strcmp(node->GetName(), name))
+      {
+      return node;
+      }
+    }
+  return nullptr;
+}
+
+//---------------------------------------------------------------------------
+bool checkNodesByClass(vtkMRMLScene* scene, const char* className, bool checkNthNode = true)
+{
+  std::vector<vtkMRMLNode*> expectedNodes;
+  linearGetNodesByClass(scene, className, expectedNodes);
+  std::vector<vtkMRMLNode*> nodes;
+  scene->GetNodesByClass(className, nodes);
+  if (nodes != expectedNodes
+    || scene->GetNumberOfNodesByClass(className) != static_cast<int>(expectedNodes.size()))
+    {
+    std::cerr << "GetNodesByClass(" << className << ") failed: "
+              << nodes.size() << " nodes found, expected " << expectedNodes.size() << std::endl;
+    return false;
+    }
+  for (int i = 0; checkNthNode && i < static_cast<int>(expectedNodes.size()); ++i)
+    {
+    if (scene->GetNthNodeByClass(i, className) != expectedNodes[i])
+      {
+      std::cerr << "GetNthNodeByClass(" << i << ", " << className << ") failed" << std::endl;
+      return false;
+      }
+    }
+  if (scene->GetNthNodeByClass(static_cast<int>(expectedNodes.size()), className) != nullptr)
+    {
+    std::cerr << "GetNthNodeByClass(" << expectedNodes.size() << ", " << className
+              << ") failed: expected nullptr" << std::endl;
+    return false;
+    }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//---------------------------------------------------------------------------
+int vtkMRMLSceneNodeLookupPerformanceTest(int argc, char * argv[])
+{
+  int numberOfNodes = 20000;
+  if (argc > 1)
+    {
+    numberOfNodes = atoi(argv[1]);
+    }
+  CHECK_EXIT_SUCCESS(testLookupConsistency());
+  CHECK_EXIT_SUCCESS(testLookupPerformance(numberOfNodes, 200));
+  return EXIT_SUCCESS;
+}
+
+namespace
+{
+
+//---------------------------------------------------------------------------
+int testLookupConsistency()
+{
+  vtkNew<vtkMRMLScene> scene;
+
+  vtkNew<vtkMRMLScalarVolumeNode> volumeNode1;
+  volumeNode1->SetName("Volume");
+  scene->AddNode(volumeNode1.GetPointer());
+  vtkNew<vtkMRMLModelNode> modelNode;
+  modelNode->SetName("Model");
+  scene->AddNode(modelNode.GetPointer());
+  vtkNew<vtkMRMLLabelMapVolumeNode> labelNode;
+  labelNode->SetName("Label");
+  scene->AddNode(labelNode.GetPointer());
+  vtkNew<vtkMRMLScalarVolumeNode> volumeNode2;
+  volumeNode2->SetName("Volume");
+  scene->AddNode(volumeNode2.GetPointer());
+
+  // Results are returned in scene order, including derived classes
+  CHECK_BOOL(checkNodesByClass(scene.GetPointer(), "vtkMRMLScalarVolumeNode"), true);
+  CHECK_BOOL(checkNodesByClass(scene.GetPointer(), "vtkMRMLVolumeNode"), true);
+  CHECK_BOOL(checkNodesByClass(scene.GetPointer(), "vtkMRMLNode"), true);
+  CHECK_BOOL(checkNodesByClass(scene.GetPointer(), "vtkMRMLTransformNode"), true);
+  CHECK_POINTER(scene->GetNthNodeByClass(1, "vtkMRMLScalarVolumeNode"), labelNode.GetPointer());
+  CHECK_POINTER(scene->GetFirstNodeByClass("vtkMRMLDisplayableNode"), volumeNode1.GetPointer());
+  CHECK_POINTER(scene->GetFirstNode("Volume", "vtkMRMLVolumeNode"), volumeNode1.GetPointer());
+
+  CHECK_POINTER(scene->GetFirstNodeByName("Volume"), volumeNode1.GetPointer());
+  vtkSmartPointer<vtkCollection> nodes = vtkSmartPointer<vtkCollection>::Take(scene->GetNodesByName("Volume"));
+  CHECK_INT(nodes->GetNumberOfItems(), 2);
+  CHECK_POINTER(nodes->GetItemAsObject(1), volumeNode2.GetPointer());
+  nodes = vtkSmartPointer<vtkCollection>::Take(scene->GetNodesByClassByName("vtkMRMLModelNode", "Volume"));
+  CHECK_INT(nodes->GetNumberOfItems(), 0);
+
+  // Renaming keeps the name index in scene order
+  volumeNode1->SetName("Renamed");
+  CHECK_POINTER(scene->GetFirstNodeByName("Volume"), volumeNode2.GetPointer());
+  CHECK_POINTER(scene->GetFirstNodeByName("Renamed"), volumeNode1.GetPointer());
+  volumeNode1->SetName("Volume");
+  CHECK_POINTER(scene->GetFirstNodeByName("Volume"), volumeNode1.GetPointer());
+  CHECK_NULL(scene->GetFirstNodeByName("Renamed"));
+
+  // Removed nodes are removed from the indexes
+  scene->RemoveNode(volumeNode1.GetPointer());
+  CHECK_POINTER(scene->GetFirstNodeByName("Volume"), volumeNode2.GetPointer());
+  CHECK_BOOL(checkNodesByClass(scene.GetPointer(), "vtkMRMLScalarVolumeNode"), true);
+  scene->RemoveNode(modelNode.GetPointer());
+  CHECK_INT(scene->GetNumberOfNodesByClass("vtkMRMLModelNode"), 0);
+  CHECK_NULL(scene->GetFirstNodeByClass("vtkMRMLModelNode"));
+  CHECK_NULL(scene->GetFirstNodeByName("Model"));
+
+  // Nodes inserted in the middle of the scene are found in scene order
+  vtkNew<vtkMRMLModelNode> insertedModelNode;
+  insertedModelNode->SetName("Volume");
+  scene->InsertBeforeNode(labelNode.GetPointer(), insertedModelNode.GetPointer());
+  CHECK_BOOL(checkNodesByClass(scene.GetPointer(), "vtkMRMLNode"), true);
+  CHECK_POINTER(scene->GetFirstNodeByName("Volume"), insertedModelNode.GetPointer());
+  scene->AddNode(modelNode.GetPointer());
+  CHECK_BOOL(checkNodesByClass(scene.GetPointer(), "vtkMRMLDisplayableNode"), true);
+  CHECK_POINTER(scene->GetNthNodeByClass(1, "vtkMRMLModelNode"), modelNode.GetPointer());
+
+  scene->Clear(1);
+  CHECK_INT(scene->GetNumberOfNodesByClass("vtkMRMLNode"), 0);
+  CHECK_NULL(scene->GetFirstNodeByName("Volume"));
+
+  return EXIT_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+int testLookupPerformance(int numberOfNodes, int numberOfQueries)
+{
+  vtkNew<vtkMRMLScene> scene;
+  for (int i = 0; i < numberOfNodes; ++i)
+    {
+    std::stringstream ss;
+    ss << "Node" << i;
+    vtkSmartPointer<vtkMRMLNode> node;
+    switch (i % 4)
+      {
+      case 0: node = vtkSmartPointer<vtkMRMLScalarVolumeNode>::New(); break;
+      case 1: node = vtkSmartPointer<vtkMRMLLabelMapVolumeNode>::New(); break;
+      case 2: node = vtkSmartPointer<vtkMRMLModelNode>::New(); break;
+      default: node = vtkSmartPointer<vtkMRMLTransformNode>::New(); break;
+      }
+    node->SetName(ss.str().c_str());
+    scene->AddNode(node);
+    }
+  // A rare class, as typical lookups (e.g., singletons, selection nodes) only return a few nodes
+  vtkNew<vtkMRMLLabelMapVolumeNode> rareNode;
+  rareNode->SetName("RareNode");
+  scene->AddNode(rareNode.GetPointer());
+
+  std::vector<vtkMRMLNode*> nodes;
+  vtkNew<vtkTimerLog> timer;
+
+  timer->StartTimer();
+  for (int i = 0; i < numberOfQueries; ++i)
+    {
+    linearGetFirstNodeByName(scene.GetPointer(), "RareNode");
+    linearGetNodesByClass(scene.GetPointer(), "vtkMRMLModelNode", nodes);
+    }
+  timer->StopTimer();
+  double linearTime = timer->GetElapsedTime();
+
+  timer->StartTimer();
+  for (int i = 0; i < numberOfQueries; ++i)
+    {
+    CHECK_POINTER(scene->GetFirstNodeByName("RareNode"), rareNode.GetPointer());
+    scene->GetNodesByClass("vtkMRMLModelNode", nodes);
+    }
+  timer->StopTimer();
+  double indexedTime = timer->GetElapsedTime();
+
+  CHECK_INT(static_cast<int>(nodes.size()), (numberOfNodes + 1) / 4);
+  CHECK_BOOL(checkNodesByClass(scene.GetPointer(), "vtkMRMLVolumeNode", false), true);
+
+  std::cout << "<DartMeasurement name=\"vtkMRMLScene-LinearLookup-"
+            << numberOfNodes << "\" type=\"numeric/double\">"
+            << linearTime << "</DartMeasurement>" << std::endl;
+  std::cout << "<DartMeasurement name=\"vtkMRMLScene-IndexedLookup-"
+            << numberOfNodes << "\" type=\"numeric/double\">"
+            << indexedTime << "</DartMeasurement>" << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
@@ -0,0 +1,134 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+  All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLCoreTestingUtilities.h"
+#include "vtkMRMLModelNode.h"
+#include "vtkMRMLScene.h"
+
+// VTK includes
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <sstream>
+#include <vector>
+
+using namespace vtkMRMLCoreTestingUtilities;
+
+//---------------------------------------------------------------------------
+int vtkMRMLSceneUndoTest(int vtkNotUsed(argc), char * vtkNotUsed(argv)[])
+{
+  vtkNew<vtkMRMLScene> scene;
+  scene->SetUndoOn();
+  CHECK_BOOL(scene->GetUndoBulkDataSharing(), true);
+
+  const int numberOfNodes = 10;
+  std::vector<vtkSmartPointer<vtkMRMLModelNode> > modelNodes;
+  for (int i = 0; i < numberOfNodes; ++i)
+    {
+    vtkNew<vtkMRMLModelNode> modelNode;
+    std::stringstream ss;
+    ss << "Model" << i;
+    modelNode->SetName(ss.str().c_str());
+    modelNode->SetUndoEnabled(true);
+    vtkNew<vtkPolyData> polyData;
+    modelNode->SetAndObservePolyData(polyData);
+    scene->AddNode(modelNode);
+    modelNodes.emplace_back(modelNode.GetPointer());
+    }
+
+  // Only the modified node is copied back on undo
+  scene->SaveStateForUndo();
+  CHECK_INT(scene->GetNumberOfUndoLevels(), 1);
+  modelNodes[0]->SetName("Changed");
+  vtkNew<vtkMRMLNodeCallback> callback;
+  for (int i = 1; i < numberOfNodes; ++i)
+    {
+    modelNodes[i]->AddObserver(vtkCommand::ModifiedEvent, callback);
+    }
+  scene->Undo();
+  CHECK_STRING(modelNodes[0]->GetName(), "Model0");
+  CHECK_INT(callback->GetNumberOfModified(), 0);
+  CHECK_INT(scene->GetNumberOfUndoLevels(), 0);
+  CHECK_INT(scene->GetNumberOfRedoLevels(), 1);
+
+  scene->Redo();
+  CHECK_STRING(modelNodes[0]->GetName(), "Changed");
+  CHECK_INT(callback->GetNumberOfModified(), 0);
+  CHECK_INT(scene->GetNumberOfUndoLevels(), 1);
+  CHECK_INT(scene->GetNumberOfRedoLevels(), 0);
+
+  // Unchanged nodes are not copied again in subsequent states
+  scene->SaveStateForUndo();
+  scene->SaveStateForUndo();
+  scene->Undo();
+  scene->Undo();
+  scene->Undo();
+  CHECK_STRING(modelNodes[0]->GetName(), "Model0");
+  CHECK_INT(callback->GetNumberOfModified(), 0);
+  scene->ClearRedoStack();
+
+  // Bulk data is shared with the saved states
+  vtkPolyData* originalPolyData = modelNodes[2]->GetPolyData();
+  scene->SaveStateForUndo();
+  vtkNew<vtkPolyData> newPolyData;
+  modelNodes[2]->SetAndObservePolyData(newPolyData);
+  scene->Undo();
+  CHECK_POINTER(modelNodes[2]->GetPolyData(), originalPolyData);
+  scene->Redo();
+  CHECK_POINTER(modelNodes[2]->GetPolyData(), newPolyData.GetPointer());
+
+  // Saved states are independent if bulk data sharing is disabled
+  scene->UndoBulkDataSharingOff();
+  modelNodes[2]->SetAndObservePolyData(originalPolyData);
+  scene->SaveStateForUndo();
+  modelNodes[2]->SetAndObservePolyData(newPolyData);
+  scene->Undo();
+  CHECK_POINTER_DIFFERENT(modelNodes[2]->GetPolyData(), originalPolyData);
+  CHECK_POINTER_DIFFERENT(modelNodes[2]->GetPolyData(), newPolyData.GetPointer());
+  scene->UndoBulkDataSharingOn();
+
+  // Removed nodes are restored
+  std::string removedNodeID = modelNodes[3]->GetID();
+  scene->SaveStateForUndo();
+  scene->RemoveNode(modelNodes[3]);
+  CHECK_NULL(scene->GetNodeByID(removedNodeID));
+  scene->Undo();
+  CHECK_NOT_NULL(scene->GetNodeByID(removedNodeID));
+  CHECK_STRING(scene->GetNodeByID(removedNodeID)->GetName(), "Model3");
+  scene->Redo();
+  CHECK_NULL(scene->GetNodeByID(removedNodeID));
+  scene->Undo();
+  CHECK_NOT_NULL(scene->GetNodeByID(removedNodeID));
+  CHECK_STRING(scene->GetNodeByID(removedNodeID)->GetName(), "Model3");
+
+  // Added nodes are removed
+  vtkNew<vtkMRMLModelNode> addedNode;
+  addedNode->SetUndoEnabled(true);
+  scene->SaveStateForUndo();
+  scene->AddNode(addedNode);
+  std::string addedNodeID = addedNode->GetID();
+  scene->Undo();
+  CHECK_NULL(scene->GetNodeByID(addedNodeID));
+  scene->Redo();
+  CHECK_POINTER(scene->GetNodeByID(addedNodeID), addedNode.GetPointer());
+
+  scene->ClearUndoStack();
+  scene->ClearRedoStack();
+  CHECK_INT(scene->GetNumberOfUndoLevels(), 0);
+  CHECK_INT(scene->GetNumberOfRedoLevels(), 0);
+
+  return EXIT_SUCCESS;
+}
@@ -26,6 +26,7 @@
 #include "vtkMRMLSceneViewNode.h"
 
 // VTK includes
+#include <vtkImageData.h>
 #include <vtkNew.h>
 #include <vtkSmartPointer.h>
 
@@ -35,6 +36,54 @@ namespace
 vtkMRMLScene* createScene();
 int restoreEditAndRestore();
 int removeRestoreEditAndRestore();
+int restoreSharedBulkData();
+
+//---------------------------------------------------------------------------
+int restoreSharedBulkData()
+{
+  vtkSmartPointer<vtkMRMLScene> scene;
+  scene.TakeReference(createScene());
+
+  vtkMRMLScalarVolumeNode* volumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    scene->GetNodeByID("vtkMRMLScalarVolumeNode1"));
+  vtkMRMLNode* displayNode = scene->GetNodeByID("vtkMRMLScalarVolumeDisplayNode1");
+  vtkNew<vtkImageData> storedImageData;
+  storedImageData->SetDimensions(10, 10, 10);
+  storedImageData->AllocateScalars(VTK_SHORT, 1);
+  volumeNode->SetAndObserveImageData(storedImageData);
+
+  vtkNew<vtkMRMLSceneViewNode> sceneViewNode;
+  scene->AddNode(sceneViewNode.GetPointer());
+  sceneViewNode->StoreScene();
+
+  // Image data is shared between the scene and the scene view
+  vtkMRMLScalarVolumeNode* storedVolumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    sceneViewNode->GetStoredScene()->GetNodeByID("vtkMRMLScalarVolumeNode1"));
+  CHECK_NOT_NULL(storedVolumeNode);
+  CHECK_POINTER(storedVolumeNode->GetImageData(), storedImageData.GetPointer());
+
+  // Replaced image data is restored
+  vtkNew<vtkImageData> newImageData;
+  newImageData->SetDimensions(5, 5, 5);
+  newImageData->AllocateScalars(VTK_SHORT, 1);
+  volumeNode->SetAndObserveImageData(newImageData);
+  vtkMTimeType displayNodeMTime = displayNode->GetMTime();
+  CHECK_BOOL(sceneViewNode->RestoreScene(), true);
+  CHECK_POINTER(volumeNode->GetImageData(), storedImageData.GetPointer());
+
+  // Nodes that have not changed since they were stored are not modified
+  CHECK_BOOL(displayNode->GetMTime() == displayNodeMTime, true);
+
+  // Stored nodes are independent copies if bulk data sharing is disabled
+  sceneViewNode->BulkDataSharingOff();
+  sceneViewNode->StoreScene();
+  storedVolumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    sceneViewNode->GetStoredScene()->GetNodeByID("vtkMRMLScalarVolumeNode1"));
+  CHECK_NOT_NULL(storedVolumeNode);
+  CHECK_POINTER_DIFFERENT(storedVolumeNode->GetImageData(), storedImageData.GetPointer());
+
+  return EXIT_SUCCESS;
+}
 
 } // end of anonymous namespace
 
@@ -44,6 +93,7 @@ int vtkMRMLSceneViewNodeRestoreSceneTest(int vtkNotUsed(argc),
 {
   CHECK_EXIT_SUCCESS(restoreEditAndRestore());
   CHECK_EXIT_SUCCESS(removeRestoreEditAndRestore());
+  CHECK_EXIT_SUCCESS(restoreSharedBulkData());
   return EXIT_SUCCESS;
 }
 
@@ -125,4 +175,51 @@ int removeRestoreEditAndRestore()
   return EXIT_SUCCESS;
 }
 
+//---------------------------------------------------------------------------
+int restoreSharedBulkData()
+{
+  vtkSmartPointer<vtkMRMLScene> scene;
+  scene.TakeReference(createScene());
+
+  vtkMRMLScalarVolumeNode* volumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    scene->GetNodeByID("vtkMRMLScalarVolumeNode1"));
+  vtkMRMLNode* displayNode = scene->GetNodeByID("vtkMRMLScalarVolumeDisplayNode1");
+  vtkNew<vtkImageData> storedImageData;
+  storedImageData->SetDimensions(10, 10, 10);
+  storedImageData->AllocateScalars(VTK_SHORT, 1);
+  volumeNode->SetAndObserveImageData(storedImageData);
+
+  vtkNew<vtkMRMLSceneViewNode> sceneViewNode;
+  scene->AddNode(sceneViewNode.GetPointer());
+  sceneViewNode->StoreScene();
+
+  // Image data is shared between the scene and the scene view
+  vtkMRMLScalarVolumeNode* storedVolumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    sceneViewNode->GetStoredScene()->GetNodeByID("vtkMRMLScalarVolumeNode1"));
+  CHECK_NOT_NULL(storedVolumeNode);
+  CHECK_POINTER(storedVolumeNode->GetImageData(), storedImageData.GetPointer());
+
+  // Replaced image data is restored
+  vtkNew<vtkImageData> newImageData;
+  newImageData->SetDimensions(5, 5, 5);
+  newImageData->AllocateScalars(VTK_SHORT, 1);
+  volumeNode->SetAndObserveImageData(newImageData);
+  vtkMTimeType displayNodeMTime = displayNode->GetMTime();
+  CHECK_BOOL(sceneViewNode->RestoreScene(), true);
+  CHECK_POINTER(volumeNode->GetImageData(), storedImageData.GetPointer());
+
+  // Nodes that have not changed since they were stored are not modified
+  CHECK_BOOL(displayNode->GetMTime() == displayNodeMTime, true);
+
+  // Stored nodes are independent copies if bulk data sharing is disabled
+  sceneViewNode->BulkDataSharingOff();
+  sceneViewNode->StoreScene();
+  storedVolumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    sceneViewNode->GetStoredScene()->GetNodeByID("vtkMRMLScalarVolumeNode1"));
+  CHECK_NOT_NULL(storedVolumeNode);
+  CHECK_POINTER_DIFFERENT(storedVolumeNode->GetImageData(), storedImageData.GetPointer());
+
+  return EXIT_SUCCESS;
+}
+
 } // end of anonymous namespace
@@ -32,6 +32,7 @@ int GetSliceOrientationPresetTest();
 int GetSliceOrientationPresetNameTest();
 int SetOrientationTest();
 int InitializeDefaultMatrixTest();
+int InteractionResolutionReductionTest();
 
 //----------------------------------------------------------------------------
 int vtkMRMLSliceNodeTest1(int , char * [] )
@@ -48,6 +49,7 @@ int vtkMRMLSliceNodeTest1(int , char * [] )
   CHECK_EXIT_SUCCESS(GetSliceOrientationPresetNameTest());
   CHECK_EXIT_SUCCESS(SetOrientationTest());
   CHECK_EXIT_SUCCESS(InitializeDefaultMatrixTest());
+  CHECK_EXIT_SUCCESS(InteractionResolutionReductionTest());
 
   return EXIT_SUCCESS;
 }
@@ -426,3 +428,23 @@ int InitializeDefaultMatrixTest()
 
   return EXIT_SUCCESS;
 }
+
+//----------------------------------------------------------------------------
+int InteractionResolutionReductionTest()
+{
+  vtkNew<vtkMRMLSliceNode> sliceNode;
+  CHECK_INT(sliceNode->GetInteractionResolutionReduction(), 1);
+  CHECK_INT(sliceNode->GetCurrentResolutionReduction(), 1);
+
+  sliceNode->SetInteractionResolutionReduction(4);
+  CHECK_INT(sliceNode->GetCurrentResolutionReduction(), 1);
+  sliceNode->SetInteractionFlags(vtkMRMLSliceNode::XYZOriginFlag);
+  CHECK_INT(sliceNode->GetCurrentResolutionReduction(), 4);
+  sliceNode->SetInteractionFlags(0);
+  CHECK_INT(sliceNode->GetCurrentResolutionReduction(), 1);
+
+  sliceNode->SetInteractionResolutionReduction(0);
+  CHECK_INT(sliceNode->GetInteractionResolutionReduction(), 1);
+
+  return EXIT_SUCCESS;
+}
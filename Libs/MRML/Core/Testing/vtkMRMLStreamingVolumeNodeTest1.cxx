@@ -98,5 +98,19 @@ int vtkMRMLStreamingVolumeNodeTest1(int , char * [] )
       }
     }
 
+  // Prefetched image data is taken over by the copy, the frame is not decoded again
+  vtkSmartPointer<vtkImageData> prefetchedImageData = vtkSmartPointer<vtkImageData>::New();
+  prefetchedImageData->DeepCopy(imageData2);
+  streamingVolumeNode2->SetPrefetchedImageData(frameData, prefetchedImageData);
+  vtkSmartPointer<vtkMRMLStreamingVolumeNode> streamingVolumeNode3 = vtkSmartPointer<vtkMRMLStreamingVolumeNode>::New();
+  streamingVolumeNode3->CopyContent(streamingVolumeNode2, false);
+  CHECK_POINTER(streamingVolumeNode3->GetFrame(), frameData.GetPointer());
+  CHECK_POINTER(streamingVolumeNode3->GetImageData(), prefetchedImageData.GetPointer());
+
+  // Prefetched image data is only used once
+  vtkSmartPointer<vtkMRMLStreamingVolumeNode> streamingVolumeNode4 = vtkSmartPointer<vtkMRMLStreamingVolumeNode>::New();
+  streamingVolumeNode4->CopyContent(streamingVolumeNode2, false);
+  CHECK_POINTER(streamingVolumeNode4->GetImageData(), imageData2.GetPointer());
+
   return EXIT_SUCCESS;
 }
@@ -111,6 +111,24 @@ int vtkMRMLTableSQLiteStorageNodeTest(int , char * [] )
     return EXIT_FAILURE;
     }
 
+  // read a window of rows
+  if (storageNode->GetNumberOfRowsInDatabase() != numPoints)
+    {
+    std::cerr << "Unable to get number of rows in the database " << storageNode->GetFileName() <<std::endl;
+    removeFile(storageNode->GetFileName());
+    return EXIT_FAILURE;
+    }
+  storageNode->SetFirstRowToRead(numPoints - 4);
+  storageNode->SetMaximumNumberOfRowsToRead(10);
+  storageNode->ReadData(tableNode.GetPointer());
+  if (tableNode->GetNumberOfRows() != 4
+    || fabs(tableNode->GetTable()->GetValue(0, 0).ToDouble() - (numPoints - 4) * inc) > 1e-4)
+    {
+    std::cerr << "Unable to read a window of table rows from the database " << storageNode->GetFileName() <<std::endl;
+    removeFile(storageNode->GetFileName());
+    return EXIT_FAILURE;
+    }
+
   // clean up
   removeFile(storageNode->GetFileName());
 
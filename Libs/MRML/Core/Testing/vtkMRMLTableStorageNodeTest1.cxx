@@ -30,9 +30,13 @@
 
 #include <vtksys/SystemTools.hxx>
 
+// STD includes
+#include <fstream>
+
 //---------------------------------------------------------------------------
 int TestReadWriteWithoutSchema(vtkMRMLScene* scene);
 int TestReadWriteWithSchema(vtkMRMLScene* scene);
+int TestReadQuotedValues(vtkMRMLScene* scene);
 int TestReadWriteData(vtkMRMLScene* scene, const char *extension, vtkTable* table, bool schemaExpected);
 
 int vtkMRMLTableStorageNodeTest1(int argc, char * argv[])
@@ -52,6 +56,7 @@ int vtkMRMLTableStorageNodeTest1(int argc, char * argv[])
 
   CHECK_EXIT_SUCCESS(TestReadWriteWithoutSchema(scene.GetPointer()));
   CHECK_EXIT_SUCCESS(TestReadWriteWithSchema(scene.GetPointer()));
+  CHECK_EXIT_SUCCESS(TestReadQuotedValues(scene.GetPointer()));
 
   std::cout << "Test passed." << std::endl;
   return EXIT_SUCCESS;
@@ -113,6 +118,42 @@ int TestReadWriteWithSchema(vtkMRMLScene* scene)
   return EXIT_SUCCESS;
 }
 
+//---------------------------------------------------------------------------
+int TestReadQuotedValues(vtkMRMLScene* scene)
+{
+  std::string fileName = std::string(scene->GetRootDirectory()) +
+    std::string("/vtkMRMLTableStorageNodeTest1Quoted.csv");
+  {
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary);
+  // delimiters and line breaks in quotes, Windows line endings, empty row, missing last field
+  file << "name,value\r\n\"a,b\",1\r\n\r\n\"multi\nline\",\"2\"\r\nc";
+  }
+
+  vtkNew<vtkMRMLTableNode> tableNode;
+  CHECK_NOT_NULL(scene->AddNode(tableNode.GetPointer()));
+  vtkNew<vtkMRMLTableStorageNode> storageNode;
+  CHECK_NOT_NULL(scene->AddNode(storageNode.GetPointer()));
+  storageNode->SetFileName(fileName.c_str());
+  CHECK_BOOL(storageNode->ReadData(tableNode.GetPointer()), true);
+
+  vtkTable* table = tableNode->GetTable();
+  CHECK_NOT_NULL(table);
+  CHECK_INT(table->GetNumberOfColumns(), 2);
+  CHECK_INT(table->GetNumberOfRows(), 3);
+  CHECK_STD_STRING(table->GetColumnName(0), "name");
+  CHECK_STD_STRING(table->GetValue(0, 0).ToString(), "a,b");
+  CHECK_STD_STRING(table->GetValue(0, 1).ToString(), "1");
+  CHECK_STD_STRING(table->GetValue(1, 0).ToString(), "multi\nline");
+  CHECK_STD_STRING(table->GetValue(1, 1).ToString(), "2");
+  CHECK_STD_STRING(table->GetValue(2, 0).ToString(), "c");
+  CHECK_STD_STRING(table->GetValue(2, 1).ToString(), "");
+
+  vtksys::SystemTools::RemoveFile(fileName);
+  scene->RemoveNode(tableNode.GetPointer());
+  scene->RemoveNode(storageNode.GetPointer());
+  return EXIT_SUCCESS;
+}
+
 //---------------------------------------------------------------------------
 int TestReadWriteData(vtkMRMLScene* scene, const char *extension, vtkTable* table, bool schemaExpected)
 {
@@ -0,0 +1,108 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLTraceRecorder.h"
+
+// VTK includes
+#include <vtkNew.h>
+
+// STD includes
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+std::string readTraceFile(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str());
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+//----------------------------------------------------------------------------
+int countOccurrences(const std::string& str, const std::string& pattern)
+{
+  int count = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+    {
+    ++count;
+    }
+  return count;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkMRMLTraceRecorderTest1(int argc, char* argv[])
+{
+  if (argc < 2)
+    {
+    std::cerr << "Line " << __LINE__ << " - Missing parameters !\n"
+              << "Usage: " << argv[0] << " /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::string fileName = std::string(argv[1]) + "/vtkMRMLTraceRecorderTest1.json";
+
+  vtkNew<vtkMRMLTraceRecorder> recorder;
+  EXERCISE_BASIC_OBJECT_METHODS(recorder.GetPointer());
+
+  // Disabled by default, nothing is recorded
+  CHECK_BOOL(vtkMRMLTraceRecorder::GetEnabled(), false);
+    {
+    vtkMRMLTraceRecorder::Scope scope("DisabledSpan");
+    }
+
+  vtkMRMLTraceRecorder::SetEnabled(true);
+    {
+    vtkMRMLTraceRecorder::Scope outerScope("OuterSpan");
+      {
+      vtkMRMLTraceRecorder::Scope innerScope("Inner\"Span");
+      }
+    }
+  vtkMRMLTraceRecorder::SetEnabled(false);
+
+  CHECK_BOOL(vtkMRMLTraceRecorder::WriteTraceFile(fileName.c_str()), true);
+  std::string content = readTraceFile(fileName);
+  CHECK_INT(countOccurrences(content, "DisabledSpan"), 0);
+  CHECK_INT(countOccurrences(content, "\"name\":\"OuterSpan\""), 2);
+  CHECK_INT(countOccurrences(content, "\"name\":\"Inner\\\"Span\""), 2);
+  CHECK_INT(countOccurrences(content, "\"ph\":\"B\""), 2);
+  CHECK_INT(countOccurrences(content, "\"ph\":\"E\""), 2);
+
+  // Clear removes all events
+  vtkMRMLTraceRecorder::Clear();
+  CHECK_BOOL(vtkMRMLTraceRecorder::WriteTraceFile(fileName.c_str()), true);
+  content = readTraceFile(fileName);
+  CHECK_INT(countOccurrences(content, "\"ph\":"), 0);
+
+  // Only the most recent events are kept when the buffer is full
+  vtkMRMLTraceRecorder::SetEnabled(true);
+  for (int i = 0; i < vtkMRMLTraceRecorder::GetBufferSize(); ++i)
+    {
+    vtkMRMLTraceRecorder::Scope scope("RepeatedSpan");
+    }
+  vtkMRMLTraceRecorder::SetEnabled(false);
+  CHECK_BOOL(vtkMRMLTraceRecorder::WriteTraceFile(fileName.c_str()), true);
+  content = readTraceFile(fileName);
+  CHECK_INT(countOccurrences(content, "\"ph\":"), vtkMRMLTraceRecorder::GetBufferSize());
+
+  return EXIT_SUCCESS;
+}
@@ -11,6 +11,7 @@
 =========================================================================auto=*/
 
 #include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLCoreTestingUtilities.h"
 #include "vtkMRMLInteractionNode.h"
 #include "vtkMRMLScene.h"
 #include "vtkMRMLViewNode.h"
@@ -48,5 +49,22 @@ int vtkMRMLViewNodeTest1(int , char * [] )
     CHECK_POINTER_DIFFERENT(otherInteractionNode.GetPointer(), scene->GetNodeByID("vtkMRMLInteractionNodeSingleton"));
   }
 
+  // Test volume rendering statistics
+  {
+    vtkNew<vtkMRMLViewNode> viewNode;
+    vtkNew<vtkMRMLCoreTestingUtilities::vtkMRMLNodeCallback> callback;
+    viewNode->AddObserver(vtkCommand::AnyEvent, callback.GetPointer());
+    viewNode->SetVolumeRenderingStatistics(12.5, 256.0, 40.0);
+    CHECK_DOUBLE(viewNode->GetVolumeRenderingFrameTime(), 12.5);
+    CHECK_DOUBLE(viewNode->GetVolumeRenderingTextureMemorySize(), 256.0);
+    CHECK_DOUBLE(viewNode->GetVolumeRenderingTextureUploadTime(), 40.0);
+    // Statistics updates must not trigger rendering
+    CHECK_INT(callback->GetNumberOfModified(), 0);
+    CHECK_INT(callback->GetNumberOfEvents(vtkMRMLViewNode::VolumeRenderingStatisticsModifiedEvent), 1);
+    callback->ResetNumberOfEvents();
+    viewNode->SetVolumeRenderingStatistics(12.5, 256.0, 40.0);
+    CHECK_INT(callback->GetTotalNumberOfEvents(), 0);
+  }
+
   return EXIT_SUCCESS;
 }
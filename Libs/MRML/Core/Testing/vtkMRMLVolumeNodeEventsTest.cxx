@@ -211,6 +211,39 @@ int vtkMRMLVolumeNodeEventsTest(int , char * [] )
     }
   callback->ResetNumberOfEvents();
 
+  // Report modification of a sub-extent of the voxels
+  imageData2->SetDimensions(10, 10, 10);
+  imageData2->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  callback->ResetNumberOfEvents();
+  wasModifying = volumeNode->StartModify();
+  int modifiedExtent1[6] = { 2, 3, 2, 3, 2, 3 };
+  volumeNode->ImageDataModifiedInExtent(modifiedExtent1);
+  int modifiedExtent2[6] = { 5, 12, 1, 2, 3, 4 };
+  volumeNode->ImageDataModifiedInExtent(modifiedExtent2);
+  int modifiedExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  volumeNode->GetImageDataModifiedExtent(modifiedExtent);
+  int expectedModifiedExtent[6] = { 2, 9, 1, 3, 2, 4 };
+  for (int i = 0; i < 6; i++)
+    {
+    CHECK_INT(modifiedExtent[i], expectedModifiedExtent[i]);
+    }
+  volumeNode->EndModify(wasModifying);
+  if (!callback->GetErrorString().empty() ||
+      callback->GetNumberOfEvents(vtkMRMLVolumeNode::ImageDataModifiedEvent) != 1)
+    {
+    std::cerr << __LINE__ << ": vtkMRMLVolumeNode::ImageDataModifiedInExtent failed: "
+              << callback->GetErrorString().c_str() << " "
+              << "Number of ImageDataModifiedEvent: "
+              << callback->GetNumberOfEvents(vtkMRMLVolumeNode::ImageDataModifiedEvent)
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+  callback->ResetNumberOfEvents();
+  // after the notification the whole image data is reported
+  volumeNode->GetImageDataModifiedExtent(modifiedExtent);
+  CHECK_INT(modifiedExtent[1], 9);
+  CHECK_INT(modifiedExtent[2], 0);
+
   // Clear image data
   volumeNode->SetAndObserveImageData(nullptr);
 
@@ -61,6 +61,44 @@ public:
       }
     vtkArchiveTools::Message(message.c_str(), "Error");
   }
+  // Returns true if the file content is already compressed, therefore compressing it again
+  // in the archive would only cost time (e.g., gzip-encoded nrrd, png, nested zip files).
+  static bool IsFileContentCompressed(const std::string& fileName)
+  {
+    std::string name = vtksys::SystemTools::LowerCase(fileName);
+    const char* compressedExtensions[] = { ".gz", ".zip", ".mrb", ".png", ".jpg", ".jpeg", ".mp4", ".bz2", ".xz", nullptr };
+    for (const char** extension = compressedExtensions; *extension; ++extension)
+      {
+      if (vtksys::SystemTools::StringEndsWith(name, *extension))
+        {
+        return true;
+        }
+      }
+    if (!vtksys::SystemTools::StringEndsWith(name, ".nrrd"))
+      {
+      return false;
+      }
+    // Attached nrrd header ends at the first empty line, look for the data encoding field
+    FILE* fd = fopen(fileName.c_str(), "rb");
+    if (!fd)
+      {
+      return false;
+      }
+    bool compressed = false;
+    char line[1024];
+    while (fgets(line, sizeof(line), fd) && line[0] != '\n' && line[0] != '\r')
+      {
+      std::string field = vtksys::SystemTools::LowerCase(line);
+      if (field.compare(0, 9, "encoding:") == 0)
+        {
+        compressed = (field.find("gz") != std::string::npos || field.find("bz2") != std::string::npos
+          || field.find("bzip2") != std::string::npos);
+        break;
+        }
+      }
+    fclose(fd);
+    return compressed;
+  }
 };
 
 // --------------------------------------------------------------------------
@@ -469,6 +507,17 @@ bool vtkArchive::Zip(const char* zipFileName, const char* directoryToZip)
     archive_entry_set_size(entry, fileLength);
     archive_entry_set_filetype(entry, AE_IFREG);
     archive_entry_set_perm(entry, 0644);
+    // store already compressed files as is, compressing them again would just
+    // take time without making the archive smaller
+    const char* entryCompression = compression_type.c_str();
+    if (compression_type != "store" && vtkArchiveTools::IsFileContentCompressed(fileName))
+      {
+      entryCompression = "store";
+      }
+    if (archive_write_set_format_option(zipArchive, "zip", "compression", entryCompression) != ARCHIVE_OK)
+      {
+      vtkArchiveTools::Error("Zip: set entry compression:", archive_error_string(zipArchive));
+      }
     if (archive_write_header(zipArchive, entry) != ARCHIVE_OK)
       {
       vtkArchiveTools::Error("Zip: write file header:", archive_error_string(zipArchive));
@@ -37,6 +37,7 @@ public:
 
   // creates a zip file with the full contents of the directory (recurses)
   // zip entries will include relative path of including tail of directoryToZip
+  // files that are already compressed (gzip encoded nrrd, png, ...) are stored without compression
   static bool Zip(const char* zipFileName, const char* directoryToZip);
 
   // unzips zip file into specified directory
@@ -5,15 +5,47 @@
 #include "vtkMRMLStorageNode.h"
 
 #include <vtksys/Directory.hxx>
+#include <vtksys/MD5.h>
 #include <vtksys/SystemTools.hxx>
 
 #include <vtkCallbackCommand.h>
 #include <vtkObjectFactory.h>
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
 vtkStandardNewMacro ( vtkCacheManager );
 
 #define MB 1000000.0
 
+namespace
+{
+//----------------------------------------------------------------------------
+std::string ComputeFileHash ( const std::string& fileName )
+{
+  FILE *file = fopen ( fileName.c_str(), "rb" );
+  if ( !file )
+    {
+    return std::string();
+    }
+  vtksysMD5 *md5 = vtksysMD5_New();
+  vtksysMD5_Initialize ( md5 );
+  std::vector<unsigned char> buffer ( 1 << 16 );
+  size_t length = 0;
+  while ( ( length = fread ( buffer.data(), 1, buffer.size(), file ) ) > 0 )
+    {
+    vtksysMD5_Append ( md5, buffer.data(), static_cast<int>(length) );
+    }
+  fclose ( file );
+  char hash[33];
+  vtksysMD5_FinalizeHex ( md5, hash );
+  hash[32] = 0;
+  vtksysMD5_Delete ( md5 );
+  return std::string ( hash );
+}
+}
+
 //----------------------------------------------------------------------------
 vtkCacheManager::vtkCacheManager()
 {
@@ -133,7 +165,9 @@ void vtkCacheManager::SetRemoteCacheDirectory (const char *dir )
     {
     vtksys::SystemTools::MakeDirectory(this->RemoteCacheDirectory.c_str());
     }
-  // scan files in cache, it calls Modified
+  // read the index of files in cache, the directory is only scanned
+  // if there is no index yet
+  this->LoadCacheIndex();
   this->UpdateCacheInformation();
 }
 
@@ -307,7 +341,7 @@ int vtkCacheManager::GetCachedFileList ( const char *dirname )
               return (0);
               }
             }
-          else
+          else if (strcmp(dir.GetFile(static_cast<unsigned long>(fileNum)), vtkCacheManager::GetCacheIndexFileName()))
             {
             this->CachedFileList.emplace_back(dir.GetFile(static_cast<unsigned long>(fileNum)));
             }
@@ -514,9 +548,16 @@ void vtkCacheManager::UpdateCacheInformation ( )
   //--- recompute free buffer size
   // this->RemoteCacheFreeBufferSize = ?;
 
-  //--- and refresh list of cached files.
+  //--- and refresh list of cached files from the cache index,
+  //--- traversing the cache directory is not necessary.
   this->CachedFileList.clear();
-  this->GetCachedFileList ( this->GetRemoteCacheDirectory() );
+    {
+    std::lock_guard<std::mutex> lock ( this->CacheIndexMutex );
+    for ( const auto& entry : this->CacheIndex )
+      {
+      this->CachedFileList.push_back ( vtksys::SystemTools::GetFilenameName ( entry.first ) );
+      }
+    }
   this->Modified();
 }
 
@@ -580,6 +621,7 @@ void vtkCacheManager::DeleteFromCache( const char *target )
         }
       else
         {
+        this->RemoveFromCacheIndex ( str.c_str() );
         this->UpdateCacheInformation ( );
         this->InvokeEvent ( vtkCacheManager::CacheDeleteEvent );
         }
@@ -592,6 +634,7 @@ void vtkCacheManager::DeleteFromCache( const char *target )
         }
       else
         {
+        this->RemoveFromCacheIndex ( str.c_str() );
         this->UpdateCacheInformation ( );
         this->InvokeEvent ( vtkCacheManager::CacheDeleteEvent );
         }
@@ -652,6 +695,10 @@ int vtkCacheManager::ClearCache()
     vtkWarningMacro ( "Cache cleared: Error: unable to recreate cache directory after deleting its contents." );
     return 0;
     }
+    {
+    std::lock_guard<std::mutex> lock ( this->CacheIndexMutex );
+    this->CacheIndex.clear();
+    }
   this->UpdateCacheInformation();
   this->InvokeEvent ( vtkCacheManager::CacheClearEvent );
   return 1;
@@ -662,12 +709,20 @@ int vtkCacheManager::ClearCache()
 //----------------------------------------------------------------------------
 float vtkCacheManager::GetCurrentCacheSize ()
 {
-  if ( this->RemoteCacheDirectory.c_str() == nullptr )
+  if ( this->RemoteCacheDirectory.empty() )
     {
     return (0.0);
     }
-  float size = this->ComputeCacheSize ( this->RemoteCacheDirectory.c_str(), 0 );
-  this->SetCurrentCacheSize ( size );
+  //--- sizes of the cached files are stored in the cache index
+  unsigned long long cacheSize = 0;
+    {
+    std::lock_guard<std::mutex> lock ( this->CacheIndexMutex );
+    for ( const auto& entry : this->CacheIndex )
+      {
+      cacheSize += entry.second.Size;
+      }
+    }
+  this->SetCurrentCacheSize ( static_cast<float>(cacheSize / MB) );
   return ( this->CurrentCacheSize );
 
 }
@@ -680,6 +735,10 @@ void vtkCacheManager::MarkNode ( std::string str )
   //--- If such a node exists, mark it as modified since read,
   //--- so that a user will be prompted to save the
   //--- data elsewhere (since it'll be deleted from cache.)
+  if ( this->MRMLScene == nullptr )
+    {
+    return;
+    }
   int nnodes = this->MRMLScene->GetNumberOfNodesByClass ( "vtkMRMLStorableNode" );
   vtkMRMLStorableNode *node;
   std::string uri;
@@ -835,7 +894,7 @@ void vtkCacheManager::CacheSizeCheck()
 {
 
   //--- Compute size of the current cache
-  this->ComputeCacheSize(this->RemoteCacheDirectory.c_str(), 0);
+  this->GetCurrentCacheSize();
   //--- Invoke an event if cache size is exceeded.
   if ( this->CurrentCacheSize > (float) (this->RemoteCacheLimit) )
     {
@@ -848,7 +907,7 @@ void vtkCacheManager::CacheSizeCheck()
 float vtkCacheManager::GetFreeCacheSpaceRemaining()
 {
 
-  float cachesize = this->ComputeCacheSize(this->RemoteCacheDirectory.c_str(), 0);
+  float cachesize = this->GetCurrentCacheSize();
   // cache limit - current cache size = total space left in cache.
   // total space in cache - free buffer size = amount that can be used.
   float diff = ( float (this->RemoteCacheLimit) - cachesize );
@@ -1001,3 +1060,307 @@ const char* vtkCacheManager::FindCachedFile ( const char * target, const char *d
     }
 
 }
+
+//----------------------------------------------------------------------------
+const char* vtkCacheManager::GetCacheIndexFileName()
+{
+  return "SlicerCacheIndex.txt";
+}
+
+//----------------------------------------------------------------------------
+std::string vtkCacheManager::GetRelativeCachePath ( const char *filename )
+{
+  if ( filename == nullptr || this->RemoteCacheDirectory.empty() )
+    {
+    return std::string();
+    }
+  std::string fullName = vtksys::SystemTools::CollapseFullPath ( filename, this->RemoteCacheDirectory );
+  std::string cacheDirectory = vtksys::SystemTools::CollapseFullPath ( this->RemoteCacheDirectory ) + "/";
+  if ( fullName.compare ( 0, cacheDirectory.size(), cacheDirectory ) != 0 )
+    {
+    return std::string();
+    }
+  return fullName.substr ( cacheDirectory.size() );
+}
+
+//----------------------------------------------------------------------------
+void vtkCacheManager::LoadCacheIndex()
+{
+  std::lock_guard<std::mutex> lock ( this->CacheIndexMutex );
+  this->CacheIndex.clear();
+  std::string indexFileName = this->RemoteCacheDirectory + "/" + vtkCacheManager::GetCacheIndexFileName();
+  std::ifstream indexFile ( indexFileName.c_str() );
+  if ( !indexFile.is_open() )
+    {
+    //--- no index yet (cache created by an earlier version), index the existing files once
+    vtkDebugMacro ( "LoadCacheIndex: no cache index found, scanning " << this->RemoteCacheDirectory );
+    this->ScanCacheIndex ( std::string() );
+    this->SaveCacheIndex();
+    return;
+    }
+  //--- each line contains: last access time, size, hash ('-' if not computed), relative path
+  std::string line;
+  while ( std::getline ( indexFile, line ) )
+    {
+    if ( line.empty() || line[0] == '#' )
+      {
+      continue;
+      }
+    std::istringstream lineStream ( line );
+    CachedFileInfo info;
+    std::string relativePath;
+    lineStream >> info.LastAccessTime >> info.Size >> info.Hash;
+    lineStream.ignore ( 1 );
+    std::getline ( lineStream, relativePath );
+    if ( lineStream.fail() || relativePath.empty() )
+      {
+      vtkWarningMacro ( "LoadCacheIndex: ignoring invalid line in " << indexFileName << ": " << line );
+      continue;
+      }
+    if ( info.Hash == "-" )
+      {
+      info.Hash.clear();
+      }
+    this->CacheIndex[relativePath] = info;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCacheManager::SaveCacheIndex()
+{
+  std::string indexFileName = this->RemoteCacheDirectory + "/" + vtkCacheManager::GetCacheIndexFileName();
+  if ( this->CacheIndex.empty() )
+    {
+    //--- an empty cache directory is expected after the cache is cleared
+    if ( vtksys::SystemTools::FileExists ( indexFileName ) )
+      {
+      vtksys::SystemTools::RemoveFile ( indexFileName );
+      }
+    return;
+    }
+  std::ofstream indexFile ( indexFileName.c_str() );
+  if ( !indexFile.is_open() )
+    {
+    vtkWarningMacro ( "SaveCacheIndex: unable to write cache index " << indexFileName );
+    return;
+    }
+  indexFile << "# last access time, size, hash, path relative to the cache directory\n";
+  indexFile.precision ( 15 );
+  for ( const auto& entry : this->CacheIndex )
+    {
+    indexFile << entry.second.LastAccessTime << " " << entry.second.Size << " "
+      << ( entry.second.Hash.empty() ? std::string ( "-" ) : entry.second.Hash ) << " " << entry.first << "\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCacheManager::ScanCacheIndex ( const std::string& relativeDirectory )
+{
+  std::string directoryName = this->RemoteCacheDirectory;
+  if ( !relativeDirectory.empty() )
+    {
+    directoryName += "/" + relativeDirectory;
+    }
+  vtksys::Directory dir;
+  if ( !dir.Load ( directoryName ) )
+    {
+    return;
+    }
+  double currentTime = vtksys::SystemTools::GetTime();
+  for ( unsigned long fileNum = 0; fileNum < dir.GetNumberOfFiles(); ++fileNum )
+    {
+    std::string fileName = dir.GetFile ( fileNum );
+    if ( fileName == "." || fileName == ".." || fileName == vtkCacheManager::GetCacheIndexFileName() )
+      {
+      continue;
+      }
+    std::string relativePath = relativeDirectory.empty() ? fileName : relativeDirectory + "/" + fileName;
+    std::string fullName = this->RemoteCacheDirectory + "/" + relativePath;
+    if ( vtksys::SystemTools::FileIsDirectory ( fullName ) )
+      {
+      this->ScanCacheIndex ( relativePath );
+      continue;
+      }
+    CachedFileInfo info;
+    info.Size = vtksys::SystemTools::FileIsSymlink ( fullName ) ? 0 : vtksys::SystemTools::FileLength ( fullName );
+    info.LastAccessTime = currentTime;
+    this->CacheIndex[relativePath] = info;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCacheManager::RemoveFromCacheIndex ( const char *target )
+{
+  std::string relativePath = this->GetRelativeCachePath ( target );
+  if ( relativePath.empty() )
+    {
+    return;
+    }
+  std::lock_guard<std::mutex> lock ( this->CacheIndexMutex );
+  std::string directoryPrefix = relativePath + "/";
+  for ( auto it = this->CacheIndex.begin(); it != this->CacheIndex.end(); )
+    {
+    if ( it->first == relativePath || it->first.compare ( 0, directoryPrefix.size(), directoryPrefix ) == 0 )
+      {
+      it = this->CacheIndex.erase ( it );
+      }
+    else
+      {
+      ++it;
+      }
+    }
+  this->SaveCacheIndex();
+}
+
+//----------------------------------------------------------------------------
+void vtkCacheManager::RegisterCachedFile ( const char *filename )
+{
+  std::string relativePath = this->GetRelativeCachePath ( filename );
+  if ( relativePath.empty() )
+    {
+    vtkDebugMacro ( "RegisterCachedFile: " << (filename ? filename : "(null)") << " is not in the cache directory" );
+    return;
+    }
+  std::string fullName = this->RemoteCacheDirectory + "/" + relativePath;
+  if ( !vtksys::SystemTools::FileExists ( fullName, true ) )
+    {
+    vtkDebugMacro ( "RegisterCachedFile: file " << fullName << " does not exist" );
+    return;
+    }
+  CachedFileInfo info;
+  info.Size = vtksys::SystemTools::FileLength ( fullName );
+  info.LastAccessTime = vtksys::SystemTools::GetTime();
+  info.Hash = ComputeFileHash ( fullName );
+
+  std::lock_guard<std::mutex> lock ( this->CacheIndexMutex );
+  //--- look for a cached file with identical content, only files of the same size
+  //--- need to be compared (hashes of files found by scanning are computed here on demand)
+  for ( auto& entry : this->CacheIndex )
+    {
+    if ( info.Size == 0 || info.Hash.empty()
+      || entry.first == relativePath || entry.second.Size != info.Size )
+      {
+      continue;
+      }
+    std::string existingFullName = this->RemoteCacheDirectory + "/" + entry.first;
+    if ( entry.second.Hash.empty() )
+      {
+      entry.second.Hash = ComputeFileHash ( existingFullName );
+      }
+    if ( entry.second.Hash != info.Hash )
+      {
+      continue;
+      }
+    //--- replace the new file by a link, keep the file if links are not supported
+    std::string temporaryName = fullName + ".tmp";
+    if ( !vtksys::SystemTools::RenameFile ( fullName, temporaryName ) )
+      {
+      break;
+      }
+    if ( vtksys::SystemTools::CreateLink ( existingFullName, fullName ) )
+      {
+      vtksys::SystemTools::RemoveFile ( temporaryName );
+      vtkDebugMacro ( "RegisterCachedFile: " << fullName << " has the same content as " << existingFullName << ", replaced by a link" );
+      info.Size = 0;
+      entry.second.LastAccessTime = info.LastAccessTime;
+      }
+    else
+      {
+      vtksys::SystemTools::RenameFile ( temporaryName, fullName );
+      }
+    break;
+    }
+  this->CacheIndex[relativePath] = info;
+  this->SaveCacheIndex();
+}
+
+//----------------------------------------------------------------------------
+void vtkCacheManager::TouchCachedFiles ( const std::vector< std::string >& filenames )
+{
+  double currentTime = vtksys::SystemTools::GetTime();
+  std::lock_guard<std::mutex> lock ( this->CacheIndexMutex );
+  for ( const std::string& filename : filenames )
+    {
+    auto it = this->CacheIndex.find ( this->GetRelativeCachePath ( filename.c_str() ) );
+    if ( it != this->CacheIndex.end() )
+      {
+      it->second.LastAccessTime = currentTime;
+      }
+    }
+  this->SaveCacheIndex();
+}
+
+//----------------------------------------------------------------------------
+int vtkCacheManager::EvictLeastRecentlyUsedFiles ( float sizeLimit )
+{
+  //--- files of identical content share their data on disk (linked),
+  //--- therefore they are evicted together
+  struct CachedContent
+    {
+    double LastAccessTime{0.0};
+    unsigned long long Size{0};
+    std::vector< std::string > RelativePaths;
+    };
+  std::vector< std::string > relativePathsToRemove;
+    {
+    std::lock_guard<std::mutex> lock ( this->CacheIndexMutex );
+    unsigned long long cacheSize = 0;
+    std::map< std::string, CachedContent > contents;
+    for ( const auto& entry : this->CacheIndex )
+      {
+      cacheSize += entry.second.Size;
+      CachedContent& content = contents[entry.second.Hash.empty() ? "path:" + entry.first : entry.second.Hash];
+      content.LastAccessTime = std::max ( content.LastAccessTime, entry.second.LastAccessTime );
+      content.Size += entry.second.Size;
+      content.RelativePaths.push_back ( entry.first );
+      }
+    if ( cacheSize <= sizeLimit * MB || contents.size() < 2 )
+      {
+      return 0;
+      }
+    std::vector< const CachedContent* > contentsByLastAccess;
+    double mostRecentAccessTime = 0.0;
+    for ( const auto& content : contents )
+      {
+      contentsByLastAccess.push_back ( &content.second );
+      mostRecentAccessTime = std::max ( mostRecentAccessTime, content.second.LastAccessTime );
+      }
+    std::sort ( contentsByLastAccess.begin(), contentsByLastAccess.end(),
+      [](const CachedContent* a, const CachedContent* b) { return a->LastAccessTime < b->LastAccessTime; } );
+    for ( const CachedContent* content : contentsByLastAccess )
+      {
+      if ( cacheSize <= sizeLimit * MB || content->LastAccessTime >= mostRecentAccessTime )
+        {
+        break;
+        }
+      cacheSize -= content->Size;
+      relativePathsToRemove.insert ( relativePathsToRemove.end(), content->RelativePaths.begin(), content->RelativePaths.end() );
+      }
+    }
+
+  for ( const std::string& relativePath : relativePathsToRemove )
+    {
+    std::string fullName = this->RemoteCacheDirectory + "/" + relativePath;
+    vtkDebugMacro ( "EvictLeastRecentlyUsedFiles: removing " << fullName );
+    this->MarkNode ( fullName );
+    if ( vtksys::SystemTools::FileExists ( fullName ) && !vtksys::SystemTools::RemoveFile ( fullName ) )
+      {
+      vtkWarningMacro ( "Unable to remove cached file " << fullName << " from disk." );
+      }
+    }
+  if ( relativePathsToRemove.empty() )
+    {
+    return 0;
+    }
+    {
+    std::lock_guard<std::mutex> lock ( this->CacheIndexMutex );
+    for ( const std::string& relativePath : relativePathsToRemove )
+      {
+      this->CacheIndex.erase ( relativePath );
+      }
+    this->SaveCacheIndex();
+    }
+  this->UpdateCacheInformation();
+  this->InvokeEvent ( vtkCacheManager::CacheDeleteEvent );
+  return static_cast<int>(relativePathsToRemove.size());
+}
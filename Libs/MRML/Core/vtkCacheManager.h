@@ -13,6 +13,7 @@ class vtkMRMLScene;
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
 
 #ifndef vtkObjectPointer
 #define vtkObjectPointer(xx) (reinterpret_cast <vtkObject **>( (xx) ))
@@ -116,6 +117,28 @@ class VTK_MRML_EXPORT vtkCacheManager : public vtkObject
 
   std::vector< std::string > GetCachedFiles()const;
 
+  ///
+  /// Records a file that has been downloaded into the cache in the cache index
+  /// (size, last access time, content hash) and saves the index in the cache directory,
+  /// so that the size of the cache is known without traversing the cache directory.
+  /// If a file with identical content is already in the cache then the new file
+  /// is replaced by a link to it (if the file system supports links).
+  /// This method may be called from the networking thread.
+  void RegisterCachedFile ( const char *filename );
+  ///
+  /// Sets the last access time of the cached files to the current time.
+  /// The files are evicted last by EvictLeastRecentlyUsedFiles.
+  void TouchCachedFiles ( const std::vector< std::string >& filenames );
+  ///
+  /// Removes the least recently used files from the cache until the size of the
+  /// cache is below sizeLimit (in MB). Nodes referring to removed files are
+  /// marked as modified. The most recently used files are never removed.
+  /// Returns the number of removed files.
+  int EvictLeastRecentlyUsedFiles ( float sizeLimit );
+  ///
+  /// Name of the cache index file that is stored in the cache directory
+  static const char* GetCacheIndexFileName();
+
   ///
   vtkGetMacro ( RemoteCacheLimit, int );
   vtkSetMacro ( RemoteCacheLimit, int );
@@ -172,6 +195,32 @@ class VTK_MRML_EXPORT vtkCacheManager : public vtkObject
   /// with every download, remove from cache, and clearcache call.
   std::vector< std::string > CachedFileList;
 
+  struct CachedFileInfo
+    {
+    /// Size on disk in bytes, 0 for links to files of identical content
+    unsigned long long Size{0};
+    /// Time of the last access, in seconds
+    double LastAccessTime{0.0};
+    /// MD5 hash of the content, empty if not computed yet
+    std::string Hash;
+    };
+  /// Cached files by path relative to the cache directory.
+  /// It is read from the cache index file when the cache directory is set.
+  std::map< std::string, CachedFileInfo > CacheIndex;
+  /// Protects CacheIndex, as files may be registered from the networking thread
+  std::mutex CacheIndexMutex;
+  /// Reads the cache index file, the cache directory is scanned if the file does not exist
+  void LoadCacheIndex();
+  /// Writes the cache index file, CacheIndexMutex must be locked by the caller
+  void SaveCacheIndex();
+  /// Adds the files of a directory to the cache index, without computing hashes
+  void ScanCacheIndex ( const std::string& relativeDirectory );
+  /// Removes a file or all files in a directory from the cache index
+  void RemoveFromCacheIndex ( const char *target );
+  /// Returns the path of a file relative to the cache directory,
+  /// empty if the file is not in the cache directory
+  std::string GetRelativeCachePath ( const char *filename );
+
  protected:
   vtkCacheManager();
   ~vtkCacheManager() override;
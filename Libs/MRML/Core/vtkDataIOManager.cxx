@@ -396,6 +396,22 @@ void vtkDataIOManager::QueueRead ( vtkMRMLNode *node )
     //--- a large scene that consists of multiple datasets.
     //--- ***The risk with this implementation  is that they may
     //--- forget to adjust the cache size, but aren't notified again...
+    //--- Make space for the download by removing the least recently used
+    //--- files from the cache. Files of this node are marked as used
+    //--- so that they are kept.
+    std::vector<std::string> nodeFiles;
+    nodeFiles.emplace_back(dest);
+    for (int uriNum = 0; uriNum < dnode->GetNthStorageNode(storageNodeIndex)->GetNumberOfURIs(); uriNum++)
+      {
+      const char *destN = cm->GetFilenameFromURI(dnode->GetNthStorageNode(storageNodeIndex)->GetNthURI(uriNum));
+      if (destN)
+        {
+        nodeFiles.emplace_back(destN);
+        }
+      }
+    cm->TouchCachedFiles(nodeFiles);
+    cm->EvictLeastRecentlyUsedFiles(cm->GetRemoteCacheLimit() - cm->GetRemoteCacheFreeBufferSize());
+
     float bufsize = (cm->GetRemoteCacheLimit() * 1000000.0) -  (cm->GetRemoteCacheFreeBufferSize() * 1000000.0);
     if ( (cm->GetCurrentCacheSize()*1000000.0) >= bufsize )
       {
@@ -71,6 +71,7 @@ class VTK_MRML_EXPORT vtkDataTransfer : public vtkObject
       case vtkDataTransfer::LocalLoad: return "LocalUpload";
       case vtkDataTransfer::LocalSave: return "LocalSave";
       case vtkDataTransfer::Unspecified: return "Unspecified";
+      case vtkDataTransfer::RemotePreviewDownload: return "RemotePreviewDownload";
       }
     return "Unknown";
   }
@@ -97,7 +98,9 @@ class VTK_MRML_EXPORT vtkDataTransfer : public vtkObject
       RemoteUpload,
       LocalLoad,
       LocalSave,
-      Unspecified
+      Unspecified,
+      /// download of the low resolution preview of a remote file
+      RemotePreviewDownload
     };
 
  private:
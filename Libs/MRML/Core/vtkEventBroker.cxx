@@ -14,16 +14,27 @@
 
 // MRML includes
 #include "vtkEventBroker.h"
+#include "vtkMRMLNode.h"
 #include "vtkObservation.h"
 
 // VTK includes
 #include <vtkCallbackCommand.h>
 #include <vtkCollection.h>
+#include <vtkDoubleArray.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
 #include <vtkObjectFactory.h>
+#include <vtkStringArray.h>
+#include <vtkTable.h>
 #include <vtkTimerLog.h>
 
+// STD includes
+#include <algorithm>
+#include <sstream>
+
 vtkCxxSetObjectMacro(vtkEventBroker, TimerLog, vtkTimerLog);
 vtkCxxSetObjectMacro(vtkEventBroker, RequestModifiedCallback, vtkCallbackCommand);
+vtkCxxSetObjectMacro(vtkEventBroker, FlushEventQueueCallback, vtkCallbackCommand);
 
 //----------------------------------------------------------------------------
 // The IO manager singleton.
@@ -100,6 +111,13 @@ vtkEventBroker::vtkEventBroker()
   this->ScriptHandler = nullptr;
   this->ScriptHandlerClientData = nullptr;
   this->RequestModifiedCallback = nullptr;
+  this->MaximumFlushRate = 60.0;
+  this->LastFlushTime = 0.0;
+  this->FlushRequested = false;
+  this->FlushEventQueueCallback = nullptr;
+  this->EventProfiling = false;
+  this->MaximumNumberOfProfilingTraceEvents = 100000;
+  this->ObservationCountWarningThreshold = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -124,6 +142,10 @@ vtkEventBroker::~vtkEventBroker()
     {
     this->RequestModifiedCallback->Delete();
     }
+  if (this->FlushEventQueueCallback)
+    {
+    this->FlushEventQueueCallback->Delete();
+    }
   //cout << "vtkEventBroker singleton Deleted" << endl;
 }
 
@@ -131,8 +153,8 @@ vtkEventBroker::~vtkEventBroker()
 void vtkEventBroker::DetachObservations()
 {
   // for each subject, remove observations in its list
-  ObjectToObservationVectorMap::iterator mapiter;
-  ObservationVector::iterator oiter;
+  ObjectToObservationListMap::iterator mapiter;
+  ObservationList::iterator oiter;
 
   for (mapiter = this->SubjectMap.begin(); mapiter != this->SubjectMap.end(); mapiter++)
     {
@@ -143,10 +165,13 @@ void vtkEventBroker::DetachObservations()
       // Ideally the observation should be removed from SubjectMap and
       // ObserverMap. This is what RemoveObservations() does, but it takes
       // time.
+      (*oiter)->SubjectListIndex = -1;
+      (*oiter)->ObserverListIndex = -1;
       (*oiter)->Delete();
       }
     }
   this->SubjectMap.clear();
+  this->ObserverMap.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -157,11 +182,10 @@ vtkObservation *vtkEventBroker::AddObservation (
 
   vtkObservation *observation = vtkObservation::New();
   observation->SetEventBroker( this );
-  this->SubjectMap[subject].insert( observation );
-  this->ObserverMap[observer].insert( observation );
   observation->AssignSubject( subject );
   observation->SetEvent( event );
   observation->AssignObserver( observer );
+  this->InsertObservation( observation, true );
   observation->SetCallbackCommand( notify );
   observation->SetPriority( priority );
 
@@ -188,8 +212,8 @@ vtkObservation *vtkEventBroker::AddObservation (
 {
   vtkObservation *observation = vtkObservation::New();
   observation->SetEventBroker( this );
-  this->SubjectMap[subject].insert( observation );
   observation->AssignSubject( subject );
+  this->InsertObservation( observation, false );
 
   // figure out event either as a predefined string, or
   // as an ascii number
@@ -217,6 +241,66 @@ vtkObservation *vtkEventBroker::AddObservation (
   return (observation);
 }
 
+//----------------------------------------------------------------------------
+void vtkEventBroker::InsertObservation ( vtkObservation *observation, bool addToObserverMap )
+{
+  ObservationList& subjectObservations = this->SubjectMap[observation->GetSubject()];
+  observation->SubjectListIndex = static_cast<int>(subjectObservations.size());
+  subjectObservations.push_back( observation );
+  if ( this->ObservationCountWarningThreshold > 0 )
+    {
+    this->CheckObservationCount( observation->GetSubject(), static_cast<int>(subjectObservations.size()) );
+    }
+
+  if ( addToObserverMap )
+    {
+    ObservationList& observerObservations = this->ObserverMap[observation->GetObserver()];
+    observation->ObserverListIndex = static_cast<int>(observerObservations.size());
+    observerObservations.push_back( observation );
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkEventBroker::EraseObservation ( vtkObservation *observation )
+{
+  // the last observation of the list is moved into the place of the erased one
+  if ( observation->SubjectListIndex >= 0 )
+    {
+    ObjectToObservationListMap::iterator it = this->SubjectMap.find( observation->GetSubject() );
+    if ( it != this->SubjectMap.end() )
+      {
+      ObservationList& subjectObservations = it->second;
+      vtkObservation* lastObservation = subjectObservations.back();
+      subjectObservations[observation->SubjectListIndex] = lastObservation;
+      lastObservation->SubjectListIndex = observation->SubjectListIndex;
+      subjectObservations.pop_back();
+      if ( subjectObservations.empty() )
+        {
+        this->SubjectMap.erase( it );
+        }
+      }
+    observation->SubjectListIndex = -1;
+    }
+
+  if ( observation->ObserverListIndex >= 0 )
+    {
+    ObjectToObservationListMap::iterator it = this->ObserverMap.find( observation->GetObserver() );
+    if ( it != this->ObserverMap.end() )
+      {
+      ObservationList& observerObservations = it->second;
+      vtkObservation* lastObservation = observerObservations.back();
+      observerObservations[observation->ObserverListIndex] = lastObservation;
+      lastObservation->ObserverListIndex = observation->ObserverListIndex;
+      observerObservations.pop_back();
+      if ( observerObservations.empty() )
+        {
+        this->ObserverMap.erase( it );
+        }
+      }
+    observation->ObserverListIndex = -1;
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkEventBroker::AttachObservation ( vtkObservation *observation )
 {
@@ -294,51 +378,84 @@ void vtkEventBroker::RemoveObservations (ObservationVector observations)
   // - detach from subject (and observer)
   // - delete the observation
 
+  ObservationList removeList;
+  removeList.reserve( observations.size() );
   ObservationVector::iterator inObsIter;
-
   for(inObsIter=observations.begin(); inObsIter != observations.end(); inObsIter++)
     {
     vtkObservation *inObs = (*inObsIter);
-    ObservationVector& subjectObservations = this->SubjectMap[(*inObsIter)->GetSubject()];
-    subjectObservations.erase(subjectObservations.find(inObs));
+    if ( inObs->SubjectListIndex < 0 && inObs->ObserverListIndex < 0 )
+      {
+      // already removed
+      continue;
+      }
+    this->EraseObservation( inObs );
+    removeList.push_back( inObs );
     }
 
-  for(inObsIter=observations.begin(); inObsIter != observations.end(); inObsIter++)
-    {
-    vtkObservation *inObs = (*inObsIter);
-    ObservationVector& observerObservations = this->ObserverMap[inObs->GetObserver()];
-    observerObservations.erase(observerObservations.find(inObs));
-    }
+  this->DeleteErasedObservations( removeList );
+}
 
+//----------------------------------------------------------------------------
+void vtkEventBroker::DeleteErasedObservations (const ObservationList& observations)
+{
   // remove from event queue
-  std::deque< vtkObservation *>::iterator queueIter;
-  for(queueIter=this->EventQueue.begin(); queueIter != this->EventQueue.end();)
+  bool inEventQueue = false;
+  ObservationList::const_iterator obsIter;
+  for(obsIter=observations.begin(); obsIter != observations.end() && !inEventQueue; obsIter++)
     {
-    // foreach of the broker's observations see if it is in the list of items to be removed
-    if (observations.find(*queueIter)!=observations.end())
-      {
-      // these event is related to the observations to be deleted
-      queueIter=this->EventQueue.erase(queueIter);
-      }
-    else
+    inEventQueue = ( (*obsIter)->GetInEventQueue() != 0 );
+    }
+  if ( inEventQueue )
+    {
+    ObservationVector removedObservations( observations.begin(), observations.end() );
+    std::deque< vtkObservation *>::iterator queueIter;
+    for(queueIter=this->EventQueue.begin(); queueIter != this->EventQueue.end();)
       {
-      ++queueIter;
+      // foreach of the broker's observations see if it is in the list of items to be removed
+      if (removedObservations.find(*queueIter)!=removedObservations.end())
+        {
+        // these event is related to the observations to be deleted
+        queueIter=this->EventQueue.erase(queueIter);
+        }
+      else
+        {
+        ++queueIter;
+        }
       }
     }
 
   // detach and delete each of the observations
-  for(ObservationVector::iterator removeIter=observations.begin(); removeIter != observations.end(); removeIter++)
+  for(obsIter=observations.begin(); obsIter != observations.end(); obsIter++)
     {
-    (*removeIter)->SetInEventQueue( 0 );
-    this->DetachObservation( *removeIter );
-    (*removeIter)->Delete();
+    (*obsIter)->SetInEventQueue( 0 );
+    this->DetachObservation( *obsIter );
+    (*obsIter)->Delete();
     }
 }
 
 //----------------------------------------------------------------------------
 void vtkEventBroker::RemoveObservations (vtkObject *observer)
 {
-  this->RemoveObservations( this->GetObservations( observer ) );
+  // Remove all observations of the observer at once: the observer's list is
+  // dropped as a whole, only the subject lists need to be updated.
+  ObjectToObservationListMap::iterator it = this->ObserverMap.find( observer );
+  if ( it == this->ObserverMap.end() )
+    {
+    return;
+    }
+  ObservationList observations;
+  observations.swap( it->second );
+  this->ObserverMap.erase( it );
+
+  ObservationList::iterator obsIter;
+  for(obsIter=observations.begin(); obsIter != observations.end(); obsIter++)
+    {
+    (*obsIter)->ObserverListIndex = -1;
+    this->EraseObservation( *obsIter );
+    }
+
+  this->DeleteErasedObservations( observations );
 }
 
 //----------------------------------------------------------------------------
@@ -370,7 +487,12 @@ vtkEventBroker::ObservationVector vtkEventBroker
 ::GetSubjectObservations (vtkObject *observer)
 {
   // find matching observations to remove
-  ObservationVector observationList = this->ObserverMap[observer];
+  ObservationVector observationList;
+  ObjectToObservationListMap::iterator it = this->ObserverMap.find( observer );
+  if ( it != this->ObserverMap.end() )
+    {
+    observationList.insert( it->second.begin(), it->second.end() );
+    }
 
   return( observationList );
 }
@@ -388,9 +510,14 @@ vtkEventBroker::ObservationVector vtkEventBroker::GetObservations (
     return observationList;
     }
   // find matching observations to remove
-  ObservationVector& subjectList = this->SubjectMap[subject];
+  ObjectToObservationListMap::iterator it = this->SubjectMap.find( subject );
+  if ( it == this->SubjectMap.end() )
+    {
+    return observationList;
+    }
+  ObservationList& subjectList = it->second;
 
-  for(ObservationVector::iterator obsIter = subjectList.begin();
+  for(ObservationList::iterator obsIter = subjectList.begin();
       obsIter != subjectList.end();
       ++obsIter)
     {
@@ -425,9 +552,14 @@ vtkEventBroker::ObservationVector vtkEventBroker::GetObservationsForSubjectByTag
 {
   // find matching observations to remove
   // - all tags match 0
-  ObservationVector& subjectList = this->SubjectMap[subject];
   ObservationVector observationList;
-  for (ObservationVector::iterator obsIter = subjectList.begin();
+  ObjectToObservationListMap::iterator it = this->SubjectMap.find( subject );
+  if ( it == this->SubjectMap.end() )
+    {
+    return ( observationList );
+    }
+  ObservationList& subjectList = it->second;
+  for (ObservationList::iterator obsIter = subjectList.begin();
        obsIter != subjectList.end(); obsIter++)
     {
     vtkObservation *obs = *obsIter;
@@ -444,8 +576,13 @@ vtkEventBroker::ObservationVector vtkEventBroker::GetObservationsForSubjectByTag
 vtkCollection *vtkEventBroker::GetObservationsForSubject ( vtkObject *subject )
 {
   vtkCollection *collection = vtkCollection::New();
-  ObservationVector& subjectList = this->SubjectMap[subject];
-  for(ObservationVector::iterator iter=subjectList.begin();
+  ObjectToObservationListMap::iterator it = this->SubjectMap.find( subject );
+  if ( it == this->SubjectMap.end() )
+    {
+    return collection;
+    }
+  ObservationList& subjectList = it->second;
+  for(ObservationList::iterator iter=subjectList.begin();
       iter != subjectList.end(); iter++)
     {
     if ( (*iter)->GetSubject() == subject )
@@ -460,8 +597,13 @@ vtkCollection *vtkEventBroker::GetObservationsForSubject ( vtkObject *subject )
 vtkCollection *vtkEventBroker::GetObservationsForObserver ( vtkObject *observer )
 {
   vtkCollection *collection = vtkCollection::New();
-  ObservationVector& observerList = this->ObserverMap[observer];
-  for (ObservationVector::iterator iter = observerList.begin();
+  ObjectToObservationListMap::iterator it = this->ObserverMap.find( observer );
+  if ( it == this->ObserverMap.end() )
+    {
+    return collection;
+    }
+  ObservationList& observerList = it->second;
+  for (ObservationList::iterator iter = observerList.begin();
        iter != observerList.end(); iter++)
     {
     if ( (*iter)->GetObserver() == observer )
@@ -476,10 +618,10 @@ vtkCollection *vtkEventBroker::GetObservationsForObserver ( vtkObject *observer
 vtkCollection *vtkEventBroker::GetObservationsForCallback ( vtkCallbackCommand *callback )
 {
   vtkCollection *collection = vtkCollection::New();
-  ObjectToObservationVectorMap::iterator it;
+  ObjectToObservationListMap::iterator it;
   for (it = this->ObserverMap.begin(); it != this->ObserverMap.end(); ++it)
     {
-    ObservationVector::iterator iter;
+    ObservationList::iterator iter;
     for(iter=it->second.begin(); iter != it->second.end(); iter++)
       {
       if ( *iter && (*iter)->GetCallbackCommand() == callback )
@@ -495,7 +637,7 @@ vtkCollection *vtkEventBroker::GetObservationsForCallback ( vtkCallbackCommand *
 int vtkEventBroker::GetNumberOfObservations ( )
 {
   size_t count = 0;
-  ObjectToObservationVectorMap::iterator iter;
+  ObjectToObservationListMap::iterator iter;
   for(iter=this->SubjectMap.begin(); iter != this->SubjectMap.end(); iter++)
     {
     count += iter->second.size();
@@ -512,14 +654,12 @@ vtkObservation *vtkEventBroker::GetNthObservation ( int n )
     }
 
   size_t count = 0;
-  ObjectToObservationVectorMap::iterator iter;
+  ObjectToObservationListMap::iterator iter;
   for(iter=this->SubjectMap.begin(); iter != this->SubjectMap.end(); iter++)
     {
     if ( static_cast<size_t>(n) < count + iter->second.size())
       {
-      ObservationVector::iterator it=iter->second.begin();
-      std::advance(it, n-count);
-      return (*it);
+      return iter->second[n-count];
       }
     else
       {
@@ -578,6 +718,150 @@ int vtkEventBroker::GenerateGraphFile ( const char *graphFile )
   return 0;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+std::string GetEventName(unsigned long eid)
+{
+  if (eid > vtkCommand::UserEvent)
+    {
+    // custom events have no name registered in vtkCommand
+    return "UserEvent+" + std::to_string(eid - vtkCommand::UserEvent);
+    }
+  return vtkCommand::GetStringFromEventId(eid);
+}
+}
+
+//----------------------------------------------------------------------------
+void vtkEventBroker::ProfileEvent (const ProfilingKey& key, double startTime, double elapsedTime)
+{
+  ProfilingStatistics& statistics = this->ProfilingStatisticsMap[key];
+  statistics.Count++;
+  statistics.TotalTime += elapsedTime;
+  statistics.MaximumTime = std::max(statistics.MaximumTime, elapsedTime);
+
+  if ( static_cast<int>(this->ProfilingTraceEvents.size()) < this->MaximumNumberOfProfilingTraceEvents )
+    {
+    ProfilingTraceEvent traceEvent;
+    traceEvent.Name = std::get<2>(key) + " <- " + std::get<0>(key) + "::" + GetEventName(std::get<1>(key));
+    traceEvent.StartTime = startTime;
+    traceEvent.Duration = elapsedTime;
+    traceEvent.NestingLevel = this->EventNestingLevel;
+    this->ProfilingTraceEvents.push_back(traceEvent);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkEventBroker::ResetProfiling ()
+{
+  this->ProfilingStatisticsMap.clear();
+  this->ProfilingTraceEvents.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkEventBroker::GetProfilingStatistics ( vtkTable* table )
+{
+  if ( !table )
+    {
+    vtkErrorMacro("GetProfilingStatistics: invalid table");
+    return;
+    }
+  table->Initialize();
+
+  typedef std::pair< ProfilingKey, ProfilingStatistics > StatisticsItem;
+  std::vector< StatisticsItem > sortedStatistics(
+    this->ProfilingStatisticsMap.begin(), this->ProfilingStatisticsMap.end());
+  std::sort(sortedStatistics.begin(), sortedStatistics.end(),
+    [](const StatisticsItem& a, const StatisticsItem& b) { return a.second.TotalTime > b.second.TotalTime; });
+
+  vtkNew<vtkStringArray> subjectClassColumn;
+  subjectClassColumn->SetName("SubjectClass");
+  vtkNew<vtkStringArray> eventColumn;
+  eventColumn->SetName("Event");
+  vtkNew<vtkIntArray> eventIdColumn;
+  eventIdColumn->SetName("EventId");
+  vtkNew<vtkStringArray> observerClassColumn;
+  observerClassColumn->SetName("ObserverClass");
+  vtkNew<vtkIntArray> countColumn;
+  countColumn->SetName("Count");
+  vtkNew<vtkDoubleArray> totalTimeColumn;
+  totalTimeColumn->SetName("TotalTime");
+  vtkNew<vtkDoubleArray> maximumTimeColumn;
+  maximumTimeColumn->SetName("MaximumTime");
+
+  for (const StatisticsItem& item : sortedStatistics)
+    {
+    subjectClassColumn->InsertNextValue(std::get<0>(item.first));
+    eventColumn->InsertNextValue(GetEventName(std::get<1>(item.first)));
+    eventIdColumn->InsertNextValue(static_cast<int>(std::get<1>(item.first)));
+    observerClassColumn->InsertNextValue(std::get<2>(item.first));
+    countColumn->InsertNextValue(item.second.Count);
+    totalTimeColumn->InsertNextValue(item.second.TotalTime);
+    maximumTimeColumn->InsertNextValue(item.second.MaximumTime);
+    }
+
+  table->AddColumn(subjectClassColumn);
+  table->AddColumn(eventColumn);
+  table->AddColumn(eventIdColumn);
+  table->AddColumn(observerClassColumn);
+  table->AddColumn(countColumn);
+  table->AddColumn(totalTimeColumn);
+  table->AddColumn(maximumTimeColumn);
+}
+
+//----------------------------------------------------------------------------
+bool vtkEventBroker::WriteProfilingTrace ( const char *fileName )
+{
+  if ( !fileName )
+    {
+    vtkErrorMacro("WriteProfilingTrace: invalid filename");
+    return false;
+    }
+  std::ofstream file;
+  file.open( fileName, std::ios::out );
+  if ( file.fail() )
+    {
+    vtkErrorMacro( "WriteProfilingTrace: could not write to " << fileName );
+    return false;
+    }
+
+  // Chrome trace event format: complete events ("X") with timestamp and duration in microseconds
+  // (events are recorded when they complete, therefore nested events are stored before their parent)
+  double startTime = this->ProfilingTraceEvents.empty() ? 0.0 : this->ProfilingTraceEvents.front().StartTime;
+  for (const ProfilingTraceEvent& traceEvent : this->ProfilingTraceEvents)
+    {
+    startTime = std::min(startTime, traceEvent.StartTime);
+    }
+  file << "{\"traceEvents\":[\n";
+  bool first = true;
+  for (const ProfilingTraceEvent& traceEvent : this->ProfilingTraceEvents)
+    {
+    // escape characters that are not allowed in JSON strings
+    std::string name;
+    for (char c : traceEvent.Name)
+      {
+      if (c == '"' || c == '\\')
+        {
+        name += '\\';
+        }
+      name += c;
+      }
+    if (!first)
+      {
+      file << ",\n";
+      }
+    first = false;
+    file << "{\"name\":\"" << name << "\",\"cat\":\"MRML\",\"ph\":\"X\""
+      << ",\"ts\":" << static_cast<long long>((traceEvent.StartTime - startTime) * 1e6)
+      << ",\"dur\":" << static_cast<long long>(traceEvent.Duration * 1e6)
+      << ",\"pid\":1,\"tid\":1"
+      << ",\"args\":{\"nestingLevel\":" << traceEvent.NestingLevel << "}}";
+    }
+  file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  file.close();
+  return !file.fail();
+}
+
 //----------------------------------------------------------------------------
 void vtkEventBroker::OpenLogFile ()
 {
@@ -692,7 +976,8 @@ void vtkEventBroker::ProcessEvent ( vtkObservation *observation, vtkObject *call
       {
       this->InvokeObservation( observation, eid, callData );
       }
-    else if ( this->EventMode == vtkEventBroker::Asynchronous )
+    else if ( this->EventMode == vtkEventBroker::Asynchronous
+      || this->EventMode == vtkEventBroker::Coalescing )
       {
       this->QueueObservation( observation, eid, callData );
       }
@@ -713,8 +998,14 @@ void vtkEventBroker::ProcessEvent ( vtkObservation *observation, vtkObject *call
   if ( eid == vtkCommand::DeleteEvent )
     {
     // iterate list of observations for the deleted object (caller) as subject
-    ObservationVector::iterator obsIter;
-    ObservationVector& subjectList = this->SubjectMap[caller];
+    // (copied, as invoked observers may add or remove observations)
+    ObservationList subjectList;
+    ObjectToObservationListMap::iterator subjectIt = this->SubjectMap.find( caller );
+    if ( subjectIt != this->SubjectMap.end() )
+      {
+      subjectList = subjectIt->second;
+      }
+    ObservationList::iterator obsIter;
     for(obsIter=subjectList.begin(); obsIter != subjectList.end(); ++obsIter)
       {
       if ( (*obsIter)->GetEvent() == vtkCommand::DeleteEvent )
@@ -755,10 +1046,27 @@ void vtkEventBroker::QueueObservation ( vtkObservation *observation,
   //    one unique entry for each
   // it it's not there, add the current call data to the list so that each unique combination
   // can be invoked.
+  // In coalescing mode, only the most recent call data is kept for each event ID.
   // If the event is not currently in the queue, add it and keep a flag.
   //
   vtkObservation::CallType call(eid, callData);
-  if ( this->GetCompressCallData() &&
+  if ( this->EventMode == vtkEventBroker::Coalescing )
+    {
+    std::deque< vtkObservation::CallType >::iterator dataIter;
+    for(dataIter=observation->GetCallDataList()->begin();dataIter != observation->GetCallDataList()->end(); dataIter++)
+      {
+      if ( call.EventID == dataIter->EventID )
+        {
+        dataIter->CallData = call.CallData;
+        break;
+        }
+      }
+    if ( dataIter == observation->GetCallDataList()->end() )
+      {
+      observation->GetCallDataList()->push_back( call );
+      }
+    }
+  else if ( this->GetCompressCallData() &&
        observation->GetEvent() != vtkCommand::AnyEvent)
     {
     observation->GetCallDataList()->clear();
@@ -786,6 +1094,28 @@ void vtkEventBroker::QueueObservation ( vtkObservation *observation,
     this->EventQueue.push_back( observation );
     observation->SetInEventQueue(1);
     }
+
+  if ( this->EventMode == vtkEventBroker::Coalescing )
+    {
+    this->RequestFlushEventQueue();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkEventBroker::RequestFlushEventQueue()
+{
+  if ( this->FlushRequested || !this->FlushEventQueueCallback )
+    {
+    return;
+    }
+  double delay = 0.0;
+  if ( this->MaximumFlushRate > 0.0 )
+    {
+    double elapsedTimeSinceLastFlush = this->TimerLog->GetUniversalTime() - this->LastFlushTime;
+    delay = std::max(0.0, 1.0 / this->MaximumFlushRate - elapsedTimeSinceLastFlush);
+    }
+  this->FlushRequested = true;
+  this->FlushEventQueueCallback->Execute(this, vtkCommand::ModifiedEvent, &delay);
 }
 
 //----------------------------------------------------------------------------
@@ -824,6 +1154,17 @@ void vtkEventBroker::InvokeObservation ( vtkObservation *observation,
   // Register so observation won't be deleted while callback is running
   observation->Register(this);
 
+  // Get names now, as the subject or observer may be deleted by the callback
+  ProfilingKey profilingKey;
+  if ( this->EventProfiling )
+    {
+    profilingKey = ProfilingKey(
+      observation->GetSubject() ? observation->GetSubject()->GetClassName() : "(none)",
+      eid,
+      observation->GetScript() ? "(script)"
+        : (observation->GetObserver() ? observation->GetObserver()->GetClassName() : "(none)"));
+    }
+
   // Invoke the observation
   // - run script if available, otherwise run callback command
   //  -- pass back the client data to the script handler (for
@@ -849,6 +1190,10 @@ void vtkEventBroker::InvokeObservation ( vtkObservation *observation,
   observation->SetTotalElapsedTime (observation->GetTotalElapsedTime() + elapsedTime);
   observation->SetLastElapsedTime (elapsedTime);
   this->LogEvent (observation);
+  if ( this->EventProfiling )
+    {
+    this->ProfileEvent (profilingKey, startTime, elapsedTime);
+    }
 
   // clear reference to observation (may cause delete)
   observation->Delete();
@@ -866,6 +1211,8 @@ void vtkEventBroker::ProcessEventQueue ()
   // - if the observation is no longer in the queue, stop processing events
   // - unregister before after dequeuing in case the observation should go away
   //
+  this->FlushRequested = false;
+  this->LastFlushTime = this->TimerLog->GetUniversalTime();
   while ( this->GetNumberOfQueuedObservations() > 0 )
     {
     vtkObservation *observation = this->EventQueue.front();
@@ -889,6 +1236,140 @@ void vtkEventBroker::ProcessEventQueue ()
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkEventBroker::GetNumberOfObservationsForSubject ( vtkObject *subject, unsigned long event )
+{
+  ObjectToObservationListMap::iterator it = this->SubjectMap.find( subject );
+  if ( it == this->SubjectMap.end() )
+    {
+    return 0;
+    }
+  if ( event == 0 )
+    {
+    return static_cast<int>(it->second.size());
+    }
+  int count = 0;
+  for (vtkObservation* observation : it->second)
+    {
+    if ( observation->GetEvent() == event )
+      {
+      ++count;
+      }
+    }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkEventBroker::GetMostObservedSubjects ( vtkTable* table, int maximumNumberOfSubjects )
+{
+  if ( !table )
+    {
+    vtkErrorMacro("GetMostObservedSubjects: invalid table");
+    return;
+    }
+  table->Initialize();
+
+  typedef std::pair< vtkObject*, const ObservationList* > SubjectItem;
+  std::vector< SubjectItem > sortedSubjects;
+  sortedSubjects.reserve( this->SubjectMap.size() );
+  for (const auto& subjectObservations : this->SubjectMap)
+    {
+    sortedSubjects.emplace_back( subjectObservations.first, &subjectObservations.second );
+    }
+  auto moreObserved = [](const SubjectItem& a, const SubjectItem& b) { return a.second->size() > b.second->size(); };
+  if ( maximumNumberOfSubjects > 0 && maximumNumberOfSubjects < static_cast<int>(sortedSubjects.size()) )
+    {
+    std::partial_sort(sortedSubjects.begin(), sortedSubjects.begin() + maximumNumberOfSubjects,
+      sortedSubjects.end(), moreObserved);
+    sortedSubjects.resize( maximumNumberOfSubjects );
+    }
+  else
+    {
+    std::sort(sortedSubjects.begin(), sortedSubjects.end(), moreObserved);
+    }
+
+  vtkNew<vtkStringArray> subjectClassColumn;
+  subjectClassColumn->SetName("SubjectClass");
+  vtkNew<vtkStringArray> subjectColumn;
+  subjectColumn->SetName("Subject");
+  vtkNew<vtkStringArray> eventColumn;
+  eventColumn->SetName("Event");
+  vtkNew<vtkIntArray> eventIdColumn;
+  eventIdColumn->SetName("EventId");
+  vtkNew<vtkIntArray> countColumn;
+  countColumn->SetName("Count");
+  vtkNew<vtkIntArray> numberOfObserversColumn;
+  numberOfObserversColumn->SetName("NumberOfObservers");
+  vtkNew<vtkIntArray> subjectCountColumn;
+  subjectCountColumn->SetName("SubjectCount");
+
+  for (const SubjectItem& item : sortedSubjects)
+    {
+    vtkObject* subject = item.first;
+    vtkMRMLNode* subjectNode = vtkMRMLNode::SafeDownCast( subject );
+    std::string subjectName;
+    if ( subjectNode && subjectNode->GetID() )
+      {
+      subjectName = subjectNode->GetID();
+      }
+    else
+      {
+      std::stringstream subjectAddress;
+      subjectAddress << subject;
+      subjectName = subjectAddress.str();
+      }
+
+    // observers of each event of the subject
+    std::map< unsigned long, std::set< vtkObject* > > eventObservers;
+    std::map< unsigned long, int > eventCounts;
+    for (vtkObservation* observation : *item.second)
+      {
+      eventObservers[observation->GetEvent()].insert( observation->GetObserver() );
+      eventCounts[observation->GetEvent()]++;
+      }
+    for (const auto& eventCount : eventCounts)
+      {
+      subjectClassColumn->InsertNextValue( subject->GetClassName() );
+      subjectColumn->InsertNextValue( subjectName );
+      eventColumn->InsertNextValue( GetEventName(eventCount.first) );
+      eventIdColumn->InsertNextValue( static_cast<int>(eventCount.first) );
+      countColumn->InsertNextValue( eventCount.second );
+      numberOfObserversColumn->InsertNextValue( static_cast<int>(eventObservers[eventCount.first].size()) );
+      subjectCountColumn->InsertNextValue( static_cast<int>(item.second->size()) );
+      }
+    }
+
+  table->AddColumn(subjectClassColumn);
+  table->AddColumn(subjectColumn);
+  table->AddColumn(eventColumn);
+  table->AddColumn(eventIdColumn);
+  table->AddColumn(countColumn);
+  table->AddColumn(numberOfObserversColumn);
+  table->AddColumn(subjectCountColumn);
+}
+
+//----------------------------------------------------------------------------
+void vtkEventBroker::CheckObservationCount ( vtkObject *subject, int numberOfObservations )
+{
+  // Report at threshold, 2x threshold, 4x threshold, ...
+  if ( numberOfObservations < this->ObservationCountWarningThreshold
+    || numberOfObservations % this->ObservationCountWarningThreshold != 0 )
+    {
+    return;
+    }
+  int multiple = numberOfObservations / this->ObservationCountWarningThreshold;
+  if ( (multiple & (multiple - 1)) != 0 )
+    {
+    return;
+    }
+  vtkMRMLNode* subjectNode = vtkMRMLNode::SafeDownCast( subject );
+  vtkWarningMacro( "Subject " << subject->GetClassName() << " "
+    << ( subjectNode && subjectNode->GetID() ? subjectNode->GetID() : "" ) << " (" << subject << ") has "
+    << numberOfObservations << " observations. Each event of this object is processed by all observers,"
+    << " which may slow down the application. Use GetMostObservedSubjects for details." );
+  this->InvokeEvent( vtkEventBroker::ObservationCountWarningEvent, subject );
+}
+
 //----------------------------------------------------------------------------
 void vtkEventBroker::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -897,7 +1378,11 @@ void vtkEventBroker::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NumberOfObservations: " << this->GetNumberOfObservations() << "\n";
   os << indent << "NumberOfQueueObservations: " << this->GetNumberOfQueuedObservations() << "\n";
   os << indent << "EventMode: " << this->GetEventModeAsString() << "\n";
+  os << indent << "MaximumFlushRate: " << this->MaximumFlushRate << "\n";
   os << indent << "EventLogging: " << this->EventLogging << "\n";
+  os << indent << "EventProfiling: " << (this->EventProfiling ? "true" : "false") << "\n";
+  os << indent << "MaximumNumberOfProfilingTraceEvents: " << this->MaximumNumberOfProfilingTraceEvents << "\n";
+  os << indent << "ObservationCountWarningThreshold: " << this->ObservationCountWarningThreshold << "\n";
   os << indent << "EventNestingLevel: " << this->EventNestingLevel << "\n";
   os << indent << "LogFileName: " <<
     (this->LogFileName ? this->LogFileName : "(none)") << "\n";
@@ -19,6 +19,7 @@
 #include "vtkMRML.h"
 
 // VTK includes
+#include <vtkCommand.h>
 #include <vtkObject.h>
 class vtkTimerLog;
 
@@ -27,11 +28,15 @@ class vtkTimerLog;
 #include <vector>
 #include <set>
 #include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
 #include <fstream>
 
 class vtkCollection;
 class vtkCallbackCommand;
 class vtkObservation;
+class vtkTable;
 
 /// \brief Class that manages adding and deleting of observers with events.
 ///
@@ -173,15 +178,84 @@ public:
   /// Write out the current list of observations in graphviz format (.dot)
   int GenerateGraphFile ( const char *graphFile );
 
+  /// Event Profiling
+  ///
+  /// When enabled, each observation invocation is recorded: invocation count,
+  /// cumulative and maximum callback time are accumulated for each
+  /// (subject class, event, observer class) combination.
+  /// Turning profiling on or off does not clear previously recorded data.
+  vtkBooleanMacro (EventProfiling, bool);
+  vtkSetMacro (EventProfiling, bool);
+  vtkGetMacro (EventProfiling, bool);
+
+  ///
+  /// Maximum number of individual invocations kept for the trace
+  /// (oldest ones are kept, invocation statistics are still updated).
+  /// Set to 0 to only compute statistics. Default is 100000.
+  vtkSetMacro (MaximumNumberOfProfilingTraceEvents, int);
+  vtkGetMacro (MaximumNumberOfProfilingTraceEvents, int);
+
+  ///
+  /// Clear all recorded profiling data.
+  void ResetProfiling ();
+
+  ///
+  /// Fill the table with the profiling statistics, one row for each
+  /// (subject class, event, observer class) combination, sorted by decreasing
+  /// cumulative time. Columns: SubjectClass, Event, EventId, ObserverClass,
+  /// Count, TotalTime, MaximumTime (times are in seconds).
+  void GetProfilingStatistics ( vtkTable* table );
+
+  ///
+  /// Write the recorded invocations in Chrome trace event format (JSON),
+  /// which can be loaded in chrome://tracing or https://ui.perfetto.dev.
+  /// Returns false if the file cannot be written.
+  bool WriteProfilingTrace ( const char *fileName );
+
+  /// Observation Diagnostics
+  ///
+  /// Return the number of observations of the subject.
+  /// If event is != 0, only observations of that event are counted.
+  int GetNumberOfObservationsForSubject ( vtkObject *subject, unsigned long event = 0 );
+
+  ///
+  /// Fill the table with the observation counts of the most observed subjects,
+  /// to find objects with excessive observer fan-out (each observation is executed on every
+  /// event of the subject). There is one row for each observed event of the
+  /// maximumNumberOfSubjects subjects that have the most observations (0 means all subjects),
+  /// sorted by decreasing number of observations of the subject.
+  /// Columns: SubjectClass, Subject (node ID for MRML nodes, address otherwise), Event, EventId,
+  /// Count, NumberOfObservers (distinct observers of the event), SubjectCount (all observations
+  /// of the subject).
+  void GetMostObservedSubjects ( vtkTable* table, int maximumNumberOfSubjects = 20 );
+
+  ///
+  /// When the number of observations of a single subject reaches this threshold,
+  /// a warning is logged and ObservationCountWarningEvent is invoked with the subject
+  /// as call data. The warning is repeated each time the count doubles.
+  /// 0 means disabled. Default is 0.
+  vtkSetClampMacro (ObservationCountWarningThreshold, int, 0, VTK_INT_MAX);
+  vtkGetMacro (ObservationCountWarningThreshold, int);
+
+  enum
+    {
+    ObservationCountWarningEvent = vtkCommand::UserEvent + 1
+    };
+
 
   /// Event Queue processing modes
   ///
   /// In synchronous mode, observations are invoked immediately when the
   /// event takes place.  In asynchronous mode, observations are added
   /// to the event queue for later invocation.
+  /// Coalescing mode is an asynchronous mode where repeated events of an observation
+  /// (same subject, event, and observer) are collapsed into a single pending invocation
+  /// that uses the most recent call data, and processing of the queue is requested
+  /// using the FlushEventQueueCallback (at most MaximumFlushRate times per second).
   enum EventMode {
     Synchronous,
-    Asynchronous
+    Asynchronous,
+    Coalescing
   };
   vtkGetMacro(EventMode, int);
   void SetEventMode(int eventMode)
@@ -196,12 +270,28 @@ public:
 
   void SetEventModeToSynchronous() {this->SetEventMode(vtkEventBroker::Synchronous);};
   void SetEventModeToAsynchronous() {this->SetEventMode(vtkEventBroker::Asynchronous);};
+  void SetEventModeToCoalescing() {this->SetEventMode(vtkEventBroker::Coalescing);};
   const char * GetEventModeAsString() {
     if (this->EventMode == vtkEventBroker::Synchronous) return ("Synchronous");
     if (this->EventMode == vtkEventBroker::Asynchronous) return ("Asynchronous");
+    if (this->EventMode == vtkEventBroker::Coalescing) return ("Coalescing");
     return "Undefined";
   }
 
+  /// Maximum number of times per second the event queue is flushed in coalescing mode.
+  /// Events that arrive faster than this are collapsed into a single invocation.
+  /// 0 means that flush is requested as soon as an event is queued.
+  /// Default is 60.
+  vtkSetClampMacro(MaximumFlushRate, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(MaximumFlushRate, double);
+
+  /// Set callback command that is executed in coalescing mode when an event is queued
+  /// and the event queue has no pending flush request yet.
+  /// Call data is a pointer to a double containing the delay (in seconds) after which
+  /// the application should call ProcessEventQueue() (typically from its event loop).
+  virtual void SetFlushEventQueueCallback(vtkCallbackCommand* callback);
+  vtkGetObjectMacro(FlushEventQueueCallback, vtkCallbackCommand);
+
 
   /// Event queue processing
 
@@ -272,16 +362,33 @@ protected:
   void AttachObservation (vtkObservation *observation);
   void DetachObservation (vtkObservation *observation);
 
+  ///
+  /// Execute FlushEventQueueCallback if no flush request is pending.
+  void RequestFlushEventQueue();
+
   friend class vtkEventBrokerInitialize;
   typedef vtkEventBroker Self;
 
 
-  ///
-  typedef std::map< vtkObject*, ObservationVector > ObjectToObservationVectorMap;
+  /// Observations of an object are stored in a contiguous list. Each observation
+  /// stores its position in the subject and observer lists, which allows
+  /// constant-time insertion and removal.
+  typedef std::vector< vtkObservation * > ObservationList;
+  typedef std::unordered_map< vtkObject*, ObservationList > ObjectToObservationListMap;
 
   /// maps to manage quick lookup by object
-  ObjectToObservationVectorMap SubjectMap;
-  ObjectToObservationVectorMap ObserverMap;
+  ObjectToObservationListMap SubjectMap;
+  ObjectToObservationListMap ObserverMap;
+
+  ///
+  /// Add/remove observation to/from SubjectMap and ObserverMap.
+  void InsertObservation (vtkObservation *observation, bool addToObserverMap);
+  void EraseObservation (vtkObservation *observation);
+
+  ///
+  /// Remove observations from the event queue, detach and delete them.
+  /// The observations must have been already erased from SubjectMap and ObserverMap.
+  void DeleteErasedObservations (const ObservationList& observations);
 
   /// The event queue of triggered but not-yet-invoked observations
   std::deque< vtkObservation * > EventQueue;
@@ -291,12 +398,46 @@ protected:
 
   int EventLogging;
   int EventNestingLevel;
+
+  struct ProfilingStatistics
+  {
+    int Count{0};
+    double TotalTime{0.0};
+    double MaximumTime{0.0};
+  };
+  struct ProfilingTraceEvent
+  {
+    std::string Name;
+    double StartTime;
+    double Duration;
+    int NestingLevel;
+  };
+  /// (subject class, event, observer class)
+  typedef std::tuple< std::string, unsigned long, std::string > ProfilingKey;
+  bool EventProfiling;
+  int MaximumNumberOfProfilingTraceEvents;
+  std::map< ProfilingKey, ProfilingStatistics > ProfilingStatisticsMap;
+  std::vector< ProfilingTraceEvent > ProfilingTraceEvents;
+
+  /// Record an invocation (when EventProfiling is enabled)
+  void ProfileEvent (const ProfilingKey& key, double startTime, double elapsedTime);
+
+  int ObservationCountWarningThreshold;
+  /// Report if the number of observations of the subject crossed the warning threshold
+  void CheckObservationCount (vtkObject *subject, int numberOfObservations);
   char *LogFileName;
   vtkTimerLog *TimerLog;
 
   int EventMode;
   int CompressCallData;
 
+  double MaximumFlushRate;
+  /// Universal time of the last ProcessEventQueue call
+  double LastFlushTime;
+  /// Set when FlushEventQueueCallback has been invoked and the queue has not been processed since
+  bool FlushRequested;
+  vtkCallbackCommand* FlushEventQueueCallback;
+
   std::ofstream LogFile;
 
   vtkCallbackCommand* RequestModifiedCallback;
@@ -0,0 +1,144 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkImageLabelMapToColors.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkLookupTable.h>
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <cmath>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkImageLabelMapToColors);
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+template <class T>
+void MapLabelsThroughTable(vtkImageData* inData, vtkImageData* outData, int outExt[6],
+  const unsigned char* table, vtkIdType numberOfColors, vtkIdType firstLabel)
+{
+  vtkIdType inInc0, inInc1, inInc2;
+  inData->GetContinuousIncrements(outExt, inInc0, inInc1, inInc2);
+  vtkIdType outInc0, outInc1, outInc2;
+  outData->GetContinuousIncrements(outExt, outInc0, outInc1, outInc2);
+  const T* inPtr = static_cast<const T*>(inData->GetScalarPointerForExtent(outExt));
+  unsigned char* outPtr = static_cast<unsigned char*>(outData->GetScalarPointerForExtent(outExt));
+  const vtkIdType lastIndex = numberOfColors - 1;
+  const int rowLength = outExt[1] - outExt[0] + 1;
+  for (int idx2 = outExt[4]; idx2 <= outExt[5]; ++idx2)
+    {
+    for (int idx1 = outExt[2]; idx1 <= outExt[3]; ++idx1)
+      {
+      for (int idx0 = 0; idx0 < rowLength; ++idx0)
+        {
+        // out of range values are clamped, as vtkLookupTable does
+        vtkIdType index = static_cast<vtkIdType>(*inPtr) - firstLabel;
+        index = index < 0 ? 0 : (index > lastIndex ? lastIndex : index);
+        std::memcpy(outPtr, table + 4 * index, 4);
+        ++inPtr;
+        outPtr += 4;
+        }
+      inPtr += inInc1;
+      outPtr += outInc1;
+      }
+    inPtr += inInc2;
+    outPtr += outInc2;
+    }
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkImageLabelMapToColors::vtkImageLabelMapToColors() = default;
+
+//----------------------------------------------------------------------------
+vtkImageLabelMapToColors::~vtkImageLabelMapToColors() = default;
+
+//----------------------------------------------------------------------------
+void vtkImageLabelMapToColors::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "DirectIndexing: " << (this->DirectIndexing ? "true" : "false") << "\n";
+}
+
+//----------------------------------------------------------------------------
+bool vtkImageLabelMapToColors::CanUseDirectIndexing(vtkImageData* input)
+{
+  if (!this->DirectIndexing || !input
+    || this->OutputFormat != VTK_RGBA
+    || input->GetNumberOfScalarComponents() != 1)
+    {
+    return false;
+    }
+  switch (input->GetScalarType())
+    {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+    case VTK_INT:
+    case VTK_UNSIGNED_INT:
+      break;
+    default:
+      return false;
+    }
+  vtkLookupTable* lut = vtkLookupTable::SafeDownCast(this->LookupTable);
+  if (!lut || lut->GetIndexedLookup()
+    || lut->GetScale() != VTK_SCALE_LINEAR
+    || lut->GetUseBelowRangeColor() || lut->GetUseAboveRangeColor()
+    || lut->GetAlpha() != 1.0
+    || lut->GetNumberOfTableValues() < 1)
+    {
+    return false;
+    }
+  // each label value must map to exactly one table entry
+  const double* range = lut->GetTableRange();
+  return range[0] == std::floor(range[0])
+    && range[1] - range[0] + 1 == lut->GetNumberOfTableValues();
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelMapToColors::ThreadedRequestData(vtkInformation *request,
+                                                   vtkInformationVector **inputVector,
+                                                   vtkInformationVector *outputVector,
+                                                   vtkImageData ***inData,
+                                                   vtkImageData **outData,
+                                                   int outExt[6], int id)
+{
+  if (!this->CanUseDirectIndexing(inData[0][0]))
+    {
+    this->Superclass::ThreadedRequestData(request, inputVector, outputVector, inData, outData, outExt, id);
+    return;
+    }
+  vtkLookupTable* lut = vtkLookupTable::SafeDownCast(this->LookupTable);
+  const unsigned char* table = lut->GetPointer(0);
+  vtkIdType numberOfColors = lut->GetNumberOfTableValues();
+  vtkIdType firstLabel = static_cast<vtkIdType>(lut->GetTableRange()[0]);
+  switch (inData[0][0]->GetScalarType())
+    {
+    vtkTemplateMacro(MapLabelsThroughTable<VTK_TT>(inData[0][0], outData[0], outExt,
+      table, numberOfColors, firstLabel));
+    default:
+      break;
+    }
+}
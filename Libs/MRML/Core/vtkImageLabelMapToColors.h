@@ -0,0 +1,67 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkImageLabelMapToColors_h
+#define __vtkImageLabelMapToColors_h
+
+// MRML includes
+#include "vtkMRML.h"
+
+// VTK includes
+#include <vtkImageMapToColors.h>
+
+/// \brief Map a label map image through a lookup table.
+///
+/// Same as vtkImageMapToColors, but when the input is a single-component integer
+/// image, the output format is RGBA and the lookup table is a vtkLookupTable that
+/// maps each label value to one table entry (linear scale, table range size equal
+/// to the number of colors, as set up by vtkMRMLLabelMapVolumeDisplayNode),
+/// label values are used directly as indices into the RGBA table instead of going
+/// through the general range mapping of the lookup table.
+/// All other cases are processed by vtkImageMapToColors.
+class VTK_MRML_EXPORT vtkImageLabelMapToColors : public vtkImageMapToColors
+{
+public:
+  static vtkImageLabelMapToColors *New();
+  vtkTypeMacro(vtkImageLabelMapToColors, vtkImageMapToColors);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Enable/disable direct indexing of the lookup table for integer labels.
+  /// Enabled by default.
+  vtkSetMacro(DirectIndexing, bool);
+  vtkGetMacro(DirectIndexing, bool);
+  vtkBooleanMacro(DirectIndexing, bool);
+
+  /// Returns true if the current input and lookup table can be mapped by direct indexing.
+  bool CanUseDirectIndexing(vtkImageData* input);
+
+protected:
+  vtkImageLabelMapToColors();
+  ~vtkImageLabelMapToColors() override;
+
+  void ThreadedRequestData(vtkInformation *request,
+                           vtkInformationVector **inputVector,
+                           vtkInformationVector *outputVector,
+                           vtkImageData ***inData, vtkImageData **outData,
+                           int outExt[6], int id) override;
+
+  bool DirectIndexing{true};
+
+private:
+  vtkImageLabelMapToColors(const vtkImageLabelMapToColors&) = delete;
+  void operator=(const vtkImageLabelMapToColors&) = delete;
+};
+
+#endif
@@ -42,6 +42,7 @@ vtkMRMLColorNode::vtkMRMLColorNode()
   this->SetNoName("(none)");
 
   this->NamesInitialised = 0;
+  this->NameToIndexValid = false;
 }
 
 //----------------------------------------------------------------------------
@@ -149,6 +150,7 @@ void vtkMRMLColorNode::Copy(vtkMRMLNode *anode)
 
   // copy names
   this->Names = node->Names;
+  this->NamesModified();
 
   this->NamesInitialised = node->NamesInitialised;
 
@@ -273,6 +275,7 @@ void vtkMRMLColorNode::SetNamesFromColors()
   const int numPoints = this->GetNumberOfColors();
   // reset the names
   this->Names.resize(numPoints);
+  this->NamesModified();
 
   for (int i = 0; i < numPoints; ++i)
     {
@@ -379,15 +382,49 @@ int vtkMRMLColorNode::GetColorIndexByName(const char *name)
     this->SetNamesFromColors();
     }
 
+  if (!this->NameToIndexValid)
+    {
+    this->NameToIndex.clear();
+    this->NameToIndex.reserve(this->Names.size());
+    for (int i = 0; i < static_cast<int>(this->Names.size()); ++i)
+      {
+      // emplace keeps the first (lowest) index of duplicate names
+      this->NameToIndex.emplace(this->Names[i], i);
+      }
+    this->NameToIndexValid = true;
+    }
+
   std::string strName = name;
-  for (int i = 0; i < this->GetNumberOfColors(); ++i)
+  int index = -1;
+  if (!strName.empty())
     {
-    if (strName == this->GetColorName(i))
+    auto it = this->NameToIndex.find(strName);
+    if (it != this->NameToIndex.end())
       {
-      return i;
+      index = it->second;
       }
     }
-  return -1;
+  if (this->NoName && strName == this->NoName)
+    {
+    // empty names are reported as NoName by GetColorName
+    auto it = this->NameToIndex.find(std::string());
+    if (it != this->NameToIndex.end() && (index < 0 || it->second < index))
+      {
+      index = it->second;
+      }
+    }
+  if (index >= this->GetNumberOfColors())
+    {
+    return -1;
+    }
+  return index;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLColorNode::NamesModified()
+{
+  this->NameToIndexValid = false;
+  this->NameToIndex.clear();
 }
 
 //---------------------------------------------------------------------------
@@ -441,6 +478,24 @@ int vtkMRMLColorNode::SetColorName(int ind, const char *name)
   std::string newName(name);
   if (this->Names[ind] != newName)
     {
+    if (this->NameToIndexValid)
+      {
+      auto oldIt = this->NameToIndex.find(this->Names[ind]);
+      if (oldIt != this->NameToIndex.end() && oldIt->second == ind)
+        {
+        // the old name may be used by other colors, too
+        // (it is typically NoName), rebuild the map at next lookup
+        this->NamesModified();
+        }
+      else
+        {
+        auto newIt = this->NameToIndex.find(newName);
+        if (newIt == this->NameToIndex.end() || newIt->second > ind)
+          {
+          this->NameToIndex[newName] = ind;
+          }
+        }
+      }
     this->Names[ind] = newName;
     this->StorableModifiedTime.Modified();
     this->Modified();
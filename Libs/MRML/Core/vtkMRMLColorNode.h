@@ -24,6 +24,7 @@ class vtkScalarsToColors;
 
 // Std includes
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /// \brief Abstract MRML node to represent color information.
@@ -115,7 +116,9 @@ public:
   const char *GetColorName(int ind);
 
   /// Return the index associated with this color name, which can then be used
-  /// to get the color. Returns -1 on failure.
+  /// to get the color. If several colors have the same name then the lowest index
+  /// is returned. Returns -1 on failure.
+  /// Lookup uses a hash map of names, therefore it is fast even for large tables.
   /// \sa GetColorName()
   int GetColorIndexByName(const char *name);
 
@@ -240,6 +243,15 @@ protected:
   ///
   /// Have the color names been set? Used to do lazy copy of the Names array.
   int NamesInitialised;
+
+  /// Must be called when Names is modified directly, not by SetColorName().
+  void NamesModified();
+
+  /// Lowest index of each name in Names, used by GetColorIndexByName().
+  /// SetColorName() keeps it up-to-date, other changes of Names invalidate it
+  /// and it is rebuilt at the next lookup.
+  std::unordered_map<std::string, int> NameToIndex;
+  bool NameToIndexValid;
 };
 
 #endif
@@ -19,9 +19,11 @@ Version:   $Revision: 1.0 $
 
 // VTK includes
 #include <vtkCommand.h>
+#include <vtkDoubleArray.h>
 #include <vtkLookupTable.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
+#include <vtkStringArray.h>
 
 // STD includes
 #include <random>
@@ -1092,6 +1094,7 @@ void vtkMRMLColorTableNode::SetType(int type)
       this->GetLookupTable()->SetTableRange(0,255);
       this->Names.clear();
       this->Names.resize(this->GetLookupTable()->GetNumberOfTableValues());
+      this->NamesModified();
 
       if (this->SetColorName(0, "Black") != 0)
         {
@@ -1273,6 +1276,7 @@ void vtkMRMLColorTableNode::SetNumberOfColors(int n)
     // elements is set). We initialize the color names to have one for each lookup table item.
     std::string noNameStr = this->GetNoName() ? this->GetNoName() : "";
     this->Names.resize(n, noNameStr);
+    this->NamesModified();
     }
 }
 
@@ -1411,6 +1415,75 @@ int vtkMRMLColorTableNode::SetColors(int firstEntry, int lastEntry, const char *
     }
   lut->BuildSpecialColors();
   lut->Modified();
+  this->NamesModified();
+
+  this->Modified();
+  return 1;
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLColorTableNode::SetColors(int firstEntry, vtkStringArray* names, vtkDoubleArray* colors)
+{
+  if (this->GetType() != this->User &&
+      this->GetType() != this->File)
+    {
+    vtkErrorMacro("vtkMRMLColorTableNode::SetColors: Cannot set a color if not a user defined color table, reset the type first to User or File");
+    return 0;
+    }
+  if (!colors || (colors->GetNumberOfComponents() != 3 && colors->GetNumberOfComponents() != 4))
+    {
+    vtkErrorMacro("vtkMRMLColorTableNode::SetColors: colors must be an array with 3 or 4 components");
+    return 0;
+    }
+  vtkIdType numberOfEntries = colors->GetNumberOfTuples();
+  if (names && names->GetNumberOfValues() != numberOfEntries)
+    {
+    vtkErrorMacro("vtkMRMLColorTableNode::SetColors: number of names (" << names->GetNumberOfValues()
+      << ") does not match the number of colors (" << numberOfEntries << ")");
+    return 0;
+    }
+  if (numberOfEntries == 0)
+    {
+    // empty range, nothing to do
+    return 1;
+    }
+  vtkLookupTable* lut = this->GetLookupTable();
+  vtkIdType numberOfValues = lut->GetNumberOfTableValues();
+  if (firstEntry < 0 || firstEntry + numberOfEntries > numberOfValues)
+    {
+    vtkErrorMacro("vtkMRMLColorTableNode::SetColors: requested entries " << firstEntry << " - "
+      << firstEntry + numberOfEntries - 1 << " are out of table range: 0 - " << numberOfValues << ", call SetNumberOfColors");
+    return 0;
+    }
+  if (vtkIdType(this->Names.size()) < numberOfValues)
+    {
+    std::string noNameStr = this->GetNoName() ? this->GetNoName() : "";
+    this->Names.resize(numberOfValues, noNameStr);
+    }
+
+  MRMLNodeModifyBlocker blocker(this);
+
+  const int numberOfComponents = colors->GetNumberOfComponents();
+  unsigned char* rgba = lut->WritePointer(firstEntry, numberOfEntries);
+  for (vtkIdType i = 0; i < numberOfEntries; ++i)
+    {
+    const double* color = colors->GetPointer(i * numberOfComponents);
+    *(rgba++) = static_cast<unsigned char>(color[0] * 255.0 + 0.5);
+    *(rgba++) = static_cast<unsigned char>(color[1] * 255.0 + 0.5);
+    *(rgba++) = static_cast<unsigned char>(color[2] * 255.0 + 0.5);
+    *(rgba++) = static_cast<unsigned char>((numberOfComponents == 4 ? color[3] : 1.0) * 255.0 + 0.5);
+    if (names)
+      {
+      this->Names[firstEntry + i] = names->GetValue(i);
+      }
+    }
+  lut->BuildSpecialColors();
+  lut->Modified();
+  if (names)
+    {
+    this->NamesModified();
+    }
+  this->StorableModifiedTime.Modified();
 
   this->Modified();
   return 1;
@@ -1458,6 +1531,7 @@ bool vtkMRMLColorTableNode::GetColor(int entry, double color[4])
 void vtkMRMLColorTableNode::ClearNames()
 {
   this->Names.clear();
+  this->NamesModified();
   this->NamesInitialisedOff();
 }
 
@@ -17,6 +17,9 @@
 
 #include "vtkMRMLColorNode.h"
 
+class vtkDoubleArray;
+class vtkStringArray;
+
 /// \brief MRML node to represent discrete color information.
 ///
 /// Color nodes describe color look up tables. The tables may be pre-generated by
@@ -216,6 +219,13 @@ public:
   /// This is much more efficient than setting many color entries one by one using SetColor().
   int SetColors(int firstEntry, int lastEntry, const char* name, double r, double g, double b, double a = 1.0);
 
+  /// Set names and colors of consecutive entries, starting at firstEntry, in one batch
+  /// (with one ModifiedEvent). colors must have 3 (RGB) or 4 (RGBA) components with values
+  /// in the range 0-1, one tuple for each entry. If names is not nullptr then it must
+  /// contain one name for each entry. All entries must be within the table.
+  /// Return 1 on success, 0 on failure.
+  int SetColors(int firstEntry, vtkStringArray* names, vtkDoubleArray* colors);
+
   /// Set a color into the User color table. Return 1 on success, 0 on failure.
   int SetColor(int entry, double r, double g, double b, double a);
   int SetColor(int entry, double r, double g, double b);
@@ -18,11 +18,14 @@ Version:   $Revision: 1.6 $
 #include "vtkMRMLScene.h"
 
 // VTK include
+#include <vtkDoubleArray.h>
 #include <vtkLookupTable.h>
+#include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkStringArray.h>
 
 // STD include
+#include <algorithm>
 #include <sstream>
 
 //------------------------------------------------------------------------------
@@ -152,10 +155,17 @@ int vtkMRMLColorTableStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
       colorNode->GetLookupTable()->SetTableRange(0, maxID);
       }
     // init the table to black/opacity 0 with no name, just in case we're missing values
-    colorNode->SetColors(0, maxID, colorNode->GetNoName(), 0.0, 0.0, 0.0, 0.0);
-    // We are sure that all the names are initialized here, flag it as such
-    // to prevent unnecessary recomputation
-    colorNode->NamesInitialisedOn();
+    vtkNew<vtkStringArray> names;
+    names->SetNumberOfValues(maxID + 1);
+    std::string noName = colorNode->GetNoName() ? colorNode->GetNoName() : "";
+    for (int id = 0; id <= maxID; ++id)
+      {
+      names->SetValue(id, noName);
+      }
+    vtkNew<vtkDoubleArray> colors;
+    colors->SetNumberOfComponents(4);
+    colors->SetNumberOfTuples(maxID + 1);
+    colors->Fill(0.0);
     // do a little sanity check, if never get an rgb bigger than 1.0, report
     // it as a possibly miswritten file
     bool biggerThanOne = false;
@@ -214,14 +224,28 @@ int vtkMRMLColorTableStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
         {
         vtkDebugMacro("(first ten) Adding color at id " << id << ", name = " << name.c_str() << ", r = " << r << ", g = " << g << ", b = " << b << ", a = " << a);
         }
-      if (colorNode->SetColor(id, name.c_str(), r, g, b, a) == 0)
+      if (id < 0 || id > maxID)
         {
         vtkWarningMacro("ReadData: unable to set color " << id << " with name " << name.c_str() << ", breaking the loop over " << lines.size() << " lines in the file " << this->FileName);
         colorNode->EndModify(wasModifying);
         return 0;
         }
-      colorNode->SetColorNameWithSpaces(id, name.c_str(), "_");
+      // spaces are stored as underscores in the file
+      std::replace(name.begin(), name.end(), '_', ' ');
+      names->SetValue(id, name);
+      double color[4] = { r, g, b, a };
+      colors->SetTypedTuple(id, color);
+      }
+    // set all colors at once, it is much faster than setting them one by one for large tables
+    if (colorNode->SetColors(0, names, colors) == 0)
+      {
+      vtkErrorMacro("ReadData: unable to set colors from file " << this->FileName);
+      colorNode->EndModify(wasModifying);
+      return 0;
       }
+    // We are sure that all the names are initialized here, flag it as such
+    // to prevent unnecessary recomputation
+    colorNode->NamesInitialisedOn();
     if (lines.size() > 0 && !biggerThanOne)
       {
       vtkWarningMacro("ReadDataInternal: possibly malformed color table file:\n" << this->FileName << ".\n\tNo RGB values are greater than 1. Valid values are 0-255");
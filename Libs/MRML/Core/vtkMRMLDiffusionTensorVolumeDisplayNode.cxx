@@ -61,7 +61,6 @@ vtkMRMLDiffusionTensorVolumeDisplayNode
 
  this->ImageMath  = vtkImageMathematics::New();
  this->ImageMath->SetOperationToMultiplyByK();
- this->ImageMath->SetConstantK(255);
 
  this->DiffusionTensorGlyphFilter = vtkDiffusionTensorGlyph::New();
  vtkSphereSource *sphere = vtkSphereSource::New();
@@ -183,11 +182,15 @@ void vtkMRMLDiffusionTensorVolumeDisplayNode::UpdateImageDataPipeline()
     case vtkMRMLDiffusionTensorDisplayPropertiesNode::ColorOrientationMiddleEigenvector:
     case vtkMRMLDiffusionTensorDisplayPropertiesNode::ColorOrientationMinEigenvector:
       {
-      // alpha
+      // alpha: computed in the same pass as the color, on the second output.
+      // Eigensystem of each tensor is computed only once.
       this->DTIMathematics->SetScaleFactor(1000.0);
-      this->DTIMathematicsAlpha->SetOperation(
+      this->DTIMathematics->SetNumberOfOperations(2);
+      this->DTIMathematics->SetNthOperation(1,
         vtkMRMLDiffusionTensorDisplayPropertiesNode::FractionalAnisotropy);
-      this->ImageMath->SetInputConnection( this->DTIMathematicsAlpha->GetOutputPort());
+      // the scale factor applies to FA as well: map 0..1000 to 0..255
+      this->ImageMath->SetConstantK(255. / 1000.);
+      this->ImageMath->SetInputConnection( this->DTIMathematics->GetOutputPort(1));
       this->ImageCast->SetInputConnection( this->ImageMath->GetOutputPort());
       this->Threshold->SetInputConnection( this->ImageCast->GetOutputPort());
 
@@ -209,6 +212,8 @@ void vtkMRMLDiffusionTensorVolumeDisplayNode::UpdateImageDataPipeline()
       break;
       }
     default:
+      this->ImageMath->RemoveAllInputConnections(0);
+      this->DTIMathematics->SetNumberOfOperations(1);
       this->DTIMathematics->SetScaleFactor(1.0);
       this->Threshold->SetInputConnection( this->DTIMathematics->GetOutputPort());
       this->MapToWindowLevelColors->SetInputConnection( this->DTIMathematics->GetOutputPort());
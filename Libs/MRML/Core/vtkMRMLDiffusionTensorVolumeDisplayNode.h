@@ -200,7 +200,9 @@ protected:
 
   /// used for main scalar invarant (can be 1 or 3 component)
   vtkDiffusionTensorMathematics *DTIMathematics;
-  /// used for calculating single component magnitude for color images
+  /// No longer used in the pipeline: the single component magnitude for color
+  /// images is computed by DTIMathematics on its second output.
+  /// Kept for backward compatibility.
   vtkDiffusionTensorMathematics *DTIMathematicsAlpha;
 
   vtkImageShiftScale *ShiftScale;
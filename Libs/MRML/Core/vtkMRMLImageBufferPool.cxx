@@ -0,0 +1,221 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkMRMLImageBufferPool.h"
+
+// VTK includes
+#include <vtkDataArray.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkMRMLImageBufferPool);
+
+namespace
+{
+
+/// Buffers smaller than this (in bytes) are allocated and freed as usual.
+const size_t MinimumPooledBufferSize = 64 * 1024;
+
+//----------------------------------------------------------------------------
+struct ImageBufferPool
+{
+  std::mutex Mutex;
+  size_t MaximumFreeBuffersSize{256 * 1024 * 1024};
+  size_t FreeBuffersSize{0};
+  /// Buffers available for reuse, by size
+  std::multimap<size_t, void*> FreeBuffers;
+  /// Size of the buffers that are in use
+  std::unordered_map<void*, size_t> UsedBuffers;
+};
+
+//----------------------------------------------------------------------------
+ImageBufferPool& GetImageBufferPool()
+{
+  // Arrays may release their buffer during static destruction, after a static
+  // pool object would have been destroyed. Therefore the pool is never deleted.
+  static ImageBufferPool* pool = new ImageBufferPool;
+  return *pool;
+}
+
+//----------------------------------------------------------------------------
+/// Round up size to the next size class. Size classes are the powers of two
+/// and three intermediate steps between them.
+size_t GetSizeClass(size_t size)
+{
+  size_t powerOfTwo = MinimumPooledBufferSize;
+  while (powerOfTwo < size)
+    {
+    powerOfTwo <<= 1;
+    }
+  if (powerOfTwo == MinimumPooledBufferSize)
+    {
+    return powerOfTwo;
+    }
+  size_t half = powerOfTwo / 2;
+  size_t step = half / 4;
+  return half + (size - half + step - 1) / step * step;
+}
+
+//----------------------------------------------------------------------------
+void* AcquireBuffer(size_t size)
+{
+  size_t sizeClass = GetSizeClass(size);
+  ImageBufferPool& pool = GetImageBufferPool();
+  std::lock_guard<std::mutex> lock(pool.Mutex);
+  void* buffer = nullptr;
+  std::multimap<size_t, void*>::iterator freeBufferIt = pool.FreeBuffers.lower_bound(sizeClass);
+  if (freeBufferIt != pool.FreeBuffers.end() && freeBufferIt->first <= 2 * sizeClass)
+    {
+    sizeClass = freeBufferIt->first;
+    buffer = freeBufferIt->second;
+    pool.FreeBuffers.erase(freeBufferIt);
+    pool.FreeBuffersSize -= sizeClass;
+    }
+  else
+    {
+    buffer = malloc(sizeClass);
+    if (!buffer)
+      {
+      return nullptr;
+      }
+    }
+  pool.UsedBuffers[buffer] = sizeClass;
+  return buffer;
+}
+
+//----------------------------------------------------------------------------
+/// Free function of the arrays that use a buffer of the pool.
+void ReleaseBuffer(void* buffer)
+{
+  if (!buffer)
+    {
+    return;
+    }
+  ImageBufferPool& pool = GetImageBufferPool();
+  std::lock_guard<std::mutex> lock(pool.Mutex);
+  std::unordered_map<void*, size_t>::iterator usedBufferIt = pool.UsedBuffers.find(buffer);
+  if (usedBufferIt == pool.UsedBuffers.end())
+    {
+    free(buffer);
+    return;
+    }
+  size_t size = usedBufferIt->second;
+  pool.UsedBuffers.erase(usedBufferIt);
+  if (pool.FreeBuffersSize + size > pool.MaximumFreeBuffersSize)
+    {
+    free(buffer);
+    return;
+    }
+  pool.FreeBuffers.emplace(size, buffer);
+  pool.FreeBuffersSize += size;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+void vtkMRMLImageBufferPool::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumFreeBuffersSize: " << vtkMRMLImageBufferPool::GetMaximumFreeBuffersSize() << " KiB\n";
+  os << indent << "FreeBuffersSize: " << vtkMRMLImageBufferPool::GetFreeBuffersSize() << " KiB\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLImageBufferPool::SetMaximumFreeBuffersSize(vtkIdType kibibytes)
+{
+  ImageBufferPool& pool = GetImageBufferPool();
+  {
+    std::lock_guard<std::mutex> lock(pool.Mutex);
+    pool.MaximumFreeBuffersSize = static_cast<size_t>(kibibytes > 0 ? kibibytes : 0) * 1024;
+  }
+  if (vtkMRMLImageBufferPool::GetFreeBuffersSize() > kibibytes)
+    {
+    vtkMRMLImageBufferPool::Clear();
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkMRMLImageBufferPool::GetMaximumFreeBuffersSize()
+{
+  ImageBufferPool& pool = GetImageBufferPool();
+  std::lock_guard<std::mutex> lock(pool.Mutex);
+  return static_cast<vtkIdType>(pool.MaximumFreeBuffersSize / 1024);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkMRMLImageBufferPool::GetFreeBuffersSize()
+{
+  ImageBufferPool& pool = GetImageBufferPool();
+  std::lock_guard<std::mutex> lock(pool.Mutex);
+  return static_cast<vtkIdType>(pool.FreeBuffersSize / 1024);
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLImageBufferPool::Clear()
+{
+  ImageBufferPool& pool = GetImageBufferPool();
+  std::lock_guard<std::mutex> lock(pool.Mutex);
+  for (const std::pair<const size_t, void*>& freeBuffer : pool.FreeBuffers)
+    {
+    free(freeBuffer.second);
+    }
+  pool.FreeBuffers.clear();
+  pool.FreeBuffersSize = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLImageBufferPool::AllocateScalars(vtkImageData* image, int scalarType,
+  int numberOfComponents, const int extent[6])
+{
+  if (!image || !extent || numberOfComponents < 1)
+    {
+    return;
+    }
+  vtkIdType numberOfTuples = 1;
+  for (int i = 0; i < 3; ++i)
+    {
+    numberOfTuples *= std::max(extent[2 * i + 1] - extent[2 * i] + 1, 0);
+    }
+  vtkSmartPointer<vtkDataArray> scalars = vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(scalarType));
+  if (!scalars || scalarType == VTK_BIT)
+    {
+    vtkGenericWarningMacro("vtkMRMLImageBufferPool::AllocateScalars failed: invalid scalar type " << scalarType);
+    return;
+    }
+  vtkIdType numberOfValues = numberOfTuples * numberOfComponents;
+  size_t size = static_cast<size_t>(numberOfValues) * scalars->GetDataTypeSize();
+  if (size < MinimumPooledBufferSize)
+    {
+    // not worth pooling, let the filter allocate the scalars
+    return;
+    }
+  void* buffer = AcquireBuffer(size);
+  if (!buffer)
+    {
+    return;
+    }
+  scalars->SetNumberOfComponents(numberOfComponents);
+  scalars->SetVoidArray(buffer, numberOfValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  scalars->SetArrayFreeFunction(ReleaseBuffer);
+  image->GetPointData()->SetScalars(scalars);
+}
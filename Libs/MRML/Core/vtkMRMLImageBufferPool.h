@@ -0,0 +1,114 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkMRMLImageBufferPool_h
+#define __vtkMRMLImageBufferPool_h
+
+// MRML includes
+#include "vtkMRML.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkObject.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+
+class vtkInformation;
+
+/// \brief Pool of memory buffers reused by the outputs of image filters.
+///
+/// VTK image filters allocate a new scalar array each time they execute. When the
+/// output size changes often (for example, while a slice view is resized) this causes
+/// many large allocations, each of them followed by page faults when the memory is
+/// first written. Filters created with vtkMRMLPooledOutputImageFilter take their output
+/// scalars from this pool instead. Buffers are rounded up to size classes (at most 25%
+/// larger than requested) and are returned to the pool when the output array is deleted.
+///
+/// Buffers are reused by any filter that requests a buffer of the same size class (or of
+/// the next size classes, up to twice the requested size). Small buffers are not pooled.
+class VTK_MRML_EXPORT vtkMRMLImageBufferPool : public vtkObject
+{
+public:
+  static vtkMRMLImageBufferPool* New();
+  vtkTypeMacro(vtkMRMLImageBufferPool, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Maximum total size of the buffers kept in the pool for reuse, in kibibytes.
+  /// Buffers that are released when the pool is full are freed. Default is 262144 (256 MiB).
+  static void SetMaximumFreeBuffersSize(vtkIdType kibibytes);
+  static vtkIdType GetMaximumFreeBuffersSize();
+
+  /// Total size of the buffers currently kept in the pool for reuse, in kibibytes.
+  static vtkIdType GetFreeBuffersSize();
+
+  /// Free all the buffers that are kept in the pool for reuse.
+  /// Buffers that are in use are not affected.
+  static void Clear();
+
+  /// Set scalars of the requested type, number of components and extent to the
+  /// image, with a buffer taken from the pool. Unlike vtkImageData::AllocateScalars,
+  /// this does not initialize or change the image extent.
+  static void AllocateScalars(vtkImageData* image, int scalarType, int numberOfComponents, const int extent[6]);
+
+protected:
+  vtkMRMLImageBufferPool() = default;
+  ~vtkMRMLImageBufferPool() override = default;
+
+private:
+  vtkMRMLImageBufferPool(const vtkMRMLImageBufferPool&) = delete;
+  void operator=(const vtkMRMLImageBufferPool&) = delete;
+};
+
+#ifndef __VTK_WRAP__
+/// \brief Image filter that allocates its output scalars from vtkMRMLImageBufferPool.
+///
+/// FilterType must be a vtkThreadedImageAlgorithm that allocates its outputs in
+/// AllocateOutputData(vtkImageData*, vtkInformation*, int*).
+/// \code
+/// vtkImageReslice* reslice = vtkMRMLPooledOutputImageFilter<vtkImageReslice>::New();
+/// \endcode
+template <class FilterType>
+class vtkMRMLPooledOutputImageFilter : public FilterType
+{
+public:
+  static vtkMRMLPooledOutputImageFilter<FilterType>* New()
+  {
+    VTK_STANDARD_NEW_BODY(vtkMRMLPooledOutputImageFilter<FilterType>);
+  }
+  vtkTemplateTypeMacro(vtkMRMLPooledOutputImageFilter<FilterType>, FilterType);
+
+protected:
+  vtkMRMLPooledOutputImageFilter() = default;
+  ~vtkMRMLPooledOutputImageFilter() override = default;
+
+  void AllocateOutputData(vtkImageData* output, vtkInformation* outInfo, int* uExtent) override
+  {
+    if (output && output->GetPointData()->GetScalars() == nullptr)
+      {
+      // The superclass reuses these scalars, as they match the requested type and size.
+      vtkMRMLImageBufferPool::AllocateScalars(output,
+        vtkImageData::GetScalarType(outInfo), vtkImageData::GetNumberOfScalarComponents(outInfo), uExtent);
+      }
+    this->Superclass::AllocateOutputData(output, outInfo, uExtent);
+  }
+  using FilterType::AllocateOutputData;
+
+private:
+  vtkMRMLPooledOutputImageFilter(const vtkMRMLPooledOutputImageFilter&) = delete;
+  void operator=(const vtkMRMLPooledOutputImageFilter&) = delete;
+};
+#endif
+
+#endif
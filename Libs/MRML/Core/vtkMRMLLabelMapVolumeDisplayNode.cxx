@@ -12,6 +12,8 @@ Version:   $Revision: 1.2 $
 
 =========================================================================auto=*/
 
+#include "vtkImageLabelMapToColors.h"
+#include "vtkMRMLImageBufferPool.h"
 #include "vtkMRMLLabelMapVolumeDisplayNode.h"
 #include "vtkMRMLProceduralColorNode.h"
 #include "vtkMRMLScene.h"
@@ -33,7 +35,7 @@ vtkMRMLNodeNewMacro(vtkMRMLLabelMapVolumeDisplayNode);
 //----------------------------------------------------------------------------
 vtkMRMLLabelMapVolumeDisplayNode::vtkMRMLLabelMapVolumeDisplayNode()
 {
-  this->MapToColors = vtkImageMapToColors::New();
+  this->MapToColors = vtkMRMLPooledOutputImageFilter<vtkImageLabelMapToColors>::New();
   this->MapToColors->SetOutputFormatToRGBA();
 
   // set a thicker default slice intersection thickness for use when showing
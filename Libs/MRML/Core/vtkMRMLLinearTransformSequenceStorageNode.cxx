@@ -9,7 +9,11 @@ or http://www.slicer.org/copyright/copyright.txt for details.
 
 // STD includes
 #include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
 #include <sstream>
+#include <vector>
 
 #include "vtkMRMLLinearTransformSequenceStorageNode.h"
 #include "vtkMRMLMessageCollection.h"
@@ -22,12 +26,15 @@ or http://www.slicer.org/copyright/copyright.txt for details.
 #include "vtkMRMLSequenceNode.h"
 
 #include "vtkObjectFactory.h"
+#include "vtkByteSwap.h"
 #include "vtkImageAppendComponents.h"
 #include "vtkImageData.h"
 #include "vtkImageExtractComponents.h"
 #include "vtkMatrix4x4.h"
 #include "vtkNew.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
+#include "vtkZLibDataCompressor.h"
 
 #include "vtksys/SystemTools.hxx"
 
@@ -39,6 +46,11 @@ static std::string SEQMETA_FIELD_IMG_STATUS = "ImageStatus";
 // Constants for creating nodes
 static const char NODE_BASE_NAME_SEPARATOR[] = "-";
 
+// Constants for binary sequence files
+static const char BINARY_SEQUENCE_FILE_EXTENSION[] = ".seq.lts";
+static const char BINARY_SEQUENCE_FILE_MAGIC[] = "SLTSEQ1\n"; // written without the terminating null character
+static const vtkTypeUInt64 BINARY_SEQUENCE_FILE_COMPRESSED_FLAG = 1;
+
 //----------------------------------------------------------------------------
 vtkMRMLNodeNewMacro(vtkMRMLLinearTransformSequenceStorageNode);
 
@@ -81,6 +93,160 @@ void StringToInt(const char* strPtr, T &result)
   return;
 }
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Transform field of a frame, as it is found in the file header.
+/// Matrix values are parsed after the whole header is read, in parallel.
+struct TransformField
+{
+  int FrameNumber{0};
+  std::string Name;
+  std::string Value;
+};
+
+//----------------------------------------------------------------------------
+/// Parse the 16 elements of a 4x4 matrix (row by row, separated by spaces).
+/// This is much faster than parsing using string streams, which matters when
+/// there are hundreds of thousands of matrices in a file.
+bool ParseMatrixElements(const std::string& text, double elements[16])
+{
+  const char* current = text.c_str();
+  for (int elementIndex = 0; elementIndex < 16; ++elementIndex)
+    {
+    char* end = nullptr;
+    elements[elementIndex] = strtod(current, &end);
+    if (end == current)
+      {
+      return false;
+      }
+    current = end;
+    }
+  while (isspace(static_cast<unsigned char>(*current)))
+    {
+    ++current;
+    }
+  return (*current == '\0');
+}
+
+//----------------------------------------------------------------------------
+/// Get index value from timestamp. Timestamps are rounded to 3 decimal digits, as timestamp is included
+/// in node names and having lots of decimal digits would sometimes lead to extremely long node names.
+std::string GetIndexValueFromTimestamp(double timestampSec)
+{
+  std::ostringstream timestampSecStr;
+  timestampSecStr << std::fixed << std::setprecision(3) << timestampSec;
+  return timestampSecStr.str();
+}
+
+//----------------------------------------------------------------------------
+bool IsBinarySequenceFileName(const std::string& fileName)
+{
+  std::string fileNameLowercase = vtksys::SystemTools::LowerCase(fileName);
+  std::string extension = BINARY_SEQUENCE_FILE_EXTENSION;
+  return fileNameLowercase.length() > extension.length()
+    && fileNameLowercase.compare(fileNameLowercase.length() - extension.length(), extension.length(), extension) == 0;
+}
+
+//----------------------------------------------------------------------------
+void WriteUInt64(std::ostream& stream, vtkTypeUInt64 value)
+{
+  vtkByteSwap::SwapLE(&value);
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+//----------------------------------------------------------------------------
+bool ReadUInt64(std::istream& stream, vtkTypeUInt64& value)
+{
+  if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+    {
+    return false;
+    }
+  vtkByteSwap::SwapLE(&value);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void WriteString(std::ostream& stream, const std::string& text)
+{
+  WriteUInt64(stream, static_cast<vtkTypeUInt64>(text.size()));
+  stream.write(text.data(), text.size());
+}
+
+//----------------------------------------------------------------------------
+bool ReadString(std::istream& stream, std::string& text)
+{
+  vtkTypeUInt64 length = 0;
+  // Strings are only short names, a very large length indicates a corrupted file
+  if (!ReadUInt64(stream, length) || length > 65536)
+    {
+    return false;
+    }
+  text.resize(static_cast<size_t>(length));
+  return length == 0 || static_cast<bool>(stream.read(&text[0], static_cast<std::streamsize>(length)));
+}
+
+//----------------------------------------------------------------------------
+/// Write a column of values in little endian byte order.
+/// If compressor is specified then the size of the compressed data is written, followed by the compressed data.
+bool WriteColumn(std::ostream& stream, std::vector<double> values, vtkZLibDataCompressor* compressor)
+{
+  vtkByteSwap::SwapLERange(values.data(), values.size());
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(values.data());
+  size_t dataSize = values.size() * sizeof(double);
+  if (!compressor)
+    {
+    stream.write(reinterpret_cast<const char*>(data), dataSize);
+    return static_cast<bool>(stream);
+    }
+  std::vector<unsigned char> compressedData(compressor->GetMaximumCompressionSpace(dataSize));
+  size_t compressedSize = compressor->Compress(data, dataSize, compressedData.data(), compressedData.size());
+  if (compressedSize == 0 && dataSize > 0)
+    {
+    return false;
+    }
+  WriteUInt64(stream, static_cast<vtkTypeUInt64>(compressedSize));
+  stream.write(reinterpret_cast<const char*>(compressedData.data()), compressedSize);
+  return static_cast<bool>(stream);
+}
+
+//----------------------------------------------------------------------------
+/// Read a column of values written by WriteColumn. Size of values must be already set.
+bool ReadColumn(std::istream& stream, std::vector<double>& values, vtkZLibDataCompressor* compressor)
+{
+  unsigned char* data = reinterpret_cast<unsigned char*>(values.data());
+  size_t dataSize = values.size() * sizeof(double);
+  if (!compressor)
+    {
+    if (!stream.read(reinterpret_cast<char*>(data), dataSize))
+      {
+      return false;
+      }
+    }
+  else
+    {
+    vtkTypeUInt64 compressedSize = 0;
+    if (!ReadUInt64(stream, compressedSize) || compressedSize > compressor->GetMaximumCompressionSpace(dataSize))
+      {
+      return false;
+      }
+    std::vector<unsigned char> compressedData(static_cast<size_t>(compressedSize));
+    if (!stream.read(reinterpret_cast<char*>(compressedData.data()), static_cast<std::streamsize>(compressedSize)))
+      {
+      return false;
+      }
+    if (compressor->Uncompress(compressedData.data(), compressedData.size(), data, dataSize) != dataSize)
+      {
+      return false;
+      }
+    }
+  vtkByteSwap::SwapLERange(values.data(), values.size());
+  return true;
+}
+
+} // end of anonymous namespace
+
 //----------------------------------------------------------------------------
 int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const std::string& fileName, vtkMRMLScene *scene,
   std::deque< vtkSmartPointer<vtkMRMLSequenceNode> > &createdNodes, std::map< int, std::string >& frameNumberToIndexValueMap,
@@ -100,10 +266,8 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
 
   frameNumberToIndexValueMap.clear();
 
-  // This structure contains all the transform nodes that are read from the file.
-  // The nodes are not added immediately to the scene to allow them properly named, using the timestamp index value.
-  // Maps the frame number to a vector of transform nodes that belong to that frame.
-  std::map<int, std::vector<vtkMRMLLinearTransformNode*> > importedTransformNodes;
+  // Transform fields found in the header. Matrices are parsed when the whole header is read.
+  std::vector<TransformField> transformFields;
 
   // It contains the largest frame number. It will be used to iterate through all the frame numbers from 0 to lastFrameNumber
   int lastFrameNumber = -1;
@@ -206,30 +370,19 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
       lastFrameNumber = frameNumber;
       }
 
-    // Convert the string to transform and add transform to hierarchy
+    // Store the transform string, it is converted to a matrix after the whole header is read
     if (frameFieldName.find("Transform") != std::string::npos && frameFieldName.find("Status") == std::string::npos)
       {
-      vtkNew<vtkMatrix4x4> matrix;
-      bool success = vtkAddonMathUtilities::FromString(matrix.GetPointer(), value);
-      if (!success)
-        {
-        continue;
-        }
-      vtkMRMLLinearTransformNode* currentTransform = vtkMRMLLinearTransformNode::New(); // will be deleted when added to the scene
-      currentTransform->SetMatrixTransformToParent(matrix.GetPointer());
-      // Generating a unique name is important because that will be used to generate the filename by default
-      currentTransform->SetName(frameFieldName.c_str());
-      importedTransformNodes[frameNumber].push_back(currentTransform);
+      TransformField transformField;
+      transformField.FrameNumber = frameNumber;
+      transformField.Name = frameFieldName;
+      transformField.Value = value;
+      transformFields.push_back(transformField);
       }
 
     if (frameFieldName.compare("Timestamp") == 0)
       {
-      double timestampSec = atof(value.c_str());
-      // round timestamp to 3 decimal digits, as timestamp is included in node names and having lots of decimal digits would
-      // sometimes lead to extremely long node names
-      std::ostringstream timestampSecStr;
-      timestampSecStr << std::fixed << std::setprecision(3) << timestampSec << std::ends;
-      frameNumberToIndexValueMap[frameNumber] = timestampSecStr.str();
+      frameNumberToIndexValueMap[frameNumber] = GetIndexValueFromTimestamp(atof(value.c_str()));
       }
 
     if (ferror(stream))
@@ -245,9 +398,53 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
     }
   fclose(stream);
 
+  // Parse the matrices in parallel. Each transform field is parsed into different elements of the array.
+  vtkIdType numberOfTransformFields = static_cast<vtkIdType>(transformFields.size());
+  std::vector<double> transformElements(transformFields.size() * 16);
+  std::vector<char> transformValid(transformFields.size(), 0);
+  vtkSMPTools::For(0, numberOfTransformFields, [&](vtkIdType beginField, vtkIdType endField)
+    {
+    vtkNew<vtkMatrix4x4> matrix;
+    for (vtkIdType fieldIndex = beginField; fieldIndex < endField; ++fieldIndex)
+      {
+      double* elements = &transformElements[16 * fieldIndex];
+      if (ParseMatrixElements(transformFields[fieldIndex].Value, elements))
+        {
+        transformValid[fieldIndex] = 1;
+        }
+      else if (vtkAddonMathUtilities::FromString(matrix.GetPointer(), transformFields[fieldIndex].Value))
+        {
+        // not in the usual format, but the generic parser can still read it
+        std::copy(&matrix->Element[0][0], &matrix->Element[0][0] + 16, elements);
+        transformValid[fieldIndex] = 1;
+        }
+      }
+    });
+
+  // This structure contains all the transform nodes that are read from the file.
+  // The nodes are not added immediately to the scene to allow them properly named, using the timestamp index value.
+  // Maps the frame number to a vector of transform nodes that belong to that frame.
+  std::map<int, std::vector<vtkMRMLLinearTransformNode*> > importedTransformNodes;
+  vtkNew<vtkMatrix4x4> matrix;
+  for (vtkIdType fieldIndex = 0; fieldIndex < numberOfTransformFields; ++fieldIndex)
+    {
+    if (!transformValid[fieldIndex])
+      {
+      continue;
+      }
+    matrix->DeepCopy(&transformElements[16 * fieldIndex]);
+    vtkMRMLLinearTransformNode* currentTransform = vtkMRMLLinearTransformNode::New(); // will be deleted when added to the scene
+    currentTransform->SetMatrixTransformToParent(matrix.GetPointer());
+    // Generating a unique name is important because that will be used to generate the filename by default
+    currentTransform->SetName(transformFields[fieldIndex].Name.c_str());
+    importedTransformNodes[transformFields[fieldIndex].FrameNumber].push_back(currentTransform);
+    }
+
   // Now add all the nodes to the scene
 
   std::map< std::string, vtkMRMLSequenceNode* > transformSequenceNodes;
+  // Modified events of sequence nodes are invoked once, after all items are added
+  std::vector< std::pair<vtkMRMLSequenceNode*, int> > sequenceNodesWasModifying;
 
   for (int currentFrameNumber = 0; currentFrameNumber <= lastFrameNumber; currentFrameNumber++)
     {
@@ -299,6 +496,7 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
         transformsSequenceNode->SetAttribute("Sequences.Source", transformName.c_str());
 
         transformSequenceNodes[transform->GetName()] = transformsSequenceNode;
+        sequenceNodesWasModifying.emplace_back(transformsSequenceNode, transformsSequenceNode->StartModify());
         }
       else
         {
@@ -309,11 +507,17 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
       std::ostringstream nameStr;
       nameStr << transform->GetName() << "_" << std::setw(4) << std::setfill('0') << currentFrameNumber << std::ends;
       transform->SetName(nameStr.str().c_str());
-      transformsSequenceNode->SetDataNodeAtValue(transform, paramValueString.c_str());
+      // The node is not used anywhere else, so it is added to the sequence without making a copy
+      transformsSequenceNode->SetDataNodeAtValue(transform, paramValueString, false);
       transform->Delete(); // ownership transferred to the sequence node
       }
     }
 
+  for (const std::pair<vtkMRMLSequenceNode*, int>& sequenceNodeWasModifying : sequenceNodesWasModifying)
+    {
+    sequenceNodeWasModifying.first->EndModify(sequenceNodeWasModifying.second);
+    }
+
   // Add to scene and set name and storage node
   std::string fileNameName = vtksys::SystemTools::GetFilenameName(fileName);
   std::string shortestBaseNodeName;
@@ -483,6 +687,148 @@ bool vtkMRMLLinearTransformSequenceStorageNode::WriteSequenceMetafileTransforms(
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkMRMLLinearTransformSequenceStorageNode::ReadBinarySequenceFile(const std::string& fileName, vtkMRMLSequenceNode* sequenceNode)
+{
+  std::ifstream stream(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!stream)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLLinearTransformSequenceStorageNode::ReadBinarySequenceFile",
+      "Failed to open file for reading: " << fileName);
+    return false;
+    }
+
+  std::string magic(sizeof(BINARY_SEQUENCE_FILE_MAGIC) - 1, '\0');
+  vtkTypeUInt64 flags = 0;
+  vtkTypeUInt64 numberOfFrames = 0;
+  std::string transformName;
+  std::string indexName;
+  std::string indexUnit;
+  if (!stream.read(&magic[0], magic.size()) || magic != BINARY_SEQUENCE_FILE_MAGIC
+    || !ReadUInt64(stream, flags) || !ReadUInt64(stream, numberOfFrames)
+    || !ReadString(stream, transformName) || !ReadString(stream, indexName) || !ReadString(stream, indexUnit))
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLLinearTransformSequenceStorageNode::ReadBinarySequenceFile",
+      "Invalid linear transform sequence file header: " << fileName);
+    return false;
+    }
+
+  // Make sure a corrupted frame count does not make us allocate an extremely large buffer
+  std::streamoff headerSize = stream.tellg();
+  stream.seekg(0, std::ios::end);
+  std::streamoff fileSize = stream.tellg();
+  stream.seekg(headerSize);
+  bool compressed = (flags & BINARY_SEQUENCE_FILE_COMPRESSED_FLAG) != 0;
+  // zlib cannot compress data to less than about 1/1032 of its size
+  vtkTypeUInt64 maximumDataSize = static_cast<vtkTypeUInt64>(fileSize) * (compressed ? 1032 : 1);
+  if (numberOfFrames > maximumDataSize / (17 * sizeof(double)))
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLLinearTransformSequenceStorageNode::ReadBinarySequenceFile",
+      "Linear transform sequence file is truncated: " << fileName);
+    return false;
+    }
+
+  // Each column is read at once
+  vtkNew<vtkZLibDataCompressor> compressor;
+  std::vector<double> timestamps(static_cast<size_t>(numberOfFrames));
+  std::vector<double> matrixElements(static_cast<size_t>(numberOfFrames) * 16);
+  if (!ReadColumn(stream, timestamps, compressed ? compressor.GetPointer() : nullptr)
+    || !ReadColumn(stream, matrixElements, compressed ? compressor.GetPointer() : nullptr))
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLLinearTransformSequenceStorageNode::ReadBinarySequenceFile",
+      "Failed to read transforms from linear transform sequence file: " << fileName);
+    return false;
+    }
+
+  MRMLNodeModifyBlocker blocker(sequenceNode);
+  sequenceNode->RemoveAllDataNodes();
+  sequenceNode->SetIndexType(vtkMRMLSequenceNode::NumericIndex);
+  sequenceNode->SetIndexName(indexName);
+  sequenceNode->SetIndexUnit(indexUnit);
+  sequenceNode->SetAttribute("Sequences.Source", transformName.c_str());
+  vtkNew<vtkMatrix4x4> matrix;
+  for (vtkTypeUInt64 frameNumber = 0; frameNumber < numberOfFrames; ++frameNumber)
+    {
+    matrix->DeepCopy(&matrixElements[16 * frameNumber]);
+    vtkNew<vtkMRMLLinearTransformNode> transform;
+    transform->SetMatrixTransformToParent(matrix.GetPointer());
+    transform->SetHideFromEditors(false);
+    // Generating a unique name is important because that will be used to generate the filename by default
+    std::ostringstream nameStr;
+    nameStr << transformName << "Transform_" << std::setw(4) << std::setfill('0') << frameNumber;
+    transform->SetName(nameStr.str().c_str());
+    // The node is not used anywhere else, so it is added to the sequence without making a copy
+    sequenceNode->SetDataNodeAtValue(transform, GetIndexValueFromTimestamp(timestamps[frameNumber]), false);
+    }
+
+  std::string baseNodeName = vtkMRMLSequenceStorageNode::GetSequenceBaseName(vtksys::SystemTools::GetFilenameName(fileName), transformName);
+  sequenceNode->SetName(vtkMRMLSequenceStorageNode::GetSequenceNodeName(baseNodeName, transformName).c_str());
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLLinearTransformSequenceStorageNode::WriteBinarySequenceFile(const std::string& fileName, vtkMRMLSequenceNode* sequenceNode)
+{
+  if (sequenceNode->GetIndexType() != vtkMRMLSequenceNode::NumericIndex)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLLinearTransformSequenceStorageNode::WriteBinarySequenceFile",
+      "Only sequences with numeric index can be written in linear transform sequence binary format.");
+    return false;
+    }
+
+  int numberOfFrames = sequenceNode->GetNumberOfDataNodes();
+  std::vector<double> timestamps(numberOfFrames);
+  std::vector<double> matrixElements(static_cast<size_t>(numberOfFrames) * 16);
+  vtkNew<vtkMatrix4x4> matrix;
+  for (int frameNumber = 0; frameNumber < numberOfFrames; frameNumber++)
+    {
+    timestamps[frameNumber] = atof(sequenceNode->GetNthIndexValue(frameNumber).c_str());
+    vtkMRMLTransformNode* transformNode = vtkMRMLTransformNode::SafeDownCast(sequenceNode->GetNthDataNode(frameNumber));
+    if (transformNode == nullptr || !transformNode->IsLinear())
+      {
+      vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLLinearTransformSequenceStorageNode::WriteBinarySequenceFile",
+        "Only linear transform nodes can be written in this format.");
+      return false;
+      }
+    transformNode->GetMatrixTransformToParent(matrix.GetPointer());
+    std::copy(&matrix->Element[0][0], &matrix->Element[0][0] + 16, &matrixElements[16 * static_cast<size_t>(frameNumber)]);
+    }
+
+  std::string transformName = "Unknown1ToUnknown2";
+  if (sequenceNode->GetAttribute("Sequences.Source"))
+    {
+    transformName = sequenceNode->GetAttribute("Sequences.Source");
+    }
+  else if (sequenceNode->GetName())
+    {
+    transformName = sequenceNode->GetName();
+    }
+
+  std::ofstream stream(fileName.c_str(), std::ios::out | std::ios::binary);
+  if (!stream)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLLinearTransformSequenceStorageNode::WriteBinarySequenceFile",
+      "Failed to open file for writing: " << fileName);
+    return false;
+    }
+  bool compressed = (this->GetUseCompression() != 0);
+  stream.write(BINARY_SEQUENCE_FILE_MAGIC, sizeof(BINARY_SEQUENCE_FILE_MAGIC) - 1);
+  WriteUInt64(stream, compressed ? BINARY_SEQUENCE_FILE_COMPRESSED_FLAG : 0);
+  WriteUInt64(stream, static_cast<vtkTypeUInt64>(numberOfFrames));
+  WriteString(stream, transformName);
+  WriteString(stream, sequenceNode->GetIndexName());
+  WriteString(stream, sequenceNode->GetIndexUnit());
+  vtkNew<vtkZLibDataCompressor> compressor;
+  if (!WriteColumn(stream, timestamps, compressed ? compressor.GetPointer() : nullptr)
+    || !WriteColumn(stream, matrixElements, compressed ? compressor.GetPointer() : nullptr))
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLLinearTransformSequenceStorageNode::WriteBinarySequenceFile",
+      "Failed to write transforms to file: " << fileName);
+    return false;
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkMRMLLinearTransformSequenceStorageNode::ReadDataInternal(vtkMRMLNode* refNode)
 {
@@ -505,6 +851,11 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadDataInternal(vtkMRMLNode* ref
     return 0;
     }
 
+  if (IsBinarySequenceFileName(fullName))
+    {
+    return this->ReadBinarySequenceFile(fullName, seqNode) ? 1 : 0;
+    }
+
   std::deque< vtkSmartPointer<vtkMRMLSequenceNode> > createdTransformNodes;
   createdTransformNodes.push_back(seqNode);
   std::map< int, std::string > frameNumberToIndexValueMap;
@@ -572,6 +923,16 @@ int vtkMRMLLinearTransformSequenceStorageNode::WriteDataInternal(vtkMRMLNode *re
     return 0;
     }
 
+  if (IsBinarySequenceFileName(fullName))
+    {
+    if (!this->WriteBinarySequenceFile(fullName, sequenceNode))
+      {
+      return 0;
+      }
+    this->StageWriteData(refNode);
+    return 1;
+    }
+
   std::deque< vtkMRMLSequenceNode* > transformSequenceNodes;
   transformSequenceNodes.push_back(sequenceNode);
   std::deque< std::string > transformNames;
@@ -602,6 +963,7 @@ void vtkMRMLLinearTransformSequenceStorageNode::InitializeSupportedReadFileTypes
   this->SupportedReadFileTypes->InsertNextValue("Linear transform sequence (.seq.mha)");
   this->SupportedReadFileTypes->InsertNextValue("Linear transform sequence (.mha)");
   this->SupportedReadFileTypes->InsertNextValue("Linear transform sequence (.mhd)");
+  this->SupportedReadFileTypes->InsertNextValue("Linear transform sequence binary (.seq.lts)");
 }
 
 //----------------------------------------------------------------------------
@@ -611,6 +973,7 @@ void vtkMRMLLinearTransformSequenceStorageNode::InitializeSupportedWriteFileType
   this->SupportedWriteFileTypes->InsertNextValue("Linear transform sequence (.seq.mha)");
   this->SupportedWriteFileTypes->InsertNextValue("Linear transform sequence (.mhd)");
   this->SupportedWriteFileTypes->InsertNextValue("Linear transform sequence (.mha)");
+  this->SupportedWriteFileTypes->InsertNextValue("Linear transform sequence binary (.seq.lts)");
 }
 
 //----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 =========================================================================auto=*/
 ///  vtkMRMLLinearTransformSequenceStorageNode - MRML node that can read/write
 ///  a Sequence node containing linear transforms in a single nrrd or mha file
+///  (transforms are stored as text in the file header), or in a compact binary file (.seq.lts)
 ///
 
 #ifndef __vtkMRMLLinearTransformSequenceStorageNode_h
@@ -81,6 +82,15 @@ protected:
 
   /// Initialize all the supported write file types
   void InitializeSupportedWriteFileTypes() override;
+
+  /// Read transforms from a binary linear transform sequence file (.seq.lts) into the sequence node.
+  /// The file contains a short header (transform name, index name and unit, number of frames),
+  /// followed by a column of timestamps and a column of 4x4 matrices, as little endian float64 values.
+  /// Columns are zlib-compressed if UseCompression was enabled when the file was written.
+  bool ReadBinarySequenceFile(const std::string& fileName, vtkMRMLSequenceNode* sequenceNode);
+
+  /// Write transforms of the sequence node into a binary linear transform sequence file (.seq.lts).
+  bool WriteBinarySequenceFile(const std::string& fileName, vtkMRMLSequenceNode* sequenceNode);
 };
 
 #endif
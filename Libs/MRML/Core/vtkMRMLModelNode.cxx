@@ -133,6 +133,16 @@ vtkMRMLModelDisplayNode* vtkMRMLModelNode::GetModelDisplayNode()
   return vtkMRMLModelDisplayNode::SafeDownCast(this->GetDisplayNode());
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLModelNode::GetDataObjects(std::vector<vtkDataObject*>& dataObjects)
+{
+  Superclass::GetDataObjects(dataObjects);
+  if (this->GetMesh())
+    {
+    dataObjects.push_back(this->GetMesh());
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLModelNode::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -59,6 +59,10 @@ public:
   /// \sa vtkMRMLNode::CopyContent
   vtkMRMLCopyContentMacro(vtkMRMLModelNode);
 
+  /// Get bulk data objects stored in this node.
+  /// \sa vtkMRMLNode::GetDataObjects
+  void GetDataObjects(std::vector<vtkDataObject*>& dataObjects) override;
+
   /// alternative method to propagate events generated in Display nodes
   void ProcessMRMLEvents ( vtkObject * /*caller*/,
                                    unsigned long /*event*/,
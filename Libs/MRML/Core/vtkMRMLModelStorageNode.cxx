@@ -14,6 +14,7 @@
 
 #include "vtkMRMLModelStorageNode.h"
 
+#include "vtkEventBroker.h"
 #include "vtkMRMLDisplayNode.h"
 #include "vtkMRMLMessageCollection.h"
 #include "vtkMRMLModelNode.h"
@@ -170,6 +171,16 @@ int vtkMRMLModelStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
     return 0;
     }
 
+  // Model passed in memory by a shared object module: share the mesh
+  // of the referenced node, it is already in RAS coordinate system.
+  vtkMRMLModelNode* memoryModelNode = vtkMRMLModelNode::SafeDownCast(
+    vtkMRMLStorageNode::GetNodeFromMemoryReference(this->GetFileName()));
+  if (memoryModelNode)
+    {
+    modelNode->SetAndObserveMesh(memoryModelNode->GetMesh());
+    return 1;
+    }
+
   std::string fullName = this->GetFullNameFromFileName();
   if (fullName.empty())
     {
@@ -460,6 +471,31 @@ int vtkMRMLModelStorageNode::WriteDataInternal(vtkMRMLNode *refNode)
 {
   vtkMRMLModelNode *modelNode = vtkMRMLModelNode::SafeDownCast(refNode);
 
+  // Model passed in memory to a shared object module: set the mesh
+  // in the referenced node instead of writing a file.
+  vtkMRMLModelNode* memoryModelNode = vtkMRMLModelNode::SafeDownCast(
+    vtkMRMLStorageNode::GetNodeFromMemoryReference(this->GetFileName()));
+  if (memoryModelNode)
+    {
+    if (memoryModelNode != modelNode)
+      {
+      // This may be called from a processing thread: do not invoke events
+      // here, the modified event is invoked later on the main thread.
+      int wasModifying = memoryModelNode->GetDisableModifiedEvent();
+      memoryModelNode->DisableModifiedEventOn();
+      memoryModelNode->SetAndObserveMesh(modelNode->GetMesh());
+      memoryModelNode->SetDisableModifiedEvent(wasModifying);
+      if (!vtkEventBroker::GetInstance()->RequestModified(memoryModelNode))
+        {
+        // no request modified callback, modified event can be invoked directly
+        bool wasModified = memoryModelNode->StartModify();
+        memoryModelNode->Modified();
+        memoryModelNode->EndModify(wasModified);
+        }
+      }
+    return 1;
+    }
+
   std::string fullName = this->GetFullNameFromFileName();
   if (fullName.empty())
     {
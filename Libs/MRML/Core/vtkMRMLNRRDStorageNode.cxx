@@ -42,6 +42,12 @@ vtkMRMLNodeNewMacro(vtkMRMLNRRDStorageNode);
 vtkMRMLNRRDStorageNode::vtkMRMLNRRDStorageNode()
 {
   this->CenterImage = 0;
+  for (int i = 0; i < 3; ++i)
+    {
+    this->ReadExtent[2 * i] = 0;
+    this->ReadExtent[2 * i + 1] = -1;
+    }
+  this->ReadDownsamplingFactor = 1;
   this->DefaultWriteFileExtension = "nhdr";
 
   this->CompressionPresets.emplace_back(this->GetCompressionParameterFastest(), "Fastest");
@@ -62,6 +68,19 @@ void vtkMRMLNRRDStorageNode::WriteXML(ostream& of, int nIndent)
   std::stringstream ss;
   ss << this->CenterImage;
   of << " centerImage=\"" << ss.str() << "\"";
+
+  if (this->ReadExtent[0] <= this->ReadExtent[1]
+    && this->ReadExtent[2] <= this->ReadExtent[3]
+    && this->ReadExtent[4] <= this->ReadExtent[5])
+    {
+    of << " readExtent=\"" << this->ReadExtent[0] << " " << this->ReadExtent[1] << " "
+       << this->ReadExtent[2] << " " << this->ReadExtent[3] << " "
+       << this->ReadExtent[4] << " " << this->ReadExtent[5] << "\"";
+    }
+  if (this->ReadDownsamplingFactor != 1)
+    {
+    of << " readDownsamplingFactor=\"" << this->ReadDownsamplingFactor << "\"";
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -83,6 +102,23 @@ void vtkMRMLNRRDStorageNode::ReadXMLAttributes(const char** atts)
       ss << attValue;
       ss >> this->CenterImage;
       }
+    else if (!strcmp(attName, "readExtent"))
+      {
+      std::stringstream ss;
+      ss << attValue;
+      for (int i = 0; i < 6; ++i)
+        {
+        ss >> this->ReadExtent[i];
+        }
+      }
+    else if (!strcmp(attName, "readDownsamplingFactor"))
+      {
+      std::stringstream ss;
+      ss << attValue;
+      int factor = 1;
+      ss >> factor;
+      this->SetReadDownsamplingFactor(factor);
+      }
     }
 
   this->EndModify(disabledModify);
@@ -100,6 +136,8 @@ void vtkMRMLNRRDStorageNode::Copy(vtkMRMLNode *anode)
   vtkMRMLNRRDStorageNode *node = (vtkMRMLNRRDStorageNode *) anode;
 
   this->SetCenterImage(node->CenterImage);
+  this->SetReadExtent(node->ReadExtent);
+  this->SetReadDownsamplingFactor(node->ReadDownsamplingFactor);
 
   this->EndModify(disabledModify);
 
@@ -110,6 +148,10 @@ void vtkMRMLNRRDStorageNode::PrintSelf(ostream& os, vtkIndent indent)
 {
   vtkMRMLStorageNode::PrintSelf(os,indent);
   os << indent << "CenterImage:   " << this->CenterImage << "\n";
+  os << indent << "ReadExtent:   " << this->ReadExtent[0] << " " << this->ReadExtent[1] << " "
+     << this->ReadExtent[2] << " " << this->ReadExtent[3] << " "
+     << this->ReadExtent[4] << " " << this->ReadExtent[5] << "\n";
+  os << indent << "ReadDownsamplingFactor:   " << this->ReadDownsamplingFactor << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -165,6 +207,8 @@ int vtkMRMLNRRDStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
     {
     reader->SetUseNativeOriginOn();
     }
+  reader->SetReadExtent(this->ReadExtent);
+  reader->SetReadDownsamplingFactor(this->ReadDownsamplingFactor);
 
   if (volNode->GetImageData())
     {
@@ -402,6 +446,13 @@ int vtkMRMLNRRDStorageNode::WriteDataInternal(vtkMRMLNode *refNode)
     vtkErrorMacro("ERROR writing NRRD file " << (writer->GetFileName() == nullptr ? "null" : writer->GetFileName()));
     writeFlag = 0;
     }
+  else
+    {
+    // The written file only contains the voxels that were loaded
+    int wholeExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    this->SetReadExtent(wholeExtent);
+    this->SetReadDownsamplingFactor(1);
+    }
 
   this->StageWriteData(refNode);
 
@@ -53,6 +53,23 @@ class VTK_MRML_EXPORT vtkMRMLNRRDStorageNode : public vtkMRMLStorageNode
   vtkGetMacro(CenterImage, int);
   vtkSetMacro(CenterImage, int);
 
+  ///
+  /// Region of the image to read, in voxel coordinates of the image in the file
+  /// (i0, i1, j0, j1, k0, k1), for example the region of a crop ROI.
+  /// If the extent is empty (default) then the whole image is read.
+  /// Uncompressed detached-header (.nhdr) files are read without loading
+  /// the voxels outside of the region.
+  /// The extent is reset after writing, as the file then contains the loaded voxels only.
+  vtkSetVector6Macro(ReadExtent, int);
+  vtkGetVector6Macro(ReadExtent, int);
+
+  ///
+  /// Only read every N-th voxel of the read region along each axis, to load
+  /// a low resolution overview of very large images. Default is 1.
+  /// The factor is reset after writing, similarly to ReadExtent.
+  vtkSetClampMacro(ReadDownsamplingFactor, int, 1, VTK_INT_MAX);
+  vtkGetMacro(ReadDownsamplingFactor, int);
+
   ///
   /// Access the nrrd header fields to create a diffusion gradient table
   int ParseDiffusionInformation(vtkTeemNRRDReader *reader,vtkDoubleArray *grad,vtkDoubleArray *bvalues);
@@ -60,6 +77,10 @@ class VTK_MRML_EXPORT vtkMRMLNRRDStorageNode : public vtkMRMLStorageNode
   /// Return true if the node can be read in.
   bool CanReadInReferenceNode(vtkMRMLNode *refNode) override;
 
+  /// Image is read and written by a NRRD reader and writer that only access the volume node
+  bool IsWriteDataThreadSafe() override { return true; };
+  bool IsReadDataThreadSafe() override { return true; };
+
   ///
   /// Configure the storage node for data exchange. This is an
   /// opportunity to optimize the storage node's settings, for
@@ -95,6 +116,8 @@ protected:
   int GetGzipCompressionLevelFromCompressionParameter(std::string parameter);
 
   int CenterImage;
+  int ReadExtent[6];
+  int ReadDownsamplingFactor;
 };
 
 #endif
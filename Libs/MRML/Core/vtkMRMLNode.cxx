@@ -907,6 +907,35 @@ void vtkMRMLNode::SetAddToSceneNoModify(int value)
    this->AddToScene = value;
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLNode::SetName(const char* _arg)
+{
+  // Mostly copied from vtkSetStringMacro() in vtkSetGet.cxx
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting Name to " << (_arg?_arg:"(null)") );
+  if ( this->Name == nullptr && _arg == nullptr) { return;}
+  if ( this->Name && _arg && (!strcmp(this->Name,_arg))) { return;}
+  char* oldName = this->Name;
+  if (_arg)
+    {
+    size_t n = strlen(_arg) + 1;
+    char *cp1 =  new char[n];
+    const char *cp2 = (_arg);
+    this->Name = cp1;
+    do { *cp1++ = *cp2++; } while ( --n );
+    }
+   else
+    {
+    this->Name = nullptr;
+    }
+  if (this->Scene)
+    {
+    // keep the scene's name index in sync
+    this->Scene->NodeNameChanged(this, oldName);
+    }
+  if (oldName) { delete [] oldName; }
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLNode::SetID (const char* _arg)
 {
@@ -1847,6 +1876,12 @@ void vtkMRMLNode::vtkMRMLNodeReference::SetReferencedNode(vtkMRMLNode* node)
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLNode::GetDataObjects(std::vector<vtkDataObject*>& vtkNotUsed(dataObjects))
+{
+  // Generic nodes do not store bulk data.
+}
+
 //----------------------------------------------------------------------------
 bool vtkMRMLNode::HasCopyContent() const
 {
@@ -21,6 +21,7 @@
 #include "vtkIdTypeArray.h"
 #include "vtkIntArray.h"
 
+class vtkDataObject;
 class vtkMRMLScene;
 class vtkStringArray;
 
@@ -245,6 +246,14 @@ public:
   /// in all parent classes by adding vtkMRMLCopyContentMacro(ClassName) to the class headers.
   virtual void CopyContent(vtkMRMLNode* node, bool deepCopy=true);
 
+  /// \brief Get the bulk data objects (images, meshes, tables, ...) stored in this node.
+  ///
+  /// Used for memory accounting (see vtkMRMLScene::GetNodesMemorySize).
+  /// Returned data objects may be shared with other nodes.
+  /// \note Subclasses that store bulk data should implement this method.
+  /// Call this method in the subclass implementation.
+  virtual void GetDataObjects(std::vector<vtkDataObject*>& dataObjects);
+
   /// \brief Copy the references of the node into this.
   ///
   /// Existing references will be replaced if found in node, or removed if not
@@ -399,8 +408,9 @@ public:
   vtkSetStringMacro(Description);
   vtkGetStringMacro(Description);
 
-  /// Name of this node, to be set by the user
-  vtkSetStringMacro(Name);
+  /// Name of this node, to be set by the user.
+  /// If the node is in a scene then the scene's node name index is updated.
+  virtual void SetName(const char* name);
   vtkGetStringMacro(Name);
 
   /// ID use by other nodes to reference this node in XML.
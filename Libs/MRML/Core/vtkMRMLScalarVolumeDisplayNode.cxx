@@ -14,32 +14,39 @@ Version:   $Revision: 1.2 $
 
 // MRML includes
 #include "vtkEventBroker.h"
+#include "vtkMRMLImageBufferPool.h"
 #include "vtkMRMLScalarVolumeDisplayNode.h"
 #include "vtkMRMLScene.h"
 #include "vtkMRMLProceduralColorNode.h"
 #include "vtkMRMLVolumeNode.h"
 
+// vtkITK includes
+#include <vtkITKImageHistogramCache.h>
+
 // VTK includes
 #include <vtkAlgorithmOutput.h>
 #include <vtkCallbackCommand.h>
 #include <vtkColorTransferFunction.h>
+#include <vtkDataArray.h>
 #include <vtkImageAppendComponents.h>
 #include <vtkImageCast.h>
 #include <vtkImageData.h>
 #include <vtkImageExtractComponents.h>
-#include <vtkImageHistogramStatistics.h>
 #include <vtkImageLogic.h>
 #include <vtkImageMapToWindowLevelColors.h>
 #include <vtkImageStencil.h>
 #include <vtkImageThreshold.h>
 #include <vtkObjectFactory.h>
 #include <vtkLookupTable.h>
+#include <vtkNew.h>
 #include <vtkPointData.h>
 #include <vtkVersion.h>
 
 
 // STD includes
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 //----------------------------------------------------------------------------
 vtkMRMLNodeNewMacro(vtkMRMLScalarVolumeDisplayNode);
@@ -58,16 +65,18 @@ vtkMRMLScalarVolumeDisplayNode::vtkMRMLScalarVolumeDisplayNode()
   //this->SetDefaultColorMap(0);
 
   // create and set visualization pipeline
-  this->AlphaLogic = vtkImageLogic::New();
-  this->MapToColors = vtkImageMapToColors::New();
-  this->Threshold = vtkImageThreshold::New();
-  this->AppendComponents = vtkImageAppendComponents::New();
-
-  this->ExtractRGB = vtkImageExtractComponents::New();
-  this->ExtractAlpha = vtkImageExtractComponents::New();
-  this->MultiplyAlpha = vtkImageStencil::New();
-
-  this->MapToWindowLevelColors = vtkImageMapToWindowLevelColors::New();
+  // Outputs of these filters have the size of the slice view, they are allocated
+  // from the buffer pool to avoid reallocating them each time the slice is updated.
+  this->AlphaLogic = vtkMRMLPooledOutputImageFilter<vtkImageLogic>::New();
+  this->MapToColors = vtkMRMLPooledOutputImageFilter<vtkImageMapToColors>::New();
+  this->Threshold = vtkMRMLPooledOutputImageFilter<vtkImageThreshold>::New();
+  this->AppendComponents = vtkMRMLPooledOutputImageFilter<vtkImageAppendComponents>::New();
+
+  this->ExtractRGB = vtkMRMLPooledOutputImageFilter<vtkImageExtractComponents>::New();
+  this->ExtractAlpha = vtkMRMLPooledOutputImageFilter<vtkImageExtractComponents>::New();
+  this->MultiplyAlpha = vtkMRMLPooledOutputImageFilter<vtkImageStencil>::New();
+
+  this->MapToWindowLevelColors = vtkMRMLPooledOutputImageFilter<vtkImageMapToWindowLevelColors>::New();
   this->MapToWindowLevelColors->SetOutputFormatToLuminance();
   this->MapToWindowLevelColors->SetWindow(256.);
   this->MapToWindowLevelColors->SetLevel(128.);
@@ -103,8 +112,9 @@ vtkMRMLScalarVolumeDisplayNode::vtkMRMLScalarVolumeDisplayNode()
   this->AppendComponents->AddInputConnection(0, this->ExtractRGB->GetOutputPort() );
   this->AppendComponents->AddInputConnection(0, this->AlphaLogic->GetOutputPort() );
 
-  this->HistogramStatistics = nullptr;
   this->IsInCalculateAutoLevels = false;
+  this->AutoLevelsCacheSize = 256;
+  this->AutoLevelsMaximumNumberOfSamples = 0;
 
   vtkEventBroker::GetInstance()->AddObservation(
     this, vtkCommand::ModifiedEvent, this, this->MRMLCallbackCommand  , 10000.);
@@ -124,11 +134,6 @@ vtkMRMLScalarVolumeDisplayNode::~vtkMRMLScalarVolumeDisplayNode()
   this->ExtractAlpha->Delete();
   this->MultiplyAlpha->Delete();
 
-  if (this->HistogramStatistics)
-    {
-    this->HistogramStatistics->Delete();
-    this->HistogramStatistics = nullptr;
-    }
 }
 
 //----------------------------------------------------------------------------
@@ -374,6 +379,8 @@ void vtkMRMLScalarVolumeDisplayNode::Copy(vtkMRMLNode *anode)
   this->SetApplyThreshold(node->GetApplyThreshold());
   this->SetThreshold(node->GetLowerThreshold(), node->GetUpperThreshold());
   this->SetInterpolate(node->Interpolate);
+  this->SetAutoLevelsMaximumNumberOfSamples(node->GetAutoLevelsMaximumNumberOfSamples());
+  this->SetAutoLevelsCacheSize(node->GetAutoLevelsCacheSize());
   for (int p = 0; p < node->GetNumberOfWindowLevelPresets(); p++)
     {
     this->AddWindowLevelPreset(node->GetWindowPreset(p), node->GetLevelPreset(p));
@@ -403,6 +410,8 @@ void vtkMRMLScalarVolumeDisplayNode::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UpperThreshold:    " << this->GetUpperThreshold() << "\n";
   os << indent << "LowerThreshold:    " << this->GetLowerThreshold() << "\n";
   os << indent << "Interpolate:       " << this->Interpolate << "\n";
+  os << indent << "AutoLevelsMaximumNumberOfSamples: " << this->AutoLevelsMaximumNumberOfSamples << "\n";
+  os << indent << "AutoLevelsCacheSize: " << this->AutoLevelsCacheSize << "\n";
 }
 
 //---------------------------------------------------------------------------
@@ -755,32 +764,51 @@ void vtkMRMLScalarVolumeDisplayNode::CalculateAutoLevels()
     return;
     }
 
-  if (this->HistogramStatistics == nullptr)
-    {
-    this->HistogramStatistics = vtkImageHistogramStatistics::New();
-
-    // Set automatic window/level to include the entire intensity range
-    // (except top/bottom 0.1%, to not let a very thin tail of the intensity
-    // distribution to decrease the image contrast too much).
-    // While in CT and sometimes in MRI, there may be a large empty area
-    // outside the reconstructed image, which could be suppressed
-    // by a larger lower percentile value, it would make the method
-    // too specific to particular imaging modalities and could lead to
-    // suboptimal results for other types of images.
-    // Therefore, we choose small, symmetric percentile values here
-    // and maybe add modality-specific methods later (e.g., for CT
-    // images we could set lower value to -1000HU).
-    this->HistogramStatistics->SetAutoRangePercentiles(0.1, 99.9);
+  this->IsInCalculateAutoLevels = true;
 
-    // Percentiles are very low (0.1%), so there is no need for
-    // range expansion.
-    this->HistogramStatistics->SetAutoRangeExpansionFactors(0.0, 0.0);
+  vtkDataArray* scalars = imageDataScalar->GetPointData()->GetScalars();
+  double intensityRange[2] = { 0.0, 0.0 };
+  std::list<AutoLevelsCacheEntry>::iterator cacheIt = this->AutoLevelsCache.begin();
+  while (cacheIt != this->AutoLevelsCache.end())
+    {
+    if (!cacheIt->Scalars)
+      {
+      // the voxel array has been deleted
+      cacheIt = this->AutoLevelsCache.erase(cacheIt);
+      continue;
+      }
+    if (cacheIt->Scalars.GetPointer() == scalars && cacheIt->ScalarsMTime == scalars->GetMTime()
+      && cacheIt->MaximumNumberOfSamples == this->AutoLevelsMaximumNumberOfSamples)
+      {
+      break;
+      }
+    ++cacheIt;
+    }
+  if (cacheIt != this->AutoLevelsCache.end())
+    {
+    intensityRange[0] = cacheIt->Range[0];
+    intensityRange[1] = cacheIt->Range[1];
+    // move to the front, as the most recently used result
+    this->AutoLevelsCache.splice(this->AutoLevelsCache.begin(), this->AutoLevelsCache, cacheIt);
+    }
+  else
+    {
+    this->ComputeAutoLevelsRange(imageDataScalar, intensityRange);
+    if (this->AutoLevelsCacheSize > 0)
+      {
+      AutoLevelsCacheEntry entry;
+      entry.Scalars = scalars;
+      entry.ScalarsMTime = scalars->GetMTime();
+      entry.MaximumNumberOfSamples = this->AutoLevelsMaximumNumberOfSamples;
+      entry.Range[0] = intensityRange[0];
+      entry.Range[1] = intensityRange[1];
+      this->AutoLevelsCache.push_front(entry);
+      }
+    while (static_cast<int>(this->AutoLevelsCache.size()) > std::max(this->AutoLevelsCacheSize, 0))
+      {
+      this->AutoLevelsCache.pop_back();
+      }
     }
-
-  this->IsInCalculateAutoLevels = true;
-  this->HistogramStatistics->SetInputData(imageDataScalar);
-  this->HistogramStatistics->Update();
-  double* intensityRange = this->HistogramStatistics->GetAutoRange();
   vtkDebugMacro("CalculateScalarAutoLevels:"
                 << " lower: " << intensityRange[0] << " upper: " << intensityRange[1]);
 
@@ -796,3 +824,25 @@ void vtkMRMLScalarVolumeDisplayNode::CalculateAutoLevels()
   this->EndModify(disabledModify);
   this->IsInCalculateAutoLevels = false;
 }
+
+//---------------------------------------------------------------------------
+void vtkMRMLScalarVolumeDisplayNode::ComputeAutoLevelsRange(vtkImageData* imageData, double range[2])
+{
+  // Set automatic window/level to include the entire intensity range
+  // (except top/bottom 0.1%, to not let a very thin tail of the intensity
+  // distribution to decrease the image contrast too much).
+  // While in CT and sometimes in MRI, there may be a large empty area
+  // outside the reconstructed image, which could be suppressed
+  // by a larger lower percentile value, it would make the method
+  // too specific to particular imaging modalities and could lead to
+  // suboptimal results for other types of images.
+  // Therefore, we choose small, symmetric percentile values here
+  // and maybe add modality-specific methods later (e.g., for CT
+  // images we could set lower value to -1000HU).
+  // The histogram is shared with other display nodes of the same volume and with
+  // threshold calculators, and it is reused until the voxels are modified.
+  if (!vtkITKImageHistogramCache::GetPercentileRange(imageData, 0.1, 99.9, this->AutoLevelsMaximumNumberOfSamples, range))
+    {
+    imageData->GetScalarRange(range);
+    }
+}
@@ -21,7 +21,6 @@
 // VTK includes
 class vtkImageAlgorithm;
 class vtkImageAppendComponents;
-class vtkImageHistogramStatistics;
 class vtkImageCast;
 class vtkImageLogic;
 class vtkImageMapToColors;
@@ -31,7 +30,11 @@ class vtkImageThreshold;
 class vtkImageExtractComponents;
 class vtkImageMathematics;
 
+// VTK includes
+#include <vtkWeakPointer.h>
+
 // STD includes
+#include <list>
 #include <vector>
 
 /// \brief MRML node for representing a volume display attributes.
@@ -185,6 +188,24 @@ class VTK_MRML_EXPORT vtkMRMLScalarVolumeDisplayNode : public vtkMRMLVolumeDispl
   /// Volume node and returns its image data scalar range.
   virtual void GetDisplayScalarRange(double range[2]);
 
+  ///
+  /// Maximum number of voxels used for computing automatic window/level and threshold.
+  /// If the image has more voxels then the histogram is estimated from a regular
+  /// grid of voxels (every n-th voxel along each axis), which makes the computation
+  /// time independent of the image size. With the default 0.1% and 99.9% percentiles
+  /// and a few million samples the error of the estimated percentiles is far below
+  /// what is visible on the display.
+  /// 0 (default) means that all voxels are used.
+  vtkSetMacro(AutoLevelsMaximumNumberOfSamples, vtkIdType);
+  vtkGetMacro(AutoLevelsMaximumNumberOfSamples, vtkIdType);
+
+  ///
+  /// Number of automatic window/level results kept in memory.
+  /// Results are reused when the same voxel array is displayed again (for example,
+  /// when replaying a sequence), so the histogram is computed only once per frame.
+  vtkSetMacro(AutoLevelsCacheSize, int);
+  vtkGetMacro(AutoLevelsCacheSize, int);
+
 protected:
   vtkMRMLScalarVolumeDisplayNode();
   ~vtkMRMLScalarVolumeDisplayNode() override;
@@ -239,10 +260,24 @@ protected:
   /// window level presets
   std::vector<WindowLevelPreset> WindowLevelPresets;
 
-  ///
-  /// Used internally in CalculateScalarAutoLevels and CalculateStatisticsAutoLevels
-  vtkImageHistogramStatistics *HistogramStatistics;
   bool IsInCalculateAutoLevels;
+
+  /// Compute the automatic intensity range of an image (using sampling if needed).
+  void ComputeAutoLevelsRange(vtkImageData* imageData, double range[2]);
+
+  ///
+  /// Cache of computed automatic intensity ranges, the most recently used first.
+  /// Results are identified by the voxel array and its modification time.
+  struct AutoLevelsCacheEntry
+  {
+    vtkWeakPointer<vtkObject> Scalars;
+    vtkMTimeType ScalarsMTime{0};
+    vtkIdType MaximumNumberOfSamples{0};
+    double Range[2]{0.0, 0.0};
+  };
+  std::list<AutoLevelsCacheEntry> AutoLevelsCache;
+  int AutoLevelsCacheSize;
+  vtkIdType AutoLevelsMaximumNumberOfSamples;
 };
 
 #endif
@@ -65,6 +65,7 @@ Version:   $Revision: 1.18 $
 #include "vtkMRMLTableViewNode.h"
 #include "vtkMRMLTextNode.h"
 #include "vtkMRMLTextStorageNode.h"
+#include "vtkMRMLTraceRecorder.h"
 #include "vtkMRMLTransformDisplayNode.h"
 #include "vtkMRMLTransformNode.h"
 #include "vtkMRMLTransformStorageNode.h"
@@ -80,16 +81,28 @@ Version:   $Revision: 1.18 $
 #include "vtkMRMLDiffusionTensorVolumeSliceDisplayNode.h"
 #include "vtkMRMLNRRDStorageNode.h"
 #include "vtkMRMLStreamingVolumeNode.h"
+#include "vtkMRMLStreamingVolumeSequenceStorageNode.h"
 #include "vtkMRMLVectorVolumeNode.h"
 #endif
 
 // VTK includes
 #include <vtkCallbackCommand.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkCollection.h>
 #include <vtkDebugLeaks.h>
+#include <vtkDoubleArray.h>
+#include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPNGWriter.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
+#include <vtkStringArray.h>
+#include <vtkTable.h>
+#include <vtkUnstructuredGrid.h>
 
 // VTKSYS includes
 #include <vtksys/RegularExpression.hxx>
@@ -99,6 +112,7 @@ Version:   $Revision: 1.18 $
 // STD includes
 #include <algorithm>
 #include <numeric>
+#include <unordered_map>
 
 //#define MRMLSCENE_VERBOSE
 
@@ -117,10 +131,15 @@ vtkMRMLScene::vtkMRMLScene()
   this->RandomGenerator.seed(std::random_device{}());
 
   this->NodeIDsMTime = 0;
+  this->NextNodeIndexOrder = 0;
+  this->NodeIndexesValid = true;
+  this->CachedUndoReferenceIDs = nullptr;
+  this->AddingNodes = false;
 
   this->Nodes = vtkCollection::New();
   this->MaximumNumberOfSavedUndoStates = 20;
   this->UndoFlag = false;
+  this->UndoBulkDataSharing = true;
 
   this->CacheManager = nullptr;
   this->DataIOManager = nullptr;
@@ -195,6 +214,7 @@ vtkMRMLScene::vtkMRMLScene()
   this->RegisterNodeClass( vtkSmartPointer< vtkMRMLNRRDStorageNode >::New() );
   this->RegisterNodeClass( vtkSmartPointer< vtkMRMLVectorVolumeNode >::New() );
   this->RegisterNodeClass( vtkSmartPointer< vtkMRMLStreamingVolumeNode >::New() );
+  this->RegisterNodeClass( vtkSmartPointer< vtkMRMLStreamingVolumeSequenceStorageNode >::New() );
 #endif
   this->RegisterNodeClass( vtkSmartPointer< vtkMRMLVectorVolumeDisplayNode >::New() );
   this->RegisterNodeClass( vtkSmartPointer< vtkMRMLDiffusionWeightedVolumeDisplayNode >::New() );
@@ -794,6 +814,7 @@ int vtkMRMLScene::Connect(vtkMRMLMessageCollection* userMessagesInput/*=nullptr*
 //------------------------------------------------------------------------------
 int vtkMRMLScene::Import(vtkMRMLMessageCollection* userMessagesInput/*=nullptr*/)
 {
+  vtkMRMLTraceScopeMacro("vtkMRMLScene::Import");
   bool wasSceneModified = this->GetModifiedSinceRead();
 
   // We use userMessages for collecting error information, so make sure we have it, even if the caller does not need it.
@@ -867,6 +888,14 @@ int vtkMRMLScene::Import(vtkMRMLMessageCollection* userMessagesInput/*=nullptr*/
 
     this->InvokeEvent(vtkMRMLScene::NewSceneEvent, nullptr);
 
+    // Read the data files concurrently, the data is copied into the nodes
+    // when UpdateScene calls ReadData.
+    std::vector<vtkWeakPointer<vtkMRMLStorageNode> > decodedStorageNodes;
+    if (this->ParallelReadData && this->ReadDataOnLoad)
+      {
+      this->DecodeStorableNodesInParallel(addedNodes, decodedStorageNodes);
+      }
+
     // Notify the imported nodes about that all nodes are created
     // (so the observers can be attached to referenced nodes, etc.)
     // by calling UpdateScene on each node
@@ -892,6 +921,14 @@ int vtkMRMLScene::Import(vtkMRMLMessageCollection* userMessagesInput/*=nullptr*/
           }
         }
       }
+    // release data that was not used (for example, if the node was not read)
+    for (vtkMRMLStorageNode* storageNode : decodedStorageNodes)
+      {
+      if (storageNode)
+        {
+        storageNode->SetDecodedNode(nullptr);
+        }
+      }
 
     this->Modified();
     this->RemoveUnusedNodeReferences();
@@ -917,6 +954,8 @@ int vtkMRMLScene::Import(vtkMRMLMessageCollection* userMessagesInput/*=nullptr*/
   importingTimer->StopTimer();
 #endif
 
+  this->CheckMemorySize();
+
 #ifdef MRMLSCENE_VERBOSE
   timer->StopTimer();
   std::cerr << "vtkMRMLScene::Import()::AddNodes:" << addNodesTimer->GetElapsedTime() << std::endl;
@@ -1031,6 +1070,7 @@ int vtkMRMLScene::LoadIntoScene(vtkCollection* nodeCollection, vtkMRMLMessageCol
 //------------------------------------------------------------------------------
 int vtkMRMLScene::Commit(const char* url, vtkMRMLMessageCollection * userMessagesInput/*=nullptr*/)
 {
+  vtkMRMLTraceScopeMacro("vtkMRMLScene::Commit");
   // We use userMessages for collecting error information, so make sure we have it, even if the caller does not need it.
   vtkSmartPointer<vtkMRMLMessageCollection> userMessages = userMessagesInput;
   if (!userMessages)
@@ -1211,6 +1251,40 @@ inline bool IsNodeWithoutName(vtkMRMLNode* node)
   return node->GetName() == nullptr || node->GetName()[0] == '\0';
 }
 
+//------------------------------------------------------------------------------
+// Insert entry into the index list of the key, keeping the list sorted in scene order.
+template <typename IndexType, typename EntryType>
+void InsertNodeIndexEntry(IndexType& index, const std::string& key, const EntryType& entry)
+{
+  typename IndexType::mapped_type& entries = index[key];
+  entries.insert(std::upper_bound(entries.begin(), entries.end(), entry), entry);
+}
+
+//------------------------------------------------------------------------------
+// Remove entry from the index list of the key. Empty lists are removed from the index.
+// Returns true if the list of the key has been removed.
+template <typename IndexType, typename EntryType>
+bool RemoveNodeIndexEntry(IndexType& index, const std::string& key, const EntryType& entry)
+{
+  typename IndexType::iterator indexIt = index.find(key);
+  if (indexIt == index.end())
+    {
+    return false;
+    }
+  typename IndexType::mapped_type& entries = indexIt->second;
+  typename IndexType::mapped_type::iterator entryIt = std::lower_bound(entries.begin(), entries.end(), entry);
+  if (entryIt != entries.end() && entryIt->Node == entry.Node)
+    {
+    entries.erase(entryIt);
+    }
+  if (!entries.empty())
+    {
+    return false;
+    }
+  index.erase(indexIt);
+  return true;
+}
+
 }
 
 //------------------------------------------------------------------------------
@@ -1302,6 +1376,7 @@ vtkMRMLNode* vtkMRMLScene::AddNodeNoNotify(vtkMRMLNode *n)
 
   // cache the node so the whole scene cache stays up-to date
   this->AddNodeID(n);
+  this->AddNodeToIndexes(n);
 
   // Keep the SH up-to-date
   if (vtkMRMLSubjectHierarchyNode::SafeDownCast(n) != nullptr &&
@@ -1340,6 +1415,10 @@ vtkMRMLNode* vtkMRMLScene::AddNode(vtkMRMLNode *n)
       << "[" << n << "]" << " already added");
     }
 #endif
+  // Nodes added by observers of events invoked by AddNodes() are not part of the
+  // batch, their events must not be ignored.
+  bool wasAddingNodes = this->AddingNodes;
+  this->AddingNodes = false;
   // We need to know if the node will be actually added to the scene before
   // it is effectively added to know if NodeAboutToBeAddedEvent needs to be
   // fired.
@@ -1379,10 +1458,83 @@ vtkMRMLNode* vtkMRMLScene::AddNode(vtkMRMLNode *n)
   std::cerr << "AddNode: " << n->GetID() << " :" << timer->GetElapsedTime() << "\n";
   timer->Delete();
 #endif
+  this->AddingNodes = wasAddingNodes;
   // If the node is a singleton, the returned node is the existing singleton
   return node;
 }
 
+//------------------------------------------------------------------------------
+int vtkMRMLScene::AddNodes(vtkCollection* nodes, vtkCollection* addedNodes/*=nullptr*/)
+{
+  if (!nodes)
+    {
+    vtkErrorMacro("AddNodes: invalid node collection");
+    return 0;
+    }
+
+  // Node IDs reserved by the undo stack are collected once for all the nodes
+  std::set<std::string> undoReferenceIDs;
+  this->GetNodeReferenceIDsFromUndoStack(undoReferenceIDs);
+  this->CachedUndoReferenceIDs = &undoReferenceIDs;
+  bool wasAddingNodes = this->AddingNodes;
+
+  vtkNew<vtkCollection> newNodes;
+  std::vector< vtkSmartPointer<vtkMRMLNode> > nodesInScene;
+  vtkObject* object = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (nodes->InitTraversal(it); (object = nodes->GetNextItemAsObject(it)) ;)
+    {
+    vtkMRMLNode* n = vtkMRMLNode::SafeDownCast(object);
+    if (!n || !n->GetAddToScene())
+      {
+      continue;
+      }
+    // if the node is a singleton that is already in the scene, then it won't be added, just replaced
+    bool add = !(n->GetSingletonTag() != nullptr && this->GetSingletonNode(n) != nullptr);
+    if (add)
+      {
+      this->AddingNodes = true;
+      this->InvokeEvent(this->NodeAboutToBeAddedEvent, n);
+      this->AddingNodes = wasAddingNodes;
+      }
+    vtkMRMLNode* node = this->AddNodeNoNotify(n);
+    if (!node)
+      {
+      continue;
+      }
+    if (add)
+      {
+      newNodes->AddItem(n);
+      this->AddingNodes = true;
+      this->InvokeEvent(this->NodeAddedEvent, n);
+      this->AddingNodes = wasAddingNodes;
+      }
+    nodesInScene.push_back(node);
+    if (addedNodes)
+      {
+      addedNodes->AddItem(node);
+      }
+    }
+  this->CachedUndoReferenceIDs = nullptr;
+
+  // Convert all node reference IDs to pointers and add observers, now that all the nodes are in the scene
+  // (only do that if not importing, because during import node IDs are not final yet).
+  if (!this->IsImporting() && !this->IsRestoring())
+    {
+    for (vtkMRMLNode* node : nodesInScene)
+      {
+      node->UpdateNodeReferences();
+      }
+    }
+
+  if (newNodes->GetNumberOfItems() > 0)
+    {
+    this->InvokeEvent(this->NodesAddedEvent, newNodes.GetPointer());
+    }
+  this->Modified();
+  return newNodes->GetNumberOfItems();
+}
+
 //------------------------------------------------------------------------------
 vtkMRMLNode* vtkMRMLScene::AddNewNodeByClass(
     std::string className, std::string nodeBaseName /* = "" */)
@@ -1519,6 +1671,7 @@ void vtkMRMLScene::RemoveNode(vtkMRMLNode *n)
 
   std::string nid = (n->GetID() ? n->GetID() : "");
   this->RemoveNodeID(n->GetID());
+  this->RemoveNodeFromIndexes(n);
 
   this->InvokeEvent(vtkMRMLScene::NodeRemovedEvent, n);
 
@@ -1699,18 +1852,8 @@ int vtkMRMLScene::GetNumberOfNodesByClass(const char *className)
     vtkErrorMacro("GetNumberOfNodesByClass: class name is null.");
     return 0;
     }
-  int num=0;
-  vtkMRMLNode *node;
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
-    {
-    if (node->IsA(className))
-      {
-      num++;
-      }
-    }
-  return num;
+  std::vector<const NodeIndexListType*> lists;
+  return this->GetNodeIndexListsByClass(className, lists);
 }
 
 //------------------------------------------------------------------------------
@@ -1722,16 +1865,9 @@ int vtkMRMLScene::GetNodesByClass(const char *className, std::vector<vtkMRMLNode
     vtkErrorMacro("GetNodesByClass: class name is null.");
     return 0;
     }
-  vtkMRMLNode *node;
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
-    {
-    if (node->IsA(className))
-      {
-      nodes.push_back(node);
-      }
-    }
+  std::vector<const NodeIndexListType*> lists;
+  this->GetNodeIndexListsByClass(className, lists);
+  vtkMRMLScene::MergeNodeIndexLists(lists, nodes);
   return static_cast<int>(nodes.size());
 }
 
@@ -1744,15 +1880,11 @@ vtkCollection* vtkMRMLScene::GetNodesByClass(const char *className)
     return nullptr;
     }
   vtkCollection* nodes = vtkCollection::New();
-  vtkMRMLNode *node;
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+  std::vector<vtkMRMLNode*> foundNodes;
+  this->GetNodesByClass(className, foundNodes);
+  for (std::vector<vtkMRMLNode*>::iterator nodeIt = foundNodes.begin(); nodeIt != foundNodes.end(); ++nodeIt)
     {
-    if (node->IsA(className))
-      {
-      nodes->AddItem(node);
-      }
+    nodes->AddItem(*nodeIt);
     }
   return nodes;
 }
@@ -1813,13 +1945,12 @@ vtkMRMLNode* vtkMRMLScene::GetSingletonNode(const char* singletonTag, const char
     return nullptr;
     }
 
-  vtkCollectionSimpleIterator it;
-  vtkMRMLNode* node = nullptr;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+  std::vector<vtkMRMLNode*> nodes;
+  this->GetNodesByClass(className, nodes);
+  for (std::vector<vtkMRMLNode*>::iterator nodeIt = nodes.begin(); nodeIt != nodes.end(); ++nodeIt)
     {
-    if (node->IsA(className) &&
-        node->GetSingletonTag() != nullptr &&
+    vtkMRMLNode* node = *nodeIt;
+    if (node->GetSingletonTag() != nullptr &&
         strcmp(node->GetSingletonTag(), singletonTag) == 0)
       {
       return node;
@@ -1889,22 +2020,32 @@ vtkMRMLNode* vtkMRMLScene::GetNthNodeByClass(int n, const char *className)
     return nullptr;
     }
 
-  int num=0;
-  vtkMRMLNode *node;
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+  std::vector<const NodeIndexListType*> lists;
+  int numberOfNodes = this->GetNodeIndexListsByClass(className, lists);
+  if (n >= numberOfNodes)
+    {
+    return nullptr;
+    }
+  if (lists.size() == 1)
+    {
+    return (*lists[0])[n].Node;
+    }
+  if (n == 0)
     {
-    if (node->IsA(className))
+    // first node: no need to merge the lists, just find the lowest order
+    const NodeIndexEntry* firstEntry = nullptr;
+    for (std::vector<const NodeIndexListType*>::iterator listIt = lists.begin(); listIt != lists.end(); ++listIt)
       {
-      if (num == n)
+      if (!firstEntry || (*listIt)->front() < *firstEntry)
         {
-        return node;
+        firstEntry = &((*listIt)->front());
         }
-      num++;
       }
+    return firstEntry->Node;
     }
-  return nullptr;
+  std::vector<vtkMRMLNode*> nodes;
+  vtkMRMLScene::MergeNodeIndexLists(lists, nodes);
+  return nodes[n];
 }
 
 //------------------------------------------------------------------------------
@@ -1924,15 +2065,15 @@ vtkCollection* vtkMRMLScene::GetNodesByName(const char* name)
     return nodes;
     }
 
-  vtkMRMLNode *node;
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+  this->UpdateNodeIndexes();
+  std::map< std::string, NodeIndexListType >::iterator indexIt = this->NodesByName.find(name);
+  if (indexIt == this->NodesByName.end())
     {
-    if (node->GetName() != nullptr && !strcmp(node->GetName(), name))
-      {
-      nodes->AddItem(node);
-      }
+    return nodes;
+    }
+  for (NodeIndexListType::iterator entryIt = indexIt->second.begin(); entryIt != indexIt->second.end(); ++entryIt)
+    {
+    nodes->AddItem(entryIt->Node);
     }
   return nodes;
 }
@@ -1943,12 +2084,26 @@ vtkMRMLNode* vtkMRMLScene::GetFirstNode(const char* byName,
                                         const int* byHideFromEditors,
                                         bool exactNameMatch)
 {
-  vtkCollectionSimpleIterator it;
-  vtkMRMLNode* node;
-  for (this->Nodes->InitTraversal(it);
-       (node= vtkMRMLNode::SafeDownCast(
-          this->Nodes->GetNextItemAsObject(it))) ;)
+  std::vector<vtkMRMLNode*> nodes;
+  if (byClass)
     {
+    // only check nodes of the requested class
+    this->GetNodesByClass(byClass, nodes);
+    }
+  else
+    {
+    vtkCollectionSimpleIterator it;
+    vtkMRMLNode* node;
+    for (this->Nodes->InitTraversal(it);
+         (node = vtkMRMLNode::SafeDownCast(
+            this->Nodes->GetNextItemAsObject(it))) ;)
+      {
+      nodes.push_back(node);
+      }
+    }
+  for (std::vector<vtkMRMLNode*>::iterator nodeIt = nodes.begin(); nodeIt != nodes.end(); ++nodeIt)
+    {
+    vtkMRMLNode* node = *nodeIt;
     if (exactNameMatch && byName &&
         node->GetName() != nullptr && strcmp(node->GetName(), byName) != 0)
       {
@@ -1959,10 +2114,6 @@ vtkMRMLNode* vtkMRMLScene::GetFirstNode(const char* byName,
       {
       continue;
       }
-    if (byClass && !node->IsA(byClass))
-      {
-      continue;
-      }
     if (byHideFromEditors && node->GetHideFromEditors() != *byHideFromEditors)
       {
       continue;
@@ -1975,23 +2126,19 @@ vtkMRMLNode* vtkMRMLScene::GetFirstNode(const char* byName,
 //------------------------------------------------------------------------------
 vtkMRMLNode* vtkMRMLScene::GetFirstNodeByName(const char* name)
 {
-  vtkMRMLNode *node = nullptr;
   if (name == nullptr)
     {
     vtkErrorMacro("GetNodesByName: name is null");
-    return node;
+    return nullptr;
     }
 
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+  this->UpdateNodeIndexes();
+  std::map< std::string, NodeIndexListType >::iterator indexIt = this->NodesByName.find(name);
+  if (indexIt == this->NodesByName.end())
     {
-    if (node->GetName() != nullptr && !strcmp(node->GetName(), name))
-      {
-      return node;
-      }
+    return nullptr;
     }
-  return nullptr;
+  return indexIt->second.front().Node;
 }
 
 //------------------------------------------------------------------------------
@@ -2011,7 +2158,7 @@ vtkMRMLNode* vtkMRMLScene::GetNodeByID(const char* id)
 
   vtkMRMLNode *node = nullptr;
   this->UpdateNodeIDs();
-  std::map< std::string, vtkSmartPointer<vtkMRMLNode> >::iterator it = this->NodeIDs.find(std::string(id));
+  NodeIDsType::iterator it = this->NodeIDs.find(std::string(id));
   if (it != this->NodeIDs.end())
     {
     node = it->second;
@@ -2051,13 +2198,17 @@ vtkCollection* vtkMRMLScene::GetNodesByClassByName(const char* className, const
     return nodes;
     }
 
-  vtkMRMLNode *node;
-  for (int n=0; n < this->Nodes->GetNumberOfItems(); n++)
+  this->UpdateNodeIndexes();
+  std::map< std::string, NodeIndexListType >::iterator indexIt = this->NodesByName.find(name);
+  if (indexIt == this->NodesByName.end())
     {
-    node = (vtkMRMLNode*)this->Nodes->GetItemAsObject(n);
-    if (node->GetName() != nullptr && !strcmp(node->GetName(), name) && node->IsA(className))
+    return nodes;
+    }
+  for (NodeIndexListType::iterator entryIt = indexIt->second.begin(); entryIt != indexIt->second.end(); ++entryIt)
+    {
+    if (entryIt->Node->IsA(className))
       {
-      nodes->AddItem(node);
+      nodes->AddItem(entryIt->Node);
       }
     }
 
@@ -2150,6 +2301,8 @@ vtkMRMLNode* vtkMRMLScene::InsertAfterNode(vtkMRMLNode *item, vtkMRMLNode *n)
     }
   // cache the node so the whole scene cache stays up-to-date
   this->AddNodeID(n);
+  // the node order key cannot be determined cheaply when inserting in the middle
+  this->InvalidateNodeIndexes();
 
   n->SetDisableModifiedEvent(modifyStatus);
 
@@ -2248,6 +2401,8 @@ vtkMRMLNode* vtkMRMLScene::InsertBeforeNode(vtkMRMLNode *item, vtkMRMLNode *n)
     }
   // cache the node so the whole scene cache stays up-todate
   this->AddNodeID(n);
+  // the node order key cannot be determined cheaply when inserting in the middle
+  this->InvalidateNodeIndexes();
 
   n->SetDisableModifiedEvent(modifyStatus);
 
@@ -2471,6 +2626,11 @@ bool vtkMRMLScene::IsNodeIDReservedByUndo(const std::string id) const
     return false;
     }
 
+  if (this->CachedUndoReferenceIDs)
+    {
+    return this->CachedUndoReferenceIDs->find(id) != this->CachedUndoReferenceIDs->end();
+    }
+
   std::set<std::string> undoReferenceIDs;
   this->GetNodeReferenceIDsFromUndoStack(undoReferenceIDs);
   if (undoReferenceIDs.find(id) != undoReferenceIDs.end())
@@ -2520,100 +2680,340 @@ void vtkMRMLScene::GetNodeReferenceIDsFromUndoStack(std::set<std::string>& refer
     }
 }
 
+namespace
+{
 //------------------------------------------------------------------------------
-std::string vtkMRMLScene::BuildID(const std::string& baseID, int idIndex)const
+// Memory buffers are used as unit of memory accounting instead of data objects because
+// shallow copies (in undo states, sequences, etc.) create new data objects that share
+// the same data arrays.
+typedef std::map<vtkObject*, unsigned long> MemoryBuffersType;
+
+//------------------------------------------------------------------------------
+void AddFieldDataMemoryBuffers(vtkFieldData* fieldData, MemoryBuffersType& buffers)
 {
-  std::stringstream ss;
-  ss << baseID;
-  // idIndex == 0 is for singleton nodes.
-  if (idIndex != 0)
+  if (!fieldData)
     {
-    ss << idIndex;
+    return;
+    }
+  for (int arrayIndex = 0; arrayIndex < fieldData->GetNumberOfArrays(); ++arrayIndex)
+    {
+    vtkAbstractArray* array = fieldData->GetAbstractArray(arrayIndex);
+    if (array)
+      {
+      buffers[array] = array->GetActualMemorySize();
+      }
     }
-  return ss.str();
 }
 
 //------------------------------------------------------------------------------
-std::string vtkMRMLScene::GenerateUniqueName(vtkMRMLNode* node)
+void AddCellArrayMemoryBuffer(vtkCellArray* cellArray, MemoryBuffersType& buffers)
 {
-  if (!node)
+  if (cellArray)
     {
-    vtkErrorMacro("vtkMRMLScene::GenerateUniqueName: input node is invalid");
-    return "";
+    buffers[cellArray] = cellArray->GetActualMemorySize();
     }
-  return this->GenerateUniqueName(node->GetNodeTagName());
 }
 
 //------------------------------------------------------------------------------
-std::string vtkMRMLScene::GenerateUniqueName(const std::string& baseName)
+// Get memory buffers of a data object with their size (in kibibytes).
+void AddDataObjectMemoryBuffers(vtkDataObject* dataObject, MemoryBuffersType& buffers)
 {
-  int uniqueNameIndex = this->GetUniqueNameIndex(baseName);
-  // Register name so it won't be available next time GetUniqueNameIndex is called
-  this->UniqueNames[baseName] = uniqueNameIndex;
-  // Create the unique name
-  return this->BuildName(baseName, uniqueNameIndex);
+  if (!dataObject)
+    {
+    return;
+    }
+  vtkDataSet* dataSet = vtkDataSet::SafeDownCast(dataObject);
+  vtkTable* table = vtkTable::SafeDownCast(dataObject);
+  if (!dataSet && !table)
+    {
+    // Composite data sets, etc. Buffers are not looked up, the data object is the buffer.
+    buffers[dataObject] = dataObject->GetActualMemorySize();
+    return;
+    }
+  AddFieldDataMemoryBuffers(dataObject->GetFieldData(), buffers);
+  if (table)
+    {
+    AddFieldDataMemoryBuffers(table->GetRowData(), buffers);
+    return;
+    }
+  AddFieldDataMemoryBuffers(dataSet->GetPointData(), buffers);
+  AddFieldDataMemoryBuffers(dataSet->GetCellData(), buffers);
+  vtkPointSet* pointSet = vtkPointSet::SafeDownCast(dataSet);
+  if (pointSet && pointSet->GetPoints() && pointSet->GetPoints()->GetData())
+    {
+    vtkDataArray* points = pointSet->GetPoints()->GetData();
+    buffers[points] = points->GetActualMemorySize();
+    }
+  vtkPolyData* polyData = vtkPolyData::SafeDownCast(dataSet);
+  if (polyData)
+    {
+    AddCellArrayMemoryBuffer(polyData->GetVerts(), buffers);
+    AddCellArrayMemoryBuffer(polyData->GetLines(), buffers);
+    AddCellArrayMemoryBuffer(polyData->GetPolys(), buffers);
+    AddCellArrayMemoryBuffer(polyData->GetStrips(), buffers);
+    }
+  vtkUnstructuredGrid* unstructuredGrid = vtkUnstructuredGrid::SafeDownCast(dataSet);
+  if (unstructuredGrid)
+    {
+    AddCellArrayMemoryBuffer(unstructuredGrid->GetCells(), buffers);
+    }
 }
 
 //------------------------------------------------------------------------------
-const char* vtkMRMLScene::GetUniqueNameByString(const char* baseName)
+void GetNodeMemoryBuffers(vtkMRMLNode* node, MemoryBuffersType& buffers)
 {
-  static std::string unsafeName;
-  unsafeName = this->GenerateUniqueName(baseName ? baseName : "Node");
-  return unsafeName.c_str();
+  std::vector<vtkDataObject*> dataObjects;
+  node->GetDataObjects(dataObjects);
+  for (vtkDataObject* dataObject : dataObjects)
+    {
+    AddDataObjectMemoryBuffers(dataObject, buffers);
+    }
 }
+} // end of anonymous namespace
 
 //------------------------------------------------------------------------------
-int vtkMRMLScene::GetUniqueNameIndex(const std::string& baseName)
+void vtkMRMLScene::ComputeMemorySize(std::vector<std::pair<vtkMRMLNode*, double>>& nodeMemorySizes,
+  double& undoRedoStacksMemorySize)
 {
-  if (baseName.empty())
+  nodeMemorySizes.clear();
+  undoRedoStacksMemorySize = 0.0;
+
+  // Memory buffers of each node and number of nodes sharing each buffer
+  std::vector<std::pair<vtkMRMLNode*, MemoryBuffersType>> nodeBuffers;
+  std::map<vtkObject*, int> numberOfOwners;
+  vtkMRMLNode* node = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (this->Nodes->InitTraversal(it); (node = vtkMRMLNode::SafeDownCast(this->Nodes->GetNextItemAsObject(it)));)
     {
-    vtkWarningMacro("vtkMRMLScene::GetUniqueNameIndex: baseName is invalid");
+    MemoryBuffersType buffers;
+    GetNodeMemoryBuffers(node, buffers);
+    if (buffers.empty())
+      {
+      continue;
+      }
+    for (const auto& buffer : buffers)
+      {
+      numberOfOwners[buffer.first]++;
+      }
+    nodeBuffers.emplace_back(node, std::move(buffers));
     }
-  int lastNameIndex = -1;
-  std::map< std::string, int>::const_iterator uNameIt =
-    this->UniqueNames.find(baseName);
-  if (uNameIt != this->UniqueNames.end())
+
+  for (const auto& nodeBuffer : nodeBuffers)
     {
-    lastNameIndex = uNameIt->second;
+    double memorySize = 0.0;
+    for (const auto& buffer : nodeBuffer.second)
+      {
+      memorySize += static_cast<double>(buffer.second) / numberOfOwners[buffer.first];
+      }
+    nodeMemorySizes.emplace_back(nodeBuffer.first, memorySize);
     }
-  bool isUnique = false;
-  int index = lastNameIndex;
-  // keep looping until you find a name that isn't yet in the scene
-  // TODO: this could be speeded up if it becomes a bottleneck
-  for (; !isUnique; )
+
+  // Undo/redo states contain the nodes of the scene that have not changed and copies
+  // of the nodes that have changed. Only count buffers that are not in the scene.
+  MemoryBuffersType undoRedoBuffers;
+  for (const std::list<vtkCollection*>* stack : { &this->UndoStack, &this->RedoStack })
     {
-    ++index;
-    std::string candidateName = this->BuildName(baseName, index);
-    isUnique = (this->GetFirstNodeByName(candidateName.c_str()) == nullptr);
+    for (vtkCollection* stateNodes : *stack)
+      {
+      for (stateNodes->InitTraversal(it); (node = vtkMRMLNode::SafeDownCast(stateNodes->GetNextItemAsObject(it)));)
+        {
+        if (this->Nodes->IsItemPresent(node))
+          {
+          continue;
+          }
+        GetNodeMemoryBuffers(node, undoRedoBuffers);
+        }
+      }
+    }
+  for (const auto& buffer : undoRedoBuffers)
+    {
+    if (numberOfOwners.find(buffer.first) == numberOfOwners.end())
+      {
+      undoRedoStacksMemorySize += buffer.second;
+      }
     }
-  return index;
 }
 
 //------------------------------------------------------------------------------
-std::string vtkMRMLScene::BuildName(const std::string& baseName, int nameIndex)const
+double vtkMRMLScene::GetNodesMemorySize(vtkStringArray* nodeIDs, vtkDoubleArray* nodeMemorySizes)
 {
-  std::stringstream name;
-  name << baseName;
-  if (nameIndex > 0)
+  std::vector<std::pair<vtkMRMLNode*, double>> memorySizes;
+  double undoRedoStacksMemorySize = 0.0;
+  this->ComputeMemorySize(memorySizes, undoRedoStacksMemorySize);
+  if (nodeIDs)
     {
-    // first name is "foo", then "foo_1", then "foo_2"
-    name << "_" << nameIndex;
+    nodeIDs->Initialize();
     }
-  return name.str();
+  if (nodeMemorySizes)
+    {
+    nodeMemorySizes->Initialize();
+    }
+  double totalMemorySize = 0.0;
+  for (const auto& memorySize : memorySizes)
+    {
+    totalMemorySize += memorySize.second;
+    if (nodeIDs)
+      {
+      nodeIDs->InsertNextValue(memorySize.first->GetID() ? memorySize.first->GetID() : "");
+      }
+    if (nodeMemorySizes)
+      {
+      nodeMemorySizes->InsertNextValue(memorySize.second);
+      }
+    }
+  return totalMemorySize;
 }
 
 //------------------------------------------------------------------------------
-bool vtkMRMLScene::IsReservedID(const std::string& id)
+double vtkMRMLScene::GetNodeMemorySize(vtkMRMLNode* node)
 {
-  return !(this->ReservedIDs.find(id) == this->ReservedIDs.end());
+  std::vector<std::pair<vtkMRMLNode*, double>> memorySizes;
+  double undoRedoStacksMemorySize = 0.0;
+  this->ComputeMemorySize(memorySizes, undoRedoStacksMemorySize);
+  for (const auto& memorySize : memorySizes)
+    {
+    if (memorySize.first == node)
+      {
+      return memorySize.second;
+      }
+    }
+  return 0.0;
 }
 
 //------------------------------------------------------------------------------
-void vtkMRMLScene::AddReservedID(const char *id)
+double vtkMRMLScene::GetUndoRedoStacksMemorySize()
 {
-  if (id == nullptr)
-    {
-    return;
+  std::vector<std::pair<vtkMRMLNode*, double>> memorySizes;
+  double undoRedoStacksMemorySize = 0.0;
+  this->ComputeMemorySize(memorySizes, undoRedoStacksMemorySize);
+  return undoRedoStacksMemorySize;
+}
+
+//------------------------------------------------------------------------------
+double vtkMRMLScene::GetMemorySize()
+{
+  std::vector<std::pair<vtkMRMLNode*, double>> memorySizes;
+  double memorySize = 0.0;
+  this->ComputeMemorySize(memorySizes, memorySize);
+  for (const auto& nodeMemorySize : memorySizes)
+    {
+    memorySize += nodeMemorySize.second;
+    }
+  return memorySize;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMRMLScene::CheckMemorySize()
+{
+  if (this->MemorySizeWarningThreshold <= 0.0)
+    {
+    return true;
+    }
+  double memorySize = this->GetMemorySize();
+  if (memorySize <= this->MemorySizeWarningThreshold)
+    {
+    return true;
+    }
+  vtkWarningMacro("CheckMemorySize: data in the scene uses " << memorySize / 1024.0
+    << " MiB of memory, which exceeds the warning threshold of " << this->MemorySizeWarningThreshold / 1024.0 << " MiB");
+  this->InvokeEvent(vtkMRMLScene::MemorySizeWarningEvent, &memorySize);
+  return false;
+}
+
+//------------------------------------------------------------------------------
+std::string vtkMRMLScene::BuildID(const std::string& baseID, int idIndex)const
+{
+  std::stringstream ss;
+  ss << baseID;
+  // idIndex == 0 is for singleton nodes.
+  if (idIndex != 0)
+    {
+    ss << idIndex;
+    }
+  return ss.str();
+}
+
+//------------------------------------------------------------------------------
+std::string vtkMRMLScene::GenerateUniqueName(vtkMRMLNode* node)
+{
+  if (!node)
+    {
+    vtkErrorMacro("vtkMRMLScene::GenerateUniqueName: input node is invalid");
+    return "";
+    }
+  return this->GenerateUniqueName(node->GetNodeTagName());
+}
+
+//------------------------------------------------------------------------------
+std::string vtkMRMLScene::GenerateUniqueName(const std::string& baseName)
+{
+  int uniqueNameIndex = this->GetUniqueNameIndex(baseName);
+  // Register name so it won't be available next time GetUniqueNameIndex is called
+  this->UniqueNames[baseName] = uniqueNameIndex;
+  // Create the unique name
+  return this->BuildName(baseName, uniqueNameIndex);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkMRMLScene::GetUniqueNameByString(const char* baseName)
+{
+  static std::string unsafeName;
+  unsafeName = this->GenerateUniqueName(baseName ? baseName : "Node");
+  return unsafeName.c_str();
+}
+
+//------------------------------------------------------------------------------
+int vtkMRMLScene::GetUniqueNameIndex(const std::string& baseName)
+{
+  if (baseName.empty())
+    {
+    vtkWarningMacro("vtkMRMLScene::GetUniqueNameIndex: baseName is invalid");
+    }
+  int lastNameIndex = -1;
+  std::map< std::string, int>::const_iterator uNameIt =
+    this->UniqueNames.find(baseName);
+  if (uNameIt != this->UniqueNames.end())
+    {
+    lastNameIndex = uNameIt->second;
+    }
+  bool isUnique = false;
+  int index = lastNameIndex;
+  // keep looping until you find a name that isn't yet in the scene
+  // TODO: this could be speeded up if it becomes a bottleneck
+  for (; !isUnique; )
+    {
+    ++index;
+    std::string candidateName = this->BuildName(baseName, index);
+    isUnique = (this->GetFirstNodeByName(candidateName.c_str()) == nullptr);
+    }
+  return index;
+}
+
+//------------------------------------------------------------------------------
+std::string vtkMRMLScene::BuildName(const std::string& baseName, int nameIndex)const
+{
+  std::stringstream name;
+  name << baseName;
+  if (nameIndex > 0)
+    {
+    // first name is "foo", then "foo_1", then "foo_2"
+    name << "_" << nameIndex;
+    }
+  return name.str();
+}
+
+//------------------------------------------------------------------------------
+bool vtkMRMLScene::IsReservedID(const std::string& id)
+{
+  return !(this->ReservedIDs.find(id) == this->ReservedIDs.end());
+}
+
+//------------------------------------------------------------------------------
+void vtkMRMLScene::AddReservedID(const char *id)
+{
+  if (id == nullptr)
+    {
+    return;
     }
   this->ReservedIDs.insert(std::string(id));
 }
@@ -2624,6 +3024,46 @@ void vtkMRMLScene::RemoveReservedIDs()
   this->ReservedIDs.clear();
 }
 
+namespace
+{
+
+//------------------------------------------------------------------------------
+// Get undo-enabled nodes of a scene or of a saved scene state, in scene order,
+// and the index of each node in this list by node ID.
+void GetUndoEnabledNodes(vtkCollection* nodes, std::vector<vtkMRMLNode*>& undoEnabledNodes,
+                         std::unordered_map<std::string, size_t>& nodeIndexByID)
+{
+  undoEnabledNodes.clear();
+  nodeIndexByID.clear();
+  if (!nodes)
+    {
+    return;
+    }
+  vtkMRMLNode* node;
+  vtkCollectionSimpleIterator it;
+  for (nodes->InitTraversal(it); (node = vtkMRMLNode::SafeDownCast(nodes->GetNextItemAsObject(it))) ;)
+    {
+    if (node->GetUndoEnabled() && node->GetID())
+      {
+      nodeIndexByID[node->GetID()] = undoEnabledNodes.size();
+      undoEnabledNodes.push_back(node);
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+vtkCollection* CreateCollection(const std::vector<vtkSmartPointer<vtkMRMLNode> >& nodes)
+{
+  vtkCollection* collection = vtkCollection::New();
+  for (const vtkSmartPointer<vtkMRMLNode>& node : nodes)
+    {
+    collection->AddItem(node);
+    }
+  return collection;
+}
+
+} // end of anonymous namespace
+
 //------------------------------------------------------------------------------
 // Pushes the current scene onto the undo stack, and makes a backup copy of the
 // passed node so that changes to the node are undoable; several signatures to handle
@@ -2652,12 +3092,13 @@ void vtkMRMLScene::SaveStateForUndo (vtkMRMLNode *node)
     }
 
   this->ClearRedoStack();
-  //this->SetUndoOn();
-  this->PushIntoUndoStack();
+  std::set<vtkMRMLNode*> nodesToCopy;
   if (node)
     {
-    this->CopyNodeInUndoStack(node);
+    nodesToCopy.insert(node);
     }
+  this->UndoStack.push_back(this->CreateUndoState(nodesToCopy));
+  this->TrimUndoStack();
 }
 
 //------------------------------------------------------------------------------
@@ -2678,17 +3119,9 @@ void vtkMRMLScene::SaveStateForUndo (std::vector<vtkMRMLNode *> nodes)
     }
 
   this->ClearRedoStack();
-  //this->SetUndoOn();
-  this->PushIntoUndoStack();
-  unsigned int n;
-  for (n=0; n<nodes.size(); n++)
-    {
-    vtkMRMLNode *node = nodes[n];
-    if (node && node->GetUndoEnabled())
-      {
-      this->CopyNodeInUndoStack(node);
-      }
-    }
+  std::set<vtkMRMLNode*> nodesToCopy(nodes.begin(), nodes.end());
+  this->UndoStack.push_back(this->CreateUndoState(nodesToCopy));
+  this->TrimUndoStack();
 }
 
 //------------------------------------------------------------------------------
@@ -2715,19 +3148,16 @@ void vtkMRMLScene::SaveStateForUndo (vtkCollection* nodes)
     }
 
   this->ClearRedoStack();
-  //this->SetUndoOn();
-  this->PushIntoUndoStack();
-
-  int nnodes = nodes->GetNumberOfItems();
-
-  for (int n=0; n<nnodes; n++)
+  std::set<vtkMRMLNode*> nodesToCopy;
+  vtkMRMLNode* node;
+  vtkCollectionSimpleIterator it;
+  for (nodes->InitTraversal(it); (node = vtkMRMLNode::SafeDownCast(nodes->GetNextItemAsObject(it))) ;)
     {
-    vtkMRMLNode *node  = vtkMRMLNode::SafeDownCast(nodes->GetItemAsObject(n));
-    if (node && node->GetUndoEnabled())
-      {
-      this->CopyNodeInUndoStack(node);
-      }
+    nodesToCopy.insert(node);
     }
+  this->UndoStack.push_back(this->CreateUndoState(nodesToCopy));
+  this->TrimUndoStack();
+  this->CheckMemorySize();
 }
 
 //------------------------------------------------------------------------------
@@ -2750,29 +3180,41 @@ void vtkMRMLScene::SaveStateForUndo ()
 
 //------------------------------------------------------------------------------
 // Make a new collection that has pointers to all the nodes in the current scene
-void vtkMRMLScene::PushIntoUndoStack()
+// (or to their saved state, for the nodes in nodesToCopy)
+vtkCollection* vtkMRMLScene::CreateUndoState(const std::set<vtkMRMLNode*>& nodesToCopy)
 {
+  vtkCollection* newScene = vtkCollection::New();
   if (this->Nodes == nullptr)
     {
-    return;
+    return newScene;
     }
-
-  vtkCollection* newScene = vtkCollection::New();
-
-  vtkCollection* currentScene = this->Nodes;
-
-  int nnodes = currentScene->GetNumberOfItems();
-
-  for (int n=0; n<nnodes; n++)
+  vtkMRMLNode* node;
+  vtkCollectionSimpleIterator it;
+  for (this->Nodes->InitTraversal(it); (node = vtkMRMLNode::SafeDownCast(this->Nodes->GetNextItemAsObject(it))) ;)
     {
-    vtkMRMLNode *node  = vtkMRMLNode::SafeDownCast(currentScene->GetItemAsObject(n));
-    if (node && node->GetUndoEnabled())
+    if (!node->GetUndoEnabled())
       {
-      newScene->AddItem(node);
+      continue;
       }
+    vtkMRMLNode* snapshot = nullptr;
+    if (nodesToCopy.find(node) != nodesToCopy.end())
+      {
+      snapshot = this->GetUndoSnapshot(node);
+      }
+    newScene->AddItem(snapshot ? snapshot : node);
     }
+  return newScene;
+}
 
-  this->UndoStack.push_back(newScene);
+//------------------------------------------------------------------------------
+// Make a new collection that has pointers to all the nodes in the current scene
+void vtkMRMLScene::PushIntoUndoStack()
+{
+  if (this->Nodes == nullptr)
+    {
+    return;
+    }
+  this->UndoStack.push_back(this->CreateUndoState(std::set<vtkMRMLNode*>()));
   this->TrimUndoStack();
 }
 
@@ -2784,23 +3226,7 @@ void vtkMRMLScene::PushIntoRedoStack()
     {
     return;
     }
-
-  vtkCollection* newScene = vtkCollection::New();
-
-  vtkCollection* currentScene = this->Nodes;
-
-  int nnodes = currentScene->GetNumberOfItems();
-
-  for (int n=0; n<nnodes; n++)
-    {
-    vtkMRMLNode *node  = vtkMRMLNode::SafeDownCast(currentScene->GetItemAsObject(n));
-    if (node && node->GetUndoEnabled())
-      {
-      newScene->AddItem(node);
-      }
-    }
-
-  this->RedoStack.push_back(newScene);
+  this->RedoStack.push_back(this->CreateUndoState(std::set<vtkMRMLNode*>()));
 }
 
 //------------------------------------------------------------------------------
@@ -2813,25 +3239,17 @@ void vtkMRMLScene::CopyNodeInUndoStack(vtkMRMLNode *copyNode)
     vtkErrorMacro("CopyNodeInUndoStack: node is null");
     return;
     }
-
-  vtkMRMLNode *snode = copyNode->CreateNodeInstance();
-  if (snode != nullptr)
+  if (this->UndoStack.empty())
     {
-    snode->CopyWithScene(copyNode);
+    return;
     }
-
   vtkCollection* undoScene = this->UndoStack.back();
-  int nnodes = undoScene->GetNumberOfItems();
-  for (int n=0; n<nnodes; n++)
+  int index = undoScene->IsItemPresent(copyNode);
+  vtkMRMLNode* snode = this->GetUndoSnapshot(copyNode);
+  if (index > 0 && snode)
     {
-    vtkMRMLNode *node  = vtkMRMLNode::SafeDownCast(undoScene->GetItemAsObject(n));
-    if (node == copyNode)
-      {
-      undoScene->ReplaceItem (n, snode);
-      break;
-      }
+    undoScene->ReplaceItem(index - 1, snode);
     }
-  snode->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -2844,23 +3262,119 @@ void vtkMRMLScene::CopyNodeInRedoStack(vtkMRMLNode *copyNode)
     vtkErrorMacro("CopyNodeInRedoStack: node is null");
     return;
     }
-  vtkMRMLNode *snode = copyNode->CreateNodeInstance();
-  if (snode != nullptr)
+  if (this->RedoStack.empty())
     {
-    snode->CopyWithScene(copyNode);
+    return;
     }
-  vtkCollection* undoScene = this->RedoStack.back();
-  int nnodes = undoScene->GetNumberOfItems();
-  for (int n=0; n<nnodes; n++)
+  vtkCollection* redoScene = this->RedoStack.back();
+  int index = redoScene->IsItemPresent(copyNode);
+  vtkMRMLNode* snode = this->GetUndoSnapshot(copyNode);
+  if (index > 0 && snode)
     {
-    vtkMRMLNode *node  = vtkMRMLNode::SafeDownCast(undoScene->GetItemAsObject(n));
-    if (node == copyNode)
-      {
-      undoScene->ReplaceItem (n, snode);
-      break;
-      }
+    redoScene->ReplaceItem(index - 1, snode);
+    }
+}
+
+//------------------------------------------------------------------------------
+vtkMRMLNode* vtkMRMLScene::GetUndoSnapshot(vtkMRMLNode* node)
+{
+  if (!node || !node->GetID())
+    {
+    vtkErrorMacro("GetUndoSnapshot: invalid node");
+    return nullptr;
+    }
+  UndoSnapshotInfo& info = this->UndoSnapshots[node->GetID()];
+  if (info.Snapshot && this->IsUndoSnapshotUpToDate(node, info.Snapshot))
+    {
+    // The node has not changed since its state was last saved, saved states
+    // are never modified, so the same copy can be shared between states.
+    return info.Snapshot;
+    }
+  vtkSmartPointer<vtkMRMLNode> snapshot = vtkSmartPointer<vtkMRMLNode>::Take(node->CreateNodeInstance());
+  if (!snapshot)
+    {
+    vtkErrorMacro("GetUndoSnapshot: failed to create copy of node " << node->GetID());
+    return nullptr;
+    }
+  this->CopyUndoSnapshot(snapshot, node);
+  info.Snapshot = snapshot;
+  info.Node = node;
+  info.NodeMTime = node->GetMTime();
+  return snapshot;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMRMLScene::IsUndoSnapshotUpToDate(vtkMRMLNode* node, vtkMRMLNode* snapshot)
+{
+  if (!node || !snapshot || !node->GetID())
+    {
+    return false;
+    }
+  std::map<std::string, UndoSnapshotInfo>::iterator infoIt = this->UndoSnapshots.find(node->GetID());
+  if (infoIt == this->UndoSnapshots.end())
+    {
+    return false;
+    }
+  const UndoSnapshotInfo& info = infoIt->second;
+  return info.Snapshot == snapshot && info.Node == node && info.NodeMTime == node->GetMTime();
+}
+
+//------------------------------------------------------------------------------
+void vtkMRMLScene::RestoreUndoSnapshot(vtkMRMLNode* node, vtkMRMLNode* snapshot)
+{
+  this->CopyUndoSnapshot(node, snapshot);
+  UndoSnapshotInfo& info = this->UndoSnapshots[node->GetID()];
+  info.Snapshot = snapshot;
+  info.Node = node;
+  info.NodeMTime = node->GetMTime();
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkMRMLNode> vtkMRMLScene::CreateNodeFromUndoState(vtkMRMLNode* node)
+{
+  if (node->GetScene() != this)
+    {
+    // a node that was removed from the scene, it can be added back as is
+    return node;
+    }
+  // Saved node states may be shared between several undo and redo states,
+  // therefore a copy is added to the scene instead of the saved state itself.
+  vtkSmartPointer<vtkMRMLNode> newNode = vtkSmartPointer<vtkMRMLNode>::Take(node->CreateNodeInstance());
+  this->CopyUndoSnapshot(newNode, node);
+  return newNode;
+}
+
+//------------------------------------------------------------------------------
+void vtkMRMLScene::CopyUndoSnapshot(vtkMRMLNode* target, vtkMRMLNode* source)
+{
+  if (!this->UndoBulkDataSharing || !source->HasCopyContent())
+    {
+    target->CopyWithScene(source);
+    return;
+    }
+  // Same as CopyWithScene but content is shallow-copied
+  MRMLNodeModifyBlocker blocker(target);
+  if (source->GetScene())
+    {
+    target->SetScene(source->GetScene());
     }
-  snode->Delete();
+  if (source->GetID())
+    {
+    target->SetID(source->GetID());
+    }
+  if (source->GetName() && strcmp(source->GetName(), ""))
+    {
+    target->SetName(source->GetName());
+    }
+  target->SetHideFromEditors(source->GetHideFromEditors());
+  target->SetAddToScene(source->GetAddToScene());
+  if (source->GetSingletonTag())
+    {
+    target->SetSingletonTag(source->GetSingletonTag());
+    }
+  target->SetUndoEnabled(source->GetUndoEnabled());
+  target->CopyContent(source, false);
+  target->CopyReferences(source);
 }
 
 //------------------------------------------------------------------------------
@@ -2881,93 +3395,66 @@ void vtkMRMLScene::Undo()
   this->StartState(vtkMRMLScene::UndoState);
   this->RemoveUnusedNodeReferences();
 
-  int nnodes;
-  int n;
-  unsigned int nn;
-
-  this->PushIntoRedoStack();
-
-  vtkCollection* currentScene = this->Nodes;
-  // We use 2 vectors instead of a map in order to keep the ordering of the
-  // nodes.
-  std::vector<std::string> currentIDs;
   std::vector<vtkMRMLNode*> currentNodes;
-  nnodes = currentScene->GetNumberOfItems();
-  for (n=0; n<nnodes; n++)
-    {
-    vtkMRMLNode *node  = vtkMRMLNode::SafeDownCast(currentScene->GetItemAsObject(n));
-    if (node && node->GetUndoEnabled())
-      {
-      currentIDs.emplace_back(node->GetID());
-      currentNodes.push_back(node);
-      }
-    }
+  std::unordered_map<std::string, size_t> currentNodeIndices;
+  GetUndoEnabledNodes(this->Nodes, currentNodes, currentNodeIndices);
 
-  vtkCollection* undoScene = nullptr;
-  std::vector<std::string> undoIDs;
+  vtkCollection* undoScene = this->UndoStack.back();
   std::vector<vtkMRMLNode*> undoNodes;
+  std::unordered_map<std::string, size_t> undoNodeIndices;
+  GetUndoEnabledNodes(undoScene, undoNodes, undoNodeIndices);
 
-  if (!this->UndoStack.empty())
-    {
-    undoScene = this->UndoStack.back();
-    nnodes = undoScene->GetNumberOfItems();
-    for (n=0; n<nnodes; n++)
-      {
-      vtkMRMLNode *node  = vtkMRMLNode::SafeDownCast(undoScene->GetItemAsObject(n));
-      if (node && node->GetUndoEnabled())
-        {
-        undoIDs.emplace_back(node->GetID());
-        undoNodes.push_back(node);
-        }
-      }
-    }
-
-  std::vector<std::string>::iterator iterID;
-  std::vector<vtkMRMLNode*>::iterator iterNode;
-  std::vector<std::string>::iterator curIterID;
-  std::vector<vtkMRMLNode*>::iterator curIterNode;
+  // The redo state refers to the current nodes, except those that are modified below.
+  std::vector<vtkSmartPointer<vtkMRMLNode> > redoNodes(currentNodes.begin(), currentNodes.end());
 
   // copy back changes and add deleted nodes to the current scene
   std::vector<vtkMRMLNode*> addNodes;
-
-  for(iterID=undoIDs.begin(), iterNode = undoNodes.begin(); iterID != undoIDs.end(); iterID++, iterNode++)
+  for (vtkMRMLNode* undoNode : undoNodes)
     {
-    curIterID = std::find(currentIDs.begin(), currentIDs.end(), *iterID);
-    curIterNode = currentNodes.begin() + std::distance(currentIDs.begin(), curIterID);
-    if ( curIterID == currentIDs.end() )
+    std::unordered_map<std::string, size_t>::iterator currentIt = currentNodeIndices.find(undoNode->GetID());
+    if (currentIt == currentNodeIndices.end())
       {
       // the node was deleted, add Node back to the current scene
-      addNodes.push_back(*iterNode);
+      addNodes.push_back(undoNode);
+      continue;
       }
-    else if (*iterNode != *curIterNode)
+    vtkMRMLNode* currentNode = currentNodes[currentIt->second];
+    if (undoNode == currentNode || this->IsUndoSnapshotUpToDate(currentNode, undoNode))
       {
-      // nodes differ, copy from undo to current scene
-      // but before create a copy in redo stack from current
-      this->CopyNodeInRedoStack(*curIterNode);
-      (*curIterNode)->CopyWithScene(*iterNode);
+      // the node has not changed since the state was saved
+      continue;
+      }
+    // nodes differ, copy from undo to current scene
+    // but before create a copy in redo stack from current
+    vtkMRMLNode* redoNode = this->GetUndoSnapshot(currentNode);
+    if (redoNode)
+      {
+      redoNodes[currentIt->second] = redoNode;
       }
+    this->RestoreUndoSnapshot(currentNode, undoNode);
     }
 
   // remove new nodes created before Undo
   std::vector<vtkMRMLNode*> removeNodes;
-  for(curIterID=currentIDs.begin(), curIterNode = currentNodes.begin(); curIterID != currentIDs.end(); curIterID++, curIterNode++)
+  for (vtkMRMLNode* currentNode : currentNodes)
     {
-    iterID = std::find(undoIDs.begin(),undoIDs.end(), *curIterID);
     // Remove only if the node is not present in the previous state.
-    if ( iterID == undoIDs.end() )
+    if (undoNodeIndices.find(currentNode->GetID()) == undoNodeIndices.end())
       {
-      removeNodes.push_back(*curIterNode);
+      removeNodes.push_back(currentNode);
       }
     }
 
-  for (nn=0; nn<addNodes.size(); nn++)
+  this->RedoStack.push_back(CreateCollection(redoNodes));
+
+  for (vtkMRMLNode* nodeToAdd : addNodes)
     {
-    this->AddNode(addNodes[nn]);
-    addNodes[nn]->SetSceneReferences();
+    vtkSmartPointer<vtkMRMLNode> restoredNode = this->CreateNodeFromUndoState(nodeToAdd);
+    this->AddNode(restoredNode);
+    restoredNode->SetSceneReferences();
     }
-  for (nn=0; nn<removeNodes.size(); nn++)
+  for (vtkMRMLNode* nodeToRemove : removeNodes)
     {
-    vtkMRMLNode* nodeToRemove = removeNodes[nn];
     // Maybe the node has been removed already by a side effect of a previous
     // node removal.
     if (this->IsNodePresent(nodeToRemove))
@@ -2976,16 +3463,9 @@ void vtkMRMLScene::Undo()
       }
     }
 
-  if (undoScene)
-    {
-    undoScene->RemoveAllItems();
-    undoScene->Delete();
-    }
-
-  if (!this->UndoStack.empty())
-   {
-   this->UndoStack.pop_back();
-   }
+  undoScene->RemoveAllItems();
+  undoScene->Delete();
+  this->UndoStack.pop_back();
   this->Modified();
 
   this->EndState(vtkMRMLScene::UndoState);
@@ -3008,109 +3488,82 @@ void vtkMRMLScene::Redo()
     return;
     }
 
-  int nnodes;
-  int n;
-  unsigned int nn;
-
   this->StartState(vtkMRMLScene::RedoState);
 
   this->RemoveUnusedNodeReferences();
 
-  this->PushIntoUndoStack();
-
-
-  vtkCollection* currentScene = this->Nodes;
-  //std::hash_map<std::string, vtkMRMLNode*> currentMap;
-  std::map<std::string, vtkWeakPointer<vtkMRMLNode> > currentMap;
-  nnodes = currentScene->GetNumberOfItems();
-  for (n=0; n<nnodes; n++)
-    {
-    vtkMRMLNode *node  = vtkMRMLNode::SafeDownCast(currentScene->GetItemAsObject(n));
-    if (node && node->GetUndoEnabled())
-      {
-      currentMap[node->GetID()] = node;
-      }
-    }
+  std::vector<vtkMRMLNode*> currentNodes;
+  std::unordered_map<std::string, size_t> currentNodeIndices;
+  GetUndoEnabledNodes(this->Nodes, currentNodes, currentNodeIndices);
 
-  //std::hash_map<std::string, vtkMRMLNode*> undoMap;
-  std::map<std::string, vtkWeakPointer<vtkMRMLNode> > undoMap;
+  vtkCollection* redoScene = this->RedoStack.back();
+  std::vector<vtkMRMLNode*> redoNodes;
+  std::unordered_map<std::string, size_t> redoNodeIndices;
+  GetUndoEnabledNodes(redoScene, redoNodes, redoNodeIndices);
 
-  vtkCollection* undoScene = nullptr;
-
-  if (!this->RedoStack.empty())
-    {
-    undoScene = this->RedoStack.back();
-    if (undoScene)
-      {
-      nnodes = undoScene->GetNumberOfItems();
-      for (n=0; n<nnodes; n++)
-        {
-        vtkMRMLNode *node = vtkMRMLNode::SafeDownCast(undoScene->GetItemAsObject(n));
-        if (node && node->GetUndoEnabled())
-          {
-          undoMap[node->GetID()] = node;
-          }
-        }
-      }
-    }
-
-  std::map<std::string, vtkWeakPointer<vtkMRMLNode> >::iterator iter;
-  std::map<std::string, vtkWeakPointer<vtkMRMLNode> >::iterator curIter;
+  // The undo state refers to the current nodes, except those that are modified or removed below.
+  std::vector<vtkSmartPointer<vtkMRMLNode> > undoNodes(currentNodes.begin(), currentNodes.end());
 
   // copy back changes and add deleted nodes to the current scene
-  std::vector<vtkWeakPointer<vtkMRMLNode> > addNodes;
-  for(iter=undoMap.begin(); iter != undoMap.end(); iter++)
+  std::vector<vtkMRMLNode*> addNodes;
+  for (vtkMRMLNode* redoNode : redoNodes)
     {
-    curIter = currentMap.find(iter->first);
-    if ( curIter == currentMap.end() )
+    std::unordered_map<std::string, size_t>::iterator currentIt = currentNodeIndices.find(redoNode->GetID());
+    if (currentIt == currentNodeIndices.end())
       {
       // the node was deleted, add Node back to the current scene
-      addNodes.push_back(iter->second);
+      addNodes.push_back(redoNode);
+      continue;
       }
-    else if (!curIter->second || !iter->second)
+    vtkMRMLNode* currentNode = currentNodes[currentIt->second];
+    if (redoNode == currentNode || this->IsUndoSnapshotUpToDate(currentNode, redoNode))
       {
       continue;
       }
-    else if (iter->second != curIter->second)
+    // nodes differ, copy from redo to current scene
+    // but before create a copy in undo stack from current
+    vtkMRMLNode* undoNode = this->GetUndoSnapshot(currentNode);
+    if (undoNode)
       {
-      // nodes differ, copy from redo to current scene
-      // but before create a copy in undo stack from current
-      this->CopyNodeInUndoStack(curIter->second);
-      curIter->second->CopyWithScene(iter->second);
+      undoNodes[currentIt->second] = undoNode;
       }
+    this->RestoreUndoSnapshot(currentNode, redoNode);
     }
 
   // remove new nodes created before Undo
   std::vector<vtkWeakPointer<vtkMRMLNode> > removeNodes;
-  for(curIter=currentMap.begin(); curIter != currentMap.end(); curIter++)
+  for (size_t index = 0; index < currentNodes.size(); ++index)
     {
-    if (!curIter->second)
+    vtkMRMLNode* currentNode = currentNodes[index];
+    if (redoNodeIndices.find(currentNode->GetID()) == redoNodeIndices.end())
       {
-      continue;
-      }
-
-    iter = undoMap.find(curIter->first);
-    if ( iter == undoMap.end() )
-      {
-      this->CopyNodeInUndoStack(curIter->second);
-      removeNodes.push_back(curIter->second);
+      vtkMRMLNode* undoNode = this->GetUndoSnapshot(currentNode);
+      if (undoNode)
+        {
+        undoNodes[index] = undoNode;
+        }
+      removeNodes.emplace_back(currentNode);
       }
     }
 
-  for (nn=0; nn<addNodes.size(); nn++)
+  this->UndoStack.push_back(CreateCollection(undoNodes));
+  this->TrimUndoStack();
+
+  for (vtkMRMLNode* nodeToAdd : addNodes)
     {
-    this->AddNode(addNodes[nn]);
+    vtkSmartPointer<vtkMRMLNode> restoredNode = this->CreateNodeFromUndoState(nodeToAdd);
+    this->AddNode(restoredNode);
     }
-  for (nn=0; nn<removeNodes.size(); nn++)
+  for (vtkMRMLNode* nodeToRemove : removeNodes)
     {
-    this->RemoveNode(removeNodes[nn]);
+    if (nodeToRemove)
+      {
+      this->RemoveNode(nodeToRemove);
+      }
     }
 
-  if (undoScene)
-    {
-    undoScene->RemoveAllItems();
-    undoScene->Delete();
-    }
+  redoScene->RemoveAllItems();
+  redoScene->Delete();
   this->RedoStack.pop_back();
   this->Modified();
 
@@ -3127,6 +3580,10 @@ void vtkMRMLScene::ClearUndoStack()
     (*iter)->Delete();
     }
   this->UndoStack.clear();
+  if (this->RedoStack.empty())
+    {
+    this->UndoSnapshots.clear();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -3139,6 +3596,10 @@ void vtkMRMLScene::ClearRedoStack()
     (*iter)->Delete();
     }
   this->RedoStack.clear();
+  if (this->UndoStack.empty())
+    {
+    this->UndoSnapshots.clear();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -3301,21 +3762,28 @@ void vtkMRMLScene::AddReferencedNodes(vtkMRMLNode *node, vtkCollection *refNodes
 
   std::deque<vtkMRMLNode*> newFoundReferencedNodes;
 
+  // NodeReferences is not sorted, collect the referenced IDs in a set
+  // so that referenced nodes are added in the order of their IDs.
+  std::set<std::string> referencedIDs;
   for (NodeReferencesType::iterator referenceIt = this->NodeReferences.begin();
     referenceIt != this->NodeReferences.end();
     ++referenceIt)
     {
-    NodeReferencesType::value_type::second_type::iterator referringNodesIt = referenceIt->second.find(node->GetID());
-    if (referringNodesIt!=referenceIt->second.end())
+    if (referenceIt->second.find(node->GetID()) != referenceIt->second.end())
       {
       // this ID is referenced by this node
-      vtkMRMLNode *referencedNode = this->GetNodeByID(referenceIt->first);
-      if (referencedNode!=nullptr && !refNodes->IsItemPresent(referencedNode))
-        {
-        // this ID is not yet in the list of reference nodes, so add it
-        refNodes->AddItem(referencedNode);
-        newFoundReferencedNodes.push_back(referencedNode);
-        }
+      referencedIDs.insert(referenceIt->first);
+      }
+    }
+
+  for (const std::string& referencedID : referencedIDs)
+    {
+    vtkMRMLNode *referencedNode = this->GetNodeByID(referencedID);
+    if (referencedNode!=nullptr && !refNodes->IsItemPresent(referencedNode))
+      {
+      // this ID is not yet in the list of reference nodes, so add it
+      refNodes->AddItem(referencedNode);
+      newFoundReferencedNodes.push_back(referencedNode);
       }
     }
 
@@ -3482,6 +3950,187 @@ void vtkMRMLScene::ClearNodeIDs()
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::UpdateNodeIndexes()
+{
+  if (this->NodeIndexesValid)
+    {
+    return;
+    }
+#ifdef MRMLSCENE_VERBOSE
+  std::cerr << "Recompute node class and name indexes..." << std::endl;
+#endif
+  this->NodesByClassName.clear();
+  this->NodesByName.clear();
+  this->NodeIndexOrders.clear();
+  this->DerivedClassNames.clear();
+  this->NextNodeIndexOrder = 0;
+  this->NodeIndexesValid = true;
+  vtkMRMLNode *node;
+  vtkCollectionSimpleIterator it;
+  for (this->Nodes->InitTraversal(it);
+       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+    {
+    this->AddNodeToIndexes(node);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::AddNodeToIndexes(vtkMRMLNode* node)
+{
+  if (!this->NodeIndexesValid || !node)
+    {
+    // indexes will be fully rebuilt at next query
+    return;
+    }
+  NodeIndexEntry entry;
+  entry.Order = this->NextNodeIndexOrder++;
+  entry.Node = node;
+  this->NodeIndexOrders[node] = entry.Order;
+
+  NodeIndexListType& classEntries = this->NodesByClassName[node->GetClassName()];
+  if (classEntries.empty())
+    {
+    // new class in the scene, derived class names have to be recomputed
+    this->DerivedClassNames.clear();
+    }
+  // the node has been added at the end of the scene, therefore it is the last in scene order
+  classEntries.push_back(entry);
+
+  if (node->GetName())
+    {
+    this->NodesByName[node->GetName()].push_back(entry);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::RemoveNodeFromIndexes(vtkMRMLNode* node)
+{
+  if (!this->NodeIndexesValid || !node)
+    {
+    return;
+    }
+  std::map< vtkMRMLNode*, vtkIdType >::iterator orderIt = this->NodeIndexOrders.find(node);
+  if (orderIt == this->NodeIndexOrders.end())
+    {
+    return;
+    }
+  NodeIndexEntry entry;
+  entry.Order = orderIt->second;
+  entry.Node = node;
+  this->NodeIndexOrders.erase(orderIt);
+
+  if (RemoveNodeIndexEntry(this->NodesByClassName, node->GetClassName(), entry))
+    {
+    // last node of this class is removed from the scene
+    this->DerivedClassNames.clear();
+    }
+  if (node->GetName())
+    {
+    RemoveNodeIndexEntry(this->NodesByName, node->GetName(), entry);
+    }
+  if (this->NodeIndexOrders.empty())
+    {
+    this->NextNodeIndexOrder = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::InvalidateNodeIndexes()
+{
+  this->NodeIndexesValid = false;
+}
+
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::NodeNameChanged(vtkMRMLNode* node, const char* oldName)
+{
+  if (!this->NodeIndexesValid || !node)
+    {
+    return;
+    }
+  std::map< vtkMRMLNode*, vtkIdType >::iterator orderIt = this->NodeIndexOrders.find(node);
+  if (orderIt == this->NodeIndexOrders.end())
+    {
+    // node is not in the scene (yet)
+    return;
+    }
+  NodeIndexEntry entry;
+  entry.Order = orderIt->second;
+  entry.Node = node;
+  if (oldName)
+    {
+    RemoveNodeIndexEntry(this->NodesByName, oldName, entry);
+    }
+  if (node->GetName())
+    {
+    InsertNodeIndexEntry(this->NodesByName, node->GetName(), entry);
+    }
+}
+
+//-----------------------------------------------------------------------------
+int vtkMRMLScene::GetNodeIndexListsByClass(const char* className, std::vector<const NodeIndexListType*>& lists)
+{
+  lists.clear();
+  this->UpdateNodeIndexes();
+
+  std::map< std::string, std::vector< std::string > >::iterator derivedIt = this->DerivedClassNames.find(className);
+  if (derivedIt == this->DerivedClassNames.end())
+    {
+    // Find all classes in the scene that are className or derived from it.
+    // All nodes in a list have the same class, so it is enough to check the first one.
+    std::vector< std::string > derivedClassNames;
+    for (std::map< std::string, NodeIndexListType >::iterator indexIt = this->NodesByClassName.begin();
+      indexIt != this->NodesByClassName.end(); ++indexIt)
+      {
+      if (!indexIt->second.empty() && indexIt->second.front().Node->IsA(className))
+        {
+        derivedClassNames.push_back(indexIt->first);
+        }
+      }
+    derivedIt = this->DerivedClassNames.insert(std::make_pair(std::string(className), derivedClassNames)).first;
+    }
+
+  int numberOfNodes = 0;
+  for (std::vector< std::string >::iterator classNameIt = derivedIt->second.begin();
+    classNameIt != derivedIt->second.end(); ++classNameIt)
+    {
+    std::map< std::string, NodeIndexListType >::iterator indexIt = this->NodesByClassName.find(*classNameIt);
+    if (indexIt == this->NodesByClassName.end() || indexIt->second.empty())
+      {
+      continue;
+      }
+    lists.push_back(&(indexIt->second));
+    numberOfNodes += static_cast<int>(indexIt->second.size());
+    }
+  return numberOfNodes;
+}
+
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::MergeNodeIndexLists(const std::vector<const NodeIndexListType*>& lists, std::vector<vtkMRMLNode*>& nodes)
+{
+  nodes.clear();
+  if (lists.size() == 1)
+    {
+    nodes.reserve(lists[0]->size());
+    for (NodeIndexListType::const_iterator entryIt = lists[0]->begin(); entryIt != lists[0]->end(); ++entryIt)
+      {
+      nodes.push_back(entryIt->Node);
+      }
+    return;
+    }
+  NodeIndexListType entries;
+  for (std::vector<const NodeIndexListType*>::const_iterator listIt = lists.begin(); listIt != lists.end(); ++listIt)
+    {
+    entries.insert(entries.end(), (*listIt)->begin(), (*listIt)->end());
+    }
+  std::sort(entries.begin(), entries.end());
+  nodes.reserve(entries.size());
+  for (NodeIndexListType::iterator entryIt = entries.begin(); entryIt != entries.end(); ++entryIt)
+    {
+    nodes.push_back(entryIt->Node);
+    }
+}
+
 //------------------------------------------------------------------------------
 void vtkMRMLScene::AddURIHandler(vtkURIHandler *handler)
 {
@@ -4234,6 +4883,11 @@ bool vtkMRMLScene::SaveSceneToSlicerDataBundleDirectory(const char* sdbDir,
 
   bool success = true;
   std::map<std::string, vtkMRMLNode *> storableNodes;
+  // Nodes that are written in parallel after all file names are determined
+  std::set<std::string> reservedFileNames;
+  std::vector<vtkMRMLStorableNode*> nodesToWriteInParallel;
+  std::set<std::string>* reservedFileNamesPtr = this->ParallelWriteData ? &reservedFileNames : nullptr;
+  std::vector<vtkMRMLStorableNode*>* nodesToWriteInParallelPtr = this->ParallelWriteData ? &nodesToWriteInParallel : nullptr;
   int numNodes = this->GetNumberOfNodes();
   for (int i = 0; i < numNodes; ++i)
     {
@@ -4249,7 +4903,8 @@ bool vtkMRMLScene::SaveSceneToSlicerDataBundleDirectory(const char* sdbDir,
       // get all storable nodes in the main scene
       // and store them in the map by ID to avoid duplicates for the scene views
       vtkMRMLStorableNode* storableNode = vtkMRMLStorableNode::SafeDownCast(mrmlNode);
-      if (!this->SaveStorableNodeToSlicerDataBundleDirectory(storableNode, dataDir, originalStorageNodeFileNames, userMessages))
+      if (!this->SaveStorableNodeToSlicerDataBundleDirectory(storableNode, dataDir, originalStorageNodeFileNames, userMessages,
+        reservedFileNamesPtr, nodesToWriteInParallelPtr))
         {
         success = false;
         }
@@ -4281,7 +4936,9 @@ bool vtkMRMLScene::SaveSceneToSlicerDataBundleDirectory(const char* sdbDir,
         userMessages->SetObservedObject(storableNode);
         storableNode->UpdateScene(this);
         userMessages->SetObservedObject(nullptr);
-        if (!this->SaveStorableNodeToSlicerDataBundleDirectory(storableNode, dataDir, originalStorageNodeFileNames, userMessages))
+        // nodes of scene views are written immediately, as they are only temporarily added to the scene
+        if (!this->SaveStorableNodeToSlicerDataBundleDirectory(storableNode, dataDir, originalStorageNodeFileNames, userMessages,
+          reservedFileNamesPtr))
           {
           success = false;
           }
@@ -4316,6 +4973,14 @@ bool vtkMRMLScene::SaveSceneToSlicerDataBundleDirectory(const char* sdbDir,
       }
     }
 
+  if (!nodesToWriteInParallel.empty())
+    {
+    if (!this->WriteStorableNodesInParallel(nodesToWriteInParallel, userMessages))
+      {
+      success = false;
+      }
+    }
+
   // write the scene to disk, changes paths to relative
   vtkDebugMacro("calling commit on the scene, to url " << this->GetURL());
   this->Commit(nullptr, userMessages);
@@ -4438,7 +5103,14 @@ void vtkMRMLScene::SaveSceneScreenshot(vtkImageData* screenshot)
 //----------------------------------------------------------------------------
 std::string vtkMRMLScene::CreateUniqueFileName(const std::string& filename, const std::string& knownExtension)
 {
-  if (!vtksys::SystemTools::FileExists(filename.c_str()))
+  return vtkMRMLScene::CreateUniqueFileName(filename, knownExtension, std::set<std::string>());
+}
+
+//----------------------------------------------------------------------------
+std::string vtkMRMLScene::CreateUniqueFileName(const std::string& filename, const std::string& knownExtension,
+  const std::set<std::string>& reservedFileNames)
+{
+  if (!vtksys::SystemTools::FileExists(filename.c_str()) && reservedFileNames.count(filename) == 0)
     {
     // filename is unique already
     return filename;
@@ -4490,7 +5162,7 @@ std::string vtkMRMLScene::CreateUniqueFileName(const std::string& filename, cons
     std::stringstream ss;
     ss << baseName << "_" << suffix << extension;
     uniqueFilename = ss.str();
-    if (!vtksys::SystemTools::FileExists(uniqueFilename))
+    if (!vtksys::SystemTools::FileExists(uniqueFilename) && reservedFileNames.count(uniqueFilename) == 0)
       {
       // found unique filename
       break;
@@ -4501,7 +5173,8 @@ std::string vtkMRMLScene::CreateUniqueFileName(const std::string& filename, cons
 
 //----------------------------------------------------------------------------
 bool vtkMRMLScene::SaveStorableNodeToSlicerDataBundleDirectory(vtkMRMLStorableNode* storableNode, std::string &dataDir,
-  std::map<vtkMRMLStorageNode*, std::vector<std::string> > &originalStorageNodeFileNames, vtkMRMLMessageCollection* userMessages)
+  std::map<vtkMRMLStorageNode*, std::vector<std::string> > &originalStorageNodeFileNames, vtkMRMLMessageCollection* userMessages,
+  std::set<std::string>* reservedFileNames/*=nullptr*/, std::vector<vtkMRMLStorableNode*>* nodesToWriteInParallel/*=nullptr*/)
 {
   if (!storableNode || !storableNode->GetSaveWithScene())
     {
@@ -4566,15 +5239,29 @@ bool vtkMRMLScene::SaveStorableNodeToSlicerDataBundleDirectory(vtkMRMLStorableNo
   // Make sure the filename is unique (default filenames may be the same if for example there are multiple
   // nodes with the same name).
   std::string existingFileName = (storageNode->GetFileName() ? storageNode->GetFileName() : "");
-  if (vtksys::SystemTools::FileExists(existingFileName, true))
+  bool fileNameReserved = (reservedFileNames && reservedFileNames->count(existingFileName) > 0);
+  if (vtksys::SystemTools::FileExists(existingFileName, true) || fileNameReserved)
     {
     std::string currentExtension = storageNode->GetSupportedFileExtension(existingFileName.c_str());
-    std::string uniqueFileName = this->CreateUniqueFileName(existingFileName, currentExtension);
+    std::string uniqueFileName = reservedFileNames
+      ? this->CreateUniqueFileName(existingFileName, currentExtension, *reservedFileNames)
+      : this->CreateUniqueFileName(existingFileName, currentExtension);
     vtkDebugMacro("file " << existingFileName << " already exists, use " << uniqueFileName << " filename instead");
     storageNode->SetFileName(uniqueFileName.c_str());
     }
+  if (reservedFileNames && storageNode->GetFileName())
+    {
+    reservedFileNames->insert(storageNode->GetFileName());
+    }
 
   storageNode->GetUserMessages()->ClearMessages();
+  if (nodesToWriteInParallel && storageNode->IsWriteDataThreadSafe()
+    && (storageNode->GetURI() == nullptr || strlen(storageNode->GetURI()) == 0))
+    {
+    // data will be written by WriteStorableNodesInParallel
+    nodesToWriteInParallel->push_back(storableNode);
+    return true;
+    }
   int success = storageNode->WriteData(storableNode);
   if (userMessages)
     {
@@ -4585,6 +5272,124 @@ bool vtkMRMLScene::SaveStorableNodeToSlicerDataBundleDirectory(vtkMRMLStorableNo
   return success;
  }
 
+//----------------------------------------------------------------------------
+bool vtkMRMLScene::WriteStorableNodesInParallel(const std::vector<vtkMRMLStorableNode*>& storableNodes,
+  vtkMRMLMessageCollection* userMessages)
+{
+  // Events must not be invoked from worker threads (observers may update the GUI),
+  // therefore modified events of the nodes are postponed until all the nodes are written.
+  std::vector<vtkMRMLStorageNode*> storageNodes;
+  std::vector<int> wasModifyingStorableNodes;
+  std::vector<int> wasModifyingStorageNodes;
+  for (vtkMRMLStorableNode* storableNode : storableNodes)
+    {
+    vtkMRMLStorageNode* storageNode = storableNode->GetStorageNode();
+    storageNodes.push_back(storageNode);
+    wasModifyingStorableNodes.push_back(storableNode->StartModify());
+    wasModifyingStorageNodes.push_back(storageNode->StartModify());
+    }
+
+  std::vector<int> writeSuccess(storableNodes.size(), 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(storableNodes.size()), 1,
+    [&](vtkIdType beginNodeIndex, vtkIdType endNodeIndex)
+    {
+    for (vtkIdType nodeIndex = beginNodeIndex; nodeIndex < endNodeIndex; ++nodeIndex)
+      {
+      writeSuccess[nodeIndex] = storageNodes[nodeIndex]->WriteData(storableNodes[nodeIndex]);
+      }
+    });
+
+  bool success = true;
+  for (size_t nodeIndex = 0; nodeIndex < storableNodes.size(); ++nodeIndex)
+    {
+    vtkMRMLStorableNode* storableNode = storableNodes[nodeIndex];
+    vtkMRMLStorageNode* storageNode = storageNodes[nodeIndex];
+    storageNode->EndModify(wasModifyingStorageNodes[nodeIndex]);
+    storableNode->EndModify(wasModifyingStorableNodes[nodeIndex]);
+    if (userMessages)
+      {
+      std::string messagePrefix = std::string(storableNode->GetName() ? storableNode->GetName() : "unknown") + " ("
+        + (storableNode->GetID() ? storableNode->GetID() : "none") + "): ";
+      userMessages->AddMessages(storageNode->GetUserMessages(), messagePrefix);
+      }
+    if (!writeSuccess[nodeIndex])
+      {
+      success = false;
+      }
+    }
+  return success;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLScene::DecodeStorableNodesInParallel(vtkCollection* nodes,
+  std::vector<vtkWeakPointer<vtkMRMLStorageNode> >& decodedStorageNodes)
+{
+  // The files are read into temporary nodes that are not in the scene,
+  // so that no events are processed by scene observers from worker threads.
+  std::vector<vtkMRMLStorageNode*> storageNodes;
+  std::vector<vtkSmartPointer<vtkMRMLStorageNode> > decodeStorageNodes;
+  std::vector<vtkSmartPointer<vtkMRMLStorableNode> > decodedNodes;
+  vtkMRMLNode* node = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (nodes->InitTraversal(it); (node = vtkMRMLNode::SafeDownCast(nodes->GetNextItemAsObject(it)));)
+    {
+    vtkMRMLStorableNode* storableNode = vtkMRMLStorableNode::SafeDownCast(node);
+    if (!storableNode || !storableNode->GetAddToScene() || !storableNode->HasCopyContent()
+      || storableNode->GetNumberOfStorageNodes() != 1)
+      {
+      continue;
+      }
+    vtkMRMLStorageNode* storageNode = storableNode->GetStorageNode();
+    if (!storageNode || !storageNode->IsReadDataThreadSafe()
+      || storageNode->GetURI() != nullptr || storageNode->GetFileName() == nullptr)
+      {
+      continue;
+      }
+    vtkSmartPointer<vtkMRMLStorageNode> decodeStorageNode = vtkSmartPointer<vtkMRMLStorageNode>::Take(
+      vtkMRMLStorageNode::SafeDownCast(storageNode->CreateNodeInstance()));
+    vtkSmartPointer<vtkMRMLStorableNode> decodedNode = vtkSmartPointer<vtkMRMLStorableNode>::Take(
+      vtkMRMLStorableNode::SafeDownCast(storableNode->CreateNodeInstance()));
+    if (!decodeStorageNode || !decodedNode)
+      {
+      continue;
+      }
+    decodeStorageNode->Copy(storageNode);
+    // Content of the node (attributes, etc.) may be used by the reader, it is usually
+    // empty before reading, so a deep copy is not expensive.
+    decodedNode->CopyContent(storableNode, /*deepCopy*/true);
+    storageNodes.push_back(storageNode);
+    decodeStorageNodes.push_back(decodeStorageNode);
+    decodedNodes.push_back(decodedNode);
+    }
+
+  std::vector<int> readSuccess(decodedNodes.size(), 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(decodedNodes.size()), 1,
+    [&](vtkIdType beginNodeIndex, vtkIdType endNodeIndex)
+    {
+    for (vtkIdType nodeIndex = beginNodeIndex; nodeIndex < endNodeIndex; ++nodeIndex)
+      {
+      try
+        {
+        readSuccess[nodeIndex] = decodeStorageNodes[nodeIndex]->ReadData(decodedNodes[nodeIndex], /*temporary*/true);
+        }
+      catch (...)
+        {
+        // the file is read again in the main thread, which reports the error
+        readSuccess[nodeIndex] = 0;
+        }
+      }
+    });
+
+  for (size_t nodeIndex = 0; nodeIndex < decodedNodes.size(); ++nodeIndex)
+    {
+    if (readSuccess[nodeIndex])
+      {
+      storageNodes[nodeIndex]->SetDecodedNode(decodedNodes[nodeIndex]);
+      decodedStorageNodes.push_back(storageNodes[nodeIndex]);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 std::string vtkMRMLScene::PercentEncode(std::string s)
 {
@@ -29,6 +29,7 @@ Version:   $Revision: 1.18 $
 #include <random>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class vtkCacheManager;
@@ -37,6 +38,8 @@ class vtkTagTable;
 
 class vtkCallbackCommand;
 class vtkCollection;
+class vtkDataObject;
+class vtkDoubleArray;
 class vtkGeneralTransform;
 class vtkImageData;
 class vtkURIHandler;
@@ -46,6 +49,7 @@ class vtkMRMLSceneViewNode;
 class vtkMRMLSubjectHierarchyNode;
 class vtkMRMLStorableNode;
 class vtkMRMLStorageNode;
+class vtkStringArray;
 
 /// \brief A set of MRML Nodes that supports serialization and undo/redo.
 ///
@@ -62,6 +66,10 @@ class VTK_MRML_EXPORT vtkMRMLScene : public vtkObject
   /// but that's the only class that is allowed to do so
   friend class vtkMRMLSceneViewNode;
 
+  /// make the vtkMRMLNode a friend so that vtkMRMLNode::SetName() can keep
+  /// the node name index up-to-date by calling NodeNameChanged()
+  friend class vtkMRMLNode;
+
 public:
   static vtkMRMLScene *New();
   vtkTypeMacro(vtkMRMLScene, vtkObject);
@@ -228,6 +236,26 @@ public:
   /// \sa AddNewNodeByClass(), CreateNodeByClass(), vtkMRMLNode::SetName(), vtkMRMLNode::SetID(), AddNode()
   vtkMRMLNode* AddNewNodeByClassWithID(std::string className, std::string nodeBaseName, std::string nodeID);
 
+  /// \brief Add a collection of nodes to the scene at once.
+  ///
+  /// Each node is added as with AddNode(), but unique IDs are reserved in a single
+  /// pass, node references are updated after all the nodes are added (therefore
+  /// nodes of the collection may reference each other in any order), and
+  /// vtkMRMLScene::NodesAddedEvent is invoked once, with the collection of added nodes
+  /// as call data.
+  /// NodeAboutToBeAddedEvent and NodeAddedEvent are still invoked for each node for
+  /// observers that do not process NodesAddedEvent. IsAddingNodes() returns true
+  /// while these events are invoked, so observers that process NodesAddedEvent can
+  /// ignore them.
+  /// If \a addedNodes is specified then the nodes that are in the scene after the
+  /// call are added to it (for singletons it is the existing singleton node).
+  /// Returns the number of nodes that were added.
+  /// \sa AddNode(), IsAddingNodes()
+  int AddNodes(vtkCollection* nodes, vtkCollection* addedNodes = nullptr);
+
+  /// Return true if nodes are being added by AddNodes().
+  bool IsAddingNodes()const { return this->AddingNodes; }
+
   /// Add a copy of a node to the scene.
   vtkMRMLNode* CopyNode(vtkMRMLNode *n);
 
@@ -520,6 +548,33 @@ public:
   vtkSetMacro(ReadDataOnLoad,int);
   vtkGetMacro(ReadDataOnLoad,int);
 
+  /// \brief This property controls whether SaveSceneToSlicerDataBundleDirectory()
+  /// writes the data of storable nodes using multiple threads.
+  ///
+  /// If enabled, data of nodes that are saved into local files by storage nodes that
+  /// support it (see vtkMRMLStorageNode::IsWriteDataThreadSafe()) is written concurrently.
+  /// Data of other nodes is written in the calling thread. The scene file is written
+  /// after all the data files. Messages of each node are added to the message collection
+  /// in the same order as in sequential writing.
+  /// Disabled by default.
+  vtkSetMacro(ParallelWriteData, bool);
+  vtkGetMacro(ParallelWriteData, bool);
+  vtkBooleanMacro(ParallelWriteData, bool);
+
+  /// \brief This property controls whether Import() reads the data of storable nodes
+  /// using multiple threads.
+  ///
+  /// If enabled, data of nodes that are read from local files by storage nodes that
+  /// support it (see vtkMRMLStorageNode::IsReadDataThreadSafe()) is read concurrently
+  /// into temporary nodes after all the nodes are added to the scene. The content
+  /// of the temporary nodes is then copied into the scene nodes in the main thread,
+  /// when nodes are updated in scene order. Files that fail to be read concurrently
+  /// are read again in the main thread so that the same errors are reported.
+  /// Disabled by default.
+  vtkSetMacro(ParallelReadData, bool);
+  vtkGetMacro(ParallelReadData, bool);
+  vtkBooleanMacro(ParallelReadData, bool);
+
   /// \brief Set the XML string to read from by Import() if
   /// GetLoadFromXMLString() is true.
   ///
@@ -677,11 +732,16 @@ public:
     NodeAboutToBeRemovedEvent,
     NodeRemovedEvent,
     NodeClassRegisteredEvent,
+    /// Invoked once by AddNodes(), call data is the vtkCollection of added nodes
+    NodesAddedEvent,
 
     NewSceneEvent = 66030,
     MetadataAddedEvent = 66032, // ### Slicer 4.5: Simplify - Do not explicitly set for backward compat. See issue #3472
     ImportProgressFeedbackEvent,
     SaveProgressFeedbackEvent,
+    /// Invoked by CheckMemorySize() if the memory size exceeds MemorySizeWarningThreshold,
+    /// call data is a pointer to the memory size (double, in kibibytes)
+    MemorySizeWarningEvent,
 
     /// \internal
     /// not to be used directly
@@ -783,6 +843,53 @@ public:
   void SetMaximumNumberOfSavedUndoStates(int stackSize);
   vtkGetMacro(MaximumNumberOfSavedUndoStates, int);
 
+  /// \brief Share bulk data (such as image or mesh data) between nodes and their undo states.
+  ///
+  /// If enabled (default), undo and redo states of nodes that support CopyContent()
+  /// are created by shallow copy, so bulk data is shared by reference instead of being
+  /// duplicated at each saved state. Bulk data of undoable nodes must then be replaced
+  /// (not modified in place) to keep the previously saved states intact.
+  /// If disabled, each saved node state is an independent deep copy.
+  vtkSetMacro(UndoBulkDataSharing, bool);
+  vtkGetMacro(UndoBulkDataSharing, bool);
+  vtkBooleanMacro(UndoBulkDataSharing, bool);
+
+  /// \brief Get memory size (in kibibytes) of bulk data stored in the nodes of the scene.
+  ///
+  /// Memory is accounted at the level of data buffers (data arrays, cell arrays) that nodes
+  /// report in vtkMRMLNode::GetDataObjects(). A buffer that is shared by several nodes is
+  /// only counted once and its size is split evenly between the nodes, therefore the sum of
+  /// the node sizes is the total. Data stored in undo/redo stacks is not included.
+  /// \param nodeIDs If not nullptr then it is set to the IDs of the nodes that store bulk data.
+  /// \param nodeMemorySizes If not nullptr then it is set to the memory size of each node in nodeIDs.
+  /// \return Total memory size of the nodes.
+  /// \sa GetUndoRedoStacksMemorySize(), GetMemorySize()
+  double GetNodesMemorySize(vtkStringArray* nodeIDs = nullptr, vtkDoubleArray* nodeMemorySizes = nullptr);
+
+  /// \brief Get memory size (in kibibytes) attributed to a node of the scene.
+  /// \sa GetNodesMemorySize()
+  double GetNodeMemorySize(vtkMRMLNode* node);
+
+  /// \brief Get memory size (in kibibytes) of bulk data that is only referenced by the undo and redo stacks.
+  /// Data that the undo/redo states share with nodes in the scene is not included.
+  double GetUndoRedoStacksMemorySize();
+
+  /// \brief Get total memory size (in kibibytes) of bulk data in nodes and undo/redo stacks.
+  double GetMemorySize();
+
+  /// \brief Memory size (in kibibytes) above which CheckMemorySize() reports a warning.
+  ///
+  /// If non-zero, the memory size is checked after importing a scene and after saving an undo state.
+  /// 0 means no limit (default).
+  vtkSetMacro(MemorySizeWarningThreshold, double);
+  vtkGetMacro(MemorySizeWarningThreshold, double);
+
+  /// \brief Check if the memory size exceeds MemorySizeWarningThreshold.
+  ///
+  /// If the threshold is exceeded then a warning is logged and MemorySizeWarningEvent is invoked.
+  /// \return false if the threshold is exceeded.
+  bool CheckMemorySize();
+
   /// \brief Write the scene to a MRML scene bundle (.mrb) file.
   /// If thumbnail image is provided then it is saved in the scene's root folder.
   /// If userMessages is not nullptr then the method may add messages to it about issues
@@ -830,9 +937,16 @@ public:
   /// could be gz, nii.gz, or file.nii.gz and only one of them is correct).
   static std::string CreateUniqueFileName(const std::string& filename, const std::string& knownExtension = "");
 
+  /// Create a unique file name, considering file names in reservedFileNames as existing files.
+  /// It is useful when multiple files will be written later (for example, in parallel).
+  static std::string CreateUniqueFileName(const std::string& filename, const std::string& knownExtension,
+    const std::set<std::string>& reservedFileNames);
+
 protected:
 
-  typedef std::map< std::string, std::set<std::string> > NodeReferencesType;
+  /// Referenced IDs are hashed as they are looked up for every reference
+  /// that is added, updated or removed, during scene import and undo.
+  typedef std::unordered_map< std::string, std::set<std::string> > NodeReferencesType;
 
   vtkMRMLScene();
   ~vtkMRMLScene() override;
@@ -843,6 +957,32 @@ protected:
   void CopyNodeInUndoStack(vtkMRMLNode *node);
   void CopyNodeInRedoStack(vtkMRMLNode *node);
 
+  /// Create a collection containing all the undo-enabled nodes of the scene.
+  /// Nodes found in \a nodesToCopy are replaced by their saved state (see GetUndoSnapshot()).
+  vtkCollection* CreateUndoState(const std::set<vtkMRMLNode*>& nodesToCopy);
+
+  /// \brief Get a copy of the node that can be stored in the undo or redo stack.
+  ///
+  /// The saved state of a node is never modified, therefore the copy made
+  /// at the last call is returned if the node has not been modified since.
+  /// This way only the nodes that changed between two saved states are copied.
+  vtkMRMLNode* GetUndoSnapshot(vtkMRMLNode* node);
+
+  /// Returns true if the node has not been modified since \a snapshot was
+  /// taken from it or was restored into it.
+  bool IsUndoSnapshotUpToDate(vtkMRMLNode* node, vtkMRMLNode* snapshot);
+
+  /// Copy \a snapshot content into the scene node \a node and remember that they are identical.
+  void RestoreUndoSnapshot(vtkMRMLNode* node, vtkMRMLNode* snapshot);
+
+  /// Get the node to add to the scene when a node that was removed is restored from
+  /// an undo or redo state. Saved node states are copied, as they may be shared between states.
+  vtkSmartPointer<vtkMRMLNode> CreateNodeFromUndoState(vtkMRMLNode* node);
+
+  /// Copy everything (including Scene and ID) from \a source to \a target.
+  /// Bulk data is shallow-copied if UndoBulkDataSharing is enabled.
+  void CopyUndoSnapshot(vtkMRMLNode* target, vtkMRMLNode* source);
+
   /// Add a node to the scene without invoking a vtkMRMLScene::NodeAddedEvent event.
   ///
   /// \warning Use with extreme caution as it might unsynchronize observer.
@@ -890,12 +1030,57 @@ protected:
   /// Clear NodeIDs map used to speedup GetByID() method.
   void ClearNodeIDs();
 
+  /// \brief Entry of the class and name indexes.
+  ///
+  /// Order is a key that increases with the position of the node in the
+  /// \a Nodes collection, so that index lists can be kept sorted in scene order.
+  struct NodeIndexEntry
+    {
+    vtkIdType Order;
+    vtkMRMLNode* Node;
+    bool operator<(const NodeIndexEntry& other) const { return this->Order < other.Order; }
+    };
+  typedef std::vector< NodeIndexEntry > NodeIndexListType;
+
+  /// \brief Rebuild the class and name indexes from the \a Nodes collection
+  /// if they are not valid anymore.
+  ///
+  /// The indexes are used to speedup GetNodesByClass(), GetNodesByName(),
+  /// and related methods.
+  void UpdateNodeIndexes();
+
+  /// Add node to the class and name indexes.
+  /// The node must have been appended to the end of the \a Nodes collection.
+  void AddNodeToIndexes(vtkMRMLNode* node);
+
+  /// Remove node from the class and name indexes.
+  void RemoveNodeFromIndexes(vtkMRMLNode* node);
+
+  /// Invalidate the class and name indexes. They will be rebuilt at next query.
+  /// Must be called when nodes are inserted into the \a Nodes collection at
+  /// any other position than the end.
+  void InvalidateNodeIndexes();
+
+  /// Called by vtkMRMLNode::SetName() to update the name index.
+  void NodeNameChanged(vtkMRMLNode* node, const char* oldName);
+
+  /// Get index lists of all node classes that are \a className or derived from it.
+  /// Returns the number of nodes in the lists.
+  int GetNodeIndexListsByClass(const char* className, std::vector<const NodeIndexListType*>& lists);
+
+  /// Get the nodes of all the lists sorted in scene order.
+  static void MergeNodeIndexLists(const std::vector<const NodeIndexListType*>& lists, std::vector<vtkMRMLNode*>& nodes);
+
   /// Get a NodeReferences iterator for a node reference.
   NodeReferencesType::iterator FindNodeReference(const char* referencedId, vtkMRMLNode* referencingNode);
 
   /// Clean up elements of the undo/redo stack beyond the maximum size
   void TrimUndoStack();
 
+  /// Compute memory size (in kibibytes) of each node and of the data that is only in undo/redo stacks.
+  /// \sa GetNodesMemorySize()
+  void ComputeMemorySize(std::vector<std::pair<vtkMRMLNode*, double>>& nodeMemorySizes, double& undoRedoStacksMemorySize);
+
   /// Reserve all node reference ids for a node
   void ReserveNodeReferenceIDs(vtkMRMLNode* node);
 
@@ -911,8 +1096,25 @@ protected:
   /// Returns true on success (written successfully or no need to write the node).
   /// If userMessages is not nullptr then the method may add messages to it about issues
   /// encountered during the operation.
+  /// \param reservedFileNames If not nullptr then file names in this set are considered as existing files
+  ///   and the file name of this node is added to the set.
+  /// \param nodesToWriteInParallel If not nullptr and the storage node can write data from a worker thread then
+  ///   the node is only prepared for writing and added to nodesToWriteInParallel (see WriteStorableNodesInParallel).
   bool SaveStorableNodeToSlicerDataBundleDirectory(vtkMRMLStorableNode* storableNode, std::string& dataDir,
-    std::map<vtkMRMLStorageNode*, std::vector<std::string> > &originalStorageNodeFileNames, vtkMRMLMessageCollection* userMessages);
+    std::map<vtkMRMLStorageNode*, std::vector<std::string> > &originalStorageNodeFileNames, vtkMRMLMessageCollection* userMessages,
+    std::set<std::string>* reservedFileNames = nullptr, std::vector<vtkMRMLStorableNode*>* nodesToWriteInParallel = nullptr);
+
+  /// Write data of the storable nodes using their storage nodes concurrently.
+  /// Modified events of the nodes are postponed until all nodes are written.
+  /// \return True if all the nodes were written successfully.
+  bool WriteStorableNodesInParallel(const std::vector<vtkMRMLStorableNode*>& storableNodes, vtkMRMLMessageCollection* userMessages);
+
+  /// Read data of the storable nodes in the collection concurrently into temporary nodes,
+  /// and set them as decoded nodes in the storage nodes (see vtkMRMLStorageNode::SetDecodedNode).
+  /// Only nodes that have a single storage node that reads a local file from a worker thread are read.
+  /// \param decodedStorageNodes Storage nodes that received a decoded node.
+  void DecodeStorableNodesInParallel(vtkCollection* nodes,
+    std::vector<vtkWeakPointer<vtkMRMLStorageNode> >& decodedStorageNodes);
 
   vtkCollection*  Nodes;
 
@@ -933,10 +1135,26 @@ protected:
   std::list< vtkCollection* >  UndoStack;
   std::list< vtkCollection* >  RedoStack;
 
+  /// Last saved state of each undo-enabled node (indexed by node ID) and the
+  /// modification time of the node when the state was saved or restored.
+  struct UndoSnapshotInfo
+    {
+    vtkSmartPointer<vtkMRMLNode> Snapshot;
+    vtkWeakPointer<vtkMRMLNode> Node;
+    vtkMTimeType NodeMTime{0};
+    };
+  std::map< std::string, UndoSnapshotInfo > UndoSnapshots;
+  bool UndoBulkDataSharing;
+  double MemorySizeWarningThreshold{0.0};
+
   std::string                 URL;
   std::string                 RootDirectory;
 
   std::map<std::string, int> UniqueIDs;
+  /// Node IDs referenced in the undo stack, only set while AddNodes() is in progress
+  /// to avoid traversing the undo stack for each generated ID.
+  std::set<std::string>* CachedUndoReferenceIDs;
+  bool AddingNodes;
   std::map<std::string, int> UniqueNames;
   std::set<std::string>   ReservedIDs;
 
@@ -946,7 +1164,20 @@ protected:
 
   NodeReferencesType NodeReferences; // ReferencedIDs (string), ReferencingNodes (node pointer)
   std::map< std::string, std::string > ReferencedIDChanges;
-  std::map< std::string, vtkSmartPointer<vtkMRMLNode> > NodeIDs;
+  typedef std::unordered_map< std::string, vtkSmartPointer<vtkMRMLNode> > NodeIDsType;
+  NodeIDsType NodeIDs;
+
+  /// Index of nodes by class name (as returned by GetClassName()), sorted in scene order.
+  std::map< std::string, NodeIndexListType > NodesByClassName;
+  /// Index of nodes by node name, sorted in scene order.
+  std::map< std::string, NodeIndexListType > NodesByName;
+  /// Order key of each indexed node.
+  std::map< vtkMRMLNode*, vtkIdType > NodeIndexOrders;
+  /// Cache of class names found in NodesByClassName that are a given class or
+  /// derived from it. Cleared when a class appears in or disappears from the scene.
+  std::map< std::string, std::vector< std::string > > DerivedClassNames;
+  vtkIdType NextNodeIndexOrder;
+  bool NodeIndexesValid;
 
   // Stores default nodes. If a class is created or reset (using CreateNodeByClass or Clear) and
   // a default node is defined for it then the content of the default node will be used to initialize
@@ -961,6 +1192,9 @@ protected:
 
   int ReadDataOnLoad;
 
+  bool ParallelWriteData{false};
+  bool ParallelReadData{false};
+
   vtkMTimeType  NodeIDsMTime;
 
   void RemoveAllNodes(bool removeSingletons);
@@ -29,6 +29,7 @@ Version:   $Revision: 1.14 $
 #include <vtkSmartPointer.h>
 
 // STD includes
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <stack>
@@ -45,6 +46,7 @@ vtkMRMLSceneViewNode::vtkMRMLSceneViewNode()
 //  this->ScreenShot = vtkImageData::New();
   this->ScreenShot = nullptr;
   this->ScreenShotType = 0;
+  this->BulkDataSharing = true;
 }
 
 //----------------------------------------------------------------------------
@@ -73,6 +75,48 @@ void vtkMRMLSceneViewNode::WriteXML(ostream& of, int nIndent)
   vtksys::SystemTools::ReplaceString(description,"\n","<br>");
 
   of << " sceneViewDescription=\"" << this->XMLAttributeEncodeString(description) << "\"";
+
+  // Stored nodes that are the same as in the scene are only referenced by their ID
+  this->AddNodesSameAsScene();
+  if (this->SnapshotScene && this->GetScene())
+    {
+    // first make sure that the scene view scene is to be saved relative to the same place as the main scene
+    this->SnapshotScene->SetRootDirectory(this->GetScene()->GetRootDirectory());
+    this->SetAbsentStorageFileNames();
+    for (int n=0; n < this->SnapshotScene->GetNodes()->GetNumberOfItems(); n++)
+      {
+      vtkMRMLNode* node = (vtkMRMLNode*)this->SnapshotScene->GetNodes()->GetItemAsObject(n);
+      if (!node || !node->GetID() || node->IsA("vtkMRMLSceneViewNode") || !node->GetSaveWithScene())
+        {
+        continue;
+        }
+      vtkMRMLNode* sceneNode = this->GetScene()->GetNodeByID(node->GetID());
+      if (!sceneNode || !sceneNode->GetSaveWithScene() || !this->IncludeNodeInSceneView(sceneNode)
+        || strcmp(sceneNode->GetClassName(), node->GetClassName()))
+        {
+        continue;
+        }
+      std::stringstream nodeXML;
+      node->WriteXML(nodeXML, 0);
+      node->WriteNodeBodyXML(nodeXML, 0);
+      std::stringstream sceneNodeXML;
+      sceneNode->WriteXML(sceneNodeXML, 0);
+      sceneNode->WriteNodeBodyXML(sceneNodeXML, 0);
+      if (nodeXML.str() == sceneNodeXML.str())
+        {
+        this->NodeIDsSameAsScene.push_back(node->GetID());
+        }
+      }
+    }
+  if (!this->NodeIDsSameAsScene.empty())
+    {
+    std::stringstream ss;
+    for (std::vector<std::string>::iterator it = this->NodeIDsSameAsScene.begin(); it != this->NodeIDsSameAsScene.end(); ++it)
+      {
+      ss << (it == this->NodeIDsSameAsScene.begin() ? "" : " ") << *it;
+      }
+    of << " nodeIDsSameAsScene=\"" << this->XMLAttributeEncodeString(ss.str()) << "\"";
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -90,6 +134,12 @@ void vtkMRMLSceneViewNode::WriteNodeBodyXML(ostream& of, int nIndent)
   for (int n=0; n < this->SnapshotScene->GetNodes()->GetNumberOfItems(); n++)
     {
     vtkMRMLNode* node = (vtkMRMLNode*)this->SnapshotScene->GetNodes()->GetItemAsObject(n);
+    if (node && node->GetID() && std::find(this->NodeIDsSameAsScene.begin(), this->NodeIDsSameAsScene.end(),
+      std::string(node->GetID())) != this->NodeIDsSameAsScene.end())
+      {
+      // written in nodeIDsSameAsScene attribute
+      continue;
+      }
     if (node && !node->IsA("vtkMRMLSceneViewNode") && node->GetSaveWithScene())
       {
       vtkIndent vindent(nIndent+1);
@@ -102,7 +152,8 @@ void vtkMRMLSceneViewNode::WriteNodeBodyXML(ostream& of, int nIndent)
       of << "</" << node->GetNodeTagName() << ">\n";
       }
     }
-
+  // the nodes are all in the stored scene
+  this->NodeIDsSameAsScene.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -134,6 +185,17 @@ void vtkMRMLSceneViewNode::ReadXMLAttributes(const char** atts)
       vtksys::SystemTools::ReplaceString(sceneViewDescription,"[br]","\n");
       this->SetSceneViewDescription(sceneViewDescription);
       }
+    else if (!strcmp(attName, "nodeIDsSameAsScene"))
+      {
+      this->NodeIDsSameAsScene.clear();
+      std::stringstream ss;
+      ss << attValue;
+      std::string nodeID;
+      while (ss >> nodeID)
+        {
+        this->NodeIDsSameAsScene.push_back(nodeID);
+        }
+      }
     }
 
   // for backward compatibility:
@@ -235,6 +297,10 @@ void vtkMRMLSceneViewNode::Copy(vtkMRMLNode *anode)
   this->SetScreenShotType(vtkMRMLSceneViewNode::SafeDownCast(anode)->GetScreenShotType());
   this->SetSceneViewDescription(vtkMRMLSceneViewNode::SafeDownCast(anode)->GetSceneViewDescription());
 
+  this->SetBulkDataSharing(snode->GetBulkDataSharing());
+  this->SynchronizedNodeMTimes.clear();
+  snode->AddNodesSameAsScene();
+
   if (this->SnapshotScene == nullptr)
     {
     this->SnapshotScene = vtkMRMLScene::New();
@@ -264,6 +330,7 @@ void vtkMRMLSceneViewNode::Copy(vtkMRMLNode *anode)
 void vtkMRMLSceneViewNode::PrintSelf(ostream& os, vtkIndent indent)
 {
   Superclass::PrintSelf(os,indent);
+  os << indent << "BulkDataSharing: " << (this->BulkDataSharing ? "true" : "false") << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -276,6 +343,15 @@ void vtkMRMLSceneViewNode::UpdateScene(vtkMRMLScene *scene)
     {
     return;
     }
+  // The node IDs may have changed when the scene was imported
+  for (std::string& nodeID : this->NodeIDsSameAsScene)
+    {
+    const char* sceneNodeID = scene->GetChangedID(nodeID.c_str());
+    if (sceneNodeID)
+      {
+      nodeID = sceneNodeID;
+      }
+    }
   if (this->SnapshotScene)
     {
     // node references are in (this->SavedScene) already, so they should not be modified
@@ -346,6 +422,7 @@ void vtkMRMLSceneViewNode::StoreScene()
     return;
     }
 
+  this->NodeIDsSameAsScene.clear();
   if (this->SnapshotScene == nullptr)
     {
     this->SnapshotScene = vtkMRMLScene::New();
@@ -398,27 +475,111 @@ void vtkMRMLSceneViewNode::StoreScene()
     if (this->IncludeNodeInSceneView(node) &&
         node->GetSaveWithScene() )
       {
-      vtkSmartPointer<vtkMRMLNode> newNode = vtkSmartPointer<vtkMRMLNode>::Take(node->CreateNodeInstance());
+      this->AddNodeToStoredScene(node);
+      }
+    }
+  this->SnapshotScene->CopyNodeReferences(this->GetScene());
+  this->SnapshotScene->CopyNodeChangedIDs(this->GetScene());
+  this->SynchronizedNodeMTimes.clear();
+  this->UpdateSynchronizedNodeMTimes();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSceneViewNode::CopyNodeState(vtkMRMLNode* target, vtkMRMLNode* source)
+{
+  if (!this->BulkDataSharing || !source->HasCopyContent())
+    {
+    target->Copy(source);
+    return;
+    }
+  // Same as Copy but content is shallow-copied
+  if (source->GetName() && strcmp(source->GetName(), ""))
+    {
+    target->SetName(source->GetName());
+    }
+  target->SetHideFromEditors(source->GetHideFromEditors());
+  target->SetAddToScene(source->GetAddToScene());
+  if (source->GetSingletonTag())
+    {
+    target->SetSingletonTag(source->GetSingletonTag());
+    }
+  target->SetUndoEnabled(source->GetUndoEnabled());
+  target->CopyContent(source, false);
+  target->CopyReferences(source);
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSceneViewNode::AddNodeToStoredScene(vtkMRMLNode* node)
+{
+  vtkSmartPointer<vtkMRMLNode> newNode = vtkSmartPointer<vtkMRMLNode>::Take(node->CreateNodeInstance());
 
-      newNode->SetScene(this->SnapshotScene);
+  newNode->SetScene(this->SnapshotScene);
 
-      int oldMode = newNode->GetDisableModifiedEvent();
-      newNode->DisableModifiedEventOn();
-      newNode->Copy(node);
-      newNode->SetDisableModifiedEvent(oldMode);
+  int oldMode = newNode->GetDisableModifiedEvent();
+  newNode->DisableModifiedEventOn();
+  this->CopyNodeState(newNode, node);
+  newNode->SetDisableModifiedEvent(oldMode);
 
-      newNode->SetID(node->GetID());
+  newNode->SetID(node->GetID());
 
-      newNode->SetAddToSceneNoModify(1);
-      this->SnapshotScene->AddNode(newNode);
-      newNode->SetAddToSceneNoModify(0);
+  newNode->SetAddToSceneNoModify(1);
+  this->SnapshotScene->AddNode(newNode);
+  newNode->SetAddToSceneNoModify(0);
 
-      // sanity check
-      assert(newNode->GetScene() == this->SnapshotScene);
+  // sanity check
+  assert(newNode->GetScene() == this->SnapshotScene);
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSceneViewNode::AddNodesSameAsScene()
+{
+  if (this->NodeIDsSameAsScene.empty() || !this->Scene)
+    {
+    return;
+    }
+  if (this->SnapshotScene == nullptr)
+    {
+    this->SnapshotScene = vtkMRMLScene::New();
+    }
+  // Nodes are copied only when the stored scene is used, so that scene nodes
+  // have already read their data.
+  for (const std::string& nodeID : this->NodeIDsSameAsScene)
+    {
+    vtkMRMLNode* sceneNode = this->Scene->GetNodeByID(nodeID);
+    if (!sceneNode)
+      {
+      vtkWarningMacro("AddNodesSameAsScene: node " << nodeID << " of scene view "
+        << (this->GetName() ? this->GetName() : "") << " is not found in the scene");
+      continue;
+      }
+    if (!this->SnapshotScene->GetNodeByID(nodeID))
+      {
+      this->AddNodeToStoredScene(sceneNode);
+      }
+    }
+  this->NodeIDsSameAsScene.clear();
+  this->SnapshotScene->UpdateNodeReferences();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSceneViewNode::UpdateSynchronizedNodeMTimes()
+{
+  if (!this->Scene || !this->SnapshotScene)
+    {
+    return;
+    }
+  vtkCollectionSimpleIterator it;
+  vtkCollection* snapshotNodes = this->SnapshotScene->GetNodes();
+  vtkMRMLNode* node = nullptr;
+  for (snapshotNodes->InitTraversal(it);
+       (node = vtkMRMLNode::SafeDownCast(snapshotNodes->GetNextItemAsObject(it))) ;)
+    {
+    vtkMRMLNode* sceneNode = node->GetID() ? this->Scene->GetNodeByID(node->GetID()) : nullptr;
+    if (sceneNode)
+      {
+      this->SynchronizedNodeMTimes[node->GetID()] = sceneNode->GetMTime();
       }
     }
-  this->SnapshotScene->CopyNodeReferences(this->GetScene());
-  this->SnapshotScene->CopyNodeChangedIDs(this->GetScene());
 }
 
 //----------------------------------------------------------------------------
@@ -429,6 +590,7 @@ void vtkMRMLSceneViewNode::AddMissingNodes()
     vtkWarningMacro("No scene to add nodes from");
     return;
     }
+  this->AddNodesSameAsScene();
   if (this->SnapshotScene == nullptr)
     {
     vtkWarningMacro("No scene to add to");
@@ -469,23 +631,8 @@ void vtkMRMLSceneViewNode::AddMissingNodes()
       {
       vtkDebugMacro("AddMissingNodes: Adding node with id " << node->GetID());
 
-      vtkSmartPointer<vtkMRMLNode> newNode = vtkSmartPointer<vtkMRMLNode>::Take(node->CreateNodeInstance());
-
-      newNode->SetScene(this->SnapshotScene);
-
-      int oldMode = newNode->GetDisableModifiedEvent();
-      newNode->DisableModifiedEventOn();
-      newNode->Copy(node);
-      newNode->SetDisableModifiedEvent(oldMode);
-
-      newNode->SetID(node->GetID());
-
-      newNode->SetAddToSceneNoModify(1);
-      this->SnapshotScene->AddNode(newNode);
-      newNode->SetAddToSceneNoModify(0);
-
-      // sanity check
-      assert(newNode->GetScene() == this->SnapshotScene);
+      this->AddNodeToStoredScene(node);
+      this->SynchronizedNodeMTimes[node->GetID()] = node->GetMTime();
 
       nodesAdded++;
       }
@@ -506,6 +653,7 @@ bool vtkMRMLSceneViewNode::RestoreScene(bool removeNodes)
     vtkWarningMacro("No scene to restore onto");
     return true;
     }
+  this->AddNodesSameAsScene();
   if (this->SnapshotScene == nullptr)
     {
     vtkWarningMacro("No nodes to restore");
@@ -603,17 +751,29 @@ bool vtkMRMLSceneViewNode::RestoreScene(bool removeNodes)
 
         if (snode)
           {
+          std::map<std::string, vtkMTimeType>::iterator mtimeIt = this->SynchronizedNodeMTimes.find(node->GetID());
+          if (mtimeIt != this->SynchronizedNodeMTimes.end() && mtimeIt->second == snode->GetMTime())
+            {
+            // the node has not changed since it was stored or restored
+            continue;
+            }
           snode->SetScene(this->Scene);
           // to prevent copying of default info if not stored in snapshot
           MRMLNodeModifyBlocker blocker(snode);
-          snode->Copy(node);
+          this->CopyNodeState(snode, node);
           // to prevent reading data on UpdateScene()
           snode->SetAddToSceneNoModify(0);
           }
         else
           {
           vtkMRMLNode *newNode = node->CreateNodeInstance();
-          newNode->CopyWithScene(node);
+          {
+          // same as CopyWithScene, but bulk data may be shared
+          MRMLNodeModifyBlocker blocker(newNode);
+          newNode->SetScene(node->GetScene());
+          newNode->SetID(node->GetID());
+          this->CopyNodeState(newNode, node);
+          }
 
           addedNodes.push_back(newNode);
           newNode->SetAddToSceneNoModify(1);
@@ -650,6 +810,8 @@ bool vtkMRMLSceneViewNode::RestoreScene(bool removeNodes)
 
   this->Scene->EndState(vtkMRMLScene::RestoreState);
 
+  this->UpdateSynchronizedNodeMTimes();
+
 #ifndef NDEBUG
   // sanity checks
   for (sceneNodes->InitTraversal(it);
@@ -665,6 +827,7 @@ bool vtkMRMLSceneViewNode::RestoreScene(bool removeNodes)
 //----------------------------------------------------------------------------
 vtkMRMLScene* vtkMRMLSceneViewNode::GetStoredScene()
 {
+  this->AddNodesSameAsScene();
   return this->SnapshotScene;
 }
 
@@ -782,6 +945,7 @@ void vtkMRMLSceneViewNode::SetScreenShotType(int newScreenShotType)
 //----------------------------------------------------------------------------
 int vtkMRMLSceneViewNode::GetNodesByClass(const char *className, std::vector<vtkMRMLNode *> &nodes)
 {
+  this->AddNodesSameAsScene();
   if (!this->SnapshotScene)
     {
     return 0;
@@ -792,6 +956,7 @@ int vtkMRMLSceneViewNode::GetNodesByClass(const char *className, std::vector<vtk
 //------------------------------------------------------------------------------
 vtkCollection* vtkMRMLSceneViewNode::GetNodesByClass(const char *className)
 {
+  this->AddNodesSameAsScene();
   if (!this->SnapshotScene)
     {
     return nullptr;
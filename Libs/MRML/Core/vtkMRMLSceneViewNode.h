@@ -20,6 +20,11 @@
 // VTK includes
 #include <vtkStdString.h>
 class vtkCollection;
+
+// STD includes
+#include <map>
+#include <string>
+#include <vector>
 class vtkImageData;
 
 class vtkMRMLStorageNode;
@@ -130,6 +135,19 @@ class VTK_MRML_EXPORT vtkMRMLSceneViewNode : public vtkMRMLStorableNode
 
   void SetSceneViewRootDir( const char* name);
 
+  ///@{
+  /// \brief Share bulk data (such as image or mesh data) between the scene and the scene view.
+  ///
+  /// If enabled (default), nodes that support CopyContent() are stored and restored by
+  /// shallow copy, so bulk data is shared by reference instead of being duplicated in
+  /// each scene view. Bulk data must then be replaced (not modified in place) to keep
+  /// the stored state intact, similarly to vtkMRMLScene::SetUndoBulkDataSharing().
+  /// If disabled, each stored node is an independent deep copy.
+  vtkSetMacro(BulkDataSharing, bool);
+  vtkGetMacro(BulkDataSharing, bool);
+  vtkBooleanMacro(BulkDataSharing, bool);
+  ///@}
+
 protected:
   vtkMRMLSceneViewNode();
   ~vtkMRMLSceneViewNode() override;
@@ -148,6 +166,32 @@ protected:
   /// The type of the screenshot
   int ScreenShotType;
 
+  /// Copy node properties and content from \a source to \a target.
+  /// Bulk data is shallow-copied if BulkDataSharing is enabled.
+  void CopyNodeState(vtkMRMLNode* target, vtkMRMLNode* source);
+
+  /// Add a copy of a scene node to the stored scene
+  void AddNodeToStoredScene(vtkMRMLNode* node);
+
+  /// Add the stored nodes that were read from the scene file as references to scene nodes
+  /// (see NodeIDsSameAsScene) to the stored scene
+  void AddNodesSameAsScene();
+
+  /// Remember modification time of the scene nodes that are in the stored scene
+  void UpdateSynchronizedNodeMTimes();
+
+  bool BulkDataSharing;
+
+  /// Modification time of scene nodes when they were last stored into or restored
+  /// from this scene view. Nodes that have not been modified since then are already
+  /// in the stored state, therefore they are not copied when the scene view is restored.
+  std::map<std::string, vtkMTimeType> SynchronizedNodeMTimes;
+
+  /// IDs of stored nodes that are identical to the corresponding nodes of the scene.
+  /// These nodes are not written into the scene file as part of the scene view but they
+  /// are copied from the scene after the scene is read.
+  std::vector<std::string> NodeIDsSameAsScene;
+
 };
 
 #endif
@@ -34,6 +34,7 @@
 #include <vtkMRMLTransformNode.h>
 #include <vtkMRMLStorageNode.h>
 #include <vtkMRMLSubjectHierarchyNode.h>
+#include <vtkMRMLTraceRecorder.h>
 #include <vtkMRMLScalarVolumeNode.h>
 
 // VTK includes
@@ -182,6 +183,32 @@ void vtkMRMLSegmentationNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*=tr
   vtkMRMLCopyEndMacro();
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLSegmentationNode::GetDataObjects(std::vector<vtkDataObject*>& dataObjects)
+{
+  Superclass::GetDataObjects(dataObjects);
+  if (!this->Segmentation)
+    {
+    return;
+    }
+  // Shared labelmaps are returned once for each segment, duplicates are removed
+  // by the caller.
+  for (int segmentIndex = 0; segmentIndex < this->Segmentation->GetNumberOfSegments(); ++segmentIndex)
+    {
+    vtkSegment* segment = this->Segmentation->GetNthSegment(segmentIndex);
+    std::vector<std::string> representationNames;
+    segment->GetContainedRepresentationNames(representationNames);
+    for (const std::string& representationName : representationNames)
+      {
+      vtkDataObject* representation = segment->GetRepresentation(representationName);
+      if (representation)
+        {
+        dataObjects.push_back(representation);
+        }
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLSegmentationNode::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -868,6 +895,7 @@ void vtkMRMLSegmentationNode::RemoveSegment(const std::string& segmentID)
 //---------------------------------------------------------------------------
 bool vtkMRMLSegmentationNode::CreateBinaryLabelmapRepresentation()
 {
+  vtkMRMLTraceScopeMacro("vtkMRMLSegmentationNode::CreateBinaryLabelmapRepresentation");
   if (!this->Segmentation)
     {
     vtkErrorMacro("CreateBinaryLabelmapRepresentation: Invalid segmentation");
@@ -942,6 +970,7 @@ vtkOrientedImageData* vtkMRMLSegmentationNode::GetBinaryLabelmapInternalRepresen
 //---------------------------------------------------------------------------
 bool vtkMRMLSegmentationNode::CreateClosedSurfaceRepresentation()
 {
+  vtkMRMLTraceScopeMacro("vtkMRMLSegmentationNode::CreateClosedSurfaceRepresentation");
   if (!this->Segmentation)
     {
     vtkErrorMacro("CreateClosedSurfaceRepresentation: Invalid segmentation");
@@ -1092,24 +1121,17 @@ double* vtkMRMLSegmentationNode::GetSegmentCenter(const std::string& segmentID)
 
     vtkNew<vtkITKIslandMath> islandMath;
     islandMath->SetInputConnection(castToUint->GetOutputPort());
+    islandMath->ParallelLabelingOn();
+    islandMath->Update();
 
-    vtkNew<vtkImageThreshold> largestIslandFilter;
-    largestIslandFilter->SetInputConnection(islandMath->GetOutputPort());
-    largestIslandFilter->ThresholdBetween(1.0, 1.0);
-    largestIslandFilter->SetInValue(1.0);
-    largestIslandFilter->SetOutValue(0.0);
-    largestIslandFilter->Update();
-
-    vtkNew<vtkOrientedImageData> largestResampledIsland;
-    largestResampledIsland->ShallowCopy(largestIslandFilter->GetOutput());
-    largestResampledIsland->CopyDirections(resampledLabelmap);
-
-    int resampledLabelEffectiveExtent[6] = { 0, -1, 0, -1, 0, -1 };
-    if (!vtkOrientedImageDataResample::CalculateEffectiveExtent(largestResampledIsland, resampledLabelEffectiveExtent))
+    // Islands are sorted by size, the bounding box of the largest island is the first one
+    if (islandMath->GetNumberOfIslands() < 1)
       {
       vtkWarningMacro("GetSegmentCenter: segment " << segmentID << " is empty");
       return nullptr;
       }
+    int resampledLabelEffectiveExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    islandMath->GetIslandExtents()->GetTypedTuple(0, resampledLabelEffectiveExtent);
 
     // segmentCenter_Image is floored to put the center exactly in the center of a voxel
     // (otherwise center position would be set at the boundary between two voxels when extent size is an even number)
@@ -73,6 +73,10 @@ public:
   /// \sa vtkMRMLNode::CopyContent
   vtkMRMLCopyContentMacro(vtkMRMLSegmentationNode);
 
+  /// Get bulk data objects stored in this node.
+  /// \sa vtkMRMLNode::GetDataObjects
+  void GetDataObjects(std::vector<vtkDataObject*>& dataObjects) override;
+
   /// Get unique node XML tag name (like Volume, Model)
   const char* GetNodeTagName() override {return "Segmentation";};
 
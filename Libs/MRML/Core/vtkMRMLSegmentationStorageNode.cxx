@@ -22,6 +22,7 @@
 #include "vtkMRMLSegmentationStorageNode.h"
 
 #include "vtkSegmentation.h"
+#include "vtkSegmentationConversionCache.h"
 #include "vtkOrientedImageData.h"
 #include "vtkOrientedImageDataResample.h"
 
@@ -69,6 +70,7 @@
 #endif
 
 // STL & C++ includes
+#include <algorithm>
 #include <iterator>
 #include <sstream>
 
@@ -105,6 +107,8 @@ void vtkMRMLSegmentationStorageNode::PrintSelf(ostream& os, vtkIndent indent)
   Superclass::PrintSelf(os,indent);
   vtkMRMLPrintBeginMacro(os, indent);
   vtkMRMLPrintBooleanMacro(CropToMinimumExtent);
+  vtkMRMLPrintBooleanMacro(CreateRepresentationsOnDemand);
+  vtkMRMLPrintBooleanMacro(UseConversionCache);
   vtkMRMLPrintEndMacro();
 }
 
@@ -115,6 +119,8 @@ void vtkMRMLSegmentationStorageNode::ReadXMLAttributes(const char** atts)
   Superclass::ReadXMLAttributes(atts);
   vtkMRMLReadXMLBeginMacro(atts);
   vtkMRMLReadXMLBooleanMacro(CropToMinimumExtent, CropToMinimumExtent);
+  vtkMRMLReadXMLBooleanMacro(CreateRepresentationsOnDemand, CreateRepresentationsOnDemand);
+  vtkMRMLReadXMLBooleanMacro(UseConversionCache, UseConversionCache);
   vtkMRMLReadXMLEndMacro();
 }
 
@@ -124,6 +130,8 @@ void vtkMRMLSegmentationStorageNode::WriteXML(ostream& of, int nIndent)
   Superclass::WriteXML(of, nIndent);
   vtkMRMLWriteXMLBeginMacro(of);
   vtkMRMLWriteXMLBooleanMacro(CropToMinimumExtent, CropToMinimumExtent);
+  vtkMRMLWriteXMLBooleanMacro(CreateRepresentationsOnDemand, CreateRepresentationsOnDemand);
+  vtkMRMLWriteXMLBooleanMacro(UseConversionCache, UseConversionCache);
   vtkMRMLWriteXMLEndMacro();
 }
 
@@ -136,6 +144,8 @@ void vtkMRMLSegmentationStorageNode::Copy(vtkMRMLNode *anode)
   Superclass::Copy(anode);
   vtkMRMLCopyBeginMacro(anode);
   vtkMRMLCopyBooleanMacro(CropToMinimumExtent);
+  vtkMRMLCopyBooleanMacro(CreateRepresentationsOnDemand);
+  vtkMRMLCopyBooleanMacro(UseConversionCache);
   vtkMRMLCopyEndMacro();
 }
 
@@ -1611,6 +1621,17 @@ std::string vtkMRMLSegmentationStorageNode::SerializeContainedRepresentationName
     {
     ssRepresentationNames << (*reprIt) << SERIALIZATION_SEPARATOR;
     }
+  // Released representations are still part of the segmentation, they are just not in memory
+  std::vector<std::string> releasedRepresentationNames;
+  segmentation->GetReleasedRepresentationNames(releasedRepresentationNames);
+  for (const std::string& releasedRepresentationName : releasedRepresentationNames)
+    {
+    if (std::find(containedRepresentationNames.begin(), containedRepresentationNames.end(), releasedRepresentationName)
+      == containedRepresentationNames.end())
+      {
+      ssRepresentationNames << releasedRepresentationName << SERIALIZATION_SEPARATOR;
+      }
+    }
 
   return ssRepresentationNames.str();
 }
@@ -1634,6 +1655,20 @@ void vtkMRMLSegmentationStorageNode::CreateRepresentationsBySerializedNames(vtkS
     return;
     }
 
+  // Representations converted when the same segmentation was read before are taken from the cache.
+  // The cache is only used while reading, so that editing the segmentation does not write cache files.
+  bool useConversionCache = this->UseConversionCache && !this->CreateRepresentationsOnDemand
+    && !this->GetConversionCacheDirectory().empty();
+  if (useConversionCache)
+    {
+    if (!this->ConversionCache)
+      {
+      this->ConversionCache = vtkSmartPointer<vtkSegmentationConversionCache>::New();
+      }
+    this->ConversionCache->SetCacheDirectory(this->GetConversionCacheDirectory());
+    segmentation->SetConversionCache(this->ConversionCache);
+    }
+
   std::string masterRepresentation(segmentation->GetMasterRepresentationName());
   size_t separatorPosition = representationNames.find(SERIALIZATION_SEPARATOR);
   while (separatorPosition != std::string::npos)
@@ -1643,12 +1678,36 @@ void vtkMRMLSegmentationStorageNode::CreateRepresentationsBySerializedNames(vtkS
     // Only create non-master representations
     if (representationName.compare(masterRepresentation))
       {
-      segmentation->CreateRepresentation(representationName);
+      if (this->CreateRepresentationsOnDemand)
+        {
+        segmentation->ReleaseRepresentation(representationName);
+        }
+      else
+        {
+        segmentation->CreateRepresentation(representationName);
+        }
       }
 
     representationNames = representationNames.substr(separatorPosition+1);
     separatorPosition = representationNames.find(SERIALIZATION_SEPARATOR);
     }
+
+  if (useConversionCache)
+    {
+    segmentation->SetConversionCache(nullptr);
+    }
+}
+
+//----------------------------------------------------------------------------
+std::string vtkMRMLSegmentationStorageNode::GetConversionCacheDirectory()
+{
+  std::string fullName = this->GetFullNameFromFileName();
+  if (fullName.empty())
+    {
+    return "";
+    }
+  return vtksys::SystemTools::GetFilenamePath(fullName) + "/"
+    + vtksys::SystemTools::GetFilenameWithoutLastExtension(fullName) + ".cache";
 }
 
 //----------------------------------------------------------------------------
@@ -38,6 +38,7 @@ class vtkMatrix4x4;
 class vtkPolyData;
 class vtkOrientedImageData;
 class vtkSegmentation;
+class vtkSegmentationConversionCache;
 class vtkMRMLSegmentationNode;
 class vtkSegment;
 class vtkInformationStringKey;
@@ -111,6 +112,31 @@ public:
   vtkGetMacro(CropToMinimumExtent, bool);
   vtkBooleanMacro(CropToMinimumExtent, bool);
 
+  /// Controls if the non-master representations that were contained in the segmentation when it was
+  /// saved are created when the segmentation is read.
+  /// If false (default): all the representations are created by conversion from the master representation
+  /// after reading.
+  /// If true: the representations are only marked as released in the segmentation (see
+  /// vtkSegmentation::ReleaseRepresentation) and they are created when they are first requested.
+  /// This makes loading faster and uses less memory if not all the representations are needed.
+  vtkSetMacro(CreateRepresentationsOnDemand, bool);
+  vtkGetMacro(CreateRepresentationsOnDemand, bool);
+  vtkBooleanMacro(CreateRepresentationsOnDemand, bool);
+
+  /// Controls if representations created from the master representation when the segmentation
+  /// is read are stored in a conversion cache directory next to the segmentation file
+  /// (see GetConversionCacheDirectory).
+  /// If false (default): no cache is used.
+  /// If true: when the same segmentation is read again with the same conversion parameters,
+  /// representations are read from the cache instead of converting (e.g., closed surfaces are not regenerated).
+  vtkSetMacro(UseConversionCache, bool);
+  vtkGetMacro(UseConversionCache, bool);
+  vtkBooleanMacro(UseConversionCache, bool);
+
+  /// Get directory of the conversion cache of the current file name.
+  /// For "Segmentation.seg.nrrd" it is "Segmentation.seg.cache" in the same directory.
+  std::string GetConversionCacheDirectory();
+
 protected:
   /// Initialize all the supported read file types
   void InitializeSupportedReadFileTypes() override;
@@ -176,6 +202,10 @@ protected:
 
 protected:
   bool CropToMinimumExtent{false};
+  bool CreateRepresentationsOnDemand{false};
+  bool UseConversionCache{false};
+  /// Kept between reads so that representations are also cached in memory
+  vtkSmartPointer<vtkSegmentationConversionCache> ConversionCache;
 
 protected:
   vtkMRMLSegmentationStorageNode();
@@ -22,11 +22,14 @@
 #include "vtkMRMLStorableNode.h"
 
 // MRML includes
+#include <vtkMRMLLinearTransformNode.h>
 #include <vtkMRMLScene.h>
 
 // VTK includes
 #include <vtkNew.h>
 #include <vtkCollection.h>
+#include <vtkDoubleArray.h>
+#include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkSmartPointer.h>
@@ -55,6 +58,39 @@ vtkCxxSetVariableInDataAndStorageNodeMacro(IndexUnit, const std::string&);
 vtkCxxSetVariableInDataAndStorageNodeMacro(IndexType, int);
 vtkCxxSetVariableInDataAndStorageNodeMacro(NumericIndexValueTolerance, double);
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Get base name of a data node that is added to the sequence
+std::string GetDataNodeBaseName(vtkMRMLNode* source)
+{
+  std::string baseName = "Data";
+  if (source->GetAttribute("Sequences.BaseName") != 0)
+    {
+    baseName = source->GetAttribute("Sequences.BaseName");
+    }
+  else if (source->GetName() != 0)
+    {
+    baseName = source->GetName();
+    }
+  return baseName;
+}
+
+//----------------------------------------------------------------------------
+/// Set name of a data node that is added to the sequence scene from the name of the source node
+void SetDataNodeBaseName(vtkMRMLNode* target, vtkMRMLNode* source)
+{
+  std::string baseName = GetDataNodeBaseName(source);
+
+  // Generating unique node names is slow, and makes adding many nodes to a sequence too slow
+  // We will instead ensure that all file names for storable nodes are unique when saving
+  target->SetName(baseName.c_str());
+  target->SetAttribute("Sequences.BaseName", baseName.c_str());
+}
+
+} // end of anonymous namespace
+
 //----------------------------------------------------------------------------
 vtkMRMLSequenceNode::vtkMRMLSequenceNode()
 {
@@ -64,6 +100,8 @@ vtkMRMLSequenceNode::vtkMRMLSequenceNode()
   // sequence scene cannot be created here because vtkMRMLScene instantiates this node
   // in its constructor, which would lead to infinite loop
   this->SequenceScene = nullptr;
+  this->CompactTransformMatrices = vtkSmartPointer<vtkDoubleArray>::New();
+  this->CompactTransformMatrices->SetNumberOfComponents(16);
 }
 
 //----------------------------------------------------------------------------
@@ -80,6 +118,15 @@ vtkMRMLSequenceNode::~vtkMRMLSequenceNode()
 void vtkMRMLSequenceNode::RemoveAllDataNodes()
 {
   this->IndexEntries.clear();
+  this->IndexEntriesModified();
+  if (this->CompactTransformMatrices->GetNumberOfTuples() > 0)
+    {
+    this->CompactTransformMatrices->Initialize();
+    this->CompactTransformMatrices->SetNumberOfComponents(16);
+    this->CompactTransformBaseName.clear();
+    this->Modified();
+    this->StorableModifiedTime.Modified();
+    }
   if (!this->SequenceScene)
     {
     return;
@@ -106,6 +153,8 @@ void vtkMRMLSequenceNode::WriteXML(ostream& of, int nIndent)
 
   of << indent << " numericIndexValueTolerance=\"" << this->NumericIndexValueTolerance << "\"";
 
+  of << indent << " compactTransformStorage=\"" << (this->CompactTransformStorage ? "true" : "false") << "\"";
+
   of << indent << " indexValues=\"";
   for(std::deque< IndexEntryType >::iterator indexIt=this->IndexEntries.begin(); indexIt!=this->IndexEntries.end(); ++indexIt)
     {
@@ -114,7 +163,12 @@ void vtkMRMLSequenceNode::WriteXML(ostream& of, int nIndent)
       // not the first index, add a separator before adding values
       of << ";";
       }
-    if (indexIt->DataNode==nullptr)
+    if (indexIt->CompactTransformIndex >= 0)
+      {
+      // There is no data node, the transforms are written to file by the storage node
+      of << indexIt->IndexValue;
+      }
+    else if (indexIt->DataNode==nullptr)
       {
       // If we have a data node ID then store that, it is the most we know about the node that should be there
       if (!indexIt->DataNodeID.empty())
@@ -174,6 +228,10 @@ void vtkMRMLSequenceNode::ReadXMLAttributes(const char** atts)
       ss >> numericIndexValueTolerance;
       this->SetNumericIndexValueTolerance(numericIndexValueTolerance);
       }
+    else if (!strcmp(attName, "compactTransformStorage"))
+      {
+      this->SetCompactTransformStorage(!strcmp(attValue, "true"));
+      }
     else if (!strcmp(attName, "indexValues"))
       {
       ReadIndexValues(attValue);
@@ -189,6 +247,7 @@ void vtkMRMLSequenceNode::ReadIndexValues(const std::string& indexText)
   if (!this->IndexEntries.empty())
     {
     this->IndexEntries.clear();
+    this->IndexEntriesModified();
     modified = true;
     }
 
@@ -204,10 +263,12 @@ void vtkMRMLSequenceNode::ReadIndexValues(const std::string& indexText)
 
       IndexEntryType indexEntry;
       indexEntry.IndexValue=indexValue;
+      indexEntry.NumericIndexValue = atof(indexValue.c_str());
       // The nodes are not read yet, so we can only store the node ID and get the pointer to the node later (in UpdateScene())
       indexEntry.DataNodeID=nodeId;
       indexEntry.DataNode=nullptr;
       this->IndexEntries.push_back(indexEntry);
+      this->IndexEntriesModified();
       modified = true;
       }
     }
@@ -237,6 +298,9 @@ void vtkMRMLSequenceNode::Copy(vtkMRMLNode *anode)
   this->SetIndexUnit(snode->GetIndexUnit());
   this->SetIndexType(snode->GetIndexType());
   this->SetNumericIndexValueTolerance(snode->GetNumericIndexValueTolerance());
+  this->CompactTransformStorage = snode->CompactTransformStorage;
+  this->CompactTransformMatrices->DeepCopy(snode->CompactTransformMatrices);
+  this->CompactTransformBaseName = snode->CompactTransformBaseName;
 
   // Clear nodes: RemoveAllNodes is not a public method, so it's simpler to just delete and recreate the scene
   if (this->SequenceScene)
@@ -258,6 +322,11 @@ void vtkMRMLSequenceNode::Copy(vtkMRMLNode *anode)
         vtkErrorMacro("Invalid node in vtkMRMLSequenceNode");
         continue;
         }
+      if (snode->HasObserver(vtkMRMLSequenceNode::DataNodeAccessedEvent))
+        {
+        // make sure content of the data node is loaded
+        snode->InvokeEvent(vtkMRMLSequenceNode::DataNodeAccessedEvent, node);
+        }
       vtkMRMLNode* targetDataNode = this->DeepCopyNodeToScene(node, this->SequenceScene);
       sourceToTargetDataNodeID[node->GetID()] = targetDataNode->GetID();
       }
@@ -273,7 +342,15 @@ void vtkMRMLSequenceNode::Copy(vtkMRMLNode *anode)
     {
     IndexEntryType seqItem;
     seqItem.IndexValue=sourceIndexIt->IndexValue;
+    seqItem.NumericIndexValue = sourceIndexIt->NumericIndexValue;
     seqItem.DataNode = nullptr;
+    seqItem.CompactTransformIndex = sourceIndexIt->CompactTransformIndex;
+    if (seqItem.CompactTransformIndex >= 0)
+      {
+      // matrix is already copied
+      this->IndexEntries.push_back(seqItem);
+      continue;
+      }
     if (sourceIndexIt->DataNode!=nullptr)
       {
       std::string targetDataNodeID = sourceToTargetDataNodeID[sourceIndexIt->DataNode->GetID()];
@@ -292,6 +369,7 @@ void vtkMRMLSequenceNode::Copy(vtkMRMLNode *anode)
       }
     this->IndexEntries.push_back(seqItem);
     }
+  this->IndexEntriesModified();
   this->Modified();
   this->StorableModifiedTime.Modified();
 
@@ -314,6 +392,7 @@ void vtkMRMLSequenceNode::CopySequenceIndex(vtkMRMLNode *anode)
       {
       IndexEntryType seqItem;
       seqItem.IndexValue = sourceIndexIt->IndexValue;
+      seqItem.NumericIndexValue = sourceIndexIt->NumericIndexValue;
       if (sourceIndexIt->DataNode != nullptr)
         {
         seqItem.DataNodeID = sourceIndexIt->DataNode->GetID();
@@ -325,11 +404,31 @@ void vtkMRMLSequenceNode::CopySequenceIndex(vtkMRMLNode *anode)
       seqItem.DataNode = nullptr;
       this->IndexEntries.push_back(seqItem);
       }
+    this->IndexEntriesModified();
     this->Modified();
     }
   this->EndModify(wasModified);
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLSequenceNode::GetDataObjects(std::vector<vtkDataObject*>& dataObjects)
+{
+  Superclass::GetDataObjects(dataObjects);
+  // Iterate through the nodes of the internal scene directly (instead of using GetNthDataNode)
+  // to not trigger loading of data nodes on access.
+  if (!this->SequenceScene)
+    {
+    return;
+    }
+  vtkCollection* nodes = this->SequenceScene->GetNodes();
+  vtkMRMLNode* node = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (nodes->InitTraversal(it); (node = vtkMRMLNode::SafeDownCast(nodes->GetNextItemAsObject(it)));)
+    {
+    node->GetDataObjects(dataObjects);
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLSequenceNode::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -367,6 +466,22 @@ bool vtkMRMLSequenceNode::UpdateDataNodeAtValue(vtkMRMLNode* node, const std::st
     vtkErrorMacro("vtkMRMLSequenceNode::UpdateDataNodeAtValue failed, invalid node");
     return false;
     }
+  int itemNumber = this->GetItemNumberFromIndexValue(indexValue);
+  if (itemNumber >= 0 && this->IndexEntries[itemNumber].CompactTransformIndex >= 0)
+    {
+    if (this->CanStoreCompactly(node))
+      {
+      this->StoreCompactTransform(node, this->IndexEntries[itemNumber].CompactTransformIndex);
+      this->Modified();
+      this->StorableModifiedTime.Modified();
+      }
+    else
+      {
+      // the item cannot be stored as a matrix anymore
+      this->SetDataNodeAtValue(node, indexValue);
+      }
+    return true;
+    }
   vtkMRMLNode* nodeToBeUpdated = this->GetDataNodeAtValue(indexValue);
   if (!nodeToBeUpdated)
     {
@@ -385,9 +500,9 @@ int vtkMRMLSequenceNode::GetInsertPosition(const std::string& indexValue)
   int insertPosition = this->IndexEntries.size();
   if (this->IndexType == vtkMRMLSequenceNode::NumericIndex && !this->IndexEntries.empty())
     {
-    int itemNumber = this->GetItemNumberFromIndexValue(indexValue, false);
     double numericIndexValue = atof(indexValue.c_str());
-    double foundNumericIndexValue = atof(this->IndexEntries[itemNumber].IndexValue.c_str());
+    int itemNumber = this->GetItemNumberFromNumericIndexValue(numericIndexValue, false);
+    double foundNumericIndexValue = this->IndexEntries[itemNumber].NumericIndexValue;
     if (numericIndexValue < foundNumericIndexValue) // Deals with case of index value being smaller than any in the sequence and numeric tolerances
       {
       insertPosition = itemNumber;
@@ -401,18 +516,41 @@ int vtkMRMLSequenceNode::GetInsertPosition(const std::string& indexValue)
 }
 
 //----------------------------------------------------------------------------
-vtkMRMLNode* vtkMRMLSequenceNode::SetDataNodeAtValue(vtkMRMLNode* node, const std::string& indexValue)
+vtkMRMLNode* vtkMRMLSequenceNode::SetDataNodeAtValue(vtkMRMLNode* node, const std::string& indexValue, bool copyNode/*=true*/)
 {
   if (node == nullptr)
     {
     vtkErrorMacro("vtkMRMLSequenceNode::SetDataNodeAtValue failed, invalid node");
     return nullptr;
     }
+  if (!copyNode && node->GetScene())
+    {
+    vtkErrorMacro("vtkMRMLSequenceNode::SetDataNodeAtValue failed, node is already in a scene");
+    return nullptr;
+    }
   MRMLNodeModifyBlocker blocker(this);
+  bool storeCompactly = this->CanStoreCompactly(node);
   // Make sure the sequence scene is created
   this->GetSequenceScene();
-  // Add a copy of the node to the sequence's scene
-  vtkMRMLNode* newNode = this->DeepCopyNodeToScene(node, this->SequenceScene);
+  // Add the node (or a copy of the node) to the sequence's scene
+  vtkMRMLNode* newNode = nullptr;
+  if (storeCompactly)
+    {
+    // only the matrix is stored, after the item is found
+    if (this->CompactTransformBaseName.empty())
+      {
+      this->CompactTransformBaseName = GetDataNodeBaseName(node);
+      }
+    }
+  else if (copyNode)
+    {
+    newNode = this->DeepCopyNodeToScene(node, this->SequenceScene);
+    }
+  else
+    {
+    SetDataNodeBaseName(node, node);
+    newNode = this->SequenceScene->AddNode(node);
+    }
   int seqItemIndex = this->GetItemNumberFromIndexValue(indexValue);
   if (seqItemIndex<0)
     {
@@ -421,9 +559,29 @@ vtkMRMLNode* vtkMRMLSequenceNode::SetDataNodeAtValue(vtkMRMLNode* node, const st
     // Create new item
     IndexEntryType seqItem;
     seqItem.IndexValue = indexValue;
+    seqItem.NumericIndexValue = atof(indexValue.c_str());
     this->IndexEntries.insert(this->IndexEntries.begin() + seqItemIndex, seqItem);
+    if (this->IndexValueToItemNumberValid && seqItemIndex == static_cast<int>(this->IndexEntries.size()) - 1)
+      {
+      // Appending does not change item number of other items, so the lookup table can be updated
+      this->IndexValueToItemNumber.emplace(indexValue, seqItemIndex);
+      }
+    else
+      {
+      this->IndexEntriesModified();
+      }
     }
-  this->IndexEntries[seqItemIndex].DataNode = newNode;
+  if (storeCompactly)
+    {
+    vtkIdType compactTransformIndex = this->StoreCompactTransform(node, this->IndexEntries[seqItemIndex].CompactTransformIndex);
+    this->IndexEntries[seqItemIndex].CompactTransformIndex = compactTransformIndex;
+    newNode = this->GetCompactTransformDataNode(compactTransformIndex);
+    }
+  else
+    {
+    this->IndexEntries[seqItemIndex].CompactTransformIndex = -1;
+    }
+  this->IndexEntries[seqItemIndex].DataNode = (storeCompactly ? nullptr : newNode);
   this->IndexEntries[seqItemIndex].DataNodeID.clear();
   // Save the sequence data node class namein a node attribute to allow easy access
   // (e.g., for filtering on the GUI).
@@ -445,6 +603,15 @@ void vtkMRMLSequenceNode::RemoveDataNodeAtValue(const std::string& indexValue)
     vtkWarningMacro("vtkMRMLSequenceNode::RemoveDataNodeAtValue: node was not found at index value "<<indexValue);
     return;
     }
+  if (this->IndexEntries[seqItemIndex].CompactTransformIndex >= 0)
+    {
+    // the matrix is left unused in CompactTransformMatrices, it is freed when all items are removed
+    this->IndexEntries.erase(this->IndexEntries.begin()+seqItemIndex);
+    this->IndexEntriesModified();
+    this->Modified();
+    this->StorableModifiedTime.Modified();
+    return;
+    }
   if (!this->SequenceScene)
     {
     vtkWarningMacro("vtkMRMLSequenceNode::RemoveDataNodeAtValue: internal scene is already empty");
@@ -453,6 +620,7 @@ void vtkMRMLSequenceNode::RemoveDataNodeAtValue(const std::string& indexValue)
   // TODO: remove associated nodes as well (such as storage node)?
   this->SequenceScene->RemoveNode(this->IndexEntries[seqItemIndex].DataNode);
   this->IndexEntries.erase(this->IndexEntries.begin()+seqItemIndex);
+  this->IndexEntriesModified();
   this->Modified();
   this->StorableModifiedTime.Modified();
 }
@@ -460,8 +628,7 @@ void vtkMRMLSequenceNode::RemoveDataNodeAtValue(const std::string& indexValue)
 //---------------------------------------------------------------------------
 int vtkMRMLSequenceNode::GetItemNumberFromIndexValue(const std::string& indexValue, bool exactMatchRequired /* =true */)
 {
-  int numberOfSeqItems=this->IndexEntries.size();
-  if (numberOfSeqItems == 0)
+  if (this->IndexEntries.empty())
     {
     return -1;
     }
@@ -469,69 +636,93 @@ int vtkMRMLSequenceNode::GetItemNumberFromIndexValue(const std::string& indexVal
   // Binary search will be faster for numeric index
   if (this->IndexType == NumericIndex)
     {
-    int lowerBound = 0;
-    int upperBound = numberOfSeqItems-1;
-
-    // Deal with index values not within the range of index values in the Sequence
-    double numericIndexValue = atof(indexValue.c_str());
-    double lowerNumericIndexValue = atof(this->IndexEntries[lowerBound].IndexValue.c_str());
-    double upperNumericIndexValue = atof(this->IndexEntries[upperBound].IndexValue.c_str());
-    if (numericIndexValue <= lowerNumericIndexValue + this->NumericIndexValueTolerance)
+    int itemNumber = this->GetItemNumberFromNumericIndexValue(atof(indexValue.c_str()), exactMatchRequired);
+    if (itemNumber >= 0 || !exactMatchRequired)
       {
-      if (numericIndexValue < lowerNumericIndexValue - this->NumericIndexValueTolerance && exactMatchRequired)
-        {
-        return -1;
-        }
-      else
-        {
-        return lowerBound;
-        }
+      return itemNumber;
       }
-    if (numericIndexValue >= upperNumericIndexValue - this->NumericIndexValueTolerance)
+    }
+
+  // Need exact string match for non-numeric index
+  if (!this->IndexValueToItemNumberValid)
+    {
+    this->IndexValueToItemNumber.clear();
+    int numberOfSeqItems = this->IndexEntries.size();
+    for (int i = 0; i < numberOfSeqItems; i++)
       {
-      if (numericIndexValue > upperNumericIndexValue + this->NumericIndexValueTolerance && exactMatchRequired)
-        {
-        return -1;
-        }
-      else
-        {
-        return upperBound;
-        }
+      // emplace does not overwrite existing items, so the first item is found if index values are not unique
+      this->IndexValueToItemNumber.emplace(this->IndexEntries[i].IndexValue, i);
       }
+    this->IndexValueToItemNumberValid = true;
+    }
+  std::unordered_map< std::string, int >::iterator itemNumberIt = this->IndexValueToItemNumber.find(indexValue);
+  if (itemNumberIt == this->IndexValueToItemNumber.end())
+    {
+    return -1;
+    }
+  return itemNumberIt->second;
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLSequenceNode::GetItemNumberFromNumericIndexValue(double numericIndexValue, bool exactMatchRequired /* =true */)
+{
+  int numberOfSeqItems=this->IndexEntries.size();
+  if (numberOfSeqItems == 0)
+    {
+    return -1;
+    }
+
+  int lowerBound = 0;
+  int upperBound = numberOfSeqItems-1;
 
-    while (upperBound - lowerBound > 1)
+  // Deal with index values not within the range of index values in the Sequence
+  double lowerNumericIndexValue = this->IndexEntries[lowerBound].NumericIndexValue;
+  double upperNumericIndexValue = this->IndexEntries[upperBound].NumericIndexValue;
+  if (numericIndexValue <= lowerNumericIndexValue + this->NumericIndexValueTolerance)
+    {
+    if (numericIndexValue < lowerNumericIndexValue - this->NumericIndexValueTolerance && exactMatchRequired)
       {
-      // Note that if middle is equal to either lowerBound or upperBound then upperBound - lowerBound <= 1
-      int middle = int((lowerBound + upperBound)/2);
-      double middleNumericIndexValue = atof(this->IndexEntries[middle].IndexValue.c_str());
-      if (fabs(numericIndexValue - middleNumericIndexValue) <= this->NumericIndexValueTolerance)
-        {
-        return middle;
-        }
-      if (numericIndexValue > middleNumericIndexValue)
-        {
-        lowerBound = middle;
-        }
-      if (numericIndexValue < middleNumericIndexValue)
-        {
-        upperBound = middle;
-        }
+      return -1;
       }
-    if (!exactMatchRequired)
+    else
       {
       return lowerBound;
       }
     }
-
-  // Need linear search for non-numeric index
-  for (int i=0; i<numberOfSeqItems; i++)
+  if (numericIndexValue >= upperNumericIndexValue - this->NumericIndexValueTolerance)
     {
-    if (this->IndexEntries[i].IndexValue.compare(indexValue)==0)
+    if (numericIndexValue > upperNumericIndexValue + this->NumericIndexValueTolerance && exactMatchRequired)
       {
-      return i;
+      return -1;
+      }
+    else
+      {
+      return upperBound;
       }
     }
 
+  while (upperBound - lowerBound > 1)
+    {
+    // Note that if middle is equal to either lowerBound or upperBound then upperBound - lowerBound <= 1
+    int middle = int((lowerBound + upperBound)/2);
+    double middleNumericIndexValue = this->IndexEntries[middle].NumericIndexValue;
+    if (fabs(numericIndexValue - middleNumericIndexValue) <= this->NumericIndexValueTolerance)
+      {
+      return middle;
+      }
+    if (numericIndexValue > middleNumericIndexValue)
+      {
+      lowerBound = middle;
+      }
+    if (numericIndexValue < middleNumericIndexValue)
+      {
+      upperBound = middle;
+      }
+    }
+  if (!exactMatchRequired)
+    {
+    return lowerBound;
+    }
   return -1;
 }
 
@@ -549,7 +740,35 @@ vtkMRMLNode* vtkMRMLSequenceNode::GetDataNodeAtValue(const std::string& indexVal
     // not found
     return nullptr;
     }
-  return this->IndexEntries[seqItemIndex].DataNode;
+  return this->GetAccessedDataNode(seqItemIndex);
+}
+
+//---------------------------------------------------------------------------
+vtkMRMLNode* vtkMRMLSequenceNode::GetDataNodeAtNumericIndexValue(double indexValue, bool exactMatchRequired /* =true */)
+{
+  if (!this->SequenceScene)
+    {
+    // no data nodes are stored
+    return nullptr;
+    }
+  int seqItemIndex = this->GetItemNumberFromNumericIndexValue(indexValue, exactMatchRequired);
+  if (seqItemIndex < 0)
+    {
+    // not found
+    return nullptr;
+    }
+  return this->GetAccessedDataNode(seqItemIndex);
+}
+
+//---------------------------------------------------------------------------
+double vtkMRMLSequenceNode::GetNthNumericIndexValue(int seqItemIndex)
+{
+  if (seqItemIndex<0 || seqItemIndex>=static_cast<int>(this->IndexEntries.size()))
+    {
+    vtkErrorMacro("vtkMRMLSequenceNode::GetNthNumericIndexValue failed, invalid seqItemIndex value: "<<seqItemIndex);
+    return 0.0;
+    }
+  return this->IndexEntries[seqItemIndex].NumericIndexValue;
 }
 
 //---------------------------------------------------------------------------
@@ -590,6 +809,8 @@ bool vtkMRMLSequenceNode::UpdateIndexValue(const std::string& oldIndexValue, con
     }
   // Update the index value
   this->IndexEntries[oldSeqItemIndex].IndexValue = newIndexValue;
+  this->IndexEntries[oldSeqItemIndex].NumericIndexValue = atof(newIndexValue.c_str());
+  this->IndexEntriesModified();
   if (this->IndexType == vtkMRMLSequenceNode::NumericIndex)
     {
     IndexEntryType movingEntry = this->IndexEntries[oldSeqItemIndex];
@@ -604,6 +825,13 @@ bool vtkMRMLSequenceNode::UpdateIndexValue(const std::string& oldIndexValue, con
   return true;
 }
 
+//-----------------------------------------------------------------------------
+void vtkMRMLSequenceNode::IndexEntriesModified()
+{
+  this->IndexValueToItemNumberValid = false;
+  this->IndexValueToItemNumber.clear();
+}
+
 //-----------------------------------------------------------------------------
 std::string vtkMRMLSequenceNode::GetDataNodeClassName()
 {
@@ -613,6 +841,10 @@ std::string vtkMRMLSequenceNode::GetDataNodeClassName()
     }
   // All the nodes should be of the same class, so just get the class from the first one
   vtkMRMLNode* node=this->IndexEntries[0].DataNode;
+  if (this->IndexEntries[0].CompactTransformIndex >= 0)
+    {
+    return "vtkMRMLLinearTransformNode";
+    }
   if (node==nullptr)
     {
     vtkErrorMacro("vtkMRMLSequenceNode::GetDataNodeClassName node is invalid");
@@ -632,6 +864,10 @@ std::string vtkMRMLSequenceNode::GetDataNodeTagName()
     }
   // All the nodes should be of the same class, so just get the class from the first one
   vtkMRMLNode* node=this->IndexEntries[0].DataNode;
+  if (this->IndexEntries[0].CompactTransformIndex >= 0)
+    {
+    node = this->GetAccessedDataNode(0);
+    }
   if (node==nullptr)
     {
     vtkErrorMacro("vtkMRMLSequenceNode::GetDataNodeClassName node is invalid");
@@ -653,7 +889,22 @@ vtkMRMLNode* vtkMRMLSequenceNode::GetNthDataNode(int itemNumber)
     vtkErrorMacro("vtkMRMLSequenceNode::GetNthDataNode failed: itemNumber "<<itemNumber<<" is out of range");
     return nullptr;
     }
-  return this->IndexEntries[itemNumber].DataNode;
+  return this->GetAccessedDataNode(itemNumber);
+}
+
+//-----------------------------------------------------------------------------
+vtkMRMLNode* vtkMRMLSequenceNode::GetAccessedDataNode(int itemNumber)
+{
+  if (this->IndexEntries[itemNumber].CompactTransformIndex >= 0)
+    {
+    return this->GetCompactTransformDataNode(this->IndexEntries[itemNumber].CompactTransformIndex);
+    }
+  vtkMRMLNode* dataNode = this->IndexEntries[itemNumber].DataNode;
+  if (dataNode && this->HasObserver(vtkMRMLSequenceNode::DataNodeAccessedEvent))
+    {
+    this->InvokeEvent(vtkMRMLSequenceNode::DataNodeAccessedEvent, dataNode);
+    }
+  return dataNode;
 }
 
 //-----------------------------------------------------------------------------
@@ -684,7 +935,8 @@ vtkMRMLStorageNode* vtkMRMLSequenceNode::CreateDefaultStorageNode()
 std::string vtkMRMLSequenceNode::GetDefaultStorageNodeClassName(const char* filename /* =nullptr */)
 {
   // No need to create storage node if there are no nodes to store
-  if (this->GetSequenceScene() == nullptr || this->GetSequenceScene()->GetNumberOfNodes() == 0)
+  if ((this->GetSequenceScene() == nullptr || this->GetSequenceScene()->GetNumberOfNodes() == 0)
+    && this->GetNumberOfCompactlyStoredItems() == 0)
     {
     return "";
     }
@@ -732,7 +984,7 @@ void vtkMRMLSequenceNode::UpdateSequenceIndex()
     }
   for (std::deque< IndexEntryType >::iterator indexIt = this->IndexEntries.begin(); indexIt != this->IndexEntries.end(); ++indexIt)
     {
-    if (indexIt->DataNode == nullptr)
+    if (indexIt->DataNode == nullptr && indexIt->CompactTransformIndex < 0)
       {
       indexIt->DataNode = this->SequenceScene->GetNodeByID(indexIt->DataNodeID);
       if (indexIt->DataNode != nullptr)
@@ -790,25 +1042,101 @@ vtkMRMLNode* vtkMRMLSequenceNode::DeepCopyNodeToScene(vtkMRMLNode* source, vtkMR
     vtkGenericWarningMacro("vtkMRMLSequenceNode::DeepCopyNodeToScene failed, invalid node");
     return nullptr;
     }
-  std::string baseName = "Data";
-  if (source->GetAttribute("Sequences.BaseName") != 0)
+  vtkSmartPointer<vtkMRMLNode> target = vtkSmartPointer<vtkMRMLNode>::Take(source->CreateNodeInstance());
+  target->CopyContent(source); // deep-copy
+  SetDataNodeBaseName(target, source);
+
+  vtkMRMLNode* addedTargetNode = scene->AddNode(target);
+  return addedTargetNode;
+}
+
+//-----------------------------------------------------------
+void vtkMRMLSequenceNode::SetCompactTransformStorage(bool compact)
+{
+  if (this->CompactTransformStorage == compact)
     {
-    baseName = source->GetAttribute("Sequences.BaseName");
+    return;
     }
-  else if (source->GetName() != 0)
+  MRMLNodeModifyBlocker blocker(this);
+  this->CompactTransformStorage = compact;
+  for (IndexEntryType& indexEntry : this->IndexEntries)
     {
-    baseName = source->GetName();
+    if (compact && indexEntry.CompactTransformIndex < 0 && this->CanStoreCompactly(indexEntry.DataNode))
+      {
+      if (this->CompactTransformBaseName.empty())
+        {
+        this->CompactTransformBaseName = GetDataNodeBaseName(indexEntry.DataNode);
+        }
+      indexEntry.CompactTransformIndex = this->StoreCompactTransform(indexEntry.DataNode);
+      this->SequenceScene->RemoveNode(indexEntry.DataNode);
+      indexEntry.DataNode = nullptr;
+      }
+    else if (!compact && indexEntry.CompactTransformIndex >= 0)
+      {
+      indexEntry.DataNode = this->DeepCopyNodeToScene(
+        this->GetCompactTransformDataNode(indexEntry.CompactTransformIndex), this->GetSequenceScene());
+      indexEntry.CompactTransformIndex = -1;
+      }
+    }
+  if (!compact)
+    {
+    this->CompactTransformMatrices->Initialize();
+    this->CompactTransformMatrices->SetNumberOfComponents(16);
+    this->CompactTransformBaseName.clear();
+    this->CompactTransformDataNode = nullptr;
     }
-  std::string newNodeName = baseName;
+  this->Modified();
+}
 
-  vtkSmartPointer<vtkMRMLNode> target = vtkSmartPointer<vtkMRMLNode>::Take(source->CreateNodeInstance());
-  target->CopyContent(source); // deep-copy
+//-----------------------------------------------------------
+int vtkMRMLSequenceNode::GetNumberOfCompactlyStoredItems()
+{
+  int numberOfCompactlyStoredItems = 0;
+  for (const IndexEntryType& indexEntry : this->IndexEntries)
+    {
+    if (indexEntry.CompactTransformIndex >= 0)
+      {
+      ++numberOfCompactlyStoredItems;
+      }
+    }
+  return numberOfCompactlyStoredItems;
+}
 
-  // Generating unique node names is slow, and makes adding many nodes to a sequence too slow
-  // We will instead ensure that all file names for storable nodes are unique when saving
-  target->SetName(newNodeName.c_str());
-  target->SetAttribute("Sequences.BaseName", baseName.c_str());
+//-----------------------------------------------------------
+bool vtkMRMLSequenceNode::CanStoreCompactly(vtkMRMLNode* node)
+{
+  // Only the matrix is stored, therefore subclasses (that may store additional data) are not stored compactly
+  return this->CompactTransformStorage && node && strcmp(node->GetClassName(), "vtkMRMLLinearTransformNode") == 0;
+}
 
-  vtkMRMLNode* addedTargetNode = scene->AddNode(target);
-  return addedTargetNode;
+//-----------------------------------------------------------
+vtkIdType vtkMRMLSequenceNode::StoreCompactTransform(vtkMRMLNode* node, vtkIdType compactTransformIndex/*=-1*/)
+{
+  vtkNew<vtkMatrix4x4> matrix;
+  vtkMRMLLinearTransformNode::SafeDownCast(node)->GetMatrixTransformToParent(matrix);
+  if (compactTransformIndex < 0)
+    {
+    return this->CompactTransformMatrices->InsertNextTuple(&matrix->Element[0][0]);
+    }
+  this->CompactTransformMatrices->SetTuple(compactTransformIndex, &matrix->Element[0][0]);
+  return compactTransformIndex;
+}
+
+//-----------------------------------------------------------
+vtkMRMLNode* vtkMRMLSequenceNode::GetCompactTransformDataNode(vtkIdType compactTransformIndex)
+{
+  if (!this->CompactTransformDataNode)
+    {
+    this->CompactTransformDataNode = vtkSmartPointer<vtkMRMLLinearTransformNode>::New();
+    }
+  if (!this->CompactTransformBaseName.empty()
+    && this->CompactTransformBaseName != SAFE_CHAR_POINTER(this->CompactTransformDataNode->GetName()))
+    {
+    this->CompactTransformDataNode->SetName(this->CompactTransformBaseName.c_str());
+    this->CompactTransformDataNode->SetAttribute("Sequences.BaseName", this->CompactTransformBaseName.c_str());
+    }
+  vtkNew<vtkMatrix4x4> matrix;
+  matrix->DeepCopy(this->CompactTransformMatrices->GetPointer(16 * compactTransformIndex));
+  this->CompactTransformDataNode->SetMatrixTransformToParent(matrix);
+  return this->CompactTransformDataNode;
 }
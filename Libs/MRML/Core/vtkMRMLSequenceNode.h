@@ -22,10 +22,16 @@
 #include <vtkMRML.h>
 #include <vtkMRMLStorableNode.h>
 
+// VTK includes
+#include <vtkSmartPointer.h>
+
 // std includes
 #include <deque>
 #include <set>
+#include <unordered_map>
 
+class vtkDoubleArray;
+class vtkMRMLLinearTransformNode;
 
 /// \brief MRML node for representing a sequence of MRML nodes
 ///
@@ -43,6 +49,10 @@
 /// Class name of data nodes stored in the sequence is set into the `DataNodeClassName`
 /// node attribute, which may be used for attribute-based filters (for example,
 /// to show only certain type of sequence node in a node selector).
+///
+/// If CompactTransformStorage is enabled then linear transforms are not stored as separate
+/// nodes but only their matrices are stored, in a contiguous array. A data node is created only
+/// when an item is accessed, which makes sequences of millions of tracked poses manageable.
 
 class VTK_MRML_EXPORT vtkMRMLSequenceNode : public vtkMRMLStorableNode
 {
@@ -64,6 +74,10 @@ public:
 /// Copy the node's attributes to this object
   void Copy(vtkMRMLNode* node) override;
 
+  /// Get bulk data objects stored in the data nodes of the sequence.
+  /// \sa vtkMRMLNode::GetDataObjects
+  void GetDataObjects(std::vector<vtkDataObject*>& dataObjects) override;
+
   /// Copy sequence index information (index name, unit, type, values, etc)
   /// Does not copy data nodes.
   virtual void CopySequenceIndex(vtkMRMLNode *node);
@@ -103,9 +117,11 @@ public:
 
   /// Add a copy of the provided node to this sequence as a data node.
   /// If a sequence item is not found by that index, a new item is added.
-  /// Always performs deep-copy.
-  /// Returns the data node copy that has just been created.
-  vtkMRMLNode* SetDataNodeAtValue(vtkMRMLNode* node, const std::string& indexValue);
+  /// If copyNode is true (default) then a deep copy of the node is added. If copyNode is false
+  /// then the node itself is added to the sequence's scene (it must not be in any scene yet),
+  /// which is useful if the node is already a copy made for the sequence (e.g., during recording).
+  /// Returns the data node that has just been added.
+  vtkMRMLNode* SetDataNodeAtValue(vtkMRMLNode* node, const std::string& indexValue, bool copyNode = true);
 
   /// Update an existing data node.
   /// Return true if a data node was found by that index.
@@ -127,10 +143,22 @@ public:
   /// Index value of n-th data node.
   std::string GetNthIndexValue(int itemNumber);
 
+  /// Index value of n-th data node, converted to a number.
+  double GetNthNumericIndexValue(int itemNumber);
+
   /// If exact match is not required and index is numeric then the best matching data node is returned.
   /// If the sequences has numeric index, uses data node just before the index value in the case of non-exact match
   int GetItemNumberFromIndexValue(const std::string& indexValue, bool exactMatchRequired = true);
 
+  /// Get item number from a numeric index value, without converting index values from string.
+  /// Only meaningful if the sequence has numeric index.
+  /// If exact match is not required then the data node just before the index value is returned.
+  int GetItemNumberFromNumericIndexValue(double indexValue, bool exactMatchRequired = true);
+
+  /// Get the node corresponding to the specified numeric index value.
+  /// Only meaningful if the sequence has numeric index.
+  vtkMRMLNode* GetDataNodeAtNumericIndexValue(double indexValue, bool exactMatchRequired = true);
+
   /// Change index value of an existing data node.
   bool UpdateIndexValue(const std::string& oldIndexValue, const std::string& newIndexValue);
 
@@ -143,6 +171,23 @@ public:
   /// Return the human-readable type name of the data nodes (e.g., TransformNode). If there are no data nodes yet then it returns the string "undefined".
   std::string GetDataNodeTagName();
 
+  /// Store linear transform nodes (vtkMRMLLinearTransformNode) as matrices in a contiguous array instead
+  /// of as separate nodes in the sequence scene. This reduces memory usage from a few kilobytes to about
+  /// 128 bytes (plus the index value) per item. Nodes of other classes are still stored as nodes.
+  /// Changing the value converts existing items. Disabled by default.
+  ///
+  /// Data nodes of compactly stored items are created on demand: GetNthDataNode, GetDataNodeAtValue, etc.
+  /// return a node that is updated with the matrix of the requested item. The same node may be returned for all
+  /// compactly stored items, therefore it is only valid until the next time a data node is accessed.
+  /// Changes in this node are not saved in the sequence, use UpdateDataNodeAtValue or SetDataNodeAtValue
+  /// to change the item.
+  void SetCompactTransformStorage(bool compact);
+  vtkGetMacro(CompactTransformStorage, bool);
+  vtkBooleanMacro(CompactTransformStorage, bool);
+
+  /// Return number of items that are stored compactly (see CompactTransformStorage).
+  int GetNumberOfCompactlyStoredItems();
+
   /// Return the internal scene that stores all the data nodes.
   /// If autoCreate is enabled then the sequence scene is created
   /// (if it has not been created already).
@@ -169,6 +214,14 @@ public:
     NumberOfIndexTypes // this line must be the last one
     };
 
+  enum
+    {
+    /// Invoked when a data node is accessed (returned by GetNthDataNode, GetDataNodeAtValue, etc.), before it is returned.
+    /// Call data is the data node. Allows loading the content of data nodes on demand, for example
+    /// by vtkMRMLVolumeSequenceStorageNode in lazy loading mode.
+    DataNodeAccessedEvent = 24000
+    };
+
 protected:
   vtkMRMLSequenceNode();
   ~vtkMRMLSequenceNode() override;
@@ -181,13 +234,33 @@ protected:
 
   void ReadIndexValues(const std::string& indexText);
 
+  /// Must be called when index values are changed, inserted, or removed
+  /// to invalidate the index value lookup table.
+  void IndexEntriesModified();
+
   vtkMRMLNode* DeepCopyNodeToScene(vtkMRMLNode* source, vtkMRMLScene* scene);
 
+  /// Get data node of an item and notify observers that it is accessed
+  /// \sa DataNodeAccessedEvent
+  vtkMRMLNode* GetAccessedDataNode(int itemNumber);
+
+  /// Return true if the node can be stored as a matrix (see CompactTransformStorage).
+  bool CanStoreCompactly(vtkMRMLNode* node);
+  /// Store transform matrix of the node in CompactTransformMatrices.
+  /// If compactTransformIndex is negative then a new tuple is added.
+  /// Returns the index of the tuple where the matrix is stored.
+  vtkIdType StoreCompactTransform(vtkMRMLNode* node, vtkIdType compactTransformIndex = -1);
+  /// Update the node that represents compactly stored items with the matrix of an item
+  /// and return it.
+  vtkMRMLNode* GetCompactTransformDataNode(vtkIdType compactTransformIndex);
+
   struct IndexEntryType
     {
     std::string IndexValue;
+    double NumericIndexValue{0.0}; // IndexValue converted to number, to avoid string conversion in lookups
     vtkMRMLNode* DataNode;
     std::string DataNodeID; // only used temporarily, during scene load
+    vtkIdType CompactTransformIndex{-1}; // tuple index in CompactTransformMatrices, -1 if the item is stored as a data node
     };
 
 protected:
@@ -204,6 +277,19 @@ protected:
 
   /// List of data items (the scene may contain some more nodes, such as storage nodes)
   std::deque< IndexEntryType > IndexEntries;
+
+  /// Item number of each index value, for finding items by exact index value match.
+  /// Built on demand, only valid if IndexValueToItemNumberValid is set.
+  std::unordered_map< std::string, int > IndexValueToItemNumber;
+  bool IndexValueToItemNumberValid{false};
+
+  bool CompactTransformStorage{false};
+  /// Matrices of compactly stored items, 16 components per tuple (elements of the 4x4 matrix, row by row).
+  vtkSmartPointer<vtkDoubleArray> CompactTransformMatrices;
+  /// Name of nodes that represent compactly stored items
+  std::string CompactTransformBaseName;
+  /// Node that represents compactly stored items when they are accessed
+  vtkSmartPointer<vtkMRMLLinearTransformNode> CompactTransformDataNode;
 };
 
 #endif
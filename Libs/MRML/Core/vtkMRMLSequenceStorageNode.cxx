@@ -173,7 +173,13 @@ int vtkMRMLSequenceStorageNode::WriteDataInternal(vtkMRMLNode *refNode)
   std::string extension = vtkMRMLStorageNode::GetLowercaseExtensionFromFileName(fullName);
 
   bool success = false;
-  if (extension == ".mrb")
+  if (extension == ".mrb" && sequenceNode->GetNumberOfCompactlyStoredItems() > 0)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLSequenceStorageNode::WriteDataInternal",
+      "Writing sequence node failed: compactly stored transforms cannot be written to .mrb file,"
+      " use linear transform sequence file format (.seq.mha or .seq.lts)");
+    }
+  else if (extension == ".mrb")
     {
     this->ForceUniqueDataNodeFileNames(sequenceNode); // Prevents storable nodes' files from being overwritten due to the same node name
     vtkMRMLScene *sequenceScene=sequenceNode->GetSequenceScene();
@@ -240,17 +246,23 @@ std::string vtkMRMLSequenceStorageNode::GetSequenceBaseName(const std::string& f
     recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + itemName + NODE_BASE_NAME_SEPARATOR + "Seq.seq.mhd");
     recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + itemName + NODE_BASE_NAME_SEPARATOR + "Seq.seq.nrrd");
     recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + itemName + NODE_BASE_NAME_SEPARATOR + "Seq.seq.nhdr");
+    recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + itemName + NODE_BASE_NAME_SEPARATOR + "Seq.seq.lts");
+    recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + itemName + NODE_BASE_NAME_SEPARATOR + "Seq.seq.evs");
     }
   recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + "Seq.seq.mrb");
   recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + "Seq.seq.mha");
   recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + "Seq.seq.mhd");
   recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + "Seq.seq.nrrd");
   recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + "Seq.seq.nhdr");
+  recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + "Seq.seq.lts");
+  recognizedExtensions.push_back(std::string(NODE_BASE_NAME_SEPARATOR) + "Seq.seq.evs");
   recognizedExtensions.push_back(".seq.mrb");
   recognizedExtensions.push_back(".seq.mha");
   recognizedExtensions.push_back(".seq.mhd");
   recognizedExtensions.push_back(".seq.nrrd");
   recognizedExtensions.push_back(".seq.nhdr");
+  recognizedExtensions.push_back(".seq.lts");
+  recognizedExtensions.push_back(".seq.evs");
   recognizedExtensions.push_back(".mrb");
   recognizedExtensions.push_back(".mhd");
   recognizedExtensions.push_back(".mha");
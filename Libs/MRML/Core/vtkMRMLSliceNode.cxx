@@ -97,6 +97,8 @@ vtkMRMLSliceNode::vtkMRMLSliceNode()
   this->WidgetOutlineVisible = 1;
   this->WidgetNormalLockedToCamera = 0;
   this->UseLabelOutline = 0;
+  this->GPUSliceRendering = false;
+  this->InteractionResolutionReduction = 1;
 
   this->LayoutGridColumns = 1;
   this->LayoutGridRows = 1;
@@ -144,6 +146,12 @@ void vtkMRMLSliceNode::SetInteractionFlags(unsigned int flags)
   this->InteractionFlags = flags;
 }
 
+//-----------------------------------------------------------
+int vtkMRMLSliceNode::GetCurrentResolutionReduction()
+{
+  return this->InteractionFlags != 0 ? this->InteractionResolutionReduction : 1;
+}
+
 //-----------------------------------------------------------
 void vtkMRMLSliceNode::SetInteractionFlagsModifier(unsigned int flags)
 {
@@ -944,6 +952,8 @@ void vtkMRMLSliceNode::WriteXML(ostream& of, int nIndent)
   of << " widgetVisibility=\"" << (this->WidgetVisible ? "true" : "false") << "\"";
   of << " widgetOutlineVisibility=\"" << (this->WidgetOutlineVisible ? "true" : "false") << "\"";
   of << " useLabelOutline=\"" << (this->UseLabelOutline ? "true" : "false") << "\"";
+  of << " gpuSliceRendering=\"" << (this->GPUSliceRendering ? "true" : "false") << "\"";
+  of << " interactionResolutionReduction=\"" << this->InteractionResolutionReduction << "\"";
   of << " sliceSpacingMode=\"" << this->SliceSpacingMode << "\"";
   of << " prescribedSliceSpacing=\""
      << this->PrescribedSliceSpacing[0] << " "
@@ -1139,6 +1149,18 @@ void vtkMRMLSliceNode::ReadXMLAttributes(const char** atts)
         this->UseLabelOutline = 0;
         }
       }
+    else if (!strcmp(attName, "gpuSliceRendering"))
+      {
+      this->GPUSliceRendering = !strcmp(attValue, "true");
+      }
+    else if (!strcmp(attName, "interactionResolutionReduction"))
+      {
+      std::stringstream ss;
+      int val;
+      ss << attValue;
+      ss >> val;
+      this->SetInteractionResolutionReduction(val);
+      }
     else if (!strcmp(attName, "orientation"))
       {
       if (strcmp( attValue, vtkMRMLSliceNode::GetReformatOrientationName()))
@@ -1347,6 +1369,8 @@ void vtkMRMLSliceNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*=true*/)
   this->WidgetVisible = node->WidgetVisible;
   this->WidgetOutlineVisible = node->WidgetOutlineVisible;
   this->UseLabelOutline = node->UseLabelOutline;
+  this->GPUSliceRendering = node->GPUSliceRendering;
+  this->InteractionResolutionReduction = node->InteractionResolutionReduction;
 
   this->SliceResolutionMode = node->SliceResolutionMode;
 
@@ -1452,6 +1476,9 @@ void vtkMRMLSliceNode::PrintSelf(ostream& os, vtkIndent indent)
     (this->WidgetOutlineVisible ? "true" : "false") << "\n";
   os << indent << "UseLabelOutline: " <<
     (this->UseLabelOutline ? "true" : "false") << "\n";
+  os << indent << "GPUSliceRendering: " <<
+    (this->GPUSliceRendering ? "true" : "false") << "\n";
+  os << indent << "InteractionResolutionReduction: " << this->InteractionResolutionReduction << "\n";
 
   os << indent << "Jump mode: ";
   if (this->JumpMode == CenteredJumpSlice)
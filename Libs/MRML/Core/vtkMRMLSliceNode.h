@@ -129,6 +129,29 @@ class VTK_MRML_EXPORT vtkMRMLSliceNode : public vtkMRMLAbstractViewNode
   vtkSetMacro(UseLabelOutline, int);
   vtkBooleanMacro(UseLabelOutline, int);
 
+  ///
+  /// Request reslicing, window/level and blending of this slice view to be
+  /// performed on the GPU, using the volume kept resident in a 3D texture.
+  /// Off by default. This is only a hint: views that do not provide a GPU
+  /// slice rendering pipeline keep using the CPU pipeline of vtkMRMLSliceLogic.
+  vtkGetMacro(GPUSliceRendering, bool);
+  vtkSetMacro(GPUSliceRendering, bool);
+  vtkBooleanMacro(GPUSliceRendering, bool);
+
+  ///
+  /// Reduce the resolution of the slice image by this factor along
+  /// each axis of the view while the user interacts with the view
+  /// (InteractionFlags is not 0). The reduced image is upsampled for display
+  /// and the slice is recomputed at full resolution when the interaction ends.
+  /// 1 (default) disables the reduction. Recommended values are 2 and 4.
+  /// \sa GetCurrentResolutionReduction(), SetInteractionFlags()
+  vtkGetMacro(InteractionResolutionReduction, int);
+  vtkSetClampMacro(InteractionResolutionReduction, int, 1, 8);
+
+  /// Resolution reduction factor that applies to the slice image now:
+  /// InteractionResolutionReduction during interaction, 1 otherwise.
+  int GetCurrentResolutionReduction();
+
   /// \brief Set 'standard' radiological convention views of patient space.
   ///
   /// If the associated orientation preset has been renamed or removed, calling
@@ -543,6 +566,8 @@ protected:
   int WidgetOutlineVisible;
   int WidgetNormalLockedToCamera;
   int UseLabelOutline;
+  bool GPUSliceRendering;
+  int InteractionResolutionReduction;
 
   double FieldOfView[3];
   double XYZOrigin[3];
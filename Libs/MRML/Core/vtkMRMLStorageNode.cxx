@@ -79,6 +79,11 @@ vtkMRMLStorageNode::~vtkMRMLStorageNode()
     delete [] this->URI;
     this->URI = nullptr;
     }
+  if (this->PreviewURI)
+    {
+    delete [] this->PreviewURI;
+    this->PreviewURI = nullptr;
+    }
   if ( this->URIHandler )
     {
     // don't delete it, it's obtained from the scene, it's just a pointer
@@ -190,6 +195,10 @@ void vtkMRMLStorageNode::WriteXML(ostream& of, int nIndent)
     {
     of << " uriListMember" << i << "=\"" << vtkMRMLNode::URLEncodeString(this->GetNthURI(i)) << "\"";
     }
+  if (this->PreviewURI != nullptr)
+    {
+    of << " previewURI=\"" << vtkMRMLNode::URLEncodeString(this->PreviewURI) << "\"";
+    }
 
   std::stringstream ss;
   ss << this->UseCompression;
@@ -315,6 +324,11 @@ void vtkMRMLStorageNode::ReadXMLAttributes(const char** atts)
       std::string uri = vtkMRMLNode::URLDecodeString(attValue);
       this->SetURI(uri.c_str());
       }
+    else if (!strcmp(attName, "previewURI"))
+      {
+      std::string uri = vtkMRMLNode::URLDecodeString(attValue);
+      this->SetPreviewURI(uri.c_str());
+      }
     else if (!strncmp(attName, "uriListMember", 13))
       {
       std::string uri = vtkMRMLNode::URLDecodeString(attValue);
@@ -364,6 +378,7 @@ void vtkMRMLStorageNode::Copy(vtkMRMLNode *anode)
   this->SetFileName(node->FileName);
   this->FileNameList = node->FileNameList; // a loop on AddFileName would be n log(n)
   this->SetURI(node->URI);
+  this->SetPreviewURI(node->PreviewURI);
   this->ResetURIList();
   for (int i = 0; i < node->GetNumberOfURIs(); i++)
     {
@@ -396,6 +411,8 @@ void vtkMRMLStorageNode::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "URIListMember: " << this->GetNthURI(i) << "\n";
     }
+  os << indent << "PreviewURI: " <<
+    (this->PreviewURI ? this->PreviewURI : "(none)") << "\n";
   os << indent << "UseCompression:   " << this->UseCompression << "\n";
   if (!this->CompressionParameter.empty())
     {
@@ -1244,19 +1261,34 @@ int vtkMRMLStorageNode::ReadData(vtkMRMLNode* refNode, bool temporary)
     return 0;
     }
 
-  this->StageReadData(refNode);
-  if ( this->GetReadState() != this->TransferDone )
+  vtkMRMLStorableNode* storableNode = vtkMRMLStorableNode::SafeDownCast(refNode);
+  vtkSmartPointer<vtkMRMLStorableNode> decodedNode = this->DecodedNode;
+  this->DecodedNode = nullptr;
+  int success = 0;
+  if (decodedNode && storableNode && strcmp(decodedNode->GetClassName(), storableNode->GetClassName()) == 0)
+    {
+    // data has been read already, only the content is copied, the node keeps
+    // its name, references and display nodes
+    vtkDebugMacro("ReadData: using already decoded data, "
+      << "filename = " << (this->GetFileName() == nullptr ? "null" : this->GetFileName()));
+    storableNode->CopyContent(decodedNode, /*deepCopy*/false);
+    success = 1;
+    }
+  else
     {
-    // remote file download hasn't finished
-    vtkWarningToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStorageNode::ReadData",
-      "ReadData: read state is pending, remote download hasn't finished yet");
-    return 0;
+    this->StageReadData(refNode);
+    if ( this->GetReadState() != this->TransferDone )
+      {
+      // remote file download hasn't finished
+      vtkWarningToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStorageNode::ReadData",
+        "ReadData: read state is pending, remote download hasn't finished yet");
+      return 0;
+      }
+    vtkDebugMacro("ReadData: read state is ready, "
+      <<  "URI = " << (this->GetURI() == nullptr ? "null" : this->GetURI()) << ", "
+      << "filename = " << (this->GetFileName() == nullptr ? "null" : this->GetFileName()));
+    success = this->ReadDataInternal(refNode);
     }
-  vtkDebugMacro("ReadData: read state is ready, "
-    <<  "URI = " << (this->GetURI() == nullptr ? "null" : this->GetURI()) << ", "
-    << "filename = " << (this->GetFileName() == nullptr ? "null" : this->GetFileName()));
-  vtkMRMLStorableNode* storableNode = vtkMRMLStorableNode::SafeDownCast(refNode);
-  int success = this->ReadDataInternal(refNode);
   if (!success)
     {
     // failed
@@ -1308,6 +1340,45 @@ int vtkMRMLStorageNode::ReadData(vtkMRMLNode* refNode, bool temporary)
   return success;
 }
 
+//------------------------------------------------------------------------------
+void vtkMRMLStorageNode::SetDecodedNode(vtkMRMLStorableNode* decodedNode)
+{
+  this->DecodedNode = decodedNode;
+}
+
+//------------------------------------------------------------------------------
+int vtkMRMLStorageNode::ReadPreviewData(vtkMRMLNode* refNode, const char* previewFileName)
+{
+  if (refNode == nullptr || previewFileName == nullptr)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStorageNode::ReadPreviewData",
+      "Cannot read preview: invalid node or file name.");
+    return 0;
+    }
+  if (!this->CanReadInReferenceNode(refNode))
+    {
+    return 0;
+    }
+  // Read the preview file as if it was the file of the storage node,
+  // without notifying observers about the temporary file name change.
+  std::string fileName = this->FileName ? this->FileName : "";
+  std::vector<std::string> fileNameList = this->FileNameList;
+  int wasModifying = this->StartModify();
+  this->SetFileName(previewFileName);
+  this->FileNameList.clear();
+  int success = this->ReadDataInternal(refNode);
+  this->SetFileName(fileName.empty() ? nullptr : fileName.c_str());
+  this->FileNameList = fileNameList;
+  // file name is restored, so the modified event is not invoked
+  this->SetDisableModifiedEvent(wasModifying);
+  if (!success)
+    {
+    vtkWarningToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStorageNode::ReadPreviewData",
+      "Failed to read preview from " << previewFileName);
+    }
+  return success;
+}
+
 //------------------------------------------------------------------------------
 int vtkMRMLStorageNode::WriteData(vtkMRMLNode* refNode)
 {
@@ -1356,6 +1427,30 @@ int vtkMRMLStorageNode::WriteDataInternal(vtkMRMLNode* vtkNotUsed(refNode))
   return 0;
 }
 
+//------------------------------------------------------------------------------
+vtkMRMLNode* vtkMRMLStorageNode::GetNodeFromMemoryReference(const char* fileName)
+{
+  // slicer:<scene pointer>#<node ID>, remote references (slicer://) are not supported
+  if (fileName == nullptr
+    || strncmp(fileName, "slicer:", 7) != 0
+    || strncmp(fileName, "slicer://", 9) == 0)
+    {
+    return nullptr;
+    }
+  const char* nodeID = strchr(fileName, '#');
+  if (nodeID == nullptr || *(nodeID + 1) == '\0')
+    {
+    return nullptr;
+    }
+  void* scenePointer = nullptr;
+  if (sscanf(fileName + 7, "%p", &scenePointer) != 1 || scenePointer == nullptr)
+    {
+    return nullptr;
+    }
+  vtkMRMLScene* scene = reinterpret_cast<vtkMRMLScene*>(scenePointer);
+  return scene->GetNodeByID(nodeID + 1);
+}
+
 //------------------------------------------------------------------------------
 std::string vtkMRMLStorageNode::GetLowercaseExtensionFromFileName(const std::string& filename)
 {
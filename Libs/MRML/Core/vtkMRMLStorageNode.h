@@ -59,6 +59,15 @@ public:
   /// \sa SetFileName(), ReadDataInternal(), GetStoredTime()
   virtual int ReadData(vtkMRMLNode *refNode, bool temporaryFile = false);
 
+  ///
+  /// Read a low resolution preview of the data from a local file (for example the
+  /// downloaded copy of PreviewURI) and set it in the referenced node.
+  /// File name, URI and read state of the storage node are not changed, so that
+  /// the full resolution data can be read by ReadData when it becomes available.
+  /// Return 1 on success, 0 on failure.
+  /// \sa SetPreviewURI()
+  virtual int ReadPreviewData(vtkMRMLNode *refNode, const char* previewFileName);
+
   ///
   /// Write data from a  referenced node
   /// Return 1 on success, 0 on failure.
@@ -105,6 +114,14 @@ public:
   vtkSetStringMacro(URI);
   vtkGetStringMacro(URI);
 
+  ///
+  /// Location of a low resolution copy of the remote file (for example a downsampled
+  /// version of a large volume, in the same physical space). When the remote file is
+  /// downloaded asynchronously, the preview is downloaded and read first, so that the
+  /// data can be shown while the full resolution file is being downloaded.
+  vtkSetStringMacro(PreviewURI);
+  vtkGetStringMacro(PreviewURI);
+
   vtkGetObjectMacro (URIHandler, vtkURIHandler);
   virtual void SetURIHandler(vtkURIHandler* uriHandler);
 
@@ -303,6 +320,28 @@ public:
   /// \sa CanReadInReferenceNode, WriteData
   virtual bool CanWriteFromReferenceNode(vtkMRMLNode* refNode);
 
+  /// Return true if WriteData can be called from a worker thread, concurrently with
+  /// WriteData of other storage nodes. The implementation must not modify the scene
+  /// or shared objects and must not invoke events that observers in other threads may process
+  /// (modified events are postponed by the caller).
+  /// By default it returns false. Subclasses can reimplement the method.
+  /// \sa vtkMRMLScene::SetParallelWriteData
+  virtual bool IsWriteDataThreadSafe() { return false; };
+
+  /// Return true if ReadData can be called from a worker thread, for reading the file into
+  /// a node that is not in the scene. The same restrictions apply as for IsWriteDataThreadSafe().
+  /// By default it returns false. Subclasses can reimplement the method.
+  /// \sa vtkSlicerApplicationLogic::RequestReadFile
+  virtual bool IsReadDataThreadSafe() { return false; };
+
+  /// Set a node that already contains the data read from the file of this storage node
+  /// (typically read in a worker thread into a node that is not in the scene).
+  /// The next ReadData call copies the content of the decoded node (without deep copy)
+  /// into the reference node instead of reading the file, if the reference node
+  /// has the same class as the decoded node. The decoded node is released by ReadData.
+  /// \sa vtkMRMLScene::SetParallelReadData
+  void SetDecodedNode(vtkMRMLStorableNode* decodedNode);
+
   ///
   /// Configure the storage node for data exchange. This is an
   /// opportunity to optimize the storage node's settings, for
@@ -313,6 +352,14 @@ public:
   /// It always returns lowercase extension.
   static std::string GetLowercaseExtensionFromFileName(const std::string& filename);
 
+  /// Get the node referenced by a file name of the form
+  /// <code>slicer:\<scene pointer\>#\<node ID\></code>.
+  /// Such file names are used to pass nodes to shared object command line modules
+  /// without writing them to disk. Storage nodes that support memory references
+  /// share the data of the returned node instead of reading/writing a file.
+  /// Returns nullptr if the file name is not a memory reference or if the node is not found.
+  static vtkMRMLNode* GetNodeFromMemoryReference(const char* fileName);
+
   /// Remove supported extension from filename.
   /// If filename is not specified then the current FileName will be used.
   std::string GetFileNameWithoutExtension(const char* fileName = nullptr);
@@ -404,6 +451,7 @@ protected:
   char *FileName;
   char *TempFileName;
   char *URI;
+  char *PreviewURI{nullptr};
   vtkURIHandler *URIHandler;
   int UseCompression;
   int ReadState;
@@ -446,6 +494,10 @@ protected:
 
   vtkWeakPointer<vtkMRMLStorableNode> LastFoundStorableNode;
 
+  /// Node that contains the data that was already read from file.
+  /// \sa SetDecodedNode
+  vtkSmartPointer<vtkMRMLStorableNode> DecodedNode;
+
   // Record warnings and errors associated with this
   // vtkMRMLStorableNode.
   vtkMRMLMessageCollection *UserMessages;
@@ -172,6 +172,19 @@ bool vtkMRMLStreamingVolumeNode::HasExternalImageObserver()
 
 //---------------------------------------------------------------------------
 void vtkMRMLStreamingVolumeNode::SetAndObserveFrame(vtkStreamingVolumeFrame* frame)
+{
+  this->SetAndObserveFrameInternal(frame, false);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeNode::SetPrefetchedImageData(vtkStreamingVolumeFrame* frame, vtkImageData* imageData)
+{
+  this->PrefetchedFrame = imageData ? frame : nullptr;
+  this->PrefetchedImageData = frame ? imageData : nullptr;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeNode::SetAndObserveFrameInternal(vtkStreamingVolumeFrame* frame, bool frameDecoded)
 {
   if (this->Frame == frame)
     {
@@ -184,7 +197,7 @@ void vtkMRMLStreamingVolumeNode::SetAndObserveFrame(vtkStreamingVolumeFrame* fra
     }
 
   this->Frame = frame;
-  this->FrameDecoded = false;
+  this->FrameDecoded = frameDecoded;
 
   if (this->Frame)
     {
@@ -197,7 +210,7 @@ void vtkMRMLStreamingVolumeNode::SetAndObserveFrame(vtkStreamingVolumeFrame* fra
 
     // If the image is being observed beyond the default internal observations of the volume node, then the frame should be decoded
     // since some external class is observing the image data.
-    if (this->HasExternalImageObserver())
+    if (!this->FrameDecoded && this->HasExternalImageObserver())
       {
       this->DecodeFrame();
       }
@@ -264,6 +277,33 @@ bool vtkMRMLStreamingVolumeNode::DecodeFrame()
   return success;
 }
 
+//---------------------------------------------------------------------------
+std::string vtkMRMLStreamingVolumeNode::GetDefaultSequenceStorageNodeClassName()
+{
+  if (this->Frame)
+    {
+    // Keep frames compressed in the sequence file
+    return "vtkMRMLStreamingVolumeSequenceStorageNode";
+    }
+  return Superclass::GetDefaultSequenceStorageNodeClassName();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeNode::ReleaseDecodedImageData()
+{
+  if (!this->Frame || this->HasExternalImageObserver())
+    {
+    // The image is the only representation of the content or it is in use
+    return;
+    }
+  // Prevent SetAndObserveImageData from discarding the frame
+  this->FrameDecodingInProgress = true;
+  Superclass::SetAndObserveImageData(nullptr);
+  this->FrameDecodingInProgress = false;
+  this->FrameDecoded = false;
+  this->SetPrefetchedImageData(nullptr, nullptr);
+}
+
 //---------------------------------------------------------------------------
 bool vtkMRMLStreamingVolumeNode::EncodeImageData(bool forceKeyFrame/*=false*/)
 {
@@ -287,8 +327,8 @@ bool vtkMRMLStreamingVolumeNode::EncodeImageData(bool forceKeyFrame/*=false*/)
     return false;
     }
 
-  this->FrameDecoded = true;
-  this->SetAndObserveFrame(frame);
+  // The image data is the source of the frame, it does not need to be decoded
+  this->SetAndObserveFrameInternal(frame, true);
 
   return true;
 }
@@ -341,6 +381,7 @@ void vtkMRMLStreamingVolumeNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*
 {
   MRMLNodeModifyBlocker blocker(this);
 
+  bool frameDecoded = false;
   vtkMRMLStreamingVolumeNode* streamingVolumeNode = vtkMRMLStreamingVolumeNode::SafeDownCast(anode);
   if (!streamingVolumeNode)
     {
@@ -363,7 +404,16 @@ void vtkMRMLStreamingVolumeNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*
         streamingVolumeNode->ImageDataConnection->GetIndex()) : nullptr);
 
     vtkSmartPointer<vtkImageData> targetImageData = sourceImageData;
-    if (deepCopy && sourceImageData)
+    if (streamingVolumeNode->PrefetchedImageData
+      && streamingVolumeNode->PrefetchedFrame == streamingVolumeNode->Frame)
+      {
+      // The frame has been decoded already, take the image instead of decoding the frame again.
+      // The prefetched image is not referenced by the source node, therefore it does not need to be deep-copied.
+      targetImageData = streamingVolumeNode->PrefetchedImageData;
+      frameDecoded = true;
+      streamingVolumeNode->SetPrefetchedImageData(nullptr, nullptr);
+      }
+    else if (deepCopy && sourceImageData)
       {
       targetImageData = vtkSmartPointer<vtkImageData>::Take(sourceImageData->NewInstance());
       targetImageData->DeepCopy(sourceImageData);
@@ -380,7 +430,7 @@ void vtkMRMLStreamingVolumeNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*
 
   vtkMRMLCopyBeginMacro(anode);
   vtkMRMLCopyStdStringMacro(CodecFourCC);
-  this->SetAndObserveFrame(this->SafeDownCast(copySourceNode)->GetFrame());
+  this->SetAndObserveFrameInternal(this->SafeDownCast(copySourceNode)->GetFrame(), frameDecoded);
   vtkMRMLCopyStdStringMacro(CodecParameterString);
   vtkMRMLCopyEndMacro();
 }
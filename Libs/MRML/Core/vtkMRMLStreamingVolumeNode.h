@@ -80,6 +80,13 @@ public:
   /// Returns a pointer to the current frame
   vtkStreamingVolumeFrame* GetFrame(){return this->Frame.GetPointer();};
 
+  /// Set an image that has already been decoded from the specified frame (for example,
+  /// ahead of time by a playback prefetcher running in a background thread).
+  /// The image is not used by this node but it is handed over to the next node that copies
+  /// the content of this node while the frame is still current, so that the copy does not need
+  /// to decode the frame again.
+  void SetPrefetchedImageData(vtkStreamingVolumeFrame* frame, vtkImageData* imageData);
+
   /// Encodes the current vtkImageData as a compressed frame using the specified codec
   /// Returns true if the image is successfully encoded
   virtual bool EncodeImageData(bool forceKeyFrame = false);
@@ -88,6 +95,16 @@ public:
   /// Returns true if the frame is successfully decoded
   virtual bool DecodeFrame();
 
+  /// Sequences of compressed frames are stored using vtkMRMLStreamingVolumeSequenceStorageNode,
+  /// which writes the frames without decoding them.
+  std::string GetDefaultSequenceStorageNodeClassName() override;
+
+  /// Delete the decoded image, only keep the compressed frame.
+  /// The image is decoded again when it is accessed (see GetImageData).
+  /// This is used for storing long sequences of frames in memory.
+  /// The image is kept if there is no frame or the image is observed by other classes.
+  void ReleaseDecodedImageData();
+
   /// Returns true if the current frame is a keyframe
   /// Keyframes are not interpolated and don't require any additional frames in order to be decoded to an uncompressed image
   virtual bool IsKeyFrame();
@@ -126,6 +143,10 @@ protected:
   /// Returns true if the number of observers on the ImageData or ImageDataConnection is greater than the default expected number
   bool HasExternalImageObserver();
 
+  /// Set and observe the frame object.
+  /// If frameDecoded is true then the current image data is already decoded from the frame.
+  void SetAndObserveFrameInternal(vtkStreamingVolumeFrame* frame, bool frameDecoded);
+
 protected:
   vtkSmartPointer<vtkStreamingVolumeCodec> Codec;
   std::string                              CodecFourCC;
@@ -133,6 +154,8 @@ protected:
   bool                                     FrameDecoded{false};
   bool                                     FrameDecodingInProgress{false};
   vtkSmartPointer<vtkCallbackCommand>      FrameModifiedCallbackCommand;
+  vtkSmartPointer<vtkStreamingVolumeFrame> PrefetchedFrame;
+  vtkSmartPointer<vtkImageData>            PrefetchedImageData;
 
 };
 
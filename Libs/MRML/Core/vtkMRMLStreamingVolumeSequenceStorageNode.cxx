@@ -0,0 +1,362 @@
+/*=auto=========================================================================
+
+Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+See COPYRIGHT.txt
+or http://www.slicer.org/copyright/copyright.txt for details.
+
+=========================================================================auto=*/
+
+// MRML includes
+#include "vtkMRMLMessageCollection.h"
+#include "vtkMRMLSequenceNode.h"
+#include "vtkMRMLSequenceStorageNode.h"
+#include "vtkMRMLStreamingVolumeNode.h"
+#include "vtkMRMLStreamingVolumeSequenceStorageNode.h"
+
+// vtkAddon includes
+#include <vtkStreamingVolumeFrame.h>
+
+// VTK includes
+#include <vtkByteSwap.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkStringArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtksys/SystemTools.hxx>
+
+// STD includes
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+static const char STREAMING_VOLUME_SEQUENCE_FILE_MAGIC[] = "SEVSEQ1\n"; // written without the terminating null character
+
+//----------------------------------------------------------------------------
+vtkMRMLNodeNewMacro(vtkMRMLStreamingVolumeSequenceStorageNode);
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+void WriteUInt64(std::ostream& stream, vtkTypeUInt64 value)
+{
+  vtkByteSwap::SwapLE(&value);
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+//----------------------------------------------------------------------------
+bool ReadUInt64(std::istream& stream, vtkTypeUInt64& value)
+{
+  if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+    {
+    return false;
+    }
+  vtkByteSwap::SwapLE(&value);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void WriteString(std::ostream& stream, const std::string& text)
+{
+  WriteUInt64(stream, static_cast<vtkTypeUInt64>(text.size()));
+  stream.write(text.data(), text.size());
+}
+
+//----------------------------------------------------------------------------
+bool ReadString(std::istream& stream, std::string& text)
+{
+  vtkTypeUInt64 length = 0;
+  // Strings are only short names, a very large length indicates a corrupted file
+  if (!ReadUInt64(stream, length) || length > 65536)
+    {
+    return false;
+    }
+  text.resize(static_cast<size_t>(length));
+  return length == 0 || static_cast<bool>(stream.read(&text[0], static_cast<std::streamsize>(length)));
+}
+
+//----------------------------------------------------------------------------
+void WriteMatrix(std::ostream& stream, vtkMatrix4x4* matrix)
+{
+  double elements[16];
+  std::copy(&matrix->Element[0][0], &matrix->Element[0][0] + 16, elements);
+  vtkByteSwap::SwapLERange(elements, 16);
+  stream.write(reinterpret_cast<const char*>(elements), sizeof(elements));
+}
+
+//----------------------------------------------------------------------------
+bool ReadMatrix(std::istream& stream, vtkMatrix4x4* matrix)
+{
+  double elements[16];
+  if (!stream.read(reinterpret_cast<char*>(elements), sizeof(elements)))
+    {
+    return false;
+    }
+  vtkByteSwap::SwapLERange(elements, 16);
+  matrix->DeepCopy(elements);
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkMRMLStreamingVolumeSequenceStorageNode::vtkMRMLStreamingVolumeSequenceStorageNode() = default;
+
+//----------------------------------------------------------------------------
+vtkMRMLStreamingVolumeSequenceStorageNode::~vtkMRMLStreamingVolumeSequenceStorageNode() = default;
+
+//----------------------------------------------------------------------------
+bool vtkMRMLStreamingVolumeSequenceStorageNode::CanReadInReferenceNode(vtkMRMLNode *refNode)
+{
+  return refNode->IsA("vtkMRMLSequenceNode");
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLStreamingVolumeSequenceStorageNode::ReadDataInternal(vtkMRMLNode* refNode)
+{
+  vtkMRMLSequenceNode* sequenceNode = vtkMRMLSequenceNode::SafeDownCast(refNode);
+  if (!sequenceNode)
+    {
+    vtkErrorMacro("ReadDataInternal: not a Sequence node.");
+    return 0;
+    }
+
+  std::string fullName = this->GetFullNameFromFileName();
+  if (fullName.empty())
+    {
+    vtkErrorMacro("ReadData: File name not specified");
+    return 0;
+    }
+
+  std::ifstream stream(fullName.c_str(), std::ios::in | std::ios::binary);
+  if (!stream)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStreamingVolumeSequenceStorageNode::ReadDataInternal",
+      "Failed to open file for reading: " << fullName);
+    return 0;
+    }
+
+  std::string magic(sizeof(STREAMING_VOLUME_SEQUENCE_FILE_MAGIC) - 1, '\0');
+  vtkTypeUInt64 indexType = 0;
+  vtkTypeUInt64 numberOfFrames = 0;
+  std::string volumeName;
+  std::string indexName;
+  std::string indexUnit;
+  std::string codecFourCC;
+  if (!stream.read(&magic[0], magic.size()) || magic != STREAMING_VOLUME_SEQUENCE_FILE_MAGIC
+    || !ReadUInt64(stream, indexType) || !ReadUInt64(stream, numberOfFrames)
+    || !ReadString(stream, volumeName) || !ReadString(stream, indexName) || !ReadString(stream, indexUnit)
+    || !ReadString(stream, codecFourCC))
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStreamingVolumeSequenceStorageNode::ReadDataInternal",
+      "Invalid streaming volume sequence file header: " << fullName);
+    return 0;
+    }
+
+  // Make sure a corrupted frame size does not make us allocate an extremely large buffer
+  std::streamoff headerSize = stream.tellg();
+  stream.seekg(0, std::ios::end);
+  vtkTypeUInt64 fileSize = static_cast<vtkTypeUInt64>(stream.tellg());
+  stream.seekg(headerSize);
+
+  MRMLNodeModifyBlocker blocker(sequenceNode);
+  sequenceNode->RemoveAllDataNodes();
+  sequenceNode->SetIndexType(static_cast<int>(indexType));
+  sequenceNode->SetIndexName(indexName);
+  sequenceNode->SetIndexUnit(indexUnit);
+
+  vtkNew<vtkMatrix4x4> ijkToRasMatrix;
+  vtkSmartPointer<vtkStreamingVolumeFrame> previousFrame;
+  for (vtkTypeUInt64 frameNumber = 0; frameNumber < numberOfFrames; ++frameNumber)
+    {
+    std::string indexValue;
+    vtkTypeUInt64 frameType = 0;
+    vtkTypeUInt64 dimensions[3] = { 0, 0, 0 };
+    vtkTypeUInt64 numberOfComponents = 0;
+    vtkTypeUInt64 scalarType = 0;
+    vtkTypeUInt64 frameDataSize = 0;
+    if (!ReadString(stream, indexValue) || !ReadMatrix(stream, ijkToRasMatrix)
+      || !ReadUInt64(stream, frameType) || !ReadUInt64(stream, dimensions[0]) || !ReadUInt64(stream, dimensions[1])
+      || !ReadUInt64(stream, dimensions[2]) || !ReadUInt64(stream, numberOfComponents) || !ReadUInt64(stream, scalarType)
+      || !ReadUInt64(stream, frameDataSize) || frameDataSize > fileSize)
+      {
+      vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStreamingVolumeSequenceStorageNode::ReadDataInternal",
+        "Failed to read frame " << frameNumber << " from streaming volume sequence file: " << fullName);
+      return 0;
+      }
+    vtkNew<vtkUnsignedCharArray> frameData;
+    frameData->SetNumberOfValues(static_cast<vtkIdType>(frameDataSize));
+    if (frameDataSize > 0
+      && !stream.read(reinterpret_cast<char*>(frameData->GetPointer(0)), static_cast<std::streamsize>(frameDataSize)))
+      {
+      vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStreamingVolumeSequenceStorageNode::ReadDataInternal",
+        "Streaming volume sequence file is truncated at frame " << frameNumber << ": " << fullName);
+      return 0;
+      }
+
+    vtkSmartPointer<vtkStreamingVolumeFrame> frame = vtkSmartPointer<vtkStreamingVolumeFrame>::New();
+    frame->SetFrameType(static_cast<int>(frameType));
+    frame->SetDimensions(static_cast<int>(dimensions[0]), static_cast<int>(dimensions[1]), static_cast<int>(dimensions[2]));
+    frame->SetNumberOfComponents(static_cast<int>(numberOfComponents));
+    frame->SetVTKScalarType(static_cast<int>(scalarType));
+    frame->SetCodecFourCC(codecFourCC);
+    frame->SetFrameData(frameData);
+    if (!frame->IsKeyFrame())
+      {
+      // Decoding of the frame requires the preceding frames, starting from the last keyframe
+      frame->SetPreviousFrame(previousFrame);
+      }
+    previousFrame = frame;
+
+    vtkNew<vtkMRMLStreamingVolumeNode> volumeNode;
+    std::ostringstream nameStr;
+    nameStr << volumeName << "_" << std::setw(4) << std::setfill('0') << frameNumber;
+    volumeNode->SetName(nameStr.str().c_str());
+    volumeNode->SetIJKToRASMatrix(ijkToRasMatrix);
+    volumeNode->SetCodecFourCC(codecFourCC);
+    // Frame is decoded when the image data is accessed
+    volumeNode->SetAndObserveFrame(frame);
+    // The node is not used anywhere else, so it is added to the sequence without making a copy
+    sequenceNode->SetDataNodeAtValue(volumeNode, indexValue, false);
+    }
+
+  std::string baseNodeName = vtkMRMLSequenceStorageNode::GetSequenceBaseName(vtksys::SystemTools::GetFilenameName(fullName), volumeName);
+  sequenceNode->SetName(vtkMRMLSequenceStorageNode::GetSequenceNodeName(baseNodeName, volumeName).c_str());
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLStreamingVolumeSequenceStorageNode::CanWriteFromReferenceNode(vtkMRMLNode *refNode)
+{
+  vtkMRMLSequenceNode* sequenceNode = vtkMRMLSequenceNode::SafeDownCast(refNode);
+  if (!sequenceNode)
+    {
+    vtkDebugMacro("CanWriteFromReferenceNode: Only sequence nodes can be written in this format.");
+    return false;
+    }
+  std::string codecFourCC;
+  int numberOfFrames = sequenceNode->GetNumberOfDataNodes();
+  for (int frameIndex = 0; frameIndex < numberOfFrames; frameIndex++)
+    {
+    vtkMRMLStreamingVolumeNode* volumeNode = vtkMRMLStreamingVolumeNode::SafeDownCast(sequenceNode->GetNthDataNode(frameIndex));
+    if (!volumeNode || !volumeNode->GetFrame())
+      {
+      vtkDebugMacro("CanWriteFromReferenceNode: only streaming volume nodes with compressed frames can be written (frame " << frameIndex << ")");
+      return false;
+      }
+    if (frameIndex == 0)
+      {
+      codecFourCC = volumeNode->GetFrame()->GetCodecFourCC();
+      }
+    else if (volumeNode->GetFrame()->GetCodecFourCC() != codecFourCC)
+      {
+      vtkDebugMacro("CanWriteFromReferenceNode: all frames must be compressed with the same codec (frame " << frameIndex << ")");
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLStreamingVolumeSequenceStorageNode::WriteDataInternal(vtkMRMLNode *refNode)
+{
+  vtkMRMLSequenceNode* sequenceNode = vtkMRMLSequenceNode::SafeDownCast(refNode);
+  if (!sequenceNode)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStreamingVolumeSequenceStorageNode::WriteDataInternal",
+      "Only sequence nodes can be written in this format.");
+    return 0;
+    }
+  if (!this->CanWriteFromReferenceNode(sequenceNode))
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStreamingVolumeSequenceStorageNode::WriteDataInternal",
+      "Only sequences of streaming volumes that are compressed with the same codec can be written in this format.");
+    return 0;
+    }
+
+  std::string fullName = this->GetFullNameFromFileName();
+  if (fullName.empty())
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStreamingVolumeSequenceStorageNode::WriteDataInternal",
+      "File name is not specified.");
+    return 0;
+    }
+
+  std::ofstream stream(fullName.c_str(), std::ios::out | std::ios::binary);
+  if (!stream)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStreamingVolumeSequenceStorageNode::WriteDataInternal",
+      "Failed to open file for writing: " << fullName);
+    return 0;
+    }
+
+  int numberOfFrames = sequenceNode->GetNumberOfDataNodes();
+  std::string codecFourCC;
+  if (numberOfFrames > 0)
+    {
+    codecFourCC = vtkMRMLStreamingVolumeNode::SafeDownCast(sequenceNode->GetNthDataNode(0))->GetFrame()->GetCodecFourCC();
+    }
+  stream.write(STREAMING_VOLUME_SEQUENCE_FILE_MAGIC, sizeof(STREAMING_VOLUME_SEQUENCE_FILE_MAGIC) - 1);
+  WriteUInt64(stream, static_cast<vtkTypeUInt64>(sequenceNode->GetIndexType()));
+  WriteUInt64(stream, static_cast<vtkTypeUInt64>(numberOfFrames));
+  WriteString(stream, sequenceNode->GetName() ? sequenceNode->GetName() : "");
+  WriteString(stream, sequenceNode->GetIndexName());
+  WriteString(stream, sequenceNode->GetIndexUnit());
+  WriteString(stream, codecFourCC);
+
+  vtkNew<vtkMatrix4x4> ijkToRasMatrix;
+  for (int frameIndex = 0; frameIndex < numberOfFrames && stream; frameIndex++)
+    {
+    vtkMRMLStreamingVolumeNode* volumeNode = vtkMRMLStreamingVolumeNode::SafeDownCast(sequenceNode->GetNthDataNode(frameIndex));
+    vtkStreamingVolumeFrame* frame = volumeNode->GetFrame();
+    int dimensions[3] = { 0, 0, 0 };
+    frame->GetDimensions(dimensions);
+    volumeNode->GetIJKToRASMatrix(ijkToRasMatrix);
+    vtkUnsignedCharArray* frameData = frame->GetFrameData();
+    vtkTypeUInt64 frameDataSize = frameData ? static_cast<vtkTypeUInt64>(frameData->GetNumberOfValues()) : 0;
+
+    WriteString(stream, sequenceNode->GetNthIndexValue(frameIndex));
+    WriteMatrix(stream, ijkToRasMatrix);
+    WriteUInt64(stream, static_cast<vtkTypeUInt64>(frame->GetFrameType()));
+    for (int i = 0; i < 3; ++i)
+      {
+      WriteUInt64(stream, static_cast<vtkTypeUInt64>(dimensions[i]));
+      }
+    WriteUInt64(stream, static_cast<vtkTypeUInt64>(frame->GetNumberOfComponents()));
+    WriteUInt64(stream, static_cast<vtkTypeUInt64>(frame->GetVTKScalarType()));
+    WriteUInt64(stream, frameDataSize);
+    if (frameDataSize > 0)
+      {
+      stream.write(reinterpret_cast<const char*>(frameData->GetPointer(0)), static_cast<std::streamsize>(frameDataSize));
+      }
+    }
+  if (!stream)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLStreamingVolumeSequenceStorageNode::WriteDataInternal",
+      "Failed to write frames to file: " << fullName);
+    return 0;
+    }
+
+  this->StageWriteData(refNode);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeSequenceStorageNode::InitializeSupportedReadFileTypes()
+{
+  this->SupportedReadFileTypes->InsertNextValue("Streaming volume sequence (.seq.evs)");
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeSequenceStorageNode::InitializeSupportedWriteFileTypes()
+{
+  this->SupportedWriteFileTypes->InsertNextValue("Streaming volume sequence (.seq.evs)");
+}
+
+//----------------------------------------------------------------------------
+const char* vtkMRMLStreamingVolumeSequenceStorageNode::GetDefaultWriteFileExtension()
+{
+  return "seq.evs";
+}
@@ -0,0 +1,67 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+=========================================================================auto=*/
+///  vtkMRMLStreamingVolumeSequenceStorageNode - MRML node that can read/write
+///  a Sequence node containing streaming volumes in a single file (.seq.evs)
+///
+/// Compressed frames are written and read as they are, without decoding or encoding them.
+/// Frames are decoded only when they are displayed (when the image data of the
+/// item is accessed), therefore long sequences can be kept in memory.
+/// All frames of the sequence must be encoded with the same codec.
+
+#ifndef __vtkMRMLStreamingVolumeSequenceStorageNode_h
+#define __vtkMRMLStreamingVolumeSequenceStorageNode_h
+
+#include "vtkMRML.h"
+#include "vtkMRMLStorageNode.h"
+
+/// \ingroup Slicer_QtModules_Sequences
+class VTK_MRML_EXPORT vtkMRMLStreamingVolumeSequenceStorageNode : public vtkMRMLStorageNode
+{
+  public:
+
+  static vtkMRMLStreamingVolumeSequenceStorageNode *New();
+  vtkTypeMacro(vtkMRMLStreamingVolumeSequenceStorageNode,vtkMRMLStorageNode);
+
+  vtkMRMLNode* CreateNodeInstance() override;
+
+  ///
+  /// Get node XML tag name (like Storage, Model)
+  const char* GetNodeTagName() override {return "StreamingVolumeSequenceStorage";};
+
+  /// Return true if the node can be read in.
+  bool CanReadInReferenceNode(vtkMRMLNode *refNode) override;
+
+  /// Return true if the node can be written by using the writer.
+  /// All data nodes must be streaming volume nodes with a frame, encoded with the same codec.
+  bool CanWriteFromReferenceNode(vtkMRMLNode* refNode) override;
+
+  /// Write the data. Returns 1 on success, 0 otherwise.
+  int WriteDataInternal(vtkMRMLNode *refNode) override;
+
+  ///
+  /// Return a default file extension for writing
+  const char* GetDefaultWriteFileExtension() override;
+
+protected:
+  vtkMRMLStreamingVolumeSequenceStorageNode();
+  ~vtkMRMLStreamingVolumeSequenceStorageNode() override;
+  vtkMRMLStreamingVolumeSequenceStorageNode(const vtkMRMLStreamingVolumeSequenceStorageNode&);
+  void operator=(const vtkMRMLStreamingVolumeSequenceStorageNode&);
+
+  /// Does the actual reading. Returns 1 on success, 0 otherwise.
+  int ReadDataInternal(vtkMRMLNode* refNode) override;
+
+  /// Initialize all the supported read file types
+  void InitializeSupportedReadFileTypes() override;
+
+  /// Initialize all the supported write file types
+  void InitializeSupportedWriteFileTypes() override;
+};
+
+#endif
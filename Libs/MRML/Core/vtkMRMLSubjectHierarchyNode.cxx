@@ -41,6 +41,7 @@
 #include <sstream>
 #include <set>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
 
 //----------------------------------------------------------------------------
@@ -105,8 +106,12 @@ public:
 
   /// Item and data node cache to speed up lookups that are needed many times.
   /// It can be static as the item IDs are unique in one application session.
-  static std::map<vtkIdType, vtkSubjectHierarchyItem*> ItemCache;
-  static std::map<vtkMRMLNode*, vtkSubjectHierarchyItem*> DataNodeCache;
+  static std::unordered_map<vtkIdType, vtkSubjectHierarchyItem*> ItemCache;
+  static std::unordered_map<vtkMRMLNode*, vtkSubjectHierarchyItem*> DataNodeCache;
+  /// UID cache to speed up lookup by UID. Key is the UID name and value joined by the name-value separator.
+  /// Contains all existing items that have UIDs, including the ones that are not in a tree (e.g. unresolved
+  /// or copied items), so the found items need to be checked whether they are in the searched branch.
+  static std::unordered_map<std::string, std::vector<vtkSubjectHierarchyItem*> > UIDCache;
 
 // Get/set functions
 public:
@@ -191,6 +196,15 @@ public:
   void GetDirectChildren(std::vector<vtkIdType> &childIDs);
   /// Print all children with correct indentation
   void PrintAllChildren(ostream& os, vtkIndent indent);
+  /// Determine whether this item is in the branch of the given item (the item itself is not part of its branch).
+  /// Only items that have been added to a tree (i.e. that are in the item cache) are considered.
+  bool IsInBranch(vtkSubjectHierarchyItem* ancestorItem);
+  /// Find child by UID (exact match) using the UID cache
+  /// \param found Set to true if the UID cache lookup was conclusive. If there are multiple matching items in
+  ///   the branch, then it is set to false and FindChildByUID needs to be used to get the first item in tree order.
+  /// 
+eturn Item if found, nullptr otherwise
+  vtkSubjectHierarchyItem* FindChildByUIDInCache(const std::string& uidName, const std::string& uidValue, bool& found);
 
   /// Reparent item under new parent
   bool Reparent(vtkSubjectHierarchyItem* newParentItem);
@@ -238,6 +252,13 @@ private:
   /// Incremental ID used to uniquely identify subject hierarchy items
   static vtkIdType NextSubjectHierarchyItemID;
 
+  /// Add all UIDs of the item to the UID cache
+  void AddUIDsToCache();
+  /// Remove all UIDs of the item from the UID cache
+  void RemoveUIDsFromCache();
+  /// Get key of a UID in the UID cache
+  static std::string GetUIDCacheKey(const std::string& uidName, const std::string& uidValue);
+
   vtkSubjectHierarchyItem(const vtkSubjectHierarchyItem&) = delete;
   void operator=(const vtkSubjectHierarchyItem&) = delete;
 };
@@ -247,8 +268,9 @@ vtkStandardNewMacro(vtkSubjectHierarchyItem);
 
 vtkIdType vtkSubjectHierarchyItem::NextSubjectHierarchyItemID = vtkMRMLSubjectHierarchyNode::INVALID_ITEM_ID + 1;
 
-std::map<vtkIdType, vtkSubjectHierarchyItem*> vtkSubjectHierarchyItem::ItemCache = std::map<vtkIdType, vtkSubjectHierarchyItem*>();
-std::map<vtkMRMLNode*, vtkSubjectHierarchyItem*> vtkSubjectHierarchyItem::DataNodeCache = std::map<vtkMRMLNode*, vtkSubjectHierarchyItem*>();
+std::unordered_map<vtkIdType, vtkSubjectHierarchyItem*> vtkSubjectHierarchyItem::ItemCache = std::unordered_map<vtkIdType, vtkSubjectHierarchyItem*>();
+std::unordered_map<vtkMRMLNode*, vtkSubjectHierarchyItem*> vtkSubjectHierarchyItem::DataNodeCache = std::unordered_map<vtkMRMLNode*, vtkSubjectHierarchyItem*>();
+std::unordered_map<std::string, std::vector<vtkSubjectHierarchyItem*> > vtkSubjectHierarchyItem::UIDCache = std::unordered_map<std::string, std::vector<vtkSubjectHierarchyItem*> >();
 
 //---------------------------------------------------------------------------
 // vtkSubjectHierarchyItem methods
@@ -274,6 +296,7 @@ vtkSubjectHierarchyItem::~vtkSubjectHierarchyItem()
   this->RemoveAllChildren();
 
   this->Attributes.clear();
+  this->RemoveUIDsFromCache();
   this->UIDs.clear();
 }
 
@@ -470,6 +493,7 @@ void vtkSubjectHierarchyItem::ReadXMLAttributes(const char** atts)
       ss << attValue;
       std::string valueStr = ss.str();
 
+      this->RemoveUIDsFromCache();
       this->UIDs.clear();
       size_t itemSeparatorPosition = valueStr.find(vtkMRMLSubjectHierarchyNode::SUBJECTHIERARCHY_SEPARATOR);
       while (itemSeparatorPosition != std::string::npos)
@@ -493,6 +517,7 @@ void vtkSubjectHierarchyItem::ReadXMLAttributes(const char** atts)
         std::string value = itemStr.substr(nameValueSeparatorPosition + vtkMRMLSubjectHierarchyNode::SUBJECTHIERARCHY_NAME_VALUE_SEPARATOR.size());
         this->UIDs[name] = value;
         }
+      this->AddUIDsToCache();
       }
     else if (!strcmp(attName, "attributes"))
       {
@@ -639,7 +664,9 @@ void vtkSubjectHierarchyItem::DeepCopy(vtkSubjectHierarchyItem* item, bool copyC
   this->Name = item->Name;
   this->OwnerPluginName = item->OwnerPluginName;
   this->Expanded = item->Expanded;
+  this->RemoveUIDsFromCache();
   this->UIDs = item->UIDs;
+  this->AddUIDsToCache();
   this->Attributes = item->Attributes;
 
   // Copy temporary members if they are valid, otherwise save from live members
@@ -718,7 +745,7 @@ vtkSubjectHierarchyItem* vtkSubjectHierarchyItem::FindChildByID(vtkIdType itemID
     }
 
   // Try to find item in cache
-  std::map<vtkIdType, vtkSubjectHierarchyItem*>::iterator itemIt = vtkSubjectHierarchyItem::ItemCache.find(itemID);
+  auto itemIt = vtkSubjectHierarchyItem::ItemCache.find(itemID);
   if (itemIt != vtkSubjectHierarchyItem::ItemCache.end())
     {
     return itemIt->second;
@@ -749,7 +776,7 @@ vtkSubjectHierarchyItem* vtkSubjectHierarchyItem::FindChildByID(vtkIdType itemID
     }
   if (foundItem)
     {
-    vtkSubjectHierarchyItem::ItemCache[itemID] = this;
+    vtkSubjectHierarchyItem::ItemCache[itemID] = foundItem;
     }
 
   return foundItem;
@@ -790,6 +817,7 @@ vtkSubjectHierarchyItem* vtkSubjectHierarchyItem::FindChildByUID(std::string uid
     {
     return nullptr;
     }
+
   ChildVector::iterator childIt;
   for (childIt=this->Children.begin(); childIt!=this->Children.end(); ++childIt)
     {
@@ -849,7 +877,6 @@ void vtkSubjectHierarchyItem::FindChildrenByName(std::string name, std::vector<v
   for (childIt=this->Children.begin(); childIt!=this->Children.end(); ++childIt)
     {
     vtkSubjectHierarchyItem* currentItem = childIt->GetPointer();
-    std::string currentName = currentItem->GetName();
     if (name.empty())
       {
       // If given name is empty (e.g. GetAllChildrenIDs is called), then it is quicker not to do the unnecessary string operations
@@ -857,17 +884,18 @@ void vtkSubjectHierarchyItem::FindChildrenByName(std::string name, std::vector<v
       }
     else if (contains)
       {
+      std::string currentName = currentItem->GetName();
       std::transform(currentName.begin(), currentName.end(), currentName.begin(), ::tolower); // Make it lowercase for case-insensitive comparison
       if (currentName.find(name) != std::string::npos)
         {
         foundItemIDs.push_back(currentItem->ID);
         }
       }
-    else if (!currentName.compare(name))
+    else if (!currentItem->GetName().compare(name))
       {
       foundItemIDs.push_back(currentItem->ID);
       }
-    if (recursive)
+    if (recursive && currentItem->HasChildren())
       {
       currentItem->FindChildrenByName(name, foundItemIDs, contains);
       }
@@ -924,6 +952,95 @@ void vtkSubjectHierarchyItem::GetDirectChildren(std::vector<vtkIdType> &childIDs
     }
 }
 
+//---------------------------------------------------------------------------
+bool vtkSubjectHierarchyItem::IsInBranch(vtkSubjectHierarchyItem* ancestorItem)
+{
+  if (!ancestorItem)
+    {
+    return false;
+    }
+  // Parent pointers are only guaranteed to be valid for items that are in a tree
+  auto itemIt = vtkSubjectHierarchyItem::ItemCache.find(this->ID);
+  if (itemIt == vtkSubjectHierarchyItem::ItemCache.end() || itemIt->second != this)
+    {
+    return false;
+    }
+  for (vtkSubjectHierarchyItem* currentItem = this->Parent; currentItem; currentItem = currentItem->Parent)
+    {
+    if (currentItem == ancestorItem)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+//---------------------------------------------------------------------------
+vtkSubjectHierarchyItem* vtkSubjectHierarchyItem::FindChildByUIDInCache(
+  const std::string& uidName, const std::string& uidValue, bool& found)
+{
+  found = true;
+  if (uidName.empty() || uidValue.empty())
+    {
+    return nullptr;
+    }
+  auto uidIt = vtkSubjectHierarchyItem::UIDCache.find(vtkSubjectHierarchyItem::GetUIDCacheKey(uidName, uidValue));
+  if (uidIt == vtkSubjectHierarchyItem::UIDCache.end())
+    {
+    return nullptr;
+    }
+  vtkSubjectHierarchyItem* foundItem = nullptr;
+  for (vtkSubjectHierarchyItem* candidateItem : uidIt->second)
+    {
+    if (!candidateItem->IsInBranch(this))
+      {
+      continue;
+      }
+    if (foundItem)
+      {
+      // Multiple matches, the order in the tree determines which one is returned
+      found = false;
+      return nullptr;
+      }
+    foundItem = candidateItem;
+    }
+  return foundItem;
+}
+
+//---------------------------------------------------------------------------
+std::string vtkSubjectHierarchyItem::GetUIDCacheKey(const std::string& uidName, const std::string& uidValue)
+{
+  return uidName + vtkMRMLSubjectHierarchyNode::SUBJECTHIERARCHY_NAME_VALUE_SEPARATOR + uidValue;
+}
+
+//---------------------------------------------------------------------------
+void vtkSubjectHierarchyItem::AddUIDsToCache()
+{
+  for (std::map<std::string, std::string>::iterator uidIt = this->UIDs.begin(); uidIt != this->UIDs.end(); ++uidIt)
+    {
+    vtkSubjectHierarchyItem::UIDCache[vtkSubjectHierarchyItem::GetUIDCacheKey(uidIt->first, uidIt->second)].push_back(this);
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkSubjectHierarchyItem::RemoveUIDsFromCache()
+{
+  for (std::map<std::string, std::string>::iterator uidIt = this->UIDs.begin(); uidIt != this->UIDs.end(); ++uidIt)
+    {
+    auto cacheIt = vtkSubjectHierarchyItem::UIDCache.find(vtkSubjectHierarchyItem::GetUIDCacheKey(uidIt->first, uidIt->second));
+    if (cacheIt == vtkSubjectHierarchyItem::UIDCache.end())
+      {
+      continue;
+      }
+    std::vector<vtkSubjectHierarchyItem*>& items = cacheIt->second;
+    items.erase(std::remove(items.begin(), items.end(), this), items.end());
+    if (items.empty())
+      {
+      vtkSubjectHierarchyItem::UIDCache.erase(cacheIt);
+      }
+    }
+}
+
 //---------------------------------------------------------------------------
 void vtkSubjectHierarchyItem::PrintAllChildren(ostream& os, vtkIndent indent)
 {
@@ -1243,29 +1360,30 @@ void vtkSubjectHierarchyItem::RemoveAllChildren()
 {
   std::vector<vtkIdType> childIDs;
   this->GetAllChildren(childIDs);
-  while (childIDs.size())
+  // Children are listed in depth-first order, so when traversing the list backwards the children
+  // of each item are removed before the item itself, therefore every item is a leaf when it is reached
+  std::vector<vtkIdType>::reverse_iterator childIt;
+  for (childIt=childIDs.rbegin(); childIt!=childIDs.rend(); ++childIt)
     {
-    // Remove first leaf item found
-    std::vector<vtkIdType>::iterator childIt;
-    for (childIt=childIDs.begin(); childIt!=childIDs.end(); ++childIt)
+    if ((*childIt) == vtkMRMLSubjectHierarchyNode::INVALID_ITEM_ID)
       {
-      if ((*childIt) == vtkMRMLSubjectHierarchyNode::INVALID_ITEM_ID)
-        {
-        // This can happen when UnresolvedItems are deleted. In that case the items will automatically deconstruct
-        childIDs.erase(childIt);
-        break;
-        }
-      vtkSubjectHierarchyItem* currentItem = this->FindChildByID(*childIt);
-      if (currentItem && !currentItem->HasChildren())
-        {
-        // Remove leaf item
-        currentItem->Parent->RemoveChild(*childIt);
-        // Remove ID of deleted item from list and keep deleting until empty
-        childIDs.erase(childIt);
-        break;
-        }
+      // This can happen when UnresolvedItems are deleted. In that case the items will automatically deconstruct
+      continue;
       }
-    } // While there are children to delete
+    vtkSubjectHierarchyItem* currentItem = this->FindChildByID(*childIt);
+    if (!currentItem || !currentItem->Parent)
+      {
+      // Item has already been removed (e.g., by an observer of a removal event)
+      continue;
+      }
+    if (currentItem->HasChildren())
+      {
+      // Children may have been added by an observer of a removal event
+      currentItem->RemoveAllChildren();
+      }
+    // Remove leaf item
+    currentItem->Parent->RemoveChild(*childIt);
+    }
 }
 
 //---------------------------------------------------------------------------
@@ -1284,8 +1402,15 @@ void vtkSubjectHierarchyItem::SetUID(std::string uidName, std::string uidValue)
       {
       return; // Do nothing if the UID values match
       }
+    this->RemoveUIDsFromCache();
+    this->UIDs[uidName] = uidValue;
+    this->AddUIDsToCache();
+    }
+  else
+    {
+    this->UIDs[uidName] = uidValue;
+    vtkSubjectHierarchyItem::UIDCache[vtkSubjectHierarchyItem::GetUIDCacheKey(uidName, uidValue)].push_back(this);
     }
-  this->UIDs[uidName] = uidValue;
   this->InvokeEvent(vtkMRMLSubjectHierarchyNode::SubjectHierarchyItemUIDAddedEvent, this);
   this->Modified();
 }
@@ -2935,7 +3060,12 @@ vtkIdType vtkMRMLSubjectHierarchyNode::GetItemByUID(const char* uidName, const c
     vtkErrorMacro("GetSubjectHierarchyNodeByUID: Invalid UID name or value");
     return INVALID_ITEM_ID;
     }
-  vtkSubjectHierarchyItem* item = this->Internal->SceneItem->FindChildByUID(uidName, uidValue);
+  bool found = false;
+  vtkSubjectHierarchyItem* item = this->Internal->SceneItem->FindChildByUIDInCache(uidName, uidValue, found);
+  if (!found)
+    {
+    item = this->Internal->SceneItem->FindChildByUID(uidName, uidValue);
+    }
   return (item ? item->ID : INVALID_ITEM_ID);
 }
 
@@ -201,6 +201,16 @@ void vtkMRMLTableNode::ProcessMRMLEvents( vtkObject *caller, unsigned long event
 }
 
 
+//----------------------------------------------------------------------------
+void vtkMRMLTableNode::GetDataObjects(std::vector<vtkDataObject*>& dataObjects)
+{
+  Superclass::GetDataObjects(dataObjects);
+  if (this->Table)
+    {
+    dataObjects.push_back(this->Table);
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLTableNode::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -70,6 +70,10 @@ public:
   /// \sa vtkMRMLNode::CopyContent
   vtkMRMLCopyContentMacro(vtkMRMLTableNode);
 
+  /// Get bulk data objects stored in this node.
+  /// \sa vtkMRMLNode::GetDataObjects
+  void GetDataObjects(std::vector<vtkDataObject*>& dataObjects) override;
+
   ///
   /// Get node XML tag name (like Volume, Model)
   const char* GetNodeTagName() override { return "Table"; }
@@ -40,6 +40,9 @@
 
 #include <vtksys/SystemTools.hxx>
 
+// STD includes
+#include <sstream>
+
 //------------------------------------------------------------------------------
 vtkMRMLNodeNewMacro(vtkMRMLTableSQLiteStorageNode);
 
@@ -58,6 +61,8 @@ vtkMRMLTableSQLiteStorageNode::~vtkMRMLTableSQLiteStorageNode() = default;
 void vtkMRMLTableSQLiteStorageNode::PrintSelf(ostream& os, vtkIndent indent)
 {
   vtkMRMLStorageNode::PrintSelf(os,indent);
+  os << indent << "FirstRowToRead: " << this->FirstRowToRead << "\n";
+  os << indent << "MaximumNumberOfRowsToRead: " << this->MaximumNumberOfRowsToRead << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -100,11 +105,23 @@ int vtkMRMLTableSQLiteStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
     return 0;
     }
 
+  if (!this->TableName || std::string(this->TableName).empty())
+    {
+    vtkErrorMacro("ReadData: no table name specified");
+    return 0;
+    }
+
   vtkSmartPointer<vtkSQLiteQuery> query = vtkSmartPointer<vtkSQLiteQuery>::Take(
                    vtkSQLiteQuery::SafeDownCast( database->GetQueryInstance()));
-  std::string queryString("select * from ");
-  queryString += std::string(this->TableName);
-  query->SetQuery(queryString.c_str());
+  std::stringstream queryString;
+  queryString << "select * from " << this->TableName;
+  if (this->MaximumNumberOfRowsToRead >= 0 || this->FirstRowToRead > 0)
+    {
+    // only read the requested window of rows (negative limit means no limit in SQLite)
+    queryString << " limit " << (this->MaximumNumberOfRowsToRead >= 0 ? this->MaximumNumberOfRowsToRead : -1)
+      << " offset " << this->FirstRowToRead;
+    }
+  query->SetQuery(queryString.str().c_str());
   query->Execute();
 
   vtkSmartPointer<vtkRowQueryToTable> queryToTable = vtkSmartPointer<vtkRowQueryToTable>::New();
@@ -234,27 +251,42 @@ int vtkMRMLTableSQLiteStorageNode::WriteDataInternal(vtkMRMLNode *refNode)
     vtkErrorMacro(<<"Error performing 'create table' query");
     }
 
-  //iterate over the rows of the vtkTable to complete the insert query
+  //insert the rows with a single prepared statement, in one transaction
+  //(committing each row separately would sync the file after each insert)
+  std::string insertQuery = insertPreamble;
+  for (vtkIdType j = 0; j < numColumns; j++)
+    {
+    insertQuery += (j < numColumns - 1 ? "?, " : "?");
+    }
+  insertQuery += ");";
+  bool inTransaction = query->BeginTransaction();
+  if (!inTransaction)
+    {
+    vtkWarningMacro(<<"Failed to start transaction, rows are inserted one by one");
+    }
+  query->SetQuery(insertQuery.c_str());
   vtkIdType numRows = table->GetNumberOfRows();
+  vtkIdType numFailedRows = 0;
   for(vtkIdType i = 0; i < numRows; i++)
     {
-    std::string insertQuery = insertPreamble;
     for (vtkIdType j = 0; j < numColumns; j++)
       {
-      insertQuery += "'" + table->GetValue(i, j).ToString() + "'";
-      if(j < numColumns - 1)
-        {
-        insertQuery += ", ";
-        }
+      query->BindParameter(static_cast<int>(j), table->GetValue(i, j));
       }
-    insertQuery += ");";
     //perform the insert query for this row
-    query->SetQuery(insertQuery.c_str());
     if(!query->Execute())
       {
-      vtkErrorMacro(<<"Error performing 'insert' query");
+      ++numFailedRows;
       }
     }
+  if (inTransaction && !query->CommitTransaction())
+    {
+    vtkErrorMacro(<<"Error committing inserted rows");
+    }
+  if (numFailedRows > 0)
+    {
+    vtkErrorMacro(<<"Error performing 'insert' query for " << numFailedRows << " rows");
+    }
 
   //cleanup and return
   query->Delete();
@@ -265,6 +297,34 @@ int vtkMRMLTableSQLiteStorageNode::WriteDataInternal(vtkMRMLNode *refNode)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkIdType vtkMRMLTableSQLiteStorageNode::GetNumberOfRowsInDatabase()
+{
+  std::string fullName = this->GetFullNameFromFileName();
+  if (fullName.empty() || !vtksys::SystemTools::FileExists(fullName)
+    || !this->TableName || std::string(this->TableName).empty())
+    {
+    return -1;
+    }
+  std::string dbname = std::string("sqlite://") + fullName;
+  vtkSmartPointer<vtkSQLiteDatabase> database = vtkSmartPointer<vtkSQLiteDatabase>::Take(
+                   vtkSQLiteDatabase::SafeDownCast( vtkSQLiteDatabase::CreateFromURL(dbname.c_str())));
+  if (!database.GetPointer() || !database->Open(this->GetPassword(), vtkSQLiteDatabase::USE_EXISTING))
+    {
+    return -1;
+    }
+  vtkSmartPointer<vtkSQLiteQuery> query = vtkSmartPointer<vtkSQLiteQuery>::Take(
+                   vtkSQLiteQuery::SafeDownCast( database->GetQueryInstance()));
+  std::string queryString = std::string("select count(*) from ") + this->TableName;
+  query->SetQuery(queryString.c_str());
+  if (!query->Execute() || !query->NextRow())
+    {
+    return -1;
+    }
+  return static_cast<vtkIdType>(query->DataValue(0).ToTypeInt64());
+}
+
+//----------------------------------------------------------------------------
 int vtkMRMLTableSQLiteStorageNode::DropTable(char *tableName, vtkSQLiteDatabase* database)
 {
   if(!tableName || std::string(tableName).empty())
@@ -57,6 +57,20 @@ public:
   vtkSetStringMacro(TableName);
   vtkGetStringMacro(TableName);
 
+  /// Index of the first row that is read from the database table. Default is 0.
+  /// Together with MaximumNumberOfRowsToRead it allows reading only a window of a large table.
+  vtkSetClampMacro(FirstRowToRead, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(FirstRowToRead, vtkIdType);
+
+  /// Maximum number of rows that are read from the database table.
+  /// Negative value (default) means that all the rows are read.
+  vtkSetMacro(MaximumNumberOfRowsToRead, vtkIdType);
+  vtkGetMacro(MaximumNumberOfRowsToRead, vtkIdType);
+
+  /// Get the number of rows of the table in the database file, without reading the rows.
+  /// Returns -1 if the table cannot be found in the database.
+  vtkIdType GetNumberOfRowsInDatabase();
+
   /// Drop a specified table from the database
   static int DropTable(char *tableName, vtkSQLiteDatabase* database);
 
@@ -80,6 +94,8 @@ protected:
 
   char *TableName;
   char *Password;
+  vtkIdType FirstRowToRead{0};
+  vtkIdType MaximumNumberOfRowsToRead{-1};
 };
 
 #endif
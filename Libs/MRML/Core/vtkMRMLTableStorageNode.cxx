@@ -34,8 +34,15 @@
 #include <vtkStringArray.h>
 #include <vtkBitArray.h>
 #include <vtkNew.h>
+#include <vtkSMPTools.h>
 #include <vtksys/SystemTools.hxx>
 
+// STD includes
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+
 //------------------------------------------------------------------------------
 // Helper class to be able to read tables that have "\" characters in them.
 //
@@ -67,6 +74,176 @@ protected:
 
 vtkStandardNewMacro(vtkNoEscapeDelimitedTextReader);
 
+namespace
+{
+
+//------------------------------------------------------------------------------
+// Parser of delimited text files, which splits rows and fields the same way as
+// vtkNoEscapeDelimitedTextReader with the settings used by the storage node:
+// rows are separated by line breaks (empty rows are ignored), fields are separated by
+// any of the field delimiter characters, and field delimiters and line breaks between
+// double quotes are part of the value (the quotes are removed).
+// The whole file is read into memory and the rows are located in a single pass,
+// so that the fields of the rows can then be parsed in parallel.
+class DelimitedTextParser
+{
+public:
+  DelimitedTextParser(const std::string& fieldDelimiters)
+  {
+    for (int i = 0; i < 256; ++i)
+      {
+      this->IsFieldDelimiter[i] = false;
+      }
+    for (char delimiter : fieldDelimiters)
+      {
+      this->IsFieldDelimiter[static_cast<unsigned char>(delimiter)] = true;
+      }
+  }
+
+  bool ReadFile(const std::string& filename)
+  {
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file)
+      {
+      return false;
+      }
+    file.seekg(0, std::ios::end);
+    std::streamoff fileSize = file.tellg();
+    if (fileSize < 0)
+      {
+      return false;
+      }
+    this->Text.resize(static_cast<size_t>(fileSize));
+    file.seekg(0, std::ios::beg);
+    if (fileSize > 0 && !file.read(&this->Text[0], fileSize))
+      {
+      return false;
+      }
+    // Skip UTF-8 byte order mark
+    size_t position = (this->Text.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0);
+    this->FindRows(position);
+    return true;
+  }
+
+  vtkIdType GetNumberOfRows() const
+  {
+    return static_cast<vtkIdType>(this->RowStarts.size());
+  }
+
+  /// Get values of a row. Strings in fields are reused to minimize memory allocations,
+  /// therefore fields may contain more elements than the number of fields of the row.
+  /// Returns the number of fields of the row.
+  size_t GetFields(vtkIdType row, std::vector<std::string>& fields) const
+  {
+    const char* current = this->Text.data() + this->RowStarts[row];
+    const char* rowEnd = this->Text.data() + this->RowEnds[row];
+    size_t fieldIndex = 0;
+    if (fields.empty())
+      {
+      fields.emplace_back();
+      }
+    fields[0].clear();
+    bool inQuotes = false;
+    const char* spanStart = current;
+    for (; current < rowEnd; ++current)
+      {
+      char c = *current;
+      if (c == '"')
+        {
+        fields[fieldIndex].append(spanStart, current);
+        spanStart = current + 1;
+        inQuotes = !inQuotes;
+        }
+      else if (!inQuotes && this->IsFieldDelimiter[static_cast<unsigned char>(c)])
+        {
+        fields[fieldIndex].append(spanStart, current);
+        spanStart = current + 1;
+        ++fieldIndex;
+        if (fieldIndex >= fields.size())
+          {
+          fields.emplace_back();
+          }
+        fields[fieldIndex].clear();
+        }
+      }
+    fields[fieldIndex].append(spanStart, rowEnd);
+    return fieldIndex + 1;
+  }
+
+protected:
+  void FindRows(size_t position)
+  {
+    const char* text = this->Text.data();
+    size_t length = this->Text.size();
+    size_t rowStart = position;
+    bool inQuotes = false;
+    for (; position < length; ++position)
+      {
+      char c = text[position];
+      if (c == '"')
+        {
+        inQuotes = !inQuotes;
+        }
+      else if (!inQuotes && (c == '\n' || c == '\r'))
+        {
+        if (position > rowStart)
+          {
+          this->RowStarts.push_back(rowStart);
+          this->RowEnds.push_back(position);
+          }
+        rowStart = position + 1;
+        }
+      }
+    if (length > rowStart)
+      {
+      this->RowStarts.push_back(rowStart);
+      this->RowEnds.push_back(length);
+      }
+  }
+
+  std::string Text;
+  std::vector<size_t> RowStarts;
+  std::vector<size_t> RowEnds;
+  bool IsFieldDelimiter[256];
+};
+
+//------------------------------------------------------------------------------
+// Convert text to number. Returns false if the text is not a number.
+bool ParseNumber(const std::string& text, double& value)
+{
+  const char* begin = text.c_str();
+  char* end = nullptr;
+  value = strtod(begin, &end);
+  if (end == begin)
+    {
+    return false;
+    }
+  while (*end == ' ')
+    {
+    ++end;
+    }
+  return (*end == '\0');
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void SetParsedValue(void* values, vtkIdType index, double value)
+{
+  static_cast<T*>(values)[index] = static_cast<T>(value);
+}
+
+//------------------------------------------------------------------------------
+// Array that the values of a file column are parsed into
+struct RawColumn
+{
+  vtkStringArray* StringArray{nullptr};
+  vtkStdString* StringValues{nullptr};
+  vtkDataArray* TypedArray{nullptr};
+  void* TypedValues{nullptr};
+};
+
+}
+
 //------------------------------------------------------------------------------
 vtkMRMLNodeNewMacro(vtkMRMLTableStorageNode);
 
@@ -364,7 +541,7 @@ std::vector<vtkMRMLTableStorageNode::ColumnInfo> vtkMRMLTableStorageNode::GetCol
     for (int col = 0; col < rawTable->GetNumberOfColumns(); ++col)
       {
       vtkMRMLTableStorageNode::ColumnInfo columnInfo;
-      vtkStringArray* column = vtkStringArray::SafeDownCast(rawTable->GetColumn(col));
+      vtkAbstractArray* column = rawTable->GetColumn(col);
       if (column == nullptr)
         {
         vtkWarningMacro("vtkMRMLTableStorageNode::GetColumnInfo: invalid column - " << col);
@@ -502,6 +679,27 @@ void vtkMRMLTableStorageNode::AddColumnToTable(vtkTable* table, vtkMRMLTableStor
     vtkIdType componentIndex = 0;
     for (vtkAbstractArray* componentArray : rawComponentArrays)
       {
+      vtkDataArray* rawTypedComponentArray = vtkDataArray::SafeDownCast(componentArray);
+      if (rawTypedComponentArray && rawTypedComponentArray->GetDataType() == valueTypeId
+        && rawTypedComponentArray->GetNumberOfTuples() == numberOfTuples)
+        {
+        // Values have been already parsed into an array of the correct type
+        if (rawComponentArrays.size() > 1)
+          {
+          typedColumn->CopyComponent(componentIndex, rawTypedComponentArray, 0);
+          }
+        else
+          {
+          typedColumn = rawTypedComponentArray;
+          }
+        if (componentIndex < static_cast<vtkIdType>(columnInfo.ComponentNames.size()))
+          {
+          typedColumn->SetComponentName(componentIndex, columnInfo.ComponentNames[componentIndex].c_str());
+          }
+        ++componentIndex;
+        continue;
+        }
+
       vtkSmartPointer<vtkStringArray> rawComponentArray = vtkStringArray::SafeDownCast(componentArray);
       if (rawComponentArray == nullptr)
         {
@@ -596,23 +794,8 @@ bool vtkMRMLTableStorageNode::ReadSchema(std::string filename, vtkMRMLTableNode*
 //----------------------------------------------------------------------------
 bool vtkMRMLTableStorageNode::ReadTable(std::string filename, vtkMRMLTableNode* tableNode)
 {
-  vtkNew<vtkNoEscapeDelimitedTextReader> reader;
-  reader->SetFileName(filename.c_str());
-  reader->SetHaveHeaders(true);
-  reader->SetFieldDelimiterCharacters(this->GetFieldDelimiterCharacters(filename).c_str());
-  // Make sure string delimiter characters are removed (somebody may have written a tsv with string delimiters)
-  reader->SetUseStringDelimiter(true);
-  // File contents is preserved better if we don't try to detect numeric columns
-  reader->DetectNumericColumnsOff();
-
-  // Read table
-  vtkTable* rawTable = nullptr;
-  try
-    {
-    reader->Update();
-    rawTable = reader->GetOutput();
-    }
-  catch (...)
+  vtkNew<vtkTable> rawTable;
+  if (!this->ReadRawTable(filename, tableNode, rawTable))
     {
     vtkErrorMacro("vtkMRMLTableStorageNode::ReadTable: failed to read table file: " << filename);
     return false;
@@ -632,6 +815,157 @@ bool vtkMRMLTableStorageNode::ReadTable(std::string filename, vtkMRMLTableNode*
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkMRMLTableStorageNode::ReadRawTable(const std::string& filename, vtkMRMLTableNode* tableNode, vtkTable* rawTable)
+{
+  DelimitedTextParser parser(this->GetFieldDelimiterCharacters(filename));
+  if (!parser.ReadFile(filename))
+    {
+    return false;
+    }
+  vtkIdType numberOfRows = parser.GetNumberOfRows() - 1; // first row is the header
+  if (numberOfRows < 0)
+    {
+    // empty file
+    return true;
+    }
+
+  // Get value type and null value of each file column from the schema.
+  // Components of multi-component columns are stored in separate file columns.
+  std::map<std::string, std::pair<int, std::string> > schemaFileColumns;
+  vtkTable* schema = tableNode->GetSchema();
+  vtkStringArray* schemaColumnNameArray = nullptr;
+  vtkStringArray* schemaComponentNamesArray = nullptr;
+  if (schema != nullptr)
+    {
+    schemaColumnNameArray = vtkStringArray::SafeDownCast(schema->GetColumnByName("columnName"));
+    schemaComponentNamesArray = vtkStringArray::SafeDownCast(schema->GetColumnByName("componentNames"));
+    }
+  if (schemaColumnNameArray != nullptr && schemaComponentNamesArray != nullptr)
+    {
+    for (int schemaRowIndex = 0; schemaRowIndex < schema->GetNumberOfRows(); ++schemaRowIndex)
+      {
+      std::string columnName = schemaColumnNameArray->GetValue(schemaRowIndex);
+      std::pair<int, std::string> columnType(tableNode->GetColumnValueTypeFromSchema(columnName),
+        tableNode->GetColumnProperty(columnName, "nullValue"));
+      std::string componentNamesStr = schemaComponentNamesArray->GetValue(schemaRowIndex);
+      if (componentNamesStr.empty())
+        {
+        schemaFileColumns[columnName] = columnType;
+        continue;
+        }
+      std::stringstream ss(componentNamesStr);
+      std::string componentName;
+      while (std::getline(ss, componentName, '|'))
+        {
+        schemaFileColumns[columnName + COMPONENT_SEPERATOR + componentName] = columnType;
+        }
+      }
+    }
+
+  // Create the arrays that the values of each file column are parsed into.
+  // Values of numeric columns are parsed directly into typed arrays, other columns
+  // are stored as strings and converted later if needed.
+  std::vector<std::string> columnNames;
+  size_t numberOfColumns = parser.GetFields(0, columnNames);
+  std::vector<RawColumn> rawColumns(numberOfColumns);
+  for (size_t col = 0; col < numberOfColumns; ++col)
+    {
+    const std::string& columnName = columnNames[col];
+    int valueType = VTK_VOID;
+    std::string nullValueString;
+    if (schemaColumnNameArray != nullptr && schemaComponentNamesArray != nullptr)
+      {
+      std::map<std::string, std::pair<int, std::string> >::iterator schemaFileColumnIt = schemaFileColumns.find(columnName);
+      if (schemaFileColumnIt != schemaFileColumns.end())
+        {
+        valueType = schemaFileColumnIt->second.first;
+        nullValueString = schemaFileColumnIt->second.second;
+        }
+      }
+    else
+      {
+      valueType = tableNode->GetColumnValueTypeFromSchema(columnName);
+      nullValueString = tableNode->GetColumnProperty(columnName, "nullValue");
+      }
+
+    vtkSmartPointer<vtkAbstractArray> rawArray;
+    // bit arrays cannot be accessed as a typed pointer, they are converted from strings
+    if (valueType != VTK_VOID && valueType != VTK_STRING && valueType != VTK_BIT)
+      {
+      vtkSmartPointer<vtkDataArray> typedArray = vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(valueType));
+      if (typedArray && typedArray->IsNumeric())
+        {
+        typedArray->SetNumberOfComponents(1);
+        typedArray->SetNumberOfTuples(numberOfRows);
+        // empty cells and invalid values are set to the null value
+        double nullValue = 0.0;
+        if (!nullValueString.empty())
+          {
+          nullValue = vtkVariant(nullValueString).ToDouble();
+          }
+        typedArray->FillComponent(0, nullValue);
+        rawColumns[col].TypedArray = typedArray;
+        rawColumns[col].TypedValues = typedArray->GetVoidPointer(0);
+        rawArray = typedArray;
+        }
+      }
+    if (!rawArray)
+      {
+      vtkNew<vtkStringArray> stringArray;
+      stringArray->SetNumberOfValues(numberOfRows);
+      rawColumns[col].StringArray = stringArray;
+      rawColumns[col].StringValues = stringArray->GetPointer(0);
+      rawArray = stringArray;
+      }
+    rawArray->SetName(columnName.c_str());
+    rawTable->AddColumn(rawArray);
+    }
+
+  // Parse the rows in parallel. Each row is written to different elements of the arrays.
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    std::vector<std::string> fields;
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      // fields after the last column are ignored, missing fields are left empty
+      size_t numberOfFields = std::min(parser.GetFields(row + 1, fields), numberOfColumns);
+      for (size_t col = 0; col < numberOfFields; ++col)
+        {
+        const RawColumn& rawColumn = rawColumns[col];
+        if (rawColumn.StringValues)
+          {
+          rawColumn.StringValues[row] = fields[col];
+          continue;
+          }
+        double value = 0.0;
+        if (fields[col].empty() || !ParseNumber(fields[col], value))
+          {
+          // empty cell or invalid value, leave the null value
+          continue;
+          }
+        switch (rawColumn.TypedArray->GetDataType())
+          {
+          vtkTemplateMacro(SetParsedValue<VTK_TT>(rawColumn.TypedValues, row, value));
+          }
+        }
+      }
+    });
+
+  for (RawColumn& rawColumn : rawColumns)
+    {
+    if (rawColumn.TypedArray)
+      {
+      rawColumn.TypedArray->Modified();
+      }
+    else if (rawColumn.StringArray)
+      {
+      rawColumn.StringArray->DataChanged();
+      }
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool vtkMRMLTableStorageNode::WriteTable(std::string filename, vtkMRMLTableNode* tableNode)
 {
@@ -117,6 +117,11 @@ protected:
   bool ReadSchema(std::string filename, vtkMRMLTableNode* tableNode);
   bool ReadTable(std::string filename, vtkMRMLTableNode* tableNode);
 
+  /// Read the table file into rawTable, which contains one array for each column of the file.
+  /// Values of columns that have a numeric type in the schema are parsed directly into typed arrays,
+  /// others are stored in string arrays. Rows are parsed in parallel.
+  bool ReadRawTable(const std::string& filename, vtkMRMLTableNode* tableNode, vtkTable* rawTable);
+
   bool WriteTable(std::string filename, vtkMRMLTableNode* tableNode);
   bool WriteSchema(std::string filename, vtkMRMLTableNode* tableNode);
 
@@ -0,0 +1,220 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkMRMLTraceRecorder.h"
+
+// VTK includes
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkMRMLTraceRecorder);
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+struct TraceEvent
+{
+  const char* Name{nullptr};
+  std::int64_t Timestamp{0}; // nanoseconds
+  bool Begin{true};
+};
+
+//----------------------------------------------------------------------------
+/// Ring buffer of the events of a single thread. Only the owner thread writes it.
+struct ThreadTraceBuffer
+{
+  ThreadTraceBuffer(int threadIndex, int size)
+    : ThreadIndex(threadIndex)
+    , Events(static_cast<size_t>(std::max(size, 2)))
+  {
+  }
+  int ThreadIndex;
+  std::vector<TraceEvent> Events;
+  std::atomic<std::uint64_t> NumberOfEvents{0};
+};
+
+//----------------------------------------------------------------------------
+struct TraceRegistry
+{
+  std::atomic<bool> Enabled{false};
+  std::atomic<int> BufferSize{65536};
+  std::chrono::steady_clock::time_point StartTime{std::chrono::steady_clock::now()};
+  // Buffers are kept after their thread exits so that their events can be written.
+  std::mutex BuffersMutex;
+  std::vector<std::shared_ptr<ThreadTraceBuffer>> Buffers;
+};
+
+//----------------------------------------------------------------------------
+TraceRegistry& GetTraceRegistry()
+{
+  static TraceRegistry registry;
+  return registry;
+}
+
+//----------------------------------------------------------------------------
+ThreadTraceBuffer& GetThreadTraceBuffer()
+{
+  thread_local std::shared_ptr<ThreadTraceBuffer> threadBuffer;
+  if (!threadBuffer)
+    {
+    TraceRegistry& registry = GetTraceRegistry();
+    std::lock_guard<std::mutex> lock(registry.BuffersMutex);
+    threadBuffer = std::make_shared<ThreadTraceBuffer>(
+      static_cast<int>(registry.Buffers.size()) + 1, registry.BufferSize.load());
+    registry.Buffers.push_back(threadBuffer);
+    }
+  return *threadBuffer;
+}
+
+//----------------------------------------------------------------------------
+void RecordEvent(const char* name, bool begin)
+{
+  TraceRegistry& registry = GetTraceRegistry();
+  ThreadTraceBuffer& buffer = GetThreadTraceBuffer();
+  std::uint64_t eventIndex = buffer.NumberOfEvents.load(std::memory_order_relaxed);
+  TraceEvent& event = buffer.Events[eventIndex % buffer.Events.size()];
+  event.Name = name;
+  event.Timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - registry.StartTime).count();
+  event.Begin = begin;
+  buffer.NumberOfEvents.store(eventIndex + 1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------
+void WriteJSONString(std::ostream& os, const char* str)
+{
+  os << '"';
+  for (const char* c = str; c && *c; ++c)
+    {
+    if (*c == '"' || *c == '\\')
+      {
+      os << '\\' << *c;
+      }
+    else if (static_cast<unsigned char>(*c) >= 0x20)
+      {
+      os << *c;
+      }
+    }
+  os << '"';
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+void vtkMRMLTraceRecorder::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << (vtkMRMLTraceRecorder::GetEnabled() ? "true" : "false") << "\n";
+  os << indent << "BufferSize: " << vtkMRMLTraceRecorder::GetBufferSize() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLTraceRecorder::SetEnabled(bool enabled)
+{
+  GetTraceRegistry().Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLTraceRecorder::GetEnabled()
+{
+  return GetTraceRegistry().Enabled.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLTraceRecorder::SetBufferSize(int numberOfEvents)
+{
+  GetTraceRegistry().BufferSize.store(std::max(numberOfEvents, 2));
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLTraceRecorder::GetBufferSize()
+{
+  return GetTraceRegistry().BufferSize.load();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLTraceRecorder::Clear()
+{
+  TraceRegistry& registry = GetTraceRegistry();
+  std::lock_guard<std::mutex> lock(registry.BuffersMutex);
+  for (const std::shared_ptr<ThreadTraceBuffer>& buffer : registry.Buffers)
+    {
+    buffer->NumberOfEvents.store(0, std::memory_order_release);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLTraceRecorder::BeginSpan(const char* name)
+{
+  RecordEvent(name, true);
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLTraceRecorder::EndSpan(const char* name)
+{
+  RecordEvent(name, false);
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLTraceRecorder::WriteTraceFile(const char* fileName)
+{
+  if (!fileName)
+    {
+    vtkGenericWarningMacro("vtkMRMLTraceRecorder::WriteTraceFile failed: invalid file name");
+    return false;
+    }
+  std::ofstream file(fileName);
+  if (!file.is_open())
+    {
+    vtkGenericWarningMacro("vtkMRMLTraceRecorder::WriteTraceFile failed: cannot open file " << fileName);
+    return false;
+    }
+
+  TraceRegistry& registry = GetTraceRegistry();
+  std::lock_guard<std::mutex> lock(registry.BuffersMutex);
+  file << std::fixed << std::setprecision(3);
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool firstEvent = true;
+  for (const std::shared_ptr<ThreadTraceBuffer>& buffer : registry.Buffers)
+    {
+    std::uint64_t numberOfEvents = buffer->NumberOfEvents.load(std::memory_order_acquire);
+    std::uint64_t capacity = buffer->Events.size();
+    std::uint64_t firstEventIndex = numberOfEvents > capacity ? numberOfEvents - capacity : 0;
+    for (std::uint64_t eventIndex = firstEventIndex; eventIndex < numberOfEvents; ++eventIndex)
+      {
+      const TraceEvent& event = buffer->Events[eventIndex % capacity];
+      file << (firstEvent ? "\n" : ",\n") << "{\"name\":";
+      WriteJSONString(file, event.Name);
+      file << ",\"ph\":\"" << (event.Begin ? 'B' : 'E') << "\",\"ts\":" << event.Timestamp / 1000.0
+           << ",\"pid\":1,\"tid\":" << buffer->ThreadIndex << "}";
+      firstEvent = false;
+      }
+    }
+  file << "\n]}\n";
+  return file.good();
+}
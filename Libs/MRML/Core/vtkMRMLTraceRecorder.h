@@ -0,0 +1,116 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkMRMLTraceRecorder_h
+#define __vtkMRMLTraceRecorder_h
+
+// MRML includes
+#include "vtkMRML.h"
+
+// VTK includes
+#include <vtkObject.h>
+
+/// \brief Records begin/end spans of time-critical operations for performance analysis.
+///
+/// Spans are recorded with vtkMRMLTraceScopeMacro into a fixed-size ring buffer of the
+/// calling thread, without locking. Recording is disabled by default and costs a single
+/// flag check then. When MRML is built with MRML_USE_TRACING disabled, the macros
+/// compile to nothing.
+///
+/// Recorded spans can be saved in the JSON trace event format, which can be opened
+/// in Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+///
+/// Example (Python console):
+/// \code
+/// slicer.vtkMRMLTraceRecorder.SetEnabled(True)
+/// # ... interact with the application ...
+/// slicer.vtkMRMLTraceRecorder.WriteTraceFile("/tmp/SlicerTrace.json")
+/// \endcode
+///
+/// Span names must be string literals (or other strings that are never released), as
+/// only their pointer is stored.
+class VTK_MRML_EXPORT vtkMRMLTraceRecorder : public vtkObject
+{
+public:
+  static vtkMRMLTraceRecorder* New();
+  vtkTypeMacro(vtkMRMLTraceRecorder, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Enable/disable recording of spans. Disabled by default.
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+
+  /// Number of events (begin or end) kept for each thread. When the buffer is full,
+  /// the oldest events are overwritten. Applies to threads that record their first event
+  /// after the call. Default is 65536.
+  static void SetBufferSize(int numberOfEvents);
+  static int GetBufferSize();
+
+  /// Remove all recorded events.
+  static void Clear();
+
+  /// Write recorded events to a file in JSON trace event format.
+  /// Recording should be disabled while writing, to get a consistent snapshot.
+  /// \return true on success
+  static bool WriteTraceFile(const char* fileName);
+
+  /// Record the beginning or end of a span. Prefer using vtkMRMLTraceScopeMacro.
+  static void BeginSpan(const char* name);
+  static void EndSpan(const char* name);
+
+#ifndef __VTK_WRAP__
+  /// Records a span for the lifetime of the object.
+  class Scope
+  {
+  public:
+    Scope(const char* name)
+      : Name(vtkMRMLTraceRecorder::GetEnabled() ? name : nullptr)
+    {
+      if (this->Name)
+        {
+        vtkMRMLTraceRecorder::BeginSpan(this->Name);
+        }
+    }
+    ~Scope()
+    {
+      if (this->Name)
+        {
+        vtkMRMLTraceRecorder::EndSpan(this->Name);
+        }
+    }
+  private:
+    Scope(const Scope&) = delete;
+    void operator=(const Scope&) = delete;
+    const char* Name;
+  };
+#endif
+
+protected:
+  vtkMRMLTraceRecorder() = default;
+  ~vtkMRMLTraceRecorder() override = default;
+
+private:
+  vtkMRMLTraceRecorder(const vtkMRMLTraceRecorder&) = delete;
+  void operator=(const vtkMRMLTraceRecorder&) = delete;
+};
+
+/// Record a span from this point until the end of the enclosing scope.
+#ifdef MRML_USE_TRACING
+# define vtkMRMLTraceScopeMacro(name) vtkMRMLTraceRecorder::Scope vtkMRMLTraceScopeInstance(name)
+#else
+# define vtkMRMLTraceScopeMacro(name)
+#endif
+
+#endif
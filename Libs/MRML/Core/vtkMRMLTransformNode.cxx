@@ -30,21 +30,160 @@ Version:   $Revision: 1.14 $
 #include <vtkCommand.h>
 #include <vtkCollection.h>
 #include <vtkCollectionIterator.h>
+#include <vtkBSplineTransform.h>
 #include <vtkGeneralTransform.h>
+#include <vtkGridTransform.h>
 #include <vtkImageData.h>
 #include <vtkLinearTransform.h>
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
 #include <vtkHomogeneousTransform.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPoints.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
 #include <vtkThinPlateSplineTransform.h>
 #include <vtkTransform.h>
 #include <vtksys/SystemTools.hxx>
 
 // STD includes
+#include <algorithm>
 #include <sstream>
 #include <stack>
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Compute an explicit inverse of forwardTransform on the grid defined by gridGeometry
+/// and gridDirection. Each grid point is inverted by fixed-point iteration, grid slices
+/// are processed in parallel.
+vtkSmartPointer<vtkOrientedGridTransform> ComputeInverseDisplacementField(vtkAbstractTransform* forwardTransform,
+  const int extent[6], const double origin[3], const double spacing[3], vtkMatrix4x4* gridDirection)
+{
+  const int maximumNumberOfIterations = 20;
+  double tolerance = 0.01 * std::min(std::min(fabs(spacing[0]), fabs(spacing[1])), fabs(spacing[2]));
+  double toleranceSquared = tolerance * tolerance;
+
+  double direction[3][3] = { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } };
+  if (gridDirection)
+    {
+    for (int row = 0; row < 3; row++)
+      {
+      for (int column = 0; column < 3; column++)
+        {
+        direction[row][column] = gridDirection->GetElement(row, column);
+        }
+      }
+    }
+
+  vtkNew<vtkImageData> displacementField;
+  displacementField->SetExtent(const_cast<int*>(extent));
+  displacementField->SetOrigin(origin[0], origin[1], origin[2]);
+  displacementField->SetSpacing(spacing[0], spacing[1], spacing[2]);
+  displacementField->AllocateScalars(VTK_DOUBLE, 3);
+  double* displacements = static_cast<double*>(displacementField->GetScalarPointer());
+  int dimensions[3] = { extent[1] - extent[0] + 1, extent[3] - extent[2] + 1, extent[5] - extent[4] + 1 };
+
+  // Make sure the transform is up-to-date before it is used from multiple threads
+  forwardTransform->Update();
+
+  vtkSMPTools::For(0, dimensions[2], [&](vtkIdType beginSlice, vtkIdType endSlice)
+    {
+    for (vtkIdType sliceIndex = beginSlice; sliceIndex < endSlice; ++sliceIndex)
+      {
+      for (int rowIndex = 0; rowIndex < dimensions[1]; ++rowIndex)
+        {
+        double* displacement = displacements + 3 * (sliceIndex * dimensions[1] + rowIndex) * dimensions[0];
+        for (int columnIndex = 0; columnIndex < dimensions[0]; ++columnIndex, displacement += 3)
+          {
+          double ijk[3] =
+            {
+            (extent[0] + columnIndex) * spacing[0],
+            (extent[2] + rowIndex) * spacing[1],
+            (extent[4] + sliceIndex) * spacing[2]
+            };
+          double point[3] = { origin[0], origin[1], origin[2] };
+          for (int row = 0; row < 3; row++)
+            {
+            point[row] += direction[row][0] * ijk[0] + direction[row][1] * ijk[1] + direction[row][2] * ijk[2];
+            }
+
+          // Initial guess: apply the negated forward displacement
+          double transformedPoint[3] = { 0.0, 0.0, 0.0 };
+          forwardTransform->TransformPoint(point, transformedPoint);
+          double inversePoint[3] =
+            {
+            2.0 * point[0] - transformedPoint[0],
+            2.0 * point[1] - transformedPoint[1],
+            2.0 * point[2] - transformedPoint[2]
+            };
+          // Fixed-point iteration: y(k+1) = y(k) + (x - T(y(k)))
+          for (int iteration = 0; iteration < maximumNumberOfIterations; ++iteration)
+            {
+            forwardTransform->TransformPoint(inversePoint, transformedPoint);
+            double residual[3] =
+              {
+              point[0] - transformedPoint[0],
+              point[1] - transformedPoint[1],
+              point[2] - transformedPoint[2]
+              };
+            if (vtkMath::Dot(residual, residual) < toleranceSquared)
+              {
+              break;
+              }
+            inversePoint[0] += residual[0];
+            inversePoint[1] += residual[1];
+            inversePoint[2] += residual[2];
+            }
+
+          displacement[0] = inversePoint[0] - point[0];
+          displacement[1] = inversePoint[1] - point[1];
+          displacement[2] = inversePoint[2] - point[2];
+          }
+        }
+      }
+    });
+
+  vtkSmartPointer<vtkOrientedGridTransform> inverseTransform = vtkSmartPointer<vtkOrientedGridTransform>::New();
+  inverseTransform->SetDisplacementGridData(displacementField);
+  if (gridDirection)
+    {
+    inverseTransform->SetGridDirectionMatrix(gridDirection);
+    }
+  return inverseTransform;
+}
+
+//----------------------------------------------------------------------------
+/// Get the latest modification time of the components of the transform,
+/// including the grids of grid and B-spline transforms.
+vtkMTimeType GetTransformComponentsMTime(vtkAbstractTransform* transform)
+{
+  vtkMTimeType mtime = transform->GetMTime();
+  vtkNew<vtkCollection> transformList;
+  vtkMRMLTransformNode::FlattenGeneralTransform(transformList.GetPointer(), transform);
+  vtkCollectionSimpleIterator it;
+  vtkAbstractTransform* component = nullptr;
+  for (transformList->InitTraversal(it); (component = vtkAbstractTransform::SafeDownCast(transformList->GetNextItemAsObject(it)));)
+    {
+    mtime = std::max(mtime, component->GetMTime());
+    vtkGridTransform* gridTransform = vtkGridTransform::SafeDownCast(component);
+    if (gridTransform && gridTransform->GetDisplacementGrid())
+      {
+      mtime = std::max(mtime, gridTransform->GetDisplacementGrid()->GetMTime());
+      }
+    vtkBSplineTransform* bsplineTransform = vtkBSplineTransform::SafeDownCast(component);
+    if (bsplineTransform && bsplineTransform->GetCoefficientData())
+      {
+      mtime = std::max(mtime, bsplineTransform->GetCoefficientData()->GetMTime());
+      }
+    }
+  return mtime;
+}
+
+}
+
 //----------------------------------------------------------------------------
 vtkMRMLNodeNewMacro(vtkMRMLTransformNode);
 
@@ -58,6 +197,11 @@ vtkMRMLTransformNode::vtkMRMLTransformNode()
   this->CachedMatrixTransformToParent=vtkMatrix4x4::New();
   this->CachedMatrixTransformFromParent=vtkMatrix4x4::New();
 
+  this->CacheInverseDisplacementField = false;
+  this->CachedInverseTransform = nullptr;
+  this->CachedInverseForwardTransform = nullptr;
+  this->CachedInverseForwardTransformMTime = 0;
+
   this->ContentModifiedEvents->InsertNextValue(vtkMRMLTransformableNode::TransformModifiedEvent);
 
   this->DefaultSequenceStorageNodeClassName = "vtkMRMLLinearTransformSequenceStorageNode";
@@ -73,6 +217,12 @@ vtkMRMLTransformNode::~vtkMRMLTransformNode()
   this->CachedMatrixTransformToParent=nullptr;
   this->CachedMatrixTransformFromParent->Delete();
   this->CachedMatrixTransformFromParent=nullptr;
+
+  if (this->CachedInverseTransform)
+    {
+    this->CachedInverseTransform->UnRegister(this);
+    this->CachedInverseTransform = nullptr;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -305,6 +455,7 @@ void vtkMRMLTransformNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*=true*
   if (deepCopy)
   {
   this->SetReadAsTransformToParent(node->GetReadAsTransformToParent());
+  this->SetCacheInverseDisplacementField(node->GetCacheInverseDisplacementField());
 
   // Unfortunately VTK transform DeepCopy actually performs a shallow copy (only data object
   // pointers are copied, but not the contents itself), so we have to apply our custom DeepCopy
@@ -347,6 +498,7 @@ void vtkMRMLTransformNode::PrintSelf(ostream& os, vtkIndent indent)
 {
   Superclass::PrintSelf(os,indent);
   os << indent << "ReadAsTransformToParent: " << this->ReadAsTransformToParent << "\n";
+  os << indent << "CacheInverseDisplacementField: " << (this->CacheInverseDisplacementField ? "true" : "false") << "\n";
 
   // Flatten the transform list to make the copying simpler
   if (this->TransformToParent)
@@ -413,6 +565,113 @@ vtkAbstractTransform* vtkMRMLTransformNode::GetTransformFromParent()
     }
 }
 
+//----------------------------------------------------------------------------
+vtkAbstractTransform* vtkMRMLTransformNode::GetTransformToParentForConcatenation()
+{
+  if (!this->TransformToParent && this->TransformFromParent)
+    {
+    vtkAbstractTransform* cachedInverseTransform = this->GetCachedInverseTransform(this->TransformFromParent);
+    if (cachedInverseTransform)
+      {
+      return cachedInverseTransform;
+      }
+    }
+  return this->GetTransformToParent();
+}
+
+//----------------------------------------------------------------------------
+vtkAbstractTransform* vtkMRMLTransformNode::GetTransformFromParentForConcatenation()
+{
+  if (!this->TransformFromParent && this->TransformToParent)
+    {
+    vtkAbstractTransform* cachedInverseTransform = this->GetCachedInverseTransform(this->TransformToParent);
+    if (cachedInverseTransform)
+      {
+      return cachedInverseTransform;
+      }
+    }
+  return this->GetTransformFromParent();
+}
+
+//----------------------------------------------------------------------------
+vtkAbstractTransform* vtkMRMLTransformNode::GetCachedInverseTransform(vtkAbstractTransform* forwardTransform)
+{
+  if (!this->CacheInverseDisplacementField || !forwardTransform)
+    {
+    return nullptr;
+    }
+
+  // Only single grid and B-spline transforms are inverted explicitly
+  vtkNew<vtkCollection> forwardTransformList;
+  vtkMRMLTransformNode::FlattenGeneralTransform(forwardTransformList.GetPointer(), forwardTransform);
+  if (forwardTransformList->GetNumberOfItems() != 1)
+    {
+    return nullptr;
+    }
+  vtkAbstractTransform* forwardComponent = vtkAbstractTransform::SafeDownCast(forwardTransformList->GetItemAsObject(0));
+  vtkOrientedGridTransform* gridTransform = vtkOrientedGridTransform::SafeDownCast(forwardComponent);
+  vtkOrientedBSplineTransform* bsplineTransform = vtkOrientedBSplineTransform::SafeDownCast(forwardComponent);
+  if (!gridTransform && !bsplineTransform)
+    {
+    return nullptr;
+    }
+  vtkImageData* grid = (gridTransform ? gridTransform->GetDisplacementGrid() : bsplineTransform->GetCoefficientData());
+  if (!grid)
+    {
+    return nullptr;
+    }
+
+  vtkMTimeType forwardTransformMTime = std::max(std::max(forwardTransform->GetMTime(), forwardComponent->GetMTime()), grid->GetMTime());
+  if (this->CachedInverseTransform
+    && this->CachedInverseForwardTransform == forwardTransform
+    && this->CachedInverseForwardTransformMTime == forwardTransformMTime)
+    {
+    return this->CachedInverseTransform;
+    }
+
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  grid->GetExtent(extent);
+  if (extent[0] > extent[1] || extent[2] > extent[3] || extent[4] > extent[5])
+    {
+    return nullptr;
+    }
+  double origin[3] = { 0.0, 0.0, 0.0 };
+  grid->GetOrigin(origin);
+  double spacing[3] = { 1.0, 1.0, 1.0 };
+  grid->GetSpacing(spacing);
+  vtkMatrix4x4* gridDirection = nullptr;
+  if (gridTransform)
+    {
+    gridDirection = gridTransform->GetGridDirectionMatrix();
+    }
+  else
+    {
+    // B-spline coefficients are sparse, sample the inverse at twice the coefficient grid resolution
+    gridDirection = bsplineTransform->GetGridDirectionMatrix();
+    for (int i = 0; i < 3; i++)
+      {
+      extent[2 * i] *= 2;
+      extent[2 * i + 1] *= 2;
+      spacing[i] /= 2.0;
+      }
+    }
+
+  vtkSmartPointer<vtkOrientedGridTransform> inverseTransform =
+    ComputeInverseDisplacementField(forwardTransform, extent, origin, spacing, gridDirection);
+
+  // A new transform object is created each time, so that users of the concatenated
+  // transforms can detect the change by comparing the transform components.
+  if (this->CachedInverseTransform)
+    {
+    this->CachedInverseTransform->UnRegister(this);
+    }
+  this->CachedInverseTransform = inverseTransform;
+  this->CachedInverseTransform->Register(this);
+  this->CachedInverseForwardTransform = forwardTransform;
+  this->CachedInverseForwardTransformMTime = forwardTransformMTime;
+  return this->CachedInverseTransform;
+}
+
 //----------------------------------------------------------------------------
 int  vtkMRMLTransformNode::IsTransformToWorldLinear()
 {
@@ -539,7 +798,7 @@ void vtkMRMLTransformNode::GetTransformBetweenNodes(vtkMRMLTransformNode* source
     // traverse the transform tree from bottom to top, from sourceNode to targetNode
     for (vtkMRMLTransformNode* current = sourceNode; current != targetNode; current = current->GetParentTransformNode())
       {
-      vtkAbstractTransform* transformToParent=current->GetTransformToParent();
+      vtkAbstractTransform* transformToParent=current->GetTransformToParentForConcatenation();
       if (transformToParent)
         {
         transformSourceToTarget->Concatenate(transformToParent);
@@ -558,28 +817,69 @@ void vtkMRMLTransformNode::GetTransformBetweenNodes(vtkMRMLTransformNode* source
     }
   else if (sourceNode == nullptr || sourceNode->IsTransformNodeMyChild(targetNode))
     {
-    // traverse the transform tree from bottom to top, from targetNode to sourceNode
-    for (vtkMRMLTransformNode* current = targetNode; current != sourceNode; current = current->GetParentTransformNode())
+    bool concatenateTransformsFromParent = false;
+    for (vtkMRMLTransformNode* current = targetNode; current != sourceNode && currentDepth <= maxDepth;
+      current = current->GetParentTransformNode(), ++currentDepth)
       {
-      vtkAbstractTransform* transformToParent=current->GetTransformToParent();
-      if (transformToParent)
+      if (current->GetCacheInverseDisplacementField())
         {
-        transformSourceToTarget->Concatenate(transformToParent);
+        concatenateTransformsFromParent = true;
+        break;
         }
+      }
+    currentDepth = 0;
 
-      ++currentDepth;
-      if (currentDepth > maxDepth && !visitedTransformNodes.insert(current).second)
+    if (concatenateTransformsFromParent)
+      {
+      // traverse the transform tree from bottom to top, from targetNode to sourceNode,
+      // and concatenate transforms from parent (so that cached explicit inverse transforms
+      // are used instead of inverting the transforms to parent)
+      transformSourceToTarget->PreMultiply();
+      for (vtkMRMLTransformNode* current = targetNode; current != sourceNode; current = current->GetParentTransformNode())
         {
-        // Max depth exceeded and duplicate transform found. Loop detected.
-        // See issue https://github.com/Slicer/Slicer/issues/6355.
-        vtkGenericWarningMacro("vtkMRMLTransformNode::GetTransformBetweenNodes: Loop detected between transform nodes");
-        transformSourceToTarget->Identity();
-        break;
+        vtkAbstractTransform* transformFromParent=current->GetTransformFromParentForConcatenation();
+        if (transformFromParent)
+          {
+          transformSourceToTarget->Concatenate(transformFromParent);
+          }
+
+        ++currentDepth;
+        if (currentDepth > maxDepth && !visitedTransformNodes.insert(current).second)
+          {
+          // Max depth exceeded and duplicate transform found. Loop detected.
+          // See issue https://github.com/Slicer/Slicer/issues/6355.
+          vtkGenericWarningMacro("vtkMRMLTransformNode::GetTransformBetweenNodes: Loop detected between transform nodes");
+          transformSourceToTarget->Identity();
+          break;
+          }
         }
+      transformSourceToTarget->PostMultiply();
+      }
+    else
+      {
+      // traverse the transform tree from bottom to top, from targetNode to sourceNode
+      for (vtkMRMLTransformNode* current = targetNode; current != sourceNode; current = current->GetParentTransformNode())
+        {
+        vtkAbstractTransform* transformToParent=current->GetTransformToParent();
+        if (transformToParent)
+          {
+          transformSourceToTarget->Concatenate(transformToParent);
+          }
+
+        ++currentDepth;
+        if (currentDepth > maxDepth && !visitedTransformNodes.insert(current).second)
+          {
+          // Max depth exceeded and duplicate transform found. Loop detected.
+          // See issue https://github.com/Slicer/Slicer/issues/6355.
+          vtkGenericWarningMacro("vtkMRMLTransformNode::GetTransformBetweenNodes: Loop detected between transform nodes");
+          transformSourceToTarget->Identity();
+          break;
+          }
+        }
+      // in transformSourceToTarget we have transform targetNode->sourceNode,
+      // need to invert to get sourceNode->targetNode
+      transformSourceToTarget->Inverse();
       }
-    // in transformSourceToTarget we have transform targetNode->sourceNode,
-    // need to invert to get sourceNode->targetNode
-    transformSourceToTarget->Inverse();
     }
   else
     {
@@ -588,13 +888,165 @@ void vtkMRMLTransformNode::GetTransformBetweenNodes(vtkMRMLTransformNode* source
     sourceNode->GetTransformToNode(firstCommonParentNode, transformSourceToTarget);
 
     vtkNew<vtkGeneralTransform> transformFromCommonParentNode;
-    targetNode->GetTransformToNode(firstCommonParentNode, transformFromCommonParentNode.GetPointer());
-    transformFromCommonParentNode->Inverse();
+    vtkMRMLTransformNode::GetTransformBetweenNodes(firstCommonParentNode, targetNode, transformFromCommonParentNode.GetPointer());
 
     transformSourceToTarget->Concatenate(transformFromCommonParentNode.GetPointer());
     }
 }
 
+//----------------------------------------------------------------------------
+vtkOrientedGridTransform* vtkMRMLTransformNode::GetBakedTransformToWorld(vtkMatrix4x4* gridToWorld, const int extent[6])
+{
+  vtkNew<vtkGeneralTransform> transformToWorld;
+  this->GetTransformToWorld(transformToWorld);
+  return this->GetBakedTransform(transformToWorld, gridToWorld, extent, this->BakedTransformsToWorld);
+}
+
+//----------------------------------------------------------------------------
+vtkOrientedGridTransform* vtkMRMLTransformNode::GetBakedTransformFromWorld(vtkMatrix4x4* gridToWorld, const int extent[6])
+{
+  vtkNew<vtkGeneralTransform> transformFromWorld;
+  this->GetTransformFromWorld(transformFromWorld);
+  return this->GetBakedTransform(transformFromWorld, gridToWorld, extent, this->BakedTransformsFromWorld);
+}
+
+//----------------------------------------------------------------------------
+vtkOrientedGridTransform* vtkMRMLTransformNode::GetBakedTransform(vtkGeneralTransform* transform,
+  vtkMatrix4x4* gridToWorld, const int extent[6], std::deque<BakedTransformInfo>& bakedTransforms)
+{
+  // Baked transforms are often requested for a few different grids (e.g., for the volumes
+  // shown in the slice views), so a few of them are kept.
+  const size_t maximumNumberOfBakedTransforms = 4;
+
+  if (!gridToWorld || !extent)
+    {
+    vtkErrorMacro("vtkMRMLTransformNode::GetBakedTransform failed: invalid grid");
+    return nullptr;
+    }
+
+  double grid[22] = { 0.0 };
+  for (int i = 0; i < 16; i++)
+    {
+    grid[i] = gridToWorld->GetElement(i / 4, i % 4);
+    }
+  for (int i = 0; i < 6; i++)
+    {
+    grid[16 + i] = extent[i];
+    }
+  vtkMTimeType transformMTime = GetTransformComponentsMTime(transform);
+
+  for (std::deque<BakedTransformInfo>::iterator bakedTransformIt = bakedTransforms.begin();
+    bakedTransformIt != bakedTransforms.end(); ++bakedTransformIt)
+    {
+    if (!std::equal(grid, grid + 22, bakedTransformIt->Grid))
+      {
+      continue;
+      }
+    if (bakedTransformIt->SourceTransformMTime == transformMTime
+      && vtkMRMLTransformNode::AreTransformsEqual(transform, bakedTransformIt->SourceTransform))
+      {
+      return bakedTransformIt->GridTransform;
+      }
+    // Outdated, it will be recomputed
+    bakedTransforms.erase(bakedTransformIt);
+    break;
+    }
+
+  vtkSmartPointer<vtkOrientedGridTransform> gridTransform = vtkSmartPointer<vtkOrientedGridTransform>::New();
+  if (!vtkMRMLTransformNode::SampleTransformOnGrid(transform, gridToWorld, extent, gridTransform))
+    {
+    return nullptr;
+    }
+
+  BakedTransformInfo bakedTransform;
+  bakedTransform.GridTransform = gridTransform;
+  // Keep a reference to the source transform so that its components are not deleted
+  // and can be compared to the current transform components.
+  bakedTransform.SourceTransform = transform;
+  bakedTransform.SourceTransformMTime = transformMTime;
+  std::copy(grid, grid + 22, bakedTransform.Grid);
+  bakedTransforms.push_front(bakedTransform);
+  if (bakedTransforms.size() > maximumNumberOfBakedTransforms)
+    {
+    bakedTransforms.pop_back();
+    }
+  return gridTransform;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLTransformNode::SampleTransformOnGrid(vtkAbstractTransform* transform, vtkMatrix4x4* gridToWorld,
+  const int extent[6], vtkOrientedGridTransform* outputGridTransform)
+{
+  if (!transform || !gridToWorld || !extent || !outputGridTransform)
+    {
+    vtkGenericWarningMacro("vtkMRMLTransformNode::SampleTransformOnGrid failed: invalid inputs");
+    return false;
+    }
+  if (extent[0] > extent[1] || extent[2] > extent[3] || extent[4] > extent[5])
+    {
+    vtkGenericWarningMacro("vtkMRMLTransformNode::SampleTransformOnGrid failed: empty grid extent");
+    return false;
+    }
+
+  // Split the grid to world matrix to origin, spacing, and axis directions
+  double origin[3] = { 0.0, 0.0, 0.0 };
+  double spacing[3] = { 1.0, 1.0, 1.0 };
+  vtkNew<vtkMatrix4x4> gridDirection;
+  for (int column = 0; column < 3; column++)
+    {
+    double axis[3] = { gridToWorld->GetElement(0, column), gridToWorld->GetElement(1, column), gridToWorld->GetElement(2, column) };
+    spacing[column] = vtkMath::Norm(axis);
+    if (spacing[column] == 0.0)
+      {
+      vtkGenericWarningMacro("vtkMRMLTransformNode::SampleTransformOnGrid failed: invalid grid to world matrix");
+      return false;
+      }
+    for (int row = 0; row < 3; row++)
+      {
+      gridDirection->SetElement(row, column, axis[row] / spacing[column]);
+      }
+    origin[column] = gridToWorld->GetElement(column, 3);
+    }
+
+  vtkNew<vtkImageData> displacementField;
+  displacementField->SetExtent(const_cast<int*>(extent));
+  displacementField->SetOrigin(origin);
+  displacementField->SetSpacing(spacing);
+  displacementField->AllocateScalars(VTK_DOUBLE, 3);
+  double* displacements = static_cast<double*>(displacementField->GetScalarPointer());
+  int dimensions[3] = { extent[1] - extent[0] + 1, extent[3] - extent[2] + 1, extent[5] - extent[4] + 1 };
+
+  // Make sure the transform is up-to-date before it is used from multiple threads
+  transform->Update();
+
+  // Process rows in parallel, so that single-slice grids are sampled in parallel as well
+  vtkSMPTools::For(0, dimensions[1] * dimensions[2], [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    double point_Grid[4] = { 0.0, 0.0, 0.0, 1.0 };
+    double point_World[4] = { 0.0, 0.0, 0.0, 1.0 };
+    double transformedPoint_World[3] = { 0.0, 0.0, 0.0 };
+    double* displacement = displacements + 3 * beginRow * dimensions[0];
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      point_Grid[1] = extent[2] + row % dimensions[1];
+      point_Grid[2] = extent[4] + row / dimensions[1];
+      for (int columnIndex = 0; columnIndex < dimensions[0]; ++columnIndex, displacement += 3)
+        {
+        point_Grid[0] = extent[0] + columnIndex;
+        gridToWorld->MultiplyPoint(point_Grid, point_World);
+        transform->TransformPoint(point_World, transformedPoint_World);
+        displacement[0] = transformedPoint_World[0] - point_World[0];
+        displacement[1] = transformedPoint_World[1] - point_World[1];
+        displacement[2] = transformedPoint_World[2] - point_World[2];
+        }
+      }
+    });
+
+  outputGridTransform->SetDisplacementGridData(displacementField);
+  outputGridTransform->SetGridDirectionMatrix(gridDirection);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkMRMLTransformNode::IsTransformNodeMyParent(vtkMRMLTransformNode* node)
 {
@@ -17,10 +17,14 @@
 
 #include "vtkMRMLDisplayableNode.h"
 
+// STD includes
+#include <deque>
+
 class vtkCollection;
 class vtkAbstractTransform;
 class vtkGeneralTransform;
 class vtkMatrix4x4;
+class vtkOrientedGridTransform;
 class vtkTransform;
 
 /// \brief MRML node for representing a transformation
@@ -146,6 +150,26 @@ public:
   static void GetTransformBetweenNodes(vtkMRMLTransformNode* sourceNode,
     vtkMRMLTransformNode* targetNode, vtkGeneralTransform* transformSourceToTarget);
 
+  ///
+  /// Get concatenated transforms to/from world, baked into a single grid transform.
+  /// Applying the grid transform only requires interpolation of a displacement field,
+  /// which is much faster than evaluating a chain of non-linear transforms at each point,
+  /// at the cost of some interpolation error.
+  /// \param gridToWorld Grid point index (IJK) to world matrix, may contain rotation.
+  /// \param extent Grid extent, defines the region where the transform is accurate.
+  /// The grid transform is cached in the node and reused while the transforms
+  /// in the hierarchy and the requested grid are unchanged.
+  /// Returns nullptr if the transform could not be computed.
+  vtkOrientedGridTransform* GetBakedTransformToWorld(vtkMatrix4x4* gridToWorld, const int extent[6]);
+  vtkOrientedGridTransform* GetBakedTransformFromWorld(vtkMatrix4x4* gridToWorld, const int extent[6]);
+
+  ///
+  /// Sample the transform at each point of the grid and store it in the output grid transform.
+  /// Grid slices are sampled in parallel.
+  /// \param gridToWorld Grid point index (IJK) to world matrix, may contain rotation.
+  static bool SampleTransformOnGrid(vtkAbstractTransform* transform, vtkMatrix4x4* gridToWorld,
+    const int extent[6], vtkOrientedGridTransform* outputGridTransform);
+
   ///
   /// Get concatenated transforms to world.
   /// Returns 0 if the transform is not linear (cannot be described by a matrix).
@@ -268,6 +292,19 @@ public:
   vtkSetMacro(ReadAsTransformToParent, int);
   vtkBooleanMacro(ReadAsTransformToParent, int);
 
+  /// Get/Set for CacheInverseDisplacementField
+  /// If enabled and the transform is a single grid or B-spline transform that is only
+  /// specified in one direction, then concatenated transforms (GetTransformToWorld,
+  /// GetTransformFromWorld, GetTransformBetweenNodes, ...) use an explicit inverse
+  /// displacement field instead of the iterative inversion of the transform at each point.
+  /// The inverse displacement field is computed on the grid of the forward transform when it
+  /// is first needed and recomputed when the forward transform is modified.
+  /// The inverse is an approximation, therefore it is not used for storing the transform.
+  /// Disabled by default.
+  vtkGetMacro(CacheInverseDisplacementField, bool);
+  vtkSetMacro(CacheInverseDisplacementField, bool);
+  vtkBooleanMacro(CacheInverseDisplacementField, bool);
+
   ///
   /// Indicates that the transform inside the object is modified.
   /// Typical usage would be to disable transform modified events, call a series of operations that change transforms
@@ -381,6 +418,35 @@ protected:
   /// Sets and observes a transform and deletes the inverse (so that the inverse will be computed automatically)
   virtual void SetAndObserveTransform(vtkAbstractTransform** originalTransformPtr, vtkAbstractTransform** inverseTransformPtr, vtkAbstractTransform *transform);
 
+  ///
+  /// Transform of this node to/from parent, for concatenating with other transforms.
+  /// Same as GetTransformToParent/GetTransformFromParent, except that the cached inverse
+  /// displacement field is returned instead of the iterative inverse if
+  /// CacheInverseDisplacementField is enabled.
+  vtkAbstractTransform* GetTransformToParentForConcatenation();
+  vtkAbstractTransform* GetTransformFromParentForConcatenation();
+
+  ///
+  /// Returns the explicit inverse of the forward transform (computed and cached if necessary).
+  /// Returns nullptr if the inverse is not cached for this kind of transform.
+  vtkAbstractTransform* GetCachedInverseTransform(vtkAbstractTransform* forwardTransform);
+
+  /// Cached result of GetBakedTransformToWorld or GetBakedTransformFromWorld
+  struct BakedTransformInfo
+    {
+    vtkSmartPointer<vtkOrientedGridTransform> GridTransform;
+    /// Concatenated transform that the grid transform was computed from
+    vtkSmartPointer<vtkGeneralTransform> SourceTransform;
+    vtkMTimeType SourceTransformMTime = 0;
+    /// Grid to world matrix elements followed by the extent
+    double Grid[22] = { 0.0 };
+    };
+  ///
+  /// Returns the baked transform from the cache or computes it if it is not found in the cache.
+  /// The cache keeps the most recently used few grids.
+  vtkOrientedGridTransform* GetBakedTransform(vtkGeneralTransform* transform, vtkMatrix4x4* gridToWorld,
+    const int extent[6], std::deque<BakedTransformInfo>& bakedTransforms);
+
   ///
   /// These transforms store the transforms that were set externally.
   /// We use the capability of generic transforms for concatenating and inverting the same
@@ -400,6 +466,16 @@ protected:
   /// GetMatrixTransformToParent and GetMatrixFromParent methods
   vtkMatrix4x4* CachedMatrixTransformToParent;
   vtkMatrix4x4* CachedMatrixTransformFromParent;
+
+  bool CacheInverseDisplacementField;
+  /// Explicit inverse of CachedInverseForwardTransform
+  vtkAbstractTransform* CachedInverseTransform;
+  /// Transform that CachedInverseTransform was computed from. Only used for comparison.
+  vtkAbstractTransform* CachedInverseForwardTransform;
+  vtkMTimeType CachedInverseForwardTransformMTime;
+
+  std::deque<BakedTransformInfo> BakedTransformsToWorld;
+  std::deque<BakedTransformInfo> BakedTransformsFromWorld;
 };
 
 #endif
@@ -57,9 +57,14 @@ vtkMRMLViewNode::vtkMRMLViewNode()
   this->OrientationMarkerEnabled = true;
   this->RulerEnabled = true;
   this->GPUMemorySize = 0; // Means application default
+  this->VolumeRenderingFrameCacheSize = 0;
   this->AutoReleaseGraphicsResources = false;
   this->ExpectedFPS = 8.;
   this->VolumeRenderingQuality = vtkMRMLViewNode::Normal;
+  this->VolumeRenderingUseMeasuredFrameTime = false;
+  this->VolumeRenderingFrameTime = 0.0;
+  this->VolumeRenderingTextureMemorySize = 0.0;
+  this->VolumeRenderingTextureUploadTime = 0.0;
   this->RaycastTechnique = vtkMRMLViewNode::Composite;
   this->VolumeRenderingSurfaceSmoothing = false;
   this->VolumeRenderingOversamplingFactor = 2.0;
@@ -104,9 +109,11 @@ void vtkMRMLViewNode::WriteXML(ostream& of, int nIndent)
   vtkMRMLWriteXMLEnumMacro(renderMode, RenderMode);
   vtkMRMLWriteXMLIntMacro(useDepthPeeling, UseDepthPeeling);
   vtkMRMLWriteXMLIntMacro(gpuMemorySize, GPUMemorySize);
+  vtkMRMLWriteXMLIntMacro(volumeRenderingFrameCacheSize, VolumeRenderingFrameCacheSize);
   vtkMRMLWriteXMLBooleanMacro(autoReleaseGraphicsResources, AutoReleaseGraphicsResources);
   vtkMRMLWriteXMLFloatMacro(expectedFPS, ExpectedFPS);
   vtkMRMLWriteXMLEnumMacro(volumeRenderingQuality, VolumeRenderingQuality);
+  vtkMRMLWriteXMLBooleanMacro(volumeRenderingUseMeasuredFrameTime, VolumeRenderingUseMeasuredFrameTime);
   vtkMRMLWriteXMLEnumMacro(raycastTechnique, RaycastTechnique);
   vtkMRMLWriteXMLIntMacro(volumeRenderingSurfaceSmoothing, VolumeRenderingSurfaceSmoothing);
   vtkMRMLWriteXMLFloatMacro(volumeRenderingOversamplingFactor, VolumeRenderingOversamplingFactor);
@@ -142,9 +149,11 @@ void vtkMRMLViewNode::ReadXMLAttributes(const char** atts)
   vtkMRMLReadXMLEnumMacro(renderMode, RenderMode);
   vtkMRMLReadXMLIntMacro(useDepthPeeling, UseDepthPeeling);
   vtkMRMLReadXMLIntMacro(gpuMemorySize, GPUMemorySize);
+  vtkMRMLReadXMLIntMacro(volumeRenderingFrameCacheSize, VolumeRenderingFrameCacheSize);
   vtkMRMLReadXMLBooleanMacro(autoReleaseGraphicsResources, AutoReleaseGraphicsResources);
   vtkMRMLReadXMLFloatMacro(expectedFPS, ExpectedFPS);
   vtkMRMLReadXMLEnumMacro(volumeRenderingQuality, VolumeRenderingQuality);
+  vtkMRMLReadXMLBooleanMacro(volumeRenderingUseMeasuredFrameTime, VolumeRenderingUseMeasuredFrameTime);
   vtkMRMLReadXMLEnumMacro(raycastTechnique, RaycastTechnique);
   vtkMRMLReadXMLIntMacro(volumeRenderingSurfaceSmoothing, VolumeRenderingSurfaceSmoothing);
   vtkMRMLReadXMLFloatMacro(volumeRenderingOversamplingFactor, VolumeRenderingOversamplingFactor);
@@ -181,9 +190,11 @@ void vtkMRMLViewNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*=true*/)
   vtkMRMLCopyEnumMacro(RenderMode);
   vtkMRMLCopyIntMacro(UseDepthPeeling);
   vtkMRMLCopyIntMacro(GPUMemorySize);
+  vtkMRMLCopyIntMacro(VolumeRenderingFrameCacheSize);
   vtkMRMLCopyBooleanMacro(AutoReleaseGraphicsResources);
   vtkMRMLCopyFloatMacro(ExpectedFPS);
   vtkMRMLCopyIntMacro(VolumeRenderingQuality);
+  vtkMRMLCopyBooleanMacro(VolumeRenderingUseMeasuredFrameTime);
   vtkMRMLCopyIntMacro(RaycastTechnique);
   vtkMRMLCopyIntMacro(VolumeRenderingSurfaceSmoothing);
   vtkMRMLCopyFloatMacro(VolumeRenderingOversamplingFactor);
@@ -217,9 +228,14 @@ void vtkMRMLViewNode::PrintSelf(ostream& os, vtkIndent indent)
   vtkMRMLPrintEnumMacro(RenderMode);
   vtkMRMLPrintIntMacro(UseDepthPeeling);
   vtkMRMLPrintIntMacro(GPUMemorySize);
+  vtkMRMLPrintIntMacro(VolumeRenderingFrameCacheSize);
   vtkMRMLPrintBooleanMacro(AutoReleaseGraphicsResources);
   vtkMRMLPrintFloatMacro(ExpectedFPS);
   vtkMRMLPrintIntMacro(VolumeRenderingQuality);
+  vtkMRMLPrintBooleanMacro(VolumeRenderingUseMeasuredFrameTime);
+  vtkMRMLPrintFloatMacro(VolumeRenderingFrameTime);
+  vtkMRMLPrintFloatMacro(VolumeRenderingTextureMemorySize);
+  vtkMRMLPrintFloatMacro(VolumeRenderingTextureUploadTime);
   vtkMRMLPrintIntMacro(RaycastTechnique);
   vtkMRMLPrintIntMacro(VolumeRenderingSurfaceSmoothing);
   vtkMRMLPrintFloatMacro(VolumeRenderingOversamplingFactor);
@@ -515,3 +531,19 @@ void vtkMRMLViewNode::SetInteractionFlags(unsigned int flags)
   // Don't call Modified()
   this->InteractionFlags = flags;
 }
+
+//-----------------------------------------------------------
+void vtkMRMLViewNode::SetVolumeRenderingStatistics(double frameTime, double textureMemorySize, double textureUploadTime)
+{
+  if (this->VolumeRenderingFrameTime == frameTime
+    && this->VolumeRenderingTextureMemorySize == textureMemorySize
+    && this->VolumeRenderingTextureUploadTime == textureUploadTime)
+    {
+    return;
+    }
+  // Don't call Modified(), as it would trigger rendering
+  this->VolumeRenderingFrameTime = frameTime;
+  this->VolumeRenderingTextureMemorySize = textureMemorySize;
+  this->VolumeRenderingTextureUploadTime = textureUploadTime;
+  this->InvokeEvent(vtkMRMLViewNode::VolumeRenderingStatisticsModifiedEvent);
+}
@@ -149,6 +149,14 @@ public:
   vtkGetMacro(GPUMemorySize, int);
   vtkSetMacro(GPUMemorySize, int);
 
+  /// GPU memory size in MB that GPU volume rendering may use for keeping
+  /// the textures of recently displayed volumes of a sequence (4D volume rendering).
+  /// Switching back to a frame that is still in graphics memory does not
+  /// upload the volume again, which allows replaying sequences at display rate.
+  /// 0 by default (only the currently displayed volume is kept).
+  vtkGetMacro(VolumeRenderingFrameCacheSize, int);
+  vtkSetMacro(VolumeRenderingFrameCacheSize, int);
+
   ///@{
   /// Enable/Disable automatic immediate release of graphics resources
   /// when not in use. If GPU volume rendering is used, enabling this option
@@ -170,6 +178,31 @@ public:
   static const char* GetVolumeRenderingQualityAsString(int id);
   static int GetVolumeRenderingQualityFromString(const char* name);
 
+  ///@{
+  /// In adaptive quality mode, adjust the rendering speed from the measured volume rendering
+  /// frame time (see GetVolumeRenderingFrameTime) instead of the renderer's time estimates.
+  /// Disabled by default.
+  vtkSetMacro(VolumeRenderingUseMeasuredFrameTime, bool);
+  vtkGetMacro(VolumeRenderingUseMeasuredFrameTime, bool);
+  vtkBooleanMacro(VolumeRenderingUseMeasuredFrameTime, bool);
+  ///@}
+
+  ///@{
+  /// Volume rendering performance statistics of this view, measured by the volume rendering
+  /// displayable manager.
+  /// Frame time is the GPU time of the last rendered frame in milliseconds (CPU time
+  /// if GPU timer queries are not available). Texture memory size is the estimated size
+  /// of the volume textures in MB. Texture upload time is the frame time of the last
+  /// frame that uploaded a new or modified volume to the GPU, in milliseconds.
+  /// These values are not saved into the scene. Setting them invokes
+  /// VolumeRenderingStatisticsModifiedEvent instead of Modified(), so that updating the
+  /// statistics after each frame does not trigger rendering.
+  void SetVolumeRenderingStatistics(double frameTime, double textureMemorySize, double textureUploadTime);
+  vtkGetMacro(VolumeRenderingFrameTime, double);
+  vtkGetMacro(VolumeRenderingTextureMemorySize, double);
+  vtkGetMacro(VolumeRenderingTextureUploadTime, double);
+  ///@}
+
   /// Rycasting technique for volume rendering
   vtkGetMacro(RaycastTechnique, int);
   vtkSetMacro(RaycastTechnique, int);
@@ -266,6 +299,7 @@ public:
     {
     GraphicalResourcesCreatedEvent = 19001,
     ResetFocalPointRequestedEvent,
+    VolumeRenderingStatisticsModifiedEvent,
     };
 
   /// Get/Set a flag indicating whether this node is actively being
@@ -365,6 +399,9 @@ protected:
   /// A value of 0 indicates to use the default value in the settings
   int GPUMemorySize;
 
+  /// GPU memory size in MB for the textures of recently displayed sequence frames
+  int VolumeRenderingFrameCacheSize;
+
   /// Immediately release graphics resources when they are not in use.
   bool AutoReleaseGraphicsResources;
 
@@ -377,6 +414,14 @@ protected:
   /// 2: Maximum Quality
   int VolumeRenderingQuality;
 
+  /// Use measured frame time in adaptive volume rendering quality mode
+  bool VolumeRenderingUseMeasuredFrameTime;
+
+  /// Measured volume rendering statistics. Not saved into scene file.
+  double VolumeRenderingFrameTime;
+  double VolumeRenderingTextureMemorySize;
+  double VolumeRenderingTextureUploadTime;
+
   /// Techniques for volume rendering ray cast
   /// 0: Composite with directional lighting (default)
   /// 1: Composite with fake lighting (edge coloring, faster) - Not used
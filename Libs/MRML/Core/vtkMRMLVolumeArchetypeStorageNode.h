@@ -79,6 +79,10 @@ public:
   bool CanReadInReferenceNode(vtkMRMLNode* refNode) override;
   bool CanWriteFromReferenceNode(vtkMRMLNode* refNode) override;
 
+  /// Image is read and written by ITK readers and writers that only access the volume node
+  bool IsWriteDataThreadSafe() override { return true; };
+  bool IsReadDataThreadSafe() override { return true; };
+
   ///
   /// Configure the storage node for data exchange. This is an
   /// opportunity to optimize the storage node's settings, for
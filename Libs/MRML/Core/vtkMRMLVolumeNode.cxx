@@ -26,24 +26,29 @@ Version:   $Revision: 1.14 $
 #include <vtkAppendPolyData.h>
 #include <vtkBoundingBox.h>
 #include <vtkCallbackCommand.h>
+#include <vtkDataArray.h>
 #include <vtkEventForwarderCommand.h>
 #include <vtkGeneralTransform.h>
 #include <vtkHomogeneousTransform.h>
 #include <vtkImageData.h>
 #include <vtkImageDataGeometryFilter.h>
 #include <vtkImageReslice.h>
+#include <vtkInformation.h>
+#include <vtkInformationIntegerKey.h>
 #include <vtkMathUtilities.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
+#include <vtkPointData.h>
 #include <vtkSmartPointer.h>
 #include <vtkTransform.h>
 #include <vtkTrivialProducer.h>
 
-#include <algorithm> // For std::min
+#include <algorithm> // For std::min, std::max, std::copy
 #include <cassert>
 #include <vector>
 
 //----------------------------------------------------------------------------
+vtkInformationKeyMacro(vtkMRMLVolumeNode, SHARED_ARRAY, Integer);
 
 //----------------------------------------------------------------------------
 vtkMRMLVolumeNode::vtkMRMLVolumeNode()
@@ -71,6 +76,13 @@ vtkMRMLVolumeNode::vtkMRMLVolumeNode()
 
   this->VoxelVectorType = vtkMRMLVolumeNode::VoxelVectorTypeUndefined;
 
+  for (int i = 0; i < 3; i++)
+    {
+    this->ImageDataModifiedExtent[2 * i] = 0;
+    this->ImageDataModifiedExtent[2 * i + 1] = -1;
+    }
+  this->ImageDataModificationPending = false;
+
   this->ContentModifiedEvents->InsertNextValue(vtkMRMLVolumeNode::ImageDataModifiedEvent);
 }
 
@@ -193,6 +205,16 @@ void vtkMRMLVolumeNode::CopyOrientation(vtkMRMLVolumeNode *node)
   this->SetIJKToRASMatrix(ijkToRasmatrix);
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLVolumeNode::GetDataObjects(std::vector<vtkDataObject*>& dataObjects)
+{
+  Superclass::GetDataObjects(dataObjects);
+  if (this->GetImageData())
+    {
+    dataObjects.push_back(this->GetImageData());
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLVolumeNode::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -715,6 +737,69 @@ vtkImageData* vtkMRMLVolumeNode::GetImageData()
       this->ImageDataConnection->GetIndex()) : nullptr);
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeNode::SetAndObserveSharedImageData(vtkImageData* sourceImageData)
+{
+  if (!sourceImageData)
+    {
+    this->SetAndObserveImageData(nullptr);
+    return;
+    }
+  vtkNew<vtkImageData> imageData;
+  imageData->ShallowCopy(sourceImageData);
+  vtkPointData* pointData = imageData->GetPointData();
+  for (int arrayIndex = 0; arrayIndex < pointData->GetNumberOfArrays(); ++arrayIndex)
+    {
+    vtkDataArray* array = pointData->GetArray(arrayIndex);
+    if (array)
+      {
+      array->GetInformation()->Set(vtkMRMLVolumeNode::SHARED_ARRAY(), 1);
+      }
+    }
+  this->SetAndObserveImageData(imageData);
+}
+
+//---------------------------------------------------------------------------
+vtkImageData* vtkMRMLVolumeNode::GetImageDataForModification()
+{
+  vtkImageData* imageData = this->GetImageData();
+  if (!imageData)
+    {
+    return nullptr;
+    }
+  vtkPointData* pointData = imageData->GetPointData();
+  // Arrays are collected first, because replacing an attribute array changes the array order
+  std::vector<std::pair<vtkDataArray*, int> > sharedArrays;
+  for (int arrayIndex = 0; arrayIndex < pointData->GetNumberOfArrays(); ++arrayIndex)
+    {
+    vtkDataArray* array = pointData->GetArray(arrayIndex);
+    // One reference is held by the point data of this image. If there are more
+    // then the array is still used by the image it was shared with.
+    if (array && array->HasInformation() && array->GetInformation()->Get(vtkMRMLVolumeNode::SHARED_ARRAY())
+      && array->GetReferenceCount() > 1)
+      {
+      sharedArrays.emplace_back(array, pointData->IsArrayAnAttribute(arrayIndex));
+      }
+    }
+  for (const std::pair<vtkDataArray*, int>& sharedArray : sharedArrays)
+    {
+    vtkSmartPointer<vtkDataArray> arrayCopy = vtkSmartPointer<vtkDataArray>::Take(sharedArray.first->NewInstance());
+    arrayCopy->DeepCopy(sharedArray.first);
+    // DeepCopy copies the array information, but the copy is not shared
+    arrayCopy->GetInformation()->Remove(vtkMRMLVolumeNode::SHARED_ARRAY());
+    if (sharedArray.second >= 0)
+      {
+      pointData->SetAttribute(arrayCopy, sharedArray.second);
+      }
+    else if (sharedArray.first->GetName())
+      {
+      // replaces the array that has the same name
+      pointData->AddArray(arrayCopy);
+      }
+    }
+  return imageData;
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLVolumeNode
 ::SetImageDataConnection(vtkAlgorithmOutput *newImageDataConnection)
@@ -820,7 +905,15 @@ void vtkMRMLVolumeNode::ProcessMRMLEvents ( vtkObject *caller,
       this->ImageDataConnection->GetProducer() == vtkAlgorithm::SafeDownCast(caller) &&
     event ==  vtkCommand::ModifiedEvent)
     {
+    // the whole image data may have changed
+    this->ImageDataModifiedExtent[0] = 0;
+    this->ImageDataModifiedExtent[1] = -1;
+    this->ImageDataModificationPending = true;
     this->InvokeCustomModifiedEvent(vtkMRMLVolumeNode::ImageDataModifiedEvent);
+    if (!this->GetDisableModifiedEvent())
+      {
+      this->ImageDataModificationPending = false;
+      }
     return;
     }
 
@@ -1123,6 +1216,92 @@ int vtkMRMLVolumeNode::GetResamplingInterpolationMode()
   return VTK_LINEAR_INTERPOLATION;
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeNode::ImageDataModifiedInExtent(const int extent[6])
+{
+  vtkImageData* imageData = this->GetImageData();
+  if (!imageData)
+    {
+    vtkErrorMacro("ImageDataModifiedInExtent: No image data");
+    return;
+    }
+  int wholeExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  imageData->GetExtent(wholeExtent);
+  int modifiedExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  for (int i = 0; i < 3; i++)
+    {
+    modifiedExtent[2 * i] = std::max(extent[2 * i], wholeExtent[2 * i]);
+    modifiedExtent[2 * i + 1] = std::min(extent[2 * i + 1], wholeExtent[2 * i + 1]);
+    if (modifiedExtent[2 * i] > modifiedExtent[2 * i + 1])
+      {
+      // no voxels of the image data are modified
+      return;
+      }
+    }
+
+  if (!this->ImageDataModificationPending)
+    {
+    std::copy(modifiedExtent, modifiedExtent + 6, this->ImageDataModifiedExtent);
+    }
+  else if (this->ImageDataModifiedExtent[0] <= this->ImageDataModifiedExtent[1])
+    {
+    // modifications are being batched, notify the union of the modified extents
+    for (int i = 0; i < 3; i++)
+      {
+      this->ImageDataModifiedExtent[2 * i] = std::min(this->ImageDataModifiedExtent[2 * i], modifiedExtent[2 * i]);
+      this->ImageDataModifiedExtent[2 * i + 1] = std::max(this->ImageDataModifiedExtent[2 * i + 1], modifiedExtent[2 * i + 1]);
+      }
+    }
+  this->ImageDataModificationPending = true;
+
+  vtkPointData* pointData = imageData->GetPointData();
+  if (pointData && pointData->GetScalars())
+    {
+    pointData->GetScalars()->Modified();
+    }
+  if (pointData && pointData->GetTensors())
+    {
+    pointData->GetTensors()->Modified();
+    }
+
+  // same notifications as in SetImageDataConnection
+  int wasModifying = this->StartModify();
+  this->StorableModifiedTime.Modified();
+  this->Modified();
+  this->InvokeCustomModifiedEvent(vtkMRMLVolumeNode::ImageDataModifiedEvent);
+  this->EndModify(wasModifying);
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLVolumeNode::InvokePendingModifiedEvent()
+{
+  int numberOfPendingEvents = Superclass::InvokePendingModifiedEvent();
+  // the modified extent has been notified
+  this->ImageDataModificationPending = false;
+  return numberOfPendingEvents;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeNode::GetImageDataModifiedExtent(int extent[6])
+{
+  if (this->ImageDataModificationPending && this->ImageDataModifiedExtent[0] <= this->ImageDataModifiedExtent[1])
+    {
+    std::copy(this->ImageDataModifiedExtent, this->ImageDataModifiedExtent + 6, extent);
+    return;
+    }
+  vtkImageData* imageData = this->GetImageData();
+  if (!imageData)
+    {
+    for (int i = 0; i < 3; i++)
+      {
+      extent[2 * i] = 0;
+      extent[2 * i + 1] = -1;
+      }
+    return;
+    }
+  imageData->GetExtent(extent);
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLVolumeNode::ShiftImageDataExtentToZeroStart()
 {
@@ -23,6 +23,7 @@ class vtkMRMLVolumeDisplayNode;
 class vtkAlgorithmOutput;
 class vtkEventForwarderCommand;
 class vtkImageData;
+class vtkInformationIntegerKey;
 class vtkMatrix4x4;
 
 // ITK includes
@@ -66,6 +67,10 @@ public:
   /// \sa vtkMRMLNode::CopyContent
   vtkMRMLCopyContentMacro(vtkMRMLVolumeNode);
 
+  /// Get bulk data objects stored in this node.
+  /// \sa vtkMRMLNode::GetDataObjects
+  void GetDataObjects(std::vector<vtkDataObject*>& dataObjects) override;
+
   ///
   /// Copy the node's attributes to this object
   void CopyOrientation(vtkMRMLVolumeNode *node);
@@ -190,12 +195,46 @@ public:
   /// Return the input image data pipeline.
   vtkGetObjectMacro(ImageDataConnection, vtkAlgorithmOutput);
 
+  /// Set image data that shares the voxel arrays of \a sourceImageData instead of copying them.
+  /// The shared arrays are marked with SHARED_ARRAY() and are copied by GetImageDataForModification
+  /// when either image is about to be modified (copy-on-write).
+  void SetAndObserveSharedImageData(vtkImageData* sourceImageData);
+
+  /// Get image data for modifying its voxels in place.
+  /// Voxel arrays may be shared between image data objects, for example a volume that is cloned
+  /// by vtkSlicerVolumesLogic::CloneVolume shares the voxels with the original volume until either
+  /// of them is modified. This method copies the shared arrays that are still used by other data objects,
+  /// so that the modification does not affect other volumes. Voxels must not be modified in place
+  /// through GetImageData() or GetImageDataConnection() without calling this method first.
+  /// Replacing the image data (e.g., by SetAndObserveImageData) does not require calling this method.
+  vtkImageData* GetImageDataForModification();
+
+  /// Information key of voxel arrays that are shared between volumes.
+  /// \sa SetAndObserveSharedImageData
+  static vtkInformationIntegerKey* SHARED_ARRAY();
+
   ///
   /// Make sure image data of a volume node has extents that start at zero.
   /// This needs to be done for compatibility reasons, as many components assume the extent has a form of
   /// (0,dim[0],0,dim[1],0,dim[2]), which is not the case many times for segmentation merged labelmaps.
   void ShiftImageDataExtentToZeroStart();
 
+  /// Indicate that voxels of the image data have been modified in place within the
+  /// given IJK extent (e.g., through a numpy array that shares the voxel array).
+  /// The voxel array is marked as modified and ImageDataModifiedEvent is invoked.
+  /// While the event is processed, GetImageDataModifiedExtent() returns this extent,
+  /// so that observers may update only the modified region.
+  /// \sa GetImageDataModifiedExtent()
+  void ImageDataModifiedInExtent(const int extent[6]);
+
+  /// Get the IJK extent of the voxels that are modified by the image data modification
+  /// that is being notified by ImageDataModifiedEvent. It is the whole extent of the
+  /// image data, unless the modification was reported by ImageDataModifiedInExtent().
+  void GetImageDataModifiedExtent(int extent[6]);
+
+  /// Reimplemented to reset the modified extent after ImageDataModifiedEvent is invoked.
+  int InvokePendingModifiedEvent() override;
+
   ///
   /// alternative method to propagate events generated in Display nodes
   void ProcessMRMLEvents ( vtkObject * /*caller*/,
@@ -301,6 +340,11 @@ protected:
 
   int VoxelVectorType;
   itk::MetaDataDictionary Dictionary;
+
+  /// Extent of the voxels modified by ImageDataModifiedInExtent(), while the
+  /// modification is pending. An empty extent means the whole image data.
+  int ImageDataModifiedExtent[6];
+  bool ImageDataModificationPending;
 };
 
 #endif
@@ -27,10 +27,294 @@ or http://www.slicer.org/copyright/copyright.txt for details.
 #include "vtkImageAppendComponents.h"
 #endif
 #include "vtkImageExtractComponents.h"
+#include "vtkByteSwap.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
 #include "vtkNew.h"
+#include "vtkPointData.h"
 #include "vtkStringArray.h"
+#include "vtkWeakPointer.h"
 #include "vtksys/SystemTools.hxx"
 
+#include <fstream>
+#include <list>
+#include <map>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Location of voxel data in an uncompressed NRRD file
+struct NRRDRawDataLayout
+{
+  std::string DataFileName;
+  vtkTypeInt64 DataOffset{0};
+  std::vector<vtkTypeInt64> Sizes;
+  std::vector<std::string> Kinds;
+};
+
+//----------------------------------------------------------------------------
+/// Parse the NRRD header to find where the raw voxel data is stored.
+/// Returns false if the data is not stored in a single uncompressed data file.
+bool GetNRRDRawDataLayout(const std::string& headerFileName, NRRDRawDataLayout& layout)
+{
+  std::ifstream headerFile(headerFileName.c_str(), std::ios::in | std::ios::binary);
+  std::string line;
+  if (!std::getline(headerFile, line) || line.compare(0, 4, "NRRD") != 0)
+    {
+    return false;
+    }
+  std::string encoding;
+  vtkTypeInt64 byteSkip = 0;
+  while (std::getline(headerFile, line))
+    {
+    if (!line.empty() && line[line.size() - 1] == '\r')
+      {
+      line.erase(line.size() - 1);
+      }
+    if (line.empty())
+      {
+      // end of header
+      break;
+      }
+    if (line[0] == '#')
+      {
+      // comment
+      continue;
+      }
+    std::string::size_type separatorPosition = line.find(": ");
+    if (separatorPosition == std::string::npos)
+      {
+      // key/value pair (separated by ":=")
+      continue;
+      }
+    std::string field = line.substr(0, separatorPosition);
+    std::istringstream value(line.substr(separatorPosition + 2));
+    if (field == "encoding")
+      {
+      value >> encoding;
+      }
+    else if (field == "sizes")
+      {
+      for (vtkTypeInt64 size = 0; value >> size;)
+        {
+        layout.Sizes.push_back(size);
+        }
+      }
+    else if (field == "kinds")
+      {
+      for (std::string kind; value >> kind;)
+        {
+        layout.Kinds.push_back(kind);
+        }
+      }
+    else if (field == "data file" || field == "datafile")
+      {
+      std::getline(value, layout.DataFileName);
+      if (layout.DataFileName.compare(0, 4, "LIST") == 0 || layout.DataFileName.find(' ') != std::string::npos)
+        {
+        // data is split into multiple files
+        return false;
+        }
+      }
+    else if (field == "byte skip" || field == "byteskip")
+      {
+      value >> byteSkip;
+      }
+    else if (field == "line skip" || field == "lineskip")
+      {
+      int lineSkip = 0;
+      value >> lineSkip;
+      if (lineSkip != 0)
+        {
+        return false;
+        }
+      }
+    }
+  if (encoding != "raw" || !headerFile)
+    {
+    return false;
+    }
+  if (layout.DataFileName.empty())
+    {
+    // attached header, data starts right after the header
+    layout.DataFileName = headerFileName;
+    layout.DataOffset = static_cast<vtkTypeInt64>(headerFile.tellg());
+    }
+  else if (!vtksys::SystemTools::FileIsFullPath(layout.DataFileName))
+    {
+    layout.DataFileName = vtksys::SystemTools::GetFilenamePath(headerFileName) + "/" + layout.DataFileName;
+    }
+  if (byteSkip > 0)
+    {
+    layout.DataOffset += byteSkip;
+    }
+  else if (byteSkip == -1)
+    {
+    // data is at the end of the file, offset is computed when the data size is known
+    layout.DataOffset = -1;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+/// Loads voxels of frames of a volume sequence on demand, when a data node of the sequence
+/// is accessed. Frames that are not accessed recently are unloaded when the total size of
+/// loaded frames exceed the memory budget.
+class vtkMRMLVolumeSequenceLazyFrameLoader : public vtkCommand
+{
+public:
+  static vtkMRMLVolumeSequenceLazyFrameLoader* New()
+    {
+    return new vtkMRMLVolumeSequenceLazyFrameLoader;
+    }
+
+  void AddFrame(vtkMRMLScalarVolumeNode* frameVolume, int frameIndex)
+    {
+    FrameInfo& frameInfo = this->Frames[frameVolume];
+    frameInfo.FrameVolume = frameVolume;
+    frameInfo.FrameIndex = frameIndex;
+    }
+
+  void Execute(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eventId), void* callData) override
+    {
+    auto frameIt = this->Frames.find(reinterpret_cast<vtkMRMLNode*>(callData));
+    if (frameIt == this->Frames.end())
+      {
+      return;
+      }
+    FrameInfo& frameInfo = frameIt->second;
+    if (frameInfo.FrameVolume == nullptr)
+      {
+      // frame volume node has been deleted
+      this->ReleaseFrame(frameIt);
+      return;
+      }
+    if (frameInfo.LoadedImageData)
+      {
+      if (!this->IsFrameUnmodified(frameInfo))
+        {
+        // frame content has been changed, it must not be unloaded anymore
+        this->ReleaseFrame(frameIt);
+        return;
+        }
+      // most recently used
+      this->LoadedFrames.splice(this->LoadedFrames.begin(), this->LoadedFrames, frameInfo.LoadedFramesIt);
+      return;
+      }
+    if (frameInfo.FrameVolume->GetImageData())
+      {
+      // image data has been set externally
+      this->ReleaseFrame(frameIt);
+      return;
+      }
+    this->LoadFrame(frameInfo);
+    this->UnloadFramesOverBudget();
+    }
+
+  std::string DataFileName;
+  vtkTypeInt64 DataOffset{0};
+  int Dimensions[3]{0, 0, 0};
+  int ScalarType{VTK_VOID};
+  bool SwapBytes{false};
+  std::string DataArrayName;
+  vtkTypeInt64 MemoryBudget{0};
+
+protected:
+  struct FrameInfo
+    {
+    vtkWeakPointer<vtkMRMLScalarVolumeNode> FrameVolume;
+    int FrameIndex{0};
+    vtkWeakPointer<vtkImageData> LoadedImageData;
+    vtkMTimeType LoadedImageDataMTime{0};
+    std::list<vtkMRMLNode*>::iterator LoadedFramesIt;
+    };
+  typedef std::map<vtkMRMLNode*, FrameInfo> FrameMapType;
+
+  //----------------------------------------------------------------------------
+  vtkTypeInt64 GetFrameSize()
+    {
+    return static_cast<vtkTypeInt64>(this->Dimensions[0]) * this->Dimensions[1] * this->Dimensions[2]
+      * vtkDataArray::GetDataTypeSize(this->ScalarType);
+    }
+
+  //----------------------------------------------------------------------------
+  bool IsFrameUnmodified(FrameInfo& frameInfo)
+    {
+    return frameInfo.LoadedImageData
+      && frameInfo.FrameVolume->GetImageData() == frameInfo.LoadedImageData.GetPointer()
+      && frameInfo.LoadedImageData->GetMTime() == frameInfo.LoadedImageDataMTime;
+    }
+
+  //----------------------------------------------------------------------------
+  void LoadFrame(FrameInfo& frameInfo)
+    {
+    vtkNew<vtkImageData> frameVoxels;
+    frameVoxels->SetDimensions(this->Dimensions);
+    frameVoxels->AllocateScalars(this->ScalarType, 1);
+    frameVoxels->GetPointData()->GetScalars()->SetName(this->DataArrayName.c_str());
+    vtkTypeInt64 frameSize = this->GetFrameSize();
+    std::ifstream dataFile(this->DataFileName.c_str(), std::ios::in | std::ios::binary);
+    dataFile.seekg(static_cast<std::streamoff>(this->DataOffset + frameInfo.FrameIndex * frameSize));
+    dataFile.read(static_cast<char*>(frameVoxels->GetScalarPointer()), static_cast<std::streamsize>(frameSize));
+    if (!dataFile)
+      {
+      vtkGenericWarningMacro("vtkMRMLVolumeSequenceStorageNode: failed to read frame " << frameInfo.FrameIndex
+        << " from " << this->DataFileName);
+      }
+    if (this->SwapBytes)
+      {
+      int scalarSize = vtkDataArray::GetDataTypeSize(this->ScalarType);
+      vtkByteSwap::SwapVoidRange(frameVoxels->GetScalarPointer(), frameSize / scalarSize, scalarSize);
+      }
+    frameInfo.FrameVolume->SetAndObserveImageData(frameVoxels);
+    frameInfo.LoadedImageData = frameVoxels.GetPointer();
+    frameInfo.LoadedImageDataMTime = frameVoxels->GetMTime();
+    this->LoadedFrames.push_front(frameInfo.FrameVolume);
+    frameInfo.LoadedFramesIt = this->LoadedFrames.begin();
+    this->LoadedSize += frameSize;
+    }
+
+  //----------------------------------------------------------------------------
+  void UnloadFramesOverBudget()
+    {
+    // the most recently used frame is always kept
+    while (this->LoadedSize > this->MemoryBudget && this->LoadedFrames.size() > 1)
+      {
+      FrameMapType::iterator frameIt = this->Frames.find(this->LoadedFrames.back());
+      FrameInfo& frameInfo = frameIt->second;
+      if (frameInfo.FrameVolume == nullptr || !this->IsFrameUnmodified(frameInfo))
+        {
+        this->ReleaseFrame(frameIt);
+        continue;
+        }
+      frameInfo.FrameVolume->SetAndObserveImageData(nullptr);
+      frameInfo.LoadedImageData = nullptr;
+      this->LoadedFrames.pop_back();
+      this->LoadedSize -= this->GetFrameSize();
+      }
+    }
+
+  //----------------------------------------------------------------------------
+  /// Stop managing the frame (it will not be loaded or unloaded anymore)
+  void ReleaseFrame(FrameMapType::iterator frameIt)
+    {
+    if (frameIt->second.LoadedImageData)
+      {
+      this->LoadedFrames.erase(frameIt->second.LoadedFramesIt);
+      this->LoadedSize -= this->GetFrameSize();
+      }
+    this->Frames.erase(frameIt);
+    }
+
+  FrameMapType Frames;
+  /// Loaded frames, most recently used first
+  std::list<vtkMRMLNode*> LoadedFrames;
+  vtkTypeInt64 LoadedSize{0};
+};
+
+} // end of anonymous namespace
+
 //----------------------------------------------------------------------------
 vtkMRMLNodeNewMacro(vtkMRMLVolumeSequenceStorageNode);
 
@@ -40,6 +324,48 @@ vtkMRMLVolumeSequenceStorageNode::vtkMRMLVolumeSequenceStorageNode() = default;
 //----------------------------------------------------------------------------
 vtkMRMLVolumeSequenceStorageNode::~vtkMRMLVolumeSequenceStorageNode() = default;
 
+//----------------------------------------------------------------------------
+void vtkMRMLVolumeSequenceStorageNode::PrintSelf(ostream& os, vtkIndent indent)
+{
+  Superclass::PrintSelf(os,indent);
+  vtkMRMLPrintBeginMacro(os, indent);
+  vtkMRMLPrintBooleanMacro(LazyLoading);
+  vtkMRMLPrintFloatMacro(LazyLoadingMemoryBudgetMB);
+  vtkMRMLPrintEndMacro();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLVolumeSequenceStorageNode::WriteXML(ostream& of, int nIndent)
+{
+  Superclass::WriteXML(of, nIndent);
+  vtkMRMLWriteXMLBeginMacro(of);
+  vtkMRMLWriteXMLBooleanMacro(lazyLoading, LazyLoading);
+  vtkMRMLWriteXMLFloatMacro(lazyLoadingMemoryBudgetMB, LazyLoadingMemoryBudgetMB);
+  vtkMRMLWriteXMLEndMacro();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLVolumeSequenceStorageNode::ReadXMLAttributes(const char** atts)
+{
+  MRMLNodeModifyBlocker blocker(this);
+  Superclass::ReadXMLAttributes(atts);
+  vtkMRMLReadXMLBeginMacro(atts);
+  vtkMRMLReadXMLBooleanMacro(lazyLoading, LazyLoading);
+  vtkMRMLReadXMLFloatMacro(lazyLoadingMemoryBudgetMB, LazyLoadingMemoryBudgetMB);
+  vtkMRMLReadXMLEndMacro();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLVolumeSequenceStorageNode::Copy(vtkMRMLNode *anode)
+{
+  MRMLNodeModifyBlocker blocker(this);
+  Superclass::Copy(anode);
+  vtkMRMLCopyBeginMacro(anode);
+  vtkMRMLCopyBooleanMacro(LazyLoading);
+  vtkMRMLCopyFloatMacro(LazyLoadingMemoryBudgetMB);
+  vtkMRMLCopyEndMacro();
+}
+
 //----------------------------------------------------------------------------
 bool vtkMRMLVolumeSequenceStorageNode::CanReadInReferenceNode(vtkMRMLNode *refNode)
 {
@@ -153,6 +479,12 @@ int vtkMRMLVolumeSequenceStorageNode::ReadDataInternal(vtkMRMLNode* refNode)
   const char* sequenceAxisUnit = reader->GetAxisUnit(frameAxis);
   volSequenceNode->SetIndexUnit(sequenceAxisUnit ? sequenceAxisUnit : "");
 
+  if (this->LazyLoading && this->ReadDataLazy(volSequenceNode, reader, fullName, indexValues))
+    {
+    vtkDebugMacro("vtkMRMLVolumeSequenceStorageNode::ReadDataInternal: frames of " << fullName << " are loaded on demand");
+    return 1;
+    }
+
   // Read and copy the data to sequence of volume nodes
 #ifdef NRRD_CHUNK_IO_AVAILABLE
   int numberOfFrames = reader->GetNumberOfImages();
@@ -244,6 +576,94 @@ int vtkMRMLVolumeSequenceStorageNode::ReadDataInternal(vtkMRMLNode* refNode)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+bool vtkMRMLVolumeSequenceStorageNode::ReadDataLazy(vtkMRMLSequenceNode* volSequenceNode, vtkTeemNRRDReader* reader,
+  const std::string& fullName, const std::vector<std::string>& indexValues)
+{
+  NRRDRawDataLayout layout;
+  if (!GetNRRDRawDataLayout(fullName, layout))
+    {
+    vtkDebugMacro("vtkMRMLVolumeSequenceStorageNode::ReadDataLazy: data in " << fullName << " is not stored uncompressed in a single file");
+    return false;
+    }
+  // Each frame must be stored contiguously (frame axis is the slowest)
+  if (layout.Sizes.size() != 4 || layout.Kinds.size() != 4)
+    {
+    return false;
+    }
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    if (layout.Kinds[axis] != "domain" && layout.Kinds[axis] != "space")
+      {
+      return false;
+      }
+    }
+  if (layout.Kinds[3] == "domain" || layout.Kinds[3] == "space" || layout.Kinds[3] == "time")
+    {
+    return false;
+    }
+  int scalarType = reader->GetDataType();
+  int scalarSize = (scalarType == VTK_VOID || scalarType < 0) ? 0 : vtkDataArray::GetDataTypeSize(scalarType);
+  if (scalarSize <= 0)
+    {
+    return false;
+    }
+  vtkTypeInt64 frameSize = layout.Sizes[0] * layout.Sizes[1] * layout.Sizes[2] * scalarSize;
+  int numberOfFrames = static_cast<int>(layout.Sizes[3]);
+  vtkTypeInt64 dataFileSize = static_cast<vtkTypeInt64>(vtksys::SystemTools::FileLength(layout.DataFileName));
+  if (layout.DataOffset < 0)
+    {
+    layout.DataOffset = dataFileSize - frameSize * numberOfFrames;
+    }
+  if (layout.DataOffset < 0 || layout.DataOffset + frameSize * numberOfFrames > dataFileSize)
+    {
+    vtkDebugMacro("vtkMRMLVolumeSequenceStorageNode::ReadDataLazy: data file " << layout.DataFileName << " is too short");
+    return false;
+    }
+
+  volSequenceNode->RemoveObservers(vtkMRMLSequenceNode::DataNodeAccessedEvent);
+  vtkNew<vtkMRMLVolumeSequenceLazyFrameLoader> loader;
+  loader->DataFileName = layout.DataFileName;
+  loader->DataOffset = layout.DataOffset;
+  for (int i = 0; i < 3; ++i)
+    {
+    loader->Dimensions[i] = static_cast<int>(layout.Sizes[i]);
+    }
+  loader->ScalarType = scalarType;
+  loader->SwapBytes = reader->GetSwapBytes();
+  loader->DataArrayName = reader->GetDataArrayName();
+  loader->MemoryBudget = static_cast<vtkTypeInt64>(this->LazyLoadingMemoryBudgetMB * 1024.0 * 1024.0);
+
+  for (int frameIndex = 0; frameIndex < numberOfFrames; ++frameIndex)
+    {
+    // Voxels are loaded when the frame is accessed
+    vtkNew<vtkMRMLScalarVolumeNode> frameVolume;
+    frameVolume->SetRASToIJKMatrix(reader->GetRasToIjkMatrix());
+
+    std::ostringstream indexStr;
+    if (static_cast<int>(indexValues.size()) > frameIndex)
+      {
+      indexStr << indexValues[frameIndex] << std::ends;
+      }
+    else
+      {
+      indexStr << frameIndex << std::ends;
+      }
+
+    std::ostringstream nameStr;
+    nameStr << volSequenceNode->GetName() << "_" << std::setw(4) << std::setfill('0') << frameIndex << std::ends;
+    frameVolume->SetName( nameStr.str().c_str() );
+    vtkMRMLScalarVolumeNode* addedFrameVolume = vtkMRMLScalarVolumeNode::SafeDownCast(
+      volSequenceNode->SetDataNodeAtValue(frameVolume.GetPointer(), indexStr.str().c_str()));
+    if (addedFrameVolume)
+      {
+      loader->AddFrame(addedFrameVolume, frameIndex);
+      }
+    }
+  volSequenceNode->AddObserver(vtkMRMLSequenceNode::DataNodeAccessedEvent, loader);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool vtkMRMLVolumeSequenceStorageNode::CanWriteFromReferenceNode(vtkMRMLNode *refNode)
 {
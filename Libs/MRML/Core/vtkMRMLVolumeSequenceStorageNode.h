@@ -17,6 +17,10 @@
 
 #include "vtkMRMLNRRDStorageNode.h"
 #include <string>
+#include <vector>
+
+class vtkMRMLSequenceNode;
+class vtkTeemNRRDReader;
 
 /// \ingroup Slicer_QtModules_Sequences
 class VTK_MRML_EXPORT vtkMRMLVolumeSequenceStorageNode : public vtkMRMLNRRDStorageNode
@@ -28,6 +32,17 @@ class VTK_MRML_EXPORT vtkMRMLVolumeSequenceStorageNode : public vtkMRMLNRRDStora
 
   vtkMRMLNode* CreateNodeInstance() override;
 
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Read node attributes from XML file
+  void ReadXMLAttributes( const char** atts) override;
+
+  /// Write this node's information to a MRML file in XML format.
+  void WriteXML(ostream& of, int indent) override;
+
+  /// Copy the node's attributes to this object
+  void Copy(vtkMRMLNode *node) override;
+
   ///
   /// Get node XML tag name (like Storage, Model)
   const char* GetNodeTagName() override {return "VolumeSequenceStorage";};
@@ -55,6 +70,22 @@ class VTK_MRML_EXPORT vtkMRMLVolumeSequenceStorageNode : public vtkMRMLNRRDStora
   /// Return a default file extension for writing
   const char* GetDefaultWriteFileExtension() override;
 
+  /// Load the voxels of each frame on demand, when the frame is accessed in the sequence,
+  /// instead of reading the entire sequence into memory.
+  /// It is only possible for uncompressed (raw encoding) files where each frame is stored
+  /// contiguously ("kinds: domain domain domain list"), other files are read into memory.
+  /// Applied when the data is read. Disabled by default.
+  vtkGetMacro(LazyLoading, bool);
+  vtkSetMacro(LazyLoading, bool);
+  vtkBooleanMacro(LazyLoading, bool);
+
+  /// Maximum size of frames loaded on demand (in MB). When it is exceeded, the least recently
+  /// accessed frames are unloaded (they are loaded again when they are accessed next time).
+  /// Frames that have been modified are never unloaded.
+  /// Applied when the data is read. Default is 2048 MB.
+  vtkGetMacro(LazyLoadingMemoryBudgetMB, double);
+  vtkSetMacro(LazyLoadingMemoryBudgetMB, double);
+
 protected:
   vtkMRMLVolumeSequenceStorageNode();
   ~vtkMRMLVolumeSequenceStorageNode() override;
@@ -75,11 +106,19 @@ protected:
 
   int ReadDataInternal(vtkMRMLNode* refNode) override;
 
+  /// Set up on-demand loading of the frames of a raw NRRD file.
+  /// Returns false if the file cannot be loaded lazily.
+  bool ReadDataLazy(vtkMRMLSequenceNode* volSequenceNode, vtkTeemNRRDReader* reader,
+    const std::string& fullName, const std::vector<std::string>& indexValues);
+
   /// Initialize all the supported write file types
   void InitializeSupportedReadFileTypes() override;
 
   /// Initialize all the supported write file types
   void InitializeSupportedWriteFileTypes() override;
+
+  bool LazyLoading{false};
+  double LazyLoadingMemoryBudgetMB{2048.0};
 };
 
 #endif
@@ -39,6 +39,8 @@ vtkObservation::vtkObservation()
   this->EventTag = 0;
   this->SubjectDeleteEventTag = 0;
   this->ObserverDeleteEventTag = 0;
+  this->SubjectListIndex = -1;
+  this->ObserverListIndex = -1;
 
   this->ObservationCallbackCommand = vtkCallbackCommand::New();
   this->ObservationCallbackCommand->SetCallback( vtkEventBroker::Callback );
@@ -157,6 +157,13 @@ protected:
   unsigned long SubjectDeleteEventTag;
   unsigned long ObserverDeleteEventTag;
 
+  ///
+  /// Position of this observation in the contiguous observation lists
+  /// of the event broker (-1 if not in the list)
+  int SubjectListIndex;
+  int ObserverListIndex;
+  friend class vtkEventBroker;
+
   double LastElapsedTime;
   double TotalElapsedTime;
 
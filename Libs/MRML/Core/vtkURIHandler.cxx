@@ -111,6 +111,22 @@ void vtkURIHandler::StageFileWrite ( const char * vtkNotUsed( source ), const ch
 {
 }
 
+//----------------------------------------------------------------------------
+void vtkURIHandler::StageFilesRead(const std::vector<std::string>& sources,
+                                   const std::vector<std::string>& destinations)
+{
+  if (sources.size() != destinations.size())
+    {
+    vtkErrorMacro("StageFilesRead: number of sources (" << sources.size()
+      << ") and destinations (" << destinations.size() << ") differ");
+    return;
+    }
+  for (size_t i = 0; i < sources.size(); ++i)
+    {
+    this->StageFileRead(sources[i].c_str(), destinations[i].c_str());
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkURIHandler::StageFileRead(const char * vtkNotUsed( source ),
                              const char * vtkNotUsed( destination ),
@@ -8,6 +8,10 @@ class vtkPermissionPrompter;
 // VTK includes
 #include <vtkObject.h>
 
+// STD includes
+#include <string>
+#include <vector>
+
 class VTK_MRML_EXPORT vtkURIHandler : public vtkObject
 {
 public:
@@ -26,6 +30,13 @@ public:
   virtual void StageFileRead ( const char *source, const char * destination );
   virtual void StageFileWrite ( const char *source, const char * destination );
 
+  ///
+  /// Download several files, the i-th source is downloaded to the i-th destination.
+  /// Handlers that can transfer files concurrently should override this method,
+  /// the default implementation calls StageFileRead for each file.
+  virtual void StageFilesRead(const std::vector<std::string>& sources,
+                              const std::vector<std::string>& destinations);
+
   ///
   /// various Read/Write method footprints useful to redefine in specific handlers.
   virtual void StageFileRead(const char * source,
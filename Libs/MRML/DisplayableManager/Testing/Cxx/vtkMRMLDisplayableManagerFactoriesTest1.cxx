@@ -13,6 +13,7 @@
 #include <vtkMRMLApplicationLogic.h>
 
 // MRML includes
+#include <vtkMRMLModelDisplayNode.h>
 #include <vtkMRMLViewNode.h>
 #include <vtkMRMLSliceNode.h>
 
@@ -353,6 +354,46 @@ int vtkMRMLDisplayableManagerFactoriesTest1(int argc, char* argv[])
     return EXIT_FAILURE;
     }
 
+  // ThreeD - Displayable manager that is instantiated only when the scene contains the nodes it handles
+  threeDViewFactory->AddDisplayableManagerHandledNodeClass("vtkMRMLModelDisplayableManager", "vtkMRMLModelDisplayNode");
+  if (threeDViewFactory->GetNumberOfDisplayableManagerHandledNodeClasses("vtkMRMLModelDisplayableManager") != 1 ||
+      threeDViewFactory->GetNthDisplayableManagerHandledNodeClass("vtkMRMLModelDisplayableManager", 0) != "vtkMRMLModelDisplayNode" ||
+      threeDViewFactory->GetNumberOfDisplayableManagerHandledNodeClasses("vtkMRMLTestCustomDisplayableManager") != 0)
+    {
+    std::cerr << "Line " << __LINE__
+        << " - Problem with threeDViewFactory->GetNumberOfDisplayableManagerHandledNodeClasses() method"
+        << std::endl;
+    return EXIT_FAILURE;
+    }
+  threeDViewFactory->RegisterDisplayableManager("vtkMRMLModelDisplayableManager");
+  if (threeDViewGroup->GetDisplayableManagerCount() != 2 ||
+      threeDViewGroup->GetDisplayableManagerByClassName("vtkMRMLModelDisplayableManager"))
+    {
+    std::cerr << "Line " << __LINE__
+        << " - Displayable manager with handled node classes must not be instantiated without handled nodes"
+        << std::endl;
+    return EXIT_FAILURE;
+    }
+  vtkNew<vtkMRMLModelDisplayNode> modelDisplayNode;
+  scene->AddNode(modelDisplayNode.GetPointer());
+  if (threeDViewGroup->GetDisplayableManagerCount() != 3 ||
+      !threeDViewGroup->GetDisplayableManagerByClassName("vtkMRMLModelDisplayableManager"))
+    {
+    std::cerr << "Line " << __LINE__
+        << " - Displayable manager with handled node classes must be instantiated when a handled node is added"
+        << std::endl;
+    return EXIT_FAILURE;
+    }
+  scene->RemoveNode(modelDisplayNode.GetPointer());
+  if (threeDViewGroup->GetDisplayableManagerCount() != 2 ||
+      threeDViewGroup->GetDisplayableManagerByClassName("vtkMRMLModelDisplayableManager"))
+    {
+    std::cerr << "Line " << __LINE__
+        << " - Displayable manager with handled node classes must be deleted when the last handled node is removed"
+        << std::endl;
+    return EXIT_FAILURE;
+    }
+
   threeDViewGroup->Delete();
   sliceViewGroup->Delete();
 
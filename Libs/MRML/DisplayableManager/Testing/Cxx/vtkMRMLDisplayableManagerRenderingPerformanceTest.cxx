@@ -0,0 +1,364 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// Measure per-frame latency of slice and 3D view rendering in scripted interactions
+// (slice scrolling with increasing number of layers, oblique reformat, model slice
+// intersections, 3D camera path). Render windows are rendered offscreen, so the test can
+// run headless if VTK is built with an offscreen (EGL or OSMesa) render window.
+// Latency percentiles are reported as dashboard measurements.
+
+// MRMLDisplayableManager includes
+#include <vtkMRMLDisplayableManagerGroup.h>
+#include <vtkMRMLModelDisplayableManager.h>
+#include <vtkMRMLModelSliceDisplayableManager.h>
+
+// MRMLLogic includes
+#include <vtkMRMLApplicationLogic.h>
+#include <vtkMRMLSliceLogic.h>
+
+// MRML includes
+#include <vtkMRMLColorTableNode.h>
+#include <vtkMRMLCoreTestingMacros.h>
+#include <vtkMRMLLabelMapVolumeDisplayNode.h>
+#include <vtkMRMLLabelMapVolumeNode.h>
+#include <vtkMRMLModelDisplayNode.h>
+#include <vtkMRMLModelNode.h>
+#include <vtkMRMLScalarVolumeDisplayNode.h>
+#include <vtkMRMLScalarVolumeNode.h>
+#include <vtkMRMLScene.h>
+#include <vtkMRMLSliceCompositeNode.h>
+#include <vtkMRMLSliceNode.h>
+#include <vtkMRMLViewNode.h>
+
+// VTK includes
+#include <vtkCamera.h>
+#include <vtkImageActor.h>
+#include <vtkImageData.h>
+#include <vtkImageMapper3D.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkRenderer.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+#include <vtkTimerLog.h>
+#include <vtkTransform.h>
+
+// STD includes
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const int VolumeSize = 256;
+const int NumberOfFrames = 100;
+const int NumberOfModels = 100;
+
+//----------------------------------------------------------------------------
+/// Report the percentiles of frame times (in milliseconds) as dashboard measurements.
+void printFrameTimeMeasurements(const std::string& scenario, std::vector<double> frameTimes)
+{
+  if (frameTimes.empty())
+    {
+    return;
+    }
+  std::sort(frameTimes.begin(), frameTimes.end());
+  const double percentiles[] = { 50.0, 90.0, 99.0, 100.0 };
+  const char* percentileNames[] = { "p50", "p90", "p99", "max" };
+  for (int i = 0; i < 4; ++i)
+    {
+    size_t index = static_cast<size_t>(percentiles[i] / 100.0 * (frameTimes.size() - 1) + 0.5);
+    std::cout << "<DartMeasurement name=\"" << scenario << "-" << percentileNames[i]
+              << "\" type=\"numeric/double\">" << frameTimes[index] * 1000.0 << "</DartMeasurement>" << std::endl;
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Render a frame after each update and return the time of each frame (update and render).
+std::vector<double> measureFrames(vtkRenderWindow* renderWindow, const std::function<void(int)>& updateFrame)
+{
+  // The first rendering includes creation of the rendering pipeline, shader compilation, etc.
+  renderWindow->Render();
+  std::vector<double> frameTimes;
+  vtkNew<vtkTimerLog> timer;
+  for (int frame = 0; frame < NumberOfFrames; ++frame)
+    {
+    timer->StartTimer();
+    updateFrame(frame);
+    renderWindow->Render();
+    timer->StopTimer();
+    frameTimes.push_back(timer->GetElapsedTime());
+    }
+  return frameTimes;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkRenderWindow> createOffscreenRenderWindow(vtkRenderer* renderer)
+{
+  vtkSmartPointer<vtkRenderWindow> renderWindow = vtkSmartPointer<vtkRenderWindow>::New();
+  renderWindow->SetOffScreenRendering(1);
+  renderWindow->SetSize(512, 512);
+  renderWindow->SetMultiSamples(0);
+  renderWindow->AddRenderer(renderer);
+  vtkNew<vtkRenderWindowInteractor> renderWindowInteractor;
+  renderWindow->SetInteractor(renderWindowInteractor.GetPointer());
+  return renderWindow;
+}
+
+//----------------------------------------------------------------------------
+/// Create a volume of VolumeSize^3 voxels. Label volumes contain concentric shells of labels.
+vtkMRMLScalarVolumeNode* addVolume(vtkMRMLScene* scene, bool labelmap)
+{
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(VolumeSize, VolumeSize, VolumeSize);
+  imageData->AllocateScalars(labelmap ? VTK_UNSIGNED_CHAR : VTK_SHORT, 1);
+  const double center = VolumeSize / 2.0;
+  if (labelmap)
+    {
+    unsigned char* voxels = static_cast<unsigned char*>(imageData->GetScalarPointer());
+    for (int z = 0; z < VolumeSize; ++z)
+      {
+      for (int y = 0; y < VolumeSize; ++y)
+        {
+        for (int x = 0; x < VolumeSize; ++x)
+          {
+          double r2 = (x - center) * (x - center) + (y - center) * (y - center) + (z - center) * (z - center);
+          *(voxels++) = static_cast<unsigned char>(static_cast<int>(r2 / 400.0) % 8);
+          }
+        }
+      }
+    }
+  else
+    {
+    short* voxels = static_cast<short*>(imageData->GetScalarPointer());
+    for (int z = 0; z < VolumeSize; ++z)
+      {
+      for (int y = 0; y < VolumeSize; ++y)
+        {
+        for (int x = 0; x < VolumeSize; ++x)
+          {
+          *(voxels++) = static_cast<short>((x * 7 + y * 3 + z * 5) % 1000);
+          }
+        }
+      }
+    }
+
+  vtkNew<vtkMRMLColorTableNode> colorNode;
+  if (labelmap)
+    {
+    colorNode->SetTypeToLabels();
+    }
+  else
+    {
+    colorNode->SetTypeToGrey();
+    }
+  scene->AddNode(colorNode.GetPointer());
+
+  vtkSmartPointer<vtkMRMLVolumeDisplayNode> displayNode;
+  vtkSmartPointer<vtkMRMLScalarVolumeNode> volumeNode;
+  if (labelmap)
+    {
+    displayNode = vtkSmartPointer<vtkMRMLLabelMapVolumeDisplayNode>::New();
+    volumeNode = vtkSmartPointer<vtkMRMLLabelMapVolumeNode>::New();
+    }
+  else
+    {
+    vtkNew<vtkMRMLScalarVolumeDisplayNode> scalarDisplayNode;
+    scalarDisplayNode->SetAutoWindowLevel(0);
+    scalarDisplayNode->SetWindowLevelMinMax(0, 1000);
+    displayNode = scalarDisplayNode.GetPointer();
+    volumeNode = vtkSmartPointer<vtkMRMLScalarVolumeNode>::New();
+    }
+  scene->AddNode(displayNode);
+  displayNode->SetAndObserveColorNodeID(colorNode->GetID());
+  volumeNode->SetOrigin(-center, -center, -center);
+  volumeNode->SetAndObserveImageData(imageData.GetPointer());
+  scene->AddNode(volumeNode);
+  volumeNode->SetAndObserveDisplayNodeID(displayNode->GetID());
+  return volumeNode;
+}
+
+//----------------------------------------------------------------------------
+/// Add spheres distributed in the volume, visible in 2D and 3D views.
+void addModels(vtkMRMLScene* scene)
+{
+  for (int i = 0; i < NumberOfModels; ++i)
+    {
+    vtkNew<vtkSphereSource> sphereSource;
+    sphereSource->SetCenter((i % 10) * 20.0 - 90.0, ((i / 10) % 10) * 20.0 - 90.0, (i % 7) * 20.0 - 60.0);
+    sphereSource->SetRadius(8.0);
+    sphereSource->SetThetaResolution(32);
+    sphereSource->SetPhiResolution(32);
+    sphereSource->Update();
+    vtkNew<vtkMRMLModelDisplayNode> displayNode;
+    displayNode->SetVisibility2D(true);
+    scene->AddNode(displayNode.GetPointer());
+    vtkNew<vtkMRMLModelNode> modelNode;
+    modelNode->SetAndObservePolyData(sphereSource->GetOutput());
+    scene->AddNode(modelNode.GetPointer());
+    modelNode->SetAndObserveDisplayNodeID(displayNode->GetID());
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Slice view: reslicing, blending of layers and (optionally) model intersections.
+class SliceViewBenchmark
+{
+public:
+  SliceViewBenchmark()
+  {
+    this->ApplicationLogic->SetMRMLScene(this->Scene);
+    vtkMRMLSliceNode::AddDefaultSliceOrientationPresets(this->Scene);
+    this->SliceLogic->SetMRMLScene(this->Scene);
+    this->SliceLogic->AddSliceNode("Red");
+    this->SliceLogic->ResizeSliceNode(512, 512);
+
+    this->ImageActor->GetMapper()->SetInputConnection(this->SliceLogic->GetImageDataConnection());
+    this->Renderer->AddViewProp(this->ImageActor);
+    this->RenderWindow = createOffscreenRenderWindow(this->Renderer);
+
+    this->DisplayableManagerGroup->SetRenderer(this->Renderer);
+    this->DisplayableManagerGroup->SetMRMLDisplayableNode(this->SliceLogic->GetSliceNode());
+    vtkNew<vtkMRMLModelSliceDisplayableManager> modelSliceDisplayableManager;
+    modelSliceDisplayableManager->SetMRMLApplicationLogic(this->ApplicationLogic);
+    this->DisplayableManagerGroup->AddDisplayableManager(modelSliceDisplayableManager);
+    this->DisplayableManagerGroup->GetInteractor()->Initialize();
+  }
+
+  /// Show 1 to 3 volume layers (background, foreground, label).
+  void SetNumberOfLayers(int numberOfLayers)
+  {
+    vtkMRMLSliceCompositeNode* compositeNode = this->SliceLogic->GetSliceCompositeNode();
+    compositeNode->SetBackgroundVolumeID(this->GetVolume(0, false)->GetID());
+    compositeNode->SetForegroundVolumeID(numberOfLayers > 1 ? this->GetVolume(1, false)->GetID() : nullptr);
+    compositeNode->SetForegroundOpacity(0.5);
+    compositeNode->SetLabelVolumeID(numberOfLayers > 2 ? this->GetVolume(2, true)->GetID() : nullptr);
+    compositeNode->SetLabelOpacity(0.5);
+    this->SliceLogic->FitSliceToAll();
+  }
+
+  std::vector<double> Scroll()
+  {
+    vtkMRMLSliceLogic* sliceLogic = this->SliceLogic;
+    return measureFrames(this->RenderWindow, [sliceLogic](int frame)
+      {
+      sliceLogic->SetSliceOffset(-VolumeSize / 2.0 + (frame * VolumeSize) / NumberOfFrames);
+      });
+  }
+
+  std::vector<double> ObliqueReformat()
+  {
+    vtkMRMLSliceNode* sliceNode = this->SliceLogic->GetSliceNode();
+    return measureFrames(this->RenderWindow, [sliceNode](int vtkNotUsed(frame))
+      {
+      vtkNew<vtkTransform> transform;
+      transform->SetMatrix(sliceNode->GetSliceToRAS());
+      transform->RotateWXYZ(2.0, 1.0, 1.0, 0.0);
+      sliceNode->GetSliceToRAS()->DeepCopy(transform->GetMatrix());
+      sliceNode->UpdateMatrices();
+      });
+  }
+
+  vtkMRMLScalarVolumeNode* GetVolume(int index, bool labelmap)
+  {
+    while (static_cast<int>(this->Volumes.size()) <= index)
+      {
+      this->Volumes.push_back(nullptr);
+      }
+    if (!this->Volumes[index])
+      {
+      this->Volumes[index] = addVolume(this->Scene, labelmap);
+      }
+    return this->Volumes[index];
+  }
+
+  vtkNew<vtkMRMLScene> Scene;
+  vtkNew<vtkMRMLApplicationLogic> ApplicationLogic;
+  vtkNew<vtkMRMLSliceLogic> SliceLogic;
+  vtkNew<vtkImageActor> ImageActor;
+  vtkNew<vtkRenderer> Renderer;
+  vtkSmartPointer<vtkRenderWindow> RenderWindow;
+  vtkNew<vtkMRMLDisplayableManagerGroup> DisplayableManagerGroup;
+  std::vector<vtkMRMLScalarVolumeNode*> Volumes;
+};
+
+//----------------------------------------------------------------------------
+int testSliceView()
+{
+  SliceViewBenchmark benchmark;
+  for (int numberOfLayers = 1; numberOfLayers <= 3; ++numberOfLayers)
+    {
+    benchmark.SetNumberOfLayers(numberOfLayers);
+    std::stringstream ss;
+    ss << "SliceScroll-" << numberOfLayers << "Layers";
+    printFrameTimeMeasurements(ss.str(), benchmark.Scroll());
+    }
+  printFrameTimeMeasurements("ObliqueReformat-3Layers", benchmark.ObliqueReformat());
+
+  // Model intersections as an additional layer
+  benchmark.SliceLogic->GetSliceNode()->SetOrientationToAxial();
+  addModels(benchmark.Scene);
+  printFrameTimeMeasurements("SliceScroll-3Layers-ModelIntersections", benchmark.Scroll());
+  benchmark.SetNumberOfLayers(1);
+  printFrameTimeMeasurements("SliceScroll-1Layer-ModelIntersections", benchmark.Scroll());
+  return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+int testThreeDView()
+{
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkMRMLApplicationLogic> applicationLogic;
+  applicationLogic->SetMRMLScene(scene);
+  vtkNew<vtkMRMLViewNode> viewNode;
+  scene->AddNode(viewNode);
+
+  vtkNew<vtkRenderer> renderer;
+  vtkSmartPointer<vtkRenderWindow> renderWindow = createOffscreenRenderWindow(renderer);
+  vtkNew<vtkMRMLDisplayableManagerGroup> displayableManagerGroup;
+  displayableManagerGroup->SetRenderer(renderer);
+  displayableManagerGroup->SetMRMLDisplayableNode(viewNode);
+  vtkNew<vtkMRMLModelDisplayableManager> modelDisplayableManager;
+  modelDisplayableManager->SetMRMLApplicationLogic(applicationLogic);
+  displayableManagerGroup->AddDisplayableManager(modelDisplayableManager);
+  displayableManagerGroup->GetInteractor()->Initialize();
+
+  addModels(scene);
+  renderer->ResetCamera();
+
+  vtkCamera* camera = renderer->GetActiveCamera();
+  printFrameTimeMeasurements("ThreeDCameraPath-Models", measureFrames(renderWindow, [camera](int vtkNotUsed(frame))
+    {
+    camera->Azimuth(360.0 / NumberOfFrames);
+    camera->Elevation(0.5);
+    camera->OrthogonalizeViewUp();
+    }));
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkMRMLDisplayableManagerRenderingPerformanceTest(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  CHECK_EXIT_SUCCESS(testSliceView());
+  CHECK_EXIT_SUCCESS(testThreeDView());
+  return EXIT_SUCCESS;
+}
@@ -31,6 +31,7 @@
 #include <vtkMRMLInteractionNode.h>
 #include <vtkMRMLScene.h>
 #include <vtkMRMLSelectionNode.h>
+#include <vtkMRMLTraceRecorder.h>
 
 // VTK includes
 #include <vtkCallbackCommand.h>
@@ -831,13 +832,15 @@ void vtkMRMLAbstractDisplayableManager::RequestRender()
 
   if (this->Internal->UpdateFromMRMLRequested)
     {
+    // Span is named after the class, as each displayable manager has its own UpdateFromMRML
+    vtkMRMLTraceScopeMacro(this->GetClassName());
     this->UpdateFromMRML();
     }
 
   this->InvokeEvent(vtkCommand::UpdateEvent);
   if (this->Internal->DisplayableManagerGroup)
     {
-    this->Internal->DisplayableManagerGroup->RequestRender();
+    this->Internal->DisplayableManagerGroup->RequestRender(this);
     }
 }
 
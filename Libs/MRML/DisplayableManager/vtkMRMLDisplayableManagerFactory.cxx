@@ -34,6 +34,7 @@
 
 // STD includes
 #include <algorithm>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -52,6 +53,9 @@ public:
   // .. and its associated convenient typedef
   typedef std::vector<std::string>::iterator DisplayableManagerClassNamesIt;
 
+  // Map DisplayableManagerName -> node classes that it handles
+  std::map<std::string, std::vector<std::string> > HandledNodeClasses;
+
   // The application logic (can be a vtkSlicerApplicationLogic
   vtkSmartPointer<vtkMRMLApplicationLogic> ApplicationLogic;
 };
@@ -195,6 +199,53 @@ std::string vtkMRMLDisplayableManagerFactory::GetRegisteredDisplayableManagerNam
   return this->Internal->DisplayableManagerClassNames.at(n);
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerFactory::AddDisplayableManagerHandledNodeClass(
+  const char* vtkClassOrScriptName, const char* nodeClassName)
+{
+  // Sanity checks
+  if (!vtkClassOrScriptName || !nodeClassName)
+    {
+    vtkWarningMacro(<<"AddDisplayableManagerHandledNodeClass - vtkClassOrScriptName or nodeClassName is NULL");
+    return;
+    }
+  std::vector<std::string>& nodeClassNames = this->Internal->HandledNodeClasses[vtkClassOrScriptName];
+  if (std::find(nodeClassNames.begin(), nodeClassNames.end(), nodeClassName) == nodeClassNames.end())
+    {
+    nodeClassNames.emplace_back(nodeClassName);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLDisplayableManagerFactory::GetNumberOfDisplayableManagerHandledNodeClasses(
+  const char* vtkClassOrScriptName)
+{
+  if (!vtkClassOrScriptName)
+    {
+    return 0;
+    }
+  std::map<std::string, std::vector<std::string> >::iterator it =
+    this->Internal->HandledNodeClasses.find(vtkClassOrScriptName);
+  if (it == this->Internal->HandledNodeClasses.end())
+    {
+    return 0;
+    }
+  return static_cast<int>(it->second.size());
+}
+
+//----------------------------------------------------------------------------
+std::string vtkMRMLDisplayableManagerFactory::GetNthDisplayableManagerHandledNodeClass(
+  const char* vtkClassOrScriptName, int n)
+{
+  if (n < 0 || n >= this->GetNumberOfDisplayableManagerHandledNodeClasses(vtkClassOrScriptName))
+    {
+    vtkWarningMacro(<<"GetNthDisplayableManagerHandledNodeClass - "
+                    "n " << n << " is invalid for " << (vtkClassOrScriptName ? vtkClassOrScriptName : "(null)"));
+    return std::string();
+    }
+  return this->Internal->HandledNodeClasses[vtkClassOrScriptName].at(n);
+}
+
 //----------------------------------------------------------------------------
 vtkMRMLDisplayableManagerGroup* vtkMRMLDisplayableManagerFactory::InstantiateDisplayableManagers(
     vtkRenderer * newRenderer)
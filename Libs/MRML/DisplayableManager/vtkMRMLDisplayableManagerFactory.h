@@ -72,6 +72,28 @@ public:
   /// Return name of the nth registered displayable manager
   std::string GetRegisteredDisplayableManagerName(int n);
 
+  /// Specify that the displayable manager identified by \a vtkClassOrScriptName
+  /// only displays nodes of class \a nodeClassName (or of its subclasses).
+  /// Such a displayable manager is instantiated in a view only when the scene
+  /// contains at least one node of its handled classes, and it is deleted
+  /// when the last one is removed, so that it does not observe the scene and
+  /// process node events in vain.
+  /// Displayable managers without handled node classes are always instantiated.
+  /// Handled node classes should be specified before the displayable manager
+  /// is registered.
+  /// \sa GetNumberOfDisplayableManagerHandledNodeClasses()
+  void AddDisplayableManagerHandledNodeClass(const char* vtkClassOrScriptName, const char* nodeClassName);
+
+  /// Return the number of node classes handled by the displayable manager
+  /// identified by \a vtkClassOrScriptName, 0 if it is always instantiated.
+  /// \sa AddDisplayableManagerHandledNodeClass()
+  int GetNumberOfDisplayableManagerHandledNodeClasses(const char* vtkClassOrScriptName);
+
+  /// Return the nth node class handled by the displayable manager identified
+  /// by \a vtkClassOrScriptName.
+  /// \sa AddDisplayableManagerHandledNodeClass()
+  std::string GetNthDisplayableManagerHandledNodeClass(const char* vtkClassOrScriptName, int n);
+
   /// Instantiate registered DisplayableManagers
   /// It returns a vtkMRMLDisplayableManagerGroup representing a list of DisplayableManager
   /// Internally, the factory keep track of all the Group and will invoke the ModifiedEvent
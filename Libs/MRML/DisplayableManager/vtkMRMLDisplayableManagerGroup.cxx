@@ -30,6 +30,7 @@
 
 // MRML includes
 #include <vtkMRMLNode.h>
+#include <vtkMRMLScene.h>
 
 // VTK includes
 #include <vtkCallbackCommand.h>
@@ -43,6 +44,7 @@
 // STD includes
 #include <algorithm>
 #include <cassert>
+#include <map>
 #include <vector>
 
 //----------------------------------------------------------------------------
@@ -67,11 +69,21 @@ public:
   typedef std::map<std::string, vtkMRMLAbstractDisplayableManager*>::iterator
       NameToDisplayableManagerMapIt;
 
+  // Map DisplayableManagerName -> DisplayableManager* (nullptr if not needed)
+  // for the displayable managers that have handled node classes
+  std::map<std::string, vtkMRMLAbstractDisplayableManager*> ConditionalDisplayableManagers;
+
   vtkSmartPointer<vtkCallbackCommand>   CallBackCommand;
+  vtkSmartPointer<vtkCallbackCommand>   SceneCallBackCommand;
+  vtkWeakPointer<vtkMRMLScene>          ObservedScene;
   vtkMRMLDisplayableManagerFactory*     DisplayableManagerFactory;
   vtkMRMLNode*                          MRMLDisplayableNode;
   vtkRenderer*                          Renderer;
   vtkWeakPointer<vtkMRMLLightBoxRendererManagerProxy> LightBoxRendererManagerProxy;
+
+  // Number of render requests, in total and by displayable manager class
+  int RenderRequestCount;
+  std::map<std::string, int> RenderRequestCountByClassName;
 };
 
 //----------------------------------------------------------------------------
@@ -83,8 +95,10 @@ vtkMRMLDisplayableManagerGroup::vtkInternal::vtkInternal()
   this->MRMLDisplayableNode = nullptr;
   this->Renderer = nullptr;
   this->CallBackCommand = vtkSmartPointer<vtkCallbackCommand>::New();
+  this->SceneCallBackCommand = vtkSmartPointer<vtkCallbackCommand>::New();
   this->DisplayableManagerFactory = nullptr;
   this->LightBoxRendererManagerProxy = nullptr;
+  this->RenderRequestCount = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -96,11 +110,16 @@ vtkMRMLDisplayableManagerGroup::vtkMRMLDisplayableManagerGroup()
   this->Internal = new vtkInternal;
   this->Internal->CallBackCommand->SetCallback(Self::DoCallback);
   this->Internal->CallBackCommand->SetClientData(this);
+  this->Internal->SceneCallBackCommand->SetCallback(Self::DoSceneCallback);
+  this->Internal->SceneCallBackCommand->SetClientData(this);
 }
 
 //----------------------------------------------------------------------------
 vtkMRMLDisplayableManagerGroup::~vtkMRMLDisplayableManagerGroup()
 {
+  this->SetAndObserveMRMLScene(nullptr);
+  // Conditional displayable managers are deleted with the others
+  this->Internal->ConditionalDisplayableManagers.clear();
   this->SetAndObserveDisplayableManagerFactory(nullptr);
   this->SetMRMLDisplayableNode(nullptr);
 
@@ -205,11 +224,175 @@ void vtkMRMLDisplayableManagerGroup::Initialize(vtkMRMLDisplayableManagerFactory
   for(int i=0; i < factory->GetRegisteredDisplayableManagerCount(); ++i)
     {
     std::string classOrScriptName = factory->GetRegisteredDisplayableManagerName(i);
-    vtkSmartPointer<vtkMRMLAbstractDisplayableManager> displayableManager;
-    displayableManager.TakeReference(
-      vtkMRMLDisplayableManagerGroup::InstantiateDisplayableManager(classOrScriptName.c_str()));
-    // Note that DisplayableManagerGroup will take ownership of the object
-    this->AddDisplayableManager(displayableManager);
+    this->AddRegisteredDisplayableManager(classOrScriptName.c_str());
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::AddRegisteredDisplayableManager(const char* displayableManagerName)
+{
+  if (this->Internal->DisplayableManagerFactory &&
+      this->Internal->DisplayableManagerFactory->GetNumberOfDisplayableManagerHandledNodeClasses(displayableManagerName) > 0)
+    {
+    // Instantiated only when the scene contains a node that it handles
+    if (this->Internal->ConditionalDisplayableManagers.find(displayableManagerName)
+        == this->Internal->ConditionalDisplayableManagers.end())
+      {
+      this->Internal->ConditionalDisplayableManagers[displayableManagerName] = nullptr;
+      }
+    this->UpdateConditionalDisplayableManagers();
+    return;
+    }
+  vtkSmartPointer<vtkMRMLAbstractDisplayableManager> displayableManager;
+  displayableManager.TakeReference(
+    vtkMRMLDisplayableManagerGroup::InstantiateDisplayableManager(displayableManagerName));
+  // Note that DisplayableManagerGroup will take ownership of the object
+  this->AddDisplayableManager(displayableManager);
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::RemoveDisplayableManager(
+  vtkMRMLAbstractDisplayableManager* displayableManager)
+{
+  vtkInternal::DisplayableManagersIt it = std::find(this->Internal->DisplayableManagers.begin(),
+                                                    this->Internal->DisplayableManagers.end(),
+                                                    displayableManager);
+  if (it == this->Internal->DisplayableManagers.end())
+    {
+    return;
+    }
+  this->Internal->DisplayableManagers.erase(it);
+  this->Internal->NameToDisplayableManagerMap.erase(displayableManager->GetClassName());
+  // Clean memory
+  displayableManager->Delete();
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLDisplayableManagerGroup::IsDisplayableManagerNeeded(
+  const std::string& displayableManagerName, vtkMRMLScene* scene)
+{
+  vtkMRMLDisplayableManagerFactory* factory = this->Internal->DisplayableManagerFactory;
+  if (!scene || !factory)
+    {
+    return false;
+    }
+  int numberOfNodeClasses =
+    factory->GetNumberOfDisplayableManagerHandledNodeClasses(displayableManagerName.c_str());
+  for (int i = 0; i < numberOfNodeClasses; ++i)
+    {
+    std::string nodeClassName =
+      factory->GetNthDisplayableManagerHandledNodeClass(displayableManagerName.c_str(), i);
+    if (scene->GetNumberOfNodesByClass(nodeClassName.c_str()) > 0)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::UpdateConditionalDisplayableManagers(vtkMRMLNode* node)
+{
+  vtkMRMLDisplayableManagerFactory* factory = this->Internal->DisplayableManagerFactory;
+  vtkMRMLScene* scene = this->Internal->ObservedScene;
+  bool modified = false;
+  for (std::map<std::string, vtkMRMLAbstractDisplayableManager*>::iterator it =
+         this->Internal->ConditionalDisplayableManagers.begin();
+       it != this->Internal->ConditionalDisplayableManagers.end(); ++it)
+    {
+    if (node && factory)
+      {
+      // Skip displayable managers that do not handle the node
+      bool handled = false;
+      int numberOfNodeClasses = factory->GetNumberOfDisplayableManagerHandledNodeClasses(it->first.c_str());
+      for (int i = 0; i < numberOfNodeClasses && !handled; ++i)
+        {
+        handled = node->IsA(factory->GetNthDisplayableManagerHandledNodeClass(it->first.c_str(), i).c_str());
+        }
+      if (!handled)
+        {
+        continue;
+        }
+      }
+    bool needed = this->IsDisplayableManagerNeeded(it->first, scene);
+    if (needed && !it->second)
+      {
+      vtkSmartPointer<vtkMRMLAbstractDisplayableManager> displayableManager;
+      displayableManager.TakeReference(
+        vtkMRMLDisplayableManagerGroup::InstantiateDisplayableManager(it->first.c_str()));
+      if (!displayableManager)
+        {
+        continue;
+        }
+      // The new displayable manager is populated from the scene when the displayable node is set
+      this->AddDisplayableManager(displayableManager);
+      if (this->GetDisplayableManagerByClassName(displayableManager->GetClassName()) == displayableManager)
+        {
+        it->second = displayableManager;
+        modified = true;
+        }
+      }
+    else if (!needed && it->second)
+      {
+      this->RemoveDisplayableManager(it->second);
+      it->second = nullptr;
+      modified = true;
+      }
+    }
+  if (modified)
+    {
+    this->RequestRender();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::SetAndObserveMRMLScene(vtkMRMLScene* scene)
+{
+  if (this->Internal->ObservedScene == scene)
+    {
+    return;
+    }
+  if (this->Internal->ObservedScene)
+    {
+    this->Internal->ObservedScene->RemoveObserver(this->Internal->SceneCallBackCommand);
+    }
+  this->Internal->ObservedScene = scene;
+  if (scene)
+    {
+    // Use a low priority so that the displayable managers process the events
+    // first: a displayable manager that is not needed anymore can then be deleted.
+    scene->AddObserver(vtkMRMLScene::NodeAddedEvent, this->Internal->SceneCallBackCommand, -1.0);
+    scene->AddObserver(vtkMRMLScene::NodeRemovedEvent, this->Internal->SceneCallBackCommand, -1.0);
+    scene->AddObserver(vtkMRMLScene::EndBatchProcessEvent, this->Internal->SceneCallBackCommand, -1.0);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::DoSceneCallback(vtkObject* vtk_obj, unsigned long event,
+                                                     void* client_data, void* call_data)
+{
+  vtkMRMLDisplayableManagerGroup* self =
+      reinterpret_cast<vtkMRMLDisplayableManagerGroup*>(client_data);
+  vtkMRMLScene* scene = vtkMRMLScene::SafeDownCast(vtk_obj);
+  assert(self);
+  if (!scene || scene != self->Internal->ObservedScene
+      || self->Internal->ConditionalDisplayableManagers.empty())
+    {
+    return;
+    }
+  switch(event)
+    {
+    case vtkMRMLScene::NodeAddedEvent:
+    case vtkMRMLScene::NodeRemovedEvent:
+      // The displayable managers are updated at the end of the batch process
+      if (!scene->IsBatchProcessing())
+        {
+        self->UpdateConditionalDisplayableManagers(reinterpret_cast<vtkMRMLNode*>(call_data));
+        }
+      break;
+    case vtkMRMLScene::EndBatchProcessEvent:
+      self->UpdateConditionalDisplayableManagers();
+      break;
     }
 }
 
@@ -355,9 +538,44 @@ vtkRenderWindowInteractor* vtkMRMLDisplayableManagerGroup::GetInteractor()
 //----------------------------------------------------------------------------
 void vtkMRMLDisplayableManagerGroup::RequestRender()
 {
+  ++this->Internal->RenderRequestCount;
   this->InvokeEvent(vtkCommand::UpdateEvent);
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::RequestRender(vtkMRMLAbstractDisplayableManager* requester)
+{
+  if (requester)
+    {
+    ++this->Internal->RenderRequestCountByClassName[requester->GetClassName()];
+    }
+  this->RequestRender();
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLDisplayableManagerGroup::GetRenderRequestCount()
+{
+  return this->Internal->RenderRequestCount;
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLDisplayableManagerGroup::GetRenderRequestCountByClassName(const char* className)
+{
+  if (!className)
+    {
+    return 0;
+    }
+  std::map<std::string, int>::iterator it = this->Internal->RenderRequestCountByClassName.find(className);
+  return it != this->Internal->RenderRequestCountByClassName.end() ? it->second : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::ResetRenderRequestCounts()
+{
+  this->Internal->RenderRequestCount = 0;
+  this->Internal->RenderRequestCountByClassName.clear();
+}
+
 //----------------------------------------------------------------------------
 vtkRenderer* vtkMRMLDisplayableManagerGroup::GetRenderer()
 {
@@ -386,6 +604,9 @@ void vtkMRMLDisplayableManagerGroup::SetMRMLDisplayableNode(
     displayableManager->SetAndObserveMRMLDisplayableNode(newMRMLDisplayableNode);
     }
   vtkSetObjectBodyMacro(Internal->MRMLDisplayableNode, vtkMRMLNode, newMRMLDisplayableNode);
+
+  this->SetAndObserveMRMLScene(newMRMLDisplayableNode ? newMRMLDisplayableNode->GetScene() : nullptr);
+  this->UpdateConditionalDisplayableManagers();
 }
 
 //----------------------------------------------------------------------------
@@ -439,11 +660,7 @@ void vtkMRMLDisplayableManagerGroup::onDisplayableManagerFactoryRegisteredEvent(
 {
   assert(displayableManagerName);
 
-  vtkSmartPointer<vtkMRMLAbstractDisplayableManager> newDisplayableManager;
-  newDisplayableManager.TakeReference(
-    vtkMRMLDisplayableManagerGroup::InstantiateDisplayableManager(
-      displayableManagerName));
-  this->AddDisplayableManager(newDisplayableManager);
+  this->AddRegisteredDisplayableManager(displayableManagerName);
   vtkDebugMacro(<< "group:" << this << ", onDisplayableManagerFactoryRegisteredEvent:"
                 << displayableManagerName);
 }
@@ -454,6 +671,18 @@ void vtkMRMLDisplayableManagerGroup::onDisplayableManagerFactoryUnRegisteredEven
 {
   assert(displayableManagerName);
 
+  std::map<std::string, vtkMRMLAbstractDisplayableManager*>::iterator conditionalIt =
+    this->Internal->ConditionalDisplayableManagers.find(displayableManagerName);
+  if (conditionalIt != this->Internal->ConditionalDisplayableManagers.end())
+    {
+    if (conditionalIt->second)
+      {
+      this->RemoveDisplayableManager(conditionalIt->second);
+      }
+    this->Internal->ConditionalDisplayableManagers.erase(conditionalIt);
+    return;
+    }
+
   // Find the associated object
   vtkInternal::NameToDisplayableManagerMapIt it =
       this->Internal->NameToDisplayableManagerMap.find(displayableManagerName);
@@ -30,6 +30,7 @@ class vtkMRMLDisplayableManagerFactory;
 class vtkMRMLAbstractDisplayableManager;
 class vtkMRMLLightBoxRendererManagerProxy;
 class vtkMRMLNode;
+class vtkMRMLScene;
 class vtkRenderer;
 class vtkRenderWindowInteractor;
 
@@ -40,6 +41,11 @@ class vtkRenderWindowInteractor;
 /// When the displayable managers in the group request the view to be
 /// refreshed, the group fires a vtkCommand::UpdateEvent event.
 /// This event can be observed and trigger a Render on the render window.
+///
+/// Displayable managers that have handled node classes in the factory are
+/// added to the group only while the scene of the displayable node contains
+/// nodes of these classes.
+/// \sa vtkMRMLDisplayableManagerFactory::AddDisplayableManagerHandledNodeClass()
 class VTK_MRML_DISPLAYABLEMANAGER_EXPORT vtkMRMLDisplayableManagerGroup : public vtkObject
 {
 public:
@@ -83,6 +89,24 @@ public:
   /// \sa vtkMRMLAbstractDisplayableManager::RequestRender()
   void RequestRender();
 
+  /// Same as RequestRender(), the request is also counted for the
+  /// displayable manager that made it.
+  /// \sa GetRenderRequestCount()
+  void RequestRender(vtkMRMLAbstractDisplayableManager* requester);
+
+  /// Return the number of render requests since the group was created or
+  /// the counts were reset. Requests are coalesced by the view, so this is
+  /// usually much more than the number of renders.
+  /// \sa ResetRenderRequestCounts()
+  int GetRenderRequestCount();
+
+  /// Return the number of render requests made by the displayable managers
+  /// of class \a className.
+  int GetRenderRequestCountByClassName(const char* className);
+
+  /// Set the render request counts to 0
+  void ResetRenderRequestCounts();
+
   /// Get Renderer
   vtkRenderer* GetRenderer();
 
@@ -130,6 +154,28 @@ protected:
   void onDisplayableManagerFactoryRegisteredEvent(const char* displayableManagerName);
   void onDisplayableManagerFactoryUnRegisteredEvent(const char* displayableManagerName);
 
+  /// Instantiate and add the displayable manager registered in the factory
+  /// as \a displayableManagerName, or only keep track of it if it has handled
+  /// node classes.
+  void AddRegisteredDisplayableManager(const char* displayableManagerName);
+
+  /// Remove the displayable manager from the group and delete it
+  void RemoveDisplayableManager(vtkMRMLAbstractDisplayableManager* displayableManager);
+
+  /// Return true if the scene contains a node handled by the displayable manager
+  /// registered as \a displayableManagerName.
+  bool IsDisplayableManagerNeeded(const std::string& displayableManagerName, vtkMRMLScene* scene);
+
+  /// Add the displayable managers with handled node classes that are needed
+  /// and remove the ones that are not needed anymore.
+  /// If \a node is specified, only the displayable managers that handle it are updated.
+  void UpdateConditionalDisplayableManagers(vtkMRMLNode* node = nullptr);
+
+  /// Observe the scene events that can change the conditional displayable managers
+  void SetAndObserveMRMLScene(vtkMRMLScene* scene);
+  static void DoSceneCallback(vtkObject* vtk_obj, unsigned long event,
+                              void* client_data, void* call_data);
+
   class vtkInternal;
   vtkInternal* Internal;
 
@@ -33,6 +33,7 @@
 #include <vtkMRMLVolumeNode.h>
 
 // VTK includes
+#include <vtkActor.h>
 #include <vtkAlgorithm.h>
 #include <vtkAlgorithmOutput.h>
 #include <vtkAssignAttribute.h>
@@ -40,7 +41,10 @@
 #include <vtkCellArray.h>
 #include <vtkClipDataSet.h>
 #include <vtkClipPolyData.h>
+#include <vtkCollection.h>
 #include <vtkColorTransferFunction.h>
+#include <vtkCompositeDataDisplayAttributes.h>
+#include <vtkCompositePolyDataMapper2.h>
 #include <vtkDataSetAttributes.h>
 #include <vtkDataSetMapper.h>
 #include <vtkExtractGeometry.h>
@@ -52,8 +56,10 @@
 #include <vtkImplicitBoolean.h>
 #include <vtkLookupTable.h>
 #include <vtkMatrix4x4.h>
+#include <vtkMultiBlockDataSet.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
+#include <vtkPassThrough.h>
 #include <vtkPlane.h>
 #include <vtkPointData.h>
 #include <vtkPointSet.h>
@@ -61,9 +67,12 @@
 #include <vtkProp3DCollection.h>
 #include <vtkProperty.h>
 #include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
 #include <vtkSmartPointer.h>
 #include <vtkTexture.h>
+#include <vtkTransform.h>
 #include <vtkTransformFilter.h>
+#include <vtkTransformPolyDataFilter.h>
 #include <vtkVersion.h>
 #include <vtkWeakPointer.h>
 // For picking
@@ -71,11 +80,51 @@
 #include <vtkPointPicker.h>
 #include <vtkPropPicker.h>
 #include <vtkRendererCollection.h>
+#include <vtkStaticCellLocator.h>
 #include <vtkWorldPointPicker.h>
 
+// STD includes
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <set>
+#include <sstream>
+
 //---------------------------------------------------------------------------
 vtkStandardNewMacro (vtkMRMLModelDisplayableManager );
 
+namespace
+{
+
+//---------------------------------------------------------------------------
+vtkSmartPointer<vtkPointSet> TransformMesh(vtkSmartPointer<vtkPointSet> mesh, vtkSmartPointer<vtkGeneralTransform> transform)
+{
+  vtkNew<vtkTransformFilter> transformFilter;
+  transformFilter->SetInputData(mesh);
+  transformFilter->SetTransform(transform);
+  transformFilter->Update();
+  return vtkSmartPointer<vtkPointSet>(transformFilter->GetOutput());
+}
+
+//---------------------------------------------------------------------------
+/// Get the latest modification time of the transforms that make up a transform chain.
+vtkMTimeType GetTransformComponentsMTime(vtkAbstractTransform* transform)
+{
+  vtkNew<vtkCollection> transformList;
+  vtkMRMLTransformNode::FlattenGeneralTransform(transformList, transform);
+  vtkMTimeType mtime = 0;
+  vtkCollectionSimpleIterator it;
+  transformList->InitTraversal(it);
+  vtkObject* transformComponent = nullptr;
+  while ((transformComponent = transformList->GetNextItemAsObject(it)) != nullptr)
+    {
+    mtime = std::max(mtime, transformComponent->GetMTime());
+    }
+  return mtime;
+}
+
+}
+
 //---------------------------------------------------------------------------
 class vtkMRMLModelDisplayableManager::vtkInternal
 {
@@ -95,6 +144,44 @@ public:
   void FindPickedPointOnMeshAndCell(vtkPointSet* mesh, double pickedPoint[3]);
   /// Find first picked node from prop3Ds in cell picker and set PickedNodeID in Internal
   void FindFirstPickedDisplayNodeFromPickerProp3Ds();
+  /// Make the cell picker use a cell locator for each visible model mesh.
+  /// Locators are kept between picks and only rebuilt when the mesh changes,
+  /// so that picking dense models does not require testing every cell.
+  void UpdatePickLocators();
+
+  /// Non-linearly transformed mesh of a display node.
+  /// Warping a dense mesh with a grid or B-spline transform may take a long time, therefore
+  /// the mesh is transformed in a background thread. The last transformed mesh remains
+  /// displayed until the new one is ready.
+  struct NonLinearMeshTransform
+    {
+    /// Provides the last transformed mesh to the display pipeline
+    vtkSmartPointer<vtkPassThrough> Output;
+    /// Input mesh and transform of the last request, used for detecting changes
+    vtkWeakPointer<vtkPointSet> InputMesh;
+    vtkMTimeType InputMeshMTime{0};
+    vtkSmartPointer<vtkGeneralTransform> Transform;
+    vtkMTimeType TransformMTime{0};
+    /// Mesh that is being transformed in the background thread
+    std::future<vtkSmartPointer<vtkPointSet> > Result;
+    /// Latest request that arrived while the background thread was busy.
+    /// A pending request that is replaced by a newer one is discarded without being computed.
+    vtkSmartPointer<vtkPointSet> PendingMesh;
+    vtkSmartPointer<vtkGeneralTransform> PendingTransform;
+    };
+  /// Request transformation of the mesh if the mesh or the transform has changed
+  void UpdateNonLinearMeshTransform(NonLinearMeshTransform& meshTransform,
+    vtkAlgorithmOutput* meshConnection, vtkGeneralTransform* worldTransform);
+  void StartNonLinearMeshTransform(NonLinearMeshTransform& meshTransform,
+    vtkPointSet* mesh, vtkGeneralTransform* transform);
+  /// Display the meshes that have been transformed in the background thread
+  void ProcessNonLinearMeshTransformResults();
+  static void NonLinearMeshTransformTimerCallback(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+
+  /// Get a string that identifies the display properties of the actor that must be the same
+  /// for all the models that are rendered in the same batch.
+  /// Returns an empty string if the actor cannot be rendered in a batch.
+  std::string GetBatchPropertiesSignature(vtkProp3D* prop, int clipState);
 
 public:
   vtkMRMLModelDisplayableManager* External;
@@ -104,7 +191,10 @@ public:
   std::map<std::string, int>                       DisplayedClipState;
   std::map<std::string, vtkMRMLDisplayableNode*>   DisplayableNodes;
   std::map<std::string, int>                       RegisteredModelHierarchies;
-  std::map<std::string, vtkTransformFilter*>       DisplayNodeTransformFilters;
+  std::map<std::string, NonLinearMeshTransform>    NonLinearMeshTransforms;
+  /// Timer that checks for results of background mesh transforms, 0 if not running
+  int NonLinearMeshTransformTimerId;
+  vtkSmartPointer<vtkCallbackCommand> NonLinearMeshTransformTimerCallbackCommand;
 
   vtkMRMLSliceNode* RedSliceNode;
   vtkMRMLSliceNode* GreenSliceNode;
@@ -129,6 +219,8 @@ public:
   vtkSmartPointer<vtkPropPicker>       PropPicker;
   vtkSmartPointer<vtkCellPicker>       CellPicker;
   vtkSmartPointer<vtkPointPicker>      PointPicker;
+  /// Cell locators used by CellPicker, key: display node ID
+  std::map<std::string, vtkSmartPointer<vtkStaticCellLocator> > PickLocators;
 
   // Information about a pick event
   std::string  PickedDisplayNodeID;
@@ -139,6 +231,28 @@ public:
   // Used for caching the node pointer so that we do not have to search in the scene each time.
   // We do not add an observer therefore we can let the selection node deleted without our knowledge.
   vtkWeakPointer<vtkMRMLSelectionNode> SelectionNode;
+
+  // Batched rendering
+  bool BatchedRendering;
+  /// Models rendered by a single composite actor
+  struct BatchGroup
+    {
+    vtkSmartPointer<vtkActor> Actor;
+    vtkSmartPointer<vtkCompositePolyDataMapper2> Mapper;
+    vtkSmartPointer<vtkCompositeDataDisplayAttributes> DisplayAttributes;
+    /// Display node ID of each block, in block order
+    std::vector<std::string> DisplayNodeIDs;
+    };
+  /// key: display properties signature
+  std::map<std::string, BatchGroup> BatchGroups;
+  /// Mesh of a batched model, transformed to world coordinates
+  struct BatchedMesh
+    {
+    vtkSmartPointer<vtkTransformPolyDataFilter> Transformer;
+    vtkSmartPointer<vtkTransform> Transform;
+    };
+  /// key: display node ID
+  std::map<std::string, BatchedMesh> BatchedMeshes;
 };
 
 //---------------------------------------------------------------------------
@@ -162,6 +276,8 @@ vtkMRMLModelDisplayableManager::vtkInternal::vtkInternal(vtkMRMLModelDisplayable
   this->ResetPick();
 
   this->IsUpdatingModelsFromMRML = false;
+  this->BatchedRendering = false;
+  this->NonLinearMeshTransformTimerId = 0;
 }
 
 //---------------------------------------------------------------------------
@@ -220,6 +336,15 @@ void vtkMRMLModelDisplayableManager::vtkInternal::FindPickedDisplayNodeFromMesh(
         }
       }
     }
+  // Batched models are rendered using a transformed copy of their mesh
+  for (std::pair<const std::string, BatchedMesh>& batchedMesh : this->BatchedMeshes)
+    {
+    if (batchedMesh.second.Transformer->GetOutput() == mesh)
+      {
+      this->PickedDisplayNodeID = batchedMesh.first;
+      return; // Display node found
+      }
+    }
 }
 //
 //---------------------------------------------------------------------------
@@ -320,9 +445,246 @@ void vtkMRMLModelDisplayableManager::vtkInternal::FindFirstPickedDisplayNodeFrom
         return; // Display node found
         }
       }
+    for (std::pair<const std::string, BatchGroup>& batchGroup : this->BatchGroups)
+      {
+      if (pickedProp != batchGroup.second.Actor)
+        {
+        continue;
+        }
+      // Blocks are direct children of the root, therefore block index is flat index - 1
+      vtkIdType blockIndex = this->CellPicker->GetFlatBlockIndex() - 1;
+      if (blockIndex >= 0 && blockIndex < static_cast<vtkIdType>(batchGroup.second.DisplayNodeIDs.size()))
+        {
+        this->PickedDisplayNodeID = batchGroup.second.DisplayNodeIDs[blockIndex];
+        return; // Display node found
+        }
+      }
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::UpdatePickLocators()
+{
+  this->CellPicker->RemoveAllLocators();
+
+  std::map<std::string, vtkSmartPointer<vtkStaticCellLocator> > usedPickLocators;
+  for (std::pair<const std::string, vtkProp3D*>& displayedActor : this->DisplayedActors)
+    {
+    vtkActor* actor = vtkActor::SafeDownCast(displayedActor.second);
+    if (!actor || !actor->GetVisibility() || !actor->GetPickable() || !actor->GetMapper())
+      {
+      continue;
+      }
+    vtkDataSet* mesh = actor->GetMapper()->GetInput();
+    if (!vtkPointSet::SafeDownCast(mesh) || mesh->GetNumberOfCells() == 0)
+      {
+      continue;
+      }
+    vtkSmartPointer<vtkStaticCellLocator> locator;
+    std::map<std::string, vtkSmartPointer<vtkStaticCellLocator> >::iterator locatorIt =
+      this->PickLocators.find(displayedActor.first);
+    if (locatorIt != this->PickLocators.end() && locatorIt->second->GetDataSet() == mesh)
+      {
+      locator = locatorIt->second;
+      }
+    else
+      {
+      locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+      locator->SetDataSet(mesh);
+      }
+    // rebuilds the locator only if the mesh has been modified since the last build
+    locator->Update();
+    this->CellPicker->AddLocator(locator);
+    usedPickLocators[displayedActor.first] = locator;
+    }
+  // locators of removed or hidden models are released
+  this->PickLocators.swap(usedPickLocators);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::UpdateNonLinearMeshTransform(NonLinearMeshTransform& meshTransform,
+  vtkAlgorithmOutput* meshConnection, vtkGeneralTransform* worldTransform)
+{
+  if (!meshTransform.Output)
+    {
+    meshTransform.Output = vtkSmartPointer<vtkPassThrough>::New();
+    }
+  vtkAlgorithm* meshProducer = meshConnection->GetProducer();
+  meshProducer->Update();
+  vtkPointSet* mesh = vtkPointSet::SafeDownCast(meshProducer->GetOutputDataObject(meshConnection->GetIndex()));
+  if (!mesh)
+    {
+    return;
+    }
+
+  // It is important to only update the transformed mesh if the mesh or the transform chain is actually changed,
+  // because recomputing a non-linear transformation on a complex model may be very time-consuming.
+  vtkMTimeType transformMTime = GetTransformComponentsMTime(worldTransform);
+  if (mesh == meshTransform.InputMesh && mesh->GetMTime() == meshTransform.InputMeshMTime
+    && vtkMRMLTransformNode::AreTransformsEqual(worldTransform, meshTransform.Transform)
+    && transformMTime == meshTransform.TransformMTime)
+    {
+    return;
+    }
+  meshTransform.InputMesh = mesh;
+  meshTransform.InputMeshMTime = mesh->GetMTime();
+  meshTransform.Transform = worldTransform;
+  meshTransform.TransformMTime = transformMTime;
+
+  // The background thread works on copies, so that the mesh and the transform can be modified meanwhile
+  vtkSmartPointer<vtkPointSet> meshCopy = vtkSmartPointer<vtkPointSet>::Take(mesh->NewInstance());
+  meshCopy->DeepCopy(mesh);
+  vtkNew<vtkGeneralTransform> transformCopy;
+  if (!vtkMRMLTransformNode::DeepCopyTransform(transformCopy, worldTransform))
+    {
+    // the transform cannot be copied, therefore it cannot be used in the background thread
+    meshTransform.Output->SetInputData(TransformMesh(meshCopy, worldTransform));
+    return;
+    }
+
+  if (meshTransform.Output->GetNumberOfInputConnections(0) == 0)
+    {
+    // Nothing is displayed yet, transform the mesh now to show the model right away
+    meshTransform.Output->SetInputData(TransformMesh(meshCopy, transformCopy.GetPointer()));
+    return;
+    }
+  if (meshTransform.Result.valid())
+    {
+    // Background thread is busy, the mesh will be transformed when it is done
+    meshTransform.PendingMesh = meshCopy;
+    meshTransform.PendingTransform = transformCopy;
+    return;
+    }
+  this->StartNonLinearMeshTransform(meshTransform, meshCopy, transformCopy);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::StartNonLinearMeshTransform(NonLinearMeshTransform& meshTransform,
+  vtkPointSet* mesh, vtkGeneralTransform* transform)
+{
+  meshTransform.Result = std::async(std::launch::async, TransformMesh,
+    vtkSmartPointer<vtkPointSet>(mesh), vtkSmartPointer<vtkGeneralTransform>(transform));
+  if (this->NonLinearMeshTransformTimerId)
+    {
+    // results are already being checked
+    return;
+    }
+  vtkRenderWindowInteractor* interactor = this->External->GetInteractor();
+  if (interactor)
+    {
+    if (!this->NonLinearMeshTransformTimerCallbackCommand)
+      {
+      this->NonLinearMeshTransformTimerCallbackCommand = vtkSmartPointer<vtkCallbackCommand>::New();
+      this->NonLinearMeshTransformTimerCallbackCommand->SetClientData(this);
+      this->NonLinearMeshTransformTimerCallbackCommand->SetCallback(vtkInternal::NonLinearMeshTransformTimerCallback);
+      interactor->AddObserver(vtkCommand::TimerEvent, this->NonLinearMeshTransformTimerCallbackCommand);
+      }
+    this->NonLinearMeshTransformTimerId = interactor->CreateRepeatingTimer(50);
+    }
+  if (!this->NonLinearMeshTransformTimerId)
+    {
+    // Timers are not available, wait for the result
+    meshTransform.Output->SetInputData(meshTransform.Result.get());
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::ProcessNonLinearMeshTransformResults()
+{
+  bool meshModified = false;
+  bool transformRunning = false;
+  for (std::pair<const std::string, NonLinearMeshTransform>& meshTransformIt : this->NonLinearMeshTransforms)
+    {
+    NonLinearMeshTransform& meshTransform = meshTransformIt.second;
+    if (!meshTransform.Result.valid())
+      {
+      continue;
+      }
+    if (meshTransform.Result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      {
+      transformRunning = true;
+      continue;
+      }
+    meshTransform.Output->SetInputData(meshTransform.Result.get());
+    meshModified = true;
+    if (meshTransform.PendingMesh)
+      {
+      this->StartNonLinearMeshTransform(meshTransform, meshTransform.PendingMesh, meshTransform.PendingTransform);
+      meshTransform.PendingMesh = nullptr;
+      meshTransform.PendingTransform = nullptr;
+      transformRunning = true;
+      }
+    }
+  if (!transformRunning && this->NonLinearMeshTransformTimerId)
+    {
+    if (this->External->GetInteractor())
+      {
+      this->External->GetInteractor()->DestroyTimer(this->NonLinearMeshTransformTimerId);
+      }
+    this->NonLinearMeshTransformTimerId = 0;
+    }
+  if (meshModified)
+    {
+    this->External->RequestRender();
     }
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::NonLinearMeshTransformTimerCallback(
+  vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* callData)
+{
+  vtkInternal* self = reinterpret_cast<vtkInternal*>(clientData);
+  int* timerId = reinterpret_cast<int*>(callData);
+  if (!self || !timerId || *timerId != self->NonLinearMeshTransformTimerId)
+    {
+    return;
+    }
+  self->ProcessNonLinearMeshTransformResults();
+}
+
+//---------------------------------------------------------------------------
+std::string vtkMRMLModelDisplayableManager::vtkInternal::GetBatchPropertiesSignature(vtkProp3D* prop, int clipState)
+{
+  vtkActor* actor = vtkActor::SafeDownCast(prop);
+  if (!actor || clipState || actor->GetTexture())
+    {
+    return std::string();
+    }
+  vtkPolyDataMapper* mapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
+  if (!mapper || mapper->GetScalarVisibility() || !mapper->GetInputConnection(0, 0))
+    {
+    return std::string();
+    }
+  vtkProperty* property = actor->GetProperty();
+  if (property->GetOpacity() < 1.0)
+    {
+    // translucent models need to be depth sorted with other actors
+    return std::string();
+    }
+  std::ostringstream signature;
+  signature << property->GetRepresentation()
+    << " " << property->GetPointSize()
+    << " " << property->GetLineWidth()
+    << " " << property->GetLighting()
+    << " " << property->GetInterpolation()
+    << " " << property->GetShading()
+    << " " << property->GetFrontfaceCulling()
+    << " " << property->GetBackfaceCulling()
+    << " " << property->GetAmbient()
+    << " " << property->GetDiffuse()
+    << " " << property->GetSpecular()
+    << " " << property->GetSpecularPower()
+    << " " << property->GetMetallic()
+    << " " << property->GetRoughness()
+    << " " << property->GetEdgeVisibility();
+  if (property->GetEdgeVisibility())
+    {
+    double* edgeColor = property->GetEdgeColor();
+    signature << " " << edgeColor[0] << " " << edgeColor[1] << " " << edgeColor[2];
+    }
+  return signature.str();
+}
+
 
 //---------------------------------------------------------------------------
 // vtkMRMLModelDisplayableManager methods
@@ -346,18 +708,16 @@ vtkMRMLModelDisplayableManager::~vtkMRMLModelDisplayableManager()
   // release the DisplayedModelActors
   this->Internal->DisplayedActors.clear();
 
-  // release transforms
-  std::map<std::string, vtkTransformFilter *>::iterator tit;
-  for (tit = this->Internal->DisplayNodeTransformFilters.begin();
-       tit != this->Internal->DisplayNodeTransformFilters.end(); tit++ )
+  // release transforms (waits for background transforms to complete)
+  if (this->GetInteractor() && this->Internal->NonLinearMeshTransformTimerCallbackCommand)
     {
-    vtkTransformFilter  *transformFilter = tit->second;
-    transformFilter->SetInputConnection(nullptr);
-    transformFilter->SetTransform(nullptr);
-    transformFilter->Delete();
+    if (this->Internal->NonLinearMeshTransformTimerId)
+      {
+      this->GetInteractor()->DestroyTimer(this->Internal->NonLinearMeshTransformTimerId);
+      }
+    this->GetInteractor()->RemoveObserver(this->Internal->NonLinearMeshTransformTimerCallbackCommand);
     }
-
-  this->Internal->DisplayNodeTransformFilters.clear();
+  this->Internal->NonLinearMeshTransforms.clear();
 
   delete this->Internal;
 }
@@ -945,7 +1305,7 @@ void vtkMRMLModelDisplayableManager::UpdateModelsFromMRML()
     this->Internal->DisplayedActors.clear();
     this->Internal->DisplayedNodes.clear();
     this->Internal->DisplayedClipState.clear();
-    this->Internal->DisplayNodeTransformFilters.clear();
+    this->Internal->NonLinearMeshTransforms.clear();
     }
 
   // render slices first
@@ -970,6 +1330,7 @@ void vtkMRMLModelDisplayableManager::UpdateModelsFromMRML()
     {
     this->UpdateModifiedModel(model);
     }
+  this->UpdateBatchedActors();
   this->Internal->IsUpdatingModelsFromMRML = false;
 }
 
@@ -978,6 +1339,11 @@ void vtkMRMLModelDisplayableManager::UpdateModifiedModel(vtkMRMLDisplayableNode
 {
   this->UpdateModel(model);
   this->SetModelDisplayProperty(model);
+  if (!this->Internal->IsUpdatingModelsFromMRML)
+    {
+    // when all models are updated, batches are updated once at the end
+    this->UpdateBatchedActors();
+    }
 }
 
 //---------------------------------------------------------------------------
@@ -1052,32 +1418,13 @@ void vtkMRMLModelDisplayableManager::UpdateModelMesh(vtkMRMLDisplayableNode *dis
       continue;
       }
 
-    // create TransformFilter for non-linear transform
-    vtkTransformFilter* transformFilter = nullptr;
+    // transform mesh for non-linear transform
+    vtkAlgorithm* transformFilter = nullptr;
     if (hasNonLinearTransform)
       {
-      std::map<std::string, vtkTransformFilter *>::iterator tit;
-      tit = this->Internal->DisplayNodeTransformFilters.find(displayNode->GetID());
-      if (tit == this->Internal->DisplayNodeTransformFilters.end() )
-        {
-        transformFilter = vtkTransformFilter::New();
-        this->Internal->DisplayNodeTransformFilters[displayNode->GetID()] = transformFilter;
-        }
-      else
-        {
-        transformFilter = tit->second;
-        }
-      }
-
-    if (transformFilter)
-      {
-      transformFilter->SetInputConnection(meshConnection);
-      // It is important to only update the transform if the transform chain is actually changed,
-      // because recomputing a non-linear transformation on a complex model may be very time-consuming.
-      if (!vtkMRMLTransformNode::AreTransformsEqual(worldTransform, transformFilter->GetTransform()))
-        {
-        transformFilter->SetTransform(worldTransform);
-        }
+      vtkInternal::NonLinearMeshTransform& meshTransform = this->Internal->NonLinearMeshTransforms[displayNode->GetID()];
+      this->Internal->UpdateNonLinearMeshTransform(meshTransform, meshConnection, worldTransform);
+      transformFilter = meshTransform.Output;
       }
 
     vtkMRMLModelNode::MeshTypeHint meshType = modelNode ? modelNode->GetMeshType() : vtkMRMLModelNode::PolyDataMeshType;
@@ -1665,6 +2012,160 @@ bool vtkMRMLModelDisplayableManager::IsCellScalarsActive(
   return false;
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::SetBatchedRendering(bool batched)
+{
+  if (this->Internal->BatchedRendering == batched)
+    {
+    return;
+    }
+  this->Internal->BatchedRendering = batched;
+  this->Modified();
+  this->SetUpdateFromMRMLRequested(true);
+  this->RequestRender();
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLModelDisplayableManager::GetBatchedRendering()
+{
+  return this->Internal->BatchedRendering;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::UpdateBatchedActors()
+{
+  vtkRenderer* renderer = this->GetRenderer();
+  if (!renderer)
+    {
+    return;
+    }
+
+  // Sort the models that can be batched into groups of identical display properties
+  std::map<std::string, std::vector<std::string> > batchGroupDisplayNodeIDs;
+  std::set<std::string> batchedDisplayNodeIDs;
+  if (this->Internal->BatchedRendering)
+    {
+    for (std::pair<const std::string, vtkProp3D*>& displayedActor : this->Internal->DisplayedActors)
+      {
+      std::map<std::string, int>::iterator clipStateIt = this->Internal->DisplayedClipState.find(displayedActor.first);
+      int clipState = (clipStateIt != this->Internal->DisplayedClipState.end() ? clipStateIt->second : 0);
+      std::string signature = this->Internal->GetBatchPropertiesSignature(displayedActor.second, clipState);
+      if (signature.empty())
+        {
+        continue;
+        }
+      batchGroupDisplayNodeIDs[signature].push_back(displayedActor.first);
+      batchedDisplayNodeIDs.insert(displayedActor.first);
+      }
+    }
+
+  // Restore actors of models that are not batched anymore
+  for (std::map<std::string, vtkInternal::BatchedMesh>::iterator batchedMeshIt = this->Internal->BatchedMeshes.begin();
+    batchedMeshIt != this->Internal->BatchedMeshes.end();)
+    {
+    if (batchedDisplayNodeIDs.find(batchedMeshIt->first) != batchedDisplayNodeIDs.end())
+      {
+      ++batchedMeshIt;
+      continue;
+      }
+    std::map<std::string, vtkProp3D*>::iterator actorIt = this->Internal->DisplayedActors.find(batchedMeshIt->first);
+    if (actorIt != this->Internal->DisplayedActors.end() && !renderer->HasViewProp(actorIt->second))
+      {
+      renderer->AddViewProp(actorIt->second);
+      }
+    batchedMeshIt = this->Internal->BatchedMeshes.erase(batchedMeshIt);
+    }
+
+  // Remove batches that are not used anymore
+  for (std::map<std::string, vtkInternal::BatchGroup>::iterator batchGroupIt = this->Internal->BatchGroups.begin();
+    batchGroupIt != this->Internal->BatchGroups.end();)
+    {
+    if (batchGroupDisplayNodeIDs.find(batchGroupIt->first) != batchGroupDisplayNodeIDs.end())
+      {
+      ++batchGroupIt;
+      continue;
+      }
+    renderer->RemoveViewProp(batchGroupIt->second.Actor);
+    batchGroupIt = this->Internal->BatchGroups.erase(batchGroupIt);
+    }
+
+  // Update batches
+  for (std::pair<const std::string, std::vector<std::string> >& batchGroupIDs : batchGroupDisplayNodeIDs)
+    {
+    vtkInternal::BatchGroup& batchGroup = this->Internal->BatchGroups[batchGroupIDs.first];
+    if (!batchGroup.Actor)
+      {
+      batchGroup.Actor = vtkSmartPointer<vtkActor>::New();
+      batchGroup.Mapper = vtkSmartPointer<vtkCompositePolyDataMapper2>::New();
+      batchGroup.DisplayAttributes = vtkSmartPointer<vtkCompositeDataDisplayAttributes>::New();
+      batchGroup.Mapper->SetCompositeDataDisplayAttributes(batchGroup.DisplayAttributes);
+      batchGroup.Mapper->ScalarVisibilityOff();
+      batchGroup.Actor->SetMapper(batchGroup.Mapper);
+      renderer->AddViewProp(batchGroup.Actor);
+      }
+    batchGroup.DisplayNodeIDs = batchGroupIDs.second;
+    batchGroup.DisplayAttributes->RemoveBlockVisibilities();
+    batchGroup.DisplayAttributes->RemoveBlockColors();
+    batchGroup.DisplayAttributes->RemoveBlockPickabilities();
+
+    vtkNew<vtkMultiBlockDataSet> blocks;
+    blocks->SetNumberOfBlocks(static_cast<unsigned int>(batchGroup.DisplayNodeIDs.size()));
+    bool pickable = false;
+    for (unsigned int blockIndex = 0; blockIndex < batchGroup.DisplayNodeIDs.size(); ++blockIndex)
+      {
+      const std::string& displayNodeID = batchGroup.DisplayNodeIDs[blockIndex];
+      vtkActor* actor = vtkActor::SafeDownCast(this->Internal->DisplayedActors[displayNodeID]);
+      if (blockIndex == 0)
+        {
+        // all the models in the batch have the same properties, except color
+        batchGroup.Actor->GetProperty()->DeepCopy(actor->GetProperty());
+        }
+      if (renderer->HasViewProp(actor))
+        {
+        renderer->RemoveViewProp(actor);
+        }
+
+      // Composite mapper cannot transform blocks, therefore the mesh is transformed to world coordinates
+      vtkInternal::BatchedMesh& batchedMesh = this->Internal->BatchedMeshes[displayNodeID];
+      if (!batchedMesh.Transformer)
+        {
+        batchedMesh.Transformer = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
+        batchedMesh.Transform = vtkSmartPointer<vtkTransform>::New();
+        batchedMesh.Transformer->SetTransform(batchedMesh.Transform);
+        }
+      vtkNew<vtkMatrix4x4> modelToWorldMatrix;
+      if (actor->GetUserMatrix())
+        {
+        modelToWorldMatrix->DeepCopy(actor->GetUserMatrix());
+        }
+      bool matrixChanged = false;
+      for (int i = 0; i < 4 && !matrixChanged; ++i)
+        {
+        for (int j = 0; j < 4 && !matrixChanged; ++j)
+          {
+          matrixChanged = (modelToWorldMatrix->GetElement(i, j) != batchedMesh.Transform->GetMatrix()->GetElement(i, j));
+          }
+        }
+      if (matrixChanged)
+        {
+        // only modify the transform if it has changed to avoid transforming the mesh again
+        batchedMesh.Transform->SetMatrix(modelToWorldMatrix);
+        }
+      batchedMesh.Transformer->SetInputConnection(actor->GetMapper()->GetInputConnection(0, 0));
+      batchedMesh.Transformer->Update();
+      vtkPolyData* blockMesh = batchedMesh.Transformer->GetOutput();
+      blocks->SetBlock(blockIndex, blockMesh);
+
+      batchGroup.DisplayAttributes->SetBlockVisibility(blockMesh, actor->GetVisibility());
+      batchGroup.DisplayAttributes->SetBlockColor(blockMesh, actor->GetProperty()->GetColor());
+      batchGroup.DisplayAttributes->SetBlockPickability(blockMesh, actor->GetPickable());
+      pickable |= (actor->GetPickable() != 0);
+      }
+    batchGroup.Actor->SetPickable(pickable);
+    batchGroup.Mapper->SetInputDataObject(blocks);
+    }
+}
+
 //---------------------------------------------------------------------------
 // Description:
 // return the current actor corresponding to a give MRML ID
@@ -1777,6 +2278,7 @@ int vtkMRMLModelDisplayableManager::Pick(int x, int y)
   displayPoint[1] = renSize[1] - y;
   displayPoint[2] = 0.0;
 
+  this->Internal->UpdatePickLocators();
   if (this->Internal->CellPicker->Pick(displayPoint[0], displayPoint[1], displayPoint[2], ren))
     {
     this->Internal->CellPicker->GetPickPosition(pickPoint);
@@ -1831,6 +2333,7 @@ int vtkMRMLModelDisplayableManager::Pick3D(double ras[3])
     return 0;
     }
 
+  this->Internal->UpdatePickLocators();
   if (this->Internal->CellPicker->Pick3DPoint(ras, ren))
     {
     this->SetPickedCellID(this->Internal->CellPicker->GetCellId());
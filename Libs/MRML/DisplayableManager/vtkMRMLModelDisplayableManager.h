@@ -118,6 +118,17 @@ public:
   ///   False otherwise.
   static bool IsCellScalarsActive(vtkMRMLDisplayNode* displayNode, vtkMRMLModelNode* model = nullptr);
 
+  /// Render models that have the same display properties (except color and visibility)
+  /// using a single composite actor, to reduce the number of draw calls in scenes that
+  /// contain many models (e.g., atlases). Models that are translucent, clipped, textured,
+  /// colored by scalars, or unstructured grids are rendered using their own actor.
+  /// Backface color offset is not applied on batched models.
+  /// Picking reports the models that are rendered in a batch.
+  /// Disabled by default.
+  void SetBatchedRendering(bool batched);
+  bool GetBatchedRendering();
+  vtkBooleanMacro(BatchedRendering, bool);
+
 protected:
   int ActiveInteractionModes() override;
 
@@ -152,6 +163,9 @@ protected:
   void UpdateModifiedModel(vtkMRMLDisplayableNode* model);
 
   void SetModelDisplayProperty(vtkMRMLDisplayableNode* model);
+  /// Move the actors of models that can be batched into composite actors
+  /// (and the actors of models that cannot be batched anymore back to the renderer).
+  void UpdateBatchedActors();
   int GetDisplayedModelsVisibility(vtkMRMLDisplayNode* displayNode);
 
   const char* GetActiveScalarName(vtkMRMLDisplayNode* displayNode,
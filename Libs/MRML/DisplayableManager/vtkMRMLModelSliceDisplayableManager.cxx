@@ -41,13 +41,17 @@
 #include <vtkColorTransferFunction.h>
 #include <vtkDataSetSurfaceFilter.h>
 #include <vtkEventBroker.h>
+#include <vtkExtractCells.h>
 #include <vtkGeneralTransform.h>
+#include <vtkIdList.h>
 #include <vtkLookupTable.h>
+#include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPlane.h>
 #include <vtkPointLocator.h>
+#include <vtkPointSet.h>
 #include <vtkPolyDataMapper2D.h>
 #include <vtkProperty2D.h>
 #include <vtkRenderer.h>
@@ -65,8 +69,11 @@
 // STD includes
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <set>
 #include <map>
+#include <vector>
 
 //---------------------------------------------------------------------------
 vtkStandardNewMacro(vtkMRMLModelSliceDisplayableManager );
@@ -75,6 +82,39 @@ vtkStandardNewMacro(vtkMRMLModelSliceDisplayableManager );
 class vtkMRMLModelSliceDisplayableManager::vtkInternal
 {
 public:
+  /// Index of the cells of a mesh by their extent along the slice normal.
+  /// Cells are sorted into buckets by the signed distance range of their points,
+  /// so that cells that may be intersected by a slice plane of a given offset can be
+  /// found without visiting all the cells. The index is only rebuilt when the mesh
+  /// or the slice orientation changes, therefore moving the slice offset is cheap.
+  class CellIntervalIndex
+    {
+  public:
+    /// Rebuild the index if the mesh or the plane normal has changed since the last update.
+    void Update(vtkPointSet* mesh, const double normal[3]);
+    /// Get the cells that may be intersected by the plane at the given offset along the normal.
+    /// \return False if no cells are intersected.
+    bool GetCandidateCells(double offset, vtkIdList* cellIds) const;
+    /// Number of indexed cells
+    vtkIdType GetNumberOfCells() const { return static_cast<vtkIdType>(this->CellRanges.size() / 2); }
+
+  protected:
+    int GetBucketIndex(double distance) const;
+
+    vtkWeakPointer<vtkPointSet> Mesh;
+    vtkMTimeType MeshMTime{0};
+    double Normal[3]{0.0, 0.0, 0.0};
+    /// Range of signed distances of all the cells
+    double Range[2]{0.0, -1.0};
+    double BucketWidth{0.0};
+    /// Minimum and maximum signed distance of each cell
+    std::vector<double> CellRanges;
+    /// Index of the first cell of each bucket in BucketCells, with an additional element at the end
+    std::vector<vtkIdType> BucketOffsets;
+    /// Cells of all the buckets. A cell is in all the buckets that its range overlaps.
+    std::vector<vtkIdType> BucketCells;
+    };
+
   struct Pipeline
     {
     vtkSmartPointer<vtkGeneralTransform> NodeToWorld;
@@ -83,6 +123,9 @@ public:
     vtkSmartPointer<vtkDataSetSurfaceFilter> SurfaceExtractor;
     vtkSmartPointer<vtkTransformFilter> ModelWarper;
     vtkSmartPointer<vtkPlane> Plane;
+    vtkSmartPointer<vtkExtractCells> CellExtractor; // restricts cutting to the cells near the slice plane
+    vtkSmartPointer<vtkIdList> CandidateCellIds;
+    mutable CellIntervalIndex IntersectionIndex;
     vtkSmartPointer<vtkPlaneCutter> Cutter;
     vtkSmartPointer<vtkCompositeDataGeometryFilter> GeometryFilter; // appends multiple cut pieces into a single polydata
     vtkSmartPointer<vtkSampleImplicitFunctionFilter> SliceDistance;
@@ -129,6 +172,147 @@ private:
   vtkMRMLModelSliceDisplayableManager* External;
 };
 
+//---------------------------------------------------------------------------
+// vtkInternal::CellIntervalIndex methods
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelSliceDisplayableManager::vtkInternal::CellIntervalIndex
+::Update(vtkPointSet* mesh, const double normal[3])
+{
+  if (mesh == this->Mesh && mesh && mesh->GetMTime() == this->MeshMTime
+    && normal[0] == this->Normal[0] && normal[1] == this->Normal[1] && normal[2] == this->Normal[2])
+    {
+    // up-to-date
+    return;
+    }
+  this->Mesh = mesh;
+  this->MeshMTime = mesh ? mesh->GetMTime() : 0;
+  this->Normal[0] = normal[0];
+  this->Normal[1] = normal[1];
+  this->Normal[2] = normal[2];
+  this->Range[0] = std::numeric_limits<double>::max();
+  this->Range[1] = std::numeric_limits<double>::lowest();
+  this->CellRanges.clear();
+  this->BucketOffsets.clear();
+  this->BucketCells.clear();
+
+  vtkIdType numberOfCells = mesh ? mesh->GetNumberOfCells() : 0;
+  if (numberOfCells == 0)
+    {
+    return;
+    }
+
+  // Signed distance of each point along the normal
+  vtkIdType numberOfPoints = mesh->GetNumberOfPoints();
+  std::vector<double> pointDistances(numberOfPoints);
+  double point[3] = { 0.0, 0.0, 0.0 };
+  for (vtkIdType pointId = 0; pointId < numberOfPoints; ++pointId)
+    {
+    mesh->GetPoint(pointId, point);
+    pointDistances[pointId] = vtkMath::Dot(point, normal);
+    }
+
+  // Distance range of each cell
+  this->CellRanges.resize(2 * numberOfCells);
+  vtkNew<vtkIdList> cellPointIds;
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+    mesh->GetCellPoints(cellId, cellPointIds);
+    double cellRange[2] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest() };
+    for (vtkIdType i = 0; i < cellPointIds->GetNumberOfIds(); ++i)
+      {
+      double distance = pointDistances[cellPointIds->GetId(i)];
+      cellRange[0] = std::min(cellRange[0], distance);
+      cellRange[1] = std::max(cellRange[1], distance);
+      }
+    this->CellRanges[2 * cellId] = cellRange[0];
+    this->CellRanges[2 * cellId + 1] = cellRange[1];
+    if (cellRange[0] <= cellRange[1])
+      {
+      this->Range[0] = std::min(this->Range[0], cellRange[0]);
+      this->Range[1] = std::max(this->Range[1], cellRange[1]);
+      }
+    }
+  if (this->Range[0] > this->Range[1])
+    {
+    // only empty cells
+    return;
+    }
+
+  // Sort cells into buckets (counting pass, then filling pass)
+  const int maximumNumberOfBuckets = 1024;
+  const int cellsPerBucket = 16;
+  int numberOfBuckets = static_cast<int>(std::max<vtkIdType>(1,
+    std::min<vtkIdType>(maximumNumberOfBuckets, numberOfCells / cellsPerBucket)));
+  this->BucketWidth = (this->Range[1] - this->Range[0]) / numberOfBuckets;
+  this->BucketOffsets.assign(numberOfBuckets + 1, 0);
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+    if (this->CellRanges[2 * cellId] > this->CellRanges[2 * cellId + 1])
+      {
+      continue;
+      }
+    int lastBucket = this->GetBucketIndex(this->CellRanges[2 * cellId + 1]);
+    for (int bucket = this->GetBucketIndex(this->CellRanges[2 * cellId]); bucket <= lastBucket; ++bucket)
+      {
+      ++this->BucketOffsets[bucket + 1];
+      }
+    }
+  for (int bucket = 0; bucket < numberOfBuckets; ++bucket)
+    {
+    this->BucketOffsets[bucket + 1] += this->BucketOffsets[bucket];
+    }
+  this->BucketCells.resize(this->BucketOffsets[numberOfBuckets]);
+  std::vector<vtkIdType> bucketFill(this->BucketOffsets.begin(), this->BucketOffsets.end() - 1);
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+    if (this->CellRanges[2 * cellId] > this->CellRanges[2 * cellId + 1])
+      {
+      continue;
+      }
+    int lastBucket = this->GetBucketIndex(this->CellRanges[2 * cellId + 1]);
+    for (int bucket = this->GetBucketIndex(this->CellRanges[2 * cellId]); bucket <= lastBucket; ++bucket)
+      {
+      this->BucketCells[bucketFill[bucket]++] = cellId;
+      }
+    }
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLModelSliceDisplayableManager::vtkInternal::CellIntervalIndex
+::GetBucketIndex(double distance) const
+{
+  int numberOfBuckets = static_cast<int>(this->BucketOffsets.size()) - 1;
+  if (this->BucketWidth <= 0.0)
+    {
+    return 0;
+    }
+  int bucket = static_cast<int>(std::floor((distance - this->Range[0]) / this->BucketWidth));
+  return std::max(0, std::min(numberOfBuckets - 1, bucket));
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLModelSliceDisplayableManager::vtkInternal::CellIntervalIndex
+::GetCandidateCells(double offset, vtkIdList* cellIds) const
+{
+  cellIds->Reset();
+  if (this->BucketOffsets.size() < 2 || offset < this->Range[0] || offset > this->Range[1])
+    {
+    // the plane does not intersect the bounds of the mesh along the normal
+    return false;
+    }
+  int bucket = this->GetBucketIndex(offset);
+  for (vtkIdType i = this->BucketOffsets[bucket]; i < this->BucketOffsets[bucket + 1]; ++i)
+    {
+    vtkIdType cellId = this->BucketCells[i];
+    if (this->CellRanges[2 * cellId] <= offset && offset <= this->CellRanges[2 * cellId + 1])
+      {
+      cellIds->InsertNextId(cellId);
+      }
+    }
+  return cellIds->GetNumberOfIds() > 0;
+}
+
 //---------------------------------------------------------------------------
 // vtkInternal methods
 vtkMRMLModelSliceDisplayableManager::vtkInternal
@@ -319,6 +503,8 @@ void vtkMRMLModelSliceDisplayableManager::vtkInternal
   pipeline->ModelWarper = vtkSmartPointer<vtkTransformFilter>::New();
   pipeline->SurfaceExtractor = vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
   pipeline->Plane = vtkSmartPointer<vtkPlane>::New();
+  pipeline->CellExtractor = vtkSmartPointer<vtkExtractCells>::New();
+  pipeline->CandidateCellIds = vtkSmartPointer<vtkIdList>::New();
 
   // Set up pipeline
   pipeline->Transformer->SetTransform(pipeline->TransformToSlice);
@@ -326,6 +512,7 @@ void vtkMRMLModelSliceDisplayableManager::vtkInternal
   pipeline->Cutter->SetPlane(pipeline->Plane);
   pipeline->Cutter->BuildTreeOff(); // the cutter crashes for complex geometries if build tree is enabled
   pipeline->Cutter->SetInputConnection(pipeline->ModelWarper->GetOutputPort());
+  pipeline->CellExtractor->SetInputConnection(pipeline->ModelWarper->GetOutputPort());
   pipeline->GeometryFilter->SetInputConnection(pipeline->Cutter->GetOutputPort());
   // Projection is created from outer surface of volumetric meshes (for polydata surface
   // extraction is just shallow-copy)
@@ -439,9 +626,9 @@ void vtkMRMLModelSliceDisplayableManager::vtkInternal
   pipeline->ModelWarper->SetInputData(pointSet); //why here? +connection?
   pipeline->ModelWarper->SetTransform(pipeline->NodeToWorld);
 
-  // Set Plane Transform
+  // Set Plane Transform. The plane is only marked as modified if the normal or origin changes,
+  // so that the intersection is not recomputed if the slice has not moved.
   this->SetSlicePlaneFromMatrix(this->SliceXYToRAS, pipeline->Plane);
-  pipeline->Plane->Modified();
 
   if (modelDisplayNode->GetSliceDisplayMode() == vtkMRMLModelDisplayNode::SliceDisplayProjection
     || modelDisplayNode->GetSliceDisplayMode() == vtkMRMLModelDisplayNode::SliceDisplayDistanceEncodedProjection)
@@ -474,7 +661,29 @@ void vtkMRMLModelSliceDisplayableManager::vtkInternal
     // show intersection in the slice view
     // include clipper in the pipeline
     pipeline->Transformer->SetInputConnection(pipeline->GeometryFilter->GetOutputPort());
-    pipeline->Cutter->SetInputConnection(pipeline->ModelWarper->GetOutputPort());
+
+    // Only cut the cells that may be intersected by the slice plane
+    pipeline->ModelWarper->Update();
+    vtkPointSet* worldMesh = vtkPointSet::SafeDownCast(pipeline->ModelWarper->GetOutputDataObject(0));
+    double* planeNormal = pipeline->Plane->GetNormal();
+    double planeOffset = vtkMath::Dot(planeNormal, pipeline->Plane->GetOrigin());
+    pipeline->IntersectionIndex.Update(worldMesh, planeNormal);
+    if (!pipeline->IntersectionIndex.GetCandidateCells(planeOffset, pipeline->CandidateCellIds))
+      {
+      // the slice plane does not intersect the model
+      pipeline->Actor->SetVisibility(false);
+      return;
+      }
+    if (2 * pipeline->CandidateCellIds->GetNumberOfIds() < pipeline->IntersectionIndex.GetNumberOfCells())
+      {
+      pipeline->CellExtractor->SetCellList(pipeline->CandidateCellIds);
+      pipeline->Cutter->SetInputConnection(pipeline->CellExtractor->GetOutputPort());
+      }
+    else
+      {
+      // most cells are intersected, extracting them would not make cutting faster
+      pipeline->Cutter->SetInputConnection(pipeline->ModelWarper->GetOutputPort());
+      }
 
     // If there is no input or if the input has no points, the vtkTransformPolyDataFilter will display an error message
     // on every update: "No input data".
@@ -1086,23 +1086,15 @@ void vtkMRMLSliceIntersectionInteractionRepresentation::UpdateSliceIntersectionD
   pipeline->SliceOffsetHandle1Property->SetColor(intersectingSliceNode->GetLayoutColor());
   pipeline->SliceOffsetHandle2Property->SetColor(intersectingSliceNode->GetLayoutColor());
 
-  // Get slice node transforms
-  vtkMatrix4x4* xyToRAS = this->Internal->SliceNode->GetXYToRAS();
-  vtkNew<vtkMatrix4x4> rasToXY;
-  vtkMatrix4x4::Invert(xyToRAS, rasToXY);
-
   // Get slice intersection point XY
   this->ComputeSliceIntersectionPoint();
   double sliceIntersectionPoint[4] = { this->SliceIntersectionPoint[0], this->SliceIntersectionPoint[1], this->SliceIntersectionPoint[2], 1 };
 
-  // Get outer intersection line tips
-  vtkMatrix4x4* intersectingXYToRAS = intersectingSliceNode->GetXYToRAS();
-  vtkNew<vtkMatrix4x4> intersectingXYToXY;
-  vtkMatrix4x4::Multiply4x4(rasToXY, intersectingXYToRAS, intersectingXYToXY);
+  // Get outer intersection line tips (only recomputed if the slice geometry has changed)
   double intersectionLineTip1[3] = { 0.0, 0.0, 0.0};
   double intersectionLineTip2[3] = { 0.0, 0.0, 0.0};
-  int intersectionFound = this->Helper->GetLineTipsFromIntersectingSliceNode(intersectingSliceNode, intersectingXYToXY,
-    intersectionLineTip1, intersectionLineTip2);
+  int intersectionFound = vtkMRMLSliceIntersectionInteractionRepresentationHelper::GetCachedLineTipsFromIntersectingSliceNode(
+    this->Internal->SliceNode, intersectingSliceNode, intersectionLineTip1, intersectionLineTip2);
   if (!intersectionFound) // Pipelines not visible if no intersection is found
     {
     pipeline->SetIntersectionsVisibility(false);
@@ -19,6 +19,7 @@
 
 
 #include <deque>
+#include <map>
 #define _USE_MATH_DEFINES
 #include <math.h>
 
@@ -65,6 +66,7 @@
 #include "vtkTextMapper.h"
 #include "vtkTextProperty.h"
 #include "vtkTubeFilter.h"
+#include "vtkWeakPointer.h"
 #include "vtkWindow.h"
 
 // MRML includes
@@ -76,6 +78,34 @@ static const double SLICEOFFSET_HANDLE_DEFAULT_ORIENTATION[3] = { 0.0,1.0,0.0 };
 
 vtkStandardNewMacro(vtkMRMLSliceIntersectionInteractionRepresentationHelper);
 
+namespace
+{
+
+//----------------------------------------------------------------------
+/// Intersection line of a slice in the XY coordinate system of another slice
+struct SliceIntersectionGeometry
+{
+  vtkWeakPointer<vtkMRMLSliceNode> SliceNode;
+  vtkWeakPointer<vtkMRMLSliceNode> IntersectingSliceNode;
+  vtkMTimeType XYToRASTime{ 0 };
+  vtkMTimeType IntersectingXYToRASTime{ 0 };
+  int IntersectingDimensions[2]{ 0, 0 };
+  int IntersectionFound{ 0 };
+  double LineTip1[3]{ 0.0, 0.0, 0.0 };
+  double LineTip2[3]{ 0.0, 0.0, 0.0 };
+};
+
+typedef std::map<std::pair<vtkMRMLSliceNode*, vtkMRMLSliceNode*>, SliceIntersectionGeometry> SliceIntersectionGeometryCache;
+
+//----------------------------------------------------------------------
+SliceIntersectionGeometryCache& GetSliceIntersectionGeometryCache()
+{
+  static SliceIntersectionGeometryCache cache;
+  return cache;
+}
+
+} // end of anonymous namespace
+
 //----------------------------------------------------------------------
 vtkMRMLSliceIntersectionInteractionRepresentationHelper::vtkMRMLSliceIntersectionInteractionRepresentationHelper()
 {
@@ -340,6 +370,66 @@ int vtkMRMLSliceIntersectionInteractionRepresentationHelper::GetLineTipsFromInte
   return intersectionFound;
 }
 
+//----------------------------------------------------------------------
+int vtkMRMLSliceIntersectionInteractionRepresentationHelper::GetCachedLineTipsFromIntersectingSliceNode(vtkMRMLSliceNode* sliceNode,
+  vtkMRMLSliceNode* intersectingSliceNode, double intersectionLineTip1[3], double intersectionLineTip2[3])
+{
+  if (!sliceNode || !intersectingSliceNode)
+    {
+    return 0;
+    }
+  vtkMatrix4x4* xyToRAS = sliceNode->GetXYToRAS();
+  vtkMatrix4x4* intersectingXYToRAS = intersectingSliceNode->GetXYToRAS();
+  int* intersectingDimensions = intersectingSliceNode->GetDimensions();
+
+  SliceIntersectionGeometryCache& cache = GetSliceIntersectionGeometryCache();
+  std::pair<vtkMRMLSliceNode*, vtkMRMLSliceNode*> key(sliceNode, intersectingSliceNode);
+  SliceIntersectionGeometryCache::iterator geometryIt = cache.find(key);
+  if (geometryIt == cache.end())
+    {
+    // Remove entries of deleted slice nodes before adding a new one
+    for (SliceIntersectionGeometryCache::iterator it = cache.begin(); it != cache.end();)
+      {
+      if (!it->second.SliceNode || !it->second.IntersectingSliceNode)
+        {
+        it = cache.erase(it);
+        }
+      else
+        {
+        ++it;
+        }
+      }
+    geometryIt = cache.insert(std::make_pair(key, SliceIntersectionGeometry())).first;
+    }
+  SliceIntersectionGeometry& geometry = geometryIt->second;
+  // The node pointers are also checked because a new slice node may be allocated at the address of a deleted one
+  if (geometry.SliceNode != sliceNode || geometry.IntersectingSliceNode != intersectingSliceNode
+    || geometry.XYToRASTime != xyToRAS->GetMTime()
+    || geometry.IntersectingXYToRASTime != intersectingXYToRAS->GetMTime()
+    || geometry.IntersectingDimensions[0] != intersectingDimensions[0]
+    || geometry.IntersectingDimensions[1] != intersectingDimensions[1])
+    {
+    vtkNew<vtkMatrix4x4> rasToXY;
+    vtkMatrix4x4::Invert(xyToRAS, rasToXY);
+    vtkNew<vtkMatrix4x4> intersectingXYToXY;
+    vtkMatrix4x4::Multiply4x4(rasToXY, intersectingXYToRAS, intersectingXYToXY);
+    geometry.IntersectionFound = vtkMRMLSliceIntersectionInteractionRepresentationHelper::GetLineTipsFromIntersectingSliceNode(
+      intersectingSliceNode, intersectingXYToXY, geometry.LineTip1, geometry.LineTip2);
+    geometry.SliceNode = sliceNode;
+    geometry.IntersectingSliceNode = intersectingSliceNode;
+    geometry.XYToRASTime = xyToRAS->GetMTime();
+    geometry.IntersectingXYToRASTime = intersectingXYToRAS->GetMTime();
+    geometry.IntersectingDimensions[0] = intersectingDimensions[0];
+    geometry.IntersectingDimensions[1] = intersectingDimensions[1];
+    }
+  for (int i = 0; i < 3; ++i)
+    {
+    intersectionLineTip1[i] = geometry.LineTip1[i];
+    intersectionLineTip2[i] = geometry.LineTip2[i];
+    }
+  return geometry.IntersectionFound;
+}
+
 //----------------------------------------------------------------------
 void vtkMRMLSliceIntersectionInteractionRepresentationHelper::ComputeHandleToWorldTransformMatrix(double handlePosition[2], double handleOrientation[2],
   vtkMatrix4x4* handleToWorldTransformMatrix)
@@ -64,7 +64,7 @@ class VTK_MRML_DISPLAYABLEMANAGER_EXPORT vtkMRMLSliceIntersectionInteractionRepr
     void PrintSelf(ostream& os, vtkIndent indent) override;
     //@}
 
-    int IntersectWithFinitePlane(double n[3], double o[3], double pOrigin[3], double px[3], double py[3], double x0[3], double x1[3]);
+    static int IntersectWithFinitePlane(double n[3], double o[3], double pOrigin[3], double px[3], double py[3], double x0[3], double x1[3]);
 
     /// Compute intersection between a 2D line and the slice view boundaries
     void GetIntersectionWithSliceViewBoundaries(double* pointA, double* pointB, double* sliceViewBounds, double* intersectionPoint);
@@ -72,7 +72,15 @@ class VTK_MRML_DISPLAYABLEMANAGER_EXPORT vtkMRMLSliceIntersectionInteractionRepr
     /// Get boundaries of the slice view associated with a given vtkMRMLSliceNode
     void GetSliceViewBoundariesXY(vtkMRMLSliceNode* sliceNode, double* sliceViewBounds);
 
-    int GetLineTipsFromIntersectingSliceNode(vtkMRMLSliceNode* intersectingSliceNode, vtkMatrix4x4* intersectingXYToXY,
+    static int GetLineTipsFromIntersectingSliceNode(vtkMRMLSliceNode* intersectingSliceNode, vtkMatrix4x4* intersectingXYToXY,
+        double intersectionLineTip1[3], double intersectionLineTip2[3]);
+
+    /// Get tips of the intersection line of intersectingSliceNode in the XY coordinate system of sliceNode.
+    /// Results are stored in a cache shared by all slice intersection representations and are only
+    /// recomputed when XYToRAS of either slice node or dimensions of the intersecting slice node change,
+    /// therefore updates that do not change the slice geometry do not recompute the intersection.
+    /// Returns 0 if the slices do not intersect.
+    static int GetCachedLineTipsFromIntersectingSliceNode(vtkMRMLSliceNode* sliceNode, vtkMRMLSliceNode* intersectingSliceNode,
         double intersectionLineTip1[3], double intersectionLineTip2[3]);
 
     void ComputeHandleToWorldTransformMatrix(double handlePosition[2], double handleOrientation[2], vtkMatrix4x4* handleToWorldTransformMatrix);
@@ -13,6 +13,7 @@
 
 =========================================================================*/
 #include "vtkMRMLSliceIntersectionRepresentation2D.h"
+#include "vtkMRMLSliceIntersectionInteractionRepresentationHelper.h"
 
 
 #include <deque>
@@ -28,7 +29,6 @@
 #include "vtkCallbackCommand.h"
 #include "vtkCommand.h"
 #include "vtkPolyDataMapper2D.h"
-#include "vtkPlane.h"
 #include "vtkRenderer.h"
 #include "vtkRenderWindow.h"
 #include "vtkSphereSource.h"
@@ -173,8 +173,6 @@ public:
   vtkInternal(vtkMRMLSliceIntersectionRepresentation2D * external);
   ~vtkInternal();
 
-  static int IntersectWithFinitePlane(double n[3], double o[3], double pOrigin[3], double px[3], double py[3], double x0[3], double x1[3]);
-
   vtkMRMLSliceIntersectionRepresentation2D* External;
 
   vtkSmartPointer<vtkMRMLSliceNode> SliceNode;
@@ -197,77 +195,6 @@ vtkMRMLSliceIntersectionRepresentation2D::vtkInternal
 vtkMRMLSliceIntersectionRepresentation2D::vtkInternal::~vtkInternal() = default;
 
 
-//---------------------------------------------------------------------------
-int vtkMRMLSliceIntersectionRepresentation2D::vtkInternal::IntersectWithFinitePlane(double n[3], double o[3],
-  double pOrigin[3], double px[3], double py[3],
-  double x0[3], double x1[3])
-{
-  // Since we are dealing with convex shapes, if there is an intersection a
-  // single line is produced as output. So all this is necessary is to
-  // intersect the four bounding lines of the finite line and find the two
-  // intersection points.
-  int numInts = 0;
-  double t, *x = x0;
-  double xr0[3], xr1[3];
-
-  // First line
-  xr0[0] = pOrigin[0];
-  xr0[1] = pOrigin[1];
-  xr0[2] = pOrigin[2];
-  xr1[0] = px[0];
-  xr1[1] = px[1];
-  xr1[2] = px[2];
-  if (vtkPlane::IntersectWithLine(xr0, xr1, n, o, t, x))
-    {
-    numInts++;
-    x = x1;
-    }
-
-  // Second line
-  xr1[0] = py[0];
-  xr1[1] = py[1];
-  xr1[2] = py[2];
-  if (vtkPlane::IntersectWithLine(xr0, xr1, n, o, t, x))
-    {
-    numInts++;
-    x = x1;
-    }
-  if (numInts == 2)
-    {
-    return 1;
-    }
-
-  // Third line
-  xr0[0] = -pOrigin[0] + px[0] + py[0];
-  xr0[1] = -pOrigin[1] + px[1] + py[1];
-  xr0[2] = -pOrigin[2] + px[2] + py[2];
-  if (vtkPlane::IntersectWithLine(xr0, xr1, n, o, t, x))
-    {
-    numInts++;
-    x = x1;
-    }
-  if (numInts == 2)
-    {
-    return 1;
-    }
-
-  // Fourth and last line
-  xr1[0] = px[0];
-  xr1[1] = px[1];
-  xr1[2] = px[2];
-  if (vtkPlane::IntersectWithLine(xr0, xr1, n, o, t, x))
-    {
-    numInts++;
-    }
-  if (numInts == 2)
-    {
-    return 1;
-    }
-
-  // No intersection has occurred, or a single degenerate point
-  return 0;
-}
-
 //----------------------------------------------------------------------
 vtkMRMLSliceIntersectionRepresentation2D::vtkMRMLSliceIntersectionRepresentation2D()
 {
@@ -435,31 +362,12 @@ void vtkMRMLSliceIntersectionRepresentation2D::UpdateSliceIntersectionDisplay(Sl
 
   pipeline->Property->SetColor(intersectingSliceNode->GetLayoutColor());
 
-  vtkMatrix4x4* intersectingXYToRAS = intersectingSliceNode->GetXYToRAS();
-  vtkMatrix4x4* xyToRAS = this->Internal->SliceNode->GetXYToRAS();
-
-  vtkNew<vtkMatrix4x4> rasToXY;
-  vtkMatrix4x4::Invert(xyToRAS, rasToXY);
-  vtkNew<vtkMatrix4x4> intersectingXYToXY;
-  vtkMatrix4x4::Multiply4x4(rasToXY, intersectingXYToRAS, intersectingXYToXY);
-
-  double slicePlaneNormal[3] = { 0.,0.,1. };
-  double slicePlaneOrigin[3] = { 0., 0., 0. };
-
-  int* intersectingSliceSizeDimensions = intersectingSliceNode->GetDimensions();
-  double intersectingPlaneOrigin[4] = { 0, 0, 0, 1 };
-  double intersectingPlaneX[4] = { double(intersectingSliceSizeDimensions[0]), 0., 0., 1. };
-  double intersectingPlaneY[4] = { 0., double(intersectingSliceSizeDimensions[1]), 0., 1. };
-  intersectingXYToXY->MultiplyPoint(intersectingPlaneOrigin, intersectingPlaneOrigin);
-  intersectingXYToXY->MultiplyPoint(intersectingPlaneX, intersectingPlaneX);
-  intersectingXYToXY->MultiplyPoint(intersectingPlaneY, intersectingPlaneY);
-
+  // Intersection geometry is shared with the interaction representation
+  // and only recomputed if the slice geometry has changed.
   double intersectionPoint1[4] = { 0.0, 0.0, 0.0, 1.0 };
   double intersectionPoint2[4] = { 0.0, 0.0, 0.0, 1.0 };
-
-  int intersectionFound = vtkMRMLSliceIntersectionRepresentation2D::vtkInternal::IntersectWithFinitePlane(slicePlaneNormal, slicePlaneOrigin,
-    intersectingPlaneOrigin, intersectingPlaneX, intersectingPlaneY,
-    intersectionPoint1, intersectionPoint2);
+  int intersectionFound = vtkMRMLSliceIntersectionInteractionRepresentationHelper::GetCachedLineTipsFromIntersectingSliceNode(
+    this->Internal->SliceNode, intersectingSliceNode, intersectionPoint1, intersectionPoint2);
   if (!intersectionFound)
     {
     pipeline->SetVisibility(false);
@@ -30,6 +30,7 @@
 #include <vtksys/SystemTools.hxx>
 
 // STD includes
+#include <set>
 #include <sstream>
 #include <string>
 
@@ -220,6 +221,13 @@ int CreateUniqueFileNameTest(std::string tempDir)
     tempDir + "/CreateUniqueFileNameTest_1.txt"),
     tempDir + "/CreateUniqueFileNameTest_2.txt");
 
+  // Check if reserved file names are considered as existing files
+  std::set<std::string> reservedFileNames;
+  reservedFileNames.insert(tempDir + "/CreateUniqueFileNameTest_2.txt");
+  CHECK_STD_STRING(vtkMRMLScene::CreateUniqueFileName(
+    tempDir + "/CreateUniqueFileNameTest.txt", ".txt", reservedFileNames),
+    tempDir + "/CreateUniqueFileNameTest_3.txt");
+
   // Check if a suffix is incremented if a composite file extension is used
 
   // Check if we get a suffixed filename if the file exists already
@@ -23,7 +23,9 @@
 
 // MRML includes
 #include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLScalarVolumeNode.h"
 #include "vtkMRMLScene.h"
+#include "vtkMRMLSliceNode.h"
 
 // VTK includes
 #include <vtkAssignAttribute.h>
@@ -39,6 +41,7 @@
 namespace
 {
 bool testDTIPipeline();
+bool testResliceNotModifiedWithoutGeometryChange();
 }
 
 //----------------------------------------------------------------------------
@@ -73,6 +76,7 @@ int vtkMRMLSliceLayerLogicTest(int , char * [] )
 
   bool res = true;
   res = res && testDTIPipeline();
+  res = res && testResliceNotModifiedWithoutGeometryChange();
   return res ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
@@ -136,4 +140,41 @@ bool testDTIPipeline()
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool testResliceNotModifiedWithoutGeometryChange()
+{
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(10, 10, 10);
+  imageData->AllocateScalars(VTK_SHORT, 1);
+  vtkMRMLScalarVolumeNode* volumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLScalarVolumeNode"));
+  volumeNode->SetAndObserveImageData(imageData);
+  vtkMRMLSliceNode* sliceNode = vtkMRMLSliceNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLSliceNode"));
+
+  vtkNew<vtkMRMLSliceLayerLogic> logic;
+  logic->SetMRMLScene(scene);
+  logic->SetSliceNode(sliceNode);
+  logic->SetVolumeNode(volumeNode);
+
+  vtkMTimeType resliceMTime = logic->GetReslice()->GetMTime();
+  // modification that does not change the slice geometry
+  sliceNode->Modified();
+  if (logic->GetReslice()->GetMTime() != resliceMTime)
+    {
+    std::cerr << "Line " << __LINE__ << ": reslice is not expected to be modified if the slice geometry is unchanged" << std::endl;
+    return false;
+    }
+
+  // modification that changes the slice geometry
+  sliceNode->SetSliceOffset(sliceNode->GetSliceOffset() + 1.0);
+  if (logic->GetReslice()->GetMTime() == resliceMTime)
+    {
+    std::cerr << "Line " << __LINE__ << ": reslice is expected to be modified when the slice is moved" << std::endl;
+    return false;
+    }
+  return true;
+}
+
 }
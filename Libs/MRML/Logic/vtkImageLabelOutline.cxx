@@ -20,6 +20,9 @@
 #include <vtkStreamingDemandDrivenPipeline.h>
 #include <vtkVersion.h>
 
+// STD includes
+#include <algorithm>
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkImageLabelOutline);
 
@@ -194,6 +197,125 @@ static void vtkImageLabelOutlineExecute(vtkImageLabelOutline *self,
     }//for2
 }
 
+//----------------------------------------------------------------------------
+// Description:
+// Returns true if any of the count values starting at row differs from label.
+// The comparison is branchless so that the compiler can vectorize it.
+template <class T>
+static inline bool vtkImageLabelOutlineRowDiffers(const T* row, int count, T label)
+{
+  bool differs = false;
+  for (int i = 0; i < count; ++i)
+    {
+    differs |= (row[i] != label);
+    }
+  return differs;
+}
+
+//----------------------------------------------------------------------------
+// Description:
+// Fast path for integer label images. It produces the same output as
+// vtkImageLabelOutlineExecute but:
+// - pixels whose neighborhood reaches outside the image are outline pixels
+//   without looking at the neighbors, so there are no bounds checks in the
+//   neighborhood loop,
+// - neighbors are compared row by row and the search stops at the first row
+//   that contains a different label.
+template <class T>
+static void vtkImageLabelOutlineExecuteInteger(vtkImageLabelOutline *self,
+                     vtkImageData *inData, vtkImageData *outData,
+                     int outExt[6], int id)
+{
+  const T backgroundLabelValue = static_cast<T>(self->GetBackground());
+  const int outline = std::max(self->GetOutline(), 0);
+  const int hoodSize = 2 * outline + 1;
+
+  int inExt[6];
+  self->GetInputInformation()->Get(
+        vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), inExt);
+  vtkIdType inInc0, inInc1, inInc2;
+  inData->GetIncrements(inInc0, inInc1, inInc2);
+  vtkIdType outInc0, outInc1, outInc2;
+  outData->GetIncrements(outInc0, outInc1, outInc2);
+
+  // Range of pixels whose neighborhood is entirely inside the image
+  const int innerMin0 = inExt[0] + outline;
+  const int innerMax0 = inExt[1] - outline;
+  const int innerMin1 = inExt[2] + outline;
+  const int innerMax1 = inExt[3] - outline;
+
+  unsigned long count = 0;
+  unsigned long target = (unsigned long)((outExt[5]-outExt[4]+1)*(outExt[3]-outExt[2]+1)/50.0);
+  target++;
+
+  T *outPtr2 = static_cast<T*>(outData->GetScalarPointerForExtent(outExt));
+  const T *inPtr2 = static_cast<T*>(inData->GetScalarPointer(outExt[0], outExt[2], outExt[4]));
+  for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5]; outIdx2++)
+    {
+    T *outPtr1 = outPtr2;
+    const T *inPtr1 = inPtr2;
+    for (int outIdx1 = outExt[2];
+      !self->AbortExecute && outIdx1 <= outExt[3]; outIdx1++)
+      {
+      if (!id)
+        {
+        if (!(count%target))
+          {
+          self->UpdateProgress(count/(50.0*target));
+          }
+        count++;
+        }
+      const bool innerRow = (outIdx1 >= innerMin1 && outIdx1 <= innerMax1);
+      T *outPtr0 = outPtr1;
+      const T *inPtr0 = inPtr1;
+      for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; outIdx0++)
+        {
+        const T inLabelValue = *inPtr0;
+        T outValue = backgroundLabelValue;
+        if (inLabelValue != backgroundLabelValue)
+          {
+          if (!innerRow || outIdx0 < innerMin0 || outIdx0 > innerMax0)
+            {
+            // neighborhood reaches outside of the input domain
+            outValue = inLabelValue;
+            }
+          else
+            {
+            const T *hoodPtr1 = inPtr0 - outline * inInc0 - outline * inInc1;
+            for (int hoodIdx1 = 0; hoodIdx1 < hoodSize; ++hoodIdx1, hoodPtr1 += inInc1)
+              {
+              bool differs = false;
+              if (inInc0 == 1)
+                {
+                differs = vtkImageLabelOutlineRowDiffers(hoodPtr1, hoodSize, inLabelValue);
+                }
+              else
+                {
+                for (int hoodIdx0 = 0; hoodIdx0 < hoodSize; ++hoodIdx0)
+                  {
+                  differs |= (hoodPtr1[hoodIdx0 * inInc0] != inLabelValue);
+                  }
+                }
+              if (differs)
+                {
+                outValue = inLabelValue;
+                break;
+                }
+              }
+            }
+          }
+        *outPtr0 = outValue;
+        inPtr0 += inInc0;
+        outPtr0 += outInc0;
+        }//for0
+      inPtr1 += inInc1;
+      outPtr1 += outInc1;
+      }//for1
+    inPtr2 += inInc2;
+    outPtr2 += outInc2;
+    }//for2
+}
+
 //----------------------------------------------------------------------------
 // Description:
 // This method is passed a input and output data, and executes the filter
@@ -216,6 +338,8 @@ void vtkImageLabelOutline::ThreadedExecute(vtkImageData *inData,
 
   void *inPtr = inData->GetScalarPointerForExtent(outExt);
 
+  // Integer label types use a specialized implementation,
+  // floating-point types use the generic one.
   switch (inData->GetScalarType())
     {
   case VTK_DOUBLE:
@@ -227,40 +351,31 @@ void vtkImageLabelOutline::ThreadedExecute(vtkImageData *inData,
       outData, outExt, id);
     break;
   case VTK_LONG:
-    vtkImageLabelOutlineExecute(this, inData, (long *)(inPtr),
-      outData, outExt, id);
+    vtkImageLabelOutlineExecuteInteger<long>(this, inData, outData, outExt, id);
     break;
   case VTK_UNSIGNED_LONG:
-    vtkImageLabelOutlineExecute(this, inData, (unsigned long *)(inPtr),
-      outData, outExt, id);
+    vtkImageLabelOutlineExecuteInteger<unsigned long>(this, inData, outData, outExt, id);
     break;
   case VTK_INT:
-    vtkImageLabelOutlineExecute(this, inData, (int *)(inPtr),
-      outData, outExt, id);
+    vtkImageLabelOutlineExecuteInteger<int>(this, inData, outData, outExt, id);
     break;
   case VTK_UNSIGNED_INT:
-    vtkImageLabelOutlineExecute(this, inData, (unsigned int *)(inPtr),
-      outData, outExt, id);
+    vtkImageLabelOutlineExecuteInteger<unsigned int>(this, inData, outData, outExt, id);
     break;
   case VTK_SHORT:
-    vtkImageLabelOutlineExecute(this, inData, (short *)(inPtr),
-      outData, outExt, id);
+    vtkImageLabelOutlineExecuteInteger<short>(this, inData, outData, outExt, id);
     break;
   case VTK_UNSIGNED_SHORT:
-    vtkImageLabelOutlineExecute(this, inData, (unsigned short *)(inPtr),
-      outData, outExt, id);
+    vtkImageLabelOutlineExecuteInteger<unsigned short>(this, inData, outData, outExt, id);
     break;
   case VTK_CHAR:
-    vtkImageLabelOutlineExecute(this, inData, (char *)(inPtr),
-      outData, outExt, id);
+    vtkImageLabelOutlineExecuteInteger<char>(this, inData, outData, outExt, id);
     break;
   case VTK_SIGNED_CHAR:
-    vtkImageLabelOutlineExecute(this, inData, (signed char *)(inPtr),
-      outData, outExt, id);
+    vtkImageLabelOutlineExecuteInteger<signed char>(this, inData, outData, outExt, id);
     break;
   case VTK_UNSIGNED_CHAR:
-    vtkImageLabelOutlineExecute(this, inData, (unsigned char *)(inPtr),
-      outData, outExt, id);
+    vtkImageLabelOutlineExecuteInteger<unsigned char>(this, inData, outData, outExt, id);
     break;
   default:
     vtkErrorMacro(<< "Execute: Unknown input ScalarType");
@@ -878,7 +878,13 @@ vtkMRMLAbstractLogic* vtkMRMLApplicationLogic::GetModuleLogic(const char* module
   //Check that the logic is registered.
   if (this->Internal->ModuleLogicMap.count(moduleName) == 0)
     {
-    return nullptr;
+    // Give a chance to load the module on demand
+    const_cast<vtkMRMLApplicationLogic*>(this)->InvokeEvent(
+      vtkMRMLApplicationLogic::ModuleLogicRequestedEvent, const_cast<char*>(moduleName));
+    if (this->Internal->ModuleLogicMap.count(moduleName) == 0)
+      {
+      return nullptr;
+      }
     }
   return this->Internal->ModuleLogicMap[moduleName];
 }
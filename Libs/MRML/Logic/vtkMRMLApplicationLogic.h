@@ -192,6 +192,10 @@ public:
     ResumeRenderEvent,
     EditNodeEvent,
     ShowViewContextMenuEvent,
+    /// Invoked by GetModuleLogic() when no logic is registered for the module,
+    /// the module name (const char*) is passed as calldata. Observers may load
+    /// the module (e.g. if its loading has been deferred) and set its logic.
+    ModuleLogicRequestedEvent,
   };
   /// Structure passed as calldata pointer in the RequestEvent invoked event.
   struct InvokeRequest{
@@ -249,6 +253,7 @@ public:
   /// \param moduleName name of the module associated to the logic
   /// \return constant pointer to vtkMRMLAbstractLogic corresponding to the
   /// logic associated to th logic
+  /// \sa ModuleLogicRequestedEvent
   vtkMRMLAbstractLogic* GetModuleLogic(const char* moduleName) const;
 
   enum IntersectingSlicesOperation
@@ -22,6 +22,7 @@
 #include "vtkMRMLDiffusionWeightedVolumeDisplayNode.h"
 #include "vtkMRMLDiffusionTensorVolumeDisplayNode.h"
 #include "vtkMRMLDiffusionTensorVolumeSliceDisplayNode.h"
+#include "vtkMRMLImageBufferPool.h"
 #include "vtkMRMLScene.h"
 #include "vtkMRMLTransformNode.h"
 
@@ -29,6 +30,7 @@
 #include <vtkAlgorithm.h>
 #include <vtkAlgorithmOutput.h>
 #include <vtkAssignAttribute.h>
+#include <vtkCollection.h>
 #include <vtkDiffusionTensorMathematics.h>
 #include <vtkFloatArray.h>
 #include <vtkGeneralTransform.h>
@@ -40,10 +42,12 @@
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
+#include <vtkThreadedImageAlgorithm.h>
 #include <vtkTrivialProducer.h>
 #include <vtkTransform.h>
 #include <vtkVersion.h>
 #include <vtkAddonMathUtilities.h>
+#include <vtkOrientedGridTransform.h>
 
 //
 #include "vtkImageLabelOutline.h"
@@ -59,6 +63,18 @@ bool AreMatricesEqual(const vtkMatrix4x4* first, const vtkMatrix4x4* second)
   return vtkAddonMathUtilities::MatrixAreEqual(first, second);
 }
 
+// Returns true if currentTransform is a linear transform with the same matrix as newTransform.
+//----------------------------------------------------------------------------
+bool IsLinearTransformEqual(vtkAbstractTransform* currentTransform, vtkTransform* newTransform)
+{
+  vtkTransform* currentLinearTransform = vtkTransform::SafeDownCast(currentTransform);
+  if (!currentLinearTransform || !newTransform)
+    {
+    return false;
+    }
+  return AreMatricesEqual(currentLinearTransform->GetMatrix(), newTransform->GetMatrix());
+}
+
 // Convert a linear transform that is almost exactly a permute transform
 // to an exact permute transform.
 // vtkImageReslice works about 10-20% faster if it reslices along an axis
@@ -121,11 +137,13 @@ vtkMRMLSliceLayerLogic::vtkMRMLSliceLayerLogic()
   this->AssignAttributeScalarsToTensors->Assign(vtkDataSetAttributes::SCALARS, vtkDataSetAttributes::TENSORS, vtkAssignAttribute::POINT_DATA);
   this->AssignAttributeScalarsToTensorsUVW->Assign(vtkDataSetAttributes::SCALARS, vtkDataSetAttributes::TENSORS, vtkAssignAttribute::POINT_DATA);
 
-  // Create the parts for the scalar layer pipeline
-  this->Reslice = vtkImageReslice::New();
-  this->ResliceUVW = vtkImageReslice::New();
-  this->LabelOutline = vtkImageLabelOutline::New();
-  this->LabelOutlineUVW = vtkImageLabelOutline::New();
+  // Create the parts for the scalar layer pipeline.
+  // Their output is allocated from the buffer pool, as it is reallocated each time
+  // the slice is updated and its size changes when the view is resized.
+  this->Reslice = vtkMRMLPooledOutputImageFilter<vtkImageReslice>::New();
+  this->ResliceUVW = vtkMRMLPooledOutputImageFilter<vtkImageReslice>::New();
+  this->LabelOutline = vtkMRMLPooledOutputImageFilter<vtkImageLabelOutline>::New();
+  this->LabelOutlineUVW = vtkMRMLPooledOutputImageFilter<vtkImageLabelOutline>::New();
 
   //
   // Set parameters that won't change based on input
@@ -146,9 +164,32 @@ vtkMRMLSliceLayerLogic::vtkMRMLSliceLayerLogic()
   this->ResliceUVW->SetOutputDimensionality( 3 );
   this->ResliceUVW->GenerateStencilOutputOn();
 
+  vtkMRMLSliceLayerLogic::SetupTiledProcessing(this->Reslice);
+  vtkMRMLSliceLayerLogic::SetupTiledProcessing(this->ResliceUVW);
+  vtkMRMLSliceLayerLogic::SetupTiledProcessing(this->LabelOutline);
+  vtkMRMLSliceLayerLogic::SetupTiledProcessing(this->LabelOutlineUVW);
+
   this->UpdatingTransforms = 0;
 
   this->InterpolationMode = VTK_RESLICE_LINEAR;
+
+  this->BakeNonLinearTransforms = false;
+  this->BakedTransformGridSize = 64;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLayerLogic::SetupTiledProcessing(vtkThreadedImageAlgorithm* filter)
+{
+  if (!filter)
+    {
+    return;
+    }
+  // 256KB pieces (e.g., 32 rows of a 4K wide RGBA image) fit in the L2 cache
+  // and give enough pieces for load balancing between threads.
+  const vtkIdType desiredBytesPerPiece = 256 * 1024;
+  filter->EnableSMPOn();
+  filter->SetSplitModeToBeam();
+  filter->SetDesiredBytesPerPiece(desiredBytesPerPiece);
 }
 
 //----------------------------------------------------------------------------
@@ -469,6 +510,84 @@ void vtkMRMLSliceLayerLogic::UpdateVolumeDisplayNode()
 }
 
 
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLayerLogic::SetBakeNonLinearTransforms(bool bake)
+{
+  if (this->BakeNonLinearTransforms == bake)
+    {
+    return;
+    }
+  this->BakeNonLinearTransforms = bake;
+  this->UpdateTransforms();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLayerLogic::SetBakedTransformGridSize(int gridSize)
+{
+  gridSize = std::max(gridSize, 2);
+  if (this->BakedTransformGridSize == gridSize)
+    {
+    return;
+    }
+  this->BakedTransformGridSize = gridSize;
+  this->UpdateTransforms();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLSliceLayerLogic::GetBakedTransformGrid(vtkMRMLTransformNode* transformNode,
+  vtkMatrix4x4* gridToWorld, int extent[6])
+{
+  if (!transformNode || !this->VolumeNode || !this->VolumeNode->GetImageData())
+    {
+    return false;
+    }
+
+  // Get the bounding box of the transformed volume corners in world coordinates
+  int* volumeExtent = this->VolumeNode->GetImageData()->GetExtent();
+  vtkNew<vtkMatrix4x4> ijkToRAS;
+  this->VolumeNode->GetIJKToRASMatrix(ijkToRAS.GetPointer());
+  vtkNew<vtkGeneralTransform> volumeToWorld;
+  transformNode->GetTransformToWorld(volumeToWorld.GetPointer());
+  double bounds_World[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  for (int corner = 0; corner < 8; corner++)
+    {
+    double point_IJK[4] =
+      {
+      static_cast<double>(volumeExtent[(corner & 1) ? 1 : 0]),
+      static_cast<double>(volumeExtent[(corner & 2) ? 3 : 2]),
+      static_cast<double>(volumeExtent[(corner & 4) ? 5 : 4]),
+      1.0
+      };
+    double point_RAS[4] = { 0.0, 0.0, 0.0, 1.0 };
+    ijkToRAS->MultiplyPoint(point_IJK, point_RAS);
+    double point_World[3] = { 0.0, 0.0, 0.0 };
+    volumeToWorld->TransformPoint(point_RAS, point_World);
+    for (int axis = 0; axis < 3; axis++)
+      {
+      bounds_World[axis * 2] = std::min(bounds_World[axis * 2], point_World[axis]);
+      bounds_World[axis * 2 + 1] = std::max(bounds_World[axis * 2 + 1], point_World[axis]);
+      }
+    }
+
+  // Add a margin so that the grid covers the volume even where it is displaced
+  double* volumeSpacing = this->VolumeNode->GetSpacing();
+  double minimumMargin = std::max(std::max(volumeSpacing[0], volumeSpacing[1]), volumeSpacing[2]);
+  gridToWorld->Identity();
+  for (int axis = 0; axis < 3; axis++)
+    {
+    double margin = std::max(0.1 * (bounds_World[axis * 2 + 1] - bounds_World[axis * 2]), minimumMargin);
+    double origin = bounds_World[axis * 2] - margin;
+    double size = bounds_World[axis * 2 + 1] + margin - origin;
+    gridToWorld->SetElement(axis, axis, size / (this->BakedTransformGridSize - 1));
+    gridToWorld->SetElement(axis, 3, origin);
+    extent[axis * 2] = 0;
+    extent[axis * 2 + 1] = this->BakedTransformGridSize - 1;
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLSliceLayerLogic::UpdateTransforms()
 {
@@ -527,8 +646,27 @@ void vtkMRMLSliceLayerLogic::UpdateTransforms()
       transformNode->GetTransformFromWorld(worldTransform.GetPointer());
       //worldTransform->Inverse();
 
-      this->XYToIJKTransform->Concatenate(worldTransform.GetPointer());
-      this->UVWToIJKTransform->Concatenate(worldTransform.GetPointer());
+      vtkAbstractTransform* volumeTransform = worldTransform.GetPointer();
+      if (this->BakeNonLinearTransforms && !vtkMRMLTransformNode::IsGeneralTransformLinear(worldTransform))
+        {
+        // Baking only makes reslicing faster if multiple transforms are chained
+        vtkNew<vtkCollection> transformComponents;
+        vtkMRMLTransformNode::FlattenGeneralTransform(transformComponents, worldTransform);
+        vtkNew<vtkMatrix4x4> gridToWorld;
+        int gridExtent[6] = { 0, -1, 0, -1, 0, -1 };
+        if (transformComponents->GetNumberOfItems() > 1
+          && this->GetBakedTransformGrid(transformNode, gridToWorld, gridExtent))
+          {
+          vtkOrientedGridTransform* bakedTransform = transformNode->GetBakedTransformFromWorld(gridToWorld, gridExtent);
+          if (bakedTransform)
+            {
+            volumeTransform = bakedTransform;
+            }
+          }
+        }
+
+      this->XYToIJKTransform->Concatenate(volumeTransform);
+      this->UVWToIJKTransform->Concatenate(volumeTransform);
       }
 
     vtkNew<vtkMatrix4x4> rasToIJK;
@@ -540,11 +678,16 @@ void vtkMRMLSliceLayerLogic::UpdateTransforms()
     // vtkImageReslice works faster if the input is a linear transform, so try to convert it
     // to a linear transform.
     // Also attempt to make it a permute transform, as it makes reslicing even faster.
+    // The reslice transform is only replaced if it has changed, so that the reslice output
+    // (which contains all lightbox tiles) is not recomputed when only display properties change.
     vtkSmartPointer<vtkTransform> linearXYToIJKTransform = vtkSmartPointer<vtkTransform>::New();
     if (vtkMRMLTransformNode::IsGeneralTransformLinear(this->XYToIJKTransform, linearXYToIJKTransform))
       {
       SnapToPermuteMatrix(linearXYToIJKTransform);
-      this->Reslice->SetResliceTransform(linearXYToIJKTransform);
+      if (!IsLinearTransformEqual(this->Reslice->GetResliceTransform(), linearXYToIJKTransform))
+        {
+        this->Reslice->SetResliceTransform(linearXYToIJKTransform);
+        }
       }
     else
       {
@@ -554,7 +697,10 @@ void vtkMRMLSliceLayerLogic::UpdateTransforms()
     if (vtkMRMLTransformNode::IsGeneralTransformLinear(this->UVWToIJKTransform, linearUVWToIJKTransform))
       {
       SnapToPermuteMatrix(linearUVWToIJKTransform);
-      this->ResliceUVW->SetResliceTransform( linearUVWToIJKTransform );
+      if (!IsLinearTransformEqual(this->ResliceUVW->GetResliceTransform(), linearUVWToIJKTransform))
+        {
+        this->ResliceUVW->SetResliceTransform( linearUVWToIJKTransform );
+        }
       }
     else
       {
@@ -581,8 +727,14 @@ void vtkMRMLSliceLayerLogic::UpdateTransforms()
     }
   ***/
 
-  this->Reslice->SetOutputExtent( 0, dimensions[0]-1,
-                                  0, dimensions[1]-1,
+  // During interaction the slice may be computed at reduced resolution:
+  // output points are still in XY coordinates (so the reslice transform does
+  // not change) but they are sampled at every reduction-th pixel.
+  // vtkMRMLSliceLogic upsamples the blended image to the full view size.
+  int reduction = this->SliceNode ? this->SliceNode->GetCurrentResolutionReduction() : 1;
+  this->Reslice->SetOutputSpacing(reduction, reduction, 1.);
+  this->Reslice->SetOutputExtent( 0, (dimensions[0] - 1 + reduction - 1) / reduction,
+                                  0, (dimensions[1] - 1 + reduction - 1) / reduction,
                                   0, dimensions[2]-1);
 
   this->ResliceUVW->SetOutputExtent( 0, dimensionsUVW[0]-1,
@@ -933,6 +1085,8 @@ void vtkMRMLSliceLayerLogic::PrintSelf(ostream& os, vtkIndent indent)
   nextIndent = indent.GetNextIndent();
 
   os << indent << "SlicerSliceLayerLogic:             " << this->GetClassName() << "\n";
+  os << indent << "BakeNonLinearTransforms: " << (this->BakeNonLinearTransforms ? "true" : "false") << "\n";
+  os << indent << "BakedTransformGridSize: " << this->BakedTransformGridSize << "\n";
 
   if (this->VolumeNode)
     {
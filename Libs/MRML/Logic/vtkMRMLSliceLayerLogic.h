@@ -55,6 +55,7 @@ class vtkGeneralTransform;
 //#include <cstdlib>
 
 class vtkImageLabelOutline;
+class vtkThreadedImageAlgorithm;
 class vtkTransform;
 
 class VTK_MRML_LOGIC_EXPORT vtkMRMLSliceLayerLogic
@@ -135,6 +136,34 @@ public:
   vtkGetMacro(InterpolationMode, int);
   vtkSetMacro(InterpolationMode, int);
 
+  ///
+  /// If enabled, then a chain of transforms between the world and the volume that contains
+  /// non-linear transforms is baked into a single grid transform that covers the volume,
+  /// so that reslicing requires only one displacement field interpolation per pixel.
+  /// The baked transform is cached in the transform node and shared between slice views.
+  /// Disabled by default.
+  /// \sa vtkMRMLTransformNode::GetBakedTransformFromWorld
+  void SetBakeNonLinearTransforms(bool bake);
+  vtkGetMacro(BakeNonLinearTransforms, bool);
+  vtkBooleanMacro(BakeNonLinearTransforms, bool);
+
+  ///
+  /// Number of grid points along each axis of the baked transform.
+  /// Higher values make the baked transform more accurate but slower to compute.
+  /// Default is 64.
+  void SetBakedTransformGridSize(int gridSize);
+  vtkGetMacro(BakedTransformGridSize, int);
+
+  /// \brief Set up an image filter of the slice pipeline to process its output in tiles, in parallel.
+  ///
+  /// By default threaded image filters split their output into as many pieces as threads.
+  /// This makes the filter split its output into many small tiles of whole rows (rows are kept
+  /// intact because the reslice stencil output is built row by row) that are dynamically
+  /// distributed between threads by the SMP backend, so that large (e.g., 4K) views are
+  /// processed in cache-friendly pieces with good load balancing.
+  /// The filter still only re-executes if its inputs have changed.
+  static void SetupTiledProcessing(vtkThreadedImageAlgorithm* filter);
+
 protected:
   vtkMRMLSliceLayerLogic();
   ~vtkMRMLSliceLayerLogic() override;
@@ -161,6 +190,10 @@ protected:
   // Copy VolumeDisplayNodeObserved into VolumeDisplayNode
   void UpdateVolumeDisplayNode();
 
+  /// Get the grid that the transform from world is baked on: it covers the volume with a margin.
+  /// Returns false if the volume has no image data.
+  bool GetBakedTransformGrid(vtkMRMLTransformNode* transformNode, vtkMatrix4x4* gridToWorld, int extent[6]);
+
   ///
   /// the MRML Nodes that define this Logic's parameters
   vtkMRMLVolumeNode *VolumeNode;
@@ -189,6 +222,9 @@ protected:
   int UpdatingTransforms;
 
   int InterpolationMode;
+
+  bool BakeNonLinearTransforms;
+  int BakedTransformGridSize;
 };
 
 #endif
@@ -35,6 +35,7 @@
 
 // STD includes
 #include <cassert>
+#include <deque>
 
 
 //----------------------------------------------------------------------------
@@ -353,6 +354,9 @@ void vtkMRMLSliceLinkLogic::BroadcastSliceNodeEvent(vtkMRMLSliceNode *sliceNode)
     vtkCollectionSimpleIterator it;
     vtkSmartPointer<vtkCollection> nodes;
     nodes.TakeReference(this->GetMRMLScene()->GetNodesByClass("vtkMRMLSliceNode"));
+    // Modified events of the linked nodes are invoked after all of them are updated,
+    // so that each linked view is updated only once per broadcast event.
+    std::deque<MRMLNodeModifyBlocker> linkedNodeBlockers;
     for (nodes->InitTraversal(it);
         (sNode=vtkMRMLSliceNode::SafeDownCast(nodes->GetNextItemAsObject(it)));)
       {
@@ -364,6 +368,7 @@ void vtkMRMLSliceLinkLogic::BroadcastSliceNodeEvent(vtkMRMLSliceNode *sliceNode)
         {
         continue;
         }
+      linkedNodeBlockers.emplace_back(sNode);
 
       // Link slice parameters whenever the reformation is consistent
       if (vtkMRMLSliceLinkLogic::IsOrientationMatching(sliceNode, sNode))
@@ -518,6 +523,8 @@ void vtkMRMLSliceLinkLogic::BroadcastSliceNodeEvent(vtkMRMLSliceNode *sliceNode)
       // that do not require the orientation to match
       //
       }
+    // Invoke the modified events of all linked nodes
+    linkedNodeBlockers.clear();
 
     // Update SliceNodeInteractionStatus after MultiplanarReformat interaction
     this->UpdateSliceNodeInteractionStatus(sliceNode);
@@ -552,6 +559,8 @@ void vtkMRMLSliceLinkLogic::BroadcastSliceCompositeNodeEvent(vtkMRMLSliceComposi
     vtkSmartPointer<vtkCollection> nodes;
     nodes.TakeReference(this->GetMRMLScene()->GetNodesByClass("vtkMRMLSliceCompositeNode"));
 
+    // Modified events of the linked nodes are invoked after all of them are updated
+    std::deque<MRMLNodeModifyBlocker> linkedNodeBlockers;
     for (nodes->InitTraversal(it);
         (cNode=vtkMRMLSliceCompositeNode::SafeDownCast(nodes->GetNextItemAsObject(it)));)
       {
@@ -567,6 +576,7 @@ void vtkMRMLSliceLinkLogic::BroadcastSliceCompositeNodeEvent(vtkMRMLSliceComposi
           continue;
           }
         }
+      linkedNodeBlockers.emplace_back(cNode);
       // Foreground selection
       if (sliceCompositeNode->GetInteractionFlags() & sliceCompositeNode->GetInteractionFlagsModifier()
           & vtkMRMLSliceCompositeNode::ForegroundVolumeFlag)
@@ -604,6 +614,8 @@ void vtkMRMLSliceLinkLogic::BroadcastSliceCompositeNodeEvent(vtkMRMLSliceComposi
         }
 
       }
+    // Invoke the modified events of all linked nodes
+    linkedNodeBlockers.clear();
 
     this->BroadcastingEventsOff();
     }
@@ -22,6 +22,7 @@
 #include <vtkMRMLCrosshairNode.h>
 #include <vtkMRMLDiffusionTensorVolumeSliceDisplayNode.h>
 #include <vtkMRMLGlyphableVolumeDisplayNode.h>
+#include <vtkMRMLImageBufferPool.h>
 #include <vtkMRMLLinearTransformNode.h>
 #include <vtkMRMLModelNode.h>
 #include <vtkMRMLProceduralColorNode.h>
@@ -29,6 +30,7 @@
 #include <vtkMRMLScene.h>
 #include <vtkMRMLSliceCompositeNode.h>
 #include <vtkMRMLSliceDisplayNode.h>
+#include <vtkMRMLTraceRecorder.h>
 
 // VTK includes
 #include <vtkAlgorithmOutput.h>
@@ -124,6 +126,12 @@ struct BlendPipeline
 
     this->AddSubOutputCast->SetOutputScalarTypeToUnsignedChar();
     this->AddSubOutputCast->ClampOverflowOn();
+
+    vtkMRMLSliceLayerLogic::SetupTiledProcessing(this->AddSubForegroundCast);
+    vtkMRMLSliceLayerLogic::SetupTiledProcessing(this->AddSubBackgroundCast);
+    vtkMRMLSliceLayerLogic::SetupTiledProcessing(this->AddSubMath);
+    vtkMRMLSliceLayerLogic::SetupTiledProcessing(this->AddSubOutputCast);
+    vtkMRMLSliceLayerLogic::SetupTiledProcessing(this->Blend);
   }
 
   void AddLayers(std::deque<SliceLayerInfo>& layers, int sliceCompositing,
@@ -185,14 +193,16 @@ struct BlendPipeline
       }
   }
 
-  vtkNew<vtkImageCast> AddSubForegroundCast;
-  vtkNew<vtkImageCast> AddSubBackgroundCast;
-  vtkNew<vtkImageMathematics> AddSubMath;
-  vtkNew<vtkImageExtractComponents> AddSubExtractRGB;
-  vtkNew<vtkImageExtractComponents> AddSubExtractAlpha;
-  vtkNew<vtkImageAppendComponents> AddSubAppendRGBA;
-  vtkNew<vtkImageCast> AddSubOutputCast;
-  vtkNew<vtkImageBlend> Blend;
+  // Outputs are allocated from the buffer pool, as they are reallocated each time
+  // the slice is updated and their size changes when the view is resized.
+  vtkNew<vtkMRMLPooledOutputImageFilter<vtkImageCast>> AddSubForegroundCast;
+  vtkNew<vtkMRMLPooledOutputImageFilter<vtkImageCast>> AddSubBackgroundCast;
+  vtkNew<vtkMRMLPooledOutputImageFilter<vtkImageMathematics>> AddSubMath;
+  vtkNew<vtkMRMLPooledOutputImageFilter<vtkImageExtractComponents>> AddSubExtractRGB;
+  vtkNew<vtkMRMLPooledOutputImageFilter<vtkImageExtractComponents>> AddSubExtractAlpha;
+  vtkNew<vtkMRMLPooledOutputImageFilter<vtkImageAppendComponents>> AddSubAppendRGBA;
+  vtkNew<vtkMRMLPooledOutputImageFilter<vtkImageCast>> AddSubOutputCast;
+  vtkNew<vtkMRMLPooledOutputImageFilter<vtkImageBlend>> Blend;
 };
 
 //----------------------------------------------------------------------------
@@ -214,6 +224,14 @@ vtkMRMLSliceLogic::vtkMRMLSliceLogic()
   this->ExtractModelTexture->SetOutputDimensionality (2);
   this->ExtractModelTexture->SetInputConnection(this->PipelineUVW->Blend->GetOutputPort());
 
+  this->InteractionUpsample = vtkMRMLPooledOutputImageFilter<vtkImageReslice>::New();
+  this->InteractionUpsample->SetOutputOrigin(0, 0, 0);
+  this->InteractionUpsample->SetOutputSpacing(1, 1, 1);
+  this->InteractionUpsample->SetOutputDimensionality(3);
+  this->InteractionUpsample->SetInterpolationModeToLinear();
+  this->InteractionUpsample->SetBackgroundColor(0, 0, 0, 0);
+  vtkMRMLSliceLayerLogic::SetupTiledProcessing(this->InteractionUpsample);
+
   this->SliceModelNode = nullptr;
   this->SliceModelTransformNode = nullptr;
   this->SliceModelDisplayNode = nullptr;
@@ -241,6 +259,12 @@ vtkMRMLSliceLogic::~vtkMRMLSliceLogic()
     this->ExtractModelTexture = nullptr;
     }
 
+  if (this->InteractionUpsample)
+    {
+    this->InteractionUpsample->Delete();
+    this->InteractionUpsample = nullptr;
+    }
+
   this->SetBackgroundLayer (nullptr);
   this->SetForegroundLayer (nullptr);
   this->SetLabelLayer (nullptr);
@@ -856,10 +880,26 @@ vtkAlgorithmOutput * vtkMRMLSliceLogic::GetImageDataConnection()
 //----------------------------------------------------------------------------
 void vtkMRMLSliceLogic::UpdateImageData ()
 {
+  // While the slice is computed at reduced resolution (during interaction),
+  // the displayed image is upsampled to the size of the view.
+  vtkAlgorithmOutput* displayImageConnection = this->Pipeline->Blend->GetOutputPort();
+  if (this->SliceNode->GetCurrentResolutionReduction() > 1)
+    {
+    int dimensions[3] = { 0, 0, 0 };
+    this->SliceNode->GetDimensions(dimensions);
+    this->InteractionUpsample->SetInputConnection(displayImageConnection);
+    this->InteractionUpsample->SetOutputExtent(0, dimensions[0] - 1, 0, dimensions[1] - 1, 0, dimensions[2] - 1);
+    displayImageConnection = this->InteractionUpsample->GetOutputPort();
+    }
+  else
+    {
+    this->InteractionUpsample->SetInputConnection(nullptr);
+    }
+
   if (this->SliceNode->GetSliceResolutionMode() == vtkMRMLSliceNode::SliceResolutionMatch2DView)
     {
     this->ExtractModelTexture->SetInputConnection( this->Pipeline->Blend->GetOutputPort() );
-    this->ImageDataConnection = this->Pipeline->Blend->GetOutputPort();
+    this->ImageDataConnection = displayImageConnection;
     }
   else
     {
@@ -872,10 +912,7 @@ void vtkMRMLSliceLogic::UpdateImageData ()
        (this->GetForegroundLayer() != nullptr && this->GetForegroundLayer()->GetImageDataConnection() != nullptr) ||
        (this->GetLabelLayer() != nullptr && this->GetLabelLayer()->GetImageDataConnection() != nullptr) )
     {
-    if (this->ImageDataConnection == nullptr || this->Pipeline->Blend->GetOutputPort()->GetMTime() > this->ImageDataConnection->GetMTime())
-      {
-      this->ImageDataConnection = this->Pipeline->Blend->GetOutputPort();
-      }
+    this->ImageDataConnection = displayImageConnection;
     }
   else
     {
@@ -897,29 +934,23 @@ bool vtkMRMLSliceLogic::UpdateBlendLayers(vtkImageBlend* blend, const std::deque
   const int blendPort = 0;
   vtkMTimeType oldBlendMTime = blend->GetMTime();
 
-  bool layersChanged = false;
   int numberOfLayers = layers.size();
   if (numberOfLayers == blend->GetNumberOfInputConnections(blendPort))
     {
+    // Only replace the inputs that have changed, the blend filter and its output are kept
     int layerIndex = 0;
     for (std::deque<SliceLayerInfo>::const_iterator layerIt = layers.begin(); layerIt != layers.end(); ++layerIt, ++layerIndex)
       {
       if (layerIt->BlendInput != blend->GetInputConnection(blendPort, layerIndex))
         {
-        layersChanged = true;
-        break;
+        blend->SetNthInputConnection(blendPort, layerIndex, layerIt->BlendInput);
         }
       }
     }
   else
-    {
-    layersChanged = true;
-    }
-  if (layersChanged)
     {
     blend->RemoveAllInputs();
-    int layerIndex = 0;
-    for (std::deque<SliceLayerInfo>::const_iterator layerIt = layers.begin(); layerIt != layers.end(); ++layerIt, ++layerIndex)
+    for (std::deque<SliceLayerInfo>::const_iterator layerIt = layers.begin(); layerIt != layers.end(); ++layerIt)
       {
       blend->AddInputConnection(layerIt->BlendInput);
       }
@@ -941,6 +972,7 @@ bool vtkMRMLSliceLogic::UpdateBlendLayers(vtkImageBlend* blend, const std::deque
 //----------------------------------------------------------------------------
 void vtkMRMLSliceLogic::UpdatePipeline()
 {
+  vtkMRMLTraceScopeMacro("vtkMRMLSliceLogic::UpdatePipeline");
   int modified = 0;
   if ( this->SliceCompositeNode )
     {
@@ -2070,6 +2102,13 @@ void vtkMRMLSliceLogic::EndSliceNodeInteraction()
     }
 
   this->SliceNode->SetInteractionFlags(0);
+
+  // The slice may have been computed at reduced resolution during the
+  // interaction, recompute it at full resolution.
+  if (this->SliceNode->GetInteractionResolutionReduction() > 1)
+    {
+    this->SliceNode->Modified();
+    }
 }
 
 //----------------------------------------------------------------------------
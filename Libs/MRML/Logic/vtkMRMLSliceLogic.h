@@ -440,6 +440,10 @@ protected:
   BlendPipeline* Pipeline;
   BlendPipeline* PipelineUVW;
   vtkImageReslice * ExtractModelTexture;
+  /// Upsamples the blended image to the view size when the slice is
+  /// computed at reduced resolution during interaction.
+  /// \sa vtkMRMLSliceNode::GetCurrentResolutionReduction()
+  vtkImageReslice * InteractionUpsample;
   vtkAlgorithmOutput *    ImageDataConnection;
 
   vtkMRMLModelNode *            SliceModelNode;
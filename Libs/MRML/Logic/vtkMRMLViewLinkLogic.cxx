@@ -42,6 +42,7 @@
 
 // STD includes
 #include <cassert>
+#include <deque>
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkMRMLViewLinkLogic);
@@ -192,6 +193,9 @@ void vtkMRMLViewLinkLogic::BroadcastCameraNodeEvent(vtkMRMLCameraNode* sourceCam
     this->GetMRMLScene()->GetNodesByClass("vtkMRMLCameraNode"));
   vtkMRMLCameraNode* cameraNode = nullptr;
   vtkCollectionSimpleIterator it;
+  // Modified (and clipping range reset) events of the linked cameras are invoked
+  // after all of them are updated, so that each linked view is updated only once.
+  std::deque<MRMLNodeModifyBlocker> linkedNodeBlockers;
   for (nodes->InitTraversal(it);
       (cameraNode = vtkMRMLCameraNode::SafeDownCast(nodes->GetNextItemAsObject(it)));)
     {
@@ -211,6 +215,7 @@ void vtkMRMLViewLinkLogic::BroadcastCameraNodeEvent(vtkMRMLCameraNode* sourceCam
       {
       continue;
       }
+    linkedNodeBlockers.emplace_back(cameraNode);
 
     // Axis selection
     if (sourceCameraNode->GetInteractionFlags() == vtkMRMLCameraNode::LookFromAxis)
@@ -362,6 +367,8 @@ void vtkMRMLViewLinkLogic::BroadcastCameraNodeEvent(vtkMRMLCameraNode* sourceCam
       cameraNode->InvokeCustomModifiedEvent(vtkMRMLCameraNode::ResetCameraClippingEvent);
       }
     }
+  // Invoke the modified events of all linked nodes
+  linkedNodeBlockers.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -380,6 +387,8 @@ void vtkMRMLViewLinkLogic::BroadcastViewNodeEvent(vtkMRMLViewNode* viewNode)
   vtkSmartPointer<vtkCollection> nodes;
   nodes.TakeReference(this->GetMRMLScene()->GetNodesByClass("vtkMRMLViewNode"));
 
+  // Modified events of the linked nodes are invoked after all of them are updated
+  std::deque<MRMLNodeModifyBlocker> linkedNodeBlockers;
   for (nodes->InitTraversal(it);
       (vNode = vtkMRMLViewNode::SafeDownCast(nodes->GetNextItemAsObject(it)));)
     {
@@ -387,6 +396,7 @@ void vtkMRMLViewLinkLogic::BroadcastViewNodeEvent(vtkMRMLViewNode* viewNode)
       {
       continue;
       }
+    linkedNodeBlockers.emplace_back(vNode);
 
     // RenderMode selection
     if (viewNode->GetInteractionFlags() == vtkMRMLViewNode::RenderModeFlag)
@@ -457,4 +467,6 @@ void vtkMRMLViewLinkLogic::BroadcastViewNodeEvent(vtkMRMLViewNode* viewNode)
       vNode->SetFPSVisible(viewNode->GetFPSVisible());
       }
     }
+  // Invoke the modified events of all linked nodes
+  linkedNodeBlockers.clear();
 }
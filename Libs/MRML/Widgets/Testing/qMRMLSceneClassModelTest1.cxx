@@ -0,0 +1,123 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// Qt includes
+#include <QApplication>
+
+// qMRML includes
+#include "qMRMLSceneClassModel.h"
+#include "qMRMLWidget.h"
+
+// MRML includes
+#include <vtkMRMLCameraNode.h>
+#include <vtkMRMLScene.h>
+#include <vtkMRMLSliceNode.h>
+#include <vtkMRMLViewNode.h>
+
+// VTK includes
+#include <vtkNew.h>
+
+// STD includes
+#include <iostream>
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+bool checkNodeRows(qMRMLSceneClassModel& model, int line, int expectedCount)
+{
+  int count = model.rowCount(model.mrmlSceneIndex());
+  if (count != expectedCount)
+    {
+    std::cerr << "Line " << line << ": wrong number of nodes: " << count
+              << ", expected: " << expectedCount << std::endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+//-----------------------------------------------------------------------------
+int qMRMLSceneClassModelTest1(int argc, char * argv [])
+{
+  qMRMLWidget::preInitializeApplication();
+  QApplication app(argc, argv);
+  qMRMLWidget::postInitializeApplication();
+
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkMRMLViewNode> viewNode1;
+  scene->AddNode(viewNode1.GetPointer());
+  vtkNew<vtkMRMLSliceNode> sliceNode;
+  scene->AddNode(sliceNode.GetPointer());
+  vtkNew<vtkMRMLViewNode> viewNode2;
+  scene->AddNode(viewNode2.GetPointer());
+
+  qMRMLSceneClassModel model;
+  model.setMRMLScene(scene.GetPointer());
+  // All nodes are in the model if no node types are set
+  if (!checkNodeRows(model, __LINE__, 3))
+    {
+    return EXIT_FAILURE;
+    }
+
+  model.setNodeTypes(QStringList() << "vtkMRMLViewNode");
+  if (!checkNodeRows(model, __LINE__, 2)
+    || model.itemFromNode(sliceNode.GetPointer()) != nullptr
+    || model.indexFromNode(viewNode2.GetPointer()).row() != 1)
+    {
+    std::cerr << "Line " << __LINE__ << ": setNodeTypes failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Nodes of other types are ignored
+  vtkNew<vtkMRMLCameraNode> cameraNode;
+  scene->AddNode(cameraNode.GetPointer());
+  if (!checkNodeRows(model, __LINE__, 2))
+    {
+    return EXIT_FAILURE;
+    }
+  // Nodes of listed types are added in scene order
+  vtkNew<vtkMRMLViewNode> viewNode3;
+  scene->AddNode(viewNode3.GetPointer());
+  if (!checkNodeRows(model, __LINE__, 3)
+    || model.indexFromNode(viewNode3.GetPointer()).row() != 2)
+    {
+    std::cerr << "Line " << __LINE__ << ": node insertion failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+  scene->RemoveNode(viewNode1.GetPointer());
+  scene->RemoveNode(cameraNode.GetPointer());
+  if (!checkNodeRows(model, __LINE__, 2)
+    || model.indexFromNode(viewNode2.GetPointer()).row() != 0)
+    {
+    std::cerr << "Line " << __LINE__ << ": node removal failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Multiple node types
+  model.setNodeTypes(QStringList() << "vtkMRMLSliceNode" << "vtkMRMLViewNode");
+  if (!checkNodeRows(model, __LINE__, 3)
+    || model.indexFromNode(sliceNode.GetPointer()).row() != 0)
+    {
+    std::cerr << "Line " << __LINE__ << ": multiple node types failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "qMRMLSceneClassModelTest1 passed" << std::endl;
+  return EXIT_SUCCESS;
+}
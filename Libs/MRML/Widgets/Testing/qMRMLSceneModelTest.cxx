@@ -47,6 +47,7 @@ private slots:
   void testSetColumns_data();
   void testSetColumnsWithScene();
   void testSetColumnsWithScene_data();
+  void testBatchProcessNodeModified();
 };
 
 // ----------------------------------------------------------------------------
@@ -192,6 +193,34 @@ void qMRMLSceneModelTester::testSetColumnsWithScene_data()
   this->testSetColumns_data();
 }
 
+// ----------------------------------------------------------------------------
+void qMRMLSceneModelTester::testBatchProcessNodeModified()
+{
+  qMRMLSceneModel sceneModel;
+  sceneModel.setListenNodeModifiedEvent(qMRMLSceneModel::AllNodes);
+  vtkNew<vtkMRMLScene> scene;
+  sceneModel.setMRMLScene(scene.GetPointer());
+  vtkNew<vtkMRMLViewNode> node;
+  node->SetName("View");
+  scene->AddNode(node.GetPointer());
+  QCOMPARE(sceneModel.itemFromNode(node.GetPointer())->text(), QString("View"));
+
+  // Items are updated only once batch processing is completed
+  scene->StartState(vtkMRMLScene::BatchProcessState);
+  node->SetName("Renamed");
+  node->SetName("RenamedAgain");
+  QCOMPARE(sceneModel.itemFromNode(node.GetPointer())->text(), QString("View"));
+  scene->EndState(vtkMRMLScene::BatchProcessState);
+  QCOMPARE(sceneModel.itemFromNode(node.GetPointer())->text(), QString("RenamedAgain"));
+
+  // Nodes removed during batch processing are not updated
+  scene->StartState(vtkMRMLScene::BatchProcessState);
+  node->SetName("Removed");
+  scene->RemoveNode(node.GetPointer());
+  scene->EndState(vtkMRMLScene::BatchProcessState);
+  QVERIFY(sceneModel.itemFromNode(node.GetPointer()) == nullptr);
+}
+
 // ----------------------------------------------------------------------------
 CTK_TEST_MAIN(qMRMLSceneModelTest)
 #include "moc_qMRMLSceneModelTest.cxx"
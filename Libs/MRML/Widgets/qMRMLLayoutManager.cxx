@@ -96,7 +96,12 @@ QWidget* qMRMLLayoutThreeDViewFactory::createViewFromNode(vtkMRMLAbstractViewNod
   // There must be a unique ThreeDWidget per node
   Q_ASSERT(!this->viewWidget(viewNode));
 
-  qMRMLThreeDWidget* threeDWidget = new qMRMLThreeDWidget(this->layoutManager()->viewport());
+  // Reuse the view of a removed view node if any, to not create a new render window
+  qMRMLThreeDWidget* threeDWidget = qobject_cast<qMRMLThreeDWidget*>(this->takePooledView());
+  if (!threeDWidget)
+    {
+    threeDWidget = new qMRMLThreeDWidget(this->layoutManager()->viewport());
+    }
   threeDWidget->setObjectName(QString("ThreeDWidget%1").arg(viewNode->GetLayoutName()));
   threeDWidget->setMRMLScene(this->mrmlScene());
   threeDWidget->setMRMLViewNode(vtkMRMLViewNode::SafeDownCast(viewNode));
@@ -248,8 +253,13 @@ QWidget* qMRMLLayoutSliceViewFactory::createViewFromNode(vtkMRMLAbstractViewNode
   // there is a unique slice widget per node
   Q_ASSERT(!this->viewWidget(viewNode));
 
-  qMRMLSliceWidget * sliceWidget = new qMRMLSliceWidget(this->layoutManager()->viewport());
-  sliceWidget->sliceController()->setControllerButtonGroup(this->SliceControllerButtonGroup);
+  // Reuse the view of a removed slice node if any, to not create a new render window
+  qMRMLSliceWidget* sliceWidget = qobject_cast<qMRMLSliceWidget*>(this->takePooledView());
+  if (!sliceWidget)
+    {
+    sliceWidget = new qMRMLSliceWidget(this->layoutManager()->viewport());
+    sliceWidget->sliceController()->setControllerButtonGroup(this->SliceControllerButtonGroup);
+    }
   sliceWidget->setObjectName(QString("qMRMLSliceWidget%1").arg(viewNode->GetLayoutName()));
   // set slice node before setting the scene to allow using slice node names in the slice transform, display, and model nodes
   sliceWidget->setMRMLSliceNode(vtkMRMLSliceNode::SafeDownCast(viewNode));
@@ -303,12 +313,16 @@ void qMRMLLayoutManagerPrivate::init()
 
   q->setSpacing(1);
 
+  // Keep a few of the views of removed view nodes (e.g. when a scene with
+  // different views is loaded), they are reused for the next view nodes.
   qMRMLLayoutThreeDViewFactory* threeDViewFactory =
     new qMRMLLayoutThreeDViewFactory;
+  threeDViewFactory->setMaximumPooledViewCount(2);
   q->registerViewFactory(threeDViewFactory);
 
   qMRMLLayoutSliceViewFactory* sliceViewFactory =
     new qMRMLLayoutSliceViewFactory;
+  sliceViewFactory->setMaximumPooledViewCount(4);
   q->registerViewFactory(sliceViewFactory);
 
   qMRMLLayoutTableViewFactory* tableViewFactory =
@@ -21,6 +21,7 @@
 // Qt includes
 //#include <QDomElement>
 #include <QDebug>
+#include <QPointer>
 
 // CTK includes
 #include <ctkVTKAbstractView.h>
@@ -64,6 +65,9 @@ protected:
 
   qMRMLLayoutManager* LayoutManager;
   QHash<vtkMRMLAbstractViewNode*, QWidget*> Views;
+  /// Views of removed view nodes, that can be reused
+  QList<QPointer<QWidget> > PooledViews;
+  int MaximumPooledViewCount;
 
   vtkMRMLScene* MRMLScene;
   vtkMRMLAbstractViewNode* ActiveViewNode;
@@ -73,6 +77,7 @@ protected:
 qMRMLLayoutViewFactoryPrivate::qMRMLLayoutViewFactoryPrivate(qMRMLLayoutViewFactory& object)
   : q_ptr(&object)
   , LayoutManager(nullptr)
+  , MaximumPooledViewCount(0)
   , MRMLScene(nullptr)
   , ActiveViewNode(nullptr)
 {
@@ -193,6 +198,7 @@ qMRMLLayoutViewFactory::qMRMLLayoutViewFactory(QObject* parentObject)
 qMRMLLayoutViewFactory::~qMRMLLayoutViewFactory()
 {
   Q_D(qMRMLLayoutViewFactory);
+  this->setMaximumPooledViewCount(0);
   while(this->viewCount())
     {
     this->deleteView(d->Views.keys()[0]);
@@ -311,6 +317,44 @@ QWidget* qMRMLLayoutViewFactory::viewWidgetByLayoutLabel(const QString& layoutLa
   return this->viewWidget(viewNode);
 }
 
+//------------------------------------------------------------------------------
+int qMRMLLayoutViewFactory::maximumPooledViewCount()const
+{
+  Q_D(const qMRMLLayoutViewFactory);
+  return d->MaximumPooledViewCount;
+}
+
+//------------------------------------------------------------------------------
+void qMRMLLayoutViewFactory::setMaximumPooledViewCount(int count)
+{
+  Q_D(qMRMLLayoutViewFactory);
+  d->MaximumPooledViewCount = qMax(0, count);
+  while (d->PooledViews.count() > d->MaximumPooledViewCount)
+    {
+    QPointer<QWidget> pooledView = d->PooledViews.takeFirst();
+    if (pooledView)
+      {
+      pooledView->deleteLater();
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+QWidget* qMRMLLayoutViewFactory::takePooledView()
+{
+  Q_D(qMRMLLayoutViewFactory);
+  while (!d->PooledViews.isEmpty())
+    {
+    // The view may have been deleted with its parent
+    QPointer<QWidget> pooledView = d->PooledViews.takeLast();
+    if (pooledView)
+      {
+      return pooledView;
+      }
+    }
+  return nullptr;
+}
+
 //------------------------------------------------------------------------------
 QStringList qMRMLLayoutViewFactory::viewNodeNames() const
 {
@@ -479,7 +523,15 @@ void qMRMLLayoutViewFactory::deleteView(vtkMRMLAbstractViewNode* viewNode)
     }
   this->unregisterView(widgetToDelete);
   d->Views.remove(viewNode);
-  widgetToDelete->deleteLater();
+  if (d->PooledViews.count() < d->MaximumPooledViewCount)
+    {
+    widgetToDelete->setVisible(false);
+    d->PooledViews << widgetToDelete;
+    }
+  else
+    {
+    widgetToDelete->deleteLater();
+    }
   if (this->activeViewNode() == viewNode)
     {
     this->setActiveViewNode(nullptr);
@@ -50,6 +50,13 @@ class QMRML_WIDGETS_EXPORT qMRMLLayoutViewFactory : public ctkLayoutViewFactory
   /// The accessor MUST BE reimplemented in the derived class.
   /// \sa viewClassName(), isElementSupported, isViewNodeSupported
   Q_PROPERTY(QString viewClassName READ viewClassName);
+  /// This property controls the number of views that are kept when their
+  /// view node is removed, to be reused for the next view nodes that are
+  /// added instead of creating new views (creating a view creates a render
+  /// window and its OpenGL context).
+  /// 0 (no view is kept) by default.
+  /// \sa deleteView(), takePooledView()
+  Q_PROPERTY(int maximumPooledViewCount READ maximumPooledViewCount WRITE setMaximumPooledViewCount);
 public:
   /// Superclass typedef
   typedef ctkLayoutViewFactory Superclass;
@@ -95,6 +102,10 @@ public:
 
   vtkMRMLAbstractViewNode* viewNode(QWidget* widget)const;
 
+  /// \sa maximumPooledViewCount
+  int maximumPooledViewCount()const;
+  void setMaximumPooledViewCount(int count);
+
   /// Return all the names of the created view nodes.
   QStringList viewNodeNames() const;
 
@@ -146,8 +157,17 @@ protected:
   /// To be reimplemented
   /// \sa createViewFromXML
   virtual QWidget* createViewFromNode(vtkMRMLAbstractViewNode* node);
+  /// Remove the view of the view node. The view is kept in the pool if it
+  /// is not full, otherwise it is deleted.
+  /// \sa maximumPooledViewCount, takePooledView()
   virtual void deleteView(vtkMRMLAbstractViewNode* node);
 
+  /// Remove a view from the pool and return it, or return nullptr if the
+  /// pool is empty. The view is not associated with any view node and
+  /// scene, it can be set up in createViewFromNode() as a new view.
+  /// \sa maximumPooledViewCount
+  QWidget* takePooledView();
+
 private:
   Q_DECLARE_PRIVATE(qMRMLLayoutViewFactory);
   Q_DISABLE_COPY(qMRMLLayoutViewFactory);
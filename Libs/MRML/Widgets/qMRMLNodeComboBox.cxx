@@ -36,7 +36,7 @@
 #include "qMRMLNodeComboBoxMenuDelegate.h"
 #include "qMRMLNodeComboBox_p.h"
 #include "qMRMLNodeFactory.h"
-#include "qMRMLSceneModel.h"
+#include "qMRMLSceneClassModel.h"
 
 // MRML includes
 #include <vtkMRMLInteractionNode.h>
@@ -396,7 +396,7 @@ qMRMLNodeComboBox::qMRMLNodeComboBox(QWidget* parentWidget)
   , d_ptr(new qMRMLNodeComboBoxPrivate(*this))
 {
   Q_D(qMRMLNodeComboBox);
-  d->init(new qMRMLSceneModel(this));
+  d->init(new qMRMLSceneClassModel(this));
 }
 
 // --------------------------------------------------------------------------
@@ -414,7 +414,7 @@ qMRMLNodeComboBox::qMRMLNodeComboBox(qMRMLNodeComboBoxPrivate* pimpl, QWidget* p
   , d_ptr(pimpl)
 {
   Q_D(qMRMLNodeComboBox);
-  d->init(new qMRMLSceneModel(this));
+  d->init(new qMRMLSceneClassModel(this));
 }
 
 // --------------------------------------------------------------------------
@@ -956,6 +956,12 @@ void qMRMLNodeComboBox::setNodeTypes(const QStringList& _nodeTypes)
   QStringList nodeTypesFiltered = _nodeTypes;
   nodeTypesFiltered.removeAll("");
 
+  // Nodes of other types are not needed in the scene model if it supports restricting its content
+  qMRMLSceneClassModel* sceneClassModel = qobject_cast<qMRMLSceneClassModel*>(d->MRMLSceneModel);
+  if (sceneClassModel)
+    {
+    sceneClassModel->setNodeTypes(nodeTypesFiltered);
+    }
   this->sortFilterProxyModel()->setNodeTypes(nodeTypesFiltered);
   d->updateDefaultText();
   d->updateActionItems();
@@ -53,10 +53,12 @@
 #include <vtkChartLegend.h>
 #include <vtkChartXY.h>
 #include <vtkCollection.h>
+#include <vtkDataArray.h>
 #include <vtkContextMouseEvent.h>
 #include <vtkContextScene.h>
 #include <vtkContextView.h>
 #include <vtkGL2PSExporter.h>
+#include <vtkMath.h>
 #include <vtkNew.h>
 #include <vtkPen.h>
 #include <vtkPlot.h>
@@ -69,6 +71,212 @@
 #include <vtkTable.h>
 #include <vtkTextProperty.h>
 
+//--------------------------------------------------------------------------
+// qMRMLPlotSeriesDecimation methods
+
+namespace
+{
+/// Series with less points than this are always displayed without decimation.
+const vtkIdType MinimumNumberOfPointsForDecimation = 10000;
+
+//--------------------------------------------------------------------------
+bool areValuesEqual(double value1, double value2)
+{
+  return value1 == value2 || (vtkMath::IsNan(value1) && vtkMath::IsNan(value2));
+}
+}
+
+//---------------------------------------------------------------------------
+void qMRMLPlotSeriesDecimation::Bucket::add(vtkIdType row, double value)
+{
+  if (this->MinimumRow < 0 || value < this->Minimum)
+    {
+    this->MinimumRow = row;
+    this->Minimum = value;
+    }
+  if (this->MaximumRow < 0 || value > this->Maximum)
+    {
+    this->MaximumRow = row;
+    this->Maximum = value;
+    }
+}
+
+//---------------------------------------------------------------------------
+void qMRMLPlotSeriesDecimation::Bucket::add(const Bucket& other)
+{
+  if (other.MinimumRow >= 0)
+    {
+    this->add(other.MinimumRow, other.Minimum);
+    }
+  if (other.MaximumRow >= 0)
+    {
+    this->add(other.MaximumRow, other.Maximum);
+    }
+}
+
+//---------------------------------------------------------------------------
+qMRMLPlotSeriesDecimation::qMRMLPlotSeriesDecimation()
+{
+  this->X->SetName("X");
+  this->Y->SetName("Y");
+  this->Index->SetName("Index");
+  this->Table->AddColumn(this->X);
+  this->Table->AddColumn(this->Y);
+  this->Table->AddColumn(this->Index);
+}
+
+//---------------------------------------------------------------------------
+void qMRMLPlotSeriesDecimation::reset()
+{
+  this->XArray = nullptr;
+  this->YArray = nullptr;
+  this->NumberOfProcessedRows = 0;
+  this->BucketSize = 0;
+  this->Buckets.clear();
+}
+
+//---------------------------------------------------------------------------
+bool qMRMLPlotSeriesDecimation::update(vtkDataArray* xArray, vtkDataArray* yArray, vtkIdType numberOfBuckets)
+{
+  if (!yArray)
+    {
+    this->reset();
+    return false;
+    }
+  vtkIdType numberOfRows = yArray->GetNumberOfTuples();
+  if (xArray)
+    {
+    numberOfRows = std::min(numberOfRows, xArray->GetNumberOfTuples());
+    }
+  vtkIdType bucketSize = 1;
+  while (bucketSize * std::max(numberOfBuckets, vtkIdType(1)) < numberOfRows)
+    {
+    bucketSize *= 2;
+    }
+
+  // Rows that are already processed are reused if the arrays are the same and the
+  // new rows are appended after them (the last processed row is still the same).
+  vtkIdType lastRow = this->NumberOfProcessedRows - 1;
+  bool append = (xArray == this->XArray && yArray == this->YArray
+    && lastRow >= 0 && numberOfRows > lastRow && bucketSize >= this->BucketSize
+    && areValuesEqual(yArray->GetTuple1(lastRow), this->LastY)
+    && (!xArray || areValuesEqual(xArray->GetTuple1(lastRow), this->LastX)));
+  if (append && numberOfRows == this->NumberOfProcessedRows)
+    {
+    if (yArray->GetMTime() == this->YArrayMTime && (!xArray || xArray->GetMTime() == this->XArrayMTime))
+      {
+      // nothing has changed
+      return true;
+      }
+    // values have changed in place
+    append = false;
+    }
+  if (append)
+    {
+    // Merge pairs of buckets until bucket size is large enough for the new number of rows
+    while (this->BucketSize < bucketSize)
+      {
+      std::vector<Bucket> mergedBuckets((this->Buckets.size() + 1) / 2);
+      for (size_t bucketIndex = 0; bucketIndex < this->Buckets.size(); ++bucketIndex)
+        {
+        mergedBuckets[bucketIndex / 2].add(this->Buckets[bucketIndex]);
+        }
+      this->Buckets.swap(mergedBuckets);
+      this->BucketSize *= 2;
+      }
+    }
+  else
+    {
+    this->reset();
+    this->XArray = xArray;
+    this->YArray = yArray;
+    this->BucketSize = bucketSize;
+    }
+
+  double previousX = this->NumberOfProcessedRows > 0 ? this->LastX : -vtkMath::Inf();
+  this->Buckets.resize((numberOfRows + this->BucketSize - 1) / this->BucketSize);
+  for (vtkIdType row = this->NumberOfProcessedRows; row < numberOfRows; ++row)
+    {
+    if (xArray)
+      {
+      double x = xArray->GetTuple1(row);
+      if (!(x >= previousX))
+        {
+        // X values must be increasing for decimation, otherwise points of a bucket
+        // would not be next to each other in the plot.
+        this->reset();
+        return false;
+        }
+      previousX = x;
+      }
+    double y = yArray->GetTuple1(row);
+    if (!vtkMath::IsNan(y))
+      {
+      this->Buckets[row / this->BucketSize].add(row, y);
+      }
+    }
+
+  this->NumberOfProcessedRows = numberOfRows;
+  if (numberOfRows > 0)
+    {
+    this->LastY = yArray->GetTuple1(numberOfRows - 1);
+    this->LastX = xArray ? xArray->GetTuple1(numberOfRows - 1) : 0.0;
+    }
+  this->YArrayMTime = yArray->GetMTime();
+  this->XArrayMTime = xArray ? xArray->GetMTime() : 0;
+  this->updateTable(xArray);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+void qMRMLPlotSeriesDecimation::updateTable(vtkDataArray* xArray)
+{
+  vtkIdType numberOfPoints = 0;
+  for (const Bucket& bucket : this->Buckets)
+    {
+    if (bucket.MinimumRow >= 0)
+      {
+      numberOfPoints += (bucket.MinimumRow == bucket.MaximumRow ? 1 : 2);
+      }
+    }
+  // The table and its arrays are updated in place, so that the plot keeps its input
+  this->X->SetNumberOfTuples(numberOfPoints);
+  this->Y->SetNumberOfTuples(numberOfPoints);
+  this->Index->SetNumberOfTuples(numberOfPoints);
+  vtkIdType pointIndex = 0;
+  for (const Bucket& bucket : this->Buckets)
+    {
+    if (bucket.MinimumRow < 0)
+      {
+      continue;
+      }
+    vtkIdType rows[2] = { std::min(bucket.MinimumRow, bucket.MaximumRow), std::max(bucket.MinimumRow, bucket.MaximumRow) };
+    double values[2] = { bucket.MinimumRow < bucket.MaximumRow ? bucket.Minimum : bucket.Maximum,
+                         bucket.MinimumRow < bucket.MaximumRow ? bucket.Maximum : bucket.Minimum };
+    for (int i = 0; i < (rows[0] == rows[1] ? 1 : 2); ++i)
+      {
+      this->X->SetValue(pointIndex, xArray ? xArray->GetTuple1(rows[i]) : static_cast<double>(rows[i]));
+      this->Y->SetValue(pointIndex, values[i]);
+      this->Index->SetValue(pointIndex, rows[i]);
+      ++pointIndex;
+      }
+    }
+  this->X->Modified();
+  this->Y->Modified();
+  this->Index->Modified();
+  this->Table->Modified();
+}
+
+//---------------------------------------------------------------------------
+vtkIdType qMRMLPlotSeriesDecimation::sourceRowIndex(vtkIdType pointIndex)
+{
+  if (pointIndex < 0 || pointIndex >= this->Index->GetNumberOfValues())
+    {
+    return -1;
+    }
+  return this->Index->GetValue(pointIndex);
+}
+
 //--------------------------------------------------------------------------
 // qMRMLPlotViewPrivate methods
 
@@ -234,6 +442,40 @@ void qMRMLPlotViewPrivate::adjustRangeForLogScale(double range[2], double comput
     }
 }
 
+// --------------------------------------------------------------------------
+vtkTable* qMRMLPlotViewPrivate::decimatedTable(vtkPlot* plot, vtkMRMLPlotSeriesNode* plotSeriesNode,
+  vtkDataArray* xColumn, vtkDataArray* yColumn)
+{
+  Q_Q(qMRMLPlotView);
+  // Decimation would change the appearance of markers and bars, and point indices
+  // of labels and moved points would not match the table rows.
+  vtkIdType numberOfBuckets = std::max(q->width(), 100);
+  bool canDecimate = yColumn
+    && yColumn->GetNumberOfTuples() >= std::max(MinimumNumberOfPointsForDecimation, 4 * numberOfBuckets)
+    && (plotSeriesNode->GetPlotType() == vtkMRMLPlotSeriesNode::PlotTypeLine
+      || (plotSeriesNode->GetPlotType() == vtkMRMLPlotSeriesNode::PlotTypeScatter
+        && plotSeriesNode->GetMarkerStyle() == vtkMRMLPlotSeriesNode::MarkerStyleNone))
+    && (!plotSeriesNode->IsXColumnRequired() || xColumn)
+    && !q->chart()->GetDragPointAlongX() && !q->chart()->GetDragPointAlongY()
+    && plotSeriesNode->GetLabelColumnName().empty();
+  if (!canDecimate)
+    {
+    this->PlotDecimations.remove(plot);
+    return nullptr;
+    }
+  QSharedPointer<qMRMLPlotSeriesDecimation>& decimation = this->PlotDecimations[plot];
+  if (decimation.isNull())
+    {
+    decimation = QSharedPointer<qMRMLPlotSeriesDecimation>(new qMRMLPlotSeriesDecimation);
+    }
+  if (!decimation->update(plotSeriesNode->IsXColumnRequired() ? xColumn : nullptr, yColumn, numberOfBuckets))
+    {
+    this->PlotDecimations.remove(plot);
+    return nullptr;
+    }
+  return decimation->table();
+}
+
 // --------------------------------------------------------------------------
 vtkSmartPointer<vtkPlot> qMRMLPlotViewPrivate::updatePlotFromPlotSeriesNode(vtkMRMLPlotSeriesNode* plotSeriesNode, vtkPlot* existingPlot)
 {
@@ -366,7 +608,17 @@ vtkSmartPointer<vtkPlot> qMRMLPlotViewPrivate::updatePlotFromPlotSeriesNode(vtkM
     }
   newPlot->SetIndexedLabels(labelArray);
 
-  if (plotSeriesNode->IsXColumnRequired())
+  // Series of many points are displayed using the minimum and maximum values of each pixel column
+  vtkTable* decimatedTable = this->decimatedTable(newPlot, plotSeriesNode,
+    vtkDataArray::SafeDownCast(xColumn), vtkDataArray::SafeDownCast(yColumn));
+  if (decimatedTable)
+    {
+    newPlot->SetUseIndexForXSeries(false);
+    // Setting the same input does not modify the plot, it is updated as the table is modified.
+    newPlot->SetInputData(decimatedTable, "X", "Y");
+    newPlot->SetTooltipLabelFormat(plotSeriesNode->IsXColumnRequired() ? "%l = (%x, %y)" : "%x: %l = %y");
+    }
+  else if (plotSeriesNode->IsXColumnRequired())
     {
     newPlot->SetUseIndexForXSeries(false);
     newPlot->SetInputData(table, xColumnName, yColumnName);
@@ -655,7 +907,21 @@ void qMRMLPlotViewPrivate::emitSelection()
 
     if (selection->GetNumberOfValues() > 0)
       {
-      selectionCol->AddItem(selection);
+      QSharedPointer<qMRMLPlotSeriesDecimation> decimation = this->PlotDecimations.value(plot);
+      if (!decimation.isNull())
+        {
+        // Report rows of the table instead of points of the decimated series
+        vtkNew<vtkIdTypeArray> tableRowSelection;
+        for (vtkIdType i = 0; i < selection->GetNumberOfValues(); ++i)
+          {
+          tableRowSelection->InsertNextValue(decimation->sourceRowIndex(selection->GetValue(i)));
+          }
+        selectionCol->AddItem(tableRowSelection);
+        }
+      else
+        {
+        selectionCol->AddItem(selection);
+        }
       vtkMRMLPlotSeriesNode* plotSeriesNode = this->plotSeriesNodeFromPlot(plot);
       if (plotSeriesNode)
         {
@@ -740,6 +1006,7 @@ void qMRMLPlotViewPrivate::updateWidgetFromMRML()
       q->removePlot(q->chart()->GetPlot(0));
       }
     this->MapPlotToPlotSeriesNodeID.clear();
+    this->PlotDecimations.clear();
     this->UpdatingWidgetFromMRML = false;
     return;
     }
@@ -814,6 +1081,7 @@ void qMRMLPlotViewPrivate::updateWidgetFromMRML()
 
       q->removePlot(plot);
       this->MapPlotToPlotSeriesNodeID.remove(plot);
+      this->PlotDecimations.remove(plot);
       }
     }
 
@@ -34,6 +34,10 @@
 // Qt includes
 class QToolButton;
 #include <QMap>
+#include <QSharedPointer>
+
+// STD includes
+#include <vector>
 
 // VTK includes
 #include <vtkWeakPointer.h>
@@ -47,9 +51,14 @@ class QToolButton;
 #include "qMRMLPlotView.h"
 
 // vtk includes
+#include <vtkDoubleArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkNew.h>
 #include <vtkSmartPointer.h>
+#include <vtkTable.h>
 class vtkPlot;
 
+class vtkDataArray;
 class vtkMRMLPlotSeriesNode;
 class vtkMRMLPlotViewNode;
 class vtkMRMLPlotChartNode;
@@ -57,6 +66,60 @@ class vtkObject;
 class vtkPlot;
 class vtkStringArray;
 
+//-----------------------------------------------------------------------------
+/// Min/max decimation of a plot series, for displaying series of many points.
+///
+/// Rows are grouped in buckets of a power-of-two size, so that there are about
+/// as many buckets as pixel columns. Only the minimum and maximum Y values of each bucket
+/// are kept, which preserves the envelope of the signal. When rows are appended to
+/// the table, only the new rows are processed (and buckets are merged pairwise when
+/// the bucket size doubles).
+class qMRMLPlotSeriesDecimation
+{
+public:
+  qMRMLPlotSeriesDecimation();
+
+  /// Update the decimated table from the table columns.
+  /// If xArray is nullptr then row indices are used as X values.
+  /// Returns false if the series cannot be decimated (X values are not increasing).
+  bool update(vtkDataArray* xArray, vtkDataArray* yArray, vtkIdType numberOfBuckets);
+
+  /// Table of the decimated points, with "X", "Y" and "Index" (original row index) columns.
+  vtkTable* table() { return this->Table; }
+
+  /// Original row index of a point of the decimated table.
+  vtkIdType sourceRowIndex(vtkIdType pointIndex);
+
+protected:
+  struct Bucket
+  {
+    vtkIdType MinimumRow{-1};
+    double Minimum{0.0};
+    vtkIdType MaximumRow{-1};
+    double Maximum{0.0};
+    void add(vtkIdType row, double value);
+    void add(const Bucket& other);
+  };
+
+  void reset();
+  void updateTable(vtkDataArray* xArray);
+
+  vtkWeakPointer<vtkDataArray> XArray;
+  vtkWeakPointer<vtkDataArray> YArray;
+  vtkMTimeType XArrayMTime{0};
+  vtkMTimeType YArrayMTime{0};
+  vtkIdType NumberOfProcessedRows{0};
+  double LastX{0.0};
+  double LastY{0.0};
+  vtkIdType BucketSize{0};
+  std::vector<Bucket> Buckets;
+
+  vtkNew<vtkTable> Table;
+  vtkNew<vtkDoubleArray> X;
+  vtkNew<vtkDoubleArray> Y;
+  vtkNew<vtkIdTypeArray> Index;
+};
+
 //-----------------------------------------------------------------------------
 class qMRMLPlotViewPrivate: public QObject
 {
@@ -83,6 +146,11 @@ public:
   // Adjust range to make it displayable with logarithmic scale
   void adjustRangeForLogScale(double range[2], double computedLimit[2]);
 
+  // Returns the decimated table to display for the plot series, or nullptr if the
+  // series is displayed using all the points of the table.
+  vtkTable* decimatedTable(vtkPlot* plot, vtkMRMLPlotSeriesNode* plotSeriesNode,
+    vtkDataArray* xColumn, vtkDataArray* yColumn);
+
 public slots:
   /// Handle MRML scene event
   void startProcessing();
@@ -108,6 +176,7 @@ protected:
   bool                               UpdatingWidgetFromMRML;
 
   QMap< vtkPlot*, QString > MapPlotToPlotSeriesNodeID;
+  QMap< vtkPlot*, QSharedPointer<qMRMLPlotSeriesDecimation> > PlotDecimations;
 };
 
 #endif
@@ -0,0 +1,222 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// qMRML includes
+#include "qMRMLSceneClassModel.h"
+
+// MRML includes
+#include <vtkMRMLNode.h>
+#include <vtkMRMLScene.h>
+
+// VTK includes
+#include <vtkCollection.h>
+
+// STD includes
+#include <algorithm>
+
+//------------------------------------------------------------------------------
+class qMRMLSceneClassModelPrivate
+{
+public:
+  QStringList NodeTypes;
+};
+
+//------------------------------------------------------------------------------
+qMRMLSceneClassModel::qMRMLSceneClassModel(QObject *vparent)
+  : Superclass(vparent)
+  , d_ptr(new qMRMLSceneClassModelPrivate)
+{
+}
+
+//------------------------------------------------------------------------------
+qMRMLSceneClassModel::~qMRMLSceneClassModel() = default;
+
+//------------------------------------------------------------------------------
+QStringList qMRMLSceneClassModel::nodeTypes()const
+{
+  Q_D(const qMRMLSceneClassModel);
+  return d->NodeTypes;
+}
+
+//------------------------------------------------------------------------------
+void qMRMLSceneClassModel::setNodeTypes(const QStringList& nodeTypes)
+{
+  Q_D(qMRMLSceneClassModel);
+  if (d->NodeTypes == nodeTypes)
+    {
+    return;
+    }
+  d->NodeTypes = nodeTypes;
+
+  vtkMRMLScene* scene = this->mrmlScene();
+  if (!scene)
+    {
+    return;
+    }
+  // Remove the nodes that are not listed anymore and add the ones that are newly listed.
+  // Unchanged nodes keep their items, so views do not lose their current node.
+  std::vector<vtkMRMLNode*> nodes;
+  vtkMRMLNode* node = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (scene->GetNodes()->InitTraversal(it);
+       (node = vtkMRMLNode::SafeDownCast(scene->GetNodes()->GetNextItemAsObject(it))) ;)
+    {
+    nodes.push_back(node);
+    }
+  for (vtkMRMLNode* sceneNode : nodes)
+    {
+    if (!this->isNodeTypeListed(sceneNode) && this->itemFromNode(sceneNode))
+      {
+      this->Superclass::onMRMLSceneNodeAboutToBeRemoved(scene, sceneNode);
+      }
+    }
+  for (vtkMRMLNode* sceneNode : nodes)
+    {
+    if (this->isNodeTypeListed(sceneNode) && !this->itemFromNode(sceneNode))
+      {
+      this->insertNode(sceneNode);
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+bool qMRMLSceneClassModel::isNodeTypeListed(vtkMRMLNode* node)const
+{
+  Q_D(const qMRMLSceneClassModel);
+  if (!node)
+    {
+    return false;
+    }
+  if (d->NodeTypes.isEmpty())
+    {
+    return true;
+    }
+  foreach(const QString& nodeType, d->NodeTypes)
+    {
+    if (node->IsA(nodeType.toUtf8()))
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+void qMRMLSceneClassModel::listedNodes(std::vector<vtkMRMLNode*>& nodes)const
+{
+  Q_D(const qMRMLSceneClassModel);
+  nodes.clear();
+  vtkMRMLScene* scene = this->mrmlScene();
+  if (!scene)
+    {
+    return;
+    }
+  if (d->NodeTypes.size() == 1)
+    {
+    // The class index of the scene returns the nodes in scene order
+    scene->GetNodesByClass(d->NodeTypes[0].toUtf8(), nodes);
+    return;
+    }
+  // Nodes of multiple classes need to be interleaved in scene order
+  vtkMRMLNode* node = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (scene->GetNodes()->InitTraversal(it);
+       (node = vtkMRMLNode::SafeDownCast(scene->GetNodes()->GetNextItemAsObject(it))) ;)
+    {
+    if (this->isNodeTypeListed(node))
+      {
+      nodes.push_back(node);
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+int qMRMLSceneClassModel::nodeIndex(vtkMRMLNode* node)const
+{
+  Q_D(const qMRMLSceneClassModel);
+  if (d->NodeTypes.isEmpty())
+    {
+    return this->Superclass::nodeIndex(node);
+    }
+  if (!node || !node->GetID() || !this->isNodeTypeListed(node))
+    {
+    return -1;
+    }
+  std::vector<vtkMRMLNode*> nodes;
+  this->listedNodes(nodes);
+  std::vector<vtkMRMLNode*>::iterator nodeIt = std::find(nodes.begin(), nodes.end(), node);
+  if (nodeIt == nodes.end())
+    {
+    return -1;
+    }
+  return static_cast<int>(nodeIt - nodes.begin());
+}
+
+//------------------------------------------------------------------------------
+void qMRMLSceneClassModel::populateScene()
+{
+  Q_D(qMRMLSceneClassModel);
+  if (d->NodeTypes.isEmpty())
+    {
+    this->Superclass::populateScene();
+    return;
+    }
+  QStandardItem* sceneItem = this->mrmlSceneItem();
+  if (!sceneItem)
+    {
+    return;
+    }
+  std::vector<vtkMRMLNode*> nodes;
+  this->listedNodes(nodes);
+  // Nodes are inserted in scene order, the row is known without calling nodeIndex()
+  int row = this->preItems(sceneItem).count();
+  for (vtkMRMLNode* node : nodes)
+    {
+    this->insertNode(node, sceneItem, row);
+    ++row;
+    }
+}
+
+//------------------------------------------------------------------------------
+void qMRMLSceneClassModel::onMRMLSceneNodeAdded(vtkMRMLScene* scene, vtkMRMLNode* node)
+{
+  if (!this->isNodeTypeListed(node))
+    {
+    return;
+    }
+  this->Superclass::onMRMLSceneNodeAdded(scene, node);
+}
+
+//------------------------------------------------------------------------------
+void qMRMLSceneClassModel::onMRMLSceneNodeAboutToBeRemoved(vtkMRMLScene* scene, vtkMRMLNode* node)
+{
+  if (!this->isNodeTypeListed(node))
+    {
+    return;
+    }
+  this->Superclass::onMRMLSceneNodeAboutToBeRemoved(scene, node);
+}
+
+//------------------------------------------------------------------------------
+void qMRMLSceneClassModel::onMRMLSceneNodeRemoved(vtkMRMLScene* scene, vtkMRMLNode* node)
+{
+  if (!this->isNodeTypeListed(node))
+    {
+    return;
+    }
+  this->Superclass::onMRMLSceneNodeRemoved(scene, node);
+}
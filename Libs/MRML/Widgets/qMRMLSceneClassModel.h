@@ -0,0 +1,77 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __qMRMLSceneClassModel_h
+#define __qMRMLSceneClassModel_h
+
+// qMRML includes
+#include "qMRMLSceneModel.h"
+
+// STD includes
+#include <vector>
+
+class qMRMLSceneClassModelPrivate;
+
+/// \brief Scene model that only contains nodes of a given set of classes.
+///
+/// Unlike qMRMLSortFilterProxyModel, which filters all the nodes of a complete
+/// scene model, this model does not create items for nodes that are not of
+/// the listed node types and ignores scene events of such nodes.
+/// Nodes of the listed types are retrieved using the class index of the scene.
+/// It is the default scene model of qMRMLNodeComboBox.
+/// \sa qMRMLNodeComboBox::nodeTypes
+class QMRML_WIDGETS_EXPORT qMRMLSceneClassModel : public qMRMLSceneModel
+{
+  Q_OBJECT
+  /// Class names of the nodes that are in the model. Nodes that are
+  /// derived from the listed classes are included as well.
+  /// If empty (default), then all the nodes of the scene are in the model.
+  Q_PROPERTY(QStringList nodeTypes READ nodeTypes WRITE setNodeTypes)
+
+public:
+  typedef qMRMLSceneModel Superclass;
+  qMRMLSceneClassModel(QObject *parent=nullptr);
+  ~qMRMLSceneClassModel() override;
+
+  QStringList nodeTypes()const;
+  void setNodeTypes(const QStringList& nodeTypes);
+
+  /// Returns true if the node is of one of the listed node types
+  /// (or if no node types are listed).
+  bool isNodeTypeListed(vtkMRMLNode* node)const;
+
+  int nodeIndex(vtkMRMLNode* node)const override;
+
+protected slots:
+  void onMRMLSceneNodeAboutToBeRemoved(vtkMRMLScene* scene, vtkMRMLNode* node) override;
+  void onMRMLSceneNodeAdded(vtkMRMLScene* scene, vtkMRMLNode* node) override;
+  void onMRMLSceneNodeRemoved(vtkMRMLScene* scene, vtkMRMLNode* node) override;
+
+protected:
+  void populateScene() override;
+
+  /// Get the listed nodes in scene order
+  void listedNodes(std::vector<vtkMRMLNode*>& nodes)const;
+
+  QScopedPointer<qMRMLSceneClassModelPrivate> d_ptr;
+
+private:
+  Q_DECLARE_PRIVATE(qMRMLSceneClassModel);
+  Q_DISABLE_COPY(qMRMLSceneClassModel);
+};
+
+#endif
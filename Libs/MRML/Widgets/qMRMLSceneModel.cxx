@@ -120,6 +120,23 @@ QModelIndexList qMRMLSceneModelPrivate::indexes(const QString& nodeID)const
   return nodeIndexes;
 }
 
+//------------------------------------------------------------------------------
+void qMRMLSceneModelPrivate::updatePendingModifiedNodes()
+{
+  Q_Q(qMRMLSceneModel);
+  QList<vtkWeakPointer<vtkMRMLNode> > modifiedNodes = this->PendingModifiedNodes.values();
+  this->PendingModifiedNodes.clear();
+  foreach(vtkMRMLNode* node, modifiedNodes)
+    {
+    // Skip nodes that have been deleted or removed from the scene since they were modified
+    if (!node || node->GetScene() != this->MRMLScene || !q->indexFromNode(node).isValid())
+      {
+      continue;
+      }
+    q->updateNodeItems(node, QString(node->GetID()));
+    }
+}
+
 //------------------------------------------------------------------------------
 void qMRMLSceneModelPrivate::listenNodeModifiedEvent()
 {
@@ -363,6 +380,7 @@ void qMRMLSceneModel::setMRMLScene(vtkMRMLScene* scene)
     {
     scene->AddObserver(vtkMRMLScene::NodeAboutToBeAddedEvent, d->CallBack, -10.);
     scene->AddObserver(vtkMRMLScene::NodeAddedEvent, d->CallBack, 10.);
+    scene->AddObserver(vtkMRMLScene::NodesAddedEvent, d->CallBack, 10.);
     scene->AddObserver(vtkMRMLScene::NodeAboutToBeRemovedEvent, d->CallBack, -10.);
     scene->AddObserver(vtkMRMLScene::NodeRemovedEvent, d->CallBack, 10.);
     scene->AddObserver(vtkCommand::DeleteEvent, d->CallBack);
@@ -514,8 +532,21 @@ QModelIndex qMRMLSceneModel::indexFromNode(vtkMRMLNode* node, int column)const
 //------------------------------------------------------------------------------
 QModelIndexList qMRMLSceneModel::indexes(vtkMRMLNode* node)const
 {
-  Q_D(const qMRMLSceneModel);
-  return d->indexes(QString(node->GetID()));
+  // Use the row cache of indexFromNode() instead of browsing through the whole model
+  QModelIndexList nodeIndexes;
+  QModelIndex nodeIndex = this->indexFromNode(node);
+  if (!nodeIndex.isValid())
+    {
+    return nodeIndexes;
+    }
+  const int row = nodeIndex.row();
+  QModelIndex nodeParentIndex = nodeIndex.parent();
+  const int columnCount = this->columnCount(nodeParentIndex);
+  for (int column = 0; column < columnCount; ++column)
+    {
+    nodeIndexes << this->index(row, column, nodeParentIndex);
+    }
+  return nodeIndexes;
 }
 
 //------------------------------------------------------------------------------
@@ -717,6 +748,7 @@ void qMRMLSceneModel::updateScene()
                  this, SLOT(onMRMLNodeIDChanged(vtkObject*,void*)));
 
   d->RowCache.clear();
+  d->PendingModifiedNodes.clear();
 
   // Enabled so it can be interacted with
   this->invisibleRootItem()->setFlags(Qt::ItemIsEnabled);
@@ -1154,8 +1186,16 @@ void qMRMLSceneModel::onMRMLSceneEvent(vtkObject* vtk_obj, unsigned long event,
       break;
     case vtkMRMLScene::NodeAddedEvent:
       Q_ASSERT(node);
+      if (scene->IsAddingNodes())
+        {
+        // nodes added by vtkMRMLScene::AddNodes() are processed at once
+        break;
+        }
       sceneModel->onMRMLSceneNodeAdded(scene, node);
       break;
+    case vtkMRMLScene::NodesAddedEvent:
+      sceneModel->onMRMLSceneNodesAdded(scene, reinterpret_cast<vtkCollection*>(call_data));
+      break;
     case vtkMRMLScene::NodeAboutToBeRemovedEvent:
       Q_ASSERT(node);
       sceneModel->onMRMLSceneNodeAboutToBeRemoved(scene, node);
@@ -1218,6 +1258,25 @@ void qMRMLSceneModel::onMRMLSceneNodeAdded(vtkMRMLScene* scene, vtkMRMLNode* nod
   this->insertNode(node);
 }
 
+//------------------------------------------------------------------------------
+void qMRMLSceneModel::onMRMLSceneNodesAdded(vtkMRMLScene* scene, vtkCollection* nodes)
+{
+  if (!nodes)
+    {
+    return;
+    }
+  vtkObject* object = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (nodes->InitTraversal(it); (object = nodes->GetNextItemAsObject(it)) ;)
+    {
+    vtkMRMLNode* node = vtkMRMLNode::SafeDownCast(object);
+    if (node)
+      {
+      this->onMRMLSceneNodeAdded(scene, node);
+      }
+    }
+}
+
 //------------------------------------------------------------------------------
 void qMRMLSceneModel::onMRMLSceneNodeAboutToBeRemoved(vtkMRMLScene* scene, vtkMRMLNode* node)
 {
@@ -1245,14 +1304,13 @@ void qMRMLSceneModel::onMRMLSceneNodeAboutToBeRemoved(vtkMRMLScene* scene, vtkMR
   Q_UNUSED(connectionsRemoved);
   // Remove all the observations on the node
   qvtkDisconnect(node, vtkCommand::NoEvent, this, nullptr);
+  d->PendingModifiedNodes.remove(node);
 
-  // TODO: can be fasten by browsing the tree only once
-  QModelIndexList indexes = this->match(this->mrmlSceneIndex(), qMRMLSceneModel::UIDRole,
-                                        QString(node->GetID()), 1,
-                                        Qt::MatchExactly | Qt::MatchRecursive);
-  if (indexes.count())
+  QModelIndex index = this->indexFromNode(node);
+  d->RowCache.remove(node);
+  if (index.isValid())
     {
-    QStandardItem* item = this->itemFromIndex(indexes[0].sibling(indexes[0].row(),0));
+    QStandardItem* item = this->itemFromIndex(index);
     // The children may be lost if not reparented, we ensure they got reparented.
     while (item->rowCount())
       {
@@ -1269,7 +1327,7 @@ void qMRMLSceneModel::onMRMLSceneNodeAboutToBeRemoved(vtkMRMLScene* scene, vtkMR
         d->Orphans.removeAll(orphans);
         }
       }
-    this->removeRow(indexes[0].row(), indexes[0].parent());
+    this->removeRow(index.row(), index.parent());
     }
 }
 
@@ -1362,7 +1420,15 @@ void qMRMLSceneModel::updateNodeItems()
 //------------------------------------------------------------------------------
 void qMRMLSceneModel::onMRMLNodeModified(vtkObject* node)
 {
+  Q_D(qMRMLSceneModel);
   vtkMRMLNode* modifiedNode = vtkMRMLNode::SafeDownCast(node);
+  if (d->MRMLScene && d->MRMLScene->IsBatchProcessing() && !d->LazyUpdate && modifiedNode)
+    {
+    // Nodes are often modified many times during batch processing, update
+    // their items only once when batch processing is completed.
+    d->PendingModifiedNodes[modifiedNode] = modifiedNode;
+    return;
+    }
   this->updateNodeItems(modifiedNode, QString(modifiedNode->GetID()));
 }
 
@@ -1395,7 +1461,8 @@ void qMRMLSceneModel::updateNodeItems(vtkMRMLNode* node, const QString& nodeUID)
     return;
     }
   //Q_ASSERT(node->GetScene()->IsNodePresent(node));
-  QModelIndexList nodeIndexes = d->indexes(nodeUID);
+  // If the node ID has not changed then the row cache can be used to find the items quickly
+  QModelIndexList nodeIndexes = (nodeUID == QString(node->GetID())) ? this->indexes(node) : d->indexes(nodeUID);
   //qDebug() << "onMRMLNodeModified" << node->GetID() << nodeIndexes;
   Q_ASSERT(nodeIndexes.count());
   for (int i = 0; i < nodeIndexes.size(); ++i)
@@ -1541,6 +1608,10 @@ void qMRMLSceneModel::onMRMLSceneEndBatchProcess(vtkMRMLScene* scene)
     this->updateScene();
     emit sceneUpdated();
     }
+  else
+    {
+    d->updatePendingModifiedNodes();
+    }
 }
 
 //------------------------------------------------------------------------------
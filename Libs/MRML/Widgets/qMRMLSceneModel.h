@@ -31,6 +31,7 @@
 // qMRML includes
 #include "qMRMLWidgetsExport.h"
 
+class vtkCollection;
 class vtkMRMLNode;
 class vtkMRMLScene;
 
@@ -222,6 +223,9 @@ protected slots:
   virtual void onMRMLSceneNodeAboutToBeAdded(vtkMRMLScene* scene, vtkMRMLNode* node);
   virtual void onMRMLSceneNodeAboutToBeRemoved(vtkMRMLScene* scene, vtkMRMLNode* node);
   virtual void onMRMLSceneNodeAdded(vtkMRMLScene* scene, vtkMRMLNode* node);
+  /// Called once when nodes are added using vtkMRMLScene::AddNodes().
+  /// Default implementation calls onMRMLSceneNodeAdded() for each node.
+  virtual void onMRMLSceneNodesAdded(vtkMRMLScene* scene, vtkCollection* nodes);
   virtual void onMRMLSceneNodeRemoved(vtkMRMLScene* scene, vtkMRMLNode* node);
 
   virtual void onMRMLSceneAboutToBeImported(vtkMRMLScene* scene);
@@ -35,6 +35,7 @@
 // Qt includes
 class QStandardItemModel;
 #include <QFlags>
+#include <QHash>
 #include <QMap>
 
 // qMRML includes
@@ -78,10 +79,16 @@ public:
   /// qMRMLSceneModel::nodeIndex(vtkMRMLNode*).
   QStandardItem* insertNode(vtkMRMLNode* node, int index);
 
+  /// Update items of the nodes that have been modified during batch processing
+  void updatePendingModifiedNodes();
+
   vtkSmartPointer<vtkCallbackCommand> CallBack;
   qMRMLSceneModel::NodeTypes ListenNodeModifiedEvent;
   bool LazyUpdate;
   int PendingItemModified;
+  // Nodes that have been modified during batch processing. Their items are
+  // updated only once, when batch processing ends.
+  QHash<vtkMRMLNode*, vtkWeakPointer<vtkMRMLNode> > PendingModifiedNodes;
 
   int NameColumn;
   int IDColumn;
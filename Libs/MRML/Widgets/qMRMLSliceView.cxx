@@ -23,8 +23,11 @@
 #include <QDropEvent>
 #include <QEvent>
 #include <QFileInfo>
+#include <QGuiApplication>
 #include <QHBoxLayout>
 #include <QMimeData>
+#include <QScreen>
+#include <QShowEvent>
 #include <QToolButton>
 #include <QUrl>
 
@@ -131,6 +134,8 @@ qMRMLSliceViewPrivate::qMRMLSliceViewPrivate(qMRMLSliceView& object)
   : q_ptr(&object)
 {
   this->DisplayableManagerGroup = nullptr;
+  this->DisplayableManagersInstantiated = false;
+  this->RenderCount = 0;
   this->MRMLScene = nullptr;
   this->MRMLSliceNode = nullptr;
   this->InactiveBoxColor = QColor(95, 95, 113);
@@ -155,6 +160,15 @@ void qMRMLSliceViewPrivate::init()
 {
   Q_Q(qMRMLSliceView);
 
+  // Render requests are coalesced into at most one render per refresh of the screen
+  QScreen* screen = QGuiApplication::primaryScreen();
+  if (screen && screen->refreshRate() > 0.)
+    {
+    q->setMaximumUpdateRate(screen->refreshRate());
+    }
+  this->qvtkConnect(q->renderWindow(), vtkCommand::EndEvent,
+                    this, SLOT(onRenderEnded()));
+
   // Highlight first RenderWindowItem
   q->setHighlightedBoxColor(this->InactiveBoxColor);
 
@@ -200,9 +214,8 @@ void qMRMLSliceViewPrivate::initDisplayableManagers()
       }
     }
 
-  this->DisplayableManagerGroup
-    = factory->InstantiateDisplayableManagers(
-      q->lightBoxRendererManager()->GetRenderer(0));
+  // The group is empty until the view is shown, see instantiateDisplayableManagers()
+  this->DisplayableManagerGroup = vtkMRMLDisplayableManagerGroup::New();
   // Observe displayable manager group to catch RequestRender events
   q->qvtkConnect(this->DisplayableManagerGroup, vtkCommand::UpdateEvent,
                  q, SLOT(scheduleRender()));
@@ -212,6 +225,23 @@ void qMRMLSliceViewPrivate::initDisplayableManagers()
 
 }
 
+//---------------------------------------------------------------------------
+void qMRMLSliceViewPrivate::instantiateDisplayableManagers()
+{
+  Q_Q(qMRMLSliceView);
+  if (this->DisplayableManagersInstantiated)
+    {
+    return;
+    }
+  this->DisplayableManagersInstantiated = true;
+  // The lightbox proxy and the slice node that are already set on the group
+  // are passed to the displayable managers when they are added.
+  this->DisplayableManagerGroup->Initialize(
+    vtkMRMLSliceViewDisplayableManagerFactory::GetInstance(),
+    q->lightBoxRendererManager()->GetRenderer(0));
+  q->scheduleRender();
+}
+
 //---------------------------------------------------------------------------
 void qMRMLSliceViewPrivate::setMRMLScene(vtkMRMLScene* newScene)
 {
@@ -248,6 +278,12 @@ void qMRMLSliceViewPrivate::onSceneEndProcessing()
   q->setRenderEnabled(true);
 }
 
+// --------------------------------------------------------------------------
+void qMRMLSliceViewPrivate::onRenderEnded()
+{
+  ++this->RenderCount;
+}
+
 // --------------------------------------------------------------------------
 void qMRMLSliceViewPrivate::updateWidgetFromMRML()
 {
@@ -288,6 +324,7 @@ void qMRMLSliceView::addDisplayableManager(const QString& displayableManagerName
   displayableManager.TakeReference(
     vtkMRMLDisplayableManagerGroup::InstantiateDisplayableManager(
       displayableManagerName.toUtf8()));
+  d->instantiateDisplayableManagers();
   d->DisplayableManagerGroup->AddDisplayableManager(displayableManager);
 }
 
@@ -300,6 +337,7 @@ void qMRMLSliceView::getDisplayableManagers(vtkCollection *displayableManagers)
     {
     return;
     }
+  d->instantiateDisplayableManagers();
   int num = d->DisplayableManagerGroup->GetDisplayableManagerCount();
   for (int n = 0; n < num; n++)
     {
@@ -311,6 +349,7 @@ void qMRMLSliceView::getDisplayableManagers(vtkCollection *displayableManagers)
 vtkMRMLAbstractDisplayableManager* qMRMLSliceView::displayableManagerByClassName(const char* className)
 {
   Q_D(qMRMLSliceView);
+  d->instantiateDisplayableManagers();
   return d->DisplayableManagerGroup->GetDisplayableManagerByClassName(className);
 }
 
@@ -366,6 +405,7 @@ vtkMRMLSliceViewInteractorStyle* qMRMLSliceView::sliceViewInteractorStyle()const
 QList<double> qMRMLSliceView::convertDeviceToXYZ(const QList<int>& xy)const
 {
   Q_D(const qMRMLSliceView);
+  const_cast<qMRMLSliceViewPrivate*>(d)->instantiateDisplayableManagers();
 
   // Grab a displayable manager that is derived from
   // AbstractSliceViewDisplayableManager, like the CrosshairDisplayableManager
@@ -391,6 +431,7 @@ QList<double> qMRMLSliceView::convertDeviceToXYZ(const QList<int>& xy)const
 QList<double> qMRMLSliceView::convertRASToXYZ(const QList<double>& ras)const
 {
   Q_D(const qMRMLSliceView);
+  const_cast<qMRMLSliceViewPrivate*>(d)->instantiateDisplayableManagers();
 
   // Grab a displayable manager that is derived from
   // AbstractSliceViewDisplayableManager, like the CrosshairDisplayableManager
@@ -417,6 +458,7 @@ QList<double> qMRMLSliceView::convertRASToXYZ(const QList<double>& ras)const
 QList<double> qMRMLSliceView::convertXYZToRAS(const QList<double>& xyz)const
 {
   Q_D(const qMRMLSliceView);
+  const_cast<qMRMLSliceViewPrivate*>(d)->instantiateDisplayableManagers();
 
   // Grab a displayable manager that is derived from
   // AbstractSliceViewDisplayableManager, like the CrosshairDisplayableManager
@@ -470,6 +512,42 @@ void qMRMLSliceView::setDefaultViewCursor(const QCursor &cursor)
     }
 }
 
+//------------------------------------------------------------------------------
+QVariantMap qMRMLSliceView::renderStatistics()const
+{
+  Q_D(const qMRMLSliceView);
+  int requestCount = d->DisplayableManagerGroup->GetRenderRequestCount();
+  QVariantMap requestCountByDisplayableManager;
+  for (int n = 0; n < d->DisplayableManagerGroup->GetDisplayableManagerCount(); ++n)
+    {
+    const char* className = d->DisplayableManagerGroup->GetNthDisplayableManager(n)->GetClassName();
+    requestCountByDisplayableManager[className] =
+      d->DisplayableManagerGroup->GetRenderRequestCountByClassName(className);
+    }
+  QVariantMap statistics;
+  statistics["requestCount"] = requestCount;
+  statistics["renderCount"] = d->RenderCount;
+  statistics["coalescedRequestCount"] = qMax(0, requestCount - d->RenderCount);
+  statistics["requestCountByDisplayableManager"] = requestCountByDisplayableManager;
+  return statistics;
+}
+
+//------------------------------------------------------------------------------
+void qMRMLSliceView::resetRenderStatistics()
+{
+  Q_D(qMRMLSliceView);
+  d->DisplayableManagerGroup->ResetRenderRequestCounts();
+  d->RenderCount = 0;
+}
+
+//---------------------------------------------------------------------------
+void qMRMLSliceView::showEvent(QShowEvent* event)
+{
+  Q_D(qMRMLSliceView);
+  d->instantiateDisplayableManagers();
+  this->Superclass::showEvent(event);
+}
+
 //---------------------------------------------------------------------------
 void qMRMLSliceView::dragEnterEvent(QDragEnterEvent* event)
 {
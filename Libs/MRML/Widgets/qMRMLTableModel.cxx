@@ -22,6 +22,7 @@
 
 // Qt includes
 #include <QApplication>
+#include <QFont>
 #include <QPalette>
 
 // qMRML includes
@@ -56,11 +57,23 @@ public:
   static QString columnNameFromIndex(int index);
 
   // Generate tooltip text
-  QString columnTooltipText(int tableCol);
+  QString columnTooltipText(int tableCol)const;
+
+  // Returns the table of the table node, nullptr if there is no table
+  vtkTable* table()const;
 
   vtkSmartPointer<vtkCallbackCommand> CallBack;
   vtkSmartPointer<vtkMRMLTableNode>   MRMLTableNode;
   bool Transposed;
+
+  // Number of rows and columns of the model at the last update from MRML.
+  // Views are notified of changes in the table dimensions only in updateModelFromMRML().
+  int RowCount;
+  int ColumnCount;
+
+  // Set while the model modifies the table. The modified cell is updated in the views
+  // by dataChanged, therefore the entire model does not need to be updated.
+  bool UpdatingMRMLFromModel;
 };
 
 //------------------------------------------------------------------------------
@@ -69,6 +82,9 @@ qMRMLTableModelPrivate::qMRMLTableModelPrivate(qMRMLTableModel& object)
 {
   this->CallBack = vtkSmartPointer<vtkCallbackCommand>::New();
   this->Transposed = false;
+  this->RowCount = 0;
+  this->ColumnCount = 0;
+  this->UpdatingMRMLFromModel = false;
 }
 
 //------------------------------------------------------------------------------
@@ -86,8 +102,6 @@ void qMRMLTableModelPrivate::init()
   Q_Q(qMRMLTableModel);
   this->CallBack->SetClientData(q);
   this->CallBack->SetCallback(qMRMLTableModel::onMRMLNodeEvent);
-  q->setColumnCount(0);
-  QObject::connect(q, SIGNAL(itemChanged(QStandardItem*)), q, SLOT(onItemChanged(QStandardItem*)), Qt::UniqueConnection);
 }
 
 //------------------------------------------------------------------------------
@@ -104,9 +118,9 @@ QString qMRMLTableModelPrivate::columnNameFromIndex(int index)
 }
 
 //------------------------------------------------------------------------------
-QString qMRMLTableModelPrivate::columnTooltipText(int tableCol)
+QString qMRMLTableModelPrivate::columnTooltipText(int tableCol)const
 {
-  Q_Q(qMRMLTableModel);
+  Q_Q(const qMRMLTableModel);
   vtkMRMLTableNode* tableNode = q->mrmlTableNode();
   if (tableNode == nullptr)
     {
@@ -141,11 +155,17 @@ QString qMRMLTableModelPrivate::columnTooltipText(int tableCol)
   return textLines.join("<p>");
 }
 
+//------------------------------------------------------------------------------
+vtkTable* qMRMLTableModelPrivate::table()const
+{
+  return (this->MRMLTableNode ? this->MRMLTableNode->GetTable() : nullptr);
+}
+
 //------------------------------------------------------------------------------
 // qMRMLTableModel
 //------------------------------------------------------------------------------
 qMRMLTableModel::qMRMLTableModel(QObject *_parent)
-  : QStandardItemModel(_parent)
+  : QAbstractTableModel(_parent)
   , d_ptr(new qMRMLTableModelPrivate(*this))
 {
   Q_D(qMRMLTableModel);
@@ -154,7 +174,7 @@ qMRMLTableModel::qMRMLTableModel(QObject *_parent)
 
 //------------------------------------------------------------------------------
 qMRMLTableModel::qMRMLTableModel(qMRMLTableModelPrivate* pimpl, QObject *parentObject)
-  : QStandardItemModel(parentObject)
+  : QAbstractTableModel(parentObject)
   , d_ptr(pimpl)
 {
   Q_D(qMRMLTableModel);
@@ -176,7 +196,12 @@ void qMRMLTableModel::setMRMLTableNode(vtkMRMLTableNode* tableNode)
     {
     tableNode->AddObserver(vtkCommand::ModifiedEvent, d->CallBack);
     }
+  // Contents of another table is shown, so views are reset instead of updating rows and columns
+  this->beginResetModel();
   d->MRMLTableNode = tableNode;
+  d->RowCount = 0;
+  d->ColumnCount = 0;
+  this->endResetModel();
   this->updateModelFromMRML();
 }
 
@@ -192,274 +217,249 @@ void qMRMLTableModel::updateModelFromMRML()
 {
   Q_D(qMRMLTableModel);
 
-  QObject::disconnect(this, SIGNAL(itemChanged(QStandardItem*)), this, SLOT(onItemChanged(QStandardItem*)));
+  // Cells are not stored in the model, they are read from the table when the
+  // views request them, therefore only the dimensions need to be updated here.
+  int rowCount = 0;
+  int columnCount = 0;
+  vtkTable* table = d->table();
+  if (table != nullptr && table->GetNumberOfColumns() > 0)
+    {
+    // offset: modelIndex = mrmlIndex - offset
+    vtkIdType tableColOffset = d->MRMLTableNode->GetUseFirstColumnAsRowHeader() ? 1 : 0;
+    vtkIdType tableRowOffset = d->MRMLTableNode->GetUseColumnNameAsColumnHeader() ? 0 : -1;
+    int numberOfModelTableRows = static_cast<int>(table->GetNumberOfRows() - tableRowOffset);
+    int numberOfModelTableColumns = static_cast<int>(table->GetNumberOfColumns() - tableColOffset);
+    rowCount = d->Transposed ? numberOfModelTableColumns : numberOfModelTableRows;
+    columnCount = d->Transposed ? numberOfModelTableRows : numberOfModelTableColumns;
+    }
+
+  // Add or remove rows and columns at the end, as QStandardItemModel::setRowCount() did,
+  // so that the selection and current index of the views are preserved.
+  if (rowCount > d->RowCount)
+    {
+    this->beginInsertRows(QModelIndex(), d->RowCount, rowCount - 1);
+    d->RowCount = rowCount;
+    this->endInsertRows();
+    }
+  else if (rowCount < d->RowCount)
+    {
+    this->beginRemoveRows(QModelIndex(), rowCount, d->RowCount - 1);
+    d->RowCount = rowCount;
+    this->endRemoveRows();
+    }
+  if (columnCount > d->ColumnCount)
+    {
+    this->beginInsertColumns(QModelIndex(), d->ColumnCount, columnCount - 1);
+    d->ColumnCount = columnCount;
+    this->endInsertColumns();
+    }
+  else if (columnCount < d->ColumnCount)
+    {
+    this->beginRemoveColumns(QModelIndex(), columnCount, d->ColumnCount - 1);
+    d->ColumnCount = columnCount;
+    this->endRemoveColumns();
+    }
 
-  vtkMRMLTableNode* tableNode = vtkMRMLTableNode::SafeDownCast(d->MRMLTableNode);
-  vtkTable* table = (tableNode ? tableNode->GetTable() : nullptr);
-  if (table==nullptr || table->GetNumberOfColumns()==0)
+  // Views only request the data of the visible cells again
+  if (d->RowCount > 0 && d->ColumnCount > 0)
     {
-    beginResetModel();
-    // setRowCount and setColumnCount to 0 would not be enough, it's necessary to remove the header as well
-    setRowCount(0);
-    setColumnCount(0);
-    endResetModel();
-    QObject::connect(this, SIGNAL(itemChanged(QStandardItem*)), this, SLOT(onItemChanged(QStandardItem*)), Qt::UniqueConnection);
-    return;
+    emit dataChanged(this->index(0, 0), this->index(d->RowCount - 1, d->ColumnCount - 1));
+    emit headerDataChanged(Qt::Horizontal, 0, d->ColumnCount - 1);
+    emit headerDataChanged(Qt::Vertical, 0, d->RowCount - 1);
     }
+}
 
-  bool tableLocked = tableNode->GetLocked();
-  bool labelInFirstTableColumn = tableNode->GetUseFirstColumnAsRowHeader();
-  bool useColumnNameAsColumnHeader = tableNode->GetUseColumnNameAsColumnHeader();
+//------------------------------------------------------------------------------
+int qMRMLTableModel::rowCount(const QModelIndex& parent)const
+{
+  Q_D(const qMRMLTableModel);
+  return parent.isValid() ? 0 : d->RowCount;
+}
 
-  vtkIdType numberOfTableColumns = table->GetNumberOfColumns();
-  vtkIdType numberOfTableRows = table->GetNumberOfRows();
-  // offset: modelIndex = mrmlIndex - offset
-  vtkIdType tableColOffset = labelInFirstTableColumn ? 1 : 0;
-  vtkIdType tableRowOffset = useColumnNameAsColumnHeader ? 0 : -1;
-  if (d->Transposed)
+//------------------------------------------------------------------------------
+int qMRMLTableModel::columnCount(const QModelIndex& parent)const
+{
+  Q_D(const qMRMLTableModel);
+  return parent.isValid() ? 0 : d->ColumnCount;
+}
+
+//------------------------------------------------------------------------------
+QVariant qMRMLTableModel::data(const QModelIndex& index, int role)const
+{
+  Q_D(const qMRMLTableModel);
+  vtkTable* table = d->table();
+  if (!index.isValid() || table == nullptr)
     {
-    setRowCount(static_cast<int>(numberOfTableColumns-tableColOffset));
-    setColumnCount(static_cast<int>(numberOfTableRows-tableRowOffset));
+    return QVariant();
     }
-  else
+  int tableRow = this->mrmlTableRowIndex(index);
+  int tableCol = this->mrmlTableColumnIndex(index);
+  if (tableCol < 0 || tableCol >= table->GetNumberOfColumns() || tableRow >= table->GetNumberOfRows())
     {
-    setRowCount(static_cast<int>(numberOfTableRows-tableRowOffset));
-    setColumnCount(static_cast<int>(numberOfTableColumns-tableColOffset));
+    // the table has been changed since the last update of the model
+    return QVariant();
     }
 
-  // Setup items for each table column
-  for (vtkIdType tableCol = tableColOffset; tableCol < numberOfTableColumns; ++tableCol)
+  if (role == Qt::ToolTipRole)
     {
-    int modelCol = static_cast<int>(tableCol - tableColOffset);
-
-    QString columnName(table->GetColumnName(tableCol));
-    vtkAbstractArray* columnArray = table->GetColumn(tableCol);
+    return d->columnTooltipText(tableCol);
+    }
 
-    if (useColumnNameAsColumnHeader)
+  if (tableRow < 0)
+    {
+    // Column names are displayed in the first row, using bold font
+    if (role == Qt::DisplayRole || role == Qt::EditRole)
       {
-      setHeaderData(modelCol, d->Transposed ? Qt::Vertical : Qt::Horizontal, columnName);
+      return QString(table->GetColumnName(tableCol));
       }
-    else
+    if (role == Qt::FontRole)
       {
-      QString autoColumnHeader = d->columnNameFromIndex(modelCol);
-      setHeaderData(modelCol, d->Transposed ? Qt::Vertical : Qt::Horizontal, autoColumnHeader);
+      QFont font;
+      font.setBold(true);
+      return font;
       }
+    return QVariant();
+    }
 
-    // Go through the rows of the current column
-    for (vtkIdType tableRow = tableRowOffset; tableRow < numberOfTableRows; ++tableRow)
+  // Set item property for known types.
+  // Special types are defined to be displayed differently, handled by qMRMLTableItemDelegate.
+  // NOTE: The data type itself can be enough, but in future types it will be necessary to define display role
+  //       as well, e.g. double array can be both color and position.
+  vtkAbstractArray* columnArray = table->GetColumn(tableCol);
+  if (vtkBitArray::SafeDownCast(columnArray))
+    {
+    // Boolean values indicated by a column of vtkBitArray type are displayed as checkboxes,
+    // no text is supposed to be in the cell
+    if (role == Qt::CheckStateRole)
       {
-      int modelRow = static_cast<int>(tableRow - tableRowOffset);
-
-      // Use existing item if already created
-      QStandardItem* existingItem = nullptr;
-      if (d->Transposed)
-        {
-        existingItem = this->item(modelCol, modelRow);
-        }
-      else
-        {
-        existingItem = this->item(modelRow, modelCol);
-        }
-      QStandardItem* item = existingItem;
-      // Create item if did not exist
-      if (item==nullptr)
-        {
-        item = new QStandardItem();
-        }
-
-      // Items in first row use bold font, the others regular
-      if (tableRow>=0)
-        {
-        vtkVariant variant = table->GetValue(tableRow, tableCol);
-        if (tableRow==0)
-          {
-          // the first row might have been bold earlier, make sure
-          // it is reset to non-bold
-          QFont font;
-          item->setData(font, Qt::FontRole);
-          }
-
-        int dataType = columnArray->GetDataType();
-
-        // Set item property for known types.
-        // Special types are defined to be displayed differently, handled by qMRMLTableItemDelegate.
-        // NOTE: The data type itself can be enough, but in future types it will be necessary to define display role
-        //       as well, e.g. double array can be both color and position.
-        if (vtkBitArray::SafeDownCast(columnArray))
-          {
-          // Boolean values indicated by a column of vtkBitArray type are displayed as checkboxes
-          item->setData(VTK_BIT, UserRoleValueType);
-          item->setCheckable(true);
-          item->setCheckState(variant.ToInt() ? Qt::Checked : Qt::Unchecked);
-          item->setText(QString()); // No text is supposed to be in the cell
-          }
-        // Default display as text
-        else
-          {
-          if (dataType == VTK_CHAR || dataType == VTK_UNSIGNED_CHAR || dataType == VTK_SIGNED_CHAR)
-            {
-            // vtkVariant converts char type to string as a single letter, therefore we need to use
-            // custom converter
-            item->setText(QString::number(variant.ToInt()));
-            }
-          else
-            {
-            item->setText(QString(variant.ToString()));
-            }
-          item->setData(QVariant(), UserRoleValueType);
-          item->setCheckable(false);
-          item->setData(QVariant(), Qt::CheckStateRole);
-          }
-        }
-      else
-        {
-        item->setText(columnName);
-        QFont font;
-        font.setBold(true);
-        item->setData(font, Qt::FontRole);
-        }
-
-      // Handle locked flag
-      if (item->isCheckable())
-        {
-        if (tableLocked)
-          {
-          // Item is view-only, clear the ItemIsUserCheckable flag
-          item->setFlags(item->flags() & (~Qt::ItemIsUserCheckable));
-          }
-        else
-          {
-          // Item is editable, set the ItemIsUserCheckable flag
-          item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
-          }
-        // Item text is empty and should not be editable
-        item->setFlags(item->flags() & (~Qt::ItemIsEditable));
-        }
-      else
-        {
-        if (tableLocked)
-          {
-          // Item is view-only, clear the ItemIsEditable flag
-          item->setFlags(item->flags() & (~Qt::ItemIsEditable));
-          }
-        else
-          {
-          // Item is editable, set the ItemIsEditable flag
-          item->setFlags(item->flags() | Qt::ItemIsEditable);
-          }
-        }
-
-      // Add item if just created
-      if (item!=existingItem)
-        {
-        if (d->Transposed)
-          {
-          setItem(modelCol, modelRow, item);
-          }
-        else
-          {
-          setItem(modelRow, modelCol, item);
-          }
-        }
+      return static_cast<int>(table->GetValue(tableRow, tableCol).ToInt() ? Qt::Checked : Qt::Unchecked);
+      }
+    if (role == UserRoleValueType)
+      {
+      return VTK_BIT;
       }
+    return QVariant();
     }
-  // Set row label: either simply 1, 2, ... or values of the first column
-  for (vtkIdType tableRow = tableRowOffset; tableRow < numberOfTableRows; ++tableRow)
+
+  // Default display as text
+  if (role == Qt::DisplayRole || role == Qt::EditRole)
     {
-    int modelRow = static_cast<int>(tableRow - tableRowOffset);
-    QString rowLabel;
-    if(labelInFirstTableColumn)
+    vtkVariant variant = table->GetValue(tableRow, tableCol);
+    int dataType = columnArray->GetDataType();
+    if (dataType == VTK_CHAR || dataType == VTK_UNSIGNED_CHAR || dataType == VTK_SIGNED_CHAR)
       {
-      if (tableRow>=0)
-        {
-        rowLabel = QString(table->GetValue(tableRow, 0).ToString());
-        }
-      else
-        {
-        rowLabel = QString(table->GetColumnName(0));;
-        }
+      // vtkVariant converts char type to string as a single letter, therefore we need to use
+      // custom converter
+      return QString::number(variant.ToInt());
       }
-    else
+    return QString(variant.ToString());
+    }
+  return QVariant();
+}
+
+//------------------------------------------------------------------------------
+Qt::ItemFlags qMRMLTableModel::flags(const QModelIndex& index)const
+{
+  Q_D(const qMRMLTableModel);
+  Qt::ItemFlags itemFlags = this->Superclass::flags(index);
+  vtkTable* table = d->table();
+  if (!index.isValid() || table == nullptr || d->MRMLTableNode->GetLocked())
+    {
+    // Items are view-only
+    return itemFlags;
+    }
+  int tableRow = this->mrmlTableRowIndex(index);
+  int tableCol = this->mrmlTableColumnIndex(index);
+  if (tableRow >= 0 && vtkBitArray::SafeDownCast(table->GetColumn(tableCol)))
+    {
+    // Item text is empty and should not be editable
+    itemFlags |= Qt::ItemIsUserCheckable;
+    }
+  else
+    {
+    itemFlags |= Qt::ItemIsEditable;
+    }
+  return itemFlags;
+}
+
+//------------------------------------------------------------------------------
+QVariant qMRMLTableModel::headerData(int section, Qt::Orientation orientation, int role)const
+{
+  Q_D(const qMRMLTableModel);
+  vtkTable* table = d->table();
+  if (role != Qt::DisplayRole || table == nullptr || table->GetNumberOfColumns() == 0)
+    {
+    return this->Superclass::headerData(section, orientation, role);
+    }
+  bool labelInFirstTableColumn = d->MRMLTableNode->GetUseFirstColumnAsRowHeader();
+  bool useColumnNameAsColumnHeader = d->MRMLTableNode->GetUseColumnNameAsColumnHeader();
+  if ((orientation == Qt::Horizontal) != d->Transposed)
+    {
+    // Column header
+    vtkIdType tableCol = section + (labelInFirstTableColumn ? 1 : 0);
+    if (useColumnNameAsColumnHeader && tableCol < table->GetNumberOfColumns())
       {
-      rowLabel = QString::number(modelRow+1);
+      return QString(table->GetColumnName(tableCol));
       }
-    setHeaderData(modelRow, d->Transposed ? Qt::Horizontal : Qt::Vertical, rowLabel);
+    return qMRMLTableModelPrivate::columnNameFromIndex(section);
     }
-
-  // Add tooltip text
-  for (vtkIdType tableCol = tableColOffset; tableCol < numberOfTableColumns; ++tableCol)
+  else
     {
-    int modelCol = static_cast<int>(tableCol - tableColOffset);
-    QString tooltipText = d->columnTooltipText(tableCol);
-    for (vtkIdType tableRow = tableRowOffset; tableRow < numberOfTableRows; ++tableRow)
+    // Row label: either simply 1, 2, ... or values of the first column
+    if (labelInFirstTableColumn)
       {
-      int modelRow = static_cast<int>(tableRow - tableRowOffset);
-      QStandardItem* existingItem = nullptr;
-      if (d->Transposed)
+      vtkIdType tableRow = section - (useColumnNameAsColumnHeader ? 0 : 1);
+      if (tableRow < 0)
         {
-        existingItem = this->item(modelCol, modelRow);
+        return QString(table->GetColumnName(0));
         }
-      else
+      if (tableRow < table->GetNumberOfRows())
         {
-        existingItem = this->item(modelRow, modelCol);
+        return QString(table->GetValue(tableRow, 0).ToString());
         }
-      existingItem->setToolTip(tooltipText);
       }
+    return QString::number(section + 1);
     }
-
-  QObject::connect(this, SIGNAL(itemChanged(QStandardItem*)), this, SLOT(onItemChanged(QStandardItem*)), Qt::UniqueConnection);
 }
 
 //------------------------------------------------------------------------------
-void qMRMLTableModel::updateMRMLFromModel(QStandardItem* item)
+bool qMRMLTableModel::setData(const QModelIndex& index, const QVariant& value, int role)
 {
   Q_D(qMRMLTableModel);
-  if (item == nullptr)
-    {
-    qCritical("qMRMLTableModel::updateMRMLFromModel failed: item is invalid");
-    return;
-    }
-  vtkMRMLTableNode* tableNode = vtkMRMLTableNode::SafeDownCast(d->MRMLTableNode);
-  if (tableNode==nullptr)
+  vtkTable* table = d->table();
+  if (!index.isValid() || table == nullptr)
     {
-    qCritical("qMRMLTableModel::updateMRMLFromModel failed: tableNode is invalid");
-    return;
+    return false;
     }
-  vtkTable* table = tableNode->GetTable();
-  if (table==nullptr)
+  int tableRow = this->mrmlTableRowIndex(index);
+  int tableCol = this->mrmlTableColumnIndex(index);
+  if (tableCol < 0 || tableCol >= table->GetNumberOfColumns() || tableRow >= table->GetNumberOfRows())
     {
-    qCritical("qMRMLTableModel::updateMRMLFromModel failed: table is invalid");
-    return;
+    return false;
     }
 
-  int tableRow = mrmlTableRowIndex(item->index());
-  int tableCol = mrmlTableColumnIndex(item->index());
-
+  bool modified = false;
+  d->UpdatingMRMLFromModel = true;
   if (tableRow>=0)
     {
     // Get item value according to type
-    int widgetType = item->data(UserRoleValueType).toInt();
-    if (widgetType == VTK_BIT)
+    if (vtkBitArray::SafeDownCast(table->GetColumn(tableCol)))
       {
-      // Cell bool value changed
-      int checked = item->checkState();
-      int valueBefore = table->GetValue(tableRow, tableCol).ToInt();
-      if (checked == valueBefore)
-        {
-        // The value is not changed, this means that the table cannot store this value - revert the value in the table
-        this->blockSignals(true);
-        item->setCheckState(valueBefore ? Qt::Checked : Qt::Unchecked);
-        item->setText(QString()); // No text is supposed to be in the cell
-        this->blockSignals(false);
-        }
-      else
+      if (role == Qt::CheckStateRole)
         {
-        table->SetValue(tableRow, tableCol, vtkVariant(checked));
-        table->GetColumn(tableCol)->Modified(); // Enable observation of checked state changed separately
-        table->Modified();
+        // Cell bool value changed
+        int checked = (value.toInt() == Qt::Checked ? 1 : 0);
+        int valueBefore = table->GetValue(tableRow, tableCol).ToInt();
+        if (checked != valueBefore)
+          {
+          table->SetValue(tableRow, tableCol, vtkVariant(checked));
+          table->GetColumn(tableCol)->Modified(); // Enable observation of checked state changed separately
+          table->Modified();
+          modified = true;
+          }
         }
       }
-    else
+    else if (role == Qt::EditRole)
       {
       // Cell text value changed
       int dataType = table->GetColumn(tableCol)->GetDataType();
@@ -467,7 +467,7 @@ void qMRMLTableModel::updateMRMLFromModel(QStandardItem* item)
         {
         // vtkVariant would convert char to a letter, so we need custom conversion here
         bool valid = false;
-        int newValue = item->text().toInt(&valid);
+        int newValue = value.toString().toInt(&valid);
         if (dataType == VTK_UNSIGNED_CHAR)
           {
           if (newValue < VTK_UNSIGNED_CHAR_MIN || newValue > VTK_UNSIGNED_CHAR_MAX)
@@ -482,53 +482,55 @@ void qMRMLTableModel::updateMRMLFromModel(QStandardItem* item)
             valid = false;
             }
           }
-        if (valid)
+        if (valid && newValue != table->GetValue(tableRow, tableCol).ToInt())
           {
           table->SetValue(tableRow, tableCol, newValue);
           table->Modified();
-          }
-        else
-          {
-          vtkVariant valueInTableBefore = table->GetValue(tableRow, tableCol); // restore this value if new value is invalid
-          this->blockSignals(true);
-          item->setText(QString::number(valueInTableBefore.ToInt()));
-          this->blockSignals(false);
+          modified = true;
           }
         }
       else
         {
-        vtkVariant valueInTableBefore = table->GetValue(tableRow, tableCol); // restore this value if new value is invalid
-        vtkVariant itemText(item->text().toUtf8().constData()); // the vtkVariant constructor makes a copy of the input buffer, so using constData is safe
+        vtkVariant valueInTableBefore = table->GetValue(tableRow, tableCol);
+        vtkVariant itemText(value.toString().toUtf8().constData()); // the vtkVariant constructor makes a copy of the input buffer, so using constData is safe
         table->SetValue(tableRow, tableCol, itemText);
         vtkVariant valueInTableAfter = table->GetValue(tableRow, tableCol);
-        if (valueInTableBefore == valueInTableAfter)
-          {
-          // The value is not changed then it means it is invalid,
-          // restore previous value
-          this->blockSignals(true);
-          item->setText(QString(valueInTableBefore.ToString()));
-          this->blockSignals(false);
-          }
-        else
+        // If the value is not changed then it means it is invalid (or the same), the table keeps the previous value
+        if (!(valueInTableBefore == valueInTableAfter))
           {
           table->Modified();
+          modified = true;
           }
         }
       }
     }
-  else
+  else if (role == Qt::EditRole)
     {
     // Column header changed
     vtkAbstractArray* column = table->GetColumn(tableCol);
     if (column)
       {
       QString valueBefore = QString::fromStdString(column->GetName()?column->GetName():"");
-      if (valueBefore!=item->text())
+      if (valueBefore!=value.toString())
         {
-        tableNode->RenameColumn(tableCol, item->text().toUtf8().constData());
+        d->MRMLTableNode->RenameColumn(tableCol, value.toString().toUtf8().constData());
+        modified = true;
         }
       }
     }
+  d->UpdatingMRMLFromModel = false;
+
+  if (modified)
+    {
+    emit dataChanged(index, index);
+    if (tableRow < 0 || (tableCol == 0 && d->MRMLTableNode->GetUseFirstColumnAsRowHeader()))
+      {
+      // column name or row label may be displayed in headers
+      emit headerDataChanged(Qt::Horizontal, 0, d->ColumnCount - 1);
+      emit headerDataChanged(Qt::Vertical, 0, d->RowCount - 1);
+      }
+    }
+  return modified;
 }
 
 //-----------------------------------------------------------------------------
@@ -556,17 +558,12 @@ void qMRMLTableModel::onMRMLTableNodeModified(vtkObject* node)
   Q_UNUSED(tableNode);
   Q_UNUSED(d);
   Q_ASSERT(tableNode == d->MRMLTableNode);
-  this->updateModelFromMRML();
-}
-
-//------------------------------------------------------------------------------
-void qMRMLTableModel::onItemChanged(QStandardItem * item)
-{
-  if (item == this->invisibleRootItem())
+  if (d->UpdatingMRMLFromModel)
     {
+    // the views are notified of the modified cell by setData()
     return;
     }
-  this->updateMRMLFromModel(item);
+  this->updateModelFromMRML();
 }
 
 //------------------------------------------------------------------------------
@@ -24,7 +24,7 @@
 #define __qMRMLTableModel_h
 
 // Qt includes
-#include <QStandardItemModel>
+#include <QAbstractTableModel>
 
 // CTK includes
 #include <ctkPimpl.h>
@@ -40,7 +40,11 @@ class QAction;
 class qMRMLTableModelPrivate;
 
 //------------------------------------------------------------------------------
-class QMRML_WIDGETS_EXPORT qMRMLTableModel : public QStandardItemModel
+/// \brief Model to show and edit the content of a MRML table node.
+///
+/// Cell values are not copied into the model but read from the vtkTable when views
+/// request them, therefore only the visible cells are converted to text.
+class QMRML_WIDGETS_EXPORT qMRMLTableModel : public QAbstractTableModel
 {
   Q_OBJECT
   QVTK_OBJECT
@@ -48,7 +52,7 @@ class QMRML_WIDGETS_EXPORT qMRMLTableModel : public QStandardItemModel
   Q_PROPERTY(bool transposed READ transposed WRITE setTransposed)
 
 public:
-  typedef QAbstractItemModel Superclass;
+  typedef QAbstractTableModel Superclass;
   qMRMLTableModel(QObject *parent=nullptr);
   ~qMRMLTableModel() override;
 
@@ -64,12 +68,20 @@ public:
   void setTransposed(bool transposed);
   bool transposed()const;
 
-  /// Return the VTK table cell associated to the node index.
-  void updateMRMLFromModel(QStandardItem* item);
-
-  /// Update the entire table from the MRML node
+  /// Update the entire table from the MRML node.
+  /// Views are notified of added or removed rows and columns and that all the cells may have changed.
   void updateModelFromMRML();
 
+  int rowCount(const QModelIndex& parent = QModelIndex())const override;
+  int columnCount(const QModelIndex& parent = QModelIndex())const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole)const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole)const override;
+  Qt::ItemFlags flags(const QModelIndex& index)const override;
+
+  /// Set the value of the VTK table cell associated to the model index.
+  /// Only the modified cell is updated in the views.
+  bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+
   /// Get MRML table index from model index
   int mrmlTableRowIndex(QModelIndex modelIndex)const;
 
@@ -84,7 +96,6 @@ public:
 
 protected slots:
   void onMRMLTableNodeModified(vtkObject* node);
-  void onItemChanged(QStandardItem * item);
 
 protected:
 
@@ -331,14 +331,14 @@ void qMRMLTableView::copySelection()
         {
         textToCopy.append('\t');
         }
-      QStandardItem *item = mrmlModel->item(rowIndex, columnIndex);
-      if (item->isCheckable())
+      QModelIndex index = mrmlModel->index(rowIndex, columnIndex);
+      if (mrmlModel->data(index, Qt::CheckStateRole).isValid())
         {
-        textToCopy.append(item->checkState() == Qt::Checked ? "1" : "0");
+        textToCopy.append(mrmlModel->data(index, Qt::CheckStateRole).toInt() == Qt::Checked ? "1" : "0");
         }
       else
         {
-        textToCopy.append(item->text());
+        textToCopy.append(mrmlModel->data(index).toString());
         }
       }
     }
@@ -425,16 +425,16 @@ void qMRMLTableView::pasteSelection()
         mrmlModel->updateModelFromMRML();
         }
       // Set values in items
-      QStandardItem* item = mrmlModel->item(rowIndex,columnIndex);
-      if (item != nullptr)
+      QModelIndex index = mrmlModel->index(rowIndex, columnIndex);
+      if (index.isValid())
         {
-        if (item->isCheckable())
+        if (mrmlModel->data(index, Qt::CheckStateRole).isValid())
           {
-          item->setCheckState(cell.toInt() == 0 ? Qt::Unchecked : Qt::Checked);
+          mrmlModel->setData(index, cell.toInt() == 0 ? Qt::Unchecked : Qt::Checked, Qt::CheckStateRole);
           }
         else
           {
-          item->setText(cell);
+          mrmlModel->setData(index, cell, Qt::EditRole);
           }
         }
       else
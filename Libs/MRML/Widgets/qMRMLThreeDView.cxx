@@ -23,8 +23,11 @@
 #include <QDropEvent>
 #include <QEvent>
 #include <QFileInfo>
+#include <QGuiApplication>
 #include <QHBoxLayout>
 #include <QMimeData>
+#include <QScreen>
+#include <QShowEvent>
 #include <QToolButton>
 
 // CTK includes
@@ -54,6 +57,7 @@
 #include <vtkCollection.h>
 #include <vtkNew.h>
 #include <vtkRenderer.h>
+#include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
 #include <vtkSmartPointer.h>
 
@@ -65,6 +69,8 @@ qMRMLThreeDViewPrivate::qMRMLThreeDViewPrivate(qMRMLThreeDView& object)
   : q_ptr(&object)
 {
   this->DisplayableManagerGroup = nullptr;
+  this->DisplayableManagersInstantiated = false;
+  this->RenderCount = 0;
   this->MRMLScene = nullptr;
   this->MRMLViewNode = nullptr;
 }
@@ -82,6 +88,15 @@ qMRMLThreeDViewPrivate::~qMRMLThreeDViewPrivate()
 void qMRMLThreeDViewPrivate::init()
 {
   Q_Q(qMRMLThreeDView);
+
+  // Render requests are coalesced into at most one render per refresh of the screen
+  QScreen* screen = QGuiApplication::primaryScreen();
+  if (screen && screen->refreshRate() > 0.)
+    {
+    q->setMaximumUpdateRate(screen->refreshRate());
+    }
+  this->qvtkConnect(q->renderWindow(), vtkCommand::EndEvent,
+                    this, SLOT(onRenderEnded()));
   q->setRenderEnabled(this->MRMLScene != nullptr);
 
   vtkNew<vtkMRMLThreeDViewInteractorStyle> interactorStyle;
@@ -131,13 +146,29 @@ void qMRMLThreeDViewPrivate::initDisplayableManagers()
       }
     }
 
-  this->DisplayableManagerGroup
-    = factory->InstantiateDisplayableManagers(q->renderer());
+  // The group is empty until the view is shown, see instantiateDisplayableManagers()
+  this->DisplayableManagerGroup = vtkMRMLDisplayableManagerGroup::New();
   // Observe displayable manager group to catch RequestRender events
   this->qvtkConnect(this->DisplayableManagerGroup, vtkCommand::UpdateEvent,
                     q, SLOT(scheduleRender()));
 }
 
+//---------------------------------------------------------------------------
+void qMRMLThreeDViewPrivate::instantiateDisplayableManagers()
+{
+  Q_Q(qMRMLThreeDView);
+  if (this->DisplayableManagersInstantiated)
+    {
+    return;
+    }
+  this->DisplayableManagersInstantiated = true;
+  // The view node that is already set on the group is passed to the
+  // displayable managers when they are added.
+  this->DisplayableManagerGroup->Initialize(
+    vtkMRMLThreeDViewDisplayableManagerFactory::GetInstance(), q->renderer());
+  q->scheduleRender();
+}
+
 //---------------------------------------------------------------------------
 void qMRMLThreeDViewPrivate::setMRMLScene(vtkMRMLScene* newScene)
 {
@@ -177,6 +208,12 @@ void qMRMLThreeDViewPrivate::onSceneEndProcessing()
   q->setRenderEnabled(true);
 }
 
+// --------------------------------------------------------------------------
+void qMRMLThreeDViewPrivate::onRenderEnded()
+{
+  ++this->RenderCount;
+}
+
 // --------------------------------------------------------------------------
 void qMRMLThreeDViewPrivate::updateWidgetFromMRML()
 {
@@ -285,12 +322,16 @@ void qMRMLThreeDView::addDisplayableManager(const QString& displayableManagerNam
   displayableManager.TakeReference(
     vtkMRMLDisplayableManagerGroup::InstantiateDisplayableManager(
       displayableManagerName.toUtf8()));
+  d->instantiateDisplayableManagers();
   d->DisplayableManagerGroup->AddDisplayableManager(displayableManager);
 }
 
 //------------------------------------------------------------------------------
 vtkMRMLCameraNode* qMRMLThreeDView::cameraNode()
 {
+  Q_D(qMRMLThreeDView);
+  // The camera node of the interactor style is set by the camera displayable manager
+  d->instantiateDisplayableManagers();
   vtkMRMLThreeDViewInteractorStyle* style = vtkMRMLThreeDViewInteractorStyle::SafeDownCast(this->interactorStyle());
   if (!style)
     {
@@ -311,7 +352,7 @@ void qMRMLThreeDView::rotateToViewAxis(unsigned int axisId)
     return;
     }
 
-  vtkMRMLCameraNode* cam = style->GetCameraNode();
+  vtkMRMLCameraNode* cam = this->cameraNode();
   if (!cam)
     {
     qCritical() << "qMRMLThreeDView::rotateToViewAxis: can not retrieve camera node.";
@@ -380,7 +421,7 @@ void qMRMLThreeDView
     return;
     }
 
-  vtkMRMLCameraNode* cam = style->GetCameraNode();
+  vtkMRMLCameraNode* cam = this->cameraNode();
   if (!cam)
     {
     qCritical() << "qMRMLThreeDView::resetCamera: can not retrieve camera node.";
@@ -509,6 +550,7 @@ void qMRMLThreeDView::getDisplayableManagers(vtkCollection *displayableManagers)
     {
     return;
     }
+  d->instantiateDisplayableManagers();
   int num = d->DisplayableManagerGroup->GetDisplayableManagerCount();
   for (int n = 0; n < num; n++)
     {
@@ -520,6 +562,7 @@ void qMRMLThreeDView::getDisplayableManagers(vtkCollection *displayableManagers)
 vtkMRMLAbstractDisplayableManager* qMRMLThreeDView::displayableManagerByClassName(const char* className)
 {
   Q_D(qMRMLThreeDView);
+  d->instantiateDisplayableManagers();
   return d->DisplayableManagerGroup->GetDisplayableManagerByClassName(className);
 }
 
@@ -554,6 +597,42 @@ void qMRMLThreeDView::setDefaultViewCursor(const QCursor &cursor)
     }
 }
 
+//------------------------------------------------------------------------------
+QVariantMap qMRMLThreeDView::renderStatistics()const
+{
+  Q_D(const qMRMLThreeDView);
+  int requestCount = d->DisplayableManagerGroup->GetRenderRequestCount();
+  QVariantMap requestCountByDisplayableManager;
+  for (int n = 0; n < d->DisplayableManagerGroup->GetDisplayableManagerCount(); ++n)
+    {
+    const char* className = d->DisplayableManagerGroup->GetNthDisplayableManager(n)->GetClassName();
+    requestCountByDisplayableManager[className] =
+      d->DisplayableManagerGroup->GetRenderRequestCountByClassName(className);
+    }
+  QVariantMap statistics;
+  statistics["requestCount"] = requestCount;
+  statistics["renderCount"] = d->RenderCount;
+  statistics["coalescedRequestCount"] = qMax(0, requestCount - d->RenderCount);
+  statistics["requestCountByDisplayableManager"] = requestCountByDisplayableManager;
+  return statistics;
+}
+
+//------------------------------------------------------------------------------
+void qMRMLThreeDView::resetRenderStatistics()
+{
+  Q_D(qMRMLThreeDView);
+  d->DisplayableManagerGroup->ResetRenderRequestCounts();
+  d->RenderCount = 0;
+}
+
+//---------------------------------------------------------------------------
+void qMRMLThreeDView::showEvent(QShowEvent* event)
+{
+  Q_D(qMRMLThreeDView);
+  d->instantiateDisplayableManagers();
+  this->Superclass::showEvent(event);
+}
+
 //---------------------------------------------------------------------------
 void qMRMLThreeDView::dragEnterEvent(QDragEnterEvent* event)
 {
@@ -21,6 +21,9 @@
 #ifndef __qMRMLThreeDView_h
 #define __qMRMLThreeDView_h
 
+// Qt includes
+#include <QVariantMap>
+
 // CTK includes
 #include <ctkPimpl.h>
 #include <ctkVTKRenderView.h>
@@ -65,6 +68,17 @@ public:
   /// Return a DisplayableManager given its class name
   Q_INVOKABLE  vtkMRMLAbstractDisplayableManager* displayableManagerByClassName(const char* className);
 
+  /// Return rendering statistics of the view, for profiling.
+  /// Render requests of the displayable managers are coalesced into at most
+  /// one render per refresh of the screen. The returned map contains:
+  ///  - requestCount: number of render requests
+  ///  - renderCount: number of renders of the view
+  ///  - coalescedRequestCount: number of requests that did not result in a render of their own
+  ///  - requestCountByDisplayableManager: map of the number of requests by displayable manager class name
+  /// \sa resetRenderStatistics()
+  Q_INVOKABLE QVariantMap renderStatistics()const;
+  Q_INVOKABLE void resetRenderStatistics();
+
   /// Get the 3D View node observed by view.
   Q_INVOKABLE vtkMRMLViewNode* mrmlViewNode()const;
 
@@ -117,6 +131,10 @@ public slots:
 protected:
   QScopedPointer<qMRMLThreeDViewPrivate> d_ptr;
 
+  /// Reimplemented to instantiate the displayable managers the first time
+  /// the view is shown.
+  void showEvent(QShowEvent* event) override;
+
 private:
   Q_DECLARE_PRIVATE(qMRMLThreeDView);
   Q_DISABLE_COPY(qMRMLThreeDView);
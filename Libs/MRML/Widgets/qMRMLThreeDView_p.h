@@ -67,10 +67,21 @@ public slots:
 
   void updateWidgetFromMRML();
 
+  /// Count the renders of the view
+  void onRenderEnded();
+
+  /// Instantiate the displayable managers registered in the factory, if
+  /// not done yet. Displayable managers are instantiated the first time the
+  /// view is shown or the first time they are accessed, so that views that
+  /// are created but not visible in the layout are cheap.
+  void instantiateDisplayableManagers();
+
 protected:
   void initDisplayableManagers();
 
   vtkMRMLDisplayableManagerGroup*    DisplayableManagerGroup;
+  bool                               DisplayableManagersInstantiated;
+  int                                RenderCount;
   vtkMRMLScene*                      MRMLScene;
   vtkMRMLViewNode*                   MRMLViewNode;
 };
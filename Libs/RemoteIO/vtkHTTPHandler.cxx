@@ -8,6 +8,10 @@
 // CURL includes
 #include <curl/curl.h>
 
+// STD includes
+#include <string>
+#include <vector>
+
 #if defined(_MSC_VER)
 #pragma warning ( disable : 4786 )
 #endif
@@ -19,6 +23,27 @@ public:
   vtkInternal(vtkHTTPHandler* external);
   ~vtkInternal();
 
+  /// Set the options of a handle for downloading source into file
+  void SetupDownload(CURL* handle, const char* source, FILE* file);
+
+  /// Download state of a file in StageFilesRead
+  struct Download
+    {
+    std::string Source;
+    std::string Destination;
+    FILE* File{nullptr};
+    CURL* Handle{nullptr};
+    /// Number of bytes already written to the file by previous attempts
+    double ResumeFrom{0.0};
+    int NumberOfResumeAttempts{0};
+    };
+
+  /// Open the destination file and add the download to the multi handle
+  bool StartDownload(CURLM* multiHandle, Download& download);
+  /// Add the download to the multi handle again if it failed with an error
+  /// that may be transient. Returns false if the download cannot be resumed.
+  bool ResumeDownload(CURLM* multiHandle, Download& download, CURLcode result);
+
   vtkHTTPHandler* External;
   CURL* CurlHandle;
   int ForbidReuse;
@@ -40,6 +65,111 @@ vtkHTTPHandler::vtkInternal::~vtkInternal()
   this->CurlHandle = nullptr;
 }
 
+//----------------------------------------------------------------------------
+void vtkHTTPHandler::vtkInternal::SetupDownload(CURL* handle, const char* source, FILE* file)
+{
+  if ( this->ForbidReuse )
+    {
+    curl_easy_setopt(handle, CURLOPT_FORBID_REUSE, 1);
+    }
+  curl_easy_setopt(handle, CURLOPT_HTTPGET, 1);
+  curl_easy_setopt(handle, CURLOPT_URL, source);
+  curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, true);
+  // use the default curl write call back
+  curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, nullptr);
+  // output goes into file, must be  FILE*
+  curl_easy_setopt(handle, CURLOPT_WRITEDATA, file);
+
+  if (this->External->CaCertificatesPath)
+    {
+    curl_easy_setopt(handle, CURLOPT_CAINFO, this->External->CaCertificatesPath);
+    }
+  else
+    {
+    curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, 0);
+    curl_easy_setopt(handle, CURLOPT_SSL_VERIFYHOST, 0);
+    }
+
+  // quick timeout during connection phase if URL is not accessible (e.g. blocked by a firewall)
+  curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, 3); // in seconds (type long)
+}
+
+//----------------------------------------------------------------------------
+bool vtkHTTPHandler::vtkInternal::StartDownload(CURLM* multiHandle, Download& download)
+{
+  download.File = fopen(download.Destination.c_str(), "wb");
+  if (!download.File)
+    {
+    vtkErrorWithObjectMacro(this->External, "StageFilesRead: cannot open file for writing: " << download.Destination);
+    return false;
+    }
+  download.Handle = curl_easy_init();
+  if (!download.Handle)
+    {
+    vtkErrorWithObjectMacro(this->External, "StageFilesRead: unable to initialise transfer of " << download.Source);
+    fclose(download.File);
+    download.File = nullptr;
+    return false;
+    }
+  this->SetupDownload(download.Handle, download.Source.c_str(), download.File);
+  curl_easy_setopt(download.Handle, CURLOPT_PRIVATE, &download);
+#if LIBCURL_VERSION_NUM >= 0x072b00
+  // wait for an existing connection to the server instead of opening a new one,
+  // if the requests can be multiplexed on it
+  curl_easy_setopt(download.Handle, CURLOPT_PIPEWAIT, 1L);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072f00
+  curl_easy_setopt(download.Handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+#endif
+  if (curl_multi_add_handle(multiHandle, download.Handle) != CURLM_OK)
+    {
+    vtkErrorWithObjectMacro(this->External, "StageFilesRead: unable to start transfer of " << download.Source);
+    curl_easy_cleanup(download.Handle);
+    download.Handle = nullptr;
+    fclose(download.File);
+    download.File = nullptr;
+    return false;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkHTTPHandler::vtkInternal::ResumeDownload(CURLM* multiHandle, Download& download, CURLcode result)
+{
+  if (download.NumberOfResumeAttempts >= this->External->MaximumNumberOfResumeAttempts)
+    {
+    return false;
+    }
+  if (result == CURLE_RANGE_ERROR)
+    {
+    // the server does not support range requests, start again from the beginning
+    download.File = freopen(download.Destination.c_str(), "wb", download.File);
+    if (!download.File)
+      {
+      return false;
+      }
+    download.ResumeFrom = 0.0;
+    curl_easy_setopt(download.Handle, CURLOPT_WRITEDATA, download.File);
+    }
+  else if (result == CURLE_PARTIAL_FILE || result == CURLE_RECV_ERROR || result == CURLE_SEND_ERROR
+    || result == CURLE_OPERATION_TIMEDOUT || result == CURLE_GOT_NOTHING)
+    {
+    // continue after the bytes that have been already written
+    double downloadedSize = 0.0;
+    curl_easy_getinfo(download.Handle, CURLINFO_SIZE_DOWNLOAD, &downloadedSize);
+    download.ResumeFrom += downloadedSize;
+    }
+  else
+    {
+    return false;
+    }
+  ++download.NumberOfResumeAttempts;
+  vtkDebugWithObjectMacro(this->External, "StageFilesRead: resuming download of " << download.Source
+    << " from byte " << download.ResumeFrom);
+  curl_easy_setopt(download.Handle, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(download.ResumeFrom));
+  return curl_multi_add_handle(multiHandle, download.Handle) == CURLM_OK;
+}
+
 //----------------------------------------------------------------------------
 // vtkHTTPHandler methods
 
@@ -107,6 +237,8 @@ vtkHTTPHandler::~vtkHTTPHandler()
 void vtkHTTPHandler::PrintSelf(ostream& os, vtkIndent indent)
 {
   Superclass::PrintSelf ( os, indent );
+  os << indent << "MaximumNumberOfConcurrentTransfers: " << this->MaximumNumberOfConcurrentTransfers << "\n";
+  os << indent << "MaximumNumberOfResumeAttempts: " << this->MaximumNumberOfResumeAttempts << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -201,35 +333,8 @@ void vtkHTTPHandler::StageFileRead(const char * source, const char * destination
   */
   this->InitTransfer( );
 
-
-  if ( this->Internal->ForbidReuse )
-    {
-    curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_FORBID_REUSE, 1);
-    }
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_HTTPGET, 1);
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_URL, source);
-//  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_NOPROGRESS, false);
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_FOLLOWLOCATION, true);
-  // use the default curl write call back
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_WRITEFUNCTION, nullptr); // write_callback);
   this->LocalFile = fopen(destination, "wb");
-  // output goes into LocalFile, must be  FILE*
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_WRITEDATA, this->LocalFile);
-//  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_PROGRESSDATA, nullptr);
-//  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_PROGRESSFUNCTION, ProgressCallback);
-
-  if (this->CaCertificatesPath)
-    {
-    curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_CAINFO, this->CaCertificatesPath);
-    }
-  else
-    {
-    curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_SSL_VERIFYPEER, 0);
-    curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_SSL_VERIFYHOST, 0);
-    }
-
-  // quick timeout during connection phase if URL is not accessible (e.g. blocked by a firewall)
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_CONNECTTIMEOUT, 3); // in seconds (type long)
+  this->Internal->SetupDownload(this->Internal->CurlHandle, source, this->LocalFile);
 
   vtkDebugMacro("StageFileRead: about to do the curl download... source = " << source << ", dest = " << destination);
   CURLcode retval = curl_easy_perform(this->Internal->CurlHandle);
@@ -273,6 +378,113 @@ void vtkHTTPHandler::StageFileRead(const char * source, const char * destination
 }
 
 
+//----------------------------------------------------------------------------
+void vtkHTTPHandler::StageFilesRead(const std::vector<std::string>& sources,
+                                    const std::vector<std::string>& destinations)
+{
+  if (sources.size() != destinations.size())
+    {
+    vtkErrorMacro("StageFilesRead: number of sources (" << sources.size()
+      << ") and destinations (" << destinations.size() << ") differ");
+    return;
+    }
+  if (sources.size() < 2 || this->MaximumNumberOfConcurrentTransfers < 2)
+    {
+    this->Superclass::StageFilesRead(sources, destinations);
+    return;
+    }
+
+  curl_global_init(CURL_GLOBAL_ALL);
+  CURLM* multiHandle = curl_multi_init();
+  if (multiHandle == nullptr)
+    {
+    vtkErrorMacro("StageFilesRead: unable to initialise");
+    return;
+    }
+#if LIBCURL_VERSION_NUM >= 0x072b00
+  curl_multi_setopt(multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+  curl_multi_setopt(multiHandle, CURLMOPT_MAX_TOTAL_CONNECTIONS, static_cast<long>(this->MaximumNumberOfConcurrentTransfers));
+
+  // downloads are not added or removed from the vector, as the handles store pointers to them
+  std::vector<vtkInternal::Download> downloads(sources.size());
+  size_t nextDownloadIndex = 0;
+  int numberOfActiveDownloads = 0;
+  while (true)
+    {
+    while (nextDownloadIndex < downloads.size()
+      && numberOfActiveDownloads < this->MaximumNumberOfConcurrentTransfers)
+      {
+      vtkInternal::Download& download = downloads[nextDownloadIndex];
+      download.Source = sources[nextDownloadIndex];
+      download.Destination = destinations[nextDownloadIndex];
+      ++nextDownloadIndex;
+      vtkDebugMacro("StageFilesRead: start download, source = " << download.Source << ", dest = " << download.Destination);
+      if (this->Internal->StartDownload(multiHandle, download))
+        {
+        ++numberOfActiveDownloads;
+        }
+      }
+    if (numberOfActiveDownloads == 0)
+      {
+      break;
+      }
+
+    int numberOfRunningHandles = 0;
+    curl_multi_perform(multiHandle, &numberOfRunningHandles);
+
+    int numberOfMessagesInQueue = 0;
+    while (CURLMsg* message = curl_multi_info_read(multiHandle, &numberOfMessagesInQueue))
+      {
+      if (message->msg != CURLMSG_DONE)
+        {
+        continue;
+        }
+      // the message is invalid after the handle is removed
+      CURL* handle = message->easy_handle;
+      CURLcode result = message->data.result;
+      curl_multi_remove_handle(multiHandle, handle);
+      vtkInternal::Download* download = nullptr;
+      curl_easy_getinfo(handle, CURLINFO_PRIVATE, &download);
+      if (result != CURLE_OK && this->Internal->ResumeDownload(multiHandle, *download, result))
+        {
+        continue;
+        }
+      --numberOfActiveDownloads;
+      if (result == CURLE_OK)
+        {
+        vtkDebugMacro("StageFilesRead: successful return from curl for " << download->Source);
+        }
+      else
+        {
+        vtkErrorMacro("StageFilesRead: error downloading " << download->Source << ": " << curl_easy_strerror(result));
+        //--- in case the permissions were not correct and that's
+        //--- the reason the read command failed,
+        //--- reset the 'remember check' in the permissions
+        //--- prompter so that new login info  will be prompted.
+        if ( this->GetPermissionPrompter() != nullptr )
+          {
+          this->GetPermissionPrompter()->SetRemember ( 0 );
+          }
+        }
+      curl_easy_cleanup(handle);
+      download->Handle = nullptr;
+      if (download->File)
+        {
+        fclose(download->File);
+        download->File = nullptr;
+        }
+      }
+
+    if (numberOfRunningHandles > 0)
+      {
+      curl_multi_wait(multiHandle, nullptr, 0, 1000, nullptr);
+      }
+    }
+
+  curl_multi_cleanup(multiHandle);
+}
+
 //----------------------------------------------------------------------------
 void vtkHTTPHandler::StageFileWrite(const char * source, const char * destination)
 {
@@ -37,6 +37,12 @@ public:
   using vtkURIHandler::StageFileRead;
   void StageFileWrite(const char * source, const char * destination) override;
   using vtkURIHandler::StageFileWrite;
+  /// Download the files concurrently, using at most MaximumNumberOfConcurrentTransfers
+  /// simultaneous transfers. Connections are reused between transfers to the same server, and
+  /// requests are multiplexed on a single connection if the server supports HTTP/2.
+  /// Interrupted downloads are resumed using range requests.
+  void StageFilesRead(const std::vector<std::string>& sources,
+                      const std::vector<std::string>& destinations) override;
   void InitTransfer () override;
   int CloseTransfer () override;
 
@@ -44,6 +50,16 @@ public:
   vtkSetStringMacro(CaCertificatesPath);
   vtkGetStringMacro(CaCertificatesPath);
 
+  /// Maximum number of files that StageFilesRead downloads at the same time.
+  /// If set to 1 then files are downloaded one after the other. Default is 4.
+  vtkSetClampMacro(MaximumNumberOfConcurrentTransfers, int, 1, 64);
+  vtkGetMacro(MaximumNumberOfConcurrentTransfers, int);
+
+  /// Maximum number of times StageFilesRead tries to resume a download that
+  /// was interrupted (connection reset, timeout, ...). Default is 2.
+  vtkSetClampMacro(MaximumNumberOfResumeAttempts, int, 0, 100);
+  vtkGetMacro(MaximumNumberOfResumeAttempts, int);
+
 protected:
   vtkHTTPHandler();
   ~vtkHTTPHandler() override;
@@ -54,6 +70,8 @@ private:
   class vtkInternal;
   vtkInternal* Internal;
   char* CaCertificatesPath{nullptr};
+  int MaximumNumberOfConcurrentTransfers{4};
+  int MaximumNumberOfResumeAttempts{2};
 };
 
 #endif
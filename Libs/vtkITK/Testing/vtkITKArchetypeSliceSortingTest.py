@@ -0,0 +1,43 @@
+import unittest
+
+import vtk
+import vtkITK
+
+
+class vtkITKArchetypeSliceSortingTest(unittest.TestCase):
+    def sortSlices(self, positions, orientation):
+        positionsArray = vtk.vtkDoubleArray()
+        positionsArray.SetNumberOfComponents(3)
+        for position in positions:
+            positionsArray.InsertNextTuple(position)
+        sortedIndices = vtk.vtkIdList()
+        sortedDistances = vtk.vtkDoubleArray()
+        spacingError = vtkITK.vtkITKArchetypeImageSeriesReader.SortSlicesAlongNormal(
+            positionsArray, orientation, sortedIndices, sortedDistances)
+        indices = [sortedIndices.GetId(i) for i in range(sortedIndices.GetNumberOfIds())]
+        distances = [sortedDistances.GetValue(i) for i in range(sortedDistances.GetNumberOfTuples())]
+        return indices, distances, spacingError
+
+    def test_uniformSpacing(self):
+        # Axial slices, listed in random order
+        positions = [[0.0, 0.0, 2.5], [0.0, 0.0, -2.5], [0.0, 0.0, 0.0], [0.0, 0.0, 5.0]]
+        indices, distances, spacingError = self.sortSlices(positions, [1.0, 0.0, 0.0, 0.0, 1.0, 0.0])
+        self.assertEqual(indices, [1, 2, 0, 3])
+        self.assertEqual(distances, [-5.0, -2.5, 0.0, 2.5])
+        self.assertAlmostEqual(spacingError, 0.0)
+
+    def test_nonUniformSpacing(self):
+        # Sagittal slices, with a missing slice
+        positions = [[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [3.0, 0.0, 0.0]]
+        indices, distances, spacingError = self.sortSlices(positions, [0.0, 1.0, 0.0, 0.0, 0.0, -1.0])
+        self.assertEqual(indices, [2, 1, 0])
+        self.assertAlmostEqual(spacingError, 1.0)
+
+    def test_empty(self):
+        indices, distances, spacingError = self.sortSlices([], [1.0, 0.0, 0.0, 0.0, 1.0, 0.0])
+        self.assertEqual(indices, [])
+        self.assertEqual(spacingError, 0.0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,76 @@
+import unittest
+
+import numpy
+import vtk
+import vtkITK
+from vtk.util import numpy_support as ns
+
+
+class vtkITKDistanceTransformTest(unittest.TestCase):
+    def setUp(self):
+        self.voxels = numpy.zeros([20, 30, 40], dtype=numpy.uint8)
+        self.voxels[5:15, 10:20, 10:30] = 1
+        self.image = vtk.vtkImageData()
+        self.image.SetDimensions(40, 30, 20)
+        self.image.SetSpacing(0.8, 1.1, 2.0)
+        self.setVoxels(self.voxels)
+
+    def setVoxels(self, voxels):
+        self.image.GetPointData().SetScalars(ns.numpy_to_vtk(voxels.ravel(), deep=True, array_type=vtk.VTK_UNSIGNED_CHAR))
+
+    def computeDistance(self, outputScalars=None, computeExtent=None, padding=None):
+        distance = vtkITK.vtkITKDistanceTransform()
+        distance.SetInputData(self.image)
+        distance.SetUseImageSpacing(True)
+        distance.SetNumberOfThreads(2)
+        if outputScalars:
+            distance.SetOutputScalars(outputScalars)
+        if computeExtent:
+            distance.SetComputeExtent(computeExtent)
+        if padding is not None:
+            distance.SetComputeExtentPadding(padding)
+        distance.Update()
+        output = distance.GetOutput()
+        self.assertEqual(output.GetScalarType(), vtk.VTK_FLOAT)
+        return ns.vtk_to_numpy(output.GetPointData().GetScalars()).copy()
+
+    def test_outputScalars(self):
+        fullDistance = self.computeDistance()
+        # Distance is 0 at the boundary voxels of the foreground, and changes across the whole image
+        self.assertEqual(fullDistance.reshape(self.voxels.shape)[5, 15, 20], 0.0)
+        self.assertGreater(fullDistance.max(), 0.0)
+
+        outputScalars = vtk.vtkFloatArray()
+        distance = self.computeDistance(outputScalars)
+        self.assertTrue(numpy.array_equal(fullDistance, distance))
+        self.assertTrue(numpy.array_equal(fullDistance, ns.vtk_to_numpy(outputScalars)))
+
+    def test_computeExtent(self):
+        outputScalars = vtk.vtkFloatArray()
+        originalDistance = self.computeDistance(outputScalars)
+
+        # Edit a small region and only update distances around it
+        editedVoxels = self.voxels.copy()
+        editedVoxels[8:10, 20:23, 15:18] = 1
+        self.setVoxels(editedVoxels)
+        computeExtent = [13, 19, 18, 24, 6, 11]
+        distance = self.computeDistance(outputScalars, computeExtent, padding=100)
+
+        # With large enough padding, the result in the compute extent is the same as full recomputation
+        fullDistance = self.computeDistance()
+        e = computeExtent
+        distanceVolume = distance.reshape(self.voxels.shape)
+        self.assertTrue(numpy.array_equal(
+            fullDistance.reshape(self.voxels.shape)[e[4]:e[5] + 1, e[2]:e[3] + 1, e[0]:e[1] + 1],
+            distanceVolume[e[4]:e[5] + 1, e[2]:e[3] + 1, e[0]:e[1] + 1]))
+
+        # Voxels outside the compute extent are unchanged
+        mask = numpy.ones(self.voxels.shape, dtype=bool)
+        mask[e[4]:e[5] + 1, e[2]:e[3] + 1, e[0]:e[1] + 1] = False
+        self.assertTrue(numpy.array_equal(originalDistance.reshape(self.voxels.shape)[mask], distanceVolume[mask]))
+
+    def runTest(self):
+        self.setUp()
+        self.test_outputScalars()
+        self.setUp()
+        self.test_computeExtent()
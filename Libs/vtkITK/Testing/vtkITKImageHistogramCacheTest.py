@@ -0,0 +1,79 @@
+import unittest
+
+import numpy
+import vtk
+import vtkITK
+from vtk.util import numpy_support as ns
+
+
+class vtkITKImageHistogramCacheTest(unittest.TestCase):
+    def setUp(self):
+        vtkITK.vtkITKImageHistogramCache.Clear()
+        self.voxels = (numpy.arange(30 * 40 * 50) % 1000).astype(numpy.int16).reshape([30, 40, 50])
+        self.image = vtk.vtkImageData()
+        self.image.SetDimensions(50, 40, 30)
+        self.image.GetPointData().SetScalars(ns.numpy_to_vtk(self.voxels.ravel(), deep=True, array_type=vtk.VTK_SHORT))
+
+    def test_histogram(self):
+        binCounts = vtk.vtkIdTypeArray()
+        binOriginAndSpacing = [0.0, 0.0]
+        self.assertTrue(vtkITK.vtkITKImageHistogramCache.GetHistogram(self.image, 0, 0, binCounts, binOriginAndSpacing))
+        # one bin per integer value
+        self.assertEqual(binCounts.GetNumberOfValues(), 1000)
+        self.assertEqual(binOriginAndSpacing, [0.0, 1.0])
+        expectedCounts = numpy.bincount(self.voxels.ravel(), minlength=1000)
+        self.assertTrue(numpy.array_equal(ns.vtk_to_numpy(binCounts), expectedCounts))
+
+        # fixed number of bins, first and last bins are centered at the minimum and maximum
+        self.assertTrue(vtkITK.vtkITKImageHistogramCache.GetHistogram(self.image, 64, 0, binCounts, binOriginAndSpacing))
+        self.assertEqual(binCounts.GetNumberOfValues(), 64)
+        self.assertAlmostEqual(binOriginAndSpacing[0] + 63 * binOriginAndSpacing[1], 999.0)
+        self.assertEqual(ns.vtk_to_numpy(binCounts).sum(), self.voxels.size)
+
+    def test_cache(self):
+        binCounts = vtk.vtkIdTypeArray()
+        binOriginAndSpacing = [0.0, 0.0]
+        vtkITK.vtkITKImageHistogramCache.GetHistogram(self.image, 0, 0, binCounts, binOriginAndSpacing)
+        vtkITK.vtkITKImageHistogramCache.GetHistogram(self.image, 0, 0, binCounts, binOriginAndSpacing)
+        self.assertEqual(vtkITK.vtkITKImageHistogramCache.GetNumberOfHistograms(), 1)
+
+        # histogram is recomputed after the voxels are modified
+        scalars = self.image.GetPointData().GetScalars()
+        ns.vtk_to_numpy(scalars)[:] = 5
+        scalars.Modified()
+        vtkITK.vtkITKImageHistogramCache.GetHistogram(self.image, 0, 0, binCounts, binOriginAndSpacing)
+        self.assertEqual(binCounts.GetNumberOfValues(), 1)
+        self.assertEqual(binCounts.GetValue(0), self.voxels.size)
+
+        vtkITK.vtkITKImageHistogramCache.Clear(self.image)
+        self.assertEqual(vtkITK.vtkITKImageHistogramCache.GetNumberOfHistograms(), 0)
+
+    def test_percentileRange(self):
+        percentileRange = [0.0, 0.0]
+        self.assertTrue(vtkITK.vtkITKImageHistogramCache.GetPercentileRange(self.image, 0.1, 99.9, 0, percentileRange))
+        self.assertAlmostEqual(percentileRange[0], 1.0)
+        self.assertAlmostEqual(percentileRange[1], 998.0)
+        # estimation from a subset of the voxels
+        self.assertTrue(vtkITK.vtkITKImageHistogramCache.GetPercentileRange(self.image, 0.1, 99.9, 5000, percentileRange))
+        self.assertLess(abs(percentileRange[0] - 1.0), 20.0)
+        self.assertLess(abs(percentileRange[1] - 998.0), 20.0)
+
+    def test_thresholdCalculator(self):
+        calculator = vtkITK.vtkITKImageThresholdCalculator()
+        calculator.SetInputData(self.image)
+        calculator.SetMethodToOtsu()
+        calculator.Update()
+        self.assertGreater(calculator.GetThreshold(), 0.0)
+        self.assertLess(calculator.GetThreshold(), 999.0)
+        # histogram is shared with other consumers
+        self.assertEqual(vtkITK.vtkITKImageHistogramCache.GetNumberOfHistograms(), 1)
+
+    def runTest(self):
+        self.setUp()
+        self.test_histogram()
+        self.setUp()
+        self.test_cache()
+        self.setUp()
+        self.test_percentileRange()
+        self.setUp()
+        self.test_thresholdCalculator()
@@ -0,0 +1,42 @@
+import unittest
+
+import numpy
+import vtk
+import vtkITK
+from vtk.util import numpy_support as ns
+
+
+class vtkITKImageMarginParallelDistanceTransformTest(unittest.TestCase):
+    def setUp(self):
+        # Two boxes and a few isolated voxels, with anisotropic spacing
+        voxels = numpy.zeros([30, 40, 50], dtype=numpy.uint8)
+        voxels[10:20, 5:15, 20:35] = 1
+        voxels[3:6, 25:30, 5:8] = 1
+        voxels[25, 35, 45] = 1
+        voxels[0, 0, 0] = 1
+        self.image = vtk.vtkImageData()
+        self.image.SetDimensions(50, 40, 30)
+        self.image.SetSpacing(0.8, 1.1, 2.0)
+        self.image.GetPointData().SetScalars(ns.numpy_to_vtk(voxels.ravel(), deep=True, array_type=vtk.VTK_UNSIGNED_CHAR))
+
+    def computeMargin(self, useParallelDistanceTransform, innerMarginMM, outerMarginMM):
+        margin = vtkITK.vtkITKImageMargin()
+        margin.SetInputData(self.image)
+        margin.CalculateMarginInMMOn()
+        margin.SetInnerMarginMM(innerMarginMM)
+        margin.SetOuterMarginMM(outerMarginMM)
+        margin.SetUseParallelDistanceTransform(useParallelDistanceTransform)
+        margin.Update()
+        return ns.vtk_to_numpy(margin.GetOutput().GetPointData().GetScalars())
+
+    def test_sameAsITK(self):
+        for innerMarginMM, outerMarginMM in [(-float("inf"), 0.0), (-float("inf"), 3.0), (-float("inf"), 10.5),
+                                             (-2.0, 0.0), (-1.5, 1.5), (0.1, 4.0)]:
+            itkMargin = self.computeMargin(False, innerMarginMM, outerMarginMM)
+            parallelMargin = self.computeMargin(True, innerMarginMM, outerMarginMM)
+            self.assertTrue(numpy.array_equal(itkMargin, parallelMargin),
+                            f"Margin mismatch for inner={innerMarginMM}, outer={outerMarginMM}")
+
+    def runTest(self):
+        self.setUp()
+        self.test_sameAsITK()
@@ -0,0 +1,66 @@
+import unittest
+
+import numpy
+import vtk
+import vtkITK
+from vtk.util import numpy_support as ns
+
+
+class vtkITKIslandMathParallelLabelingTest(unittest.TestCase):
+    def setUp(self):
+        # Random blobs, with an extent that does not start at 0
+        numpy.random.seed(0)
+        voxels = (numpy.random.rand(20, 30, 40) > 0.6).astype(numpy.uint16)
+        self.image = vtk.vtkImageData()
+        self.image.SetExtent(5, 44, -3, 26, 0, 19)
+        self.image.GetPointData().SetScalars(ns.numpy_to_vtk(voxels.ravel(), deep=True, array_type=vtk.VTK_UNSIGNED_SHORT))
+
+    def runIslandMath(self, parallelLabeling, fullyConnected, minimumSize, labelingExtent=None):
+        islandMath = vtkITK.vtkITKIslandMath()
+        islandMath.SetInputData(self.image)
+        islandMath.SetFullyConnected(fullyConnected)
+        islandMath.SetMinimumSize(minimumSize)
+        islandMath.SetParallelLabeling(parallelLabeling)
+        if labelingExtent:
+            islandMath.SetLabelingExtent(labelingExtent)
+        islandMath.Update()
+        return islandMath
+
+    def test_sameAsITK(self):
+        for fullyConnected in [False, True]:
+            for minimumSize in [0, 3]:
+                itkIslandMath = self.runIslandMath(False, fullyConnected, minimumSize)
+                parallelIslandMath = self.runIslandMath(True, fullyConnected, minimumSize)
+                self.assertEqual(parallelIslandMath.GetNumberOfIslands(), itkIslandMath.GetNumberOfIslands())
+                self.assertEqual(parallelIslandMath.GetOriginalNumberOfIslands(), itkIslandMath.GetOriginalNumberOfIslands())
+                # Labels are equal up to the order of islands of the same size, so compare the island sizes
+                itkSizes = ns.vtk_to_numpy(itkIslandMath.GetIslandSizes())
+                parallelSizes = ns.vtk_to_numpy(parallelIslandMath.GetIslandSizes())
+                self.assertTrue(numpy.array_equal(itkSizes, parallelSizes))
+                itkLabels = ns.vtk_to_numpy(itkIslandMath.GetOutput().GetPointData().GetScalars())
+                parallelLabels = ns.vtk_to_numpy(parallelIslandMath.GetOutput().GetPointData().GetScalars())
+                self.assertTrue(numpy.array_equal(itkLabels > 0, parallelLabels > 0))
+                self.assertTrue(numpy.array_equal(numpy.bincount(parallelLabels)[1:], parallelSizes))
+
+    def test_islandExtents(self):
+        islandMath = self.runIslandMath(True, False, 0)
+        labels = ns.vtk_to_numpy(islandMath.GetOutput().GetPointData().GetScalars()).reshape(20, 30, 40)
+        extents = islandMath.GetIslandExtents()
+        for islandIndex in range(min(10, islandMath.GetNumberOfIslands())):
+            k, j, i = numpy.nonzero(labels == islandIndex + 1)
+            expectedExtent = [i.min() + 5, i.max() + 5, j.min() - 3, j.max() - 3, k.min(), k.max()]
+            self.assertEqual([int(extents.GetComponent(islandIndex, component)) for component in range(6)], expectedExtent)
+
+    def test_labelingExtent(self):
+        islandMath = self.runIslandMath(True, False, 0, [10, 20, 0, 10, 5, 8])
+        labels = ns.vtk_to_numpy(islandMath.GetOutput().GetPointData().GetScalars()).reshape(20, 30, 40)
+        insideMask = numpy.zeros(labels.shape, dtype=bool)
+        insideMask[5:9, 3:14, 5:16] = True
+        self.assertFalse(numpy.any(labels[~insideMask]))
+        self.assertEqual(numpy.count_nonzero(labels), sum(ns.vtk_to_numpy(islandMath.GetIslandSizes())))
+
+    def runTest(self):
+        self.setUp()
+        self.test_sameAsITK()
+        self.test_islandExtents()
+        self.test_labelingExtent()
@@ -0,0 +1,71 @@
+import unittest
+
+import numpy
+import vtk
+import vtkITK
+from vtk.util import numpy_support as ns
+
+
+class vtkITKLevelTracingTest(unittest.TestCase):
+    def setUp(self):
+        # Box of 20 (I) x 10 (J) x 10 (K) voxels
+        self.voxels = numpy.zeros([20, 30, 40], dtype=numpy.uint8)
+        self.voxels[5:15, 10:20, 10:30] = 1
+        self.image = vtk.vtkImageData()
+        self.image.SetDimensions(40, 30, 20)
+        self.image.GetPointData().SetScalars(ns.numpy_to_vtk(self.voxels.ravel(), deep=True, array_type=vtk.VTK_UNSIGNED_CHAR))
+        self.tracing = vtkITK.vtkITKLevelTracingImageFilter()
+        self.tracing.SetInputData(self.image)
+
+    def trace(self, seed, plane):
+        self.tracing.SetSeed(seed)
+        self.tracing.SetPlane(plane)
+        self.tracing.Update()
+        output = self.tracing.GetOutput()
+        if not output.GetPoints():
+            return numpy.zeros([0, 3])
+        return ns.vtk_to_numpy(output.GetPoints().GetData()).copy()
+
+    def test_planes(self):
+        # Number of points on the boundary of a W x H rectangle is 2 * (W - 1) + 2 * (H - 1)
+        points = self.trace([10, 15, 8], 2)
+        self.assertEqual(len(points), 56)
+        self.assertTrue(numpy.all(points[:, 2] == 8))
+        points = self.trace([10, 15, 8], 1)
+        self.assertEqual(len(points), 56)
+        self.assertTrue(numpy.all(points[:, 1] == 15))
+        points = self.trace([20, 10, 8], 0)
+        self.assertEqual(len(points), 36)
+        self.assertTrue(numpy.all(points[:, 0] == 20))
+
+        # Seed in uniform region or outside the image
+        self.assertEqual(len(self.trace([20, 15, 8], 2)), 0)
+        self.assertEqual(len(self.trace([20, 15, 100], 1)), 0)
+
+    def test_repeatedTracing(self):
+        # Moving the seed on the same slice gives the same contour
+        for plane in range(3):
+            first = self.trace([10, 10, 8], plane)
+            self.assertGreater(len(first), 0)
+            second = self.trace([10, 10, 8], plane)
+            self.assertTrue(numpy.array_equal(first, second))
+
+        # Modified voxels are taken into account
+        voxels = ns.vtk_to_numpy(self.image.GetPointData().GetScalars()).reshape(self.voxels.shape)
+        for plane in [1, 2]:
+            self.assertEqual(len(self.trace([10, 15, 8], plane)), 56)
+            voxels[5:15, 10:20, 10:40] = 1
+            self.image.GetPointData().GetScalars().Modified()
+            self.assertEqual(len(self.trace([10, 15, 8], plane)), 76)
+            voxels[5:15, 10:20, 30:40] = 0
+            self.image.GetPointData().GetScalars().Modified()
+
+    def test_rgb(self):
+        rgb = numpy.repeat(self.voxels.ravel()[:, numpy.newaxis] * 200, 3, axis=1)
+        self.image.GetPointData().SetScalars(ns.numpy_to_vtk(rgb, deep=True, array_type=vtk.VTK_UNSIGNED_CHAR))
+        self.assertEqual(len(self.trace([10, 15, 8], 2)), 56)
+        self.assertEqual(len(self.trace([10, 15, 8], 1)), 56)
+
+
+if __name__ == '__main__':
+    unittest.main()
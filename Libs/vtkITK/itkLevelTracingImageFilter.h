@@ -83,6 +83,14 @@ public:
   /// Did we move the seed point to put in on a boundary?
   itkGetMacro(MovedSeed, bool);
 
+  /// Generate the label image output (on by default). In 2D, if only the
+  /// path output is needed, then switching this off avoids allocating and
+  /// clearing an image of the size of the input at each trace.
+  /// The label image is always generated in the ND case.
+  itkSetMacro(GenerateLabelImage, bool);
+  itkGetConstMacro(GenerateLabelImage, bool);
+  itkBooleanMacro(GenerateLabelImage);
+
   int GetThreshold();
   InputImagePixelType GetMaxIntensity() {return m_Max;}
   InputImagePixelType GetMinIntensity() {return m_Min;}
@@ -122,6 +130,7 @@ private:
   InputImagePixelType m_Max;
   InputImagePixelType m_Min;
   bool                m_MovedSeed;
+  bool                m_GenerateLabelImage;
 
 };
 
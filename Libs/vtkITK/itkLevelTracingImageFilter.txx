@@ -170,6 +170,7 @@ LevelTracingImageFilter<TInputImage, TOutputImage>
 {
   m_Seed.Fill(0);
   m_MovedSeed = false;
+  m_GenerateLabelImage = true;
   m_Min = 0;
   m_Max = 0;
 
@@ -216,6 +217,8 @@ LevelTracingImageFilter<TInputImage, TOutputImage>
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Seed point location: " << m_Seed
      << std::endl;
+  os << indent << "GenerateLabelImage: " << m_GenerateLabelImage
+     << std::endl;
 }
 
 template <class TInputImage, class TOutputImage>
@@ -284,10 +287,13 @@ LevelTracingImageFilter<TInputImage,TOutputImage>
   m_MovedSeed = false;
 
   // Zero the output
-  OutputImageRegionType regionOut =  outputImage->GetRequestedRegion();
-  outputImage->SetBufferedRegion( regionOut );
-  outputImage->Allocate();
-  outputImage->FillBuffer ( NumericTraits<OutputImagePixelType>::ZeroValue() );
+  if (m_GenerateLabelImage)
+    {
+    OutputImageRegionType regionOut =  outputImage->GetRequestedRegion();
+    outputImage->SetBufferedRegion( regionOut );
+    outputImage->Allocate();
+    outputImage->FillBuffer ( NumericTraits<OutputImagePixelType>::ZeroValue() );
+    }
 
   outputPath->Initialize();
 
@@ -407,7 +413,10 @@ LevelTracingImageFilter<TInputImage,TOutputImage>
 
   // Now we have the seed and the starting neighbor
   outputPath->SetStart(seed);
-  outputImage->SetPixel(pix, NumericTraits<OutputImagePixelType>::OneValue());
+  if (m_GenerateLabelImage)
+    {
+    outputImage->SetPixel(pix, NumericTraits<OutputImagePixelType>::OneValue());
+    }
   do
     {
     for(int s = 0; s<8; s++)
@@ -422,8 +431,11 @@ LevelTracingImageFilter<TInputImage,TOutputImage>
         if (val >= threshold)
           {
           //condition is satisfied, label the output image and output path
-          outputImage->SetPixel(pixTemp,
-                                NumericTraits<OutputImagePixelType>::OneValue());
+          if (m_GenerateLabelImage)
+            {
+            outputImage->SetPixel(pixTemp,
+                                  NumericTraits<OutputImagePixelType>::OneValue());
+            }
           offset[0]=offsetX;
           offset[1]=offsetY;
           outputPath->InsertStep(noOfPixels, offset);
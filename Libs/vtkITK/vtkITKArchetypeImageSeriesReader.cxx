@@ -18,7 +18,9 @@
 
 // VTK includes
 #include <vtkDataArray.h>
+#include <vtkDoubleArray.h>
 #include <vtkErrorCode.h>
+#include <vtkIdList.h>
 #include <vtkImageData.h>
 #include <vtkMath.h>
 #include <vtkMatrix4x4.h>
@@ -40,6 +42,8 @@
 
 // STD includes
 #include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <vector>
 
 #include "itkArchetypeSeriesFileNames.h"
@@ -49,6 +53,14 @@
 #include "itkDCMTKImageIO.h"
 #include "itkGDCMSeriesFileNames.h"
 #include "itkGDCMImageIO.h"
+#include "itkMultiThreaderBase.h"
+
+// GDCM includes
+#include <gdcmReader.h>
+#include <gdcmStringFilter.h>
+
+// STD includes
+#include <set>
 #endif
 
 vtkStandardNewMacro(vtkITKArchetypeImageSeriesReader);
@@ -92,6 +104,7 @@ vtkITKArchetypeImageSeriesReader::vtkITKArchetypeImageSeriesReader()
   this->ImageOrientationPatient.resize( 0 );
 
   this->AnalyzeHeader = true;
+  this->ParallelSliceReading = true;
 
   this->GroupingByTags = false;
   this->IsOnlyFile = false;
@@ -166,6 +179,7 @@ void vtkITKArchetypeImageSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OutputScalarType: "
      << vtkImageScalarTypeNameMacro(this->OutputScalarType)
      << std::endl;
+  os << indent << "ParallelSliceReading: " << this->ParallelSliceReading << "\n";
   os << indent << "DefaultDataSpacing: (" << this->DefaultDataSpacing[0];
   for (idx = 1; idx < 3; ++idx)
     {
@@ -1228,6 +1242,91 @@ std::string vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(const itk
   return tagValue;
 }
 
+#ifdef VTKITK_BUILD_DICOM_SUPPORT
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Values of the DICOM tags that are used for grouping and sorting files of a series
+struct DicomSliceHeader
+{
+  enum TagIndex
+    {
+    SeriesInstanceUID = 0,
+    ContentTime,
+    TriggerTime,
+    EchoNumbers,
+    DiffusionGradientOrientation,
+    SliceLocation,
+    ImageOrientationPatient,
+    ImagePositionPatient,
+    NumberOfTags
+    };
+
+  static const char* GetTagKey(int tagIndex)
+    {
+    static const char* tagKeys[NumberOfTags] =
+      {
+      "0020|000e", "0008|0033", "0018|1060", "0018|0086",
+      "0010|9089", "0020|1041", "0020|0037", "0020|0032"
+      };
+    return tagKeys[tagIndex];
+    }
+
+  bool Parsed{false};
+  std::string Values[NumberOfTags];
+};
+
+//----------------------------------------------------------------------------
+/// Read only the tags needed for grouping the files.
+/// Parsing of the file stops after the last needed tag, so pixel data is not read.
+/// Values are converted the same way as in itk::GDCMImageIO and spaces are removed
+/// as in vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces.
+void ReadDicomSliceHeader(const std::string& fileName, DicomSliceHeader& sliceHeader)
+{
+  std::set<gdcm::Tag> tags;
+  std::vector<gdcm::Tag> tagList;
+  for (int tagIndex = 0; tagIndex < DicomSliceHeader::NumberOfTags; ++tagIndex)
+    {
+    gdcm::Tag tag;
+    tag.ReadFromPipeSeparatedString(DicomSliceHeader::GetTagKey(tagIndex));
+    tags.insert(tag);
+    tagList.push_back(tag);
+    }
+  gdcm::Reader reader;
+  reader.SetFileName(fileName.c_str());
+  try
+    {
+    if (!reader.ReadSelectedTags(tags))
+      {
+      return;
+      }
+    }
+  catch (...)
+    {
+    // the file will be parsed again by itk::GDCMImageIO, which reports the error
+    return;
+    }
+  const gdcm::DataSet& dataSet = reader.GetFile().GetDataSet();
+  gdcm::StringFilter stringFilter;
+  stringFilter.SetFile(reader.GetFile());
+  for (int tagIndex = 0; tagIndex < DicomSliceHeader::NumberOfTags; ++tagIndex)
+    {
+    if (!dataSet.FindDataElement(tagList[tagIndex]) || dataSet.GetDataElement(tagList[tagIndex]).IsEmpty())
+      {
+      continue;
+      }
+    std::string tagValue = stringFilter.ToString(tagList[tagIndex]);
+    tagValue.erase(std::remove_if(tagValue.begin(), tagValue.end(),
+      [](char c) { return isspace(static_cast<unsigned char>(c)) || c == '\0'; }), tagValue.end());
+    sliceHeader.Values[tagIndex] = tagValue;
+    }
+  sliceHeader.Parsed = true;
+}
+
+} // end of anonymous namespace
+#endif
+
 //----------------------------------------------------------------------------
 void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
 {
@@ -1335,20 +1434,43 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
     }
 
   // if Archetype is a Dicom File
+  // Headers are parsed concurrently (only the tags needed for grouping the files),
+  // then the values are inserted in file order, so that the result is the same as
+  // with sequential parsing.
+  std::vector<DicomSliceHeader> sliceHeaders(nFiles);
+  const std::vector<std::string>& allFileNames = this->AllFileNames;
+  itk::MultiThreaderBase::Pointer multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(0, nFiles,
+    [&sliceHeaders, &allFileNames](itk::SizeValueType f)
+      {
+      ReadDicomSliceHeader(allFileNames[f], sliceHeaders[f]);
+      },
+    nullptr);
+
   gdcmIO->SetFileName( this->Archetype );
   for (int f = 0; f < nFiles; f++)
     {
-    gdcmIO->SetFileName( this->AllFileNames[f] );
-    gdcmIO->ReadImageInformation();
-    itk::MetaDataDictionary &dict = gdcmIO->GetMetaDataDictionary();
+    DicomSliceHeader& sliceHeader = sliceHeaders[f];
+    if (!sliceHeader.Parsed)
+      {
+      // Partial parsing failed, read the header the same way as the image will be read
+      // (reports errors the same way as reading the image)
+      gdcmIO->SetFileName( this->AllFileNames[f] );
+      gdcmIO->ReadImageInformation();
+      itk::MetaDataDictionary &dict = gdcmIO->GetMetaDataDictionary();
+      for (int tagIndex = 0; tagIndex < DicomSliceHeader::NumberOfTags; ++tagIndex)
+        {
+        // Use vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces to remove extra spaces
+        // from the DICOM tag, because extra spaces were found in some DICOM file before/after the
+        // multi-value separator backslashes.
+        sliceHeader.Values[tagIndex] = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(
+          dict, DicomSliceHeader::GetTagKey(tagIndex));
+        }
+      }
     std::string tagValue;
 
-    // Use vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces to remove extra spaces
-    // from the DICOM tag, because extra spaces were found in some DICOM file before/after the
-    // multi-value separator backslashes.
-
     // series instance UID
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0020|000e");
+    tagValue = sliceHeader.Values[DicomSliceHeader::SeriesInstanceUID];
     if (!tagValue.empty())
       {
       int idx = InsertSeriesInstanceUIDs( tagValue.c_str() );
@@ -1360,7 +1482,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // content time
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0008|0033");
+    tagValue = sliceHeader.Values[DicomSliceHeader::ContentTime];
     if (!tagValue.empty())
       {
       int idx = InsertContentTime( tagValue.c_str() );
@@ -1372,7 +1494,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // trigger time
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0018|1060");
+    tagValue = sliceHeader.Values[DicomSliceHeader::TriggerTime];
     if (!tagValue.empty())
       {
       int idx = InsertTriggerTime( tagValue.c_str() );
@@ -1384,7 +1506,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // echo numbers
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0018|0086");
+    tagValue = sliceHeader.Values[DicomSliceHeader::EchoNumbers];
     if (!tagValue.empty())
       {
       int idx = InsertEchoNumbers( tagValue.c_str() );
@@ -1396,7 +1518,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // diffision gradient orientation
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0010|9089");
+    tagValue = sliceHeader.Values[DicomSliceHeader::DiffusionGradientOrientation];
     if (!tagValue.empty())
       {
       float a[3] = { -1 };
@@ -1410,7 +1532,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // slice location
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0020|1041");
+    tagValue = sliceHeader.Values[DicomSliceHeader::SliceLocation];
     if (!tagValue.empty())
       {
       float a = -1;
@@ -1424,7 +1546,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // image orientation patient
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0020|0037");
+    tagValue = sliceHeader.Values[DicomSliceHeader::ImageOrientationPatient];
     if (!tagValue.empty())
       {
       float a[6] = { -1 };
@@ -1437,7 +1559,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       this->IndexImageOrientationPatient[f] = -1;
       }
     // image position patient
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0020|0032");
+    tagValue = sliceHeader.Values[DicomSliceHeader::ImagePositionPatient];
     if (!tagValue.empty())
       {
       float a[3] = { -1 };
@@ -1566,6 +1688,58 @@ void vtkITKArchetypeImageSeriesReader::ResetFileNames( )
   this->ImageOrientationPatient.resize( 0 );
 }
 
+//----------------------------------------------------------------------------
+double vtkITKArchetypeImageSeriesReader::SortSlicesAlongNormal(vtkDoubleArray* positions, const double orientation[6],
+  vtkIdList* sortedIndices, vtkDoubleArray* sortedDistances)
+{
+  if (!positions || positions->GetNumberOfComponents() != 3 || !orientation || !sortedIndices || !sortedDistances)
+    {
+    vtkGenericWarningMacro("vtkITKArchetypeImageSeriesReader::SortSlicesAlongNormal failed: invalid inputs");
+    return -1.0;
+    }
+  vtkIdType numberOfSlices = positions->GetNumberOfTuples();
+  sortedIndices->SetNumberOfIds(numberOfSlices);
+  sortedDistances->SetNumberOfComponents(1);
+  sortedDistances->SetNumberOfTuples(numberOfSlices);
+  if (numberOfSlices == 0)
+    {
+    return 0.0;
+    }
+
+  // Distance of each slice from the first slice along the slice normal
+  double scanAxis[3] = { 0.0, 0.0, 0.0 };
+  vtkMath::Cross(orientation, orientation + 3, scanAxis);
+  const double* position = positions->GetPointer(0);
+  const double scanOrigin[3] = { position[0], position[1], position[2] };
+  std::vector<double> distances(numberOfSlices);
+  for (vtkIdType i = 0; i < numberOfSlices; i++, position += 3)
+    {
+    distances[i] = (position[0] - scanOrigin[0]) * scanAxis[0]
+      + (position[1] - scanOrigin[1]) * scanAxis[1]
+      + (position[2] - scanOrigin[2]) * scanAxis[2];
+    }
+
+  // Slices at the same position keep their input order
+  std::vector<vtkIdType> order(numberOfSlices);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+    [&distances](vtkIdType a, vtkIdType b) { return distances[a] < distances[b]; });
+
+  double maximumSpacingError = 0.0;
+  double firstSpacing = (numberOfSlices > 1 ? distances[order[1]] - distances[order[0]] : 0.0);
+  for (vtkIdType i = 0; i < numberOfSlices; i++)
+    {
+    sortedIndices->SetId(i, order[i]);
+    sortedDistances->SetValue(i, distances[order[i]]);
+    if (i > 1)
+      {
+      double spacingError = std::abs((distances[order[i]] - distances[order[i - 1]]) - firstSpacing);
+      maximumSpacingError = std::max(maximumSpacingError, spacingError);
+      }
+    }
+  return maximumSpacingError;
+}
+
 //----------------------------------------------------------------------------
 int vtkITKArchetypeImageSeriesReader::AssembleVolumeContainingArchetype( )
 {
@@ -1593,6 +1767,59 @@ int vtkITKArchetypeImageSeriesReader::AssembleVolumeContainingArchetype( )
   long int iArchetypeDiffusion = this->IndexDiffusionGradientOrientation[this->IndexArchetype];
   long int iArchetypeOrientation =  this->IndexImageOrientationPatient[this->IndexArchetype];
 
+  // Find the files that match the archetype
+  std::vector<int> matchingFiles;
+  bool positionsAvailable = (this->ImagePositionPatient.size() != 0);
+  for (unsigned int k = 0; k < this->AllFileNames.size(); k++)
+    {
+    if ((this->IndexSeriesInstanceUIDs[k] != iArchetypeSeriesUID &&
+         this->IndexSeriesInstanceUIDs[k] >= 0 && iArchetypeSeriesUID >= 0)
+        ||
+        (this->IndexEchoNumbers[k] != iArchetypeEchoNumbers &&
+         this->IndexEchoNumbers[k] >= 0 && iArchetypeEchoNumbers >= 0)
+        ||
+        (this->IndexDiffusionGradientOrientation[k] != iArchetypeDiffusion  &&
+         this->IndexDiffusionGradientOrientation[k] >= 0 && iArchetypeDiffusion >= 0)
+        ||
+        (this->IndexImageOrientationPatient[k] != iArchetypeOrientation &&
+         this->IndexImageOrientationPatient[k] >= 0 && iArchetypeOrientation >= 0) )
+      {
+      // file doesn't match our criteria
+      continue;
+      }
+    matchingFiles.push_back(k);
+    if (positionsAvailable && (this->IndexImageOrientationPatient[k] <= 0 || this->IndexImagePositionPatient[k] <= 0))
+      {
+      positionsAvailable = false;
+      }
+    }
+
+  // If all files have position information then sort them along the slice normal
+  if (positionsAvailable && !matchingFiles.empty())
+    {
+    vtkNew<vtkDoubleArray> positions;
+    positions->SetNumberOfComponents(3);
+    positions->SetNumberOfTuples(static_cast<vtkIdType>(matchingFiles.size()));
+    for (size_t i = 0; i < matchingFiles.size(); i++)
+      {
+      const std::vector<float>& position = this->ImagePositionPatient[this->IndexImagePositionPatient[matchingFiles[i]]];
+      positions->SetTuple3(static_cast<vtkIdType>(i), position[0], position[1], position[2]);
+      }
+    const std::vector<float>& firstOrientation = this->ImageOrientationPatient[this->IndexImageOrientationPatient[matchingFiles[0]]];
+    double orientation[6] = { 0.0 };
+    std::copy(firstOrientation.begin(), firstOrientation.begin() + 6, orientation);
+    vtkNew<vtkIdList> sortedIndices;
+    vtkNew<vtkDoubleArray> sortedDistances;
+    if (vtkITKArchetypeImageSeriesReader::SortSlicesAlongNormal(positions, orientation, sortedIndices, sortedDistances) >= 0.0)
+      {
+      for (vtkIdType i = 0; i < sortedIndices->GetNumberOfIds(); i++)
+        {
+        this->FileNames.push_back(this->AllFileNames[matchingFiles[sortedIndices->GetId(i)]]);
+        }
+      return this->FileNames.size();
+      }
+    }
+
   // keep track of the locations for the selected files
   std::vector<std::pair <double, int> > fileNameSortKey;
   bool originSet = false;
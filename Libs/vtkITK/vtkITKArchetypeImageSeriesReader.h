@@ -20,6 +20,8 @@ Version:   $Revision$
 
 // VTK includes
 #include "vtkImageAlgorithm.h"
+class vtkDoubleArray;
+class vtkIdList;
 class vtkMatrix4x4;
 
 // ITK includes
@@ -71,6 +73,18 @@ public:
   const char* GetFileName( unsigned int n );
   void ResetFileNames();
 
+  ///
+  /// Sort slices by their position along the slice normal, as it is done
+  /// when the files of a DICOM series are assembled into a volume.
+  /// positions contains the ImagePositionPatient (3 components) of each slice,
+  /// orientation is the ImageOrientationPatient (row and column directions).
+  /// sortedIndices receives the indices of the slices in increasing position and
+  /// sortedDistances their distance from the first input slice along the normal.
+  /// Returns the largest difference between the spacing of adjacent slices and the
+  /// spacing of the first two sorted slices (uniform spacing if it is 0), or -1 on error.
+  static double SortSlicesAlongNormal(vtkDoubleArray* positions, const double orientation[6],
+    vtkIdList* sortedIndices, vtkDoubleArray* sortedDistances);
+
   ///
   /// Set/Get the default spacing of the data in the file. This will be
   /// used if the reader provided spacing is 1.0. (Default is 1.0)
@@ -246,6 +260,15 @@ public:
   vtkSetMacro(AnalyzeHeader, bool);
   vtkGetMacro(AnalyzeHeader, bool);
 
+  ///
+  /// Whether the files of a series can be decoded concurrently, each file
+  /// directly into its slice of the output image. Only used when the native
+  /// coordinate orientation is requested and each file contains one slice;
+  /// other series are read sequentially. (Default is true)
+  vtkSetMacro(ParallelSliceReading, bool);
+  vtkGetMacro(ParallelSliceReading, bool);
+  vtkBooleanMacro(ParallelSliceReading, bool);
+
   ///
   /// Whether to use orientation from file
   vtkSetMacro(UseOrientationFromFile, int);
@@ -879,6 +902,7 @@ protected:
 
   std::vector<std::string> AllFileNames;
   bool AnalyzeHeader;
+  bool ParallelSliceReading;
   bool IsOnlyFile;
   bool ArchetypeIsDICOM;
 
@@ -28,13 +28,21 @@
 #include <vtkVersion.h>
 
 // ITK includes
-#include <itkOrientImageFilter.h>
+#include <itkConvertPixelBuffer.h>
+#include <itkImageFileReader.h>
+#include <itkImageIORegion.h>
 #include <itkImageSeriesReader.h>
+#include <itkMultiThreaderBase.h>
+#include <itkOrientImageFilter.h>
 #ifdef VTKITK_BUILD_DICOM_SUPPORT
 #include <itkDCMTKImageIO.h>
 #include <itkGDCMImageIO.h>
 #endif
 
+// STD includes
+#include <atomic>
+#include <vector>
+
 vtkStandardNewMacro(vtkITKArchetypeImageSeriesScalarReader);
 
 namespace {
@@ -45,6 +53,107 @@ vtkAOSDataArrayTemplate<T>* DownCast(vtkAbstractArray* a)
   return vtkAOSDataArrayTemplate<T>::FastDownCast(a);
 }
 
+//----------------------------------------------------------------------------
+template <class TInputPixel, class TOutputPixel>
+void ConvertSliceBuffer(const char* inputBuffer, int inputNumberOfComponents,
+  TOutputPixel* outputBuffer, size_t numberOfPixels)
+{
+  itk::ConvertPixelBuffer<TInputPixel, TOutputPixel, itk::DefaultConvertPixelTraits<TOutputPixel> >::Convert(
+    const_cast<TInputPixel*>(reinterpret_cast<const TInputPixel*>(inputBuffer)),
+    inputNumberOfComponents, outputBuffer, numberOfPixels);
+}
+
+//----------------------------------------------------------------------------
+/// Decode a single 2D file of the series into its slice of the output buffer.
+/// Returns false if the file does not contain exactly one slice of the expected size.
+template <class TOutputPixel>
+bool ReadSliceIntoBuffer(itk::ImageIOBase* imageIO, const std::string& fileName,
+  const itk::SizeValueType sliceSize[2], TOutputPixel* sliceBuffer)
+{
+  imageIO->SetFileName(fileName);
+  imageIO->ReadImageInformation();
+  const unsigned int numberOfDimensions = imageIO->GetNumberOfDimensions();
+  if (numberOfDimensions < 2
+    || imageIO->GetDimensions(0) != sliceSize[0]
+    || imageIO->GetDimensions(1) != sliceSize[1]
+    || (numberOfDimensions > 2 && imageIO->GetDimensions(2) != 1))
+    {
+    return false;
+    }
+  itk::ImageIORegion ioRegion(numberOfDimensions);
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+    {
+    ioRegion.SetIndex(i, 0);
+    ioRegion.SetSize(i, imageIO->GetDimensions(i));
+    }
+  imageIO->SetIORegion(ioRegion);
+
+  const size_t numberOfPixels = sliceSize[0] * sliceSize[1];
+  if (imageIO->GetNumberOfComponents() == 1
+    && imageIO->GetComponentType() == itk::ImageIOBase::MapPixelType<TOutputPixel>::CType)
+    {
+    // Pixel type matches, decode directly into the output image
+    imageIO->Read(sliceBuffer);
+    return true;
+    }
+
+  std::vector<char> fileBuffer(imageIO->GetImageSizeInBytes());
+  imageIO->Read(fileBuffer.data());
+  const int numberOfComponents = imageIO->GetNumberOfComponents();
+  switch (imageIO->GetComponentType())
+    {
+    case itk::ImageIOBase::UCHAR: ConvertSliceBuffer<unsigned char>(fileBuffer.data(), numberOfComponents, sliceBuffer, numberOfPixels); break;
+    case itk::ImageIOBase::CHAR: ConvertSliceBuffer<char>(fileBuffer.data(), numberOfComponents, sliceBuffer, numberOfPixels); break;
+    case itk::ImageIOBase::USHORT: ConvertSliceBuffer<unsigned short>(fileBuffer.data(), numberOfComponents, sliceBuffer, numberOfPixels); break;
+    case itk::ImageIOBase::SHORT: ConvertSliceBuffer<short>(fileBuffer.data(), numberOfComponents, sliceBuffer, numberOfPixels); break;
+    case itk::ImageIOBase::UINT: ConvertSliceBuffer<unsigned int>(fileBuffer.data(), numberOfComponents, sliceBuffer, numberOfPixels); break;
+    case itk::ImageIOBase::INT: ConvertSliceBuffer<int>(fileBuffer.data(), numberOfComponents, sliceBuffer, numberOfPixels); break;
+    case itk::ImageIOBase::ULONG: ConvertSliceBuffer<unsigned long>(fileBuffer.data(), numberOfComponents, sliceBuffer, numberOfPixels); break;
+    case itk::ImageIOBase::LONG: ConvertSliceBuffer<long>(fileBuffer.data(), numberOfComponents, sliceBuffer, numberOfPixels); break;
+    case itk::ImageIOBase::FLOAT: ConvertSliceBuffer<float>(fileBuffer.data(), numberOfComponents, sliceBuffer, numberOfPixels); break;
+    case itk::ImageIOBase::DOUBLE: ConvertSliceBuffer<double>(fileBuffer.data(), numberOfComponents, sliceBuffer, numberOfPixels); break;
+    default:
+      return false;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+/// Decode all the files of the series concurrently, each file into its own slice
+/// of the output buffer. Returns false if any of the files could not be decoded.
+template <class TOutputPixel>
+bool ReadSlicesIntoBuffer(itk::ImageIOBase* prototypeImageIO, const std::vector<std::string>& fileNames,
+  const itk::SizeValueType sliceSize[2], TOutputPixel* outputBuffer)
+{
+  std::atomic<bool> success(true);
+  const size_t numberOfPixelsPerSlice = sliceSize[0] * sliceSize[1];
+  itk::MultiThreaderBase::Pointer multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(0, fileNames.size(),
+    [&](itk::SizeValueType f)
+      {
+      if (!success)
+        {
+        return;
+        }
+      // ImageIO objects are not thread-safe, each slice uses its own instance
+      itk::ImageIOBase::Pointer imageIO = dynamic_cast<itk::ImageIOBase*>(prototypeImageIO->CreateAnother().GetPointer());
+      try
+        {
+        if (imageIO.IsNull()
+          || !ReadSliceIntoBuffer<TOutputPixel>(imageIO, fileNames[f], sliceSize, outputBuffer + f * numberOfPixelsPerSlice))
+          {
+          success = false;
+          }
+        }
+      catch (...)
+        {
+        success = false;
+        }
+      },
+    nullptr);
+  return success;
+}
+
 };
 
 //----------------------------------------------------------------------------
@@ -88,6 +197,13 @@ int vtkITKArchetypeImageSeriesScalarReader::RequestData(
     vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()));
   this->SetMetaDataScalarRangeToPointDataInfo(data);
 
+  if (this->ReadSeriesSlicesInParallel(data))
+    {
+    this->Progress = 1.0;
+    this->InvokeEvent(vtkCommand::ProgressEvent, &this->Progress);
+    return 1;
+    }
+
 #ifdef VTKITK_BUILD_DICOM_SUPPORT
 #define vtkITKExecuteDataDeclareDICOMImageIO \
       typedef itk::ImageIOBase ImageIOType; \
@@ -264,7 +380,88 @@ int vtkITKArchetypeImageSeriesScalarReader::RequestData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+bool vtkITKArchetypeImageSeriesScalarReader::ReadSeriesSlicesInParallel(vtkImageData* data)
+{
+  // The OrientImageFilter may reorder the voxels, so slices can only be decoded
+  // directly into the output image when the native orientation is used.
+  if (!this->ParallelSliceReading
+    || !this->UseNativeCoordinateOrientation
+    || this->FileNames.size() < 2
+    || this->GetNumberOfComponents() != 1
+    || data->GetNumberOfScalarComponents() != 1)
+    {
+    return false;
+    }
+  int dimensions[3] = { 0, 0, 0 };
+  data->GetDimensions(dimensions);
+  if (dimensions[2] != static_cast<int>(this->FileNames.size()))
+    {
+    // not one file per slice
+    return false;
+    }
 
+  itk::ImageIOBase::Pointer prototypeImageIO;
+  try
+    {
+    if (this->ArchetypeIsDICOM)
+      {
+#ifdef VTKITK_BUILD_DICOM_SUPPORT
+      // DCMTK decoders rely on globally registered codecs, keep reading those sequentially
+      if (this->DICOMImageIOApproach != vtkITKArchetypeImageSeriesReader::GDCM)
+        {
+        return false;
+        }
+      prototypeImageIO = itk::GDCMImageIO::New();
+#else
+      return false;
+#endif
+      }
+    else
+      {
+      typedef itk::Image<float, 3> ImageType;
+      itk::ImageFileReader<ImageType>::Pointer imageReader = itk::ImageFileReader<ImageType>::New();
+      imageReader->SetFileName(this->FileNames[0].c_str());
+      imageReader->UpdateOutputInformation();
+      prototypeImageIO = imageReader->GetImageIO();
+      }
+    }
+  catch (itk::ExceptionObject& e)
+    {
+    vtkDebugMacro(<< "ReadSeriesSlicesInParallel: failed to get the image IO, reading the series sequentially: " << e);
+    return false;
+    }
+  if (prototypeImageIO.IsNull())
+    {
+    return false;
+    }
+
+  // Make sure that the output buffer is allocated for the whole extent
+  data->AllocateScalars(data->GetScalarType(), 1);
+  void* outputBuffer = data->GetScalarPointer();
+  if (!outputBuffer)
+    {
+    return false;
+    }
+
+  const itk::SizeValueType sliceSize[2] =
+    { static_cast<itk::SizeValueType>(dimensions[0]), static_cast<itk::SizeValueType>(dimensions[1]) };
+  bool success = false;
+  switch (data->GetScalarType())
+    {
+    vtkTemplateMacro(success = ReadSlicesIntoBuffer<VTK_TT>(
+      prototypeImageIO, this->FileNames, sliceSize, static_cast<VTK_TT*>(outputBuffer)));
+    default:
+      break;
+    }
+  if (!success)
+    {
+    vtkDebugMacro(<< "ReadSeriesSlicesInParallel: failed to decode slices in parallel, reading the series sequentially");
+    }
+  return success;
+}
+
+//----------------------------------------------------------------------------
 void vtkITKArchetypeImageSeriesScalarReader::ReadProgressCallback(itk::Object* obj, const itk::EventObject&, void* data)
 {
   itk::ProcessObject::Pointer p(dynamic_cast<itk::ProcessObject *>(obj));
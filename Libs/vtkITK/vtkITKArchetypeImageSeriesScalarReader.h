@@ -33,6 +33,10 @@ class VTK_ITK_EXPORT vtkITKArchetypeImageSeriesScalarReader : public vtkITKArche
 
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector) override;
   static void ReadProgressCallback(itk::Object* obj, const itk::EventObject&, void* data);
+
+  /// Decode the files of a series concurrently, directly into the output image.
+  /// Returns false if the series has to be read with the sequential series reader instead.
+  bool ReadSeriesSlicesInParallel(vtkImageData* data);
   /// private:
 
 private:
@@ -11,11 +11,18 @@
 #include "vtkObjectFactory.h"
 
 #include "vtkDataArray.h"
-#include "vtkPointData.h"
+#include "vtkFloatArray.h"
 #include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkPointData.h"
 
+#include "itkRegionOfInterestImageFilter.h"
 #include "itkSignedMaurerDistanceMapImageFilter.h"
 
+#include <algorithm>
+#include <cstring>
+
 vtkStandardNewMacro(vtkITKDistanceTransform);
 
 vtkITKDistanceTransform::vtkITKDistanceTransform()
@@ -28,23 +35,38 @@ vtkITKDistanceTransform::vtkITKDistanceTransform()
 
 vtkITKDistanceTransform::~vtkITKDistanceTransform() = default;
 
+void vtkITKDistanceTransform::SetOutputScalars(vtkFloatArray* outputScalars)
+{
+  if (this->OutputScalars == outputScalars)
+    {
+    return;
+    }
+  this->OutputScalars = outputScalars;
+  this->Modified();
+}
+
+vtkFloatArray* vtkITKDistanceTransform::GetOutputScalars()
+{
+  return this->OutputScalars;
+}
+
 
 template <class T>
 void vtkITKDistanceTransformExecute(vtkITKDistanceTransform *self, vtkImageData* input,
-                vtkImageData* output,
-                T* inPtr, T* vtkNotUsed(outPtr))
+                vtkImageData* output, T* inPtr, const int* computeExtent)
 {
 
   int dims[3];
   input->GetDimensions(dims);
   double spacing[3];
   input->GetSpacing(spacing);
+  const itk::SizeValueType numberOfVoxels = static_cast<itk::SizeValueType>(dims[0]) * dims[1] * dims[2];
 
   // Wrap scalars into an ITK image
   // - mostly rely on defaults for spacing, origin etc for this filter
   typedef itk::Image<T, 3> ImageType;
   typename ImageType::Pointer inImage = ImageType::New();
-  inImage->GetPixelContainer()->SetImportPointer(inPtr, dims[0]*dims[1]*dims[2], false);
+  inImage->GetPixelContainer()->SetImportPointer(inPtr, numberOfVoxels, false);
   typename ImageType::RegionType region;
   typename ImageType::IndexType index;
   typename ImageType::SizeType size;
@@ -68,25 +90,166 @@ void vtkITKDistanceTransformExecute(vtkITKDistanceTransform *self, vtkImageData*
   dist->SetUseImageSpacing(self->GetUseImageSpacing());
   dist->SetInsideIsPositive(self->GetInsideIsPositive());
   dist->SetSquaredDistance(self->GetSquaredDistance());
+  if (self->GetNumberOfThreads() > 0)
+    {
+    dist->GetMultiThreader()->SetMaximumNumberOfThreads(self->GetNumberOfThreads());
+    dist->SetNumberOfWorkUnits(self->GetNumberOfThreads());
+    }
+
+  float* outPtr = static_cast<float*>(output->GetScalarPointer());
 
-  dist->SetInput( inImage );
+  if (!computeExtent)
+    {
+    // Compute distances directly into the output scalars
+    DistanceImageType::Pointer outImage = DistanceImageType::New();
+    outImage->GetPixelContainer()->SetImportPointer(outPtr, numberOfVoxels, false);
+    outImage->SetRegions(region);
+    outImage->SetSpacing(spacing);
+    dist->GraftOutput(outImage);
+    dist->SetInput( inImage );
+    dist->Update();
+    if (dist->GetOutput()->GetBufferPointer() != outPtr)
+      {
+      // the filter allocated its own buffer
+      memcpy(outPtr, dist->GetOutput()->GetBufferPointer(), numberOfVoxels * sizeof(float));
+      }
+    return;
+    }
+
+  // Only compute distances in the padded extent and copy them to the output in the requested extent
+  int* inExtent = input->GetExtent();
+  int padding = std::max(0, self->GetComputeExtentPadding());
+  typename ImageType::IndexType paddedIndex;
+  typename ImageType::SizeType paddedSize;
+  int writeStart[3] = { 0, 0, 0 };
+  int writeEnd[3] = { 0, 0, 0 };
+  for (int i = 0; i < 3; ++i)
+    {
+    writeStart[i] = computeExtent[2 * i] - inExtent[2 * i];
+    writeEnd[i] = computeExtent[2 * i + 1] - inExtent[2 * i];
+    int paddedStart = std::max(0, writeStart[i] - padding);
+    int paddedEnd = std::min(dims[i] - 1, writeEnd[i] + padding);
+    paddedIndex[i] = paddedStart;
+    paddedSize[i] = paddedEnd - paddedStart + 1;
+    }
+  typename ImageType::RegionType paddedRegion;
+  paddedRegion.SetIndex(paddedIndex);
+  paddedRegion.SetSize(paddedSize);
+
+  typedef itk::RegionOfInterestImageFilter<ImageType, ImageType> RegionOfInterestType;
+  typename RegionOfInterestType::Pointer regionOfInterest = RegionOfInterestType::New();
+  regionOfInterest->SetInput(inImage);
+  regionOfInterest->SetRegionOfInterest(paddedRegion);
+  if (self->GetNumberOfThreads() > 0)
+    {
+    regionOfInterest->GetMultiThreader()->SetMaximumNumberOfThreads(self->GetNumberOfThreads());
+    regionOfInterest->SetNumberOfWorkUnits(self->GetNumberOfThreads());
+    }
+
+  dist->SetInput(regionOfInterest->GetOutput());
   dist->Update();
 
-  // Copy to the output
-  output->AllocateScalars(VTK_FLOAT, 1);  // in case the image being worked on is not float type
-  void * oPtr = output->GetScalarPointer();
-  memcpy(oPtr, dist->GetOutput()->GetBufferPointer(),
-         dist->GetOutput()->GetBufferedRegion().GetNumberOfPixels() * sizeof(T));
+  const float* distancePtr = dist->GetOutput()->GetBufferPointer();
+  const size_t rowSize = static_cast<size_t>(writeEnd[0] - writeStart[0] + 1) * sizeof(float);
+  for (int z = writeStart[2]; z <= writeEnd[2]; ++z)
+    {
+    for (int y = writeStart[1]; y <= writeEnd[1]; ++y)
+      {
+      const float* sourceRow = distancePtr
+        + ((static_cast<vtkIdType>(z - paddedIndex[2]) * paddedSize[1] + (y - paddedIndex[1])) * paddedSize[0]
+        + (writeStart[0] - paddedIndex[0]));
+      float* targetRow = outPtr + ((static_cast<vtkIdType>(z) * dims[1] + y) * dims[0] + writeStart[0]);
+      memcpy(targetRow, sourceRow, rowSize);
+      }
+    }
+}
+
 
+//
+//
+//
+int vtkITKDistanceTransform::RequestInformation(vtkInformation* request,
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (!this->Superclass::RequestInformation(request, inputVector, outputVector))
+    {
+    return 0;
+    }
+  // Distances are always stored as float
+  vtkDataObject::SetPointDataActiveScalarInfo(outputVector->GetInformationObject(0), VTK_FLOAT, 1);
+  return 1;
 }
 
+//
+//
+//
+int vtkITKDistanceTransform::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkImageData* input = vtkImageData::GetData(inputVector[0]);
+  vtkImageData* output = vtkImageData::GetData(outputVector);
+  if (!input || !output)
+    {
+    return 0;
+    }
 
+  int inExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  input->GetExtent(inExtent);
+  output->SetExtent(inExtent);
+  vtkIdType numberOfVoxels = input->GetNumberOfPoints();
 
+  const int* computeExtent = nullptr;
+  int clippedComputeExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  if (this->OutputScalars)
+    {
+    // Only a previous result of the same size can be partially updated
+    bool previousResultAvailable = (this->OutputScalars->GetNumberOfComponents() == 1
+      && this->OutputScalars->GetNumberOfTuples() == numberOfVoxels);
+    this->OutputScalars->SetNumberOfComponents(1);
+    this->OutputScalars->SetNumberOfTuples(numberOfVoxels);
+    output->GetPointData()->SetScalars(this->OutputScalars);
+    if (previousResultAvailable
+      && this->ComputeExtent[0] <= this->ComputeExtent[1]
+      && this->ComputeExtent[2] <= this->ComputeExtent[3]
+      && this->ComputeExtent[4] <= this->ComputeExtent[5])
+      {
+      bool emptyExtent = false;
+      for (int i = 0; i < 3; ++i)
+        {
+        clippedComputeExtent[2 * i] = std::max(this->ComputeExtent[2 * i], inExtent[2 * i]);
+        clippedComputeExtent[2 * i + 1] = std::min(this->ComputeExtent[2 * i + 1], inExtent[2 * i + 1]);
+        emptyExtent = emptyExtent || (clippedComputeExtent[2 * i] > clippedComputeExtent[2 * i + 1]);
+        }
+      if (emptyExtent)
+        {
+        // nothing to update
+        return 1;
+        }
+      computeExtent = clippedComputeExtent;
+      }
+    }
+  else
+    {
+    // Reuses the current output scalars if the image size did not change
+    output->AllocateScalars(VTK_FLOAT, 1);
+    }
+
+  this->ExecuteDistanceTransform(input, output, computeExtent);
+  return 1;
+}
 
 //
 //
 //
 void vtkITKDistanceTransform::SimpleExecute(vtkImageData *input, vtkImageData *output)
+{
+  this->ExecuteDistanceTransform(input, output, nullptr);
+}
+
+//
+//
+//
+void vtkITKDistanceTransform::ExecuteDistanceTransform(vtkImageData *input, vtkImageData *output, const int* computeExtent)
 {
   vtkDebugMacro(<< "Executing distance transform");
 
@@ -94,7 +257,6 @@ void vtkITKDistanceTransform::SimpleExecute(vtkImageData *input, vtkImageData *o
   // Initialize and check input
   //
   vtkPointData *pd = input->GetPointData();
-  pd=input->GetPointData();
   if (pd ==nullptr)
     {
     vtkErrorMacro(<<"PointData is NULL");
@@ -106,6 +268,11 @@ void vtkITKDistanceTransform::SimpleExecute(vtkImageData *input, vtkImageData *o
     vtkErrorMacro(<<"Scalars must be defined for distance transform");
     return;
     }
+  if (!vtkFloatArray::SafeDownCast(output->GetPointData()->GetScalars()))
+    {
+    vtkErrorMacro(<<"Output scalars must be float");
+    return;
+    }
 
   if (inScalars->GetNumberOfComponents() == 1 )
     {
@@ -114,10 +281,9 @@ void vtkITKDistanceTransform::SimpleExecute(vtkImageData *input, vtkImageData *o
 #undef VTK_TYPE_USE_LONG_LONG
 #undef VTK_TYPE_USE___INT64
 
-#define CALL  vtkITKDistanceTransformExecute(this, input, output, static_cast<VTK_TT *>(inPtr), static_cast<VTK_TT *>(outPtr));
+#define CALL  vtkITKDistanceTransformExecute(this, input, output, static_cast<VTK_TT *>(inPtr), computeExtent);
 
     void* inPtr = input->GetScalarPointer();
-    void* outPtr = output->GetScalarPointer();
 
     switch (inScalars->GetDataType())
       {
@@ -148,6 +314,10 @@ void vtkITKDistanceTransform::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "InsideIsPositive: " << InsideIsPositive << std::endl;
   os << indent << "UseImageSpacing: " << UseImageSpacing << std::endl;
   os << indent << "SquaredDistance: " << SquaredDistance << std::endl;
+  os << indent << "NumberOfThreads: " << NumberOfThreads << std::endl;
+  os << indent << "ComputeExtent: " << ComputeExtent[0] << ", " << ComputeExtent[1] << ", " << ComputeExtent[2]
+    << ", " << ComputeExtent[3] << ", " << ComputeExtent[4] << ", " << ComputeExtent[5] << std::endl;
+  os << indent << "ComputeExtentPadding: " << ComputeExtentPadding << std::endl;
 }
 
 
@@ -13,7 +13,16 @@
 #include "vtkITK.h"
 #include "vtkSimpleImageToImageFilter.h"
 
+#include <vtkSmartPointer.h>
+
+class vtkFloatArray;
+
 /// \brief Wrapper class around itk::SignedMaurerDistanceMapImageFilter.
+///
+/// Output is a float image. Distances are computed directly into the output scalars
+/// without extra copies, and the output scalars are reused between updates if the
+/// image size does not change. When distances are recomputed repeatedly after small
+/// edits, set OutputScalars and ComputeExtent to only update the edited region.
 class VTK_ITK_EXPORT vtkITKDistanceTransform : public vtkSimpleImageToImageFilter
 {
 public:
@@ -37,17 +46,53 @@ public:
   vtkGetMacro(BackgroundValue, double);
   vtkSetMacro(BackgroundValue, double);
 
+  /// Maximum number of threads used for computing the distance map.
+  /// If 0 (default) then the ITK default number of threads is used.
+  vtkGetMacro(NumberOfThreads, int);
+  vtkSetMacro(NumberOfThreads, int);
+
+  /// Array that the distances are written into. If not set (default) then the output scalars are
+  /// allocated by the filter. Setting the same array for each update avoids reallocation, and it
+  /// contains the result of the previous update, which is needed when only ComputeExtent is updated.
+  void SetOutputScalars(vtkFloatArray* outputScalars);
+  vtkFloatArray* GetOutputScalars();
+
+  /// If a valid extent is set then distances are only recomputed within this extent of the input image,
+  /// and voxels outside are left as they were in OutputScalars. It is ignored if OutputScalars is not set
+  /// or its size does not match the input image (then there is no previous result to update).
+  /// Default is empty extent (0, -1, 0, -1, 0, -1), which means the whole image is computed.
+  vtkSetVector6Macro(ComputeExtent, int);
+  vtkGetVector6Macro(ComputeExtent, int);
+
+  /// Number of voxels that ComputeExtent is padded with on each side. Only the input within the
+  /// padded extent is used, therefore distances in ComputeExtent are only exact if the closest
+  /// boundary is within the padding. Default is 10.
+  vtkSetMacro(ComputeExtentPadding, int);
+  vtkGetMacro(ComputeExtentPadding, int);
+
 
 protected:
   vtkITKDistanceTransform();
   ~vtkITKDistanceTransform() override;
 
+  int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
   void SimpleExecute(vtkImageData* input, vtkImageData* output) override;
 
+  /// Compute distances. If computeExtent is not nullptr then only that extent is updated in the output.
+  void ExecuteDistanceTransform(vtkImageData* input, vtkImageData* output, const int* computeExtent);
+
   int SquaredDistance;
   int InsideIsPositive;
   int UseImageSpacing;
   double BackgroundValue;
+  int NumberOfThreads{0};
+  vtkSmartPointer<vtkFloatArray> OutputScalars;
+  int ComputeExtent[6]{0, -1, 0, -1, 0, -1};
+  int ComputeExtentPadding{10};
 
 private:
   vtkITKDistanceTransform(const vtkITKDistanceTransform&) = delete;
@@ -0,0 +1,368 @@
+/*=========================================================================
+
+  Copyright Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   vtkITK
+
+==========================================================================*/
+
+// vtkITK includes
+#include "vtkITKImageHistogramCache.h"
+
+// VTK includes
+#include <vtkDataArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkImageData.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
+#include <vtkWeakPointer.h>
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <mutex>
+#include <vector>
+
+vtkStandardNewMacro(vtkITKImageHistogramCache);
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+struct HistogramEntry
+{
+  /// Voxels that the histogram was computed from
+  vtkWeakPointer<vtkDataArray> Scalars;
+  vtkMTimeType ScalarsMTime{0};
+  int Dimensions[3]{0, 0, 0};
+  /// Parameters that the histogram was computed with
+  int RequestedNumberOfBins{0};
+  vtkIdType MaximumNumberOfSamples{0};
+  /// Histogram
+  double BinOrigin{0.0};
+  double BinSpacing{1.0};
+  std::vector<vtkIdType> Counts;
+};
+
+//----------------------------------------------------------------------------
+struct HistogramCache
+{
+  std::mutex Mutex;
+  int MaximumNumberOfHistograms{16};
+  /// Most recently used histogram first
+  std::list<HistogramEntry> Entries;
+};
+
+//----------------------------------------------------------------------------
+HistogramCache& GetHistogramCache()
+{
+  // The cache is never deleted, so that it can be used during static destruction
+  static HistogramCache* cache = new HistogramCache;
+  return *cache;
+}
+
+//----------------------------------------------------------------------------
+/// Remove histograms of deleted arrays and the least recently used histograms
+/// above the maximum number. The cache must be locked.
+void RemoveUnusedHistograms(HistogramCache& cache)
+{
+  std::list<HistogramEntry>::iterator entryIt = cache.Entries.begin();
+  while (entryIt != cache.Entries.end())
+    {
+    if (!entryIt->Scalars)
+      {
+      entryIt = cache.Entries.erase(entryIt);
+      continue;
+      }
+    ++entryIt;
+    }
+  while (static_cast<int>(cache.Entries.size()) > std::max(cache.MaximumNumberOfHistograms, 0))
+    {
+    cache.Entries.pop_back();
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void AccumulateHistogram(const T* scalars, int numberOfComponents, const int dimensions[3], const int sampleRate[3],
+  double binOrigin, double binSpacing, std::vector<vtkIdType>& counts)
+{
+  const vtkIdType numberOfBins = static_cast<vtkIdType>(counts.size());
+  const vtkIdType numberOfSlices = (dimensions[2] + sampleRate[2] - 1) / sampleRate[2];
+  vtkSMPThreadLocal<std::vector<vtkIdType>> threadCounts;
+  // Each thread processes a slab of slices and accumulates the counts in its own histogram
+  vtkSMPTools::For(0, numberOfSlices, [&](vtkIdType beginSlice, vtkIdType endSlice)
+    {
+    std::vector<vtkIdType>& localCounts = threadCounts.Local();
+    if (localCounts.empty())
+      {
+      localCounts.resize(numberOfBins, 0);
+      }
+    for (vtkIdType slice = beginSlice; slice < endSlice; ++slice)
+      {
+      vtkIdType z = slice * sampleRate[2];
+      for (vtkIdType y = 0; y < dimensions[1]; y += sampleRate[1])
+        {
+        const T* row = scalars + (z * dimensions[1] + y) * dimensions[0] * numberOfComponents;
+        for (vtkIdType x = 0; x < dimensions[0]; x += sampleRate[0])
+          {
+          double binPosition = (static_cast<double>(row[x * numberOfComponents]) - binOrigin) / binSpacing + 0.5;
+          if (binPosition != binPosition)
+            {
+            // NaN
+            continue;
+            }
+          vtkIdType binIndex = static_cast<vtkIdType>(std::floor(binPosition));
+          binIndex = std::max(static_cast<vtkIdType>(0), std::min(binIndex, numberOfBins - 1));
+          localCounts[binIndex]++;
+          }
+        }
+      }
+    });
+  for (std::vector<vtkIdType>& localCounts : threadCounts)
+    {
+    for (vtkIdType binIndex = 0; binIndex < static_cast<vtkIdType>(localCounts.size()); ++binIndex)
+      {
+      counts[binIndex] += localCounts[binIndex];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Find histogram in the cache or compute it
+bool GetHistogramEntry(vtkImageData* image, int numberOfBins, vtkIdType maximumNumberOfSamples, HistogramEntry& histogram)
+{
+  vtkDataArray* scalars = (image && image->GetPointData()) ? image->GetPointData()->GetScalars() : nullptr;
+  if (!scalars || scalars->GetNumberOfTuples() < 1)
+    {
+    return false;
+    }
+  int dimensions[3] = { 0, 0, 0 };
+  image->GetDimensions(dimensions);
+  if (static_cast<vtkIdType>(dimensions[0]) * dimensions[1] * dimensions[2] != scalars->GetNumberOfTuples())
+    {
+    vtkGenericWarningMacro("vtkITKImageHistogramCache: number of scalars does not match the image dimensions");
+    return false;
+    }
+  numberOfBins = std::max(numberOfBins, 0);
+  maximumNumberOfSamples = std::max(maximumNumberOfSamples, static_cast<vtkIdType>(0));
+
+  HistogramCache& cache = GetHistogramCache();
+  {
+    std::lock_guard<std::mutex> lock(cache.Mutex);
+    for (std::list<HistogramEntry>::iterator entryIt = cache.Entries.begin(); entryIt != cache.Entries.end(); ++entryIt)
+      {
+      if (entryIt->Scalars.GetPointer() == scalars && entryIt->ScalarsMTime == scalars->GetMTime()
+        && std::equal(dimensions, dimensions + 3, entryIt->Dimensions)
+        && entryIt->RequestedNumberOfBins == numberOfBins && entryIt->MaximumNumberOfSamples == maximumNumberOfSamples)
+        {
+        // move to the front, as the most recently used histogram
+        cache.Entries.splice(cache.Entries.begin(), cache.Entries, entryIt);
+        histogram = cache.Entries.front();
+        return true;
+        }
+      }
+  }
+
+  // Compute bins from the scalar range (the range is cached by the array)
+  double range[2] = { 0.0, 0.0 };
+  scalars->GetRange(range, 0);
+  if (range[0] > range[1])
+    {
+    return false;
+    }
+  bool floatingPoint = (scalars->GetDataType() == VTK_FLOAT || scalars->GetDataType() == VTK_DOUBLE);
+  double binSpacing = 1.0;
+  int actualNumberOfBins = numberOfBins;
+  if (range[1] <= range[0])
+    {
+    actualNumberOfBins = (numberOfBins > 0 ? numberOfBins : 1);
+    }
+  else if (numberOfBins > 0)
+    {
+    binSpacing = (numberOfBins > 1 ? (range[1] - range[0]) / (numberOfBins - 1) : range[1] - range[0]);
+    }
+  else if (!floatingPoint)
+    {
+    // one bin per value, or a few values per bin for large ranges
+    double maximumNumberOfBins = vtkITKImageHistogramCache::GetMaximumNumberOfAutomaticBins();
+    binSpacing = std::max(1.0, std::ceil((range[1] - range[0] + 1.0) / maximumNumberOfBins));
+    actualNumberOfBins = static_cast<int>(std::floor((range[1] - range[0]) / binSpacing)) + 1;
+    }
+  else
+    {
+    actualNumberOfBins = vtkITKImageHistogramCache::GetMaximumNumberOfAutomaticBins();
+    binSpacing = (range[1] - range[0]) / (actualNumberOfBins - 1);
+    }
+
+  // Use the same sampling rate along all the non-degenerate axes
+  int sampleRate[3] = { 1, 1, 1 };
+  vtkIdType numberOfVoxels = scalars->GetNumberOfTuples();
+  if (maximumNumberOfSamples > 0 && numberOfVoxels > maximumNumberOfSamples)
+    {
+    int numberOfAxes = 0;
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      numberOfAxes += (dimensions[axis] > 1 ? 1 : 0);
+      }
+    double rate = std::pow(static_cast<double>(numberOfVoxels) / maximumNumberOfSamples, 1.0 / std::max(numberOfAxes, 1));
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      if (dimensions[axis] > 1)
+        {
+        sampleRate[axis] = std::min(static_cast<int>(std::ceil(rate)), dimensions[axis]);
+        }
+      }
+    }
+
+  HistogramEntry entry;
+  entry.Scalars = scalars;
+  entry.ScalarsMTime = scalars->GetMTime();
+  std::copy(dimensions, dimensions + 3, entry.Dimensions);
+  entry.RequestedNumberOfBins = numberOfBins;
+  entry.MaximumNumberOfSamples = maximumNumberOfSamples;
+  entry.BinOrigin = range[0];
+  entry.BinSpacing = binSpacing;
+  entry.Counts.resize(actualNumberOfBins, 0);
+  switch (scalars->GetDataType())
+    {
+    vtkTemplateMacro(AccumulateHistogram(static_cast<const VTK_TT*>(scalars->GetVoidPointer(0)),
+      scalars->GetNumberOfComponents(), dimensions, sampleRate, entry.BinOrigin, entry.BinSpacing, entry.Counts));
+    default:
+      vtkGenericWarningMacro("vtkITKImageHistogramCache: unsupported scalar type " << scalars->GetDataType());
+      return false;
+    }
+  histogram = entry;
+
+  {
+    std::lock_guard<std::mutex> lock(cache.Mutex);
+    cache.Entries.push_front(std::move(entry));
+    RemoveUnusedHistograms(cache);
+  }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+void vtkITKImageHistogramCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumNumberOfHistograms: " << vtkITKImageHistogramCache::GetMaximumNumberOfHistograms() << "\n";
+  os << indent << "NumberOfHistograms: " << vtkITKImageHistogramCache::GetNumberOfHistograms() << "\n";
+}
+
+//----------------------------------------------------------------------------
+bool vtkITKImageHistogramCache::GetHistogram(vtkImageData* image, int numberOfBins, vtkIdType maximumNumberOfSamples,
+  vtkIdTypeArray* binCounts, double binOriginAndSpacing[2])
+{
+  if (!binCounts || !binOriginAndSpacing)
+    {
+    return false;
+    }
+  HistogramEntry histogram;
+  if (!GetHistogramEntry(image, numberOfBins, maximumNumberOfSamples, histogram))
+    {
+    return false;
+    }
+  binCounts->SetNumberOfComponents(1);
+  binCounts->SetNumberOfValues(static_cast<vtkIdType>(histogram.Counts.size()));
+  std::copy(histogram.Counts.begin(), histogram.Counts.end(), binCounts->GetPointer(0));
+  binOriginAndSpacing[0] = histogram.BinOrigin;
+  binOriginAndSpacing[1] = histogram.BinSpacing;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkITKImageHistogramCache::GetPercentileRange(vtkImageData* image, double lowerPercentile, double upperPercentile,
+  vtkIdType maximumNumberOfSamples, double range[2])
+{
+  if (!range)
+    {
+    return false;
+    }
+  HistogramEntry histogram;
+  if (!GetHistogramEntry(image, 0, maximumNumberOfSamples, histogram))
+    {
+    return false;
+    }
+  vtkIdType total = 0;
+  for (vtkIdType count : histogram.Counts)
+    {
+    total += count;
+    }
+  if (total == 0)
+    {
+    return false;
+    }
+  double lowerCount = total * std::max(0.0, std::min(lowerPercentile, 100.0)) / 100.0;
+  double upperCount = total * std::max(0.0, std::min(upperPercentile, 100.0)) / 100.0;
+  vtkIdType lastBinIndex = static_cast<vtkIdType>(histogram.Counts.size()) - 1;
+  vtkIdType lowerBinIndex = -1;
+  vtkIdType upperBinIndex = lastBinIndex;
+  vtkIdType cumulativeCount = 0;
+  for (vtkIdType binIndex = 0; binIndex <= lastBinIndex; ++binIndex)
+    {
+    cumulativeCount += histogram.Counts[binIndex];
+    if (lowerBinIndex < 0 && cumulativeCount > lowerCount)
+      {
+      lowerBinIndex = binIndex;
+      }
+    if (cumulativeCount >= upperCount)
+      {
+      upperBinIndex = binIndex;
+      break;
+      }
+    }
+  lowerBinIndex = std::max(static_cast<vtkIdType>(0), std::min(lowerBinIndex, upperBinIndex));
+  range[0] = histogram.BinOrigin + lowerBinIndex * histogram.BinSpacing;
+  range[1] = histogram.BinOrigin + upperBinIndex * histogram.BinSpacing;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkITKImageHistogramCache::Clear(vtkImageData* image)
+{
+  vtkDataArray* scalars = (image && image->GetPointData()) ? image->GetPointData()->GetScalars() : nullptr;
+  HistogramCache& cache = GetHistogramCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  if (!image)
+    {
+    cache.Entries.clear();
+    return;
+    }
+  cache.Entries.remove_if([scalars](const HistogramEntry& entry) { return entry.Scalars.GetPointer() == scalars; });
+  RemoveUnusedHistograms(cache);
+}
+
+//----------------------------------------------------------------------------
+void vtkITKImageHistogramCache::SetMaximumNumberOfHistograms(int maximumNumberOfHistograms)
+{
+  HistogramCache& cache = GetHistogramCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  cache.MaximumNumberOfHistograms = std::max(maximumNumberOfHistograms, 0);
+  RemoveUnusedHistograms(cache);
+}
+
+//----------------------------------------------------------------------------
+int vtkITKImageHistogramCache::GetMaximumNumberOfHistograms()
+{
+  HistogramCache& cache = GetHistogramCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.MaximumNumberOfHistograms;
+}
+
+//----------------------------------------------------------------------------
+int vtkITKImageHistogramCache::GetNumberOfHistograms()
+{
+  HistogramCache& cache = GetHistogramCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  RemoveUnusedHistograms(cache);
+  return static_cast<int>(cache.Entries.size());
+}
@@ -0,0 +1,82 @@
+/*=========================================================================
+
+  Copyright Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   vtkITK
+
+==========================================================================*/
+
+#ifndef __vtkITKImageHistogramCache_h
+#define __vtkITKImageHistogramCache_h
+
+#include "vtkITK.h"
+
+// VTK includes
+#include <vtkObject.h>
+
+class vtkIdTypeArray;
+class vtkImageData;
+
+/// \brief Histograms of images, shared by all components that need them.
+///
+/// Automatic window/level of scalar volume display nodes and automatic threshold
+/// computation (vtkITKImageThresholdCalculator, used by the Threshold segment editor effect)
+/// all need the histogram of the same volume. They get it from this class, so that it is
+/// computed only once. Histograms are computed in parallel, each thread processing a slab
+/// of slices, and they are kept until the voxels are modified or deleted. The least recently
+/// used histograms are deleted when more than MaximumNumberOfHistograms are stored.
+///
+/// Histograms are computed from the first scalar component. Bins are centered at
+/// binOrigin + binIndex * binSpacing, the first bin is centered at the minimum and the
+/// last bin is centered at the maximum of the scalar range.
+class VTK_ITK_EXPORT vtkITKImageHistogramCache : public vtkObject
+{
+public:
+  static vtkITKImageHistogramCache* New();
+  vtkTypeMacro(vtkITKImageHistogramCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Get histogram of the image.
+  /// \param numberOfBins Number of bins. If 0, then for integer scalar types there is one bin per
+  ///   scalar value (if there are no more values than GetMaximumNumberOfAutomaticBins()), otherwise
+  ///   GetMaximumNumberOfAutomaticBins() bins are used.
+  /// \param maximumNumberOfSamples If larger than 0 and the image has more voxels, then
+  ///   voxels are sampled with the same rate along all axes, to use at most this many voxels.
+  /// \param binCounts Output array. Its size is set to the number of bins.
+  /// \param binOriginAndSpacing Output, center of the first bin and distance between bin centers.
+  /// \return True on success.
+  static bool GetHistogram(vtkImageData* image, int numberOfBins, vtkIdType maximumNumberOfSamples,
+    vtkIdTypeArray* binCounts, double binOriginAndSpacing[2]);
+
+  /// Get range of the image between the lower and upper percentiles (in 0-100 range)
+  /// of the voxel values. The histogram uses automatic bins (see GetHistogram).
+  /// \return True on success.
+  static bool GetPercentileRange(vtkImageData* image, double lowerPercentile, double upperPercentile,
+    vtkIdType maximumNumberOfSamples, double range[2]);
+
+  /// Delete the stored histograms of the image. If image is nullptr then all histograms are deleted.
+  static void Clear(vtkImageData* image = nullptr);
+
+  /// Maximum number of histograms that are kept. Default is 16.
+  static void SetMaximumNumberOfHistograms(int maximumNumberOfHistograms);
+  static int GetMaximumNumberOfHistograms();
+
+  /// Number of histograms currently stored.
+  static int GetNumberOfHistograms();
+
+  /// Maximum number of bins if the number of bins is chosen automatically.
+  static int GetMaximumNumberOfAutomaticBins() { return 65536; };
+
+protected:
+  vtkITKImageHistogramCache() = default;
+  ~vtkITKImageHistogramCache() override = default;
+
+private:
+  vtkITKImageHistogramCache(const vtkITKImageHistogramCache&) = delete;
+  void operator=(const vtkITKImageHistogramCache&) = delete;
+};
+
+#endif
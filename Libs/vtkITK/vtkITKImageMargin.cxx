@@ -28,12 +28,21 @@
 #include <vtkMath.h>
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 
 /// ITK includes
 #include <itkBinaryThresholdImageFilter.h>
 #include <itkCommand.h>
 #include <itkSignedMaurerDistanceMapImageFilter.h>
 
+/// STD includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 vtkStandardNewMacro(vtkITKImageMargin);
 
 //----------------------------------------------------------------------------
@@ -50,6 +59,7 @@ vtkITKImageMargin::~vtkITKImageMargin() = default;
 void vtkITKImageMargin::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "UseParallelDistanceTransform: " << this->UseParallelDistanceTransform << std::endl;
 }
 
 //----------------------------------------------------------------------------
@@ -93,6 +103,239 @@ sdfMargin(itk::SmartPointer<ImageType> labelImage, int backgroundValue, double i
   return sdfTh->GetOutput();
 }
 
+//----------------------------------------------------------------------------
+// Squared Euclidean distance transform of a line, computed in place as the lower envelope
+// of parabolas rooted at each voxel (Felzenszwalb and Huttenlocher, 2012).
+// Values of voxels that are not reachable from any feature must be infinite.
+// f, v, z are work buffers, to avoid memory reallocation for each line.
+void distanceTransformLine(float* values, vtkIdType stride, int numberOfValues, double spacing,
+  std::vector<double>& f, std::vector<int>& v, std::vector<double>& z)
+{
+  const double infinity = std::numeric_limits<double>::infinity();
+  f.resize(numberOfValues);
+  v.resize(numberOfValues);
+  z.resize(numberOfValues);
+  for (int q = 0; q < numberOfValues; ++q)
+    {
+    f[q] = values[q * stride];
+    }
+
+  // Compute lower envelope. z[k] is the position where parabola k becomes the lowest.
+  int k = -1;
+  for (int q = 0; q < numberOfValues; ++q)
+    {
+    if (f[q] == infinity)
+      {
+      continue;
+      }
+    const double positionQ = q * spacing;
+    const double heightQ = f[q] + positionQ * positionQ;
+    double intersection = -infinity;
+    while (k >= 0)
+      {
+      const double positionV = v[k] * spacing;
+      intersection = (heightQ - (f[v[k]] + positionV * positionV)) / (2.0 * (positionQ - positionV));
+      if (intersection > z[k])
+        {
+        break;
+        }
+      --k;
+      intersection = -infinity;
+      }
+    ++k;
+    v[k] = q;
+    z[k] = intersection;
+    }
+  if (k < 0)
+    {
+    // no features in this line
+    return;
+    }
+
+  // Sample the lower envelope
+  int envelopeIndex = 0;
+  for (int p = 0; p < numberOfValues; ++p)
+    {
+    const double position = p * spacing;
+    while (envelopeIndex < k && z[envelopeIndex + 1] < position)
+      {
+      ++envelopeIndex;
+      }
+    const double offset = position - v[envelopeIndex] * spacing;
+    values[p * stride] = static_cast<float>(f[v[envelopeIndex]] + offset * offset);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Compute the same margin as sdfMargin, using a separable distance transform that is
+// restricted to the extent of the foreground padded by the outer margin.
+// Same as in itk::SignedMaurerDistanceMapImageFilter, distances are computed to the
+// contour of the foreground, which consists of foreground voxels that have a background
+// voxel among their 26 neighbors. Distance is negative inside the foreground.
+template <class T>
+void parallelMargin(const T* inPtr, T* outPtr, const int dims[3], const double spacing[3],
+  double backgroundValue, double innerMarginMM, double outerMarginMM)
+{
+  innerMarginMM -= std::numeric_limits<double>::epsilon();
+  outerMarginMM += std::numeric_limits<double>::epsilon();
+  // Same threshold type as the ITK filter, to get the same result at voxels that are exactly at the margin
+  const float upperThreshold = static_cast<float>(outerMarginMM * std::abs(outerMarginMM));
+  const bool useLowerThreshold = (innerMarginMM > vtkMath::NegInf());
+  const float lowerThreshold = useLowerThreshold ? static_cast<float>(innerMarginMM * std::abs(innerMarginMM)) : 0.0f;
+  const T background = static_cast<T>(backgroundValue);
+  const T insideValue = std::numeric_limits<T>::max();
+  const vtkIdType sliceSize = static_cast<vtkIdType>(dims[0]) * dims[1];
+  const vtkIdType numberOfRows = static_cast<vtkIdType>(dims[1]) * dims[2];
+
+  // Find extent of the foreground
+  const std::array<int, 6> emptyExtent = { { dims[0], -1, dims[1], -1, dims[2], -1 } };
+  vtkSMPThreadLocal<std::array<int, 6> > threadForegroundExtents(emptyExtent);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    std::array<int, 6>& localExtent = threadForegroundExtents.Local();
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      const T* rowPtr = inPtr + row * dims[0];
+      int firstIndex = 0;
+      while (firstIndex < dims[0] && rowPtr[firstIndex] == background)
+        {
+        ++firstIndex;
+        }
+      if (firstIndex == dims[0])
+        {
+        continue;
+        }
+      int lastIndex = dims[0] - 1;
+      while (rowPtr[lastIndex] == background)
+        {
+        --lastIndex;
+        }
+      const int j = static_cast<int>(row % dims[1]);
+      const int k = static_cast<int>(row / dims[1]);
+      localExtent[0] = std::min(localExtent[0], firstIndex);
+      localExtent[1] = std::max(localExtent[1], lastIndex);
+      localExtent[2] = std::min(localExtent[2], j);
+      localExtent[3] = std::max(localExtent[3], j);
+      localExtent[4] = std::min(localExtent[4], k);
+      localExtent[5] = std::max(localExtent[5], k);
+      }
+    });
+  std::array<int, 6> foregroundExtent = emptyExtent;
+  for (const std::array<int, 6>& localExtent : threadForegroundExtents)
+    {
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      foregroundExtent[axis * 2] = std::min(foregroundExtent[axis * 2], localExtent[axis * 2]);
+      foregroundExtent[axis * 2 + 1] = std::max(foregroundExtent[axis * 2 + 1], localExtent[axis * 2 + 1]);
+      }
+    }
+  if (foregroundExtent[1] < foregroundExtent[0])
+    {
+    // No foreground, all voxels are infinitely far from the contour
+    std::fill(outPtr, outPtr + sliceSize * dims[2], static_cast<T>(0));
+    return;
+    }
+
+  // Voxels that are farther from the foreground extent than the outer margin along any axis
+  // cannot be within the margin.
+  int extent[6] = { 0 };
+  int regionDims[3] = { 0 };
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    const int padding = static_cast<int>(std::floor(std::max(outerMarginMM, 0.0) / spacing[axis])) + 1;
+    extent[axis * 2] = std::max(0, foregroundExtent[axis * 2] - padding);
+    extent[axis * 2 + 1] = std::min(dims[axis] - 1, foregroundExtent[axis * 2 + 1] + padding);
+    regionDims[axis] = extent[axis * 2 + 1] - extent[axis * 2] + 1;
+    }
+  const vtkIdType regionSliceSize = static_cast<vtkIdType>(regionDims[0]) * regionDims[1];
+  std::vector<float> squaredDistances(regionSliceSize * regionDims[2]);
+
+  // Mark contour voxels as features
+  auto isBackground = [&](int i, int j, int k)
+    {
+    return inPtr[k * sliceSize + static_cast<vtkIdType>(j) * dims[0] + i] == background;
+    };
+  vtkSMPTools::For(0, static_cast<vtkIdType>(regionDims[1]) * regionDims[2], [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      const int j = extent[2] + static_cast<int>(row % regionDims[1]);
+      const int k = extent[4] + static_cast<int>(row / regionDims[1]);
+      float* distancePtr = &squaredDistances[row * regionDims[0]];
+      for (int i = extent[0]; i <= extent[1]; ++i, ++distancePtr)
+        {
+        *distancePtr = std::numeric_limits<float>::infinity();
+        if (isBackground(i, j, k))
+          {
+          continue;
+          }
+        bool contour = false;
+        for (int dk = std::max(k - 1, 0); dk <= std::min(k + 1, dims[2] - 1) && !contour; ++dk)
+          {
+          for (int dj = std::max(j - 1, 0); dj <= std::min(j + 1, dims[1] - 1) && !contour; ++dj)
+            {
+            for (int di = std::max(i - 1, 0); di <= std::min(i + 1, dims[0] - 1) && !contour; ++di)
+              {
+              contour = isBackground(di, dj, dk);
+              }
+            }
+          }
+        if (contour)
+          {
+          *distancePtr = 0.0f;
+          }
+        }
+      }
+    });
+
+  // Separable distance transform, one pass along each axis
+  const vtkIdType strides[3] = { 1, regionDims[0], regionSliceSize };
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    const int otherAxis1 = (axis == 0 ? 1 : 0);
+    const int otherAxis2 = (axis == 2 ? 1 : 2);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(regionDims[otherAxis1]) * regionDims[otherAxis2], [&](vtkIdType beginLine, vtkIdType endLine)
+      {
+      std::vector<double> f;
+      std::vector<int> v;
+      std::vector<double> z;
+      for (vtkIdType line = beginLine; line < endLine; ++line)
+        {
+        const vtkIdType index1 = line % regionDims[otherAxis1];
+        const vtkIdType index2 = line / regionDims[otherAxis1];
+        float* linePtr = &squaredDistances[index1 * strides[otherAxis1] + index2 * strides[otherAxis2]];
+        distanceTransformLine(linePtr, strides[axis], regionDims[axis], spacing[axis], f, v, z);
+        }
+      });
+    }
+
+  // Threshold the signed squared distance
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      T* outRowPtr = outPtr + row * dims[0];
+      std::fill(outRowPtr, outRowPtr + dims[0], static_cast<T>(0));
+      const int j = static_cast<int>(row % dims[1]);
+      const int k = static_cast<int>(row / dims[1]);
+      if (j < extent[2] || j > extent[3] || k < extent[4] || k > extent[5])
+        {
+        continue;
+        }
+      const T* inRowPtr = inPtr + row * dims[0];
+      const float* distancePtr = &squaredDistances[(k - extent[4]) * regionSliceSize + static_cast<vtkIdType>(j - extent[2]) * regionDims[0]];
+      for (int i = extent[0]; i <= extent[1]; ++i, ++distancePtr)
+        {
+        const float signedSquaredDistance = (inRowPtr[i] == background) ? *distancePtr : -*distancePtr;
+        if (signedSquaredDistance <= upperThreshold && (!useLowerThreshold || signedSquaredDistance >= lowerThreshold))
+          {
+          outRowPtr[i] = insideValue;
+          }
+        }
+      }
+    });
+}
+
 //----------------------------------------------------------------------------
 template <class T>
 void vtkITKImageMarginExecute(vtkITKImageMargin *self, vtkImageData* input,
@@ -130,6 +373,16 @@ void vtkITKImageMarginExecute(vtkITKImageMargin *self, vtkImageData* input,
       innerMarginDistance = self->GetInnerMarginMM();
       outerMarginDistance = self->GetOuterMarginMM();
       }
+    else
+      {
+      spacing[0] = spacing[1] = spacing[2] = 1.0;
+      }
+
+    if (self->GetUseParallelDistanceTransform() && vtkMath::IsFinite(outerMarginDistance))
+      {
+      parallelMargin<T>(inPtr, outPtr, dims, spacing, self->GetBackgroundValue(), innerMarginDistance, outerMarginDistance);
+      return;
+      }
 
     itk::SmartPointer<ImageType> outputImage;
     outputImage = sdfMargin<ImageType>(inImage, self->GetBackgroundValue(), innerMarginDistance, outerMarginDistance);
@@ -69,6 +69,16 @@ class VTK_ITK_EXPORT vtkITKImageMargin : public vtkSimpleImageToImageFilter
   vtkGetMacro(InnerMarginVoxels, double);
   vtkSetMacro(InnerMarginVoxels, double);
 
+  /// If enabled then the distance map is computed by a multi-threaded separable
+  /// Euclidean distance transform (lower envelope of parabolas along each axis) instead of
+  /// the ITK signed Maurer distance map filter. The distance transform is only computed
+  /// within the extent of the foreground, padded by the outer margin, therefore it is much
+  /// faster for small margins of small segments. The result is the same as the ITK filter.
+  /// Disabled by default.
+  vtkGetMacro(UseParallelDistanceTransform, bool);
+  vtkSetMacro(UseParallelDistanceTransform, bool);
+  vtkBooleanMacro(UseParallelDistanceTransform, bool);
+
 protected:
   int BackgroundValue{0};
   bool CalculateMarginInMM{true};
@@ -76,6 +86,7 @@ protected:
   double InnerMarginMM{0.0};
   double OuterMarginVoxels{0.0};
   double InnerMarginVoxels{0.0};
+  bool UseParallelDistanceTransform{false};
 
 protected:
   vtkITKImageMargin();
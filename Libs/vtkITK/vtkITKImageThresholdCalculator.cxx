@@ -13,14 +13,14 @@
 ==========================================================================*/
 
 // vtkITK includes
+#include "vtkITKImageHistogramCache.h"
 #include "vtkITKImageThresholdCalculator.h"
 
 // VTK includes
 #include <vtkDataArray.h>
-#include <vtkImageExport.h>
+#include <vtkIdTypeArray.h>
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
-#include <vtkITKUtility.h>
 #include <vtkNew.h>
 #include <vtkPointData.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
@@ -30,9 +30,9 @@
 //#include <vtksys/SystemTools.hxx>
 
 // ITK includes
+#include "itkHistogram.h"
 #include "itkHistogramThresholdCalculator.h"
 #include "itkHuangThresholdCalculator.h"
-#include "itkImageToHistogramFilter.h"
 #include "itkIntermodesThresholdCalculator.h"
 #include "itkIsoDataThresholdCalculator.h"
 #include "itkKittlerIllingworthThresholdCalculator.h"
@@ -43,42 +43,43 @@
 #include "itkRenyiEntropyThresholdCalculator.h"
 #include "itkShanbhagThresholdCalculator.h"
 #include "itkTriangleThresholdCalculator.h"
-#include "itkVTKImageImport.h"
 #include "itkYenThresholdCalculator.h"
 
 vtkStandardNewMacro(vtkITKImageThresholdCalculator);
 
-// helper function
-template <class TPixelType>
-void ITKComputeThresholdFromVTKImage(vtkITKImageThresholdCalculator *self, vtkImageData *inputImage, double& computedThreshold)
+//----------------------------------------------------------------------------
+void vtkITKImageThresholdCalculator::ComputeThresholdFromImage(vtkImageData *inputImage)
 {
-  typedef itk::Image<TPixelType, 3> ImageType;
-  typedef itk::Statistics::ImageToHistogramFilter<ImageType> HistogramGeneratorType;
-  typedef typename HistogramGeneratorType::HistogramType HistogramType;
+  typedef itk::Statistics::Histogram<double> HistogramType;
   typedef itk::HistogramThresholdCalculator<HistogramType, double> CalculatorType;
 
-  // itk import for input itk images
-  typedef typename itk::VTKImageImport<ImageType> ImageImportType;
-  typename ImageImportType::Pointer itkImporter = ImageImportType::New();
-
-  // vtk export for  vtk image
-  vtkNew<vtkImageExport> vtkExporter;
-
-  vtkExporter->SetInputData ( inputImage );
-
-  ConnectPipelines(vtkExporter.GetPointer(), itkImporter);
-  itkImporter->UpdateLargestPossibleRegion();
-
-  typename HistogramGeneratorType::Pointer histGenerator = HistogramGeneratorType::New();
-  histGenerator->SetInput(itkImporter->GetOutput());
-  typename HistogramGeneratorType::HistogramSizeType hsize(1);
-  hsize[0] = 64;
-  histGenerator->SetHistogramSize( hsize );
-  histGenerator->SetAutoMinimumMaximum( true );
+  // The histogram is shared with other consumers and reused until the input image is modified
+  // (e.g., when trying different threshold methods).
+  const int numberOfBins = 64;
+  vtkNew<vtkIdTypeArray> binCounts;
+  double binOriginAndSpacing[2] = { 0.0, 1.0 };
+  if (!vtkITKImageHistogramCache::GetHistogram(inputImage, numberOfBins, 0, binCounts, binOriginAndSpacing))
+    {
+    vtkErrorMacro("Failed to compute histogram");
+    return;
+    }
+  HistogramType::Pointer histogram = HistogramType::New();
+  HistogramType::SizeType size(1);
+  size[0] = binCounts->GetNumberOfValues();
+  HistogramType::MeasurementVectorType lowerBound(1);
+  HistogramType::MeasurementVectorType upperBound(1);
+  lowerBound[0] = binOriginAndSpacing[0] - binOriginAndSpacing[1] / 2.0;
+  upperBound[0] = lowerBound[0] + binCounts->GetNumberOfValues() * binOriginAndSpacing[1];
+  histogram->SetMeasurementVectorSize(1);
+  histogram->Initialize(size, lowerBound, upperBound);
+  for (vtkIdType binIndex = 0; binIndex < binCounts->GetNumberOfValues(); ++binIndex)
+    {
+    histogram->SetFrequency(binIndex, binCounts->GetValue(binIndex));
+    }
 
   // Create and initialize the calculator
-  typename CalculatorType::Pointer calculator;
-  switch (self->GetMethod())
+  CalculatorType::Pointer calculator;
+  switch (this->Method)
     {
     case vtkITKImageThresholdCalculator::METHOD_HUANG: calculator = itk::HuangThresholdCalculator<HistogramType>::New(); break;
     case vtkITKImageThresholdCalculator::METHOD_INTERMODES: calculator = itk::IntermodesThresholdCalculator<HistogramType>::New(); break;
@@ -93,11 +94,11 @@ void ITKComputeThresholdFromVTKImage(vtkITKImageThresholdCalculator *self, vtkIm
     case vtkITKImageThresholdCalculator::METHOD_TRIANGLE: calculator = itk::TriangleThresholdCalculator<HistogramType>::New(); break;
     case vtkITKImageThresholdCalculator::METHOD_YEN: calculator = itk::YenThresholdCalculator<HistogramType>::New(); break;
     default:
-      vtkErrorWithObjectMacro(self, "ITKComputeThresholdFromVTKImage failed: invalid method: " << self->GetMethod());
+      vtkErrorMacro("ComputeThresholdFromImage failed: invalid method: " << this->Method);
       return;
     }
 
-  calculator->SetInput( histGenerator->GetOutput() );
+  calculator->SetInput( histogram );
 
   try
     {
@@ -105,11 +106,11 @@ void ITKComputeThresholdFromVTKImage(vtkITKImageThresholdCalculator *self, vtkIm
     }
   catch (itk::ExceptionObject &err)
     {
-    vtkErrorWithObjectMacro(self, "Failed to compute threshold value using method " << self->GetMethodAsString(self->GetMethod())
+    vtkErrorMacro("Failed to compute threshold value using method " << this->GetMethodAsString(this->Method)
       << ". Details: " << err);
     }
 
-  computedThreshold = calculator->GetThreshold();
+  this->Threshold = calculator->GetThreshold();
 }
 
 //----------------------------------------------------------------------------
@@ -122,6 +123,12 @@ vtkITKImageThresholdCalculator::vtkITKImageThresholdCalculator()
 //----------------------------------------------------------------------------
 vtkITKImageThresholdCalculator::~vtkITKImageThresholdCalculator() = default;
 
+//----------------------------------------------------------------------------
+void vtkITKImageThresholdCalculator::ClearHistogramCache()
+{
+  vtkITKImageHistogramCache::Clear(this->GetImageDataInput(0));
+}
+
 //----------------------------------------------------------------------------
 void vtkITKImageThresholdCalculator::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -167,14 +174,7 @@ void vtkITKImageThresholdCalculator::Update()
     return;
     }
 
-  int inputDataType = pointData->GetScalars()->GetDataType();
-  switch (inputDataType)
-    {
-    vtkTemplateMacro(ITKComputeThresholdFromVTKImage<VTK_TT>(this, inputImage, this->Threshold));
-    default:
-      vtkErrorMacro("Execute: Unknown ScalarType" << inputDataType);
-      return;
-    }
+  this->ComputeThresholdFromImage(inputImage);
 }
 
 //----------------------------------------------------------------------------
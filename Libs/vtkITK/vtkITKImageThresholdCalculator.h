@@ -81,6 +81,12 @@ public:
   /// The main interface which triggers the writer to start.
   void Update() override;
 
+  /// Delete the stored histograms of the input image.
+  /// The histogram of the input is computed once by vtkITKImageHistogramCache and reused
+  /// by all threshold methods until the input image is modified or replaced, therefore
+  /// calling this method is only needed for releasing memory.
+  void ClearHistogramCache();
+
 protected:
   vtkITKImageThresholdCalculator();
   ~vtkITKImageThresholdCalculator() override;
@@ -88,6 +94,9 @@ protected:
   int Method;
   double Threshold;
 
+  /// Compute Threshold from the input image using the selected method
+  void ComputeThresholdFromImage(vtkImageData *inputImage);
+
 private:
   vtkITKImageThresholdCalculator(const vtkITKImageThresholdCalculator&) = delete;
   void operator=(const vtkITKImageThresholdCalculator&) = delete;
@@ -11,15 +11,133 @@
 #include "vtkObjectFactory.h"
 
 #include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
 #include "vtkPointData.h"
 #include "vtkImageData.h"
 #include "vtkAlgorithm.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include <vtkVersion.h>
 
 #include "itkConnectedComponentImageFilter.h"
 #include "itkRelabelComponentImageFilter.h"
 #include "itkCommand.h"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+namespace
+{
+/// Voxel count and bounding box of an island, in voxel index coordinates relative to the first voxel of the input
+struct IslandStatistics
+{
+  vtkIdType Size{0};
+  int Extent[6]{VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN};
+
+  void AddRun(int begin, int end, int j, int k)
+    {
+    this->Size += end - begin + 1;
+    this->Extent[0] = std::min(this->Extent[0], begin);
+    this->Extent[1] = std::max(this->Extent[1], end);
+    this->Extent[2] = std::min(this->Extent[2], j);
+    this->Extent[3] = std::max(this->Extent[3], j);
+    this->Extent[4] = std::min(this->Extent[4], k);
+    this->Extent[5] = std::max(this->Extent[5], k);
+    }
+
+  void Merge(const IslandStatistics& other)
+    {
+    this->Size += other.Size;
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      this->Extent[axis * 2] = std::min(this->Extent[axis * 2], other.Extent[axis * 2]);
+      this->Extent[axis * 2 + 1] = std::max(this->Extent[axis * 2 + 1], other.Extent[axis * 2 + 1]);
+      }
+    }
+};
+
+/// Run of non-zero voxels in a row, inclusive range of I indices
+struct IslandRun
+{
+  int Begin;
+  int End;
+};
+
+typedef std::vector<std::atomic<vtkIdType> > RunParentVector;
+
+//----------------------------------------------------------------------------
+/// Find the root of a run. Roots are always the run with the lowest index in the tree
+/// and parents only ever decrease, therefore the lock-free path halving is safe.
+vtkIdType FindRootRun(RunParentVector& parents, vtkIdType run)
+{
+  while (true)
+    {
+    vtkIdType parent = parents[run].load();
+    if (parent == run)
+      {
+      return run;
+      }
+    vtkIdType grandParent = parents[parent].load();
+    if (grandParent != parent)
+      {
+      parents[run].compare_exchange_weak(parent, grandParent);
+      }
+    run = grandParent;
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Merge the trees of two runs, linking the higher root under the lower root
+void UnionRuns(RunParentVector& parents, vtkIdType run1, vtkIdType run2)
+{
+  while (true)
+    {
+    run1 = FindRootRun(parents, run1);
+    run2 = FindRootRun(parents, run2);
+    if (run1 == run2)
+      {
+      return;
+      }
+    if (run1 < run2)
+      {
+      std::swap(run1, run2);
+      }
+    vtkIdType expectedParent = run1;
+    if (parents[run1].compare_exchange_strong(expectedParent, run2))
+      {
+      return;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void SetIslandStatistics(vtkITKIslandMath* self, const std::vector<IslandStatistics>& islands, const int inputExtent[6])
+{
+  vtkIdTypeArray* islandSizes = self->GetIslandSizes();
+  vtkIntArray* islandExtents = self->GetIslandExtents();
+  islandSizes->SetNumberOfTuples(islands.size());
+  islandExtents->SetNumberOfTuples(islands.size());
+  for (vtkIdType islandIndex = 0; islandIndex < static_cast<vtkIdType>(islands.size()); ++islandIndex)
+    {
+    const IslandStatistics& island = islands[islandIndex];
+    islandSizes->SetValue(islandIndex, island.Size);
+    int extent[6] = { 0, -1, 0, -1, 0, -1 };
+    if (island.Size > 0)
+      {
+      for (int i = 0; i < 6; ++i)
+        {
+        extent[i] = island.Extent[i] + inputExtent[(i / 2) * 2];
+        }
+      }
+    islandExtents->SetTypedTuple(islandIndex, extent);
+    }
+}
+
+} // end of anonymous namespace
+
 vtkStandardNewMacro(vtkITKIslandMath);
 
 vtkITKIslandMath::vtkITKIslandMath()
@@ -28,12 +146,25 @@ vtkITKIslandMath::vtkITKIslandMath()
   this->SliceBySlice = 0;
   this->MinimumSize = 0;
   this->MaximumSize = VTK_ID_MAX;
+  this->ParallelLabeling = false;
+  this->LabelingExtent[0] = 0;
+  this->LabelingExtent[1] = -1;
+  this->LabelingExtent[2] = 0;
+  this->LabelingExtent[3] = -1;
+  this->LabelingExtent[4] = 0;
+  this->LabelingExtent[5] = -1;
   this->NumberOfIslands = 0;
   this->OriginalNumberOfIslands = 0;
-
+  this->IslandSizes = vtkIdTypeArray::New();
+  this->IslandExtents = vtkIntArray::New();
+  this->IslandExtents->SetNumberOfComponents(6);
 }
 
-vtkITKIslandMath::~vtkITKIslandMath() = default;
+vtkITKIslandMath::~vtkITKIslandMath()
+{
+  this->IslandSizes->Delete();
+  this->IslandExtents->Delete();
+}
 
 void vtkITKIslandMath::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -43,6 +174,9 @@ void vtkITKIslandMath::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "SliceBySlice: " << SliceBySlice << std::endl;
   os << indent << "MinimumSize: " << MinimumSize << std::endl;
   os << indent << "MaximumSize: " << MaximumSize << std::endl;
+  os << indent << "ParallelLabeling: " << ParallelLabeling << std::endl;
+  os << indent << "LabelingExtent: " << LabelingExtent[0] << ", " << LabelingExtent[1] << ", "
+    << LabelingExtent[2] << ", " << LabelingExtent[3] << ", " << LabelingExtent[4] << ", " << LabelingExtent[5] << std::endl;
   os << indent << "NumberOfIslands: " << NumberOfIslands << std::endl;
   os << indent << "OriginalNumberOfIslands: " << OriginalNumberOfIslands << std::endl;
 }
@@ -117,6 +251,281 @@ void vtkITKIslandMathExecute(vtkITKIslandMath *self, vtkImageData* input,
   memcpy(outPtr, relabel->GetOutput()->GetBufferPointer(),
          relabel->GetOutput()->GetBufferedRegion().GetNumberOfPixels() * sizeof(T));
 
+  // Compute size and bounding box of each island
+  const vtkIdType numberOfIslands = static_cast<vtkIdType>(self->GetNumberOfIslands());
+  vtkSMPThreadLocal<std::vector<IslandStatistics> > threadIslands;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dims[1]) * dims[2], [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    std::vector<IslandStatistics>& islands = threadIslands.Local();
+    islands.resize(numberOfIslands);
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      const T* rowPtr = outPtr + row * dims[0];
+      const int j = static_cast<int>(row % dims[1]);
+      const int k = static_cast<int>(row / dims[1]);
+      for (int i = 0; i < dims[0]; ++i)
+        {
+        vtkIdType label = static_cast<vtkIdType>(rowPtr[i]);
+        if (label <= 0 || label > numberOfIslands)
+          {
+          continue;
+          }
+        int runEnd = i;
+        while (runEnd + 1 < dims[0] && rowPtr[runEnd + 1] == rowPtr[i])
+          {
+          ++runEnd;
+          }
+        islands[label - 1].AddRun(i, runEnd, j, k);
+        i = runEnd;
+        }
+      }
+    });
+  std::vector<IslandStatistics> islands(numberOfIslands);
+  for (const std::vector<IslandStatistics>& localIslands : threadIslands)
+    {
+    for (vtkIdType islandIndex = 0; islandIndex < static_cast<vtkIdType>(localIslands.size()); ++islandIndex)
+      {
+      islands[islandIndex].Merge(localIslands[islandIndex]);
+      }
+    }
+  SetIslandStatistics(self, islands, input->GetExtent());
+}
+
+//
+// Multi-threaded labeling. Non-zero voxels are grouped into runs along rows,
+// then runs of neighboring rows that touch are merged using a lock-free union-find.
+// Each island's root is its first run in raster order, which is used as tie-breaker
+// when sorting islands by size (same as ITK relabel filter).
+//
+template <class T>
+void vtkITKIslandMathParallelExecute(vtkITKIslandMath *self, vtkImageData* input,
+                vtkImageData* vtkNotUsed(output),
+                T* inPtr, T* outPtr)
+{
+  int dims[3];
+  input->GetDimensions(dims);
+  int* inputExtent = input->GetExtent();
+
+  // Labeling extent, relative to the first voxel of the input
+  int extent[6] = { 0, dims[0] - 1, 0, dims[1] - 1, 0, dims[2] - 1 };
+  int* labelingExtent = self->GetLabelingExtent();
+  if (labelingExtent[0] <= labelingExtent[1] && labelingExtent[2] <= labelingExtent[3] && labelingExtent[4] <= labelingExtent[5])
+    {
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      extent[axis * 2] = std::max(extent[axis * 2], labelingExtent[axis * 2] - inputExtent[axis * 2]);
+      extent[axis * 2 + 1] = std::min(extent[axis * 2 + 1], labelingExtent[axis * 2 + 1] - inputExtent[axis * 2]);
+      }
+    }
+  const bool emptyExtent = (extent[0] > extent[1] || extent[2] > extent[3] || extent[4] > extent[5]);
+  const int rowsPerSlice = emptyExtent ? 0 : extent[3] - extent[2] + 1;
+  const vtkIdType numberOfRows = emptyExtent ? 0 : static_cast<vtkIdType>(rowsPerSlice) * (extent[5] - extent[4] + 1);
+
+  // Collect runs of non-zero voxels of each row in the labeling extent
+  std::vector<vtkIdType> rowRunOffsets(numberOfRows + 1, 0);
+  auto getRowPtr = [&](vtkIdType row)
+    {
+    vtkIdType j = extent[2] + row % rowsPerSlice;
+    vtkIdType k = extent[4] + row / rowsPerSlice;
+    return inPtr + (k * dims[1] + j) * dims[0];
+    };
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      const T* rowPtr = getRowPtr(row);
+      vtkIdType numberOfRuns = 0;
+      bool previousInside = false;
+      for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+        bool inside = (rowPtr[i] != 0);
+        if (inside && !previousInside)
+          {
+          ++numberOfRuns;
+          }
+        previousInside = inside;
+        }
+      rowRunOffsets[row + 1] = numberOfRuns;
+      }
+    });
+  for (vtkIdType row = 0; row < numberOfRows; ++row)
+    {
+    rowRunOffsets[row + 1] += rowRunOffsets[row];
+    }
+  const vtkIdType numberOfRuns = rowRunOffsets[numberOfRows];
+  std::vector<IslandRun> runs(numberOfRuns);
+  RunParentVector runParents(numberOfRuns);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      const T* rowPtr = getRowPtr(row);
+      vtkIdType runIndex = rowRunOffsets[row];
+      for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+        if (rowPtr[i] == 0)
+          {
+          continue;
+          }
+        IslandRun& run = runs[runIndex];
+        run.Begin = i;
+        while (i + 1 <= extent[1] && rowPtr[i + 1] != 0)
+          {
+          ++i;
+          }
+        run.End = i;
+        runParents[runIndex].store(runIndex);
+        ++runIndex;
+        }
+      }
+    });
+  self->UpdateProgress(0.3);
+
+  // Merge runs with the touching runs of preceding neighbor rows
+  const bool fullyConnected = (self->GetFullyConnected() != 0);
+  const int overlapTolerance = fullyConnected ? 1 : 0;
+  // (j, k) offsets of neighbor rows that precede the current row in raster order
+  const int fullyConnectedNeighborRows[4][2] = { { -1, 0 }, { -1, -1 }, { 0, -1 }, { 1, -1 } };
+  const int faceConnectedNeighborRows[2][2] = { { -1, 0 }, { 0, -1 } };
+  const int (*neighborRows)[2] = fullyConnected ? fullyConnectedNeighborRows : faceConnectedNeighborRows;
+  const int numberOfNeighborRows = fullyConnected ? 4 : 2;
+  const int numberOfSlices = emptyExtent ? 0 : extent[5] - extent[4] + 1;
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      if (rowRunOffsets[row] == rowRunOffsets[row + 1])
+        {
+        continue;
+        }
+      const int j = static_cast<int>(row % rowsPerSlice);
+      const int k = static_cast<int>(row / rowsPerSlice);
+      for (int neighborIndex = 0; neighborIndex < numberOfNeighborRows; ++neighborIndex)
+        {
+        const int neighborJ = j + neighborRows[neighborIndex][0];
+        const int neighborK = k + neighborRows[neighborIndex][1];
+        if (neighborJ < 0 || neighborJ >= rowsPerSlice || neighborK < 0 || neighborK >= numberOfSlices)
+          {
+          continue;
+          }
+        const vtkIdType neighborRow = static_cast<vtkIdType>(neighborK) * rowsPerSlice + neighborJ;
+        vtkIdType runIndex = rowRunOffsets[row];
+        vtkIdType neighborRunIndex = rowRunOffsets[neighborRow];
+        while (runIndex < rowRunOffsets[row + 1] && neighborRunIndex < rowRunOffsets[neighborRow + 1])
+          {
+          const IslandRun& run = runs[runIndex];
+          const IslandRun& neighborRun = runs[neighborRunIndex];
+          if (run.Begin <= neighborRun.End + overlapTolerance && neighborRun.Begin <= run.End + overlapTolerance)
+            {
+            UnionRuns(runParents, runIndex, neighborRunIndex);
+            }
+          if (run.End < neighborRun.End)
+            {
+            ++runIndex;
+            }
+          else
+            {
+            ++neighborRunIndex;
+            }
+          }
+        }
+      }
+    });
+  self->UpdateProgress(0.6);
+
+  // Resolve the root run of each run
+  std::vector<vtkIdType> runIslands(numberOfRuns);
+  vtkSMPTools::For(0, numberOfRuns, [&](vtkIdType beginRun, vtkIdType endRun)
+    {
+    for (vtkIdType runIndex = beginRun; runIndex < endRun; ++runIndex)
+      {
+      runIslands[runIndex] = FindRootRun(runParents, runIndex);
+      }
+    });
+
+  // Number the islands in raster order and compute their size and bounding box.
+  // Roots precede all the other runs of their island, so the island index of the root
+  // is already known when it is referenced. This pass is linear in the number of runs.
+  std::vector<IslandStatistics> islands;
+  for (vtkIdType row = 0; row < numberOfRows; ++row)
+    {
+    const int j = extent[2] + static_cast<int>(row % rowsPerSlice);
+    const int k = extent[4] + static_cast<int>(row / rowsPerSlice);
+    for (vtkIdType runIndex = rowRunOffsets[row]; runIndex < rowRunOffsets[row + 1]; ++runIndex)
+      {
+      vtkIdType rootRun = runIslands[runIndex];
+      vtkIdType islandIndex = 0;
+      if (rootRun == runIndex)
+        {
+        islandIndex = static_cast<vtkIdType>(islands.size());
+        islands.emplace_back();
+        }
+      else
+        {
+        islandIndex = runIslands[rootRun];
+        }
+      runIslands[runIndex] = islandIndex;
+      islands[islandIndex].AddRun(runs[runIndex].Begin, runs[runIndex].End, j, k);
+      }
+    }
+
+  // Filter islands by size and sort them by decreasing size
+  std::vector<vtkIdType> keptIslands;
+  for (vtkIdType islandIndex = 0; islandIndex < static_cast<vtkIdType>(islands.size()); ++islandIndex)
+    {
+    vtkIdType size = islands[islandIndex].Size;
+    if (size >= self->GetMinimumSize() && size <= self->GetMaximumSize())
+      {
+      keptIslands.push_back(islandIndex);
+      }
+    }
+  std::stable_sort(keptIslands.begin(), keptIslands.end(), [&](vtkIdType island1, vtkIdType island2)
+    {
+    return islands[island1].Size > islands[island2].Size;
+    });
+  if (keptIslands.size() > static_cast<size_t>(std::numeric_limits<T>::max()))
+    {
+    vtkErrorWithObjectMacro(self, "vtkITKIslandMath: number of islands (" << keptIslands.size()
+      << ") exceeds the maximum value of the scalar type");
+    keptIslands.clear();
+    }
+  std::vector<T> islandLabels(islands.size(), 0);
+  std::vector<IslandStatistics> keptIslandStatistics;
+  for (size_t keptIndex = 0; keptIndex < keptIslands.size(); ++keptIndex)
+    {
+    islandLabels[keptIslands[keptIndex]] = static_cast<T>(keptIndex + 1);
+    keptIslandStatistics.push_back(islands[keptIslands[keptIndex]]);
+    }
+  self->SetOriginalNumberOfIslands(static_cast<unsigned long>(islands.size()));
+  self->SetNumberOfIslands(static_cast<unsigned long>(keptIslands.size()));
+  SetIslandStatistics(self, keptIslandStatistics, inputExtent);
+  self->UpdateProgress(0.8);
+
+  // Write the output
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dims[1]) * dims[2], [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType fullRow = beginRow; fullRow < endRow; ++fullRow)
+      {
+      T* rowPtr = outPtr + fullRow * dims[0];
+      std::fill(rowPtr, rowPtr + dims[0], static_cast<T>(0));
+      const int j = static_cast<int>(fullRow % dims[1]);
+      const int k = static_cast<int>(fullRow / dims[1]);
+      if (emptyExtent || j < extent[2] || j > extent[3] || k < extent[4] || k > extent[5])
+        {
+        continue;
+        }
+      const vtkIdType row = static_cast<vtkIdType>(k - extent[4]) * rowsPerSlice + (j - extent[2]);
+      for (vtkIdType runIndex = rowRunOffsets[row]; runIndex < rowRunOffsets[row + 1]; ++runIndex)
+        {
+        T label = islandLabels[runIslands[runIndex]];
+        if (label != 0)
+          {
+          std::fill(rowPtr + runs[runIndex].Begin, rowPtr + runs[runIndex].End + 1, label);
+          }
+        }
+      }
+    });
+  self->UpdateProgress(1.0);
 }
 
 
@@ -152,7 +561,15 @@ void vtkITKIslandMath::SimpleExecute(vtkImageData *input, vtkImageData *output)
 #undef VTK_TYPE_USE_LONG_LONG
 #undef VTK_TYPE_USE___INT64
 
-#define CALL  vtkITKIslandMathExecute(this, input, output, static_cast<VTK_TT *>(inPtr), static_cast<VTK_TT *>(outPtr));
+#define CALL \
+  if (this->ParallelLabeling) \
+    { \
+    vtkITKIslandMathParallelExecute(this, input, output, static_cast<VTK_TT *>(inPtr), static_cast<VTK_TT *>(outPtr)); \
+    } \
+  else \
+    { \
+    vtkITKIslandMathExecute(this, input, output, static_cast<VTK_TT *>(inPtr), static_cast<VTK_TT *>(outPtr)); \
+    }
 
     void* inPtr = input->GetScalarPointer();
     void* outPtr = output->GetScalarPointer();
@@ -13,10 +13,17 @@
 #include "vtkITK.h"
 #include "vtkSimpleImageToImageFilter.h"
 
+class vtkIdTypeArray;
+class vtkIntArray;
+
 /// \brief ITK-based utilities for manipulating connected regions in label maps.
 /// Limitation: The filter does not work correctly with input volume that has
 /// unsigned long scalar type on Linux and macOS.
 ///
+/// Islands are labeled in decreasing order of size (largest island is 1).
+/// Size and bounding box of each island is available after execution
+/// via GetIslandSizes() and GetIslandExtents().
+///
 class VTK_ITK_EXPORT vtkITKIslandMath : public vtkSimpleImageToImageFilter
 {
  public:
@@ -37,9 +44,25 @@ class VTK_ITK_EXPORT vtkITKIslandMath : public vtkSimpleImageToImageFilter
 
   ///
   /// Maximum island size (in pixels).  Islands larger than this are ignored.
+  /// Only used if ParallelLabeling is enabled.
   vtkGetMacro(MaximumSize, vtkIdType);
   vtkSetMacro(MaximumSize, vtkIdType);
 
+  ///
+  /// If enabled then islands are identified by a multi-threaded union-find of the
+  /// runs of non-zero voxels instead of ITK connected component and relabel filters.
+  /// Islands are filtered by size during labeling. Disabled by default.
+  vtkGetMacro(ParallelLabeling, bool);
+  vtkSetMacro(ParallelLabeling, bool);
+  vtkBooleanMacro(ParallelLabeling, bool);
+
+  ///
+  /// Restrict labeling to this extent of the input image. Voxels outside are set to 0.
+  /// If the extent is empty (default) then the whole input is labeled.
+  /// Only used if ParallelLabeling is enabled.
+  vtkGetVector6Macro(LabelingExtent, int);
+  vtkSetVector6Macro(LabelingExtent, int);
+
   ///
   /// TODO: Not yet implemented
   /// If zero, islands are defined by 3D connectivity
@@ -58,6 +81,14 @@ class VTK_ITK_EXPORT vtkITKIslandMath : public vtkSimpleImageToImageFilter
   vtkGetMacro(OriginalNumberOfIslands, unsigned long);
   vtkSetMacro(OriginalNumberOfIslands, unsigned long);
 
+  ///
+  /// Number of voxels of each island. The i-th tuple belongs to island label i+1.
+  vtkGetObjectMacro(IslandSizes, vtkIdTypeArray);
+  ///
+  /// Bounding box of each island (6 components, in IJK extent of the input image).
+  /// The i-th tuple belongs to island label i+1.
+  vtkGetObjectMacro(IslandExtents, vtkIntArray);
+
 
 protected:
   vtkITKIslandMath();
@@ -69,10 +100,15 @@ protected:
   int SliceBySlice;
   vtkIdType MinimumSize;
   vtkIdType MaximumSize;
+  bool ParallelLabeling;
+  int LabelingExtent[6];
 
   unsigned long NumberOfIslands;
   unsigned long OriginalNumberOfIslands;
 
+  vtkIdTypeArray* IslandSizes;
+  vtkIntArray* IslandExtents;
+
 private:
   vtkITKIslandMath(const vtkITKIslandMath&) = delete;
   void operator=(const vtkITKIslandMath&) = delete;
@@ -80,14 +80,31 @@ void vtkITKLevelTracing3DTrace(vtkITKLevelTracing3DImageFilter *vtkNotUsed(self)
   seedIndex[1] = seed[1];
   seedIndex[2] = seed[2];
 
+  if (!region.IsInside(seedIndex))
+    {
+    // nothing to trace
+    memset(oscalars, 0, static_cast<size_t>(dims[0])*dims[1]*dims[2]);
+    return;
+    }
   tracing->SetSeed(seedIndex);
 
+  // Label the surface directly in the output scalars
+  typename LabelImageType::Pointer labelImage = LabelImageType::New();
+  labelImage->GetPixelContainer()->SetImportPointer(oscalars, dims[0]*dims[1]*dims[2], false);
+  labelImage->SetOrigin( origin );
+  labelImage->SetSpacing( spacing );
+  labelImage->SetRegions( region );
+  tracing->GraftOutput( labelImage );
+
   tracing->SetInput( image );
   tracing->Update();
 
-  // Copy to the output
-  memcpy(oscalars, tracing->GetOutput()->GetBufferPointer(),
-         tracing->GetOutput()->GetBufferedRegion().GetNumberOfPixels());
+  if (tracing->GetOutput()->GetBufferPointer() != oscalars)
+    {
+    // the filter allocated its own buffer, copy to the output
+    memcpy(oscalars, tracing->GetOutput()->GetBufferPointer(),
+           tracing->GetOutput()->GetBufferedRegion().GetNumberOfPixels());
+    }
 
 }
 
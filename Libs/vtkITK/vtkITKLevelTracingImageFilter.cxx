@@ -24,11 +24,53 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
+#include "vtkWeakPointer.h"
 
 #include "itkExtractImageFilter.h"
 
+// STD includes
+#include <algorithm>
+
 vtkStandardNewMacro(vtkITKLevelTracingImageFilter);
 
+//----------------------------------------------------------------------------
+class vtkITKLevelTracingImageFilter::vtkInternal
+{
+public:
+  /// Return true if the cached slice was extracted from the same scalars
+  /// (same array, not modified since), plane and slice index.
+  bool IsSliceValid(vtkDataArray* scalars, int extent[6], int plane, int sliceIndex)
+  {
+    return this->Slice.IsNotNull()
+      && this->SliceSource.GetPointer() == scalars && scalars != nullptr
+      && this->SliceSourceMTime == scalars->GetMTime()
+      && this->SlicePlane == plane && this->SliceIndex == sliceIndex
+      && std::equal(extent, extent + 6, this->SliceExtent);
+  }
+
+  void SetSliceSource(vtkDataArray* scalars, int extent[6], int plane, int sliceIndex)
+  {
+    this->SliceSource = scalars;
+    this->SliceSourceMTime = scalars->GetMTime();
+    this->SlicePlane = plane;
+    this->SliceIndex = sliceIndex;
+    std::copy(extent, extent + 6, this->SliceExtent);
+  }
+
+  /// Extracted 2D slice (itk::Image<T,2>), reused while IsSliceValid returns true.
+  itk::DataObject::Pointer Slice;
+  vtkWeakPointer<vtkDataArray> SliceSource;
+  vtkMTimeType SliceSourceMTime{ 0 };
+  int SlicePlane{ -1 };
+  int SliceIndex{ 0 };
+  int SliceExtent[6]{ 0, -1, 0, -1, 0, -1 };
+
+  /// Grayscale conversion of RGB input scalars
+  vtkSmartPointer<vtkUnsignedCharArray> GrayScalars;
+  vtkWeakPointer<vtkDataArray> GrayScalarsSource;
+  vtkMTimeType GrayScalarsSourceMTime{ 0 };
+};
+
 // Description:
 // Construct object with initial range (0,1) and single contour value
 // of 0.0. ComputeNormal is on, ComputeGradients is off and ComputeScalars is on.
@@ -39,9 +81,14 @@ vtkITKLevelTracingImageFilter::vtkITKLevelTracingImageFilter()
   this->Seed[2] = 0;
 
   this->Plane = 2;  // Default to XY plane
+
+  this->Internal = new vtkInternal;
 }
 
-vtkITKLevelTracingImageFilter::~vtkITKLevelTracingImageFilter() = default;
+vtkITKLevelTracingImageFilter::~vtkITKLevelTracingImageFilter()
+{
+  delete this->Internal;
+}
 
 
 template <class T>
@@ -49,15 +96,11 @@ void vtkITKLevelTracingTrace(vtkITKLevelTracingImageFilter *vtkNotUsed(self), T*
                              int dims[3], int extent[6], double origin[3], double spacing[3],
                              vtkPoints *newPoints,
                              vtkCellArray *newPolys,
-                             int seed[3], int plane)
+                             int seed[3], int plane,
+                             itk::DataObject::Pointer& cachedSlice, bool cachedSliceValid)
 {
-
-  // Wrap scalars into an ITK image
   typedef itk::Image<T, 3> ImageType;
-  typename ImageType::Pointer image = ImageType::New();
-  image->GetPixelContainer()->SetImportPointer(scalars, dims[0]*dims[1]*dims[2], false);
-  image->SetOrigin( origin );
-  image->SetSpacing( spacing );
+  typedef itk::Image<T,2> Image2DType;
 
   typename ImageType::RegionType region;
   typename ImageType::IndexType index;
@@ -70,26 +113,16 @@ void vtkITKLevelTracingTrace(vtkITKLevelTracingImageFilter *vtkNotUsed(self), T*
   size[1] = extent[3] - extent[2] + 1;
   size[2] = extent[5] - extent[4] + 1;
   region.SetSize( size );
-  image->SetRegions(region);
-
-  // Extract the 2D slice to process
-  typedef itk::Image<T,2> Image2DType;
-  typedef itk::ExtractImageFilter<ImageType, Image2DType> ExtractType;
-  typename ExtractType::Pointer extract = ExtractType::New();
-  extract->SetDirectionCollapseToIdentity(); //If you don't care about resulting image dimension
-
-  typedef typename ExtractType::InputImageRegionType ExtractionRegionType;
-  ExtractionRegionType extractRegion;
-  typename ExtractionRegionType::IndexType extractIndex;
-  typename ExtractionRegionType::SizeType extractSize;
-
-  extractIndex = index;
-  extractSize = size;
-  extract->SetInput( image );
 
-  // Trace the level curve using itk::LevelTracingImageFilter
-  typedef itk::LevelTracingImageFilter<Image2DType, Image2DType> LevelTracingType;
-  typename LevelTracingType::Pointer tracing = LevelTracingType::New();
+  typename ImageType::IndexType seedIndex;
+  seedIndex[0] = seed[0];
+  seedIndex[1] = seed[1];
+  seedIndex[2] = seed[2];
+  if (!region.IsInside(seedIndex) || plane < 0 || plane > 2)
+    {
+    // nothing to trace (and the slice could not be extracted)
+    return;
+    }
 
   itk::Index<2> seed2D = {{0,0}};
   switch(plane)
@@ -97,30 +130,81 @@ void vtkITKLevelTracingTrace(vtkITKLevelTracingImageFilter *vtkNotUsed(self), T*
   case 0: //JK plane
     seed2D[0] = seed[1];
     seed2D[1] = seed[2];
-    extractSize[0] = 0;
-    extractIndex[0] = seed[0];
     break;
   case 1:  //IK plane
     seed2D[0] = seed[0];
     seed2D[1] = seed[2];
-    extractSize[1] = 0;
-    extractIndex[1] = seed[1];
     break;
   case 2:  //IJ plane (axials)
     seed2D[0] = seed[0];
     seed2D[1] = seed[1];
-    extractSize[2] = 0;
-    extractIndex[2] = seed[2];
     break;
   }
 
-  extractRegion.SetIndex( extractIndex );
-  extractRegion.SetSize( extractSize );
-  extract->SetExtractionRegion( extractRegion );
+  typename Image2DType::Pointer slice;
+  if (plane == 2)
+    {
+    // IJ slices are contiguous in memory, wrap them without copying
+    slice = Image2DType::New();
+    vtkIdType sliceSize = static_cast<vtkIdType>(dims[0]) * dims[1];
+    slice->GetPixelContainer()->SetImportPointer(
+      scalars + (seed[2] - extent[4]) * sliceSize, sliceSize, false);
+    double origin2D[2] = { origin[0], origin[1] };
+    double spacing2D[2] = { spacing[0], spacing[1] };
+    slice->SetOrigin( origin2D );
+    slice->SetSpacing( spacing2D );
+    typename Image2DType::RegionType region2D;
+    typename Image2DType::IndexType index2D = {{ extent[0], extent[2] }};
+    typename Image2DType::SizeType size2D = {{ size[0], size[1] }};
+    region2D.SetIndex( index2D );
+    region2D.SetSize( size2D );
+    slice->SetRegions( region2D );
+    }
+  else if (cachedSliceValid)
+    {
+    slice = dynamic_cast<Image2DType*>(cachedSlice.GetPointer());
+    }
 
+  if (slice.IsNull())
+    {
+    // Wrap scalars into an ITK image
+    typename ImageType::Pointer image = ImageType::New();
+    image->GetPixelContainer()->SetImportPointer(scalars, dims[0]*dims[1]*dims[2], false);
+    image->SetOrigin( origin );
+    image->SetSpacing( spacing );
+    image->SetRegions(region);
+
+    // Extract the 2D slice to process
+    typedef itk::ExtractImageFilter<ImageType, Image2DType> ExtractType;
+    typename ExtractType::Pointer extract = ExtractType::New();
+    extract->SetDirectionCollapseToIdentity(); //If you don't care about resulting image dimension
+
+    typedef typename ExtractType::InputImageRegionType ExtractionRegionType;
+    ExtractionRegionType extractRegion;
+    typename ExtractionRegionType::IndexType extractIndex = index;
+    typename ExtractionRegionType::SizeType extractSize = size;
+    extractSize[plane] = 0;
+    extractIndex[plane] = seed[plane];
+    extractRegion.SetIndex( extractIndex );
+    extractRegion.SetSize( extractSize );
+    extract->SetExtractionRegion( extractRegion );
+    extract->SetInput( image );
+    extract->Update();
+
+    // Keep the slice for tracing on the same slice again
+    slice = extract->GetOutput();
+    slice->DisconnectPipeline();
+    cachedSlice = slice.GetPointer();
+    }
+
+  // Trace the level curve using itk::LevelTracingImageFilter.
+  // Only the chain code is used, so the label image is not generated.
+  typedef itk::LevelTracingImageFilter<Image2DType, Image2DType> LevelTracingType;
+  typename LevelTracingType::Pointer tracing = LevelTracingType::New();
+  tracing->GenerateLabelImageOff();
   tracing->SetSeed(seed2D);
 
-  tracing->SetInput( extract->GetOutput() );
+  tracing->SetInput( slice );
   tracing->Update();
 
   // Convert chain code output to points and polys (remember to put
@@ -263,15 +347,27 @@ int vtkITKLevelTracingImageFilter::RequestData(
 #undef vtkTemplateMacroCase_ll
 # define vtkTemplateMacroCase_ll(typeN, type, call)
 #endif
+  // Reuse the previously extracted slice if tracing on the same slice again
+  vtkInternal* internal = this->Internal;
+  int sliceIndex = (this->Plane >= 0 && this->Plane <= 2) ? this->Seed[this->Plane] : 0;
+  bool cachedSliceValid = internal->IsSliceValid(inScalars, extent, this->Plane, sliceIndex);
+  if (!cachedSliceValid)
+    {
+    internal->Slice = nullptr;
+    internal->SetSliceSource(inScalars, extent, this->Plane, sliceIndex);
+    }
+
   if (inScalars->GetNumberOfComponents() == 1 )
   {
+    internal->GrayScalars = nullptr;
     void* scalars = inScalars->GetVoidPointer(0);
     switch (inScalars->GetDataType())
     {
       vtkTemplateMacro(
         vtkITKLevelTracingTrace(this, static_cast<VTK_TT*>(scalars),
         dims,extent,origin,spacing,
-        newPts,newPolys,this->Seed, this->Plane
+        newPts,newPolys,this->Seed, this->Plane,
+        internal->Slice, cachedSliceValid
         )
         );
     } //switch
@@ -279,25 +375,32 @@ int vtkITKLevelTracingImageFilter::RequestData(
   else if (inScalars->GetNumberOfComponents() == 3)
     {
     // RGB - convert for now...
-    vtkSmartPointer<vtkUnsignedCharArray> grayScalars
-      = vtkUnsignedCharArray::New();
-    grayScalars->SetNumberOfTuples( inScalars->GetNumberOfTuples() );
-
-    double in[3];
-    unsigned char out;
-    for (vtkIdType i=0; i < inScalars->GetNumberOfTuples(); ++i)
+    if (internal->GrayScalars == nullptr
+      || internal->GrayScalarsSource.GetPointer() != inScalars
+      || internal->GrayScalarsSourceMTime != inScalars->GetMTime())
       {
-      inScalars->GetTuple(i, in);
+      internal->GrayScalars = vtkSmartPointer<vtkUnsignedCharArray>::New();
+      internal->GrayScalars->SetNumberOfTuples( inScalars->GetNumberOfTuples() );
+      internal->GrayScalarsSource = inScalars;
+      internal->GrayScalarsSourceMTime = inScalars->GetMTime();
+
+      double in[3];
+      unsigned char out;
+      for (vtkIdType i=0; i < inScalars->GetNumberOfTuples(); ++i)
+        {
+        inScalars->GetTuple(i, in);
 
-      out = static_cast<unsigned char>((2125.0 * in[0] +  7154.0 * in[1] +  0721.0 * in[2]) / 10000.0);
+        out = static_cast<unsigned char>((2125.0 * in[0] +  7154.0 * in[1] +  0721.0 * in[2]) / 10000.0);
 
-      grayScalars->SetTypedTuple(i, &out);
+        internal->GrayScalars->SetTypedTuple(i, &out);
+        }
       }
 
     vtkITKLevelTracingTrace(this,
-                            (unsigned char *)grayScalars->GetVoidPointer(0),
+                            (unsigned char *)internal->GrayScalars->GetVoidPointer(0),
                             dims, extent, origin, spacing,
-                            newPts, newPolys, this->Seed, this->Plane);
+                            newPts, newPolys, this->Seed, this->Plane,
+                            internal->Slice, cachedSliceValid);
     }
   else
     {
@@ -16,6 +16,12 @@
 /// This filter is specialized to volumes. If you are interested in
 /// contouring other types of data, use the general vtkContourFilter. If you
 /// want to contour an image (i.e., a volume slice), use vtkMarchingSquares.
+///
+/// Tracing is typically repeated many times on the same slice (for example,
+/// to preview the contour while the mouse is moved), therefore IJ slices are
+/// traced directly in the input buffer and IK, JK slices (and the grayscale
+/// conversion of RGB images) are extracted only once and reused until the
+/// input scalars, the plane, or the slice index changes.
 class VTK_ITK_EXPORT vtkITKLevelTracingImageFilter : public vtkPolyDataAlgorithm
 {
 public:
@@ -45,6 +51,9 @@ protected:
   int Seed[3];
   int Plane;
 
+  class vtkInternal;
+  vtkInternal* Internal;
+
 private:
   vtkITKLevelTracingImageFilter(const vtkITKLevelTracingImageFilter&) = delete;
   void operator=(const vtkITKLevelTracingImageFilter&) = delete;
@@ -13,13 +13,55 @@
 #include "vtkDataArray.h"
 #include "vtkPointData.h"
 #include "vtkImageData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 
 #include "itkMorphologicalContourInterpolator.h"
 
+#include <algorithm>
+#include <array>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace
+{
+/// Bounding box of a label, in voxel index coordinates (IJK) of the input image
+typedef std::array<int, 6> LabelExtent;
+}
+
+class vtkITKMorphologicalContourInterpolator::vtkInternal
+{
+public:
+  /// Input of the previous execution, used for detecting which labels have changed
+  vtkSmartPointer<vtkImageData> PreviousInput;
+  /// Interpolation result of each label within the bounding box of the label
+  std::map<long, vtkSmartPointer<vtkImageData> > InterpolatedLabels;
+  /// Parameters that were used for computing InterpolatedLabels
+  int Axis{-1};
+  bool HeuristicAlignment{true};
+  bool UseDistanceTransform{false};
+  bool UseBallStructuringElement{false};
+};
+
 vtkStandardNewMacro(vtkITKMorphologicalContourInterpolator);
 
-vtkITKMorphologicalContourInterpolator::vtkITKMorphologicalContourInterpolator() = default;
-vtkITKMorphologicalContourInterpolator::~vtkITKMorphologicalContourInterpolator() = default;
+vtkITKMorphologicalContourInterpolator::vtkITKMorphologicalContourInterpolator()
+{
+  this->Internal = new vtkInternal();
+}
+
+vtkITKMorphologicalContourInterpolator::~vtkITKMorphologicalContourInterpolator()
+{
+  delete this->Internal;
+}
+
+void vtkITKMorphologicalContourInterpolator::ClearCache()
+{
+  this->Internal->PreviousInput = nullptr;
+  this->Internal->InterpolatedLabels.clear();
+}
 
 
 template <class T>
@@ -74,6 +116,265 @@ void vtkITKMorphologicalContourInterpolatorExecute(vtkITKMorphologicalContourInt
 
 
 
+//
+// Interpolate a single label within its bounding box.
+// Voxels of other labels are ignored, therefore labels can be processed independently.
+//
+template <class T>
+void vtkITKMorphologicalContourInterpolatorExecuteLabel(vtkITKMorphologicalContourInterpolator *self,
+                const T* inPtr, const int dims[3], const double spacing[3], int scalarType,
+                long label, const LabelExtent& extent, vtkImageData* labelResult)
+{
+  typedef itk::Image<T, 3> ImageType;
+  typename ImageType::Pointer labelImage = ImageType::New();
+  typename ImageType::RegionType region;
+  typename ImageType::IndexType index;
+  typename ImageType::SizeType size;
+  for (int axis = 0; axis < 3; axis++)
+    {
+    index[axis] = 0;
+    size[axis] = extent[axis * 2 + 1] - extent[axis * 2] + 1;
+    }
+  region.SetIndex(index);
+  region.SetSize(size);
+  labelImage->SetRegions(region);
+  labelImage->SetSpacing(spacing);
+  labelImage->Allocate();
+
+  T labelValue = static_cast<T>(label);
+  T* labelPtr = labelImage->GetBufferPointer();
+  for (int k = extent[4]; k <= extent[5]; k++)
+    {
+    for (int j = extent[2]; j <= extent[3]; j++)
+      {
+      const T* inRowPtr = inPtr + (static_cast<vtkIdType>(k) * dims[1] + j) * dims[0];
+      for (int i = extent[0]; i <= extent[1]; i++)
+        {
+        *(labelPtr++) = (inRowPtr[i] == labelValue) ? labelValue : 0;
+        }
+      }
+    }
+
+  typedef itk::MorphologicalContourInterpolator<ImageType> ContourInterpolatorType;
+  typename ContourInterpolatorType::Pointer interpolatorFilter = ContourInterpolatorType::New();
+
+  interpolatorFilter->SetLabel(labelValue);
+  interpolatorFilter->SetAxis(self->GetAxis());
+  interpolatorFilter->SetHeuristicAlignment(self->GetHeuristicAlignment());
+  interpolatorFilter->SetUseDistanceTransform(self->GetUseDistanceTransform());
+  interpolatorFilter->SetUseBallStructuringElement(self->GetUseBallStructuringElement());
+
+  interpolatorFilter->SetInput( labelImage );
+  interpolatorFilter->Update();
+
+  labelResult->SetExtent(extent[0], extent[1], extent[2], extent[3], extent[4], extent[5]);
+  labelResult->AllocateScalars(scalarType, 1);
+  memcpy(labelResult->GetScalarPointer(), interpolatorFilter->GetOutput()->GetBufferPointer(),
+         interpolatorFilter->GetOutput()->GetBufferedRegion().GetNumberOfPixels() * sizeof(T));
+}
+
+//
+//
+//
+template <class T>
+void vtkITKMorphologicalContourInterpolator::ParallelExecute(vtkImageData* input, T* inPtr, T* outPtr)
+{
+  int dims[3];
+  input->GetDimensions(dims);
+  double spacing[3];
+  input->GetSpacing(spacing);
+  vtkInternal* internal = this->Internal;
+
+  // Stored results can only be reused if input geometry and parameters are the same
+  bool cacheValid = (internal->PreviousInput != nullptr
+    && internal->PreviousInput->GetScalarType() == input->GetScalarType()
+    && internal->Axis == this->Axis
+    && internal->HeuristicAlignment == this->HeuristicAlignment
+    && internal->UseDistanceTransform == this->UseDistanceTransform
+    && internal->UseBallStructuringElement == this->UseBallStructuringElement);
+  if (cacheValid)
+    {
+    int previousDims[3];
+    internal->PreviousInput->GetDimensions(previousDims);
+    double previousSpacing[3];
+    internal->PreviousInput->GetSpacing(previousSpacing);
+    for (int axis = 0; axis < 3; axis++)
+      {
+      if (previousDims[axis] != dims[axis] || previousSpacing[axis] != spacing[axis])
+        {
+        cacheValid = false;
+        }
+      }
+    }
+  if (!cacheValid)
+    {
+    this->ClearCache();
+    }
+  const T* previousPtr = cacheValid ? static_cast<T*>(internal->PreviousInput->GetScalarPointer()) : nullptr;
+
+  // Compute bounding box of each label and collect labels that changed since the previous execution
+  struct LabelScanResult
+    {
+    std::map<long, LabelExtent> Extents;
+    std::set<long> ChangedLabels;
+    };
+  vtkSMPThreadLocal<LabelScanResult> scanResults;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dims[1]) * dims[2], [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    LabelScanResult& scanResult = scanResults.Local();
+    for (vtkIdType row = beginRow; row < endRow; row++)
+      {
+      int j = static_cast<int>(row % dims[1]);
+      int k = static_cast<int>(row / dims[1]);
+      const T* inRowPtr = inPtr + row * dims[0];
+      if (previousPtr)
+        {
+        const T* previousRowPtr = previousPtr + row * dims[0];
+        for (int i = 0; i < dims[0]; i++)
+          {
+          if (previousRowPtr[i] != inRowPtr[i])
+            {
+            scanResult.ChangedLabels.insert(static_cast<long>(previousRowPtr[i]));
+            scanResult.ChangedLabels.insert(static_cast<long>(inRowPtr[i]));
+            }
+          }
+        }
+      for (int i = 0; i < dims[0]; i++)
+        {
+        T value = inRowPtr[i];
+        if (value == 0)
+          {
+          continue;
+          }
+        // Find the end of the run of voxels of the same label
+        int runStart = i;
+        while (i + 1 < dims[0] && inRowPtr[i + 1] == value)
+          {
+          i++;
+          }
+        long label = static_cast<long>(value);
+        auto extentIt = scanResult.Extents.find(label);
+        if (extentIt == scanResult.Extents.end())
+          {
+          scanResult.Extents[label] = LabelExtent{ { runStart, i, j, j, k, k } };
+          continue;
+          }
+        LabelExtent& extent = extentIt->second;
+        extent[0] = std::min(extent[0], runStart);
+        extent[1] = std::max(extent[1], i);
+        extent[2] = std::min(extent[2], j);
+        extent[3] = std::max(extent[3], j);
+        extent[4] = std::min(extent[4], k);
+        extent[5] = std::max(extent[5], k);
+        }
+      }
+    });
+
+  std::map<long, LabelExtent> labelExtents;
+  std::set<long> changedLabels;
+  for (LabelScanResult& scanResult : scanResults)
+    {
+    for (const auto& labelExtent : scanResult.Extents)
+      {
+      auto extentIt = labelExtents.find(labelExtent.first);
+      if (extentIt == labelExtents.end())
+        {
+        labelExtents.insert(labelExtent);
+        continue;
+        }
+      for (int axis = 0; axis < 3; axis++)
+        {
+        extentIt->second[axis * 2] = std::min(extentIt->second[axis * 2], labelExtent.second[axis * 2]);
+        extentIt->second[axis * 2 + 1] = std::max(extentIt->second[axis * 2 + 1], labelExtent.second[axis * 2 + 1]);
+        }
+      }
+    changedLabels.insert(scanResult.ChangedLabels.begin(), scanResult.ChangedLabels.end());
+    }
+
+  // Remove results of labels that are not present anymore and find labels that need to be recomputed
+  for (auto labelIt = internal->InterpolatedLabels.begin(); labelIt != internal->InterpolatedLabels.end(); )
+    {
+    if (labelExtents.find(labelIt->first) == labelExtents.end())
+      {
+      labelIt = internal->InterpolatedLabels.erase(labelIt);
+      }
+    else
+      {
+      ++labelIt;
+      }
+    }
+  std::vector<long> labelsToInterpolate;
+  std::vector<vtkSmartPointer<vtkImageData> > labelResults;
+  for (const auto& labelExtent : labelExtents)
+    {
+    if (changedLabels.find(labelExtent.first) != changedLabels.end()
+      || internal->InterpolatedLabels.find(labelExtent.first) == internal->InterpolatedLabels.end())
+      {
+      labelsToInterpolate.push_back(labelExtent.first);
+      labelResults.push_back(vtkSmartPointer<vtkImageData>::New());
+      }
+    }
+  vtkDebugMacro(<< "Interpolating " << labelsToInterpolate.size() << " of " << labelExtents.size() << " labels");
+
+  // Interpolate labels in parallel
+  int scalarType = input->GetScalarType();
+  vtkSMPTools::For(0, static_cast<vtkIdType>(labelsToInterpolate.size()), [&](vtkIdType beginLabel, vtkIdType endLabel)
+    {
+    for (vtkIdType labelIndex = beginLabel; labelIndex < endLabel; labelIndex++)
+      {
+      long label = labelsToInterpolate[labelIndex];
+      vtkITKMorphologicalContourInterpolatorExecuteLabel(this, inPtr, dims, spacing, scalarType,
+        label, labelExtents.find(label)->second, labelResults[labelIndex]);
+      }
+    });
+  for (size_t labelIndex = 0; labelIndex < labelsToInterpolate.size(); labelIndex++)
+    {
+    internal->InterpolatedLabels[labelsToInterpolate[labelIndex]] = labelResults[labelIndex];
+    }
+
+  // Compose output: input voxels are kept and only background voxels are filled.
+  // Labels are written in decreasing order, so that lower label values take precedence.
+  std::copy(inPtr, inPtr + static_cast<vtkIdType>(dims[0]) * dims[1] * dims[2], outPtr);
+  for (auto labelIt = internal->InterpolatedLabels.rbegin(); labelIt != internal->InterpolatedLabels.rend(); ++labelIt)
+    {
+    T labelValue = static_cast<T>(labelIt->first);
+    vtkImageData* labelResult = labelIt->second;
+    int* extent = labelResult->GetExtent();
+    int sizeX = extent[1] - extent[0] + 1;
+    int sizeY = extent[3] - extent[2] + 1;
+    int sizeZ = extent[5] - extent[4] + 1;
+    const T* labelPtr = static_cast<T*>(labelResult->GetScalarPointer());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(sizeY) * sizeZ, [&](vtkIdType beginRow, vtkIdType endRow)
+      {
+      for (vtkIdType row = beginRow; row < endRow; row++)
+        {
+        int j = extent[2] + static_cast<int>(row % sizeY);
+        int k = extent[4] + static_cast<int>(row / sizeY);
+        vtkIdType rowOffset = (static_cast<vtkIdType>(k) * dims[1] + j) * dims[0] + extent[0];
+        const T* labelRowPtr = labelPtr + row * sizeX;
+        for (int i = 0; i < sizeX; i++)
+          {
+          if (labelRowPtr[i] == labelValue && inPtr[rowOffset + i] == 0)
+            {
+            outPtr[rowOffset + i] = labelValue;
+            }
+          }
+        }
+      });
+    }
+
+  // Store input and parameters for detecting changes at the next execution
+  if (!internal->PreviousInput)
+    {
+    internal->PreviousInput = vtkSmartPointer<vtkImageData>::New();
+    }
+  internal->PreviousInput->DeepCopy(input);
+  internal->Axis = this->Axis;
+  internal->HeuristicAlignment = this->HeuristicAlignment;
+  internal->UseDistanceTransform = this->UseDistanceTransform;
+  internal->UseBallStructuringElement = this->UseBallStructuringElement;
+}
+
 //
 //
 //
@@ -105,7 +406,15 @@ void vtkITKMorphologicalContourInterpolator::SimpleExecute(vtkImageData *input,
 #undef VTK_TYPE_USE_LONG_LONG
 #undef VTK_TYPE_USE___INT64
 
-#define CALL  vtkITKMorphologicalContourInterpolatorExecute(this, input, output, static_cast<VTK_TT *>(inPtr), static_cast<VTK_TT *>(outPtr));
+#define CALL \
+  if (this->ParallelLabelInterpolation && this->Label == 0) \
+    { \
+    this->ParallelExecute(input, static_cast<VTK_TT *>(inPtr), static_cast<VTK_TT *>(outPtr)); \
+    } \
+  else \
+    { \
+    vtkITKMorphologicalContourInterpolatorExecute(this, input, output, static_cast<VTK_TT *>(inPtr), static_cast<VTK_TT *>(outPtr)); \
+    }
 
     void* inPtr = input->GetScalarPointer();
     void* outPtr = output->GetScalarPointer();
@@ -137,4 +446,5 @@ void vtkITKMorphologicalContourInterpolator::PrintSelf(ostream& os, vtkIndent in
   os << indent << "HeuristicAlignment: " << HeuristicAlignment << std::endl;
   os << indent << "UseDistanceTransform: " << UseDistanceTransform << std::endl;
   os << indent << "UseBallStructuringElement: " << UseBallStructuringElement << std::endl;
+  os << indent << "ParallelLabelInterpolation: " << ParallelLabelInterpolation << std::endl;
 }
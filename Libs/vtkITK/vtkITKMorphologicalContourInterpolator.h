@@ -44,17 +44,39 @@ public:
   vtkGetMacro(UseBallStructuringElement, bool);
   vtkSetMacro(UseBallStructuringElement, bool);
 
+  /// If enabled and Label is 0 then each label is interpolated independently, in parallel,
+  /// within the bounding box of the label. Interpolation results are kept for each label
+  /// and when the filter is executed again then only those labels are recomputed whose voxels
+  /// have changed since the previous execution (e.g., after editing a single slice of a segment).
+  /// Where interpolated regions of labels overlap, the label with the lower value is used.
+  /// Default is OFF.
+  vtkGetMacro(ParallelLabelInterpolation, bool);
+  vtkSetMacro(ParallelLabelInterpolation, bool);
+  vtkBooleanMacro(ParallelLabelInterpolation, bool);
+
+  /// Remove stored interpolation results. The next execution recomputes all the labels.
+  void ClearCache();
+
 protected:
   vtkITKMorphologicalContourInterpolator();
   ~vtkITKMorphologicalContourInterpolator() override;
 
   void SimpleExecute(vtkImageData* input, vtkImageData* output) override;
 
+  /// Interpolate each label separately, in parallel. Only labels that changed since
+  /// the previous execution are recomputed.
+  template <class T>
+  void ParallelExecute(vtkImageData* input, T* inPtr, T* outPtr);
+
   long Label{0};
   int Axis{-1};
   bool HeuristicAlignment{true};
   bool UseDistanceTransform{false};
   bool UseBallStructuringElement{false};
+  bool ParallelLabelInterpolation{false};
+
+  class vtkInternal;
+  vtkInternal* Internal;
 
 private:
   vtkITKMorphologicalContourInterpolator(const vtkITKMorphologicalContourInterpolator&) = delete;
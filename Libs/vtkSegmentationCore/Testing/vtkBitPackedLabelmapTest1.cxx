@@ -0,0 +1,147 @@
+/*==============================================================================
+
+  Copyright (c) Laboratory for Percutaneous Surgery (PerkLab)
+  Queen's University, Kingston, ON, Canada. All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VTK includes
+#include <vtkNew.h>
+
+// SegmentationCore includes
+#include "vtkBitPackedLabelmap.h"
+#include "vtkOrientedImageData.h"
+#include "vtkOrientedImageDataResample.h"
+
+// Get CHECK_INT from vtkAddonTestingMacros.h to avoid dependency on vtkAddon
+namespace
+{
+
+//----------------------------------------------------------------------------
+bool CheckInt(int line, const std::string& description, int current, int expected)
+{
+  if (current == expected)
+    {
+    return EXIT_SUCCESS;
+    }
+  std::cerr << "\nLine " << line << " - " << description.c_str() << " : test failed"
+    << "\n\tcurrent :" << current
+    << "\n\texpected:" << expected
+    << std::endl;
+  return EXIT_FAILURE;
+}
+
+// Use a macro to be able to print the evaluated expression and the line number
+#define CHECK_INT(actual, expected) \
+  { \
+  if (CheckInt(__LINE__,#actual " != " #expected, (actual), (expected)) != EXIT_SUCCESS) \
+    { \
+    return EXIT_FAILURE; \
+    } \
+  }
+
+//----------------------------------------------------------------------------
+/// Fill a box of an image with a value. Rows are longer than 64 voxels to span multiple words.
+void CreateLabelmap(vtkOrientedImageData* image, const int box[6], double value)
+{
+  image->SetExtent(0, 99, 0, 19, 0, 9);
+  image->SetSpacing(0.5, 0.5, 2.0);
+  image->SetOrigin(10.0, -20.0, 5.0);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  vtkOrientedImageDataResample::FillImage(image, 0.0);
+  vtkOrientedImageDataResample::FillImage(image, value, box);
+}
+
+}
+
+//----------------------------------------------------------------------------
+int vtkBitPackedLabelmapTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int boxA[6] = { 10, 79, 2, 11, 1, 5 };
+  int boxB[6] = { 60, 89, 5, 15, 3, 8 };
+  vtkNew<vtkOrientedImageData> imageA;
+  CreateLabelmap(imageA, boxA, 1.0);
+  vtkNew<vtkOrientedImageData> imageB;
+  CreateLabelmap(imageB, boxB, 3.0);
+
+  vtkNew<vtkBitPackedLabelmap> labelmapA;
+  CHECK_INT(labelmapA->SetImage(imageA), true);
+  CHECK_INT(labelmapA->GetNumberOfSetVoxels(), 70 * 10 * 5);
+  CHECK_INT(labelmapA->GetValue(10, 2, 1), true);
+  CHECK_INT(labelmapA->GetValue(79, 11, 5), true);
+  CHECK_INT(labelmapA->GetValue(80, 11, 5), false);
+  CHECK_INT(labelmapA->GetValue(200, 11, 5), false);
+
+  int effectiveExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  CHECK_INT(labelmapA->CalculateEffectiveExtent(effectiveExtent), true);
+  for (int i = 0; i < 6; ++i)
+    {
+    CHECK_INT(effectiveExtent[i], boxA[i]);
+    }
+
+  // Bits are 1/8 of the unsigned char scalars
+  CHECK_INT(labelmapA->GetActualMemorySize() * 4 < imageA->GetActualMemorySize(), true);
+
+  // Reconstruction
+  vtkNew<vtkOrientedImageData> decodedImage;
+  CHECK_INT(labelmapA->GetImage(decodedImage), true);
+  CHECK_INT(vtkOrientedImageDataResample::DoGeometriesMatch(imageA, decodedImage), true);
+  CHECK_INT(vtkOrientedImageDataResample::DoExtentsMatch(imageA, decodedImage), true);
+  CHECK_INT(decodedImage->GetScalarComponentAsDouble(50, 5, 3, 0), 1);
+  CHECK_INT(decodedImage->GetScalarComponentAsDouble(50, 15, 3, 0), 0);
+
+  // Logical operations
+  vtkNew<vtkBitPackedLabelmap> labelmapB;
+  CHECK_INT(labelmapB->SetImage(imageB, 3.0), true);
+  CHECK_INT(labelmapB->GetNumberOfSetVoxels(), 30 * 11 * 6);
+  vtkIdType overlap = 20 * 7 * 3;
+
+  vtkNew<vtkBitPackedLabelmap> result;
+  result->SetImage(imageA);
+  CHECK_INT(result->Intersect(labelmapB), true);
+  CHECK_INT(result->GetNumberOfSetVoxels(), overlap);
+
+  result->SetImage(imageA);
+  CHECK_INT(result->Union(labelmapB), true);
+  CHECK_INT(result->GetNumberOfSetVoxels(), 70 * 10 * 5 + 30 * 11 * 6 - overlap);
+
+  result->SetImage(imageA);
+  CHECK_INT(result->Subtract(labelmapB), true);
+  CHECK_INT(result->GetNumberOfSetVoxels(), 70 * 10 * 5 - overlap);
+
+  result->SetImage(imageA);
+  result->Invert();
+  CHECK_INT(result->GetNumberOfSetVoxels(), 100 * 20 * 10 - 70 * 10 * 5);
+
+  // Union grows the extent to contain the other labelmap
+  vtkNew<vtkOrientedImageData> croppedImageA;
+  int croppedExtent[6] = { 0, 49, 0, 19, 0, 9 };
+  vtkOrientedImageDataResample::CopyImage(imageA, croppedImageA, croppedExtent);
+  result->SetImage(croppedImageA);
+  CHECK_INT(result->Union(labelmapB), true);
+  int unionExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  result->GetExtent(unionExtent);
+  CHECK_INT(unionExtent[1], 99);
+  CHECK_INT(result->GetNumberOfSetVoxels(), 40 * 10 * 5 + 30 * 11 * 6);
+
+  // Labelmaps with different geometry are rejected
+  imageB->SetSpacing(1.0, 1.0, 1.0);
+  labelmapB->SetImage(imageB);
+  CHECK_INT(result->Intersect(labelmapB), false);
+
+  labelmapA->Initialize();
+  CHECK_INT(labelmapA->GetNumberOfSetVoxels(), 0);
+  CHECK_INT(labelmapA->CalculateEffectiveExtent(effectiveExtent), false);
+
+  std::cout << "vtkBitPackedLabelmapTest1 passed" << std::endl;
+  return EXIT_SUCCESS;
+}
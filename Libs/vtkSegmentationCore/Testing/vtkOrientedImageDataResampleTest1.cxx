@@ -0,0 +1,259 @@
+/*==============================================================================
+
+  Copyright (c) Laboratory for Percutaneous Surgery (PerkLab)
+  Queen's University, Kingston, ON, Canada. All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VTK includes
+#include <vtkDataArray.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+
+// SegmentationCore includes
+#include "vtkOrientedImageData.h"
+#include "vtkOrientedImageDataResample.h"
+
+// STD includes
+#include <algorithm>
+#include <vector>
+
+// Get CHECK_INT from vtkAddonTestingMacros.h to avoid dependency on vtkAddon
+namespace
+{
+
+//----------------------------------------------------------------------------
+bool CheckInt(int line, const std::string& description, int current, int expected)
+{
+  if (current == expected)
+    {
+    return EXIT_SUCCESS;
+    }
+  std::cerr << "\nLine " << line << " - " << description.c_str() << " : test failed"
+    << "\n\tcurrent :" << current
+    << "\n\texpected:" << expected
+    << std::endl;
+  return EXIT_FAILURE;
+}
+
+// Use a macro to be able to print the evaluated expression and the line number
+#define CHECK_INT(actual, expected) \
+  { \
+  if (CheckInt(__LINE__,#actual " != " #expected, (actual), (expected)) != EXIT_SUCCESS) \
+    { \
+    return EXIT_FAILURE; \
+    } \
+  }
+
+//----------------------------------------------------------------------------
+void CreateImage(vtkOrientedImageData* image, int scalarType, int i0, int i1, int j0, int j1, int k0, int k1)
+{
+  image->SetExtent(i0, i1, j0, j1, k0, k1);
+  image->SetSpacing(0.5, 0.5, 2.0);
+  image->SetOrigin(10.0, -20.0, 5.0);
+  image->AllocateScalars(scalarType, 1);
+  // Deterministic pseudo-random pattern of small values
+  for (int k = k0; k <= k1; ++k)
+    {
+    for (int j = j0; j <= j1; ++j)
+      {
+      for (int i = i0; i <= i1; ++i)
+        {
+        image->SetScalarComponentFromDouble(i, j, k, 0, (i * 7 + j * 13 + k * 29) % 5);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+bool IsInExtent(const int extent[6], int i, int j, int k)
+{
+  return i >= extent[0] && i <= extent[1] && j >= extent[2] && j <= extent[3] && k >= extent[4] && k <= extent[5];
+}
+
+}
+
+//----------------------------------------------------------------------------
+int vtkOrientedImageDataResampleTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkOrientedImageData> originalImage;
+  CreateImage(originalImage, VTK_SHORT, 0, 40, 0, 30, 0, 10);
+  int* imageExtent = originalImage->GetExtent();
+
+  vtkNew<vtkOrientedImageData> modifierImage;
+  CreateImage(modifierImage, VTK_UNSIGNED_CHAR, 5, 50, -3, 20, 2, 12);
+  int* modifierExtent = modifierImage->GetExtent();
+
+  // Compare each voxel of ModifyImage result with the expected value
+  int operations[3] =
+    {
+    vtkOrientedImageDataResample::OPERATION_MAXIMUM,
+    vtkOrientedImageDataResample::OPERATION_MINIMUM,
+    vtkOrientedImageDataResample::OPERATION_MASKING
+    };
+  for (int operation : operations)
+    {
+    vtkNew<vtkOrientedImageData> image;
+    image->DeepCopy(originalImage);
+    vtkMTimeType mtimeBefore = image->GetMTime();
+    CHECK_INT(vtkOrientedImageDataResample::ModifyImage(image, modifierImage, operation, nullptr, 2.0, 9.0), true);
+    CHECK_INT(image->GetMTime() > mtimeBefore, true);
+    int differentVoxels = 0;
+    for (int k = imageExtent[4]; k <= imageExtent[5]; ++k)
+      {
+      for (int j = imageExtent[2]; j <= imageExtent[3]; ++j)
+        {
+        for (int i = imageExtent[0]; i <= imageExtent[1]; ++i)
+          {
+          double expected = originalImage->GetScalarComponentAsDouble(i, j, k, 0);
+          if (IsInExtent(modifierExtent, i, j, k))
+            {
+            double modifierValue = modifierImage->GetScalarComponentAsDouble(i, j, k, 0);
+            if (operation == vtkOrientedImageDataResample::OPERATION_MAXIMUM)
+              {
+              expected = std::max(expected, modifierValue);
+              }
+            else if (operation == vtkOrientedImageDataResample::OPERATION_MINIMUM)
+              {
+              expected = std::min(expected, modifierValue);
+              }
+            else if (modifierValue > 2.0)
+              {
+              expected = 9.0;
+              }
+            }
+          if (image->GetScalarComponentAsDouble(i, j, k, 0) != expected)
+            {
+            ++differentVoxels;
+            }
+          }
+        }
+      }
+    CHECK_INT(differentVoxels, 0);
+    }
+
+  // Merging an image that does not change any voxel does not modify the output
+  vtkNew<vtkOrientedImageData> emptyModifierImage;
+  emptyModifierImage->DeepCopy(modifierImage);
+  vtkOrientedImageDataResample::FillImage(emptyModifierImage, 0.0);
+  vtkNew<vtkOrientedImageData> mergedImage;
+  bool outputModified = true;
+  mergedImage->DeepCopy(originalImage);
+  CHECK_INT(vtkOrientedImageDataResample::MergeImage(originalImage, emptyModifierImage, mergedImage,
+    vtkOrientedImageDataResample::OPERATION_MAXIMUM, nullptr, 0, 1, &outputModified), true);
+  CHECK_INT(outputModified, false);
+
+  // Apply mask, voxels outside of the mask extent are outside of the mask
+  for (int notMask = 0; notMask <= 1; ++notMask)
+    {
+    vtkNew<vtkOrientedImageData> image;
+    image->DeepCopy(originalImage);
+    vtkDataArray* scalarsBefore = image->GetPointData()->GetScalars();
+    CHECK_INT(vtkOrientedImageDataResample::ApplyImageMask(image, modifierImage, 7.0, notMask != 0), true);
+    CHECK_INT(vtkOrientedImageDataResample::DoGeometriesMatch(image, originalImage), true);
+    CHECK_INT(vtkOrientedImageDataResample::DoExtentsMatch(image, originalImage), true);
+    CHECK_INT(image->GetPointData()->GetScalars() != scalarsBefore, true);
+    int differentVoxels = 0;
+    for (int k = imageExtent[4]; k <= imageExtent[5]; ++k)
+      {
+      for (int j = imageExtent[2]; j <= imageExtent[3]; ++j)
+        {
+        for (int i = imageExtent[0]; i <= imageExtent[1]; ++i)
+          {
+          bool inMask = IsInExtent(modifierExtent, i, j, k) && modifierImage->GetScalarComponentAsDouble(i, j, k, 0) != 0;
+          double expected = (inMask != (notMask != 0)) ? originalImage->GetScalarComponentAsDouble(i, j, k, 0) : 7.0;
+          if (image->GetScalarComponentAsDouble(i, j, k, 0) != expected)
+            {
+            ++differentVoxels;
+            }
+          }
+        }
+      }
+    CHECK_INT(differentVoxels, 0);
+    }
+
+  // Label values in mask
+  std::vector<int> labelValues;
+  vtkOrientedImageDataResample::GetLabelValuesInMask(labelValues, originalImage, modifierImage, nullptr, 3);
+  std::vector<bool> expectedLabelFound(5, false);
+  for (int k = imageExtent[4]; k <= imageExtent[5]; ++k)
+    {
+    for (int j = imageExtent[2]; j <= imageExtent[3]; ++j)
+      {
+      for (int i = imageExtent[0]; i <= imageExtent[1]; ++i)
+        {
+        if (IsInExtent(modifierExtent, i, j, k) && modifierImage->GetScalarComponentAsDouble(i, j, k, 0) > 3)
+          {
+          expectedLabelFound[static_cast<int>(originalImage->GetScalarComponentAsDouble(i, j, k, 0))] = true;
+          }
+        }
+      }
+    }
+  int numberOfExpectedLabels = 0;
+  for (int value = 1; value < 5; ++value)
+    {
+    if (expectedLabelFound[value])
+      {
+      ++numberOfExpectedLabels;
+      CHECK_INT(std::find(labelValues.begin(), labelValues.end(), value) != labelValues.end(), true);
+      }
+    }
+  CHECK_INT(static_cast<int>(labelValues.size()), numberOfExpectedLabels);
+
+  // Resample to a reference geometry that has flipped and permuted axes and is shifted by whole voxels.
+  // Reference IJK (i, j, k) corresponds to input IJK (3 - j, k + 2, i).
+  vtkNew<vtkMatrix4x4> inputImageToWorldMatrix;
+  originalImage->GetImageToWorldMatrix(inputImageToWorldMatrix);
+  vtkNew<vtkMatrix4x4> referenceToInputImageMatrix;
+  referenceToInputImageMatrix->Zero();
+  referenceToInputImageMatrix->SetElement(0, 1, -1.0);
+  referenceToInputImageMatrix->SetElement(0, 3, 3.0);
+  referenceToInputImageMatrix->SetElement(1, 2, 1.0);
+  referenceToInputImageMatrix->SetElement(1, 3, 2.0);
+  referenceToInputImageMatrix->SetElement(2, 0, 1.0);
+  referenceToInputImageMatrix->SetElement(3, 3, 1.0);
+  vtkNew<vtkMatrix4x4> referenceImageToWorldMatrix;
+  vtkMatrix4x4::Multiply4x4(inputImageToWorldMatrix, referenceToInputImageMatrix, referenceImageToWorldMatrix);
+  vtkNew<vtkOrientedImageData> referenceImage;
+  referenceImage->SetExtent(0, 12, -5, 10, 0, 30);
+  referenceImage->SetImageToWorldMatrix(referenceImageToWorldMatrix);
+  vtkNew<vtkOrientedImageData> resampledImage;
+  CHECK_INT(vtkOrientedImageDataResample::ResampleOrientedImageToReferenceOrientedImage(
+    originalImage, referenceImage, resampledImage, false, false, nullptr, 4.0), true);
+  CHECK_INT(vtkOrientedImageDataResample::DoGeometriesMatch(resampledImage, referenceImage), true);
+  CHECK_INT(vtkOrientedImageDataResample::DoExtentsMatch(resampledImage, referenceImage), true);
+  int* referenceExtent = referenceImage->GetExtent();
+  int differentVoxels = 0;
+  for (int k = referenceExtent[4]; k <= referenceExtent[5]; ++k)
+    {
+    for (int j = referenceExtent[2]; j <= referenceExtent[3]; ++j)
+      {
+      for (int i = referenceExtent[0]; i <= referenceExtent[1]; ++i)
+        {
+        double expected = 4.0;
+        if (IsInExtent(imageExtent, 3 - j, k + 2, i))
+          {
+          expected = originalImage->GetScalarComponentAsDouble(3 - j, k + 2, i, 0);
+          }
+        if (resampledImage->GetScalarComponentAsDouble(i, j, k, 0) != expected)
+          {
+          ++differentVoxels;
+          }
+        }
+      }
+    }
+  CHECK_INT(differentVoxels, 0);
+
+  std::cout << "vtkOrientedImageDataResampleTest1 passed" << std::endl;
+  return EXIT_SUCCESS;
+}
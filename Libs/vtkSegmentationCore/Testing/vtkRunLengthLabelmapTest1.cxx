@@ -0,0 +1,171 @@
+/*==============================================================================
+
+  Copyright (c) Laboratory for Percutaneous Surgery (PerkLab)
+  Queen's University, Kingston, ON, Canada. All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VTK includes
+#include <vtkNew.h>
+
+// SegmentationCore includes
+#include "vtkOrientedImageData.h"
+#include "vtkOrientedImageDataResample.h"
+#include "vtkRunLengthLabelmap.h"
+
+// Get CHECK_INT from vtkAddonTestingMacros.h to avoid dependency on vtkAddon
+namespace
+{
+
+//----------------------------------------------------------------------------
+bool CheckInt(int line, const std::string& description, int current, int expected)
+{
+  if (current == expected)
+    {
+    return EXIT_SUCCESS;
+    }
+  std::cerr << "\nLine " << line << " - " << description.c_str() << " : test failed"
+    << "\n\tcurrent :" << current
+    << "\n\texpected:" << expected
+    << std::endl;
+  return EXIT_FAILURE;
+}
+
+// Use a macro to be able to print the evaluated expression and the line number
+#define CHECK_INT(actual, expected) \
+  { \
+  if (CheckInt(__LINE__,#actual " != " #expected, (actual), (expected)) != EXIT_SUCCESS) \
+    { \
+    return EXIT_FAILURE; \
+    } \
+  }
+
+//----------------------------------------------------------------------------
+void CreateLabelmap(vtkOrientedImageData* image)
+{
+  image->SetExtent(0, 31, 0, 31, 0, 15);
+  image->SetSpacing(0.5, 0.5, 2.0);
+  image->SetOrigin(10.0, -20.0, 5.0);
+  image->AllocateScalars(VTK_SHORT, 1);
+  vtkOrientedImageDataResample::FillImage(image, 0.0);
+  for (int k = 2; k <= 10; ++k)
+    {
+    for (int j = 4; j <= 20; ++j)
+      {
+      for (int i = 3; i <= 8; ++i)
+        {
+        image->SetScalarComponentFromDouble(i, j, k, 0, 1.0);
+        }
+      for (int i = 12; i <= 14; ++i)
+        {
+        image->SetScalarComponentFromDouble(i, j, k, 0, 2.0);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+int CountDifferentVoxels(vtkImageData* image1, vtkImageData* image2)
+{
+  int* extent = image1->GetExtent();
+  int differentVoxels = 0;
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+        if (image1->GetScalarComponentAsDouble(i, j, k, 0) != image2->GetScalarComponentAsDouble(i, j, k, 0))
+          {
+          ++differentVoxels;
+          }
+        }
+      }
+    }
+  return differentVoxels;
+}
+
+}
+
+//----------------------------------------------------------------------------
+int vtkRunLengthLabelmapTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkOrientedImageData> image;
+  CreateLabelmap(image);
+
+  vtkNew<vtkRunLengthLabelmap> labelmap;
+  CHECK_INT(labelmap->SetImage(image), true);
+  CHECK_INT(labelmap->GetScalarType(), VTK_SHORT);
+  // Two runs in each non-empty row
+  CHECK_INT(labelmap->GetNumberOfRuns(), 2 * 17 * 9);
+  CHECK_INT(labelmap->GetValue(3, 4, 2), 1);
+  CHECK_INT(labelmap->GetValue(13, 20, 10), 2);
+  CHECK_INT(labelmap->GetValue(10, 10, 5), 0);
+  CHECK_INT(labelmap->GetValue(100, 10, 5), 0);
+
+  int effectiveExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  CHECK_INT(labelmap->CalculateEffectiveExtent(effectiveExtent), true);
+  CHECK_INT(effectiveExtent[0], 3);
+  CHECK_INT(effectiveExtent[1], 14);
+  CHECK_INT(effectiveExtent[2], 4);
+  CHECK_INT(effectiveExtent[3], 20);
+  CHECK_INT(effectiveExtent[4], 2);
+  CHECK_INT(effectiveExtent[5], 10);
+
+  // Full reconstruction
+  vtkNew<vtkOrientedImageData> decodedImage;
+  CHECK_INT(labelmap->GetImage(decodedImage), true);
+  CHECK_INT(vtkOrientedImageDataResample::DoGeometriesMatch(image, decodedImage), true);
+  CHECK_INT(vtkOrientedImageDataResample::DoExtentsMatch(image, decodedImage), true);
+  CHECK_INT(CountDifferentVoxels(image, decodedImage), 0);
+
+  // Reconstruction of a single slice
+  int sliceExtent[6] = { 0, 31, 0, 31, 5, 5 };
+  vtkNew<vtkOrientedImageData> decodedSlice;
+  CHECK_INT(labelmap->GetImage(decodedSlice, sliceExtent), true);
+  CHECK_INT(decodedSlice->GetDimensions()[2], 1);
+  CHECK_INT(CountDifferentVoxels(decodedSlice, image), 0);
+
+  // Modify a dense image directly with the runs
+  vtkNew<vtkOrientedImageData> baseImage;
+  baseImage->SetExtent(0, 31, 0, 31, 0, 15);
+  baseImage->SetSpacing(image->GetSpacing());
+  baseImage->SetOrigin(image->GetOrigin());
+  baseImage->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  vtkOrientedImageDataResample::FillImage(baseImage, 0.0);
+  CHECK_INT(vtkOrientedImageDataResample::ModifyImage(baseImage, labelmap, vtkOrientedImageDataResample::OPERATION_MAXIMUM), true);
+  CHECK_INT(CountDifferentVoxels(baseImage, image), 0);
+
+  vtkOrientedImageDataResample::FillImage(baseImage, 0.0);
+  CHECK_INT(vtkOrientedImageDataResample::ModifyImage(baseImage, labelmap, vtkOrientedImageDataResample::OPERATION_MASKING,
+    nullptr, 1.0, 5.0), true);
+  CHECK_INT(baseImage->GetScalarComponentAsDouble(13, 10, 5, 0), 5);
+  CHECK_INT(baseImage->GetScalarComponentAsDouble(5, 10, 5, 0), 0);
+
+  vtkOrientedImageDataResample::FillImage(baseImage, 3.0);
+  CHECK_INT(vtkOrientedImageDataResample::ModifyImage(baseImage, labelmap, vtkOrientedImageDataResample::OPERATION_MINIMUM), true);
+  CHECK_INT(CountDifferentVoxels(baseImage, image), 0);
+
+  // Images with different geometry are rejected
+  baseImage->SetSpacing(1.0, 1.0, 1.0);
+  CHECK_INT(vtkOrientedImageDataResample::ModifyImage(baseImage, labelmap, vtkOrientedImageDataResample::OPERATION_MAXIMUM), false);
+
+  // Sparse storage is smaller than dense storage
+  CHECK_INT(labelmap->GetActualMemorySize() < image->GetActualMemorySize(), true);
+
+  labelmap->Initialize();
+  CHECK_INT(labelmap->GetNumberOfRuns(), 0);
+  CHECK_INT(labelmap->CalculateEffectiveExtent(effectiveExtent), false);
+
+  std::cout << "vtkRunLengthLabelmapTest1 passed" << std::endl;
+  return EXIT_SUCCESS;
+}
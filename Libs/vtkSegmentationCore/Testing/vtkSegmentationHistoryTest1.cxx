@@ -243,6 +243,22 @@ int vtkSegmentationHistoryTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
   // restoring previous state saves the current modified state
   CHECK_INT(history->GetNumberOfStates(), 3);
 
+  // Labelmaps are stored compressed and unchanged slices are shared between states
+  vtkOrientedImageData* currentLabelmap = vtkOrientedImageData::SafeDownCast(segment1->GetRepresentation(
+    vtkSegmentationConverter::GetBinaryLabelmapRepresentationName()));
+  unsigned long memorySize = history->GetMemorySize();
+  if (memorySize == 0 || memorySize >= currentLabelmap->GetActualMemorySize())
+    {
+    std::cerr << "Invalid memory size of stored states " << memorySize << " KiB, should be less than the size of one labelmap ("
+      << currentLabelmap->GetActualMemorySize() << " KiB)" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Exceeding the memory limit removes the oldest states, except the most recent one
+  history->SetMaximumMemorySize(1);
+  CHECK_INT(history->GetNumberOfStates(), 1);
+  history->SetMaximumMemorySize(0);
+
   std::cout << "Segmentation history test 1 passed." << std::endl;
   return EXIT_SUCCESS;
 }
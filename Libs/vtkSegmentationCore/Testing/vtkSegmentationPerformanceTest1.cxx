@@ -0,0 +1,310 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// Measure the time of the core segmentation operations (representation conversions,
+// labelmap modification in each merge mode, shared labelmap collapse, undo/redo)
+// at several segment counts and volume sizes. Times are reported as dashboard
+// measurements, to provide a baseline to compare optimizations against.
+
+// VTK includes
+#include <vtkDataArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+#include <vtkTimerLog.h>
+
+// SegmentationCore includes
+#include "vtkBinaryLabelmapToClosedSurfaceConversionRule.h"
+#include "vtkClosedSurfaceToBinaryLabelmapConversionRule.h"
+#include "vtkOrientedImageData.h"
+#include "vtkSegment.h"
+#include "vtkSegmentation.h"
+#include "vtkSegmentationConverter.h"
+#include "vtkSegmentationConverterFactory.h"
+#include "vtkSegmentationHistory.h"
+#include "vtkSegmentationModifier.h"
+
+// STD includes
+#include <cmath>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+void printMeasurement(const std::string& name, int volumeSize, int numberOfSegments, double seconds)
+{
+  std::cout << "<DartMeasurement name=\"" << name << "-" << volumeSize << "^3-" << numberOfSegments
+            << "Segments\" type=\"numeric/double\">" << seconds * 1000.0 << "</DartMeasurement>" << std::endl;
+}
+
+//----------------------------------------------------------------------------
+/// Center and radius of the i-th of numberOfSegments spheres, laid out on a regular grid
+/// so that the spheres do not overlap.
+void getSphere(int i, int numberOfSegments, int volumeSize, double center[3], double& radius)
+{
+  int spheresPerAxis = static_cast<int>(std::ceil(std::cbrt(static_cast<double>(numberOfSegments))));
+  double cellSize = static_cast<double>(volumeSize) / spheresPerAxis;
+  center[0] = (i % spheresPerAxis + 0.5) * cellSize;
+  center[1] = ((i / spheresPerAxis) % spheresPerAxis + 0.5) * cellSize;
+  center[2] = (i / (spheresPerAxis * spheresPerAxis) + 0.5) * cellSize;
+  radius = cellSize * 0.4;
+}
+
+//----------------------------------------------------------------------------
+/// Fill labelmap with spheres, using segment index + 1 as label value.
+/// If segmentIndex is specified then only that sphere is drawn.
+void createSphereLabelmap(vtkOrientedImageData* labelmap, int volumeSize, int numberOfSegments, int segmentIndex = -1)
+{
+  labelmap->SetExtent(0, volumeSize - 1, 0, volumeSize - 1, 0, volumeSize - 1);
+  labelmap->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  unsigned char* voxels = static_cast<unsigned char*>(labelmap->GetScalarPointer());
+  int spheresPerAxis = static_cast<int>(std::ceil(std::cbrt(static_cast<double>(numberOfSegments))));
+  double cellSize = static_cast<double>(volumeSize) / spheresPerAxis;
+  for (int z = 0; z < volumeSize; ++z)
+    {
+    for (int y = 0; y < volumeSize; ++y)
+      {
+      for (int x = 0; x < volumeSize; ++x, ++voxels)
+        {
+        *voxels = 0;
+        int cell[3] = { static_cast<int>(x / cellSize), static_cast<int>(y / cellSize), static_cast<int>(z / cellSize) };
+        int i = cell[0] + cell[1] * spheresPerAxis + cell[2] * spheresPerAxis * spheresPerAxis;
+        if (i >= numberOfSegments || (segmentIndex >= 0 && i != segmentIndex))
+          {
+          continue;
+          }
+        double center[3] = { 0.0, 0.0, 0.0 };
+        double radius = 0.0;
+        getSphere(i, numberOfSegments, volumeSize, center, radius);
+        double r2 = (x - center[0]) * (x - center[0]) + (y - center[1]) * (y - center[1]) + (z - center[2]) * (z - center[2]);
+        if (r2 <= radius * radius)
+          {
+          *voxels = static_cast<unsigned char>(i + 1);
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Create a segmentation where all segments share the same binary labelmap
+/// (or each segment has its own labelmap, if sharedLabelmap is false).
+void createLabelmapSegmentation(vtkSegmentation* segmentation, int volumeSize, int numberOfSegments, bool sharedLabelmap = true)
+{
+  segmentation->SetMasterRepresentationName(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName());
+  vtkNew<vtkOrientedImageData> sharedLabelmapImage;
+  if (sharedLabelmap)
+    {
+    createSphereLabelmap(sharedLabelmapImage, volumeSize, numberOfSegments);
+    }
+  for (int i = 0; i < numberOfSegments; ++i)
+    {
+    vtkNew<vtkSegment> segment;
+    std::stringstream ss;
+    ss << "Segment_" << i + 1;
+    segment->SetName(ss.str().c_str());
+    segment->SetLabelValue(i + 1);
+    if (sharedLabelmap)
+      {
+      segment->AddRepresentation(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName(), sharedLabelmapImage);
+      }
+    else
+      {
+      vtkNew<vtkOrientedImageData> labelmap;
+      createSphereLabelmap(labelmap, volumeSize, numberOfSegments, i);
+      segment->AddRepresentation(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName(), labelmap);
+      }
+    segmentation->AddSegment(segment, ss.str());
+    }
+}
+
+//----------------------------------------------------------------------------
+void testLabelmapToClosedSurface(int volumeSize, int numberOfSegments)
+{
+  vtkNew<vtkSegmentation> segmentation;
+  createLabelmapSegmentation(segmentation, volumeSize, numberOfSegments);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  segmentation->CreateRepresentation(vtkSegmentationConverter::GetSegmentationClosedSurfaceRepresentationName(), true);
+  timer->StopTimer();
+  printMeasurement("BinaryLabelmapToClosedSurface", volumeSize, numberOfSegments, timer->GetElapsedTime());
+}
+
+//----------------------------------------------------------------------------
+void testClosedSurfaceToLabelmap(int volumeSize, int numberOfSegments)
+{
+  vtkNew<vtkSegmentation> segmentation;
+  segmentation->SetMasterRepresentationName(vtkSegmentationConverter::GetSegmentationClosedSurfaceRepresentationName());
+  for (int i = 0; i < numberOfSegments; ++i)
+    {
+    double center[3] = { 0.0, 0.0, 0.0 };
+    double radius = 0.0;
+    getSphere(i, numberOfSegments, volumeSize, center, radius);
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(center);
+    sphere->SetRadius(radius);
+    sphere->SetThetaResolution(32);
+    sphere->SetPhiResolution(32);
+    sphere->Update();
+    vtkNew<vtkSegment> segment;
+    segment->AddRepresentation(vtkSegmentationConverter::GetSegmentationClosedSurfaceRepresentationName(), sphere->GetOutput());
+    segmentation->AddSegment(segment);
+    }
+
+  // Use the same labelmap geometry as in the other tests
+  vtkNew<vtkOrientedImageData> referenceImage;
+  referenceImage->SetExtent(0, volumeSize - 1, 0, volumeSize - 1, 0, volumeSize - 1);
+  segmentation->SetConversionParameter(vtkSegmentationConverter::GetReferenceImageGeometryParameterName(),
+    vtkSegmentationConverter::SerializeImageGeometry(referenceImage));
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  segmentation->CreateRepresentation(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName(), true);
+  timer->StopTimer();
+  printMeasurement("ClosedSurfaceToBinaryLabelmap", volumeSize, numberOfSegments, timer->GetElapsedTime());
+}
+
+//----------------------------------------------------------------------------
+void testModifyBinaryLabelmap(int volumeSize, int numberOfSegments)
+{
+  const char* modeNames[] = { "Replace", "MergeMax", "MergeMin", "MergeMask" };
+  const int modes[] = { vtkSegmentationModifier::MODE_REPLACE, vtkSegmentationModifier::MODE_MERGE_MAX,
+    vtkSegmentationModifier::MODE_MERGE_MIN, vtkSegmentationModifier::MODE_MERGE_MASK };
+
+  // Brush-like modifier: a small cube in the center of the volume
+  vtkNew<vtkOrientedImageData> modifierLabelmap;
+  modifierLabelmap->SetExtent(0, volumeSize - 1, 0, volumeSize - 1, 0, volumeSize - 1);
+  modifierLabelmap->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  modifierLabelmap->GetPointData()->GetScalars()->Fill(0);
+  int modifierExtent[6] = { volumeSize * 3 / 8, volumeSize * 5 / 8, volumeSize * 3 / 8, volumeSize * 5 / 8, volumeSize * 3 / 8, volumeSize * 5 / 8 };
+  for (int z = modifierExtent[4]; z <= modifierExtent[5]; ++z)
+    {
+    for (int y = modifierExtent[2]; y <= modifierExtent[3]; ++y)
+      {
+      for (int x = modifierExtent[0]; x <= modifierExtent[1]; ++x)
+        {
+        *static_cast<unsigned char*>(modifierLabelmap->GetScalarPointer(x, y, z)) = 1;
+        }
+      }
+    }
+
+  const int numberOfRepeats = 10;
+  for (int modeIndex = 0; modeIndex < 4; ++modeIndex)
+    {
+    vtkNew<vtkSegmentation> segmentation;
+    createLabelmapSegmentation(segmentation, volumeSize, numberOfSegments);
+    std::string segmentID = segmentation->GetNthSegmentID(0);
+    vtkNew<vtkTimerLog> timer;
+    timer->StartTimer();
+    for (int i = 0; i < numberOfRepeats; ++i)
+      {
+      vtkSegmentationModifier::ModifyBinaryLabelmap(modifierLabelmap, segmentation, segmentID, modes[modeIndex], modifierExtent);
+      }
+    timer->StopTimer();
+    printMeasurement(std::string("ModifyBinaryLabelmap") + modeNames[modeIndex], volumeSize, numberOfSegments,
+      timer->GetElapsedTime() / numberOfRepeats);
+    }
+}
+
+//----------------------------------------------------------------------------
+void testCollapseBinaryLabelmaps(int volumeSize, int numberOfSegments)
+{
+  vtkNew<vtkSegmentation> segmentation;
+  createLabelmapSegmentation(segmentation, volumeSize, numberOfSegments, false);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  segmentation->CollapseBinaryLabelmaps(false);
+  timer->StopTimer();
+  printMeasurement("CollapseBinaryLabelmaps", volumeSize, numberOfSegments, timer->GetElapsedTime());
+}
+
+//----------------------------------------------------------------------------
+void testSegmentationHistory(int volumeSize, int numberOfSegments)
+{
+  vtkNew<vtkSegmentation> segmentation;
+  createLabelmapSegmentation(segmentation, volumeSize, numberOfSegments);
+  vtkNew<vtkSegmentationHistory> history;
+  history->SetSegmentation(segmentation);
+  std::string segmentID = segmentation->GetNthSegmentID(0);
+
+  vtkNew<vtkOrientedImageData> modifierLabelmap;
+  createSphereLabelmap(modifierLabelmap, volumeSize, 1);
+
+  const int numberOfStates = 10;
+  vtkNew<vtkTimerLog> timer;
+  double saveTime = 0.0;
+  for (int i = 0; i < numberOfStates; ++i)
+    {
+    timer->StartTimer();
+    history->SaveState();
+    timer->StopTimer();
+    saveTime += timer->GetElapsedTime();
+    vtkSegmentationModifier::ModifyBinaryLabelmap(modifierLabelmap, segmentation, segmentID,
+      i % 2 ? vtkSegmentationModifier::MODE_MERGE_MIN : vtkSegmentationModifier::MODE_MERGE_MAX);
+    }
+  printMeasurement("SegmentationHistorySaveState", volumeSize, numberOfSegments, saveTime / numberOfStates);
+
+  timer->StartTimer();
+  for (int i = 0; i < numberOfStates && history->IsRestorePreviousStateAvailable(); ++i)
+    {
+    history->RestorePreviousState();
+    }
+  timer->StopTimer();
+  printMeasurement("SegmentationHistoryRestorePreviousState", volumeSize, numberOfSegments, timer->GetElapsedTime() / numberOfStates);
+
+  timer->StartTimer();
+  for (int i = 0; i < numberOfStates && history->IsRestoreNextStateAvailable(); ++i)
+    {
+    history->RestoreNextState();
+    }
+  timer->StopTimer();
+  printMeasurement("SegmentationHistoryRestoreNextState", volumeSize, numberOfSegments, timer->GetElapsedTime() / numberOfStates);
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkSegmentationPerformanceTest1(int argc, char* argv[])
+{
+  // Largest volume size can be set from the command line to run longer benchmarks
+  int maximumVolumeSize = 128;
+  if (argc > 1)
+    {
+    maximumVolumeSize = atoi(argv[1]);
+    }
+
+  vtkSegmentationConverterFactory::GetInstance()->RegisterConverterRule(
+    vtkSmartPointer<vtkBinaryLabelmapToClosedSurfaceConversionRule>::New());
+  vtkSegmentationConverterFactory::GetInstance()->RegisterConverterRule(
+    vtkSmartPointer<vtkClosedSurfaceToBinaryLabelmapConversionRule>::New());
+
+  const int segmentCounts[] = { 1, 10, 50 };
+  for (int volumeSize = 64; volumeSize <= maximumVolumeSize; volumeSize *= 2)
+    {
+    for (int numberOfSegments : segmentCounts)
+      {
+      testLabelmapToClosedSurface(volumeSize, numberOfSegments);
+      testClosedSurfaceToLabelmap(volumeSize, numberOfSegments);
+      testModifyBinaryLabelmap(volumeSize, numberOfSegments);
+      testCollapseBinaryLabelmaps(volumeSize, numberOfSegments);
+      testSegmentationHistory(volumeSize, numberOfSegments);
+      }
+    }
+  return EXIT_SUCCESS;
+}
@@ -34,9 +34,15 @@
 #include "vtkOrientedImageData.h"
 #include "vtkOrientedImageDataResample.h"
 #include "vtkSegmentationConverterFactory.h"
+#include "vtkSegmentationConversionCache.h"
+#include "vtkSegmentationConversionParameters.h"
+#include "vtkSegmentationConversionPath.h"
 #include "vtkBinaryLabelmapToClosedSurfaceConversionRule.h"
 #include "vtkClosedSurfaceToBinaryLabelmapConversionRule.h"
 
+// STD includes
+#include <cmath>
+
 void CreateSpherePolyData(vtkPolyData* polyData, double center[3], double radius);
 int CreateCubeLabelmap(vtkOrientedImageData* imageData, int extent[6]);
 
@@ -314,6 +320,315 @@ bool TestSharedLabelmapCasting()
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool TestParallelConversion()
+{
+  vtkNew<vtkSegmentation> segmentation;
+  segmentation->SetMasterRepresentationName(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName());
+  for (int i = 0; i < 8; ++i)
+    {
+    vtkNew<vtkOrientedImageData> cubeImage;
+    int extent[6] = { 4 * i, 4 * i + 2 + i % 3, 0, 2, 0, 2 };
+    CreateCubeLabelmap(cubeImage, extent);
+    vtkNew<vtkSegment> segment;
+    segment->AddRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName(), cubeImage);
+    segmentation->AddSegment(segment);
+    }
+  // Half of the segments in separate labelmaps, half in a shared labelmap
+  segmentation->CollapseBinaryLabelmaps(false);
+
+  std::vector<std::string> segmentIDs;
+  segmentation->GetSegmentIDs(segmentIDs);
+
+  for (const std::string jointSmoothing : { "0", "1" })
+    {
+    segmentation->SetConversionParameter(
+      vtkBinaryLabelmapToClosedSurfaceConversionRule::GetJointSmoothingParameterName(), jointSmoothing);
+
+    segmentation->ParallelConversionOff();
+    segmentation->CreateRepresentation(vtkSegmentationConverter::GetClosedSurfaceRepresentationName(), true);
+    std::vector<vtkIdType> expectedNumberOfPoints;
+    for (const std::string& segmentID : segmentIDs)
+      {
+      vtkPolyData* surface = vtkPolyData::SafeDownCast(segmentation->GetSegment(segmentID)->GetRepresentation(
+        vtkSegmentationConverter::GetClosedSurfaceRepresentationName()));
+      expectedNumberOfPoints.push_back(surface ? surface->GetNumberOfPoints() : -1);
+      }
+
+    segmentation->ParallelConversionOn();
+    segmentation->CreateRepresentation(vtkSegmentationConverter::GetClosedSurfaceRepresentationName(), true);
+    for (size_t i = 0; i < segmentIDs.size(); ++i)
+      {
+      vtkPolyData* surface = vtkPolyData::SafeDownCast(segmentation->GetSegment(segmentIDs[i])->GetRepresentation(
+        vtkSegmentationConverter::GetClosedSurfaceRepresentationName()));
+      if (!surface || surface->GetNumberOfPoints() == 0 || surface->GetNumberOfPoints() != expectedNumberOfPoints[i])
+        {
+        std::cerr << __LINE__ << ": Parallel conversion of segment " << segmentIDs[i] << " failed: "
+          << (surface ? surface->GetNumberOfPoints() : -1) << " points, expected " << expectedNumberOfPoints[i]
+          << " (joint smoothing: " << jointSmoothing << ")" << std::endl;
+        return false;
+        }
+      }
+    }
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestRepresentationMemoryBudget()
+{
+  vtkNew<vtkSegmentation> segmentation;
+  segmentation->SetMasterRepresentationName(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName());
+  for (int i = 0; i < 3; ++i)
+    {
+    vtkNew<vtkOrientedImageData> cubeImage;
+    int extent[6] = { 4 * i, 4 * i + 2, 0, 2, 0, 2 };
+    CreateCubeLabelmap(cubeImage, extent);
+    vtkNew<vtkSegment> segment;
+    segment->AddRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName(), cubeImage);
+    segmentation->AddSegment(segment);
+    }
+  std::string segmentID = segmentation->GetNthSegmentID(0);
+  const std::string closedSurfaceName = vtkSegmentationConverter::GetClosedSurfaceRepresentationName();
+
+  segmentation->CreateRepresentation(closedSurfaceName);
+  if (segmentation->GetRepresentationMemorySize(closedSurfaceName) <= 0)
+    {
+    std::cerr << __LINE__ << ": Invalid closed surface memory size" << std::endl;
+    return false;
+    }
+
+  // Released representation is regenerated on demand
+  if (!segmentation->ReleaseRepresentation(closedSurfaceName)
+    || segmentation->ContainsRepresentation(closedSurfaceName)
+    || !segmentation->IsRepresentationReleased(closedSurfaceName)
+    || segmentation->GetNumberOfRepresentationReleases() != 1)
+    {
+    std::cerr << __LINE__ << ": Failed to release closed surface representation" << std::endl;
+    return false;
+    }
+  vtkPolyData* surface = vtkPolyData::SafeDownCast(segmentation->GetSegmentRepresentation(segmentID, closedSurfaceName));
+  if (!surface || surface->GetNumberOfPoints() == 0
+    || !segmentation->ContainsRepresentation(closedSurfaceName)
+    || segmentation->IsRepresentationReleased(closedSurfaceName)
+    || segmentation->GetNumberOfRepresentationRegenerations() != 1)
+    {
+    std::cerr << __LINE__ << ": Failed to regenerate closed surface representation" << std::endl;
+    return false;
+    }
+
+  // The most recently used representation is kept even if it does not fit in the budget
+  segmentation->SetRepresentationMemoryBudget(1);
+  if (segmentation->EnforceRepresentationMemoryBudget() != 0 || !segmentation->ContainsRepresentation(closedSurfaceName))
+    {
+    std::cerr << __LINE__ << ": Most recently used representation was released" << std::endl;
+    return false;
+    }
+
+  // Explicitly removed representation is not regenerated
+  segmentation->ReleaseRepresentation(closedSurfaceName);
+  segmentation->RemoveRepresentation(closedSurfaceName);
+  if (segmentation->GetSegmentRepresentation(segmentID, closedSurfaceName) != nullptr)
+    {
+    std::cerr << __LINE__ << ": Removed representation was regenerated" << std::endl;
+    return false;
+    }
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestIncrementalSurfaceUpdate()
+{
+  // Sphere labelmap that is large enough for updating the surface locally
+  vtkNew<vtkOrientedImageData> labelmap;
+  labelmap->SetExtent(0, 159, 0, 159, 0, 159);
+  labelmap->SetSpacing(0.5, 0.5, 0.5);
+  labelmap->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  unsigned char* labelmapPtr = static_cast<unsigned char*>(labelmap->GetScalarPointer());
+  for (int k = 0; k < 160; ++k)
+    {
+    for (int j = 0; j < 160; ++j)
+      {
+      for (int i = 0; i < 160; ++i)
+        {
+        int distance2 = (i - 80) * (i - 80) + (j - 80) * (j - 80) + (k - 80) * (k - 80);
+        *(labelmapPtr++) = (distance2 < 50 * 50 ? 1 : 0);
+        }
+      }
+    }
+
+  vtkNew<vtkSegment> segment;
+  segment->AddRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName(), labelmap);
+  vtkNew<vtkBinaryLabelmapToClosedSurfaceConversionRule> rule;
+  rule->Convert(segment);
+  vtkPolyData* surface = vtkPolyData::SafeDownCast(segment->GetRepresentation(
+    vtkSegmentationConverter::GetClosedSurfaceRepresentationName()));
+  if (!surface || surface->GetNumberOfPolys() == 0)
+    {
+    std::cerr << __LINE__ << ": Failed to create closed surface" << std::endl;
+    return false;
+    }
+
+  // Add a small bump to the surface of the sphere, within a single labelmap block
+  for (int k = 72; k < 76; ++k)
+    {
+    for (int j = 72; j < 76; ++j)
+      {
+      for (int i = 26; i < 31; ++i)
+        {
+        *static_cast<unsigned char*>(labelmap->GetScalarPointer(i, j, k)) = 1;
+        }
+      }
+    }
+  labelmap->Modified();
+  rule->Convert(segment);
+  vtkPolyData* updatedSurface = vtkPolyData::SafeDownCast(segment->GetRepresentation(
+    vtkSegmentationConverter::GetClosedSurfaceRepresentationName()));
+
+  // Compare with a surface that is created from the whole labelmap
+  vtkNew<vtkSegment> referenceSegment;
+  referenceSegment->AddRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName(), labelmap);
+  vtkNew<vtkBinaryLabelmapToClosedSurfaceConversionRule> referenceRule;
+  referenceRule->Convert(referenceSegment);
+  vtkPolyData* referenceSurface = vtkPolyData::SafeDownCast(referenceSegment->GetRepresentation(
+    vtkSegmentationConverter::GetClosedSurfaceRepresentationName()));
+
+  if (updatedSurface != surface || !referenceSurface
+    || updatedSurface->GetNumberOfPolys() != referenceSurface->GetNumberOfPolys())
+    {
+    std::cerr << __LINE__ << ": Incremental surface update failed: "
+      << (updatedSurface ? updatedSurface->GetNumberOfPolys() : -1) << " polygons, expected "
+      << (referenceSurface ? referenceSurface->GetNumberOfPolys() : -1) << std::endl;
+    return false;
+    }
+  double bounds[6] = { 0.0, -1.0, 0.0, -1.0, 0.0, -1.0 };
+  double referenceBounds[6] = { 0.0, -1.0, 0.0, -1.0, 0.0, -1.0 };
+  updatedSurface->GetBounds(bounds);
+  referenceSurface->GetBounds(referenceBounds);
+  for (int i = 0; i < 6; ++i)
+    {
+    if (fabs(bounds[i] - referenceBounds[i]) > 1e-3)
+      {
+      std::cerr << __LINE__ << ": Incremental surface update failed: bounds[" << i << "] = " << bounds[i]
+        << ", expected " << referenceBounds[i] << std::endl;
+      return false;
+      }
+    }
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestConversionBudget()
+{
+  vtkNew<vtkSegmentation> segmentation;
+  segmentation->SetMasterRepresentationName(vtkSegmentationConverter::GetClosedSurfaceRepresentationName());
+  vtkNew<vtkPolyData> spherePolyData;
+  double center[3] = { 0.0, 0.0, 0.0 };
+  CreateSpherePolyData(spherePolyData, center, 3.0);
+  vtkNew<vtkSegment> segment;
+  segment->AddRepresentation(vtkSegmentationConverter::GetClosedSurfaceRepresentationName(), spherePolyData);
+  segmentation->AddSegment(segment);
+  SetReferenceGeometry(segmentation);
+
+  vtkNew<vtkSegmentationConversionPaths> paths;
+  segmentation->GetPossibleConversions(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName(), paths);
+  vtkSegmentationConversionPath* path = vtkSegmentationConverter::GetCheapestPath(paths);
+  if (!path || path->GetNumberOfRules() != 1 || path->GetRuleConversionTime(0) >= 0.0)
+    {
+    std::cerr << __LINE__ << ": Invalid conversion path" << std::endl;
+    return false;
+    }
+
+  // About 240^3 voxels without limiting the memory
+  vtkNew<vtkSegmentationConversionParameters> parameters;
+  segmentation->GetConversionParametersForPath(parameters, path);
+  parameters->SetValue(vtkClosedSurfaceToBinaryLabelmapConversionRule::GetOversamplingFactorParameterName(), "4");
+  parameters->SetValue(vtkClosedSurfaceToBinaryLabelmapConversionRule::GetMaximumMemoryParameterName(), "1");
+  segmentation->CreateRepresentation(path, parameters);
+
+  vtkOrientedImageData* labelmap = vtkOrientedImageData::SafeDownCast(
+    segment->GetRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName()));
+  double maximumNumberOfVoxels = 1.1 * 1024 * 1024;
+  if (!labelmap || labelmap->GetNumberOfPoints() == 0 || labelmap->GetNumberOfPoints() > maximumNumberOfVoxels)
+    {
+    std::cerr << __LINE__ << ": Labelmap does not fit in the memory budget: "
+      << (labelmap ? labelmap->GetNumberOfPoints() : -1) << " voxels" << std::endl;
+    return false;
+    }
+
+  // Actual cost of the conversion step is reported
+  if (path->GetRuleConversionTime(0) < 0.0 || path->GetRuleConversionMemorySize(0) <= 0)
+    {
+    std::cerr << __LINE__ << ": Conversion cost is not reported: " << path->GetRuleConversionTime(0) << " s, "
+      << path->GetRuleConversionMemorySize(0) << " KiB" << std::endl;
+    return false;
+    }
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestConversionCache()
+{
+  vtkNew<vtkSegmentationConversionCache> cache;
+  vtkIdType expectedNumberOfPoints = -1;
+  for (int segmentationIndex = 0; segmentationIndex < 2; ++segmentationIndex)
+    {
+    // Segmentations with the same content, as if the same file was read twice
+    vtkNew<vtkSegmentation> segmentation;
+    segmentation->SetMasterRepresentationName(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName());
+    segmentation->SetConversionCache(cache);
+    vtkNew<vtkOrientedImageData> cubeImage;
+    int extent[6] = { 0, 5, 0, 5, 0, 5 };
+    CreateCubeLabelmap(cubeImage, extent);
+    vtkNew<vtkSegment> segment;
+    segment->AddRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName(), cubeImage);
+    segmentation->AddSegment(segment);
+
+    segmentation->CreateRepresentation(vtkSegmentationConverter::GetClosedSurfaceRepresentationName());
+    vtkPolyData* surface = vtkPolyData::SafeDownCast(
+      segment->GetRepresentation(vtkSegmentationConverter::GetClosedSurfaceRepresentationName()));
+    if (!surface || surface->GetNumberOfPoints() == 0)
+      {
+      std::cerr << __LINE__ << ": Failed to create closed surface" << std::endl;
+      return false;
+      }
+    if (segmentationIndex == 0)
+      {
+      expectedNumberOfPoints = surface->GetNumberOfPoints();
+      }
+    else if (surface->GetNumberOfPoints() != expectedNumberOfPoints)
+      {
+      std::cerr << __LINE__ << ": Cached closed surface mismatch: " << surface->GetNumberOfPoints()
+        << " points, expected " << expectedNumberOfPoints << std::endl;
+      return false;
+      }
+    }
+  if (cache->GetNumberOfMisses() != 1 || cache->GetNumberOfHits() != 1)
+    {
+    std::cerr << __LINE__ << ": Conversion result was not reused: " << cache->GetNumberOfHits() << " hits, "
+      << cache->GetNumberOfMisses() << " misses" << std::endl;
+    return false;
+    }
+
+  // Different content is not found in the cache
+  vtkNew<vtkOrientedImageData> otherCubeImage;
+  int otherExtent[6] = { 0, 6, 0, 5, 0, 5 };
+  CreateCubeLabelmap(otherCubeImage, otherExtent);
+  vtkNew<vtkOrientedImageData> cubeImage;
+  int extent[6] = { 0, 5, 0, 5, 0, 5 };
+  CreateCubeLabelmap(cubeImage, extent);
+  if (vtkSegmentationConversionCache::GetContentHash(otherCubeImage) == vtkSegmentationConversionCache::GetContentHash(cubeImage))
+    {
+    std::cerr << __LINE__ << ": Content hash does not depend on the labelmap content" << std::endl;
+    return false;
+    }
+
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkSegmentationTest2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
 {
@@ -338,6 +653,31 @@ int vtkSegmentationTest2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
     return EXIT_FAILURE;
     }
 
+  if (!TestParallelConversion())
+    {
+    return EXIT_FAILURE;
+    }
+
+  if (!TestRepresentationMemoryBudget())
+    {
+    return EXIT_FAILURE;
+    }
+
+  if (!TestIncrementalSurfaceUpdate())
+    {
+    return EXIT_FAILURE;
+    }
+
+  if (!TestConversionBudget())
+    {
+    return EXIT_FAILURE;
+    }
+
+  if (!TestConversionCache())
+    {
+    return EXIT_FAILURE;
+    }
+
   std::cout << "Segmentation test 2 passed." << std::endl;
   return EXIT_SUCCESS;
 }
@@ -58,11 +58,156 @@
 #include <vtkSelection.h>
 #include <vtkSelectionNode.h>
 #include <vtkFloatArray.h>
+#include <vtkAppendPolyData.h>
+#include <vtkCellArray.h>
+#include <vtkCleanPolyData.h>
+#include <vtkMatrix4x4.h>
+
+// STD includes
+#include <algorithm>
 #include <vtkExtractSelectedIds.h>
 #include <vtkInformation.h>
 #include <vtkExtractSelection.h>
 #include <vtkSelectionSource.h>
 
+namespace
+{
+/// Size of the labelmap blocks that are compared for finding the modified region (in voxels)
+const int INCREMENTAL_UPDATE_BLOCK_SIZE = 16;
+/// Distance (in voxels) that a labelmap change can influence the surface.
+/// Each smoothing iteration propagates changes to neighbor points, which are closer than 1.5 voxels.
+const int INCREMENTAL_UPDATE_MARGIN = 32;
+
+//----------------------------------------------------------------------------
+int FloorDivide(int value, int divisor)
+{
+  return (value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor));
+}
+
+//----------------------------------------------------------------------------
+template<class ImageScalarType>
+void ComputeBlockHashesGeneric(vtkImageData* labelmap, int labelValue, std::map<std::array<int, 3>, vtkTypeUInt64>& blockHashes)
+{
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  labelmap->GetExtent(extent);
+  if (extent[0] > extent[1] || extent[2] > extent[3] || extent[4] > extent[5])
+    {
+    return;
+    }
+  vtkIdType increments[3] = { 0, 0, 0 };
+  labelmap->GetIncrements(increments);
+  ImageScalarType* imagePtr = static_cast<ImageScalarType*>(labelmap->GetScalarPointerForExtent(extent));
+  ImageScalarType segmentValue = static_cast<ImageScalarType>(labelValue);
+
+  int firstBlock[3] = { 0, 0, 0 };
+  int lastBlock[3] = { 0, 0, 0 };
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    firstBlock[axis] = FloorDivide(extent[2 * axis], INCREMENTAL_UPDATE_BLOCK_SIZE);
+    lastBlock[axis] = FloorDivide(extent[2 * axis + 1], INCREMENTAL_UPDATE_BLOCK_SIZE);
+    }
+
+  for (int bk = firstBlock[2]; bk <= lastBlock[2]; ++bk)
+    {
+    for (int bj = firstBlock[1]; bj <= lastBlock[1]; ++bj)
+      {
+      for (int bi = firstBlock[0]; bi <= lastBlock[0]; ++bi)
+        {
+        int blockIndex[3] = { bi, bj, bk };
+        int blockExtent[6] = { 0, -1, 0, -1, 0, -1 };
+        for (int axis = 0; axis < 3; ++axis)
+          {
+          blockExtent[2 * axis] = std::max(extent[2 * axis], blockIndex[axis] * INCREMENTAL_UPDATE_BLOCK_SIZE);
+          blockExtent[2 * axis + 1] = std::min(extent[2 * axis + 1], (blockIndex[axis] + 1) * INCREMENTAL_UPDATE_BLOCK_SIZE - 1);
+          }
+        // FNV-1a hash of the position of the segment voxels within the block
+        vtkTypeUInt64 hash = 14695981039346656037ULL;
+        bool blockEmpty = true;
+        for (int k = blockExtent[4]; k <= blockExtent[5]; ++k)
+          {
+          for (int j = blockExtent[2]; j <= blockExtent[3]; ++j)
+            {
+            ImageScalarType* rowPtr = imagePtr + (k - extent[4]) * increments[2] + (j - extent[2]) * increments[1];
+            for (int i = blockExtent[0]; i <= blockExtent[1]; ++i)
+              {
+              if (rowPtr[(i - extent[0]) * increments[0]] != segmentValue)
+                {
+                continue;
+                }
+              vtkTypeUInt64 voxelIndex = ((k - bk * INCREMENTAL_UPDATE_BLOCK_SIZE) * INCREMENTAL_UPDATE_BLOCK_SIZE
+                + (j - bj * INCREMENTAL_UPDATE_BLOCK_SIZE)) * INCREMENTAL_UPDATE_BLOCK_SIZE + (i - bi * INCREMENTAL_UPDATE_BLOCK_SIZE);
+              hash = (hash ^ voxelIndex) * 1099511628211ULL;
+              blockEmpty = false;
+              }
+            }
+          }
+        if (!blockEmpty)
+          {
+          blockHashes[{ bi, bj, bk }] = hash;
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Get the polygons of the surface that have their center inside (or outside) of the box.
+/// The box is specified in the IJK coordinate system of the labelmap.
+vtkSmartPointer<vtkPolyData> ExtractPolygonsInBox(vtkPolyData* polyData, vtkMatrix4x4* worldToImageMatrix,
+  const double box[6], bool inside)
+{
+  vtkNew<vtkCellArray> polys;
+  vtkPoints* points = polyData->GetPoints();
+  vtkCellArray* inputPolys = polyData->GetPolys();
+  if (points && inputPolys)
+    {
+    vtkIdType numberOfCellPoints = 0;
+    const vtkIdType* cellPointIds = nullptr;
+    for (inputPolys->InitTraversal(); inputPolys->GetNextCell(numberOfCellPoints, cellPointIds);)
+      {
+      if (numberOfCellPoints == 0)
+        {
+        continue;
+        }
+      double center_World[4] = { 0.0, 0.0, 0.0, 1.0 };
+      for (vtkIdType pointIndex = 0; pointIndex < numberOfCellPoints; ++pointIndex)
+        {
+        double point[3] = { 0.0, 0.0, 0.0 };
+        points->GetPoint(cellPointIds[pointIndex], point);
+        center_World[0] += point[0] / numberOfCellPoints;
+        center_World[1] += point[1] / numberOfCellPoints;
+        center_World[2] += point[2] / numberOfCellPoints;
+        }
+      double center_Image[4] = { 0.0, 0.0, 0.0, 1.0 };
+      worldToImageMatrix->MultiplyPoint(center_World, center_Image);
+      bool centerInside =
+           box[0] <= center_Image[0] && center_Image[0] < box[1]
+        && box[2] <= center_Image[1] && center_Image[1] < box[3]
+        && box[4] <= center_Image[2] && center_Image[2] < box[5];
+      if (centerInside == inside)
+        {
+        polys->InsertNextCell(numberOfCellPoints, cellPointIds);
+        }
+      }
+    }
+
+  vtkNew<vtkPolyData> extractedPolyData;
+  extractedPolyData->SetPoints(points);
+  extractedPolyData->GetPointData()->PassData(polyData->GetPointData());
+  extractedPolyData->SetPolys(polys);
+
+  // Remove the points that are not used by the extracted polygons
+  vtkNew<vtkCleanPolyData> cleaner;
+  cleaner->SetInputData(extractedPolyData);
+  cleaner->PointMergingOff();
+  cleaner->ConvertLinesToPointsOff();
+  cleaner->ConvertPolysToLinesOff();
+  cleaner->ConvertStripsToPolysOff();
+  cleaner->Update();
+  return cleaner->GetOutput();
+}
+}
+
 //----------------------------------------------------------------------------
 vtkSegmentationConverterRuleNewMacro(vtkBinaryLabelmapToClosedSurfaceConversionRule);
 
@@ -155,6 +300,9 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::Convert(vtkSegment* segment
 
   if (jointSmoothing > 0 && smoothingFactor > 0)
     {
+    // The joint smoothed surface is computed once per shared labelmap,
+    // segments converted in parallel wait for it.
+    std::unique_lock<std::mutex> jointSmoothCacheLock(this->JointSmoothCacheMutex);
     if (this->JointSmoothCache.find(orientedBinaryLabelmap) == this->JointSmoothCache.end())
       {
       double* scalarRange = orientedBinaryLabelmap->GetScalarRange();
@@ -185,12 +333,17 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::Convert(vtkSegment* segment
       this->JointSmoothCache[orientedBinaryLabelmap] = jointSmoothedSurface;
       }
 
-    vtkDataObject* sharedSurface = this->JointSmoothCache[orientedBinaryLabelmap];
-    if (!sharedSurface)
+    vtkPolyData* cachedSurface = this->JointSmoothCache[orientedBinaryLabelmap];
+    if (!cachedSurface)
       {
       vtkErrorMacro("Convert: Could not find cached surface");
       return false;
       }
+    // Each segment uses its own shallow copy as pipeline input so that the
+    // cached data object is not modified by the pipelines.
+    vtkNew<vtkPolyData> sharedSurface;
+    sharedSurface->ShallowCopy(cachedSurface);
+    jointSmoothCacheLock.unlock();
 
     vtkNew<vtkSelectionSource> selection;
     selection->SetContentType(vtkSelectionNode::THRESHOLDS);
@@ -211,8 +364,7 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::Convert(vtkSegment* segment
     }
   else
     {
-    std::vector<int> labelValue = { segment->GetLabelValue() };
-    this->CreateClosedSurface(orientedBinaryLabelmap, closedSurfacePolyData, labelValue);
+    this->UpdateClosedSurface(orientedBinaryLabelmap, closedSurfacePolyData, segment->GetLabelValue());
     }
 
   // Remove "ImageScalars" array because having a scalar in a model would get that
@@ -226,9 +378,176 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::Convert(vtkSegment* segment
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkBinaryLabelmapToClosedSurfaceConversionRule::UpdateClosedSurface(vtkOrientedImageData* orientedBinaryLabelmap,
+  vtkPolyData* closedSurfacePolyData, int labelValue)
+{
+  if (!closedSurfacePolyData || !orientedBinaryLabelmap)
+    {
+    vtkErrorMacro("UpdateClosedSurface: Invalid input or output");
+    return false;
+    }
+
+  double decimationFactor = this->ConversionParameters->GetValueAsDouble(GetDecimationFactorParameterName());
+  double smoothingFactor = this->ConversionParameters->GetValueAsDouble(GetSmoothingFactorParameterName());
+  int computeSurfaceNormals = this->ConversionParameters->GetValueAsInt(GetComputeSurfaceNormalsParameterName());
+  std::vector<int> labelValues = { labelValue };
+  if (decimationFactor > 0.0)
+    {
+    // Decimation result depends on the whole surface, it cannot be updated locally
+    return this->CreateClosedSurface(orientedBinaryLabelmap, closedSurfacePolyData, labelValues);
+    }
+
+  vtkNew<vtkMatrix4x4> imageToWorldMatrix;
+  orientedBinaryLabelmap->GetImageToWorldMatrix(imageToWorldMatrix);
+  std::array<double, 16> imageToWorld;
+  for (int i = 0; i < 16; ++i)
+    {
+    imageToWorld[i] = imageToWorldMatrix->GetElement(i / 4, i % 4);
+    }
+
+  std::map<std::array<int, 3>, vtkTypeUInt64> blockHashes;
+  switch (orientedBinaryLabelmap->GetScalarType())
+    {
+    vtkTemplateMacro(ComputeBlockHashesGeneric<VTK_TT>(orientedBinaryLabelmap, labelValue, blockHashes));
+    default:
+      vtkErrorMacro("UpdateClosedSurface: Unknown image scalar type!");
+      return false;
+    }
+
+  IncrementalUpdateState* state = nullptr;
+  bool newState = false;
+  {
+    std::lock_guard<std::mutex> lock(this->IncrementalUpdateStatesMutex);
+    // Forget surfaces that have been deleted
+    for (auto stateIt = this->IncrementalUpdateStates.begin(); stateIt != this->IncrementalUpdateStates.end();)
+      {
+      if (!stateIt->second.ClosedSurface)
+        {
+        stateIt = this->IncrementalUpdateStates.erase(stateIt);
+        }
+      else
+        {
+        ++stateIt;
+        }
+      }
+    newState = (this->IncrementalUpdateStates.find(closedSurfacePolyData) == this->IncrementalUpdateStates.end());
+    state = &this->IncrementalUpdateStates[closedSurfacePolyData];
+    state->ClosedSurface = closedSurfacePolyData;
+  }
+
+  bool previousSurfaceValid = !newState
+    && state->ClosedSurfaceMTime == closedSurfacePolyData->GetMTime()
+    && state->LabelValue == labelValue
+    && state->SmoothingFactor == smoothingFactor
+    && state->ComputeSurfaceNormals == computeSurfaceNormals
+    && state->ImageToWorld == imageToWorld
+    && closedSurfacePolyData->GetNumberOfCells() == closedSurfacePolyData->GetNumberOfPolys();
+
+  bool surfaceUpdated = false;
+  if (previousSurfaceValid)
+    {
+    // Get the extent of the blocks that have changed since the previous conversion
+    int modifiedExtent[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN };
+    auto addModifiedBlock = [&modifiedExtent](const std::array<int, 3>& blockIndex)
+      {
+      for (int axis = 0; axis < 3; ++axis)
+        {
+        modifiedExtent[2 * axis] = std::min(modifiedExtent[2 * axis], blockIndex[axis] * INCREMENTAL_UPDATE_BLOCK_SIZE);
+        modifiedExtent[2 * axis + 1] = std::max(modifiedExtent[2 * axis + 1], (blockIndex[axis] + 1) * INCREMENTAL_UPDATE_BLOCK_SIZE - 1);
+        }
+      };
+    for (const auto& block : blockHashes)
+      {
+      auto previousBlockIt = state->BlockHashes.find(block.first);
+      if (previousBlockIt == state->BlockHashes.end() || previousBlockIt->second != block.second)
+        {
+        addModifiedBlock(block.first);
+        }
+      }
+    for (const auto& previousBlock : state->BlockHashes)
+      {
+      if (blockHashes.find(previousBlock.first) == blockHashes.end())
+        {
+        addModifiedBlock(previousBlock.first);
+        }
+      }
+
+    if (modifiedExtent[0] > modifiedExtent[1])
+      {
+      // Segment voxels have not changed, the surface is up-to-date
+      surfaceUpdated = true;
+      }
+    else
+      {
+      // Polygons around the modified blocks are replaced. They are re-meshed from a region
+      // that is large enough that the region boundary does not influence them.
+      int labelmapExtent[6] = { 0, -1, 0, -1, 0, -1 };
+      orientedBinaryLabelmap->GetExtent(labelmapExtent);
+      int regionExtent[6] = { 0, -1, 0, -1, 0, -1 };
+      double replacedBox[6] = { 0.0, -1.0, 0.0, -1.0, 0.0, -1.0 };
+      double numberOfRegionVoxels = 1.0;
+      double numberOfLabelmapVoxels = 1.0;
+      for (int axis = 0; axis < 3; ++axis)
+        {
+        replacedBox[2 * axis] = modifiedExtent[2 * axis] - INCREMENTAL_UPDATE_MARGIN - 0.5;
+        replacedBox[2 * axis + 1] = modifiedExtent[2 * axis + 1] + INCREMENTAL_UPDATE_MARGIN + 0.5;
+        // Outside of the labelmap only the padding voxels are needed
+        regionExtent[2 * axis] = std::max(modifiedExtent[2 * axis] - 2 * INCREMENTAL_UPDATE_MARGIN, labelmapExtent[2 * axis] - 1);
+        regionExtent[2 * axis + 1] = std::min(modifiedExtent[2 * axis + 1] + 2 * INCREMENTAL_UPDATE_MARGIN, labelmapExtent[2 * axis + 1] + 1);
+        numberOfRegionVoxels *= std::max(0, regionExtent[2 * axis + 1] - regionExtent[2 * axis] + 1);
+        numberOfLabelmapVoxels *= std::max(0, labelmapExtent[2 * axis + 1] - labelmapExtent[2 * axis] + 1);
+        }
+
+      // Re-meshing a region that is not smaller than the labelmap would be slower than converting the whole labelmap
+      if (numberOfRegionVoxels > 0.0 && numberOfRegionVoxels < numberOfLabelmapVoxels)
+        {
+        vtkNew<vtkPolyData> regionSurface;
+        this->CreateClosedSurfaceInExtent(orientedBinaryLabelmap, regionSurface, labelValues, regionExtent);
+
+        vtkNew<vtkMatrix4x4> worldToImageMatrix;
+        orientedBinaryLabelmap->GetWorldToImageMatrix(worldToImageMatrix);
+        vtkNew<vtkAppendPolyData> append;
+        append->AddInputData(ExtractPolygonsInBox(closedSurfacePolyData, worldToImageMatrix, replacedBox, false));
+        append->AddInputData(ExtractPolygonsInBox(regionSurface, worldToImageMatrix, replacedBox, true));
+        append->Update();
+        closedSurfacePolyData->ShallowCopy(append->GetOutput());
+        surfaceUpdated = true;
+        }
+      }
+    }
+
+  if (!surfaceUpdated)
+    {
+    this->CreateClosedSurface(orientedBinaryLabelmap, closedSurfacePolyData, labelValues);
+    }
+
+  // Remove "ImageScalars" array now so that the modification time of the stored state matches the final surface
+  vtkPointData* pointData = closedSurfacePolyData->GetPointData();
+  if (pointData != nullptr)
+    {
+    pointData->RemoveArray("ImageScalars");
+    }
+
+  state->ClosedSurfaceMTime = closedSurfacePolyData->GetMTime();
+  state->LabelValue = labelValue;
+  state->SmoothingFactor = smoothingFactor;
+  state->ComputeSurfaceNormals = computeSurfaceNormals;
+  state->ImageToWorld = imageToWorld;
+  state->BlockHashes.swap(blockHashes);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurface(vtkOrientedImageData* orientedBinaryLabelmap,
   vtkPolyData* closedSurfacePolyData, std::vector<int> labelValues)
+{
+  return this->CreateClosedSurfaceInExtent(orientedBinaryLabelmap, closedSurfacePolyData, labelValues, nullptr);
+}
+
+//----------------------------------------------------------------------------
+bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurfaceInExtent(vtkOrientedImageData* orientedBinaryLabelmap,
+  vtkPolyData* closedSurfacePolyData, std::vector<int> labelValues, const int* regionExtent)
 {
   if (!closedSurfacePolyData)
     {
@@ -243,12 +562,10 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurface(vtkOrie
     return false;
     }
 
-  vtkSmartPointer<vtkImageData> binaryLabelmap = orientedBinaryLabelmap;
-  if (!binaryLabelmap)
-    {
-    vtkErrorMacro("Convert: Source representation is not data");
-    return false;
-    }
+  // Use a shallow copy as pipeline input so that the input data object is not
+  // modified, as it may be shared by segments that are converted in parallel.
+  vtkSmartPointer<vtkImageData> binaryLabelmap = vtkSmartPointer<vtkImageData>::New();
+  binaryLabelmap->ShallowCopy(orientedBinaryLabelmap);
 
   // Pad labelmap if it has non-background border voxels
   int* binaryLabelmapExtent = binaryLabelmap->GetExtent();
@@ -262,10 +579,18 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurface(vtkOrie
     return true;
     }
 
+  if (regionExtent)
+    {
+    // Crop the labelmap to the region, voxels outside of the labelmap are background
+    vtkSmartPointer<vtkImageConstantPad> padder = vtkSmartPointer<vtkImageConstantPad>::New();
+    padder->SetInputData(binaryLabelmap);
+    padder->SetOutputWholeExtent(regionExtent[0], regionExtent[1], regionExtent[2], regionExtent[3], regionExtent[4], regionExtent[5]);
+    padder->Update();
+    binaryLabelmap = padder->GetOutput();
+    }
   /// If input labelmap has non-background border voxels, then those regions remain open in the output closed surface.
   /// This function adds a 1 voxel padding to the labelmap in these cases.
-  bool paddingNecessary = this->IsLabelmapPaddingNecessary(binaryLabelmap);
-  if (paddingNecessary)
+  else if (this->IsLabelmapPaddingNecessary(binaryLabelmap))
     {
     vtkSmartPointer<vtkImageConstantPad> padder = vtkSmartPointer<vtkImageConstantPad>::New();
     padder->SetInputData(binaryLabelmap);
@@ -29,6 +29,12 @@
 
 // VTK includes
 #include <vtkPolyData.h>
+#include <vtkWeakPointer.h>
+
+// STD includes
+#include <array>
+#include <map>
+#include <mutex>
 
 /// \ingroup SegmentationCore
 /// \brief Convert binary labelmap representation (vtkOrientedImageData type) to
@@ -75,6 +81,9 @@ public:
   /// Clears the joint smoothing cache
   bool PostConvert(vtkSegmentation* segmentation) override;
 
+  /// Segments can be converted in parallel, the joint smoothing cache is locked.
+  bool IsThreadSafe() override { return true; };
+
   /// Get the cost of the conversion.
   unsigned int GetConversionCost(vtkDataObject* sourceRepresentation=nullptr, vtkDataObject* targetRepresentation=nullptr) override;
 
@@ -92,6 +101,17 @@ protected:
   /// This function checks whether this is the case.
   bool IsLabelmapPaddingNecessary(vtkImageData* binaryLabelMap);
 
+  /// Perform the conversion. If region extent is specified then only that region
+  /// of the labelmap (padded with background outside of the labelmap) is converted.
+  bool CreateClosedSurfaceInExtent(vtkOrientedImageData* inputImage, vtkPolyData* outputPolydata,
+    std::vector<int> values, const int* regionExtent);
+
+  /// Update the closed surface of a segment from its binary labelmap.
+  /// If the surface was created by the previous conversion of the same segment then
+  /// only the region around the labelmap blocks that changed since then is re-meshed
+  /// and replaced in the existing surface. Otherwise the whole surface is created.
+  bool UpdateClosedSurface(vtkOrientedImageData* inputImage, vtkPolyData* outputPolydata, int labelValue);
+
 protected:
   vtkBinaryLabelmapToClosedSurfaceConversionRule();
   ~vtkBinaryLabelmapToClosedSurfaceConversionRule() override;
@@ -100,6 +120,24 @@ protected:
   /// Cache for storing merged closed surfaces that have been joint smoothed
   /// The key used is the binary labelmap representation, which maps to the combined vtkPolyData containing surfaces for all segments in the segmentation
   std::map<vtkOrientedImageData*, vtkSmartPointer<vtkPolyData> > JointSmoothCache;
+  std::mutex JointSmoothCacheMutex;
+
+  /// Labelmap content and parameters that were used for creating a closed surface.
+  /// The labelmap is stored as a hash of the segment voxels in each block of the image.
+  struct IncrementalUpdateState
+    {
+    vtkWeakPointer<vtkPolyData> ClosedSurface;
+    vtkMTimeType ClosedSurfaceMTime{0};
+    int LabelValue{0};
+    double SmoothingFactor{0.0};
+    int ComputeSurfaceNormals{0};
+    std::array<double, 16> ImageToWorld;
+    std::map<std::array<int, 3>, vtkTypeUInt64> BlockHashes;
+    };
+  /// State of the last conversion of each closed surface, used for updating only the
+  /// modified region of the surface when the labelmap is edited locally.
+  std::map<vtkPolyData*, IncrementalUpdateState> IncrementalUpdateStates;
+  std::mutex IncrementalUpdateStatesMutex;
 
 private:
   vtkBinaryLabelmapToClosedSurfaceConversionRule(const vtkBinaryLabelmapToClosedSurfaceConversionRule&) = delete;
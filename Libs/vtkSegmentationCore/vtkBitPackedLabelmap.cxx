@@ -0,0 +1,541 @@
+/*==============================================================================
+
+  Copyright (c) Laboratory for Percutaneous Surgery (PerkLab)
+  Queen's University, Kingston, ON, Canada. All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// SegmentationCore includes
+#include "vtkBitPackedLabelmap.h"
+#include "vtkOrientedImageData.h"
+#include "vtkOrientedImageDataResample.h"
+
+// VTK includes
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkSMPTools.h>
+
+// STD includes
+#include <algorithm>
+
+namespace
+{
+const int BITS_PER_WORD = 64;
+
+//----------------------------------------------------------------------------
+int CountSetBits(vtkTypeUInt64 word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(word);
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool IsExtentEmpty(const int extent[6])
+{
+  return extent[0] > extent[1] || extent[2] > extent[3] || extent[4] > extent[5];
+}
+
+//----------------------------------------------------------------------------
+/// Mask of the bits of the last word of a row that are within the row
+vtkTypeUInt64 GetLastWordMask(int rowLength)
+{
+  int bitsInLastWord = rowLength % BITS_PER_WORD;
+  return bitsInLastWord == 0 ? ~vtkTypeUInt64(0) : ((vtkTypeUInt64(1) << bitsInLastWord) - 1);
+}
+
+//----------------------------------------------------------------------------
+/// Set the bits of voxels for which isSet(value) is true
+template<class ScalarType, class Predicate>
+void EncodeImage(vtkOrientedImageData* image, vtkTypeUInt64* words, vtkIdType wordsPerRow, Predicate isSet)
+{
+  int* extent = image->GetExtent();
+  int rowLength = extent[1] - extent[0] + 1;
+  const ScalarType* values = static_cast<const ScalarType*>(image->GetScalarPointer());
+  vtkIdType numberOfRows = static_cast<vtkIdType>(extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      const ScalarType* rowValues = values + row * rowLength;
+      vtkTypeUInt64* rowWords = words + row * wordsPerRow;
+      for (vtkIdType wordIndex = 0; wordIndex < wordsPerRow; ++wordIndex)
+        {
+        int firstVoxel = static_cast<int>(wordIndex * BITS_PER_WORD);
+        int numberOfVoxels = std::min(BITS_PER_WORD, rowLength - firstVoxel);
+        vtkTypeUInt64 word = 0;
+        for (int bit = 0; bit < numberOfVoxels; ++bit)
+          {
+          word |= static_cast<vtkTypeUInt64>(isSet(rowValues[firstVoxel + bit])) << bit;
+          }
+        rowWords[wordIndex] = word;
+        }
+      }
+    });
+}
+
+//----------------------------------------------------------------------------
+template<class ScalarType>
+void EncodeNonZero(vtkOrientedImageData* image, vtkTypeUInt64* words, vtkIdType wordsPerRow)
+{
+  EncodeImage<ScalarType>(image, words, wordsPerRow, [](ScalarType value) { return value != 0; });
+}
+
+//----------------------------------------------------------------------------
+template<class ScalarType>
+void EncodeLabel(vtkOrientedImageData* image, vtkTypeUInt64* words, vtkIdType wordsPerRow, double labelValue)
+{
+  EncodeImage<ScalarType>(image, words, wordsPerRow, [labelValue](ScalarType value) { return value == labelValue; });
+}
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkBitPackedLabelmap);
+
+//----------------------------------------------------------------------------
+vtkBitPackedLabelmap::vtkBitPackedLabelmap()
+{
+  this->WordsPerRow = 0;
+  for (int i = 0; i < 3; ++i)
+    {
+    this->Spacing[i] = 1.0;
+    this->Origin[i] = 0.0;
+    for (int j = 0; j < 3; ++j)
+      {
+      this->Directions[i][j] = (i == j ? 1.0 : 0.0);
+      }
+    }
+  this->Initialize();
+}
+
+//----------------------------------------------------------------------------
+vtkBitPackedLabelmap::~vtkBitPackedLabelmap() = default;
+
+//----------------------------------------------------------------------------
+void vtkBitPackedLabelmap::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Extent: " << this->Extent[0] << " " << this->Extent[1] << " " << this->Extent[2]
+    << " " << this->Extent[3] << " " << this->Extent[4] << " " << this->Extent[5] << "\n";
+  os << indent << "Spacing: " << this->Spacing[0] << " " << this->Spacing[1] << " " << this->Spacing[2] << "\n";
+  os << indent << "Origin: " << this->Origin[0] << " " << this->Origin[1] << " " << this->Origin[2] << "\n";
+  os << indent << "WordsPerRow: " << this->WordsPerRow << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkBitPackedLabelmap::Initialize()
+{
+  int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  this->AllocateWords(emptyExtent);
+  this->Words.shrink_to_fit();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkBitPackedLabelmap::AllocateWords(const int extent[6])
+{
+  std::copy(extent, extent + 6, this->Extent);
+  this->Words.clear();
+  if (IsExtentEmpty(extent))
+    {
+    this->WordsPerRow = 0;
+    return;
+    }
+  this->WordsPerRow = (extent[1] - extent[0] + BITS_PER_WORD) / BITS_PER_WORD;
+  vtkIdType numberOfRows = static_cast<vtkIdType>(extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1);
+  this->Words.resize(numberOfRows * this->WordsPerRow, 0);
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitPackedLabelmap::SetImage(vtkOrientedImageData* image)
+{
+  return this->SetImageInternal(image, true, 0.0);
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitPackedLabelmap::SetImage(vtkOrientedImageData* image, double labelValue)
+{
+  return this->SetImageInternal(image, false, labelValue);
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitPackedLabelmap::SetImageInternal(vtkOrientedImageData* image, bool nonZero, double labelValue)
+{
+  if (!image)
+    {
+    vtkErrorMacro("SetImage: Invalid input image");
+    return false;
+    }
+  if (image->GetPointData()->GetScalars() && image->GetNumberOfScalarComponents() != 1)
+    {
+    vtkErrorMacro("SetImage: Only single-component images are supported");
+    return false;
+    }
+
+  this->AllocateWords(image->GetExtent());
+  image->GetSpacing(this->Spacing);
+  image->GetOrigin(this->Origin);
+  image->GetDirections(this->Directions);
+  if (image->GetPointData()->GetScalars() && !this->Words.empty())
+    {
+    switch (image->GetScalarType())
+      {
+      vtkTemplateMacro(nonZero
+        ? EncodeNonZero<VTK_TT>(image, this->Words.data(), this->WordsPerRow)
+        : EncodeLabel<VTK_TT>(image, this->Words.data(), this->WordsPerRow, labelValue));
+      default:
+        vtkErrorMacro("SetImage: Unknown scalar type");
+        this->Initialize();
+        return false;
+      }
+    }
+  this->Words.shrink_to_fit();
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitPackedLabelmap::GetImage(vtkOrientedImageData* image, double labelValue/*=1.0*/, const int extent[6]/*=nullptr*/)
+{
+  if (!image)
+    {
+    vtkErrorMacro("GetImage: Invalid output image");
+    return false;
+    }
+  image->SetSpacing(this->Spacing);
+  image->SetOrigin(this->Origin);
+  image->SetDirections(this->Directions);
+  image->SetExtent(extent ? const_cast<int*>(extent) : this->Extent);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  int* outputExtent = image->GetExtent();
+  if (IsExtentEmpty(outputExtent))
+    {
+    return true;
+    }
+
+  unsigned char value = static_cast<unsigned char>(std::max(0.0, std::min(static_cast<double>(VTK_UNSIGNED_CHAR_MAX), labelValue)));
+  unsigned char* values = static_cast<unsigned char*>(image->GetScalarPointer());
+  int rowLength = outputExtent[1] - outputExtent[0] + 1;
+  vtkIdType numberOfRowsPerSlice = outputExtent[3] - outputExtent[2] + 1;
+  vtkIdType numberOfRows = numberOfRowsPerSlice * (outputExtent[5] - outputExtent[4] + 1);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      int j = outputExtent[2] + static_cast<int>(row % numberOfRowsPerSlice);
+      int k = outputExtent[4] + static_cast<int>(row / numberOfRowsPerSlice);
+      unsigned char* rowValues = values + row * rowLength;
+      for (int firstVoxel = 0; firstVoxel < rowLength; firstVoxel += BITS_PER_WORD)
+        {
+        vtkTypeUInt64 word = this->GetWord(outputExtent[0] + firstVoxel, j, k);
+        int numberOfVoxels = std::min(BITS_PER_WORD, rowLength - firstVoxel);
+        for (int bit = 0; bit < numberOfVoxels; ++bit)
+          {
+          rowValues[firstVoxel + bit] = ((word >> bit) & 1) ? value : 0;
+          }
+        }
+      }
+    });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkBitPackedLabelmap::GetExtent(int extent[6])
+{
+  std::copy(this->Extent, this->Extent + 6, extent);
+}
+
+//----------------------------------------------------------------------------
+void vtkBitPackedLabelmap::GetImageToWorldMatrix(vtkMatrix4x4* imageToWorldMatrix)
+{
+  if (!imageToWorldMatrix)
+    {
+    return;
+    }
+  imageToWorldMatrix->Identity();
+  for (int row = 0; row < 3; ++row)
+    {
+    for (int col = 0; col < 3; ++col)
+      {
+      imageToWorldMatrix->SetElement(row, col, this->Spacing[col] * this->Directions[row][col]);
+      }
+    imageToWorldMatrix->SetElement(row, 3, this->Origin[row]);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64* vtkBitPackedLabelmap::GetRowWords(int j, int k)
+{
+  if (IsExtentEmpty(this->Extent)
+    || j < this->Extent[2] || j > this->Extent[3] || k < this->Extent[4] || k > this->Extent[5])
+    {
+    return nullptr;
+    }
+  vtkIdType rowIndex = static_cast<vtkIdType>(k - this->Extent[4]) * (this->Extent[3] - this->Extent[2] + 1) + (j - this->Extent[2]);
+  return this->Words.data() + rowIndex * this->WordsPerRow;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkBitPackedLabelmap::GetWord(int i, int j, int k)
+{
+  const vtkTypeUInt64* rowWords = this->GetRowWords(j, k);
+  if (!rowWords)
+    {
+    return 0;
+    }
+  vtkIdType offset = static_cast<vtkIdType>(i) - this->Extent[0];
+  if (offset <= -BITS_PER_WORD || offset >= this->WordsPerRow * BITS_PER_WORD)
+    {
+    return 0;
+    }
+  if (offset < 0)
+    {
+    return rowWords[0] << (-offset);
+    }
+  vtkIdType wordIndex = offset / BITS_PER_WORD;
+  int shift = static_cast<int>(offset % BITS_PER_WORD);
+  if (shift == 0)
+    {
+    return rowWords[wordIndex];
+    }
+  vtkTypeUInt64 word = rowWords[wordIndex] >> shift;
+  if (wordIndex + 1 < this->WordsPerRow)
+    {
+    word |= rowWords[wordIndex + 1] << (BITS_PER_WORD - shift);
+    }
+  return word;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitPackedLabelmap::GetValue(int i, int j, int k)
+{
+  if (i < this->Extent[0] || i > this->Extent[1])
+    {
+    return false;
+    }
+  return (this->GetWord(i, j, k) & 1) != 0;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkBitPackedLabelmap::GetNumberOfSetVoxels()
+{
+  vtkIdType numberOfSetVoxels = 0;
+  for (vtkTypeUInt64 word : this->Words)
+    {
+    numberOfSetVoxels += CountSetBits(word);
+    }
+  return numberOfSetVoxels;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitPackedLabelmap::CalculateEffectiveExtent(int effectiveExtent[6])
+{
+  int validExtent[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN };
+  for (int k = this->Extent[4]; k <= this->Extent[5]; ++k)
+    {
+    for (int j = this->Extent[2]; j <= this->Extent[3]; ++j)
+      {
+      const vtkTypeUInt64* rowWords = this->GetRowWords(j, k);
+      if (!rowWords)
+        {
+        continue;
+        }
+      for (vtkIdType wordIndex = 0; wordIndex < this->WordsPerRow; ++wordIndex)
+        {
+        vtkTypeUInt64 word = rowWords[wordIndex];
+        if (word == 0)
+          {
+          continue;
+          }
+        int firstVoxel = this->Extent[0] + static_cast<int>(wordIndex * BITS_PER_WORD);
+        int lowestBit = 0;
+        while (((word >> lowestBit) & 1) == 0)
+          {
+          ++lowestBit;
+          }
+        int highestBit = BITS_PER_WORD - 1;
+        while (((word >> highestBit) & 1) == 0)
+          {
+          --highestBit;
+          }
+        validExtent[0] = std::min(validExtent[0], firstVoxel + lowestBit);
+        validExtent[1] = std::max(validExtent[1], firstVoxel + highestBit);
+        validExtent[2] = std::min(validExtent[2], j);
+        validExtent[3] = std::max(validExtent[3], j);
+        validExtent[4] = std::min(validExtent[4], k);
+        validExtent[5] = std::max(validExtent[5], k);
+        }
+      }
+    }
+  if (validExtent[0] > validExtent[1])
+    {
+    int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    std::copy(emptyExtent, emptyExtent + 6, effectiveExtent);
+    return false;
+    }
+  std::copy(validExtent, validExtent + 6, effectiveExtent);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitPackedLabelmap::DoGeometriesMatch(vtkBitPackedLabelmap* other)
+{
+  if (!other)
+    {
+    return false;
+    }
+  for (int i = 0; i < 3; ++i)
+    {
+    if (!vtkOrientedImageDataResample::AreEqualWithTolerance(this->Spacing[i], other->Spacing[i])
+      || !vtkOrientedImageDataResample::AreEqualWithTolerance(this->Origin[i], other->Origin[i]))
+      {
+      return false;
+      }
+    for (int j = 0; j < 3; ++j)
+      {
+      if (!vtkOrientedImageDataResample::AreEqualWithTolerance(this->Directions[i][j], other->Directions[i][j]))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+template <class WordOperation>
+void vtkBitPackedLabelmap::ApplyWordOperation(vtkBitPackedLabelmap* other, WordOperation operation)
+{
+  if (this->Words.empty())
+    {
+    return;
+    }
+  bool extentsMatch = std::equal(this->Extent, this->Extent + 6, other->Extent);
+  vtkTypeUInt64 lastWordMask = GetLastWordMask(this->Extent[1] - this->Extent[0] + 1);
+  vtkIdType numberOfRowsPerSlice = this->Extent[3] - this->Extent[2] + 1;
+  vtkIdType numberOfRows = numberOfRowsPerSlice * (this->Extent[5] - this->Extent[4] + 1);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      vtkTypeUInt64* rowWords = this->Words.data() + row * this->WordsPerRow;
+      if (extentsMatch)
+        {
+        // Same layout, words can be combined directly
+        const vtkTypeUInt64* otherRowWords = other->Words.data() + row * this->WordsPerRow;
+        for (vtkIdType wordIndex = 0; wordIndex < this->WordsPerRow; ++wordIndex)
+          {
+          rowWords[wordIndex] = operation(rowWords[wordIndex], otherRowWords[wordIndex]);
+          }
+        }
+      else
+        {
+        int j = this->Extent[2] + static_cast<int>(row % numberOfRowsPerSlice);
+        int k = this->Extent[4] + static_cast<int>(row / numberOfRowsPerSlice);
+        for (vtkIdType wordIndex = 0; wordIndex < this->WordsPerRow; ++wordIndex)
+          {
+          int i = this->Extent[0] + static_cast<int>(wordIndex * BITS_PER_WORD);
+          rowWords[wordIndex] = operation(rowWords[wordIndex], other->GetWord(i, j, k));
+          }
+        }
+      rowWords[this->WordsPerRow - 1] &= lastWordMask;
+      }
+    });
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitPackedLabelmap::Union(vtkBitPackedLabelmap* other)
+{
+  if (!other || (!IsExtentEmpty(this->Extent) && !this->DoGeometriesMatch(other)))
+    {
+    vtkErrorMacro("Union: Geometry mismatch");
+    return false;
+    }
+  if (IsExtentEmpty(other->Extent))
+    {
+    return true;
+    }
+  if (IsExtentEmpty(this->Extent))
+    {
+    std::copy(other->Spacing, other->Spacing + 3, this->Spacing);
+    std::copy(other->Origin, other->Origin + 3, this->Origin);
+    for (int i = 0; i < 3; ++i)
+      {
+      std::copy(other->Directions[i], other->Directions[i] + 3, this->Directions[i]);
+      }
+    }
+
+  // Grow the extent to contain the other labelmap
+  int unionExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  for (int i = 0; i < 3; ++i)
+    {
+    unionExtent[i * 2] = IsExtentEmpty(this->Extent) ? other->Extent[i * 2] : std::min(this->Extent[i * 2], other->Extent[i * 2]);
+    unionExtent[i * 2 + 1] = IsExtentEmpty(this->Extent) ? other->Extent[i * 2 + 1] : std::max(this->Extent[i * 2 + 1], other->Extent[i * 2 + 1]);
+    }
+  if (!std::equal(unionExtent, unionExtent + 6, this->Extent))
+    {
+    // Move the current voxels to a temporary labelmap and copy them back into the grown extent
+    vtkNew<vtkBitPackedLabelmap> original;
+    original->Words.swap(this->Words);
+    original->WordsPerRow = this->WordsPerRow;
+    std::copy(this->Extent, this->Extent + 6, original->Extent);
+    this->AllocateWords(unionExtent);
+    this->ApplyWordOperation(original, [](vtkTypeUInt64, vtkTypeUInt64 otherWord) { return otherWord; });
+    }
+  this->ApplyWordOperation(other, [](vtkTypeUInt64 word, vtkTypeUInt64 otherWord) { return word | otherWord; });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitPackedLabelmap::Intersect(vtkBitPackedLabelmap* other)
+{
+  if (!this->DoGeometriesMatch(other))
+    {
+    vtkErrorMacro("Intersect: Geometry mismatch");
+    return false;
+    }
+  this->ApplyWordOperation(other, [](vtkTypeUInt64 word, vtkTypeUInt64 otherWord) { return word & otherWord; });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitPackedLabelmap::Subtract(vtkBitPackedLabelmap* other)
+{
+  if (!this->DoGeometriesMatch(other))
+    {
+    vtkErrorMacro("Subtract: Geometry mismatch");
+    return false;
+    }
+  this->ApplyWordOperation(other, [](vtkTypeUInt64 word, vtkTypeUInt64 otherWord) { return word & ~otherWord; });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkBitPackedLabelmap::Invert()
+{
+  this->ApplyWordOperation(this, [](vtkTypeUInt64 word, vtkTypeUInt64) { return ~word; });
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkBitPackedLabelmap::GetActualMemorySize()
+{
+  size_t memorySizeBytes = this->Words.capacity() * sizeof(vtkTypeUInt64);
+  return static_cast<unsigned long>((memorySizeBytes + 1023) / 1024);
+}
@@ -0,0 +1,137 @@
+/*==============================================================================
+
+  Copyright (c) Laboratory for Percutaneous Surgery (PerkLab)
+  Queen's University, Kingston, ON, Canada. All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkBitPackedLabelmap_h
+#define __vtkBitPackedLabelmap_h
+
+// VTK includes
+#include <vtkObject.h>
+#include <vtkType.h>
+
+// STD includes
+#include <vector>
+
+#include "vtkSegmentationCoreConfigure.h"
+
+class vtkMatrix4x4;
+class vtkOrientedImageData;
+
+/// \ingroup SegmentationCore
+/// \brief Binary labelmap stored with one bit per voxel.
+///
+/// Each row (along the I axis) of the labelmap is stored in 64-bit words, therefore the memory usage
+/// is 1/8 of an unsigned char image of the same extent. This is well suited for large segmentations
+/// of a single structure. Volume (number of set voxels) is computed by counting the set bits and
+/// logical operations (union, intersection, subtraction, inversion) are performed on whole words.
+///
+/// The labelmaps of logical operations must have the same geometry (origin, spacing, directions),
+/// but their extents may be different.
+class vtkSegmentationCore_EXPORT vtkBitPackedLabelmap : public vtkObject
+{
+public:
+  static vtkBitPackedLabelmap* New();
+  vtkTypeMacro(vtkBitPackedLabelmap, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Encode the non-zero voxels of the image. The image must have a single scalar component.
+  /// \return Success flag
+  bool SetImage(vtkOrientedImageData* image);
+
+  /// Encode the voxels of the image that are equal to labelValue (e.g., one segment of a shared labelmap).
+  /// The image must have a single scalar component.
+  /// \return Success flag
+  bool SetImage(vtkOrientedImageData* image, double labelValue);
+
+  /// Reconstruct the dense image as unsigned char scalars. Set voxels are filled with labelValue, others with 0.
+  /// \param extent If specified, only this sub-extent is reconstructed; voxels that
+  ///   are outside of the encoded extent are set to 0.
+  /// \return Success flag
+  bool GetImage(vtkOrientedImageData* image, double labelValue = 1.0, const int extent[6] = nullptr);
+
+  /// Remove all voxels and reset the extent to empty
+  void Initialize();
+
+  /// Get extent of the encoded image
+  void GetExtent(int extent[6]);
+  /// Get geometry of the encoded image
+  void GetImageToWorldMatrix(vtkMatrix4x4* imageToWorldMatrix);
+
+  /// Get value of a voxel. Returns false for positions outside of the extent.
+  bool GetValue(int i, int j, int k);
+
+  /// Get number of set voxels
+  vtkIdType GetNumberOfSetVoxels();
+
+  /// Compute the extent of the set voxels.
+  /// \return False if there are no set voxels.
+  bool CalculateEffectiveExtent(int effectiveExtent[6]);
+
+  /// Set the voxels that are set in the other labelmap. The extent is grown to contain the other labelmap.
+  /// \return False if the geometry of the labelmaps does not match
+  bool Union(vtkBitPackedLabelmap* other);
+  /// Clear the voxels that are not set in the other labelmap. The extent is not changed.
+  /// \return False if the geometry of the labelmaps does not match
+  bool Intersect(vtkBitPackedLabelmap* other);
+  /// Clear the voxels that are set in the other labelmap. The extent is not changed.
+  /// \return False if the geometry of the labelmaps does not match
+  bool Subtract(vtkBitPackedLabelmap* other);
+  /// Invert all voxels within the extent
+  void Invert();
+
+  /// Return true if the other labelmap has the same origin, spacing, and directions
+  bool DoGeometriesMatch(vtkBitPackedLabelmap* other);
+
+  /// Return the memory used by the bits, in kibibytes (1024 bytes), similarly to vtkDataObject::GetActualMemorySize.
+  unsigned long GetActualMemorySize();
+
+protected:
+  vtkBitPackedLabelmap();
+  ~vtkBitPackedLabelmap() override;
+
+  /// Encode non-zero voxels or voxels equal to labelValue
+  bool SetImageInternal(vtkOrientedImageData* image, bool nonZero, double labelValue);
+
+  /// Set the extent and clear all the voxels
+  void AllocateWords(const int extent[6]);
+
+  /// Get the 64 voxels of row (j, k) starting at voxel i, the voxel i is the lowest bit.
+  /// Voxels outside of the extent are not set.
+  vtkTypeUInt64 GetWord(int i, int j, int k);
+
+  /// Get the words of row (j, k). Returns nullptr if the row is outside of the extent.
+  vtkTypeUInt64* GetRowWords(int j, int k);
+
+  /// Apply on each word of the extent: word = operation(word, other word at the same position).
+  template <class WordOperation>
+  void ApplyWordOperation(vtkBitPackedLabelmap* other, WordOperation operation);
+
+protected:
+  int Extent[6];
+  double Spacing[3];
+  double Origin[3];
+  double Directions[3][3];
+
+  /// Number of words that store one row
+  vtkIdType WordsPerRow;
+  /// Bits of all the rows, ordered by row. Bits after the end of a row are not set.
+  std::vector<vtkTypeUInt64> Words;
+
+private:
+  vtkBitPackedLabelmap(const vtkBitPackedLabelmap&) = delete;
+  void operator=(const vtkBitPackedLabelmap&) = delete;
+};
+
+#endif
@@ -33,7 +33,7 @@
 #include <vtkVersion.h>
 
 // STD includes
-#include <math.h>
+#include <cmath>
 #include <algorithm>
 
 //----------------------------------------------------------------------------
@@ -433,6 +433,31 @@ void vtkCalculateOversamplingFactor::ClipMembershipFunction(vtkPiecewiseFunction
     }
 }
 
+//---------------------------------------------------------------------------
+double vtkCalculateOversamplingFactor::GetMaximumOversamplingFactor(vtkOrientedImageData* imageData, double maximumNumberOfVoxels)
+{
+  const double largestOversamplingFactor = 100.0;
+  if (!imageData)
+    {
+    return largestOversamplingFactor;
+    }
+  int extent[6] = {0,-1,0,-1,0,-1};
+  imageData->GetExtent(extent);
+  double numberOfVoxels = 1.0;
+  for (unsigned int axis=0; axis<3; ++axis)
+    {
+    int dimension = extent[axis*2+1] - extent[axis*2] + 1;
+    if (dimension <= 0)
+      {
+      return largestOversamplingFactor;
+      }
+    numberOfVoxels *= dimension;
+    }
+  // Oversampling scales the number of voxels by the cube of the factor
+  double maximumOversamplingFactor = std::cbrt(std::max(maximumNumberOfVoxels, 0.0) / numberOfVoxels);
+  return std::min(maximumOversamplingFactor, largestOversamplingFactor);
+}
+
 //---------------------------------------------------------------------------
 void vtkCalculateOversamplingFactor::ApplyOversamplingOnImageGeometry(vtkOrientedImageData* imageData, double oversamplingFactor)
 {
@@ -56,6 +56,11 @@ public:
   /// Does not allocate memory, just updates geometry.
   static void ApplyOversamplingOnImageGeometry(vtkOrientedImageData* imageData, double oversamplingFactor);
 
+  /// Get the largest oversampling factor that keeps the number of voxels of the oversampled
+  /// image geometry below the given maximum. Useful for limiting memory usage and computation time.
+  /// Returns 100.0 (the largest factor that is applied) if the image geometry is empty.
+  static double GetMaximumOversamplingFactor(vtkOrientedImageData* imageData, double maximumNumberOfVoxels);
+
 protected:
   /// Calculate relative structure size from input model and rasterization reference volume
   /// \return Success flag
@@ -32,22 +32,111 @@
 #include <vtkObjectFactory.h>
 #include <vtkVersion.h>
 #include <vtkSmartPointer.h>
+#include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkPolyData.h>
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
-#include <vtkImageCast.h>
-#include <vtkImageStencil.h>
+#include <vtkImageStencilData.h>
+#include <vtkPoints.h>
 #include <vtkPolyDataNormals.h>
+#include <vtkSMPTools.h>
 #include <vtkStripper.h>
+#include <vtkTimerLog.h>
 #include <vtkTriangleFilter.h>
 #include <vtkPolyDataToImageStencil.h>
 
 // STD includes
+#include <algorithm>
 #include <sstream>
 
 int DEFAULT_LABEL_VALUE = 1;
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Poly data to image stencil filter that can fill slabs of the same stencil concurrently.
+/// The stencil rows of different slices are stored separately, therefore slabs do not overlap.
+class vtkSlabPolyDataToImageStencil : public vtkPolyDataToImageStencil
+{
+public:
+  static vtkSlabPolyDataToImageStencil* New();
+  vtkTypeMacro(vtkSlabPolyDataToImageStencil, vtkPolyDataToImageStencil);
+
+  /// Fill the slices of the extent in the stencil data, which must already be allocated.
+  /// Cells of the input must be built before slabs are filled concurrently.
+  void FillSlab(vtkImageStencilData* data, int slabExtent[6], bool reportProgress)
+  {
+    this->ThreadedExecute(data, slabExtent, reportProgress ? 0 : 1);
+  }
+
+protected:
+  vtkSlabPolyDataToImageStencil() = default;
+  ~vtkSlabPolyDataToImageStencil() override = default;
+
+private:
+  vtkSlabPolyDataToImageStencil(const vtkSlabPolyDataToImageStencil&) = delete;
+  void operator=(const vtkSlabPolyDataToImageStencil&) = delete;
+};
+vtkStandardNewMacro(vtkSlabPolyDataToImageStencil);
+
+//----------------------------------------------------------------------------
+/// Get the extent that contains all the surface points in the IJK space of the image geometry.
+/// The points are transformed one by one, without creating a transformed copy of the poly data.
+/// If crop is enabled then the extent is intersected with the extent of the image geometry.
+void GetSurfaceExtentInImageGeometry(vtkPoints* surfacePoints, vtkOrientedImageData* geometryImageData, bool crop, int surfaceExtent[6])
+{
+  // We need to apply inverse of direction matrix to the input poly data
+  // so that we can expand the image in its IJK directions
+  vtkNew<vtkMatrix4x4> geometryImageToWorldMatrix;
+  geometryImageData->GetImageToWorldMatrix(geometryImageToWorldMatrix);
+  vtkNew<vtkMatrix4x4> worldToImageGeometryMatrix;
+  vtkMatrix4x4::Invert(geometryImageToWorldMatrix, worldToImageGeometryMatrix);
+
+  double surfaceBounds[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  vtkIdType numberOfPoints = surfacePoints->GetNumberOfPoints();
+  for (vtkIdType pointId = 0; pointId < numberOfPoints; ++pointId)
+    {
+    double point[4] = { 0.0, 0.0, 0.0, 1.0 };
+    surfacePoints->GetPoint(pointId, point);
+    double ijkPoint[4] = { 0.0, 0.0, 0.0, 1.0 };
+    worldToImageGeometryMatrix->MultiplyPoint(point, ijkPoint);
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      if (pointId == 0 || ijkPoint[axis] < surfaceBounds[2 * axis])
+        {
+        surfaceBounds[2 * axis] = ijkPoint[axis];
+        }
+      if (pointId == 0 || ijkPoint[axis] > surfaceBounds[2 * axis + 1])
+        {
+        surfaceBounds[2 * axis + 1] = ijkPoint[axis];
+        }
+      }
+    }
+
+  // Expand floating point bounds to extent integers
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    surfaceExtent[2 * axis] = static_cast<int>(floor(surfaceBounds[2 * axis]));
+    surfaceExtent[2 * axis + 1] = static_cast<int>(ceil(surfaceBounds[2 * axis + 1]));
+    }
+
+  if (crop)
+    {
+    // Set effective extent to be maximum as large as the reference extent (less memory needed if the extent only covers the non-zero region)
+    int referenceExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    geometryImageData->GetExtent(referenceExtent);
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      surfaceExtent[2 * axis] = std::max(surfaceExtent[2 * axis], referenceExtent[2 * axis]);
+      surfaceExtent[2 * axis + 1] = std::min(surfaceExtent[2 * axis + 1], referenceExtent[2 * axis + 1]);
+      }
+    }
+}
+
+} // end of anonymous namespace
+
 //----------------------------------------------------------------------------
 vtkSegmentationConverterRuleNewMacro(vtkClosedSurfaceToBinaryLabelmapConversionRule);
 
@@ -72,6 +161,13 @@ vtkClosedSurfaceToBinaryLabelmapConversionRule::vtkClosedSurfaceToBinaryLabelmap
   this->ConversionParameters->SetParameter(GetCollapseLabelmapsParameterName(), "1",
     "Merge the labelmaps into as few shared labelmaps as possible"
     " 1 = created labelmaps will be shared if possible without overwriting each other.");
+  // Conversion budget parameters
+  this->ConversionParameters->SetParameter(GetMaximumMemoryParameterName(), "0",
+    "Maximum memory size of the labelmap created for a segment, in megabytes. If the oversampled labelmap would be larger,"
+    " then the oversampling factor is reduced. 0 (default) = no limit.");
+  this->ConversionParameters->SetParameter(GetTargetTimeParameterName(), "0",
+    "Target conversion time of a segment, in seconds. The oversampling factor is reduced so that the conversion time,"
+    " estimated from the speed of previous conversions, does not exceed this value. 0 (default) = no limit.");
 }
 
 //----------------------------------------------------------------------------
@@ -167,6 +263,8 @@ bool vtkClosedSurfaceToBinaryLabelmapConversionRule::Convert(vtkSegment* segment
     vtkSegmentationConverter::DeserializeImageGeometry(geometryString, binaryLabelmap, false);
     }
 
+  double startTime = vtkTimerLog::GetUniversalTime();
+
   // Allocate output image data
   binaryLabelmap->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
 
@@ -196,11 +294,6 @@ bool vtkClosedSurfaceToBinaryLabelmapConversionRule::Convert(vtkSegment* segment
   inverseOutputLabelmapGeometryTransform->SetMatrix(outputLabelmapImageToWorldMatrix);
   inverseOutputLabelmapGeometryTransform->Inverse();
 
-  // Set geometry to identity for the volume so that we can perform the stencil operation in IJK space
-  vtkSmartPointer<vtkMatrix4x4> identityMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
-  identityMatrix->Identity();
-  binaryLabelmap->SetGeometryFromImageToWorldMatrix(identityMatrix);
-
   vtkSmartPointer<vtkTransformPolyDataFilter> transformPolyDataFilter =
     vtkSmartPointer<vtkTransformPolyDataFilter>::New();
   transformPolyDataFilter->SetInputData(closedSurfacePolyData);
@@ -218,33 +311,57 @@ bool vtkClosedSurfaceToBinaryLabelmapConversionRule::Convert(vtkSegment* segment
   // Convert to triangle strip
   vtkSmartPointer<vtkStripper> stripper=vtkSmartPointer<vtkStripper>::New();
   stripper->SetInputConnection(triangle->GetOutputPort());
-
-  // Convert polydata to stencil
-  vtkNew<vtkPolyDataToImageStencil> polyDataToImageStencil;
-  polyDataToImageStencil->SetInputConnection(stripper->GetOutputPort());
-  polyDataToImageStencil->SetOutputSpacing(binaryLabelmap->GetSpacing());
-  polyDataToImageStencil->SetOutputOrigin(binaryLabelmap->GetOrigin());
-  polyDataToImageStencil->SetOutputWholeExtent(binaryLabelmap->GetExtent());
-
-  // Convert stencil to image
-  vtkNew<vtkImageStencil> stencil;
-  stencil->SetInputData(binaryLabelmap);
-  stencil->SetStencilConnection(polyDataToImageStencil->GetOutputPort());
-  stencil->ReverseStencilOn();
+  stripper->Update();
+
+  // The surface is cut concurrently by the slabs, so the cells are built in advance
+  vtkNew<vtkPolyData> ijkSurfacePolyData;
+  ijkSurfacePolyData->ShallowCopy(stripper->GetOutput());
+  ijkSurfacePolyData->BuildCells();
+
+  // Convert polydata to stencil in IJK space
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  binaryLabelmap->GetExtent(extent);
+  vtkNew<vtkSlabPolyDataToImageStencil> polyDataToImageStencil;
+  polyDataToImageStencil->SetInputData(ijkSurfacePolyData);
+  vtkNew<vtkImageStencilData> stencilData;
+  stencilData->SetSpacing(1.0, 1.0, 1.0);
+  stencilData->SetOrigin(0.0, 0.0, 0.0);
+  stencilData->SetExtent(extent);
+  stencilData->AllocateExtents();
+
+  // Fill the stencil and write the voxels inside the surface slab by slab.
   // If the output labelmap was to required to be unsigned char, we could use the segment label value.
   // To ensure that the label value is < 255, we set it to 1. Collapsing the labelmaps during post-conversion may assign new a value regardless.
-  stencil->SetBackgroundValue(DEFAULT_LABEL_VALUE); // General foreground value is 1 (background value because of reverse stencil)
-
-  // Save result to output
-  vtkNew<vtkImageCast> imageCast;
-  imageCast->SetInputConnection(stencil->GetOutputPort());
-  imageCast->SetOutputScalarTypeToUnsignedChar();
-  imageCast->Update();
-  binaryLabelmap->ShallowCopy(imageCast->GetOutput());
+  unsigned char* voxels = static_cast<unsigned char*>(binaryLabelmapVoxelsPointer);
+  vtkIdType rowLength = extent[1] - extent[0] + 1;
+  vtkIdType sliceLength = rowLength * (extent[3] - extent[2] + 1);
+  vtkSMPTools::For(extent[4], extent[5] + 1, [&](vtkIdType beginZ, vtkIdType endZ)
+    {
+    int slabExtent[6] = { extent[0], extent[1], extent[2], extent[3],
+      static_cast<int>(beginZ), static_cast<int>(endZ - 1) };
+    polyDataToImageStencil->FillSlab(stencilData, slabExtent, beginZ == extent[4]);
+    for (int z = slabExtent[4]; z <= slabExtent[5]; ++z)
+      {
+      for (int y = extent[2]; y <= extent[3]; ++y)
+        {
+        unsigned char* row = voxels + (z - extent[4]) * sliceLength + (y - extent[2]) * rowLength - extent[0];
+        int iter = 0;
+        int r1 = 0;
+        int r2 = 0;
+        while (stencilData->GetNextExtent(r1, r2, extent[0], extent[1], y, z, iter))
+          {
+          std::fill(row + r1, row + r2 + 1, static_cast<unsigned char>(DEFAULT_LABEL_VALUE));
+          }
+        }
+      }
+    });
 
-  // Restore geometry of the labelmap that we set to identity before conversion
-  // (so that we can perform the stencil operations in IJK space)
-  binaryLabelmap->SetGeometryFromImageToWorldMatrix(outputLabelmapImageToWorldMatrix);
+  // Store conversion speed for estimating time of the next conversions
+  double conversionTime = vtkTimerLog::GetUniversalTime() - startTime;
+  if (conversionTime > 0.01)
+    {
+    this->VoxelsPerSecond = static_cast<double>(sliceLength) * (extent[5] - extent[4] + 1) / conversionTime;
+    }
 
   // Set segment value to 1
   segment->SetLabelValue(DEFAULT_LABEL_VALUE);
@@ -329,9 +446,6 @@ bool vtkClosedSurfaceToBinaryLabelmapConversionRule::CalculateOutputGeometry(vtk
       }
     }
 
-  // Apply oversampling if needed
-  vtkCalculateOversamplingFactor::ApplyOversamplingOnImageGeometry(geometryImageData, oversamplingFactor);
-
   int cropToReferenceImageGeometry = 0;
     {
     std::string cropToReferenceImageGeometryString = this->ConversionParameters->GetValue(GetCropToReferenceImageGeometryParameterName());
@@ -344,54 +458,62 @@ bool vtkClosedSurfaceToBinaryLabelmapConversionRule::CalculateOutputGeometry(vtk
       }
     }
 
-  // We need to apply inverse of direction matrix to the input poly data
-  // so that we can expand the image in its IJK directions
-  vtkSmartPointer<vtkMatrix4x4> geometryImageToWorldMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
-  geometryImageData->GetImageToWorldMatrix(geometryImageToWorldMatrix);
-  vtkSmartPointer<vtkTransform> inverseImageGeometryTransform = vtkSmartPointer<vtkTransform>::New();
-  inverseImageGeometryTransform->SetMatrix(geometryImageToWorldMatrix);
-  inverseImageGeometryTransform->Inverse();
-
-  vtkSmartPointer<vtkTransformPolyDataFilter> transformPolyDataFilter =
-    vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-  transformPolyDataFilter->SetInputData(closedSurfacePolyData);
-  transformPolyDataFilter->SetTransform(inverseImageGeometryTransform);
-  transformPolyDataFilter->Update();
-  vtkPolyData* transformedClosedSurfacePolyData = transformPolyDataFilter->GetOutput();
+  // Reduce oversampling if the labelmap would not fit in the memory or time budget of the segment
+  double maximumNumberOfVoxels = this->GetMaximumNumberOfOutputVoxels();
+  if (maximumNumberOfVoxels > 0.0)
+    {
+    vtkNew<vtkOrientedImageData> surfaceGeometryImageData;
+    surfaceGeometryImageData->ShallowCopy(geometryImageData);
+    int surfaceExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    GetSurfaceExtentInImageGeometry(closedSurfacePolyData->GetPoints(), geometryImageData, cropToReferenceImageGeometry, surfaceExtent);
+    surfaceGeometryImageData->SetExtent(surfaceExtent);
+    double maximumOversamplingFactor = vtkCalculateOversamplingFactor::GetMaximumOversamplingFactor(
+      surfaceGeometryImageData, maximumNumberOfVoxels);
+    if (oversamplingFactor > maximumOversamplingFactor)
+      {
+      vtkInfoMacro("CalculateOutputGeometry: Oversampling factor is reduced from " << oversamplingFactor
+        << " to " << maximumOversamplingFactor << " to stay within the conversion budget");
+      oversamplingFactor = std::max(maximumOversamplingFactor, 0.01);
+      }
+    }
 
-  // Compute input closed surface poly data bounds
-  double surfaceBounds[6] = { 0, 0, 0, 0, 0, 0 };
-  transformedClosedSurfacePolyData->GetPoints()->GetBounds(surfaceBounds);
+  // Apply oversampling if needed
+  vtkCalculateOversamplingFactor::ApplyOversamplingOnImageGeometry(geometryImageData, oversamplingFactor);
 
-  // Expand floating point bounds to extent integers
+  // Set effective extent to be just large enough to contain the full surface
+  // (and maximum as large as the reference extent if cropping is requested)
   int surfaceExtent[6] = { 0, -1, 0, -1, 0, -1 };
-  surfaceExtent[0] = (int)floor(surfaceBounds[0]);
-  surfaceExtent[1] = (int)ceil(surfaceBounds[1]);
-  surfaceExtent[2] = (int)floor(surfaceBounds[2]);
-  surfaceExtent[3] = (int)ceil(surfaceBounds[3]);
-  surfaceExtent[4] = (int)floor(surfaceBounds[4]);
-  surfaceExtent[5] = (int)ceil(surfaceBounds[5]);
-
-  if (cropToReferenceImageGeometry)
+  GetSurfaceExtentInImageGeometry(closedSurfacePolyData->GetPoints(), geometryImageData, cropToReferenceImageGeometry, surfaceExtent);
+  geometryImageData->SetExtent(surfaceExtent);
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+double vtkClosedSurfaceToBinaryLabelmapConversionRule::GetMaximumNumberOfOutputVoxels()
+{
+  double maximumNumberOfVoxels = 0.0;
+
+  // Memory budget (one byte per voxel)
+  double maximumMemoryMB = this->ConversionParameters->GetValueAsDouble(GetMaximumMemoryParameterName());
+  if (maximumMemoryMB > 0.0)
     {
-    // Set effective extent to be maximum as large as the reference extent (less memory needed if the extent only covers the non-zero region)
-    int referenceExtent[6] = { 0, -1, 0, -1, 0, -1 };
-    geometryImageData->GetExtent(referenceExtent);
-    if (surfaceExtent[0] > referenceExtent[0]) { referenceExtent[0] = surfaceExtent[0]; }
-    if (surfaceExtent[1] < referenceExtent[1]) { referenceExtent[1] = surfaceExtent[1]; }
-    if (surfaceExtent[2] > referenceExtent[2]) { referenceExtent[2] = surfaceExtent[2]; }
-    if (surfaceExtent[3] < referenceExtent[3]) { referenceExtent[3] = surfaceExtent[3]; }
-    if (surfaceExtent[4] > referenceExtent[4]) { referenceExtent[4] = surfaceExtent[4]; }
-    if (surfaceExtent[5] < referenceExtent[5]) { referenceExtent[5] = surfaceExtent[5]; }
-    geometryImageData->SetExtent(referenceExtent);
+    maximumNumberOfVoxels = maximumMemoryMB * 1024.0 * 1024.0;
     }
-  else
+
+  // Time budget, only if the conversion speed has been already measured
+  double targetTime = this->ConversionParameters->GetValueAsDouble(GetTargetTimeParameterName());
+  double voxelsPerSecond = this->VoxelsPerSecond;
+  if (targetTime > 0.0 && voxelsPerSecond > 0.0)
     {
-    // Set effective extent to be just large enough to contain the full surface
-    geometryImageData->SetExtent(surfaceExtent);
+    double maximumNumberOfVoxelsForTime = targetTime * voxelsPerSecond;
+    if (maximumNumberOfVoxels <= 0.0 || maximumNumberOfVoxelsForTime < maximumNumberOfVoxels)
+      {
+      maximumNumberOfVoxels = maximumNumberOfVoxelsForTime;
+      }
     }
 
-  return true;
+  return maximumNumberOfVoxels;
 }
 
 //----------------------------------------------------------------------------
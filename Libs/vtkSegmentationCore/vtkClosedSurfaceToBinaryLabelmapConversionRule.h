@@ -27,6 +27,9 @@
 
 #include "vtkSegmentationCoreConfigure.h"
 
+// STD includes
+#include <atomic>
+
 class vtkPolyData;
 
 /// \ingroup SegmentationCore
@@ -46,6 +49,12 @@ public:
   /// Determines if the output binary labelmaps should be reduced to as few shared labelmaps as possible after conversion.
   /// A value of 1 means that the labelmaps will be collapsed, while a value of 0 means that they will not be collapsed.
   static const std::string GetCollapseLabelmapsParameterName() { return "Collapse labelmaps"; };
+  /// Conversion parameter: maximum memory size of the labelmap of a segment in megabytes.
+  /// The oversampling factor is reduced if necessary to stay within this limit. 0 means no limit.
+  static const std::string GetMaximumMemoryParameterName() { return "Maximum memory per segment (MB)"; };
+  /// Conversion parameter: target conversion time of a segment in seconds. The oversampling factor
+  /// is reduced if the time estimated from previous conversions would exceed it. 0 means no limit.
+  static const std::string GetTargetTimeParameterName() { return "Target time per segment (s)"; };
 
 public:
   static vtkClosedSurfaceToBinaryLabelmapConversionRule* New();
@@ -69,6 +78,9 @@ public:
   /// Collapses the segments to as few labelmaps as is possible
   bool PostConvert(vtkSegmentation* segmentation) override;
 
+  /// Segments can be converted in parallel, each conversion only uses its own segment.
+  bool IsThreadSafe() override { return true; };
+
   /// Get the cost of the conversion.
   unsigned int GetConversionCost(vtkDataObject* sourceRepresentation=nullptr, vtkDataObject* targetRepresentation=nullptr) override;
 
@@ -98,6 +110,10 @@ protected:
   /// \return Serialized image geometry for input poly data with identity directions and 1 mm spacing.
   std::string GetDefaultImageGeometryStringForPolyData(vtkPolyData* polyData);
 
+  /// Get maximum number of voxels of the output labelmap allowed by the memory and time budget
+  /// conversion parameters. Returns 0 if there is no limit.
+  double GetMaximumNumberOfOutputVoxels();
+
 protected:
   /// Flag determining whether to use the geometry of the given output oriented image data as is,
   /// or use the conversion parameters and the extent of the input surface. False by default,
@@ -106,6 +122,10 @@ protected:
   /// then stitching them back together).
   bool UseOutputImageDataGeometry{false};
 
+  /// Number of output voxels computed per second in the last conversion,
+  /// used for estimating conversion time. 0 if not measured yet.
+  std::atomic<double> VoxelsPerSecond{0.0};
+
 protected:
   vtkClosedSurfaceToBinaryLabelmapConversionRule();
   ~vtkClosedSurfaceToBinaryLabelmapConversionRule() override;
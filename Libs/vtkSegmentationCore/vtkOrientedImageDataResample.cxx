@@ -22,20 +22,24 @@
 #include "vtkOrientedImageDataResample.h"
 #include "vtkSegmentationConverter.h"
 #include "vtkOrientedImageData.h"
+#include "vtkRunLengthLabelmap.h"
 
 // VTK includes
 #include <vtkAppendPolyData.h>
 #include <vtkBoundingBox.h>
+#include <vtkDataArray.h>
 #include <vtkGeneralTransform.h>
 #include <vtkImageCast.h>
 #include <vtkImageConstantPad.h>
-#include <vtkImageMask.h>
 #include <vtkImageReslice.h>
+#include <vtkLinearTransform.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPlaneSource.h>
 #include <vtkPointData.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
@@ -44,10 +48,52 @@
 
 // STD includes
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <set>
 #include <vector>
 
 vtkStandardNewMacro(vtkOrientedImageDataResample);
 
+//----------------------------------------------------------------------------
+// Apply rowOperation(baseRow, modifierRow, numberOfValues) on each row of the update extent.
+// Rows are independent, therefore they are distributed between threads.
+// rowOperation returns true if it changed any voxel of the row.
+// Returns true if any voxel of the base image was changed.
+template <class BaseImageScalarType, class ModifierImageScalarType, class RowOperation>
+bool ModifyImageRowsGeneric(
+    BaseImageScalarType* baseImagePtr,
+    const vtkIdType baseIncrements[3],
+    const ModifierImageScalarType* modifierImagePtr,
+    const vtkIdType modifierIncrements[3],
+    const int updateExt[6],
+    vtkIdType rowLength,
+    RowOperation rowOperation)
+{
+  vtkIdType numberOfRowsPerSlice = updateExt[3] - updateExt[2] + 1;
+  vtkIdType numberOfRows = numberOfRowsPerSlice * (updateExt[5] - updateExt[4] + 1);
+  std::atomic<bool> modified(false);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    bool rowsModified = false;
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      vtkIdType idxY = row % numberOfRowsPerSlice;
+      vtkIdType idxZ = row / numberOfRowsPerSlice;
+      rowsModified |= rowOperation(
+        baseImagePtr + idxZ * baseIncrements[2] + idxY * baseIncrements[1],
+        modifierImagePtr + idxZ * modifierIncrements[2] + idxY * modifierIncrements[1],
+        rowLength);
+      }
+    if (rowsModified)
+      {
+      modified = true;
+      }
+    });
+  return modified;
+}
+
 //----------------------------------------------------------------------------
 // This templated function executes the filter for any type of data.
 template <class BaseImageScalarType, class ModifierImageScalarType>
@@ -88,18 +134,6 @@ void MergeImageGeneric2(
     return;
     }
 
-  // Get increments to march through data
-  vtkIdType baseIncX = 0;
-  vtkIdType baseIncY = 0;
-  vtkIdType baseIncZ = 0;
-  vtkIdType modifierIncX = 0;
-  vtkIdType modifierIncY = 0;
-  vtkIdType modifierIncZ = 0;
-  baseImage->GetContinuousIncrements(updateExt, baseIncX, baseIncY, baseIncZ);
-  modifierImage->GetContinuousIncrements(updateExt, modifierIncX, modifierIncY, modifierIncZ);
-  int maxX = (updateExt[1] - updateExt[0]) * baseImage->GetNumberOfScalarComponents();
-  int maxY = updateExt[3] - updateExt[2];
-  int maxZ = updateExt[5] - updateExt[4];
   BaseImageScalarType* baseImagePtr = static_cast<BaseImageScalarType*>(baseImage->GetScalarPointerForExtent(updateExt));
   ModifierImageScalarType* modifierImagePtr = static_cast<ModifierImageScalarType*>(modifierImage->GetScalarPointerForExtent(updateExt));
 
@@ -114,59 +148,50 @@ void MergeImageGeneric2(
     return;
     }
 
+  // Get increments to march through data
+  vtkIdType baseIncrements[3] = { 0, 0, 0 };
+  vtkIdType modifierIncrements[3] = { 0, 0, 0 };
+  baseImage->GetIncrements(baseIncrements);
+  modifierImage->GetIncrements(modifierIncrements);
+  vtkIdType rowLength = static_cast<vtkIdType>(updateExt[1] - updateExt[0] + 1) * baseImage->GetNumberOfScalarComponents();
+
+  // The operation is selected outside of the loops and each row is processed by a branch-free loop
+  // that the compiler can vectorize. Voxels are written unconditionally, whether the base image
+  // was modified is accumulated per row.
   bool baseImageModified = false;
-
-  // Loop through output pixels
-  // There is difference in only one line between min/max computation but the comparison
-  // is performed for each pixel, so it is faster to make the conditional expression in the outer loop.
-  // Looping is performed in two step: first we just check if any of the pixels have to be changed,
-  // if we find any, then we set baseImageModified flag and to the second loop without need to set
-  // baseImageModified flag again (setting a flag in a hot loop may impact speed).
   if (operation == vtkOrientedImageDataResample::OPERATION_MAXIMUM)
     {
-    for (vtkIdType idxZ = 0; idxZ <= maxZ; idxZ++)
+    baseImageModified = ModifyImageRowsGeneric(baseImagePtr, baseIncrements, modifierImagePtr, modifierIncrements, updateExt, rowLength,
+      [](BaseImageScalarType* baseRow, const ModifierImageScalarType* modifierRow, vtkIdType numberOfValues)
       {
-      for (vtkIdType idxY = 0; idxY <= maxY; idxY++)
+      bool rowModified = false;
+      for (vtkIdType idxX = 0; idxX < numberOfValues; idxX++)
         {
-        for (vtkIdType idxX = 0; idxX <= maxX; idxX++)
-          {
-          if (static_cast<BaseImageScalarType>(*modifierImagePtr) > *baseImagePtr)
-            {
-            *baseImagePtr = *modifierImagePtr;
-            baseImageModified = true;
-            }
-          baseImagePtr++;
-          modifierImagePtr++;
-          }
-        baseImagePtr += baseIncY;
-        modifierImagePtr += modifierIncY;
+        BaseImageScalarType baseValue = baseRow[idxX];
+        BaseImageScalarType modifierValue = static_cast<BaseImageScalarType>(modifierRow[idxX]);
+        bool changed = (modifierValue > baseValue);
+        rowModified |= changed;
+        baseRow[idxX] = changed ? modifierValue : baseValue;
         }
-      baseImagePtr += baseIncZ;
-      modifierImagePtr += modifierIncZ;
-      }
+      return rowModified;
+      });
     }
   else if (operation == vtkOrientedImageDataResample::OPERATION_MINIMUM)
     {
-    for (vtkIdType idxZ = 0; idxZ <= maxZ; idxZ++)
+    baseImageModified = ModifyImageRowsGeneric(baseImagePtr, baseIncrements, modifierImagePtr, modifierIncrements, updateExt, rowLength,
+      [](BaseImageScalarType* baseRow, const ModifierImageScalarType* modifierRow, vtkIdType numberOfValues)
       {
-      for (vtkIdType idxY = 0; idxY <= maxY; idxY++)
+      bool rowModified = false;
+      for (vtkIdType idxX = 0; idxX < numberOfValues; idxX++)
         {
-        for (vtkIdType idxX = 0; idxX <= maxX; idxX++)
-          {
-          if (static_cast<BaseImageScalarType>(*modifierImagePtr) < *baseImagePtr)
-            {
-            *baseImagePtr = *modifierImagePtr;
-            baseImageModified = true;
-            }
-          baseImagePtr++;
-          modifierImagePtr++;
-          }
-        baseImagePtr += baseIncY;
-        modifierImagePtr += modifierIncY;
+        BaseImageScalarType baseValue = baseRow[idxX];
+        BaseImageScalarType modifierValue = static_cast<BaseImageScalarType>(modifierRow[idxX]);
+        bool changed = (modifierValue < baseValue);
+        rowModified |= changed;
+        baseRow[idxX] = changed ? modifierValue : baseValue;
         }
-      baseImagePtr += baseIncZ;
-      modifierImagePtr += modifierIncZ;
-      }
+      return rowModified;
+      });
     }
   else if (operation == vtkOrientedImageDataResample::OPERATION_MASKING)
     {
@@ -201,26 +226,19 @@ void MergeImageGeneric2(
       maskThresholdModifierType = static_cast<ModifierImageScalarType>(maskThreshold);
       }
 
-    for (vtkIdType idxZ = 0; idxZ <= maxZ; idxZ++)
+    baseImageModified = ModifyImageRowsGeneric(baseImagePtr, baseIncrements, modifierImagePtr, modifierIncrements, updateExt, rowLength,
+      [fillValueBaseImageType, maskThresholdModifierType](BaseImageScalarType* baseRow, const ModifierImageScalarType* modifierRow,
+        vtkIdType numberOfValues)
       {
-      for (vtkIdType idxY = 0; idxY <= maxY; idxY++)
+      bool rowModified = false;
+      for (vtkIdType idxX = 0; idxX < numberOfValues; idxX++)
         {
-        for (vtkIdType idxX = 0; idxX <= maxX; idxX++)
-          {
-          if ((*modifierImagePtr) > maskThresholdModifierType)
-            {
-            *baseImagePtr = fillValueBaseImageType;
-            baseImageModified = true;
-            }
-          baseImagePtr++;
-          modifierImagePtr++;
+        bool inMask = (modifierRow[idxX] > maskThresholdModifierType);
+        rowModified |= inMask;
+        baseRow[idxX] = inMask ? fillValueBaseImageType : baseRow[idxX];
         }
-        baseImagePtr += baseIncY;
-        modifierImagePtr += modifierIncY;
-        }
-      baseImagePtr += baseIncZ;
-      modifierImagePtr += modifierIncZ;
-      }
+      return rowModified;
+      });
     }
   if (baseImageModified)
     {
@@ -252,6 +270,167 @@ void MergeImageGeneric(
     }
 }
 
+//----------------------------------------------------------------------------
+// Get the mapping of a voxel permuting transform: inputIJK[r] = referenceToInput[r][0..2] * referenceIJK + referenceToInput[r][3],
+// where the 3x3 part is a signed permutation matrix and the translation is integer.
+// Returns false if the referenceToInputMatrix does not map voxel centers to voxel centers this way.
+static bool GetVoxelPermutation(vtkMatrix4x4* referenceToInputMatrix, int referenceToInput[3][4])
+{
+  bool inputAxisUsed[3] = { false, false, false };
+  for (int row = 0; row < 3; ++row)
+    {
+    int numberOfNonZeroElements = 0;
+    for (int column = 0; column < 4; ++column)
+      {
+      double element = referenceToInputMatrix->GetElement(row, column);
+      double roundedElement = std::floor(element + 0.5);
+      if (!vtkOrientedImageDataResample::AreEqualWithTolerance(element, roundedElement))
+        {
+        return false;
+        }
+      referenceToInput[row][column] = static_cast<int>(roundedElement);
+      if (column == 3 || referenceToInput[row][column] == 0)
+        {
+        continue;
+        }
+      if (std::abs(referenceToInput[row][column]) != 1 || inputAxisUsed[column])
+        {
+        return false;
+        }
+      inputAxisUsed[column] = true;
+      ++numberOfNonZeroElements;
+      }
+    if (numberOfNonZeroElements != 1)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Fill outputImage by copying voxels of inputImage according to a voxel permutation (see GetVoxelPermutation).
+// Voxels that are mapped outside of the input extent are set to backgroundValue.
+// Rows are processed in parallel, contiguous input rows are copied at once.
+template <class ImageScalarType>
+void CopyPermutedImageGeneric(vtkImageData* inputImage, vtkImageData* outputImage, const int referenceToInput[3][4], double backgroundValue)
+{
+  int* inputExtent = inputImage->GetExtent();
+  int* outputExtent = outputImage->GetExtent();
+  const ImageScalarType* inputPtr = static_cast<ImageScalarType*>(inputImage->GetScalarPointer());
+  ImageScalarType* outputPtr = static_cast<ImageScalarType*>(outputImage->GetScalarPointer());
+  int numberOfComponents = inputImage->GetNumberOfScalarComponents();
+  vtkIdType inputIncrements[3] = { 0, 0, 0 };
+  inputImage->GetIncrements(inputIncrements);
+
+  // Make sure the background value is valid for the image scalar range
+  ImageScalarType backgroundValueImageType = 0;
+  if (backgroundValue < outputImage->GetScalarTypeMin())
+    {
+    backgroundValueImageType = static_cast<ImageScalarType>(outputImage->GetScalarTypeMin());
+    }
+  else if (backgroundValue > outputImage->GetScalarTypeMax())
+    {
+    backgroundValueImageType = static_cast<ImageScalarType>(outputImage->GetScalarTypeMax());
+    }
+  else
+    {
+    backgroundValueImageType = static_cast<ImageScalarType>(backgroundValue);
+    }
+
+  // Input axis that changes along output rows
+  int rowAxis = 0;
+  for (int row = 0; row < 3; ++row)
+    {
+    if (referenceToInput[row][0] != 0)
+      {
+      rowAxis = row;
+      }
+    }
+  int rowDirection = referenceToInput[rowAxis][0];
+  vtkIdType inputStride = rowDirection * inputIncrements[rowAxis];
+
+  vtkIdType rowLength = static_cast<vtkIdType>(outputExtent[1] - outputExtent[0] + 1) * numberOfComponents;
+  vtkIdType numberOfRowsPerSlice = outputExtent[3] - outputExtent[2] + 1;
+  vtkIdType numberOfRows = numberOfRowsPerSlice * (outputExtent[5] - outputExtent[4] + 1);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      int j = outputExtent[2] + static_cast<int>(row % numberOfRowsPerSlice);
+      int k = outputExtent[4] + static_cast<int>(row / numberOfRowsPerSlice);
+      ImageScalarType* outputRow = outputPtr + row * rowLength;
+
+      // Input voxel of the first voxel of the output row
+      int inputIjk[3] = { 0, 0, 0 };
+      bool rowInInputExtent = true;
+      for (int axis = 0; axis < 3; ++axis)
+        {
+        inputIjk[axis] = referenceToInput[axis][0] * outputExtent[0] + referenceToInput[axis][1] * j
+          + referenceToInput[axis][2] * k + referenceToInput[axis][3];
+        if (axis != rowAxis && (inputIjk[axis] < inputExtent[axis * 2] || inputIjk[axis] > inputExtent[axis * 2 + 1]))
+          {
+          rowInInputExtent = false;
+          }
+        }
+
+      // Range of output voxels of the row that are inside the input extent
+      vtkIdType beginIndex = rowLength;
+      vtkIdType endIndex = rowLength;
+      int numberOfVoxels = 0;
+      if (rowInInputExtent)
+        {
+        int firstVoxel = 0;
+        int lastVoxel = outputExtent[1] - outputExtent[0];
+        if (rowDirection > 0)
+          {
+          firstVoxel = std::max(firstVoxel, inputExtent[rowAxis * 2] - inputIjk[rowAxis]);
+          lastVoxel = std::min(lastVoxel, inputExtent[rowAxis * 2 + 1] - inputIjk[rowAxis]);
+          }
+        else
+          {
+          firstVoxel = std::max(firstVoxel, inputIjk[rowAxis] - inputExtent[rowAxis * 2 + 1]);
+          lastVoxel = std::min(lastVoxel, inputIjk[rowAxis] - inputExtent[rowAxis * 2]);
+          }
+        if (firstVoxel <= lastVoxel)
+          {
+          inputIjk[rowAxis] += rowDirection * firstVoxel;
+          numberOfVoxels = lastVoxel - firstVoxel + 1;
+          beginIndex = static_cast<vtkIdType>(firstVoxel) * numberOfComponents;
+          endIndex = static_cast<vtkIdType>(lastVoxel + 1) * numberOfComponents;
+          }
+        }
+      std::fill(outputRow, outputRow + beginIndex, backgroundValueImageType);
+      std::fill(outputRow + endIndex, outputRow + rowLength, backgroundValueImageType);
+      if (numberOfVoxels == 0)
+        {
+        continue;
+        }
+
+      const ImageScalarType* inputVoxel = inputPtr
+        + (inputIjk[0] - inputExtent[0]) * inputIncrements[0]
+        + (inputIjk[1] - inputExtent[2]) * inputIncrements[1]
+        + (inputIjk[2] - inputExtent[4]) * inputIncrements[2];
+      ImageScalarType* outputVoxel = outputRow + beginIndex;
+      if (inputStride == numberOfComponents)
+        {
+        // Integer shift along the row, copy the whole segment
+        std::copy(inputVoxel, inputVoxel + numberOfVoxels * numberOfComponents, outputVoxel);
+        continue;
+        }
+      for (int voxel = 0; voxel < numberOfVoxels; ++voxel)
+        {
+        for (int component = 0; component < numberOfComponents; ++component)
+          {
+          outputVoxel[component] = inputVoxel[component];
+          }
+        inputVoxel += inputStride;
+        outputVoxel += numberOfComponents;
+        }
+      }
+    });
+}
+
 //----------------------------------------------------------------------------
 vtkOrientedImageDataResample::vtkOrientedImageDataResample() = default;
 
@@ -437,6 +616,40 @@ bool vtkOrientedImageDataResample::ResampleOrientedImageToReferenceOrientedImage
     return false;
     }
 
+  // If voxels of the reference image are mapped to voxels of the input image by axis permutations, flips
+  // and integer shifts (typical for images that were derived from the same reference volume) then
+  // no interpolation is needed, voxels are directly copied.
+  vtkLinearTransform* inputImageLinearTransform = vtkLinearTransform::SafeDownCast(inputImageTransform);
+  if (isInputImageTransformIdentity || inputImageLinearTransform)
+    {
+    vtkNew<vtkMatrix4x4> inputImageToTransformedWorldMatrix;
+    inputImageToTransformedWorldMatrix->DeepCopy(inputImageToWorldMatrix);
+    if (inputImageLinearTransform)
+      {
+      vtkMatrix4x4::Multiply4x4(inputImageLinearTransform->GetMatrix(), inputImageToWorldMatrix, inputImageToTransformedWorldMatrix);
+      }
+    vtkNew<vtkMatrix4x4> referenceImageToInputImageMatrix;
+    vtkMatrix4x4::Multiply4x4(worldToReferenceImageMatrix, inputImageToTransformedWorldMatrix, referenceImageToInputImageMatrix);
+    referenceImageToInputImageMatrix->Invert();
+    int referenceToInput[3][4] = { { 0 } };
+    if (GetVoxelPermutation(referenceImageToInputImageMatrix, referenceToInput))
+      {
+      vtkNew<vtkImageData> permutedImage;
+      permutedImage->SetExtent(unionExtent);
+      permutedImage->AllocateScalars(inputImage->GetScalarType(), inputImage->GetNumberOfScalarComponents());
+      switch (inputImage->GetScalarType())
+        {
+        vtkTemplateMacro(CopyPermutedImageGeneric<VTK_TT>(inputImage, permutedImage, referenceToInput, backgroundValue));
+        default:
+          vtkGenericWarningMacro("vtkOrientedImageDataResample::ResampleOrientedImageToReferenceOrientedImage: Unknown ScalarType");
+          return false;
+        }
+      outputImage->ShallowCopy(permutedImage);
+      outputImage->SetImageToWorldMatrix(referenceImageToWorldMatrix.GetPointer());
+      return true;
+      }
+    }
+
   // Invert transform for the resampling
   vtkAbstractTransform* referenceImageToInputImageTransform = inputImageToReferenceImageTransform->GetInverse();
   referenceImageToInputImageTransform->Update();
@@ -1187,6 +1400,144 @@ bool vtkOrientedImageDataResample::ModifyImage(
   return true;
 }
 
+//----------------------------------------------------------------------------
+template <class BaseImageScalarType>
+void ModifyImageWithRunsGeneric(
+    vtkImageData *baseImage,
+    vtkRunLengthLabelmap *modifierLabelmap,
+    int operation,
+    const int extent[6],
+    double maskThreshold,
+    double fillValue)
+{
+  // Compute update extent as intersection of base and modifier extents (extent can be further reduced by specifying a smaller extent)
+  int updateExt[6] = { 0, -1, 0, -1, 0, -1 };
+  baseImage->GetExtent(updateExt);
+  int modifierExt[6] = { 0, -1, 0, -1, 0, -1 };
+  modifierLabelmap->GetExtent(modifierExt);
+  for (int idx = 0; idx < 3; ++idx)
+    {
+    updateExt[idx * 2] = std::max(updateExt[idx * 2], modifierExt[idx * 2]);
+    updateExt[idx * 2 + 1] = std::min(updateExt[idx * 2 + 1], modifierExt[idx * 2 + 1]);
+    if (extent)
+      {
+      updateExt[idx * 2] = std::max(updateExt[idx * 2], extent[idx * 2]);
+      updateExt[idx * 2 + 1] = std::min(updateExt[idx * 2 + 1], extent[idx * 2 + 1]);
+      }
+    }
+  if (updateExt[0] > updateExt[1] || updateExt[2] > updateExt[3] || updateExt[4] > updateExt[5])
+    {
+    // base and modifier images don't intersect, nothing need to be done
+    return;
+    }
+
+  // Make sure the fill value is valid for the base image scalar range
+  BaseImageScalarType fillValueBaseImageType = static_cast<BaseImageScalarType>(
+    std::max(baseImage->GetScalarTypeMin(), std::min(baseImage->GetScalarTypeMax(), fillValue)));
+
+  bool baseImageModified = false;
+  auto modifyRange = [&](BaseImageScalarType* baseImagePtr, int numberOfVoxels, double modifierValue)
+    {
+    if (operation == vtkOrientedImageDataResample::OPERATION_MASKING)
+      {
+      if (modifierValue <= maskThreshold)
+        {
+        return;
+        }
+      std::fill(baseImagePtr, baseImagePtr + numberOfVoxels, fillValueBaseImageType);
+      baseImageModified = true;
+      return;
+      }
+    BaseImageScalarType value = static_cast<BaseImageScalarType>(modifierValue);
+    for (int idxX = 0; idxX < numberOfVoxels; ++idxX, ++baseImagePtr)
+      {
+      if (operation == vtkOrientedImageDataResample::OPERATION_MAXIMUM ? value > *baseImagePtr : value < *baseImagePtr)
+        {
+        *baseImagePtr = value;
+        baseImageModified = true;
+        }
+      }
+    };
+
+  // Walk through each row as a sequence of runs and background gaps
+  for (int k = updateExt[4]; k <= updateExt[5]; ++k)
+    {
+    for (int j = updateExt[2]; j <= updateExt[3]; ++j)
+      {
+      BaseImageScalarType* rowPtr = static_cast<BaseImageScalarType*>(baseImage->GetScalarPointer(updateExt[0], j, k));
+      vtkIdType numberOfRuns = 0;
+      const vtkRunLengthLabelmap::Run* runs = modifierLabelmap->GetRowRuns(j, k, numberOfRuns);
+      int i = updateExt[0];
+      for (vtkIdType runIndex = 0; runIndex < numberOfRuns && i <= updateExt[1]; ++runIndex)
+        {
+        int begin = std::max(runs[runIndex].Begin, updateExt[0]);
+        int end = std::min(runs[runIndex].End, updateExt[1]);
+        if (begin > end)
+          {
+          continue;
+          }
+        if (begin > i)
+          {
+          modifyRange(rowPtr + (i - updateExt[0]), begin - i, 0.0);
+          }
+        modifyRange(rowPtr + (begin - updateExt[0]), end - begin + 1, runs[runIndex].Value);
+        i = end + 1;
+        }
+      if (i <= updateExt[1])
+        {
+        modifyRange(rowPtr + (i - updateExt[0]), updateExt[1] - i + 1, 0.0);
+        }
+      }
+    }
+  if (baseImageModified)
+    {
+    baseImage->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkOrientedImageDataResample::ModifyImage(
+    vtkOrientedImageData* inputImage,
+    vtkRunLengthLabelmap* modifierLabelmap,
+    int operation,
+    const int extent[6]/*=0*/,
+    double maskThreshold /*=0*/,
+    double fillValue /*=1*/)
+{
+  if (!inputImage || !modifierLabelmap)
+    {
+    return false;
+    }
+  if (inputImage->GetNumberOfScalarComponents() != 1)
+    {
+    vtkGenericWarningMacro("vtkOrientedImageDataResample::ModifyImage failed: inputImage must have a single scalar component");
+    return false;
+    }
+  vtkNew<vtkMatrix4x4> inputImageToWorldMatrix;
+  inputImage->GetImageToWorldMatrix(inputImageToWorldMatrix);
+  vtkNew<vtkMatrix4x4> modifierToWorldMatrix;
+  modifierLabelmap->GetImageToWorldMatrix(modifierToWorldMatrix);
+  if (!vtkOrientedImageDataResample::IsEqual(inputImageToWorldMatrix, modifierToWorldMatrix))
+    {
+    vtkGenericWarningMacro("vtkOrientedImageDataResample::ModifyImage failed: geometry mismatch between inputImage and modifierLabelmap");
+    return false;
+    }
+  switch (inputImage->GetScalarType())
+    {
+    vtkTemplateMacro(ModifyImageWithRunsGeneric<VTK_TT>(
+                       inputImage,
+                       modifierLabelmap,
+                       operation,
+                       extent,
+                       maskThreshold,
+                       fillValue));
+  default:
+    vtkGenericWarningMacro("vtkOrientedImageDataResample::ModifyImage failed: unknown ScalarType");
+    return false;
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool vtkOrientedImageDataResample::CopyImage(vtkOrientedImageData* imageToCopy, vtkOrientedImageData* outputImage, const int extent[6]/*=0*/)
 {
@@ -1418,6 +1769,142 @@ void vtkOrientedImageDataResample::FillImage(vtkImageData* image, double fillVal
     }
 }
 
+//----------------------------------------------------------------------------
+// Write the masked input image scalars into outputPtr, which has the same memory layout as the input image.
+template <class ImageScalarType, class MaskScalarType>
+void ApplyImageMaskGeneric2(
+    vtkImageData* input,
+    ImageScalarType* outputPtr,
+    vtkImageData* mask,
+    double fillValue,
+    bool notMask)
+{
+  int* inputExt = input->GetExtent();
+  int* maskExt = mask->GetExtent();
+  const ImageScalarType* inputPtr = static_cast<ImageScalarType*>(input->GetScalarPointer());
+  const MaskScalarType* maskPtr = nullptr;
+  vtkDataArray* maskScalars = mask->GetPointData()->GetScalars();
+  if (maskScalars && maskScalars->GetNumberOfTuples() > 0)
+    {
+    maskPtr = static_cast<MaskScalarType*>(maskScalars->GetVoidPointer(0));
+    }
+
+  // Make sure the fill value is valid for the input image scalar range
+  ImageScalarType fillValueImageType = 0;
+  if (fillValue < input->GetScalarTypeMin())
+    {
+    fillValueImageType = static_cast<ImageScalarType>(input->GetScalarTypeMin());
+    }
+  else if (fillValue > input->GetScalarTypeMax())
+    {
+    fillValueImageType = static_cast<ImageScalarType>(input->GetScalarTypeMax());
+    }
+  else
+    {
+    fillValueImageType = static_cast<ImageScalarType>(fillValue);
+    }
+
+  int numberOfComponents = input->GetNumberOfScalarComponents();
+  int numberOfMaskComponents = mask->GetNumberOfScalarComponents();
+  vtkIdType maskIncrements[3] = { 0, 0, 0 };
+  mask->GetIncrements(maskIncrements);
+
+  vtkIdType rowLength = static_cast<vtkIdType>(inputExt[1] - inputExt[0] + 1) * numberOfComponents;
+  vtkIdType numberOfRowsPerSlice = inputExt[3] - inputExt[2] + 1;
+  vtkIdType numberOfRows = numberOfRowsPerSlice * (inputExt[5] - inputExt[4] + 1);
+
+  // Range of voxels of each row that are inside the mask extent (empty if the mask image is empty)
+  int maskBeginI = std::max(inputExt[0], maskExt[0]);
+  int maskEndI = std::min(inputExt[1], maskExt[1]);
+  if (!maskPtr)
+    {
+    maskEndI = maskBeginI - 1;
+    }
+
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = beginRow; row < endRow; ++row)
+      {
+      const ImageScalarType* inputRow = inputPtr + row * rowLength;
+      ImageScalarType* outputRow = outputPtr + row * rowLength;
+      int j = inputExt[2] + static_cast<int>(row % numberOfRowsPerSlice);
+      int k = inputExt[4] + static_cast<int>(row / numberOfRowsPerSlice);
+
+      // Voxels outside of the mask extent are kept only if notMask is enabled
+      vtkIdType beginIndex = rowLength;
+      vtkIdType endIndex = rowLength;
+      if (maskBeginI <= maskEndI && j >= maskExt[2] && j <= maskExt[3] && k >= maskExt[4] && k <= maskExt[5])
+        {
+        beginIndex = static_cast<vtkIdType>(maskBeginI - inputExt[0]) * numberOfComponents;
+        endIndex = static_cast<vtkIdType>(maskEndI - inputExt[0] + 1) * numberOfComponents;
+        }
+      if (notMask)
+        {
+        std::copy(inputRow, inputRow + beginIndex, outputRow);
+        std::copy(inputRow + endIndex, inputRow + rowLength, outputRow + endIndex);
+        }
+      else
+        {
+        std::fill(outputRow, outputRow + beginIndex, fillValueImageType);
+        std::fill(outputRow + endIndex, outputRow + rowLength, fillValueImageType);
+        }
+      if (beginIndex >= endIndex)
+        {
+        continue;
+        }
+
+      // Voxels inside the mask extent
+      const MaskScalarType* maskRow = maskPtr
+        + (maskBeginI - maskExt[0]) * maskIncrements[0] + (j - maskExt[2]) * maskIncrements[1] + (k - maskExt[4]) * maskIncrements[2];
+      vtkIdType numberOfVoxels = maskEndI - maskBeginI + 1;
+      if (numberOfComponents == 1 && numberOfMaskComponents == 1)
+        {
+        const ImageScalarType* inputValues = inputRow + beginIndex;
+        ImageScalarType* outputValues = outputRow + beginIndex;
+        for (vtkIdType idxX = 0; idxX < numberOfVoxels; ++idxX)
+          {
+          bool keep = ((maskRow[idxX] != 0) != notMask);
+          outputValues[idxX] = keep ? inputValues[idxX] : fillValueImageType;
+          }
+        }
+      else
+        {
+        for (vtkIdType idxX = 0; idxX < numberOfVoxels; ++idxX)
+          {
+          bool keep = ((maskRow[idxX * numberOfMaskComponents] != 0) != notMask);
+          for (int component = 0; component < numberOfComponents; ++component)
+            {
+            vtkIdType index = beginIndex + idxX * numberOfComponents + component;
+            outputRow[index] = keep ? inputRow[index] : fillValueImageType;
+            }
+          }
+        }
+      }
+    });
+}
+
+//----------------------------------------------------------------------------
+template <class ImageScalarType>
+void ApplyImageMaskGeneric(
+    vtkImageData* input,
+    ImageScalarType* outputPtr,
+    vtkImageData* mask,
+    double fillValue,
+    bool notMask)
+{
+  switch (mask->GetScalarType())
+    {
+    vtkTemplateMacro((ApplyImageMaskGeneric2<ImageScalarType, VTK_TT>(
+                        input,
+                        outputPtr,
+                        mask,
+                        fillValue,
+                        notMask)));
+  default:
+    vtkGenericWarningMacro("vtkOrientedImageDataResample::ApplyImageMaskGeneric: Unknown ScalarType");
+    }
+}
+
 //-----------------------------------------------------------------------------
 bool vtkOrientedImageDataResample::ApplyImageMask(vtkOrientedImageData* input, vtkOrientedImageData* mask, double fillValue,
   bool notMask/*=false*/)
@@ -1435,28 +1922,35 @@ bool vtkOrientedImageDataResample::ApplyImageMask(vtkOrientedImageData* input, v
     return false;
     }
 
-  // Make sure mask has the same extent as the input labelmap
-  vtkSmartPointer<vtkImageConstantPad> padder = vtkSmartPointer<vtkImageConstantPad>::New();
-  padder->SetInputData(mask);
-  padder->SetOutputWholeExtent(input->GetExtent());
-  padder->Update();
-  //mask->DeepCopy(padder->GetOutput());
-
-  // Apply mask
-  vtkNew<vtkImageMask> masker;
-  masker->SetImageInputData(input);
-  //masker->SetMaskInputData(resampledMask);
-  masker->SetMaskInputData(padder->GetOutput());
-  //masker->SetMaskInputData(mask);
-  masker->SetNotMask(notMask);
-  masker->SetMaskedOutputValue(fillValue);
-  masker->Update();
-
-  // Copy masked input to input
-  vtkNew<vtkMatrix4x4> inputImageToWorldMatrix;
-  input->GetImageToWorldMatrix(inputImageToWorldMatrix.GetPointer());
-  input->ShallowCopy(masker->GetOutput());
-  input->SetGeometryFromImageToWorldMatrix(inputImageToWorldMatrix.GetPointer());
+  vtkDataArray* inputScalars = input->GetPointData()->GetScalars();
+  if (!inputScalars || inputScalars->GetNumberOfTuples() == 0)
+    {
+    // Empty input image, nothing to mask
+    return true;
+    }
+
+  // The masked voxels are written into a new scalar array (the input scalars may be shared with other images).
+  // Voxels outside of the mask extent are considered to be outside of the mask.
+  vtkSmartPointer<vtkDataArray> outputScalars = vtkSmartPointer<vtkDataArray>::Take(inputScalars->NewInstance());
+  outputScalars->SetName(inputScalars->GetName());
+  outputScalars->SetNumberOfComponents(inputScalars->GetNumberOfComponents());
+  outputScalars->SetNumberOfTuples(inputScalars->GetNumberOfTuples());
+
+  switch (input->GetScalarType())
+    {
+    vtkTemplateMacro(ApplyImageMaskGeneric<VTK_TT>(
+                       input,
+                       static_cast<VTK_TT*>(outputScalars->GetVoidPointer(0)),
+                       mask,
+                       fillValue,
+                       notMask));
+  default:
+    vtkGenericWarningMacro("vtkOrientedImageDataResample::ApplyImageMask failed: unknown ScalarType");
+    return false;
+    }
+
+  input->GetPointData()->SetScalars(outputScalars);
+  input->Modified();
 
   return true;
 }
@@ -1499,21 +1993,6 @@ void GetLabelValuesInMaskGeneric2(
     return;
     }
 
-  // Get increments to march through data
-  vtkIdType baseIncX = 0;
-  vtkIdType baseIncY = 0;
-  vtkIdType baseIncZ = 0;
-  vtkIdType maskIncX = 0;
-  vtkIdType maskIncY = 0;
-  vtkIdType maskIncZ = 0;
-  binaryLabelmap->GetContinuousIncrements(updateExt, baseIncX, baseIncY, baseIncZ);
-  mask->GetContinuousIncrements(updateExt, maskIncX, maskIncY, maskIncZ);
-  int maxX = (updateExt[1] - updateExt[0]) * binaryLabelmap->GetNumberOfScalarComponents();
-  int maxY = updateExt[3] - updateExt[2];
-  int maxZ = updateExt[5] - updateExt[4];
-  ImageScalarType* binaryLabelmapPointer = static_cast<ImageScalarType*>(binaryLabelmap->GetScalarPointerForExtent(updateExt));
-  MaskScalarType* maskPointer = static_cast<MaskScalarType*>(mask->GetScalarPointerForExtent(updateExt));
-
   // Make sure the threshold is valid for the modifier scalar range
   MaskScalarType maskThresholdMaskType = 0;
   if (maskThreshold < mask->GetScalarTypeMin())
@@ -1529,40 +2008,61 @@ void GetLabelValuesInMaskGeneric2(
     maskThresholdMaskType = static_cast<MaskScalarType>(maskThreshold);
     }
 
-  int minimumValue = (int)std::numeric_limits<ImageScalarType>::min();
-  int maximumValue = (int)std::numeric_limits<ImageScalarType>::max();
-  int rangeSize = maximumValue - minimumValue;
-
-  // Faster to preallocate a vector of the potential values between the minimum and maximum than to generate unique values using std::set
-  // Not scalable to any scalar range, so the preallocated array method is only used up to the maximum below.
-  size_t maximumSize = 1024 * 1024;
-  if (rangeSize * sizeof(int) <= maximumSize)
+  ImageScalarType* binaryLabelmapPointer = static_cast<ImageScalarType*>(binaryLabelmap->GetScalarPointerForExtent(updateExt));
+  MaskScalarType* maskPointer = static_cast<MaskScalarType*>(mask->GetScalarPointerForExtent(updateExt));
+  if (!binaryLabelmapPointer || !maskPointer)
     {
-    std::vector<int> arrayValues(rangeSize, 0);
-    for (vtkIdType idxZ = 0; idxZ <= maxZ; idxZ++)
+    return;
+    }
+
+  // Get increments to march through data
+  vtkIdType baseIncrements[3] = { 0, 0, 0 };
+  vtkIdType maskIncrements[3] = { 0, 0, 0 };
+  binaryLabelmap->GetIncrements(baseIncrements);
+  mask->GetIncrements(maskIncrements);
+  vtkIdType rowLength = static_cast<vtkIdType>(updateExt[1] - updateExt[0] + 1) * binaryLabelmap->GetNumberOfScalarComponents();
+  vtkIdType numberOfRowsPerSlice = updateExt[3] - updateExt[2] + 1;
+  vtkIdType numberOfRows = numberOfRowsPerSlice * (updateExt[5] - updateExt[4] + 1);
+
+  // Rows are processed in parallel, the values found by each thread are merged at the end.
+  // For scalar types of up to 16 bits it is faster to mark the found values in a preallocated array
+  // of all the potential values than to generate unique values using std::set.
+  if (std::numeric_limits<ImageScalarType>::is_integer && sizeof(ImageScalarType) <= 2)
+    {
+    int minimumValue = static_cast<int>(std::numeric_limits<ImageScalarType>::min());
+    int maximumValue = static_cast<int>(std::numeric_limits<ImageScalarType>::max());
+    std::vector<unsigned char> emptyValueFlags(maximumValue - minimumValue + 1, 0);
+    vtkSMPThreadLocal<std::vector<unsigned char> > threadValueFlags(emptyValueFlags);
+    vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
       {
-      for (vtkIdType idxY = 0; idxY <= maxY; idxY++)
+      std::vector<unsigned char>& valueFlags = threadValueFlags.Local();
+      for (vtkIdType row = beginRow; row < endRow; ++row)
         {
-        for (vtkIdType idxX = 0; idxX <= maxX; idxX++)
+        vtkIdType idxY = row % numberOfRowsPerSlice;
+        vtkIdType idxZ = row / numberOfRowsPerSlice;
+        const ImageScalarType* binaryLabelmapRow = binaryLabelmapPointer + idxZ * baseIncrements[2] + idxY * baseIncrements[1];
+        const MaskScalarType* maskRow = maskPointer + idxZ * maskIncrements[2] + idxY * maskIncrements[1];
+        for (vtkIdType idxX = 0; idxX < rowLength; ++idxX)
           {
-          if ((*maskPointer) > maskThresholdMaskType)
+          if (maskRow[idxX] > maskThresholdMaskType)
             {
-            int value = static_cast<int>(*binaryLabelmapPointer);
-            int index = value - minimumValue;
-            arrayValues[index] = value;
+            valueFlags[static_cast<int>(binaryLabelmapRow[idxX]) - minimumValue] = 1;
             }
-          binaryLabelmapPointer++;
-          maskPointer++;
           }
-        binaryLabelmapPointer += baseIncY;
-        maskPointer += maskIncY;
         }
-      binaryLabelmapPointer += baseIncZ;
-      maskPointer += maskIncZ;
+      });
+    std::vector<unsigned char> valueFlags(emptyValueFlags);
+    for (std::vector<unsigned char>& flags : threadValueFlags)
+      {
+      for (size_t index = 0; index < flags.size(); ++index)
+        {
+        valueFlags[index] |= flags[index];
+        }
       }
-    for (int value : arrayValues)
+    for (size_t index = 0; index < valueFlags.size(); ++index)
       {
-      if (value != 0)
+      int value = static_cast<int>(index) + minimumValue;
+      if (valueFlags[index] && value != 0)
         {
         foundValues.push_back(value);
         }
@@ -1570,26 +2070,29 @@ void GetLabelValuesInMaskGeneric2(
     }
   else
     {
-    std::set<int> setValues;
-    for (vtkIdType idxZ = 0; idxZ <= maxZ; idxZ++)
+    vtkSMPThreadLocal<std::set<int> > threadSetValues;
+    vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
       {
-      for (vtkIdType idxY = 0; idxY <= maxY; idxY++)
+      std::set<int>& setValues = threadSetValues.Local();
+      for (vtkIdType row = beginRow; row < endRow; ++row)
         {
-        for (vtkIdType idxX = 0; idxX <= maxX; idxX++)
+        vtkIdType idxY = row % numberOfRowsPerSlice;
+        vtkIdType idxZ = row / numberOfRowsPerSlice;
+        const ImageScalarType* binaryLabelmapRow = binaryLabelmapPointer + idxZ * baseIncrements[2] + idxY * baseIncrements[1];
+        const MaskScalarType* maskRow = maskPointer + idxZ * maskIncrements[2] + idxY * maskIncrements[1];
+        for (vtkIdType idxX = 0; idxX < rowLength; ++idxX)
           {
-          if ((*maskPointer) > maskThresholdMaskType)
+          if (maskRow[idxX] > maskThresholdMaskType)
             {
-            int value = static_cast<int>(*binaryLabelmapPointer);
-            setValues.insert(value);
+            setValues.insert(static_cast<int>(binaryLabelmapRow[idxX]));
             }
-          binaryLabelmapPointer++;
-          maskPointer++;
           }
-        binaryLabelmapPointer += baseIncY;
-        maskPointer += maskIncY;
         }
-      binaryLabelmapPointer += baseIncZ;
-      maskPointer += maskIncZ;
+      });
+    std::set<int> setValues;
+    for (std::set<int>& values : threadSetValues)
+      {
+      setValues.insert(values.begin(), values.end());
       }
     for (int value : setValues)
       {
@@ -34,6 +34,7 @@
 class vtkImageData;
 class vtkMatrix4x4;
 class vtkOrientedImageData;
+class vtkRunLengthLabelmap;
 class vtkTransform;
 class vtkAbstractTransform;
 
@@ -95,6 +96,12 @@ public:
   static bool ModifyImage(vtkOrientedImageData* inputImage, vtkOrientedImageData* modifierImage, int operation,
     const int extent[6] = nullptr, double maskThreshold = 0, double fillValue = 1);
 
+  /// Modifies inputImage in-place by combining with a run-length encoded modifier labelmap using max/min operation.
+  /// Same as ModifyImage with a dense modifier image, but the runs are applied directly, without reconstructing the modifier image.
+  /// inputImage and modifierLabelmap must have the same geometry (origin, spacing, directions), but they may have different extents.
+  static bool ModifyImage(vtkOrientedImageData* inputImage, vtkRunLengthLabelmap* modifierLabelmap, int operation,
+    const int extent[6] = nullptr, double maskThreshold = 0, double fillValue = 1);
+
   /// Copy image with clipping to the specified extent
   static bool CopyImage(vtkOrientedImageData* imageToCopy, vtkOrientedImageData* outputImage, const int extent[6]=nullptr);
 
@@ -163,6 +170,9 @@ public:
   /// \param notMask If on, the mask is passed through a boolean not before it is used to mask the image.
   ///   The effect is to pass the input pixels where the mask is zero, and replace the pixels where the
   ///   mask is non zero
+  /// Voxels of the input image that are outside of the mask extent are considered to be outside of the mask.
+  /// The mask can be of any scalar type. The masked scalars are stored in a new array, the input scalar
+  /// array is not modified.
   static bool ApplyImageMask(vtkOrientedImageData* input, vtkOrientedImageData* mask, double fillValue, bool notMask = false);
 
   /// Get the values contained in the labelmap under the mask
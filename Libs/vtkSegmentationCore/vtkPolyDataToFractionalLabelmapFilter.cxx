@@ -38,11 +38,10 @@
 #include <vtkPolyDataNormals.h>
 #include <vtkTriangleFilter.h>
 #include <vtkStripper.h>
-#include <vtkImageStencil.h>
-#include <vtkImageCast.h>
+#include <vtkSMPTools.h>
 
 // std includes
-#include <map>
+#include <vector>
 
 vtkStandardNewMacro(vtkPolyDataToFractionalLabelmapFilter);
 
@@ -51,12 +50,6 @@ vtkPolyDataToFractionalLabelmapFilter::vtkPolyDataToFractionalLabelmapFilter()
 {
   this->NumberOfOffsets = 6;
 
-  this->LinesCache = std::map<double, vtkSmartPointer<vtkCellArray> >();
-  this->SliceCache = std::map<double, vtkSmartPointer<vtkPolyData> >();
-  this->PointIdsCache = std::map<double, vtkIdType*>();
-  this->NptsCache = std::map<double, vtkIdType>();
-  this->PointNeighborCountsCache = std::map<double,  vtkSmartPointer<vtkIdTypeArray> >();
-
   this->CellLocator = vtkCellLocator::New();
 
   this->OutputImageTransformData = vtkOrientedImageData::New();
@@ -425,110 +418,89 @@ int vtkPolyDataToFractionalLabelmapFilter::RequestData(
   int extent[6];
   outputData->GetExtent(extent);
 
-  vtkSmartPointer<vtkImageData> emptyImageData = vtkSmartPointer<vtkImageData>::New();
-  emptyImageData->SetExtent(extent);
-  emptyImageData->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
-
-  void* emptyImageDataPointer = emptyImageData->GetScalarPointerForExtent(emptyImageData->GetExtent());
-  if (!emptyImageDataPointer)
-  {
-    vtkErrorMacro("Convert: Failed to allocate memory for output labelmap image!");
-    return false;
-  }
-  else
-  {
-    memset(emptyImageDataPointer, 0, ((extent[1]-extent[0]+1)*(extent[3]-extent[2]+1)*(extent[5]-extent[4]+1) * emptyImageData->GetScalarSize() * emptyImageData->GetNumberOfScalarComponents()));
-  }
+  if (!transformedClosedSurface->GetNumberOfPoints())
+    {
+    return 1;
+    }
 
+  // Cells and bounds are computed on this thread, so that the surface is only read when slices are processed in parallel
+  transformedClosedSurface->BuildCells();
+  double bounds[6] = { 0.0, -1.0, 0.0, -1.0, 0.0, -1.0 };
+  transformedClosedSurface->GetBounds(bounds);
+  // Polylines are selected by the superclass, which is not thread-safe
+  bool parallel = (transformedClosedSurface->GetNumberOfPolys() > 0 || transformedClosedSurface->GetNumberOfStrips() > 0);
 
   // The magnitude of the offset step size ( n-1 / 2n )
   double offsetStepSize = (double)(this->NumberOfOffsets-1.0)/(2 * this->NumberOfOffsets);
+  const double spacing[3] = { 1.0, 1.0, 1.0 };
 
-  vtkSmartPointer<vtkImageStencilData> imageStencilData = vtkSmartPointer<vtkImageStencilData>::New();
-  imageStencilData->SetExtent(extent);
-  imageStencilData->SetSpacing(1.0, 1.0, 1.0);
-
-  vtkNew<vtkImageStencil> imageStencil;
-  imageStencil->SetInputData(emptyImageData);
-  imageStencil->SetStencilData(imageStencilData);
-  imageStencil->ReverseStencilOn();
-  imageStencil->SetBackgroundValue(1); // General foreground value is 1 (background value because of reverse stencil)
-
-  vtkNew<vtkImageCast> imageCast;
-  imageCast->SetInputConnection(imageStencil->GetOutputPort());
-  imageCast->SetOutputScalarTypeToUnsignedChar();
-
-  // Iterate through "NumberOfOffsets" in each of the dimensions and create a binary labelmap at each offset
+  // The surface is sampled at "NumberOfOffsets" offsets in each of the dimensions. For each slice, the contour is
+  // computed once per z offset and then rasterized at all x and y offsets. Voxels inside the contour at an offset
+  // get one fractional step. Each slice only writes its own voxels, therefore slices are processed in parallel.
   for (int k = 0; k < this->NumberOfOffsets; ++k)
-  {
-    double kOffset = ( (double) k / this->NumberOfOffsets - offsetStepSize );
-
-    for (int j = 0; j < this->NumberOfOffsets; ++j)
     {
-      double jOffset = ( (double) j / this->NumberOfOffsets - offsetStepSize );
+    double kOffset = ( (double) k / this->NumberOfOffsets - offsetStepSize );
 
-      for (int i = 0; i < this->NumberOfOffsets; ++i)
+    auto rasterizeSlices = [&](vtkIdType beginSlice, vtkIdType endSlice)
       {
-        double iOffset = ( (double) i / this->NumberOfOffsets - offsetStepSize );
-
-        // Create stencil for the current binary labelmap offset
-        imageStencilData->AllocateExtents();
-        imageStencilData->SetOrigin(iOffset, jOffset, kOffset);
-        this->FillImageStencilData(imageStencilData, transformedClosedSurface, extent);
-
-        // Save result to output
-        imageCast->Update();
-        this->AddBinaryLabelMapToFractionalLabelMap(imageCast->GetOutput(), outputData);
+      vtkNew<vtkPolyData> contour;
+      std::vector<vtkIdType> pointNeighborCounts;
+      vtkNew<vtkImageStencilData> sliceStencilData;
+      sliceStencilData->SetSpacing(1.0, 1.0, 1.0);
+      for (int idxZ = static_cast<int>(beginSlice); idxZ < static_cast<int>(endSlice); ++idxZ)
+        {
+        if (!this->GetSliceContour(transformedClosedSurface, idxZ + kOffset, spacing[2], contour, pointNeighborCounts))
+          {
+          continue;
+          }
+        int sliceExtent[6] = { extent[0], extent[1], extent[2], extent[3], idxZ, idxZ };
+        for (int j = 0; j < this->NumberOfOffsets; ++j)
+          {
+          double jOffset = ( (double) j / this->NumberOfOffsets - offsetStepSize );
+          for (int i = 0; i < this->NumberOfOffsets; ++i)
+            {
+            double iOffset = ( (double) i / this->NumberOfOffsets - offsetStepSize );
+            double origin[3] = { iOffset, jOffset, kOffset };
+            sliceStencilData->SetExtent(sliceExtent);
+            sliceStencilData->SetOrigin(origin);
+            sliceStencilData->AllocateExtents();
+            this->RasterizeSliceContour(contour, pointNeighborCounts, origin, spacing, sliceExtent, sliceStencilData);
+
+            // Add the sample to the voxel runs that are inside the contour
+            for (int idxY = extent[2]; idxY <= extent[3]; ++idxY)
+              {
+              FRACTIONAL_DATA_TYPE* rowPointer = static_cast<FRACTIONAL_DATA_TYPE*>(outputData->GetScalarPointer(extent[0], idxY, idxZ));
+              int iter = 0;
+              int r1 = 0;
+              int r2 = 0;
+              while (sliceStencilData->GetNextExtent(r1, r2, extent[0], extent[1], idxY, idxZ, iter))
+                {
+                for (int idxX = r1; idxX <= r2; ++idxX)
+                  {
+                  rowPointer[idxX - extent[0]] += FRACTIONAL_STEP_SIZE;
+                  }
+                }
+              }
+            } // i
+          } // j
+        }
+      };
 
-        this->UpdateProgress(((i+1)*(j+1)*(k+1))/(this->NumberOfOffsets*this->NumberOfOffsets*this->NumberOfOffsets));
+    if (parallel)
+      {
+      vtkSMPTools::For(extent[4], extent[5] + 1, rasterizeSlices);
+      }
+    else
+      {
+      rasterizeSlices(extent[4], extent[5] + 1);
+      }
 
-      } // i
-    } // j
-  } // k
+    this->UpdateProgress(static_cast<double>(k + 1) / this->NumberOfOffsets);
+    } // k
 
   return 1;
 }
 
-//----------------------------------------------------------------------------
-void vtkPolyDataToFractionalLabelmapFilter::AddBinaryLabelMapToFractionalLabelMap(vtkImageData* binaryLabelMap, vtkImageData* fractionalLabelMap)
-{
-
-  if (!binaryLabelMap)
-  {
-    vtkErrorMacro("AddBinaryLabelMapToFractionalLabelMap: Invalid vtkImageData!");
-    return;
-  }
-
-  if (!fractionalLabelMap)
-  {
-    vtkErrorMacro("AddBinaryLabelMapToFractionalLabelMap: Invalid vtkImageData!");
-    return;
-  }
-
-  int binaryExtent[6] = {0,-1,0,-1,0,-1};
-  binaryLabelMap->GetExtent(binaryExtent);
-
-  int fractionalExtent[6] = {0,-1,0,-1,0,-1};
-  fractionalLabelMap->GetExtent(fractionalExtent);
-
-  // Get points to the extent in both the binary and fractional labelmaps
-  char* binaryLabelMapPointer = (char*)binaryLabelMap->GetScalarPointerForExtent(binaryExtent);
-  FRACTIONAL_DATA_TYPE* fractionalLabelMapPointer = (FRACTIONAL_DATA_TYPE*)fractionalLabelMap->GetScalarPointerForExtent(fractionalExtent);
-
-  int dimensions[6] = {0,0,0};
-  fractionalLabelMap->GetDimensions(dimensions);
-
-  int numberOfVoxels = dimensions[0]*dimensions[1]*dimensions[2];
-
-  for (int i = 0; i < numberOfVoxels; ++i)
-  {
-    (*fractionalLabelMapPointer) += (*binaryLabelMapPointer) * FRACTIONAL_STEP_SIZE;
-    ++binaryLabelMapPointer;
-    ++fractionalLabelMapPointer;
-  }
-
-}
-
 //----------------------------------------------------------------------------
 void vtkPolyDataToFractionalLabelmapFilter::FillImageStencilData(
   vtkImageStencilData *data, vtkPolyData* closedSurface,
@@ -548,27 +520,13 @@ void vtkPolyDataToFractionalLabelmapFilter::FillImageStencilData(
   double *origin = data->GetOrigin();
 
   // if we have no data then return
-  if (!this->GetInput()->GetNumberOfPoints())
+  if (!closedSurface || !closedSurface->GetNumberOfPoints())
     {
     return;
     }
 
-  // Only divide once
-  double invspacing[3];
-  invspacing[0] = 1.0/spacing[0];
-  invspacing[1] = 1.0/spacing[1];
-  invspacing[2] = 1.0/spacing[2];
-
-  // get the input data
-  vtkPolyData *input = closedSurface;
-
-  // the output produced by cutting the polydata with the Z plane
-  vtkSmartPointer<vtkPolyData> slice;
-
-  // This raster stores all line segments by recording all "x"
-  // positions on the surface for each y integer position.
-  vtkImageStencilRaster raster(&extent[2]);
-  raster.SetTolerance(this->Tolerance);
+  vtkNew<vtkPolyData> contour;
+  std::vector<vtkIdType> pointNeighborCounts;
 
   // The extent for one slice of the image
   int sliceExtent[6];
@@ -579,300 +537,288 @@ void vtkPolyDataToFractionalLabelmapFilter::FillImageStencilData(
   // Loop through the slices
   for (int idxZ = extent[4]; idxZ <= extent[5]; idxZ++)
     {
-
     double z = idxZ*spacing[2] + origin[2];
+    if (!this->GetSliceContour(closedSurface, z, spacing[2], contour, pointNeighborCounts))
+      {
+      continue;
+      }
+    sliceExtent[4] = idxZ;
+    sliceExtent[5] = idxZ;
+    this->RasterizeSliceContour(contour, pointNeighborCounts, origin, spacing, sliceExtent, data);
+    }
+}
 
-    raster.PrepareForNewData();
+//----------------------------------------------------------------------------
+bool vtkPolyDataToFractionalLabelmapFilter::GetSliceContour(vtkPolyData* closedSurface, double z, double sliceThickness,
+  vtkPolyData* slice, std::vector<vtkIdType>& pointNeighborCounts)
+{
+  // Step 1: Cut the data into slices
+  if (closedSurface->GetNumberOfPolys() > 0 || closedSurface->GetNumberOfStrips() > 0)
+    {
+    this->PolyDataCutter(closedSurface, slice, z);
+    }
+  else
+    {
+    // if no polys, select polylines instead
+    this->PolyDataSelector(closedSurface, slice, z, sliceThickness);
+    }
 
-    if ( this->SliceCache.count(z) == 0 )
-      {
+  if (!slice->GetNumberOfLines())
+    {
+    return false;
+    }
 
-      slice = vtkSmartPointer<vtkPolyData>::New();
+  vtkIdType numberOfPoints = slice->GetNumberOfPoints();
+  pointNeighborCounts.assign(numberOfPoints, 0);
 
-      // Step 1: Cut the data into slices
-      if (input->GetNumberOfPolys() > 0 || input->GetNumberOfStrips() > 0)
-        {
+  // Step 2: Find and connect all the loose ends
+  std::vector<vtkIdType> pointNeighbors(numberOfPoints);
 
-        this->PolyDataCutter(input, slice, z);
-        }
-      else
+  // get the connectivity count for each point
+  vtkSmartPointer<vtkCellArray> lines = slice->GetLines();
+  vtkIdType npts = 0;
+  const vtkIdType *pointIds = nullptr;
+  vtkIdType count = lines->GetNumberOfConnectivityEntries();
+  for (vtkIdType loc = 0; loc < count; loc += npts + 1)
+    {
+    lines->GetCell(loc, npts, pointIds);
+    if (npts > 0)
+      {
+      pointNeighborCounts[pointIds[0]] += 1;
+      for (vtkIdType j = 1; j < npts-1; j++)
         {
-        // if no polys, select polylines instead
-        this->PolyDataSelector(input, slice, z, spacing[2]);
+        pointNeighborCounts[pointIds[j]] += 2;
         }
-
-      if (!slice->GetNumberOfLines())
+      pointNeighborCounts[pointIds[npts-1]] += 1;
+      if (pointIds[0] != pointIds[npts-1])
         {
-        continue;
+        // store the neighbors for end points, because these are
+        // potentially loose ends that will have to be dealt with later
+        pointNeighbors[pointIds[0]] = pointIds[1];
+        pointNeighbors[pointIds[npts-1]] = pointIds[npts-2];
         }
-
-      this->SliceCache.insert(std::pair<double, vtkPolyData*>(z, slice));
-
       }
+    }
 
-    slice = this->SliceCache[z];
-
-    // convert to structured coords via origin and spacing
-    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-    points->DeepCopy(slice->GetPoints());
-    vtkIdType numberOfPoints = points->GetNumberOfPoints();
+  // use connectivity count to identify loose ends and branch points
+  std::vector<vtkIdType> looseEndIds;
+  std::vector<vtkIdType> branchIds;
 
-    for (vtkIdType j = 0; j < numberOfPoints; j++)
+  for (vtkIdType j = 0; j < numberOfPoints; j++)
+    {
+    if (pointNeighborCounts[j] == 1)
       {
-      double tempPoint[3];
-      points->GetPoint(j, tempPoint);
-      tempPoint[0] = (tempPoint[0] - origin[0])*invspacing[0];
-      tempPoint[1] = (tempPoint[1] - origin[1])*invspacing[1];
-      tempPoint[2] = (tempPoint[2] - origin[2])*invspacing[2];
-      points->SetPoint(j, tempPoint);
+      looseEndIds.push_back(j);
       }
+    else if (pointNeighborCounts[j] > 2)
+      {
+      branchIds.push_back(j);
+      }
+    }
 
-    if (this->LinesCache.count(z) == 0)
+  // remove any spurs
+  for (size_t b = 0; b < branchIds.size(); b++)
     {
-
-      // Step 2: Find and connect all the loose ends
-      std::vector<vtkIdType> pointNeighbors(numberOfPoints);
-      vtkSmartPointer<vtkIdTypeArray> pointNeighborCountsArray = vtkSmartPointer<vtkIdTypeArray>::New();
-      pointNeighborCountsArray->Allocate(numberOfPoints, 1);
-      vtkIdType* pointNeighborCounts = pointNeighborCountsArray->GetPointer(0);
-      memset(pointNeighborCounts, 0, numberOfPoints*sizeof(vtkIdType));
-
-      // get the connectivity count for each point
-      vtkSmartPointer<vtkCellArray> lines = slice->GetLines();
-      vtkIdType npts = 0;
-      const vtkIdType *pointIds = nullptr;
-      vtkIdType count = lines->GetNumberOfConnectivityEntries();
-      for (vtkIdType loc = 0; loc < count; loc += npts + 1)
+    for (size_t i = 0; i < looseEndIds.size(); i++)
+      {
+      if (pointNeighbors[looseEndIds[i]] == branchIds[b])
         {
-        lines->GetCell(loc, npts, pointIds);
-        if (npts > 0)
+        // mark this pointId as removed
+        pointNeighborCounts[looseEndIds[i]] = 0;
+        looseEndIds.erase(looseEndIds.begin() + i);
+        i--;
+        if (--pointNeighborCounts[branchIds[b]] <= 2)
           {
-          pointNeighborCounts[pointIds[0]] += 1;
-          for (vtkIdType j = 1; j < npts-1; j++)
-            {
-            pointNeighborCounts[pointIds[j]] += 2;
-            }
-          pointNeighborCounts[pointIds[npts-1]] += 1;
-          if (pointIds[0] != pointIds[npts-1])
-            {
-            // store the neighbors for end points, because these are
-            // potentially loose ends that will have to be dealt with later
-            pointNeighbors[pointIds[0]] = pointIds[1];
-            pointNeighbors[pointIds[npts-1]] = pointIds[npts-2];
-            }
+          break;
           }
         }
+      }
+    }
 
-      // use connectivity count to identify loose ends and branch points
-      std::vector<vtkIdType> looseEndIds;
-      std::vector<vtkIdType> branchIds;
+  // join any loose ends
+  while (looseEndIds.size() >= 2)
+    {
+    size_t n = looseEndIds.size();
 
-      for (vtkIdType j = 0; j < numberOfPoints; j++)
-        {
-        if (pointNeighborCounts[j] == 1)
-          {
-          looseEndIds.push_back(j);
-          }
-        else if (pointNeighborCounts[j] > 2)
-          {
-          branchIds.push_back(j);
-          }
-        }
+    // search for the two closest loose ends
+    double maxval = -VTK_FLOAT_MAX;
+    vtkIdType firstIndex = 0;
+    vtkIdType secondIndex = 1;
+    bool isCoincident = false;
+    bool isOnHull = false;
+
+    for (size_t i = 0; i < n && !isCoincident; i++)
+      {
+      // first loose end
+      vtkIdType firstLooseEndId = looseEndIds[i];
+      vtkIdType neighborId = pointNeighbors[firstLooseEndId];
 
-      // remove any spurs
-      for (size_t b = 0; b < branchIds.size(); b++)
+      double firstLooseEnd[3];
+      slice->GetPoint(firstLooseEndId, firstLooseEnd);
+      double neighbor[3];
+      slice->GetPoint(neighborId, neighbor);
+
+      for (size_t j = i+1; j < n; j++)
         {
-        for (size_t i = 0; i < looseEndIds.size(); i++)
+        vtkIdType secondLooseEndId = looseEndIds[j];
+        if (secondLooseEndId != neighborId)
           {
-          if (pointNeighbors[looseEndIds[i]] == branchIds[b])
+          double currentLooseEnd[3];
+          slice->GetPoint(secondLooseEndId, currentLooseEnd);
+
+          // When connecting loose ends, use dot product to favor
+          // continuing in same direction as the line already
+          // connected to the loose end, but also favour short
+          // distances by dividing dotprod by square of distance.
+          double v1[2], v2[2];
+          v1[0] = firstLooseEnd[0] - neighbor[0];
+          v1[1] = firstLooseEnd[1] - neighbor[1];
+          v2[0] = currentLooseEnd[0] - firstLooseEnd[0];
+          v2[1] = currentLooseEnd[1] - firstLooseEnd[1];
+          double dotprod = v1[0]*v2[0] + v1[1]*v2[1];
+          double distance2 = v2[0]*v2[0] + v2[1]*v2[1];
+
+          // check if points are coincident
+          if (distance2 == 0)
             {
-            // mark this pointId as removed
-            pointNeighborCounts[looseEndIds[i]] = 0;
-            looseEndIds.erase(looseEndIds.begin() + i);
-            i--;
-            if (--pointNeighborCounts[branchIds[b]] <= 2)
-              {
-              break;
-              }
+            firstIndex = i;
+            secondIndex = j;
+            isCoincident = true;
+            break;
             }
-          }
-        }
-
-      // join any loose ends
-      while (looseEndIds.size() >= 2)
-        {
-        size_t n = looseEndIds.size();
-
-        // search for the two closest loose ends
-        double maxval = -VTK_FLOAT_MAX;
-        vtkIdType firstIndex = 0;
-        vtkIdType secondIndex = 1;
-        bool isCoincident = false;
-        bool isOnHull = false;
 
-        for (size_t i = 0; i < n && !isCoincident; i++)
-          {
-          // first loose end
-          vtkIdType firstLooseEndId = looseEndIds[i];
-          vtkIdType neighborId = pointNeighbors[firstLooseEndId];
-
-          double firstLooseEnd[3];
-          slice->GetPoint(firstLooseEndId, firstLooseEnd);
-          double neighbor[3];
-          slice->GetPoint(neighborId, neighbor);
-
-          for (size_t j = i+1; j < n; j++)
+          // prefer adding segments that lie on hull
+          double midpoint[2], normal[2];
+          midpoint[0] = 0.5*(currentLooseEnd[0] + firstLooseEnd[0]);
+          midpoint[1] = 0.5*(currentLooseEnd[1] + firstLooseEnd[1]);
+          normal[0] = currentLooseEnd[1] - firstLooseEnd[1];
+          normal[1] = -(currentLooseEnd[0] - firstLooseEnd[0]);
+          double sidecheck = 0.0;
+          bool checkOnHull = true;
+          for (size_t k = 0; k < n; k++)
             {
-            vtkIdType secondLooseEndId = looseEndIds[j];
-            if (secondLooseEndId != neighborId)
+            if (k != i && k != j)
               {
-              double currentLooseEnd[3];
-              slice->GetPoint(secondLooseEndId, currentLooseEnd);
-
-              // When connecting loose ends, use dot product to favor
-              // continuing in same direction as the line already
-              // connected to the loose end, but also favour short
-              // distances by dividing dotprod by square of distance.
-              double v1[2], v2[2];
-              v1[0] = firstLooseEnd[0] - neighbor[0];
-              v1[1] = firstLooseEnd[1] - neighbor[1];
-              v2[0] = currentLooseEnd[0] - firstLooseEnd[0];
-              v2[1] = currentLooseEnd[1] - firstLooseEnd[1];
-              double dotprod = v1[0]*v2[0] + v1[1]*v2[1];
-              double distance2 = v2[0]*v2[0] + v2[1]*v2[1];
-
-              // check if points are coincident
-              if (distance2 == 0)
-                {
-                firstIndex = i;
-                secondIndex = j;
-                isCoincident = true;
-                break;
-                }
-
-              // prefer adding segments that lie on hull
-              double midpoint[2], normal[2];
-              midpoint[0] = 0.5*(currentLooseEnd[0] + firstLooseEnd[0]);
-              midpoint[1] = 0.5*(currentLooseEnd[1] + firstLooseEnd[1]);
-              normal[0] = currentLooseEnd[1] - firstLooseEnd[1];
-              normal[1] = -(currentLooseEnd[0] - firstLooseEnd[0]);
-              double sidecheck = 0.0;
-              bool checkOnHull = true;
-              for (size_t k = 0; k < n; k++)
-                {
-                if (k != i && k != j)
-                  {
-                  double checkEnd[3];
-                  slice->GetPoint(looseEndIds[k], checkEnd);
-                  double dotprod2 = ((checkEnd[0] - midpoint[0])*normal[0] +
-                                     (checkEnd[1] - midpoint[1])*normal[1]);
-                  if (dotprod2*sidecheck < 0)
-                    {
-                    checkOnHull = false;
-                    }
-                  sidecheck = dotprod2;
-                  }
-                }
-
-              // check if new candidate is better than previous one
-              if ((checkOnHull && !isOnHull) ||
-                  (checkOnHull == isOnHull && dotprod > maxval*distance2))
+              double checkEnd[3];
+              slice->GetPoint(looseEndIds[k], checkEnd);
+              double dotprod2 = ((checkEnd[0] - midpoint[0])*normal[0] +
+                                 (checkEnd[1] - midpoint[1])*normal[1]);
+              if (dotprod2*sidecheck < 0)
                 {
-                firstIndex = i;
-                secondIndex = j;
-                isOnHull |= checkOnHull;
-                maxval = dotprod/distance2;
+                checkOnHull = false;
                 }
+              sidecheck = dotprod2;
               }
             }
-          }
 
-        // get info about the two loose ends and their neighbors
-        vtkIdType firstLooseEndId = looseEndIds[firstIndex];
-        vtkIdType neighborId = pointNeighbors[firstLooseEndId];
-        double firstLooseEnd[3];
-        slice->GetPoint(firstLooseEndId, firstLooseEnd);
-        double neighbor[3];
-        slice->GetPoint(neighborId, neighbor);
-
-        vtkIdType secondLooseEndId = looseEndIds[secondIndex];
-        vtkIdType secondNeighborId = pointNeighbors[secondLooseEndId];
-        double secondLooseEnd[3];
-        slice->GetPoint(secondLooseEndId, secondLooseEnd);
-        double secondNeighbor[3];
-        slice->GetPoint(secondNeighborId, secondNeighbor);
-
-        // remove these loose ends from the list
-        looseEndIds.erase(looseEndIds.begin() + secondIndex);
-        looseEndIds.erase(looseEndIds.begin() + firstIndex);
-
-        if (!isCoincident)
-          {
-          // create a new line segment by connecting these two points
-          lines->InsertNextCell(2);
-          lines->InsertCellPoint(firstLooseEndId);
-          lines->InsertCellPoint(secondLooseEndId);
+          // check if new candidate is better than previous one
+          if ((checkOnHull && !isOnHull) ||
+              (checkOnHull == isOnHull && dotprod > maxval*distance2))
+            {
+            firstIndex = i;
+            secondIndex = j;
+            isOnHull |= checkOnHull;
+            maxval = dotprod/distance2;
+            }
           }
         }
-
-        this->LinesCache.insert(std::pair<double, vtkCellArray*>(z, lines));
-        this->NptsCache.insert(std::pair<double, vtkIdType>(z, npts));
-        this->PointNeighborCountsCache.insert(std::pair<double, vtkSmartPointer<vtkIdTypeArray> >(z, pointNeighborCountsArray));
-
       }
 
-   if (this->LinesCache.count(z) == 0)
-    {
-     continue;
+    // get info about the two loose ends and their neighbors
+    vtkIdType firstLooseEndId = looseEndIds[firstIndex];
+    vtkIdType neighborId = pointNeighbors[firstLooseEndId];
+    double firstLooseEnd[3];
+    slice->GetPoint(firstLooseEndId, firstLooseEnd);
+    double neighbor[3];
+    slice->GetPoint(neighborId, neighbor);
+
+    vtkIdType secondLooseEndId = looseEndIds[secondIndex];
+    vtkIdType secondNeighborId = pointNeighbors[secondLooseEndId];
+    double secondLooseEnd[3];
+    slice->GetPoint(secondLooseEndId, secondLooseEnd);
+    double secondNeighbor[3];
+    slice->GetPoint(secondNeighborId, secondNeighbor);
+
+    // remove these loose ends from the list
+    looseEndIds.erase(looseEndIds.begin() + secondIndex);
+    looseEndIds.erase(looseEndIds.begin() + firstIndex);
+
+    if (!isCoincident)
+      {
+      // create a new line segment by connecting these two points
+      lines->InsertNextCell(2);
+      lines->InsertCellPoint(firstLooseEndId);
+      lines->InsertCellPoint(secondLooseEndId);
+      }
     }
 
-    vtkCellArray* lines = this->LinesCache[z];
-    vtkIdType count = lines->GetNumberOfConnectivityEntries();
-    const vtkIdType* pointIds = this->PointIdsCache[z];
-    vtkIdType npts = this->NptsCache[z];
-    vtkIdTypeArray* pointNeighborCountsArray = this->PointNeighborCountsCache[z];
-    vtkIdType* pointNeighborCounts = pointNeighborCountsArray->GetPointer(0);
-
-    // Step 3: Go through all the line segments for this slice,
-    // and for each integer y position on the line segment,
-    // drop the corresponding x position into the y raster line.
-    for (vtkIdType loc = 0; loc < count; loc += npts + 1)
-      {
-      lines->GetCell(loc, npts, pointIds);
-      if (npts > 0)
-        {
-        vtkIdType pointId0 = pointIds[0];
-        double point0[3];
-        points->GetPoint(pointId0, point0);
-        for (vtkIdType j = 1; j < npts; j++)
-          {
-          vtkIdType pointId1 = pointIds[j];
-          double point1[3];
-          points->GetPoint(pointId1, point1);
+  return true;
+}
 
-          // make sure points aren't flagged for removal
-          if (pointNeighborCounts[pointId0] > 0 &&
-              pointNeighborCounts[pointId1] > 0)
-            {
-            raster.InsertLine(point0, point1);
-            }
+//----------------------------------------------------------------------------
+void vtkPolyDataToFractionalLabelmapFilter::RasterizeSliceContour(vtkPolyData* slice, const std::vector<vtkIdType>& pointNeighborCounts,
+  const double origin[3], const double spacing[3], int sliceExtent[6], vtkImageStencilData* data)
+{
+  // Only divide once
+  double invspacing[3];
+  invspacing[0] = 1.0/spacing[0];
+  invspacing[1] = 1.0/spacing[1];
+  invspacing[2] = 1.0/spacing[2];
 
-          pointId0 = pointId1;
-          point0[0] = point1[0];
-          point0[1] = point1[1];
-          point0[2] = point1[2];
-          }
-        }
+  // This raster stores all line segments by recording all "x"
+  // positions on the surface for each y integer position.
+  vtkImageStencilRaster raster(&sliceExtent[2]);
+  raster.SetTolerance(this->Tolerance);
+  raster.PrepareForNewData();
+
+  // Step 3: Go through all the line segments for this slice,
+  // and for each integer y position on the line segment,
+  // drop the corresponding x position into the y raster line.
+  vtkPoints* points = slice->GetPoints();
+  vtkCellArray* lines = slice->GetLines();
+  vtkIdType npts = 0;
+  const vtkIdType* pointIds = nullptr;
+  for (lines->InitTraversal(); lines->GetNextCell(npts, pointIds); )
+    {
+    if (npts <= 0)
+      {
+      continue;
+      }
+    vtkIdType pointId0 = pointIds[0];
+    double point0[3];
+    points->GetPoint(pointId0, point0);
+    // convert to structured coords via origin and spacing
+    for (int c = 0; c < 3; ++c)
+      {
+      point0[c] = (point0[c] - origin[c])*invspacing[c];
       }
+    for (vtkIdType j = 1; j < npts; j++)
+      {
+      vtkIdType pointId1 = pointIds[j];
+      double point1[3];
+      points->GetPoint(pointId1, point1);
+      for (int c = 0; c < 3; ++c)
+        {
+        point1[c] = (point1[c] - origin[c])*invspacing[c];
+        }
 
-    // Step 4: Use the x values stored in the xy raster to create
-    // one z slice of the vtkStencilData
-    sliceExtent[4] = idxZ;
-    sliceExtent[5] = idxZ;
-    raster.FillStencilData(data, sliceExtent);
+      // make sure points aren't flagged for removal
+      if (pointNeighborCounts[pointId0] > 0 &&
+          pointNeighborCounts[pointId1] > 0)
+        {
+        raster.InsertLine(point0, point1);
+        }
 
+      pointId0 = pointId1;
+      point0[0] = point1[0];
+      point0[1] = point1[1];
+      point0[2] = point1[2];
+      }
     }
 
+  // Step 4: Use the x values stored in the xy raster to create
+  // one z slice of the vtkStencilData
+  raster.FillStencilData(data, sliceExtent);
 }
 
 //----------------------------------------------------------------------------
@@ -987,11 +933,5 @@ void vtkPolyDataToFractionalLabelmapFilter::PolyDataCutter(
 //----------------------------------------------------------------------------
 void vtkPolyDataToFractionalLabelmapFilter::DeleteCache()
 {
-
-  this->SliceCache.clear();
-  this->LinesCache.clear();
-  this->NptsCache.clear();
-  this->PointIdsCache.clear();
-  this->PointNeighborCountsCache.clear();
-
+  // Slice contours are no longer cached between executions, there is nothing to delete
 }
@@ -36,7 +36,7 @@
 #include <vtkOrientedImageData.h>
 
 // std includes
-#include <map>
+#include <vector>
 
 #include "vtkSegmentationCoreConfigure.h"
 
@@ -64,12 +64,6 @@ class vtkSegmentationCore_EXPORT vtkPolyDataToFractionalLabelmapFilter :
   public vtkPolyDataToImageStencil
 {
 private:
-  std::map<double, vtkSmartPointer<vtkCellArray> > LinesCache;
-  std::map<double, vtkSmartPointer<vtkPolyData> > SliceCache;
-  std::map<double, vtkIdType*> PointIdsCache;
-  std::map<double, vtkIdType> NptsCache;
-  std::map<double,  vtkSmartPointer<vtkIdTypeArray> > PointNeighborCountsCache;
-
   vtkCellLocator* CellLocator;
 
   vtkOrientedImageData* OutputImageTransformData;
@@ -102,7 +96,8 @@ public:
   void SetOutputSpacing(double x, double y, double z) override;
 
 
-  /// This method deletes the currently stored cache variables
+  /// Slice contours are not cached between executions anymore, this method does nothing.
+  /// It is kept for backward compatibility.
   void DeleteCache();
 
   vtkSetMacro(NumberOfOffsets, int);
@@ -124,10 +119,23 @@ protected:
   /// \param extent The extent region that is being converted
   void FillImageStencilData(vtkImageStencilData *output, vtkPolyData* closedSurface, int extent[6]);
 
-  /// Add the values of the binary labelmap to the fractional labelmap.
-  /// \param binaryLabelMap Binary labelmap that will be added to the fractional labelmap
-  /// \param fractionalLabelMap The fractional labelmap that the binary labelmap is added to
-  void AddBinaryLabelMapToFractionalLabelMap(vtkImageData* binaryLabelMap, vtkImageData* fractionalLabelMap);
+  /// Cut the closed surface at the specified z coordinate and connect the loose ends of the contour.
+  /// Only reads the closed surface, therefore it may be called from multiple threads for polygonal surfaces.
+  /// \param closedSurface The closed surface that is being cut
+  /// \param z The z coordinate for the cutting plane
+  /// \param sliceThickness Thickness of the slice, used for selecting polylines if the surface has no polygons
+  /// \param slice Output contour lines
+  /// \param pointNeighborCounts Output number of neighbors of each contour point, 0 for removed points
+  /// \return False if the surface does not intersect the slice
+  bool GetSliceContour(vtkPolyData* closedSurface, double z, double sliceThickness,
+    vtkPolyData* slice, std::vector<vtkIdType>& pointNeighborCounts);
+
+  /// Fill one slice of the image stencil from a contour computed by GetSliceContour.
+  /// \param origin Origin of the stencil, contour points are shifted by it
+  /// \param spacing Spacing of the stencil
+  /// \param sliceExtent Extent of the slice, the z range must be a single slice
+  void RasterizeSliceContour(vtkPolyData* slice, const std::vector<vtkIdType>& pointNeighborCounts,
+    const double origin[3], const double spacing[3], int sliceExtent[6], vtkImageStencilData* data);
 
   /// Clip the polydata at the specified z coordinate to create a planar contour.
   /// This method is a modified version of vtkPolyDataToImageStencil::PolyDataCutter to decrease execution time
@@ -0,0 +1,329 @@
+/*==============================================================================
+
+  Copyright (c) Laboratory for Percutaneous Surgery (PerkLab)
+  Queen's University, Kingston, ON, Canada. All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// SegmentationCore includes
+#include "vtkRunLengthLabelmap.h"
+#include "vtkOrientedImageData.h"
+
+// VTK includes
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+
+// STD includes
+#include <algorithm>
+
+namespace
+{
+//----------------------------------------------------------------------------
+template<class ScalarType>
+void EncodeRow(const ScalarType* values, int begin, int end, std::vector<vtkRunLengthLabelmap::Run>& runs)
+{
+  int i = begin;
+  while (i <= end)
+    {
+    ScalarType value = values[i - begin];
+    int runEnd = i;
+    while (runEnd < end && values[runEnd + 1 - begin] == value)
+      {
+      ++runEnd;
+      }
+    if (value != 0)
+      {
+      runs.push_back({ i, runEnd, static_cast<double>(value) });
+      }
+    i = runEnd + 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+template<class ScalarType>
+void EncodeImage(vtkOrientedImageData* image, std::vector<vtkRunLengthLabelmap::Run>& runs, std::vector<vtkIdType>& rowOffsets)
+{
+  int* extent = image->GetExtent();
+  vtkIdType rowLength = extent[1] - extent[0] + 1;
+  const ScalarType* values = static_cast<const ScalarType*>(image->GetScalarPointer());
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      rowOffsets.push_back(static_cast<vtkIdType>(runs.size()));
+      EncodeRow(values, extent[0], extent[1], runs);
+      values += rowLength;
+      }
+    }
+  rowOffsets.push_back(static_cast<vtkIdType>(runs.size()));
+}
+
+//----------------------------------------------------------------------------
+template<class ScalarType>
+void DecodeImage(vtkRunLengthLabelmap* labelmap, vtkOrientedImageData* image)
+{
+  int* extent = image->GetExtent();
+  vtkIdType rowLength = extent[1] - extent[0] + 1;
+  ScalarType* values = static_cast<ScalarType*>(image->GetScalarPointer());
+  std::fill(values, values + rowLength * (extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1), static_cast<ScalarType>(0));
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      vtkIdType numberOfRuns = 0;
+      const vtkRunLengthLabelmap::Run* runs = labelmap->GetRowRuns(j, k, numberOfRuns);
+      for (vtkIdType runIndex = 0; runIndex < numberOfRuns; ++runIndex)
+        {
+        int begin = std::max(runs[runIndex].Begin, extent[0]);
+        int end = std::min(runs[runIndex].End, extent[1]);
+        if (begin <= end)
+          {
+          std::fill(values + (begin - extent[0]), values + (end - extent[0] + 1), static_cast<ScalarType>(runs[runIndex].Value));
+          }
+        }
+      values += rowLength;
+      }
+    }
+}
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkRunLengthLabelmap);
+
+//----------------------------------------------------------------------------
+vtkRunLengthLabelmap::vtkRunLengthLabelmap()
+{
+  this->ScalarType = VTK_UNSIGNED_CHAR;
+  for (int i = 0; i < 3; ++i)
+    {
+    this->Spacing[i] = 1.0;
+    this->Origin[i] = 0.0;
+    for (int j = 0; j < 3; ++j)
+      {
+      this->Directions[i][j] = (i == j ? 1.0 : 0.0);
+      }
+    }
+  this->Initialize();
+}
+
+//----------------------------------------------------------------------------
+vtkRunLengthLabelmap::~vtkRunLengthLabelmap() = default;
+
+//----------------------------------------------------------------------------
+void vtkRunLengthLabelmap::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Extent: " << this->Extent[0] << " " << this->Extent[1] << " " << this->Extent[2]
+    << " " << this->Extent[3] << " " << this->Extent[4] << " " << this->Extent[5] << "\n";
+  os << indent << "Spacing: " << this->Spacing[0] << " " << this->Spacing[1] << " " << this->Spacing[2] << "\n";
+  os << indent << "Origin: " << this->Origin[0] << " " << this->Origin[1] << " " << this->Origin[2] << "\n";
+  os << indent << "ScalarType: " << vtkImageScalarTypeNameMacro(this->ScalarType) << "\n";
+  os << indent << "NumberOfRuns: " << this->GetNumberOfRuns() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkRunLengthLabelmap::Initialize()
+{
+  int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  std::copy(emptyExtent, emptyExtent + 6, this->Extent);
+  this->Runs.clear();
+  this->Runs.shrink_to_fit();
+  this->RowOffsets.clear();
+  this->RowOffsets.shrink_to_fit();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkRunLengthLabelmap::SetImage(vtkOrientedImageData* image)
+{
+  if (!image)
+    {
+    vtkErrorMacro("SetImage: Invalid input image");
+    return false;
+    }
+  if (image->GetPointData()->GetScalars() && image->GetNumberOfScalarComponents() != 1)
+    {
+    vtkErrorMacro("SetImage: Only single-component images are supported");
+    return false;
+    }
+
+  std::vector<Run> runs;
+  std::vector<vtkIdType> rowOffsets;
+  int* extent = image->GetExtent();
+  if (image->GetPointData()->GetScalars() && extent[0] <= extent[1] && extent[2] <= extent[3] && extent[4] <= extent[5])
+    {
+    rowOffsets.reserve(static_cast<size_t>(extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1) + 1);
+    switch (image->GetScalarType())
+      {
+      vtkTemplateMacro(EncodeImage<VTK_TT>(image, runs, rowOffsets));
+      default:
+        vtkErrorMacro("SetImage: Unknown scalar type");
+        return false;
+      }
+    }
+  else
+    {
+    // Empty image, all rows are empty
+    rowOffsets.resize(std::max(0, extent[3] - extent[2] + 1) * std::max(0, extent[5] - extent[4] + 1) + 1, 0);
+    }
+  runs.shrink_to_fit();
+
+  image->GetExtent(this->Extent);
+  image->GetSpacing(this->Spacing);
+  image->GetOrigin(this->Origin);
+  image->GetDirections(this->Directions);
+  this->ScalarType = image->GetScalarType();
+  this->Runs.swap(runs);
+  this->RowOffsets.swap(rowOffsets);
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkRunLengthLabelmap::GetImage(vtkOrientedImageData* image, const int extent[6]/*=nullptr*/)
+{
+  if (!image)
+    {
+    vtkErrorMacro("GetImage: Invalid output image");
+    return false;
+    }
+  image->SetSpacing(this->Spacing);
+  image->SetOrigin(this->Origin);
+  image->SetDirections(this->Directions);
+  image->SetExtent(extent ? const_cast<int*>(extent) : this->Extent);
+  image->AllocateScalars(this->ScalarType, 1);
+  int* outputExtent = image->GetExtent();
+  if (outputExtent[0] > outputExtent[1] || outputExtent[2] > outputExtent[3] || outputExtent[4] > outputExtent[5])
+    {
+    return true;
+    }
+  switch (this->ScalarType)
+    {
+    vtkTemplateMacro(DecodeImage<VTK_TT>(this, image));
+    default:
+      vtkErrorMacro("GetImage: Unknown scalar type");
+      return false;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkRunLengthLabelmap::GetExtent(int extent[6])
+{
+  std::copy(this->Extent, this->Extent + 6, extent);
+}
+
+//----------------------------------------------------------------------------
+void vtkRunLengthLabelmap::GetImageToWorldMatrix(vtkMatrix4x4* imageToWorldMatrix)
+{
+  if (!imageToWorldMatrix)
+    {
+    return;
+    }
+  imageToWorldMatrix->Identity();
+  for (int row = 0; row < 3; ++row)
+    {
+    for (int col = 0; col < 3; ++col)
+      {
+      imageToWorldMatrix->SetElement(row, col, this->Spacing[col] * this->Directions[row][col]);
+      }
+    imageToWorldMatrix->SetElement(row, 3, this->Origin[row]);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkRunLengthLabelmap::GetRowIndex(int j, int k)
+{
+  if (j < this->Extent[2] || j > this->Extent[3] || k < this->Extent[4] || k > this->Extent[5])
+    {
+    return -1;
+    }
+  return static_cast<vtkIdType>(k - this->Extent[4]) * (this->Extent[3] - this->Extent[2] + 1) + (j - this->Extent[2]);
+}
+
+//----------------------------------------------------------------------------
+const vtkRunLengthLabelmap::Run* vtkRunLengthLabelmap::GetRowRuns(int j, int k, vtkIdType& numberOfRuns)
+{
+  numberOfRuns = 0;
+  vtkIdType rowIndex = this->GetRowIndex(j, k);
+  if (rowIndex < 0 || rowIndex + 1 >= static_cast<vtkIdType>(this->RowOffsets.size()))
+    {
+    return nullptr;
+    }
+  numberOfRuns = this->RowOffsets[rowIndex + 1] - this->RowOffsets[rowIndex];
+  return numberOfRuns > 0 ? &this->Runs[this->RowOffsets[rowIndex]] : nullptr;
+}
+
+//----------------------------------------------------------------------------
+double vtkRunLengthLabelmap::GetValue(int i, int j, int k)
+{
+  vtkIdType numberOfRuns = 0;
+  const Run* runs = this->GetRowRuns(j, k, numberOfRuns);
+  if (!runs)
+    {
+    return 0.0;
+    }
+  // Runs are sorted, find the first run that ends at or after i
+  const Run* run = std::lower_bound(runs, runs + numberOfRuns, i,
+    [](const Run& r, int index) { return r.End < index; });
+  if (run != runs + numberOfRuns && run->Begin <= i)
+    {
+    return run->Value;
+    }
+  return 0.0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkRunLengthLabelmap::CalculateEffectiveExtent(int effectiveExtent[6])
+{
+  int validExtent[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN };
+  for (int k = this->Extent[4]; k <= this->Extent[5]; ++k)
+    {
+    for (int j = this->Extent[2]; j <= this->Extent[3]; ++j)
+      {
+      vtkIdType numberOfRuns = 0;
+      const Run* runs = this->GetRowRuns(j, k, numberOfRuns);
+      if (numberOfRuns == 0)
+        {
+        continue;
+        }
+      validExtent[0] = std::min(validExtent[0], runs[0].Begin);
+      validExtent[1] = std::max(validExtent[1], runs[numberOfRuns - 1].End);
+      validExtent[2] = std::min(validExtent[2], j);
+      validExtent[3] = std::max(validExtent[3], j);
+      validExtent[4] = std::min(validExtent[4], k);
+      validExtent[5] = std::max(validExtent[5], k);
+      }
+    }
+  if (validExtent[0] > validExtent[1])
+    {
+    int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    std::copy(emptyExtent, emptyExtent + 6, effectiveExtent);
+    return false;
+    }
+  std::copy(validExtent, validExtent + 6, effectiveExtent);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkRunLengthLabelmap::GetNumberOfRuns()
+{
+  return static_cast<vtkIdType>(this->Runs.size());
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkRunLengthLabelmap::GetActualMemorySize()
+{
+  size_t memorySizeBytes = this->Runs.capacity() * sizeof(Run) + this->RowOffsets.capacity() * sizeof(vtkIdType);
+  return static_cast<unsigned long>((memorySizeBytes + 1023) / 1024);
+}
@@ -0,0 +1,118 @@
+/*==============================================================================
+
+  Copyright (c) Laboratory for Percutaneous Surgery (PerkLab)
+  Queen's University, Kingston, ON, Canada. All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkRunLengthLabelmap_h
+#define __vtkRunLengthLabelmap_h
+
+// VTK includes
+#include <vtkObject.h>
+
+// STD includes
+#include <vector>
+
+#include "vtkSegmentationCoreConfigure.h"
+
+class vtkMatrix4x4;
+class vtkOrientedImageData;
+
+/// \ingroup SegmentationCore
+/// \brief Sparse, run-length encoded representation of a single-component labelmap.
+///
+/// Each row (along the I axis) of the labelmap is stored as a list of runs of non-zero voxels.
+/// Background voxels are not stored, therefore the memory usage scales with the number of
+/// label boundaries along the rows instead of the size of the extent. This is well suited
+/// for shared labelmap layers containing many thin structures that are mostly background.
+///
+/// The dense image can be reconstructed on demand, for the whole extent or for a sub-extent
+/// only (e.g., a single slice), using GetImage(). vtkOrientedImageDataResample::ModifyImage
+/// can apply the runs directly onto a dense image without reconstructing the labelmap.
+class vtkSegmentationCore_EXPORT vtkRunLengthLabelmap : public vtkObject
+{
+public:
+  static vtkRunLengthLabelmap* New();
+  vtkTypeMacro(vtkRunLengthLabelmap, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// A run of voxels of the same non-zero value in a row
+  struct Run
+    {
+    int Begin;
+    int End;
+    double Value;
+    };
+
+  /// Encode the scalars of the image. The image must have a single scalar component.
+  /// \return Success flag
+  bool SetImage(vtkOrientedImageData* image);
+
+  /// Reconstruct the dense image. The geometry and scalar type of the encoded image are used.
+  /// \param extent If specified, only this sub-extent is reconstructed; voxels that
+  ///   are outside of the encoded extent are set to 0.
+  /// \return Success flag
+  bool GetImage(vtkOrientedImageData* image, const int extent[6]=nullptr);
+
+  /// Remove all runs and reset the extent to empty
+  void Initialize();
+
+  /// Get extent of the encoded image
+  void GetExtent(int extent[6]);
+  /// Get geometry of the encoded image
+  void GetImageToWorldMatrix(vtkMatrix4x4* imageToWorldMatrix);
+  /// Get scalar type of the encoded image
+  vtkGetMacro(ScalarType, int);
+
+  /// Get value of a voxel. Returns 0 for background voxels and positions outside of the extent.
+  double GetValue(int i, int j, int k);
+
+  /// Get the runs of row (j, k). Returns nullptr if the row is outside of the extent
+  /// and sets numberOfRuns to 0.
+  const Run* GetRowRuns(int j, int k, vtkIdType& numberOfRuns);
+
+  /// Compute the extent of the non-zero voxels.
+  /// \return False if there are no non-zero voxels.
+  bool CalculateEffectiveExtent(int effectiveExtent[6]);
+
+  /// Get total number of stored runs
+  vtkIdType GetNumberOfRuns();
+
+  /// Return the memory used by the runs, in kibibytes (1024 bytes), similarly to vtkDataObject::GetActualMemorySize.
+  unsigned long GetActualMemorySize();
+
+protected:
+  vtkRunLengthLabelmap();
+  ~vtkRunLengthLabelmap() override;
+
+  /// Index of row (j, k) in RowOffsets
+  vtkIdType GetRowIndex(int j, int k);
+
+protected:
+  int Extent[6];
+  double Spacing[3];
+  double Origin[3];
+  double Directions[3][3];
+  int ScalarType;
+
+  /// Runs of all the rows, ordered by row then by Begin
+  std::vector<Run> Runs;
+  /// Index of the first run of each row in Runs, with an additional element at the end
+  std::vector<vtkIdType> RowOffsets;
+
+private:
+  vtkRunLengthLabelmap(const vtkRunLengthLabelmap&) = delete;
+  void operator=(const vtkRunLengthLabelmap&) = delete;
+};
+
+#endif
@@ -20,6 +20,7 @@
 
 // SegmentationCore includes
 #include "vtkSegmentation.h"
+#include "vtkSegmentationConversionCache.h"
 #include "vtkSegmentationConverterRule.h"
 #include "vtkSegmentationConverterFactory.h"
 #include "vtkSegmentationHistory.h"
@@ -40,7 +41,9 @@
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
+#include <vtkSMPTools.h>
 #include <vtkStringArray.h>
+#include <vtkTimerLog.h>
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
 #include <vtkVersion.h>
@@ -48,7 +51,9 @@
 // STD includes
 #include <algorithm>
 #include <functional>
+#include <set>
 #include <sstream>
+#include <unordered_map>
 
 const int DEFAULT_LABEL_VALUE = 1;
 
@@ -70,6 +75,12 @@ vtkSegmentation::vtkSegmentation()
 
   this->MasterRepresentationModifiedEnabled = true;
   this->SegmentModifiedEnabled = true;
+  this->ParallelConversion = true;
+
+  this->RepresentationMemoryBudget = 0;
+  this->RepresentationUseCounter = 0;
+  this->NumberOfRepresentationReleases = 0;
+  this->NumberOfRepresentationRegenerations = 0;
 
   this->SegmentIdAutogeneratorIndex = 0;
 
@@ -148,6 +159,9 @@ void vtkSegmentation::DeepCopy(vtkSegmentation* aSegmentation)
     vtkSegmentation::CopySegment(segment, aSegmentation->Segments[*segmentIdIt], nullptr, copiedDataObjects);
     this->AddSegment(segment, *segmentIdIt);
     }
+
+  this->RepresentationMemoryBudget = aSegmentation->RepresentationMemoryBudget;
+  this->ReleasedRepresentationNames = aSegmentation->ReleasedRepresentationNames;
 }
 
 //----------------------------------------------------------------------------
@@ -166,6 +180,16 @@ void vtkSegmentation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Modified Time: " << this->GetMTime() << "\n";
 
   os << indent << "MasterRepresentationName:  " << this->MasterRepresentationName << "\n";
+  os << indent << "ParallelConversion:  " << (this->ParallelConversion ? "true" : "false") << "\n";
+  os << indent << "RepresentationMemoryBudget:  " << this->RepresentationMemoryBudget << " KiB\n";
+  os << indent << "ReleasedRepresentationNames: ";
+  for (const std::string& releasedRepresentationName : this->ReleasedRepresentationNames)
+    {
+    os << releasedRepresentationName << " ";
+    }
+  os << "\n";
+  os << indent << "NumberOfRepresentationReleases:  " << this->NumberOfRepresentationReleases << "\n";
+  os << indent << "NumberOfRepresentationRegenerations:  " << this->NumberOfRepresentationRegenerations << "\n";
   os << indent << "Number of segments: " << this->Segments.size() << "\n";
   os << indent << "Segments:\n";
   for (std::deque< std::string >::iterator segmentIdIt = this->SegmentIds.begin();
@@ -217,6 +241,8 @@ void vtkSegmentation::SetMasterRepresentationName(const std::string& representat
   bool wasMasterRepresentationModifiedEnabled = this->SetMasterRepresentationModifiedEnabled(false);
 
   this->MasterRepresentationName = representationName;
+  // The master representation is never regenerated
+  this->ReleasedRepresentationNames.erase(representationName);
 
   // Add observation of new master representation in all segments
   this->SetMasterRepresentationModifiedEnabled(wasMasterRepresentationModifiedEnabled);
@@ -1013,6 +1039,26 @@ void vtkSegmentation::ApplyNonLinearTransform(vtkAbstractTransform* transform)
     }
 }
 
+namespace
+{
+
+//-----------------------------------------------------------------------------
+/// Get memory used by the data objects in kibibytes. Null objects are ignored.
+vtkIdType GetDataObjectsMemorySize(const std::set<vtkDataObject*>& dataObjects)
+{
+  vtkIdType memorySizeKiB = 0;
+  for (vtkDataObject* dataObject : dataObjects)
+    {
+    if (dataObject)
+      {
+      memorySizeKiB += static_cast<vtkIdType>(dataObject->GetActualMemorySize());
+      }
+    }
+  return memorySizeKiB;
+}
+
+} // end of anonymous namespace
+
 //-----------------------------------------------------------------------------
 bool vtkSegmentation::ConvertSegmentsUsingPath(std::vector<std::string> segmentIDs, vtkSegmentationConversionPath* path, bool overwriteExisting)
 {
@@ -1033,7 +1079,9 @@ bool vtkSegmentation::ConvertSegmentsUsingPath(std::vector<std::string> segmentI
       }
 
     // Perform conversion step
+    double startTime = vtkTimerLog::GetUniversalTime();
     currentConversionRule->PreConvert(this);
+    std::vector<vtkSegment*> segmentsToConvert;
     for (auto segmentID : segmentIDs)
       {
       vtkSegment* segment = this->GetSegment(segmentID);
@@ -1056,15 +1104,101 @@ bool vtkSegmentation::ConvertSegmentsUsingPath(std::vector<std::string> segmentI
         {
         continue;
         }
-      currentConversionRule->Convert(segment);
+      segmentsToConvert.push_back(segment);
+      }
+
+    // Representations that were created before from the same source content are taken from the cache
+    std::vector<std::string> conversionKeys;
+    if (this->ConversionCache)
+      {
+      const std::string targetRepresentationName = currentConversionRule->GetTargetRepresentationName();
+      std::map<vtkDataObject*, std::string> contentHashes;
+      std::vector<vtkSegment*> segmentsNotInCache;
+      for (vtkSegment* segment : segmentsToConvert)
+        {
+        // Shared source representations are hashed once
+        vtkDataObject* sourceRepresentation = segment->GetRepresentation(currentConversionRule->GetSourceRepresentationName());
+        std::map<vtkDataObject*, std::string>::iterator contentHashIt = contentHashes.find(sourceRepresentation);
+        if (contentHashIt == contentHashes.end())
+          {
+          contentHashIt = contentHashes.insert(std::make_pair(sourceRepresentation,
+            vtkSegmentationConversionCache::GetContentHash(sourceRepresentation))).first;
+          }
+        std::string conversionKey = vtkSegmentationConversionCache::GetConversionKey(
+          contentHashIt->second, segment->GetLabelValue(), currentConversionRule);
+        vtkSmartPointer<vtkDataObject> cachedRepresentation = vtkSmartPointer<vtkDataObject>::Take(
+          currentConversionRule->ConstructRepresentationObjectByRepresentation(targetRepresentationName));
+        if (this->ConversionCache->GetRepresentation(conversionKey, cachedRepresentation))
+          {
+          segment->AddRepresentation(targetRepresentationName, cachedRepresentation);
+          continue;
+          }
+        segmentsNotInCache.push_back(segment);
+        conversionKeys.push_back(conversionKey);
+        }
+      segmentsToConvert.swap(segmentsNotInCache);
+      }
+
+    if (this->ParallelConversion && currentConversionRule->IsThreadSafe() && segmentsToConvert.size() > 1)
+      {
+      this->ConvertSegmentsInParallel(currentConversionRule, segmentsToConvert);
+      }
+    else
+      {
+      for (vtkSegment* segment : segmentsToConvert)
+        {
+        currentConversionRule->Convert(segment);
+        }
       }
     currentConversionRule->PostConvert(this);
 
-  }
+    // Store the new conversion results in the cache
+    if (this->ConversionCache)
+      {
+      for (size_t segmentIndex = 0; segmentIndex < segmentsToConvert.size(); ++segmentIndex)
+        {
+        this->ConversionCache->AddRepresentation(conversionKeys[segmentIndex],
+          segmentsToConvert[segmentIndex]->GetRepresentation(currentConversionRule->GetTargetRepresentationName()));
+        }
+      }
+
+    // Report the actual cost of the conversion step
+    std::set<vtkDataObject*> targetRepresentations;
+    for (vtkSegment* segment : segmentsToConvert)
+      {
+      targetRepresentations.insert(segment->GetRepresentation(currentConversionRule->GetTargetRepresentationName()));
+      }
+    path->SetRuleConversionCost(ruleIndex, vtkTimerLog::GetUniversalTime() - startTime,
+      GetDataObjectsMemorySize(targetRepresentations));
+    }
 
   return true;
 }
 
+//-----------------------------------------------------------------------------
+void vtkSegmentation::ConvertSegmentsInParallel(vtkSegmentationConverterRule* rule, const std::vector<vtkSegment*>& segments)
+{
+  // Adding a representation to a segment invokes events, therefore target
+  // representations are created on this thread before converting.
+  for (vtkSegment* segment : segments)
+    {
+    rule->CreateTargetRepresentation(segment);
+    }
+  bool replaceTargetRepresentation = rule->ReplaceTargetRepresentation;
+  rule->ReplaceTargetRepresentation = false;
+
+  auto convertSegments = [&](vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType index = begin; index < end; ++index)
+      {
+      rule->Convert(segments[index]);
+      }
+    };
+  vtkSMPTools::For(0, static_cast<vtkIdType>(segments.size()), convertSegments);
+
+  rule->ReplaceTargetRepresentation = replaceTargetRepresentation;
+}
+
 //-----------------------------------------------------------------------------
 bool vtkSegmentation::ConvertSegmentUsingPath(vtkSegment* segment, vtkSegmentationConversionPath* path, bool overwriteExisting/*=false*/)
 {
@@ -1099,9 +1233,16 @@ bool vtkSegmentation::ConvertSegmentUsingPath(vtkSegment* segment, vtkSegmentati
       }
 
     // Perform conversion step
+    double startTime = vtkTimerLog::GetUniversalTime();
     currentConversionRule->PreConvert(this);
     currentConversionRule->Convert(segment);
     currentConversionRule->PostConvert(this);
+
+    // Report the actual cost of the conversion step
+    std::set<vtkDataObject*> targetRepresentations;
+    targetRepresentations.insert(segment->GetRepresentation(currentConversionRule->GetTargetRepresentationName()));
+    path->SetRuleConversionCost(ruleIndex, vtkTimerLog::GetUniversalTime() - startTime,
+      GetDataObjectsMemorySize(targetRepresentations));
     }
 
   return true;
@@ -1116,6 +1257,8 @@ bool vtkSegmentation::CreateRepresentation(const std::string& targetRepresentati
     return false;
     }
 
+  this->TouchRepresentation(targetRepresentationName);
+
   // Simply return success if the target representation exists
   if (!alwaysConvert)
     {
@@ -1212,6 +1355,12 @@ bool vtkSegmentation::CreateRepresentation(const std::string& targetRepresentati
     }
 
   this->InvokeEvent(vtkSegmentation::ContainedRepresentationNamesModified);
+
+  if (this->ReleasedRepresentationNames.erase(targetRepresentationName) > 0)
+    {
+    this->NumberOfRepresentationRegenerations++;
+    }
+  this->EnforceRepresentationMemoryBudget();
   return true;
 }
 
@@ -1250,6 +1399,9 @@ bool vtkSegmentation::CreateRepresentation(vtkSegmentationConversionPath* path,
 //---------------------------------------------------------------------------
 void vtkSegmentation::RemoveRepresentation(const std::string& representationName)
 {
+  // Explicitly removed representations are not regenerated on demand
+  this->ReleasedRepresentationNames.erase(representationName);
+
   // We temporarily disable modification of segments to avoid invoking events
   // when segmentation is in an inconsistent state (when segments have different
   // representations). We call Modified events after all the updates are completed.
@@ -1281,9 +1433,167 @@ vtkDataObject* vtkSegmentation::GetSegmentRepresentation(std::string segmentId,
     {
     return nullptr;
     }
+  vtkDataObject* representation = segment->GetRepresentation(representationName);
+  if (representation)
+    {
+    this->TouchRepresentation(representationName);
+    return representation;
+    }
+  if (!this->IsRepresentationReleased(representationName))
+    {
+    return nullptr;
+    }
+  // Regenerate released representation
+  if (!this->CreateRepresentation(representationName))
+    {
+    vtkErrorMacro("GetSegmentRepresentation: Failed to regenerate released representation " << representationName);
+    return nullptr;
+    }
   return segment->GetRepresentation(representationName);
 }
 
+//---------------------------------------------------------------------------
+void vtkSegmentation::TouchRepresentation(const std::string& representationName)
+{
+  this->RepresentationLastUse[representationName] = ++this->RepresentationUseCounter;
+}
+
+//---------------------------------------------------------------------------
+void vtkSegmentation::SetConversionCache(vtkSegmentationConversionCache* cache)
+{
+  if (this->ConversionCache == cache)
+    {
+    return;
+    }
+  this->ConversionCache = cache;
+  this->Modified();
+}
+
+//---------------------------------------------------------------------------
+vtkSegmentationConversionCache* vtkSegmentation::GetConversionCache()
+{
+  return this->ConversionCache;
+}
+
+//---------------------------------------------------------------------------
+void vtkSegmentation::SetRepresentationMemoryBudget(vtkIdType budgetKiB)
+{
+  if (this->RepresentationMemoryBudget == budgetKiB)
+    {
+    return;
+    }
+  this->RepresentationMemoryBudget = budgetKiB;
+  this->Modified();
+  this->EnforceRepresentationMemoryBudget();
+}
+
+//---------------------------------------------------------------------------
+vtkIdType vtkSegmentation::GetRepresentationMemorySize(const std::string& representationName)
+{
+  // Shared representations (e.g., shared labelmaps) are counted once
+  std::set<vtkDataObject*> representations;
+  for (SegmentMap::iterator segmentIt = this->Segments.begin(); segmentIt != this->Segments.end(); ++segmentIt)
+    {
+    vtkDataObject* representation = segmentIt->second->GetRepresentation(representationName);
+    if (representation)
+      {
+      representations.insert(representation);
+      }
+    }
+
+  return GetDataObjectsMemorySize(representations);
+}
+
+//---------------------------------------------------------------------------
+int vtkSegmentation::EnforceRepresentationMemoryBudget()
+{
+  if (this->RepresentationMemoryBudget <= 0)
+    {
+    return 0;
+    }
+
+  std::vector<std::string> representationNames;
+  this->GetContainedRepresentationNames(representationNames);
+  representationNames.erase(std::remove(representationNames.begin(), representationNames.end(), this->MasterRepresentationName),
+    representationNames.end());
+
+  std::map<std::string, vtkIdType> memorySizes;
+  vtkIdType totalMemorySizeKiB = 0;
+  for (const std::string& representationName : representationNames)
+    {
+    memorySizes[representationName] = this->GetRepresentationMemorySize(representationName);
+    totalMemorySizeKiB += memorySizes[representationName];
+    }
+  if (totalMemorySizeKiB <= this->RepresentationMemoryBudget || representationNames.size() < 2)
+    {
+    return 0;
+    }
+
+  // Sort by last use, least recently used first. Representations that have never been requested
+  // (e.g., intermediate representations of a conversion path) come first.
+  std::vector<std::pair<vtkIdType, std::string> > representationsByLastUse;
+  for (const std::string& representationName : representationNames)
+    {
+    std::map<std::string, vtkIdType>::iterator lastUseIt = this->RepresentationLastUse.find(representationName);
+    vtkIdType lastUse = (lastUseIt != this->RepresentationLastUse.end() ? lastUseIt->second : 0);
+    representationsByLastUse.emplace_back(lastUse, representationName);
+    }
+  std::sort(representationsByLastUse.begin(), representationsByLastUse.end());
+
+  // The most recently used representation is kept even if it is larger than the budget
+  representationsByLastUse.pop_back();
+  int numberOfReleasedRepresentations = 0;
+  for (const std::pair<vtkIdType, std::string>& representation : representationsByLastUse)
+    {
+    if (totalMemorySizeKiB <= this->RepresentationMemoryBudget)
+      {
+      break;
+      }
+    vtkDebugMacro("EnforceRepresentationMemoryBudget: Releasing representation " << representation.second
+      << " (" << memorySizes[representation.second] << " KiB)");
+    this->ReleaseRepresentation(representation.second);
+    totalMemorySizeKiB -= memorySizes[representation.second];
+    numberOfReleasedRepresentations++;
+    }
+  return numberOfReleasedRepresentations;
+}
+
+//---------------------------------------------------------------------------
+bool vtkSegmentation::ReleaseRepresentation(const std::string& representationName)
+{
+  if (representationName == this->MasterRepresentationName)
+    {
+    vtkErrorMacro("ReleaseRepresentation: The master representation " << representationName << " cannot be released");
+    return false;
+    }
+  if (this->ContainsRepresentation(representationName))
+    {
+    this->RemoveRepresentation(representationName);
+    this->NumberOfRepresentationReleases++;
+    }
+  this->ReleasedRepresentationNames.insert(representationName);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+void vtkSegmentation::GetReleasedRepresentationNames(std::vector<std::string>& representationNames)
+{
+  representationNames.assign(this->ReleasedRepresentationNames.begin(), this->ReleasedRepresentationNames.end());
+}
+
+//---------------------------------------------------------------------------
+bool vtkSegmentation::IsRepresentationReleased(const std::string& representationName)
+{
+  return this->ReleasedRepresentationNames.find(representationName) != this->ReleasedRepresentationNames.end();
+}
+
+//---------------------------------------------------------------------------
+void vtkSegmentation::ResetRepresentationUsageStatistics()
+{
+  this->NumberOfRepresentationReleases = 0;
+  this->NumberOfRepresentationRegenerations = 0;
+}
+
 //---------------------------------------------------------------------------
 void vtkSegmentation::InvalidateNonMasterRepresentations()
 {
@@ -1362,6 +1672,74 @@ void vtkSegmentation::MergeSegmentLabelmaps(std::vector<std::string> mergeSegmen
   sharedLabelmapRepresentation->Modified();
 }
 
+namespace
+{
+
+//---------------------------------------------------------------------------
+/// Write the merged label values of the segments of a labelmap layer directly into the merged labelmap.
+/// The layer must have the same geometry as the merged labelmap (its extent may be different).
+/// Voxels of labels that are not in mergedLabelValues are left unchanged. Slices are processed in parallel.
+template <class T>
+void PaintLayerIntoMergedLabelmapGeneric(vtkOrientedImageData* layer, vtkOrientedImageData* mergedLabelmap,
+  const std::unordered_map<int, short>& mergedLabelValues)
+{
+  int* layerExtent = layer->GetExtent();
+  int* mergedExtent = mergedLabelmap->GetExtent();
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  for (int i = 0; i < 3; ++i)
+    {
+    extent[2 * i] = std::max(layerExtent[2 * i], mergedExtent[2 * i]);
+    extent[2 * i + 1] = std::min(layerExtent[2 * i + 1], mergedExtent[2 * i + 1]);
+    if (extent[2 * i] > extent[2 * i + 1])
+      {
+      return;
+      }
+    }
+
+  vtkIdType layerIncrements[3] = { 0, 0, 0 };
+  layer->GetIncrements(layerIncrements);
+  vtkIdType mergedIncrements[3] = { 0, 0, 0 };
+  mergedLabelmap->GetIncrements(mergedIncrements);
+  int rowLength = extent[1] - extent[0] + 1;
+
+  vtkSMPTools::For(extent[4], extent[5] + 1, [&](vtkIdType beginSlice, vtkIdType endSlice)
+    {
+    for (int k = static_cast<int>(beginSlice); k < static_cast<int>(endSlice); ++k)
+      {
+      // Consecutive voxels mostly have the same value, so the map is only looked up when the value changes
+      T previousValue = 0;
+      short previousMergedLabelValue = 0;
+      bool previousValueFound = false;
+      for (int j = extent[2]; j <= extent[3]; ++j)
+        {
+        const T* layerPtr = static_cast<const T*>(layer->GetScalarPointer(extent[0], j, k));
+        short* mergedPtr = static_cast<short*>(mergedLabelmap->GetScalarPointer(extent[0], j, k));
+        for (int i = 0; i < rowLength; ++i, layerPtr += layerIncrements[0], mergedPtr += mergedIncrements[0])
+          {
+          T value = *layerPtr;
+          if (value == 0)
+            {
+            continue;
+            }
+          if (value != previousValue)
+            {
+            previousValue = value;
+            std::unordered_map<int, short>::const_iterator mergedLabelValueIt = mergedLabelValues.find(static_cast<int>(value));
+            previousValueFound = (mergedLabelValueIt != mergedLabelValues.end());
+            previousMergedLabelValue = previousValueFound ? mergedLabelValueIt->second : 0;
+            }
+          if (previousValueFound)
+            {
+            *mergedPtr = previousMergedLabelValue;
+            }
+          }
+        }
+      }
+    });
+}
+
+} // end of anonymous namespace
+
 //---------------------------------------------------------------------------
 bool vtkSegmentation::GenerateMergedLabelmap(
   vtkOrientedImageData* sharedImageData,
@@ -1459,25 +1837,49 @@ bool vtkSegmentation::GenerateMergedLabelmap(
     return true;
     }
 
-  // Create shared labelmap
+  // Create shared labelmap.
+  // Consecutive segments that are stored in the same layer are written into the shared labelmap in one pass,
+  // directly from the layer (without thresholding each segment into a temporary image).
+  // Overlapping segments in different layers are resolved by the order of the segments, as later layers
+  // overwrite the voxels of earlier ones.
   bool success = true;
-  short segmentIndex = 0;
-  for (std::vector<std::string>::iterator segmentIdIt = sharedSegmentIDs.begin(); segmentIdIt != sharedSegmentIDs.end(); ++segmentIdIt, ++segmentIndex)
+  size_t segmentIndex = 0;
+  while (segmentIndex < sharedSegmentIDs.size())
     {
-    std::string currentSegmentId = *segmentIdIt;
+    std::string currentSegmentId = sharedSegmentIDs[segmentIndex];
     vtkSegment* currentSegment = this->GetSegment(currentSegmentId);
     if (!currentSegment)
       {
       vtkErrorMacro("GenerateSharedLabelmap: Segment not found by ID: " << currentSegmentId);
       success = false;
+      ++segmentIndex;
       continue;
       }
 
     // Get binary labelmap from segment
     vtkOrientedImageData* representationBinaryLabelmap = vtkOrientedImageData::SafeDownCast(
       currentSegment->GetRepresentation(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName()));
+
+    // Collect label values of the consecutive segments in this layer
+    std::unordered_map<int, short> mergedLabelValues;
+    for (; segmentIndex < sharedSegmentIDs.size(); ++segmentIndex)
+      {
+      vtkSegment* segment = this->GetSegment(sharedSegmentIDs[segmentIndex]);
+      if (!segment || segment->GetRepresentation(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName())
+        != representationBinaryLabelmap)
+        {
+        break;
+        }
+      int labelValue = backgroundColorIndex + 1 + static_cast<int>(segmentIndex);
+      if (labelValues)
+        {
+        labelValue = labelValues->GetValue(static_cast<vtkIdType>(segmentIndex));
+        }
+      mergedLabelValues[segment->GetLabelValue()] = static_cast<short>(labelValue);
+      }
+
     // If binary labelmap is empty then skip
-    if (representationBinaryLabelmap->IsEmpty())
+    if (!representationBinaryLabelmap || representationBinaryLabelmap->IsEmpty())
       {
       continue;
       }
@@ -1504,31 +1906,14 @@ bool vtkSegmentation::GenerateMergedLabelmap(
       binaryLabelmap = resampledBinaryLabelmap;
       }
 
-    vtkNew<vtkOrientedImageData> thresholdedLabelmap;
-    vtkNew<vtkImageThreshold> threshold;
-    threshold->SetInputData(binaryLabelmap);
-    threshold->ThresholdBetween(currentSegment->GetLabelValue(), currentSegment->GetLabelValue());
-    threshold->SetInValue(1);
-    threshold->SetOutValue(0);
-    threshold->Update();
-    thresholdedLabelmap->ShallowCopy(threshold->GetOutput());
-    thresholdedLabelmap->CopyDirections(binaryLabelmap);
-    binaryLabelmap = thresholdedLabelmap;
-
-    int labelValue = backgroundColorIndex + 1 + segmentIndex;
-    if (labelValues)
+    // Copy image data voxels into shared labelmap with the proper color index
+    switch (binaryLabelmap->GetScalarType())
       {
-      labelValue = labelValues->GetValue(segmentIndex);
+      vtkTemplateMacro(PaintLayerIntoMergedLabelmapGeneric<VTK_TT>(binaryLabelmap, sharedImageData, mergedLabelValues));
+      default:
+        vtkErrorMacro("GenerateSharedLabelmap: Unsupported scalar type in binary labelmap of segment " << currentSegmentId);
+        success = false;
       }
-
-    // Copy image data voxels into shared labelmap with the proper color index
-    vtkOrientedImageDataResample::ModifyImage(
-      sharedImageData,
-      binaryLabelmap,
-      vtkOrientedImageDataResample::OPERATION_MASKING,
-      nullptr,
-      0,
-      labelValue);
     }
 
   return success;
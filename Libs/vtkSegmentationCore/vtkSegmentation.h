@@ -41,6 +41,7 @@ class vtkAbstractTransform;
 class vtkCallbackCommand;
 class vtkCollection;
 class vtkIntArray;
+class vtkSegmentationConversionCache;
 class vtkSegmentationConversionPath;
 class vtkStringArray;
 
@@ -478,6 +479,57 @@ public:
   /// the segmentation! Use \sa CreateRepresentation for that.
   virtual void SetMasterRepresentationName(const std::string& representationName);
 
+  /// If enabled, then segments are converted concurrently by conversion rules
+  /// that are thread-safe (see vtkSegmentationConverterRule::IsThreadSafe).
+  /// Enabled by default.
+  vtkSetMacro(ParallelConversion, bool);
+  vtkGetMacro(ParallelConversion, bool);
+  vtkBooleanMacro(ParallelConversion, bool);
+
+  /// Cache of representations created by conversion. If set, then the result of converting a segment
+  /// is taken from the cache if the same source representation content was converted before with
+  /// the same conversion parameters, and new conversion results are stored in the cache.
+  /// The same cache can be used by multiple segmentations. Not set by default.
+  void SetConversionCache(vtkSegmentationConversionCache* cache);
+  vtkSegmentationConversionCache* GetConversionCache();
+
+// Representation memory management
+
+  /// Memory budget of the non-master representations in kibibytes (1024 bytes).
+  /// If the non-master representations use more memory than the budget then the least recently used ones
+  /// are released from all segments. Released representations are regenerated from the master representation
+  /// when they are requested again by \sa GetSegmentRepresentation or \sa CreateRepresentation.
+  /// The master representation and the most recently used representation are never released.
+  /// 0 (default) means unlimited.
+  void SetRepresentationMemoryBudget(vtkIdType budgetKiB);
+  vtkGetMacro(RepresentationMemoryBudget, vtkIdType);
+
+  /// Get memory used by a representation in all segments in kibibytes (1024 bytes).
+  /// Data objects shared between segments (e.g., shared labelmaps) are counted once.
+  vtkIdType GetRepresentationMemorySize(const std::string& representationName);
+
+  /// Release the least recently used non-master representations until their memory
+  /// usage is within \sa RepresentationMemoryBudget.
+  /// \return Number of released representations
+  int EnforceRepresentationMemoryBudget();
+
+  /// Remove a non-master representation from all segments but keep it available: it is regenerated
+  /// from the master representation when it is requested next time. The representation does not have
+  /// to exist (e.g., representations of a segmentation loaded from file can be created on first use).
+  /// \return False if the representation is the master representation
+  bool ReleaseRepresentation(const std::string& representationName);
+
+  /// Get names of the representations that are released and will be regenerated on demand
+  void GetReleasedRepresentationNames(std::vector<std::string>& representationNames);
+  /// Return true if the representation is released and will be regenerated on demand
+  bool IsRepresentationReleased(const std::string& representationName);
+
+  /// Number of times a representation was released since the last \sa ResetRepresentationUsageStatistics
+  vtkGetMacro(NumberOfRepresentationReleases, int);
+  /// Number of times a released representation was regenerated since the last \sa ResetRepresentationUsageStatistics
+  vtkGetMacro(NumberOfRepresentationRegenerations, int);
+  void ResetRepresentationUsageStatistics();
+
   /// Deep copies source segment to destination segment. If the same representation is found in baseline
   /// with up-to-date timestamp then the representation is reused from baseline.
   static void CopySegment(vtkSegment* destination, vtkSegment* source, vtkSegment* baseline,
@@ -494,6 +546,10 @@ protected:
   /// \return Success flag
   bool ConvertSegmentUsingPath(vtkSegment* segment, vtkSegmentationConversionPath* path, bool overwriteExisting = false);
 
+  /// Convert the given segments with a thread-safe rule using multiple threads.
+  /// Must be called between PreConvert and PostConvert of the rule.
+  void ConvertSegmentsInParallel(vtkSegmentationConverterRule* rule, const std::vector<vtkSegment*>& segments);
+
   /// Converts a single segment to a representation.
   bool ConvertSingleSegment(std::string segmentId, std::string targetRepresentationName);
 
@@ -513,6 +569,9 @@ protected:
   /// state when calling SetSegmentModifiedEnabled in nested functions.
   bool SetSegmentModifiedEnabled(bool enabled);
 
+  /// Record that the representation is used, for choosing the least recently used representation to release
+  void TouchRepresentation(const std::string& representationName);
+
 protected:
   /// Callback function invoked when segment is modified.
   /// It calls Modified on the segmentation and rebuilds observations on the master representation of each segment
@@ -555,6 +614,12 @@ protected:
   /// Modified events of segments are observed
   bool SegmentModifiedEnabled;
 
+  /// Segments are converted in parallel by thread-safe conversion rules
+  bool ParallelConversion;
+
+  /// Cache of conversion results, optional
+  vtkSmartPointer<vtkSegmentationConversionCache> ConversionCache;
+
   /// This number is incremented and used for generating the next
   /// segment ID.
   int SegmentIdAutogeneratorIndex;
@@ -566,6 +631,17 @@ protected:
 
   std::set<vtkSmartPointer<vtkDataObject> > MasterRepresentationCache;
 
+  /// Memory budget of the non-master representations in kibibytes. 0 means unlimited.
+  vtkIdType RepresentationMemoryBudget;
+  /// Names of the non-master representations that are regenerated when requested
+  std::set<std::string> ReleasedRepresentationNames;
+  /// Last use of each representation (value of RepresentationUseCounter at the time of the use)
+  std::map<std::string, vtkIdType> RepresentationLastUse;
+  vtkIdType RepresentationUseCounter;
+
+  int NumberOfRepresentationReleases;
+  int NumberOfRepresentationRegenerations;
+
   friend class vtkMRMLSegmentationNode;
   friend class vtkSlicerSegmentationsModuleLogic;
   friend class vtkSegmentationModifier;
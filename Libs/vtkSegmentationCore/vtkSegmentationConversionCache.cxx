@@ -0,0 +1,317 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// Segmentation includes
+#include "vtkSegmentationConversionCache.h"
+#include "vtkOrientedImageData.h"
+#include "vtkSegmentationConversionParameters.h"
+#include "vtkSegmentationConverterRule.h"
+
+// VTK includes
+#include <vtkCellArray.h>
+#include <vtkDataArray.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkXMLPolyDataReader.h>
+#include <vtkXMLPolyDataWriter.h>
+
+// VTKSYS includes
+#include <vtksys/SystemTools.hxx>
+
+// STD includes
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkSegmentationConversionCache);
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Incremental 64-bit FNV-1a hash. Data is processed in 8-byte words, which is
+/// much faster than hashing byte by byte and is sufficient for detecting changes.
+class ContentHash
+{
+public:
+  void Add(const void* data, size_t size)
+  {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    size_t numberOfWords = size / sizeof(vtkTypeUInt64);
+    for (size_t wordIndex = 0; wordIndex < numberOfWords; ++wordIndex)
+      {
+      vtkTypeUInt64 word = 0;
+      memcpy(&word, bytes + wordIndex * sizeof(vtkTypeUInt64), sizeof(vtkTypeUInt64));
+      this->Hash = (this->Hash ^ word) * 1099511628211ULL;
+      }
+    for (size_t byteIndex = numberOfWords * sizeof(vtkTypeUInt64); byteIndex < size; ++byteIndex)
+      {
+      this->Hash = (this->Hash ^ bytes[byteIndex]) * 1099511628211ULL;
+      }
+    // Size is included so that data split differently between calls gives different hash
+    vtkTypeUInt64 size64 = static_cast<vtkTypeUInt64>(size);
+    this->Hash = (this->Hash ^ size64) * 1099511628211ULL;
+  }
+
+  void Add(const std::string& text)
+  {
+    this->Add(text.c_str(), text.size());
+  }
+
+  void Add(vtkDataArray* array)
+  {
+    if (!array)
+      {
+      this->Add("-");
+      return;
+      }
+    int dataType = array->GetDataType();
+    int numberOfComponents = array->GetNumberOfComponents();
+    this->Add(&dataType, sizeof(dataType));
+    this->Add(&numberOfComponents, sizeof(numberOfComponents));
+    this->Add(array->GetVoidPointer(0), static_cast<size_t>(array->GetNumberOfValues()) * array->GetDataTypeSize());
+  }
+
+  void Add(vtkCellArray* cells)
+  {
+    if (!cells)
+      {
+      this->Add("-");
+      return;
+      }
+    this->Add(cells->GetOffsetsArray());
+    this->Add(cells->GetConnectivityArray());
+  }
+
+  std::string GetHashString()
+  {
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << this->Hash;
+    return ss.str();
+  }
+
+protected:
+  vtkTypeUInt64 Hash{14695981039346656037ULL};
+};
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkSegmentationConversionCache::vtkSegmentationConversionCache() = default;
+
+//----------------------------------------------------------------------------
+vtkSegmentationConversionCache::~vtkSegmentationConversionCache() = default;
+
+//----------------------------------------------------------------------------
+void vtkSegmentationConversionCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MemoryBudget: " << this->MemoryBudget << " KiB\n";
+  os << indent << "MemorySize: " << this->MemorySize << " KiB\n";
+  os << indent << "NumberOfRepresentationsInMemory: " << this->Entries.size() << "\n";
+  os << indent << "CacheDirectory: " << this->CacheDirectory << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
+}
+
+//----------------------------------------------------------------------------
+std::string vtkSegmentationConversionCache::GetContentHash(vtkDataObject* dataObject)
+{
+  ContentHash hash;
+  vtkPolyData* polyData = vtkPolyData::SafeDownCast(dataObject);
+  vtkImageData* imageData = vtkImageData::SafeDownCast(dataObject);
+  if (polyData)
+    {
+    hash.Add("vtkPolyData");
+    hash.Add(polyData->GetPoints() ? polyData->GetPoints()->GetData() : nullptr);
+    hash.Add(polyData->GetVerts());
+    hash.Add(polyData->GetLines());
+    hash.Add(polyData->GetPolys());
+    hash.Add(polyData->GetStrips());
+    }
+  else if (imageData)
+    {
+    hash.Add("vtkImageData");
+    int extent[6] = { 0, -1, 0, -1, 0, -1 };
+    imageData->GetExtent(extent);
+    hash.Add(extent, sizeof(extent));
+    vtkNew<vtkMatrix4x4> imageToWorldMatrix;
+    vtkOrientedImageData* orientedImageData = vtkOrientedImageData::SafeDownCast(imageData);
+    if (orientedImageData)
+      {
+      orientedImageData->GetImageToWorldMatrix(imageToWorldMatrix);
+      }
+    else
+      {
+      for (int i = 0; i < 3; ++i)
+        {
+        imageToWorldMatrix->SetElement(i, i, imageData->GetSpacing()[i]);
+        imageToWorldMatrix->SetElement(i, 3, imageData->GetOrigin()[i]);
+        }
+      }
+    hash.Add(imageToWorldMatrix->GetData(), 16 * sizeof(double));
+    hash.Add(imageData->GetPointData()->GetScalars());
+    }
+  else
+    {
+    return "";
+    }
+  return hash.GetHashString();
+}
+
+//----------------------------------------------------------------------------
+std::string vtkSegmentationConversionCache::GetConversionKey(const std::string& sourceContentHash, int labelValue,
+  vtkSegmentationConverterRule* rule)
+{
+  if (sourceContentHash.empty() || !rule)
+    {
+    return "";
+    }
+  ContentHash hash;
+  hash.Add(sourceContentHash);
+  hash.Add(&labelValue, sizeof(labelValue));
+  hash.Add(rule->GetName());
+  vtkNew<vtkSegmentationConversionParameters> parameters;
+  rule->GetRuleConversionParameters(parameters);
+  for (int parameterIndex = 0; parameterIndex < parameters->GetNumberOfParameters(); ++parameterIndex)
+    {
+    hash.Add(parameters->GetName(parameterIndex));
+    hash.Add(parameters->GetValue(parameterIndex));
+    }
+  return hash.GetHashString();
+}
+
+//----------------------------------------------------------------------------
+bool vtkSegmentationConversionCache::GetRepresentation(const std::string& key, vtkDataObject* targetRepresentation)
+{
+  vtkPolyData* targetPolyData = vtkPolyData::SafeDownCast(targetRepresentation);
+  if (key.empty() || !targetPolyData)
+    {
+    return false;
+    }
+
+  std::map<std::string, CacheEntry>::iterator entryIt = this->Entries.find(key);
+  if (entryIt != this->Entries.end())
+    {
+    this->RecentlyUsedKeys.splice(this->RecentlyUsedKeys.begin(), this->RecentlyUsedKeys, entryIt->second.LastUse);
+    targetPolyData->DeepCopy(entryIt->second.Representation);
+    this->NumberOfHits++;
+    return true;
+    }
+
+  std::string fileName = this->GetCacheFileName(key);
+  if (!fileName.empty() && vtksys::SystemTools::FileExists(fileName, true))
+    {
+    vtkNew<vtkXMLPolyDataReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    if (reader->GetErrorCode() == 0 && reader->GetOutput())
+      {
+      targetPolyData->DeepCopy(reader->GetOutput());
+      this->AddRepresentation(key, targetPolyData);
+      this->NumberOfHits++;
+      return true;
+      }
+    vtkWarningMacro("GetRepresentation: Failed to read cached representation from " << fileName);
+    }
+
+  this->NumberOfMisses++;
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkSegmentationConversionCache::AddRepresentation(const std::string& key, vtkDataObject* representation)
+{
+  vtkPolyData* polyData = vtkPolyData::SafeDownCast(representation);
+  if (key.empty() || !polyData)
+    {
+    return;
+    }
+
+  std::map<std::string, CacheEntry>::iterator entryIt = this->Entries.find(key);
+  bool alreadyInMemory = (entryIt != this->Entries.end());
+  if (!alreadyInMemory)
+    {
+    this->RecentlyUsedKeys.push_front(key);
+    CacheEntry& entry = this->Entries[key];
+    entry.Representation = vtkSmartPointer<vtkPolyData>::New();
+    entry.Representation->DeepCopy(polyData);
+    entry.MemorySize = static_cast<vtkIdType>(entry.Representation->GetActualMemorySize());
+    entry.LastUse = this->RecentlyUsedKeys.begin();
+    this->MemorySize += entry.MemorySize;
+    }
+
+  std::string fileName = this->GetCacheFileName(key);
+  if (!fileName.empty() && !vtksys::SystemTools::FileExists(fileName, true))
+    {
+    vtksys::SystemTools::MakeDirectory(this->CacheDirectory);
+    vtkNew<vtkXMLPolyDataWriter> writer;
+    writer->SetFileName(fileName.c_str());
+    writer->SetInputData(polyData);
+    if (!writer->Write())
+      {
+      vtkWarningMacro("AddRepresentation: Failed to write cached representation to " << fileName);
+      }
+    }
+
+  this->EnforceMemoryBudget();
+}
+
+//----------------------------------------------------------------------------
+void vtkSegmentationConversionCache::Clear()
+{
+  this->Entries.clear();
+  this->RecentlyUsedKeys.clear();
+  this->MemorySize = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkSegmentationConversionCache::SetCacheDirectory(const std::string& directory)
+{
+  if (this->CacheDirectory == directory)
+    {
+    return;
+    }
+  this->CacheDirectory = directory;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+std::string vtkSegmentationConversionCache::GetCacheFileName(const std::string& key)
+{
+  if (this->CacheDirectory.empty())
+    {
+    return "";
+    }
+  return this->CacheDirectory + "/" + key + ".vtp";
+}
+
+//----------------------------------------------------------------------------
+void vtkSegmentationConversionCache::EnforceMemoryBudget()
+{
+  // The most recently used representation is always kept
+  while (this->MemorySize > this->MemoryBudget && this->RecentlyUsedKeys.size() > 1)
+    {
+    std::map<std::string, CacheEntry>::iterator entryIt = this->Entries.find(this->RecentlyUsedKeys.back());
+    this->MemorySize -= entryIt->second.MemorySize;
+    this->Entries.erase(entryIt);
+    this->RecentlyUsedKeys.pop_back();
+    }
+}
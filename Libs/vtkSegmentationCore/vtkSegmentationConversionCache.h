@@ -0,0 +1,121 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkSegmentationConversionCache_h
+#define __vtkSegmentationConversionCache_h
+
+// VTK includes
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <list>
+#include <map>
+#include <string>
+
+// Segmentation includes
+#include "vtkSegmentationCoreConfigure.h"
+
+class vtkDataObject;
+class vtkSegmentationConverterRule;
+
+/// \ingroup SegmentationCore
+/// \brief Cache of representations created by conversion, keyed by the content of the source representation.
+/// \details
+/// If a segmentation uses a conversion cache (see vtkSegmentation::SetConversionCache) then the result
+/// of each conversion step is stored in the cache, and when a segment with the same source representation
+/// content, label value, and conversion parameters is converted again (e.g., when the segmentation is reloaded)
+/// then the stored result is copied instead of running the conversion.
+///
+/// Representations are kept in memory up to MemoryBudget. If CacheDirectory is set then they
+/// are also written to files in that directory, so that they can be reused in later sessions.
+/// Only poly data representations (such as closed surfaces) are cached.
+class vtkSegmentationCore_EXPORT vtkSegmentationConversionCache : public vtkObject
+{
+public:
+  static vtkSegmentationConversionCache* New();
+  vtkTypeMacro(vtkSegmentationConversionCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Get hash of the content (geometry, points, cells, voxels) of a poly data or image data.
+  /// Returns empty string if the data object type is not supported.
+  static std::string GetContentHash(vtkDataObject* dataObject);
+
+  /// Get the key of converting a segment with a rule. The key is computed from the content hash of the
+  /// source representation (see GetContentHash), the label value of the segment, and the name
+  /// and conversion parameters of the rule. Returns empty string if the content hash is empty.
+  static std::string GetConversionKey(const std::string& sourceContentHash, int labelValue, vtkSegmentationConverterRule* rule);
+
+  /// Copy the cached representation to the target representation.
+  /// Representations in memory are looked up first, then files in the cache directory.
+  /// \return True if the representation was found in the cache
+  bool GetRepresentation(const std::string& key, vtkDataObject* targetRepresentation);
+
+  /// Store a copy of the representation in the cache. Only poly data are stored.
+  void AddRepresentation(const std::string& key, vtkDataObject* representation);
+
+  /// Remove all representations from memory. Files in the cache directory are not deleted.
+  void Clear();
+
+  /// Maximum memory used by the representations kept in memory, in kibibytes.
+  /// Least recently used representations are removed from memory when the budget is exceeded.
+  /// Default is 262144 (256 MiB).
+  vtkSetMacro(MemoryBudget, vtkIdType);
+  vtkGetMacro(MemoryBudget, vtkIdType);
+
+  /// Directory where cached representations are stored in files.
+  /// If empty (default) then representations are only kept in memory.
+  void SetCacheDirectory(const std::string& directory);
+  std::string GetCacheDirectory() { return this->CacheDirectory; };
+
+  /// Number of representations that were found in the cache
+  vtkGetMacro(NumberOfHits, int);
+  /// Number of representations that were not found in the cache
+  vtkGetMacro(NumberOfMisses, int);
+
+protected:
+  /// Get file name of the cached representation in the cache directory
+  std::string GetCacheFileName(const std::string& key);
+
+  /// Remove least recently used representations from memory until the memory budget is met
+  void EnforceMemoryBudget();
+
+protected:
+  struct CacheEntry
+    {
+    vtkSmartPointer<vtkDataObject> Representation;
+    vtkIdType MemorySize{0};
+    std::list<std::string>::iterator LastUse;
+    };
+  std::map<std::string, CacheEntry> Entries;
+  /// Keys of the representations in memory, most recently used first
+  std::list<std::string> RecentlyUsedKeys;
+  vtkIdType MemorySize{0};
+
+  vtkIdType MemoryBudget{262144};
+  std::string CacheDirectory;
+  int NumberOfHits{0};
+  int NumberOfMisses{0};
+
+protected:
+  vtkSegmentationConversionCache();
+  ~vtkSegmentationConversionCache() override;
+
+private:
+  vtkSegmentationConversionCache(const vtkSegmentationConversionCache&) = delete;
+  void operator=(const vtkSegmentationConversionCache&) = delete;
+};
+
+#endif // __vtkSegmentationConversionCache_h
@@ -41,10 +41,16 @@ vtkSegmentationConversionPath::~vtkSegmentationConversionPath()
 void vtkSegmentationConversionPath::PrintSelf(ostream& os, vtkIndent indent)
 {
   os << indent << "Cost: " << this->GetCost() << "\n";
-  for (const vtkSmartPointer<vtkSegmentationConverterRule>& rule : this->Rules)
+  for (int ruleIndex = 0; ruleIndex < this->GetNumberOfRules(); ++ruleIndex)
     {
     os << indent << "Rule:\n";
-    rule->PrintSelf(os, indent.GetNextIndent());
+    this->Rules[ruleIndex]->PrintSelf(os, indent.GetNextIndent());
+    const RuleConversionCost& cost = this->RuleConversionCosts[ruleIndex];
+    if (cost.Time >= 0.0)
+      {
+      os << indent.GetNextIndent() << "Measured conversion time: " << cost.Time << " s\n";
+      os << indent.GetNextIndent() << "Measured conversion memory size: " << cost.MemorySize << " KiB\n";
+      }
     }
 }
 
@@ -58,6 +64,7 @@ int vtkSegmentationConversionPath::GetNumberOfRules()
 void vtkSegmentationConversionPath::RemoveAllRules()
 {
   this->Rules.clear();
+  this->RuleConversionCosts.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -80,12 +87,14 @@ void vtkSegmentationConversionPath::RemoveRule(int index)
     return;
     }
   this->Rules.erase(this->Rules.begin()+index);
+  this->RuleConversionCosts.erase(this->RuleConversionCosts.begin()+index);
 }
 
 //----------------------------------------------------------------------------
 int vtkSegmentationConversionPath::AddRule(vtkSegmentationConverterRule* rule)
 {
   this->Rules.push_back(rule);
+  this->RuleConversionCosts.emplace_back();
   return this->GetNumberOfRules() - 1;
 }
 
@@ -108,6 +117,41 @@ void vtkSegmentationConversionPath::Copy(vtkSegmentationConversionPath* source)
     return;
     }
   this->Rules = source->Rules;
+  this->RuleConversionCosts = source->RuleConversionCosts;
+}
+
+//----------------------------------------------------------------------------
+double vtkSegmentationConversionPath::GetRuleConversionTime(int index)
+{
+  if (index < 0 || index >= this->GetNumberOfRules())
+    {
+    vtkErrorMacro("GetRuleConversionTime failed: invalid index: " << index);
+    return -1.0;
+    }
+  return this->RuleConversionCosts[index].Time;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSegmentationConversionPath::GetRuleConversionMemorySize(int index)
+{
+  if (index < 0 || index >= this->GetNumberOfRules())
+    {
+    vtkErrorMacro("GetRuleConversionMemorySize failed: invalid index: " << index);
+    return -1;
+    }
+  return this->RuleConversionCosts[index].MemorySize;
+}
+
+//----------------------------------------------------------------------------
+void vtkSegmentationConversionPath::SetRuleConversionCost(int index, double timeSeconds, vtkIdType memorySizeKiB)
+{
+  if (index < 0 || index >= this->GetNumberOfRules())
+    {
+    vtkErrorMacro("SetRuleConversionCost failed: invalid index: " << index);
+    return;
+    }
+  this->RuleConversionCosts[index].Time = timeSeconds;
+  this->RuleConversionCosts[index].MemorySize = memorySizeKiB;
 }
 
 //----------------------------------------------------------------------------
@@ -67,9 +67,28 @@ public:
   /// The rules are shallow-copied.
   void Copy(vtkSegmentationConversionPath* source);
 
+  /// Get measured computation time of the index-th rule in the last conversion along this path,
+  /// in seconds. Negative if the rule has not been executed yet.
+  double GetRuleConversionTime(int index) VTK_EXPECTS(0 <= index && index < GetNumberOfRules());
+
+  /// Get total memory size of the representations that the index-th rule created in the last
+  /// conversion along this path, in kibibytes. Negative if the rule has not been executed yet.
+  vtkIdType GetRuleConversionMemorySize(int index) VTK_EXPECTS(0 <= index && index < GetNumberOfRules());
+
+  /// Store the measured cost of the index-th rule. Called by vtkSegmentation after each conversion step.
+  void SetRuleConversionCost(int index, double timeSeconds, vtkIdType memorySizeKiB) VTK_EXPECTS(0 <= index && index < GetNumberOfRules());
+
 protected:
 
+  struct RuleConversionCost
+  {
+    double Time{-1.0};
+    vtkIdType MemorySize{-1};
+  };
+
   std::vector< vtkSmartPointer<vtkSegmentationConverterRule> > Rules;
+  /// Measured cost of each rule, same size as Rules
+  std::vector<RuleConversionCost> RuleConversionCosts;
 
 protected:
   vtkSegmentationConversionPath();
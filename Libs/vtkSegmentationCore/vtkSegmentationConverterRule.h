@@ -94,6 +94,14 @@ public:
   /// This step should be unnecessary if only converting a single segment
   virtual bool PostConvert(vtkSegmentation* vtkNotUsed(segmentation)) { return true; };
 
+  /// Return true if Convert can be called concurrently for different segments
+  /// (between PreConvert and PostConvert). Thread-safe rules must not modify
+  /// shared state without locking and must not invoke events in Convert.
+  /// When converting multiple segments in parallel, target representation objects
+  /// are created before Convert is called. False by default.
+  /// \sa vtkSegmentation::SetParallelConversion
+  virtual bool IsThreadSafe() { return false; };
+
   /// Get the cost of the conversion.
   /// \return Expected duration of the conversion in milliseconds. If the arguments are omitted, then a rough average can be
   ///   given just to indicate the relative computational cost of the algorithm. If the objects are given, then a more educated
@@ -154,6 +162,7 @@ protected:
   bool ReplaceTargetRepresentation{false};
 
   friend class vtkSegmentationConverter;
+  friend class vtkSegmentation;
 };
 
 #endif // __vtkSegmentationConverterRule_h
@@ -22,14 +22,80 @@
 #include "vtkSegmentationHistory.h"
 #include "vtkSegmentationConverterFactory.h"
 #include "vtkSegmentation.h"
+#include "vtkOrientedImageData.h"
 
 // VTK includes
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkCallbackCommand.h>
+#include <vtkDataArray.h>
+#include <vtkFieldData.h>
+#include <vtkPointData.h>
+#include <vtkTimeStamp.h>
 
 // std includes
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <set>
+
+//----------------------------------------------------------------------------
+struct vtkSegmentationHistory::CompressedImage
+{
+  int Extent[6];
+  double Spacing[3];
+  double Origin[3];
+  double Directions[3][3];
+  bool HasScalars{false};
+  int ScalarType{VTK_VOID};
+  int NumberOfComponents{1};
+  std::string ScalarsName;
+  /// Run-length encoded voxel values of each slice
+  std::vector<std::shared_ptr<const std::vector<unsigned char> > > Slices;
+  /// Time when the image was compressed
+  vtkTimeStamp CompressionTime;
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+template<class ScalarType>
+void EncodeRunLength(const ScalarType* values, vtkIdType numberOfValues, std::vector<unsigned char>& encoded)
+{
+  vtkIdType index = 0;
+  while (index < numberOfValues)
+    {
+    ScalarType value = values[index];
+    vtkTypeUInt32 runLength = 1;
+    while (index + runLength < numberOfValues && runLength < VTK_TYPE_UINT32_MAX && values[index + runLength] == value)
+      {
+      ++runLength;
+      }
+    size_t position = encoded.size();
+    encoded.resize(position + sizeof(runLength) + sizeof(value));
+    memcpy(&encoded[position], &runLength, sizeof(runLength));
+    memcpy(&encoded[position + sizeof(runLength)], &value, sizeof(value));
+    index += runLength;
+    }
+}
+
+//----------------------------------------------------------------------------
+template<class ScalarType>
+void DecodeRunLength(const std::vector<unsigned char>& encoded, ScalarType* values)
+{
+  size_t position = 0;
+  while (position + sizeof(vtkTypeUInt32) + sizeof(ScalarType) <= encoded.size())
+    {
+    vtkTypeUInt32 runLength = 0;
+    ScalarType value;
+    memcpy(&runLength, &encoded[position], sizeof(runLength));
+    memcpy(&value, &encoded[position + sizeof(runLength)], sizeof(value));
+    std::fill(values, values + runLength, value);
+    values += runLength;
+    position += sizeof(runLength) + sizeof(value);
+    }
+}
+}
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSegmentationHistory);
@@ -40,6 +106,7 @@ vtkSegmentationHistory::vtkSegmentationHistory()
   this->Segmentation = nullptr;
 
   this->MaximumNumberOfStates = 5;
+  this->MaximumMemorySize = 0;
 
   this->LastRestoredState = 0;
   this->RestoreStateInProgress = false;
@@ -98,6 +165,8 @@ void vtkSegmentationHistory::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Modified Time: " << this->GetMTime() << "\n";
 
   os << indent << "Number of saved states:  " << this->SegmentationStates.size() << "\n";
+  os << indent << "Maximum number of states:  " << this->MaximumNumberOfStates << "\n";
+  os << indent << "Maximum memory size:  " << this->MaximumMemorySize << " KiB\n";
 }
 
 //---------------------------------------------------------------------------
@@ -130,6 +199,7 @@ bool vtkSegmentationHistory::SaveState()
   this->Segmentation->GetSegmentIDs(segmentIDs);
   newSegmentationState.SegmentIds = segmentIDs;
   std::map<vtkDataObject*, vtkDataObject*> savedObjects;
+  std::map<vtkDataObject*, std::shared_ptr<CompressedImage> > savedImages;
   for (std::vector<std::string>::iterator segmentIDIt = segmentIDs.begin(); segmentIDIt != segmentIDs.end(); ++segmentIDIt)
     {
     vtkSegment* segment = this->Segmentation->GetSegment(*segmentIDIt);
@@ -141,6 +211,7 @@ bool vtkSegmentationHistory::SaveState()
     // Previous saved state of the segment
     // (if the new state has exactly the same representation then only a shallow copy will be made)
     vtkSegment* baselineSegment = nullptr;
+    CompressedImagesMap* baselineImages = nullptr;
     if (this->SegmentationStates.size() > 0)
       {
       SegmentsMap::iterator baselineSegmentIt = this->SegmentationStates.back().Segments.find(*segmentIDIt);
@@ -148,10 +219,85 @@ bool vtkSegmentationHistory::SaveState()
         {
         baselineSegment = baselineSegmentIt->second.GetPointer();
         }
+      std::map<std::string, CompressedImagesMap>::iterator baselineImagesIt = this->SegmentationStates.back().SegmentImages.find(*segmentIDIt);
+      if (baselineImagesIt != this->SegmentationStates.back().SegmentImages.end())
+        {
+        baselineImages = &baselineImagesIt->second;
+        }
       }
 
     vtkSmartPointer<vtkSegment> segmentClone = vtkSmartPointer<vtkSegment>::New();
-    vtkSegmentation::CopySegment(segmentClone, segment, baselineSegment, savedObjects);
+    segmentClone->DeepCopyMetadata(segment);
+    std::vector<std::string> representationNames;
+    segment->GetContainedRepresentationNames(representationNames);
+    for (const std::string& representationName : representationNames)
+      {
+      vtkDataObject* representation = segment->GetRepresentation(representationName);
+
+      // Image representations (such as binary labelmaps) are stored compressed
+      vtkOrientedImageData* image = vtkOrientedImageData::SafeDownCast(representation);
+      if (image)
+        {
+        std::shared_ptr<CompressedImage> compressedImage;
+        if (savedImages.find(image) != savedImages.end())
+          {
+          // Shared labelmap has already been saved with a previous segment
+          compressedImage = savedImages[image];
+          }
+        else
+          {
+          CompressedImage* baselineImage = nullptr;
+          if (baselineImages && baselineImages->find(representationName) != baselineImages->end())
+            {
+            baselineImage = (*baselineImages)[representationName].get();
+            }
+          if (baselineImage && baselineImage->CompressionTime.GetMTime() > image->GetMTime())
+            {
+            // Image has not changed since the baseline was saved
+            compressedImage = (*baselineImages)[representationName];
+            }
+          else
+            {
+            compressedImage = vtkSegmentationHistory::CompressImage(image, baselineImage);
+            }
+          }
+        if (compressedImage)
+          {
+          savedImages[image] = compressedImage;
+          newSegmentationState.SegmentImages[*segmentIDIt][representationName] = compressedImage;
+          continue;
+          }
+        }
+
+      if (savedObjects.find(representation) != savedObjects.end())
+        {
+        // Shared representation has already been saved with a previous segment
+        segmentClone->AddRepresentation(representationName, savedObjects[representation]);
+        continue;
+        }
+      vtkDataObject* baselineRepresentation = nullptr;
+      if (baselineSegment)
+        {
+        baselineRepresentation = baselineSegment->GetRepresentation(representationName);
+        }
+      if (baselineRepresentation != nullptr && baselineRepresentation->GetMTime() > representation->GetMTime())
+        {
+        // Representation has not changed since the baseline was saved
+        segmentClone->AddRepresentation(representationName, baselineRepresentation);
+        savedObjects[representation] = baselineRepresentation;
+        continue;
+        }
+      vtkSmartPointer<vtkDataObject> representationCopy = vtkSmartPointer<vtkDataObject>::Take(
+        vtkSegmentationConverterFactory::GetInstance()->ConstructRepresentationObjectByClass(representation->GetClassName()));
+      if (!representationCopy)
+        {
+        vtkErrorMacro("SaveState: Unable to construct representation type class '" << representation->GetClassName() << "'");
+        continue;
+        }
+      representationCopy->DeepCopy(representation);
+      segmentClone->AddRepresentation(representationName, representationCopy);
+      savedObjects[representation] = representationCopy;
+      }
     newSegmentationState.Segments[*segmentIDIt] = segmentClone;
     }
   this->SegmentationStates.push_back(newSegmentationState);
@@ -224,6 +370,7 @@ bool vtkSegmentationHistory::RestoreState(unsigned int stateIndex)
 
   std::set<std::string> segmentIDsToKeep;
   std::map<vtkDataObject*, vtkDataObject*> restoredRepresentations;
+  std::map<CompressedImage*, vtkSmartPointer<vtkOrientedImageData> > restoredImages;
   for (SegmentsMap::iterator restoredSegmentsIt = restoredState.Segments.begin();
     restoredSegmentsIt != restoredState.Segments.end(); ++restoredSegmentsIt)
     {
@@ -240,6 +387,23 @@ bool vtkSegmentationHistory::RestoreState(unsigned int stateIndex)
 
     std::vector<std::string> restoredRepresentationNames;
     segmentToRestore->GetContainedRepresentationNames(restoredRepresentationNames);
+
+    // Restore compressed image representations.
+    // Segments that shared a labelmap when the state was saved share the restored labelmap, too.
+    std::map<std::string, CompressedImagesMap>::iterator segmentImagesIt = restoredState.SegmentImages.find(restoredSegmentsIt->first);
+    if (segmentImagesIt != restoredState.SegmentImages.end())
+      {
+      for (CompressedImagesMap::iterator imageIt = segmentImagesIt->second.begin(); imageIt != segmentImagesIt->second.end(); ++imageIt)
+        {
+        vtkSmartPointer<vtkOrientedImageData>& restoredImage = restoredImages[imageIt->second.get()];
+        if (!restoredImage)
+          {
+          restoredImage = vtkSegmentationHistory::DecompressImage(imageIt->second.get());
+          }
+        segment->AddRepresentation(imageIt->first, restoredImage);
+        restoredRepresentationNames.push_back(imageIt->first);
+        }
+      }
     std::vector<std::string> currentRepresentationNames;
     segment->GetContainedRepresentationNames(currentRepresentationNames);
     // Remove representations that are not in the restoring segment
@@ -312,10 +476,15 @@ void vtkSegmentationHistory::RemoveAllNextStates()
 void vtkSegmentationHistory::RemoveAllObsoleteStates()
 {
   bool modified = false;
-  while ((this->SegmentationStates.size() > this->MaximumNumberOfStates) && (!this->SegmentationStates.empty()))
+  while (!this->SegmentationStates.empty()
+    && (this->SegmentationStates.size() > this->MaximumNumberOfStates
+      || (this->MaximumMemorySize > 0 && this->SegmentationStates.size() > 1 && this->GetMemorySize() > this->MaximumMemorySize)))
     {
     this->SegmentationStates.pop_front();
-    this->LastRestoredState--;
+    if (this->LastRestoredState > 0)
+      {
+      this->LastRestoredState--;
+      }
     modified = true;
    }
   if (modified)
@@ -336,6 +505,166 @@ void vtkSegmentationHistory::SetMaximumNumberOfStates(unsigned int maximumNumber
   this->Modified();
 }
 
+//---------------------------------------------------------------------------
+void vtkSegmentationHistory::SetMaximumMemorySize(unsigned long maximumMemorySize)
+{
+  if (maximumMemorySize == this->MaximumMemorySize)
+    {
+    return;
+    }
+  this->MaximumMemorySize = maximumMemorySize;
+  this->RemoveAllObsoleteStates();
+  this->Modified();
+}
+
+//---------------------------------------------------------------------------
+unsigned long vtkSegmentationHistory::GetMemorySize()
+{
+  std::set<const void*> countedData;
+  double memorySizeBytes = 0.0;
+  for (const SegmentationState& state : this->SegmentationStates)
+    {
+    for (const auto& segment : state.Segments)
+      {
+      std::vector<std::string> representationNames;
+      segment.second->GetContainedRepresentationNames(representationNames);
+      for (const std::string& representationName : representationNames)
+        {
+        vtkDataObject* representation = segment.second->GetRepresentation(representationName);
+        if (representation && countedData.insert(representation).second)
+          {
+          memorySizeBytes += 1024.0 * representation->GetActualMemorySize();
+          }
+        }
+      }
+    for (const auto& segmentImages : state.SegmentImages)
+      {
+      for (const auto& image : segmentImages.second)
+        {
+        if (!countedData.insert(image.second.get()).second)
+          {
+          continue;
+          }
+        for (const auto& slice : image.second->Slices)
+          {
+          if (countedData.insert(slice.get()).second)
+            {
+            memorySizeBytes += slice->capacity();
+            }
+          }
+        }
+      }
+    }
+  return static_cast<unsigned long>(ceil(memorySizeBytes / 1024.0));
+}
+
+//---------------------------------------------------------------------------
+std::shared_ptr<vtkSegmentationHistory::CompressedImage> vtkSegmentationHistory::CompressImage(
+  vtkOrientedImageData* image, CompressedImage* baseline)
+{
+  if (!image)
+    {
+    return nullptr;
+    }
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  if (image->GetPointData()->GetNumberOfArrays() > (scalars ? 1 : 0)
+    || (image->GetFieldData() && image->GetFieldData()->GetNumberOfArrays() > 0))
+    {
+    // Only the geometry and scalars are stored
+    return nullptr;
+    }
+
+  std::shared_ptr<CompressedImage> compressedImage = std::make_shared<CompressedImage>();
+  image->GetExtent(compressedImage->Extent);
+  image->GetSpacing(compressedImage->Spacing);
+  image->GetOrigin(compressedImage->Origin);
+  image->GetDirections(compressedImage->Directions);
+  compressedImage->CompressionTime.Modified();
+  if (!scalars)
+    {
+    return compressedImage;
+    }
+  compressedImage->HasScalars = true;
+  compressedImage->ScalarType = scalars->GetDataType();
+  compressedImage->NumberOfComponents = scalars->GetNumberOfComponents();
+  compressedImage->ScalarsName = (scalars->GetName() ? scalars->GetName() : "");
+
+  int dimensions[3] = { 0, 0, 0 };
+  image->GetDimensions(dimensions);
+  if (scalars->GetNumberOfTuples() != static_cast<vtkIdType>(dimensions[0]) * dimensions[1] * dimensions[2])
+    {
+    return nullptr;
+    }
+  bool baselineCompatible = baseline && baseline->HasScalars
+    && baseline->ScalarType == compressedImage->ScalarType
+    && baseline->NumberOfComponents == compressedImage->NumberOfComponents
+    && std::equal(baseline->Extent, baseline->Extent + 6, compressedImage->Extent)
+    && baseline->Slices.size() == static_cast<size_t>(dimensions[2]);
+
+  vtkIdType numberOfSliceValues = static_cast<vtkIdType>(dimensions[0]) * dimensions[1] * compressedImage->NumberOfComponents;
+  for (int sliceIndex = 0; sliceIndex < dimensions[2]; ++sliceIndex)
+    {
+    std::shared_ptr<std::vector<unsigned char> > slice = std::make_shared<std::vector<unsigned char> >();
+    void* sliceValues = scalars->GetVoidPointer(sliceIndex * numberOfSliceValues);
+    switch (compressedImage->ScalarType)
+      {
+      vtkTemplateMacro(EncodeRunLength(static_cast<VTK_TT*>(sliceValues), numberOfSliceValues, *slice));
+      default:
+        return nullptr;
+      }
+    if (baselineCompatible && *baseline->Slices[sliceIndex] == *slice)
+      {
+      // Unchanged slice, share the data with the baseline
+      compressedImage->Slices.push_back(baseline->Slices[sliceIndex]);
+      }
+    else
+      {
+      slice->shrink_to_fit();
+      compressedImage->Slices.push_back(slice);
+      }
+    }
+  return compressedImage;
+}
+
+//---------------------------------------------------------------------------
+vtkSmartPointer<vtkOrientedImageData> vtkSegmentationHistory::DecompressImage(CompressedImage* compressedImage)
+{
+  vtkSmartPointer<vtkOrientedImageData> image = vtkSmartPointer<vtkOrientedImageData>::New();
+  if (!compressedImage)
+    {
+    return image;
+    }
+  image->SetExtent(compressedImage->Extent);
+  image->SetSpacing(compressedImage->Spacing);
+  image->SetOrigin(compressedImage->Origin);
+  image->SetDirections(compressedImage->Directions);
+  if (!compressedImage->HasScalars)
+    {
+    return image;
+    }
+  image->AllocateScalars(compressedImage->ScalarType, compressedImage->NumberOfComponents);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  if (!compressedImage->ScalarsName.empty())
+    {
+    scalars->SetName(compressedImage->ScalarsName.c_str());
+    }
+
+  int dimensions[3] = { 0, 0, 0 };
+  image->GetDimensions(dimensions);
+  vtkIdType numberOfSliceValues = static_cast<vtkIdType>(dimensions[0]) * dimensions[1] * compressedImage->NumberOfComponents;
+  for (size_t sliceIndex = 0; sliceIndex < compressedImage->Slices.size(); ++sliceIndex)
+    {
+    void* sliceValues = scalars->GetVoidPointer(sliceIndex * numberOfSliceValues);
+    switch (compressedImage->ScalarType)
+      {
+      vtkTemplateMacro(DecodeRunLength(*compressedImage->Slices[sliceIndex], static_cast<VTK_TT*>(sliceValues)));
+      default:
+        break;
+      }
+    }
+  return image;
+}
+
 //---------------------------------------------------------------------------
 void vtkSegmentationHistory::OnSegmentationModified(vtkObject* vtkNotUsed(caller),
   unsigned long vtkNotUsed(eid),
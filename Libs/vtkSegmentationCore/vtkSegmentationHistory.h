@@ -28,12 +28,14 @@
 // STD includes
 #include <deque>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "vtkSegmentationCoreConfigure.h"
 
 class vtkCallbackCommand;
 class vtkDataObject;
+class vtkOrientedImageData;
 class vtkSegment;
 class vtkSegmentation;
 
@@ -86,6 +88,18 @@ public:
   /// Get the current number of states.
   int GetNumberOfStates();
 
+  /// Limits how much memory the stored states may use (in kibibytes).
+  /// If the stored states use more memory then the oldest states are removed,
+  /// but the most recent state is always kept. 0 means no limit (default).
+  void SetMaximumMemorySize(unsigned long maximumMemorySize);
+
+  /// Get the limit of how much memory the stored states may use (in kibibytes).
+  vtkGetMacro(MaximumMemorySize, unsigned long);
+
+  /// Get the memory used by the stored states (in kibibytes).
+  /// Data that is shared between states is only counted once.
+  unsigned long GetMemorySize();
+
 protected:
   /// Callback function called when the segmentation has been modified.
   /// It clears all states that are more recent than the last restored state.
@@ -106,16 +120,31 @@ protected:
 
   typedef std::map<std::string, vtkSmartPointer<vtkSegment> > SegmentsMap;
 
+  /// Image representation stored in a state. The image is run-length encoded slice by slice,
+  /// slices that have not changed since the previous state are shared between the states.
+  struct CompressedImage;
+  typedef std::map<std::string, std::shared_ptr<CompressedImage> > CompressedImagesMap;
+
   struct SegmentationState
     {
-    SegmentsMap Segments;
+    SegmentsMap Segments; // segments with all representations except compressed images
+    std::map<std::string, CompressedImagesMap> SegmentImages; // compressed image representations of each segment
     std::vector<std::string> SegmentIds; // order of segments
     };
 
+  /// Create compressed copy of an image representation.
+  /// Returns nullptr if the image cannot be compressed (it has multiple data arrays).
+  /// \param baseline Slices that are the same as in the baseline image are shared with it.
+  static std::shared_ptr<CompressedImage> CompressImage(vtkOrientedImageData* image, CompressedImage* baseline);
+
+  /// Create image from its compressed copy
+  static vtkSmartPointer<vtkOrientedImageData> DecompressImage(CompressedImage* compressedImage);
+
   vtkSegmentation* Segmentation;
   vtkCallbackCommand* SegmentationModifiedCallbackCommand;
   std::deque<SegmentationState> SegmentationStates;
   unsigned int MaximumNumberOfStates;
+  unsigned long MaximumMemorySize;
 
   // Index of the state in SegmentationStates that was restored last.
   // If LastRestoredState == size of states then it means that the segmentation has changed
@@ -0,0 +1,201 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// vtkTeem includes
+#include <vtkDiffusionTensorGlyph.h>
+#include <vtkDiffusionTensorMathematics.h>
+
+// VTK includes
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkMath.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+// STD includes
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+bool checkValue(const char* name, double actual, double expected, int line)
+{
+  if (std::fabs(actual - expected) > 1e-4)
+    {
+    std::cerr << "Line " << line << ": " << name << " is " << actual
+              << ", expected " << expected << std::endl;
+    return false;
+    }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkDiffusionTensorGlyphTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // 3x3x1 tensor image, with eigenvalues (4, 1, 1) * 1e-6 at each voxel,
+  // except the center voxel where the tensor is zero
+  vtkNew<vtkImageData> tensorImage;
+  int dimensions[3] = {3, 3, 1};
+  tensorImage->SetDimensions(dimensions);
+  tensorImage->SetSpacing(10., 10., 10.);
+  vtkNew<vtkFloatArray> tensors;
+  tensors->SetNumberOfComponents(9);
+  tensors->SetNumberOfTuples(dimensions[0] * dimensions[1] * dimensions[2]);
+  for (vtkIdType i = 0; i < tensors->GetNumberOfTuples(); ++i)
+    {
+    float tensor[9] = {4e-6f, 0.f, 0.f, 0.f, 1e-6f, 0.f, 0.f, 0.f, 1e-6f};
+    if (i == 4)
+      {
+      tensor[0] = tensor[4] = tensor[8] = 0.f;
+      }
+    tensors->SetTypedTuple(i, tensor);
+    }
+  tensorImage->GetPointData()->SetTensors(tensors);
+
+  // Glyph source: a single triangle
+  vtkNew<vtkPolyData> source;
+  vtkNew<vtkPoints> sourcePoints;
+  sourcePoints->InsertNextPoint(1., 0., 0.);
+  sourcePoints->InsertNextPoint(0., 1., 0.);
+  sourcePoints->InsertNextPoint(0., 0., 1.);
+  source->SetPoints(sourcePoints);
+  vtkNew<vtkCellArray> sourcePolys;
+  vtkIdType triangle[3] = {0, 1, 2};
+  sourcePolys->InsertNextCell(3, triangle);
+  source->SetPolys(sourcePolys);
+
+  vtkNew<vtkDiffusionTensorGlyph> glyphFilter;
+  glyphFilter->SetInputData(tensorImage);
+  glyphFilter->SetSourceData(source);
+  glyphFilter->SetDimensionResolution(1, 1);
+  glyphFilter->ColorGlyphsByFractionalAnisotropy();
+  glyphFilter->Update();
+
+  // Center voxel is not glyphed, as its trace is zero
+  vtkPolyData* output = glyphFilter->GetOutput();
+  if (output->GetNumberOfPoints() != 8 * 3 || output->GetNumberOfPolys() != 8)
+    {
+    std::cerr << "Line " << __LINE__ << ": unexpected number of points (" << output->GetNumberOfPoints()
+              << ") or cells (" << output->GetNumberOfPolys() << ")" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Glyphs are scaled by the square root of the eigenvalues (times ScaleFactor)
+  // and oriented along the eigenvectors.
+  double center[3] = {0., 0., 0.};
+  double point[3];
+  output->GetPoint(0, point);
+  if (!checkValue("major axis", std::sqrt(vtkMath::Distance2BetweenPoints(point, center)), 2., __LINE__)
+    || !checkValue("major axis x", std::fabs(point[0]), 2., __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+  output->GetPoint(1, point);
+  if (!checkValue("medium axis", std::sqrt(vtkMath::Distance2BetweenPoints(point, center)), 1., __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+  vtkIdType npts = 0;
+  const vtkIdType* pts = nullptr;
+  output->GetPolys()->GetCellAtId(7, npts, pts);
+  if (npts != 3 || pts[0] != 21 || pts[2] != 23)
+    {
+    std::cerr << "Line " << __LINE__ << ": unexpected connectivity of the last glyph" << std::endl;
+    return EXIT_FAILURE;
+    }
+  double eigenvalues[3] = {4e-6, 1e-6, 1e-6};
+  double expectedFA = vtkDiffusionTensorMathematics::FractionalAnisotropy(eigenvalues);
+  vtkDataArray* scalars = output->GetPointData()->GetScalars();
+  if (!scalars || scalars->GetNumberOfTuples() != 8 * 3
+    || !checkValue("scalar", scalars->GetComponent(23, 0), expectedFA, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Three symmetric glyphs per tensor
+  glyphFilter->ThreeGlyphsOn();
+  glyphFilter->SymmetricOn();
+  glyphFilter->Update();
+  if (output->GetNumberOfPoints() != 8 * 6 * 3 || output->GetNumberOfPolys() != 8 * 6)
+    {
+    std::cerr << "Line " << __LINE__ << ": unexpected number of points (" << output->GetNumberOfPoints()
+              << ") or cells (" << output->GetNumberOfPolys() << ") with symmetric glyphs" << std::endl;
+    return EXIT_FAILURE;
+    }
+  glyphFilter->ThreeGlyphsOff();
+  glyphFilter->SymmetricOff();
+
+  // Masking
+  vtkNew<vtkImageData> maskImage;
+  maskImage->SetDimensions(dimensions);
+  maskImage->AllocateScalars(VTK_SHORT, 1);
+  short* maskPtr = static_cast<short*>(maskImage->GetScalarPointer());
+  for (int i = 0; i < dimensions[0] * dimensions[1] * dimensions[2]; ++i)
+    {
+    maskPtr[i] = (i == 1 ? 1 : 0);
+    }
+  glyphFilter->SetMask(maskImage);
+  glyphFilter->MaskGlyphsOn();
+  glyphFilter->Update();
+  if (output->GetNumberOfPoints() != 3 || output->GetNumberOfPolys() != 1)
+    {
+    std::cerr << "Line " << __LINE__ << ": unexpected number of points (" << output->GetNumberOfPoints()
+              << ") or cells (" << output->GetNumberOfPolys() << ") with mask" << std::endl;
+    return EXIT_FAILURE;
+    }
+  output->GetPoint(0, point);
+  center[0] = 10.;
+  if (!checkValue("masked glyph major axis", std::sqrt(vtkMath::Distance2BetweenPoints(point, center)), 2., __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+  glyphFilter->MaskGlyphsOff();
+
+  // Glyph instancing
+  glyphFilter->GlyphInstancingOn();
+  glyphFilter->Update();
+  vtkDataArray* orientations = output->GetPointData()->GetArray(vtkDiffusionTensorGlyph::GetGlyphOrientationArrayName());
+  vtkDataArray* scales = output->GetPointData()->GetArray(vtkDiffusionTensorGlyph::GetGlyphScaleArrayName());
+  if (output->GetNumberOfPoints() != 8 || output->GetNumberOfCells() != 0
+    || !orientations || orientations->GetNumberOfComponents() != 4 || orientations->GetNumberOfTuples() != 8
+    || !scales || scales->GetNumberOfComponents() != 3 || scales->GetNumberOfTuples() != 8)
+    {
+    std::cerr << "Line " << __LINE__ << ": unexpected output in glyph instancing mode" << std::endl;
+    return EXIT_FAILURE;
+    }
+  double quaternion[4];
+  orientations->GetTuple(0, quaternion);
+  double quaternionNorm = std::sqrt(quaternion[0] * quaternion[0] + quaternion[1] * quaternion[1]
+    + quaternion[2] * quaternion[2] + quaternion[3] * quaternion[3]);
+  output->GetPoint(8 - 1, point);
+  if (!checkValue("orientation norm", quaternionNorm, 1., __LINE__)
+    || !checkValue("scale x", std::fabs(scales->GetComponent(0, 0)), 2., __LINE__)
+    || !checkValue("scale y", std::fabs(scales->GetComponent(0, 1)), 1., __LINE__)
+    || !checkValue("instance position x", point[0], 20., __LINE__)
+    || !checkValue("instance position y", point[1], 20., __LINE__)
+    || !checkValue("instance scalar", output->GetPointData()->GetScalars()->GetComponent(0, 0), expectedFA, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -29,6 +29,9 @@
 #include <vtkPointData.h>
 #include <vtkVersion.h>
 
+// STD includes
+#include <cmath>
+
 //----------------------------------------------------------------------------
 int vtkDiffusionTensorMathematicsTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
 {
@@ -119,5 +122,53 @@ int vtkDiffusionTensorMathematicsTest1(int vtkNotUsed(argc), char* vtkNotUsed(ar
       }
     std::cout << std::endl << std::endl;
     }
+
+  // Compute several operations in a single pass and compare with separate executions
+  const int operations[3] = {
+    vtkDiffusionTensorMathematics::VTK_TENS_FRACTIONAL_ANISOTROPY,
+    vtkDiffusionTensorMathematics::VTK_TENS_TRACE,
+    vtkDiffusionTensorMathematics::VTK_TENS_COLOR_ORIENTATION};
+  vtkNew<vtkDiffusionTensorMathematics> multiFilter;
+  multiFilter->SetInputData(tensorImage.GetPointer());
+  multiFilter->SetScalarMask(maskImage.GetPointer());
+  multiFilter->SetMaskLabelValue(0);
+  multiFilter->SetMaskWithScalars(1);
+  multiFilter->SetNumberOfOperations(3);
+  if (multiFilter->GetNumberOfOperations() != 3 || multiFilter->GetNumberOfOutputPorts() != 3)
+    {
+    std::cerr << "Line " << __LINE__ << ": SetNumberOfOperations failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+  for (int n = 0; n < 3; ++n)
+    {
+    multiFilter->SetNthOperation(n, operations[n]);
+    }
+  multiFilter->Update();
+  for (int n = 0; n < 3; ++n)
+    {
+    filter->SetOperation(operations[n]);
+    filter->Update();
+    vtkDataArray* expected = filter->GetOutput()->GetPointData()->GetScalars();
+    vtkDataArray* actual = multiFilter->GetOutput(n)->GetPointData()->GetScalars();
+    if (!actual || actual->GetDataType() != expected->GetDataType()
+      || actual->GetNumberOfComponents() != expected->GetNumberOfComponents()
+      || actual->GetNumberOfTuples() != expected->GetNumberOfTuples())
+      {
+      std::cerr << "Line " << __LINE__ << ": invalid output " << n << std::endl;
+      return EXIT_FAILURE;
+      }
+    for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+      {
+      int numberOfComponents = expected->GetNumberOfComponents();
+      double expectedValue = expected->GetComponent(i / numberOfComponents, i % numberOfComponents);
+      double actualValue = actual->GetComponent(i / numberOfComponents, i % numberOfComponents);
+      if (fabs(expectedValue - actualValue) > 1e-5)
+        {
+        std::cerr << "Line " << __LINE__ << ": operation " << operations[n] << " value " << i
+                  << " is " << actualValue << ", expected " << expectedValue << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
   return EXIT_SUCCESS;
 }
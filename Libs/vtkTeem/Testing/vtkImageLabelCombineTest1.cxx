@@ -0,0 +1,107 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  Copyright (c) Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// vtkTeem includes
+#include <vtkImageLabelCombine.h>
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <iostream>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> CreateLabelmap(const short values[4])
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(4, 1, 1);
+  image->AllocateScalars(VTK_SHORT, 1);
+  short* ptr = static_cast<short*>(image->GetScalarPointer());
+  for (int i = 0; i < 4; ++i)
+    {
+    ptr[i] = values[i];
+    }
+  return image;
+}
+
+//----------------------------------------------------------------------------
+bool CheckOutput(vtkImageLabelCombine* filter, const short expected[4], int line)
+{
+  filter->Update();
+  short* ptr = static_cast<short*>(filter->GetOutput()->GetScalarPointer());
+  for (int i = 0; i < 4; ++i)
+    {
+    if (ptr[i] != expected[i])
+      {
+      std::cerr << "Line " << line << ": voxel " << i << " is " << ptr[i]
+                << ", expected " << expected[i] << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkImageLabelCombineTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  const short values1[4] = { 0, 1, 0, -1 };
+  const short values2[4] = { 0, 2, 2, 2 };
+  const short values3[4] = { 3, 3, 0, 3 };
+  vtkSmartPointer<vtkImageData> image1 = CreateLabelmap(values1);
+  vtkSmartPointer<vtkImageData> image2 = CreateLabelmap(values2);
+  vtkSmartPointer<vtkImageData> image3 = CreateLabelmap(values3);
+
+  // Two inputs
+  vtkNew<vtkImageLabelCombine> filter;
+  filter->SetInput1(image1);
+  filter->SetInput2(image2);
+  const short firstOverwrites2[4] = { 0, 1, 2, 0 };
+  if (!CheckOutput(filter, firstOverwrites2, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+  filter->SetOverwriteInput(1);
+  const short secondOverwrites2[4] = { 0, 2, 2, 2 };
+  if (!CheckOutput(filter, secondOverwrites2, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Three inputs, combined in one pass
+  filter->AddInput2(image3);
+  filter->SetOverwriteInput(0);
+  const short firstOverwrites3[4] = { 3, 1, 2, 0 };
+  if (!CheckOutput(filter, firstOverwrites3, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+  filter->SetOverwriteInput(1);
+  const short lastOverwrites3[4] = { 3, 3, 2, 3 };
+  if (!CheckOutput(filter, lastOverwrites3, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
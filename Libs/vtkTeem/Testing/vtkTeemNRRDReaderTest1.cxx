@@ -0,0 +1,211 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// vtkTeem includes
+#include <vtkTeemNRRDReader.h>
+
+// VTK includes
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+bool IsLittleEndian()
+{
+  const unsigned short value = 1;
+  return *reinterpret_cast<const unsigned char*>(&value) == 1;
+}
+
+//----------------------------------------------------------------------------
+/// Write a detached header NRRD file of short voxels, with byteSkip bytes
+/// of padding before the voxel data.
+bool WriteDetachedNRRD(const std::string& headerFileName, const std::string& dataFileName,
+  const int dimensions[3], int byteSkip)
+{
+  std::ofstream header(headerFileName.c_str());
+  header << "NRRD0004\n"
+         << "type: short\n"
+         << "dimension: 3\n"
+         << "space: left-posterior-superior\n"
+         << "sizes: " << dimensions[0] << " " << dimensions[1] << " " << dimensions[2] << "\n"
+         << "space directions: (1,0,0) (0,1,0) (0,0,1)\n"
+         << "kinds: domain domain domain\n"
+         << "endian: " << (IsLittleEndian() ? "little" : "big") << "\n"
+         << "encoding: raw\n"
+         << "space origin: (0,0,0)\n"
+         << "byte skip: " << byteSkip << "\n"
+         << "data file: " << dataFileName << "\n";
+  header.close();
+
+  std::string dataFilePath = headerFileName.substr(0, headerFileName.find_last_of("/\\") + 1) + dataFileName;
+  std::ofstream data(dataFilePath.c_str(), std::ios::binary);
+  for (int i = 0; i < byteSkip; ++i)
+    {
+    data.put(0);
+    }
+  const int numberOfVoxels = dimensions[0] * dimensions[1] * dimensions[2];
+  for (short value = 0; value < numberOfVoxels; ++value)
+    {
+    data.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+  return data.good();
+}
+
+//----------------------------------------------------------------------------
+int ReadAndCheck(const std::string& fileName, bool useMemoryMapping, const int dimensions[3])
+{
+  vtkSmartPointer<vtkImageData> image;
+  {
+    vtkNew<vtkTeemNRRDReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->SetUseMemoryMapping(useMemoryMapping);
+    reader->Update();
+    image = reader->GetOutput();
+  }
+  int imageDimensions[3] = { 0, 0, 0 };
+  image->GetDimensions(imageDimensions);
+  for (int i = 0; i < 3; ++i)
+    {
+    if (imageDimensions[i] != dimensions[i])
+      {
+      std::cerr << "Line " << __LINE__ << ": unexpected dimensions when reading "
+                << fileName << " (memory mapping: " << useMemoryMapping << ")" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  if (!scalars || scalars->GetDataType() != VTK_SHORT)
+    {
+    std::cerr << "Line " << __LINE__ << ": unexpected scalars when reading " << fileName << std::endl;
+    return EXIT_FAILURE;
+    }
+  const short* values = static_cast<const short*>(scalars->GetVoidPointer(0));
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+    {
+    if (values[i] != static_cast<short>(i))
+      {
+      std::cerr << "Line " << __LINE__ << ": unexpected value at " << i << " when reading "
+                << fileName << " (memory mapping: " << useMemoryMapping << "): " << values[i] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  // Memory-mapped data is copy-on-write, it can be modified without changing the file
+  scalars->SetTuple1(0, 1000);
+  return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+int ReadRegionAndCheck(const std::string& fileName, const int dimensions[3])
+{
+  vtkNew<vtkTeemNRRDReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetReadExtent(1, 5, 1, 3, 0, 2);
+  reader->SetReadDownsamplingFactor(2);
+  reader->Update();
+  vtkImageData* image = reader->GetOutput();
+  int imageDimensions[3] = { 0, 0, 0 };
+  image->GetDimensions(imageDimensions);
+  if (imageDimensions[0] != 3 || imageDimensions[1] != 2 || imageDimensions[2] != 2)
+    {
+    std::cerr << "Line " << __LINE__ << ": unexpected region dimensions when reading " << fileName << ": "
+              << imageDimensions[0] << " " << imageDimensions[1] << " " << imageDimensions[2] << std::endl;
+    return EXIT_FAILURE;
+    }
+  const short* values = static_cast<const short*>(image->GetScalarPointer());
+  int index = 0;
+  for (int k = 0; k <= 2; k += 2)
+    {
+    for (int j = 1; j <= 3; j += 2)
+      {
+      for (int i = 1; i <= 5; i += 2)
+        {
+        short expectedValue = static_cast<short>(i + dimensions[0] * (j + dimensions[1] * k));
+        if (values[index] != expectedValue)
+          {
+          std::cerr << "Line " << __LINE__ << ": unexpected region value at " << index << " when reading "
+                    << fileName << ": " << values[index] << " != " << expectedValue << std::endl;
+          return EXIT_FAILURE;
+          }
+        ++index;
+        }
+      }
+    }
+  // Voxel (0,0,0) of the region is voxel (1,1,0) of the image, with 2x spacing
+  vtkMatrix4x4* rasToIjk = reader->GetRasToIjkMatrix();
+  double ras[4] = { -1.0, -1.0, 0.0, 1.0 };
+  double ijk[4] = { 0.0, 0.0, 0.0, 0.0 };
+  rasToIjk->MultiplyPoint(ras, ijk);
+  if (fabs(ijk[0]) > 1e-6 || fabs(ijk[1]) > 1e-6 || fabs(ijk[2]) > 1e-6
+    || fabs(rasToIjk->GetElement(2, 2) - 0.5) > 1e-6)
+    {
+    std::cerr << "Line " << __LINE__ << ": unexpected region geometry when reading " << fileName << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkTeemNRRDReaderTest1(int argc, char* argv[])
+{
+  if (argc < 2)
+    {
+    std::cerr << "Usage: vtkTeemNRRDReaderTest1 /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string tempDir = argv[1];
+  const int dimensions[3] = { 7, 5, 3 };
+
+  const int byteSkips[2] = { 0, 5000 };
+  for (int byteSkip : byteSkips)
+    {
+    std::string headerFileName = tempDir + "/vtkTeemNRRDReaderTest1_" + std::to_string(byteSkip) + ".nhdr";
+    std::string dataFileName = "vtkTeemNRRDReaderTest1_" + std::to_string(byteSkip) + ".raw";
+    if (!WriteDetachedNRRD(headerFileName, dataFileName, dimensions, byteSkip))
+      {
+      std::cerr << "Line " << __LINE__ << ": failed to write " << headerFileName << std::endl;
+      return EXIT_FAILURE;
+      }
+    // Read twice with each mode to check that the modified voxel is not written to the file
+    for (int i = 0; i < 2; ++i)
+      {
+      if (ReadAndCheck(headerFileName, true, dimensions) != EXIT_SUCCESS
+        || ReadAndCheck(headerFileName, false, dimensions) != EXIT_SUCCESS)
+        {
+        return EXIT_FAILURE;
+        }
+      }
+    if (ReadRegionAndCheck(headerFileName, dimensions) != EXIT_SUCCESS)
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  std::cout << "vtkTeemNRRDReaderTest1 passed" << std::endl;
+  return EXIT_SUCCESS;
+}
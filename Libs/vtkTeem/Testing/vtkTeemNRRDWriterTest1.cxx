@@ -0,0 +1,123 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// vtkTeem includes
+#include <vtkTeemNRRDReader.h>
+#include <vtkTeemNRRDWriter.h>
+
+// VTK includes
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+
+// VTKsys includes
+#include <vtksys/SystemTools.hxx>
+
+// STD includes
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+int WriteAndReadCompressed(vtkImageData* image, const std::string& fileName, bool useParallelCompression)
+{
+  vtkNew<vtkTeemNRRDWriter> writer;
+  writer->SetFileName(fileName.c_str());
+  writer->SetInputData(image);
+  writer->SetUseCompression(true);
+  writer->SetCompressionLevel(1);
+  writer->SetUseParallelCompression(useParallelCompression);
+  writer->SetNumberOfCompressionThreads(2);
+  writer->Write();
+  if (writer->GetWriteError())
+    {
+    std::cerr << "Line " << __LINE__ << ": failed to write " << fileName << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkTeemNRRDReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkDataArray* readScalars = reader->GetOutput()->GetPointData()->GetScalars();
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  if (!readScalars || readScalars->GetNumberOfValues() != scalars->GetNumberOfValues())
+    {
+    std::cerr << "Line " << __LINE__ << ": unexpected scalars read from " << fileName << std::endl;
+    return EXIT_FAILURE;
+    }
+  const short* values = static_cast<const short*>(scalars->GetVoidPointer(0));
+  const short* readValues = static_cast<const short*>(readScalars->GetVoidPointer(0));
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+    {
+    if (readValues[i] != values[i])
+      {
+      std::cerr << "Line " << __LINE__ << ": unexpected value at " << i << " read from " << fileName
+                << " (parallel compression: " << useParallelCompression << "): "
+                << readValues[i] << " != " << values[i] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkTeemNRRDWriterTest1(int argc, char* argv[])
+{
+  if (argc < 2)
+    {
+    std::cerr << "Usage: vtkTeemNRRDWriterTest1 /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string tempDir = argv[1];
+
+  // Image larger than a compression chunk, so that it is compressed in several parallel chunks
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(256, 256, 50);
+  image->AllocateScalars(VTK_SHORT, 1);
+  short* values = static_cast<short*>(image->GetScalarPointer());
+  vtkIdType numberOfValues = image->GetPointData()->GetScalars()->GetNumberOfValues();
+  for (vtkIdType i = 0; i < numberOfValues; ++i)
+    {
+    values[i] = static_cast<short>((i * 7) % 1000 - (i / 65536) * 13);
+    }
+
+  const char* extensions[2] = { ".nrrd", ".nhdr" };
+  for (const char* extension : extensions)
+    {
+    for (int parallel = 0; parallel < 2; ++parallel)
+      {
+      std::string fileName = tempDir + "/vtkTeemNRRDWriterTest1" + std::to_string(parallel) + extension;
+      if (WriteAndReadCompressed(image, fileName, parallel != 0) != EXIT_SUCCESS)
+        {
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // Detached data is written in the same file as without parallel compression
+  if (!vtksys::SystemTools::FileExists(tempDir + "/vtkTeemNRRDWriterTest11.raw.gz", true))
+    {
+    std::cerr << "Line " << __LINE__ << ": detached data file not found" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "vtkTeemNRRDWriterTest1 passed" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -15,19 +15,25 @@
 
 #include "vtkCellArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include <vtkNew.h>
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
-#include "vtkTransform.h"
 
 #include "vtkImageData.h"
 #include "vtkDiffusionTensorMathematics.h"
 
+#include <algorithm>
 #include <ctime>
+#include <vector>
 
 vtkCxxSetObjectMacro(vtkDiffusionTensorGlyph,Mask,vtkImageData);
 vtkCxxSetObjectMacro(vtkDiffusionTensorGlyph,VolumePositionMatrix,vtkMatrix4x4);
@@ -56,6 +62,8 @@ vtkDiffusionTensorGlyph::vtkDiffusionTensorGlyph()
   this->DimensionResolution[0] = 20;
   this->DimensionResolution[1] = 20;
 
+  this->GlyphInstancing = 0;
+
   // Default large scalar factor for diffusion data.
   // Display small magnitude eigenvalues in mm space.
   this->ScaleFactor = 1000;
@@ -138,6 +146,220 @@ void vtkDiffusionTensorGlyph::ColorGlyphsBy(int invariant) {
     }
 }
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Orientation, scale and scalar of the glyph of one input point.
+struct TensorGlyphParameters
+{
+  vtkIdType InputPointId;
+  bool Visible;
+  double Position[3];
+  // normalized eigenvectors as columns
+  double Eigenvectors[3][3];
+  double Scale[3];
+  double Scalar;
+};
+
+//----------------------------------------------------------------------------
+/// Compute the linear part and translation of the transform of the glyph of
+/// eigenvector eigenDir. This is the same transform as the one that was built
+/// with vtkTransform (in PreMultiply mode) for each glyph:
+/// Translate(position) * TensorRotationMatrix * Eigenvectors * Rotate(eigenDir)
+/// * Scale * Mirror(symmetricDir) * Translate(-Length) (for negative scale).
+void ComputeGlyphTransform(const TensorGlyphParameters& glyph, const double rotation[3][3],
+                           const double rotationTranslation[3], int threeGlyphs, double scaleFactor,
+                           int eigenDir, int symmetricDir, double offset,
+                           double linear[3][3], double translation[3])
+{
+  double orientation[3][3];
+  vtkMath::Multiply3x3(rotation, glyph.Eigenvectors, orientation);
+  if (eigenDir == 1)
+    {
+    // Rotate the glyph by 90 degrees around Z
+    const double rotateZ[3][3] = {{0., -1., 0.}, {1., 0., 0.}, {0., 0., 1.}};
+    vtkMath::Multiply3x3(orientation, rotateZ, orientation);
+    }
+  else if (eigenDir == 2)
+    {
+    // Rotate the glyph by -90 degrees around Y
+    const double rotateY[3][3] = {{0., 0., -1.}, {0., 1., 0.}, {1., 0., 0.}};
+    vtkMath::Multiply3x3(orientation, rotateY, orientation);
+    }
+
+  double scale[3];
+  if (threeGlyphs)
+    {
+    scale[0] = glyph.Scale[eigenDir];
+    scale[1] = scaleFactor;
+    scale[2] = scaleFactor;
+    }
+  else
+    {
+    scale[0] = glyph.Scale[0];
+    scale[1] = glyph.Scale[1];
+    scale[2] = glyph.Scale[2];
+    }
+  // Mirror second set to the symmetric position
+  if (symmetricDir == 1)
+    {
+    scale[0] = -scale[0];
+    }
+  for (int row = 0; row < 3; ++row)
+    {
+    for (int col = 0; col < 3; ++col)
+      {
+      linear[row][col] = orientation[row][col] * scale[col];
+      }
+    translation[row] = glyph.Position[row] + rotationTranslation[row] - linear[row][0] * offset;
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Create cells of all the glyphs from the cells of the source glyph.
+/// Cells are ordered by glyph, then by source cell and then by direction.
+vtkSmartPointer<vtkCellArray> CreateGlyphCells(vtkCellArray* sourceCells, vtkIdType numberOfGlyphs,
+                                               int numDirs, vtkIdType numSourcePts)
+{
+  std::vector<vtkIdType> sourceOffsets(1, 0);
+  std::vector<vtkIdType> sourceConnectivity;
+  vtkIdType npts = 0;
+  const vtkIdType* pts = nullptr;
+  for (sourceCells->InitTraversal(); sourceCells->GetNextCell(npts, pts);)
+    {
+    sourceConnectivity.insert(sourceConnectivity.end(), pts, pts + npts);
+    sourceOffsets.push_back(static_cast<vtkIdType>(sourceConnectivity.size()));
+    }
+  const vtkIdType numSourceCells = static_cast<vtkIdType>(sourceOffsets.size()) - 1;
+  const vtkIdType sourceConnectivitySize = static_cast<vtkIdType>(sourceConnectivity.size());
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numberOfGlyphs * numDirs * numSourceCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numberOfGlyphs * numDirs * sourceConnectivitySize);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkIdType* connectivityPtr = connectivity->GetPointer(0);
+
+  vtkSMPTools::For(0, numberOfGlyphs, [&](vtkIdType beginGlyph, vtkIdType endGlyph)
+    {
+    for (vtkIdType glyphIndex = beginGlyph; glyphIndex < endGlyph; ++glyphIndex)
+      {
+      vtkIdType cellIndex = glyphIndex * numDirs * numSourceCells;
+      vtkIdType connectivityIndex = glyphIndex * numDirs * sourceConnectivitySize;
+      // Offset of the points of this glyph in the output
+      const vtkIdType ptOffset = glyphIndex * numDirs * numSourcePts;
+      for (vtkIdType cellId = 0; cellId < numSourceCells; ++cellId)
+        {
+        for (int dir = 0; dir < numDirs; ++dir)
+          {
+          const vtkIdType subIncr = ptOffset + dir * numSourcePts;
+          offsetsPtr[cellIndex++] = connectivityIndex;
+          for (vtkIdType i = sourceOffsets[cellId]; i < sourceOffsets[cellId + 1]; ++i)
+            {
+            connectivityPtr[connectivityIndex++] = sourceConnectivity[i] + subIncr;
+            }
+          }
+        }
+      }
+    });
+  offsetsPtr[numberOfGlyphs * numDirs * numSourceCells] = numberOfGlyphs * numDirs * sourceConnectivitySize;
+
+  vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+  cells->SetData(offsets, connectivity);
+  return cells;
+}
+
+//----------------------------------------------------------------------------
+/// Output one point per glyph, with the orientation (as quaternion) and scale
+/// of the glyph in point data arrays, for rendering with vtkGlyph3DMapper.
+void GenerateGlyphInstances(vtkPolyData* output, const std::vector<TensorGlyphParameters>& glyphs,
+                            int numDirs, int threeGlyphs, double scaleFactor,
+                            const double rotation[3][3], const double rotationTranslation[3],
+                            vtkFloatArray* newScalars)
+{
+  const vtkIdType numInstances = static_cast<vtkIdType>(glyphs.size()) * numDirs;
+
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataTypeToFloat();
+  newPts->SetNumberOfPoints(numInstances);
+  float* newPtsPtr = static_cast<float*>(newPts->GetVoidPointer(0));
+
+  vtkNew<vtkFloatArray> orientations;
+  orientations->SetName(vtkDiffusionTensorGlyph::GetGlyphOrientationArrayName());
+  orientations->SetNumberOfComponents(4);
+  orientations->SetNumberOfTuples(numInstances);
+  float* orientationsPtr = orientations->GetPointer(0);
+
+  vtkNew<vtkFloatArray> scales;
+  scales->SetName(vtkDiffusionTensorGlyph::GetGlyphScaleArrayName());
+  scales->SetNumberOfComponents(3);
+  scales->SetNumberOfTuples(numInstances);
+  float* scalesPtr = scales->GetPointer(0);
+
+  float* newScalarsPtr = nullptr;
+  if (newScalars)
+    {
+    newScalars->SetNumberOfTuples(numInstances);
+    newScalarsPtr = newScalars->GetPointer(0);
+    }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(glyphs.size()), [&](vtkIdType beginGlyph, vtkIdType endGlyph)
+    {
+    double linear[3][3], translation[3], orientation[3][3], scale[3], quaternion[4];
+    for (vtkIdType glyphIndex = beginGlyph; glyphIndex < endGlyph; ++glyphIndex)
+      {
+      const TensorGlyphParameters& glyph = glyphs[glyphIndex];
+      for (int dir = 0; dir < numDirs; dir++)
+        {
+        ComputeGlyphTransform(glyph, rotation, rotationTranslation, threeGlyphs, scaleFactor,
+          dir%(threeGlyphs?3:1), dir/(threeGlyphs?3:1), 0.0, linear, translation);
+
+        // Split the linear part into a rotation and a scale along each glyph axis.
+        // Mirroring is stored as a negative scale along the glyph x axis.
+        for (int col = 0; col < 3; col++)
+          {
+          scale[col] = sqrt(linear[0][col] * linear[0][col] + linear[1][col] * linear[1][col]
+            + linear[2][col] * linear[2][col]);
+          for (int row = 0; row < 3; row++)
+            {
+            orientation[row][col] = (scale[col] > 0.0 ? linear[row][col] / scale[col] : linear[row][col]);
+            }
+          }
+        if (vtkMath::Determinant3x3(orientation) < 0)
+          {
+          scale[0] = -scale[0];
+          orientation[0][0] = -orientation[0][0];
+          orientation[1][0] = -orientation[1][0];
+          orientation[2][0] = -orientation[2][0];
+          }
+        vtkMath::Matrix3x3ToQuaternion(orientation, quaternion);
+
+        const vtkIdType instanceId = glyphIndex * numDirs + dir;
+        for (int i = 0; i < 3; i++)
+          {
+          newPtsPtr[3 * instanceId + i] = static_cast<float>(translation[i]);
+          scalesPtr[3 * instanceId + i] = static_cast<float>(scale[i]);
+          }
+        for (int i = 0; i < 4; i++)
+          {
+          orientationsPtr[4 * instanceId + i] = static_cast<float>(quaternion[i]);
+          }
+        if (newScalarsPtr)
+          {
+          newScalarsPtr[instanceId] = static_cast<float>(glyph.Scalar);
+          }
+        }
+      }
+    });
+
+  output->SetPoints(newPts);
+  output->GetPointData()->AddArray(orientations);
+  output->GetPointData()->AddArray(scales);
+}
+
+} // end of anonymous namespace
+
 // TO DO: make input mask a point data object or scalars
 
 int vtkDiffusionTensorGlyph::RequestData(
@@ -160,37 +382,13 @@ int vtkDiffusionTensorGlyph::RequestData(
 
   vtkDataArray *inTensors;
   vtkDataArray *inScalars;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  int j;
-  vtkPoints *sourcePts;
+  vtkIdType numPts, numSourcePts, inPtId;
   vtkDataArray *sourceNormals;
-  vtkCellArray *sourceCells, *cells;
-  vtkPoints *newPts;
   vtkFloatArray *newScalars=nullptr;
   vtkFloatArray *newNormals=nullptr;
-  double x[3], x2[3], s;
-  vtkTransform *trans;
-  vtkCell *cell;
-  vtkIdList *cellPts;
-  int npts;
-  vtkIdType *pts;
-  vtkIdType cellId;
-  vtkIdType subIncr;
-  int numDirs, dir, eigen_dir, symmetric_dir;
-  vtkMatrix4x4 *matrix;
-  double *m[3], w[3], *v[3];
-  double m0[3], m1[3], m2[3];
-  double v0[3], v1[3], v2[3];
-  double xv[3], yv[3], zv[3];
-  double maxScale;
+  int numDirs;
   vtkPointData *pd, *outPD;
 
-  // Keeps track of the number of points added to the output polydata so far.
-  // this replaces variable ptIncr in superclass vtkTensorGlyph.
-  vtkIdType ptOffset = 0;
-
-  // coordinate systems for DTI
-  vtkTransform *userVolumeTransform = nullptr;
   // masking of glyphs
   vtkDataArray *inMask;
   // glyph timing
@@ -198,20 +396,9 @@ int vtkDiffusionTensorGlyph::RequestData(
   clock_t tStart = clock();
 #endif
 
-  // use simpler 3x3 array, not 9D as in vtkTensorGlyph class
-  double tensor[3][3];
-
   // the number of eigenvectors to glyph * if there are two glyphs per vector
   numDirs = (this->ThreeGlyphs?3:1)*(this->Symmetric+1);
 
-  pts = new vtkIdType[source->GetMaxCellSize()];
-  trans = vtkTransform::New();
-  matrix = vtkMatrix4x4::New();
-
-  // set up working matrices
-  m[0] = m0; m[1] = m1; m[2] = m2;
-  v[0] = v0; v[1] = v1; v[2] = v2;
-
   vtkDebugMacro(<<"Generating tensor glyphs");
 
   pd = input->GetPointData();
@@ -222,8 +409,6 @@ int vtkDiffusionTensorGlyph::RequestData(
   if ( !inTensors || numPts < 1 )
     {
     vtkErrorMacro(<<"No data to glyph!");
-    trans->Delete();
-    matrix->Delete();
     return 1;
     }
 
@@ -257,78 +442,6 @@ int vtkDiffusionTensorGlyph::RequestData(
       }
     }
 
-  //
-  // Allocate storage for output PolyData
-  //
-  sourcePts = source->GetPoints();
-  numSourcePts = sourcePts->GetNumberOfPoints();
-  numSourceCells = source->GetNumberOfCells();
-
-  newPts = vtkPoints::New();
-  // Allocate as if we will glyph every point
-  // If some are masked/skipped for Resolution this will be fixed later with Squeeze
-  // TO DO allocate less for lower resolution
-  newPts->Allocate(numDirs*numInputPts*numSourcePts);
-
-  // Setting up for calls to PolyData::InsertNextCell()
-  if ( (sourceCells=source->GetVerts())->GetNumberOfCells() > 0 )
-    {
-    cells = vtkCellArray::New();
-    cells->Allocate(numDirs*numInputPts*sourceCells->GetSize());
-    output->SetVerts(cells);
-    cells->Delete();
-    }
-  if ( (sourceCells=this->GetSource()->GetLines())->GetNumberOfCells() > 0 )
-    {
-    cells = vtkCellArray::New();
-    cells->Allocate(numDirs*numInputPts*sourceCells->GetSize());
-    output->SetLines(cells);
-    cells->Delete();
-    }
-  if ( (sourceCells=this->GetSource()->GetPolys())->GetNumberOfCells() > 0 )
-    {
-    cells = vtkCellArray::New();
-    cells->Allocate(numDirs*numInputPts*sourceCells->GetSize());
-    output->SetPolys(cells);
-    cells->Delete();
-    }
-  if ( (sourceCells=this->GetSource()->GetStrips())->GetNumberOfCells() > 0 )
-    {
-    cells = vtkCellArray::New();
-    cells->Allocate(numDirs*numInputPts*sourceCells->GetSize());
-    output->SetStrips(cells);
-    cells->Delete();
-    }
-
-  // Get point data, decide how to allocate scalars
-  pd = this->GetSource()->GetPointData();
-
-  // generate scalars if eigenvalues are chosen or if scalars exist.
-  if (this->ColorGlyphs &&
-      ((this->ColorMode == COLOR_BY_EIGENVALUES) ||
-       (inScalars && (this->ColorMode == COLOR_BY_SCALARS)) ) )
-    {
-    newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numDirs*numInputPts*numSourcePts);
-    }
-  else
-    {
-    // only copy scalar data through
-    // (superclass does this but why? if user has not asked for ColorGlyphs)
-    outPD->CopyAllOff();
-    outPD->CopyScalarsOn();
-    outPD->CopyAllocate(pd,numDirs*numInputPts*numSourcePts);
-    }
-  if ( (sourceNormals = pd->GetNormals()) )
-    {
-    newNormals = vtkFloatArray::New();
-    newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(numDirs*3*numInputPts*numSourcePts);
-    }
-
-  // Don't copy all topology here as in superclass because
-  // we are not necessarily outputting a glyph for every point.
-
   // Figure out if we are masking some of the glyphs
   inMask = nullptr;
 
@@ -344,14 +457,30 @@ int vtkDiffusionTensorGlyph::RequestData(
       }
     }
 
-  // Figure out if we are transforming output point locations
+  // Matrices are read here once, as vtkMatrix4x4 and vtkTransform objects
+  // must not be used from multiple threads.
+  double volumePosition[16];
   if (this->VolumePositionMatrix)
     {
-    // user transform to move points
-    userVolumeTransform = vtkTransform::New();
-
-    userVolumeTransform->SetMatrix(this->VolumePositionMatrix);
-    userVolumeTransform->PreMultiply();
+    vtkMatrix4x4::DeepCopy(volumePosition, this->VolumePositionMatrix);
+    }
+  double rotation[3][3] = {{1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}};
+  double rotationTranslation[3] = {0., 0., 0.};
+  int flipNormals = 0;
+  if (this->TensorRotationMatrix)
+    {
+    for (int rowIndex = 0; rowIndex < 3; ++rowIndex)
+      {
+      for (int colIndex = 0; colIndex < 3; ++colIndex)
+        {
+        rotation[rowIndex][colIndex] = this->TensorRotationMatrix->GetElement(rowIndex, colIndex);
+        }
+      rotationTranslation[rowIndex] = this->TensorRotationMatrix->GetElement(rowIndex, 3);
+      }
+    if (this->TensorRotationMatrix->Determinant() < 0)
+      {
+      flipNormals = 1;
+      }
     }
 
   vtkDebugMacro(<<"Generating tensor glyphs: TRAVERSE POINTS");
@@ -359,12 +488,10 @@ int vtkDiffusionTensorGlyph::RequestData(
   vtkDebugMacro("Scalar coloring (" <<  this->ColorMode << ")  ["<< vtkTensorGlyph::COLOR_BY_EIGENVALUES << "] is evals. Scalar Invariant (" << this->ScalarInvariant << ")") ;
 
   //
-  // Traverse all Input points, transforming glyph in this->Source by tensor,
-  // and outputting it at each point.  (Input points are not all used, only
-  // those not masked and included by this->Resolution.)
+  // Collect the input points included by this->Resolution.
   //
-  trans->PreMultiply();
-
+  std::vector<TensorGlyphParameters> glyphs;
+  glyphs.reserve(numInputPts > 0 ? numInputPts : 0);
   for (inPtId=0; inPtId < numPts; inPtId += skipCols)
     {
     if (col >= rowLength)
@@ -378,50 +505,61 @@ int vtkDiffusionTensorGlyph::RequestData(
         }
       }
     col += skipCols;
-    // progress notification
-    if ( ! (inPtId % 10000) )
-      {
-      this->UpdateProgress ((double)inPtId/numPts);
-
-      vtkDebugMacro(<<"Generating diffusion tensor glyphs: PROGRESS" << (double)inPtId/numPts);
-      if (this->GetAbortExecute())
-        {
-        break;
-        }
-      }
+    TensorGlyphParameters glyph;
+    glyph.InputPointId = inPtId;
+    glyph.Visible = false;
+    glyphs.push_back(glyph);
+    }
 
-    inTensors->GetTuple(inPtId, (double *)tensor);
+  // Initialize point access structures of the input before it is accessed from multiple threads
+  double firstPoint[3];
+  input->GetPoint(0, firstPoint);
 
-    // Decide whether this tensor will be glyphed:
-    // Threshold by trace ( must be > 0)
-    double trace = vtkDiffusionTensorMathematics::Trace(tensor);
+  const bool outputInputScalars =
+    inScalars && this->ColorGlyphs && ( this->ColorMode == vtkTensorGlyph::COLOR_BY_SCALARS );
+  const bool outputScalarInvariant =
+    !outputInputScalars && this->ColorGlyphs && ( this->ColorMode == vtkTensorGlyph::COLOR_BY_EIGENVALUES );
 
-    // Only display this glyph if either:
-    // a) we are masking and the mask is 1 at this location.
-    // b) the trace is positive and we are not masking (default).
-    if (( ( inMask != nullptr ) && inMask->GetTuple1( inPtId ) ) || ( !this->MaskGlyphs && trace > 0 ))
+  //
+  // Decide which tensors are glyphed and compute orientation, scale and scalar
+  // of their glyph. Tensors are independent, therefore they are processed in parallel.
+  //
+  vtkSMPTools::For(0, static_cast<vtkIdType>(glyphs.size()), [&](vtkIdType beginGlyph, vtkIdType endGlyph)
+    {
+    // use simpler 3x3 array, not 9D as in vtkTensorGlyph class
+    double tensor[3][3];
+    double *m[3], w[3], *v[3];
+    double m0[3], m1[3], m2[3];
+    double v0[3], v1[3], v2[3];
+    double xv[3], yv[3], zv[3];
+    double x[3];
+    double s = 0.0;
+    double maxScale;
+    int i, j;
+
+    // set up working matrices
+    m[0] = m0; m[1] = m1; m[2] = m2;
+    v[0] = v0; v[1] = v1; v[2] = v2;
+
+    for (vtkIdType glyphIndex = beginGlyph; glyphIndex < endGlyph; ++glyphIndex)
       {
-      // copy topology of output glyph for this point
-      for (cellId=0; cellId < numSourceCells; cellId++)
-        {
-        cell = this->GetSource()->GetCell(cellId);
-        cellPts = cell->GetPointIds();
-        npts = cellPts->GetNumberOfIds();
-        for (dir=0; dir < numDirs; dir++)
-          {
-          // This variable may be removed, but that
-          // will not improve readability
-          //subIncr = ptIncr + dir*numSourcePts;
+      TensorGlyphParameters& glyph = glyphs[glyphIndex];
+      const vtkIdType ptId = glyph.InputPointId;
 
-          // Add offset calculated from all non-masked points added to output so far
-          subIncr = ptOffset + dir*numSourcePts;
+      inTensors->GetTuple(ptId, (double *)tensor);
 
-          for (i=0; i < npts; i++)
-            {
-            pts[i] = cellPts->GetId(i) + subIncr;
-            }
-          output->InsertNextCell(cell->GetCellType(),npts,pts);
-          }
+      // Decide whether this tensor will be glyphed:
+      // Threshold by trace ( must be > 0)
+      double trace = vtkDiffusionTensorMathematics::Trace(tensor);
+
+      // Only display this glyph if either:
+      // a) we are masking and the mask is 1 at this location.
+      // b) the trace is positive and we are not masking (default).
+      // (GetComponent is used instead of GetTuple1 because it is thread-safe.)
+      glyph.Visible = ( ( inMask != nullptr ) && inMask->GetComponent( ptId, 0 ) ) || ( !this->MaskGlyphs && trace > 0 );
+      if (!glyph.Visible)
+        {
+        continue;
         }
 
       // compute orientation vectors and scale factors from tensor
@@ -465,14 +603,14 @@ int vtkDiffusionTensorGlyph::RequestData(
 
       // Calculate output scalars before computing glyph scale factors from eigenvalues.
       // First, pass through input scalars if requested.
-      if ( inScalars && this->ColorGlyphs && ( this->ColorMode == vtkTensorGlyph::COLOR_BY_SCALARS ) )
+      if ( outputInputScalars )
         {
         // Copy point data from source
-        s = inScalars->GetComponent(inPtId, 0);
+        s = inScalars->GetComponent(ptId, 0);
         }
 
       // Output scalar invariants if requested
-      else if ( this->ColorGlyphs && ( this->ColorMode == vtkTensorGlyph::COLOR_BY_EIGENVALUES ) )
+      else if ( outputScalarInvariant )
         {
         // Correct for negative eigenvalues: use logic coded in vtkDiffusionTensorMathematics
         vtkDiffusionTensorMathematics::FixNegativeEigenvaluesMethod(w);
@@ -505,14 +643,19 @@ int vtkDiffusionTensorGlyph::RequestData(
             break;
           case vtkDiffusionTensorMathematics::VTK_TENS_COLOR_ORIENTATION:
             double v_maj[3];
-            v_maj[0]=v[0][0];
-            v_maj[1]=v[1][0];
-            v_maj[2]=v[2][0];
             if (this->TensorRotationMatrix)
               {
-              vtkNew<vtkTransform> rotate;
-              rotate->SetMatrix(this->TensorRotationMatrix);
-              rotate->TransformPoint(v_maj,v_maj);
+              vtkMath::Multiply3x3(rotation, xv, v_maj);
+              for (i=0; i<3; i++)
+                {
+                v_maj[i] += rotationTranslation[i];
+                }
+              }
+            else
+              {
+              v_maj[0] = xv[0];
+              v_maj[1] = xv[1];
+              v_maj[2] = xv[2];
               }
             // TO DO: here output as RGB. Need to allocate 3-component scalars first.
             s = 0;
@@ -532,6 +675,7 @@ int vtkDiffusionTensorGlyph::RequestData(
             break;
           }
         }
+      glyph.Scalar = s;
 
       // Use the square root of the eigenvalues for scaling
       // for DTI
@@ -585,149 +729,220 @@ int vtkDiffusionTensorGlyph::RequestData(
           {
           w[i] = maxScale * 1.0e-06;
           }
+        glyph.Scale[i] = w[i];
+        // normalized eigenvectors rotate object for eigen direction 0
+        glyph.Eigenvectors[i][0] = xv[i];
+        glyph.Eigenvectors[i][1] = yv[i];
+        glyph.Eigenvectors[i][2] = zv[i];
         }
 
-      // Now do the real work for each "direction"
-      // This is a loop over each eigenvector allowing
-      // a separate glyph for each (or two loops per eigenvector
-      // allowing two symmetric glyphs for each)
+      // translate Source to Input point
+      input->GetPoint(ptId, x);
 
-      int flipNormals = 0;
-      if ( this->TensorRotationMatrix && this->TensorRotationMatrix->Determinant() < 0 )
+      // If we have a user-specified matrix modifying the output point locations
+      if ( this->VolumePositionMatrix )
         {
-        flipNormals = 1;
+        double point[4] = {x[0], x[1], x[2], 1.0};
+        double transformedPoint[4];
+        vtkMatrix4x4::MultiplyPoint(volumePosition, point, transformedPoint);
+        x[0] = transformedPoint[0];
+        x[1] = transformedPoint[1];
+        x[2] = transformedPoint[2];
         }
+      glyph.Position[0] = x[0];
+      glyph.Position[1] = x[1];
+      glyph.Position[2] = x[2];
+      }
+    });
 
-      for (dir=0; dir < numDirs; dir++)
-        {
-        eigen_dir = dir%(this->ThreeGlyphs?3:1);
-        symmetric_dir = dir/(this->ThreeGlyphs?3:1);
-
-        // Remove previous scales ...
-        trans->Identity();
-
-        // Actually output the scalar invariant calculated above
-        if ( newScalars != nullptr )
-          {
-          for (i=0; i < numSourcePts; i++)
-            {
-            newScalars->InsertTuple(ptOffset+i, &s);
-            }
-          }
-        else
-          {
-          for (i=0; i < numSourcePts; i++)
-            {
-            // TO DO: why does superclass have this if no scalar output?
-            // in this case it appears copy scalars is on (above in
-            // scalar allocation section).
-            outPD->CopyData(pd,i,ptOffset+i);
-            }
-          }
+  this->UpdateProgress(0.5);
+  if (this->GetAbortExecute())
+    {
+    return 1;
+    }
 
-        // translate Source to Input point
-        input->GetPoint(inPtId, x);
+  // Keep only the glyphs that are displayed (mask is 1 OR trace is ok)
+  glyphs.erase(std::remove_if(glyphs.begin(), glyphs.end(),
+    [](const TensorGlyphParameters& glyph) { return !glyph.Visible; }), glyphs.end());
+  const vtkIdType numGlyphs = static_cast<vtkIdType>(glyphs.size());
 
-        // If we have a user-specified matrix modifying the output point locations
-        if ( userVolumeTransform != nullptr )
-          {
-          userVolumeTransform->TransformPoint(x,x2);
-          trans->Translate(x2[0], x2[1], x2[2]);
-          }
-        else
-          {
-          trans->Translate(x[0], x[1], x[2]);
-          }
+  // Get point data, decide how to allocate scalars
+  pd = source->GetPointData();
+  sourceNormals = pd->GetNormals();
 
-        // If we have a user-specified matrix rotating each tensor
-        if (this->TensorRotationMatrix)
-          {
-          trans->Concatenate(this->TensorRotationMatrix);
-          }
+  // generate scalars if eigenvalues are chosen or if scalars exist.
+  if (this->ColorGlyphs &&
+      ((this->ColorMode == COLOR_BY_EIGENVALUES) ||
+       (inScalars && (this->ColorMode == COLOR_BY_SCALARS)) ) )
+    {
+    newScalars = vtkFloatArray::New();
+    }
 
-        // normalized eigenvectors rotate object for eigen direction 0
-        matrix->Element[0][0] = xv[0];
-        matrix->Element[0][1] = yv[0];
-        matrix->Element[0][2] = zv[0];
-        matrix->Element[1][0] = xv[1];
-        matrix->Element[1][1] = yv[1];
-        matrix->Element[1][2] = zv[1];
-        matrix->Element[2][0] = xv[2];
-        matrix->Element[2][1] = yv[2];
-        matrix->Element[2][2] = zv[2];
-        trans->Concatenate(matrix);
-
-        if (eigen_dir == 1)
-          {
-          trans->RotateZ(90.0);
-          }
+  if (this->GlyphInstancing)
+    {
+    GenerateGlyphInstances(output, glyphs, numDirs, this->ThreeGlyphs, this->ScaleFactor,
+      rotation, rotationTranslation, newScalars);
+    }
+  else
+    {
+    //
+    // Allocate storage for output PolyData. The exact number of glyphs is known,
+    // therefore output arrays can be filled directly, without reallocation.
+    //
+    vtkPoints* sourcePts = source->GetPoints();
+    numSourcePts = sourcePts->GetNumberOfPoints();
+    const vtkIdType numOutputPts = numGlyphs * numDirs * numSourcePts;
+
+    // Source arrays are copied so that they are not accessed from multiple threads.
+    std::vector<double> sourcePoints(3 * numSourcePts);
+    std::vector<double> sourceNormalVectors(sourceNormals ? 3 * numSourcePts : 0);
+    for (vtkIdType i = 0; i < numSourcePts; i++)
+      {
+      sourcePts->GetPoint(i, &sourcePoints[3 * i]);
+      if (sourceNormals)
+        {
+        sourceNormals->GetTuple(i, &sourceNormalVectors[3 * i]);
+        }
+      }
 
-        if (eigen_dir == 2)
-          {
-          trans->RotateY(-90.0);
-          }
+    vtkNew<vtkPoints> newPts;
+    newPts->SetDataTypeToFloat();
+    newPts->SetNumberOfPoints(numOutputPts);
+    float* newPtsPtr = static_cast<float*>(newPts->GetVoidPointer(0));
+    float* newScalarsPtr = nullptr;
+    if (newScalars)
+      {
+      newScalars->SetNumberOfTuples(numOutputPts);
+      newScalarsPtr = newScalars->GetPointer(0);
+      }
+    else
+      {
+      // only copy scalar data through
+      // (superclass does this but why? if user has not asked for ColorGlyphs)
+      outPD->CopyAllOff();
+      outPD->CopyScalarsOn();
+      outPD->CopyAllocate(pd,numOutputPts);
+      }
+    float* newNormalsPtr = nullptr;
+    if ( sourceNormals )
+      {
+      newNormals = vtkFloatArray::New();
+      newNormals->SetNumberOfComponents(3);
+      newNormals->SetNumberOfTuples(numOutputPts);
+      newNormalsPtr = newNormals->GetPointer(0);
+      }
 
-        if (this->ThreeGlyphs)
-          {
-          trans->Scale(w[eigen_dir], this->ScaleFactor, this->ScaleFactor);
-          }
-        else
-          {
-          trans->Scale(w[0], w[1], w[2]);
-          }
+    // Setting up topology of output glyphs
+    if ( (source->GetVerts())->GetNumberOfCells() > 0 )
+      {
+      output->SetVerts(CreateGlyphCells(source->GetVerts(), numGlyphs, numDirs, numSourcePts));
+      }
+    if ( (source->GetLines())->GetNumberOfCells() > 0 )
+      {
+      output->SetLines(CreateGlyphCells(source->GetLines(), numGlyphs, numDirs, numSourcePts));
+      }
+    if ( (source->GetPolys())->GetNumberOfCells() > 0 )
+      {
+      output->SetPolys(CreateGlyphCells(source->GetPolys(), numGlyphs, numDirs, numSourcePts));
+      }
+    if ( (source->GetStrips())->GetNumberOfCells() > 0 )
+      {
+      output->SetStrips(CreateGlyphCells(source->GetStrips(), numGlyphs, numDirs, numSourcePts));
+      }
 
-        // Mirror second set to the symmetric position
-        if (symmetric_dir == 1)
-          {
-          trans->Scale(-1.,1.,1.);
-          }
+    //
+    // Transform glyph in this->Source by tensor for each glyphed point.
+    // Each glyph writes its own range of the output arrays.
+    //
+    const int threeGlyphs = this->ThreeGlyphs;
+    const double scaleFactor = this->ScaleFactor;
+    const double length = this->Length;
+    vtkSMPTools::For(0, numGlyphs, [&](vtkIdType beginGlyph, vtkIdType endGlyph)
+      {
+      double linear[3][3], translation[3], normalMatrix[3][3];
+      double outPoint[3], outNormal[3];
+      for (vtkIdType glyphIndex = beginGlyph; glyphIndex < endGlyph; ++glyphIndex)
+        {
+        const TensorGlyphParameters& glyph = glyphs[glyphIndex];
 
-        // if the eigenvalue is negative, shift to reverse direction.
-        // The && is there to ensure that we do not change the
-        // old behavior of vtkTensorGlyphs (which only used one dir),
-        // in case there is an oriented glyph, e.g. an arrow.
-        if (w[eigen_dir] < 0 && numDirs > 1)
+        // Now do the real work for each "direction"
+        // This is a loop over each eigenvector allowing
+        // a separate glyph for each (or two loops per eigenvector
+        // allowing two symmetric glyphs for each)
+        for (int dir = 0; dir < numDirs; dir++)
           {
-          trans->Translate(-this->Length, 0., 0.);
-          }
-
-        // multiply points (and normals if available) by resulting
-        // matrix.
-        // This also appends them to the output "new" data.
-        trans->TransformPoints(sourcePts,newPts);
+          const int eigen_dir = dir%(threeGlyphs?3:1);
+          const int symmetric_dir = dir/(threeGlyphs?3:1);
+
+          // if the eigenvalue is negative, shift to reverse direction.
+          // The && is there to ensure that we do not change the
+          // old behavior of vtkTensorGlyphs (which only used one dir),
+          // in case there is an oriented glyph, e.g. an arrow.
+          const double offset = (glyph.Scale[eigen_dir] < 0 && numDirs > 1) ? length : 0.0;
+          ComputeGlyphTransform(glyph, rotation, rotationTranslation, threeGlyphs, scaleFactor,
+            eigen_dir, symmetric_dir, offset, linear, translation);
+
+          // Keep track of the number of points output so far.
+          const vtkIdType ptOffset = (glyphIndex * numDirs + dir) * numSourcePts;
+
+          // multiply points (and normals if available) by resulting matrix.
+          for (vtkIdType ptIndex = 0; ptIndex < numSourcePts; ptIndex++)
+            {
+            vtkMath::Multiply3x3(linear, &sourcePoints[3 * ptIndex], outPoint);
+            float* newPt = newPtsPtr + 3 * (ptOffset + ptIndex);
+            newPt[0] = static_cast<float>(outPoint[0] + translation[0]);
+            newPt[1] = static_cast<float>(outPoint[1] + translation[1]);
+            newPt[2] = static_cast<float>(outPoint[2] + translation[2]);
+            }
 
-        // Apply the transformation to a series of points,
-        // and append the results to outPts.
-        if ( newNormals )
-          {
-          if ( flipNormals )
+          // Actually output the scalar invariant calculated above
+          if ( newScalarsPtr )
             {
-            trans->Scale(-1.,-1.,-1.);
-            trans->TransformNormals(sourceNormals,newNormals);
-            trans->Scale(-1.,-1.,-1.);
+            std::fill(newScalarsPtr + ptOffset, newScalarsPtr + ptOffset + numSourcePts,
+              static_cast<float>(glyph.Scalar));
             }
-          else
+
+          // Normals are transformed by the inverse transpose, same as vtkLinearTransform::TransformNormals.
+          if ( newNormalsPtr )
             {
-            trans->TransformNormals(sourceNormals,newNormals);
+            vtkMath::Invert3x3(linear, normalMatrix);
+            vtkMath::Transpose3x3(normalMatrix, normalMatrix);
+            for (vtkIdType ptIndex = 0; ptIndex < numSourcePts; ptIndex++)
+              {
+              vtkMath::Multiply3x3(normalMatrix, &sourceNormalVectors[3 * ptIndex], outNormal);
+              vtkMath::Normalize(outNormal);
+              float* newNormal = newNormalsPtr + 3 * (ptOffset + ptIndex);
+              newNormal[0] = static_cast<float>(flipNormals ? -outNormal[0] : outNormal[0]);
+              newNormal[1] = static_cast<float>(flipNormals ? -outNormal[1] : outNormal[1]);
+              newNormal[2] = static_cast<float>(flipNormals ? -outNormal[2] : outNormal[2]);
+              }
             }
+          } // end for number of dirs
+        }
+      });
+
+    if ( !newScalars )
+      {
+      for (vtkIdType ptOffset = 0; ptOffset < numOutputPts; ptOffset += numSourcePts)
+        {
+        for (vtkIdType i=0; i < numSourcePts; i++)
+          {
+          // TO DO: why does superclass have this if no scalar output?
+          // in this case it appears copy scalars is on (above in
+          // scalar allocation section).
+          outPD->CopyData(pd,i,ptOffset+i);
           }
+        }
+      }
 
-        // Keep track of the number of points output so far.
-        ptOffset += numSourcePts;
-        } // end for number of dirs
-      } // end if mask is 1 OR trace is ok (so tensor was glyphed)
-    } // end loop over input points
+    output->SetPoints(newPts);
+    }
 
-  vtkDebugMacro(<<"Generated " << numInputPts <<" tensor glyphs");
+  vtkDebugMacro(<<"Generated " << numGlyphs <<" tensor glyphs");
 
   //
   // Update output and release memory
   //
-  delete [] pts;
-
-  output->SetPoints(newPts);
-  newPts->Delete();
-
   if ( newScalars )
     {
     int idx = outPD->AddArray(newScalars);
@@ -742,13 +957,6 @@ int vtkDiffusionTensorGlyph::RequestData(
     }
 
   output->Squeeze();
-  trans->Delete();
-  matrix->Delete();
-
-  if ( userVolumeTransform )
-    {
-    userVolumeTransform->Delete();
-    }
 
   vtkDebugMacro("glyph time: " << clock() - tStart );
 
@@ -762,6 +970,7 @@ void vtkDiffusionTensorGlyph::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Color Glyphs by Scalar Invariant: " << this->ScalarInvariant << "\n";
   os << indent << "Mask Glyphs: " << (this->MaskGlyphs ? "On\n" : "Off\n");
   os << indent << "Resolution: " << this->Resolution << endl;
+  os << indent << "Glyph Instancing: " << (this->GlyphInstancing ? "On\n" : "Off\n");
 
   // print objects
   if ( this->VolumePositionMatrix )
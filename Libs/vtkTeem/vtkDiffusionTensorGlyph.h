@@ -161,6 +161,30 @@ public:
   vtkGetVector2Macro(DimensionResolution, int);
   vtkSetVector2Macro(DimensionResolution, int);
 
+  ///
+  /// If GlyphInstancing is 1 (On), glyph geometry is not generated. Instead, the output
+  /// contains one point per glyph, with the glyph orientation (quaternion, in the
+  /// GetGlyphOrientationArrayName() array), the glyph scale along its axes (in the
+  /// GetGlyphScaleArrayName() array) and the scalars. This output is meant to be rendered
+  /// by vtkGlyph3DMapper, which transforms the glyph source on the GPU:
+  /// \code
+  /// mapper->SetSourceConnection(glyphSource->GetOutputPort());
+  /// mapper->SetInputConnection(tensorGlyph->GetOutputPort());
+  /// mapper->SetOrientationModeToQuaternion();
+  /// mapper->SetOrientationArray(vtkDiffusionTensorGlyph::GetGlyphOrientationArrayName());
+  /// mapper->SetScaleModeToScaleByVectorComponents();
+  /// mapper->SetScaleArray(vtkDiffusionTensorGlyph::GetGlyphScaleArrayName());
+  /// \endcode
+  /// Symmetric glyphs of negative eigenvalues are not shifted by Length in this mode.
+  /// Default is 0 (Off).
+  vtkBooleanMacro(GlyphInstancing, int);
+  vtkSetMacro(GlyphInstancing, int);
+  vtkGetMacro(GlyphInstancing, int);
+
+  /// Name of the output point data arrays in GlyphInstancing mode.
+  static const char* GetGlyphOrientationArrayName() { return "GlyphOrientation"; }
+  static const char* GetGlyphScaleArrayName() { return "GlyphScale"; }
+
   ///
   /// When determining the modified time of the filter,
   /// this checks the modified time of the mask input,
@@ -181,6 +205,8 @@ protected:
 
   int DimensionResolution[2];
 
+  int GlyphInstancing; /// output glyph parameters instead of glyph geometry
+
   vtkMatrix4x4 *VolumePositionMatrix;
   vtkMatrix4x4 *TensorRotationMatrix;
 
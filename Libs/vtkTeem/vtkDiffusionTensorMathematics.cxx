@@ -25,6 +25,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkDiffusionTensorMathematics.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkObjectFactory.h"
 #include "vtkTransform.h"
 #include "vtkPointData.h"
@@ -36,8 +37,10 @@ extern "C" {
 #include "teem/ten.h"
 }
 
+#include <algorithm>
 #include <ctime>
 #include <limits>
+#include <vector>
 
 #define VTK_EPS 1e-16
 #define MAX(a,b) (((a)>(b))?(a):(b))
@@ -105,22 +108,125 @@ int vtkDiffusionTensorMathematics::RequestInformation (
     ext[3] << " " << ext[4] << " " << ext[5]);
 
 
-  // We always want to output float, unless it is color
-  if (this->Operation == VTK_TENS_COLOR_ORIENTATION)
+  // One output port for each operation
+  for (int port = 0; port < this->GetNumberOfOutputPorts(); ++port)
     {
-    // output color (RGBA)
-    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_UNSIGNED_CHAR, 4);
+    outInfo = outputVector->GetInformationObject(port);
+    // We always want to output float, unless it is color
+    if (vtkDiffusionTensorMathematics::IsColorOperation(this->GetNthOperation(port)))
+      {
+      // output color (RGBA)
+      vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_UNSIGNED_CHAR, 4);
+      }
+    else {
+      vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_FLOAT, 1);
+      }
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext, 6);
     }
-  else if (this->Operation == VTK_TENS_COLOR_MODE)
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkDiffusionTensorMathematics::SetNumberOfOperations(int numberOfOperations)
+{
+  numberOfOperations = std::max(numberOfOperations, 1);
+  if (numberOfOperations == this->GetNumberOfOperations())
     {
-    // output color (RGBA)
-    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_UNSIGNED_CHAR, 4);
+    return;
     }
-  else {
-    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_FLOAT, 1);
+  this->AdditionalOperations.resize(numberOfOperations - 1, VTK_TENS_TRACE);
+  this->SetNumberOfOutputPorts(numberOfOperations);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkDiffusionTensorMathematics::GetNumberOfOperations()
+{
+  return static_cast<int>(this->AdditionalOperations.size()) + 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkDiffusionTensorMathematics::SetNthOperation(int n, int operation)
+{
+  if (n == 0)
+    {
+    this->SetOperation(operation);
+    return;
     }
-  outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext, 6);
-  return 1;
+  if (n < 0 || n >= this->GetNumberOfOperations())
+    {
+    vtkErrorMacro("SetNthOperation: invalid operation index " << n);
+    return;
+    }
+  operation = std::min(std::max(operation, static_cast<int>(VTK_TENS_TRACE)), static_cast<int>(VTK_TENS_MEAN_DIFFUSIVITY));
+  if (this->AdditionalOperations[n - 1] == operation)
+    {
+    return;
+    }
+  this->AdditionalOperations[n - 1] = operation;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkDiffusionTensorMathematics::GetNthOperation(int n)
+{
+  if (n == 0)
+    {
+    return this->Operation;
+    }
+  if (n < 0 || n >= this->GetNumberOfOperations())
+    {
+    vtkErrorMacro("GetNthOperation: invalid operation index " << n);
+    return -1;
+    }
+  return this->AdditionalOperations[n - 1];
+}
+
+//----------------------------------------------------------------------------
+bool vtkDiffusionTensorMathematics::OperationRequiresEigenvalues(int operation)
+{
+  switch (operation)
+    {
+    case VTK_TENS_D11:
+    case VTK_TENS_D22:
+    case VTK_TENS_D33:
+    case VTK_TENS_TRACE:
+    case VTK_TENS_DETERMINANT:
+      return false;
+    default:
+      return true;
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkDiffusionTensorMathematics::OperationRequiresEigenvectors(int operation)
+{
+  switch (operation)
+    {
+    case VTK_TENS_MAX_EIGENVALUE_PROJX:
+    case VTK_TENS_MAX_EIGENVALUE_PROJY:
+    case VTK_TENS_MAX_EIGENVALUE_PROJZ:
+    case VTK_TENS_RAI_MAX_EIGENVEC_PROJX:
+    case VTK_TENS_RAI_MAX_EIGENVEC_PROJY:
+    case VTK_TENS_RAI_MAX_EIGENVEC_PROJZ:
+    case VTK_TENS_MAX_EIGENVEC_PROJX:
+    case VTK_TENS_MAX_EIGENVEC_PROJY:
+    case VTK_TENS_MAX_EIGENVEC_PROJZ:
+    case VTK_TENS_COLOR_ORIENTATION:
+    case VTK_TENS_COLOR_ORIENTATION_MIDDLE_EIGENVECTOR:
+    case VTK_TENS_COLOR_ORIENTATION_MIN_EIGENVECTOR:
+      return true;
+    default:
+      return false;
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkDiffusionTensorMathematics::IsColorOperation(int operation)
+{
+  return operation == VTK_TENS_COLOR_ORIENTATION || operation == VTK_TENS_COLOR_MODE
+    || operation == VTK_TENS_COLOR_ORIENTATION_MIDDLE_EIGENVECTOR
+    || operation == VTK_TENS_COLOR_ORIENTATION_MIN_EIGENVECTOR;
 }
 
 
@@ -450,6 +556,8 @@ static void vtkDiffusionTensorMathematicsExecute1Eigen(vtkDiffusionTensorMathema
 
   // decide whether to extract eigenfunctions or just use input cols
   extractEigenvalues = self->GetExtractEigenvalues();
+  // eigenvalues are faster to compute when eigenvectors are not needed
+  double** eigenvectors = vtkDiffusionTensorMathematics::OperationRequiresEigenvectors(op) ? v : nullptr;
 
   // transformation of tensor orientations for coloring
   vtkTransform *trans = vtkTransform::New();
@@ -499,8 +607,7 @@ static void vtkDiffusionTensorMathematicsExecute1Eigen(vtkDiffusionTensorMathema
           {
           *outPtr = 0;
 
-          if (op ==  vtkDiffusionTensorMathematics::VTK_TENS_COLOR_MODE ||
-            op ==  vtkDiffusionTensorMathematics::VTK_TENS_COLOR_ORIENTATION) {
+          if (vtkDiffusionTensorMathematics::IsColorOperation(op)) {
             outPtr++;
             *outPtr = 0; // green
             outPtr++;
@@ -535,7 +642,7 @@ static void vtkDiffusionTensorMathematicsExecute1Eigen(vtkDiffusionTensorMathema
               }
             // compute eigensystem
             //vtkMath::Jacobi(m, w, v);
-            vtkDiffusionTensorMathematics::TeemEigenSolver(m,w,v);
+            vtkDiffusionTensorMathematics::TeemEigenSolver(m,w,eigenvectors);
             }
           else
             {
@@ -771,8 +878,7 @@ static void vtkDiffusionTensorMathematicsExecute1Eigen(vtkDiffusionTensorMathema
             }
 
           // scale double if the user requested this
-          if (scaleFactor != 1 && op !=  vtkDiffusionTensorMathematics::VTK_TENS_COLOR_ORIENTATION
-            && op !=  vtkDiffusionTensorMathematics::VTK_TENS_COLOR_MODE)
+          if (scaleFactor != 1 && !vtkDiffusionTensorMathematics::IsColorOperation(op))
             {
             *outPtr = (T) ((*outPtr) * scaleFactor);
             }
@@ -801,6 +907,350 @@ static void vtkDiffusionTensorMathematicsExecute1Eigen(vtkDiffusionTensorMathema
 #endif
 }
 
+//----------------------------------------------------------------------------
+// Compute an operation that outputs a scalar, from the tensor and
+// from its eigensystem (eigenvalues w, eigenvectors as columns of v).
+static double vtkDiffusionTensorMathematicsComputeScalar(int op, double tensor[3][3],
+                                                         double w[3], double **v)
+{
+  switch (op)
+    {
+    case vtkDiffusionTensorMathematics::VTK_TENS_D11:
+      return tensor[0][0];
+    case vtkDiffusionTensorMathematics::VTK_TENS_D22:
+      return tensor[1][1];
+    case vtkDiffusionTensorMathematics::VTK_TENS_D33:
+      return tensor[2][2];
+    case vtkDiffusionTensorMathematics::VTK_TENS_TRACE:
+      return vtkDiffusionTensorMathematics::Trace(tensor);
+    case vtkDiffusionTensorMathematics::VTK_TENS_DETERMINANT:
+      return vtkDiffusionTensorMathematics::Determinant(tensor);
+    case vtkDiffusionTensorMathematics::VTK_TENS_RELATIVE_ANISOTROPY:
+      return vtkDiffusionTensorMathematics::RelativeAnisotropy(w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_FRACTIONAL_ANISOTROPY:
+      return vtkDiffusionTensorMathematics::FractionalAnisotropy(w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_LINEAR_MEASURE:
+      return vtkDiffusionTensorMathematics::LinearMeasure(w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_PLANAR_MEASURE:
+      return vtkDiffusionTensorMathematics::PlanarMeasure(w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_SPHERICAL_MEASURE:
+      return vtkDiffusionTensorMathematics::SphericalMeasure(w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_MAX_EIGENVALUE:
+      return w[0];
+    case vtkDiffusionTensorMathematics::VTK_TENS_MID_EIGENVALUE:
+      return w[1];
+    case vtkDiffusionTensorMathematics::VTK_TENS_MIN_EIGENVALUE:
+      return w[2];
+    case vtkDiffusionTensorMathematics::VTK_TENS_PARALLEL_DIFFUSIVITY:
+      return vtkDiffusionTensorMathematics::ParallelDiffusivity(w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_PERPENDICULAR_DIFFUSIVITY:
+      return vtkDiffusionTensorMathematics::PerpendicularDiffusivity(w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_MEAN_DIFFUSIVITY:
+      return vtkDiffusionTensorMathematics::MeanDiffusivity(w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_MAX_EIGENVALUE_PROJX:
+      return vtkDiffusionTensorMathematics::MaxEigenvalueProjectionX(v,w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_MAX_EIGENVALUE_PROJY:
+      return vtkDiffusionTensorMathematics::MaxEigenvalueProjectionY(v,w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_MAX_EIGENVALUE_PROJZ:
+      return vtkDiffusionTensorMathematics::MaxEigenvalueProjectionZ(v,w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_RAI_MAX_EIGENVEC_PROJX:
+      return vtkDiffusionTensorMathematics::RAIMaxEigenvecX(v,w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_RAI_MAX_EIGENVEC_PROJY:
+      return vtkDiffusionTensorMathematics::RAIMaxEigenvecY(v,w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_RAI_MAX_EIGENVEC_PROJZ:
+      return vtkDiffusionTensorMathematics::RAIMaxEigenvecZ(v,w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_MAX_EIGENVEC_PROJX:
+      return vtkDiffusionTensorMathematics::MaxEigenvecX(v,w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_MAX_EIGENVEC_PROJY:
+      return vtkDiffusionTensorMathematics::MaxEigenvecY(v,w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_MAX_EIGENVEC_PROJZ:
+      return vtkDiffusionTensorMathematics::MaxEigenvecZ(v,w);
+    case vtkDiffusionTensorMathematics::VTK_TENS_MODE:
+      return vtkDiffusionTensorMathematics::Mode(w);
+    default:
+      return 0.;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Executes all the operations of the filter in a single pass, computing the
+// eigensystem of each tensor only once. The result of operation n is written
+// to outData[n], which is float or unsigned char RGBA (for color operations),
+// see RequestInformation.
+static void vtkDiffusionTensorMathematicsExecuteMultiple(vtkDiffusionTensorMathematics *self,
+                          vtkImageData *in1Data,
+                          vtkImageData **outData,
+                          int outExt[6], int id)
+{
+  // image variables
+  int idxR, idxY, idxZ;
+  int maxY, maxZ;
+  vtkIdType inIncX, inIncY, inIncZ;
+  int rowLength;
+  // progress
+  unsigned long count = 0;
+  unsigned long target;
+  // tensor variables
+  vtkDataArray *inTensors;
+  double tensor[3][3];
+  // working matrices
+  double *m[3], w[3] = {0., 0., 0.}, *v[3];
+  double m0[3], m1[3], m2[3];
+  double v0[3] = {0., 0., 0.}, v1[3] = {0., 0., 0.}, v2[3] = {0., 0., 0.};
+  m[0] = m0; m[1] = m1; m[2] = m2;
+  v[0] = v0; v[1] = v1; v[2] = v2;
+  int i, j;
+  double r, g, b;
+  // scaling
+  double scaleFactor = self->GetScaleFactor();
+
+  // map 0..1 values into the range a char takes on
+  // but use scaleFactor so user can bump up the brightness
+  const double rgb_scale = (double)VTK_UNSIGNED_CHAR_MAX * scaleFactor / 1000.;
+
+  // find the input region to loop over
+  inTensors = in1Data->GetPointData()->GetTensors();
+  if ( !inTensors || in1Data->GetNumberOfPoints() < 1 )
+    {
+    vtkGenericWarningMacro(<<"No input tensor data to filter!");
+    return;
+    }
+  if (self->GetScalarMask() && self->GetScalarMask()->GetScalarType() != VTK_SHORT)
+    {
+    vtkGenericWarningMacro(<<"scalr type for mask must be short!");
+    return;
+    }
+
+  // Operations and output pointers
+  const int numberOfOperations = self->GetNumberOfOperations();
+  std::vector<int> operations(numberOfOperations);
+  std::vector<bool> colorOperations(numberOfOperations);
+  std::vector<float*> outFloatPtrs(numberOfOperations, nullptr);
+  std::vector<unsigned char*> outColorPtrs(numberOfOperations, nullptr);
+  std::vector<vtkIdType> outIncYs(numberOfOperations);
+  std::vector<vtkIdType> outIncZs(numberOfOperations);
+  bool requiresEigenvalues = false;
+  bool requiresEigenvectors = false;
+  for (int n = 0; n < numberOfOperations; ++n)
+    {
+    operations[n] = self->GetNthOperation(n);
+    colorOperations[n] = vtkDiffusionTensorMathematics::IsColorOperation(operations[n]);
+    requiresEigenvalues |= vtkDiffusionTensorMathematics::OperationRequiresEigenvalues(operations[n]);
+    requiresEigenvectors |= vtkDiffusionTensorMathematics::OperationRequiresEigenvectors(operations[n]);
+    vtkIdType outIncX;
+    outData[n]->GetContinuousIncrements(outExt, outIncX, outIncYs[n], outIncZs[n]);
+    if (colorOperations[n])
+      {
+      outColorPtrs[n] = static_cast<unsigned char*>(outData[n]->GetScalarPointerForExtent(outExt));
+      }
+    else
+      {
+      outFloatPtrs[n] = static_cast<float*>(outData[n]->GetScalarPointerForExtent(outExt));
+      }
+    }
+
+  // find the output region to loop over
+  rowLength = (outExt[1] - outExt[0]+1);
+  maxY = outExt[3] - outExt[2];
+  maxZ = outExt[5] - outExt[4];
+  target = (unsigned long)((maxZ+1)*(maxY+1)/50.0);
+  target++;
+
+  // Call special version of GetContinuousIncrements that works for Tensors
+  GetContinuousIncrements(in1Data, outExt, inIncX, inIncY, inIncZ);
+  float* inPtr = reinterpret_cast<float*>(in1Data->GetArrayPointerForExtent(inTensors, outExt));
+
+  // decide whether to extract eigenfunctions or just use input cols
+  int extractEigenvalues = self->GetExtractEigenvalues();
+  double** eigenvectors = requiresEigenvectors ? v : nullptr;
+
+  // rotation of tensor orientations for coloring (see TensorRotationMatrix)
+  double rotation[16];
+  vtkMatrix4x4* rotationMatrix = self->GetTensorRotationMatrix();
+  if (rotationMatrix)
+    {
+    vtkMatrix4x4::DeepCopy(rotation, rotationMatrix);
+    }
+
+  // Check for masking
+  bool doMasking = false;
+  short * inMaskPtr = nullptr;
+  vtkIdType maskIncX = 0;
+  vtkIdType maskIncY = 0;
+  vtkIdType maskIncZ = 0;
+  if (self->GetMaskWithScalars() && self->GetScalarMask())
+    {
+    self->GetScalarMask()->GetContinuousIncrements(outExt, maskIncX, maskIncY, maskIncZ);
+    inMaskPtr = reinterpret_cast<short *>(self->GetScalarMask()->GetScalarPointerForExtent(outExt));
+    doMasking = self->GetScalarMask()->GetPointData()->GetScalars() != nullptr;
+    }
+  const int maskLabelValue = self->GetMaskLabelValue();
+  const int fixNegativeEigenvalues = self->GetFixNegativeEigenvalues();
+
+  for (idxZ = 0; idxZ <= maxZ; idxZ++)
+    {
+    for (idxY = 0; idxY <= maxY; idxY++)
+      {
+      if (!id)
+        {
+        if (!(count%target))
+          {
+          self->UpdateProgress(count/(50.0*target));
+          }
+        count++;
+        }
+
+      for (idxR = 0; idxR < rowLength; idxR++)
+        {
+        bool masked = doMasking && *inMaskPtr != maskLabelValue;
+        if (!masked)
+          {
+          // tensor at this voxel
+          for (i=0; i<3; i++)
+            {
+            for (j=0; j<3; j++)
+              {
+              tensor[i][j] = static_cast<double>(inPtr[3*i+j]);
+              }
+            }
+
+          // get eigenvalues and eigenvectors appropriately
+          if (requiresEigenvalues && extractEigenvalues)
+            {
+            for (j=0; j<3; j++)
+              {
+              for (i=0; i<3; i++)
+                {
+                // transpose
+                m[i][j] = tensor[j][i];
+                }
+              }
+            vtkDiffusionTensorMathematics::TeemEigenSolver(m,w,eigenvectors);
+            }
+          else if (requiresEigenvalues)
+            {
+            // tensor columns are evectors scaled by evals
+            for (i=0; i<3; i++)
+              {
+              v0[i] = tensor[i][0];
+              v1[i] = tensor[i][1];
+              v2[i] = tensor[i][2];
+              }
+            w[0] = vtkMath::Normalize(v0);
+            w[1] = vtkMath::Normalize(v1);
+            w[2] = vtkMath::Normalize(v2);
+            }
+
+          // Correct for negative eigenvalues, same as in vtkDiffusionTensorMathematicsExecute1Eigen
+          if (requiresEigenvalues && fixNegativeEigenvalues==1)
+            {
+            const double min_eval = MIN3(w[0], w[1], w[2]);
+            if (min_eval < 0)
+              {
+              const double add_to_eval = -min_eval + VTK_EPS;
+              w[0] += add_to_eval;
+              w[1] += add_to_eval;
+              w[2] += add_to_eval;
+              }
+            if ((w[0] < 0) || (w[1] < 0) || (w[2] < 0))
+              {
+              vtkGenericWarningMacro( "Warning: Negative Eigenvalues after positivity fix" );
+              }
+            }
+          else if (requiresEigenvalues)
+            {
+            for (i=0; i<3; i++)
+              {
+              w[i] = MAX(w[i], 0.);
+              }
+            }
+          }
+
+        for (int n = 0; n < numberOfOperations; ++n)
+          {
+          if (!colorOperations[n])
+            {
+            *outFloatPtrs[n]++ = masked ? 0.f :
+              static_cast<float>(scaleFactor * vtkDiffusionTensorMathematicsComputeScalar(operations[n], tensor, w, v));
+            continue;
+            }
+          unsigned char* outColorPtr = outColorPtrs[n];
+          outColorPtrs[n] += 4;
+          outColorPtr[3] = VTK_UNSIGNED_CHAR_MAX; // alpha
+          if (masked)
+            {
+            outColorPtr[0] = outColorPtr[1] = outColorPtr[2] = 0;
+            continue;
+            }
+          if (operations[n] == vtkDiffusionTensorMathematics::VTK_TENS_COLOR_MODE)
+            {
+            vtkDiffusionTensorMathematics::ColorByMode(w,r,g,b);
+            }
+          else
+            {
+            // Color R, G, B depending on max (or middle, min) eigenvector,
+            // rotated into RAS space for consistent anatomical coloring
+            int eigenvectorIndex = 0;
+            if (operations[n] == vtkDiffusionTensorMathematics::VTK_TENS_COLOR_ORIENTATION_MIDDLE_EIGENVECTOR)
+              {
+              eigenvectorIndex = 1;
+              }
+            else if (operations[n] == vtkDiffusionTensorMathematics::VTK_TENS_COLOR_ORIENTATION_MIN_EIGENVECTOR)
+              {
+              eigenvectorIndex = 2;
+              }
+            double v_maj[4] = {v[0][eigenvectorIndex], v[1][eigenvectorIndex], v[2][eigenvectorIndex], 1.};
+            if (rotationMatrix)
+              {
+              vtkMatrix4x4::MultiplyPoint(rotation, v_maj, v_maj);
+              }
+            double cl = vtkDiffusionTensorMathematics::LinearMeasure(w);
+            r = fabs(v_maj[0])*cl;
+            g = fabs(v_maj[1])*cl;
+            b = fabs(v_maj[2])*cl;
+            }
+          // scale maps 0..1 values into the range a char takes on
+          outColorPtr[0] = static_cast<unsigned char>(
+            tensor_math_clamp(rgb_scale*r, (double)VTK_UNSIGNED_CHAR_MIN, (double)VTK_UNSIGNED_CHAR_MAX));
+          outColorPtr[1] = static_cast<unsigned char>(
+            tensor_math_clamp(rgb_scale*g, (double)VTK_UNSIGNED_CHAR_MIN, (double)VTK_UNSIGNED_CHAR_MAX));
+          outColorPtr[2] = static_cast<unsigned char>(
+            tensor_math_clamp(rgb_scale*b, (double)VTK_UNSIGNED_CHAR_MIN, (double)VTK_UNSIGNED_CHAR_MAX));
+          }
+
+        inPtr+=9;
+        inMaskPtr++;
+        }
+      for (int n = 0; n < numberOfOperations; ++n)
+        {
+        if (colorOperations[n])
+          {
+          outColorPtrs[n] += outIncYs[n];
+          }
+        else
+          {
+          outFloatPtrs[n] += outIncYs[n];
+          }
+        }
+      inPtr += inIncY;
+      inMaskPtr += maskIncY;
+      }
+    for (int n = 0; n < numberOfOperations; ++n)
+      {
+      if (colorOperations[n])
+        {
+        outColorPtrs[n] += outIncZs[n];
+        }
+      else
+        {
+        outFloatPtrs[n] += outIncZs[n];
+        }
+      }
+    inPtr += inIncZ;
+    inMaskPtr += maskIncZ;
+    }
+}
+
 //----------------------------------------------------------------------------
 // This method computes the increments from the MemoryOrder and the extent.
 void vtkDiffusionTensorMathematics::ComputeTensorIncrements(vtkImageData *imageData, vtkIdType incr[3])
@@ -853,6 +1303,12 @@ void vtkDiffusionTensorMathematics::ThreadedRequestData(
   // single input only for now
   vtkDebugMacro ("In Threaded Execute. scalar type is " << inData[0][0]->GetScalarType() << "op is: " << this->Operation);
 
+  if (this->GetNumberOfOperations() > 1)
+    {
+    vtkDiffusionTensorMathematicsExecuteMultiple(this, inData[0][0], outData, outExt, id);
+    return;
+    }
+
   switch (this->GetOperation())
     {
 
@@ -893,6 +1349,8 @@ void vtkDiffusionTensorMathematics::ThreadedRequestData(
     case VTK_TENS_RAI_MAX_EIGENVEC_PROJY:
     case VTK_TENS_RAI_MAX_EIGENVEC_PROJZ:
     case VTK_TENS_COLOR_ORIENTATION:
+    case VTK_TENS_COLOR_ORIENTATION_MIDDLE_EIGENVECTOR:
+    case VTK_TENS_COLOR_ORIENTATION_MIN_EIGENVECTOR:
     case VTK_TENS_MODE:
     case VTK_TENS_COLOR_MODE:
     case VTK_TENS_PARALLEL_DIFFUSIVITY:
@@ -1152,6 +1610,11 @@ void vtkDiffusionTensorMathematics::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "Operation: " << this->Operation << "\n";
+  os << indent << "NumberOfOperations: " << this->GetNumberOfOperations() << "\n";
+  for (size_t n = 0; n < this->AdditionalOperations.size(); ++n)
+    {
+    os << indent << "Operation " << n + 1 << ": " << this->AdditionalOperations[n] << "\n";
+    }
 }
 
 // Colormap: convert our mode value (-1..1) to RGB
@@ -32,6 +32,9 @@
 // VTK includes
 #include <vtkThreadedImageAlgorithm.h>
 
+// STD includes
+#include <vector>
+
 class vtkMatrix4x4;
 class vtkImageData;
 class VTK_Teem_EXPORT vtkDiffusionTensorMathematics : public vtkThreadedImageAlgorithm
@@ -80,6 +83,20 @@ public:
   vtkGetMacro(Operation,int);
   vtkSetClampMacro(Operation,int, VTK_TENS_TRACE, VTK_TENS_MEAN_DIFFUSIVITY);
 
+  ///
+  /// Number of operations computed by the filter. The result of operation n is
+  /// written to output port n. Operation 0 is the one set by SetOperation().
+  /// All operations are computed in a single pass, decomposing each tensor only once,
+  /// which is faster than executing one filter per operation.
+  /// Default is 1.
+  void SetNumberOfOperations(int numberOfOperations);
+  int GetNumberOfOperations();
+
+  ///
+  /// Set/Get the operation of output port n.
+  void SetNthOperation(int n, int operation);
+  int GetNthOperation(int n);
+
   ///
   /// Output the trace (sum of eigenvalues = sum along diagonal)
   void SetOperationToTrace()
@@ -236,6 +253,16 @@ public:
   static void RGBToIndex(double R, double G,
                   double B, double &index);
 
+  ///
+  /// Return true if the operation is computed from the eigenvalues (and eigenvectors)
+  /// of the tensor or only from the eigenvalues.
+  static bool OperationRequiresEigenvalues(int operation);
+  static bool OperationRequiresEigenvectors(int operation);
+
+  ///
+  /// Return true if the output of the operation is RGBA color. Otherwise it is a float scalar.
+  static bool IsColorOperation(int operation);
+
   ///
   /// Helper functions to perform operations pixel-wise
   static int FixNegativeEigenvaluesMethod(double w[3]);
@@ -275,6 +302,7 @@ protected:
   ~vtkDiffusionTensorMathematics() override;
 
   int Operation; /// math operation to perform
+  std::vector<int> AdditionalOperations; /// operations of output ports 1 and above
   double ScaleFactor; /// Scale factor for output scalars
   int ExtractEigenvalues; /// Boolean controls eigenfunction extraction
 
@@ -19,6 +19,9 @@
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+// STD includes
+#include <vector>
+
 
 vtkStandardNewMacro(vtkImageLabelCombine);
 
@@ -39,29 +42,33 @@ int vtkImageLabelCombine::RequestInformation (
   // get the info objects
   vtkInformation *outInfo = outputVector->GetInformationObject(0);
   vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
-  vtkInformation *inInfo2 = inputVector[1]->GetInformationObject(0);
 
   int ext[6], ext2[6], idx;
 
   inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext);
 
-  // two input take intersection
-  if (!inInfo2)
+  // two or more inputs, take intersection
+  int numberOfInputs2 = inputVector[1]->GetNumberOfInformationObjects();
+  if (numberOfInputs2 < 1)
     {
     vtkErrorMacro(<< "Second input must be specified for this operation.");
     return 1;
     }
 
-  inInfo2->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext2);
-  for (idx = 0; idx < 3; ++idx)
+  for (int inputIndex = 0; inputIndex < numberOfInputs2; ++inputIndex)
     {
-    if (ext2[idx*2] > ext[idx*2])
-      {
-      ext[idx*2] = ext2[idx*2];
-      }
-    if (ext2[idx*2+1] < ext[idx*2+1])
+    vtkInformation *inInfo2 = inputVector[1]->GetInformationObject(inputIndex);
+    inInfo2->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext2);
+    for (idx = 0; idx < 3; ++idx)
       {
-      ext[idx*2+1] = ext2[idx*2+1];
+      if (ext2[idx*2] > ext[idx*2])
+        {
+        ext[idx*2] = ext2[idx*2];
+        }
+      if (ext2[idx*2+1] < ext[idx*2+1])
+        {
+        ext[idx*2+1] = ext2[idx*2+1];
+        }
       }
     }
 
@@ -73,44 +80,33 @@ int vtkImageLabelCombine::RequestInformation (
 
 //----------------------------------------------------------------------------
 // This templated function executes the filter for any type of data.
-// Handles the two input operations
+// Inputs are sorted by decreasing precedence. Rows are processed from the
+// lowest to the highest precedence input, with a branch-free selection
+// in the inner loop so that the compiler can vectorize it.
 template <class T>
-void vtkImageLabelCombineExecute2(vtkImageLabelCombine *self,
-                                 vtkImageData *in1Data, T *in1Ptr,
-                                 vtkImageData *in2Data, T *in2Ptr,
-                                 vtkImageData *outData, T *outPtr,
+void vtkImageLabelCombineExecute(vtkImageLabelCombine *self,
+                                 const std::vector<vtkImageData*>& inputs,
+                                 vtkImageData *outData,
                                  int outExt[6], int id)
 {
-  int idxR, idxY, idxZ;
-  int maxY, maxZ;
-  vtkIdType inIncX, inIncY, inIncZ;
-  vtkIdType in2IncX, in2IncY, in2IncZ;
-  vtkIdType outIncX, outIncY, outIncZ;
-  int rowLength;
   unsigned long count = 0;
   unsigned long target;
-  int op = self->GetOverwriteInput();
 
   // find the region to loop over
-  rowLength = (outExt[1] - outExt[0]+1)*in1Data->GetNumberOfScalarComponents();
+  const int rowLength = (outExt[1] - outExt[0]+1)*outData->GetNumberOfScalarComponents();
 
-  maxY = outExt[3] - outExt[2];
-  maxZ = outExt[5] - outExt[4];
+  const int maxY = outExt[3] - outExt[2];
+  const int maxZ = outExt[5] - outExt[4];
   target = (unsigned long)((maxZ+1)*(maxY+1)/50.0);
   target++;
 
-  T v1;
-  T v2;
-
-  // Get increments to march through data
-  in1Data->GetContinuousIncrements(outExt, inIncX, inIncY, inIncZ);
-  in2Data->GetContinuousIncrements(outExt, in2IncX, in2IncY, in2IncZ);
-  outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
+  const int numberOfInputs = static_cast<int>(inputs.size());
+  const T zero = static_cast<T>(0);
 
-  // Loop through output pixels
-  for (idxZ = 0; idxZ <= maxZ; idxZ++)
+  // Loop through output rows
+  for (int idxZ = outExt[4]; idxZ <= outExt[5]; idxZ++)
     {
-    for (idxY = 0; !self->AbortExecute && idxY <= maxY; idxY++)
+    for (int idxY = outExt[2]; !self->AbortExecute && idxY <= outExt[3]; idxY++)
       {
       if (!id)
         {
@@ -120,52 +116,29 @@ void vtkImageLabelCombineExecute2(vtkImageLabelCombine *self,
           }
         count++;
         }
-      for (idxR = 0; idxR < rowLength; idxR++)
+      T* outPtr = static_cast<T*>(outData->GetScalarPointer(outExt[0], idxY, idxZ));
+
+      // Lowest precedence input: keep positive labels only
+      const T* inPtr = static_cast<T*>(inputs[numberOfInputs-1]->GetScalarPointer(outExt[0], idxY, idxZ));
+      for (int idxR = 0; idxR < rowLength; idxR++)
         {
-        // Pixel operation
-        v1 = *in1Ptr;
-        v2 = *in2Ptr;
-        if (op == 0)
-          {
-          if (v1 > 0)
-            {
-            *outPtr = v1;
-            }
-          else if (v2 > 0 && v1 == 0)
-            {
-            *outPtr = v2;
-            }
-          else
-            {
-            *outPtr = 0;
-            }
-          }
-        else
+        const T v = inPtr[idxR];
+        outPtr[idxR] = (v > zero) ? v : zero;
+        }
+
+      // Higher precedence inputs: positive labels overwrite, negative values clear,
+      // background keeps the label of the lower precedence inputs.
+      for (int inputIndex = numberOfInputs-2; inputIndex >= 0; inputIndex--)
+        {
+        inPtr = static_cast<T*>(inputs[inputIndex]->GetScalarPointer(outExt[0], idxY, idxZ));
+        for (int idxR = 0; idxR < rowLength; idxR++)
           {
-          if (v2 > 0)
-            {
-            *outPtr = v2;
-            }
-          else if (v1 > 0 && v2 == 0)
-            {
-            *outPtr = v1;
-            }
-          else
-            {
-            *outPtr = 0;
-            }
+          const T v = inPtr[idxR];
+          const T o = outPtr[idxR];
+          outPtr[idxR] = (v > zero) ? v : ((v == zero) ? o : zero);
           }
-        outPtr++;
-        in1Ptr++;
-        in2Ptr++;
         }
-      outPtr += outIncY;
-      in1Ptr += inIncY;
-      in2Ptr += in2IncY;
       }
-    outPtr += outIncZ;
-    in1Ptr += inIncZ;
-    in2Ptr += in2IncZ;
     }
 }
 
@@ -177,64 +150,70 @@ void vtkImageLabelCombineExecute2(vtkImageLabelCombine *self,
 // the data data types.
 void vtkImageLabelCombine::ThreadedRequestData(
   vtkInformation * vtkNotUsed( request ),
-  vtkInformationVector ** vtkNotUsed( inputVector ),
+  vtkInformationVector ** inputVector,
   vtkInformationVector * vtkNotUsed( outputVector ),
   vtkImageData ***inData,
   vtkImageData **outData,
   int outExt[6], int id)
 {
-  void *inPtr1;
-  void *outPtr;
-
-  inPtr1 = inData[0][0]->GetScalarPointerForExtent(outExt);
-  outPtr = outData[0]->GetScalarPointerForExtent(outExt);
-
-  void *inPtr2;
-
-  if (!inData[1] || ! inData[1][0])
+  int numberOfInputs2 = inputVector[1]->GetNumberOfInformationObjects();
+  if (!inData[1] || numberOfInputs2 < 1 || !inData[1][0])
     {
     vtkErrorMacro("ImageMathematics requested to perform a two input operation with only one input\n");
     return;
     }
 
-  inPtr2 = inData[1][0]->GetScalarPointerForExtent(outExt);
-
-  // this filter expects that input is the same type as output.
-  if (inData[0][0]->GetScalarType() != outData[0]->GetScalarType())
+  // Collect inputs in decreasing order of precedence
+  std::vector<vtkImageData*> inputs;
+  if (this->OverwriteInput)
     {
-      vtkErrorMacro(<< "Execute: input1 ScalarType, "
-                    <<  inData[0][0]->GetScalarType()
-                    << ", must match output ScalarType "
-                    << outData[0]->GetScalarType());
-      return;
+    for (int inputIndex = numberOfInputs2-1; inputIndex >= 0; inputIndex--)
+      {
+      inputs.push_back(inData[1][inputIndex]);
+      }
+    inputs.push_back(inData[0][0]);
     }
-  /**
-  if (inData[1][0]->GetScalarType() != outData[0]->GetScalarType())
+  else
+    {
+    inputs.push_back(inData[0][0]);
+    for (int inputIndex = 0; inputIndex < numberOfInputs2; inputIndex++)
+      {
+      inputs.push_back(inData[1][inputIndex]);
+      }
+    }
+
+  // this filter expects that all inputs are the same type as output
+  // and have the same number of components.
+  for (vtkImageData* input : inputs)
     {
-      vtkErrorMacro(<< "Execute: input2 ScalarType, "
-                    << inData[1][0]->GetScalarType()
+    if (!input)
+      {
+      vtkErrorMacro(<< "Execute: missing input");
+      return;
+      }
+    if (input->GetScalarType() != outData[0]->GetScalarType())
+      {
+      vtkErrorMacro(<< "Execute: input ScalarType, "
+                    <<  input->GetScalarType()
                     << ", must match output ScalarType "
                     << outData[0]->GetScalarType());
       return;
-    }
-  **/
-  // this filter expects that inputs that have the same number of components
-  if (inData[0][0]->GetNumberOfScalarComponents() !=
-      inData[1][0]->GetNumberOfScalarComponents())
-    {
-      vtkErrorMacro(<< "Execute: input1 NumberOfScalarComponents, "
-                    << inData[0][0]->GetNumberOfScalarComponents()
-                    << ", must match out input2 NumberOfScalarComponents "
-                    << inData[1][0]->GetNumberOfScalarComponents());
+      }
+    if (input->GetNumberOfScalarComponents() !=
+        outData[0]->GetNumberOfScalarComponents())
+      {
+      vtkErrorMacro(<< "Execute: input NumberOfScalarComponents, "
+                    << input->GetNumberOfScalarComponents()
+                    << ", must match output NumberOfScalarComponents "
+                    << outData[0]->GetNumberOfScalarComponents());
       return;
+      }
     }
 
-  switch (inData[0][0]->GetScalarType())
+  switch (outData[0]->GetScalarType())
     {
     vtkTemplateMacro(
-                     vtkImageLabelCombineExecute2(this,inData[0][0], (VTK_TT *)(inPtr1),
-                                                  inData[1][0], (VTK_TT *)(inPtr2),
-                                                  outData[0], (VTK_TT *)(outPtr), outExt, id));
+      vtkImageLabelCombineExecute<VTK_TT>(this, inputs, outData[0], outExt, id));
     default:
       vtkErrorMacro(<< "Execute: Unknown ScalarType");
       return;
@@ -22,11 +22,16 @@
 
 #include "vtkThreadedImageAlgorithm.h"
 
-/// \brief Add, subtract, multiply, divide, invert, sin, cos, exp, log.
+/// \brief Combine label maps into one.
 ///
-/// vtkImageLabelCombine implements basic mathematic operations SetOperation is
-/// used to select the filters behavior.  The filter can take two or one
-/// input.
+/// The first label map is set on input port 0, the other label maps are added
+/// as connections to input port 1 (SetInput2, AddInput2), so any number of label
+/// maps can be combined in one pass instead of combining them pairwise.
+/// Each output voxel takes the label of the input with highest precedence that is
+/// not background (0). By default the first input has highest precedence, followed
+/// by the additional inputs in the order they were added. If OverwriteInput is
+/// enabled then the order is reversed (the last added input has highest precedence).
+/// Negative values are not labels: they clear the voxel in the output.
 class VTK_Teem_EXPORT vtkImageLabelCombine : public vtkThreadedImageAlgorithm
 {
 public:
@@ -35,7 +40,8 @@ public:
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
   ///
-  /// Set/Get the Operation to perform.
+  /// If set to 1 then later inputs overwrite earlier inputs,
+  /// otherwise earlier inputs have precedence.
   vtkSetMacro(OverwriteInput,int);
   vtkGetMacro(OverwriteInput,int);
 
@@ -49,6 +55,10 @@ public:
   {
       this->SetInputData(1,in);
   }
+  virtual void AddInput2(vtkDataObject *in)
+  {
+      this->AddInputData(1,in);
+  }
 
 protected:
   vtkImageLabelCombine();
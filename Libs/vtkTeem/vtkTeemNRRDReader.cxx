@@ -52,8 +52,124 @@
 // Teem includes
 #include "teem/ten.h"
 
+// STD includes
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+#ifdef _WIN32
+#include <vtksys/Encoding.hxx>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 vtkStandardNewMacro(vtkTeemNRRDReader);
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Memory-mapped regions, indexed by the data pointer that is given to the
+/// VTK array, so that the mapping can be released when the array is deleted.
+struct MappedRegion
+{
+  void* Base{ nullptr };
+  size_t Length{ 0 };
+};
+std::mutex MappedRegionsMutex;
+std::map<void*, MappedRegion> MappedRegions;
+
+//----------------------------------------------------------------------------
+void UnmapRegion(const MappedRegion& region)
+{
+#ifdef _WIN32
+  UnmapViewOfFile(region.Base);
+#else
+  munmap(region.Base, region.Length);
+#endif
+}
+
+//----------------------------------------------------------------------------
+/// Free function of the memory-mapped VTK arrays
+void ReleaseMappedData(void* dataPointer)
+{
+  MappedRegion region;
+  {
+    std::lock_guard<std::mutex> lock(MappedRegionsMutex);
+    std::map<void*, MappedRegion>::iterator it = MappedRegions.find(dataPointer);
+    if (it == MappedRegions.end())
+      {
+      return;
+      }
+    region = it->second;
+    MappedRegions.erase(it);
+  }
+  UnmapRegion(region);
+}
+
+//----------------------------------------------------------------------------
+/// Map dataSize bytes of the file starting at dataOffset, copy-on-write.
+/// Returns the pointer to the first data byte, nullptr on failure.
+void* MapFileRegion(const std::string& fileName, size_t dataOffset, size_t dataSize)
+{
+  MappedRegion region;
+  size_t alignedOffset = 0;
+#ifdef _WIN32
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  alignedOffset = dataOffset - dataOffset % systemInfo.dwAllocationGranularity;
+  region.Length = dataSize + (dataOffset - alignedOffset);
+  std::wstring fileNameW = vtksys::Encoding::ToWide(fileName);
+  HANDLE fileHandle = CreateFileW(fileNameW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+    return nullptr;
+    }
+  HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(fileHandle);
+  if (mappingHandle == nullptr)
+    {
+    return nullptr;
+    }
+  const unsigned long long offset = alignedOffset;
+  region.Base = MapViewOfFile(mappingHandle, FILE_MAP_COPY,
+    static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset & 0xFFFFFFFF), region.Length);
+  // the view keeps the mapping alive
+  CloseHandle(mappingHandle);
+  if (region.Base == nullptr)
+    {
+    return nullptr;
+    }
+#else
+  const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  alignedOffset = dataOffset - dataOffset % pageSize;
+  region.Length = dataSize + (dataOffset - alignedOffset);
+  int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+  if (fileDescriptor < 0)
+    {
+    return nullptr;
+    }
+  region.Base = mmap(nullptr, region.Length, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+    fileDescriptor, static_cast<off_t>(alignedOffset));
+  // the mapping keeps the file referenced
+  close(fileDescriptor);
+  if (region.Base == MAP_FAILED)
+    {
+    return nullptr;
+    }
+#endif
+  void* dataPointer = static_cast<char*>(region.Base) + (dataOffset - alignedOffset);
+  std::lock_guard<std::mutex> lock(MappedRegionsMutex);
+  MappedRegions[dataPointer] = region;
+  return dataPointer;
+}
+
+} // end of anonymous namespace
+
 //----------------------------------------------------------------------------
 vtkTeemNRRDReader::vtkTeemNRRDReader()
 {
@@ -62,6 +178,19 @@ vtkTeemNRRDReader::vtkTeemNRRDReader()
   this->MeasurementFrameMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
   this->nrrd = nrrdNew();
   this->UseNativeOrigin = true;
+  this->UseMemoryMapping = false;
+  this->ReadDownsamplingFactor = 1;
+  this->ReadRegionActive = false;
+  for (int i = 0; i < 3; ++i)
+    {
+    // empty extent: read the whole image
+    this->ReadExtent[2 * i] = 0;
+    this->ReadExtent[2 * i + 1] = -1;
+    this->ReadRegion[2 * i] = 0;
+    this->ReadRegion[2 * i + 1] = -1;
+    this->FullDataExtent[2 * i] = 0;
+    this->FullDataExtent[2 * i + 1] = -1;
+    }
   this->ReadStatus = 0;
   this->PointDataType = -1;
   this->DataType = -1;
@@ -350,6 +479,7 @@ void vtkTeemNRRDReader::ExecuteInformation()
     return;
     }
   this->CurrentFileName = this->GetFileName();
+  this->ReadRegionActive = false;
 
   nrrdNuke(this->nrrd); // nuke and reallocate to reset the state
   this->nrrd = nrrdNew();
@@ -566,6 +696,55 @@ void vtkTeemNRRDReader::ExecuteInformation()
       }
     }
 
+  // Only read a region of the image, optionally downsampled
+  std::copy(dataExtent, dataExtent + 6, this->FullDataExtent);
+  std::copy(dataExtent, dataExtent + 6, this->ReadRegion);
+  bool readExtentSpecified = true;
+  for (int i = 0; i < 3; i++)
+    {
+    readExtentSpecified = readExtentSpecified && (this->ReadExtent[2 * i] <= this->ReadExtent[2 * i + 1]);
+    }
+  if (readExtentSpecified)
+    {
+    for (int i = 0; i < 3; i++)
+      {
+      this->ReadRegion[2 * i] = std::max(dataExtent[2 * i], this->ReadExtent[2 * i]);
+      this->ReadRegion[2 * i + 1] = std::min(dataExtent[2 * i + 1], this->ReadExtent[2 * i + 1]);
+      if (this->ReadRegion[2 * i] > this->ReadRegion[2 * i + 1])
+        {
+        vtkWarningMacro("ReadImageInformation: read extent does not intersect the image, the whole image is read");
+        std::copy(dataExtent, dataExtent + 6, this->ReadRegion);
+        break;
+        }
+      }
+    }
+  this->ReadRegionActive = (this->ReadDownsamplingFactor > 1);
+  for (int i = 0; i < 6; i++)
+    {
+    this->ReadRegionActive = this->ReadRegionActive || (this->ReadRegion[i] != dataExtent[i]);
+    }
+  if (this->ReadRegionActive)
+    {
+    // IJK of the region: (IJK of the full image - region start) / factor
+    for (int row = 0; row < 3; row++)
+      {
+      for (int column = 0; column < 3; column++)
+        {
+        origin[row] += ijkToRasMatrix->GetElement(row, column) * this->ReadRegion[2 * column];
+        }
+      }
+    for (int column = 0; column < 3; column++)
+      {
+      for (int row = 0; row < 3; row++)
+        {
+        ijkToRasMatrix->SetElement(row, column, ijkToRasMatrix->GetElement(row, column) * this->ReadDownsamplingFactor);
+        }
+      spacing[column] *= this->ReadDownsamplingFactor;
+      dataExtent[2 * column] = 0;
+      dataExtent[2 * column + 1] = (this->ReadRegion[2 * column + 1] - this->ReadRegion[2 * column]) / this->ReadDownsamplingFactor;
+      }
+    }
+
   if (this->UseNativeOrigin && AIR_EXISTS(this->nrrd->spaceOrigin[0]))
     {
     for (int i = 0; i < 3; i++)
@@ -906,28 +1085,27 @@ void vtkTeemNRRDReader::ExecuteDataWithInformation(vtkDataObject *output, vtkInf
         vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()), 6);
     }
 
-  vtkImageData *imageData = this->AllocateOutputData(output, outInfo);
-
   if (this->GetFileName() == nullptr)
     {
     vtkErrorMacro(<< "Either a FileName or FilePrefix must be specified.");
     return;
     }
 
-  // Read in the this->nrrd.  Yes, this means that the header is being read
-  // twice: once by ExecuteInformation, and once here
-  if ( nrrdLoad(this->nrrd, this->GetFileName(), nullptr) != 0 )
+  if (this->UseMemoryMapping)
     {
-    char *err =  biffGetDone(NRRD); // would be nice to free(err)
-    vtkErrorMacro("Read: Error reading " << this->GetFileName() << ":\n" << err);
-    return;
+    vtkImageData *mappedImageData = vtkImageData::SafeDownCast(output);
+    if (mappedImageData)
+      {
+      this->ExecuteInformation();
+      mappedImageData->SetExtent(this->GetUpdateExtent());
+      if (this->ReadDataMemoryMapped(mappedImageData, outInfo))
+        {
+        return;
+        }
+      }
     }
 
-  if (this->nrrd->data == nullptr)
-    {
-    vtkErrorMacro(<< "data is null.");
-    return;
-    }
+  vtkImageData *imageData = this->AllocateOutputData(output, outInfo);
 
   void *ptr = nullptr;
   switch(this->PointDataType)
@@ -953,6 +1131,27 @@ void vtkTeemNRRDReader::ExecuteDataWithInformation(vtkDataObject *output, vtkInf
     }
   this->ComputeDataIncrements();
 
+  // Uncompressed data: only read the voxels of the region
+  if (this->ReadRegionActive && ptr && this->ReadRegionFromRawDataFile(ptr))
+    {
+    return;
+    }
+
+  // Read in the this->nrrd.  Yes, this means that the header is being read
+  // twice: once by ExecuteInformation, and once here
+  if ( nrrdLoad(this->nrrd, this->GetFileName(), nullptr) != 0 )
+    {
+    char *err =  biffGetDone(NRRD); // would be nice to free(err)
+    vtkErrorMacro("Read: Error reading " << this->GetFileName() << ":\n" << err);
+    return;
+    }
+
+  if (this->nrrd->data == nullptr)
+    {
+    vtkErrorMacro(<< "data is null.");
+    return;
+    }
+
   unsigned int rangeAxisIdx[NRRD_DIM_MAX] = { 0 };
   unsigned int rangeAxisNum = nrrdRangeAxesGet(this->nrrd, rangeAxisIdx);
   if (rangeAxisNum > 1)
@@ -1090,7 +1289,12 @@ void vtkTeemNRRDReader::ExecuteDataWithInformation(vtkDataObject *output, vtkInf
     // be called here if it existed.
     }
 
-  if (ptr)
+  if (ptr && this->ReadRegionActive)
+    {
+    this->CopyReadRegion(static_cast<const char*>(this->nrrd->data),
+      nrrdElementSize(this->nrrd)*nrrdElementNumber(this->nrrd), static_cast<char*>(ptr));
+    }
+  else if (ptr)
     {
     memcpy(ptr, this->nrrd->data, nrrdElementSize(this->nrrd)*nrrdElementNumber(this->nrrd));
     }
@@ -1099,8 +1303,244 @@ void vtkTeemNRRDReader::ExecuteDataWithInformation(vtkDataObject *output, vtkInf
   nrrdEmpty(this->nrrd);
 }
 
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDReader::GetRawDataFileLayout(std::string& dataFileName, size_t& dataOffset, size_t& dataSize)
+{
+  if (this->ReadStatus != 0 || this->DataType == VTK_VOID || this->DataType == VTK_BIT)
+    {
+    return false;
+    }
+
+  // Read the header again (this->nrrd is emptied after each read) to get the data file layout
+  Nrrd *nrrdHeader = nrrdNew();
+  NrrdIoState *nio = nrrdIoStateNew();
+  nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  long int byteSkip = 0;
+  bool layoutSupported = false;
+  if (nrrdLoad(nrrdHeader, this->GetFileName(), nio) == 0)
+    {
+    // Data that has to be rearranged after reading cannot be used from the file directly
+    unsigned int rangeAxisIdx[NRRD_DIM_MAX] = { 0 };
+    unsigned int rangeAxisNum = nrrdRangeAxesGet(nrrdHeader, rangeAxisIdx);
+    layoutSupported = nrrdHeader->dim > 0
+      && this->DataType == this->NrrdToVTKScalarType(nrrdHeader->type)
+      && (rangeAxisNum == 0 || (rangeAxisNum == 1 && rangeAxisIdx[0] == 0))
+      && nrrdKind3DMaskedSymMatrix != nrrdHeader->axis[0].kind
+      && nrrdKind3DSymMatrix != nrrdHeader->axis[0].kind
+      && nio->encoding == nrrdEncodingRaw
+      && nio->dataFNArr && nio->dataFNArr->len == 1
+      && nio->lineSkip == 0
+      && (nrrdElementSize(nrrdHeader) == 1 || nio->endian == airMyEndian());
+    if (layoutSupported)
+      {
+      dataFileName = nio->dataFN[0];
+      if (!vtksys::SystemTools::FileIsFullPath(dataFileName) && nio->path)
+        {
+        dataFileName = vtksys::SystemTools::CollapseFullPath(dataFileName, nio->path);
+        }
+      byteSkip = nio->byteSkip;
+      dataSize = nrrdElementSize(nrrdHeader) * nrrdElementNumber(nrrdHeader);
+      }
+    }
+  else
+    {
+    char *err = biffGetDone(NRRD);
+    free(err);
+    }
+  nrrdIoStateNix(nio);
+  nrrdNuke(nrrdHeader);
+  if (!layoutSupported || dataSize == 0)
+    {
+    vtkDebugMacro("GetRawDataFileLayout: data file of " << this->GetFileName() << " is not uncompressed raw data");
+    return false;
+    }
+
+  const size_t fileSize = static_cast<size_t>(vtksys::SystemTools::FileLength(dataFileName));
+  if (fileSize < dataSize)
+    {
+    return false;
+    }
+  // byte skip of -1 means that the data is at the end of the file
+  dataOffset = (byteSkip < 0 ? fileSize - dataSize : static_cast<size_t>(byteSkip));
+  return dataOffset + dataSize <= fileSize;
+}
+
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDReader::ReadDataMemoryMapped(vtkImageData *imageData, vtkInformation* outInfo)
+{
+  if (this->ReadRegionActive)
+    {
+    // only a part of the file is read
+    return false;
+    }
+  std::string dataFileName;
+  size_t dataOffset = 0;
+  size_t dataSize = 0;
+  if (!this->GetRawDataFileLayout(dataFileName, dataOffset, dataSize))
+    {
+    return false;
+    }
+
+  vtkIdType numberOfTuples = vtkIdType(1);
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  imageData->GetExtent(extent);
+  for (int i = 0; i < 3; ++i)
+    {
+    numberOfTuples *= vtkIdType(extent[2 * i + 1] - extent[2 * i] + 1);
+    }
+  const size_t numberOfValues = static_cast<size_t>(numberOfTuples) * this->GetNumberOfComponents();
+  if (numberOfValues * vtkAbstractArray::GetDataTypeSize(this->DataType) != dataSize)
+    {
+    return false;
+    }
+
+  void* dataPointer = MapFileRegion(dataFileName, dataOffset, dataSize);
+  if (!dataPointer)
+    {
+    vtkDebugMacro("ReadDataMemoryMapped: failed to memory-map " << dataFileName);
+    return false;
+    }
+
+  vtkSmartPointer<vtkDataArray> pd = vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(this->DataType));
+  pd->SetNumberOfComponents(this->GetNumberOfComponents());
+  pd->SetVoidArray(dataPointer, static_cast<vtkIdType>(numberOfValues), 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  pd->SetArrayFreeFunction(ReleaseMappedData);
+  pd->SetName(this->DataArrayName.c_str());
+
+  switch (this->PointDataType)
+    {
+    case vtkDataSetAttributes::SCALARS:
+      imageData->GetPointData()->SetScalars(pd);
+      vtkDataObject::SetPointDataActiveScalarInfo(outInfo, this->DataType, this->GetNumberOfComponents());
+      break;
+    case vtkDataSetAttributes::VECTORS:
+      imageData->GetPointData()->SetVectors(pd);
+      break;
+    case vtkDataSetAttributes::NORMALS:
+      imageData->GetPointData()->SetNormals(pd);
+      break;
+    case vtkDataSetAttributes::TENSORS:
+      imageData->GetPointData()->SetTensors(pd);
+      break;
+    default:
+      vtkErrorMacro("Unknown PointData Type.");
+      return false;
+    }
+  this->ComputeDataIncrements();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDReader::ReadRegionFromRawDataFile(void* outputPointer)
+{
+  std::string dataFileName;
+  size_t dataOffset = 0;
+  size_t dataSize = 0;
+  if (!this->GetRawDataFileLayout(dataFileName, dataOffset, dataSize))
+    {
+    return false;
+    }
+  // The operating system only reads the pages of the file that contain voxels of the region
+  void* dataPointer = MapFileRegion(dataFileName, dataOffset, dataSize);
+  if (!dataPointer)
+    {
+    vtkDebugMacro("ReadRegionFromRawDataFile: failed to memory-map " << dataFileName);
+    return false;
+    }
+  bool success = this->CopyReadRegion(static_cast<const char*>(dataPointer), dataSize, static_cast<char*>(outputPointer));
+  ReleaseMappedData(dataPointer);
+  return success;
+}
+
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDReader::CopyReadRegion(const char* fullImage, size_t fullImageSize, char* output)
+{
+  size_t fullDimensions[3] = { 1, 1, 1 };
+  for (int i = 0; i < 3; ++i)
+    {
+    fullDimensions[i] = static_cast<size_t>(this->FullDataExtent[2 * i + 1] - this->FullDataExtent[2 * i] + 1);
+    }
+  const size_t numberOfVoxels = fullDimensions[0] * fullDimensions[1] * fullDimensions[2];
+  if (numberOfVoxels == 0 || fullImageSize % numberOfVoxels != 0)
+    {
+    vtkErrorMacro("CopyReadRegion: image size does not match the image dimensions");
+    return false;
+    }
+  const size_t bytesPerVoxel = fullImageSize / numberOfVoxels;
+  const int* region = this->ReadRegion;
+  const int factor = this->ReadDownsamplingFactor;
+  const size_t rowLength = static_cast<size_t>(region[1] - region[0] + 1);
+  for (int z = region[4]; z <= region[5]; z += factor)
+    {
+    for (int y = region[2]; y <= region[3]; y += factor)
+      {
+      const char* row = fullImage
+        + ((static_cast<size_t>(z) * fullDimensions[1] + static_cast<size_t>(y)) * fullDimensions[0]
+        + static_cast<size_t>(region[0])) * bytesPerVoxel;
+      if (factor == 1)
+        {
+        memcpy(output, row, rowLength * bytesPerVoxel);
+        output += rowLength * bytesPerVoxel;
+        continue;
+        }
+      for (size_t x = 0; x < rowLength; x += factor)
+        {
+        memcpy(output, row + x * bytesPerVoxel, bytesPerVoxel);
+        output += bytesPerVoxel;
+        }
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkTeemNRRDReader::SetReadExtent(int extent[6])
+{
+  bool modified = false;
+  for (int i = 0; i < 6; ++i)
+    {
+    if (this->ReadExtent[i] != extent[i])
+      {
+      this->ReadExtent[i] = extent[i];
+      modified = true;
+      }
+    }
+  if (modified)
+    {
+    // image information has to be recomputed
+    this->CurrentFileName.clear();
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkTeemNRRDReader::SetReadExtent(int i0, int i1, int j0, int j1, int k0, int k1)
+{
+  int extent[6] = { i0, i1, j0, j1, k0, k1 };
+  this->SetReadExtent(extent);
+}
+
+//----------------------------------------------------------------------------
+void vtkTeemNRRDReader::SetReadDownsamplingFactor(int factor)
+{
+  factor = std::max(1, factor);
+  if (this->ReadDownsamplingFactor == factor)
+    {
+    return;
+    }
+  this->ReadDownsamplingFactor = factor;
+  // image information has to be recomputed
+  this->CurrentFileName.clear();
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 void vtkTeemNRRDReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "UseMemoryMapping: " << (this->UseMemoryMapping ? "true" : "false") << "\n";
+  os << indent << "ReadExtent: " << this->ReadExtent[0] << " " << this->ReadExtent[1] << " "
+     << this->ReadExtent[2] << " " << this->ReadExtent[3] << " "
+     << this->ReadExtent[4] << " " << this->ReadExtent[5] << "\n";
+  os << indent << "ReadDownsamplingFactor: " << this->ReadDownsamplingFactor << "\n";
 }
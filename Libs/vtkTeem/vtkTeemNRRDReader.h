@@ -155,6 +155,35 @@ public:
   vtkSetMacro(DataArrayName, std::string);
   vtkGetMacro(DataArrayName, std::string);
 
+  ///
+  /// Memory-map the data file instead of reading it into a newly allocated buffer.
+  /// Only used for uncompressed (raw encoding) detached-header files whose data
+  /// does not need to be rearranged (native byte order, components on the fastest
+  /// axis, no tensor expansion); other files are read as usual.
+  /// The mapping is copy-on-write: the file is never modified, pages are shared
+  /// with other processes mapping the same file until they are written to.
+  /// Default value is false.
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+
+  ///
+  /// Region of the image to read, in voxel coordinates of the whole image
+  /// (i0, i1, j0, j1, k0, k1). The region is clipped to the image extent.
+  /// If the extent is empty then the whole image is read. Default is empty.
+  /// For uncompressed detached-header files only the voxels of the region are
+  /// read from the file, otherwise the whole file is read and then cropped.
+  /// The returned RAS to IJK matrix corresponds to the region.
+  virtual void SetReadExtent(int extent[6]);
+  virtual void SetReadExtent(int i0, int i1, int j0, int j1, int k0, int k1);
+  vtkGetVector6Macro(ReadExtent, int);
+
+  ///
+  /// Only read every N-th voxel along each axis of the read region, to get a
+  /// lower resolution overview of very large images. Default is 1.
+  virtual void SetReadDownsamplingFactor(int factor);
+  vtkGetMacro(ReadDownsamplingFactor, int);
+
   int NrrdToVTKScalarType( const int nrrdPixelType ) const
   {
   switch( nrrdPixelType )
@@ -264,6 +293,14 @@ protected:
   int DataType;
   int NumberOfComponents;
   bool UseNativeOrigin;
+  bool UseMemoryMapping;
+  int ReadExtent[6];
+  int ReadDownsamplingFactor;
+  /// Voxels of the whole image that are actually read (read extent clipped to the image)
+  int ReadRegion[6];
+  /// True if the output is a region or downsampled version of the whole image
+  bool ReadRegionActive;
+  int FullDataExtent[6];
   std::string DataArrayName;
 
   std::map <std::string, std::string> HeaderKeyValue;
@@ -277,6 +314,21 @@ protected:
 
   int tenSpaceDirectionReduce(Nrrd *nout, const Nrrd *nin, double SD[9]);
 
+  /// Set the point data array of the output to a memory-mapped view of the data file.
+  /// Returns false if the file cannot be memory-mapped and has to be read instead.
+  bool ReadDataMemoryMapped(vtkImageData *imageData, vtkInformation* outInfo);
+
+  /// Get the location of the voxels in the data file if the image is stored
+  /// uncompressed in a detached data file and can be used without rearranging.
+  bool GetRawDataFileLayout(std::string& dataFileName, size_t& dataOffset, size_t& dataSize);
+
+  /// Read the voxels of the read region directly from the uncompressed data file.
+  /// Returns false if the data file is not uncompressed.
+  bool ReadRegionFromRawDataFile(void* outputPointer);
+
+  /// Copy the voxels of the read region from the whole image into the output buffer.
+  bool CopyReadRegion(const char* fullImage, size_t fullImageSize, char* output);
+
 private:
   vtkTeemNRRDReader(const vtkTeemNRRDReader&) = delete;
   void operator=(const vtkTeemNRRDReader&) = delete;
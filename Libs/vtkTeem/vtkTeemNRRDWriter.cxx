@@ -7,17 +7,40 @@
 #include "vtkPointData.h"
 #include "vtkObjectFactory.h"
 #include "vtkInformation.h"
+#include "vtkSMPTools.h"
 #include <vtkVersion.h>
+#include <vtk_zlib.h>
+#include <vtksys/SystemTools.hxx>
 
 #include <itkMath.h>
 #include <vnl/vnl_double_3.h>
 
 #include "itkNumberToString.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
 
 class AttributeMapType: public std::map<std::string, std::string> {};
 class AxisInfoMapType : public std::map<unsigned int, std::string> {};
 
+namespace
+{
+/// Size of the blocks of uncompressed data that are compressed independently
+/// when parallel compression is enabled.
+const size_t PARALLEL_COMPRESSION_CHUNK_SIZE = 4 * 1024 * 1024;
+
+//----------------------------------------------------------------------------
+void WriteUInt32LittleEndian(unsigned char* buffer, unsigned long value)
+{
+  buffer[0] = static_cast<unsigned char>(value & 0xff);
+  buffer[1] = static_cast<unsigned char>((value >> 8) & 0xff);
+  buffer[2] = static_cast<unsigned char>((value >> 16) & 0xff);
+  buffer[3] = static_cast<unsigned char>((value >> 24) & 0xff);
+}
+}
+
 vtkStandardNewMacro(vtkTeemNRRDWriter);
 
 //----------------------------------------------------------------------------
@@ -31,6 +54,8 @@ vtkTeemNRRDWriter::vtkTeemNRRDWriter()
   this->UseCompression = 1;
   // use default CompressionLevel
   this->CompressionLevel = -1;
+  this->UseParallelCompression = true;
+  this->NumberOfCompressionThreads = 0;
   this->DiffusionWeightedData = 0;
   this->FileType = VTK_BINARY;
   this->WriteErrorOff();
@@ -439,6 +464,29 @@ void vtkTeemNRRDWriter::WriteData()
   // set endianness as unknown of output
   nio->endian = airEndianUnknown;
 
+  // Large gzip-compressed data is compressed using multiple threads:
+  // teem only writes the header and the data is written afterward (appended
+  // to the header or written to the detached data file).
+  size_t dataSize = nrrdElementNumber(nrrd) * nrrdElementSize(nrrd);
+  bool writeDataInParallel = this->UseParallelCompression
+    && nio->encoding == nrrdEncodingGzip
+    && dataSize > PARALLEL_COMPRESSION_CHUNK_SIZE;
+  bool detachedHeader =
+    vtksys::SystemTools::LowerCase(vtksys::SystemTools::GetFilenameLastExtension(this->GetFileName())) == ".nhdr";
+  std::string dataFileName;
+  if (writeDataInParallel && detachedHeader)
+    {
+    // Use the same data file name as teem would
+    dataFileName = vtksys::SystemTools::GetFilenameWithoutLastExtension(this->GetFileName()) + ".raw.gz";
+    nio->detachedHeader = AIR_TRUE;
+    airArrayLenIncr(nio->dataFNArr, 1);
+    nio->dataFN[0] = airStrdup(dataFileName.c_str());
+    }
+  if (writeDataInParallel)
+    {
+    nio->skipData = AIR_TRUE;
+    }
+
   // Write the nrrd to file.
   if (nrrdSave(this->GetFileName(), nrrd, nio))
     {
@@ -447,15 +495,133 @@ void vtkTeemNRRDWriter::WriteData()
                       << this->GetFileName() << ":\n" << err);
     this->WriteErrorOn();
     }
+  else if (writeDataInParallel)
+    {
+    std::string dataFilePath = this->GetFileName();
+    if (detachedHeader)
+      {
+      dataFilePath = vtksys::SystemTools::GetFilenamePath(this->GetFileName());
+      dataFilePath = (dataFilePath.empty() ? dataFileName : dataFilePath + "/" + dataFileName);
+      }
+    if (!this->WriteGzipDataParallel(nrrd, dataFilePath, !detachedHeader))
+      {
+      vtkErrorMacro("Write: Error writing compressed image data to " << dataFilePath);
+      this->WriteErrorOn();
+      }
+    }
   // Free the nrrd struct but don't touch nrrd->data
   nrrd = nrrdNix(nrrd);
   nio = nrrdIoStateNix(nio);
 }
 
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDWriter::WriteGzipDataParallel(Nrrd* nrrd, const std::string& fileName, bool append)
+{
+  const unsigned char* data = static_cast<const unsigned char*>(nrrd->data);
+  size_t dataSize = nrrdElementNumber(nrrd) * nrrdElementSize(nrrd);
+  size_t numberOfChunks = (dataSize + PARALLEL_COMPRESSION_CHUNK_SIZE - 1) / PARALLEL_COMPRESSION_CHUNK_SIZE;
+  if (numberOfChunks < 1)
+    {
+    numberOfChunks = 1;
+    }
+
+  // Each chunk is compressed into an independent raw deflate stream. All chunks except the last one
+  // end with a sync flush (byte-aligned, not final block), therefore simply concatenating them results
+  // in a single valid deflate stream (same technique as pigz).
+  std::vector<std::vector<unsigned char> > compressedChunks(numberOfChunks);
+  std::vector<unsigned long> chunkCrcs(numberOfChunks, 0);
+  std::vector<char> chunkSucceeded(numberOfChunks, 0);
+  int compressionLevel = this->CompressionLevel;
+  auto compressChunks = [&](vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType chunkIndex = begin; chunkIndex < end; ++chunkIndex)
+      {
+      size_t chunkStart = static_cast<size_t>(chunkIndex) * PARALLEL_COMPRESSION_CHUNK_SIZE;
+      size_t chunkSize = std::min(PARALLEL_COMPRESSION_CHUNK_SIZE, dataSize - chunkStart);
+      bool lastChunk = (static_cast<size_t>(chunkIndex) == numberOfChunks - 1);
+      const unsigned char* chunkData = data + chunkStart;
+
+      chunkCrcs[chunkIndex] = crc32(crc32(0L, Z_NULL, 0), chunkData, static_cast<uInt>(chunkSize));
+
+      z_stream stream;
+      stream.zalloc = Z_NULL;
+      stream.zfree = Z_NULL;
+      stream.opaque = Z_NULL;
+      if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+        continue;
+        }
+      std::vector<unsigned char>& compressed = compressedChunks[chunkIndex];
+      // Extra space for the empty stored block added by the sync flush
+      compressed.resize(deflateBound(&stream, static_cast<uLong>(chunkSize)) + 16);
+      stream.next_in = const_cast<Bytef*>(chunkData);
+      stream.avail_in = static_cast<uInt>(chunkSize);
+      stream.next_out = compressed.data();
+      stream.avail_out = static_cast<uInt>(compressed.size());
+      int result = deflate(&stream, lastChunk ? Z_FINISH : Z_SYNC_FLUSH);
+      bool success = lastChunk ? (result == Z_STREAM_END) : (result == Z_OK && stream.avail_in == 0);
+      compressed.resize(compressed.size() - stream.avail_out);
+      deflateEnd(&stream);
+      chunkSucceeded[chunkIndex] = success;
+      }
+  };
+  if (this->NumberOfCompressionThreads > 0)
+    {
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ this->NumberOfCompressionThreads }, [&]()
+      {
+      vtkSMPTools::For(0, static_cast<vtkIdType>(numberOfChunks), compressChunks);
+      });
+    }
+  else
+    {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numberOfChunks), compressChunks);
+    }
+
+  unsigned long crc = 0;
+  for (size_t chunkIndex = 0; chunkIndex < numberOfChunks; ++chunkIndex)
+    {
+    if (!chunkSucceeded[chunkIndex])
+      {
+      vtkErrorMacro("WriteGzipDataParallel: failed to compress image data");
+      return false;
+      }
+    size_t chunkStart = chunkIndex * PARALLEL_COMPRESSION_CHUNK_SIZE;
+    size_t chunkSize = std::min(PARALLEL_COMPRESSION_CHUNK_SIZE, dataSize - chunkStart);
+    crc = (chunkIndex == 0) ? chunkCrcs[0] : crc32_combine(crc, chunkCrcs[chunkIndex], static_cast<z_off_t>(chunkSize));
+    }
+
+  FILE* file = vtksys::SystemTools::Fopen(fileName, append ? "ab" : "wb");
+  if (!file)
+    {
+    vtkErrorMacro("WriteGzipDataParallel: failed to open file " << fileName);
+    return false;
+    }
+
+  // gzip member header: magic, deflate method, no flags, no modification time, unknown OS
+  const unsigned char header[10] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 255 };
+  bool success = (fwrite(header, 1, sizeof(header), file) == sizeof(header));
+  for (size_t chunkIndex = 0; success && chunkIndex < numberOfChunks; ++chunkIndex)
+    {
+    const std::vector<unsigned char>& compressed = compressedChunks[chunkIndex];
+    success = (fwrite(compressed.data(), 1, compressed.size(), file) == compressed.size());
+    }
+  // gzip member trailer: CRC-32 and size of the uncompressed data (modulo 2^32)
+  unsigned char trailer[8];
+  WriteUInt32LittleEndian(trailer, crc);
+  WriteUInt32LittleEndian(trailer + 4, static_cast<unsigned long>(dataSize & 0xffffffffUL));
+  success = success && (fwrite(trailer, 1, sizeof(trailer), file) == sizeof(trailer));
+  success = (fclose(file) == 0) && success;
+  return success;
+}
+
+//----------------------------------------------------------------------------
 void vtkTeemNRRDWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
 
+  os << indent << "UseParallelCompression: " << (this->UseParallelCompression ? "true" : "false") << "\n";
+  os << indent << "NumberOfCompressionThreads: " << this->NumberOfCompressionThreads << "\n";
+
   os << indent << "RAS to IJK Matrix: ";
      this->IJKToRASMatrix->PrintSelf(os,indent);
   os << indent << "Measurement frame: ";
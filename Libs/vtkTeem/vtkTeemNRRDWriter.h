@@ -58,6 +58,22 @@ public:
   vtkSetClampMacro(CompressionLevel, int, 0, 9);
   vtkGetMacro(CompressionLevel, int);
 
+  /// Compress large images using multiple threads.
+  /// The image data is split into chunks that are compressed independently
+  /// and concatenated into a single standard gzip stream, so the written file
+  /// can be read by any NRRD reader. Used for both attached-header (.nrrd)
+  /// and detached-header (.nhdr) files.
+  /// Enabled by default.
+  vtkSetMacro(UseParallelCompression, bool);
+  vtkGetMacro(UseParallelCompression, bool);
+  vtkBooleanMacro(UseParallelCompression, bool);
+
+  /// Maximum number of threads used for parallel compression.
+  /// 0 means that the default number of threads of vtkSMPTools is used.
+  /// Default value is 0.
+  vtkSetClampMacro(NumberOfCompressionThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfCompressionThreads, int);
+
   vtkSetClampMacro(FileType,int,VTK_ASCII,VTK_BINARY);
   vtkGetMacro(FileType,int);
   void SetFileTypeToASCII() {this->SetFileType(VTK_ASCII);};
@@ -115,6 +131,12 @@ protected:
   /// Write method. It is called by vtkWriter::Write();
   void WriteData() override;
 
+  /// Write the image data of the nrrd as a gzip stream, compressing chunks of
+  /// the data in parallel. The data is appended to the end of the file if append
+  /// is true (attached header), otherwise the file is overwritten (detached header).
+  /// Returns false on failure.
+  bool WriteGzipDataParallel(Nrrd* nrrd, const std::string& fileName, bool append);
+
   ///
   /// Flag to set to on when a write error occurred
   int WriteError;
@@ -129,6 +151,8 @@ protected:
 
   int UseCompression;
   int CompressionLevel;
+  bool UseParallelCompression;
+  int NumberOfCompressionThreads;
   int FileType;
 
   AttributeMapType *Attributes;
@@ -10,9 +10,8 @@
 =========================================================================*/
 #include "itkImageFileWriter.h"
 
-#include "itkCastImageFilter.h"
-
 #include "itkPluginUtilities.h"
+#include "itkPluginVoxelwiseOperations.h"
 #include "CastScalarVolumeCLP.h"
 
 // Use an anonymous namespace to keep class types and function names
@@ -38,28 +37,30 @@ int DoIt( int argc, char * argv[], Tin, Tout )
   typedef itk::ImageFileReader<InputImageType>  ReaderType;
   typedef itk::ImageFileWriter<OutputImageType> WriterType;
 
-  typedef itk::CastImageFilter<
-    InputImageType, OutputImageType>  FilterType;
-
   typename ReaderType::Pointer reader1 = ReaderType::New();
   itk::PluginFilterWatcher watchReader1(reader1, "Read Volume",
                                         CLPProcessInformation);
 
   reader1->SetFileName( InputVolume.c_str() );
+  reader1->Update();
 
-  typename FilterType::Pointer filter = FilterType::New();
-  itk::PluginFilterWatcher watchFilter(filter,
-                                       "Cast image",
-                                       CLPProcessInformation);
-
-  filter->SetInput( 0, reader1->GetOutput() );
+  // Cast the voxels in a single pass (the input cannot be used as output,
+  // as the pixel types are different).
+  typename OutputImageType::Pointer outputImage = OutputImageType::New();
+  itk::UnaryVoxelwiseOperation(reader1->GetOutput(), outputImage.GetPointer(),
+    [](InputPixelType value)
+      {
+      return static_cast<OutputPixelType>(value);
+      });
+  // free the input voxels before writing
+  reader1->GetOutput()->Initialize();
 
   typename WriterType::Pointer writer = WriterType::New();
   itk::PluginFilterWatcher watchWriter(writer,
                                        "Write Volume",
                                        CLPProcessInformation);
   writer->SetFileName( OutputVolume.c_str() );
-  writer->SetInput( filter->GetOutput() );
+  writer->SetInput( outputImage );
   writer->SetUseCompression(1);
   writer->Update();
   return EXIT_SUCCESS;
@@ -68,13 +68,28 @@ int DoIt( int argc, char * argv[], T )
   pattern[1] = checkerPattern[1];
   pattern[2] = checkerPattern[2];
 
-  resample->SetInput( reader2->GetOutput() );
-  resample->SetReferenceImage( reader1->GetOutput() );
-  resample->UseReferenceImageOn();
-
   filter->SetCheckerPattern(pattern);
   filter->SetInput1( reader1->GetOutput() );
-  filter->SetInput2( resample->GetOutput() );
+
+  // Resampling is only needed if the second volume has a different geometry
+  reader1->UpdateOutputInformation();
+  reader2->UpdateOutputInformation();
+  const InputImageType* image1 = reader1->GetOutput();
+  const InputImageType* image2 = reader2->GetOutput();
+  if( image1->GetLargestPossibleRegion() == image2->GetLargestPossibleRegion()
+      && image1->GetSpacing() == image2->GetSpacing()
+      && image1->GetOrigin() == image2->GetOrigin()
+      && image1->GetDirection() == image2->GetDirection() )
+    {
+    filter->SetInput2( reader2->GetOutput() );
+    }
+  else
+    {
+    resample->SetInput( reader2->GetOutput() );
+    resample->SetReferenceImage( reader1->GetOutput() );
+    resample->UseReferenceImageOn();
+    filter->SetInput2( resample->GetOutput() );
+    }
 
   writer->SetInput( filter->GetOutput() );
   writer->SetUseCompression(1);
@@ -9,14 +9,20 @@ command line processing and additional features have been added.
 #pragma warning ( disable : 4786 )
 #endif
 
+#include <algorithm>
 #include <ctime>
+#include <vector>
 
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
 #include "itkExtractImageFilter.h"
 #include "itkShiftScaleImageFilter.h"
 #include "itkGDCMImageIO.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
+
+#include "gdcmUIDGenerator.h"
 
 #include "CreateDICOMSeriesCLP.h"
 
@@ -102,7 +108,6 @@ int DoIt( int argc, char * argv[])
   typedef itk::MetaDataDictionary DictionaryType;
   unsigned int numberOfSlices = image->GetLargestPossibleRegion().GetSize()[2];
 
-  typename ImageIOType::Pointer gdcmIO = ImageIOType::New();
   DictionaryType       dictionary;
 
   // Progress
@@ -344,173 +349,223 @@ int DoIt( int argc, char * argv[])
     itk::EncapsulateMetaData<std::string>(dictionary, "0008|0033", contentTime);
     }
 
-  // Set study, series, and frame of reference UIDs
+  // Set study, series, and frame of reference UIDs.
+  // Slices are written by independent DICOM IO objects in parallel, therefore UIDs cannot be generated
+  // by the IO (each IO would generate a different study and series); they are generated here once per series.
   if (studyInstanceUID.empty() && seriesInstanceUID.empty() && frameOfReferenceUID.empty())
     {
-    // no UIDs are specified, so we ask ITK DICOM IO to generate them.
-    gdcmIO->SetKeepOriginalUID(false);
+    gdcm::UIDGenerator uidGenerator;
+    studyInstanceUID = uidGenerator.Generate();
+    seriesInstanceUID = uidGenerator.Generate();
+    frameOfReferenceUID = uidGenerator.Generate();
     }
-  else
+  else if (studyInstanceUID.empty() || seriesInstanceUID.empty() || frameOfReferenceUID.empty())
     {
     // ITK DICOM IO either sets all UIDs or none of them, so we return with error if not all UIDs are specified
-    if (studyInstanceUID.empty() || seriesInstanceUID.empty() || frameOfReferenceUID.empty())
+    std::cerr << "If any of UIDs (studyInstanceUID, seriesInstanceUID, and frameOfReferenceUID)"
+      << " are specified then all of them must be specified." << std::endl;
+    return EXIT_FAILURE;
+    }
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|000d", studyInstanceUID);
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|000e", seriesInstanceUID);
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|0052", frameOfReferenceUID);
+
+  // Image Orientation (Patient) and Slice Thickness are the same for all slices
+  value.str("");
+  value << oMatrix[0][0] << "\\" << oMatrix[1][0] << "\\" << oMatrix[2][0] << "\\";
+  value << oMatrix[0][1] << "\\" << oMatrix[1][1] << "\\" << oMatrix[2][1];
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|0037", value.str() );
+  value.str("");
+  value << spacing[2];
+  itk::EncapsulateMetaData<std::string>(dictionary, "0018|0050", value.str() );
+
+  // Always set the rescale interscept and rescale slope (even if
+  // they are at their defaults of 0 and 1 respectively).
+  // value.str("");
+  // value << rescaleIntercept;
+  // itk::EncapsulateMetaData<std::string>(dictionary, "0028|1052", value.str());
+  // value.str("");
+  // value << rescaleSlope;
+  // itk::EncapsulateMetaData<std::string>(dictionary, "0028|1053", value.str());
+
+  // On Windows, it is hard to pass a string such as "%04d" via command-line, as the % is interpreted as an escape character,
+  // therefore we allow the user to omit the leading "%". If the format string does not start with "%" then we add it here.
+  if (!dicomNumberFormat.empty())
+    {
+    if (dicomNumberFormat[0] != '%')
       {
-      std::cerr << "If any of UIDs (studyInstanceUID, seriesInstanceUID, and frameOfReferenceUID)"
-        << " are specified then all of them must be specified." << std::endl;
-      return EXIT_FAILURE;
+      dicomNumberFormat = "%" + dicomNumberFormat;
       }
-    gdcmIO->SetKeepOriginalUID(true);
-    itk::EncapsulateMetaData<std::string>(dictionary, "0020|000d", studyInstanceUID);
-    itk::EncapsulateMetaData<std::string>(dictionary, "0020|000e", seriesInstanceUID);
-    itk::EncapsulateMetaData<std::string>(dictionary, "0020|0052", frameOfReferenceUID);
     }
 
   // -----------------------------------------
   // For each slice
+  //
+  // Slices are processed in batches: slices of a batch are extracted and their header is prepared
+  // (from the shared dictionary) sequentially, then they are written in parallel, each by its own
+  // writer and DICOM IO. Extracted slices are disconnected from the pipeline, so that
+  // the writers do not access the shared input image pipeline concurrently.
+
+  unsigned int numberOfWorkUnits = numberOfThreads > 0 ? static_cast<unsigned int>(numberOfThreads)
+    : itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  numberOfWorkUnits = std::max(1u, std::min(numberOfWorkUnits, numberOfSlices));
+  itk::MultiThreaderBase::Pointer multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->SetMaximumNumberOfThreads(numberOfWorkUnits);
+  multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+  std::vector<typename Image2DType::Pointer> slices(numberOfWorkUnits);
+  std::vector<std::string> sliceFileNames(numberOfWorkUnits);
+  std::vector<std::string> sliceErrors(numberOfWorkUnits);
 
   float progress = 1.0 / (float) numberOfSlices;
-  for( unsigned int i = 0; i < numberOfSlices; i++ )
+  for (unsigned int batchStart = 0; batchStart < numberOfSlices; batchStart += numberOfWorkUnits)
     {
-    std::cout << "<filter-progress>"
-              << (i + 1) * progress
-              << "</filter-progress>"
-              << std::endl
-              << std::flush;
-
-    std::ostringstream value;
-
-    // Instance Number (required, empty if unknown)
-    value.str("");
-    value << i + 1;
-    itk::EncapsulateMetaData<std::string>(dictionary, "0020|0013", value.str());
-
-    // Image Position (Patient)
-    typename Image3DType::PointType    origin;
-    typename Image3DType::IndexType    index;
-    index.Fill(0);
-    index[2] = i;
-    image->TransformIndexToPhysicalPoint(index, origin);
-    value.str("");
-    value << origin[0] << "\\" << origin[1] << "\\" << origin[2];
-    itk::EncapsulateMetaData<std::string>(dictionary, "0020|0032", value.str() );
-
-    // Image Orientation (Patient)
-    value.str("");
-    value << oMatrix[0][0] << "\\" << oMatrix[1][0] << "\\" << oMatrix[2][0] << "\\";
-    value << oMatrix[0][1] << "\\" << oMatrix[1][1] << "\\" << oMatrix[2][1];
-    itk::EncapsulateMetaData<std::string>(dictionary, "0020|0037", value.str() );
-
-    // Slice Thickness
-    value.str("");
-    value << spacing[2];
-    itk::EncapsulateMetaData<std::string>(dictionary, "0018|0050", value.str() );
-
-    // Always set the rescale interscept and rescale slope (even if
-    // they are at their defaults of 0 and 1 respectively).
-    // value.str("");
-    // value << rescaleIntercept;
-    // itk::EncapsulateMetaData<std::string>(dictionary, "0028|1052", value.str());
-    // value.str("");
-    // value << rescaleSlope;
-    // itk::EncapsulateMetaData<std::string>(dictionary, "0028|1053", value.str());
-
-    typename Image3DType::RegionType extractRegion;
-    typename Image3DType::SizeType   extractSize;
-    typename Image3DType::IndexType  extractIndex;
-    extractSize = image->GetLargestPossibleRegion().GetSize();
-    extractIndex.Fill(0);
-    if( reverseImages )
+    unsigned int batchSize = std::min(numberOfWorkUnits, numberOfSlices - batchStart);
+    for (unsigned int batchIndex = 0; batchIndex < batchSize; ++batchIndex)
       {
-      extractIndex[2] = numberOfSlices - i - 1;
-      }
-    else
-      {
-      extractIndex[2] = i;
-      }
-    extractSize[2] = 0;
-    extractRegion.SetSize(extractSize);
-    extractRegion.SetIndex(extractIndex);
-
-    typedef itk::ExtractImageFilter<Image3DType, Image2DType> ExtractType;
-    typename ExtractType::Pointer extract = ExtractType::New();
-    extract->SetDirectionCollapseToGuess();  // ITKv3 compatible, but not recommended
-    extract->SetInput(image );
-    extract->SetExtractionRegion(extractRegion);
-    extract->Update();
-
-    // If window center and width are specified then use the same values for all slices.
-    // Otherwise use the full scalar range of voxels in the current slice.
-    std::string currentWindowCenter = windowCenter;
-    std::string currentWindowWidth = windowWidth;
-    if (currentWindowCenter.empty() || currentWindowWidth.empty())
-      {
-      // Window width and center are required attributes (if VOI LUT sequence is not present), therefore
-      // if the value is not specified then set it to include the full range of voxel values.
-      itk::ImageRegionIterator<Image2DType> it( extract->GetOutput(), extract->GetOutput()->GetLargestPossibleRegion() );
-      typename Image2DType::PixelType                minValue = itk::NumericTraits<typename Image2DType::PixelType>::max();
-      typename Image2DType::PixelType                maxValue = itk::NumericTraits<typename Image2DType::PixelType>::min();
-      for( it.GoToBegin(); !it.IsAtEnd(); ++it )
-        {
-        typename Image2DType::PixelType p = it.Get();
-        if( p > maxValue )
-          {
-          maxValue = p;
-          }
-        if( p < minValue )
-          {
-          minValue = p;
-          }
-        }
-      double windowCenterValue = (static_cast<double>(minValue) + static_cast<double>(maxValue)) / 2.0;
-      double windowWidthValue = (static_cast<double>(maxValue) - static_cast<double>(minValue));
+      unsigned int i = batchStart + batchIndex;
+      DictionaryType sliceDictionary = dictionary;
 
+      // Instance Number (required, empty if unknown)
       value.str("");
-      value << windowCenterValue;
-      currentWindowCenter = value.str();
-
+      value << i + 1;
+      itk::EncapsulateMetaData<std::string>(sliceDictionary, "0020|0013", value.str());
+
+      // SOP Instance UID
+      gdcm::UIDGenerator uidGenerator;
+      itk::EncapsulateMetaData<std::string>(sliceDictionary, "0008|0018", std::string(uidGenerator.Generate()));
+
+      // Image Position (Patient)
+      typename Image3DType::PointType    origin;
+      typename Image3DType::IndexType    index;
+      index.Fill(0);
+      index[2] = i;
+      image->TransformIndexToPhysicalPoint(index, origin);
       value.str("");
-      value << windowWidthValue;
-      currentWindowWidth = value.str();
-      }
-    itk::EncapsulateMetaData<std::string>(dictionary, "0028|1050", currentWindowCenter);
-    itk::EncapsulateMetaData<std::string>(dictionary, "0028|1051", currentWindowWidth);
+      value << origin[0] << "\\" << origin[1] << "\\" << origin[2];
+      itk::EncapsulateMetaData<std::string>(sliceDictionary, "0020|0032", value.str() );
+
+      typename Image3DType::RegionType extractRegion;
+      typename Image3DType::SizeType   extractSize;
+      typename Image3DType::IndexType  extractIndex;
+      extractSize = image->GetLargestPossibleRegion().GetSize();
+      extractIndex.Fill(0);
+      if( reverseImages )
+        {
+        extractIndex[2] = numberOfSlices - i - 1;
+        }
+      else
+        {
+        extractIndex[2] = i;
+        }
+      extractSize[2] = 0;
+      extractRegion.SetSize(extractSize);
+      extractRegion.SetIndex(extractIndex);
+
+      typedef itk::ExtractImageFilter<Image3DType, Image2DType> ExtractType;
+      typename ExtractType::Pointer extract = ExtractType::New();
+      extract->SetDirectionCollapseToGuess();  // ITKv3 compatible, but not recommended
+      extract->SetInput(image );
+      extract->SetExtractionRegion(extractRegion);
+      extract->Update();
 
-    extract->GetOutput()->SetMetaDataDictionary(dictionary);
+      typename Image2DType::Pointer slice = extract->GetOutput();
+      slice->DisconnectPipeline();
+      slice->SetMetaDataDictionary(sliceDictionary);
+      slices[batchIndex] = slice;
 
-    typename WriterType::Pointer writer = WriterType::New();
-    char                imageNumber[BUFSIZ+1];
-    imageNumber[BUFSIZ] = '\0';
+      char                imageNumber[BUFSIZ+1];
+      imageNumber[BUFSIZ] = '\0';
 
 #if WIN32
 #define snprintf sprintf_s
 #endif
-    // On Windows, it is hard to pass a string such as "%04d" via command-line, as the % is interpreted as an escape character,
-    // therefore we allow the user to omit the leading "%". If the format string does not start with "%" then we add it here.
-    if (!dicomNumberFormat.empty())
+      snprintf(imageNumber, BUFSIZ, dicomNumberFormat.c_str(), i + 1);
+      value.str("");
+      value << dicomDirectory << "/" << dicomPrefix << imageNumber << ".dcm";
+      sliceFileNames[batchIndex] = value.str();
+      sliceErrors[batchIndex].clear();
+      }
+
+    multiThreader->ParallelizeArray(0, batchSize, [&](itk::SizeValueType batchIndex)
       {
-      if (dicomNumberFormat[0] != '%')
+      typename Image2DType::Pointer slice = slices[batchIndex];
+      DictionaryType& sliceDictionary = slice->GetMetaDataDictionary();
+
+      // If window center and width are specified then use the same values for all slices.
+      // Otherwise use the full scalar range of voxels in the current slice.
+      std::string currentWindowCenter = windowCenter;
+      std::string currentWindowWidth = windowWidth;
+      if (currentWindowCenter.empty() || currentWindowWidth.empty())
         {
-        dicomNumberFormat = "%" + dicomNumberFormat;
+        // Window width and center are required attributes (if VOI LUT sequence is not present), therefore
+        // if the value is not specified then set it to include the full range of voxel values.
+        itk::ImageRegionConstIterator<Image2DType> it( slice, slice->GetLargestPossibleRegion() );
+        typename Image2DType::PixelType                minValue = itk::NumericTraits<typename Image2DType::PixelType>::max();
+        typename Image2DType::PixelType                maxValue = itk::NumericTraits<typename Image2DType::PixelType>::min();
+        for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+          {
+          typename Image2DType::PixelType p = it.Get();
+          if( p > maxValue )
+            {
+            maxValue = p;
+            }
+          if( p < minValue )
+            {
+            minValue = p;
+            }
+          }
+        double windowCenterValue = (static_cast<double>(minValue) + static_cast<double>(maxValue)) / 2.0;
+        double windowWidthValue = (static_cast<double>(maxValue) - static_cast<double>(minValue));
+
+        std::ostringstream windowValue;
+        windowValue << windowCenterValue;
+        currentWindowCenter = windowValue.str();
+
+        windowValue.str("");
+        windowValue << windowWidthValue;
+        currentWindowWidth = windowValue.str();
         }
-      }
-    snprintf(imageNumber, BUFSIZ, dicomNumberFormat.c_str(), i + 1);
-    value.str("");
-    value << dicomDirectory << "/" << dicomPrefix << imageNumber << ".dcm";
-    writer->SetFileName(value.str().c_str() );
-
-    writer->SetInput(extract->GetOutput() );
-    writer->SetUseCompression(useCompression);
-    try
-      {
-      writer->SetImageIO(gdcmIO);
-      writer->Update();
-      }
-    catch( itk::ExceptionObject & excp )
+      itk::EncapsulateMetaData<std::string>(sliceDictionary, "0028|1050", currentWindowCenter);
+      itk::EncapsulateMetaData<std::string>(sliceDictionary, "0028|1051", currentWindowWidth);
+
+      // UIDs are set in the dictionary, so the IO must not generate new ones
+      typename ImageIOType::Pointer sliceIO = ImageIOType::New();
+      sliceIO->SetKeepOriginalUID(true);
+
+      typename WriterType::Pointer writer = WriterType::New();
+      writer->SetFileName(sliceFileNames[batchIndex].c_str() );
+      writer->SetInput(slice);
+      writer->SetUseCompression(useCompression);
+      writer->SetImageIO(sliceIO);
+      try
+        {
+        writer->Update();
+        }
+      catch( itk::ExceptionObject & excp )
+        {
+        std::ostringstream error;
+        error << excp;
+        sliceErrors[batchIndex] = error.str();
+        }
+      }, nullptr);
+
+    for (unsigned int batchIndex = 0; batchIndex < batchSize; ++batchIndex)
       {
-      std::cerr << "Exception thrown while writing the file " << std::endl;
-      std::cerr << excp << std::endl;
-      return EXIT_FAILURE;
+      if (!sliceErrors[batchIndex].empty())
+        {
+        std::cerr << "Exception thrown while writing the file " << sliceFileNames[batchIndex] << std::endl;
+        std::cerr << sliceErrors[batchIndex] << std::endl;
+        return EXIT_FAILURE;
+        }
+      slices[batchIndex] = nullptr;
       }
+
+    std::cout << "<filter-progress>"
+              << (batchStart + batchSize) * progress
+              << "</filter-progress>"
+              << std::endl
+              << std::flush;
     }
   std::cout << "<filter-end>" << std::endl;
   std::cout << "<filter-name>ImageFileWriter</filter-name>" << std::endl;
@@ -16,6 +16,7 @@
 =========================================================================*/
 #include "itkImageFileWriter.h"
 #include "itkCastImageFilter.h"
+#include "itkMultiThreaderBase.h"
 
 #include "itkCurvatureAnisotropicDiffusionImageFilter.h"
 
@@ -61,6 +62,13 @@ int DoIt( int argc, char * argv[], T )
                                        CLPProcessInformation);
 
   filter->SetInput( reader->GetOutput() );
+  // The input image is not used after the filter, so the diffusion is
+  // computed in its buffer instead of allocating another float volume.
+  filter->InPlaceOn();
+  if( numberOfThreads > 0 )
+    {
+    filter->SetNumberOfWorkUnits( numberOfThreads );
+    }
   filter->UseImageSpacingOn();
   filter->SetNumberOfIterations( numberOfIterations );
   filter->SetTimeStep( timeStep );
@@ -68,6 +76,8 @@ int DoIt( int argc, char * argv[], T )
 
   typename CastType::Pointer cast = CastType::New();
   cast->SetInput( filter->GetOutput() );
+  // No copy if the output is float
+  cast->InPlaceOn();
 
   typename WriterType::Pointer writer = WriterType::New();
   itk::PluginFilterWatcher watchWriter(writer, "Write Volume",
@@ -87,6 +97,11 @@ int main( int argc, char * argv[] )
 
   PARSE_ARGS;
 
+  if( numberOfThreads > 0 )
+    {
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads( numberOfThreads );
+    }
+
   itk::ImageIOBase::IOPixelType     pixelType;
   itk::ImageIOBase::IOComponentType componentType;
 
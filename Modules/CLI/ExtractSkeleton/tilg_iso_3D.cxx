@@ -23,6 +23,9 @@
 /*****************************************************************************/
 #include <cstdio>
 #include <cstdlib>
+#include <vector>
+
+#include <itkMultiThreaderBase.h>
 
 /********************************  Konstanten  *******************************/
 #define LIM  1 /* Voxelwert >= LIM => Objekt (Input-Bild) */
@@ -173,6 +176,15 @@ int Env_Code_3(int i)
   return nc;
 }
 
+bool is_border(int i)
+/* returns true if the object voxel P{i} has a background 6-neighbor, */
+/* only these voxels can be deleted                                   */
+{
+  return result[i - 1] == BG || result[i + 1] == BG
+    || result[i - nx] == BG || result[i + nx] == BG
+    || result[i - nzz] == BG || result[i + nzz] == BG;
+}
+
 /*************************** ENDE  Hilfsprozeduren **************************/
 
 /******************************  Hauptprozedur ******************************/
@@ -608,7 +620,6 @@ void tilg_iso_3D(int dx, int dy, int dz,
   int nc, x, y, z;
   int end, i, dir, dir_mask;
   // int free_mask;
-  int *list;
   int  dir_tab[26];
 
   // int b[3][3][3];
@@ -620,12 +631,6 @@ void tilg_iso_3D(int dx, int dy, int dz,
 
   workbuf = data;
   nzz = nx * ny;
-  /* Speicher allozieren */
-  if( (list = (int *) malloc(nzz * nz * sizeof(int) / 4) ) == nullptr )
-    {
-    printf("out of memory\n");
-    return;
-    }
   /* Arbeitskopie des Bildes erstellen und binaerisieren */
   end = nx * ny * nz;
   for( i = 0; i < end; i++ )
@@ -696,7 +701,27 @@ void tilg_iso_3D(int dx, int dy, int dz,
   f_tab[17] =      512;    /*  9 */
 
   /* eigentliches Bildparsing */
+  // Only border voxels (object voxels with a background 6-neighbor) can be deleted
+  // and a voxel only becomes a border voxel when one of its 6-neighbors is deleted,
+  // therefore the subcycles only visit the border list, which is updated after each
+  // subcycle by adding the object neighbors of the deleted voxels.
+  // Within a subcycle all the voxels are tested on the same image and deleted
+  // afterwards, so the tests are independent and run in parallel.
+  const int neighbor_offsets[6] = { -1, 1, -nx, nx, -nzz, nzz };
+  std::vector<unsigned char> in_border(end, 0);
+  std::vector<int> border;
+  std::vector<int> next_border;
+  std::vector<unsigned char> deletable;
   end = end - nzz - nx - 1;
+  for( i = nzz + nx + 1; i < end; i++ )
+    {
+    if( result[i] == OBJ && is_border(i) )
+      {
+      border.push_back(i);
+      in_border[i] = 1;
+      }
+    }
+  itk::MultiThreaderBase::Pointer threader = itk::MultiThreaderBase::New();
   cnt = 1;
   while( cnt )
     {
@@ -705,28 +730,48 @@ void tilg_iso_3D(int dx, int dy, int dz,
       {
       cnt1 = 0;
       dir_mask = dir_tab[dir];
-      for( i = nzz + nx + 1; i < end; i++ )
+      deletable.assign(border.size(), 0);
+      threader->ParallelizeArray(0, border.size(), [&](itk::SizeValueType b)
         {
-        if( result[i] == OBJ )
+        int code = Env_Code_3(border[b]);
+        if( ( ( (~ code) & dir_mask) == dir_mask ) && bitcount(code) > 2 && Tilg_Test_3(code, dir, type) == BG )
           {
-          nc = Env_Code_3(i);
-          if( ( (~ nc) & dir_mask) == dir_mask )
-            {
-            if( bitcount(nc) > 2 )
-              {
-              if( Tilg_Test_3(nc, dir, type) == BG )
-                {
-                list[cnt1++] = i;
-                }
-              }
-            }
+          deletable[b] = 1;
           }
-        }
+        }, nullptr);
       /* Voxel der Liste loeschen */
-      for( i = 0; i < cnt1; i++ )
+      for( size_t b = 0; b < border.size(); b++ )
         {
-        result[list[i]] = BG;
+        if( deletable[b] )
+          {
+          result[border[b]] = BG;
+          cnt1++;
+          }
+        }
+      if( cnt1 == 0 )
+        {
+        continue;
         }
+      /* Randliste aktualisieren */
+      next_border.clear();
+      for( size_t b = 0; b < border.size(); b++ )
+        {
+        if( !deletable[b] )
+          {
+          next_border.push_back(border[b]);
+          continue;
+          }
+        for( int n = 0; n < 6; n++ )
+          {
+          int neighbor = border[b] + neighbor_offsets[n];
+          if( result[neighbor] == OBJ && !in_border[neighbor] )
+            {
+            next_border.push_back(neighbor);
+            in_border[neighbor] = 1;
+            }
+          }
+        }
+      border.swap(next_border);
       cnt += cnt1;
       }
     }
@@ -752,6 +797,4 @@ void tilg_iso_3D(int dx, int dy, int dz,
         }
       }
     }
-
-  free(list);
 }
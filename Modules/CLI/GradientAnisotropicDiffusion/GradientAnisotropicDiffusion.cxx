@@ -16,6 +16,7 @@
 =========================================================================*/
 #include "itkImageFileWriter.h"
 #include "itkCastImageFilter.h"
+#include "itkMultiThreaderBase.h"
 
 #include "itkGradientAnisotropicDiffusionImageFilter.h"
 
@@ -60,6 +61,13 @@ int DoIt( int argc, char * argv[], T )
                                        CLPProcessInformation);
 
   filter->SetInput( reader->GetOutput() );
+  // The input image is not used after the filter, so the diffusion is
+  // computed in its buffer instead of allocating another float volume.
+  filter->InPlaceOn();
+  if( numberOfThreads > 0 )
+    {
+    filter->SetNumberOfWorkUnits( numberOfThreads );
+    }
   filter->SetNumberOfIterations( numberOfIterations );
   filter->SetTimeStep( timeStep );
   filter->SetConductanceParameter( conductance );
@@ -67,6 +75,8 @@ int DoIt( int argc, char * argv[], T )
 
   typename CastType::Pointer cast = CastType::New();
   cast->SetInput( filter->GetOutput() );
+  // No copy if the output is float
+  cast->InPlaceOn();
 
   typename WriterType::Pointer writer = WriterType::New();
   itk::PluginFilterWatcher watchWriter(writer, "Write Volume",
@@ -86,6 +96,11 @@ int main( int argc, char * argv[] )
 
   PARSE_ARGS;
 
+  if( numberOfThreads > 0 )
+    {
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads( numberOfThreads );
+    }
+
   itk::ImageIOBase::IOPixelType     pixelType;
   itk::ImageIOBase::IOComponentType componentType;
 
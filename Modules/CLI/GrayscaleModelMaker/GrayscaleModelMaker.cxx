@@ -14,6 +14,8 @@ Version:   $Revision$
 
 #include "GrayscaleModelMakerCLP.h"
 
+#include "vtkAppendPolyData.h"
+#include "vtkCleanPolyData.h"
 #include "vtkDecimatePro.h"
 #include "vtkFieldData.h"
 #include "vtkFlyingEdges3D.h"
@@ -21,6 +23,7 @@ Version:   $Revision$
 #include "vtkImageData.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkReverseSense.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkStripper.h"
 #include "vtkTransform.h"
@@ -33,6 +36,80 @@ Version:   $Revision$
 #include "ModuleDescriptionParser.h"
 #include "ModuleDescription.h"
 
+// STD includes
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Extract the isosurface of slabs of slices in parallel and decimate each slab
+// mesh right away, so that the full resolution mesh of the entire volume is never stored.
+// Adjacent slabs share their boundary slice and the boundary vertices of the slab meshes
+// are not removed by decimation, therefore the slab meshes are joined by merging points.
+vtkSmartPointer<vtkPolyData> ExtractDecimatedSurfaceInSlabs(vtkImageData* image_IJK, double threshold,
+  vtkTransform* transformIJKtoLPS, double targetReduction, int slabThickness)
+{
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  image_IJK->GetExtent(extent);
+  int numberOfSlabs = (extent[5] - extent[4] + slabThickness - 1) / slabThickness;
+  std::vector<vtkSmartPointer<vtkPolyData> > slabMeshes(numberOfSlabs);
+
+  vtkSMPTools::For(0, numberOfSlabs, 1, [&](vtkIdType beginSlab, vtkIdType endSlab)
+    {
+    for (vtkIdType slab = beginSlab; slab < endSlab; ++slab)
+      {
+      int slabExtent[6] = { extent[0], extent[1], extent[2], extent[3],
+        extent[4] + static_cast<int>(slab) * slabThickness,
+        std::min(extent[4] + static_cast<int>(slab + 1) * slabThickness, extent[5]) };
+      vtkNew<vtkImageData> slabImage;
+      slabImage->SetExtent(slabExtent);
+      slabImage->AllocateScalars(image_IJK->GetScalarType(), 1);
+      slabImage->CopyAndCastFrom(image_IJK, slabExtent);
+
+      vtkNew<vtkFlyingEdges3D> mcubes;
+      mcubes->SetInputData(slabImage);
+      mcubes->SetValue(0, threshold);
+      mcubes->ComputeScalarsOff();
+      mcubes->ComputeGradientsOff();
+      mcubes->ComputeNormalsOff();
+
+      vtkNew<vtkTransformPolyDataFilter> transformer;
+      transformer->SetInputConnection(mcubes->GetOutputPort());
+      transformer->SetTransform(transformIJKtoLPS);
+
+      vtkNew<vtkDecimatePro> decimator;
+      decimator->SetInputConnection(transformer->GetOutputPort());
+      decimator->SetFeatureAngle(60);
+      decimator->SplittingOff();
+      decimator->PreserveTopologyOn();
+      decimator->BoundaryVertexDeletionOff();
+      decimator->SetMaximumError(1);
+      decimator->SetTargetReduction(targetReduction);
+      decimator->Update();
+      slabMeshes[slab] = decimator->GetOutput();
+      }
+    });
+
+  vtkNew<vtkAppendPolyData> append;
+  for (vtkPolyData* slabMesh : slabMeshes)
+    {
+    append->AddInputData(slabMesh);
+    }
+  vtkNew<vtkCleanPolyData> cleaner;
+  cleaner->SetInputConnection(append->GetOutputPort());
+  cleaner->ToleranceIsAbsoluteOn();
+  cleaner->SetAbsoluteTolerance(0.0);
+  cleaner->ConvertLinesToPointsOff();
+  cleaner->ConvertPolysToLinesOff();
+  cleaner->ConvertStripsToPolysOff();
+  cleaner->Update();
+  return cleaner->GetOutput();
+}
+
+}
+
 int main(int argc, char* argv[])
 {
   PARSE_ARGS;
@@ -102,22 +179,36 @@ int main(int argc, char* argv[])
     return EXIT_FAILURE;
     }
 
-  vtkNew<vtkFlyingEdges3D> mcubes;
-  vtkPluginFilterWatcher watchMCubes(mcubes, "Marching Cubes", CLPProcessInformation, 1.0 / 7.0, 0.0);
-  mcubes->SetInputData(image_IJK);
-  mcubes->SetValue(0, Threshold);
-  mcubes->ComputeScalarsOff();
-  mcubes->ComputeGradientsOff();
-  mcubes->ComputeNormalsOff();
-  if (Debug)
-    {
-    std::cout << "Number of polygons = " << (mcubes->GetOutput())->GetNumberOfPolys() << endl;
-    }
-
   // Convert the mesh from voxel space to physical space before decimating or smoothing,
   // as they rely on actual size and aspect ratio of the mesh.
   vtkSmartPointer<vtkPolyData> mesh_LPS;
-  {
+  bool decimatedInSlabs = (Decimate > 0 && SlabThickness > 0 && extents[5] - extents[4] > SlabThickness);
+  if (decimatedInSlabs)
+    {
+    if (Debug)
+      {
+      std::cout << "Extracting and decimating surface in slabs of " << SlabThickness << " slices" << std::endl;
+      }
+    mesh_LPS = ExtractDecimatedSurfaceInSlabs(image_IJK, Threshold, transformIJKtoLPS, Decimate, SlabThickness);
+    if (Debug)
+      {
+      std::cout << "After decimation, number of polygons = " << mesh_LPS->GetNumberOfPolys() << endl;
+      }
+    }
+  else
+    {
+    vtkNew<vtkFlyingEdges3D> mcubes;
+    vtkPluginFilterWatcher watchMCubes(mcubes, "Marching Cubes", CLPProcessInformation, 1.0 / 7.0, 0.0);
+    mcubes->SetInputData(image_IJK);
+    mcubes->SetValue(0, Threshold);
+    mcubes->ComputeScalarsOff();
+    mcubes->ComputeGradientsOff();
+    mcubes->ComputeNormalsOff();
+    if (Debug)
+      {
+      std::cout << "Number of polygons = " << (mcubes->GetOutput())->GetNumberOfPolys() << endl;
+      }
+
     if (Debug)
       {
       std::cout << "Transforming to mesh to LPS coordinate system" << std::endl;
@@ -130,7 +221,7 @@ int main(int argc, char* argv[])
     transformer->SetTransform(transformIJKtoLPS);
     transformer->Update();
     mesh_LPS = transformer->GetOutput();
-  }
+    }
 
   if ((transformIJKtoLPS->GetMatrix())->Determinant() < 0)
     {
@@ -147,7 +238,7 @@ int main(int argc, char* argv[])
     mesh_LPS = reverser->GetOutput();
     }
 
-  if (Decimate > 0)
+  if (Decimate > 0 && !decimatedInSlabs)
     {
     if (Debug)
       {
@@ -24,9 +24,15 @@
 #include "itkPluginUtilities.h"
 
 #include "itkHistogramMatchingImageFilter.h"
+#include "itkImageRegionConstIterator.h"
 
 #include "HistogramMatchingCLP.h"
 
+// STD includes
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
 // Use an anonymous namespace to keep class types and function names
 // from colliding when module is used as shared object module.  Every
 // thing should be in an anonymous namespace except for the module
@@ -35,6 +41,120 @@
 namespace
 {
 
+// Compute the histogram of the reference image the same way as
+// itk::HistogramMatchingImageFilter does: bins are evenly distributed from the
+// minimum (or the mean, if thresholdAtMeanIntensity is enabled) to the maximum
+// intensity, pixels below the lower bound are ignored.
+template <class TImage, class THistogram>
+void ComputeReferenceHistogram(const TImage* image, unsigned int numberOfHistogramLevels,
+                               bool thresholdAtMeanIntensity, THistogram* histogram)
+{
+  typedef itk::ImageRegionConstIterator<TImage> IteratorType;
+
+  double minValue = std::numeric_limits<double>::max();
+  double maxValue = std::numeric_limits<double>::lowest();
+  double sum = 0.0;
+  IteratorType it(image, image->GetBufferedRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    const double value = static_cast<double>(it.Get());
+    sum += value;
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+    }
+  const double meanValue = sum / static_cast<double>(image->GetBufferedRegion().GetNumberOfPixels());
+  const double lowerBoundValue = thresholdAtMeanIntensity ? meanValue : minValue;
+
+  typename THistogram::SizeType size;
+  typename THistogram::MeasurementVectorType lowerBound;
+  typename THistogram::MeasurementVectorType upperBound;
+  size.SetSize(1);
+  lowerBound.SetSize(1);
+  upperBound.SetSize(1);
+  size.Fill(numberOfHistogramLevels);
+  lowerBound.Fill(static_cast<typename THistogram::MeasurementType>(lowerBoundValue));
+  upperBound.Fill(static_cast<typename THistogram::MeasurementType>(maxValue));
+  histogram->SetMeasurementVectorSize(1);
+  histogram->Initialize(size, lowerBound, upperBound);
+  histogram->SetToZero();
+
+  typename THistogram::MeasurementVectorType measurement;
+  measurement.SetSize(1);
+  typename THistogram::IndexType index;
+  index.SetSize(1);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    const double value = static_cast<double>(it.Get());
+    if (value < lowerBoundValue || value > maxValue)
+      {
+      continue;
+      }
+    measurement[0] = static_cast<typename THistogram::MeasurementType>(value);
+    histogram->GetIndex(measurement, index);
+    histogram->IncreaseFrequencyOfIndex(index, 1);
+    }
+}
+
+// Histogram file format: number of bins, lower bound, upper bound, then the frequency of each bin.
+template <class THistogram>
+bool WriteHistogram(const std::string& fileName, const THistogram* histogram)
+{
+  std::ofstream file(fileName.c_str());
+  if (!file.is_open())
+    {
+    std::cerr << "Failed to write histogram file: " << fileName << std::endl;
+    return false;
+    }
+  file.precision(std::numeric_limits<double>::max_digits10);
+  const unsigned int numberOfBins = histogram->GetSize(0);
+  file << numberOfBins << " "
+    << static_cast<double>(histogram->GetBinMin(0, 0)) << " "
+    << static_cast<double>(histogram->GetBinMax(0, numberOfBins - 1)) << std::endl;
+  for (unsigned int bin = 0; bin < numberOfBins; ++bin)
+    {
+    file << histogram->GetFrequency(bin) << std::endl;
+    }
+  return file.good();
+}
+
+template <class THistogram>
+bool ReadHistogram(const std::string& fileName, THistogram* histogram)
+{
+  std::ifstream file(fileName.c_str());
+  unsigned int numberOfBins = 0;
+  double lowerBoundValue = 0.0;
+  double upperBoundValue = 0.0;
+  if (!(file >> numberOfBins >> lowerBoundValue >> upperBoundValue) || numberOfBins == 0)
+    {
+    std::cerr << "Failed to read histogram file: " << fileName << std::endl;
+    return false;
+    }
+
+  typename THistogram::SizeType size;
+  typename THistogram::MeasurementVectorType lowerBound;
+  typename THistogram::MeasurementVectorType upperBound;
+  size.SetSize(1);
+  lowerBound.SetSize(1);
+  upperBound.SetSize(1);
+  size.Fill(numberOfBins);
+  lowerBound.Fill(static_cast<typename THistogram::MeasurementType>(lowerBoundValue));
+  upperBound.Fill(static_cast<typename THistogram::MeasurementType>(upperBoundValue));
+  histogram->SetMeasurementVectorSize(1);
+  histogram->Initialize(size, lowerBound, upperBound);
+
+  for (unsigned int bin = 0; bin < numberOfBins; ++bin)
+    {
+    typename THistogram::AbsoluteFrequencyType frequency = 0;
+    if (!(file >> frequency))
+      {
+      std::cerr << "Failed to read histogram file: " << fileName << std::endl;
+      return false;
+      }
+    histogram->SetFrequency(bin, frequency);
+    }
+  return true;
+}
+
 template <class T>
 int DoIt( int argc, char * argv[], T )
 {
@@ -75,11 +195,46 @@ int DoIt( int argc, char * argv[], T )
 
   // Setup the filter
   filter->SetInput( reader1->GetOutput() );
-  filter->SetReferenceImage( reader2->GetOutput() );
+  if( referenceHistogramFile.empty() )
+    {
+    filter->SetReferenceImage( reader2->GetOutput() );
+    }
   filter->SetNumberOfHistogramLevels( numberOfHistogramLevels );
   filter->SetNumberOfMatchPoints( numberOfMatchPoints );
   filter->SetThresholdAtMeanIntensity( thresholdAtMeanIntensity );
 
+  typedef typename FilterType::HistogramType HistogramType;
+  if( !referenceHistogramFile.empty() )
+    {
+    // Use the saved reference histogram instead of reading the reference volume
+    typename HistogramType::Pointer referenceHistogram = HistogramType::New();
+    if( !ReadHistogram(referenceHistogramFile, referenceHistogram.GetPointer()) )
+      {
+      return EXIT_FAILURE;
+      }
+    // the reference image input is not used when the reference histogram
+    // is provided, set the input volume so that the pipeline is complete
+    filter->SetReferenceImage( reader1->GetOutput() );
+    filter->SetReferenceHistogram( referenceHistogram );
+    filter->GenerateReferenceHistogramFromImageOff();
+    }
+  if( !outputReferenceHistogramFile.empty() )
+    {
+    typename HistogramType::ConstPointer referenceHistogram = filter->GetReferenceHistogram();
+    if( referenceHistogramFile.empty() )
+      {
+      reader2->Update();
+      typename HistogramType::Pointer computedHistogram = HistogramType::New();
+      ComputeReferenceHistogram(reader2->GetOutput(), numberOfHistogramLevels,
+                                thresholdAtMeanIntensity, computedHistogram.GetPointer());
+      referenceHistogram = computedHistogram;
+      }
+    if( !WriteHistogram(outputReferenceHistogramFile, referenceHistogram.GetPointer()) )
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
   // Write the output
   writer->SetInput( filter->GetOutput() );
   writer->Update();
@@ -8,6 +8,7 @@
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
 #include "itkImageDuplicator.h"
+#include "itkMultiThreaderBase.h"
 
 #include "ImageLabelCombineCLP.h"
 
@@ -30,80 +31,97 @@ int main( int argc, char * argv[] )
   typedef itk::Image<PixelType, 3>            ImageType;
   typedef itk::ImageFileReader<ImageType>     ReaderType;
   typedef itk::ImageFileWriter<ImageType>     WriterType;
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
   typedef itk::ImageDuplicator<ImageType>     DuplicatorType;
 
-  ReaderType::Pointer     readerA = ReaderType::New();
-  ReaderType::Pointer     readerB = ReaderType::New();
   WriterType::Pointer     writer = WriterType::New();
   DuplicatorType::Pointer duplicator = DuplicatorType::New();
-  ImageType::Pointer      input, output;
+  ImageType::Pointer      output;
 
-  readerA->SetFileName(InputLabelMap_A.c_str() );
-  readerB->SetFileName(InputLabelMap_B.c_str() );
   writer->SetFileName(OutputLabelMap.c_str() );
 
-  try
-    {
-    readerA->Update();
-    readerB->Update();
-    }
-  catch( itk::ExceptionObject & e )
-    {
-    std::cerr << "Failed to read input images. Exception: " << e << std::endl;
-    return EXIT_FAILURE;
-    }
-
+  // Label maps in increasing order of precedence
+  std::vector<std::string> inputFileNames;
   if( FirstOverwrites )
     {
-    input = readerA->GetOutput();
-    duplicator->SetInputImage(readerB->GetOutput() );
-    duplicator->Update();
-    output = duplicator->GetOutput();
+    inputFileNames.insert(inputFileNames.end(), AdditionalInputLabelMaps.rbegin(), AdditionalInputLabelMaps.rend());
+    inputFileNames.push_back(InputLabelMap_B);
+    inputFileNames.push_back(InputLabelMap_A);
     }
   else
     {
-    input = readerB->GetOutput();
-    duplicator->SetInputImage(readerA->GetOutput() );
-    duplicator->Update();
-    output = duplicator->GetOutput();
+    inputFileNames.push_back(InputLabelMap_A);
+    inputFileNames.push_back(InputLabelMap_B);
+    inputFileNames.insert(inputFileNames.end(), AdditionalInputLabelMaps.begin(), AdditionalInputLabelMaps.end());
     }
 
-  // Check dimensions equality
-  unsigned int inputDim = input->GetImageDimension();
-  unsigned int outputDim = output->GetImageDimension();
-  if (inputDim != outputDim)
+  std::vector<ImageType::Pointer> inputs;
+  try
     {
-    std::cerr << "Input images dimensionality is not be the same" << std::endl;
-    return EXIT_FAILURE;
+    for (const std::string& inputFileName : inputFileNames)
+      {
+      ReaderType::Pointer reader = ReaderType::New();
+      reader->SetFileName(inputFileName.c_str() );
+      reader->Update();
+      inputs.push_back(reader->GetOutput());
+      }
     }
-  const ImageType::SizeType inputSize = input->GetLargestPossibleRegion().GetSize();
-  const ImageType::SizeType outputSize = output->GetLargestPossibleRegion().GetSize();
-  bool dimCheck = true;
-  for (unsigned int i=0; i<inputDim; i++)
+  catch( itk::ExceptionObject & e )
     {
-    dimCheck = dimCheck && (inputSize[i] == outputSize[i]);
+    std::cerr << "Failed to read input images. Exception: " << e << std::endl;
+    return EXIT_FAILURE;
     }
-  if (!dimCheck)
+
+  // Check dimensions equality
+  const ImageType::SizeType outputSize = inputs[0]->GetLargestPossibleRegion().GetSize();
+  for (const ImageType::Pointer& input : inputs)
     {
-    std::cerr << "Input images dimensions are not be the same" << std::endl;
-    return EXIT_FAILURE;
+    if (input->GetLargestPossibleRegion().GetSize() != outputSize)
+      {
+      std::cerr << "Input images dimensions are not be the same" << std::endl;
+      return EXIT_FAILURE;
+      }
     }
 
+  // The output starts as a copy of the lowest precedence label map
+  duplicator->SetInputImage(inputs[0]);
+  duplicator->Update();
+  output = duplicator->GetOutput();
+
   // This module operates on the image pixels. The images are expected to be
-  // coinciding in the voxel space.
-  IteratorType itIn(input, input->GetLargestPossibleRegion() );
-  IteratorType itOut(output, output->GetLargestPossibleRegion() );
-  itIn.GoToBegin();
-  itOut.GoToBegin();
-  for( ; !itIn.IsAtEnd(); ++itIn, ++itOut )
+  // coinciding in the voxel space. Non-zero labels of higher precedence label
+  // maps overwrite the output, all label maps are combined in a single pass.
+  std::vector<const PixelType*> inputBuffers;
+  for (size_t inputIndex = 1; inputIndex < inputs.size(); ++inputIndex)
     {
-    if( !itIn.Get() )
+    inputBuffers.push_back(inputs[inputIndex]->GetBufferPointer());
+    }
+  PixelType* outputBuffer = output->GetBufferPointer();
+  itk::MultiThreaderBase::Pointer threader = itk::MultiThreaderBase::New();
+  threader->ParallelizeImageRegion<3>(output->GetLargestPossibleRegion(),
+    [&inputBuffers, outputBuffer, output](const ImageType::RegionType& region)
+    {
+    const itk::SizeValueType rowLength = region.GetSize(0);
+    ImageType::IndexType rowIndex = region.GetIndex();
+    for (itk::SizeValueType z = 0; z < region.GetSize(2); ++z)
       {
-      continue;
+      rowIndex[2] = region.GetIndex(2) + z;
+      for (itk::SizeValueType y = 0; y < region.GetSize(1); ++y)
+        {
+        rowIndex[1] = region.GetIndex(1) + y;
+        const itk::OffsetValueType rowOffset = output->ComputeOffset(rowIndex);
+        PixelType* outRow = outputBuffer + rowOffset;
+        for (const PixelType* inputBuffer : inputBuffers)
+          {
+          const PixelType* inRow = inputBuffer + rowOffset;
+          for (itk::SizeValueType x = 0; x < rowLength; ++x)
+            {
+            outRow[x] = inRow[x] ? inRow[x] : outRow[x];
+            }
+          }
+        }
       }
-    itOut.Set(itIn.Get() );
-    }
+    },
+    nullptr);
 
   writer->SetInput(output);
   writer->SetUseCompression(true);
@@ -10,13 +10,11 @@
 =========================================================================*/
 #include "itkImageFileWriter.h"
 
-#include "itkMaskImageFilter.h"
-#include "itkThresholdImageFilter.h"
-
 #include "itkNearestNeighborInterpolateImageFunction.h"
 #include "itkResampleImageFilter.h"
 
 #include "itkPluginUtilities.h"
+#include "itkPluginVoxelwiseOperations.h"
 #include "MaskScalarVolumeCLP.h"
 
 // Use an anonymous namespace to keep class types and function names
@@ -44,11 +42,6 @@ int DoIt( int argc, char * argv[] )
 
   typedef itk::NearestNeighborInterpolateImageFunction<InputImageType> Interpolator;
   typedef itk::ResampleImageFilter<InputImageType, OutputImageType>    ResampleType;
-  typedef itk::MaskImageFilter<
-    InputImageType, InputImageType, OutputImageType>  FilterType;
-
-  typedef itk::ThresholdImageFilter<
-    InputImageType>  ThresholdFilterType;
 
   typename ReaderType::Pointer reader1 = ReaderType::New();
   itk::PluginFilterWatcher watchReader1(reader1, "Read Input Volume",
@@ -65,45 +58,47 @@ int DoIt( int argc, char * argv[] )
   reader1->Update();
   reader2->Update();
 
-  // have to threshold the mask volume
-  typename ThresholdFilterType::Pointer thresholdFilter = ThresholdFilterType::New();
-  itk::PluginFilterWatcher watchThresholdFilter(thresholdFilter,
-                                                "Threshold Image",
-                                                CLPProcessInformation);
-
-  thresholdFilter->SetInput(0, reader2->GetOutput() );
-  thresholdFilter->SetOutsideValue(0);
-  thresholdFilter->ThresholdOutside(Label, Label);
-  thresholdFilter->ReleaseDataFlagOn();
-
-  typename Interpolator::Pointer interp = Interpolator::New();
-  interp->SetInputImage(thresholdFilter->GetOutput() );
-
-  typename ResampleType::Pointer resample = ResampleType::New();
-  resample->SetInput(thresholdFilter->GetOutput() );
-  resample->SetOutputParametersFromImage(reader1->GetOutput() );
-  resample->SetInterpolator( interp );
-  resample->SetDefaultPixelValue( 0 );
-  resample->ReleaseDataFlagOn();
-
-  itk::PluginFilterWatcher watchResample(resample, "Resampling",
-                                         CLPProcessInformation);
-
-  typename FilterType::Pointer filter = FilterType::New();
-  itk::PluginFilterWatcher watchFilter(filter,
-                                       "Masking",
-                                       CLPProcessInformation);
+  // The result is computed in the buffer of the input volume
+  typename InputImageType::Pointer image = reader1->GetOutput();
+  image->DisconnectPipeline();
 
-  filter->SetInput( 0, reader1->GetOutput() );
-  filter->SetInput( 1, resample->GetOutput() );
-  filter->SetOutsideValue( Replace );
+  // Interpolate the mask volume only if its grid is different
+  typename InputImageType::Pointer mask = reader2->GetOutput();
+  if (!itk::ImageGeometriesMatch(image.GetPointer(), mask.GetPointer()))
+    {
+    typename Interpolator::Pointer interp = Interpolator::New();
+    interp->SetInputImage(reader2->GetOutput() );
+
+    typename ResampleType::Pointer resample = ResampleType::New();
+    resample->SetInput(reader2->GetOutput() );
+    resample->SetOutputParametersFromImage(image );
+    resample->SetInterpolator( interp );
+    resample->SetDefaultPixelValue( 0 );
+
+    itk::PluginFilterWatcher watchResample(resample, "Resampling",
+                                           CLPProcessInformation);
+    resample->Update();
+    mask = resample->GetOutput();
+    }
+
+  // Keep the input value where the mask is equal to the label value, set the replace value elsewhere.
+  // Thresholding of the mask and masking are done in a single pass.
+  const InputPixelType label = static_cast<InputPixelType>(Label);
+  const OutputPixelType replace = static_cast<OutputPixelType>(Replace);
+  const bool labelIsZero = (label == itk::NumericTraits<InputPixelType>::ZeroValue());
+  itk::BinaryVoxelwiseOperationInPlace(image.GetPointer(), mask.GetPointer(),
+    [label, replace, labelIsZero](InputPixelType value, InputPixelType maskValue)
+      {
+      return (maskValue == label && !labelIsZero) ? value : replace;
+      });
+  mask = nullptr;
 
   typename WriterType::Pointer writer = WriterType::New();
   itk::PluginFilterWatcher watchWriter(writer,
                                        "Write Volume",
                                        CLPProcessInformation);
   writer->SetFileName( OutputVolume.c_str() );
-  writer->SetInput( filter->GetOutput() );
+  writer->SetInput( image );
   writer->SetUseCompression(1);
   writer->Update();
 
@@ -17,6 +17,7 @@
 #include "itkPluginUtilities.h"
 #include "itkImageFileWriter.h"
 #include "itkMedianImageFilter.h"
+#include "itkMultiThreaderBase.h"
 
 #include "MedianImageFilterCLP.h"
 
@@ -60,9 +61,24 @@ int DoIt( int argc, char * argv[], T )
   indexRadius[2] = neighborhood[2]; // radius along slice
 
   filter->SetRadius( indexRadius );
+  if( numberOfThreads > 0 )
+    {
+    filter->SetNumberOfWorkUnits( numberOfThreads );
+    }
   filter->SetInput( reader->GetOutput() );
   writer->SetInput( filter->GetOutput() );
-  writer->SetUseCompression(1);
+  if( numberOfStreamDivisions > 1 )
+    {
+    // The writer requests the output piece by piece, the filter pads the
+    // corresponding input region by the neighborhood radius.
+    // Compressed files cannot be written in pieces.
+    writer->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+    writer->SetUseCompression(0);
+    }
+  else
+    {
+    writer->SetUseCompression(1);
+    }
   writer->Update();
   return EXIT_SUCCESS;
 }
@@ -74,6 +90,11 @@ int main( int argc, char * argv[] )
 
   PARSE_ARGS;
 
+  if( numberOfThreads > 0 )
+    {
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads( numberOfThreads );
+    }
+
   itk::ImageIOBase::IOPixelType     pixelType;
   itk::ImageIOBase::IOComponentType componentType;
 
@@ -16,6 +16,7 @@
 
 // VTK includes
 #include <vtkAppendPolyData.h>
+#include <vtkCleanPolyData.h>
 
 // MRML includes
 #include "vtkMRMLModelNode.h"
@@ -49,9 +50,27 @@ int main( int argc, char * argv[] )
   add->AddInputConnection(model1Node->GetPolyDataConnection());
   add->AddInputConnection(model2Node->GetPolyDataConnection());
   add->Update();
+  vtkPolyData* mergedPolyData = add->GetOutput();
+
+  // merge coincident points
+  vtkNew<vtkCleanPolyData> cleaner;
+  if (MergePoints)
+    {
+    cleaner->SetInputData(mergedPolyData);
+    // Exactly coincident points are merged using the hashed point locator of vtkMergePoints
+    cleaner->ToleranceIsAbsoluteOn();
+    cleaner->SetAbsoluteTolerance(0.0);
+    cleaner->PointMergingOn();
+    // Keep degenerate cells as they are
+    cleaner->ConvertLinesToPointsOff();
+    cleaner->ConvertPolysToLinesOff();
+    cleaner->ConvertStripsToPolysOff();
+    cleaner->Update();
+    mergedPolyData = cleaner->GetOutput();
+    }
 
   vtkNew<vtkMRMLModelNode> outputModelNode;
-  outputModelNode->SetAndObservePolyData(add->GetOutput());
+  outputModelNode->SetAndObservePolyData(mergedPolyData);
   vtkNew<vtkMRMLModelStorageNode> outputModelStorageNode;
   outputModelStorageNode->SetFileName(ModelOutput.c_str());
   if (!outputModelStorageNode->WriteData(outputModelNode))
@@ -39,6 +39,7 @@ Version:   $Revision$
 #include <vtkImageAccumulate.h>
 #include <vtkImageChangeInformation.h>
 #include <vtkImageConstantPad.h>
+#include <vtkImageClip.h>
 #include <vtkImageData.h>
 #include <vtkImageThreshold.h>
 #include <vtkImageToStructuredPoints.h>
@@ -49,6 +50,8 @@ Version:   $Revision$
 #include <vtkPolyDataNormals.h>
 #include <vtkPolyDataWriter.h>
 #include <vtkReverseSense.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkSmoothPolyDataFilter.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
@@ -62,6 +65,101 @@ Version:   $Revision$
 // VTKsys includes
 #include <vtksys/SystemTools.hxx>
 
+// STD includes
+#include <algorithm>
+#include <array>
+#include <map>
+
+namespace
+{
+
+/// Extent of the voxels of each label value (i_min, i_max, j_min, j_max, k_min, k_max)
+typedef std::map<int, std::array<int, 6> > LabelExtentMap;
+
+//----------------------------------------------------------------------------
+template <class T>
+void ComputeLabelExtentsGeneric(vtkImageData* image, T* scalars, LabelExtentMap& labelExtents)
+{
+  int* extent = image->GetExtent();
+  vtkIdType increments[3] = { 0, 0, 0 };
+  image->GetIncrements(increments);
+  vtkSMPThreadLocal<LabelExtentMap> threadLabelExtents;
+  vtkSMPTools::For(extent[4], extent[5] + 1, [&](vtkIdType beginSlice, vtkIdType endSlice)
+    {
+    LabelExtentMap& localLabelExtents = threadLabelExtents.Local();
+    for (int k = static_cast<int>(beginSlice); k < static_cast<int>(endSlice); ++k)
+      {
+      for (int j = extent[2]; j <= extent[3]; ++j)
+        {
+        T* voxel = scalars + (k - extent[4]) * increments[2] + (j - extent[2]) * increments[1];
+        int i = extent[0];
+        while (i <= extent[1])
+          {
+          // Process runs of voxels of the same label at once
+          int label = static_cast<int>(*voxel);
+          int runStart = i;
+          for (; i <= extent[1] && static_cast<int>(*voxel) == label; ++i, voxel += increments[0])
+            {
+            }
+          LabelExtentMap::iterator labelExtentIt = localLabelExtents.find(label);
+          if (labelExtentIt == localLabelExtents.end())
+            {
+            localLabelExtents[label] = { runStart, i - 1, j, j, k, k };
+            continue;
+            }
+          std::array<int, 6>& labelExtent = labelExtentIt->second;
+          labelExtent[0] = std::min(labelExtent[0], runStart);
+          labelExtent[1] = std::max(labelExtent[1], i - 1);
+          labelExtent[2] = std::min(labelExtent[2], j);
+          labelExtent[3] = std::max(labelExtent[3], j);
+          labelExtent[4] = std::min(labelExtent[4], k);
+          labelExtent[5] = std::max(labelExtent[5], k);
+          }
+        }
+      }
+    });
+
+  labelExtents.clear();
+  for (LabelExtentMap& localLabelExtents : threadLabelExtents)
+    {
+    for (LabelExtentMap::value_type& localLabelExtent : localLabelExtents)
+      {
+      LabelExtentMap::iterator labelExtentIt = labelExtents.find(localLabelExtent.first);
+      if (labelExtentIt == labelExtents.end())
+        {
+        labelExtents.insert(localLabelExtent);
+        continue;
+        }
+      for (int axis = 0; axis < 3; ++axis)
+        {
+        labelExtentIt->second[axis * 2] = std::min(labelExtentIt->second[axis * 2], localLabelExtent.second[axis * 2]);
+        labelExtentIt->second[axis * 2 + 1] = std::max(labelExtentIt->second[axis * 2 + 1], localLabelExtent.second[axis * 2 + 1]);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Get the extent of all the label values in a single pass over the image
+void ComputeLabelExtents(vtkImageData* image, LabelExtentMap& labelExtents)
+{
+  labelExtents.clear();
+  void* scalars = image->GetScalarPointer();
+  if (scalars == nullptr)
+    {
+    return;
+    }
+  switch (image->GetScalarType())
+    {
+    vtkTemplateMacro(ComputeLabelExtentsGeneric<VTK_TT>(image, static_cast<VTK_TT*>(scalars), labelExtents));
+    default:
+      std::cerr << "ERROR: unsupported scalar type " << image->GetScalarTypeAsString() << std::endl;
+      break;
+    }
+}
+
+} // end of anonymous namespace
+
 int main(int argc, char * argv[])
 {
   PARSE_ARGS;
@@ -871,10 +969,27 @@ int main(int argc, char * argv[])
       loopLabels.push_back(Labels[i]);
       }
     }
+
+  // Compute the bounding box of all the labels in one pass over the image, so that
+  // each label is thresholded and contoured only within its bounding box instead of
+  // processing the entire image for each label.
+  LabelExtentMap labelExtents;
+  vtkImageData* labelImage = image;
+  if (JointSmoothing == 0)
+    {
+    if (Pad)
+      {
+      padder->Update();
+      labelImage = padder->GetOutput();
+      }
+    ComputeLabelExtents(labelImage, labelExtents);
+    }
+
   for(::size_t l = 0; l < loopLabels.size(); l++)
     {
     // get the label out of the vector
     int i = loopLabels[l];
+    vtkSmartPointer<vtkImageClip> labelClipper;
 
     if (makeMultiple)
       {
@@ -1002,7 +1117,25 @@ int main(int argc, char * argv[])
         {
         watchImageThreshold.QuietOn();
         }
-      if (Pad)
+      LabelExtentMap::iterator labelExtentIt = labelExtents.find(i);
+      if (labelExtentIt != labelExtents.end())
+        {
+        // Crop to the bounding box of the label, with a margin of one voxel to
+        // get the same closed surface as from the entire image
+        int* wholeExtent = labelImage->GetExtent();
+        int clipExtent[6] = { 0, -1, 0, -1, 0, -1 };
+        for (int axis = 0; axis < 3; ++axis)
+          {
+          clipExtent[axis * 2] = std::max(labelExtentIt->second[axis * 2] - 1, wholeExtent[axis * 2]);
+          clipExtent[axis * 2 + 1] = std::min(labelExtentIt->second[axis * 2 + 1] + 1, wholeExtent[axis * 2 + 1]);
+          }
+        labelClipper = vtkSmartPointer<vtkImageClip>::New();
+        labelClipper->SetInputData(labelImage);
+        labelClipper->SetOutputWholeExtent(clipExtent);
+        labelClipper->ClipDataOn();
+        imageThreshold->SetInputConnection(labelClipper->GetOutputPort());
+        }
+      else if (Pad)
         {
         imageThreshold->SetInputConnection(padder->GetOutputPort());
         }
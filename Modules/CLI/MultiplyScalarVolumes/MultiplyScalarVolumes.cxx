@@ -12,9 +12,9 @@
 
 #include "itkResampleImageFilter.h"
 #include "itkBSplineInterpolateImageFunction.h"
-#include "itkConstrainedValueMultiplicationImageFilter.h"
 
 #include "itkPluginUtilities.h"
+#include "itkPluginVoxelwiseOperations.h"
 #include "MultiplyScalarVolumesCLP.h"
 
 // Use an anonymous namespace to keep class types and function names
@@ -42,7 +42,6 @@ int DoIt( int argc, char * argv[], T )
 
   typedef itk::BSplineInterpolateImageFunction<InputImageType>                                             Interpolator;
   typedef itk::ResampleImageFilter<InputImageType, OutputImageType>                                        ResampleType;
-  typedef itk::ConstrainedValueMultiplicationImageFilter<InputImageType, OutputImageType, OutputImageType> FilterType;
 
   typename ReaderType::Pointer reader1 = ReaderType::New();
   itk::PluginFilterWatcher watchReader1(reader1, "Read Volume 1",
@@ -59,33 +58,44 @@ int DoIt( int argc, char * argv[], T )
   reader1->Update();
   reader2->Update();
 
-  typename Interpolator::Pointer interp = Interpolator::New();
-  interp->SetInputImage(reader2->GetOutput() );
-  interp->SetSplineOrder(order);
+  // The result is computed in the buffer of the first volume
+  typename InputImageType::Pointer image1 = reader1->GetOutput();
+  image1->DisconnectPipeline();
 
-  typename ResampleType::Pointer resample = ResampleType::New();
-  resample->SetInput(reader2->GetOutput() );
-  resample->SetOutputParametersFromImage(reader1->GetOutput() );
-  resample->SetInterpolator( interp );
-  resample->SetDefaultPixelValue( 0 );
-  resample->ReleaseDataFlagOn();
-
-  itk::PluginFilterWatcher watchResample(resample, "Resampling",
-                                         CLPProcessInformation);
-
-  typename FilterType::Pointer filter = FilterType::New();
-  filter->SetInput1( reader1->GetOutput() );
-  filter->SetInput2( resample->GetOutput() );
+  // Interpolate the second volume only if its grid is different
+  typename InputImageType::Pointer image2 = reader2->GetOutput();
+  if (!itk::ImageGeometriesMatch(image1.GetPointer(), image2.GetPointer()))
+    {
+    typename Interpolator::Pointer interp = Interpolator::New();
+    interp->SetInputImage(reader2->GetOutput() );
+    interp->SetSplineOrder(order);
+
+    typename ResampleType::Pointer resample = ResampleType::New();
+    resample->SetInput(reader2->GetOutput() );
+    resample->SetOutputParametersFromImage(image1 );
+    resample->SetInterpolator( interp );
+    resample->SetDefaultPixelValue( 0 );
+
+    itk::PluginFilterWatcher watchResample(resample, "Resampling",
+                                           CLPProcessInformation);
+    resample->Update();
+    image2 = resample->GetOutput();
+    }
 
-  itk::PluginFilterWatcher watchFilter(filter, "Multiplying",
-                                       CLPProcessInformation);
+  // Multiply the volumes, with the result clamped to the range of the output type
+  itk::BinaryVoxelwiseOperationInPlace(image1.GetPointer(), image2.GetPointer(),
+    [](InputPixelType value1, InputPixelType value2)
+      {
+      return itk::ClampToPixelType<OutputPixelType>(static_cast<double>(value1) * static_cast<double>(value2));
+      });
+  image2 = nullptr;
 
   typename WriterType::Pointer writer = WriterType::New();
   itk::PluginFilterWatcher watchWriter(writer,
                                        "Write Volume",
                                        CLPProcessInformation);
   writer->SetFileName( outputVolume.c_str() );
-  writer->SetInput( filter->GetOutput() );
+  writer->SetInput( image1 );
   writer->SetUseCompression(1);
   writer->Update();
 
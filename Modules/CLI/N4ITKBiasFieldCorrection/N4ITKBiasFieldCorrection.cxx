@@ -1,6 +1,7 @@
 #include "itkConstantPadImageFilter.h"
-#include "itkExtractImageFilter.h"
+#include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
+#include "itkMultiThreaderBase.h"
 #include "itkN4BiasFieldCorrectionImageFilter.h"
 #include "itkOtsuThresholdImageFilter.h"
 #include "itkShrinkImageFilter.h"
@@ -8,6 +9,10 @@
 #include "N4ITKBiasFieldCorrectionCLP.h"
 #include "itkPluginUtilities.h"
 
+// STD includes
+#include <algorithm>
+#include <cmath>
+
 namespace
 {
 
@@ -15,6 +20,9 @@ typedef float RealType;
 const int ImageDimension = 3;
 typedef itk::Image<RealType, ImageDimension> ImageType;
 
+// Number of slices of the full resolution bias field that are reconstructed at once
+const itk::SizeValueType NumberOfSlicesPerSlab = 16;
+
 template <class TFilter>
 class CommandIterationUpdate : public itk::Command
 {
@@ -65,6 +73,14 @@ int main(int argc, char* * argv)
 
   PARSE_ARGS;
 
+  if( numberOfThreads > 0 )
+    {
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads( numberOfThreads );
+    }
+
+  // If a previously computed bias field is reused then only the input image is needed
+  const bool estimateBiasField = inputBiasFieldLatticeName.empty();
+
   ImageType::Pointer inputImage = nullptr;
 
   typedef itk::Image<unsigned char, ImageDimension> MaskImageType;
@@ -72,6 +88,10 @@ int main(int argc, char* * argv)
 
   typedef    itk::N4BiasFieldCorrectionImageFilter<ImageType, MaskImageType, ImageType> CorrecterType;
   CorrecterType::Pointer correcter = CorrecterType::New();
+  if( numberOfThreads > 0 )
+    {
+    correcter->SetNumberOfWorkUnits( numberOfThreads );
+    }
 
   typedef itk::ImageFileReader<ImageType> ReaderType;
   ReaderType::Pointer reader = ReaderType::New();
@@ -84,7 +104,7 @@ int main(int argc, char* * argv)
    * handle he mask image
    */
 
-  if( maskImageName != "" )
+  if( estimateBiasField && maskImageName != "" )
     {
     typedef itk::ImageFileReader<MaskImageType> ReaderType;
     ReaderType::Pointer maskreader = ReaderType::New();
@@ -109,7 +129,7 @@ int main(int argc, char* * argv)
     correcter->SetMaskLabel(maskLabel);
     }
 
-  if( !maskImage )
+  if( estimateBiasField && !maskImage )
     {
     std::cout << "Mask no read.  Creaing Otsu mask." << std::endl;
     typedef itk::OtsuThresholdImageFilter<ImageType, MaskImageType>
@@ -126,7 +146,7 @@ int main(int argc, char* * argv)
 
   ImageType::Pointer weightImage = nullptr;
 
-  if( weightImageName != "" )
+  if( estimateBiasField && weightImageName != "" )
     {
     typedef itk::ImageFileReader<ImageType> ReaderType;
     ReaderType::Pointer weightreader = ReaderType::New();
@@ -206,14 +226,17 @@ int main(int argc, char* * argv)
     padder->Update();
     inputImage = padder->GetOutput();
 
-    typedef itk::ConstantPadImageFilter<MaskImageType, MaskImageType> MaskPadderType;
-    MaskPadderType::Pointer maskPadder = MaskPadderType::New();
-    maskPadder->SetInput( maskImage );
-    maskPadder->SetPadLowerBound( lowerBound );
-    maskPadder->SetPadUpperBound( upperBound );
-    maskPadder->SetConstant( 0 );
-    maskPadder->Update();
-    maskImage = maskPadder->GetOutput();
+    if( maskImage )
+      {
+      typedef itk::ConstantPadImageFilter<MaskImageType, MaskImageType> MaskPadderType;
+      MaskPadderType::Pointer maskPadder = MaskPadderType::New();
+      maskPadder->SetInput( maskImage );
+      maskPadder->SetPadLowerBound( lowerBound );
+      maskPadder->SetPadUpperBound( upperBound );
+      maskPadder->SetConstant( 0 );
+      maskPadder->Update();
+      maskImage = maskPadder->GetOutput();
+      }
 
     if( weightImage )
       {
@@ -237,77 +260,108 @@ int main(int argc, char* * argv)
     correcter->SetNumberOfControlPoints( numberOfControlPoints );
     }
 
-  typedef itk::ShrinkImageFilter<ImageType, ImageType> ShrinkerType;
-  ShrinkerType::Pointer shrinker = ShrinkerType::New();
-  shrinker->SetInput( inputImage );
-  shrinker->SetShrinkFactors( 1 );
-
-  typedef itk::ShrinkImageFilter<MaskImageType, MaskImageType> MaskShrinkerType;
-  MaskShrinkerType::Pointer maskshrinker = MaskShrinkerType::New();
-  maskshrinker->SetInput( maskImage );
-  maskshrinker->SetShrinkFactors( 1 );
-
-  shrinker->SetShrinkFactors( shrinkFactor );
-  maskshrinker->SetShrinkFactors( shrinkFactor );
-  shrinker->Update();
-  maskshrinker->Update();
-
-  itk::TimeProbe timer;
-  timer.Start();
-
-  correcter->SetInput( shrinker->GetOutput() );
-  correcter->SetMaskImage( maskshrinker->GetOutput() );
-  if( weightImage )
+  typedef CorrecterType::BiasFieldControlPointLatticeType LatticeType;
+  LatticeType::Pointer lattice;
+  if( !estimateBiasField )
     {
-    typedef itk::ShrinkImageFilter<ImageType, ImageType> WeightShrinkerType;
-    WeightShrinkerType::Pointer weightshrinker = WeightShrinkerType::New();
-    weightshrinker->SetInput( weightImage );
-    weightshrinker->SetShrinkFactors( 1 );
-    weightshrinker->SetShrinkFactors( shrinkFactor );
-    weightshrinker->Update();
-    correcter->SetConfidenceImage( weightshrinker->GetOutput() );
+    typedef itk::ImageFileReader<LatticeType> LatticeReaderType;
+    LatticeReaderType::Pointer latticeReader = LatticeReaderType::New();
+    latticeReader->SetFileName( inputBiasFieldLatticeName.c_str() );
+    try
+      {
+      latticeReader->Update();
+      }
+    catch( itk::ExceptionObject & err )
+      {
+      std::cerr << "Failed to read the bias field lattice: " << err << std::endl;
+      return EXIT_FAILURE;
+      }
+    lattice = latticeReader->GetOutput();
     }
+  else
+    {
+    typedef itk::ShrinkImageFilter<ImageType, ImageType> ShrinkerType;
+    ShrinkerType::Pointer shrinker = ShrinkerType::New();
+    shrinker->SetInput( inputImage );
+    shrinker->SetShrinkFactors( 1 );
+
+    typedef itk::ShrinkImageFilter<MaskImageType, MaskImageType> MaskShrinkerType;
+    MaskShrinkerType::Pointer maskshrinker = MaskShrinkerType::New();
+    maskshrinker->SetInput( maskImage );
+    maskshrinker->SetShrinkFactors( 1 );
+
+    shrinker->SetShrinkFactors( shrinkFactor );
+    maskshrinker->SetShrinkFactors( shrinkFactor );
+    shrinker->Update();
+    maskshrinker->Update();
+
+    itk::TimeProbe timer;
+    timer.Start();
+
+    correcter->SetInput( shrinker->GetOutput() );
+    correcter->SetMaskImage( maskshrinker->GetOutput() );
+    if( weightImage )
+      {
+      typedef itk::ShrinkImageFilter<ImageType, ImageType> WeightShrinkerType;
+      WeightShrinkerType::Pointer weightshrinker = WeightShrinkerType::New();
+      weightshrinker->SetInput( weightImage );
+      weightshrinker->SetShrinkFactors( 1 );
+      weightshrinker->SetShrinkFactors( shrinkFactor );
+      weightshrinker->Update();
+      correcter->SetConfidenceImage( weightshrinker->GetOutput() );
+      }
 
-  typedef CommandIterationUpdate<CorrecterType> CommandType;
-  CommandType::Pointer observer = CommandType::New();
-  correcter->AddObserver( itk::IterationEvent(), observer );
+    typedef CommandIterationUpdate<CorrecterType> CommandType;
+    CommandType::Pointer observer = CommandType::New();
+    correcter->AddObserver( itk::IterationEvent(), observer );
 
-  /**
-   * histogram sharpening options
-   */
-  if( bfFWHM )
-    {
-    correcter->SetBiasFieldFullWidthAtHalfMaximum( bfFWHM );
-    }
-  if( wienerFilterNoise )
-    {
-    correcter->SetWienerFilterNoise( wienerFilterNoise );
-    }
-  if( nHistogramBins )
-    {
-    correcter->SetNumberOfHistogramBins( nHistogramBins );
-    }
+    /**
+     * histogram sharpening options
+     */
+    if( bfFWHM )
+      {
+      correcter->SetBiasFieldFullWidthAtHalfMaximum( bfFWHM );
+      }
+    if( wienerFilterNoise )
+      {
+      correcter->SetWienerFilterNoise( wienerFilterNoise );
+      }
+    if( nHistogramBins )
+      {
+      correcter->SetNumberOfHistogramBins( nHistogramBins );
+      }
 
-  try
-    {
-    itk::PluginFilterWatcher watchN4(correcter, "N4 Bias field correction", CLPProcessInformation, 1.0 / 1.0, 0.0);
-    correcter->Update();
-    }
-  catch( itk::ExceptionObject & err )
-    {
-    std::cerr << err << std::endl;
-    return EXIT_FAILURE;
-    }
-  catch( ... )
-    {
-    std::cerr << "Unknown Exception caught." << std::endl;
-    return EXIT_FAILURE;
-    }
+    try
+      {
+      itk::PluginFilterWatcher watchN4(correcter, "N4 Bias field correction", CLPProcessInformation, 1.0 / 1.0, 0.0);
+      correcter->Update();
+      }
+    catch( itk::ExceptionObject & err )
+      {
+      std::cerr << err << std::endl;
+      return EXIT_FAILURE;
+      }
+    catch( ... )
+      {
+      std::cerr << "Unknown Exception caught." << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    correcter->Print( std::cout, 3 );
 
-  correcter->Print( std::cout, 3 );
+    timer.Stop();
+    std::cout << "Elapsed ime: " << timer.GetMean() << std::endl;
 
-  timer.Stop();
-  std::cout << "Elapsed ime: " << timer.GetMean() << std::endl;
+    lattice = correcter->GetLogBiasFieldControlPointLattice();
+    if( outputBiasFieldLatticeName != "" )
+      {
+      typedef itk::ImageFileWriter<LatticeType> LatticeWriterType;
+      LatticeWriterType::Pointer latticeWriter = LatticeWriterType::New();
+      latticeWriter->SetFileName( outputBiasFieldLatticeName.c_str() );
+      latticeWriter->SetInput( lattice );
+      latticeWriter->Update();
+      }
+    }
 
   /**
    * output
@@ -320,68 +374,80 @@ int main(int argc, char* * argv)
      * corrected image.
      */
     typedef itk::BSplineControlPointImageFilter<
-      CorrecterType::BiasFieldControlPointLatticeType,
+      LatticeType,
       CorrecterType::ScalarImageType> BSplinerType;
     BSplinerType::Pointer bspliner = BSplinerType::New();
-    bspliner->SetInput( correcter->GetLogBiasFieldControlPointLattice() );
+    bspliner->SetInput( lattice );
     bspliner->SetSplineOrder( correcter->GetSplineOrder() );
     bspliner->SetSize( inputImage->GetLargestPossibleRegion().GetSize() );
     bspliner->SetOrigin( newOrigin );
     bspliner->SetDirection( inputImage->GetDirection() );
     bspliner->SetSpacing( inputImage->GetSpacing() );
-    bspliner->Update();
-
-    ImageType::Pointer logField = ImageType::New();
-    logField->SetOrigin( inputImage->GetOrigin() );
-    logField->SetSpacing( inputImage->GetSpacing() );
-    logField->SetRegions( inputImage->GetLargestPossibleRegion() );
-    logField->SetDirection( inputImage->GetDirection() );
-    logField->Allocate();
-
-    itk::ImageRegionIterator<CorrecterType::ScalarImageType> IB(
-      bspliner->GetOutput(),
-      bspliner->GetOutput()->GetLargestPossibleRegion() );
-    itk::ImageRegionIterator<ImageType> IF( logField,
-                                            logField->GetLargestPossibleRegion() );
-    for( IB.GoToBegin(), IF.GoToBegin(); !IB.IsAtEnd(); ++IB, ++IF )
-      {
-      IF.Set( IB.Get()[0] );
-      }
-
-    typedef itk::ExpImageFilter<ImageType, ImageType> ExpFilterType;
-    ExpFilterType::Pointer expFilter = ExpFilterType::New();
-    expFilter->SetInput( logField );
-    expFilter->Update();
-
-    typedef itk::DivideImageFilter<ImageType, ImageType, ImageType> DividerType;
-    DividerType::Pointer divider = DividerType::New();
-    divider->SetInput1( inputImage );
-    divider->SetInput2( expFilter->GetOutput() );
-    divider->Update();
 
     ImageType::RegionType inputRegion;
     inputRegion.SetIndex( inputImageIndex );
     inputRegion.SetSize( inputImageSize );
 
-    typedef itk::ExtractImageFilter<ImageType, ImageType> CropperType;
-    CropperType::Pointer cropper = CropperType::New();
-    cropper->SetInput( divider->GetOutput() );
-    cropper->SetExtractionRegion( inputRegion );
-    cropper->SetDirectionCollapseToSubmatrix();
-    cropper->Update();
-
-    CropperType::Pointer biasFieldCropper = CropperType::New();
-    biasFieldCropper->SetInput( expFilter->GetOutput() );
-    biasFieldCropper->SetExtractionRegion( inputRegion );
-    biasFieldCropper->SetDirectionCollapseToSubmatrix();
-    biasFieldCropper->Update();
+    ImageType::Pointer correctedImage = ImageType::New();
+    correctedImage->CopyInformation( inputImage );
+    correctedImage->SetRegions( inputRegion );
+    correctedImage->Allocate();
 
+    ImageType::Pointer biasField = nullptr;
     if( outputBiasFieldName != "" )
+      {
+      biasField = ImageType::New();
+      biasField->CopyInformation( inputImage );
+      biasField->SetRegions( inputRegion );
+      biasField->Allocate();
+      }
+
+    // The bias field is reconstructed in slabs of slices and applied to the
+    // input image directly, so that the full resolution bias field is not in memory.
+    // Index of the bias field image starts at 0, while the padded input image starts at the
+    // (negative) lower bound of the padding.
+    const ImageType::IndexType paddedImageIndex = inputImage->GetLargestPossibleRegion().GetIndex();
+    const itk::IndexValueType endSlice = inputRegion.GetIndex()[2]
+      + static_cast<itk::IndexValueType>( inputRegion.GetSize()[2] );
+    for( itk::IndexValueType slice = inputRegion.GetIndex()[2]; slice < endSlice;
+         slice += static_cast<itk::IndexValueType>( NumberOfSlicesPerSlab ) )
+      {
+      ImageType::RegionType slabRegion = inputRegion;
+      slabRegion.SetIndex( 2, slice );
+      slabRegion.SetSize( 2, std::min( NumberOfSlicesPerSlab, static_cast<itk::SizeValueType>( endSlice - slice ) ) );
+
+      CorrecterType::ScalarImageType::RegionType fieldRegion;
+      fieldRegion.SetSize( slabRegion.GetSize() );
+      for( unsigned d = 0; d < ImageDimension; d++ )
+        {
+        fieldRegion.SetIndex( d, slabRegion.GetIndex()[d] - paddedImageIndex[d] );
+        }
+      bspliner->GetOutput()->SetRequestedRegion( fieldRegion );
+      bspliner->GetOutput()->Update();
+
+      itk::ImageRegionConstIterator<CorrecterType::ScalarImageType> IB( bspliner->GetOutput(), fieldRegion );
+      itk::ImageRegionConstIterator<ImageType> II( inputImage, slabRegion );
+      itk::ImageRegionIterator<ImageType> IC( correctedImage, slabRegion );
+      for( IB.GoToBegin(), II.GoToBegin(), IC.GoToBegin(); !IB.IsAtEnd(); ++IB, ++II, ++IC )
+        {
+        IC.Set( II.Get() / std::exp( IB.Get()[0] ) );
+        }
+      if( biasField )
+        {
+        itk::ImageRegionIterator<ImageType> IF( biasField, slabRegion );
+        for( IB.GoToBegin(), IF.GoToBegin(); !IB.IsAtEnd(); ++IB, ++IF )
+          {
+          IF.Set( std::exp( IB.Get()[0] ) );
+          }
+        }
+      }
+
+    if( biasField )
       {
       typedef itk::ImageFileWriter<ImageType> WriterType;
       WriterType::Pointer writer = WriterType::New();
       writer->SetFileName( outputBiasFieldName.c_str() );
-      writer->SetInput( biasFieldCropper->GetOutput() );
+      writer->SetInput( biasField );
       writer->SetUseCompression(true);
       writer->Update();
       }
@@ -398,7 +464,7 @@ int main(int argc, char* * argv)
       // signed types
       const char *fname = outputImageName.c_str();
 
-      return SaveIt(cropper->GetOutput(), fname);
+      return SaveIt(correctedImage, fname);
       }
     catch( itk::ExceptionObject & e )
       {
@@ -13,28 +13,31 @@
 
 // vtkITK includes
 #include <vtkITKArchetypeImageSeriesScalarReader.h>
+#include <vtkITKImageWriter.h>
 
 // VTK includes
 #include <vtkGlobFileNames.h>
-#include <vtkImageAccumulate.h>
+#include <vtkImageCast.h>
 #include <vtkImageData.h>
-#include <vtkImageThreshold.h>
-#include <vtkImageToImageStencil.h>
+#include <vtkImageShiftScale.h>
 #include <vtkNew.h>
 #include <vtkVersion.h>
 
 // ITK includes
 #include <itkGDCMImageIO.h>
-#include <itkGDCMSeriesFileNames.h>
 #include <itkImageFileWriter.h>
-#include <itkImageSeriesReader.h>
-#include <itkImageSeriesReader.h>
 #include <itkMetaDataDictionary.h>
 #include <itkNumericSeriesFileNames.h>
+#include <itksys/Directory.hxx>
+#include <itksys/SystemTools.hxx>
 
 #undef HAVE_SSTREAM // stupid DCMTK Header issue
 #include "itkDCMTKFileReader.h"
 
+// STD includes
+#include <algorithm>
+#include <map>
+
 // ...
 // ...............................................................................................
 // ...
@@ -99,6 +102,7 @@ struct parameters
     std::string VOIVolumeColorTableFile;
     std::string parameterFile;
     std::string SUVOutputTable;
+    std::string SUVOutputVolume;
     std::string SUVOutputStringFile;
     std::string patientName;
     std::string studyDate;
@@ -737,27 +741,106 @@ double DecayCorrection(parameters & list, double inVal )
 // ...
 // ...............................................................................................
 // ...
-std::string MapLabelIDtoColorName( int id, std::string colorFile )
+bool ReadColorTable( std::string colorFile, vtkMRMLColorTableNode* colorNode )
 {
   // use the color table that was passed in with the VOI volume
-
-  std::string colorName;
-
-  vtkNew<vtkMRMLColorTableNode> colorNode;
   vtkNew<vtkMRMLColorTableStorageNode> colorStorageNode;
   colorStorageNode->SetFileName(colorFile.c_str() );
 
-  if( !colorStorageNode->ReadData(colorNode.GetPointer()) )
+  if( !colorStorageNode->ReadData(colorNode) )
     {
     std::cerr << "Error reading color file " << colorStorageNode->GetFileName() << endl;
+    return false;
     }
-  else
+  return true;
+}
+
+// ...
+// ...............................................................................................
+// ...
+std::string MapLabelIDtoColorName( int id, vtkMRMLColorTableNode* colorNode )
+{
+  std::string colorName;
+  if( colorNode != nullptr )
     {
-    colorName = colorNode->GetColorName(id);
+    const char* name = colorNode->GetColorName(id);
+    if( name != nullptr )
+      {
+      colorName = name;
+      }
     }
   return colorName;
 }
 
+// ...
+// ...............................................................................................
+// ...
+struct LabelStatistics
+{
+  vtkIdType voxelCount{0};
+  double min{VTK_DOUBLE_MAX};
+  double max{VTK_DOUBLE_MIN};
+  double sum{0.0};
+};
+
+// ...
+// ...............................................................................................
+// ...
+// Compute minimum, maximum, and sum of PET voxel values (first component) for every label value of the VOI
+// volume (that has int scalar type) in a single pass. Only the common extent of the two volumes is considered.
+template <class TPET>
+void ComputeLabelStatistics( vtkImageData* petVolume, vtkImageData* voiVolume, TPET*,
+                             std::map<int, LabelStatistics>& labelStatistics )
+{
+  int* petExtent = petVolume->GetExtent();
+  int* voiExtent = voiVolume->GetExtent();
+  int extent[6];
+  for( int i = 0; i < 3; i++ )
+    {
+    extent[2 * i] = std::max(petExtent[2 * i], voiExtent[2 * i]);
+    extent[2 * i + 1] = std::min(petExtent[2 * i + 1], voiExtent[2 * i + 1]);
+    if( extent[2 * i] > extent[2 * i + 1] )
+      {
+      return;
+      }
+    }
+  int petNumberOfComponents = petVolume->GetNumberOfScalarComponents();
+  int voiNumberOfComponents = voiVolume->GetNumberOfScalarComponents();
+
+  // Statistics of the label of the previous voxel is cached, as consecutive voxels usually belong to the same label
+  int currentLabel = 0;
+  LabelStatistics* currentStatistics = &labelStatistics[currentLabel];
+  for( int z = extent[4]; z <= extent[5]; z++ )
+    {
+    for( int y = extent[2]; y <= extent[3]; y++ )
+      {
+      TPET* petPtr = static_cast<TPET*>(petVolume->GetScalarPointer(extent[0], y, z));
+      int* voiPtr = static_cast<int*>(voiVolume->GetScalarPointer(extent[0], y, z));
+      for( int x = extent[0]; x <= extent[1]; x++ )
+        {
+        if( *voiPtr != currentLabel )
+          {
+          currentLabel = *voiPtr;
+          currentStatistics = &labelStatistics[currentLabel];
+          }
+        double value = static_cast<double>(*petPtr);
+        currentStatistics->voxelCount++;
+        currentStatistics->sum += value;
+        if( value < currentStatistics->min )
+          {
+          currentStatistics->min = value;
+          }
+        if( value > currentStatistics->max )
+          {
+          currentStatistics->max = value;
+          }
+        petPtr += petNumberOfComponents;
+        voiPtr += voiNumberOfComponents;
+        }
+      }
+    }
+}
+
 // ...
 // ...............................................................................................
 // ...
@@ -845,11 +928,6 @@ int LoadImagesAndComputeSUV( parameters & list, T )
 
   // read the DICOM dir to get the radiological data
 
-  typedef short PixelValueType;
-  typedef itk::Image< PixelValueType, 3 > VolumeType;
-  typedef itk::ImageSeriesReader< VolumeType > VolumeReaderType;
-  typedef itk::GDCMSeriesFileNames InputNamesGeneratorType;
-
   if ( !list.PETDICOMPath.compare(""))
     {
     std::cerr << "GetParametersFromDicomHeader:Got empty list.PETDICOMPath." << std::endl;
@@ -882,12 +960,37 @@ int LoadImagesAndComputeSUV( parameters & list, T )
     }
 
 
-  InputNamesGeneratorType::Pointer inputNames = InputNamesGeneratorType::New();
-  inputNames->SetUseSeriesDetails(true);
-  inputNames->SetDirectory(list.PETDICOMPath);
-  itk::SerieUIDContainer seriesUIDs = inputNames->GetSeriesUIDs();
-
-  const VolumeReaderType::FileNamesContainer & filenames = inputNames->GetFileNames(seriesUIDs[0]);
+  // All parameters that are needed for SUV computation are series-level attributes, so they are read
+  // from the header of a single file. We do not sort the series (GDCMSeriesFileNames would parse
+  // the header of every file in the directory), only look for the first DICOM file.
+  std::string headerFileName;
+  itksys::Directory petDICOMDirectory;
+  if (petDICOMDirectory.Load(list.PETDICOMPath.c_str()))
+    {
+    std::vector<std::string> petDICOMFileNames;
+    for (unsigned long fileIndex = 0; fileIndex < petDICOMDirectory.GetNumberOfFiles(); ++fileIndex)
+      {
+      std::string fileName = list.PETDICOMPath + "/" + petDICOMDirectory.GetFile(fileIndex);
+      if (!itksys::SystemTools::FileIsDirectory(fileName))
+        {
+        petDICOMFileNames.push_back(fileName);
+        }
+      }
+    std::sort(petDICOMFileNames.begin(), petDICOMFileNames.end());
+    for (const std::string& fileName : petDICOMFileNames)
+      {
+      if (itk::DCMTKFileReader::IsImageFile(fileName))
+        {
+        headerFileName = fileName;
+        break;
+        }
+      }
+    }
+  if (headerFileName.empty())
+    {
+    std::cerr << "No DICOM file found in " << list.PETDICOMPath << std::endl;
+    return EXIT_FAILURE;
+    }
 
   std::string tag;
   std::string yearstr;
@@ -908,7 +1011,7 @@ int LoadImagesAndComputeSUV( parameters & list, T )
 */
     int parsingDICOM = 0;
     itk::DCMTKFileReader fileReader;
-    fileReader.SetFileName(filenames[0]);
+    fileReader.SetFileName(headerFileName);
     fileReader.LoadFile();
 
     itk::DCMTKSequence seq;
@@ -1336,6 +1439,45 @@ int LoadImagesAndComputeSUV( parameters & list, T )
     return EXIT_FAILURE;
     }
 
+  // --- we want to use the following units as noted at file top:
+  // --- CPET(t) -- tissue radioactivity in pixels-- kBq/mlunits
+  // --- injectced dose-- MBq and
+  // --- patient weight-- kg.
+  // --- computed SUV should be in units g/ml
+  // --- The conversion is the same for all voxels: SUV = CPET * tissueConversionFactor * weight / dose
+  double tissueConversionFactor = ConvertRadioactivityUnits(1, list.radioactivityUnits.c_str(), "kBq");
+  double dose = ConvertRadioactivityUnits( list.injectedDose, list.radioactivityUnits.c_str(), "MBq");
+  dose = DecayCorrection(list, dose);
+  double weight = ConvertWeightUnits( list.patientWeight, list.weightUnits.c_str(), "kg");
+  if( dose == 0.0 )
+    {
+    std::cerr << "Warning: got an injected dose of 0.0. Results of SUV computation not valid." << std::endl;
+    }
+
+  // --- write SUV volume
+  if( !list.SUVOutputVolume.empty() )
+    {
+    if( dose == 0.0 )
+      {
+      std::cerr << "ERROR: cannot compute SUV volume, the injected dose is 0.0." << std::endl;
+      return EXIT_FAILURE;
+      }
+    // vtkImageShiftScale is multi-threaded
+    vtkNew<vtkImageShiftScale> suvScale;
+    suvScale->SetInputConnection(petVolumeConnection);
+    suvScale->SetScale(tissueConversionFactor * weight / dose);
+    suvScale->SetOutputScalarTypeToFloat();
+    suvScale->Update();
+
+    vtkNew<vtkITKImageWriter> suvWriter;
+    suvWriter->SetInputConnection(suvScale->GetOutputPort());
+    suvWriter->SetFileName(list.SUVOutputVolume.c_str());
+    suvWriter->SetRasToIJKMatrix(reader1->GetRasToIjkMatrix());
+    suvWriter->SetUseCompression(1);
+    suvWriter->Write();
+    std::cout << "Wrote SUV volume to " << list.SUVOutputVolume.c_str() << std::endl;
+    }
+
   double suvmax, suvmin, suvmean;
 
   // make up a string with output to return
@@ -1345,179 +1487,130 @@ int LoadImagesAndComputeSUV( parameters & list, T )
   std::string outputSUVMeanString = "SUVMean = ";
   std::string outputSUVMinString = "SUVMin = ";
 
-  // --- find the max and min label in mask
-  vtkImageAccumulate *stataccum = vtkImageAccumulate::New();
-  stataccum->SetInputConnection( voiVolumeConnection );
-  stataccum->Update();
-  int lo = static_cast<int>(stataccum->GetMin()[0]);
-  int hi = static_cast<int>(stataccum->GetMax()[0]);
-  stataccum->Delete();
+  // --- compute statistics of all labels in a single pass over the volumes
+  vtkNew<vtkImageCast> voiCast;
+  voiCast->SetInputConnection( voiVolumeConnection );
+  voiCast->SetOutputScalarTypeToInt();
+  voiCast->Update();
+  std::map<int, LabelStatistics> labelStatistics;
+  switch( petVolume->GetScalarType() )
+    {
+    vtkTemplateMacro(ComputeLabelStatistics(petVolume, voiCast->GetOutput(), static_cast<VTK_TT*>(nullptr), labelStatistics));
+    default:
+      std::cerr << "ComputeSUV: unsupported PET volume scalar type." << std::endl;
+      return EXIT_FAILURE;
+    }
+  // --- eliminate 0 (background) label.
+  labelStatistics.erase(0);
+  int hi = labelStatistics.empty() ? 0 : labelStatistics.rbegin()->first;
+
+  // --- read the color table only once
+  vtkNew<vtkMRMLColorTableNode> colorNode;
+  bool colorTableRead = ReadColorTable(list.VOIVolumeColorTableFile, colorNode);
+
+  // open file containing suvs and append to it.
+  if( outputFile.compare("") != 0 && !labelStatistics.empty() )
+    {
+    ofile.open( outputFile.c_str(), ios::out | ios::app );
+    if( !ofile.is_open() )
+      {
+      // report error, clean up, and get out.
+      std::cerr << "ERROR: cannot open nuclear medicine output csv parameter file '" << outputFile.c_str() << "', see return strings for values" << std::endl;
+      }
+    else
+      {
+      ofile.seekp(0,ios::end);
+      long pos = ofile.tellp();
+      if (pos == 0)
+        {
+        ofile << "patientID,studyDate,dose,labelID,suvmin,suvmax,suvmean,labelName" << std::endl;
+        }
+      }
+    }
 
   std::string labelName;
   int         NumberOfVOIs = 0;
-  for( int i = lo; i <= hi; i++ )
+  for( std::map<int, LabelStatistics>::const_iterator labelIt = labelStatistics.begin(); labelIt != labelStatistics.end(); ++labelIt )
     {
+    int i = labelIt->first;
+    const LabelStatistics& labelstat = labelIt->second;
     std::stringstream ss;
-    if( i == 0 )
-      {
-      // --- eliminate 0 (background) label.
-      continue;
-      }
 
+    // --- get label name from labelID
     labelName.clear();
-    labelName = MapLabelIDtoColorName(i, list.VOIVolumeColorTableFile);
+    labelName = MapLabelIDtoColorName(i, colorTableRead ? colorNode.GetPointer() : nullptr);
     if( labelName.empty() )
       {
       labelName.clear();
       labelName = "unknown";
       }
 
-    // --- get label name from labelID
-
     suvmax = 0.0;
     suvmean = 0.0;
 
-    // create the binary volume of the label
-    vtkImageThreshold *thresholder = vtkImageThreshold::New();
-    thresholder->SetInputConnection(voiVolumeConnection);
-    thresholder->SetInValue(1);
-    thresholder->SetOutValue(0);
-    thresholder->ReplaceOutOn();
-    thresholder->ThresholdBetween(i, i);
-    thresholder->SetOutputScalarType(petVolume->GetScalarType() );
-    thresholder->Update();
-
-    // use vtk's statistics class with the binary labelmap as a stencil
-    vtkImageToImageStencil *stencil = vtkImageToImageStencil::New();
-    stencil->SetInputConnection(thresholder->GetOutputPort() );
-    stencil->ThresholdBetween(1, 1);
-
-    vtkImageAccumulate *labelstat = vtkImageAccumulate::New();
-    labelstat->SetInputConnection(petVolumeConnection);
-    labelstat->SetInputConnection(1, stencil->GetOutputPort() ); // == SetStencilData()
-    labelstat->Update();
-
-    stencil->Delete();
-
     // --- For how many labels was SUV computed?
+    NumberOfVOIs++;
 
-    int voxNumber = labelstat->GetVoxelCount();
-    if( voxNumber > 0 )
-      {
-      NumberOfVOIs++;
-
-      double CPETmin = (labelstat->GetMin() )[0];
-      double CPETmax = (labelstat->GetMax() )[0];
-      double CPETmean = (labelstat->GetMean() )[0];
-
-      // --- we want to use the following units as noted at file top:
-      // --- CPET(t) -- tissue radioactivity in pixels-- kBq/mlunits
-      // --- injectced dose-- MBq and
-      // --- patient weight-- kg.
-      // --- computed SUV should be in units g/ml
-      double weight = list.patientWeight;
-      double dose = list.injectedDose;
-
-      // --- do some error checking and reporting.
-      if( list.radioactivityUnits.c_str() == nullptr )
-        {
-        std::cerr << "ComputeSUV: Got null radioactivityUnits." << std::endl;
-        return EXIT_FAILURE;
-        }
-      if( dose == 0.0 )
-        {
-        std::cerr << "ComputeSUV: Got nullptr dose!" << std::endl;
-        return EXIT_FAILURE;
-        }
-      if( weight == 0.0 )
-        {
-        std::cerr << "ComputeSUV: got zero weight!" << std::endl;
-        return EXIT_FAILURE;
-        }
+    double CPETmin = labelstat.min;
+    double CPETmax = labelstat.max;
+    double CPETmean = labelstat.sum / labelstat.voxelCount;
 
-      double tissueConversionFactor = ConvertRadioactivityUnits(1, list.radioactivityUnits.c_str(), "kBq");
-      dose  = ConvertRadioactivityUnits( dose, list.radioactivityUnits.c_str(), "MBq");
-      dose = DecayCorrection(list, dose);
-      weight = ConvertWeightUnits( weight, list.weightUnits.c_str(), "kg");
-
-      // --- check a possible multiply by slope -- take intercept into account?
-      if( dose == 0.0 )
-        {
-        // oops, weight by dose is infinity. make a ridiculous number.
-        suvmin = 99999999999999999.;
-        suvmax = 99999999999999999.;
-        suvmean = 99999999999999999.;
-        std::cerr << "Warning: got an injected dose of 0.0. Results of SUV computation not valid." << std::endl;
-        }
-      else
-        {
-        double weightByDose = weight / dose;
-        suvmax = (CPETmax * tissueConversionFactor) * weightByDose;
-        suvmin = (CPETmin * tissueConversionFactor ) * weightByDose;
-        suvmean = (CPETmean * tissueConversionFactor) * weightByDose;
-        }
-      // --- append to output return string file
-      std::stringstream outputStringStream;
-//      outputStringStream << list.patientName << ", " << list.studyDate << ", " << list.injectedDose  << ", "  << i << ", " << suvmax << ", " << suvmean << ", " << labelName.c_str() << ", " << ", " << ", " << ", " << std::endl;
-      std::string postfixStr = ", ";
-      if (i == hi)
-        {
-        postfixStr = "";
-        }
-      outputStringStream.str("");
-      outputStringStream << labelName.c_str() << postfixStr;
-      outputLabelString += outputStringStream.str();
-      outputStringStream.str("");
-      outputStringStream  << i << postfixStr;
-      outputLabelValueString += outputStringStream.str();
-      outputStringStream.str("");
-      outputStringStream  << suvmax << postfixStr;
-      outputSUVMaxString += outputStringStream.str();
-      outputStringStream.str("");
-      outputStringStream  << suvmean << postfixStr;
-      outputSUVMeanString += outputStringStream.str();
-      outputStringStream.str("");
-      outputStringStream << suvmin << postfixStr;
-      outputSUVMinString += outputStringStream.str();
-
-      // --- write output CSV file
-
-      // open file containing suvs and append to it.
-      if (outputFile.compare("") != 0)
-        {
-        ofile.open( outputFile.c_str(), ios::out | ios::app );
-        if( !ofile.is_open() )
-          {
-          // report error, clean up, and get out.
-          std::cerr << "ERROR: cannot open nuclear medicine output csv parameter file '" << outputFile.c_str() << "', see return strings for values" << std::endl;
-          }
-        else
-          {
-          ss.str("");
-          ofile.seekp(0,ios::end);
-          long pos = ofile.tellp();
-          if (pos == 0)
-            {
-            ss << "patientID,studyDate,dose,labelID,suvmin,suvmax,suvmean,labelName" << std::endl;
-            }
-          // --- for each value..
-          // --- format looks like:
-          // patientID, studyDate, dose, labelID, suvmin, suvmax, suvmean, labelName
-          // ...
-
-          ss << list.patientName << ", " << list.studyDate << ", " << list.injectedDose  << ", "  << i << ", " << suvmin << ", " << suvmax
-             << ", " << suvmean << ", " << labelName.c_str() << std::endl;
-          ofile << ss.str();
-          ofile.close();
-          std::cout << "Wrote output for label " << labelName.c_str() << " to " << outputFile.c_str() << std::endl;
-          }
-        }
+    // --- check a possible multiply by slope -- take intercept into account?
+    if( dose == 0.0 )
+      {
+      // oops, weight by dose is infinity. make a ridiculous number.
+      suvmin = 99999999999999999.;
+      suvmax = 99999999999999999.;
+      suvmean = 99999999999999999.;
       }
-
-
-    thresholder->Delete();
-    labelstat->Delete();
+    else
+      {
+      double weightByDose = weight / dose;
+      suvmax = (CPETmax * tissueConversionFactor) * weightByDose;
+      suvmin = (CPETmin * tissueConversionFactor ) * weightByDose;
+      suvmean = (CPETmean * tissueConversionFactor) * weightByDose;
+      }
+    // --- append to output return string file
+    std::stringstream outputStringStream;
+    std::string postfixStr = ", ";
+    if (i == hi)
+      {
+      postfixStr = "";
+      }
+    outputStringStream.str("");
+    outputStringStream << labelName.c_str() << postfixStr;
+    outputLabelString += outputStringStream.str();
+    outputStringStream.str("");
+    outputStringStream  << i << postfixStr;
+    outputLabelValueString += outputStringStream.str();
+    outputStringStream.str("");
+    outputStringStream  << suvmax << postfixStr;
+    outputSUVMaxString += outputStringStream.str();
+    outputStringStream.str("");
+    outputStringStream  << suvmean << postfixStr;
+    outputSUVMeanString += outputStringStream.str();
+    outputStringStream.str("");
+    outputStringStream << suvmin << postfixStr;
+    outputSUVMinString += outputStringStream.str();
+
+    // --- write output CSV file
+    if( ofile.is_open() )
+      {
+      // --- for each value..
+      // --- format looks like:
+      // patientID, studyDate, dose, labelID, suvmin, suvmax, suvmean, labelName
+      // ...
+      ss << list.patientName << ", " << list.studyDate << ", " << list.injectedDose  << ", "  << i << ", " << suvmin << ", " << suvmax
+         << ", " << suvmean << ", " << labelName.c_str() << std::endl;
+      ofile << ss.str();
+      std::cout << "Wrote output for label " << labelName.c_str() << " to " << outputFile.c_str() << std::endl;
+      }
+    }
+  if( ofile.is_open() )
+    {
+    ofile.close();
     }
+
   // --- write output return string file
   if (outputStringFile.compare("") != 0)
     {
@@ -1607,6 +1700,7 @@ int main( int argc, char * argv[] )
     list.VOIVolumeName = VOIVolume;
     list.VOIVolumeColorTableFile = ColorTable;
     list.SUVOutputTable = OutputCSV;
+    list.SUVOutputVolume = SUVVolume;
     // GenerateCLP makes a temporary file with the path saved to
     // returnParameterFile, write the output strings in there as key = value pairs
     list.SUVOutputStringFile = returnParameterFile;
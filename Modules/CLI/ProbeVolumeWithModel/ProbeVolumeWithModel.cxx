@@ -5,10 +5,16 @@
 #include <vtkTeemNRRDReader.h>
 
 // VTK includes
+#include <vtkCharArray.h>
+#include <vtkFieldData.h>
 #include <vtkImageData.h>
+#include <vtkMath.h>
 #include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPointSet.h>
 #include <vtkPolyData.h>
-#include <vtkProbeFilter.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
 #include <vtkTransform.h>
 #include <vtkTransformFilter.h>
 #include <vtkImageChangeInformation.h>
@@ -18,6 +24,121 @@
 
 #include <vtksys/SystemTools.hxx>
 
+// STD includes
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Sample the image at each point of the mesh with trilinear interpolation.
+// Points must be in the IJK coordinate system of the image (origin 0, spacing 1, no rotation),
+// therefore voxels are looked up directly instead of locating cells as vtkProbeFilter does,
+// and points are processed in parallel.
+// Similarly to vtkProbeFilter, the output contains the points and cells of the input mesh,
+// the interpolated image array and a vtkValidPointMask array, values of points outside of
+// the image are set to 0.
+vtkSmartPointer<vtkPointSet> ProbeImageAtPoints(vtkPointSet* mesh, vtkImageData* image)
+{
+  vtkSmartPointer<vtkPointSet> probedMesh = vtkSmartPointer<vtkPointSet>::Take(mesh->NewInstance());
+  probedMesh->CopyStructure(mesh);
+  probedMesh->GetFieldData()->PassData(mesh->GetFieldData());
+
+  vtkDataArray* imageArray = image->GetPointData()->GetScalars();
+  vtkPoints* points = mesh->GetPoints();
+  if (!imageArray || !points)
+    {
+    return probedMesh;
+    }
+  vtkIdType numberOfPoints = points->GetNumberOfPoints();
+  int numberOfComponents = imageArray->GetNumberOfComponents();
+
+  vtkSmartPointer<vtkDataArray> probedArray = vtkSmartPointer<vtkDataArray>::Take(imageArray->NewInstance());
+  probedArray->SetName(imageArray->GetName());
+  probedArray->SetNumberOfComponents(numberOfComponents);
+  probedArray->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkCharArray> validPointMask;
+  validPointMask->SetName("vtkValidPointMask");
+  validPointMask->SetNumberOfTuples(numberOfPoints);
+
+  int* extent = image->GetExtent();
+  vtkIdType increments[3] = { 1, extent[1] - extent[0] + 1, 0 };
+  increments[2] = increments[1] * (extent[3] - extent[2] + 1);
+  // vtkDataArray::InterpolateTuple rounds values of integer arrays
+  bool roundValues = (imageArray->GetDataType() != VTK_FLOAT && imageArray->GetDataType() != VTK_DOUBLE);
+  const double tolerance = 1e-6;
+
+  vtkSMPTools::For(0, numberOfPoints, [&](vtkIdType beginPointId, vtkIdType endPointId)
+    {
+    double point[3] = { 0.0, 0.0, 0.0 };
+    int baseIndex[3] = { 0, 0, 0 };
+    double distance[3] = { 0.0, 0.0, 0.0 };
+    for (vtkIdType pointId = beginPointId; pointId < endPointId; ++pointId)
+      {
+      points->GetPoint(pointId, point);
+      bool inside = true;
+      for (int axis = 0; axis < 3; ++axis)
+        {
+        int minIndex = extent[axis * 2];
+        int maxIndex = extent[axis * 2 + 1];
+        if (point[axis] < minIndex - tolerance || point[axis] > maxIndex + tolerance)
+          {
+          inside = false;
+          break;
+          }
+        double coordinate = std::min(std::max(point[axis], static_cast<double>(minIndex)), static_cast<double>(maxIndex));
+        baseIndex[axis] = std::min(static_cast<int>(std::floor(coordinate)), std::max(maxIndex - 1, minIndex));
+        distance[axis] = (maxIndex > minIndex ? coordinate - baseIndex[axis] : 0.0);
+        }
+      if (!inside)
+        {
+        for (int component = 0; component < numberOfComponents; ++component)
+          {
+          probedArray->SetComponent(pointId, component, 0.0);
+          }
+        validPointMask->SetValue(pointId, 0);
+        continue;
+        }
+      vtkIdType baseId = (baseIndex[0] - extent[0]) * increments[0]
+        + (baseIndex[1] - extent[2]) * increments[1] + (baseIndex[2] - extent[4]) * increments[2];
+      for (int component = 0; component < numberOfComponents; ++component)
+        {
+        double value = 0.0;
+        for (int corner = 0; corner < 8; ++corner)
+          {
+          double weight = 1.0;
+          vtkIdType cornerId = baseId;
+          for (int axis = 0; axis < 3; ++axis)
+            {
+            if (corner & (1 << axis))
+              {
+              weight *= distance[axis];
+              cornerId += increments[axis];
+              }
+            else
+              {
+              weight *= 1.0 - distance[axis];
+              }
+            }
+          if (weight != 0.0)
+            {
+            value += weight * imageArray->GetComponent(cornerId, component);
+            }
+          }
+        probedArray->SetComponent(pointId, component, roundValues ? vtkMath::Round(value) : value);
+        }
+      validPointMask->SetValue(pointId, 1);
+      }
+    });
+
+  probedMesh->GetPointData()->SetScalars(probedArray);
+  probedMesh->GetPointData()->AddArray(validPointMask);
+  return probedMesh;
+}
+
+}
+
 int main(int argc, char* argv[])
 {
   PARSE_ARGS;
@@ -60,14 +181,13 @@ int main(int argc, char* argv[])
   modelTransformerRasToIjk->SetTransform(transformRasToIjk);
   modelTransformerRasToIjk->SetInputConnection(modelNode->GetMeshConnection());
 
-  vtkNew<vtkProbeFilter> probe;
-  probe->SetSourceData(volume_Ijk);
-  probe->SetInputConnection(modelTransformerRasToIjk->GetOutputPort());
+  modelTransformerRasToIjk->Update();
+  vtkSmartPointer<vtkPointSet> probedMesh = ProbeImageAtPoints(modelTransformerRasToIjk->GetOutput(), volume_Ijk);
 
   // Transform the model back into RAS space
   vtkNew<vtkTransformFilter> modelTransformerIjkToRas;
   modelTransformerIjkToRas->SetTransform(transformRasToIjk->GetInverse());
-  modelTransformerIjkToRas->SetInputConnection(probe->GetOutputPort());
+  modelTransformerIjkToRas->SetInputData(probedMesh);
   modelTransformerIjkToRas->Update();
 
   // Save the output
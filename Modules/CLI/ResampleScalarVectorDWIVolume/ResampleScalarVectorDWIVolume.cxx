@@ -17,7 +17,9 @@
 #include <itkCompositeTransform.h>
 #include <itkImageFileReader.h>
 #include <itkImageFileWriter.h>
+#include <itkImageRegionIteratorWithIndex.h>
 #include <itkMetaDataObject.h>
+#include <itkMultiThreaderBase.h>
 #include <itkNearestNeighborInterpolateImageFunction.h>
 #include <itkResampleImageFilter.h>
 #include <itkBSplineInterpolateImageFunction.h>
@@ -38,6 +40,8 @@
 #include "itkWarpTransform3D.h"
 
 // STD includes
+#include <algorithm>
+#include <cmath>
 
 // Use an anonymous namespace to keep class types and function names
 // from colliding when module is used as shared object module.  Every
@@ -770,6 +774,147 @@ int SeparateImages( const typename itk::VectorImage<PixelType, 3>
   return EXIT_SUCCESS;
 }
 
+// Resample all the components of a vector image at once.
+// With nearest neighbor and linear interpolation the interpolation weights only depend on
+// the position, therefore the transform and the weights are computed once per output voxel
+// and applied to all the components, without separating the image into scalar images.
+// The output regions are processed in parallel.
+template <class PixelType>
+typename itk::VectorImage<PixelType, 3>::Pointer
+ResampleVectorImage( const typename itk::VectorImage<PixelType, 3>::Pointer & inputImage,
+                     const typename itk::ResampleImageFilter<itk::Image<PixelType, 3>,
+                                                             itk::Image<PixelType, 3> >::Pointer & resampler,
+                     bool nearestNeighbor,
+                     int numberOfThreads
+                     )
+{
+  typedef itk::VectorImage<PixelType, 3>          VectorImageType;
+  typedef typename VectorImageType::RegionType    RegionType;
+  typedef typename VectorImageType::IndexType     IndexType;
+  typedef itk::ContinuousIndex<double, 3>         ContinuousIndexType;
+  typedef itk::Transform<double, 3, 3>            TransformType;
+
+  typename VectorImageType::Pointer outputImage = VectorImageType::New();
+  RegionType outputRegion( resampler->GetOutputStartIndex(), resampler->GetSize() );
+  outputImage->SetRegions( outputRegion );
+  outputImage->SetOrigin( resampler->GetOutputOrigin() );
+  outputImage->SetSpacing( resampler->GetOutputSpacing() );
+  outputImage->SetDirection( resampler->GetOutputDirection() );
+  const unsigned int numberOfComponents = inputImage->GetNumberOfComponentsPerPixel();
+  outputImage->SetVectorLength( numberOfComponents );
+  outputImage->Allocate();
+
+  const TransformType* transform = resampler->GetTransform();
+  const double defaultPixelValue = static_cast<double>( resampler->GetDefaultPixelValue() );
+  const RegionType inputRegion = inputImage->GetLargestPossibleRegion();
+  const IndexType inputStartIndex = inputRegion.GetIndex();
+  IndexType inputEndIndex;
+  for( unsigned int d = 0; d < 3; d++ )
+    {
+    inputEndIndex[d] = inputStartIndex[d] + static_cast<itk::IndexValueType>( inputRegion.GetSize()[d] ) - 1;
+    }
+  const PixelType* inputBuffer = inputImage->GetBufferPointer();
+  const double pixelMinimum = static_cast<double>( itk::NumericTraits<PixelType>::NonpositiveMin() );
+  const double pixelMaximum = static_cast<double>( itk::NumericTraits<PixelType>::max() );
+
+  itk::MultiThreaderBase::Pointer threader = itk::MultiThreaderBase::New();
+  if( numberOfThreads > 0 )
+    {
+    threader->SetNumberOfWorkUnits( numberOfThreads );
+    }
+  threader->template ParallelizeImageRegion<3>( outputRegion,
+    [&]( const RegionType & region )
+    {
+    std::vector<double> value( numberOfComponents );
+    itk::VariableLengthVector<PixelType> outputValue( numberOfComponents );
+    typename VectorImageType::PointType outputPoint;
+    ContinuousIndexType inputContinuousIndex;
+    itk::ImageRegionIteratorWithIndex<VectorImageType> out( outputImage, region );
+    for( out.GoToBegin(); !out.IsAtEnd(); ++out )
+      {
+      outputImage->TransformIndexToPhysicalPoint( out.GetIndex(), outputPoint );
+      inputImage->TransformPhysicalPointToContinuousIndex( transform->TransformPoint( outputPoint ),
+                                                           inputContinuousIndex );
+      // Same bounds as itk::ImageFunction::IsInsideBuffer
+      bool inside = true;
+      for( unsigned int d = 0; d < 3; d++ )
+        {
+        if( !( inputContinuousIndex[d] >= inputStartIndex[d] - 0.5 && inputContinuousIndex[d] < inputEndIndex[d] + 0.5 ) )
+          {
+          inside = false;
+          break;
+          }
+        }
+      if( !inside )
+        {
+        std::fill( value.begin(), value.end(), defaultPixelValue );
+        }
+      else if( nearestNeighbor )
+        {
+        IndexType inputIndex;
+        inputIndex.CopyWithRound( inputContinuousIndex );
+        for( unsigned int d = 0; d < 3; d++ )
+          {
+          inputIndex[d] = std::min( std::max( inputIndex[d], inputStartIndex[d] ), inputEndIndex[d] );
+          }
+        const PixelType* inputPixel = inputBuffer + inputImage->ComputeOffset( inputIndex ) * numberOfComponents;
+        for( unsigned int c = 0; c < numberOfComponents; c++ )
+          {
+          value[c] = static_cast<double>( inputPixel[c] );
+          }
+        }
+      else
+        {
+        // Trilinear interpolation, neighbors outside of the image are clamped to
+        // the image boundary as in itk::LinearInterpolateImageFunction
+        IndexType baseIndex;
+        double distance[3];
+        for( unsigned int d = 0; d < 3; d++ )
+          {
+          baseIndex[d] = static_cast<itk::IndexValueType>( std::floor( inputContinuousIndex[d] ) );
+          distance[d] = inputContinuousIndex[d] - static_cast<double>( baseIndex[d] );
+          }
+        std::fill( value.begin(), value.end(), 0.0 );
+        for( unsigned int neighbor = 0; neighbor < 8; neighbor++ )
+          {
+          double weight = 1.0;
+          IndexType neighborIndex;
+          for( unsigned int d = 0; d < 3; d++ )
+            {
+            if( neighbor & ( 1 << d ) )
+              {
+              neighborIndex[d] = std::min( baseIndex[d] + 1, inputEndIndex[d] );
+              weight *= distance[d];
+              }
+            else
+              {
+              neighborIndex[d] = std::max( baseIndex[d], inputStartIndex[d] );
+              weight *= 1.0 - distance[d];
+              }
+            }
+          if( weight == 0.0 )
+            {
+            continue;
+            }
+          const PixelType* inputPixel = inputBuffer + inputImage->ComputeOffset( neighborIndex ) * numberOfComponents;
+          for( unsigned int c = 0; c < numberOfComponents; c++ )
+            {
+            value[c] += weight * static_cast<double>( inputPixel[c] );
+            }
+          }
+        }
+      // Same conversion as itk::ResampleImageFilter::CastPixelWithBoundsChecking
+      for( unsigned int c = 0; c < numberOfComponents; c++ )
+        {
+        outputValue[c] = static_cast<PixelType>( std::min( std::max( value[c], pixelMinimum ), pixelMaximum ) );
+        }
+      out.Set( outputValue );
+      }
+    },
+    nullptr );
+  return outputImage;
+}
+
 // Verify if some input parameters are null
 bool VectorIsNul( std::vector<double> vec )
 {
@@ -1225,6 +1370,12 @@ int Rotate( parameters & list )
   typename ImageType::Pointer image;
   std::vector<typename ImageType::Pointer> vectorOfImage;
   itk::MetaDataDictionary                  dico;
+  // All the components are resampled at once if the interpolation weights only depend on the position
+  const bool nearestNeighbor = !list.interpolationType.compare( "nn" );
+  const bool resampleAllComponents = nearestNeighbor || !list.interpolationType.compare( "linear" );
+  typename VectorImageType::Pointer inputImage;
+  // Image that defines the geometry of the input for computing the transform and the output geometry
+  typename ImageType::Pointer referenceImage;
   try
     {
     // open image file
@@ -1238,8 +1389,19 @@ int Rotate( parameters & list )
       }
     // Save metadata dictionary
     dico = reader->GetOutput()->GetMetaDataDictionary();
-    // Separate the vector image into a vector of images
-    SeparateImages<PixelType>( reader->GetOutput(), vectorOfImage );
+    if( resampleAllComponents )
+      {
+      inputImage = reader->GetOutput();
+      // Geometry only, the voxels are not needed
+      referenceImage = ImageType::New();
+      referenceImage->CopyInformation( inputImage );
+      }
+    else
+      {
+      // Separate the vector image into a vector of images
+      SeparateImages<PixelType>( reader->GetOutput(), vectorOfImage );
+      referenceImage = vectorOfImage[0];
+      }
     }
   catch( itk::ExceptionObject &exception )
     {
@@ -1251,12 +1413,12 @@ int Rotate( parameters & list )
   interpol = SetInterpolator<ImageType>( list );
   // Create resampler and initialize its output parameters
   typename ResampleType::Pointer resample = ResampleType::New();
-  SetOutputParameters<ImageType>( list, resample, vectorOfImage[0] );
+  SetOutputParameters<ImageType>( list, resample, referenceImage );
   TransformType::Pointer transform;
   // Load transforms and compute a merged transform
   try
     {
-    transform = SetAllTransform<ImageType>(list, resample, vectorOfImage[0]);
+    transform = SetAllTransform<ImageType>(list, resample, referenceImage);
     }
   catch (itk::ExceptionObject& exception)
     {
@@ -1269,19 +1431,33 @@ int Rotate( parameters & list )
     }
   resample->SetTransform( transform );
   resample->SetInterpolator( interpol );
-  std::vector<typename ImageType::Pointer> vectorOutputImage;
-  // Resample all the images separately
-  for( ::size_t idx = 0; idx < vectorOfImage.size(); idx++ )
-    {
-    resample->SetInput( vectorOfImage[idx] );
-    resample->Update();
-    vectorOutputImage.push_back( resample->GetOutput() );
-    vectorOutputImage[idx]->DisconnectPipeline();
+  if( list.numberOfThread )
+    {
+    resample->SetNumberOfWorkUnits( list.numberOfThread );
     }
   typename itk::VectorImage<PixelType, 3>::Pointer outputImage;
-  outputImage = itk::VectorImage<PixelType, 3>::New();
-  AddImage<PixelType>( outputImage, vectorOutputImage );
-  vectorOutputImage.clear();
+  if( resampleAllComponents )
+    {
+    outputImage = ResampleVectorImage<PixelType>( inputImage, resample, nearestNeighbor, list.numberOfThread );
+    inputImage = nullptr;
+    }
+  else
+    {
+    std::vector<typename ImageType::Pointer> vectorOutputImage;
+    // Resample all the images separately
+    for( ::size_t idx = 0; idx < vectorOfImage.size(); idx++ )
+      {
+      resample->SetInput( vectorOfImage[idx] );
+      resample->Update();
+      vectorOutputImage.push_back( resample->GetOutput() );
+      vectorOutputImage[idx]->DisconnectPipeline();
+      // the input component is not needed anymore
+      vectorOfImage[idx] = nullptr;
+      }
+    outputImage = itk::VectorImage<PixelType, 3>::New();
+    AddImage<PixelType>( outputImage, vectorOutputImage );
+    vectorOutputImage.clear();
+    }
   // If necessary, transform gradient vectors with the loaded transformations
   int dwmriProblem = CheckDWMRI( dico, transform );
   if( list.space ) // && list.transformationFile.compare( "" ) )
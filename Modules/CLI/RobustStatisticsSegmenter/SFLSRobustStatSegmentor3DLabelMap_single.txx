@@ -15,6 +15,7 @@
 
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionConstIterator.h"
+#include "itkMultiThreaderBase.h"
 
 /* ============================================================   */
 template <typename TPixel>
@@ -98,7 +99,10 @@ CSFLSRobustStatSegmentor3DLabelMap<TPixel>
 // #ifndef NDEBUG
 //     std::ofstream ff("/tmp/force.txt");
 // #endif
-  for( long i = 0; i < n; ++i )
+  // The zero level set points are processed in parallel: the level set function is
+  // not modified here and each point only writes the cached feature of its own voxel.
+  itk::MultiThreaderBase::Pointer threader = itk::MultiThreaderBase::New();
+  threader->ParallelizeArray(0, n, [&](itk::SizeValueType i)
     {
     typename CSFLSLayer::iterator itz = m_lzIterVct[i];
 
@@ -115,12 +119,13 @@ CSFLSRobustStatSegmentor3DLabelMap<TPixel>
     computeFeatureAt(idx, f);
 
     // double a = -kernelEvaluation(f);
-    double a = -kernelEvaluationUsingPDF(f);
+    cvForce[i] = -kernelEvaluationUsingPDF(f);
+    }, nullptr);
 
-    fmax = fmax > fabs(a) ? fmax : fabs(a);
+  for( long i = 0; i < n; ++i )
+    {
+    fmax = fmax > fabs(cvForce[i]) ? fmax : fabs(cvForce[i]);
     kappaMax = kappaMax > fabs(kappaOnZeroLS[i]) ? kappaMax : fabs(kappaOnZeroLS[i]);
-
-    cvForce[i] = a;
     }
 
   // std::cout<<"fmax = "<<fmax<<std::endl;
@@ -829,9 +834,11 @@ CSFLSRobustStatSegmentor3DLabelMap<TPixel>
 
     double var2 = -1.0 / (2 * stdDev * stdDev);
     double c = 1.0 / sqrt(2 * (itk::Math::pi) ) / stdDev;
-    for( TPixel a = m_inputImageIntensityMin; a <= m_inputImageIntensityMax; ++a )
+    // The density at each intensity is independent of the others
+    itk::MultiThreaderBase::Pointer threader = itk::MultiThreaderBase::New();
+    threader->ParallelizeArray(0, thisPDF.size(), [&](itk::SizeValueType ia)
       {
-      long ia = static_cast<long>(a - m_inputImageIntensityMin);
+      double a = static_cast<double>(m_inputImageIntensityMin) + static_cast<double>(ia);
 
       double pp = 0.0;
       for( long ii = 0; ii < n; ++ii )
@@ -844,7 +851,7 @@ CSFLSRobustStatSegmentor3DLabelMap<TPixel>
       pp /= n;
 
       thisPDF[ia] = pp;
-      }
+      }, nullptr);
 
     m_PDFlearnedFromSeeds.push_back(thisPDF);
     }
@@ -10,12 +10,10 @@
 =========================================================================*/
 
 // ITK includes
-#include "itkChangeLabelImageFilter.h"
 #include "itkImageFileWriter.h"
-#include "itkMaskNegatedImageFilter.h"
-#include "itkThresholdImageFilter.h"
 
 #include "itkPluginUtilities.h"
+#include "itkPluginVoxelwiseOperations.h"
 #include "ThresholdScalarVolumeCLP.h"
 
 // Use an anonymous namespace to keep class types and function names
@@ -41,80 +39,52 @@ int DoIt( int argc, char * argv[] )
   typedef itk::ImageFileReader<InputImageType>  ReaderType;
   typedef itk::ImageFileWriter<OutputImageType> WriterType;
 
-  typedef itk::ThresholdImageFilter<
-    InputImageType>  FilterType;
-  typedef itk::ImageSource<
-    InputImageType>  LastFilterType;
-  typedef itk::ChangeLabelImageFilter<InputImageType, InputImageType>
-    ChangeFilterType;
-  typedef itk::MaskNegatedImageFilter<
-    InputImageType, InputImageType>  NegateFilterType;
-
-  typename LastFilterType::Pointer lastFilter;
-  typename ChangeFilterType::Pointer changeFilter;
-  typename NegateFilterType::Pointer negateFilter;
-
   typename ReaderType::Pointer reader1 = ReaderType::New();
   itk::PluginFilterWatcher watchReader1(reader1, "Read Volume",
                                         CLPProcessInformation);
 
   reader1->SetFileName( InputVolume.c_str() );
+  reader1->Update();
 
-  typename FilterType::Pointer filter = FilterType::New();
-  lastFilter = filter;
-  itk::PluginFilterWatcher watchFilter(filter,
-                                       "Threshold image",
-                                       CLPProcessInformation);
-
-  filter->SetInput( 0, reader1->GetOutput() );
-  filter->SetOutsideValue(OutsideValue);
+  // The result is computed in the buffer of the input volume
+  typename InputImageType::Pointer image = reader1->GetOutput();
+  image->DisconnectPipeline();
 
+  // Range of values that are kept, as in itk::ThresholdImageFilter
+  InputPixelType lower = itk::NumericTraits< InputPixelType >::NonpositiveMin();
+  InputPixelType upper = itk::NumericTraits< InputPixelType >::max();
   if( ThresholdType == std::string("Outside") )
     {
-    filter->ThresholdOutside(Lower, Upper);
+    lower = static_cast<InputPixelType>(Lower);
+    upper = static_cast<InputPixelType>(Upper);
     }
   else if( ThresholdType == std::string("Below") )
     {
-    filter->ThresholdBelow(ThresholdValue);
+    lower = static_cast<InputPixelType>(ThresholdValue);
     }
   else if( ThresholdType == std::string("Above") )
     {
-    filter->ThresholdAbove(ThresholdValue);
+    upper = static_cast<InputPixelType>(ThresholdValue);
     }
+  const OutputPixelType outsideValue = static_cast<OutputPixelType>(OutsideValue);
+
+  // Thresholding and negation are done in a single pass: values within the range
+  // are kept (or replaced by the outside value if negated), other values are
+  // replaced by the outside value (or kept if negated).
+  const bool negate = Negate;
+  itk::UnaryVoxelwiseOperationInPlace(image.GetPointer(),
+    [lower, upper, outsideValue, negate](InputPixelType value)
+      {
+      bool inside = (lower <= value && value <= upper);
+      return (inside != negate) ? value : outsideValue;
+      });
 
-  if( Negate )
-    {
-    InputPixelType outsideValue =
-      (filter->GetLower() != itk::NumericTraits< InputPixelType >::NonpositiveMin()) ?
-      filter->GetLower() - 1 : filter->GetUpper() + 1;
-    filter->SetOutsideValue( outsideValue );
-    changeFilter = ChangeFilterType::New();
-    itk::PluginFilterWatcher watchChangeFilter(changeFilter,
-                                               "Relabel image",
-                                               CLPProcessInformation);
-    changeFilter->SetInput(0, filter->GetOutput());
-    changeFilter->SetChange(0, 1);
-    changeFilter->SetChange(outsideValue, 0);
-
-    // Where there is a 0 in the mask, keep the input value. Where there is
-    // a value other than 0 in the mask, set OutsideValue.
-    negateFilter = NegateFilterType::New();
-    lastFilter = negateFilter;
-    itk::PluginFilterWatcher watchNegateFilter(filter,
-                                               "Negate threshold",
-                                               CLPProcessInformation);
-
-    negateFilter->SetInput(0, reader1->GetOutput());
-    negateFilter->SetInput(1, changeFilter->GetOutput()); // filter is the mask
-    negateFilter->SetOutsideValue(OutsideValue);
-    negateFilter->Update();
-    }
   typename WriterType::Pointer writer = WriterType::New();
   itk::PluginFilterWatcher watchWriter(writer,
                                        "Write Volume",
                                        CLPProcessInformation);
   writer->SetFileName( OutputVolume.c_str() );
-  writer->SetInput( lastFilter->GetOutput() );
+  writer->SetInput( image );
   writer->SetUseCompression(1);
   writer->Update();
 
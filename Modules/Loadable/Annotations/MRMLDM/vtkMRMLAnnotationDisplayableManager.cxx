@@ -462,7 +462,8 @@ void vtkMRMLAnnotationDisplayableManager::OnMRMLSceneNodeAdded(vtkMRMLNode* node
   // Remove all placed seeds
   this->Helper->RemoveSeeds();
 
-  this->Helper->UpdateLockedAllWidgetsFromInteractionNode(this->GetInteractionNode());
+  // only the new widget needs to be locked/unlocked, the others are already up to date
+  this->Helper->UpdateLockedFromInteractionNode(annotationNode, this->GetInteractionNode());
 
   // and render again after seeds were removed
   this->RequestRender();
@@ -515,8 +516,8 @@ void vtkMRMLAnnotationDisplayableManager::OnMRMLAnnotationNodeModifiedEvent(vtkM
 
   if(this->Is2DDisplayableManager())
     {
-    // force a OnMRMLSliceNodeModified() call to hide/show widgets according to the selected slice
-    this->OnMRMLSliceNodeModifiedEvent(this->GetSliceNode());
+    // hide/show the widget according to the selected slice
+    this->UpdateWidgetOnSlice(this->GetSliceNode(), annotationNode);
     }
   else
     {
@@ -574,8 +575,8 @@ void vtkMRMLAnnotationDisplayableManager::OnMRMLAnnotationDisplayNodeModifiedEve
 
     if(this->Is2DDisplayableManager())
       {
-      // force a OnMRMLSliceNodeModified() call to hide/show widgets according to the selected slice
-      this->OnMRMLSliceNodeModifiedEvent(this->GetSliceNode());
+      // hide/show the widget according to the selected slice
+      this->UpdateWidgetOnSlice(this->GetSliceNode(), annotationNode);
       }
     else
       {
@@ -633,8 +634,8 @@ void vtkMRMLAnnotationDisplayableManager::OnMRMLAnnotationNodeTransformModifiedE
 
   if(this->Is2DDisplayableManager())
     {
-    // force a OnMRMLSliceNodeModified() call to hide/show widgets according to the selected slice
-    this->OnMRMLSliceNodeModifiedEvent(this->GetSliceNode());
+    // hide/show the widget according to the selected slice
+    this->UpdateWidgetOnSlice(this->GetSliceNode(), annotationNode);
     }
   else
     {
@@ -723,187 +724,224 @@ void vtkMRMLAnnotationDisplayableManager::OnMRMLSliceNodeModifiedEvent(vtkMRMLSl
 
   // run through all associated nodes
   vtkMRMLAnnotationDisplayableManagerHelper::AnnotationNodeListIt it;
-  it = this->Helper->AnnotationNodeList.begin();
-  while(it != this->Helper->AnnotationNodeList.end())
+  for (it = this->Helper->AnnotationNodeList.begin(); it != this->Helper->AnnotationNodeList.end(); ++it)
     {
+    this->UpdateWidgetOnSlice(sliceNode, *it);
+    }
+}
 
-    // we loop through all nodes
-    vtkMRMLAnnotationNode * annotationNode = *it;
+//---------------------------------------------------------------------------
+void vtkMRMLAnnotationDisplayableManager::UpdateWidgetOnSlice(vtkMRMLSliceNode* sliceNode, vtkMRMLAnnotationNode* annotationNode)
+{
+  if (!sliceNode || !annotationNode)
+    {
+    return;
+    }
 
-    // check if the annotation is displayable according to the current selected Slice
-    bool visibleOnSlice = this->IsWidgetDisplayable(sliceNode, annotationNode);
+  // check if the annotation is displayable according to the current selected Slice
+  bool visibleOnSlice = this->IsWidgetDisplayable(sliceNode, annotationNode);
 
-    this->Helper->UpdateVisible(annotationNode, visibleOnSlice);
+  this->Helper->UpdateVisible(annotationNode, visibleOnSlice);
 
-    if (visibleOnSlice)
-      {
-      // it's visible, but if just update the position, don't get updates
-      //necessary when switch into and out of lightbox
-      vtkDebugMacro("OnMRMLSliceNodeModifiedEvent: visible, propagate mrml to widget");
+  if (visibleOnSlice)
+    {
+    // it's visible, but if just update the position, don't get updates
+    //necessary when switch into and out of lightbox
+    vtkDebugMacro("UpdateWidgetOnSlice: visible, propagate mrml to widget");
 
-      // If visible, turn off projection
-      // TODO: Find a way to generalize it (turn projectionOff ?). Difficult to know which one were turned on before
-      // to turn them back on when out of slice plane
+    // If visible, turn off projection
+    // TODO: Find a way to generalize it (turn projectionOff ?). Difficult to know which one were turned on before
+    // to turn them back on when out of slice plane
 
-      vtkMRMLAnnotationRulerNode* rulerNode = vtkMRMLAnnotationRulerNode::SafeDownCast(annotationNode);
-      vtkMRMLAnnotationFiducialNode* fiducialNode = vtkMRMLAnnotationFiducialNode::SafeDownCast(annotationNode);
-      if (rulerNode)
+    vtkMRMLAnnotationRulerNode* rulerNode = vtkMRMLAnnotationRulerNode::SafeDownCast(annotationNode);
+    vtkMRMLAnnotationFiducialNode* fiducialNode = vtkMRMLAnnotationFiducialNode::SafeDownCast(annotationNode);
+    if (rulerNode)
+      {
+      vtkLineWidget2* overLine = vtkLineWidget2::SafeDownCast(this->Helper->GetOverLineProjectionWidget(rulerNode));
+      vtkLineWidget2* underLine = vtkLineWidget2::SafeDownCast(this->Helper->GetUnderLineProjectionWidget(rulerNode));
+      if (overLine)
         {
-        vtkLineWidget2* overLine = vtkLineWidget2::SafeDownCast(this->Helper->GetOverLineProjectionWidget(rulerNode));
-        vtkLineWidget2* underLine = vtkLineWidget2::SafeDownCast(this->Helper->GetUnderLineProjectionWidget(rulerNode));
-        if (overLine)
-          {
-          overLine->Off();
-          }
-        if (underLine)
-          {
-          underLine->Off();
-          }
+        overLine->Off();
         }
-
-      if (fiducialNode)
+      if (underLine)
         {
-        vtkSeedWidget* fiducialSeed = vtkSeedWidget::SafeDownCast(this->Helper->GetPointProjectionWidget(fiducialNode));
-        if (fiducialSeed)
-          {
-          fiducialSeed->Off();
-          }
+        underLine->Off();
         }
-
-      this->PropagateMRMLToWidget(annotationNode, this->Helper->GetWidget(annotationNode));
       }
 
-    else
+    if (fiducialNode)
       {
-      // if the widget is not shown on the slice, show at least the intersection
-
-      // only implemented for ruler yet
-
-      vtkMRMLAnnotationRulerNode* rulerNode =
-        vtkMRMLAnnotationRulerNode::SafeDownCast(annotationNode);
-      vtkMRMLAnnotationFiducialNode* fiducialNode =
-        vtkMRMLAnnotationFiducialNode::SafeDownCast(annotationNode);
-
-      if (rulerNode &&
-          (rulerNode->GetAnnotationLineDisplayNode()))
+      vtkSeedWidget* fiducialSeed = vtkSeedWidget::SafeDownCast(this->Helper->GetPointProjectionWidget(fiducialNode));
+      if (fiducialSeed)
         {
+        fiducialSeed->Off();
+        }
+      }
 
-        double transformedP1[4];
-        rulerNode->GetControlPointWorldCoordinates(0, transformedP1);
+    this->PropagateMRMLToWidget(annotationNode, this->Helper->GetWidget(annotationNode));
+    }
 
-        double transformedP2[4];
-        rulerNode->GetControlPointWorldCoordinates(1, transformedP2);
+  else
+    {
+    // if the widget is not shown on the slice, show at least the intersection
 
-        // now get the displayCoordinates for the transformed worldCoordinates
-        double displayP1[4];
-        double displayP2[4];
-        this->GetWorldToDisplayCoordinates(transformedP1,displayP1);
-        this->GetWorldToDisplayCoordinates(transformedP2,displayP2);
+    // only implemented for ruler yet
 
-        //std::cout << this->GetSliceNode()->GetName() << " ras1: " << p1[0] << "," << p1[1] << "," << p1[2] << std::endl;
-        //std::cout << this->GetSliceNode()->GetName() << " ras2: " << p2[0] << "," << p2[1] << "," << p2[2] << std::endl;
+    vtkMRMLAnnotationRulerNode* rulerNode =
+      vtkMRMLAnnotationRulerNode::SafeDownCast(annotationNode);
+    vtkMRMLAnnotationFiducialNode* fiducialNode =
+      vtkMRMLAnnotationFiducialNode::SafeDownCast(annotationNode);
 
-        //std::cout << this->GetSliceNode()->GetName() << " display1: " << displayP1[0] << "," << displayP1[1] << "," << displayP1[2] << std::endl;
-        //std::cout << this->GetSliceNode()->GetName() << " display2: " << displayP2[0] << "," << displayP2[1] << "," << displayP2[2] << std::endl;
+    if (rulerNode &&
+        (rulerNode->GetAnnotationLineDisplayNode()))
+      {
 
-        // get line between p1 and p2
-        // g(x) = p1 + r*(p2-p1)
-        //
-        // compute intersection with slice plane
-        // if !=0: mark the intersection
+      double transformedP1[4];
+      rulerNode->GetControlPointWorldCoordinates(0, transformedP1);
 
-        if(rulerNode->GetAnnotationLineDisplayNode()->GetVisibility2D())
-          {
-          //double this->GetSliceNode()->GetSliceOffset() = p1[2] + (p2[2]-p1[2])*t;
-          // t = (this->GetSliceNode()->GetSliceOffset() - p1[2]) / (p2[2]-p1[2])
-          //double t = (this->GetSliceNode()->GetSliceOffset()-displayP1[2]) / (displayP2[2]-displayP1[2]);
-          double t = (-displayP1[2]) / (displayP2[2]-displayP1[2]);
+      double transformedP2[4];
+      rulerNode->GetControlPointWorldCoordinates(1, transformedP2);
 
-          // p2-p1
-          double P2minusP1[3];
-          vtkMath::Subtract(displayP2,displayP1,P2minusP1);
+      // now get the displayCoordinates for the transformed worldCoordinates
+      double displayP1[4];
+      double displayP2[4];
+      this->GetWorldToDisplayCoordinates(transformedP1,displayP1);
+      this->GetWorldToDisplayCoordinates(transformedP2,displayP2);
 
-          // (p2-p1)*t
-          vtkMath::MultiplyScalar(P2minusP1,t);
+      //std::cout << this->GetSliceNode()->GetName() << " ras1: " << p1[0] << "," << p1[1] << "," << p1[2] << std::endl;
+      //std::cout << this->GetSliceNode()->GetName() << " ras2: " << p2[0] << "," << p2[1] << "," << p2[2] << std::endl;
 
-          // p1 + ((p2-p1)*t)
-          double P1plusP2minusP1[3];
-          vtkMath::Add(displayP1,P2minusP1,P1plusP2minusP1);
+      //std::cout << this->GetSliceNode()->GetName() << " display1: " << displayP1[0] << "," << displayP1[1] << "," << displayP1[2] << std::endl;
+      //std::cout << this->GetSliceNode()->GetName() << " display2: " << displayP2[0] << "," << displayP2[1] << "," << displayP2[2] << std::endl;
 
-          // Since we have the position of the intersection now,
-          // we want to show it using a marker inside the sliceViews.
-          //
-          // We query the list if we already have a marker for this special widget.
-          // If not, we create a new marker.
-          // In any case, we will move the marker (either the newly created or the old).
+      // get line between p1 and p2
+      // g(x) = p1 + r*(p2-p1)
+      //
+      // compute intersection with slice plane
+      // if !=0: mark the intersection
 
-          vtkSeedWidget* marker = vtkSeedWidget::SafeDownCast(this->Helper->GetIntersectionWidget(rulerNode));
+      if(rulerNode->GetAnnotationLineDisplayNode()->GetVisibility2D())
+        {
+        //double this->GetSliceNode()->GetSliceOffset() = p1[2] + (p2[2]-p1[2])*t;
+        // t = (this->GetSliceNode()->GetSliceOffset() - p1[2]) / (p2[2]-p1[2])
+        //double t = (this->GetSliceNode()->GetSliceOffset()-displayP1[2]) / (displayP2[2]-displayP1[2]);
+        double t = (-displayP1[2]) / (displayP2[2]-displayP1[2]);
 
-          if (!marker)
-            {
-            // we create a new marker.
+        // p2-p1
+        double P2minusP1[3];
+        vtkMath::Subtract(displayP2,displayP1,P2minusP1);
 
-            vtkNew<vtkPointHandleRepresentation2D> handle;
-            handle->GetProperty()->SetColor(0,1,0);
-            handle->SetHandleSize(3);
+        // (p2-p1)*t
+        vtkMath::MultiplyScalar(P2minusP1,t);
 
-            vtkNew<vtkSeedRepresentation> rep;
-            rep->SetHandleRepresentation(handle.GetPointer());
+        // p1 + ((p2-p1)*t)
+        double P1plusP2minusP1[3];
+        vtkMath::Add(displayP1,P2minusP1,P1plusP2minusP1);
 
-            marker = vtkSeedWidget::New();
+        // Since we have the position of the intersection now,
+        // we want to show it using a marker inside the sliceViews.
+        //
+        // We query the list if we already have a marker for this special widget.
+        // If not, we create a new marker.
+        // In any case, we will move the marker (either the newly created or the old).
 
-            marker->CreateDefaultRepresentation();
+        vtkSeedWidget* marker = vtkSeedWidget::SafeDownCast(this->Helper->GetIntersectionWidget(rulerNode));
 
-            marker->SetRepresentation(rep.GetPointer());
+        if (!marker)
+          {
+          // we create a new marker.
 
-            marker->SetInteractor(this->GetInteractor());
-            marker->SetCurrentRenderer(this->GetRenderer());
+          vtkNew<vtkPointHandleRepresentation2D> handle;
+          handle->GetProperty()->SetColor(0,1,0);
+          handle->SetHandleSize(3);
 
-            marker->ProcessEventsOff();
+          vtkNew<vtkSeedRepresentation> rep;
+          rep->SetHandleRepresentation(handle.GetPointer());
 
-            marker->On();
-            marker->CompleteInteraction();
+          marker = vtkSeedWidget::New();
 
-            // we save the marker in our WidgetIntersection list associated to this node
-            this->Helper->WidgetIntersections[rulerNode] = marker;
-            }
+          marker->CreateDefaultRepresentation();
 
-          // remove all old markers associated with this node
-          marker->DeleteSeed(0);
+          marker->SetRepresentation(rep.GetPointer());
 
-          // the third component of the displayCoordinates is the distance to the slice
-          // now make sure that they have different signs
-          if ((displayP1[2] > 0 && displayP2[2] > 0) ||
-              (displayP1[2] < 0 && displayP2[2] < 0))
-            {
-            // jump out because they do not have different signs
-            ++it;
-            continue;
-            }
+          marker->SetInteractor(this->GetInteractor());
+          marker->SetCurrentRenderer(this->GetRenderer());
+
+          marker->ProcessEventsOff();
 
-          // .. and create a new one at the intersection location
-          vtkSmartPointer<vtkHandleWidget> newhandle = marker->CreateNewHandle();
-          vtkHandleRepresentation::SafeDownCast(newhandle->GetRepresentation())->SetDisplayPosition(P1plusP2minusP1);
           marker->On();
           marker->CompleteInteraction();
+
+          // we save the marker in our WidgetIntersection list associated to this node
+          this->Helper->WidgetIntersections[rulerNode] = marker;
           }
 
-        // Display projection on 2D viewers
-        vtkLineWidget2* overLine = vtkLineWidget2::SafeDownCast(this->Helper->GetOverLineProjectionWidget(rulerNode));
-        vtkLineWidget2* underLine = vtkLineWidget2::SafeDownCast(this->Helper->GetUnderLineProjectionWidget(rulerNode));
-        vtkMRMLAnnotationLineDisplayNode* lineDisplayNode = rulerNode->GetAnnotationLineDisplayNode();
+        // remove all old markers associated with this node
+        marker->DeleteSeed(0);
+
+        // the third component of the displayCoordinates is the distance to the slice
+        // now make sure that they have different signs
+        if ((displayP1[2] > 0 && displayP2[2] > 0) ||
+            (displayP1[2] < 0 && displayP2[2] < 0))
+          {
+          // jump out because they do not have different signs
+          return;
+          }
+
+        // .. and create a new one at the intersection location
+        vtkSmartPointer<vtkHandleWidget> newhandle = marker->CreateNewHandle();
+        vtkHandleRepresentation::SafeDownCast(newhandle->GetRepresentation())->SetDisplayPosition(P1plusP2minusP1);
+        marker->On();
+        marker->CompleteInteraction();
+        }
+
+      // Display projection on 2D viewers
+      vtkLineWidget2* overLine = vtkLineWidget2::SafeDownCast(this->Helper->GetOverLineProjectionWidget(rulerNode));
+      vtkLineWidget2* underLine = vtkLineWidget2::SafeDownCast(this->Helper->GetUnderLineProjectionWidget(rulerNode));
+      vtkMRMLAnnotationLineDisplayNode* lineDisplayNode = rulerNode->GetAnnotationLineDisplayNode();
 
-        if (lineDisplayNode)
+      if (lineDisplayNode)
+        {
+        if ((lineDisplayNode->GetSliceProjection() & lineDisplayNode->ProjectionOn) &&
+            lineDisplayNode->GetVisibility() && lineDisplayNode->GetVisibility2D())
           {
-          if ((lineDisplayNode->GetSliceProjection() & lineDisplayNode->ProjectionOn) &&
-              lineDisplayNode->GetVisibility() && lineDisplayNode->GetVisibility2D())
+          double overLineWidth = lineDisplayNode->GetOverLineThickness();
+          double underLineWidth = lineDisplayNode->GetUnderLineThickness();
+          double intersectionPoint[3] = {displayP2[0], displayP2[1], displayP2[2] };
+          bool lineIntersectPlane = false;
+
+          if (!overLine)
             {
-            double overLineWidth = lineDisplayNode->GetOverLineThickness();
-            double underLineWidth = lineDisplayNode->GetUnderLineThickness();
-            double intersectionPoint[3] = {displayP2[0], displayP2[1], displayP2[2] };
-            bool lineIntersectPlane = false;
+            vtkNew<vtkPointHandleRepresentation3D> handle;
+            handle->GetProperty()->SetOpacity(0.0);
+            handle->GetSelectedProperty()->SetOpacity(0.0);
+            handle->SetHandleSize(0);
+
+            vtkNew<vtkLineRepresentation> rep;
+            rep->SetHandleRepresentation(handle.GetPointer());
+            rep->GetPoint1Representation()->GetProperty()->SetOpacity(0.0);
+            rep->GetPoint1Representation()->GetSelectedProperty()->SetOpacity(0.0);
+            rep->GetPoint2Representation()->GetProperty()->SetOpacity(0.0);
+            rep->GetPoint2Representation()->GetSelectedProperty()->SetOpacity(0.0);
+            rep->GetLineHandleRepresentation()->GetProperty()->SetOpacity(0.0);
+            rep->GetLineHandleRepresentation()->GetSelectedProperty()->SetOpacity(0.0);
+            rep->GetLineProperty()->SetLineWidth(overLineWidth);
+            rep->GetLineHandleRepresentation()->DragableOff();
+            rep->GetLineHandleRepresentation()->PickableOff();
+
+            overLine = vtkLineWidget2::New();
+            overLine->CreateDefaultRepresentation();
+            overLine->SetRepresentation(rep.GetPointer());
+            overLine->SetInteractor(this->GetInteractor());
+            overLine->SetCurrentRenderer(this->GetRenderer());
+            overLine->ProcessEventsOff();
+            overLine->ManagesCursorOff();
+            this->Helper->WidgetOverLineProjections[rulerNode] = overLine;
+            }
 
-            if (!overLine)
+          if (lineDisplayNode->GetSliceProjection() & lineDisplayNode->ProjectionThickerOnTop)
+            {
+            if (!underLine)
               {
               vtkNew<vtkPointHandleRepresentation3D> handle;
               handle->GetProperty()->SetOpacity(0.0);
@@ -918,311 +956,276 @@ void vtkMRMLAnnotationDisplayableManager::OnMRMLSliceNodeModifiedEvent(vtkMRMLSl
               rep->GetPoint2Representation()->GetSelectedProperty()->SetOpacity(0.0);
               rep->GetLineHandleRepresentation()->GetProperty()->SetOpacity(0.0);
               rep->GetLineHandleRepresentation()->GetSelectedProperty()->SetOpacity(0.0);
-              rep->GetLineProperty()->SetLineWidth(overLineWidth);
+              rep->GetLineProperty()->SetLineWidth(underLineWidth);
               rep->GetLineHandleRepresentation()->DragableOff();
               rep->GetLineHandleRepresentation()->PickableOff();
 
-              overLine = vtkLineWidget2::New();
-              overLine->CreateDefaultRepresentation();
-              overLine->SetRepresentation(rep.GetPointer());
-              overLine->SetInteractor(this->GetInteractor());
-              overLine->SetCurrentRenderer(this->GetRenderer());
-              overLine->ProcessEventsOff();
-              overLine->ManagesCursorOff();
-              this->Helper->WidgetOverLineProjections[rulerNode] = overLine;
+              underLine = vtkLineWidget2::New();
+              underLine->CreateDefaultRepresentation();
+              underLine->SetRepresentation(rep.GetPointer());
+              underLine->SetInteractor(this->GetInteractor());
+              underLine->SetCurrentRenderer(this->GetRenderer());
+              underLine->ProcessEventsOff();
+              underLine->ManagesCursorOff();
+              this->Helper->WidgetUnderLineProjections[rulerNode] = underLine;
               }
 
-            if (lineDisplayNode->GetSliceProjection() & lineDisplayNode->ProjectionThickerOnTop)
+            if ((displayP1[2] * displayP2[2]) < 0)
               {
-              if (!underLine)
-                {
-                vtkNew<vtkPointHandleRepresentation3D> handle;
-                handle->GetProperty()->SetOpacity(0.0);
-                handle->GetSelectedProperty()->SetOpacity(0.0);
-                handle->SetHandleSize(0);
-
-                vtkNew<vtkLineRepresentation> rep;
-                rep->SetHandleRepresentation(handle.GetPointer());
-                rep->GetPoint1Representation()->GetProperty()->SetOpacity(0.0);
-                rep->GetPoint1Representation()->GetSelectedProperty()->SetOpacity(0.0);
-                rep->GetPoint2Representation()->GetProperty()->SetOpacity(0.0);
-                rep->GetPoint2Representation()->GetSelectedProperty()->SetOpacity(0.0);
-                rep->GetLineHandleRepresentation()->GetProperty()->SetOpacity(0.0);
-                rep->GetLineHandleRepresentation()->GetSelectedProperty()->SetOpacity(0.0);
-                rep->GetLineProperty()->SetLineWidth(underLineWidth);
-                rep->GetLineHandleRepresentation()->DragableOff();
-                rep->GetLineHandleRepresentation()->PickableOff();
-
-                underLine = vtkLineWidget2::New();
-                underLine->CreateDefaultRepresentation();
-                underLine->SetRepresentation(rep.GetPointer());
-                underLine->SetInteractor(this->GetInteractor());
-                underLine->SetCurrentRenderer(this->GetRenderer());
-                underLine->ProcessEventsOff();
-                underLine->ManagesCursorOff();
-                this->Helper->WidgetUnderLineProjections[rulerNode] = underLine;
-                }
-
-              if ((displayP1[2] * displayP2[2]) < 0)
-                {
-                // Point 1 and Point 2 are in different side of the plane
-                // Calculate plane intersection and set it as second point
-                // of top line, set it as first point of under line
-                lineIntersectPlane = true;
-
-                double t = (-displayP1[2]) / (displayP2[2]-displayP1[2]);
-                double P2minusP1[3];
-                vtkMath::Subtract(displayP2,displayP1,P2minusP1);
-                vtkMath::MultiplyScalar(P2minusP1,t);
-                vtkMath::Add(displayP1,P2minusP1,intersectionPoint);
-                }
-              else
-                {
-                underLine->Off();
-                }
+              // Point 1 and Point 2 are in different side of the plane
+              // Calculate plane intersection and set it as second point
+              // of top line, set it as first point of under line
+              lineIntersectPlane = true;
+
+              double t = (-displayP1[2]) / (displayP2[2]-displayP1[2]);
+              double P2minusP1[3];
+              vtkMath::Subtract(displayP2,displayP1,P2minusP1);
+              vtkMath::MultiplyScalar(P2minusP1,t);
+              vtkMath::Add(displayP1,P2minusP1,intersectionPoint);
               }
             else
               {
-              if (underLine)
-                {
-                underLine->Off();
-                }
+              underLine->Off();
               }
+            }
+          else
+            {
+            if (underLine)
+              {
+              underLine->Off();
+              }
+            }
 
-            vtkLineRepresentation* overLineRep = vtkLineRepresentation::SafeDownCast(overLine->GetRepresentation());
+          vtkLineRepresentation* overLineRep = vtkLineRepresentation::SafeDownCast(overLine->GetRepresentation());
 
-            if (overLineRep)
+          if (overLineRep)
+            {
+            overLine->Off();
+            if (underLine)
               {
-              overLine->Off();
-              if (underLine)
-                {
-                underLine->Off();
-                }
+              underLine->Off();
+              }
 
-              double lineOpacity = lineDisplayNode->GetProjectedOpacity();
-              double lineColor[3];
+            double lineOpacity = lineDisplayNode->GetProjectedOpacity();
+            double lineColor[3];
 
-              if (lineDisplayNode->GetSliceProjection() & lineDisplayNode->ProjectionUseRulerColor)
-                {
-                lineDisplayNode->GetColor(lineColor);
-                }
-              else
-                {
-                lineDisplayNode->GetProjectedColor(lineColor);
-                }
+            if (lineDisplayNode->GetSliceProjection() & lineDisplayNode->ProjectionUseRulerColor)
+              {
+              lineDisplayNode->GetColor(lineColor);
+              }
+            else
+              {
+              lineDisplayNode->GetProjectedColor(lineColor);
+              }
 
-              short linePattern = 0xFFFF;
+            short linePattern = 0xFFFF;
 
-              if (lineDisplayNode->GetSliceProjection() & lineDisplayNode->ProjectionDashed)
-                {
-                linePattern = 0xFF00;
-                }
+            if (lineDisplayNode->GetSliceProjection() & lineDisplayNode->ProjectionDashed)
+              {
+              linePattern = 0xFF00;
+              }
 
-              // TODO: Modify pattern to have spaced dot line when further from plane, smaller space when closer
-              // 0x0001 + (0x0001 + 1) = 0x0003 (0000 0000 0000 0011)
-              // 0x0003 + (0x0003 + 1) = 0x0007 (0000 0000 0000 0111)
-              // 0x0007 + (0x0007 + 1) = 0x000F (0000 0000 0000 1111)
-              // etc...
+            // TODO: Modify pattern to have spaced dot line when further from plane, smaller space when closer
+            // 0x0001 + (0x0001 + 1) = 0x0003 (0000 0000 0000 0011)
+            // 0x0003 + (0x0003 + 1) = 0x0007 (0000 0000 0000 0111)
+            // 0x0007 + (0x0007 + 1) = 0x000F (0000 0000 0000 1111)
+            // etc...
 
-              if (lineDisplayNode->GetSliceProjection() & lineDisplayNode->ProjectionColoredWhenParallel)
+            if (lineDisplayNode->GetSliceProjection() & lineDisplayNode->ProjectionColoredWhenParallel)
+              {
+              vtkMatrix4x4 *sliceToRAS = this->GetSliceNode()->GetSliceToRAS();
+              double slicePlaneNormal[3], rulerVector[3];
+              slicePlaneNormal[0] = sliceToRAS->GetElement(0,2);
+              slicePlaneNormal[1] = sliceToRAS->GetElement(1,2);
+              slicePlaneNormal[2] = sliceToRAS->GetElement(2,2);
+              rulerVector[0] = transformedP2[0] - transformedP1[0];
+              rulerVector[1] = transformedP2[1] - transformedP1[1];
+              rulerVector[2] = transformedP2[2] - transformedP1[2];
+
+              vtkMath::Normalize(slicePlaneNormal);
+              vtkMath::Normalize(rulerVector);
+
+              static const double LineInPlaneError = 0.005;
+              if (fabs(vtkMath::Dot(slicePlaneNormal, rulerVector)) < LineInPlaneError)
                 {
-                vtkMatrix4x4 *sliceToRAS = this->GetSliceNode()->GetSliceToRAS();
-                double slicePlaneNormal[3], rulerVector[3];
-                slicePlaneNormal[0] = sliceToRAS->GetElement(0,2);
-                slicePlaneNormal[1] = sliceToRAS->GetElement(1,2);
-                slicePlaneNormal[2] = sliceToRAS->GetElement(2,2);
-                rulerVector[0] = transformedP2[0] - transformedP1[0];
-                rulerVector[1] = transformedP2[1] - transformedP1[1];
-                rulerVector[2] = transformedP2[2] - transformedP1[2];
-
-                vtkMath::Normalize(slicePlaneNormal);
-                vtkMath::Normalize(rulerVector);
-
-                static const double LineInPlaneError = 0.005;
-                if (fabs(vtkMath::Dot(slicePlaneNormal, rulerVector)) < LineInPlaneError)
-                  {
-                  sliceNode->GetLayoutColor(lineColor);
-                  linePattern = 0xFFFF;
-                  }
+                sliceNode->GetLayoutColor(lineColor);
+                linePattern = 0xFFFF;
                 }
+              }
 
-              // Should be reset when widget is turned off, otherwise handle is rendered
-              overLineRep->GetPoint1Representation()->GetSelectedProperty()->SetOpacity(0.0);
-              overLineRep->GetPoint2Representation()->GetSelectedProperty()->SetOpacity(0.0);
-              overLineRep->GetLineProperty()->SetColor(lineColor);
-              overLineRep->GetLineProperty()->SetOpacity(lineOpacity);
-              overLineRep->GetLineProperty()->SetLineStipplePattern(linePattern);
-              overLineRep->GetLineProperty()->SetLineWidth(displayP1[2] > 0 ? underLineWidth : overLineWidth);
-              overLine->On();
-              overLineRep->SetPoint1DisplayPosition(displayP1);
-              overLineRep->SetPoint2DisplayPosition(intersectionPoint);
-
-              if (lineIntersectPlane)
+            // Should be reset when widget is turned off, otherwise handle is rendered
+            overLineRep->GetPoint1Representation()->GetSelectedProperty()->SetOpacity(0.0);
+            overLineRep->GetPoint2Representation()->GetSelectedProperty()->SetOpacity(0.0);
+            overLineRep->GetLineProperty()->SetColor(lineColor);
+            overLineRep->GetLineProperty()->SetOpacity(lineOpacity);
+            overLineRep->GetLineProperty()->SetLineStipplePattern(linePattern);
+            overLineRep->GetLineProperty()->SetLineWidth(displayP1[2] > 0 ? underLineWidth : overLineWidth);
+            overLine->On();
+            overLineRep->SetPoint1DisplayPosition(displayP1);
+            overLineRep->SetPoint2DisplayPosition(intersectionPoint);
+
+            if (lineIntersectPlane)
+              {
+              vtkLineRepresentation* underLineRep = vtkLineRepresentation::SafeDownCast(underLine->GetRepresentation());
+              if (underLineRep)
                 {
-                vtkLineRepresentation* underLineRep = vtkLineRepresentation::SafeDownCast(underLine->GetRepresentation());
-                if (underLineRep)
-                  {
-                  underLineRep->GetPoint1Representation()->GetSelectedProperty()->SetOpacity(0.0);
-                  underLineRep->GetPoint2Representation()->GetSelectedProperty()->SetOpacity(0.0);
-                  underLineRep->GetLineProperty()->SetColor(lineColor);
-                  underLineRep->GetLineProperty()->SetOpacity(lineOpacity);
-                  underLineRep->GetLineProperty()->SetLineStipplePattern(linePattern);
-                  underLineRep->GetLineProperty()->SetLineWidth(displayP2[2] > 0 ? underLineWidth : overLineWidth);
-                  underLine->On();
-                  underLineRep->SetPoint1DisplayPosition(intersectionPoint);
-                  underLineRep->SetPoint2DisplayPosition(displayP2);
-                  }
+                underLineRep->GetPoint1Representation()->GetSelectedProperty()->SetOpacity(0.0);
+                underLineRep->GetPoint2Representation()->GetSelectedProperty()->SetOpacity(0.0);
+                underLineRep->GetLineProperty()->SetColor(lineColor);
+                underLineRep->GetLineProperty()->SetOpacity(lineOpacity);
+                underLineRep->GetLineProperty()->SetLineStipplePattern(linePattern);
+                underLineRep->GetLineProperty()->SetLineWidth(displayP2[2] > 0 ? underLineWidth : overLineWidth);
+                underLine->On();
+                underLineRep->SetPoint1DisplayPosition(intersectionPoint);
+                underLineRep->SetPoint2DisplayPosition(displayP2);
                 }
               }
             }
-          else
+          }
+        else
+          {
+          if (overLine)
             {
-            if (overLine)
-              {
-              overLine->Off();
-              }
-            if (underLine)
-              {
-              underLine->Off();
-              }
+            overLine->Off();
+            }
+          if (underLine)
+            {
+            underLine->Off();
             }
           }
         }
-      else if (fiducialNode &&
-               fiducialNode->GetAnnotationPointDisplayNode())
-        {
-        double transformedP1[4];
-        fiducialNode->GetFiducialWorldCoordinates(transformedP1);
+      }
+    else if (fiducialNode &&
+             fiducialNode->GetAnnotationPointDisplayNode())
+      {
+      double transformedP1[4];
+      fiducialNode->GetFiducialWorldCoordinates(transformedP1);
 
-        double displayP1[4];
-        this->GetWorldToDisplayCoordinates(transformedP1, displayP1);
+      double displayP1[4];
+      this->GetWorldToDisplayCoordinates(transformedP1, displayP1);
 
-        vtkSeedWidget* projectionSeed =
-          vtkSeedWidget::SafeDownCast(this->Helper->GetPointProjectionWidget(fiducialNode));
+      vtkSeedWidget* projectionSeed =
+        vtkSeedWidget::SafeDownCast(this->Helper->GetPointProjectionWidget(fiducialNode));
 
-        vtkMRMLAnnotationPointDisplayNode* pointDisplayNode =
-          vtkMRMLAnnotationPointDisplayNode::SafeDownCast(fiducialNode->GetAnnotationPointDisplayNode());
+      vtkMRMLAnnotationPointDisplayNode* pointDisplayNode =
+        vtkMRMLAnnotationPointDisplayNode::SafeDownCast(fiducialNode->GetAnnotationPointDisplayNode());
 
-        if ((pointDisplayNode->GetSliceProjection() & pointDisplayNode->ProjectionOn) &&
-            pointDisplayNode->GetVisibility() && pointDisplayNode->GetVisibility2D())
+      if ((pointDisplayNode->GetSliceProjection() & pointDisplayNode->ProjectionOn) &&
+          pointDisplayNode->GetVisibility() && pointDisplayNode->GetVisibility2D())
+        {
+        double glyphScale = fiducialNode->GetAnnotationPointDisplayNode()->GetGlyphScale()*2;
+        int glyphType = fiducialNode->GetAnnotationPointDisplayNode()->GetGlyphType();
+        if (glyphType == vtkMRMLAnnotationPointDisplayNode::Sphere3D)
           {
-          double glyphScale = fiducialNode->GetAnnotationPointDisplayNode()->GetGlyphScale()*2;
-          int glyphType = fiducialNode->GetAnnotationPointDisplayNode()->GetGlyphType();
-          if (glyphType == vtkMRMLAnnotationPointDisplayNode::Sphere3D)
-            {
-            // 3D Sphere glyph is represented in 2D by a Circle2D glyph
-            glyphType = vtkMRMLAnnotationPointDisplayNode::Circle2D;
-            }
-
-          double pointOpacity = pointDisplayNode->GetProjectedOpacity();
-          double pointColor[3];
-          pointDisplayNode->GetProjectedColor(pointColor);
-
-          if (pointDisplayNode->GetSliceProjection() & pointDisplayNode->ProjectionUseFiducialColor)
-            {
-            pointDisplayNode->GetColor(pointColor);
-            }
+          // 3D Sphere glyph is represented in 2D by a Circle2D glyph
+          glyphType = vtkMRMLAnnotationPointDisplayNode::Circle2D;
+          }
 
-          if (!projectionSeed)
-            {
-            vtkNew<vtkAnnotationGlyphSource2D> glyph;
-            glyph->SetGlyphType(glyphType);
-            glyph->SetScale(glyphScale);
-            glyph->SetScale2(glyphScale);
-            glyph->SetColor(pointColor);
+        double pointOpacity = pointDisplayNode->GetProjectedOpacity();
+        double pointColor[3];
+        pointDisplayNode->GetProjectedColor(pointColor);
 
-            vtkNew<vtkPointHandleRepresentation2D> handle;
-            handle->SetCursorShape(glyph->GetOutput());
+        if (pointDisplayNode->GetSliceProjection() & pointDisplayNode->ProjectionUseFiducialColor)
+          {
+          pointDisplayNode->GetColor(pointColor);
+          }
 
-            vtkNew<vtkSeedRepresentation> rep;
-            rep->SetHandleRepresentation(handle.GetPointer());
+        if (!projectionSeed)
+          {
+          vtkNew<vtkAnnotationGlyphSource2D> glyph;
+          glyph->SetGlyphType(glyphType);
+          glyph->SetScale(glyphScale);
+          glyph->SetScale2(glyphScale);
+          glyph->SetColor(pointColor);
+
+          vtkNew<vtkPointHandleRepresentation2D> handle;
+          handle->SetCursorShape(glyph->GetOutput());
+
+          vtkNew<vtkSeedRepresentation> rep;
+          rep->SetHandleRepresentation(handle.GetPointer());
+
+          projectionSeed = vtkSeedWidget::New();
+          projectionSeed->CreateDefaultRepresentation();
+          projectionSeed->SetRepresentation(rep.GetPointer());
+          projectionSeed->SetInteractor(this->GetInteractor());
+          projectionSeed->SetCurrentRenderer(this->GetRenderer());
+          projectionSeed->CreateNewHandle();
+          projectionSeed->ProcessEventsOff();
+          projectionSeed->ManagesCursorOff();
+          projectionSeed->On();
+          projectionSeed->CompleteInteraction();
+          this->Helper->WidgetPointProjections[fiducialNode] = projectionSeed;
+          }
 
-            projectionSeed = vtkSeedWidget::New();
-            projectionSeed->CreateDefaultRepresentation();
-            projectionSeed->SetRepresentation(rep.GetPointer());
-            projectionSeed->SetInteractor(this->GetInteractor());
-            projectionSeed->SetCurrentRenderer(this->GetRenderer());
-            projectionSeed->CreateNewHandle();
-            projectionSeed->ProcessEventsOff();
-            projectionSeed->ManagesCursorOff();
-            projectionSeed->On();
-            projectionSeed->CompleteInteraction();
-            this->Helper->WidgetPointProjections[fiducialNode] = projectionSeed;
-            }
+        vtkSeedRepresentation* projectionSeedRep =
+          vtkSeedRepresentation::SafeDownCast(projectionSeed->GetRepresentation());
 
-          vtkSeedRepresentation* projectionSeedRep =
-            vtkSeedRepresentation::SafeDownCast(projectionSeed->GetRepresentation());
+        if (projectionSeedRep)
+          {
+          projectionSeed->Off();
 
-          if (projectionSeedRep)
+          if (projectionSeed->GetSeed(0))
             {
-            projectionSeed->Off();
+            vtkPointHandleRepresentation2D* handleRep =
+              vtkPointHandleRepresentation2D::SafeDownCast(projectionSeed->GetSeed(0)->GetRepresentation());
 
-            if (projectionSeed->GetSeed(0))
+            if (handleRep)
               {
-              vtkPointHandleRepresentation2D* handleRep =
-                vtkPointHandleRepresentation2D::SafeDownCast(projectionSeed->GetSeed(0)->GetRepresentation());
+              vtkNew<vtkAnnotationGlyphSource2D> glyphSource;
+              glyphSource->SetGlyphType(glyphType);
+              glyphSource->SetScale(glyphScale);
+              glyphSource->SetScale2(glyphScale);
 
-              if (handleRep)
+              if (pointDisplayNode->GetSliceProjection() & pointDisplayNode->ProjectionOutlinedBehindSlicePlane)
                 {
-                vtkNew<vtkAnnotationGlyphSource2D> glyphSource;
-                glyphSource->SetGlyphType(glyphType);
-                glyphSource->SetScale(glyphScale);
-                glyphSource->SetScale2(glyphScale);
-
-                if (pointDisplayNode->GetSliceProjection() & pointDisplayNode->ProjectionOutlinedBehindSlicePlane)
+                static const double threshold = 0.5;
+                static const double notInPlaneOpacity = 0.6;
+                static const double inPlaneOpacity = 1.0;
+                if (displayP1[2] < 0)
                   {
-                  static const double threshold = 0.5;
-                  static const double notInPlaneOpacity = 0.6;
-                  static const double inPlaneOpacity = 1.0;
-                  if (displayP1[2] < 0)
-                    {
-                    glyphSource->FilledOff();
-                    pointOpacity = notInPlaneOpacity;
+                  glyphSource->FilledOff();
+                  pointOpacity = notInPlaneOpacity;
 
-                    if (displayP1[2] > -threshold)
-                      {
-                      pointOpacity = inPlaneOpacity;
-                      }
-                    }
-                  else if (displayP1[2] > 0)
+                  if (displayP1[2] > -threshold)
                     {
-                    glyphSource->FilledOn();
-                    pointOpacity = notInPlaneOpacity;
-
-                    if (displayP1[2] < threshold)
-                      {
-                      pointOpacity = inPlaneOpacity;
-                      }
+                    pointOpacity = inPlaneOpacity;
                     }
                   }
-                else
+                else if (displayP1[2] > 0)
                   {
                   glyphSource->FilledOn();
+                  pointOpacity = notInPlaneOpacity;
+
+                  if (displayP1[2] < threshold)
+                    {
+                    pointOpacity = inPlaneOpacity;
+                    }
                   }
-                glyphSource->SetColor(pointColor);
-                handleRep->GetProperty()->SetColor(pointColor);
-                handleRep->GetProperty()->SetOpacity(pointOpacity);
-                handleRep->SetCursorShape(glyphSource->GetOutput());
-                handleRep->SetDisplayPosition(displayP1);
-                projectionSeed->On();
-                projectionSeed->CompleteInteraction();
                 }
+              else
+                {
+                glyphSource->FilledOn();
+                }
+              glyphSource->SetColor(pointColor);
+              handleRep->GetProperty()->SetColor(pointColor);
+              handleRep->GetProperty()->SetOpacity(pointOpacity);
+              handleRep->SetCursorShape(glyphSource->GetOutput());
+              handleRep->SetDisplayPosition(displayP1);
+              projectionSeed->On();
+              projectionSeed->CompleteInteraction();
               }
             }
           }
-        else
+        }
+      else
+        {
+        if (projectionSeed)
           {
-          if (projectionSeed)
-            {
-            projectionSeed->Off();
-            }
+          projectionSeed->Off();
           }
         }
       }
-
-    ++it;
     }
-
 }
 
 //---------------------------------------------------------------------------
@@ -137,6 +137,11 @@ protected:
   /// Handler for specific SliceView actions
   virtual void OnMRMLSliceNodeModifiedEvent(vtkMRMLSliceNode * sliceNode);
 
+  /// Update visibility, slice intersection and projection of a single widget in a slice view.
+  /// Called for all widgets when the slice node is modified, and only for the modified
+  /// annotation when an annotation node is modified.
+  virtual void UpdateWidgetOnSlice(vtkMRMLSliceNode * sliceNode, vtkMRMLAnnotationNode* annotationNode);
+
   /// Check, if the widget is displayable in the current slice geometry
   virtual bool IsWidgetDisplayable(vtkMRMLSliceNode * sliceNode, vtkMRMLAnnotationNode* node);
 
@@ -84,6 +84,30 @@ void vtkMRMLAnnotationDisplayableManagerHelper::UpdateLockedAllWidgetsFromIntera
     }
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLAnnotationDisplayableManagerHelper::UpdateLockedFromInteractionNode(vtkMRMLAnnotationNode* node,
+  vtkMRMLInteractionNode* interactionNode)
+{
+  if (!node || !interactionNode)
+    {
+    return;
+    }
+
+  int currentInteractionMode = interactionNode->GetCurrentInteractionMode();
+  if (currentInteractionMode == vtkMRMLInteractionNode::Place)
+    {
+    vtkAbstractWidget* widget = this->GetWidget(node);
+    if (widget)
+      {
+      widget->ProcessEventsOff();
+      }
+    }
+  else if (currentInteractionMode == vtkMRMLInteractionNode::ViewTransform)
+    {
+    this->UpdateLocked(node);
+    }
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLAnnotationDisplayableManagerHelper::UpdateLockedAllWidgets(bool locked)
 {
@@ -544,6 +568,13 @@ vtkMRMLAnnotationNode * vtkMRMLAnnotationDisplayableManagerHelper::GetAnnotation
     vtkErrorMacro("GetAnnotationNodeFromDisplayNode: display node or it's id is null");
     return nullptr;
     }
+  // the display node usually knows its annotation node, which is cheaper than iterating
+  // through all the annotation nodes
+  vtkMRMLAnnotationNode* displayableNode = vtkMRMLAnnotationNode::SafeDownCast(displayNode->GetDisplayableNode());
+  if (displayableNode && this->Widgets.find(displayableNode) != this->Widgets.end())
+    {
+    return displayableNode;
+    }
   // iterate through the node list
   for (unsigned int i = 0; i < this->AnnotationNodeList.size(); i++)
     {
@@ -54,6 +54,9 @@ public:
   void UpdateLockedAllWidgets(bool locked);
   /// Lock/Unlock a widget
   void UpdateLocked(vtkMRMLAnnotationNode* node);
+  /// Lock/Unlock a widget from interaction node, same as
+  /// UpdateLockedAllWidgetsFromInteractionNode but only for one widget
+  void UpdateLockedFromInteractionNode(vtkMRMLAnnotationNode* node, vtkMRMLInteractionNode* interactionNode);
   /// Hide/Show a widget according to node's visible flag and if it can be
   /// displayed in this viewer
   void UpdateVisible(vtkMRMLAnnotationNode* node, bool displayableInViewer = true);
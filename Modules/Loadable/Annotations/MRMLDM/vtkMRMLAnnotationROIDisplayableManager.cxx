@@ -259,33 +259,21 @@ void vtkMRMLAnnotationROIDisplayableManager::OnMRMLSceneNodeRemoved(vtkMRMLNode*
 }
 
 //---------------------------------------------------------------------------
-void vtkMRMLAnnotationROIDisplayableManager::OnMRMLSliceNodeModifiedEvent(vtkMRMLSliceNode* sliceNode)
+void vtkMRMLAnnotationROIDisplayableManager::UpdateWidgetOnSlice(vtkMRMLSliceNode* sliceNode,
+  vtkMRMLAnnotationNode* annotationNode)
 {
-
-  if (!sliceNode)
+  if (!sliceNode || !annotationNode)
     {
-    vtkErrorMacro("OnMRMLSliceNodeModifiedEvent: Could not get the sliceNode.");
     return;
     }
 
-  // run through all associated nodes
-  vtkMRMLAnnotationDisplayableManagerHelper::AnnotationNodeListIt it;
-  it = this->Helper->AnnotationNodeList.begin();
-  while(it != this->Helper->AnnotationNodeList.end())
+  vtkAbstractWidget* widget = this->Helper->GetWidget(annotationNode);
+  if (!widget)
     {
-
-    // we loop through all nodes
-    vtkMRMLAnnotationNode* annotationNode = *it;
-
-    vtkAbstractWidget* widget = this->Helper->GetWidget(annotationNode);
-    if (!widget)
-      {
-      vtkErrorMacro("OnMRMLSliceNodeModifiedEvent: We could not get the widget to the node: " << annotationNode->GetID());
-      return;
-      }
-    this->PropagateMRMLToWidget(annotationNode, widget);
-    it++;
+    vtkErrorMacro("UpdateWidgetOnSlice: We could not get the widget to the node: " << annotationNode->GetID());
+    return;
     }
+  this->PropagateMRMLToWidget(annotationNode, widget);
 }
 
 //---------------------------------------------------------------------------
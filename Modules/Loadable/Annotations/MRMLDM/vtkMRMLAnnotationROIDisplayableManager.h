@@ -60,7 +60,7 @@ protected:
   void OnMRMLSceneNodeRemoved(vtkMRMLNode* node) override;
 
   /// Handler for specific SliceView actions
-  void OnMRMLSliceNodeModifiedEvent(vtkMRMLSliceNode * sliceNode) override;
+  void UpdateWidgetOnSlice(vtkMRMLSliceNode * sliceNode, vtkMRMLAnnotationNode* annotationNode) override;
 
 
   /// Update just the position for the widget, implemented by subclasses.
@@ -32,6 +32,8 @@
 #include <vtkMRMLLinearTransformNode.h>
 #include <vtkMRMLMarkupsFiducialNode.h>
 #include <vtkMRMLMarkupsROINode.h>
+#include <vtkMRMLScene.h>
+#include <vtkMRMLSequenceNode.h>
 #include <vtkMRMLVectorVolumeNode.h>
 #include <vtkMRMLVectorVolumeDisplayNode.h>
 #include <vtkMRMLTransformNode.h>
@@ -42,10 +44,12 @@
 #include <vtkGeneralTransform.h>
 #include <vtkImageConstantPad.h>
 #include <vtkImageData.h>
+#include <vtkImageReslice.h>
 #include <vtkNew.h>
 #include <vtkMatrix4x4.h>
 #include <vtkMatrix3x3.h>
 #include <vtkObjectFactory.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkTransform.h>
 #include <vtkVersion.h>
@@ -55,6 +59,7 @@
 // STD includes
 #include <cassert>
 #include <iostream>
+#include <vector>
 
 //----------------------------------------------------------------------------
 class vtkSlicerCropVolumeLogic::vtkInternal
@@ -159,6 +164,177 @@ public:
     vtkMatrix4x4::Multiply4x4(rasToIJK, objectToVolumeRAS, objectToVolumeIJK);
     }
 
+  /// Compute geometry of the output volume of interpolated cropping.
+  /// outputIJKToRAS is the output volume IJK to RAS matrix with the origin at the ROI corner and
+  /// outputOrigin_RAS is the position of the center of the first voxel.
+  /// Returns 0 on success, -5 if the ROI and -6 if the output volume is under a non-linear transform.
+  static int GetInterpolatedCropOutputVoxelGeometry(vtkMRMLDisplayableNode* roi, vtkMRMLVolumeNode* inputVolume,
+    vtkMRMLVolumeNode* outputVolume, bool isotropicResampling, double spacingScale, int outputExtent[6],
+    double outputSpacing[3], double outputDirectionColRow[3][3], vtkMatrix4x4* outputIJKToRAS, double outputOrigin_RAS[4])
+    {
+    vtkSlicerCropVolumeLogic::GetInterpolatedCropOutputGeometry(roi, inputVolume, isotropicResampling, spacingScale, outputExtent, outputSpacing);
+
+    double roiXYZ[3] = { 0.0, 0.0, 0.0 };
+    double roiRadius[3] = { 0.0, 0.0, 0.0 };
+    vtkSlicerCropVolumeLogic::vtkInternal::GetROIXYZ(roi, roiXYZ);
+    vtkSlicerCropVolumeLogic::vtkInternal::GetROIRadius(roi, roiRadius);
+
+    outputIJKToRAS->Identity();
+    outputIJKToRAS->SetElement(0, 0, outputSpacing[0]);
+    outputIJKToRAS->SetElement(1, 1, outputSpacing[1]);
+    outputIJKToRAS->SetElement(2, 2, outputSpacing[2]);
+    outputIJKToRAS->SetElement(0, 3, roiXYZ[0] - roiRadius[0]);
+    outputIJKToRAS->SetElement(1, 3, roiXYZ[1] - roiRadius[1]);
+    outputIJKToRAS->SetElement(2, 3, roiXYZ[2] - roiRadius[2]);
+
+    // account for the ROI parent transform, if present
+    vtkMRMLTransformNode *roiTransform = roi->GetParentTransformNode();
+    vtkMRMLTransformNode *outputTransform = outputVolume->GetParentTransformNode();
+    if (roiTransform && !roiTransform->IsTransformToWorldLinear())
+      {
+      // We can only display a If ROI is transformed with a warping transform then we ignore the transformation because non-linear
+      // transform of ROI node is not supported.
+      return -5;
+      }
+    if (outputTransform && !outputTransform->IsTransformToWorldLinear())
+      {
+      // The resample module can only create a rectangular output.
+      return -6;
+      }
+
+    vtkNew<vtkMatrix4x4> roiMatrix;
+    vtkSlicerCropVolumeLogic::vtkInternal::GetMatrixTransformFromObjectToNode(roi, outputVolume, roiMatrix);
+    vtkMatrix4x4::Multiply4x4(roiMatrix.GetPointer(), outputIJKToRAS, outputIJKToRAS);
+
+    vtkNew<vtkMatrix4x4> rasToLPS;
+    rasToLPS->SetElement(0, 0, -1);
+    rasToLPS->SetElement(1, 1, -1);
+    vtkNew<vtkMatrix4x4> outputIJKToLPS;
+    vtkMatrix4x4::Multiply4x4(rasToLPS.GetPointer(), outputIJKToRAS, outputIJKToLPS.GetPointer());
+
+    // contains axis directions, in unconventional indexing (column, row)
+    // so that it can be conveniently normalized
+    for (int column = 0; column < 3; column++)
+      {
+      for (int row = 0; row < 3; row++)
+        {
+        outputDirectionColRow[column][row] = outputIJKToLPS->GetElement(row, column);
+        }
+      outputSpacing[column] = vtkMath::Normalize(outputDirectionColRow[column]);
+      }
+
+    // Center the output image in the ROI. For that, compute the size difference between
+    // the ROI and the output image.
+    double sizeDifference_IJK[3] =
+      {
+      roiRadius[0] * 2 / outputSpacing[0] - (outputExtent[1] - outputExtent[0] + 1),
+      roiRadius[1] * 2 / outputSpacing[1] - (outputExtent[3] - outputExtent[2] + 1),
+      roiRadius[2] * 2 / outputSpacing[2] - (outputExtent[5] - outputExtent[4] + 1)
+      };
+    // Origin is in the voxel's center. Shift the origin by half voxel
+    // to have the ROI edge at the output image voxel edge.
+    double outputOrigin_IJK[4] =
+      {
+      0.5 + sizeDifference_IJK[0] / 2,
+      0.5 + sizeDifference_IJK[1] / 2,
+      0.5 + sizeDifference_IJK[2] / 2,
+      1.0
+      };
+    outputIJKToRAS->MultiplyPoint(outputOrigin_IJK, outputOrigin_RAS);
+    return 0;
+    }
+
+  /// Returns true if interpolated cropping can be computed using vtkImageReslice,
+  /// without creating temporary nodes and running the resample module.
+  /// Diffusion and vector volumes require reorientation of voxel values, and
+  /// windowed sinc and b-spline interpolation are only available in the resample module.
+  static bool CanResampleInProcess(vtkMRMLVolumeNode* inputVolume, vtkMRMLVolumeNode* outputVolume, int interpolationMode)
+    {
+    if (!inputVolume->IsA("vtkMRMLScalarVolumeNode")
+      || inputVolume->IsA("vtkMRMLTensorVolumeNode")
+      || inputVolume->IsA("vtkMRMLDiffusionWeightedVolumeNode")
+      || !inputVolume->GetImageData())
+      {
+      return false;
+      }
+    if (interpolationMode != vtkMRMLCropVolumeParametersNode::InterpolationNearestNeighbor
+      && interpolationMode != vtkMRMLCropVolumeParametersNode::InterpolationLinear)
+      {
+      return false;
+      }
+    // Input volume must not be warped relative to the output volume
+    vtkNew<vtkMatrix4x4> outputToInputTransform;
+    return vtkMRMLTransformNode::GetMatrixTransformBetweenNodes(outputVolume->GetParentTransformNode(),
+      inputVolume->GetParentTransformNode(), outputToInputTransform) != 0;
+    }
+
+  /// Get transform from output volume IJK to input image coordinates (used as reslice axes).
+  static void GetOutputIJKToInputImage(vtkMRMLVolumeNode* inputVolume, vtkImageData* inputImage, vtkMRMLVolumeNode* outputVolume,
+    vtkMatrix4x4* outputIJKToRAS, vtkMatrix4x4* outputIJKToInputImage)
+    {
+    vtkNew<vtkMatrix4x4> outputToInputTransform;
+    vtkMRMLTransformNode::GetMatrixTransformBetweenNodes(outputVolume->GetParentTransformNode(),
+      inputVolume->GetParentTransformNode(), outputToInputTransform);
+    vtkNew<vtkMatrix4x4> inputRASToIJK;
+    inputVolume->GetRASToIJKMatrix(inputRASToIJK);
+    vtkNew<vtkMatrix4x4> inputIJKToImage;
+    for (int i = 0; i < 3; i++)
+      {
+      inputIJKToImage->SetElement(i, i, inputImage->GetSpacing()[i]);
+      inputIJKToImage->SetElement(i, 3, inputImage->GetOrigin()[i]);
+      }
+    vtkMatrix4x4::Multiply4x4(outputToInputTransform, outputIJKToRAS, outputIJKToInputImage);
+    vtkMatrix4x4::Multiply4x4(inputRASToIJK, outputIJKToInputImage, outputIJKToInputImage);
+    vtkMatrix4x4::Multiply4x4(inputIJKToImage, outputIJKToInputImage, outputIJKToInputImage);
+    }
+
+  /// Resample the input image into the output extent using vtkImageReslice.
+  /// Only VTK objects are used, therefore images of different volumes can be resampled concurrently.
+  static vtkSmartPointer<vtkImageData> ResampleImage(vtkImageData* inputImage, vtkMatrix4x4* outputIJKToInputImage,
+    const int outputExtent[6], int interpolationMode, double fillValue)
+    {
+    vtkNew<vtkImageReslice> reslice;
+    reslice->SetInputData(inputImage);
+    reslice->SetResliceAxes(outputIJKToInputImage);
+    reslice->SetOutputOrigin(0.0, 0.0, 0.0);
+    reslice->SetOutputSpacing(1.0, 1.0, 1.0);
+    reslice->SetOutputExtent(0, outputExtent[1] - outputExtent[0],
+      0, outputExtent[3] - outputExtent[2],
+      0, outputExtent[5] - outputExtent[4]);
+    if (interpolationMode == vtkMRMLCropVolumeParametersNode::InterpolationNearestNeighbor)
+      {
+      reslice->SetInterpolationModeToNearestNeighbor();
+      }
+    else
+      {
+      reslice->SetInterpolationModeToLinear();
+      }
+    reslice->SetBackgroundLevel(fillValue);
+    reslice->Update();
+
+    vtkSmartPointer<vtkImageData> outputImage = vtkSmartPointer<vtkImageData>::New();
+    outputImage->ShallowCopy(reslice->GetOutput());
+    return outputImage;
+    }
+
+  /// Resample the input volume into the output volume geometry using vtkImageReslice.
+  /// The filter is multi-threaded and each thread fills its own slab of the output directly.
+  static int ResampleInProcess(vtkMRMLVolumeNode* inputVolume, vtkMRMLVolumeNode* outputVolume,
+    vtkMatrix4x4* outputIJKToRAS, const int outputExtent[6], int interpolationMode, double fillValue)
+    {
+    vtkImageData* inputImage = inputVolume->GetImageData();
+    vtkNew<vtkMatrix4x4> outputIJKToInputImage;
+    GetOutputIJKToInputImage(inputVolume, inputImage, outputVolume, outputIJKToRAS, outputIJKToInputImage);
+    vtkSmartPointer<vtkImageData> outputImage = ResampleImage(inputImage, outputIJKToInputImage,
+      outputExtent, interpolationMode, fillValue);
+
+    int wasModified = outputVolume->StartModify();
+    outputVolume->SetAndObserveImageData(outputImage);
+    outputVolume->SetIJKToRASMatrix(outputIJKToRAS);
+    outputVolume->EndModify(wasModified);
+    return 0;
+    }
+
 };
 
 //----------------------------------------------------------------------------
@@ -368,6 +544,227 @@ bool vtkSlicerCropVolumeLogic::GetVoxelBasedCropOutputExtent(vtkMRMLDisplayableN
   return true;
 }
 
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+bool vtkSlicerCropVolumeLogic::CanApplySequence(vtkMRMLCropVolumeParametersNode* pnode, vtkMRMLSequenceNode* inputSequenceNode)
+{
+  if (!pnode || !inputSequenceNode)
+    {
+    return false;
+    }
+  for (int itemIndex = 0; itemIndex < inputSequenceNode->GetNumberOfDataNodes(); ++itemIndex)
+    {
+    vtkMRMLVolumeNode* inputVolume = vtkMRMLVolumeNode::SafeDownCast(inputSequenceNode->GetNthDataNode(itemIndex));
+    if (!inputVolume || inputVolume->IsA("vtkMRMLDiffusionTensorVolumeNode"))
+      {
+      return false;
+      }
+    if (pnode->GetVoxelBased())
+      {
+      continue;
+      }
+    // Same conditions as in vtkInternal::CanResampleInProcess (transforms are checked when cropping)
+    if (!inputVolume->IsA("vtkMRMLScalarVolumeNode")
+      || inputVolume->IsA("vtkMRMLTensorVolumeNode")
+      || inputVolume->IsA("vtkMRMLDiffusionWeightedVolumeNode"))
+      {
+      return false;
+      }
+    }
+  if (!pnode->GetVoxelBased()
+    && pnode->GetInterpolationMode() != vtkMRMLCropVolumeParametersNode::InterpolationNearestNeighbor
+    && pnode->GetInterpolationMode() != vtkMRMLCropVolumeParametersNode::InterpolationLinear)
+    {
+    return false;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkSlicerCropVolumeLogic::ApplySequence(vtkMRMLCropVolumeParametersNode* pnode,
+  vtkMRMLSequenceNode* inputSequenceNode, vtkMRMLSequenceNode* outputSequenceNode,
+  vtkMRMLTransformNode* inputVolumeTransformNode/*=nullptr*/, vtkMRMLTransformNode* outputVolumeTransformNode/*=nullptr*/)
+{
+  vtkMRMLScene *scene = this->GetMRMLScene();
+  if (!scene || !pnode || !inputSequenceNode || !outputSequenceNode)
+    {
+    vtkErrorMacro("ApplySequence: Invalid scene, parameter node, or sequence");
+    return -1;
+    }
+  vtkMRMLDisplayableNode* inputROI = vtkMRMLDisplayableNode::SafeDownCast(scene->GetNodeByID(pnode->GetROINodeID()));
+  if (!vtkMRMLAnnotationROINode::SafeDownCast(inputROI) && !vtkMRMLMarkupsROINode::SafeDownCast(inputROI))
+    {
+    vtkErrorMacro("ApplySequence: Invalid ROI");
+    return -1;
+    }
+  if (!vtkSlicerCropVolumeLogic::CanApplySequence(pnode, inputSequenceNode))
+    {
+    vtkErrorMacro("ApplySequence: Volume type or interpolation mode is not supported, use Apply for each volume instead");
+    return -2;
+    }
+  if ((inputVolumeTransformNode && !inputVolumeTransformNode->IsTransformToWorldLinear())
+    || (outputVolumeTransformNode && !outputVolumeTransformNode->IsTransformToWorldLinear()))
+    {
+    vtkErrorMacro("ApplySequence: Volumes must not be under a non-linear transform");
+    return -6;
+    }
+  bool voxelBased = pnode->GetVoxelBased();
+  bool inPlace = (inputSequenceNode == outputSequenceNode);
+  int numberOfItems = inputSequenceNode->GetNumberOfDataNodes();
+  if (numberOfItems == 0)
+    {
+    if (!inPlace)
+      {
+      outputSequenceNode->RemoveAllDataNodes();
+      }
+    return 0;
+    }
+
+  // Items of the sequence are not in the scene, therefore temporary volume nodes are added to the scene
+  // to compute geometry in the coordinate system of the ROI. Only geometry of these nodes is changed, they
+  // refer to the voxels of the items.
+  vtkSmartPointer<vtkMRMLVolumeNode> referenceInputVolume = vtkSmartPointer<vtkMRMLVolumeNode>::Take(
+    vtkMRMLVolumeNode::SafeDownCast(inputSequenceNode->GetNthDataNode(0)->CreateNodeInstance()));
+  vtkSmartPointer<vtkMRMLVolumeNode> referenceOutputVolume = vtkSmartPointer<vtkMRMLVolumeNode>::Take(
+    vtkMRMLVolumeNode::SafeDownCast(referenceInputVolume->CreateNodeInstance()));
+  referenceInputVolume->SetHideFromEditors(true);
+  referenceOutputVolume->SetHideFromEditors(true);
+  scene->AddNode(referenceInputVolume);
+  scene->AddNode(referenceOutputVolume);
+  referenceInputVolume->SetAndObserveTransformNodeID(inputVolumeTransformNode ? inputVolumeTransformNode->GetID() : nullptr);
+  referenceOutputVolume->SetAndObserveTransformNodeID(outputVolumeTransformNode ? outputVolumeTransformNode->GetID() : nullptr);
+
+  struct CropItem
+    {
+    vtkSmartPointer<vtkImageData> InputImage;
+    int OutputExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    vtkSmartPointer<vtkMatrix4x4> OutputIJKToRAS{ vtkSmartPointer<vtkMatrix4x4>::New() };
+    vtkSmartPointer<vtkMatrix4x4> OutputIJKToInputImage{ vtkSmartPointer<vtkMatrix4x4>::New() };
+    vtkSmartPointer<vtkImageData> OutputImage;
+    };
+  std::vector<CropItem> cropItems(numberOfItems);
+
+  // Compute output geometry of each item (requires access to MRML nodes, therefore it is not done in parallel)
+  int errorCode = 0;
+  for (int itemIndex = 0; itemIndex < numberOfItems && errorCode == 0; ++itemIndex)
+    {
+    CropItem& cropItem = cropItems[itemIndex];
+    vtkMRMLVolumeNode* inputVolume = vtkMRMLVolumeNode::SafeDownCast(inputSequenceNode->GetNthDataNode(itemIndex));
+    if (!inputVolume->GetImageData())
+      {
+      continue;
+      }
+    // The image is shallow-copied so that each filter has its own input, even if items share voxels
+    cropItem.InputImage = vtkSmartPointer<vtkImageData>::New();
+    cropItem.InputImage->ShallowCopy(inputVolume->GetImageData());
+    vtkNew<vtkMatrix4x4> inputIJKToRAS;
+    inputVolume->GetIJKToRASMatrix(inputIJKToRAS);
+    referenceInputVolume->SetIJKToRASMatrix(inputIJKToRAS);
+    referenceInputVolume->SetAndObserveImageData(cropItem.InputImage);
+    if (voxelBased)
+      {
+      if (!vtkSlicerCropVolumeLogic::GetVoxelBasedCropOutputExtent(inputROI, referenceInputVolume, cropItem.OutputExtent, false))
+        {
+        vtkErrorMacro("ApplySequence: failed to get output geometry of item " << itemIndex);
+        errorCode = -1;
+        }
+      cropItem.OutputIJKToRAS->DeepCopy(inputIJKToRAS);
+      }
+    else
+      {
+      double outputSpacing[3] = { 0 };
+      double outputDirectionColRow[3][3] = {{ 0 }};
+      double outputOrigin_RAS[4] = { 0.0, 0.0, 0.0, 1.0 };
+      errorCode = vtkSlicerCropVolumeLogic::vtkInternal::GetInterpolatedCropOutputVoxelGeometry(inputROI, referenceInputVolume,
+        referenceOutputVolume, pnode->GetIsotropicResampling(), pnode->GetSpacingScalingConst(),
+        cropItem.OutputExtent, outputSpacing, outputDirectionColRow, cropItem.OutputIJKToRAS, outputOrigin_RAS);
+      if (errorCode != 0)
+        {
+        vtkErrorMacro("ApplySequence: ROI is under a non-linear transform");
+        }
+      for (int row = 0; row < 3; row++)
+        {
+        cropItem.OutputIJKToRAS->SetElement(row, 3, outputOrigin_RAS[row]);
+        }
+      vtkSlicerCropVolumeLogic::vtkInternal::GetOutputIJKToInputImage(referenceInputVolume, cropItem.InputImage,
+        referenceOutputVolume, cropItem.OutputIJKToRAS, cropItem.OutputIJKToInputImage);
+      }
+    }
+  scene->RemoveNode(referenceInputVolume);
+  scene->RemoveNode(referenceOutputVolume);
+  if (errorCode != 0)
+    {
+    return errorCode;
+    }
+
+  // Crop the images in parallel. Filters are multi-threaded, too, which helps when there are only a few items.
+  double fillValue = pnode->GetFillValue();
+  int interpolationMode = pnode->GetInterpolationMode();
+  vtkSMPTools::For(0, numberOfItems, [&](vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType itemIndex = begin; itemIndex < end; ++itemIndex)
+      {
+      CropItem& cropItem = cropItems[itemIndex];
+      if (!cropItem.InputImage)
+        {
+        continue;
+        }
+      if (voxelBased)
+        {
+        vtkNew<vtkImageConstantPad> imageClip;
+        imageClip->SetInputData(cropItem.InputImage);
+        imageClip->SetOutputWholeExtent(cropItem.OutputExtent);
+        imageClip->SetConstant(fillValue);
+        imageClip->Update();
+        cropItem.OutputImage = vtkSmartPointer<vtkImageData>::New();
+        cropItem.OutputImage->ShallowCopy(imageClip->GetOutput());
+        }
+      else
+        {
+        cropItem.OutputImage = vtkSlicerCropVolumeLogic::vtkInternal::ResampleImage(cropItem.InputImage,
+          cropItem.OutputIJKToInputImage, cropItem.OutputExtent, interpolationMode, fillValue);
+        }
+      }
+    });
+
+  // Store results in the output sequence
+  MRMLNodeModifyBlocker blocker(outputSequenceNode);
+  if (!inPlace)
+    {
+    outputSequenceNode->RemoveAllDataNodes();
+    outputSequenceNode->SetIndexType(inputSequenceNode->GetIndexType());
+    outputSequenceNode->SetIndexName(inputSequenceNode->GetIndexName());
+    outputSequenceNode->SetIndexUnit(inputSequenceNode->GetIndexUnit());
+    }
+  for (int itemIndex = 0; itemIndex < numberOfItems; ++itemIndex)
+    {
+    CropItem& cropItem = cropItems[itemIndex];
+    vtkMRMLVolumeNode* inputVolume = vtkMRMLVolumeNode::SafeDownCast(inputSequenceNode->GetNthDataNode(itemIndex));
+    vtkSmartPointer<vtkMRMLVolumeNode> outputVolume = inputVolume;
+    if (!inPlace)
+      {
+      outputVolume = vtkSmartPointer<vtkMRMLVolumeNode>::Take(vtkMRMLVolumeNode::SafeDownCast(inputVolume->CreateNodeInstance()));
+      // Voxels are not copied, they are replaced by the cropped image
+      outputVolume->CopyContent(inputVolume, false);
+      outputVolume->SetName(inputVolume->GetName());
+      }
+    int wasModified = outputVolume->StartModify();
+    outputVolume->SetAndObserveImageData(cropItem.OutputImage);
+    outputVolume->SetIJKToRASMatrix(cropItem.OutputIJKToRAS);
+    if (voxelBased)
+      {
+      outputVolume->ShiftImageDataExtentToZeroStart();
+      }
+    outputVolume->EndModify(wasModified);
+    if (!inPlace)
+      {
+      // The node is not used anywhere else, so it is added to the sequence without making a copy
+      outputSequenceNode->SetDataNodeAtValue(outputVolume, inputSequenceNode->GetNthIndexValue(itemIndex), false);
+      }
+    }
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 int vtkSlicerCropVolumeLogic::CropVoxelBased(vtkMRMLDisplayableNode* roi,
   vtkMRMLVolumeNode* inputVolume, vtkMRMLVolumeNode* outputVolume, bool limitToInputExtent/*=true*/, double fillValue/*=0.0*/)
@@ -499,59 +896,34 @@ int vtkSlicerCropVolumeLogic::CropInterpolated(vtkMRMLDisplayableNode* roi, vtkM
 
   int outputExtent[6] = { 0, -1, 0, -1, 0, -1 };
   double outputSpacing[3] = { 0 };
-  this->GetInterpolatedCropOutputGeometry(roi, inputVolume, isotropicResampling, spacingScale, outputExtent, outputSpacing);
-
-  double roiXYZ[3] = { 0.0, 0.0, 0.0 };
-  double roiRadius[3] = { 0.0, 0.0, 0.0 };
-  vtkSlicerCropVolumeLogic::vtkInternal::GetROIXYZ(roi, roiXYZ);
-  vtkSlicerCropVolumeLogic::vtkInternal::GetROIRadius(roi, roiRadius);
-
+  // contains axis directions, in unconventional indexing (column, row)
+  double outputDirectionColRow[3][3] = {{ 0 }};
   vtkNew<vtkMatrix4x4> outputIJKToRAS;
-  outputIJKToRAS->SetElement(0, 0, outputSpacing[0]);
-  outputIJKToRAS->SetElement(1, 1, outputSpacing[1]);
-  outputIJKToRAS->SetElement(2, 2, outputSpacing[2]);
-  outputIJKToRAS->SetElement(0, 3, roiXYZ[0] - roiRadius[0]);
-  outputIJKToRAS->SetElement(1, 3, roiXYZ[1] - roiRadius[1]);
-  outputIJKToRAS->SetElement(2, 3, roiXYZ[2] - roiRadius[2]);
-
-  // account for the ROI parent transform, if present
-  vtkMRMLTransformNode *roiTransform = roi->GetParentTransformNode();
-  vtkMRMLTransformNode *outputTransform = outputVolume->GetParentTransformNode();
-  if (roiTransform && !roiTransform->IsTransformToWorldLinear())
+  double outputOrigin_RAS[4] = { 0.0, 0.0, 0.0, 1.0 };
+  int errorCode = vtkSlicerCropVolumeLogic::vtkInternal::GetInterpolatedCropOutputVoxelGeometry(roi, inputVolume, outputVolume,
+    isotropicResampling, spacingScale, outputExtent, outputSpacing, outputDirectionColRow, outputIJKToRAS, outputOrigin_RAS);
+  if (errorCode == -5)
     {
-    // We can only display a If ROI is transformed with a warping transform then we ignore the transformation because non-linear
-    // transform of ROI node is not supported.
     vtkErrorMacro("vtkSlicerCropVolumeLogic::CropInterpolated: ROI is under a non-linear transform");
-    return -5;
+    return errorCode;
     }
-  if (outputTransform && !outputTransform->IsTransformToWorldLinear())
+  if (errorCode == -6)
     {
-    // The resample module can only create a rectangular output.
     vtkErrorMacro("vtkSlicerCropVolumeLogic::CropInterpolated: output volume is under a non-linear transform");
-    return -6;
+    return errorCode;
     }
 
-  vtkNew<vtkMatrix4x4> roiMatrix;
-  vtkSlicerCropVolumeLogic::vtkInternal::GetMatrixTransformFromObjectToNode(roi, outputVolume, roiMatrix);
-  outputIJKToRAS->Multiply4x4(roiMatrix.GetPointer(), outputIJKToRAS.GetPointer(),
-    outputIJKToRAS.GetPointer());
-
-  vtkNew<vtkMatrix4x4> rasToLPS;
-  rasToLPS->SetElement(0, 0, -1);
-  rasToLPS->SetElement(1, 1, -1);
-  vtkNew<vtkMatrix4x4> outputIJKToLPS;
-  vtkMatrix4x4::Multiply4x4(rasToLPS.GetPointer(), outputIJKToRAS.GetPointer(), outputIJKToLPS.GetPointer());
-
-  // contains axis directions, in unconventional indexing (column, row)
-  // so that it can be conveniently normalized
-  double outputDirectionColRow[3][3] = {{ 0 }};
-  for (int column = 0; column < 3; column++)
+  if (vtkSlicerCropVolumeLogic::vtkInternal::CanResampleInProcess(inputVolume, outputVolume, interpolationMode))
     {
+    // Output geometry is the same as the resample module would create
+    vtkNew<vtkMatrix4x4> outputVoxelIJKToRAS;
+    outputVoxelIJKToRAS->DeepCopy(outputIJKToRAS);
     for (int row = 0; row < 3; row++)
       {
-      outputDirectionColRow[column][row] = outputIJKToLPS->GetElement(row, column);
+      outputVoxelIJKToRAS->SetElement(row, 3, outputOrigin_RAS[row]);
       }
-    outputSpacing[column] = vtkMath::Normalize(outputDirectionColRow[column]);
+    return vtkSlicerCropVolumeLogic::vtkInternal::ResampleInProcess(inputVolume, outputVolume, outputVoxelIJKToRAS,
+      outputExtent, interpolationMode, fillValue);
     }
 
   vtkMRMLCommandLineModuleNode* cmdNode = resampleLogic->CreateNodeInScene();
@@ -570,26 +942,6 @@ int vtkSlicerCropVolumeLogic::CropInterpolated(vtkMRMLDisplayableNode* roi, vtkM
     << (outputExtent[5] - outputExtent[4] + 1);
   cmdNode->SetParameterAsString("outputImageSize", sizeStream.str());
 
-  // Center the output image in the ROI. For that, compute the size difference between
-  // the ROI and the output image.
-  double sizeDifference_IJK[3] =
-    {
-    roiRadius[0] * 2 / outputSpacing[0] - (outputExtent[1] - outputExtent[0] + 1),
-    roiRadius[1] * 2 / outputSpacing[1] - (outputExtent[3] - outputExtent[2] + 1),
-    roiRadius[2] * 2 / outputSpacing[2] - (outputExtent[5] - outputExtent[4] + 1)
-    };
-  // Origin is in the voxel's center. Shift the origin by half voxel
-  // to have the ROI edge at the output image voxel edge.
-  double outputOrigin_IJK[4] =
-    {
-    0.5 + sizeDifference_IJK[0] / 2,
-    0.5 + sizeDifference_IJK[1] / 2,
-    0.5 + sizeDifference_IJK[2] / 2,
-    1.0
-    };
-  double outputOrigin_RAS[4] = { 0.0, 0.0, 0.0, 1.0 };
-  outputIJKToRAS->MultiplyPoint(outputOrigin_IJK, outputOrigin_RAS);
-
   vtkNew<vtkMRMLMarkupsFiducialNode> originMarkupNode;
   // Markups are transformed from RAS to LPS by the CLI infrastructure, so we pass them in RAS
   originMarkupNode->AddControlPoint(outputOrigin_RAS);
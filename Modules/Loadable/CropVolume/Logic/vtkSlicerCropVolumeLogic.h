@@ -27,6 +27,8 @@ class vtkSlicerCLIModuleLogic;
 class vtkSlicerVolumesLogic;
 class vtkMRMLVolumeNode;
 class vtkMRMLDisplayableNode;
+class vtkMRMLSequenceNode;
+class vtkMRMLTransformNode;
 // vtk includes
 class vtkMatrix4x4;
 // CropVolumes includes
@@ -53,7 +55,9 @@ class vtkMRMLCropVolumeParametersNode;
 /// almost no extra memory.
 ///
 /// If interpolation is enabled, then both the size and resolution
-/// of the volume can be changed.
+/// of the volume can be changed. Scalar volumes with nearest neighbor or linear
+/// interpolation are resampled directly (multi-threaded), other volume types and
+/// interpolation modes use the ResampleScalarVectorDWIVolume module.
 ///
 /// Limitations:
 /// * Region of interes (ROI) node cannot be under non-linear transform
@@ -74,6 +78,25 @@ public:
   /// Crop input volume using the specified ROI node.
   int Apply(vtkMRMLCropVolumeParametersNode*);
 
+  /// Crop all volumes of a sequence using the ROI and cropping settings of the parameter node
+  /// (input and output volumes of the parameter node are not used).
+  /// Cropped volumes are stored in outputSequenceNode, with the same index values as in the input.
+  /// If outputSequenceNode is the same as inputSequenceNode then volumes are cropped in place.
+  /// Volumes are cropped directly in the sequence, without updating proxy nodes, and in parallel.
+  /// \param inputVolumeTransformNode Parent transform of the input volumes (such as the parent transform of the proxy node).
+  /// \param outputVolumeTransformNode Parent transform of the output volumes. Only used for interpolated cropping,
+  ///   voxel-based cropping keeps the volumes in the same coordinate system.
+  /// eturn 0 on success, -2 if the sequence cannot be cropped by this method (see CanApplySequence).
+  int ApplySequence(vtkMRMLCropVolumeParametersNode* pnode, vtkMRMLSequenceNode* inputSequenceNode,
+    vtkMRMLSequenceNode* outputSequenceNode, vtkMRMLTransformNode* inputVolumeTransformNode=nullptr,
+    vtkMRMLTransformNode* outputVolumeTransformNode=nullptr);
+
+  /// Returns true if volumes of the sequence can be cropped using ApplySequence.
+  /// Voxel-based cropping is supported for all volumes except diffusion tensor volumes,
+  /// interpolated cropping is supported for scalar volumes (except tensor and diffusion weighted volumes)
+  /// with nearest neighbor and linear interpolation.
+  static bool CanApplySequence(vtkMRMLCropVolumeParametersNode* pnode, vtkMRMLSequenceNode* inputSequenceNode);
+
   /// Perform non-interpolated (voxel-based) cropping.
   /// If limitToInputExtent is set to true (default) then the extent can only be smaller than the input volume.
   static int CropVoxelBased(vtkMRMLDisplayableNode* roi, vtkMRMLVolumeNode* inputVolume,
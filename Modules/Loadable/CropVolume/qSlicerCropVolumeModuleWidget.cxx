@@ -1,6 +1,7 @@
 // Qt includes
 #include <QDebug>
 #include <QMessageBox>
+#include <QTimer>
 
 // CTK includes
 #include <ctkFlowLayout.h>
@@ -57,6 +58,10 @@ public:
   vtkWeakPointer<vtkMRMLCropVolumeParametersNode> ParametersNode;
   vtkWeakPointer<vtkMRMLVolumeNode> InputVolumeNode;
   vtkWeakPointer<vtkMRMLTransformableNode> InputROINode;
+
+  /// Compresses ROI modifications during live update, so that cropping is performed
+  /// only once when multiple modifications are pending.
+  QTimer LiveUpdateTimer;
 };
 
 //-----------------------------------------------------------------------------
@@ -275,6 +280,13 @@ void qSlicerCropVolumeModuleWidget::setup()
   connect(d->CropButton, SIGNAL(clicked()),
     this, SLOT(onApply()));
 
+  d->LiveUpdateTimer.setSingleShot(true);
+  d->LiveUpdateTimer.setInterval(0);
+  connect(&d->LiveUpdateTimer, SIGNAL(timeout()),
+    this, SLOT(onApply()));
+  connect(d->LiveUpdateCheckBox, SIGNAL(toggled(bool)),
+    this, SLOT(onLiveUpdateToggled(bool)));
+
 }
 
 //-----------------------------------------------------------------------------
@@ -428,6 +440,30 @@ void qSlicerCropVolumeModuleWidget::onApply()
   QApplication::restoreOverrideCursor();
 }
 
+//-----------------------------------------------------------------------------
+void qSlicerCropVolumeModuleWidget::onInputROIModified()
+{
+  Q_D(qSlicerCropVolumeModuleWidget);
+  if (!d->LiveUpdateCheckBox->isChecked() || !d->CropButton->isEnabled())
+    {
+    return;
+    }
+  d->LiveUpdateTimer.start();
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerCropVolumeModuleWidget::onLiveUpdateToggled(bool enabled)
+{
+  Q_D(qSlicerCropVolumeModuleWidget);
+  if (!enabled)
+    {
+    d->LiveUpdateTimer.stop();
+    return;
+    }
+  // Make the output volume up-to-date right away
+  this->onInputROIModified();
+}
+
 //-----------------------------------------------------------------------------
 void qSlicerCropVolumeModuleWidget::onFixAlignment()
 {
@@ -492,6 +528,7 @@ void qSlicerCropVolumeModuleWidget::setInputROI(vtkMRMLNode* node)
     roiNode = vtkMRMLTransformableNode::SafeDownCast(node);
     }
   qvtkReconnect(d->InputROINode, roiNode, vtkCommand::ModifiedEvent, this, SLOT(updateWidgetFromMRML()));
+  qvtkReconnect(d->InputROINode, roiNode, vtkCommand::ModifiedEvent, this, SLOT(onInputROIModified()));
   d->InputROINode = roiNode;
   d->ParametersNode->SetROINodeID(roiNode ? roiNode->GetID() : nullptr);
 }
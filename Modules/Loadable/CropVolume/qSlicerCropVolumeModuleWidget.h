@@ -47,6 +47,8 @@ protected slots:
   void onROIFit();
   void onInterpolationModeChanged();
   void onApply();
+  void onInputROIModified();
+  void onLiveUpdateToggled(bool);
   void onFixAlignment();
   void updateWidgetFromMRML();
   void onSpacingScalingValueChanged(double);
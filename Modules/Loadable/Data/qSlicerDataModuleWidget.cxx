@@ -45,10 +45,13 @@
 #include <vtkNew.h>
 #include <vtkSmartPointer.h>
 #include <vtkCallbackCommand.h>
+#include <vtkDoubleArray.h>
+#include <vtkStringArray.h>
 
 // Qt includes
 #include <QAction>
 #include <QDebug>
+#include <QTableWidgetItem>
 #include <QTimer>
 
 //-----------------------------------------------------------------------------
@@ -146,6 +149,9 @@ void qSlicerDataModuleWidget::setup()
   d->ViewTabWidget->widget(TabIndexAllNodes)->layout()->setContentsMargins(2,2,2,2);
   d->ViewTabWidget->widget(TabIndexAllNodes)->layout()->setSpacing(4);
 
+  d->ViewTabWidget->widget(TabIndexMemory)->layout()->setContentsMargins(2,2,2,2);
+  d->ViewTabWidget->widget(TabIndexMemory)->layout()->setSpacing(4);
+
   connect( d->ViewTabWidget, SIGNAL(currentChanged(int)),
           this, SLOT(onCurrentTabChanged(int)) );
 
@@ -259,6 +265,17 @@ void qSlicerDataModuleWidget::setup()
   // Make connections for the attribute table widget
   connect( d->AllNodesMRMLTreeView, SIGNAL(currentNodeChanged(vtkMRMLNode*)),
           d->MRMLNodeAttributeTableWidget, SLOT(setMRMLNode(vtkMRMLNode*)) );
+
+  //
+  // Memory tab
+
+  d->MemoryTableWidget->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+  d->MemoryTableWidget->horizontalHeader()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+  d->MemoryTableWidget->horizontalHeader()->setSectionResizeMode(2, QHeaderView::ResizeToContents);
+  connect( d->MemoryRefreshButton, SIGNAL(clicked()),
+          this, SLOT(updateMemoryUsage()) );
+  connect( d->MemoryWarningThresholdSpinBox, SIGNAL(valueChanged(double)),
+          this, SLOT(setMemoryWarningThreshold(double)) );
 }
 
 //-----------------------------------------------------------------------------
@@ -270,6 +287,14 @@ void qSlicerDataModuleWidget::setMRMLScene(vtkMRMLScene* scene)
 
   this->setMRMLIDsVisible(d->SubjectHierarchyDisplayDataNodeIDsCheckBox->isChecked());
   this->setTransformsVisible(d->SubjectHierarchyDisplayTransformsCheckBox->isChecked());
+
+  bool wasBlocked = d->MemoryWarningThresholdSpinBox->blockSignals(true);
+  d->MemoryWarningThresholdSpinBox->setValue(scene ? scene->GetMemorySizeWarningThreshold() / 1024.0 : 0.0);
+  d->MemoryWarningThresholdSpinBox->blockSignals(wasBlocked);
+  if (d->ViewTabWidget->currentIndex() == TabIndexMemory)
+    {
+    this->updateMemoryUsage();
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -349,6 +374,66 @@ void qSlicerDataModuleWidget::onCurrentTabChanged(int tabIndex)
     // Make sure MRML node attribute widget is updated
     d->MRMLNodeAttributeTableWidget->setMRMLNode(d->AllNodesMRMLTreeView->currentNode());
     }
+  else if (tabIndex == TabIndexMemory)
+    {
+    // Prevent the taller widget affect the size of the other
+    d->TransformMRMLTreeView->setVisible(false);
+    d->SubjectHierarchyTreeView->setVisible(false);
+    d->AllNodesMRMLTreeView->setVisible(false);
+
+    d->MRMLNodeAttributeTableWidget->setMRMLNode(nullptr);
+    this->updateMemoryUsage();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerDataModuleWidget::updateMemoryUsage()
+{
+  Q_D(qSlicerDataModuleWidget);
+
+  d->MemoryTableWidget->setSortingEnabled(false);
+  d->MemoryTableWidget->setRowCount(0);
+  vtkMRMLScene* scene = this->mrmlScene();
+  if (!scene)
+    {
+    d->MemorySummaryLabel->setText(QString());
+    return;
+    }
+
+  vtkNew<vtkStringArray> nodeIDs;
+  vtkNew<vtkDoubleArray> nodeMemorySizes;
+  double nodesMemorySize = scene->GetNodesMemorySize(nodeIDs, nodeMemorySizes);
+  double undoRedoMemorySize = scene->GetUndoRedoStacksMemorySize();
+  d->MemoryTableWidget->setRowCount(nodeIDs->GetNumberOfValues());
+  for (vtkIdType nodeIndex = 0; nodeIndex < nodeIDs->GetNumberOfValues(); ++nodeIndex)
+    {
+    vtkMRMLNode* node = scene->GetNodeByID(nodeIDs->GetValue(nodeIndex));
+    int row = static_cast<int>(nodeIndex);
+    d->MemoryTableWidget->setItem(row, 0, new QTableWidgetItem(node && node->GetName() ? QString::fromUtf8(node->GetName()) : QString()));
+    d->MemoryTableWidget->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(nodeIDs->GetValue(nodeIndex))));
+    QTableWidgetItem* memoryItem = new QTableWidgetItem();
+    // Set the value as a number (instead of string) to sort numerically
+    memoryItem->setData(Qt::DisplayRole, qRound(nodeMemorySizes->GetValue(nodeIndex) / 1024.0 * 10.0) / 10.0);
+    memoryItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    d->MemoryTableWidget->setItem(row, 2, memoryItem);
+    }
+  d->MemoryTableWidget->setSortingEnabled(true);
+  d->MemoryTableWidget->sortItems(2, Qt::DescendingOrder);
+
+  d->MemorySummaryLabel->setText(tr("Nodes: %1 MB, undo/redo history: %2 MB")
+    .arg(nodesMemorySize / 1024.0, 0, 'f', 1)
+    .arg(undoRedoMemorySize / 1024.0, 0, 'f', 1));
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerDataModuleWidget::setMemoryWarningThreshold(double thresholdMB)
+{
+  vtkMRMLScene* scene = this->mrmlScene();
+  if (!scene)
+    {
+    return;
+    }
+  scene->SetMemorySizeWarningThreshold(thresholdMB * 1024.0);
 }
 
 //-----------------------------------------------------------------------------
@@ -44,7 +44,8 @@ public:
     {
     TabIndexSubjectHierarchy = 0,
     TabIndexTransformHierarchy,
-    TabIndexAllNodes
+    TabIndexAllNodes,
+    TabIndexMemory
     };
 
 public slots:
@@ -69,6 +70,11 @@ public slots:
   /// Harden transform on current node
   void hardenTransformOnCurrentNode();
 
+  /// Update the memory usage table from the scene
+  void updateMemoryUsage();
+  /// Set memory size warning threshold of the scene (in MB, 0 disables the warning)
+  void setMemoryWarningThreshold(double thresholdMB);
+
 public:
   /// Assessor function for subject hierarchy model (for python)
   Q_INVOKABLE qMRMLSubjectHierarchyModel* subjectHierarchySceneModel()const;
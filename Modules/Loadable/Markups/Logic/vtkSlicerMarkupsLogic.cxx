@@ -1371,13 +1371,18 @@ void vtkSlicerMarkupsLogic::ConvertAnnotationFiducialsToMarkups()
     if (hierarchyNodeIDs->GetNumberOfValues() == 0)
       {
       hierarchyNodeIDs->Delete();
-      return;
+      continue;
       }
     else
       {
       vtkDebugMacro("Converting " << hierarchyNodeIDs->GetNumberOfValues()
                     << " annotation hierarchies to markup lists");
       }
+    // Legacy scenes may contain thousands of annotation fiducials, therefore nodes are added
+    // and removed in batch processing state, so that observers (such as displayable managers)
+    // update only once, at the end of the conversion.
+    scene->StartState(vtkMRMLScene::BatchProcessState);
+
     // now iterate over the hierarchies that have fiducials in them and convert
     // them to markups lists
     for (int i = 0; i < hierarchyNodeIDs->GetNumberOfValues(); ++i)
@@ -1403,6 +1408,9 @@ void vtkSlicerMarkupsLogic::ConvertAnnotationFiducialsToMarkups()
         {
         continue;
         }
+      // all control points are added before the markups node invokes modified events
+      MRMLNodeModifyBlocker blocker(markupsNode);
+
       // now get the fiducials in this annotation hierarchy
       vtkCollection *children = vtkCollection::New();
       hierarchyNode->GetAssociatedChildrenNodes(children, "vtkMRMLAnnotationFiducialNode");
@@ -1414,24 +1422,27 @@ void vtkSlicerMarkupsLogic::ConvertAnnotationFiducialsToMarkups()
           {
           continue;
           }
-        double coord[3];
-        annotNode->GetFiducialCoordinates(coord);
-        int fidIndex = markupsNode->AddControlPoint(vtkVector3d(coord), std::string(annotNode->GetName()));
-        vtkDebugMacro("Added a control point at index " << fidIndex);
+        // set all properties of the control point before adding it, to avoid invoking
+        // a point modified event for each property
+        vtkMRMLMarkupsNode::ControlPoint *controlPoint = new vtkMRMLMarkupsNode::ControlPoint;
+        annotNode->GetFiducialCoordinates(controlPoint->Position);
+        controlPoint->PositionStatus = vtkMRMLMarkupsNode::PositionDefined;
+        controlPoint->Label = annotNode->GetName() ? annotNode->GetName() : "";
         char *desc = annotNode->GetDescription();
         if (desc)
           {
-          markupsNode->SetNthControlPointDescription(fidIndex,std::string(desc));
+          controlPoint->Description = desc;
           }
-        markupsNode->SetNthControlPointSelected(fidIndex, annotNode->GetSelected());
-        markupsNode->SetNthControlPointVisibility(fidIndex,
-                                                  annotNode->GetDisplayVisibility());
-        markupsNode->SetNthControlPointLocked(fidIndex, annotNode->GetLocked());
+        controlPoint->Selected = annotNode->GetSelected();
+        controlPoint->Visibility = annotNode->GetDisplayVisibility();
+        controlPoint->Locked = annotNode->GetLocked();
         const char *assocNodeID = annotNode->GetAttribute("AssociatedNodeID");
         if (assocNodeID)
           {
-          markupsNode->SetNthControlPointAssociatedNodeID(fidIndex, assocNodeID);
+          controlPoint->AssociatedNodeID = assocNodeID;
           }
+        int fidIndex = markupsNode->AddControlPoint(controlPoint);
+        vtkDebugMacro("Added a control point at index " << fidIndex);
 
         // get the display nodes
         vtkMRMLAnnotationPointDisplayNode *pointDisplayNode = annotNode->GetAnnotationPointDisplayNode();
@@ -1490,6 +1501,7 @@ void vtkSlicerMarkupsLogic::ConvertAnnotationFiducialsToMarkups()
       children->RemoveAllItems();
       children->Delete();
       }
+    scene->EndState(vtkMRMLScene::BatchProcessState);
     hierarchyNodeIDs->Delete();
     } // end of looping over the scene
   sceneViews->RemoveAllItems();
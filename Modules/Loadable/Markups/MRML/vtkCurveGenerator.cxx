@@ -24,6 +24,7 @@
 // VTK includes
 #include <vtkCardinalSpline.h>
 #include <vtkDoubleArray.h>
+#include <vtkIdList.h>
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
 #include <vtkKochanekSpline.h>
@@ -35,6 +36,7 @@
 #include <vtkPointLocator.h>
 #include <vtkPolyData.h>
 #include <vtkSlicerDijkstraGraphGeodesicPath.h>
+#include <vtkSMPTools.h>
 
 #include <vtkLine.h>
 
@@ -63,6 +65,9 @@ vtkCurveGenerator::vtkCurveGenerator()
   this->PolynomialWeightFunction = vtkCurveGenerator::POLYNOMIAL_WEIGHT_FUNCTION_GAUSSIAN;
   this->PolynomialSampleWidth = 0.5;
   this->OutputCurveLength = 0.0;
+  this->IncrementalUpdate = true;
+  this->CachedInputSurfaceMTime = 0;
+  this->CachedMTime = 0;
 
   // timestamps for input and output are the same, initially
   this->Modified();
@@ -71,6 +76,7 @@ vtkCurveGenerator::vtkCurveGenerator()
   this->SurfacePointLocator = vtkSmartPointer<vtkPointLocator>::New();
   this->SurfacePathFilter = vtkSmartPointer<vtkSlicerDijkstraGraphGeodesicPath>::New();
   this->SurfacePathFilter->StopWhenEndReachedOn();
+  this->SurfacePointIds = vtkSmartPointer<vtkIdList>::New();
   this->InputParameters = nullptr;
   this->ParametricFunction = nullptr;
 }
@@ -90,6 +96,7 @@ void vtkCurveGenerator::PrintSelf(std::ostream &os, vtkIndent indent)
   os << indent << "KochanekTension: " << this->KochanekTension << std::endl;
   os << indent << "KochanekEndsCopyNearestDerivatives: " << this->KochanekEndsCopyNearestDerivatives << std::endl;
   os << indent << "PolynomialOrder: " << this->PolynomialOrder << std::endl;
+  os << indent << "IncrementalUpdate: " << this->IncrementalUpdate << std::endl;
   os << indent << "SurfaceCostFunctionType: " <<
     vtkSlicerDijkstraGraphGeodesicPath::GetCostFunctionTypeAsString(this->GetSurfaceCostFunctionType()) << std::endl;
 }
@@ -548,6 +555,7 @@ int vtkCurveGenerator::GeneratePoints(vtkPoints* inputPoints, vtkPolyData* input
     {
     if (!this->GeneratePointsFromFunction(inputPoints, outputPoints, outputPedigreeIdArray))
       {
+      this->CachedInputPoints = nullptr;
       return 0;
       }
     break;
@@ -555,16 +563,29 @@ int vtkCurveGenerator::GeneratePoints(vtkPoints* inputPoints, vtkPolyData* input
   case vtkCurveGenerator::CURVE_TYPE_SHORTEST_DISTANCE_ON_SURFACE:
     if (!this->GeneratePointsFromSurface(inputPoints, inputSurface, outputPoints, outputPedigreeIdArray))
       {
+      this->CachedInputPoints = nullptr;
       return 0;
       }
     break;
   default:
     {
     vtkErrorMacro("Error: Unrecognized curve type: " << this->CurveType << ".");
+    this->CachedInputPoints = nullptr;
     return 0;
     }
   }
 
+  // Store inputs and outputs so that next time only the modified segments have to be regenerated
+  if (!this->CachedInputPoints)
+    {
+    this->CachedInputPoints = vtkSmartPointer<vtkPoints>::New();
+    }
+  this->CachedInputPoints->DeepCopy(inputPoints);
+  this->CachedOutputPoints = outputPoints;
+  this->CachedInputSurface = inputSurface;
+  this->CachedInputSurfaceMTime = (inputSurface ? inputSurface->GetMTime() : 0);
+  this->CachedMTime = this->GetMTime();
+
   outputPolyData->SetPoints(outputPoints);
   outputPolyData->GetPointData()->AddArray(outputPedigreeIdArray);
   return 1;
@@ -627,22 +648,71 @@ int vtkCurveGenerator::GeneratePointsFromFunction(vtkPoints* inputPoints, vtkPoi
   outputPedigreeIdArray->Reset();
   outputPedigreeIdArray->FillComponent(0, 0.0);
 
-  double previousPoint[3] = { 0.0 };
-  for (int pointIndex = 0; pointIndex < totalNumberOfPoints; pointIndex++)
+  // Only linear and Kochanek splines have local support: a curve segment only depends on its
+  // two endpoints (linear) or also on the control points before and after (Kochanek).
+  // Cardinal splines are computed by solving a global system of equations, therefore moving
+  // a control point modifies all the segments.
+  std::vector<bool> modifiedSegments;
+  bool incrementalUpdate = false;
+  if (this->CurveType == vtkCurveGenerator::CURVE_TYPE_LINEAR_SPLINE)
     {
-    double sampleParameter = double(pointIndex) / ((double)(totalNumberOfPoints - 1));
-    double curvePoint[3];
-    this->ParametricFunction->Evaluate(&sampleParameter, curvePoint, nullptr);
-    outputPoints->InsertNextPoint(curvePoint);
-    if (pointIndex > 0)
+    incrementalUpdate = this->GetModifiedSegments(inputPoints, numberOfSegments, 1, 0, modifiedSegments);
+    }
+  else if (this->CurveType == vtkCurveGenerator::CURVE_TYPE_KOCHANEK_SPLINE)
+    {
+    incrementalUpdate = this->GetModifiedSegments(inputPoints, numberOfSegments, 2, 1, modifiedSegments);
+    }
+  if (incrementalUpdate
+    && (!this->CachedOutputPoints || this->CachedOutputPoints->GetNumberOfPoints() != totalNumberOfPoints
+    || static_cast<int>(this->CachedSegmentLengths.size()) != numberOfSegments))
+    {
+    incrementalUpdate = false;
+    }
+  if (incrementalUpdate)
+    {
+    outputPoints->DeepCopy(this->CachedOutputPoints);
+    }
+  else
+    {
+    outputPoints->SetNumberOfPoints(totalNumberOfPoints);
+    modifiedSegments.assign(numberOfSegments, true);
+    this->CachedSegmentLengths.assign(numberOfSegments, 0.0);
+    }
+
+  for (int segmentIndex = 0; segmentIndex < numberOfSegments; ++segmentIndex)
+    {
+    if (!modifiedSegments[segmentIndex])
       {
-      double segmentLength = sqrt(vtkMath::Distance2BetweenPoints(previousPoint, curvePoint));
-      this->OutputCurveLength += segmentLength;
+      continue;
       }
-    previousPoint[0] = curvePoint[0];
-    previousPoint[1] = curvePoint[1];
-    previousPoint[2] = curvePoint[2];
+    double segmentLength = 0.0;
+    double previousPoint[3] = { 0.0 };
+    int segmentStartPointIndex = segmentIndex * this->NumberOfPointsPerInterpolatingSegment;
+    for (int pointIndex = segmentStartPointIndex;
+      pointIndex <= segmentStartPointIndex + this->NumberOfPointsPerInterpolatingSegment; pointIndex++)
+      {
+      double sampleParameter = double(pointIndex) / ((double)(totalNumberOfPoints - 1));
+      double curvePoint[3];
+      this->ParametricFunction->Evaluate(&sampleParameter, curvePoint, nullptr);
+      outputPoints->SetPoint(pointIndex, curvePoint);
+      if (pointIndex > segmentStartPointIndex)
+        {
+        segmentLength += sqrt(vtkMath::Distance2BetweenPoints(previousPoint, curvePoint));
+        }
+      previousPoint[0] = curvePoint[0];
+      previousPoint[1] = curvePoint[1];
+      previousPoint[2] = curvePoint[2];
+      }
+    this->CachedSegmentLengths[segmentIndex] = segmentLength;
+    }
+  outputPoints->Modified();
+  for (double segmentLength : this->CachedSegmentLengths)
+    {
+    this->OutputCurveLength += segmentLength;
+    }
 
+  for (int pointIndex = 0; pointIndex < totalNumberOfPoints; pointIndex++)
+    {
     // Calculate pedigree ID for point
     // Each poly data point corresponding to a control point has the same ID as the control point index,
     // and the interpolating segment is a fractional value:
@@ -653,7 +723,7 @@ int vtkCurveGenerator::GeneratePointsFromFunction(vtkPoints* inputPoints, vtkPoi
     double pedigreeId = correspondingControlPointIndex
       + (double)interpolatedPointIndexAfterControlPoint / this->NumberOfPointsPerInterpolatingSegment;
     outputPedigreeIdArray->InsertValue(pointIndex, pedigreeId);
-  }
+    }
 
   return 1;
 }
@@ -662,6 +732,8 @@ int vtkCurveGenerator::GeneratePointsFromFunction(vtkPoints* inputPoints, vtkPoi
 int vtkCurveGenerator::GeneratePointsFromSurface(
   vtkPoints* inputPoints, vtkPolyData* inputSurface, vtkPoints* outputPoints, vtkDoubleArray* outputPedigreeIdArray)
 {
+  this->SurfacePointIds->Reset();
+
   // If there is no surface, there are no points. Don't report as an error.
   if (!inputSurface)
     {
@@ -685,35 +757,68 @@ int vtkCurveGenerator::GeneratePointsFromSurface(
     numberOfSegments = (numberOfInputPoints - 1);
     }
 
-  this->SurfacePathFilter->SetInputData(inputSurface);
+  // Each path only depends on its two endpoints, therefore only paths that end at a moved
+  // control point have to be computed again if the surface has not changed.
+  std::vector<bool> modifiedSegments;
+  if (!this->GetModifiedSegments(inputPoints, numberOfSegments, 1, 0, modifiedSegments)
+    || this->CachedInputSurface != inputSurface || this->CachedInputSurfaceMTime != inputSurface->GetMTime()
+    || static_cast<vtkIdType>(this->CachedSurfacePaths.size()) != numberOfSegments)
+    {
+    modifiedSegments.assign(numberOfSegments, true);
+    this->CachedSurfacePaths.assign(numberOfSegments, vtkSmartPointer<vtkIdList>());
+    }
+
+  // The graph of the surface is only built once, then the paths of the segments are computed in parallel
+  bool validGraph = this->SurfacePathFilter->UpdateGraph(inputSurface);
   this->SurfacePointLocator->SetDataSet(inputSurface);
   this->SurfacePointLocator->BuildLocator();
 
-  for (vtkIdType controlPointIndex = 0; controlPointIndex < numberOfSegments; ++controlPointIndex)
+  // Point locator is not thread-safe, therefore closest surface points are found beforehand
+  std::vector<vtkIdType> controlPointSurfaceIds(numberOfInputPoints, -1);
+  for (vtkIdType controlPointIndex = 0; controlPointIndex < numberOfInputPoints; ++controlPointIndex)
     {
-    double controlPoint1[3] = { 0 };
-    inputPoints->GetPoint(controlPointIndex, controlPoint1);
-    vtkIdType id1 = this->SurfacePointLocator->FindClosestPoint(controlPoint1);
-
-    double controlPoint2[3] = { 0 };
-    inputPoints->GetPoint((controlPointIndex + 1) % numberOfInputPoints, controlPoint2);
-    vtkIdType id2 = this->SurfacePointLocator->FindClosestPoint(controlPoint2);
+    double controlPoint[3] = { 0 };
+    inputPoints->GetPoint(controlPointIndex, controlPoint);
+    controlPointSurfaceIds[controlPointIndex] = this->SurfacePointLocator->FindClosestPoint(controlPoint);
+    }
 
-    // Path is traced backward, so start vertex should be point2, and end should be point1.
-    this->SurfacePathFilter->SetStartVertex(id2);
-    this->SurfacePathFilter->SetEndVertex(id1);
-    this->SurfacePathFilter->Update();
+  auto computePaths = [&](vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType controlPointIndex = begin; controlPointIndex < end; ++controlPointIndex)
+      {
+      if (!modifiedSegments[controlPointIndex])
+        {
+        continue;
+        }
+      vtkIdType id1 = controlPointSurfaceIds[controlPointIndex];
+      vtkIdType id2 = controlPointSurfaceIds[(controlPointIndex + 1) % numberOfInputPoints];
+      vtkSmartPointer<vtkIdList> pathIds = vtkSmartPointer<vtkIdList>::New();
+      // Path is traced backward, so start vertex should be point2, and end should be point1.
+      if (validGraph && !this->SurfacePathFilter->FindShortestPath(id2, id1, pathIds))
+        {
+        // No path on the surface, connect the points directly
+        pathIds->Reset();
+        pathIds->InsertNextId(id1);
+        pathIds->InsertNextId(id2);
+        }
+      this->CachedSurfacePaths[controlPointIndex] = pathIds;
+      }
+    };
+  vtkSMPTools::For(0, numberOfSegments, computePaths);
 
-    vtkPolyData* outputPath = this->SurfacePathFilter->GetOutput();
+  for (vtkIdType controlPointIndex = 0; controlPointIndex < numberOfSegments; ++controlPointIndex)
+    {
+    vtkIdList* pathIds = this->CachedSurfacePaths[controlPointIndex];
     double previousPoint[3] = { 0 };
-    for (vtkIdType pointIndex = 0; pointIndex < outputPath->GetNumberOfPoints(); ++pointIndex)
+    for (vtkIdType pointIndex = 0; pointIndex < pathIds->GetNumberOfIds(); ++pointIndex)
       {
       double curvePoint[3] = { 0 };
-      outputPath->GetPoint(pointIndex, curvePoint);
+      inputSurface->GetPoint(pathIds->GetId(pointIndex), curvePoint);
 
       if (controlPointIndex == 0 || pointIndex > 0)
         {
         vtkIdType outputPointId = outputPoints->InsertNextPoint(curvePoint);
+        this->SurfacePointIds->InsertNextId(pathIds->GetId(pointIndex));
         if (static_cast<vtkIdType>(this->InterpolatedPointIdsForControlPoints.size()) <= controlPointIndex)
           {
           this->InterpolatedPointIdsForControlPoints.push_back(outputPointId);
@@ -756,6 +861,46 @@ int vtkCurveGenerator::GeneratePointsFromSurface(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+bool vtkCurveGenerator::GetModifiedSegments(vtkPoints* inputPoints, vtkIdType numberOfSegments,
+  int segmentsBefore, int segmentsAfter, std::vector<bool>& modifiedSegments)
+{
+  if (!this->IncrementalUpdate || !this->CachedInputPoints || this->CachedMTime != this->GetMTime())
+    {
+    return false;
+    }
+  vtkIdType numberOfInputPoints = inputPoints->GetNumberOfPoints();
+  if (this->CachedInputPoints->GetNumberOfPoints() != numberOfInputPoints || numberOfSegments <= 0)
+    {
+    return false;
+    }
+
+  modifiedSegments.assign(numberOfSegments, false);
+  for (vtkIdType pointIndex = 0; pointIndex < numberOfInputPoints; ++pointIndex)
+    {
+    double point[3] = { 0.0 };
+    double cachedPoint[3] = { 0.0 };
+    inputPoints->GetPoint(pointIndex, point);
+    this->CachedInputPoints->GetPoint(pointIndex, cachedPoint);
+    if (point[0] == cachedPoint[0] && point[1] == cachedPoint[1] && point[2] == cachedPoint[2])
+      {
+      continue;
+      }
+    for (vtkIdType segmentIndex = pointIndex - segmentsBefore; segmentIndex <= pointIndex + segmentsAfter; ++segmentIndex)
+      {
+      if (this->CurveIsClosed)
+        {
+        modifiedSegments[(segmentIndex + numberOfSegments) % numberOfSegments] = true;
+        }
+      else if (segmentIndex >= 0 && segmentIndex < numberOfSegments)
+        {
+        modifiedSegments[segmentIndex] = true;
+        }
+      }
+    }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 int vtkCurveGenerator::GenerateLines(vtkPolyData* polyData)
 {
@@ -1033,7 +1178,7 @@ bool vtkCurveGenerator::IsInterpolatingCurve()
 //------------------------------------------------------------------------------
 vtkIdList* vtkCurveGenerator::GetSurfacePointIds()
 {
-  return this->SurfacePathFilter->GetIdList();
+  return this->SurfacePointIds;
 }
 
 //------------------------------------------------------------------------------
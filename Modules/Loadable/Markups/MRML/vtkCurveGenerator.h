@@ -27,9 +27,11 @@
 #include <vtkPolyDataAlgorithm.h>
 #include <vtkSetGet.h>
 #include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
 
 class vtkSlicerDijkstraGraphGeodesicPath;
 class vtkDoubleArray;
+class vtkIdList;
 class vtkPoints;
 class vtkSpline;
 
@@ -171,6 +173,14 @@ public:
   void SetPolynomialWeightFunctionToCosine() { this->SetPolynomialWeightFunction(vtkCurveGenerator::POLYNOMIAL_WEIGHT_FUNCTION_COSINE); }
   void SetPolynomialWeightFunctionToGaussian() { this->SetPolynomialWeightFunction(vtkCurveGenerator::POLYNOMIAL_WEIGHT_FUNCTION_GAUSSIAN); }
 
+  /// If enabled then only those curve segments are regenerated that are affected by the control points
+  /// that have been moved since the last update. It is used only if the curve type allows local
+  /// update (linear spline, Kochanek spline, shortest distance on surface), the number of control points
+  /// is unchanged, and no other parameters of the filter have been modified. Enabled by default.
+  vtkSetMacro(IncrementalUpdate, bool);
+  vtkGetMacro(IncrementalUpdate, bool);
+  vtkBooleanMacro(IncrementalUpdate, bool);
+
   /// If the surface scalars should be used to weight the distances in the pathfinding algorithm
   int GetSurfaceCostFunctionType();
   void SetSurfaceCostFunctionType(int surfaceCostFunctionType);
@@ -228,6 +238,7 @@ protected:
   double PolynomialSampleWidth;
   int PolynomialWeightFunction;
   std::vector<vtkIdType> InterpolatedPointIdsForControlPoints;
+  bool IncrementalUpdate;
 
   // internal storage
   vtkSmartPointer<vtkPointLocator> SurfacePointLocator;
@@ -235,6 +246,19 @@ protected:
   vtkSmartPointer<vtkDoubleArray> InputParameters;
   vtkSmartPointer<vtkParametricFunction> ParametricFunction;
 
+  // inputs and outputs of the last update, used for incremental update
+  vtkSmartPointer<vtkPoints> CachedInputPoints;
+  vtkSmartPointer<vtkPoints> CachedOutputPoints;
+  vtkWeakPointer<vtkPolyData> CachedInputSurface;
+  vtkMTimeType CachedInputSurfaceMTime;
+  vtkMTimeType CachedMTime;
+  /// Length of each curve segment (between two consecutive control points)
+  std::vector<double> CachedSegmentLengths;
+  /// Surface vertex ids along each curve segment, for shortest distance on surface curve type
+  std::vector<vtkSmartPointer<vtkIdList> > CachedSurfacePaths;
+  /// Surface vertex ids of all the output points, for shortest distance on surface curve type
+  vtkSmartPointer<vtkIdList> SurfacePointIds;
+
   // output
   double OutputCurveLength;
 
@@ -249,6 +273,13 @@ protected:
   int GeneratePointsFromSurface(vtkPoints* inputPoints, vtkPolyData* inputSurface, vtkPoints* outputPoints, vtkDoubleArray* outputPedigreeIdArray);
   int GenerateLines(vtkPolyData* polyData);
 
+  /// Get the list of curve segments that must be regenerated because the input points have been moved
+  /// since the last update. Moving control point i affects segments i-segmentsBefore to i+segmentsAfter
+  /// (segment i is between control points i and i+1).
+  /// \return False if the whole curve must be regenerated.
+  bool GetModifiedSegments(vtkPoints* inputPoints, vtkIdType numberOfSegments, int segmentsBefore, int segmentsAfter,
+    std::vector<bool>& modifiedSegments);
+
   int FillInputPortInformation(int port, vtkInformation* info) override;
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector) override;
 
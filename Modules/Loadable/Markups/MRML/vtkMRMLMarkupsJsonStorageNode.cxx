@@ -67,6 +67,293 @@ namespace
 
 #include <vtkMRMLMarkupsJsonStorageNode_Private.h>
 
+namespace
+{
+
+//---------------------------------------------------------------------------
+/// SAX handler that forwards all parsing events to the document, except the content of
+/// "controlPoints" arrays of markups, which is converted directly to control points.
+template <typename OutputHandler>
+class ControlPointsFilterHandler
+{
+public:
+  typedef char Ch;
+
+  ControlPointsFilterHandler(OutputHandler& output, vtkMRMLMarkupsJsonStorageNode::vtkInternal* internal,
+    bool readControlPoints, std::vector<std::pair<int, vtkMRMLMarkupsJsonStorageNode::vtkInternal::StreamedControlPointList> >& controlPointLists)
+    : Output(output)
+    , Internal(internal)
+    , ReadControlPoints(readControlPoints)
+    , ControlPointLists(controlPointLists)
+  {
+  }
+
+  bool Null()
+    {
+    if (this->CaptureDepth > 0)
+      {
+      this->InvalidValue();
+      return true;
+      }
+    return this->Output.Null();
+    }
+  bool Bool(bool b)
+    {
+    if (this->CaptureDepth > 0)
+      {
+      if (this->CaptureDepth == 2)
+        {
+        this->Item.BoolValues[this->CurrentKey] = b;
+        }
+      else
+        {
+        this->InvalidValue();
+        }
+      return true;
+      }
+    return this->Output.Bool(b);
+    }
+  bool Int(int i) { return this->CaptureDepth > 0 ? this->Number(i) : this->Output.Int(i); }
+  bool Uint(unsigned i) { return this->CaptureDepth > 0 ? this->Number(i) : this->Output.Uint(i); }
+  bool Int64(int64_t i) { return this->CaptureDepth > 0 ? this->Number(static_cast<double>(i)) : this->Output.Int64(i); }
+  bool Uint64(uint64_t i) { return this->CaptureDepth > 0 ? this->Number(static_cast<double>(i)) : this->Output.Uint64(i); }
+  bool Double(double d) { return this->CaptureDepth > 0 ? this->Number(d) : this->Output.Double(d); }
+  bool RawNumber(const Ch* str, rapidjson::SizeType length, bool copy)
+    {
+    if (this->CaptureDepth > 0)
+      {
+      this->InvalidValue();
+      return true;
+      }
+    return this->Output.RawNumber(str, length, copy);
+    }
+  bool String(const Ch* str, rapidjson::SizeType length, bool copy)
+    {
+    if (this->CaptureDepth > 0)
+      {
+      if (this->CaptureDepth == 2)
+        {
+        this->Item.StringValues[this->CurrentKey] = std::string(str, length);
+        }
+      else
+        {
+        this->InvalidValue();
+        }
+      return true;
+      }
+    return this->Output.String(str, length, copy);
+    }
+  bool Key(const Ch* str, rapidjson::SizeType length, bool copy)
+    {
+    this->CurrentKey = std::string(str, length);
+    if (this->CaptureDepth > 0)
+      {
+      return true;
+      }
+    return this->Output.Key(str, length, copy);
+    }
+  bool StartObject()
+    {
+    if (this->CaptureDepth > 0)
+      {
+      if (this->CaptureDepth == 1)
+        {
+        // Start of a control point
+        this->Item = vtkMRMLMarkupsJsonStorageNode::vtkInternal::ControlPointItem();
+        }
+      else
+        {
+        this->InvalidValue();
+        }
+      this->CaptureDepth++;
+      return true;
+      }
+    if (this->Containers.size() == 2 && this->IsMarkupsArrayOpen())
+      {
+      this->MarkupIndex++;
+      }
+    this->Containers.push_back(std::make_pair(true, this->CurrentKey));
+    return this->Output.StartObject();
+    }
+  bool EndObject(rapidjson::SizeType memberCount)
+    {
+    if (this->CaptureDepth > 0)
+      {
+      this->CaptureDepth--;
+      if (this->CaptureDepth == 1)
+        {
+        this->EndControlPoint();
+        }
+      return true;
+      }
+    this->Containers.pop_back();
+    return this->Output.EndObject(memberCount);
+    }
+  bool StartArray()
+    {
+    if (this->CaptureDepth > 0)
+      {
+      if (this->CaptureDepth == 2)
+        {
+        this->Vector.clear();
+        this->VectorValid = true;
+        this->VectorKey = this->CurrentKey;
+        }
+      else
+        {
+        this->InvalidValue();
+        }
+      this->CaptureDepth++;
+      return true;
+      }
+    if (this->CurrentKey == "controlPoints" && this->Containers.size() == 3 && this->Containers[2].first
+      && this->IsMarkupsArrayOpen())
+      {
+      // Start of a control points array of a markup
+      this->CaptureDepth = 1;
+      this->ControlPointIndex = 0;
+      this->ControlPointLists.emplace_back(this->MarkupIndex, vtkMRMLMarkupsJsonStorageNode::vtkInternal::StreamedControlPointList());
+      return true;
+      }
+    this->Containers.push_back(std::make_pair(false, this->CurrentKey));
+    return this->Output.StartArray();
+    }
+  bool EndArray(rapidjson::SizeType elementCount)
+    {
+    if (this->CaptureDepth > 0)
+      {
+      this->CaptureDepth--;
+      if (this->CaptureDepth == 0)
+        {
+        // End of the control points array, leave an empty array in the document
+        return this->Output.StartArray() && this->Output.EndArray(0);
+        }
+      if (this->CaptureDepth == 2)
+        {
+        if (this->VectorValid)
+          {
+          this->Item.VectorValues[this->VectorKey] = this->Vector;
+          }
+        else
+          {
+          this->Item.InvalidValues.insert(this->VectorKey);
+          }
+        }
+      return true;
+      }
+    this->Containers.pop_back();
+    return this->Output.EndArray(elementCount);
+    }
+
+protected:
+  /// Returns true if the first two open containers are the root object and its "markups" array
+  bool IsMarkupsArrayOpen()
+    {
+    return this->Containers.size() >= 2 && this->Containers[0].first
+      && !this->Containers[1].first && this->Containers[1].second == "markups";
+    }
+
+  bool Number(double value)
+    {
+    if (this->CaptureDepth == 3)
+      {
+      this->Vector.push_back(value);
+      }
+    else
+      {
+      this->InvalidValue();
+      }
+    return true;
+    }
+
+  void InvalidValue()
+    {
+    if (this->CaptureDepth == 1)
+      {
+      // Control point is not an object
+      this->Item = vtkMRMLMarkupsJsonStorageNode::vtkInternal::ControlPointItem();
+      this->Item.InvalidValues.insert("");
+      this->EndControlPoint();
+      }
+    else if (this->CaptureDepth == 2)
+      {
+      this->Item.InvalidValues.insert(this->CurrentKey);
+      }
+    else if (this->CaptureDepth == 3)
+      {
+      this->VectorValid = false;
+      }
+    }
+
+  void EndControlPoint()
+    {
+    vtkMRMLMarkupsJsonStorageNode::vtkInternal::StreamedControlPointList& controlPointList = this->ControlPointLists.back().second;
+    int controlPointIndex = this->ControlPointIndex++;
+    if (!this->ReadControlPoints || !controlPointList.Valid)
+      {
+      return;
+      }
+    vtkMRMLMarkupsJsonStorageNode::vtkInternal::StreamedControlPoint controlPoint;
+    if (!this->Internal->ReadControlPoint(this->Item, controlPointIndex, controlPoint))
+      {
+      controlPointList.Valid = false;
+      controlPointList.ControlPoints.clear();
+      return;
+      }
+    controlPointList.ControlPoints.push_back(std::move(controlPoint));
+    }
+
+  OutputHandler& Output;
+  vtkMRMLMarkupsJsonStorageNode::vtkInternal* Internal;
+  bool ReadControlPoints;
+  std::vector<std::pair<int, vtkMRMLMarkupsJsonStorageNode::vtkInternal::StreamedControlPointList> >& ControlPointLists;
+
+  /// Open containers outside of control points arrays (is object, key of the container in its parent)
+  std::vector<std::pair<bool, std::string> > Containers;
+  std::string CurrentKey;
+  int MarkupIndex{-1};
+
+  /// Nesting level inside a control points array (0 = not in array, 1 = in array, 2 = in control point, 3 = in vector)
+  int CaptureDepth{0};
+  int ControlPointIndex{0};
+  vtkMRMLMarkupsJsonStorageNode::vtkInternal::ControlPointItem Item;
+  std::vector<double> Vector;
+  std::string VectorKey;
+  bool VectorValid{true};
+};
+
+//---------------------------------------------------------------------------
+/// Populates a document from a stream, using ControlPointsFilterHandler
+template <typename InputStream>
+class ControlPointsFilterGenerator
+{
+public:
+  ControlPointsFilterGenerator(InputStream& stream, vtkMRMLMarkupsJsonStorageNode::vtkInternal* internal, bool readControlPoints)
+    : Stream(stream)
+    , Internal(internal)
+    , ReadControlPoints(readControlPoints)
+  {
+  }
+
+  template <typename Handler>
+  bool operator()(Handler& handler)
+    {
+    ControlPointsFilterHandler<Handler> filterHandler(handler, this->Internal, this->ReadControlPoints, this->ControlPointLists);
+    rapidjson::Reader reader;
+    this->ParseResult = reader.Parse<rapidjson::kParseDefaultFlags>(this->Stream, filterHandler);
+    return !this->ParseResult.IsError();
+    }
+
+  InputStream& Stream;
+  vtkMRMLMarkupsJsonStorageNode::vtkInternal* Internal;
+  bool ReadControlPoints;
+  rapidjson::ParseResult ParseResult;
+  /// Markup index and control points of each control points array
+  std::vector<std::pair<int, vtkMRMLMarkupsJsonStorageNode::vtkInternal::StreamedControlPointList> > ControlPointLists;
+};
+
+}
+
 //---------------------------------------------------------------------------
 // vtkInternal methods
 
@@ -101,8 +388,11 @@ std::string vtkMRMLMarkupsJsonStorageNode::vtkInternal::GetCoordinateUnitsFromSc
 }
 
 //---------------------------------------------------------------------------
-std::unique_ptr<rapidjson::Document> vtkMRMLMarkupsJsonStorageNode::vtkInternal::CreateJsonDocumentFromFile(const char* filePath)
+std::unique_ptr<rapidjson::Document> vtkMRMLMarkupsJsonStorageNode::vtkInternal::CreateJsonDocumentFromFile(const char* filePath,
+  bool readControlPoints/*=true*/)
 {
+  this->StreamedControlPoints.clear();
+
   // Read document from file
   FILE* fp = fopen(filePath, "r");
   if (!fp)
@@ -112,9 +402,11 @@ std::unique_ptr<rapidjson::Document> vtkMRMLMarkupsJsonStorageNode::vtkInternal:
     return nullptr;
     }
   std::unique_ptr<rapidjson::Document> jsonRoot = std::unique_ptr<rapidjson::Document>(new rapidjson::Document);
-  char buffer[4096];
+  char buffer[65536];
   rapidjson::FileReadStream fs(fp, buffer, sizeof(buffer));
-  if (jsonRoot->ParseStream(fs).HasParseError())
+  ControlPointsFilterGenerator<rapidjson::FileReadStream> generator(fs, this, readControlPoints);
+  jsonRoot->Populate(generator);
+  if (generator.ParseResult.IsError())
   {
     vtkErrorToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(), "vtkMRMLMarkupsJsonStorageNode::ReadDataInternal",
       "Error parsing the file'" << filePath << "'");
@@ -145,6 +437,26 @@ std::unique_ptr<rapidjson::Document> vtkMRMLMarkupsJsonStorageNode::vtkInternal:
     return nullptr;
     }
 
+  // Associate control points that were read during parsing with the (empty) control points arrays in the document
+  for (auto& controlPointList : generator.ControlPointLists)
+    {
+    if (!jsonRoot->HasMember("markups"))
+      {
+      break;
+      }
+    rapidjson::Value& markups = (*jsonRoot)["markups"];
+    if (!markups.IsArray() || controlPointList.first < 0 || controlPointList.first >= static_cast<int>(markups.Size()))
+      {
+      continue;
+      }
+    rapidjson::Value& markup = markups[controlPointList.first];
+    if (!markup.IsObject() || !markup.HasMember("controlPoints"))
+      {
+      continue;
+      }
+    this->StreamedControlPoints[&markup["controlPoints"]] = std::move(controlPointList.second);
+    }
+
   return jsonRoot;
 }
 
@@ -173,137 +485,248 @@ bool vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadVector(rapidjson::Value& it
 }
 
 //----------------------------------------------------------------------------
-bool vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoints(rapidjson::Value& controlPointsArray, int coordinateSystem, vtkMRMLMarkupsNode* markupsNode)
+void vtkMRMLMarkupsJsonStorageNode::vtkInternal::GetControlPointItemFromJsonValue(rapidjson::Value& controlPointValue,
+  ControlPointItem& controlPointItem)
 {
-  if (!markupsNode)
+  if (!controlPointValue.IsObject())
     {
-    vtkErrorToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
-      "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoints",
-      "File reading failed: invalid markups node");
-    return false;
-    }
-  if (!controlPointsArray.IsArray())
-    {
-    vtkErrorToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
-      "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoints",
-      "File reading failed: invalid controlPoints item (it is expected to be an array).");
-    return false;
+    controlPointItem.InvalidValues.insert("");
+    return;
     }
-  bool wasUpdatingPoints = markupsNode->IsUpdatingPoints;
-  markupsNode->IsUpdatingPoints = true;
-  for (rapidjson::SizeType controlPointIndex = 0; controlPointIndex < controlPointsArray.Size(); ++controlPointIndex)
+  for (rapidjson::Value::MemberIterator memberIt = controlPointValue.MemberBegin(); memberIt != controlPointValue.MemberEnd(); ++memberIt)
     {
-    rapidjson::Value& controlPointItem = controlPointsArray[controlPointIndex];
-    vtkMRMLMarkupsNode::ControlPoint* cp = new vtkMRMLMarkupsNode::ControlPoint;
-    if (controlPointItem.HasMember("id"))
-      {
-      cp->ID = controlPointItem["id"].GetString();
-      }
-    if (controlPointItem.HasMember("label"))
-      {
-      cp->Label = controlPointItem["label"].GetString();
-      }
-    if (controlPointItem.HasMember("description"))
-      {
-      cp->Description = controlPointItem["description"].GetString();
-      }
-    if (controlPointItem.HasMember("associatedNodeID"))
+    std::string key = memberIt->name.GetString();
+    rapidjson::Value& value = memberIt->value;
+    if (value.IsString())
       {
-      cp->AssociatedNodeID = controlPointItem["associatedNodeID"].GetString();
+      controlPointItem.StringValues[key] = value.GetString();
       }
-
-    if (controlPointItem.HasMember("positionStatus"))
+    else if (value.IsBool())
       {
-      int positionStatus = vtkMRMLMarkupsNode::GetPositionStatusFromString(controlPointItem["positionStatus"].GetString());
-      if (positionStatus < 0)
-        {
-        vtkErrorToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
-          "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoints",
-          "File reading failed: invalid positionStatus '" << controlPointItem["positionStatus"].GetString()
-          << "' for control point " << controlPointIndex + 1 << ".");
-        return false;
-        }
-      cp->PositionStatus = positionStatus;
+      controlPointItem.BoolValues[key] = value.GetBool();
       }
-    if (controlPointItem.HasMember("position"))
+    else if (value.IsArray())
       {
-      rapidjson::Value& positionItem = controlPointItem["position"];
-      if (!this->ReadVector(positionItem, cp->Position))
+      std::vector<double> vector;
+      bool valid = true;
+      for (rapidjson::SizeType i = 0; i < value.Size(); ++i)
         {
-        // If positionStatus is not defined there is a position value
-        // then it indicates that a valid position should be present,
-        // therefore it is an error that the position vector is invalid.
-        if (!controlPointItem.HasMember("positionStatus")
-          || cp->PositionStatus == vtkMRMLMarkupsNode::PositionDefined)
+        if (!value[i].IsNumber())
           {
-          vtkErrorToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
-            "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoints",
-            "File reading failed: position must be a 3-element numeric array"
-            << " for control point " << controlPointIndex + 1 << ".");
-          return false;
+          valid = false;
+          break;
           }
+        vector.push_back(value[i].GetDouble());
         }
-      if (coordinateSystem == vtkMRMLStorageNode::CoordinateSystemLPS)
+      if (valid)
         {
-        cp->Position[0] = -cp->Position[0];
-        cp->Position[1] = -cp->Position[1];
+        controlPointItem.VectorValues[key] = vector;
         }
-      if (!controlPointItem.HasMember("positionStatus"))
+      else
         {
-        cp->PositionStatus = vtkMRMLMarkupsNode::PositionDefined;
+        controlPointItem.InvalidValues.insert(key);
         }
       }
     else
       {
-      if (controlPointItem.HasMember("positionStatus")
-        && cp->PositionStatus == vtkMRMLMarkupsNode::PositionDefined)
-        {
-        vtkWarningToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
-          "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoints",
-          "File content is inconsistent: positionStatus is set to defined but no position values are provided"
-          << " for control point " << controlPointIndex + 1 << ".");
-        }
-      cp->PositionStatus = vtkMRMLMarkupsNode::PositionUndefined;
+      controlPointItem.InvalidValues.insert(key);
       }
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoint(ControlPointItem& controlPointItem, int controlPointIndex,
+  StreamedControlPoint& controlPoint)
+{
+  if (controlPointItem.InvalidValues.count(""))
+    {
+    vtkErrorToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
+      "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoint",
+      "File reading failed: control point " << controlPointIndex + 1 << " is expected to be an object.");
+    return false;
+    }
+  controlPoint.ControlPoint.reset(new vtkMRMLMarkupsNode::ControlPoint);
+  vtkMRMLMarkupsNode::ControlPoint* cp = controlPoint.ControlPoint.get();
+  std::map<std::string, std::string>& stringValues = controlPointItem.StringValues;
+  if (stringValues.count("id"))
+    {
+    cp->ID = stringValues["id"];
+    }
+  if (stringValues.count("label"))
+    {
+    cp->Label = stringValues["label"];
+    }
+  if (stringValues.count("description"))
+    {
+    cp->Description = stringValues["description"];
+    }
+  if (stringValues.count("associatedNodeID"))
+    {
+    cp->AssociatedNodeID = stringValues["associatedNodeID"];
+    }
 
-    if (controlPointItem.HasMember("orientation"))
+  bool hasPositionStatus = (stringValues.count("positionStatus") > 0);
+  if (hasPositionStatus)
+    {
+    int positionStatus = vtkMRMLMarkupsNode::GetPositionStatusFromString(stringValues["positionStatus"].c_str());
+    if (positionStatus < 0)
+      {
+      vtkErrorToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
+        "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoint",
+        "File reading failed: invalid positionStatus '" << stringValues["positionStatus"]
+        << "' for control point " << controlPointIndex + 1 << ".");
+      return false;
+      }
+    cp->PositionStatus = positionStatus;
+    }
+  controlPoint.HasPosition = (controlPointItem.VectorValues.count("position") > 0 || controlPointItem.InvalidValues.count("position") > 0);
+  if (controlPoint.HasPosition)
+    {
+    std::vector<double>& position = controlPointItem.VectorValues["position"];
+    if (position.size() == 3)
       {
-      rapidjson::Value& orientationItem = controlPointItem["orientation"];
-      if (!this->ReadVector(orientationItem, cp->OrientationMatrix, 9))
+      std::copy(position.begin(), position.end(), cp->Position);
+      }
+    else
+      {
+      // If positionStatus is not defined there is a position value
+      // then it indicates that a valid position should be present,
+      // therefore it is an error that the position vector is invalid.
+      if (!hasPositionStatus || cp->PositionStatus == vtkMRMLMarkupsNode::PositionDefined)
         {
         vtkErrorToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
-          "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoints",
+          "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoint",
           "File reading failed: position must be a 3-element numeric array"
           << " for control point " << controlPointIndex + 1 << ".");
         return false;
         }
-      if (coordinateSystem == vtkMRMLStorageNode::CoordinateSystemLPS)
-        {
-        for (int i = 0; i < 6; ++i)
-          {
-          cp->OrientationMatrix[i] *= -1.0;
-          }
-        }
       }
-
-    if (controlPointItem.HasMember("selected"))
+    if (!hasPositionStatus)
       {
-      cp->Selected = controlPointItem["selected"].GetBool();
+      cp->PositionStatus = vtkMRMLMarkupsNode::PositionDefined;
       }
-    if (controlPointItem.HasMember("locked"))
+    }
+  else
+    {
+    if (hasPositionStatus && cp->PositionStatus == vtkMRMLMarkupsNode::PositionDefined)
       {
-      cp->Locked = controlPointItem["locked"].GetBool();
+      vtkWarningToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
+        "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoint",
+        "File content is inconsistent: positionStatus is set to defined but no position values are provided"
+        << " for control point " << controlPointIndex + 1 << ".");
       }
-    if (controlPointItem.HasMember("visibility"))
+    cp->PositionStatus = vtkMRMLMarkupsNode::PositionUndefined;
+    }
+
+  controlPoint.HasOrientation = (controlPointItem.VectorValues.count("orientation") > 0 || controlPointItem.InvalidValues.count("orientation") > 0);
+  if (controlPoint.HasOrientation)
+    {
+    std::vector<double>& orientation = controlPointItem.VectorValues["orientation"];
+    if (orientation.size() != 9)
       {
-      cp->Visibility = controlPointItem["visibility"].GetBool();
+      vtkErrorToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
+        "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoint",
+        "File reading failed: orientation must be a 9-element numeric array"
+        << " for control point " << controlPointIndex + 1 << ".");
+      return false;
       }
+    std::copy(orientation.begin(), orientation.end(), cp->OrientationMatrix);
+    }
+
+  std::map<std::string, bool>& boolValues = controlPointItem.BoolValues;
+  if (boolValues.count("selected"))
+    {
+    cp->Selected = boolValues["selected"];
+    }
+  if (boolValues.count("locked"))
+    {
+    cp->Locked = boolValues["locked"];
+    }
+  if (boolValues.count("visibility"))
+    {
+    cp->Visibility = boolValues["visibility"];
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoints(rapidjson::Value& controlPointsArray, int coordinateSystem, vtkMRMLMarkupsNode* markupsNode)
+{
+  if (!markupsNode)
+    {
+    vtkErrorToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
+      "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoints",
+      "File reading failed: invalid markups node");
+    return false;
+    }
+  if (!controlPointsArray.IsArray())
+    {
+    vtkErrorToMessageCollectionWithObjectMacro(this->External, this->External->GetUserMessages(),
+      "vtkMRMLMarkupsJsonStorageNode::vtkInternal::ReadControlPoints",
+      "File reading failed: invalid controlPoints item (it is expected to be an array).");
+    return false;
+    }
 
+  StreamedControlPointList controlPoints;
+  auto streamedControlPointsIt = this->StreamedControlPoints.find(&controlPointsArray);
+  if (streamedControlPointsIt != this->StreamedControlPoints.end())
+    {
+    // Control points have been already read while parsing the file
+    controlPoints = std::move(streamedControlPointsIt->second);
+    this->StreamedControlPoints.erase(streamedControlPointsIt);
+    }
+  else
+    {
+    for (rapidjson::SizeType controlPointIndex = 0; controlPointIndex < controlPointsArray.Size(); ++controlPointIndex)
+      {
+      ControlPointItem controlPointItem;
+      this->GetControlPointItemFromJsonValue(controlPointsArray[controlPointIndex], controlPointItem);
+      StreamedControlPoint controlPoint;
+      if (!this->ReadControlPoint(controlPointItem, controlPointIndex, controlPoint))
+        {
+        controlPoints.Valid = false;
+        break;
+        }
+      controlPoints.ControlPoints.push_back(std::move(controlPoint));
+      }
+    }
+  if (!controlPoints.Valid)
+    {
+    // error is already logged
+    return false;
+    }
+
+  bool wasUpdatingPoints = markupsNode->IsUpdatingPoints;
+  markupsNode->IsUpdatingPoints = true;
+  markupsNode->ControlPoints.reserve(markupsNode->ControlPoints.size() + controlPoints.ControlPoints.size());
+  for (StreamedControlPoint& controlPoint : controlPoints.ControlPoints)
+    {
+    vtkMRMLMarkupsNode::ControlPoint* cp = controlPoint.ControlPoint.release();
+    if (coordinateSystem == vtkMRMLStorageNode::CoordinateSystemLPS)
+      {
+      if (controlPoint.HasPosition)
+        {
+        cp->Position[0] = -cp->Position[0];
+        cp->Position[1] = -cp->Position[1];
+        }
+      if (controlPoint.HasOrientation)
+        {
+        for (int i = 0; i < 6; ++i)
+          {
+          cp->OrientationMatrix[i] *= -1.0;
+          }
+        }
+      }
     markupsNode->AddControlPoint(cp, false);
     }
 
   markupsNode->IsUpdatingPoints = wasUpdatingPoints;
-  markupsNode->UpdateAllMeasurements();
+  if (!markupsNode->GetDisableModifiedEvent())
+    {
+    // If modified events are blocked then the curve and measurements are
+    // updated only once, when the points are all read and EndModify is called.
+    markupsNode->UpdateAllMeasurements();
+    }
 
   return true;
 }
@@ -1197,7 +1620,8 @@ bool vtkMRMLMarkupsJsonStorageNode::CanReadInReferenceNode(vtkMRMLNode *refNode)
 //----------------------------------------------------------------------------
 void vtkMRMLMarkupsJsonStorageNode::GetMarkupsTypesInFile(const char* filePath, std::vector<std::string>& outputMarkupsTypes)
 {
-  std::unique_ptr<rapidjson::Document> jsonRoot = this->Internal->CreateJsonDocumentFromFile(filePath);
+  // Control points are not needed for getting the markups types
+  std::unique_ptr<rapidjson::Document> jsonRoot = this->Internal->CreateJsonDocumentFromFile(filePath, false);
   if (!jsonRoot)
     {
     // error is already logged
@@ -20,6 +20,7 @@
 
 // MRML includes
 #include "vtkMRMLMarkupsJsonStorageNode.h"
+#include "vtkMRMLMarkupsNode.h"
 
 // Relax JSON standard and allow reading/writing of nan and inf
 // values. Such values should not normally occur, but if they do then
@@ -35,7 +36,11 @@
 #include "rapidjson/filereadstream.h"
 #include "rapidjson/filewritestream.h"
 
+#include <algorithm>
 #include <deque>
+#include <map>
+#include <set>
+#include <vector>
 
 //---------------------------------------------------------------------------
 class vtkMRMLMarkupsJsonStorageNode::vtkInternal
@@ -44,14 +49,45 @@ public:
   vtkInternal(vtkMRMLMarkupsJsonStorageNode* external);
   ~vtkInternal();
 
+  /// Control point properties as they are found in the file, before validation
+  struct ControlPointItem
+    {
+    std::map<std::string, std::string> StringValues;
+    std::map<std::string, bool> BoolValues;
+    std::map<std::string, std::vector<double> > VectorValues;
+    /// Keys of the values that have unexpected type
+    std::set<std::string> InvalidValues;
+    };
+
+  /// Validated control point, before conversion to the RAS coordinate system
+  struct StreamedControlPoint
+    {
+    std::unique_ptr<vtkMRMLMarkupsNode::ControlPoint> ControlPoint;
+    bool HasPosition{false};
+    bool HasOrientation{false};
+    };
+
+  struct StreamedControlPointList
+    {
+    std::vector<StreamedControlPoint> ControlPoints;
+    bool Valid{true};
+    };
+
   // Reader
-  std::unique_ptr<rapidjson::Document> CreateJsonDocumentFromFile(const char* filePath);
+
+  /// Parse the file. Control points are read while the file is parsed, without storing them
+  /// in the document (the "controlPoints" arrays are left empty in the document) to reduce memory usage.
+  /// \param readControlPoints If false then control points are skipped. It is useful for quickly
+  ///   querying markups information from a file.
+  std::unique_ptr<rapidjson::Document> CreateJsonDocumentFromFile(const char* filePath, bool readControlPoints=true);
   std::string GetMarkupsClassNameFromMarkupsType(std::string markupsType);
   std::string GetMarkupsClassNameFromJsonValue(rapidjson::Value& markupObject);
   virtual bool UpdateMarkupsNodeFromJsonValue (vtkMRMLMarkupsNode* markupsNode, rapidjson::Value& markupObject);
   bool UpdateMarkupsDisplayNodeFromJsonValue(vtkMRMLMarkupsDisplayNode* displayNode, rapidjson::Value& markupObject);
   bool ReadVector(rapidjson::Value& item, double* v, int numberOfComponents=3);
   bool ReadControlPoints(rapidjson::Value& item, int coordinateSystem, vtkMRMLMarkupsNode* markupsNode);
+  void GetControlPointItemFromJsonValue(rapidjson::Value& controlPointValue, ControlPointItem& controlPointItem);
+  bool ReadControlPoint(ControlPointItem& controlPointItem, int controlPointIndex, StreamedControlPoint& controlPoint);
   bool ReadMeasurements(rapidjson::Value& item, vtkMRMLMarkupsNode* markupsNode);
 
   // Writer
@@ -64,6 +100,9 @@ public:
 
   std::string GetCoordinateUnitsFromSceneAsString(vtkMRMLMarkupsNode* markupsNode);
 
+  /// Control points read while parsing the file, for each (empty) "controlPoints" array of the document
+  std::map<const rapidjson::Value*, StreamedControlPointList> StreamedControlPoints;
+
 protected:
   vtkMRMLMarkupsJsonStorageNode* External;
 };
@@ -40,12 +40,14 @@
 #include <vtkCollection.h>
 #include <vtkParallelTransportFrame.h>
 #include <vtkGeneralTransform.h>
+#include <vtkIdList.h>
 #include <vtkMatrix3x3.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPlane.h>
 #include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkPolyData.h>
 #include <vtkStringArray.h>
 #include <vtkTransform.h>
@@ -297,6 +299,10 @@ int vtkMRMLMarkupsNode::EndModify(int previousDisableModifiedEventState)
   if (processPendingPointModifiedEvents)
     {
     this->UpdateAllMeasurements();
+    if (this->GetDisplayNode())
+      {
+      this->GetDisplayNode()->UpdateScalarRange();
+      }
     }
   return wasModified;
 }
@@ -448,6 +454,8 @@ void vtkMRMLMarkupsNode::RemoveAllControlPoints()
     }
 
   this->ControlPoints.clear();
+  this->ControlPointIndexByID.clear();
+  this->ControlPointIndexByIDValid = true;
 
   if (!this->GetDisableModifiedEvent())
     {
@@ -622,6 +630,11 @@ int vtkMRMLMarkupsNode::AddControlPoint(ControlPoint *controlPoint, bool autoLab
     }
 
   this->ControlPoints.push_back(controlPoint);
+  if (this->ControlPointIndexByIDValid)
+    {
+    // Existing entry is kept if the ID is not unique, as lookup returns the first match
+    this->ControlPointIndexByID.emplace(controlPoint->ID, this->GetNumberOfControlPoints() - 1);
+    }
 
   if (!this->GetDisableModifiedEvent())
     {
@@ -838,6 +851,7 @@ void vtkMRMLMarkupsNode::RemoveNthControlPoint(int pointIndex)
 
   delete this->ControlPoints[static_cast<unsigned int> (pointIndex)];
   this->ControlPoints.erase(this->ControlPoints.begin() + pointIndex);
+  this->ControlPointIndexByIDValid = false;
 
   if (!this->GetDisableModifiedEvent())
     {
@@ -882,6 +896,7 @@ bool vtkMRMLMarkupsNode::InsertControlPoint(ControlPoint *controlPoint, int targ
 
   std::vector < ControlPoint* >::iterator pos = this->ControlPoints.begin() + destIndex;
   this->ControlPoints.insert(pos, controlPoint);
+  this->ControlPointIndexByIDValid = false;
 
   if (!this->GetDisableModifiedEvent())
     {
@@ -979,6 +994,7 @@ void vtkMRMLMarkupsNode::SwapControlPoints(int m1, int m2)
   *controlPoint1 = *controlPoint2;
   // and copy the backup of the first one into the second
   *controlPoint2 = controlPoint1Backup;
+  this->ControlPointIndexByIDValid = false;
 
   if (!this->GetDisableModifiedEvent())
     {
@@ -1052,10 +1068,10 @@ void vtkMRMLMarkupsNode::SetNthControlPointPosition(const int pointIndex,
   if (!this->GetDisableModifiedEvent())
     {
     this->UpdateAllMeasurements();
-    }
-  if (this->GetDisplayNode())
-    {
-    this->GetDisplayNode()->UpdateScalarRange();
+    if (this->GetDisplayNode())
+      {
+      this->GetDisplayNode()->UpdateScalarRange();
+      }
     }
 }
 
@@ -1547,14 +1563,36 @@ int vtkMRMLMarkupsNode::GetNthControlPointIndexByID(const char* controlPointID)
     {
     return -1;
     }
-  for (int controlPointIndex = 0; controlPointIndex < this->GetNumberOfControlPoints(); controlPointIndex++)
+  int numberOfControlPoints = this->GetNumberOfControlPoints();
+  for (int attempt = 0; attempt < 2; ++attempt)
     {
-    ControlPoint *compareControlPoint = this->ControlPoints[controlPointIndex];
-    if (compareControlPoint &&
-        strcmp(compareControlPoint->ID.c_str(), controlPointID) == 0)
+    if (!this->ControlPointIndexByIDValid)
+      {
+      this->ControlPointIndexByID.clear();
+      this->ControlPointIndexByID.reserve(numberOfControlPoints);
+      for (int controlPointIndex = 0; controlPointIndex < numberOfControlPoints; controlPointIndex++)
+        {
+        ControlPoint* controlPoint = this->ControlPoints[controlPointIndex];
+        if (controlPoint)
+          {
+          this->ControlPointIndexByID.emplace(controlPoint->ID, controlPointIndex);
+          }
+        }
+      this->ControlPointIndexByIDValid = true;
+      }
+    auto indexIt = this->ControlPointIndexByID.find(controlPointID);
+    if (indexIt == this->ControlPointIndexByID.end())
+      {
+      return -1;
+      }
+    int controlPointIndex = indexIt->second;
+    if (controlPointIndex < numberOfControlPoints && this->ControlPoints[controlPointIndex]
+      && this->ControlPoints[controlPointIndex]->ID == controlPointID)
       {
       return controlPointIndex;
       }
+    // The control point ID was changed directly in the control point, rebuild the index
+    this->ControlPointIndexByIDValid = false;
     }
   return -1;
 }
@@ -1588,6 +1626,7 @@ void vtkMRMLMarkupsNode::SetNthControlPointID(int n, std::string id)
     return;
     }
   controlPoint->ID = id;
+  this->ControlPointIndexByIDValid = false;
 }
 
 //---------------------------------------------------------------------------
@@ -2426,24 +2465,33 @@ void vtkMRMLMarkupsNode::SetControlPointPositionsWorld(vtkPoints* points)
   int wasModified = this->StartModify();
   this->IsUpdatingPoints = true;
 
-  vtkIdType numberOfPoints = points->GetNumberOfPoints();
+  vtkNew<vtkPoints> pointsLocal;
+  this->TransformPointsFromWorld(points, pointsLocal);
+  vtkIdType numberOfPoints = pointsLocal->GetNumberOfPoints();
+  int numberOfExistingPoints = this->GetNumberOfControlPoints();
   for (vtkIdType pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
     {
-    double* posWorld = points->GetPoint(pointIndex);
-    if (pointIndex < this->GetNumberOfControlPoints())
+    double* pos = pointsLocal->GetPoint(pointIndex);
+    if (pointIndex < numberOfExistingPoints)
       {
       // point already exists, just update it
-      this->SetNthControlPointPositionWorld(pointIndex, posWorld);
+      this->SetNthControlPointPosition(pointIndex, pos);
       }
     else
       {
       // need to add a new point
-      vtkMRMLMarkupsNode::AddControlPointWorld(vtkVector3d(posWorld));
+      vtkVector3d point(pos);
+      this->AddNControlPoints(1, std::string(), &point);
       }
     }
-  while (this->GetNumberOfControlPoints() > numberOfPoints)
+  if (numberOfExistingPoints > numberOfPoints)
     {
-    this->RemoveNthControlPoint(this->GetNumberOfControlPoints() - 1);
+    vtkNew<vtkIdList> pointIndicesToRemove;
+    for (vtkIdType pointIndex = numberOfPoints; pointIndex < numberOfExistingPoints; pointIndex++)
+      {
+      pointIndicesToRemove->InsertNextId(pointIndex);
+      }
+    this->RemoveControlPoints(pointIndicesToRemove);
     }
 
   this->IsUpdatingPoints = false;
@@ -2452,6 +2500,141 @@ void vtkMRMLMarkupsNode::SetControlPointPositionsWorld(vtkPoints* points)
   this->EndModify(wasModified);
 }
 
+//---------------------------------------------------------------------------
+int vtkMRMLMarkupsNode::AddControlPointsWorld(vtkPoints* points)
+{
+  if (!points)
+    {
+    vtkErrorMacro("AddControlPointsWorld: invalid point list");
+    return -1;
+    }
+  vtkIdType numberOfPoints = points->GetNumberOfPoints();
+  if (this->MaximumNumberOfControlPoints >= 0 && this->GetNumberOfControlPoints() + numberOfPoints > this->MaximumNumberOfControlPoints)
+    {
+    vtkErrorMacro("AddControlPointsWorld: number of existing points (" << this->GetNumberOfControlPoints()
+      << ") plus requested number of new points (" << numberOfPoints << ") are more than maximum number of control points allowed ("
+      << this->MaximumNumberOfControlPoints << ")");
+    return -1;
+    }
+  if (this->GetFixedNumberOfControlPoints())
+    {
+    vtkErrorMacro("AddControlPointsWorld: Markup node control point number is locked.");
+    return -1;
+    }
+  if (numberOfPoints == 0)
+    {
+    return this->GetNumberOfControlPoints() - 1;
+    }
+
+  int wasModified = this->StartModify();
+  this->IsUpdatingPoints = true;
+
+  vtkNew<vtkPoints> pointsLocal;
+  this->TransformPointsFromWorld(points, pointsLocal);
+  this->ControlPoints.reserve(this->ControlPoints.size() + numberOfPoints);
+  int controlPointIndex = -1;
+  for (vtkIdType pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
+    {
+    ControlPoint* controlPoint = new ControlPoint;
+    pointsLocal->GetPoint(pointIndex, controlPoint->Position);
+    controlPoint->PositionStatus = PositionDefined;
+    controlPointIndex = this->AddControlPoint(controlPoint);
+    }
+
+  this->IsUpdatingPoints = false;
+  this->EndModify(wasModified);
+  return controlPointIndex;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLMarkupsNode::RemoveControlPoints(vtkIdList* pointIndices)
+{
+  if (!pointIndices || pointIndices->GetNumberOfIds() == 0)
+    {
+    return;
+    }
+  if (this->GetFixedNumberOfControlPoints())
+    {
+    vtkErrorMacro("RemoveControlPoints: Markup node control point number is locked.");
+    return;
+    }
+
+  int numberOfControlPoints = this->GetNumberOfControlPoints();
+  std::vector<bool> removeControlPoint(numberOfControlPoints, false);
+  bool anyControlPointRemoved = false;
+  for (vtkIdType i = 0; i < pointIndices->GetNumberOfIds(); i++)
+    {
+    vtkIdType pointIndex = pointIndices->GetId(i);
+    if (pointIndex >= 0 && pointIndex < numberOfControlPoints)
+      {
+      removeControlPoint[pointIndex] = true;
+      anyControlPointRemoved = true;
+      }
+    }
+  if (!anyControlPointRemoved)
+    {
+    return;
+    }
+
+  int wasModified = this->StartModify();
+  this->IsUpdatingPoints = true;
+
+  bool definedPointsRemoved = false;
+  bool missingPointsRemoved = false;
+  int numberOfRemainingControlPoints = 0;
+  for (int pointIndex = 0; pointIndex < numberOfControlPoints; pointIndex++)
+    {
+    ControlPoint* controlPoint = this->ControlPoints[pointIndex];
+    if (!removeControlPoint[pointIndex])
+      {
+      this->ControlPoints[numberOfRemainingControlPoints++] = controlPoint;
+      continue;
+      }
+    this->InvokeCustomModifiedEvent(vtkMRMLMarkupsNode::PointAboutToBeRemovedEvent, static_cast<void*>(&pointIndex));
+    if (controlPoint->PositionStatus == vtkMRMLMarkupsNode::PositionDefined)
+      {
+      definedPointsRemoved = true;
+      }
+    if (controlPoint->PositionStatus == vtkMRMLMarkupsNode::PositionMissing)
+      {
+      missingPointsRemoved = true;
+      }
+    delete controlPoint;
+    this->InvokeCustomModifiedEvent(vtkMRMLMarkupsNode::PointRemovedEvent, static_cast<void*>(&pointIndex));
+    }
+  this->ControlPoints.resize(numberOfRemainingControlPoints);
+  this->ControlPointIndexByIDValid = false;
+
+  if (definedPointsRemoved)
+    {
+    this->InvokeCustomModifiedEvent(vtkMRMLMarkupsNode::PointPositionUndefinedEvent);
+    }
+  if (missingPointsRemoved)
+    {
+    this->InvokeCustomModifiedEvent(vtkMRMLMarkupsNode::PointPositionNonMissingEvent);
+    }
+  this->StorableModifiedTime.Modified();
+
+  this->IsUpdatingPoints = false;
+  // Curve and measurements are updated in EndModify()
+  this->EndModify(wasModified);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLMarkupsNode::TransformPointsFromWorld(vtkPoints* pointsWorld, vtkPoints* pointsLocal)
+{
+  vtkMRMLTransformNode* transformNode = this->GetParentTransformNode();
+  if (!transformNode)
+    {
+    pointsLocal->DeepCopy(pointsWorld);
+    return;
+    }
+  vtkNew<vtkGeneralTransform> transformFromWorld;
+  transformNode->GetTransformFromWorld(transformFromWorld);
+  pointsLocal->SetNumberOfPoints(0);
+  transformFromWorld->TransformPoints(pointsWorld, pointsLocal);
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLMarkupsNode::GetControlPointPositionsWorld(vtkPoints* points)
 {
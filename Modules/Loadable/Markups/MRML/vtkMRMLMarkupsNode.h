@@ -32,6 +32,9 @@
 #include <vtkSmartPointer.h>
 #include <vtkVector.h>
 
+// STD includes
+#include <unordered_map>
+
 class vtkMatrix3x3;
 class vtkMRMLUnitNode;
 class vtkParallelTransportFrame;
@@ -68,6 +71,7 @@ class vtkAlgorithmOutput;
 class vtkCollection;
 class vtkDataArray;
 class vtkGeneralTransform;
+class vtkIdList;
 class vtkMatrix4x4;
 class vtkMRMLMarkupsDisplayNode;
 class vtkPolyData;
@@ -314,6 +318,19 @@ public:
   /// Any extra existing control points are removed.
   void SetControlPointPositionsWorld(vtkPoints* points);
 
+  /// Add control points at the positions of a point list, defined in the world coordinate system.
+  /// Point events are invoked once for the whole list and the curve and measurements are
+  /// updated only once, after all the points are added.
+  /// If the requested number of points would result more points than the maximum allowed number of points
+  /// then no points are added at all.
+  /// Return index of the last added control point, -1 on failure.
+  int AddControlPointsWorld(vtkPoints* points);
+
+  /// Remove the control points of the specified indices.
+  /// Point events are invoked once for the whole list and the curve and measurements are
+  /// updated only once, after all the points are removed. Invalid indices are ignored.
+  void RemoveControlPoints(vtkIdList* pointIndices);
+
   /// Get a copy of all control point positions in world coordinate system
   void GetControlPointPositionsWorld(vtkPoints* points);
 
@@ -521,7 +538,8 @@ public:
   /// Get the id for the Nth control point
   std::string GetNthControlPointID(int n);
 
-  /// Get the Nth control point index based on it's ID
+  /// Get the Nth control point index based on it's ID.
+  /// The lookup uses a hash table that is updated lazily when control points are added, removed or renamed.
   int GetNthControlPointIndexByID(const char* controlPointID);
   /// Get the Nth control point based on it's ID
   ControlPoint* GetNthControlPointByID(const char* controlPointID);
@@ -935,6 +953,10 @@ protected:
 
   virtual void UpdateCurvePolyFromControlPoints();
 
+  /// Transform a point list from world coordinate system to the node coordinate system.
+  /// The world to node transform is only computed once for the whole list.
+  void TransformPointsFromWorld(vtkPoints* pointsWorld, vtkPoints* pointsLocal);
+
   void OnTransformNodeReferenceChanged(vtkMRMLTransformNode* transformNode) override;
 
   /// Calculate the updated measurements.
@@ -968,6 +990,11 @@ protected:
   /// Vector of control points
   ControlPointsListType ControlPoints;
 
+  /// Control point index by ID, used for fast lookup in GetNthControlPointIndexByID.
+  /// Only valid if ControlPointIndexByIDValid is set.
+  std::unordered_map<std::string, int> ControlPointIndexByID;
+  bool ControlPointIndexByIDValid{false};
+
   /// Converts curve control points to curve points.
   vtkSmartPointer<vtkCurveGenerator> CurveGenerator;
 
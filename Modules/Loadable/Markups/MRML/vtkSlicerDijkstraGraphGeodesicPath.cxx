@@ -22,11 +22,20 @@
 #include "vtkSlicerDijkstraGraphGeodesicPath.h"
 
 // VTK includes
+#include <vtkCellType.h>
 #include <vtkFloatArray.h>
+#include <vtkIdList.h>
 #include <vtkPointData.h>
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
 
+// STD includes
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSlicerDijkstraGraphGeodesicPath);
 
@@ -37,6 +46,9 @@ vtkSlicerDijkstraGraphGeodesicPath::vtkSlicerDijkstraGraphGeodesicPath()
   this->PreviousUseScalarWeights = this->UseScalarWeights;
   this->CostFunctionType = COST_FUNCTION_TYPE_DISTANCE;
   this->PreviousCostFunctionType = this->CostFunctionType;
+  this->GraphMinimumCostPerLength = 0.0;
+  this->GraphCostFunctionType = this->CostFunctionType;
+  this->GraphUseScalarWeights = this->UseScalarWeights;
 }
 
 //------------------------------------------------------------------------------
@@ -189,3 +201,167 @@ double vtkSlicerDijkstraGraphGeodesicPath::CalculateStaticEdgeCost(vtkDataSet* i
     }
   return cost;
 }
+
+//------------------------------------------------------------------------------
+bool vtkSlicerDijkstraGraphGeodesicPath::UpdateGraph(vtkPolyData* surface)
+{
+  if (!surface)
+    {
+    return false;
+    }
+  if (this->GraphSurface == surface
+    && this->GraphBuildTime.GetMTime() > surface->GetMTime()
+    && this->GraphCostFunctionType == this->CostFunctionType
+    && this->GraphUseScalarWeights == static_cast<bool>(this->UseScalarWeights))
+    {
+    // graph is up-to-date
+    return !this->GraphVertexPositions.empty();
+    }
+
+  this->GraphSurface = surface;
+  this->GraphCostFunctionType = this->CostFunctionType;
+  this->GraphUseScalarWeights = this->UseScalarWeights;
+  this->GraphBuildTime.Modified();
+
+  vtkIdType numberOfVertices = surface->GetNumberOfPoints();
+  this->GraphVertexPositions.resize(3 * numberOfVertices);
+  for (vtkIdType vertexId = 0; vertexId < numberOfVertices; ++vertexId)
+    {
+    surface->GetPoint(vertexId, &this->GraphVertexPositions[3 * vertexId]);
+    }
+
+  // Collect edges of polygons, the same way as vtkDijkstraGraphGeodesicPath::BuildAdjacency
+  std::vector<std::pair<vtkIdType, vtkIdType> > edges;
+  vtkIdType numberOfCells = surface->GetNumberOfCells();
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+    int cellType = surface->GetCellType(cellId);
+    if (cellType != VTK_POLYGON && cellType != VTK_TRIANGLE && cellType != VTK_QUAD)
+      {
+      continue;
+      }
+    vtkIdType numberOfCellPoints = 0;
+    const vtkIdType* cellPoints = nullptr;
+    surface->GetCellPoints(cellId, numberOfCellPoints, cellPoints);
+    for (vtkIdType i = 0; i < numberOfCellPoints; ++i)
+      {
+      vtkIdType u = cellPoints[i];
+      vtkIdType v = cellPoints[(i + 1) % numberOfCellPoints];
+      edges.emplace_back(u, v);
+      edges.emplace_back(v, u);
+      }
+    }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  this->GraphOffsets.assign(numberOfVertices + 1, 0);
+  this->GraphNeighbors.resize(edges.size());
+  this->GraphEdgeCosts.resize(edges.size());
+  this->GraphMinimumCostPerLength = std::numeric_limits<double>::infinity();
+  for (size_t edgeIndex = 0; edgeIndex < edges.size(); ++edgeIndex)
+    {
+    vtkIdType u = edges[edgeIndex].first;
+    vtkIdType v = edges[edgeIndex].second;
+    this->GraphOffsets[u + 1]++;
+    this->GraphNeighbors[edgeIndex] = v;
+    double cost = this->CalculateStaticEdgeCost(surface, u, v);
+    this->GraphEdgeCosts[edgeIndex] = cost;
+    double length = sqrt(vtkMath::Distance2BetweenPoints(&this->GraphVertexPositions[3 * u], &this->GraphVertexPositions[3 * v]));
+    if (length > 0.0)
+      {
+      this->GraphMinimumCostPerLength = std::min(this->GraphMinimumCostPerLength, cost / length);
+      }
+    }
+  for (vtkIdType vertexId = 0; vertexId < numberOfVertices; ++vertexId)
+    {
+    this->GraphOffsets[vertexId + 1] += this->GraphOffsets[vertexId];
+    }
+
+  // The heuristic must not overestimate the remaining cost, therefore the Euclidean distance
+  // is scaled by the lowest cost per unit length (the heuristic is not used if it is not positive).
+  if (!(this->GraphMinimumCostPerLength > 0.0) || this->GraphMinimumCostPerLength == std::numeric_limits<double>::infinity())
+    {
+    this->GraphMinimumCostPerLength = 0.0;
+    }
+
+  return numberOfVertices > 0;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSlicerDijkstraGraphGeodesicPath::FindShortestPath(vtkIdType startVertex, vtkIdType endVertex, vtkIdList* pathVertexIds)
+{
+  if (!pathVertexIds)
+    {
+    vtkErrorMacro("FindShortestPath failed: invalid pathVertexIds");
+    return false;
+    }
+  pathVertexIds->Reset();
+  vtkIdType numberOfVertices = static_cast<vtkIdType>(this->GraphVertexPositions.size() / 3);
+  if (startVertex < 0 || startVertex >= numberOfVertices || endVertex < 0 || endVertex >= numberOfVertices)
+    {
+    return false;
+    }
+
+  const double* endPosition = &this->GraphVertexPositions[3 * endVertex];
+  auto heuristic = [&](vtkIdType vertexId)
+    {
+    if (this->GraphMinimumCostPerLength <= 0.0)
+      {
+      return 0.0;
+      }
+    return this->GraphMinimumCostPerLength
+      * sqrt(vtkMath::Distance2BetweenPoints(&this->GraphVertexPositions[3 * vertexId], endPosition));
+    };
+
+  std::vector<double> costs(numberOfVertices, std::numeric_limits<double>::infinity());
+  std::vector<vtkIdType> predecessors(numberOfVertices, -1);
+  std::vector<bool> closed(numberOfVertices, false);
+
+  // (estimated total cost, vertex), smallest estimate first
+  typedef std::pair<double, vtkIdType> OpenVertex;
+  std::priority_queue<OpenVertex, std::vector<OpenVertex>, std::greater<OpenVertex> > openVertices;
+  costs[startVertex] = 0.0;
+  openVertices.emplace(heuristic(startVertex), startVertex);
+  while (!openVertices.empty())
+    {
+    vtkIdType u = openVertices.top().second;
+    openVertices.pop();
+    if (closed[u])
+      {
+      // already processed with a lower cost
+      continue;
+      }
+    if (u == endVertex)
+      {
+      break;
+      }
+    closed[u] = true;
+    for (vtkIdType edgeIndex = this->GraphOffsets[u]; edgeIndex < this->GraphOffsets[u + 1]; ++edgeIndex)
+      {
+      vtkIdType v = this->GraphNeighbors[edgeIndex];
+      if (closed[v])
+        {
+        continue;
+        }
+      double cost = costs[u] + this->GraphEdgeCosts[edgeIndex];
+      if (cost < costs[v])
+        {
+        costs[v] = cost;
+        predecessors[v] = u;
+        openVertices.emplace(cost + heuristic(v), v);
+        }
+      }
+    }
+
+  if (endVertex != startVertex && predecessors[endVertex] < 0)
+    {
+    // end vertex is not reachable
+    return false;
+    }
+  for (vtkIdType vertexId = endVertex; vertexId != startVertex; vertexId = predecessors[vertexId])
+    {
+    pathVertexIds->InsertNextId(vertexId);
+    }
+  pathVertexIds->InsertNextId(startVertex);
+  return true;
+}
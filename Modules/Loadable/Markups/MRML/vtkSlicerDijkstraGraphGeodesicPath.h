@@ -23,6 +23,10 @@
 
 // VTK includes
 #include <vtkDijkstraGraphGeodesicPath.h>
+#include <vtkWeakPointer.h>
+
+// STD includes
+#include <vector>
 
 // export
 #include "vtkSlicerMarkupsModuleMRMLExport.h"
@@ -54,6 +58,19 @@ public:
   vtkSetMacro(CostFunctionType, int);
   vtkGetMacro(CostFunctionType, int);
 
+  /// Build the graph (vertex adjacency and edge costs) of the surface for FindShortestPath.
+  /// The graph is only rebuilt if the surface, the cost function type, or UseScalarWeights has changed
+  /// since the last call.
+  /// \return False if the surface has no vertices.
+  bool UpdateGraph(vtkPolyData* surface);
+
+  /// Find the shortest path between two vertices of the surface that was set in the last UpdateGraph call.
+  /// The path is found using A* search, with a heuristic based on the Euclidean distance to the end vertex.
+  /// The method does not modify the graph, therefore it can be called concurrently from multiple threads.
+  /// \param pathVertexIds Vertex ids along the path, from endVertex to startVertex (same order as in IdList).
+  /// \return False if the end vertex cannot be reached from the start vertex.
+  bool FindShortestPath(vtkIdType startVertex, vtkIdType endVertex, vtkIdList* pathVertexIds);
+
 protected:
   /// Reimplemented to rebuild the adjacency info if either CostFunctionType or UseScalarWeights are changed.
   int RequestData(vtkInformation*, vtkInformationVector**,
@@ -68,6 +85,19 @@ protected:
   int PreviousCostFunctionType;
   bool PreviousUseScalarWeights;
 
+  /// Graph used by FindShortestPath, in compressed sparse row format: edges starting from vertex i
+  /// are stored in GraphNeighbors and GraphEdgeCosts from GraphOffsets[i] to GraphOffsets[i+1]-1.
+  std::vector<vtkIdType> GraphOffsets;
+  std::vector<vtkIdType> GraphNeighbors;
+  std::vector<double> GraphEdgeCosts;
+  std::vector<double> GraphVertexPositions;
+  /// Lower bound of edge cost per unit length, used for scaling the A* heuristic
+  double GraphMinimumCostPerLength;
+  vtkWeakPointer<vtkPolyData> GraphSurface;
+  vtkTimeStamp GraphBuildTime;
+  int GraphCostFunctionType;
+  bool GraphUseScalarWeights;
+
 protected:
   vtkSlicerDijkstraGraphGeodesicPath();
   ~vtkSlicerDijkstraGraphGeodesicPath() override;
@@ -0,0 +1,215 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// Markups includes
+#include "vtkCurveGenerator.h"
+#include "vtkSlicerDijkstraGraphGeodesicPath.h"
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+
+// VTK includes
+#include <vtkCellArray.h>
+#include <vtkIdList.h>
+#include <vtkMath.h>
+#include <vtkNew.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+int TestIncrementalUpdate(int curveType, bool closed)
+{
+  const int numberOfControlPoints = 12;
+  vtkNew<vtkPoints> controlPoints;
+  for (int i = 0; i < numberOfControlPoints; ++i)
+    {
+    controlPoints->InsertNextPoint(10.0 * cos(i * 0.5), 10.0 * sin(i * 0.5), 2.0 * i);
+    }
+
+  vtkNew<vtkCurveGenerator> incrementalGenerator;
+  incrementalGenerator->SetCurveType(curveType);
+  incrementalGenerator->SetCurveIsClosed(closed);
+  incrementalGenerator->SetNumberOfPointsPerInterpolatingSegment(7);
+  incrementalGenerator->SetInputPoints(controlPoints);
+  incrementalGenerator->Update();
+
+  vtkNew<vtkCurveGenerator> fullGenerator;
+  fullGenerator->SetCurveType(curveType);
+  fullGenerator->SetCurveIsClosed(closed);
+  fullGenerator->SetNumberOfPointsPerInterpolatingSegment(7);
+  fullGenerator->IncrementalUpdateOff();
+  fullGenerator->SetInputPoints(controlPoints);
+
+  // Move points at the ends and in the middle of the curve
+  const int movedPointIndices[] = { 0, 5, numberOfControlPoints - 1, 6 };
+  for (int movedPointIndex : movedPointIndices)
+    {
+    double position[3] = { 0.0 };
+    controlPoints->GetPoint(movedPointIndex, position);
+    position[0] += 3.0;
+    position[2] -= 1.5;
+    controlPoints->SetPoint(movedPointIndex, position);
+    controlPoints->Modified();
+
+    incrementalGenerator->Update();
+    fullGenerator->Update();
+
+    vtkPoints* incrementalPoints = incrementalGenerator->GetOutputPoints();
+    vtkPoints* fullPoints = fullGenerator->GetOutputPoints();
+    CHECK_NOT_NULL(incrementalPoints);
+    CHECK_NOT_NULL(fullPoints);
+    CHECK_INT(incrementalPoints->GetNumberOfPoints(), fullPoints->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < fullPoints->GetNumberOfPoints(); ++i)
+      {
+      double incrementalPoint[3] = { 0.0 };
+      double fullPoint[3] = { 0.0 };
+      incrementalPoints->GetPoint(i, incrementalPoint);
+      fullPoints->GetPoint(i, fullPoint);
+      CHECK_DOUBLE_TOLERANCE(sqrt(vtkMath::Distance2BetweenPoints(incrementalPoint, fullPoint)), 0.0, 1e-6);
+      }
+    CHECK_DOUBLE_TOLERANCE(incrementalGenerator->GetOutputCurveLength(), fullGenerator->GetOutputCurveLength(), 1e-6);
+    }
+
+  // Adding a point regenerates the whole curve
+  controlPoints->InsertNextPoint(0.0, 0.0, 30.0);
+  controlPoints->Modified();
+  incrementalGenerator->Update();
+  fullGenerator->Update();
+  CHECK_INT(incrementalGenerator->GetOutputPoints()->GetNumberOfPoints(), fullGenerator->GetOutputPoints()->GetNumberOfPoints());
+  CHECK_DOUBLE_TOLERANCE(incrementalGenerator->GetOutputCurveLength(), fullGenerator->GetOutputCurveLength(), 1e-6);
+
+  return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+void CreateSurface(vtkPolyData* surface)
+{
+  // Triangulated height map
+  const int size = 40;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < size; ++j)
+    {
+    for (int i = 0; i < size; ++i)
+      {
+      points->InsertNextPoint(i, j, 3.0 * sin(i * 0.3) * cos(j * 0.2));
+      }
+    }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < size - 1; ++j)
+    {
+    for (int i = 0; i < size - 1; ++i)
+      {
+      vtkIdType p0 = j * size + i;
+      vtkIdType triangle1[3] = { p0, p0 + 1, p0 + size + 1 };
+      vtkIdType triangle2[3] = { p0, p0 + size + 1, p0 + size };
+      polys->InsertNextCell(3, triangle1);
+      polys->InsertNextCell(3, triangle2);
+      }
+    }
+  surface->SetPoints(points);
+  surface->SetPolys(polys);
+}
+
+//----------------------------------------------------------------------------
+double GetPathLength(vtkPolyData* surface, vtkIdList* pathIds)
+{
+  double length = 0.0;
+  for (vtkIdType i = 1; i < pathIds->GetNumberOfIds(); ++i)
+    {
+    double p1[3] = { 0.0 };
+    double p2[3] = { 0.0 };
+    surface->GetPoint(pathIds->GetId(i - 1), p1);
+    surface->GetPoint(pathIds->GetId(i), p2);
+    length += sqrt(vtkMath::Distance2BetweenPoints(p1, p2));
+    }
+  return length;
+}
+
+//----------------------------------------------------------------------------
+int TestShortestPathOnSurface()
+{
+  vtkNew<vtkPolyData> surface;
+  CreateSurface(surface);
+
+  // Paths found using the cached graph are as short as the paths of vtkDijkstraGraphGeodesicPath
+  vtkNew<vtkSlicerDijkstraGraphGeodesicPath> pathFilter;
+  pathFilter->StopWhenEndReachedOn();
+  pathFilter->SetInputData(surface);
+  CHECK_BOOL(pathFilter->UpdateGraph(surface), true);
+  const vtkIdType vertexPairs[][2] = { { 0, 1599 }, { 45, 1210 }, { 1560, 39 } };
+  for (const auto& vertexPair : vertexPairs)
+    {
+    pathFilter->SetStartVertex(vertexPair[0]);
+    pathFilter->SetEndVertex(vertexPair[1]);
+    pathFilter->Update();
+    vtkNew<vtkIdList> pathIds;
+    CHECK_BOOL(pathFilter->FindShortestPath(vertexPair[0], vertexPair[1], pathIds), true);
+    CHECK_INT(pathIds->GetId(0), vertexPair[1]);
+    CHECK_INT(pathIds->GetId(pathIds->GetNumberOfIds() - 1), vertexPair[0]);
+    CHECK_DOUBLE_TOLERANCE(GetPathLength(surface, pathIds), GetPathLength(surface, pathFilter->GetIdList()), 1e-6);
+    }
+
+  // Incremental update of a curve on the surface
+  vtkNew<vtkPoints> controlPoints;
+  controlPoints->InsertNextPoint(2.0, 3.0, 0.0);
+  controlPoints->InsertNextPoint(20.0, 5.0, 0.0);
+  controlPoints->InsertNextPoint(30.0, 30.0, 0.0);
+  controlPoints->InsertNextPoint(5.0, 35.0, 0.0);
+
+  vtkNew<vtkCurveGenerator> incrementalGenerator;
+  incrementalGenerator->SetCurveTypeToShortestDistanceOnSurface();
+  incrementalGenerator->SetInputPoints(controlPoints);
+  incrementalGenerator->SetInputData(1, surface);
+  incrementalGenerator->Update();
+
+  vtkNew<vtkCurveGenerator> fullGenerator;
+  fullGenerator->SetCurveTypeToShortestDistanceOnSurface();
+  fullGenerator->IncrementalUpdateOff();
+  fullGenerator->SetInputPoints(controlPoints);
+  fullGenerator->SetInputData(1, surface);
+
+  controlPoints->SetPoint(2, 25.0, 20.0, 0.0);
+  controlPoints->Modified();
+  incrementalGenerator->Update();
+  fullGenerator->Update();
+  CHECK_INT(incrementalGenerator->GetOutputPoints()->GetNumberOfPoints(), fullGenerator->GetOutputPoints()->GetNumberOfPoints());
+  CHECK_INT(incrementalGenerator->GetSurfacePointIds()->GetNumberOfIds(), fullGenerator->GetOutputPoints()->GetNumberOfPoints());
+  CHECK_DOUBLE_TOLERANCE(incrementalGenerator->GetOutputCurveLength(), fullGenerator->GetOutputCurveLength(), 1e-6);
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+//----------------------------------------------------------------------------
+int vtkCurveGeneratorTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  const int curveTypes[] = {
+    vtkCurveGenerator::CURVE_TYPE_LINEAR_SPLINE,
+    vtkCurveGenerator::CURVE_TYPE_CARDINAL_SPLINE,
+    vtkCurveGenerator::CURVE_TYPE_KOCHANEK_SPLINE,
+    vtkCurveGenerator::CURVE_TYPE_POLYNOMIAL
+    };
+  for (int curveType : curveTypes)
+    {
+    CHECK_EXIT_SUCCESS(TestIncrementalUpdate(curveType, false));
+    CHECK_EXIT_SUCCESS(TestIncrementalUpdate(curveType, true));
+    }
+  CHECK_EXIT_SUCCESS(TestShortestPathOnSurface());
+  return EXIT_SUCCESS;
+}
@@ -22,10 +22,13 @@
 // VTK includes
 #include <vtkIndent.h>
 #include <vtkMath.h>
+#include <vtkIdList.h>
 #include <vtkNew.h>
+#include <vtkPoints.h>
 #include <vtkTestingOutputWindow.h>
 
 // STL includes
+#include <algorithm>
 #include <vector>
 
 #include "vtkMRMLCoreTestingMacros.h"
@@ -82,6 +85,13 @@ bool containsEvent(vtkMRMLMarkupNodeObserver* observer, int eventId)
   return found;
 }
 
+int countEvent(vtkMRMLMarkupNodeObserver* observer, int eventId)
+{
+  int count = static_cast<int>(std::count(observer->invokedEvents.begin(), observer->invokedEvents.end(), eventId));
+  observer->invokedEvents.clear();
+  return count;
+}
+
 }
 
 int vtkMRMLMarkupsNodeEventsTest(int, char* [])
@@ -150,5 +160,39 @@ int vtkMRMLMarkupsNodeEventsTest(int, char* [])
   node->RemoveNthControlPoint(0);
   CHECK_BOOL(containsEvent(observer, vtkMRMLMarkupsNode::PointAboutToBeRemovedEvent), true);
 
+  // Test 13: batch insertion invokes a single PointAddedEvent
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 100; ++i)
+    {
+    points->InsertNextPoint(i, 2.0 * i, 3.0 * i);
+    }
+  CHECK_INT(node->AddControlPointsWorld(points), 99);
+  CHECK_INT(node->GetNumberOfControlPoints(), 100);
+  double position[3] = { 0.0, 0.0, 0.0 };
+  node->GetNthControlPointPositionWorld(50, position);
+  CHECK_DOUBLE(position[1], 100.0);
+  CHECK_INT(countEvent(observer, vtkMRMLMarkupsNode::PointAddedEvent), 1);
+
+  // Test 14: batch removal invokes a single PointRemovedEvent
+  vtkNew<vtkIdList> pointIndices;
+  for (int i = 0; i < 100; i += 2)
+    {
+    pointIndices->InsertNextId(i);
+    }
+  node->RemoveControlPoints(pointIndices);
+  CHECK_INT(node->GetNumberOfControlPoints(), 50);
+  node->GetNthControlPointPositionWorld(0, position);
+  CHECK_DOUBLE(position[0], 1.0);
+  CHECK_INT(countEvent(observer, vtkMRMLMarkupsNode::PointRemovedEvent), 1);
+
+  // Test 15: batch update invokes a single PointModifiedEvent
+  node->SetControlPointPositionsWorld(points);
+  CHECK_INT(node->GetNumberOfControlPoints(), 100);
+  CHECK_INT(countEvent(observer, vtkMRMLMarkupsNode::PointModifiedEvent), 1);
+  points->SetNumberOfPoints(10);
+  node->SetControlPointPositionsWorld(points);
+  CHECK_INT(node->GetNumberOfControlPoints(), 10);
+  CHECK_INT(countEvent(observer, vtkMRMLMarkupsNode::PointRemovedEvent), 1);
+
   return EXIT_SUCCESS;
 }
@@ -175,5 +175,43 @@ int vtkMRMLMarkupsNodeTest2(int , char * [] )
     return EXIT_FAILURE;
     }
 
+  // Check that lookup by ID follows insertion, swap, renaming and removal of control points
+  vtkNew<vtkMRMLMarkupsFiducialNode> node2;
+  node2->AddNControlPoints(1000);
+  std::string lastID = node2->GetNthControlPointID(999);
+  if (node2->GetNthControlPointIndexByID(lastID.c_str()) != 999)
+    {
+    std::cerr << "Get Markup index by ID failed after adding points" << std::endl;
+    return EXIT_FAILURE;
+    }
+  vtkMRMLMarkupsNode::ControlPoint* insertedPoint = new vtkMRMLMarkupsNode::ControlPoint;
+  node2->InsertControlPoint(insertedPoint, 0);
+  if (node2->GetNthControlPointIndexByID(lastID.c_str()) != 1000
+    || node2->GetNthControlPointIndexByID(insertedPoint->ID.c_str()) != 0)
+    {
+    std::cerr << "Get Markup index by ID failed after inserting a point" << std::endl;
+    return EXIT_FAILURE;
+    }
+  node2->SwapControlPoints(0, 1000);
+  if (node2->GetNthControlPointIndexByID(lastID.c_str()) != 0)
+    {
+    std::cerr << "Get Markup index by ID failed after swapping points" << std::endl;
+    return EXIT_FAILURE;
+    }
+  node2->SetNthControlPointID(0, "Renamed");
+  if (node2->GetNthControlPointIndexByID("Renamed") != 0
+    || node2->GetNthControlPointIndexByID(lastID.c_str()) != -1)
+    {
+    std::cerr << "Get Markup index by ID failed after renaming a point" << std::endl;
+    return EXIT_FAILURE;
+    }
+  node2->RemoveNthControlPoint(0);
+  if (node2->GetNthControlPointIndexByID("Renamed") != -1
+    || node2->GetNthControlPointIndexByID(node2->GetNthControlPointID(500).c_str()) != 500)
+    {
+    std::cerr << "Get Markup index by ID failed after removing a point" << std::endl;
+    return EXIT_FAILURE;
+    }
+
   return EXIT_SUCCESS;
 }
@@ -34,12 +34,21 @@
 #include "vtkRenderWindow.h"
 #include "vtkRenderer.h"
 
+// STD includes
+#include <algorithm>
+
 vtkStandardNewMacro(vtkFastSelectVisiblePoints);
 
 //----------------------------------------------------------------------------
 vtkFastSelectVisiblePoints::vtkFastSelectVisiblePoints()
 {
   this->ZBuffer = nullptr;
+  this->ZBufferRegion[0] = 0;
+  this->ZBufferRegion[1] = -1;
+  this->ZBufferRegion[2] = 0;
+  this->ZBufferRegion[3] = -1;
+  this->ZBufferRegionDefined = false;
+  this->RestrictZBufferToInputPoints = true;
 }
 
 //----------------------------------------------------------------------------
@@ -49,17 +58,113 @@ vtkFastSelectVisiblePoints::~vtkFastSelectVisiblePoints() = default;
 void vtkFastSelectVisiblePoints::ResetZBuffer()
 {
   this->ZBuffer = nullptr;
+  this->ZBufferRegionDefined = false;
+}
+
+//----------------------------------------------------------------------------
+void vtkFastSelectVisiblePoints::SetZBuffer(vtkFloatArray* zBuffer, const int region[4]/*=nullptr*/)
+{
+  this->ZBuffer = zBuffer;
+  this->ZBufferRegionDefined = (region != nullptr);
+  if (region)
+    {
+    std::copy(region, region + 4, this->ZBufferRegion);
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkFastSelectVisiblePoints::GetZBufferRegion(int region[4])
+{
+  if (!this->ZBufferRegionDefined)
+    {
+    return false;
+    }
+  std::copy(this->ZBufferRegion, this->ZBufferRegion + 4, region);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkFastSelectVisiblePoints::GetInputPointsRegion(int region[4])
+{
+  vtkDataSet* input = vtkDataSet::SafeDownCast(this->GetInput());
+  if (!input || !this->Renderer)
+    {
+    return false;
+    }
+  region[0] = VTK_INT_MAX;
+  region[1] = VTK_INT_MIN;
+  region[2] = VTK_INT_MAX;
+  region[3] = VTK_INT_MIN;
+  vtkIdType numberOfPoints = input->GetNumberOfPoints();
+  for (vtkIdType pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
+    {
+    double x[3] = { 0.0 };
+    input->GetPoint(pointIndex, x);
+    this->Renderer->SetWorldPoint(x[0], x[1], x[2], 1.0);
+    this->Renderer->WorldToDisplay();
+    double* displayPoint = this->Renderer->GetDisplayPoint();
+    // Add a one pixel margin to be robust to rounding errors
+    region[0] = std::min(region[0], static_cast<int>(displayPoint[0]) - 1);
+    region[1] = std::max(region[1], static_cast<int>(displayPoint[0]) + 1);
+    region[2] = std::min(region[2], static_cast<int>(displayPoint[1]) - 1);
+    region[3] = std::max(region[3], static_cast<int>(displayPoint[1]) + 1);
+    }
+  region[0] = std::max(region[0], this->InternalSelection[0]);
+  region[1] = std::min(region[1], this->InternalSelection[1]);
+  region[2] = std::max(region[2], this->InternalSelection[2]);
+  region[3] = std::min(region[3], this->InternalSelection[3]);
+  return region[0] <= region[1] && region[2] <= region[3];
 }
 
 //----------------------------------------------------------------------------
 void vtkFastSelectVisiblePoints::UpdateZBuffer()
 {
-  this->ResetZBuffer();
-  float* zPtr = this->Initialize(true);
+  if (!this->Renderer || !this->Renderer->GetRenderWindow())
+    {
+    vtkErrorMacro("UpdateZBuffer failed: renderer and render window must be set");
+    return;
+    }
+  this->Initialize(false);
+  int region[4] = { this->InternalSelection[0], this->InternalSelection[1], this->InternalSelection[2], this->InternalSelection[3] };
+  if (this->RestrictZBufferToInputPoints)
+    {
+    bool validRegion = this->GetInputPointsRegion(region);
+    if (this->ZBuffer && this->ZBufferRegionDefined
+      && this->ZBufferRegion[0] <= this->ZBufferRegion[1] && this->ZBufferRegion[2] <= this->ZBufferRegion[3])
+      {
+      // Keep the region of the current z buffer
+      if (validRegion)
+        {
+        region[0] = std::min(region[0], this->ZBufferRegion[0]);
+        region[1] = std::max(region[1], this->ZBufferRegion[1]);
+        region[2] = std::min(region[2], this->ZBufferRegion[2]);
+        region[3] = std::max(region[3], this->ZBufferRegion[3]);
+        }
+      else
+        {
+        std::copy(this->ZBufferRegion, this->ZBufferRegion + 4, region);
+        }
+      validRegion = true;
+      }
+    if (!validRegion)
+      {
+      // None of the points are in the viewport, there is nothing to read back
+      this->ZBuffer = vtkSmartPointer<vtkFloatArray>::New();
+      this->ZBufferRegion[0] = 0;
+      this->ZBufferRegion[1] = -1;
+      this->ZBufferRegion[2] = 0;
+      this->ZBufferRegion[3] = -1;
+      this->ZBufferRegionDefined = true;
+      return;
+      }
+    }
 
+  float* zPtr = this->Renderer->GetRenderWindow()->GetZbufferData(region[0], region[2], region[1], region[3]);
   this->ZBuffer = vtkSmartPointer<vtkFloatArray>::New();
-  vtkIdType size = (this->InternalSelection[1] - this->InternalSelection[0] + 1) * (this->InternalSelection[3] - this->InternalSelection[2] + 1);
-  this->ZBuffer->SetArray(zPtr, size, 0);
+  vtkIdType size = (region[1] - region[0] + 1) * (region[3] - region[2] + 1);
+  this->ZBuffer->SetArray(zPtr, size, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
+  std::copy(region, region + 4, this->ZBufferRegion);
+  this->ZBufferRegionDefined = true;
 }
 
 //----------------------------------------------------------------------------
@@ -123,6 +228,7 @@ int vtkFastSelectVisiblePoints::RequestData(vtkInformation* vtkNotUsed(request),
   output->SetVerts(outputVertices);
   outputVertices->Delete();
 
+  int pointsRegion[4] = { 0, -1, 0, -1 };
   if (!this->ZBuffer)
     {
     this->UpdateZBuffer();
@@ -130,7 +236,23 @@ int vtkFastSelectVisiblePoints::RequestData(vtkInformation* vtkNotUsed(request),
   else
     {
     this->Initialize(false);
+    if (!this->ZBufferRegionDefined)
+      {
+      // z buffer was set without region, it contains the whole viewport
+      std::copy(this->InternalSelection, this->InternalSelection + 4, this->ZBufferRegion);
+      this->ZBufferRegionDefined = true;
+      }
+    else if (this->RestrictZBufferToInputPoints && this->GetInputPointsRegion(pointsRegion)
+      && (pointsRegion[0] < this->ZBufferRegion[0] || pointsRegion[1] > this->ZBufferRegion[1]
+      || pointsRegion[2] < this->ZBufferRegion[2] || pointsRegion[3] > this->ZBufferRegion[3]))
+      {
+      // some points are outside of the shared z buffer, extend it
+      this->UpdateZBuffer();
+      }
     }
+  // The z buffer is indexed by the region that it contains.
+  // Points outside of the region are not in the viewport, so they are treated as invisible.
+  std::copy(this->ZBufferRegion, this->ZBufferRegion + 4, this->InternalSelection);
 
   int abort = 0;
   vtkIdType progressInterval = numPts / 20 + 1;
@@ -146,7 +268,7 @@ int vtkFastSelectVisiblePoints::RequestData(vtkInformation* vtkNotUsed(request),
       abort = this->GetAbortExecute();
       }
 
-    visible = IsPointOccluded(x, this->ZBuffer->GetPointer(0));
+    visible = (this->ZBuffer->GetNumberOfTuples() > 0 && this->IsPointOccluded(x, this->ZBuffer->GetPointer(0)));
 
     if ((visible && !this->SelectInvisible) || (!visible && this->SelectInvisible))
       {
@@ -169,4 +291,5 @@ int vtkFastSelectVisiblePoints::RequestData(vtkInformation* vtkNotUsed(request),
 void vtkFastSelectVisiblePoints::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "RestrictZBufferToInputPoints: " << this->RestrictZBufferToInputPoints << "\n";
 }
@@ -67,11 +67,27 @@ public:
    */
   static vtkFastSelectVisiblePoints* New();
 
+  /// If enabled then only the region of the depth buffer that contains the input points
+  /// is read back from the GPU, instead of the whole viewport. This greatly reduces the amount
+  /// of data that has to be transferred when markups only cover a small part of a large view.
+  /// Enabled by default.
+  vtkSetMacro(RestrictZBufferToInputPoints, bool);
+  vtkGetMacro(RestrictZBufferToInputPoints, bool);
+  vtkBooleanMacro(RestrictZBufferToInputPoints, bool);
+
+  /// Read back the depth buffer from the render window.
+  /// If a z buffer is already set then the new z buffer region contains the previous region as well,
+  /// so that a z buffer that is shared between multiple filters remains usable for all of them.
   void UpdateZBuffer();
   void ResetZBuffer();
 
   vtkFloatArray* GetZBuffer() { return this->ZBuffer; };
-  void SetZBuffer(vtkFloatArray* zBuffer) { this->ZBuffer = zBuffer; };
+  /// Set the depth buffer values of a region (xmin, xmax, ymin, ymax) of the render window.
+  /// If region is not specified then the z buffer must contain the whole viewport (or selection window).
+  void SetZBuffer(vtkFloatArray* zBuffer, const int region[4]=nullptr);
+  /// Get the region (xmin, xmax, ymin, ymax) of the render window that the z buffer contains.
+  /// Returns false if the region is not known (the z buffer contains the whole viewport or selection window).
+  bool GetZBufferRegion(int region[4]);
 
 protected:
   vtkFastSelectVisiblePoints();
@@ -79,7 +95,15 @@ protected:
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /// Compute the region of the render window that contains the input points, within the
+  /// viewport (or selection window). Initialize() must be called before this method.
+  /// \return False if none of the points are in the viewport.
+  bool GetInputPointsRegion(int region[4]);
+
   vtkSmartPointer<vtkFloatArray> ZBuffer;
+  int ZBufferRegion[4];
+  bool ZBufferRegionDefined;
+  bool RestrictZBufferToInputPoints;
 
 private:
   vtkFastSelectVisiblePoints(const vtkFastSelectVisiblePoints&) = delete;
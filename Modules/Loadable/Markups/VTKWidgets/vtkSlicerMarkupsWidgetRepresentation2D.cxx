@@ -21,6 +21,7 @@
 #include "vtkCellLocator.h"
 #include "vtkDiscretizableColorTransferFunction.h"
 #include "vtkGlyph2D.h"
+#include "vtkIdList.h"
 #include "vtkLabelPlacementMapper.h"
 #include "vtkLine.h"
 #include "vtkMarkupsGlyphSource2D.h"
@@ -30,13 +31,16 @@
 #include "vtkPiecewiseFunction.h"
 #include "vtkPlane.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPointSetToLabelHierarchy.h"
+#include "vtkPolyData.h"
 #include "vtkPolyDataMapper2D.h"
 #include "vtkProperty2D.h"
 #include "vtkRenderer.h"
 #include "vtkRenderWindow.h"
 #include "vtkSlicerMarkupsWidgetRepresentation2D.h"
 #include "vtkSphereSource.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStringArray.h"
 #include "vtkTensorGlyph.h"
 #include "vtkTextActor.h"
@@ -126,6 +130,9 @@ vtkSlicerMarkupsWidgetRepresentation2D::vtkSlicerMarkupsWidgetRepresentation2D()
 
   this->SlicePlane = vtkSmartPointer<vtkPlane>::New();
   this->WorldToSliceTransform = vtkSmartPointer<vtkTransform>::New();
+
+  this->ControlPointsPickingPolyData = vtkSmartPointer<vtkPolyData>::New();
+  this->ControlPointsPickingLocator = vtkSmartPointer<vtkStaticPointLocator>::New();
 }
 
 //----------------------------------------------------------------------
@@ -413,6 +420,9 @@ void vtkSlicerMarkupsWidgetRepresentation2D::UpdateFromMRML(vtkMRMLNode* caller,
 {
   Superclass::UpdateFromMRML(caller, event, callData);
 
+  // control point positions or visibility in the view may have changed
+  this->ControlPointsPickingLocatorValid = false;
+
   // Update from slice node
   if (!caller || caller == this->ViewNode.GetPointer())
     {
@@ -548,13 +558,70 @@ void vtkSlicerMarkupsWidgetRepresentation2D::CanInteract(
       }
     }
 
-  vtkIdType numberOfPoints = markupsNode->GetNumberOfControlPoints();
+  // Only control points near the mouse position are checked, found by using the locator
+  this->UpdateControlPointsPickingLocator();
+  if (this->ControlPointsPickingIndices.empty())
+    {
+    return;
+    }
+  vtkNew<vtkIdList> nearbyPointIds;
+  this->ControlPointsPickingLocator->FindPointsWithinRadius(sqrt(maxPickingDistanceFromControlPoint2),
+    displayPosition3, nearbyPointIds);
+
+  double pointDisplayPos[3] = { 0.0, 0.0, 0.0 };
+  for (vtkIdType nearbyPointIndex = 0; nearbyPointIndex < nearbyPointIds->GetNumberOfIds(); ++nearbyPointIndex)
+    {
+    vtkIdType pointId = nearbyPointIds->GetId(nearbyPointIndex);
+    int controlPointIndex = this->ControlPointsPickingIndices[pointId];
+    this->ControlPointsPickingPolyData->GetPoint(pointId, pointDisplayPos);
+    double dist2 = vtkMath::Distance2BetweenPoints(pointDisplayPos, displayPosition3);
+    if (dist2 >= maxPickingDistanceFromControlPoint2)
+      {
+      continue;
+      }
+    // if multiple control points are at the same distance then the one with lowest index is picked
+    if (dist2 < closestDistance2
+      || (dist2 == closestDistance2 && foundComponentType == vtkMRMLMarkupsDisplayNode::ComponentControlPoint
+          && controlPointIndex < foundComponentIndex))
+      {
+      closestDistance2 = dist2;
+      foundComponentType = vtkMRMLMarkupsDisplayNode::ComponentControlPoint;
+      foundComponentIndex = controlPointIndex;
+      }
+    }
+}
+
+//----------------------------------------------------------------------
+void vtkSlicerMarkupsWidgetRepresentation2D::UpdateControlPointsPickingLocator()
+{
+  vtkMRMLSliceNode* sliceNode = this->GetSliceNode();
+  vtkMRMLMarkupsNode* markupsNode = this->GetMarkupsNode();
+  if (!sliceNode || !markupsNode)
+    {
+    this->ControlPointsPickingIndices.clear();
+    return;
+    }
+  if (this->ControlPointsPickingLocatorValid
+    && this->ControlPointsPickingLocatorBuildTime.GetMTime() > markupsNode->GetMTime()
+    && this->ControlPointsPickingLocatorBuildTime.GetMTime() > sliceNode->GetMTime()
+    && (!this->MarkupsDisplayNode || this->ControlPointsPickingLocatorBuildTime.GetMTime() > this->MarkupsDisplayNode->GetMTime()))
+    {
+    // up-to-date
+    return;
+    }
+
+  bool sliceProjection = (this->MarkupsDisplayNode && this->MarkupsDisplayNode->GetSliceProjection());
 
   double pointDisplayPos[4] = { 0.0, 0.0, 0.0, 1.0 };
   double pointWorldPos[4] = { 0.0, 0.0, 0.0, 1.0 };
 
   vtkNew<vtkMatrix4x4> rasToxyMatrix;
-  sliceNode->GetXYToRAS()->Invert(sliceNode->GetXYToRAS(), rasToxyMatrix.GetPointer());
+  vtkMatrix4x4::Invert(sliceNode->GetXYToRAS(), rasToxyMatrix);
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  this->ControlPointsPickingIndices.clear();
+  int numberOfPoints = markupsNode->GetNumberOfControlPoints();
   for (int i = 0; i < numberOfPoints; i++)
     {
     if (!this->GetNthControlPointViewVisibility(i))
@@ -563,18 +630,24 @@ void vtkSlicerMarkupsWidgetRepresentation2D::CanInteract(
       }
     markupsNode->GetNthControlPointPositionWorld(i, pointWorldPos);
     rasToxyMatrix->MultiplyPoint(pointWorldPos, pointDisplayPos);
-    if (this->MarkupsDisplayNode->GetSliceProjection())
+    if (sliceProjection)
       {
-      pointDisplayPos[2] = displayPosition3[2];
-      }
-    double dist2 = vtkMath::Distance2BetweenPoints(pointDisplayPos, displayPosition3);
-    if (dist2 < maxPickingDistanceFromControlPoint2 && dist2 < closestDistance2)
-      {
-      closestDistance2 = dist2;
-      foundComponentType = vtkMRMLMarkupsDisplayNode::ComponentControlPoint;
-      foundComponentIndex = i;
+      // projected points can be picked regardless of their distance from the slice
+      pointDisplayPos[2] = 0.0;
       }
+    points->InsertNextPoint(pointDisplayPos);
+    this->ControlPointsPickingIndices.push_back(i);
     }
+
+  this->ControlPointsPickingPolyData->SetPoints(points);
+  if (!this->ControlPointsPickingIndices.empty())
+    {
+    this->ControlPointsPickingLocator->SetDataSet(this->ControlPointsPickingPolyData);
+    this->ControlPointsPickingLocator->BuildLocator();
+    }
+
+  this->ControlPointsPickingLocatorValid = true;
+  this->ControlPointsPickingLocatorBuildTime.Modified();
 }
 
 //----------------------------------------------------------------------
@@ -35,6 +35,10 @@
 
 #include "vtkMRMLSliceNode.h"
 
+#include <vtkTimeStamp.h>
+
+#include <vector>
+
 class vtkActor2D;
 class vtkDiscretizableColorTransferFunction;
 class vtkGlyph2D;
@@ -43,6 +47,7 @@ class vtkMarkupsGlyphSource2D;
 class vtkPlane;
 class vtkPolyDataMapper2D;
 class vtkProperty2D;
+class vtkStaticPointLocator;
 
 class vtkMRMLInteractionEventData;
 
@@ -124,6 +129,12 @@ protected:
 
   bool GetAllControlPointsVisible() override;
 
+  /// Update the locator of visible control point positions in slice view (display) coordinates.
+  /// The locator is rebuilt only if the representation, the markups node, or the slice view
+  /// has changed since the last build, so that finding the control point under the mouse
+  /// does not require iterating through all the control points.
+  void UpdateControlPointsPickingLocator();
+
   /// Check, if the point is displayable in the current slice geometry
   virtual bool IsControlPointDisplayableOnSlice(vtkMRMLMarkupsNode* node, int pointIndex = 0);
 
@@ -171,6 +182,14 @@ protected:
   vtkSmartPointer<vtkTransform> WorldToSliceTransform;
   vtkSmartPointer<vtkPlane> SlicePlane;
 
+  /// Visible control point positions in display coordinates, for picking
+  vtkSmartPointer<vtkPolyData> ControlPointsPickingPolyData;
+  vtkSmartPointer<vtkStaticPointLocator> ControlPointsPickingLocator;
+  /// Control point index of each point in ControlPointsPickingPolyData
+  std::vector<int> ControlPointsPickingIndices;
+  bool ControlPointsPickingLocatorValid = { false };
+  vtkTimeStamp ControlPointsPickingLocatorBuildTime;
+
   virtual void UpdateAllPointsAndLabelsFromMRML(double labelsOffset);
 
   double GetWidgetOpacity(int controlPointType);
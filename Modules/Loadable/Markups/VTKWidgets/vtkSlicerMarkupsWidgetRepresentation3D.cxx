@@ -49,6 +49,7 @@
 #include <vtkMRMLViewNode.h>
 
 std::map<vtkRenderer*, vtkSmartPointer<vtkFloatArray> > vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers;
+std::map<vtkRenderer*, std::array<int, 4> > vtkSlicerMarkupsWidgetRepresentation3D::CachedZBufferRegions;
 
 vtkSlicerMarkupsWidgetRepresentation3D::ControlPointsPipeline3D::ControlPointsPipeline3D()
 {
@@ -820,17 +821,28 @@ int vtkSlicerMarkupsWidgetRepresentation3D::RenderOverlay(vtkViewport *viewport)
       {
       if (!this->MarkupsDisplayNode->GetOccludedVisibility())
         {
+        // The z buffer is read back by the first markup that is rendered and then it is shared
+        // between all markups of the renderer. It only contains the region of the render window
+        // where the control points are, and it is extended by the filter if some points are outside.
         if (!zBuffer)
           {
+          controlPoints->SelectVisiblePoints->ResetZBuffer();
           controlPoints->SelectVisiblePoints->UpdateZBuffer();
-          zBuffer = controlPoints->SelectVisiblePoints->GetZBuffer();
-          vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers[this->Renderer] = zBuffer;
           }
         else
           {
-          controlPoints->SelectVisiblePoints->SetZBuffer(zBuffer);
+          controlPoints->SelectVisiblePoints->SetZBuffer(zBuffer,
+            vtkSlicerMarkupsWidgetRepresentation3D::CachedZBufferRegions[this->Renderer].data());
           }
         controlPoints->SelectVisiblePoints->Update();
+        std::array<int, 4> zBufferRegion;
+        if (controlPoints->SelectVisiblePoints->GetZBuffer()
+          && controlPoints->SelectVisiblePoints->GetZBufferRegion(zBufferRegion.data()))
+          {
+          zBuffer = controlPoints->SelectVisiblePoints->GetZBuffer();
+          vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers[this->Renderer] = zBuffer;
+          vtkSlicerMarkupsWidgetRepresentation3D::CachedZBufferRegions[this->Renderer] = zBufferRegion;
+          }
         }
       else
         {
@@ -1188,6 +1200,7 @@ void vtkSlicerMarkupsWidgetRepresentation3D::OnRenderCompleted(vtkObject* caller
   if (renderer && vtkSlicerMarkupsWidgetRepresentation3D::GetCachedZBuffer(renderer))
     {
     vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers.erase(renderer);
+    vtkSlicerMarkupsWidgetRepresentation3D::CachedZBufferRegions.erase(renderer);
     }
 }
 
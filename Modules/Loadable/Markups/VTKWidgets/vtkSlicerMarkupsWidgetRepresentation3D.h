@@ -30,6 +30,7 @@
 #include "vtkSlicerMarkupsModuleVTKWidgetsExport.h"
 #include "vtkSlicerMarkupsWidgetRepresentation.h"
 
+#include <array>
 #include <map>
 
 class vtkActor;
@@ -165,6 +166,8 @@ protected:
   double OccludedRelativeOffset;
 
   static std::map<vtkRenderer*, vtkSmartPointer<vtkFloatArray> > CachedZBuffers;
+  /// Region of the render window (xmin, xmax, ymin, ymax) that each cached z buffer contains
+  static std::map<vtkRenderer*, std::array<int, 4> > CachedZBufferRegions;
 
   vtkSmartPointer<vtkCallbackCommand> RenderCompletedCallback;
   static void OnRenderCompleted(vtkObject* caller, unsigned long event, void* clientData, void* callData);
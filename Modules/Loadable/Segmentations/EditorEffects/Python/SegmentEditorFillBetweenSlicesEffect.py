@@ -15,6 +15,8 @@ class SegmentEditorFillBetweenSlicesEffect(AbstractScriptedSegmentEditorAutoComp
     def __init__(self, scriptedEffect):
         AbstractScriptedSegmentEditorAutoCompleteEffect.__init__(self, scriptedEffect)
         scriptedEffect.name = 'Fill between slices'
+        # Interpolator is kept between preview updates so that only modified segments are recomputed
+        self.interpolator = None
 
     def clone(self):
         import qSlicerSegmentationsEditorEffectsPythonQt as effects
@@ -43,10 +45,15 @@ The effect uses  <a href="https://insight-journal.org/browse/publication/977">mo
 
     def computePreviewLabelmap(self, mergedImage, outputLabelmap):
         import vtkITK
-        interpolator = vtkITK.vtkITKMorphologicalContourInterpolator()
-        interpolator.SetInputData(mergedImage)
-        interpolator.Update()
-        outputLabelmap.DeepCopy(interpolator.GetOutput())
+        if not self.interpolator:
+            self.interpolator = vtkITK.vtkITKMorphologicalContourInterpolator()
+            # Interpolate segments in parallel, each within its bounding box
+            self.interpolator.SetParallelLabelInterpolation(True)
+        self.interpolator.SetInputData(mergedImage)
+        self.interpolator.Update()
+        outputLabelmap.DeepCopy(self.interpolator.GetOutput())
+        # Release reference to the input, stored interpolation results are kept
+        self.interpolator.SetInputData(None)
         imageToWorld = vtk.vtkMatrix4x4()
         mergedImage.GetImageToWorldMatrix(imageToWorld)
         outputLabelmap.SetImageToWorldMatrix(imageToWorld)
@@ -195,6 +195,7 @@ class SegmentEditorHollowEffect(AbstractScriptedSegmentEditorEffect):
         margin = vtkITK.vtkITKImageMargin()
         margin.SetInputConnection(thresh.GetOutputPort())
         margin.CalculateMarginInMMOn()
+        margin.UseParallelDistanceTransformOn()
 
         spacing = selectedSegmentLabelmap.GetSpacing()
         voxelDiameter = min(selectedSegmentLabelmap.GetSpacing())
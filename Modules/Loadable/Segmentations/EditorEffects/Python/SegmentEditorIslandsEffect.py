@@ -151,13 +151,9 @@ about each operation, hover the mouse over the option and wait for the tooltip t
         islandMath.SetInputConnection(castIn.GetOutputPort())
         islandMath.SetFullyConnected(False)
         islandMath.SetMinimumSize(minimumSize)
+        islandMath.ParallelLabelingOn()
         islandMath.Update()
-
-        islandImage = slicer.vtkOrientedImageData()
-        islandImage.ShallowCopy(islandMath.GetOutput())
-        selectedSegmentLabelmapImageToWorldMatrix = vtk.vtkMatrix4x4()
-        selectedSegmentLabelmap.GetImageToWorldMatrix(selectedSegmentLabelmapImageToWorldMatrix)
-        islandImage.SetImageToWorldMatrix(selectedSegmentLabelmapImageToWorldMatrix)
+        islandExtents = islandMath.GetIslandExtents()
 
         islandCount = islandMath.GetNumberOfIslands()
         islandOrigCount = islandMath.GetOriginalNumberOfIslands()
@@ -174,9 +170,6 @@ about each operation, hover the mouse over the option and wait for the tooltip t
             if selectedSegmentName is not None and selectedSegmentName != "":
                 baseSegmentName = selectedSegmentName
 
-            labelValues = vtk.vtkIntArray()
-            slicer.vtkSlicerSegmentationsModuleLogic.GetAllLabelValues(labelValues, islandImage)
-
             # Erase segment from in original labelmap.
             # Individual islands will be added back later.
             threshold = vtk.vtkImageThreshold()
@@ -191,13 +184,14 @@ about each operation, hover the mouse over the option and wait for the tooltip t
             self.scriptedEffect.modifySegmentByLabelmap(segmentationNode, selectedSegmentID, emptyLabelmap,
                                                         slicer.qSlicerSegmentEditorAbstractEffect.ModificationModeSet)
 
-            for i in range(labelValues.GetNumberOfTuples()):
+            # Islands are labeled 1..islandCount in decreasing order of size
+            for i in range(islandCount):
                 if (maxNumberOfSegments > 0 and i >= maxNumberOfSegments):
                     # We only care about the segments up to maxNumberOfSegments.
                     # If we do not want to split segments, we only care about the first.
                     break
 
-                labelValue = int(labelValues.GetTuple1(i))
+                labelValue = i + 1
                 segment = selectedSegment
                 segmentID = selectedSegmentID
                 if i != 0 and split:
@@ -211,23 +205,29 @@ about each operation, hover the mouse over the option and wait for the tooltip t
                     segment.SetLabelValue(segmentation.GetUniqueLabelValueForSharedLabelmap(selectedSegmentID))
 
                 threshold = vtk.vtkImageThreshold()
-                threshold.SetInputData(islandMath.GetOutput())
+                modificationMode = slicer.qSlicerSegmentEditorAbstractEffect.ModificationModeAdd
                 if not split and maxNumberOfSegments <= 0:
                     # no need to split segments and no limit on number of segments, so we can lump all islands into one segment
+                    threshold.SetInputData(islandMath.GetOutput())
                     threshold.ThresholdByLower(0)
                     threshold.SetInValue(0)
                     threshold.SetOutValue(1)
+                    if i == 0:
+                        modificationMode = slicer.qSlicerSegmentEditorAbstractEffect.ModificationModeSet
                 else:
-                    # copy only selected islands; or copy islands into different segments
+                    # copy only selected islands; or copy islands into different segments.
+                    # Only the bounding box of the island is processed. The segment has been erased above,
+                    # therefore adding the island is sufficient.
+                    islandClip = vtk.vtkImageClip()
+                    islandClip.SetInputData(islandMath.GetOutput())
+                    islandClip.SetOutputWholeExtent([int(islandExtents.GetComponent(i, component)) for component in range(6)])
+                    islandClip.ClipDataOn()
+                    threshold.SetInputConnection(islandClip.GetOutputPort())
                     threshold.ThresholdBetween(labelValue, labelValue)
                     threshold.SetInValue(1)
                     threshold.SetOutValue(0)
                 threshold.Update()
 
-                modificationMode = slicer.qSlicerSegmentEditorAbstractEffect.ModificationModeAdd
-                if i == 0:
-                    modificationMode = slicer.qSlicerSegmentEditorAbstractEffect.ModificationModeSet
-
                 # Create oriented image data from output
                 modifierImage = slicer.vtkOrientedImageData()
                 modifierImage.DeepCopy(threshold.GetOutput())
@@ -2,7 +2,6 @@ import logging
 import os
 
 import qt
-import vtk
 
 import slicer
 
@@ -161,22 +160,12 @@ class SegmentEditorLogicalEffect(AbstractScriptedSegmentEditorEffect):
         self.scriptedEffect.setParameter("ModifierSegmentID", modifierSegmentIDs)
 
     def getInvertedBinaryLabelmap(self, modifierLabelmap):
-        fillValue = 1
-        eraseValue = 0
-        inverter = vtk.vtkImageThreshold()
-        inverter.SetInputData(modifierLabelmap)
-        inverter.SetInValue(fillValue)
-        inverter.SetOutValue(eraseValue)
-        inverter.ReplaceInOn()
-        inverter.ThresholdByLower(0)
-        inverter.SetOutputScalarType(vtk.VTK_UNSIGNED_CHAR)
-        inverter.Update()
-
+        import vtkSegmentationCorePython as vtkSegmentationCore
+        packedLabelmap = vtkSegmentationCore.vtkBitPackedLabelmap()
+        packedLabelmap.SetImage(modifierLabelmap)
+        packedLabelmap.Invert()
         invertedModifierLabelmap = slicer.vtkOrientedImageData()
-        invertedModifierLabelmap.ShallowCopy(inverter.GetOutput())
-        imageToWorldMatrix = vtk.vtkMatrix4x4()
-        modifierLabelmap.GetImageToWorldMatrix(imageToWorldMatrix)
-        invertedModifierLabelmap.SetGeometryFromImageToWorldMatrix(imageToWorldMatrix)
+        packedLabelmap.GetImage(invertedModifierLabelmap)
         return invertedModifierLabelmap
 
     def onApply(self):
@@ -240,10 +229,14 @@ class SegmentEditorLogicalEffect(AbstractScriptedSegmentEditorEffect):
                     modifierSegmentLabelmap, slicer.qSlicerSegmentEditorAbstractEffect.ModificationModeRemove, bypassMasking)
             elif operation == LOGICAL_INTERSECT:
                 selectedSegmentLabelmap = self.scriptedEffect.selectedSegmentLabelmap()
+                # Intersect bit-packed labelmaps (1 bit per voxel, combined word by word)
+                intersectionPackedLabelmap = vtkSegmentationCore.vtkBitPackedLabelmap()
+                intersectionPackedLabelmap.SetImage(selectedSegmentLabelmap)
+                modifierPackedLabelmap = vtkSegmentationCore.vtkBitPackedLabelmap()
+                modifierPackedLabelmap.SetImage(modifierSegmentLabelmap)
+                intersectionPackedLabelmap.Intersect(modifierPackedLabelmap)
                 intersectionLabelmap = slicer.vtkOrientedImageData()
-                vtkSegmentationCore.vtkOrientedImageDataResample.MergeImage(
-                    selectedSegmentLabelmap, modifierSegmentLabelmap, intersectionLabelmap,
-                    vtkSegmentationCore.vtkOrientedImageDataResample.OPERATION_MINIMUM, selectedSegmentLabelmap.GetExtent())
+                intersectionPackedLabelmap.GetImage(intersectionLabelmap)
                 selectedSegmentLabelmapExtent = selectedSegmentLabelmap.GetExtent()
                 modifierSegmentLabelmapExtent = modifierSegmentLabelmap.GetExtent()
                 commonExtent = [max(selectedSegmentLabelmapExtent[0], modifierSegmentLabelmapExtent[0]),
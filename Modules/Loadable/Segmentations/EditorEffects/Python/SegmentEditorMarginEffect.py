@@ -189,6 +189,7 @@ class SegmentEditorMarginEffect(AbstractScriptedSegmentEditorEffect):
         margin = vtkITK.vtkITKImageMargin()
         margin.SetInputConnection(thresh.GetOutputPort())
         margin.CalculateMarginInMMOn()
+        margin.UseParallelDistanceTransformOn()
         margin.SetOuterMarginMM(abs(marginSizeMM))
         margin.Update()
 
@@ -511,6 +511,11 @@ class SegmentEditorThresholdEffect(AbstractScriptedSegmentEditorEffect):
     #
     def onThresholdValuesChanged(self, min, max):
         self.scriptedEffect.updateMRMLFromGUI()
+        # Update the preview immediately instead of waiting for the next preview pulse.
+        # Only the lookup table range changes, so this is instant even for large volumes.
+        for sliceWidget, pipeline in self.previewPipelines.items():
+            pipeline.setThresholdRange(min, max)
+            sliceWidget.sliceView().scheduleRender()
 
     def onUseForPaint(self):
         parameterSetNode = self.scriptedEffect.parameterSetNode()
@@ -686,10 +691,10 @@ class SegmentEditorThresholdEffect(AbstractScriptedSegmentEditorEffect):
         # Set values to pipelines
         for sliceWidget in self.previewPipelines:
             pipeline = self.previewPipelines[sliceWidget]
-            pipeline.lookupTable.SetTableValue(1, r, g, b, opacity)
+            pipeline.setColor(r, g, b, opacity)
             layerLogic = self.getSourceVolumeLayerLogic(sliceWidget)
-            pipeline.thresholdFilter.SetInputConnection(layerLogic.GetReslice().GetOutputPort())
-            pipeline.thresholdFilter.ThresholdBetween(min, max)
+            pipeline.colorMapper.SetInputConnection(layerLogic.GetReslice().GetOutputPort())
+            pipeline.setThresholdRange(min, max)
             pipeline.actor.VisibilityOn()
             sliceWidget.sliceView().scheduleRender()
 
@@ -939,18 +944,21 @@ class PreviewPipeline:
     """
 
     def __init__(self):
+        # The resliced source volume is mapped directly to colors: voxels within the threshold range
+        # get the segment color, voxels outside the range are transparent. No thresholded image is computed,
+        # therefore changing the threshold range only requires updating the table range.
         self.lookupTable = vtk.vtkLookupTable()
         self.lookupTable.SetRampToLinear()
-        self.lookupTable.SetNumberOfTableValues(2)
+        self.lookupTable.SetNumberOfTableValues(1)
         self.lookupTable.SetTableRange(0, 1)
         self.lookupTable.SetTableValue(0, 0, 0, 0, 0)
+        self.lookupTable.SetBelowRangeColor(0, 0, 0, 0)
+        self.lookupTable.SetAboveRangeColor(0, 0, 0, 0)
+        self.lookupTable.UseBelowRangeColorOn()
+        self.lookupTable.UseAboveRangeColorOn()
         self.colorMapper = vtk.vtkImageMapToRGBA()
         self.colorMapper.SetOutputFormatToRGBA()
         self.colorMapper.SetLookupTable(self.lookupTable)
-        self.thresholdFilter = vtk.vtkImageThreshold()
-        self.thresholdFilter.SetInValue(1)
-        self.thresholdFilter.SetOutValue(0)
-        self.thresholdFilter.SetOutputScalarTypeToUnsignedChar()
 
         # Feedback actor
         self.mapper = vtk.vtkImageMapper()
@@ -964,9 +972,15 @@ class PreviewPipeline:
         self.mapper.SetColorLevel(128)
 
         # Setup pipeline
-        self.colorMapper.SetInputConnection(self.thresholdFilter.GetOutputPort())
         self.mapper.SetInputConnection(self.colorMapper.GetOutputPort())
 
+    def setColor(self, r, g, b, opacity):
+        self.lookupTable.SetTableValue(0, r, g, b, opacity)
+
+    def setThresholdRange(self, min, max):
+        if self.lookupTable.GetTableRange() != (min, max):
+            self.lookupTable.SetTableRange(min, max)
+
 
 ###
 #
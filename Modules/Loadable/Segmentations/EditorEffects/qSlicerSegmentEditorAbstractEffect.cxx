@@ -80,6 +80,9 @@
 // CTK includes
 #include <ctkMessageBox.h>
 
+// STD includes
+#include <algorithm>
+
 //-----------------------------------------------------------------------------
 // qSlicerSegmentEditorAbstractEffectPrivate methods
 
@@ -338,21 +341,41 @@ void qSlicerSegmentEditorAbstractEffect::modifySegmentByLabelmap(vtkMRMLSegmenta
         return;
         }
 
-      // Create threshold image
-      vtkSmartPointer<vtkImageThreshold> threshold = vtkSmartPointer<vtkImageThreshold>::New();
-      threshold->SetInputData(sourceVolumeOrientedImageData);
-      threshold->ThresholdBetween(parameterSetNode->GetSourceVolumeIntensityMaskRange()[0], parameterSetNode->GetSourceVolumeIntensityMaskRange()[1]);
-      threshold->SetInValue(m_EraseValue);
-      threshold->SetOutValue(m_FillValue);
-      threshold->SetOutputScalarTypeToUnsignedChar();
-      threshold->Update();
-
-      vtkSmartPointer<vtkOrientedImageData> thresholdMask = vtkSmartPointer<vtkOrientedImageData>::New();
-      thresholdMask->ShallowCopy(threshold->GetOutput());
-      vtkSmartPointer<vtkMatrix4x4> modifierLabelmapToWorldMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
-      modifierLabelmap->GetImageToWorldMatrix(modifierLabelmapToWorldMatrix);
-      thresholdMask->SetGeometryFromImageToWorldMatrix(modifierLabelmapToWorldMatrix);
-      vtkOrientedImageDataResample::ModifyImage(maskImage, thresholdMask, vtkOrientedImageDataResample::OPERATION_MAXIMUM);
+      // Only the region of the source volume that is covered by the modifier labelmap is thresholded
+      // (the modifier labelmap is often much smaller than the source volume, for example when painting).
+      // Outside this region the mask is not modified anyway.
+      int thresholdExtent[6] = { 0, -1, 0, -1, 0, -1 };
+      int* modifierLabelmapExtent = modifierLabelmap->GetExtent();
+      int* sourceVolumeExtent = sourceVolumeOrientedImageData->GetExtent();
+      bool thresholdExtentEmpty = false;
+      for (int i = 0; i < 3; ++i)
+        {
+        thresholdExtent[i * 2] = std::max(modifierLabelmapExtent[i * 2], sourceVolumeExtent[i * 2]);
+        thresholdExtent[i * 2 + 1] = std::min(modifierLabelmapExtent[i * 2 + 1], sourceVolumeExtent[i * 2 + 1]);
+        if (thresholdExtent[i * 2] > thresholdExtent[i * 2 + 1])
+          {
+          thresholdExtentEmpty = true;
+          }
+        }
+
+      if (!thresholdExtentEmpty)
+        {
+        // Create threshold image
+        vtkSmartPointer<vtkImageThreshold> threshold = vtkSmartPointer<vtkImageThreshold>::New();
+        threshold->SetInputData(sourceVolumeOrientedImageData);
+        threshold->ThresholdBetween(parameterSetNode->GetSourceVolumeIntensityMaskRange()[0], parameterSetNode->GetSourceVolumeIntensityMaskRange()[1]);
+        threshold->SetInValue(m_EraseValue);
+        threshold->SetOutValue(m_FillValue);
+        threshold->SetOutputScalarTypeToUnsignedChar();
+        threshold->UpdateExtent(thresholdExtent);
+
+        vtkSmartPointer<vtkOrientedImageData> thresholdMask = vtkSmartPointer<vtkOrientedImageData>::New();
+        thresholdMask->ShallowCopy(threshold->GetOutput());
+        vtkSmartPointer<vtkMatrix4x4> modifierLabelmapToWorldMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
+        modifierLabelmap->GetImageToWorldMatrix(modifierLabelmapToWorldMatrix);
+        thresholdMask->SetGeometryFromImageToWorldMatrix(modifierLabelmapToWorldMatrix);
+        vtkOrientedImageDataResample::ModifyImage(maskImage, thresholdMask, vtkOrientedImageDataResample::OPERATION_MAXIMUM);
+        }
       }
 
     vtkSmartPointer<vtkOrientedImageData> segmentLayerLabelmap =
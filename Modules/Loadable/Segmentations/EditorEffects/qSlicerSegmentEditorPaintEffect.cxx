@@ -33,6 +33,7 @@
 #include <QFrame>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QTimer>
 #include <QToolButton>
 #include <QVBoxLayout>
 
@@ -70,6 +71,7 @@
 #include <vtkRenderer.h>
 #include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkStringArray.h>
 #include <vtkWorldPointPicker.h>
@@ -96,6 +98,12 @@
 #include "vtkMRMLSliceLayerLogic.h"
 #include "vtkOrientedImageDataResample.h"
 
+// STD includes
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 /// Visualization objects and pipeline for each slice view for the paint brush
 class BrushPipeline
@@ -219,6 +227,188 @@ public:
   vtkSmartPointer<vtkPolyDataMapper> FeedbackMapper;
 };
 
+namespace
+{
+
+//-----------------------------------------------------------------------------
+/// Convex shape in the voxel (IJK) coordinate system of a labelmap, which can be rasterized analytically.
+/// A voxel is inside the shape if its center position p satisfies all the constraints:
+/// (p-Center)^T * Quadric * (p-Center) <= 1 (if HasQuadric is set) and
+/// Slab.Min <= Slab.Normal * (p-Center) <= Slab.Max for all slabs.
+struct BrushShape
+{
+  struct Slab
+    {
+    double Normal[3];
+    double Min;
+    double Max;
+    };
+
+  double Center[3] = { 0.0, 0.0, 0.0 };
+  bool HasQuadric = false;
+  double Quadric[3][3] = { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } };
+  std::vector<Slab> Slabs;
+  /// Bounding box of the shape (may be larger than the shape)
+  int Extent[6] = { 0, -1, 0, -1, 0, -1 };
+
+  void AddSlab(const double normal[3], double minValue, double maxValue)
+    {
+    Slab slab = { { normal[0], normal[1], normal[2] }, minValue, maxValue };
+    this->Slabs.push_back(slab);
+    }
+
+  /// Get the range of voxels in row (j, k) that are inside the shape.
+  /// \return False if the row does not intersect the shape.
+  bool GetRowSpan(int j, int k, int& iMin, int& iMax) const
+    {
+    double y = j - this->Center[1];
+    double z = k - this->Center[2];
+    // Range of x = i - Center[0]
+    double xMin = -std::numeric_limits<double>::max();
+    double xMax = std::numeric_limits<double>::max();
+    const double epsilon = 1e-12;
+    if (this->HasQuadric)
+      {
+      // a*x^2 + b*x + c <= 0
+      double a = this->Quadric[0][0];
+      double b = 2.0 * (this->Quadric[0][1] * y + this->Quadric[0][2] * z);
+      double c = this->Quadric[1][1] * y * y + 2.0 * this->Quadric[1][2] * y * z + this->Quadric[2][2] * z * z - 1.0;
+      if (a > epsilon)
+        {
+        double discriminant = b * b - 4.0 * a * c;
+        if (discriminant < 0.0)
+          {
+          return false;
+          }
+        double sqrtDiscriminant = sqrt(discriminant);
+        xMin = (-b - sqrtDiscriminant) / (2.0 * a);
+        xMax = (-b + sqrtDiscriminant) / (2.0 * a);
+        }
+      else if (fabs(b) > epsilon)
+        {
+        // The quadric is degenerate along the row direction (e.g., row is parallel to the axis of a cylinder)
+        if (b > 0)
+          {
+          xMax = -c / b;
+          }
+        else
+          {
+          xMin = -c / b;
+          }
+        }
+      else if (c > 0.0)
+        {
+        return false;
+        }
+      }
+    for (const Slab& slab : this->Slabs)
+      {
+      double offset = slab.Normal[1] * y + slab.Normal[2] * z;
+      if (fabs(slab.Normal[0]) > epsilon)
+        {
+        double slabXMin = (slab.Min - offset) / slab.Normal[0];
+        double slabXMax = (slab.Max - offset) / slab.Normal[0];
+        if (slabXMin > slabXMax)
+          {
+          std::swap(slabXMin, slabXMax);
+          }
+        xMin = std::max(xMin, slabXMin);
+        xMax = std::min(xMax, slabXMax);
+        }
+      else if (offset < slab.Min || offset > slab.Max)
+        {
+        return false;
+        }
+      }
+    if (xMin > xMax)
+      {
+      return false;
+      }
+    iMin = static_cast<int>(std::max(ceil(this->Center[0] + xMin), static_cast<double>(VTK_INT_MIN)));
+    iMax = static_cast<int>(std::min(floor(this->Center[0] + xMax), static_cast<double>(VTK_INT_MAX)));
+    return iMin <= iMax;
+    }
+
+  /// Set Extent to the bounding box of a box (in shape coordinates) that is transformed
+  /// to voxel coordinates by shapeToIjk, at the specified center position.
+  static void GetBoxExtent(const double shapeToIjk[3][3], const double halfSize[3], const double center[3], int extent[6])
+    {
+    for (int row = 0; row < 3; row++)
+      {
+      double halfExtent = 0.0;
+      for (int column = 0; column < 3; column++)
+        {
+        halfExtent += fabs(shapeToIjk[row][column]) * halfSize[column];
+        }
+      extent[row * 2] = static_cast<int>(floor(center[row] - halfExtent));
+      extent[row * 2 + 1] = static_cast<int>(ceil(center[row] + halfExtent));
+      }
+    }
+
+  static void MergeExtent(int extent[6], const int extentToAdd[6])
+    {
+    for (int i = 0; i < 3; i++)
+      {
+      extent[i * 2] = std::min(extent[i * 2], extentToAdd[i * 2]);
+      extent[i * 2 + 1] = std::max(extent[i * 2 + 1], extentToAdd[i * 2 + 1]);
+      }
+    }
+};
+
+//-----------------------------------------------------------------------------
+/// Set voxels inside the shape to fillValue (or keep the current value if it is larger).
+/// Rows of the shape are processed in parallel, each row is filled as a contiguous span.
+template <class T>
+void RasterizeBrushShape(const BrushShape& shape, vtkImageData* image, double fillValue, int paintedExtent[6])
+{
+  int* imageExtent = image->GetExtent();
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  for (int i = 0; i < 3; i++)
+    {
+    extent[i * 2] = std::max(shape.Extent[i * 2], imageExtent[i * 2]);
+    extent[i * 2 + 1] = std::min(shape.Extent[i * 2 + 1], imageExtent[i * 2 + 1]);
+    if (extent[i * 2] > extent[i * 2 + 1])
+      {
+      return;
+      }
+    }
+  T value = static_cast<T>(fillValue);
+  T* imagePtr = static_cast<T*>(image->GetScalarPointer());
+  vtkIdType imageDimensionX = imageExtent[1] - imageExtent[0] + 1;
+  vtkIdType imageDimensionY = imageExtent[3] - imageExtent[2] + 1;
+  int numberOfRowsY = extent[3] - extent[2] + 1;
+  vtkIdType numberOfRows = static_cast<vtkIdType>(numberOfRowsY) * (extent[5] - extent[4] + 1);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType beginRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = beginRow; row < endRow; row++)
+      {
+      int j = extent[2] + static_cast<int>(row % numberOfRowsY);
+      int k = extent[4] + static_cast<int>(row / numberOfRowsY);
+      int iMin = 0;
+      int iMax = -1;
+      if (!shape.GetRowSpan(j, k, iMin, iMax))
+        {
+        continue;
+        }
+      iMin = std::max(iMin, extent[0]);
+      iMax = std::min(iMax, extent[1]);
+      if (iMin > iMax)
+        {
+        continue;
+        }
+      T* rowPtr = imagePtr + ((k - imageExtent[4]) * imageDimensionY + (j - imageExtent[2])) * imageDimensionX
+        + (iMin - imageExtent[0]);
+      int spanLength = iMax - iMin + 1;
+      for (int i = 0; i < spanLength; i++)
+        {
+        rowPtr[i] = std::max(rowPtr[i], value);
+        }
+      }
+    });
+  BrushShape::MergeExtent(paintedExtent, extent);
+}
+
+} // end of anonymous namespace
 
 //-----------------------------------------------------------------------------
 // qSlicerSegmentEditorPaintEffectPrivate methods
@@ -231,6 +421,11 @@ qSlicerSegmentEditorPaintEffectPrivate::qSlicerSegmentEditorPaintEffectPrivate(q
   , LastBrushPositionValid(false)
   , DelayedPaint(true)
   , IsPainting(false)
+  , AsynchronousApply(true)
+  , PaintPending(false)
+  , PendingPaintErase(false)
+  , PaintedPointCount(0)
+  , PendingPaintApplyDelayDuringStrokeMsec(200)
   , ActiveViewWidget(nullptr)
   , PaintOptionsFrame(nullptr)
   , BrushDiameterFrame(nullptr)
@@ -283,6 +478,13 @@ qSlicerSegmentEditorPaintEffectPrivate::qSlicerSegmentEditorPaintEffectPrivate(q
   this->LastBrushPosition_World[0] = 0.0;
   this->LastBrushPosition_World[1] = 0.0;
   this->LastBrushPosition_World[2] = 0.0;
+
+  for (int i = 0; i < 6; i++)
+    {
+    this->PendingPaintExtent[i] = (i % 2 == 0) ? 0 : -1;
+    }
+  this->PendingPaintApplyTimer = new QTimer(this);
+  this->PendingPaintApplyTimer->setSingleShot(true);
 }
 
 //-----------------------------------------------------------------------------
@@ -360,13 +562,121 @@ void qSlicerSegmentEditorPaintEffectPrivate::paintAddPoint(qMRMLWidget* viewWidg
   this->PaintCoordinates_World->InsertNextPoint(brushPosition_World);
   this->PaintCoordinates_World->Modified();
 
-  if (q->integerParameter("BrushPixelMode") || !this->DelayedPaint)
+  if (this->AsynchronousApply)
+    {
+    // Stroke is painted into the modifier labelmap right away, segmentation is updated later
+    this->paintPending(viewWidget);
+    qSlicerSegmentEditorAbstractEffect::scheduleRender(viewWidget);
+    }
+  else if (q->integerParameter("BrushPixelMode") || !this->DelayedPaint)
     {
     q->paintApply(viewWidget);
     qSlicerSegmentEditorAbstractEffect::forceRender(viewWidget); // TODO: repaint all?
     }
 }
 
+//-----------------------------------------------------------------------------
+void qSlicerSegmentEditorPaintEffectPrivate::paintPending(qMRMLWidget* viewWidget)
+{
+  Q_Q(qSlicerSegmentEditorPaintEffect);
+
+  vtkMRMLSegmentEditorNode* parameterSetNode = q->parameterSetNode();
+  vtkMRMLSegmentationNode* segmentationNode = parameterSetNode ? parameterSetNode->GetSegmentationNode() : nullptr;
+  const char* selectedSegmentID = parameterSetNode ? parameterSetNode->GetSelectedSegmentID() : nullptr;
+  if (!segmentationNode || !selectedSegmentID)
+    {
+    // paintApply reports the errors
+    q->paintApply(viewWidget);
+    return;
+    }
+
+  // Pending strokes can only be merged if they modify the same segment in the same way
+  if (this->PaintPending
+    && (this->PendingPaintSegmentationNode != segmentationNode
+    || this->PendingPaintSegmentID != selectedSegmentID
+    || this->PendingPaintErase != q->m_Erase))
+    {
+    q->applyPendingPaint();
+    }
+
+  vtkOrientedImageData* modifierLabelmap = nullptr;
+  if (this->PaintPending)
+    {
+    modifierLabelmap = q->modifierLabelmap();
+    }
+  else
+    {
+    modifierLabelmap = q->defaultModifierLabelmap();
+    if (!modifierLabelmap)
+      {
+      qCritical() << Q_FUNC_INFO << ": Invalid modifier labelmap";
+      return;
+      }
+    this->PaintPending = true;
+    this->PendingPaintSegmentationNode = segmentationNode;
+    this->PendingPaintSegmentID = selectedSegmentID;
+    this->PendingPaintErase = q->m_Erase;
+    for (int i = 0; i < 6; i++)
+      {
+      this->PendingPaintExtent[i] = (i % 2 == 0) ? VTK_INT_MAX : VTK_INT_MIN;
+      }
+    }
+
+  // Paint points that have not been painted yet. The last painted point is included
+  // to keep the stroke continuous.
+  vtkIdType numberOfPoints = this->PaintCoordinates_World->GetNumberOfPoints();
+  if (this->PaintedPointCount < numberOfPoints)
+    {
+    vtkNew<vtkPoints> pointsToPaint_World;
+    for (vtkIdType pointIndex = std::max(this->PaintedPointCount - 1, vtkIdType(0)); pointIndex < numberOfPoints; pointIndex++)
+      {
+      pointsToPaint_World->InsertNextPoint(this->PaintCoordinates_World->GetPoint(pointIndex));
+      }
+    int updateExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    if (q->integerParameter("BrushPixelMode"))
+      {
+      this->paintPixels(modifierLabelmap, pointsToPaint_World, updateExtent);
+      }
+    else
+      {
+      this->paintBrushes(modifierLabelmap, viewWidget, pointsToPaint_World, updateExtent);
+      }
+    if (updateExtent[0] <= updateExtent[1] && updateExtent[2] <= updateExtent[3] && updateExtent[4] <= updateExtent[5])
+      {
+      for (int i = 0; i < 3; i++)
+        {
+        this->PendingPaintExtent[i * 2] = std::min(this->PendingPaintExtent[i * 2], updateExtent[i * 2]);
+        this->PendingPaintExtent[i * 2 + 1] = std::max(this->PendingPaintExtent[i * 2 + 1], updateExtent[i * 2 + 1]);
+        }
+      }
+    this->PaintedPointCount = numberOfPoints;
+    }
+
+  if (!this->IsPainting)
+    {
+    // Stroke is completed, update the segmentation as soon as the current event is processed
+    this->PendingPaintApplyTimer->start(0);
+    }
+  else if (!this->DelayedPaint || q->integerParameter("BrushPixelMode"))
+    {
+    // Stroke is in progress, update the segmentation when the user pauses
+    this->PendingPaintApplyTimer->start(this->PendingPaintApplyDelayDuringStrokeMsec);
+    }
+}
+
+//-----------------------------------------------------------------------------
+qSlicerSegmentEditorAbstractEffect::ModificationMode qSlicerSegmentEditorPaintEffectPrivate::modificationMode(bool erase)
+{
+  Q_Q(qSlicerSegmentEditorPaintEffect);
+  if (q->m_AlwaysErase)
+    {
+    return q->integerParameter("EraseAllSegments") ?
+      qSlicerSegmentEditorAbstractEffect::ModificationModeRemoveAll : qSlicerSegmentEditorAbstractEffect::ModificationModeRemove;
+    }
+  return erase ?
+    qSlicerSegmentEditorAbstractEffect::ModificationModeRemove : qSlicerSegmentEditorAbstractEffect::ModificationModeAdd;
+}
+
 //-----------------------------------------------------------------------------
 void qSlicerSegmentEditorPaintEffectPrivate::updateBrushStencil(qMRMLWidget* viewWidget)
 {
@@ -483,7 +793,7 @@ void qSlicerSegmentEditorPaintEffectPrivate::paintPixels(
   modifierLabelmap->GetExtent(modifierExtent);
 
   vtkNew<vtkPoints> paintCoordinates_Ijk;
-  this->transformPointsFromWorldToIJK(modifierLabelmap, segmentationNode, this->PaintCoordinates_World, paintCoordinates_Ijk);
+  this->transformPointsFromWorldToIJK(modifierLabelmap, segmentationNode, pixelPositions_World, paintCoordinates_Ijk);
 
   for (int pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
     {
@@ -522,9 +832,14 @@ void qSlicerSegmentEditorPaintEffectPrivate::paintBrushes(
   vtkPoints* pixelPositions_World,
   int updateExtent[6])
 {
-  Q_UNUSED(pixelPositions_World);
   Q_Q(qSlicerSegmentEditorPaintEffect);
 
+  if (!pixelPositions_World)
+    {
+    qCritical() << Q_FUNC_INFO << ": Invalid pixelPositions";
+    return;
+    }
+
   this->updateBrushStencil(viewWidget);
 
   if (!modifierLabelmap)
@@ -545,7 +860,13 @@ void qSlicerSegmentEditorPaintEffectPrivate::paintBrushes(
   stencilData->GetExtent(stencilExtent);
 
   vtkNew<vtkPoints> paintCoordinates_Ijk;
-  this->transformPointsFromWorldToIJK(modifierLabelmap, segmentationNode, this->PaintCoordinates_World, paintCoordinates_Ijk);
+  this->transformPointsFromWorldToIJK(modifierLabelmap, segmentationNode, pixelPositions_World, paintCoordinates_Ijk);
+
+  if (this->paintBrushesAnalytically(modifierLabelmap, paintCoordinates_Ijk, updateExtent))
+    {
+    modifierLabelmap->Modified();
+    return;
+    }
 
   vtkNew<vtkImageStencilToImage> stencilToImage;
   stencilToImage->SetInputConnection(this->BrushPolyDataToStencil->GetOutputPort());
@@ -558,7 +879,7 @@ void qSlicerSegmentEditorPaintEffectPrivate::paintBrushes(
   brushPositioner->SetOutputSpacing(modifierLabelmap->GetSpacing());
   brushPositioner->SetOutputOrigin(modifierLabelmap->GetOrigin());
 
-  vtkIdType numberOfPoints = this->PaintCoordinates_World->GetNumberOfPoints();
+  vtkIdType numberOfPoints = pixelPositions_World->GetNumberOfPoints();
   for (int pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
     {
     double* shiftDouble = paintCoordinates_Ijk->GetPoint(pointIndex);
@@ -592,6 +913,238 @@ void qSlicerSegmentEditorPaintEffectPrivate::paintBrushes(
   modifierLabelmap->Modified();
 }
 
+//-----------------------------------------------------------------------------
+bool qSlicerSegmentEditorPaintEffectPrivate::paintBrushesAnalytically(
+  vtkOrientedImageData* modifierLabelmap,
+  vtkPoints* paintCoordinates_Ijk,
+  int updateExtent[6])
+{
+  Q_Q(qSlicerSegmentEditorPaintEffect);
+
+  if (this->BrushToWorldOriginTransformer->GetNumberOfInputConnections(0) == 0)
+    {
+    return false;
+    }
+  vtkAlgorithm* brushSource = this->BrushToWorldOriginTransformer->GetInputAlgorithm(0, 0);
+  bool sphereBrush = (brushSource == this->BrushSphereSource.GetPointer());
+  bool cylinderBrush = (brushSource == this->BrushCylinderSource.GetPointer());
+  if (!sphereBrush && !cylinderBrush)
+    {
+    // custom brush shape, it has to be rasterized using the brush polydata
+    return false;
+    }
+
+  // Brush model to modifier labelmap IJK (origin of the brush is at the origin of IJK)
+  vtkNew<vtkMatrix4x4> brushToIjkMatrix;
+  vtkMatrix4x4::Multiply4x4(this->WorldOriginToModifierLabelmapIjkTransform->GetMatrix(),
+    this->BrushToWorldOriginTransform->GetMatrix(), brushToIjkMatrix.GetPointer());
+  double brushToIjk[3][3] = { { 0.0 } };
+  for (int row = 0; row < 3; row++)
+    {
+    for (int column = 0; column < 3; column++)
+      {
+      brushToIjk[row][column] = brushToIjkMatrix->GetElement(row, column);
+      }
+    }
+  if (fabs(vtkMath::Determinant3x3(brushToIjk)) < 1e-12)
+    {
+    return false;
+    }
+  double ijkToBrush[3][3] = { { 0.0 } };
+  vtkMath::Invert3x3(brushToIjk, ijkToBrush);
+
+  // Brush shape is defined in brush model coordinates: sphere is centered at the origin,
+  // cylinder is centered at the origin and its axis is the Y axis.
+  double radius = sphereBrush ? this->BrushSphereSource->GetRadius() : this->BrushCylinderSource->GetRadius();
+  double halfHeight = cylinderBrush ? this->BrushCylinderSource->GetHeight() / 2.0 : radius;
+  if (radius <= 0.0)
+    {
+    return false;
+    }
+  double brushCenter[3] = { 0.0, 0.0, 0.0 };
+  if (sphereBrush)
+    {
+    this->BrushSphereSource->GetCenter(brushCenter);
+    }
+  else
+    {
+    this->BrushCylinderSource->GetCenter(brushCenter);
+    }
+  double brushCenterOffset_Ijk[3] = { 0.0, 0.0, 0.0 };
+  vtkMath::Multiply3x3(brushToIjk, brushCenter, brushCenterOffset_Ijk);
+  double brushHalfSize[3] = { radius, halfHeight, radius };
+
+  // Rows of ijkToBrush transform a vector from IJK to the brush model axes
+  double brushAxis_Ijk[3][3] = { { 0.0 } };
+  for (int axis = 0; axis < 3; axis++)
+    {
+    for (int i = 0; i < 3; i++)
+      {
+      brushAxis_Ijk[axis][i] = ijkToBrush[axis][i];
+      }
+    }
+
+  // Brush stamp at the origin (it is translated to each stroke point)
+  BrushShape stamp;
+  if (sphereBrush)
+    {
+    // |ijkToBrush * p|^2 <= r^2
+    stamp.HasQuadric = true;
+    for (int row = 0; row < 3; row++)
+      {
+      for (int column = 0; column < 3; column++)
+        {
+        for (int axis = 0; axis < 3; axis++)
+          {
+          stamp.Quadric[row][column] += brushAxis_Ijk[axis][row] * brushAxis_Ijk[axis][column] / (radius * radius);
+          }
+        }
+      }
+    }
+  else
+    {
+    // Distance from the Y axis is smaller than the radius and Y is within half height
+    stamp.HasQuadric = true;
+    for (int row = 0; row < 3; row++)
+      {
+      for (int column = 0; column < 3; column++)
+        {
+        stamp.Quadric[row][column] = (brushAxis_Ijk[0][row] * brushAxis_Ijk[0][column]
+          + brushAxis_Ijk[2][row] * brushAxis_Ijk[2][column]) / (radius * radius);
+        }
+      }
+    stamp.AddSlab(brushAxis_Ijk[1], -halfHeight, halfHeight);
+    }
+
+  // Collect brush positions. Brushes are positioned at voxel centers, similarly to the polydata based brush.
+  vtkIdType numberOfPoints = paintCoordinates_Ijk->GetNumberOfPoints();
+  std::vector<std::array<double, 3> > brushPositions_Ijk(numberOfPoints);
+  for (vtkIdType pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
+    {
+    double* position_Ijk = paintCoordinates_Ijk->GetPoint(pointIndex);
+    for (int i = 0; i < 3; i++)
+      {
+      brushPositions_Ijk[pointIndex][i] = vtkMath::Round(position_Ijk[i]) + brushCenterOffset_Ijk[i];
+      }
+    }
+
+  std::vector<BrushShape> shapes;
+  for (vtkIdType pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
+    {
+    BrushShape shape = stamp;
+    for (int i = 0; i < 3; i++)
+      {
+      shape.Center[i] = brushPositions_Ijk[pointIndex][i];
+      }
+    BrushShape::GetBoxExtent(brushToIjk, brushHalfSize, shape.Center, shape.Extent);
+    shapes.push_back(shape);
+    }
+
+  // Fill the region swept by the brush between consecutive stroke points
+  for (vtkIdType pointIndex = 1; pointIndex < numberOfPoints; pointIndex++)
+    {
+    const double* startPosition_Ijk = brushPositions_Ijk[pointIndex - 1].data();
+    const double* endPosition_Ijk = brushPositions_Ijk[pointIndex].data();
+    double stroke_Ijk[3] = { endPosition_Ijk[0] - startPosition_Ijk[0],
+      endPosition_Ijk[1] - startPosition_Ijk[1], endPosition_Ijk[2] - startPosition_Ijk[2] };
+    double stroke_Brush[3] = { 0.0, 0.0, 0.0 };
+    vtkMath::Multiply3x3(ijkToBrush, stroke_Ijk, stroke_Brush);
+    if (cylinderBrush)
+      {
+      // the cylinder is swept in its cross-section plane
+      stroke_Brush[1] = 0.0;
+      }
+    double strokeLength = vtkMath::Normalize(stroke_Brush);
+    if (strokeLength < 1e-6)
+      {
+      continue;
+      }
+    // Brush stroke direction in IJK (dot product with the direction gives distance along the stroke)
+    double strokeDirection_Ijk[3] = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < 3; i++)
+      {
+      for (int axis = 0; axis < 3; axis++)
+        {
+        strokeDirection_Ijk[i] += stroke_Brush[axis] * brushAxis_Ijk[axis][i];
+        }
+      }
+    BrushShape body;
+    for (int i = 0; i < 3; i++)
+      {
+      body.Center[i] = startPosition_Ijk[i];
+      }
+    body.AddSlab(strokeDirection_Ijk, 0.0, strokeLength);
+    if (sphereBrush)
+      {
+      // Capsule body: cylinder around the stroke
+      body.HasQuadric = true;
+      for (int row = 0; row < 3; row++)
+        {
+        for (int column = 0; column < 3; column++)
+          {
+          body.Quadric[row][column] = (stamp.Quadric[row][column] * radius * radius
+            - strokeDirection_Ijk[row] * strokeDirection_Ijk[column]) / (radius * radius);
+          }
+        }
+      }
+    else
+      {
+      // Box that connects the cylinders of the two stroke points
+      double sideDirection_Brush[3] = { stroke_Brush[2], 0.0, -stroke_Brush[0] };
+      double sideDirection_Ijk[3] = { 0.0, 0.0, 0.0 };
+      for (int i = 0; i < 3; i++)
+        {
+        for (int axis = 0; axis < 3; axis++)
+          {
+          sideDirection_Ijk[i] += sideDirection_Brush[axis] * brushAxis_Ijk[axis][i];
+          }
+        }
+      body.AddSlab(sideDirection_Ijk, -radius, radius);
+      body.AddSlab(brushAxis_Ijk[1], -halfHeight, halfHeight);
+      }
+    // The body is within the bounding box of the brushes at the two ends
+    body.Extent[0] = VTK_INT_MAX;
+    body.Extent[1] = VTK_INT_MIN;
+    body.Extent[2] = VTK_INT_MAX;
+    body.Extent[3] = VTK_INT_MIN;
+    body.Extent[4] = VTK_INT_MAX;
+    body.Extent[5] = VTK_INT_MIN;
+    BrushShape::MergeExtent(body.Extent, shapes[pointIndex - 1].Extent);
+    BrushShape::MergeExtent(body.Extent, shapes[pointIndex].Extent);
+    shapes.push_back(body);
+    }
+
+  int paintedExtent[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN };
+  for (const BrushShape& shape : shapes)
+    {
+    switch (modifierLabelmap->GetScalarType())
+      {
+      vtkTemplateMacro(RasterizeBrushShape<VTK_TT>(shape, modifierLabelmap, q->m_FillValue, paintedExtent));
+      default:
+        qCritical() << Q_FUNC_INFO << ": Unknown modifier labelmap scalar type";
+        return false;
+      }
+    }
+  if (paintedExtent[0] > paintedExtent[1])
+    {
+    // brush is outside of the modifier labelmap
+    paintedExtent[0] = 0;
+    paintedExtent[1] = -1;
+    paintedExtent[2] = 0;
+    paintedExtent[3] = -1;
+    paintedExtent[4] = 0;
+    paintedExtent[5] = -1;
+    }
+  if (updateExtent)
+    {
+    for (int i = 0; i < 6; i++)
+      {
+      updateExtent[i] = paintedExtent[i];
+      }
+    }
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void qSlicerSegmentEditorPaintEffectPrivate::scaleDiameter(double scaleFactor)
 {
@@ -973,6 +1526,9 @@ qSlicerSegmentEditorPaintEffect::qSlicerSegmentEditorPaintEffect(QObject* parent
   this->m_AlwaysErase = false;
   this->m_Erase = false;
   this->m_ShowEffectCursorInThreeDView = true;
+
+  Q_D(qSlicerSegmentEditorPaintEffect);
+  QObject::connect(d->PendingPaintApplyTimer, SIGNAL(timeout()), this, SLOT(applyPendingPaint()));
 }
 
 //----------------------------------------------------------------------------
@@ -1009,8 +1565,9 @@ qSlicerSegmentEditorAbstractEffect* qSlicerSegmentEditorPaintEffect::clone()
 void qSlicerSegmentEditorPaintEffect::deactivate()
 {
   Q_D(qSlicerSegmentEditorPaintEffect);
-  Superclass::deactivate();
   d->IsPainting = false;
+  this->applyPendingPaint();
+  Superclass::deactivate();
   d->clearBrushPipelines();
   d->PaintCoordinates_World->Reset();
   d->ActiveViewWidget = nullptr;
@@ -1247,7 +1804,8 @@ bool qSlicerSegmentEditorPaintEffect::processInteractionEvents(
       }
     foreach (qMRMLWidget* viewWidget, viewWidgets)
       {
-      d->BrushPipelines[viewWidget]->SetFeedbackVisibility(d->DelayedPaint);
+      // In asynchronous mode the feedback shows the stroke until the segmentation is updated
+      d->BrushPipelines[viewWidget]->SetFeedbackVisibility(d->DelayedPaint || d->AsynchronousApply);
       }
     // Start point of a paint stroke
     d->LastBrushPosition_World[0] = brushPosition_World[0];
@@ -1268,19 +1826,28 @@ bool qSlicerSegmentEditorPaintEffect::processInteractionEvents(
         d->paintAddPoint(viewWidget, brushPosition_World, d->LastBrushPositionValid ? d->LastBrushPosition_World : nullptr);
         }
 
-      // Schedule rendering of all views.
-      // Cleaning up pipelines schedules re-rendering as well, but on some Intel video cards, and especially in debug mode,
-      // this additional rendering request is necessary for showing the filled segment after paint stroke is completed.
-      QList<qMRMLWidget*> viewWidgets = d->BrushPipelines.keys();
-      foreach(qMRMLWidget* aViewWidget, viewWidgets)
+      if (d->AsynchronousApply)
         {
-        d->BrushPipelines[aViewWidget]->SetFeedbackVisibility(false);
-        d->BrushPipelines[aViewWidget]->SetBrushVisibility(worldPositionValid);
-        qSlicerSegmentEditorAbstractEffect::scheduleRender(aViewWidget);
+        // Segmentation is updated after this event is processed. Feedback is kept visible until then.
+        d->IsPainting = false;
+        d->paintPending(viewWidget);
         }
+      else
+        {
+        // Schedule rendering of all views.
+        // Cleaning up pipelines schedules re-rendering as well, but on some Intel video cards, and especially in debug mode,
+        // this additional rendering request is necessary for showing the filled segment after paint stroke is completed.
+        QList<qMRMLWidget*> viewWidgets = d->BrushPipelines.keys();
+        foreach(qMRMLWidget* aViewWidget, viewWidgets)
+          {
+          d->BrushPipelines[aViewWidget]->SetFeedbackVisibility(false);
+          d->BrushPipelines[aViewWidget]->SetBrushVisibility(worldPositionValid);
+          qSlicerSegmentEditorAbstractEffect::scheduleRender(aViewWidget);
+          }
 
-      this->paintApply(viewWidget);
-      d->IsPainting = false;
+        this->paintApply(viewWidget);
+        d->IsPainting = false;
+        }
       abortEvent = true;
       }
     //this->cursorOn(sliceWidget);
@@ -1698,11 +2265,85 @@ void qSlicerSegmentEditorPaintEffect::setDelayedPaint(bool delayed)
   d->DelayedPaint = delayed;
 }
 
+//-----------------------------------------------------------------------------
+bool qSlicerSegmentEditorPaintEffect::asynchronousApply()
+{
+  Q_D(qSlicerSegmentEditorPaintEffect);
+  return d->AsynchronousApply;
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerSegmentEditorPaintEffect::setAsynchronousApply(bool asynchronous)
+{
+  Q_D(qSlicerSegmentEditorPaintEffect);
+  if (!asynchronous)
+    {
+    this->applyPendingPaint();
+    }
+  d->AsynchronousApply = asynchronous;
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerSegmentEditorPaintEffect::applyPendingPaint()
+{
+  Q_D(qSlicerSegmentEditorPaintEffect);
+  d->PendingPaintApplyTimer->stop();
+  if (!d->PaintPending)
+    {
+    return;
+    }
+  d->PaintPending = false;
+
+  vtkOrientedImageData* modifierLabelmap = this->modifierLabelmap();
+  vtkMRMLSegmentationNode* segmentationNode = d->PendingPaintSegmentationNode;
+  if (modifierLabelmap && segmentationNode
+    && segmentationNode->GetSegmentation()->GetSegment(d->PendingPaintSegmentID))
+    {
+    this->saveStateForUndo();
+
+    int updateExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    int modifierExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    modifierLabelmap->GetExtent(modifierExtent);
+    for (int i = 0; i < 3; i++)
+      {
+      updateExtent[2 * i] = std::max(d->PendingPaintExtent[2 * i], modifierExtent[2 * i]);
+      updateExtent[2 * i + 1] = std::min(d->PendingPaintExtent[2 * i + 1], modifierExtent[2 * i + 1]);
+      }
+    if (updateExtent[0] <= updateExtent[1] && updateExtent[2] <= updateExtent[3] && updateExtent[4] <= updateExtent[5])
+      {
+      this->modifySegmentByLabelmap(segmentationNode, d->PendingPaintSegmentID.c_str(), modifierLabelmap,
+        d->modificationMode(d->PendingPaintErase), updateExtent);
+      }
+    }
+
+  // Rendering the feedback actor with no points will result in an error message that will clutter the log.
+  // "No input data"
+  if (d->IsPainting && d->PaintCoordinates_World->GetNumberOfPoints() > 0)
+    {
+    // Stroke is still in progress, keep the last point to connect the rest of the stroke to it
+    double lastPoint_World[3] = { 0.0, 0.0, 0.0 };
+    d->PaintCoordinates_World->GetPoint(d->PaintCoordinates_World->GetNumberOfPoints() - 1, lastPoint_World);
+    d->PaintCoordinates_World->Reset();
+    d->PaintCoordinates_World->InsertNextPoint(lastPoint_World);
+    d->PaintCoordinates_World->Modified();
+    d->PaintedPointCount = 0;
+    }
+  else
+    {
+    d->clearBrushPipelines();
+    d->PaintCoordinates_World->Reset();
+    d->PaintedPointCount = 0;
+    }
+}
+
 //-----------------------------------------------------------------------------
 void qSlicerSegmentEditorPaintEffect::paintApply(qMRMLWidget* viewWidget)
 {
   Q_D(qSlicerSegmentEditorPaintEffect);
 
+  // Apply pending strokes first to keep the order of modifications
+  this->applyPendingPaint();
+
   vtkOrientedImageData* modifierLabelmap = this->defaultModifierLabelmap();
   if (!modifierLabelmap)
     {
@@ -1748,24 +2389,13 @@ void qSlicerSegmentEditorPaintEffect::paintApply(qMRMLWidget* viewWidget)
     }
 
   // Notify editor about changes
-  qSlicerSegmentEditorAbstractEffect::ModificationMode modificationMode;
-  if (this->m_AlwaysErase)
-    {
-    modificationMode = this->integerParameter("EraseAllSegments") ?
-      qSlicerSegmentEditorAbstractEffect::ModificationModeRemoveAll : qSlicerSegmentEditorAbstractEffect::ModificationModeRemove;
-    }
-  else
-    {
-    modificationMode = this->m_Erase ?
-      qSlicerSegmentEditorAbstractEffect::ModificationModeRemove : qSlicerSegmentEditorAbstractEffect::ModificationModeAdd;
-    }
-
-  this->modifySelectedSegmentByLabelmap(modifierLabelmap, modificationMode, updateExtentList);
+  this->modifySelectedSegmentByLabelmap(modifierLabelmap, d->modificationMode(this->m_Erase), updateExtentList);
 
   // Rendering the feedback actor with no points will result in an error message that will clutter the log.
   // "No input data"
   d->clearBrushPipelines();
   d->PaintCoordinates_World->Reset();
+  d->PaintedPointCount = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -1790,6 +2420,7 @@ void qSlicerSegmentEditorPaintEffect::clearBrushes()
   // "No input data"
   d->clearBrushPipelines();
   d->PaintCoordinates_World->Reset();
+  d->PaintedPointCount = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -38,6 +38,7 @@ class Q_SLICER_SEGMENTATIONS_EFFECTS_EXPORT qSlicerSegmentEditorPaintEffect :
 public:
   Q_PROPERTY(double minimumPaintPointDistance READ minimumPaintPointDistance WRITE setMinimumPaintPointDistance)
   Q_PROPERTY(bool delayedPaint READ delayedPaint WRITE setDelayedPaint)
+  Q_PROPERTY(bool asynchronousApply READ asynchronousApply WRITE setAsynchronousApply)
 
   typedef qSlicerSegmentEditorAbstractLabelEffect Superclass;
   qSlicerSegmentEditorPaintEffect(QObject* parent = nullptr);
@@ -87,6 +88,13 @@ public:
   /// If enabled then segmentation is only modified when the mouse button is released.
   Q_INVOKABLE bool delayedPaint();
 
+  /// If enabled then interactive paint strokes are painted into the modifier labelmap right away
+  /// (shown by the stroke preview), but the segmentation is only updated after the input event has
+  /// been processed. Strokes that are painted before the pending update is applied are merged
+  /// and applied together, in the order they were painted.
+  /// Enabled by default. Scripted paint effects disable it, as they implement their own paintApply.
+  Q_INVOKABLE bool asynchronousApply();
+
   // returns extent of the brushes
   Q_INVOKABLE QList<int> paintBrushesIntoLabelmap(vtkOrientedImageData* labelmap, qMRMLWidget* viewWidget);
 
@@ -114,6 +122,14 @@ public slots:
   /// \sa delayedPaint
   void setDelayedPaint(bool delayed);
 
+  /// \sa asynchronousApply
+  void setAsynchronousApply(bool asynchronous);
+
+  /// Update the segmentation with the strokes that have been painted in asynchronous mode
+  /// but not applied yet.
+  /// \sa asynchronousApply
+  void applyPendingPaint();
+
 protected:
   /// Flag determining to always erase (not just when smudge from empty region)
   /// Overridden in the \sa qSlicerSegmentEditorEraseEffect subclass
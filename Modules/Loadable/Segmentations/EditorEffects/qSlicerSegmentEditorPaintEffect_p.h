@@ -36,6 +36,7 @@
 #include "qSlicerSegmentationsEditorEffectsExport.h"
 
 #include "qSlicerSegmentEditorPaintEffect.h"
+#include "vtkMRMLSegmentationNode.h"
 
 // VTK includes
 #include <vtkCutter.h>
@@ -51,12 +52,16 @@
 #include <QList>
 #include <QMap>
 
+// STD includes
+#include <string>
+
 class BrushPipeline;
 class ctkDoubleSlider;
 class QPoint;
 class QIcon;
 class QFrame;
 class QCheckBox;
+class QTimer;
 class QToolButton;
 class qMRMLSliceWidget;
 class qMRMLSpinBox;
@@ -108,6 +113,18 @@ protected:
   /// Paint brushes to the modifier labelmap
   void paintBrushes(vtkOrientedImageData* modifierLabelmap, qMRMLWidget* viewWidget, vtkPoints* pixelPositions_World, int extent[6]=nullptr);
 
+  /// Paint sphere and cylinder brushes by computing the voxels inside the brush (and inside the
+  /// region swept by the brush between consecutive points) directly, without creating a brush stencil.
+  /// Returns false if the brush shape is not supported (the polydata based method has to be used then).
+  bool paintBrushesAnalytically(vtkOrientedImageData* modifierLabelmap, vtkPoints* paintCoordinates_Ijk, int extent[6]=nullptr);
+
+  /// Paint stroke points that have not been painted yet into the modifier labelmap and
+  /// schedule update of the segmentation (used in asynchronous apply mode).
+  void paintPending(qMRMLWidget* viewWidget);
+
+  /// Get how the segment has to be modified if the stroke is painted or erased
+  qSlicerSegmentEditorAbstractEffect::ModificationMode modificationMode(bool erase);
+
   /// Paint one pixel at coordinate
   void paintPixel(vtkOrientedImageData* modifierLabelmap, qMRMLWidget* viewWidget, double pixelPosition_World[3]);
 
@@ -171,6 +188,21 @@ public:
   bool DelayedPaint;
   bool IsPainting;
 
+  bool AsynchronousApply;
+  /// Set if the modifier labelmap contains strokes that are not applied to the segmentation yet
+  bool PaintPending;
+  /// Segment that the pending strokes will be applied to
+  vtkWeakPointer<vtkMRMLSegmentationNode> PendingPaintSegmentationNode;
+  std::string PendingPaintSegmentID;
+  bool PendingPaintErase;
+  int PendingPaintExtent[6];
+  /// Number of points of PaintCoordinates_World that have been already painted into the modifier labelmap
+  vtkIdType PaintedPointCount;
+  /// Delay of applying pending strokes while the mouse button is still pressed
+  /// (segmentation is updated when the user pauses painting)
+  int PendingPaintApplyDelayDuringStrokeMsec;
+  QTimer* PendingPaintApplyTimer;
+
   // Observed view node
   qMRMLWidget* ActiveViewWidget;
   int ActiveViewLastInteractionPosition[2];
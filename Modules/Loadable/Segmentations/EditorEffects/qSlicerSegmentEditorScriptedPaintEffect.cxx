@@ -103,6 +103,8 @@ qSlicerSegmentEditorScriptedPaintEffect::qSlicerSegmentEditorScriptedPaintEffect
   , d_ptr(new qSlicerSegmentEditorScriptedPaintEffectPrivate)
 {
   this->m_Name = QString("UnnamedScriptedPaintEffect");
+  // Scripted effects implement paintApply, which would be bypassed by asynchronous apply
+  this->setAsynchronousApply(false);
 }
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,136 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// Segmentations includes
+#include "vtkImageGrowCutSegment.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkTimerLog.h>
+
+// STD includes
+#include <algorithm>
+
+namespace
+{
+
+const int ImageSize = 64;
+
+//----------------------------------------------------------------------------
+// Intensity volume: bright sphere in a dark background, with some noise-free gradient
+void CreateIntensityVolume(vtkImageData* image)
+{
+  image->SetDimensions(ImageSize, ImageSize, ImageSize);
+  image->AllocateScalars(VTK_SHORT, 1);
+  short* imagePtr = static_cast<short*>(image->GetScalarPointer());
+  double center = (ImageSize - 1) / 2.0;
+  double radius = ImageSize / 4.0;
+  for (int k = 0; k < ImageSize; ++k)
+    {
+    for (int j = 0; j < ImageSize; ++j)
+      {
+      for (int i = 0; i < ImageSize; ++i)
+        {
+        double distance2 = (i - center) * (i - center) + (j - center) * (j - center) + (k - center) * (k - center);
+        *(imagePtr++) = (distance2 < radius * radius) ? 200 + i % 3 : 10 + j % 3;
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void CreateSeedVolume(vtkImageData* image)
+{
+  image->SetDimensions(ImageSize, ImageSize, ImageSize);
+  image->AllocateScalars(VTK_SHORT, 1);
+  short* imagePtr = static_cast<short*>(image->GetScalarPointer());
+  std::fill(imagePtr, imagePtr + ImageSize * ImageSize * ImageSize, 0);
+  int c = ImageSize / 2;
+  // foreground seed in the sphere, background seed in a corner
+  image->SetScalarComponentFromDouble(c, c, c, 0, 1);
+  image->SetScalarComponentFromDouble(4, 4, 4, 0, 2);
+}
+
+//----------------------------------------------------------------------------
+bool CheckLabel(vtkImageData* image, int i, int j, int k, int expectedLabel, int line)
+{
+  int label = static_cast<int>(image->GetScalarComponentAsDouble(i, j, k, 0));
+  if (label != expectedLabel)
+    {
+    std::cerr << "Line " << line << ": label at (" << i << ", " << j << ", " << k << ") is "
+      << label << ", expected " << expectedLabel << std::endl;
+    return false;
+    }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkImageGrowCutSegmentTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkImageData> intensityVolume;
+  CreateIntensityVolume(intensityVolume);
+  vtkNew<vtkImageData> seedVolume;
+  CreateSeedVolume(seedVolume);
+
+  vtkNew<vtkImageGrowCutSegment> growCut;
+  growCut->SetIntensityVolume(intensityVolume);
+  growCut->SetSeedLabelVolume(seedVolume);
+
+  // Full computation
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  growCut->Update();
+  timer->StopTimer();
+  double fullComputationTime = timer->GetElapsedTime();
+
+  int c = ImageSize / 2;
+  vtkImageData* result = growCut->GetOutput();
+  if (!CheckLabel(result, c, c, c, 1, __LINE__)
+    || !CheckLabel(result, c + ImageSize / 8, c, c, 1, __LINE__)
+    || !CheckLabel(result, 10, 10, 10, 2, __LINE__)
+    // voxels at the edges of the volume
+    || !CheckLabel(result, 0, 0, 0, 2, __LINE__)
+    || !CheckLabel(result, ImageSize - 1, ImageSize - 1, ImageSize - 1, 2, __LINE__)
+    || !CheckLabel(result, c, c, 0, 2, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Incremental update after adding a seed: only the region around the new seed is recomputed
+  seedVolume->SetScalarComponentFromDouble(ImageSize - 5, ImageSize - 5, ImageSize - 5, 0, 3);
+  seedVolume->Modified();
+  timer->StartTimer();
+  growCut->Update();
+  timer->StopTimer();
+  double updateTime = timer->GetElapsedTime();
+
+  result = growCut->GetOutput();
+  if (!CheckLabel(result, c, c, c, 1, __LINE__)
+    || !CheckLabel(result, 4, 4, 4, 2, __LINE__)
+    || !CheckLabel(result, ImageSize - 5, ImageSize - 5, ImageSize - 5, 3, __LINE__)
+    || !CheckLabel(result, ImageSize - 1, ImageSize - 1, ImageSize - 1, 3, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Image size: " << ImageSize << "^3" << std::endl;
+  std::cout << "Full computation time: " << fullComputationTime << " s" << std::endl;
+  std::cout << "Update time after adding a seed: " << updateTime << " s" << std::endl;
+
+  return EXIT_SUCCESS;
+}
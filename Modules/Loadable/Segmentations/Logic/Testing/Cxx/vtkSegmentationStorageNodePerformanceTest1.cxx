@@ -0,0 +1,175 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// Measure the time of writing and reading .seg.nrrd files at several segment counts,
+// volume sizes, number of layers and compression settings.
+// Times are reported as dashboard measurements.
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+#include <vtkMRMLScene.h>
+#include <vtkMRMLSegmentationNode.h>
+#include <vtkMRMLSegmentationStorageNode.h>
+
+// SegmentationCore includes
+#include <vtkBinaryLabelmapToClosedSurfaceConversionRule.h>
+#include <vtkClosedSurfaceToBinaryLabelmapConversionRule.h>
+#include <vtkOrientedImageData.h>
+#include <vtkSegment.h>
+#include <vtkSegmentation.h>
+#include <vtkSegmentationConverter.h>
+#include <vtkSegmentationConverterFactory.h>
+
+// VTK includes
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+#include <vtkTimerLog.h>
+
+// STD includes
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Labelmap of volumeSize^3 voxels, divided into numberOfSegments slabs along the z axis.
+/// If segmentIndex is specified then only that slab is filled.
+void createSlabLabelmap(vtkOrientedImageData* labelmap, int volumeSize, int numberOfSegments, int segmentIndex = -1)
+{
+  labelmap->SetExtent(0, volumeSize - 1, 0, volumeSize - 1, 0, volumeSize - 1);
+  labelmap->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  unsigned char* voxels = static_cast<unsigned char*>(labelmap->GetScalarPointer());
+  for (int z = 0; z < volumeSize; ++z)
+    {
+    int label = z * numberOfSegments / volumeSize;
+    for (int y = 0; y < volumeSize; ++y)
+      {
+      for (int x = 0; x < volumeSize; ++x, ++voxels)
+        {
+        bool inside = (segmentIndex < 0 || label == segmentIndex)
+          && x > volumeSize / 8 && x < volumeSize * 7 / 8 && y > volumeSize / 8 && y < volumeSize * 7 / 8;
+        *voxels = inside ? static_cast<unsigned char>(label + 1) : 0;
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+int testWriteReadPerformance(const std::string& tempDir, int volumeSize, int numberOfSegments,
+  bool sharedLabelmap, bool useCompression)
+{
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkMRMLSegmentationNode> segmentationNode;
+  scene->AddNode(segmentationNode);
+  vtkSegmentation* segmentation = segmentationNode->GetSegmentation();
+  segmentation->SetMasterRepresentationName(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName());
+  vtkNew<vtkOrientedImageData> sharedLabelmapImage;
+  if (sharedLabelmap)
+    {
+    createSlabLabelmap(sharedLabelmapImage, volumeSize, numberOfSegments);
+    }
+  for (int i = 0; i < numberOfSegments; ++i)
+    {
+    vtkNew<vtkSegment> segment;
+    segment->SetLabelValue(i + 1);
+    if (sharedLabelmap)
+      {
+      segment->AddRepresentation(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName(), sharedLabelmapImage);
+      }
+    else
+      {
+      vtkNew<vtkOrientedImageData> labelmap;
+      createSlabLabelmap(labelmap, volumeSize, numberOfSegments, i);
+      segment->AddRepresentation(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName(), labelmap);
+      }
+    segmentation->AddSegment(segment);
+    }
+  int numberOfLayers = segmentation->GetNumberOfLayers();
+
+  std::stringstream nameSS;
+  nameSS << volumeSize << "^3-" << numberOfSegments << "Segments-" << numberOfLayers << "Layers-"
+         << (useCompression ? "Compressed" : "Uncompressed");
+  std::string name = nameSS.str();
+  std::string fileName = tempDir + "/vtkSegmentationStorageNodePerformanceTest1-" + name + ".seg.nrrd";
+
+  vtkNew<vtkTimerLog> timer;
+  vtkNew<vtkMRMLSegmentationStorageNode> writerStorageNode;
+  scene->AddNode(writerStorageNode);
+  writerStorageNode->SetFileName(fileName.c_str());
+  writerStorageNode->SetUseCompression(useCompression);
+  timer->StartTimer();
+  CHECK_BOOL(writerStorageNode->WriteData(segmentationNode) != 0, true);
+  timer->StopTimer();
+  std::cout << "<DartMeasurement name=\"WriteSegNrrd-" << name << "\" type=\"numeric/double\">"
+            << timer->GetElapsedTime() * 1000.0 << "</DartMeasurement>" << std::endl;
+
+  vtkNew<vtkMRMLSegmentationNode> readSegmentationNode;
+  scene->AddNode(readSegmentationNode);
+  vtkNew<vtkMRMLSegmentationStorageNode> readerStorageNode;
+  scene->AddNode(readerStorageNode);
+  readerStorageNode->SetFileName(fileName.c_str());
+  timer->StartTimer();
+  CHECK_BOOL(readerStorageNode->ReadData(readSegmentationNode) != 0, true);
+  timer->StopTimer();
+  std::cout << "<DartMeasurement name=\"ReadSegNrrd-" << name << "\" type=\"numeric/double\">"
+            << timer->GetElapsedTime() * 1000.0 << "</DartMeasurement>" << std::endl;
+
+  CHECK_INT(readSegmentationNode->GetSegmentation()->GetNumberOfSegments(), numberOfSegments);
+  CHECK_INT(readSegmentationNode->GetSegmentation()->GetNumberOfLayers(), numberOfLayers);
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkSegmentationStorageNodePerformanceTest1(int argc, char* argv[])
+{
+  if (argc < 2)
+    {
+    std::cerr << "Line " << __LINE__ << " - Missing parameters !\n"
+              << "Usage: " << argv[0] << " /path/to/temp [maximumVolumeSize]" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::string tempDir = argv[1];
+  int maximumVolumeSize = 128;
+  if (argc > 2)
+    {
+    maximumVolumeSize = atoi(argv[2]);
+    }
+
+  vtkSegmentationConverterFactory::GetInstance()->RegisterConverterRule(
+    vtkSmartPointer<vtkBinaryLabelmapToClosedSurfaceConversionRule>::New());
+  vtkSegmentationConverterFactory::GetInstance()->RegisterConverterRule(
+    vtkSmartPointer<vtkClosedSurfaceToBinaryLabelmapConversionRule>::New());
+
+  const int segmentCounts[] = { 1, 10, 50 };
+  for (int volumeSize = 64; volumeSize <= maximumVolumeSize; volumeSize *= 2)
+    {
+    for (int numberOfSegments : segmentCounts)
+      {
+      for (int useCompression = 0; useCompression < 2; ++useCompression)
+        {
+        CHECK_EXIT_SUCCESS(testWriteReadPerformance(tempDir, volumeSize, numberOfSegments, true, useCompression));
+        // Segments in separate layers (e.g., overlapping segments)
+        if (numberOfSegments > 1 && numberOfSegments <= 10)
+          {
+          CHECK_EXIT_SUCCESS(testWriteReadPerformance(tempDir, volumeSize, numberOfSegments, false, useCompression));
+          }
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
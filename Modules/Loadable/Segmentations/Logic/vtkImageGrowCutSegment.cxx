@@ -1,7 +1,9 @@
 #include "vtkImageGrowCutSegment.h"
 
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <queue>
 #include <vector>
 
 #include <vtkInformation.h>
@@ -9,10 +11,13 @@
 #include <vtkMath.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
 #include <vtkTimerLog.h>
 
+// NodeKeyValueType and NodeIndexType definitions
 #include "FibHeap.h"
 
 vtkStandardNewMacro(vtkImageGrowCutSegment);
@@ -27,6 +32,21 @@ const int MaskPixelTypeID = VTK_UNSIGNED_CHAR;
 const NodeKeyValueType DIST_INF = std::numeric_limits<NodeKeyValueType>::max();
 const NodeKeyValueType DIST_EPSILON = 1e-3;
 
+//----------------------------------------------------------------------------
+// Element of the priority queue used for propagating labels.
+// A voxel may be added multiple times to the queue (each time its distance decreases),
+// outdated elements are skipped when they are extracted from the queue.
+struct HeapElement
+{
+  NodeKeyValueType Distance;
+  NodeIndexType Index;
+  bool operator>(const HeapElement& other) const
+  {
+    return this->Distance > other.Distance;
+  }
+};
+typedef std::priority_queue<HeapElement, std::vector<HeapElement>, std::greater<HeapElement> > DistanceHeap;
+
 //----------------------------------------------------------------------------
 class vtkImageGrowCutSegment::vtkInternal
 {
@@ -63,12 +83,21 @@ public:
   NodeIndexType m_DimY;
   NodeIndexType m_DimZ;
 
+  /// Update labels of the voxels at the edge of the volume from their neighbors.
+  template<typename IntensityPixelType, typename LabelPixelType>
+  void UpdateBoundaryVoxels(vtkImageData *intensityVolume, vtkImageData *seedLabelVolume, vtkImageData *maskLabelVolume);
+
   std::vector<NodeIndexType> m_NeighborIndexOffsets;
   std::vector<double> m_NeighborDistancePenalties;
-  std::vector<unsigned char> m_NumberOfNeighbors; // size of neighborhood (everywhere the same except at the image boundary)
 
-  FibHeap *m_Heap;
-  FibHeapNode *m_HeapNodes; // a node is stored for each voxel
+  // Voxels at the edge of the volume. Labels are not propagated from these voxels (they do not have
+  // a complete neighborhood), they only get the label of their best neighbor after propagation is completed.
+  // Since these voxels are never added to the heap, the propagation loop does not need boundary checks.
+  std::vector<NodeIndexType> m_BoundaryVoxelIndices;
+
+  // Voxels that labels are propagated from. Only seeds and voxels whose distance has decreased
+  // are added, therefore an update after seed changes only processes the affected region.
+  DistanceHeap m_Heap;
   bool m_bSegInitialized;
 };
 
@@ -76,8 +105,6 @@ public:
 vtkImageGrowCutSegment::vtkInternal::vtkInternal()
 {
   m_DistancePenalty = 0.0;
-  m_Heap = nullptr;
-  m_HeapNodes = nullptr;
   m_bSegInitialized = false;
   m_DistanceVolume = vtkSmartPointer<vtkImageData>::New();
   m_ResultLabelVolume = vtkSmartPointer<vtkImageData>::New();
@@ -92,16 +119,7 @@ vtkImageGrowCutSegment::vtkInternal::~vtkInternal()
 //-----------------------------------------------------------------------------
 void vtkImageGrowCutSegment::vtkInternal::Reset()
 {
-  if (m_Heap != nullptr)
-    {
-    delete m_Heap;
-    m_Heap = nullptr;
-    }
-  if (m_HeapNodes != nullptr)
-    {
-    delete[]m_HeapNodes;
-    m_HeapNodes = nullptr;
-    }
+  m_Heap = DistanceHeap();
   m_bSegInitialized = false;
   m_DistanceVolume->Initialize();
   m_ResultLabelVolume->Initialize();
@@ -115,27 +133,6 @@ bool vtkImageGrowCutSegment::vtkInternal::InitializationAHP(
     vtkImageData *maskLabelVolume,
     double distancePenalty)
 {
-  // Release memory before reallocating
-  if (m_Heap != nullptr)
-    {
-    delete m_Heap;
-    m_Heap = nullptr;
-    }
-  if (m_HeapNodes != nullptr)
-    {
-    delete[] m_HeapNodes;
-    m_HeapNodes = nullptr;
-    }
-
-  NodeIndexType dimXYZ = m_DimX * m_DimY * m_DimZ;
-  if ((m_HeapNodes = new FibHeapNode[dimXYZ+1]) == nullptr)  // size is +1 for storing the zeroValueElement
-    {
-    vtkGenericWarningMacro("Memory allocation failed. Dimensions: " << m_DimX << "x" << m_DimY << "x" << m_DimZ);
-    return false;
-    }
-
-  m_Heap = new FibHeap;
-  m_Heap->SetHeapNodes(m_HeapNodes);
   LabelPixelType* seedLabelVolumePtr = nullptr;
   if (seedLabelVolume)
     {
@@ -147,6 +144,9 @@ bool vtkImageGrowCutSegment::vtkInternal::InitializationAHP(
     maskLabelVolumePtr = static_cast<MaskPixelType*>(maskLabelVolume->GetScalarPointer());
     }
 
+  // Seeds that labels will be propagated from, collected in parallel
+  vtkSMPThreadLocal< std::vector<HeapElement> > seedHeapElements;
+
   if (!m_bSegInitialized)
     {
     m_ResultLabelVolume->SetOrigin(seedLabelVolume->GetOrigin());
@@ -188,123 +188,114 @@ bool vtkImageGrowCutSegment::vtkInternal::InitializationAHP(
         }
       }
 
-    // Determine neighborhood size for computation at each voxel.
-    // The neighborhood size is everywhere the same (size of m_NeighborIndexOffsets)
-    // except at the edges of the volume, where the neighborhood size is 0.
-    m_NumberOfNeighbors.resize(dimXYZ);
-    const unsigned char numberOfNeighbors = static_cast<unsigned char>(m_NeighborIndexOffsets.size());
-    unsigned char* nbSizePtr = &(m_NumberOfNeighbors[0]);
+    // Collect voxels at the edges of the volume
+    m_BoundaryVoxelIndices.clear();
     for (NodeIndexType z = 0; z < m_DimZ; z++)
       {
       bool zEdge = (z == 0 || z == m_DimZ - 1);
       for (NodeIndexType y = 0; y < m_DimY; y++)
         {
         bool yEdge = (y == 0 || y == m_DimY - 1);
-        *(nbSizePtr++) = 0; // x == 0 (there is always padding, so we don't need to check if m_DimX>0)
-        unsigned char nbSize = (zEdge || yEdge) ? 0 : numberOfNeighbors;
-        for (NodeIndexType x = m_DimX-2; x > 0; x--)
+        NodeIndexType rowStartIndex = m_DimX * (y + m_DimY * z);
+        if (zEdge || yEdge)
           {
-          *(nbSizePtr++) = nbSize;
-          }
-        *(nbSizePtr++) = 0; // x == m_DimX-1 (there is always padding, so we don'neighborNewDistance need to check if m_DimX>1)
-        }
-      }
-
-    if (!maskLabelVolumePtr)
-      {
-      // no mask
-      for (NodeIndexType index = 0; index < dimXYZ; index++)
-        {
-        LabelPixelType seedValue = seedLabelVolumePtr[index];
-        resultLabelVolumePtr[index] = seedValue;
-        if (seedValue == 0)
-          {
-          m_HeapNodes[index] = DIST_INF;
-          distanceVolumePtr[index] = DIST_INF;
+          for (NodeIndexType x = 0; x < m_DimX; x++)
+            {
+            m_BoundaryVoxelIndices.push_back(rowStartIndex + x);
+            }
           }
         else
           {
-          m_HeapNodes[index] = DIST_EPSILON;
-          distanceVolumePtr[index] = DIST_EPSILON;
+          m_BoundaryVoxelIndices.push_back(rowStartIndex);
+          m_BoundaryVoxelIndices.push_back(rowStartIndex + m_DimX - 1);
           }
-        m_HeapNodes[index].SetIndexValue(index);
-        m_Heap->Insert(&m_HeapNodes[index]);
         }
       }
-    else
+
+    // Initialize labels and distances. Seeds in the interior of the volume are added to the heap.
+    vtkSMPTools::For(0, m_DimY * m_DimZ, [&](vtkIdType beginRow, vtkIdType endRow)
       {
-      // with mask
-      for (NodeIndexType index = 0; index < dimXYZ; index++)
+      std::vector<HeapElement>& localSeedHeapElements = seedHeapElements.Local();
+      for (vtkIdType row = beginRow; row < endRow; row++)
         {
-        if (maskLabelVolumePtr[index] != 0)
+        NodeIndexType y = static_cast<NodeIndexType>(row % m_DimY);
+        NodeIndexType z = static_cast<NodeIndexType>(row / m_DimY);
+        bool edgeRow = (y == 0 || y == m_DimY - 1 || z == 0 || z == m_DimZ - 1);
+        NodeIndexType rowStartIndex = static_cast<NodeIndexType>(row) * m_DimX;
+        for (NodeIndexType index = rowStartIndex; index < rowStartIndex + m_DimX; index++)
           {
-          // masked region
-          resultLabelVolumePtr[index] = 0;
-          // small distance will prevent overwriting of masked voxels
-          m_HeapNodes[index] = DIST_EPSILON;
-          distanceVolumePtr[index] = DIST_EPSILON;
-          // we don't add masked voxels to the heap
-          // to exclude them from region growing
-          }
-        else
-          {
-          // non-masked region
+          if (maskLabelVolumePtr && maskLabelVolumePtr[index] != 0)
+            {
+            // masked region
+            resultLabelVolumePtr[index] = 0;
+            // small distance will prevent overwriting of masked voxels
+            distanceVolumePtr[index] = DIST_EPSILON;
+            // we don't add masked voxels to the heap
+            // to exclude them from region growing
+            continue;
+            }
           LabelPixelType seedValue = seedLabelVolumePtr[index];
           resultLabelVolumePtr[index] = seedValue;
-          if (seedValue == 0)
+          if (edgeRow || index == rowStartIndex || index == rowStartIndex + m_DimX - 1)
+            {
+            // voxels at the edges are not updated during propagation (see UpdateBoundaryVoxels)
+            distanceVolumePtr[index] = DIST_EPSILON;
+            }
+          else if (seedValue == 0)
             {
-            m_HeapNodes[index] = DIST_INF;
             distanceVolumePtr[index] = DIST_INF;
             }
           else
             {
-            m_HeapNodes[index] = DIST_EPSILON;
             distanceVolumePtr[index] = DIST_EPSILON;
+            localSeedHeapElements.push_back({ DIST_EPSILON, index });
             }
-          m_HeapNodes[index].SetIndexValue(index);
-          m_Heap->Insert(&m_HeapNodes[index]);
           }
         }
-      }
+      });
     }
   else
     {
     // Already initialized
     LabelPixelType* resultLabelVolumePtr = static_cast<LabelPixelType*>(m_ResultLabelVolume->GetScalarPointer());
     NodeKeyValueType* distanceVolumePtr = static_cast<NodeKeyValueType*>(m_DistanceVolume->GetScalarPointer());
-    for (NodeIndexType index = 0; index < dimXYZ; index++)
+    // Only the interior of the volume is scanned, voxels at the edges are updated by UpdateBoundaryVoxels
+    vtkSMPTools::For(0, (m_DimY - 2) * (m_DimZ - 2), [&](vtkIdType beginRow, vtkIdType endRow)
       {
-      if (seedLabelVolumePtr[index] != 0)
+      std::vector<HeapElement>& localSeedHeapElements = seedHeapElements.Local();
+      for (vtkIdType row = beginRow; row < endRow; row++)
         {
-        // Only grow from new/changed seeds
-        if (resultLabelVolumePtr[index] != seedLabelVolumePtr[index] // changed seed
-          || distanceVolumePtr[index] > DIST_EPSILON // new seed
-          )
+        NodeIndexType y = static_cast<NodeIndexType>(row % (m_DimY - 2)) + 1;
+        NodeIndexType z = static_cast<NodeIndexType>(row / (m_DimY - 2)) + 1;
+        NodeIndexType rowStartIndex = m_DimX * (y + m_DimY * z);
+        for (NodeIndexType index = rowStartIndex + 1; index < rowStartIndex + m_DimX - 1; index++)
           {
-          m_HeapNodes[index] = DIST_EPSILON;
-          distanceVolumePtr[index] = DIST_EPSILON;
-          resultLabelVolumePtr[index] = seedLabelVolumePtr[index];
-          m_HeapNodes[index].SetIndexValue(index);
-          m_Heap->Insert(&m_HeapNodes[index]);
+          if (seedLabelVolumePtr[index] == 0 || (maskLabelVolumePtr && maskLabelVolumePtr[index] != 0))
+            {
+            continue;
+            }
+          // Only grow from new/changed seeds
+          if (resultLabelVolumePtr[index] != seedLabelVolumePtr[index] // changed seed
+            || distanceVolumePtr[index] > DIST_EPSILON // new seed
+            )
+            {
+            distanceVolumePtr[index] = DIST_EPSILON;
+            resultLabelVolumePtr[index] = seedLabelVolumePtr[index];
+            localSeedHeapElements.push_back({ DIST_EPSILON, index });
+            }
+          // Old seeds will be completely ignored in updates, as their labels have been already propagated
+          // and their value cannot changed (because their value is prescribed).
           }
-        // Old seeds will be completely ignored in updates, as their labels have been already propagated
-        // and their value cannot changed (because their value is prescribed).
-        }
-      else
-        {
-        m_HeapNodes[index] = DIST_INF;
-        m_HeapNodes[index].SetIndexValue(index);
-        m_Heap->Insert(&m_HeapNodes[index]);
         }
-      }
+      });
     }
 
-  // Insert 0 then extract it, which will balance heap
-  NodeIndexType zeroValueElementIndex = dimXYZ;
-  m_HeapNodes[zeroValueElementIndex] = 0;
-  m_HeapNodes[zeroValueElementIndex].SetIndexValue(zeroValueElementIndex);
-  m_Heap->Insert(&m_HeapNodes[zeroValueElementIndex]);
-  m_Heap->ExtractMin();
+  std::vector<HeapElement> heapElements;
+  for (std::vector<HeapElement>& localSeedHeapElements : seedHeapElements)
+    {
+    heapElements.insert(heapElements.end(), localSeedHeapElements.begin(), localSeedHeapElements.end());
+    }
+  m_Heap = DistanceHeap(std::greater<HeapElement>(), std::move(heapElements));
 
   return true;
 }
@@ -313,94 +304,132 @@ bool vtkImageGrowCutSegment::vtkInternal::InitializationAHP(
 template<typename IntensityPixelType, typename LabelPixelType>
 void vtkImageGrowCutSegment::vtkInternal::DijkstraBasedClassificationAHP(
     vtkImageData *intensityVolume,
-    vtkImageData *vtkNotUsed(seedLabelVolume),
-    vtkImageData *vtkNotUsed(maskLabelVolume))
+    vtkImageData *seedLabelVolume,
+    vtkImageData *maskLabelVolume)
 {
-  if (m_Heap == nullptr || m_HeapNodes == nullptr)
-    {
-    return;
-    }
-
   LabelPixelType* resultLabelVolumePtr = static_cast<LabelPixelType*>(m_ResultLabelVolume->GetScalarPointer());
+  NodeKeyValueType* distanceVolumePtr = static_cast<NodeKeyValueType*>(m_DistanceVolume->GetScalarPointer());
   IntensityPixelType* imSrc = static_cast<IntensityPixelType*>(intensityVolume->GetScalarPointer());
-
-  if (!m_bSegInitialized)
+  // Only interior voxels are added to the heap, therefore all neighbors are always within the volume
+  const size_t numberOfNeighbors = m_NeighborIndexOffsets.size();
+  const NodeIndexType* neighborIndexOffsets = m_NeighborIndexOffsets.data();
+  const double* neighborDistancePenalties = m_NeighborDistancePenalties.data();
+
+  // Dijkstra, starting from the seeds. For the initial computation the heap contains all the seeds,
+  // for updates it only contains new/changed seeds and labels are only propagated as long as a
+  // shorter path than the previously found one is found.
+  while (!m_Heap.empty())
     {
-    // Full computation
-    NodeKeyValueType* distanceVolumePtr = static_cast<NodeKeyValueType*>(m_DistanceVolume->GetScalarPointer());
-    LabelPixelType* resultLabelVolumePtr = static_cast<LabelPixelType*>(m_ResultLabelVolume->GetScalarPointer());
-
-    // Normal Dijkstra (to be used in initializing the segmenter for the current image)
-    while (!m_Heap->IsEmpty())
+    HeapElement heapElement = m_Heap.top();
+    m_Heap.pop();
+    NodeIndexType index = heapElement.Index;
+    NodeKeyValueType currentDistance = heapElement.Distance;
+    if (currentDistance > distanceVolumePtr[index])
       {
-      FibHeapNode* hnMin = m_Heap->ExtractMin();
-      NodeIndexType index = hnMin->GetIndexValue();
-      NodeKeyValueType currentDistance = hnMin->GetKeyValue();
-      LabelPixelType currentLabel = resultLabelVolumePtr[index];
+      // a shorter path has been found since this element was added
+      continue;
+      }
+    LabelPixelType currentLabel = resultLabelVolumePtr[index];
 
-      // Update neighbors
-      NodeKeyValueType pixCenter = imSrc[index];
-      unsigned char nbSize = m_NumberOfNeighbors[index];
-      for (unsigned char i = 0; i < nbSize; i++)
+    // Update neighbors
+    NodeKeyValueType pixCenter = imSrc[index];
+    for (size_t i = 0; i < numberOfNeighbors; i++)
+      {
+      NodeIndexType indexNgbh = index + neighborIndexOffsets[i];
+      NodeKeyValueType neighborCurrentDistance = distanceVolumePtr[indexNgbh];
+      NodeKeyValueType neighborNewDistance = fabs(pixCenter - imSrc[indexNgbh]) + currentDistance + neighborDistancePenalties[i];
+      if (neighborCurrentDistance > neighborNewDistance)
         {
-        NodeIndexType indexNgbh = index + m_NeighborIndexOffsets[i];
-        NodeKeyValueType neighborCurrentDistance = distanceVolumePtr[indexNgbh];
-        NodeKeyValueType neighborNewDistance = fabs(pixCenter - imSrc[indexNgbh]) + currentDistance + m_NeighborDistancePenalties[i];
-        if (neighborCurrentDistance > neighborNewDistance)
-          {
-          distanceVolumePtr[indexNgbh] = neighborNewDistance;
-          resultLabelVolumePtr[indexNgbh] = currentLabel;
-          m_Heap->DecreaseKey(&m_HeapNodes[indexNgbh], neighborNewDistance);
-          }
+        distanceVolumePtr[indexNgbh] = neighborNewDistance;
+        resultLabelVolumePtr[indexNgbh] = currentLabel;
+        m_Heap.push({ neighborNewDistance, indexNgbh });
         }
       }
     }
-  else
+
+  this->UpdateBoundaryVoxels<IntensityPixelType, LabelPixelType>(intensityVolume, seedLabelVolume, maskLabelVolume);
+
+  m_bSegInitialized = true;
+
+  // Release memory
+  m_Heap = DistanceHeap();
+}
+
+//-----------------------------------------------------------------------------
+template<typename IntensityPixelType, typename LabelPixelType>
+void vtkImageGrowCutSegment::vtkInternal::UpdateBoundaryVoxels(
+    vtkImageData *intensityVolume,
+    vtkImageData *seedLabelVolume,
+    vtkImageData *maskLabelVolume)
+{
+  LabelPixelType* resultLabelVolumePtr = static_cast<LabelPixelType*>(m_ResultLabelVolume->GetScalarPointer());
+  NodeKeyValueType* distanceVolumePtr = static_cast<NodeKeyValueType*>(m_DistanceVolume->GetScalarPointer());
+  IntensityPixelType* imSrc = static_cast<IntensityPixelType*>(intensityVolume->GetScalarPointer());
+  LabelPixelType* seedLabelVolumePtr = static_cast<LabelPixelType*>(seedLabelVolume->GetScalarPointer());
+  MaskPixelType* maskLabelVolumePtr = nullptr;
+  if (maskLabelVolume != nullptr)
     {
-    // Quick update
+    maskLabelVolumePtr = static_cast<MaskPixelType*>(maskLabelVolume->GetScalarPointer());
+    }
 
-    // Adaptive Dijkstra
-    NodeKeyValueType* distanceVolumePtr = static_cast<NodeKeyValueType*>(m_DistanceVolume->GetScalarPointer());
-    while (!m_Heap->IsEmpty())
+  vtkSMPTools::For(0, static_cast<vtkIdType>(m_BoundaryVoxelIndices.size()), [&](vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType boundaryIndex = begin; boundaryIndex < end; boundaryIndex++)
       {
-      FibHeapNode* hnMin = m_Heap->ExtractMin();
-      NodeKeyValueType currentDistance = hnMin->GetKeyValue();
-
-      // Stop if minimum value is infinite (it means there are no more voxels to propagate labels from)
-      if (currentDistance == DIST_INF)
+      NodeIndexType index = m_BoundaryVoxelIndices[boundaryIndex];
+      if (maskLabelVolumePtr && maskLabelVolumePtr[index] != 0)
         {
-        break;
+        continue;
         }
-
-      NodeIndexType index = hnMin->GetIndexValue();
-      LabelPixelType currentLabel = resultLabelVolumePtr[index];
-
-      // Update neighbors
+      if (seedLabelVolumePtr[index] != 0)
+        {
+        resultLabelVolumePtr[index] = seedLabelVolumePtr[index];
+        continue;
+        }
+      long x = index % m_DimX;
+      long y = (index / m_DimX) % m_DimY;
+      long z = index / (m_DimX * m_DimY);
       NodeKeyValueType pixCenter = imSrc[index];
-      unsigned char nbSize = m_NumberOfNeighbors[index];
-      for (unsigned char i = 0; i < nbSize; i++)
+      NodeKeyValueType bestDistance = DIST_INF;
+      LabelPixelType bestLabel = 0;
+      // Same traversal order as m_NeighborIndexOffsets, so that the same penalties can be used
+      size_t i = 0;
+      for (long ix = -1; ix <= 1; ix++)
         {
-        NodeIndexType indexNgbh = index + m_NeighborIndexOffsets[i];
-        NodeKeyValueType neighborCurrentDistance = distanceVolumePtr[indexNgbh];
-        NodeKeyValueType neighborNewDistance = fabs(pixCenter - imSrc[indexNgbh]) + currentDistance + m_NeighborDistancePenalties[i];
-        if (neighborCurrentDistance > neighborNewDistance)
+        for (long iy = -1; iy <= 1; iy++)
           {
-          distanceVolumePtr[indexNgbh] = neighborNewDistance;
-          resultLabelVolumePtr[indexNgbh] = currentLabel;
-
-          m_Heap->DecreaseKey(&m_HeapNodes[indexNgbh], neighborNewDistance);
+          for (long iz = -1; iz <= 1; iz++)
+            {
+            if (ix == 0 && iy == 0 && iz == 0)
+              {
+              continue;
+              }
+            size_t neighborIndex = i++;
+            // Only interior voxels have propagated distances
+            if (x + ix < 1 || x + ix > long(m_DimX) - 2
+              || y + iy < 1 || y + iy > long(m_DimY) - 2
+              || z + iz < 1 || z + iz > long(m_DimZ) - 2)
+              {
+              continue;
+              }
+            NodeIndexType indexNgbh = index + m_NeighborIndexOffsets[neighborIndex];
+            if (resultLabelVolumePtr[indexNgbh] == 0 || distanceVolumePtr[indexNgbh] >= DIST_INF)
+              {
+              continue;
+              }
+            NodeKeyValueType distance = distanceVolumePtr[indexNgbh] + fabs(pixCenter - imSrc[indexNgbh])
+              + m_NeighborDistancePenalties[neighborIndex];
+            if (distance < bestDistance)
+              {
+              bestDistance = distance;
+              bestLabel = resultLabelVolumePtr[indexNgbh];
+              }
+            }
           }
         }
+      resultLabelVolumePtr[index] = bestLabel;
       }
-    }
-
-  m_bSegInitialized = true;
-
-  // Release memory
-  delete m_Heap;
-  m_Heap = nullptr;
-  delete[] m_HeapNodes;
-  m_HeapNodes = nullptr;
+    });
 }
 
 //-----------------------------------------------------------------------------
@@ -39,14 +39,18 @@
 #include <vtkActor.h>
 #include <vtkAppendPolyData.h>
 #include <vtkCallbackCommand.h>
+#include <vtkCollection.h>
 #include <vtkDataObject.h>
+#include <vtkDoubleArray.h>
 #include <vtkGeneralTransform.h>
 #include <vtkGeometryFilter.h>
+#include <vtkIdTypeArray.h>
 #include <vtkImageAccumulate.h>
 #include <vtkImageConstantPad.h>
 #include <vtkImageMathematics.h>
 #include <vtkImageThreshold.h>
 #include <vtkLookupTable.h>
+#include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
@@ -57,8 +61,11 @@
 #include <vtkProperty.h>
 #include <vtkRenderer.h>
 #include <vtkRenderWindow.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 #include <vtkSTLWriter.h>
 #include <vtkStringArray.h>
+#include <vtkTable.h>
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
 #include <vtkTriangleFilter.h>
@@ -86,7 +93,403 @@
 #include <vtkEventBroker.h>
 
 // STD includes
+#include <algorithm>
+#include <cmath>
 #include <sstream>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Statistics accumulated for one segment
+struct SegmentStatisticsAccumulator
+{
+  vtkIdType VoxelCount{0};
+  double Sum{0.0};
+  double SumOfSquares{0.0};
+  double Minimum{VTK_DOUBLE_MAX};
+  double Maximum{VTK_DOUBLE_MIN};
+  /// Allocated when the first voxel of the segment is found
+  std::vector<vtkIdType> Histogram;
+};
+
+//----------------------------------------------------------------------------
+/// Binary labelmap layer resampled to the scalar volume geometry
+struct SegmentStatisticsLayer
+{
+  vtkSmartPointer<vtkOrientedImageData> Labelmap;
+  int ScalarType{VTK_VOID};
+  int ScalarSize{0};
+  /// Index of the output segment for each label value, -1 if the label is not used
+  std::vector<int> SegmentIndexForLabelValue;
+};
+
+//----------------------------------------------------------------------------
+inline int GetLabelValue(const void* row, int scalarType, vtkIdType index)
+{
+  switch (scalarType)
+    {
+    vtkTemplateMacro(return static_cast<int>(static_cast<const VTK_TT*>(row)[index]));
+    default:
+      return 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Accumulates the statistics of all segments of all layers in one pass over the scalar volume
+template <class T>
+class SegmentStatisticsFunctor
+{
+public:
+  SegmentStatisticsFunctor(vtkImageData* scalarImage, std::vector<SegmentStatisticsLayer>& layers, int numberOfSegments,
+    double histogramMinimum, double histogramBinWidth, int numberOfHistogramBins)
+    : ScalarImage(scalarImage)
+    , Layers(layers)
+    , NumberOfSegments(numberOfSegments)
+    , HistogramMinimum(histogramMinimum)
+    , HistogramBinWidth(histogramBinWidth)
+    , NumberOfHistogramBins(numberOfHistogramBins)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Accumulators.Local().resize(this->NumberOfSegments);
+  }
+
+  void operator()(vtkIdType firstSlice, vtkIdType lastSlice)
+  {
+    std::vector<SegmentStatisticsAccumulator>& accumulators = this->Accumulators.Local();
+    int* extent = this->ScalarImage->GetExtent();
+    int numberOfComponents = this->ScalarImage->GetNumberOfScalarComponents();
+    size_t numberOfLayers = this->Layers.size();
+    std::vector<const char*> layerRows(numberOfLayers, nullptr);
+    std::vector<int> layerRowFirstI(numberOfLayers, 0);
+    std::vector<int> layerRowLastI(numberOfLayers, -1);
+    for (int k = static_cast<int>(firstSlice); k < lastSlice; ++k)
+      {
+      for (int j = extent[2]; j <= extent[3]; ++j)
+        {
+        // Find the labelmap row of each layer that corresponds to the current volume row
+        bool anyLayerRow = false;
+        for (size_t layerIndex = 0; layerIndex < numberOfLayers; ++layerIndex)
+          {
+          vtkOrientedImageData* labelmap = this->Layers[layerIndex].Labelmap;
+          int* labelmapExtent = labelmap->GetExtent();
+          layerRows[layerIndex] = nullptr;
+          if (j < labelmapExtent[2] || j > labelmapExtent[3] || k < labelmapExtent[4] || k > labelmapExtent[5])
+            {
+            continue;
+            }
+          layerRowFirstI[layerIndex] = std::max(extent[0], labelmapExtent[0]);
+          layerRowLastI[layerIndex] = std::min(extent[1], labelmapExtent[1]);
+          if (layerRowFirstI[layerIndex] > layerRowLastI[layerIndex])
+            {
+            continue;
+            }
+          // Row pointer is shifted so that it can be indexed by the volume i index
+          layerRows[layerIndex] = static_cast<const char*>(labelmap->GetScalarPointer(labelmapExtent[0], j, k))
+            - static_cast<vtkIdType>(labelmapExtent[0]) * this->Layers[layerIndex].ScalarSize;
+          anyLayerRow = true;
+          }
+        if (!anyLayerRow)
+          {
+          continue;
+          }
+
+        const T* scalarRow = static_cast<const T*>(this->ScalarImage->GetScalarPointer(extent[0], j, k));
+        for (int i = extent[0]; i <= extent[1]; ++i)
+          {
+          double value = static_cast<double>(scalarRow[static_cast<vtkIdType>(i - extent[0]) * numberOfComponents]);
+          for (size_t layerIndex = 0; layerIndex < numberOfLayers; ++layerIndex)
+            {
+            if (!layerRows[layerIndex] || i < layerRowFirstI[layerIndex] || i > layerRowLastI[layerIndex])
+              {
+              continue;
+              }
+            const SegmentStatisticsLayer& layer = this->Layers[layerIndex];
+            const char* row = layerRows[layerIndex] + static_cast<vtkIdType>(i) * layer.ScalarSize;
+            int labelValue = GetLabelValue(row, layer.ScalarType, 0);
+            if (labelValue <= 0 || labelValue >= static_cast<int>(layer.SegmentIndexForLabelValue.size()))
+              {
+              continue;
+              }
+            int segmentIndex = layer.SegmentIndexForLabelValue[labelValue];
+            if (segmentIndex < 0)
+              {
+              continue;
+              }
+            this->AddValue(accumulators[segmentIndex], value);
+            }
+          }
+        }
+      }
+  }
+
+  void Reduce()
+  {
+    this->Result.resize(this->NumberOfSegments);
+    for (std::vector<SegmentStatisticsAccumulator>& accumulators : this->Accumulators)
+      {
+      for (int segmentIndex = 0; segmentIndex < this->NumberOfSegments; ++segmentIndex)
+        {
+        const SegmentStatisticsAccumulator& local = accumulators[segmentIndex];
+        if (local.VoxelCount == 0)
+          {
+          continue;
+          }
+        SegmentStatisticsAccumulator& result = this->Result[segmentIndex];
+        result.VoxelCount += local.VoxelCount;
+        result.Sum += local.Sum;
+        result.SumOfSquares += local.SumOfSquares;
+        result.Minimum = std::min(result.Minimum, local.Minimum);
+        result.Maximum = std::max(result.Maximum, local.Maximum);
+        if (result.Histogram.empty())
+          {
+          result.Histogram = local.Histogram;
+          }
+        else
+          {
+          for (int bin = 0; bin < this->NumberOfHistogramBins; ++bin)
+            {
+            result.Histogram[bin] += local.Histogram[bin];
+            }
+          }
+        }
+      }
+  }
+
+  std::vector<SegmentStatisticsAccumulator> Result;
+
+private:
+  void AddValue(SegmentStatisticsAccumulator& accumulator, double value)
+  {
+    if (accumulator.Histogram.empty())
+      {
+      accumulator.Histogram.resize(this->NumberOfHistogramBins, 0);
+      }
+    accumulator.VoxelCount++;
+    accumulator.Sum += value;
+    accumulator.SumOfSquares += value * value;
+    accumulator.Minimum = std::min(accumulator.Minimum, value);
+    accumulator.Maximum = std::max(accumulator.Maximum, value);
+    int bin = static_cast<int>((value - this->HistogramMinimum) / this->HistogramBinWidth);
+    bin = std::max(0, std::min(bin, this->NumberOfHistogramBins - 1));
+    accumulator.Histogram[bin]++;
+  }
+
+  vtkImageData* ScalarImage;
+  std::vector<SegmentStatisticsLayer>& Layers;
+  int NumberOfSegments;
+  double HistogramMinimum;
+  double HistogramBinWidth;
+  int NumberOfHistogramBins;
+  vtkSMPThreadLocal<std::vector<SegmentStatisticsAccumulator> > Accumulators;
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void AccumulateSegmentStatistics(vtkImageData* scalarImage, std::vector<SegmentStatisticsLayer>& layers, int numberOfSegments,
+  double histogramMinimum, double histogramBinWidth, int numberOfHistogramBins, std::vector<SegmentStatisticsAccumulator>& results)
+{
+  SegmentStatisticsFunctor<T> functor(scalarImage, layers, numberOfSegments,
+    histogramMinimum, histogramBinWidth, numberOfHistogramBins);
+  int* extent = scalarImage->GetExtent();
+  vtkSMPTools::For(extent[4], extent[5] + 1, functor);
+  results.swap(functor.Result);
+}
+
+//----------------------------------------------------------------------------
+/// Get the value of the order statistic of the given rank (0 = minimum) from a histogram
+double GetHistogramOrderStatistic(const SegmentStatisticsAccumulator& accumulator, vtkIdType rank,
+  double histogramMinimum, double histogramBinWidth, bool integerBins)
+{
+  vtkIdType cumulativeCount = 0;
+  for (size_t bin = 0; bin < accumulator.Histogram.size(); ++bin)
+    {
+    cumulativeCount += accumulator.Histogram[bin];
+    if (cumulativeCount > rank)
+      {
+      double value = histogramMinimum + bin * histogramBinWidth;
+      if (!integerBins)
+        {
+        value += 0.5 * histogramBinWidth;
+        }
+      return std::max(accumulator.Minimum, std::min(value, accumulator.Maximum));
+      }
+    }
+  return accumulator.Maximum;
+}
+
+//----------------------------------------------------------------------------
+double GetHistogramPercentile(const SegmentStatisticsAccumulator& accumulator, double percentile,
+  double histogramMinimum, double histogramBinWidth, bool integerBins)
+{
+  double rank = std::max(0.0, std::min(percentile, 100.0)) / 100.0 * (accumulator.VoxelCount - 1);
+  vtkIdType lowerRank = static_cast<vtkIdType>(std::floor(rank));
+  vtkIdType upperRank = static_cast<vtkIdType>(std::ceil(rank));
+  double lowerValue = GetHistogramOrderStatistic(accumulator, lowerRank, histogramMinimum, histogramBinWidth, integerBins);
+  if (upperRank == lowerRank)
+    {
+    return lowerValue;
+    }
+  double upperValue = GetHistogramOrderStatistic(accumulator, upperRank, histogramMinimum, histogramBinWidth, integerBins);
+  return lowerValue + (upperValue - lowerValue) * (rank - lowerRank);
+}
+
+//----------------------------------------------------------------------------
+/// Collect all non-zero label values and the extent that contains them in one pass over the labelmap
+template <class T>
+void ScanLabelmapGeneric(vtkImageData* labelmap, std::vector<int>& labelValues, int effectiveExtent[6])
+{
+  int* extent = labelmap->GetExtent();
+  effectiveExtent[0] = extent[1] + 1;
+  effectiveExtent[1] = extent[0] - 1;
+  effectiveExtent[2] = extent[3] + 1;
+  effectiveExtent[3] = extent[2] - 1;
+  effectiveExtent[4] = extent[5] + 1;
+  effectiveExtent[5] = extent[4] - 1;
+
+  T* imagePtr = static_cast<T*>(labelmap->GetScalarPointer());
+  if (!imagePtr)
+    {
+    return;
+    }
+  vtkIdType increments[3] = { 0, 0, 0 };
+  labelmap->GetIncrements(increments);
+  int rowLength = extent[1] - extent[0] + 1;
+
+  std::unordered_set<int> foundLabelValues;
+  // Labelmaps mostly consist of runs of the same value, so the set is only looked up when the value changes
+  T previousValue = 0;
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      T* rowPtr = imagePtr + (k - extent[4]) * increments[2] + (j - extent[2]) * increments[1];
+      int firstIndex = -1;
+      int lastIndex = -1;
+      for (int i = 0; i < rowLength; ++i, rowPtr += increments[0])
+        {
+        T value = *rowPtr;
+        if (value == 0)
+          {
+          continue;
+          }
+        if (firstIndex < 0)
+          {
+          firstIndex = i;
+          }
+        lastIndex = i;
+        if (value != previousValue)
+          {
+          previousValue = value;
+          foundLabelValues.insert(static_cast<int>(std::floor(static_cast<double>(value))));
+          }
+        }
+      if (firstIndex < 0)
+        {
+        continue;
+        }
+      effectiveExtent[0] = std::min(effectiveExtent[0], extent[0] + firstIndex);
+      effectiveExtent[1] = std::max(effectiveExtent[1], extent[0] + lastIndex);
+      effectiveExtent[2] = std::min(effectiveExtent[2], j);
+      effectiveExtent[3] = std::max(effectiveExtent[3], j);
+      effectiveExtent[4] = std::min(effectiveExtent[4], k);
+      effectiveExtent[5] = std::max(effectiveExtent[5], k);
+      }
+    }
+
+  // Values that are truncated to zero (e.g. 0.5 in a floating-point labelmap) are not labels
+  foundLabelValues.erase(0);
+  labelValues.assign(foundLabelValues.begin(), foundLabelValues.end());
+  std::sort(labelValues.begin(), labelValues.end());
+}
+
+//----------------------------------------------------------------------------
+/// Get closed surface representation of segments for writing them to file: in world coordinate system,
+/// scaled by sizeScale and converted to LPS if requested. Segments that do not have closed surface
+/// representation yet are converted together (in parallel if the conversion rule allows it), without
+/// modifying the segmentation. Surfaces are then copied and transformed in parallel.
+/// Surface is set to nullptr for segments that could not be converted.
+void GetClosedSurfacesForExport(vtkMRMLSegmentationNode* segmentationNode, const std::vector<std::string>& segmentIDs,
+  bool lps, double sizeScale, std::vector<vtkSmartPointer<vtkPolyData> >& surfaces)
+{
+  surfaces.assign(segmentIDs.size(), nullptr);
+  std::string closedSurfaceName = vtkSegmentationConverter::GetSegmentationClosedSurfaceRepresentationName();
+  vtkSegmentation* segmentation = segmentationNode->GetSegmentation();
+
+  vtkSmartPointer<vtkSegmentation> sourceSegmentation = segmentation;
+  if (!segmentation->ContainsRepresentation(closedSurfaceName))
+    {
+    // Temporarily duplicate selected segments to only convert them, not the whole segmentation
+    sourceSegmentation = vtkSmartPointer<vtkSegmentation>::New();
+    sourceSegmentation->SetMasterRepresentationName(segmentation->GetMasterRepresentationName());
+    sourceSegmentation->CopyConversionParameters(segmentation);
+    for (const std::string& segmentID : segmentIDs)
+      {
+      if (!sourceSegmentation->GetSegment(segmentID))
+        {
+        sourceSegmentation->CopySegmentFromSegmentation(segmentation, segmentID);
+        }
+      }
+    if (!sourceSegmentation->CreateRepresentation(closedSurfaceName, true))
+      {
+      return;
+      }
+    }
+
+  std::vector<vtkPolyData*> sourceSurfaces(segmentIDs.size(), nullptr);
+  for (size_t index = 0; index < segmentIDs.size(); ++index)
+    {
+    vtkSegment* segment = sourceSegmentation->GetSegment(segmentIDs[index]);
+    if (segment)
+      {
+      sourceSurfaces[index] = vtkPolyData::SafeDownCast(segment->GetRepresentation(closedSurfaceName));
+      }
+    }
+
+  vtkNew<vtkGeneralTransform> exportTransform;
+  exportTransform->PostMultiply();
+  if (segmentationNode->GetParentTransformNode())
+    {
+    vtkNew<vtkGeneralTransform> nodeToWorldTransform;
+    segmentationNode->GetParentTransformNode()->GetTransformToWorld(nodeToWorldTransform);
+    exportTransform->Concatenate(nodeToWorldTransform);
+    }
+  if (sizeScale != 1.0)
+    {
+    exportTransform->Scale(sizeScale, sizeScale, sizeScale);
+    }
+  if (lps)
+    {
+    exportTransform->Scale(-1, -1, 1);
+    }
+  // Update the transform on this thread so that it is only read by the worker threads
+  exportTransform->Update();
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(segmentIDs.size()), [&](vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType index = begin; index < end; ++index)
+      {
+      if (!sourceSurfaces[index])
+        {
+        continue;
+        }
+      vtkNew<vtkTransformPolyDataFilter> transformFilter;
+      transformFilter->SetTransform(exportTransform);
+      transformFilter->SetInputData(sourceSurfaces[index]);
+      transformFilter->Update();
+      vtkSmartPointer<vtkPolyData> surface = vtkSmartPointer<vtkPolyData>::New();
+      surface->ShallowCopy(transformFilter->GetOutput());
+      surfaces[index] = surface;
+      }
+    });
+}
+
+} // end of anonymous namespace
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSlicerSegmentationsModuleLogic);
@@ -449,6 +852,19 @@ int vtkSlicerSegmentationsModuleLogic::DoesLabelmapContainSingleLabel(vtkMRMLLab
 //-----------------------------------------------------------------------------
 void vtkSlicerSegmentationsModuleLogic::GetAllLabelValues(vtkIntArray* labels, vtkImageData* labelmap)
 {
+  int effectiveExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  vtkSlicerSegmentationsModuleLogic::GetAllLabelValues(labels, labelmap, effectiveExtent);
+}
+
+//-----------------------------------------------------------------------------
+void vtkSlicerSegmentationsModuleLogic::GetAllLabelValues(vtkIntArray* labels, vtkImageData* labelmap, int effectiveExtent[6])
+{
+  effectiveExtent[0] = 0;
+  effectiveExtent[1] = -1;
+  effectiveExtent[2] = 0;
+  effectiveExtent[3] = -1;
+  effectiveExtent[4] = 0;
+  effectiveExtent[5] = -1;
   if (!labels)
     {
     vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::GetAllLabelValues: Invalid labels");
@@ -466,32 +882,19 @@ void vtkSlicerSegmentationsModuleLogic::GetAllLabelValues(vtkIntArray* labels, v
   if (dimensions[0] <= 0 || dimensions[1] <= 0 || dimensions[2] <= 0)
     {
     // Labelmap is empty, there are no label values.
-    // Running vtkImageAccumulate would cause a crash.
     return;
     }
 
-  double* scalarRange = labelmap->GetScalarRange();
-  int lowLabel = (int)(floor(scalarRange[0]));
-  int highLabel = (int)(ceil(scalarRange[1]));
-  vtkSmartPointer<vtkImageAccumulate> imageAccumulate = vtkSmartPointer<vtkImageAccumulate>::New();
-  imageAccumulate->SetInputData(labelmap);
-  imageAccumulate->IgnoreZeroOn(); // Do not create segment from background
-  imageAccumulate->SetComponentExtent(lowLabel, highLabel, 0, 0, 0, 0);
-  imageAccumulate->SetComponentOrigin(0, 0, 0);
-  imageAccumulate->SetComponentSpacing(1, 1, 1);
-  imageAccumulate->Update();
-
-  for (int label = lowLabel; label <= highLabel; ++label)
+  std::vector<int> labelValues;
+  switch (labelmap->GetScalarType())
+    {
+    vtkTemplateMacro(ScanLabelmapGeneric<VTK_TT>(labelmap, labelValues, effectiveExtent));
+    default:
+      vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::GetAllLabelValues: Unknown scalar type");
+      return;
+    }
+  for (int label : labelValues)
     {
-    if (label == 0)
-      {
-      continue;
-      }
-    double frequency = imageAccumulate->GetOutput()->GetPointData()->GetScalars()->GetTuple1(label - lowLabel);
-    if (frequency == 0.0)
-      {
-      continue;
-      }
     labels->InsertNextValue(label);
     }
 }
@@ -904,34 +1307,98 @@ bool vtkSlicerSegmentationsModuleLogic::ExportSegmentsToModels(vtkMRMLSegmentati
     exportedSegmentIDs = segmentIDs;
     }
 
-  // Export each segment into a model
-  for (std::vector<std::string>::iterator segmentIdIt = exportedSegmentIDs.begin(); segmentIdIt != exportedSegmentIDs.end(); ++segmentIdIt)
+  std::vector<vtkSegment*> exportedSegments;
+  for (const std::string& segmentId : exportedSegmentIDs)
     {
-    // Export segment into model node
-    vtkSegment* segment = segmentationNode->GetSegmentation()->GetSegment(*segmentIdIt);
-    vtkMRMLModelNode* modelNode = nullptr;
-    if (existingModelNamesToModels.find(segment->GetName()) != existingModelNamesToModels.end())
+    vtkSegment* segment = segmentationNode->GetSegmentation()->GetSegment(segmentId);
+    if (!segment)
       {
-      // Model by the same name exists in the selected hierarchy, overwrite that model
-      modelNode = existingModelNamesToModels[segment->GetName()];
+      vtkErrorWithObjectMacro(segmentationNode, "ExportSegmentsToModels: Failed to find segment " << segmentId);
+      return false;
       }
-    else
+    exportedSegments.push_back(segment);
+    }
+
+  // Make copy of the surfaces so that the model nodes do not change if segments change.
+  // Surfaces are independent, therefore they are copied in parallel.
+  std::vector<vtkSmartPointer<vtkPolyData> > surfaces(exportedSegments.size());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(exportedSegments.size()), [&](vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType index = begin; index < end; ++index)
+      {
+      vtkPolyData* surface = vtkPolyData::SafeDownCast(exportedSegments[index]->GetRepresentation(
+        vtkSegmentationConverter::GetSegmentationClosedSurfaceRepresentationName()));
+      surfaces[index] = vtkSmartPointer<vtkPolyData>::New();
+      if (surface)
+        {
+        surfaces[index]->DeepCopy(surface);
+        }
+      }
+    });
+
+  // Export each segment into a model. New model nodes are completely set up before they are added
+  // to the scene, and they are added all at once.
+  vtkMRMLSegmentationDisplayNode* segmentationDisplayNode = vtkMRMLSegmentationDisplayNode::SafeDownCast(segmentationNode->GetDisplayNode());
+  vtkMRMLTransformNode* parentTransformNode = segmentationNode->GetParentTransformNode();
+  vtkNew<vtkCollection> newModelNodes;
+  vtkNew<vtkCollection> newDisplayNodes;
+  for (size_t index = 0; index < exportedSegments.size(); ++index)
+    {
+    vtkSegment* segment = exportedSegments[index];
+    std::map< std::string, vtkMRMLModelNode* >::iterator existingModelIt = existingModelNamesToModels.find(segment->GetName());
+    if (existingModelIt != existingModelNamesToModels.end())
       {
-      // Create new model node
-      vtkNew<vtkMRMLModelNode> newModelNode;
-      scene->AddNode(newModelNode.GetPointer());
-      newModelNode->CreateDefaultDisplayNodes();
-      modelNode = newModelNode.GetPointer();
-      // Add to folder
-      shNode->SetItemParent( shNode->GetItemByDataNode(newModelNode), folderItemId );
+      // Model by the same name exists in the selected hierarchy, overwrite that model
+      if (!vtkSlicerSegmentationsModuleLogic::ExportSegmentToRepresentationNode(segment, existingModelIt->second))
+        {
+        vtkErrorWithObjectMacro(segmentationNode, "ExportSegmentsToModels: Failed to export segmentation into model hierarchy");
+        return false;
+        }
+      continue;
       }
 
-    // Export segment into model node
-    if (!vtkSlicerSegmentationsModuleLogic::ExportSegmentToRepresentationNode(segment, modelNode))
+    vtkNew<vtkMRMLModelNode> modelNode;
+    modelNode->SetName(segment->GetName());
+    modelNode->SetAndObservePolyData(surfaces[index]);
+    if (parentTransformNode)
       {
-      vtkErrorWithObjectMacro(segmentationNode, "ExportSegmentsToModels: Failed to export segmentation into model hierarchy");
+      modelNode->SetAndObserveTransformNodeID(parentTransformNode->GetID());
+      }
+    vtkSmartPointer<vtkMRMLModelDisplayNode> displayNode = vtkSmartPointer<vtkMRMLModelDisplayNode>::Take(
+      vtkMRMLModelDisplayNode::SafeDownCast(scene->CreateNodeByClass("vtkMRMLModelDisplayNode")));
+    if (!displayNode)
+      {
+      vtkErrorWithObjectMacro(segmentationNode, "ExportSegmentsToModels: Failed to create model display node");
       return false;
       }
+    displayNode->VisibilityOn();
+    if (segmentationDisplayNode)
+      {
+      displayNode->SetColor(segment->GetColor());
+      displayNode->SetOpacity(segmentationDisplayNode->GetSegmentOpacity3D(exportedSegmentIDs[index]));
+      }
+    newModelNodes->AddItem(modelNode);
+    newDisplayNodes->AddItem(displayNode);
+    }
+
+  if (newModelNodes->GetNumberOfItems() > 0)
+    {
+    // Display nodes are added first, so that their IDs are known when the model nodes are added
+    scene->AddNodes(newDisplayNodes);
+    for (int index = 0; index < newModelNodes->GetNumberOfItems(); ++index)
+      {
+      vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(newModelNodes->GetItemAsObject(index));
+      vtkMRMLNode* displayNode = vtkMRMLNode::SafeDownCast(newDisplayNodes->GetItemAsObject(index));
+      modelNode->SetAndObserveDisplayNodeID(displayNode->GetID());
+      }
+    scene->AddNodes(newModelNodes);
+
+    // Add to folder
+    for (int index = 0; index < newModelNodes->GetNumberOfItems(); ++index)
+      {
+      vtkMRMLNode* modelNode = vtkMRMLNode::SafeDownCast(newModelNodes->GetItemAsObject(index));
+      shNode->SetItemParent(shNode->GetItemByDataNode(modelNode), folderItemId);
+      }
     }
 
   // Move exported representation under same parent as segmentation
@@ -1032,7 +1499,8 @@ void vtkSlicerSegmentationsModuleLogic::GenerateMergedLabelmapInReferenceGeometr
     }
   else
     {
-    mergedLabelmap_Reference->DeepCopy(sharedImage_Segmentation);
+    // The shared labelmap is only used here, so it does not need to be copied
+    mergedLabelmap_Reference->ShallowCopy(sharedImage_Segmentation);
     }
 }
 
@@ -1379,11 +1847,20 @@ bool vtkSlicerSegmentationsModuleLogic::ImportLabelmapToSegmentationNode(vtkMRML
 
   // Split labelmap node into per-label image data
 
+  // Label values and their extent are found in one pass over the labelmap
   vtkNew<vtkIntArray> labelValues;
-  vtkSlicerSegmentationsModuleLogic::GetAllLabelValues(labelValues.GetPointer(), labelmapNode->GetImageData());
+  int labelmapEffectiveExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  vtkSlicerSegmentationsModuleLogic::GetAllLabelValues(labelValues.GetPointer(), labelmapNode->GetImageData(), labelmapEffectiveExtent);
+
+  // All segments share the same labelmap, which is cropped to the effective extent.
+  // Cropping makes a copy, therefore editing the segments does not modify the labelmap volume.
+  vtkSmartPointer<vtkImageConstantPad> padder = vtkSmartPointer<vtkImageConstantPad>::New();
+  padder->SetInputData(labelmapNode->GetImageData());
+  padder->SetOutputWholeExtent(labelmapEffectiveExtent);
+  padder->Update();
 
   vtkSmartPointer<vtkOrientedImageData> labelOrientedImageData = vtkSmartPointer<vtkOrientedImageData>::New();
-  labelOrientedImageData->vtkImageData::DeepCopy(labelmapNode->GetImageData());
+  labelOrientedImageData->vtkImageData::ShallowCopy(padder->GetOutput());
   labelOrientedImageData->SetGeometryFromImageToWorldMatrix(labelmapIjkToRasMatrix);
 
   // Apply parent transforms if any
@@ -1405,6 +1882,7 @@ bool vtkSlicerSegmentationsModuleLogic::ImportLabelmapToSegmentationNode(vtkMRML
     double color[4] = { vtkSegment::SEGMENT_COLOR_INVALID[0],
                         vtkSegment::SEGMENT_COLOR_INVALID[1],
                         vtkSegment::SEGMENT_COLOR_INVALID[2], 1.0 };
+    std::string defaultLabelName;
     const char* labelName = nullptr;
     if (colorTableNode)
       {
@@ -1425,19 +1903,11 @@ bool vtkSlicerSegmentationsModuleLogic::ImportLabelmapToSegmentationNode(vtkMRML
       {
       std::stringstream ss;
       ss << "Label_" << label;
-      labelName = ss.str().c_str();
+      defaultLabelName = ss.str();
+      labelName = defaultLabelName.c_str();
       }
     segment->SetName(labelName);
 
-    // Clip to effective extent
-    int labelOrientedImageDataEffectiveExtent[6] = { 0, -1, 0, -1, 0, -1 };
-    vtkOrientedImageDataResample::CalculateEffectiveExtent(labelOrientedImageData, labelOrientedImageDataEffectiveExtent);
-    vtkSmartPointer<vtkImageConstantPad> padder = vtkSmartPointer<vtkImageConstantPad>::New();
-    padder->SetInputData(labelOrientedImageData);
-    padder->SetOutputWholeExtent(labelOrientedImageDataEffectiveExtent);
-    padder->Update();
-    labelOrientedImageData->ShallowCopy(padder->GetOutput());
-
     // Add oriented image data as binary labelmap representation
     segment->AddRepresentation(
       vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName(),
@@ -1477,14 +1947,14 @@ bool vtkSlicerSegmentationsModuleLogic::ImportLabelmapToSegmentationNode(vtkOrie
 
   // Split labelmap node into per-label image data
 
+  // Label values and their extent are found in one pass over the labelmap
   vtkNew<vtkIntArray> labelValues;
-  vtkSlicerSegmentationsModuleLogic::GetAllLabelValues(labelValues.GetPointer(), labelmapImage);
+  int labelOrientedImageDataEffectiveExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  vtkSlicerSegmentationsModuleLogic::GetAllLabelValues(labelValues.GetPointer(), labelmapImage, labelOrientedImageDataEffectiveExtent);
 
   MRMLNodeModifyBlocker blocker(segmentationNode);
 
   // Clip to effective extent
-  int labelOrientedImageDataEffectiveExtent[6] = { 0, -1, 0, -1, 0, -1 };
-  vtkOrientedImageDataResample::CalculateEffectiveExtent(labelmapImage, labelOrientedImageDataEffectiveExtent);
 
   vtkSmartPointer<vtkImageConstantPad> padder = vtkSmartPointer<vtkImageConstantPad>::New();
   padder->SetInputData(labelmapImage);
@@ -2094,10 +2564,6 @@ bool vtkSlicerSegmentationsModuleLogic::ExportSegmentsClosedSurfaceRepresentatio
   const std::string coordinateSystemValue = (lps ? "LPS" : "RAS");
   const std::string coordinateSytemSpecification = "SPACE=" + coordinateSystemValue;
 
-  vtkNew<vtkTriangleFilter> triangulator;
-  vtkNew<vtkSTLWriter> writer;
-  writer->SetFileType(VTK_BINARY);
-  writer->SetInputConnection(triangulator->GetOutputPort());
   std::string header = std::string("3D Slicer output. ") + coordinateSytemSpecification;
   if (sizeScale != 1.0)
     {
@@ -2105,40 +2571,36 @@ bool vtkSlicerSegmentationsModuleLogic::ExportSegmentsClosedSurfaceRepresentatio
     strs << sizeScale;
     header += ";SCALE=" + strs.str();
     }
-  writer->SetHeader(header.c_str());
 
+  std::vector<vtkSmartPointer<vtkPolyData> > surfaces;
+  GetClosedSurfacesForExport(segmentationNode, segmentIDs, lps, sizeScale, surfaces);
+  for (size_t index = 0; index < segmentIDs.size(); ++index)
+    {
+    if (!surfaces[index])
+      {
+      vtkErrorWithObjectMacro(segmentationNode, "ExportSegmentsClosedSurfaceRepresentationToFiles: Unable to convert segment "
+        << segmentIDs[index] << " to closed surface representation");
+      }
+    }
+
+  std::string safeFileName = vtkSlicerSegmentationsModuleLogic::GetSafeFileName(segmentationNode->GetName());
   if (merge)
     {
     vtkNew<vtkAppendPolyData> appendPolyData;
-
-    for (std::vector<std::string>::const_iterator segmentIdIt = segmentIDs.begin(); segmentIdIt != segmentIDs.end(); ++segmentIdIt)
+    for (vtkPolyData* surface : surfaces)
       {
-      vtkNew<vtkPolyData> segmentPolyData;
-      bool polyDataAvailable = vtkSlicerSegmentationsModuleLogic::GetSegmentClosedSurfaceRepresentation(
-        segmentationNode, *segmentIdIt, segmentPolyData.GetPointer());
-      if (!polyDataAvailable || segmentPolyData.GetPointer() == nullptr)
+      if (surface)
         {
-        vtkErrorWithObjectMacro(segmentationNode, "ExportSegmentsClosedSurfaceRepresentationToFiles: Unable to convert segment "
-          << (*segmentIdIt) << " to closed surface representation");
-        continue;
+        appendPolyData->AddInputData(surface);
         }
-      appendPolyData->AddInputData(segmentPolyData.GetPointer());
       }
-    vtkNew<vtkTransform> transformRasToLps;
-    if (sizeScale != 1.0)
-      {
-      transformRasToLps->Scale(sizeScale, sizeScale, sizeScale);
-      }
-    if (lps)
-      {
-      transformRasToLps->Scale(-1, -1, 1);
-      }
-    vtkNew<vtkTransformPolyDataFilter> transformPolyDataToOutput;
-    transformPolyDataToOutput->SetTransform(transformRasToLps.GetPointer());
-    transformPolyDataToOutput->SetInputConnection(appendPolyData->GetOutputPort());
-    std::string safeFileName = vtkSlicerSegmentationsModuleLogic::GetSafeFileName(segmentationNode->GetName());
+    vtkNew<vtkTriangleFilter> triangulator;
+    triangulator->SetInputConnection(appendPolyData->GetOutputPort());
+    vtkNew<vtkSTLWriter> writer;
+    writer->SetFileType(VTK_BINARY);
+    writer->SetInputConnection(triangulator->GetOutputPort());
+    writer->SetHeader(header.c_str());
     std::string filePath = destinationFolder + "/" + safeFileName + ".stl";
-    triangulator->SetInputConnection(transformPolyDataToOutput->GetOutputPort());
     writer->SetFileName(filePath.c_str());
     try
       {
@@ -2153,42 +2615,50 @@ bool vtkSlicerSegmentationsModuleLogic::ExportSegmentsClosedSurfaceRepresentatio
     }
   else
     {
-    for (std::vector<std::string>::const_iterator segmentIdIt = segmentIDs.begin(); segmentIdIt != segmentIDs.end(); ++segmentIdIt)
+    std::vector<std::string> filePaths(segmentIDs.size());
+    for (size_t index = 0; index < segmentIDs.size(); ++index)
       {
-      vtkNew<vtkPolyData> segmentPolyData;
-      bool polyDataAvailable = vtkSlicerSegmentationsModuleLogic::GetSegmentClosedSurfaceRepresentation(
-        segmentationNode, *segmentIdIt, segmentPolyData.GetPointer());
-      if (!polyDataAvailable || segmentPolyData.GetPointer() == nullptr)
-        {
-        vtkErrorWithObjectMacro(segmentationNode, "ExportSegmentsClosedSurfaceRepresentationToFiles: Unable to convert segment "
-          << (*segmentIdIt) << " to closed surface representation");
-        continue;
-        }
-      vtkNew<vtkTransform> transformRasToLps;
-      if (sizeScale != 1.0)
+      if (surfaces[index])
         {
-        transformRasToLps->Scale(sizeScale, sizeScale, sizeScale);
+        std::string segmentName = segmentationNode->GetSegmentation()->GetSegment(segmentIDs[index])->GetName();
+        filePaths[index] = destinationFolder + "/" + safeFileName + "_" + segmentName + ".stl";
         }
-      if (lps)
-        {
-        transformRasToLps->Scale(-1, -1, 1);
-        }
-      vtkNew<vtkTransformPolyDataFilter> transformPolyDataToOutput;
-      transformPolyDataToOutput->SetTransform(transformRasToLps.GetPointer());
-      transformPolyDataToOutput->SetInputData(segmentPolyData.GetPointer());
-      std::string segmentName = segmentationNode->GetSegmentation()->GetSegment(*segmentIdIt)->GetName();
-      std::string safeFileName = vtkSlicerSegmentationsModuleLogic::GetSafeFileName(segmentationNode->GetName());
-      std::string filePath = destinationFolder + "/" + safeFileName + "_" + segmentName + ".stl";
-      triangulator->SetInputConnection(transformPolyDataToOutput->GetOutputPort());
-      writer->SetFileName(filePath.c_str());
-      try
+      }
+
+    // Each segment is written to a separate file, therefore files are written in parallel
+    std::vector<char> writeFailed(segmentIDs.size(), 0);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(segmentIDs.size()), [&](vtkIdType begin, vtkIdType end)
+      {
+      for (vtkIdType index = begin; index < end; ++index)
         {
-        writer->Write();
+        if (!surfaces[index])
+          {
+          continue;
+          }
+        vtkNew<vtkTriangleFilter> triangulator;
+        triangulator->SetInputData(surfaces[index]);
+        vtkNew<vtkSTLWriter> writer;
+        writer->SetFileType(VTK_BINARY);
+        writer->SetInputConnection(triangulator->GetOutputPort());
+        writer->SetHeader(header.c_str());
+        writer->SetFileName(filePaths[index].c_str());
+        try
+          {
+          writeFailed[index] = (!writer->Write() || writer->GetErrorCode() != 0);
+          }
+        catch (...)
+          {
+          writeFailed[index] = 1;
+          }
         }
-      catch (...)
+      });
+
+    for (size_t index = 0; index < segmentIDs.size(); ++index)
+      {
+      if (writeFailed[index])
         {
         vtkErrorWithObjectMacro(segmentationNode, "ExportSegmentsClosedSurfaceRepresentationToFiles:"
-          " Unable to write segmentation to " << filePath);
+          " Unable to write segmentation to " << filePaths[index]);
         return false;
         }
       }
@@ -2212,44 +2682,34 @@ bool vtkSlicerSegmentationsModuleLogic::ExportSegmentsClosedSurfaceRepresentatio
   vtkNew<vtkRenderWindow> renderWindow;
   renderWindow->AddRenderer(renderer.GetPointer());
 
-  for (std::vector<std::string>::const_iterator segmentIdIt = segmentIDs.begin(); segmentIdIt != segmentIDs.end(); ++segmentIdIt)
+  // Surfaces are converted and transformed in parallel, only the file is written serially
+  std::vector<vtkSmartPointer<vtkPolyData> > surfaces;
+  GetClosedSurfacesForExport(segmentationNode, segmentIDs, lps, sizeScale, surfaces);
+
+  for (size_t index = 0; index < segmentIDs.size(); ++index)
     {
-    vtkNew<vtkPolyData> segmentPolyData;
-    bool polyDataAvailable = vtkSlicerSegmentationsModuleLogic::GetSegmentClosedSurfaceRepresentation(
-      segmentationNode, *segmentIdIt, segmentPolyData.GetPointer());
-    if (!polyDataAvailable || segmentPolyData.GetPointer() == nullptr)
+    const std::string& segmentId = segmentIDs[index];
+    if (!surfaces[index])
       {
       vtkErrorWithObjectMacro(segmentationNode, "ExportSegmentsClosedSurfaceRepresentationToObjFile: Unable to convert segment "
-        << (*segmentIdIt) << " to closed surface representation");
+        << segmentId << " to closed surface representation");
       continue;
       }
-    vtkNew<vtkTransform> transformRasToLps;
-    if (sizeScale != 1.0)
-      {
-      transformRasToLps->Scale(sizeScale, sizeScale, sizeScale);
-      }
-    if (lps)
-      {
-      transformRasToLps->Scale(-1, -1, 1);
-      }
-    vtkNew<vtkTransformPolyDataFilter> transformPolyDataToOutput;
-    transformPolyDataToOutput->SetTransform(transformRasToLps.GetPointer());
-    transformPolyDataToOutput->SetInputData(segmentPolyData.GetPointer());
     vtkNew<vtkPolyDataMapper> mapper;
-    mapper->SetInputConnection(transformPolyDataToOutput->GetOutputPort());
+    mapper->SetInputData(surfaces[index]);
     vtkNew<vtkActor> actor;
     actor->SetMapper(mapper.GetPointer());
 
     if (displayNode)
       {
       double color[3] = { 0.5, 0.5, 0.5 };
-      displayNode->GetSegmentColor(*segmentIdIt, color);
+      displayNode->GetSegmentColor(segmentId, color);
       // OBJ exporter sets the same color for ambient, diffuse, specular
       // so we scale it by 1/3 to avoid having too bright material.
       double colorScale = 1.0 / 3.0;
       actor->GetProperty()->SetColor(color[0] * colorScale, color[1] * colorScale, color[2] * colorScale);
       actor->GetProperty()->SetSpecularPower(3.0);
-      actor->GetProperty()->SetOpacity(displayNode->GetSegmentOpacity3D(*segmentIdIt));
+      actor->GetProperty()->SetOpacity(displayNode->GetSegmentOpacity3DsegmentId);
       }
     renderer->AddActor(actor.GetPointer());
     }
@@ -2740,3 +3200,188 @@ bool vtkSlicerSegmentationsModuleLogic::IsSegmentationExentOutsideReferenceGeome
     }
   return false;
 }
+
+//-----------------------------------------------------------------------------
+bool vtkSlicerSegmentationsModuleLogic::ComputeSegmentStatistics(vtkMRMLSegmentationNode* segmentationNode,
+  vtkMRMLScalarVolumeNode* scalarVolumeNode, vtkTable* statistics, vtkDoubleArray* percentiles/*=nullptr*/,
+  vtkStringArray* segmentIDs/*=nullptr*/)
+{
+  if (!segmentationNode || !segmentationNode->GetSegmentation() || !statistics)
+    {
+    vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::ComputeSegmentStatistics: Invalid segmentation node or output table");
+    return false;
+    }
+  vtkImageData* scalarImage = scalarVolumeNode ? scalarVolumeNode->GetImageData() : nullptr;
+  if (!scalarImage || !scalarImage->GetPointData() || !scalarImage->GetPointData()->GetScalars())
+    {
+    vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::ComputeSegmentStatistics: Invalid scalar volume node");
+    return false;
+    }
+  vtkSegmentation* segmentation = segmentationNode->GetSegmentation();
+  std::string labelmapRepresentationName = vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName();
+  if (!segmentation->ContainsRepresentation(labelmapRepresentationName))
+    {
+    vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::ComputeSegmentStatistics: Segmentation does not contain binary labelmap representation");
+    return false;
+    }
+
+  std::vector<std::string> requestedSegmentIDs;
+  if (segmentIDs && segmentIDs->GetNumberOfValues() > 0)
+    {
+    for (vtkIdType i = 0; i < segmentIDs->GetNumberOfValues(); ++i)
+      {
+      requestedSegmentIDs.push_back(segmentIDs->GetValue(i));
+      }
+    }
+  else
+    {
+    segmentation->GetSegmentIDs(requestedSegmentIDs);
+    }
+
+  // Reference geometry of the scalar volume
+  vtkNew<vtkOrientedImageData> referenceGeometry;
+  referenceGeometry->SetExtent(scalarImage->GetExtent());
+  vtkNew<vtkMatrix4x4> ijkToRasMatrix;
+  scalarVolumeNode->GetIJKToRASMatrix(ijkToRasMatrix);
+  referenceGeometry->SetGeometryFromImageToWorldMatrix(ijkToRasMatrix);
+  vtkNew<vtkGeneralTransform> segmentationToVolumeTransform;
+  vtkMRMLTransformNode::GetTransformBetweenNodes(segmentationNode->GetParentTransformNode(),
+    scalarVolumeNode->GetParentTransformNode(), segmentationToVolumeTransform);
+
+  // Resample each layer that contains a requested segment once
+  std::vector<SegmentStatisticsLayer> layers;
+  std::vector<std::string> outputSegmentIDs;
+  for (int layerIndex = 0; layerIndex < segmentation->GetNumberOfLayers(labelmapRepresentationName); ++layerIndex)
+    {
+    vtkOrientedImageData* layerLabelmap = vtkOrientedImageData::SafeDownCast(
+      segmentation->GetLayerDataObject(layerIndex, labelmapRepresentationName));
+    if (!layerLabelmap || !layerLabelmap->GetPointData() || !layerLabelmap->GetPointData()->GetScalars())
+      {
+      continue;
+      }
+    SegmentStatisticsLayer layer;
+    for (const std::string& segmentID : segmentation->GetSegmentIDsForLayer(layerIndex, labelmapRepresentationName))
+      {
+      vtkSegment* segment = segmentation->GetSegment(segmentID);
+      if (!segment || segment->GetLabelValue() <= 0
+        || std::find(requestedSegmentIDs.begin(), requestedSegmentIDs.end(), segmentID) == requestedSegmentIDs.end())
+        {
+        continue;
+        }
+      int labelValue = segment->GetLabelValue();
+      if (labelValue >= static_cast<int>(layer.SegmentIndexForLabelValue.size()))
+        {
+        layer.SegmentIndexForLabelValue.resize(labelValue + 1, -1);
+        }
+      layer.SegmentIndexForLabelValue[labelValue] = static_cast<int>(outputSegmentIDs.size());
+      outputSegmentIDs.push_back(segmentID);
+      }
+    if (layer.SegmentIndexForLabelValue.empty())
+      {
+      continue;
+      }
+    layer.Labelmap = vtkSmartPointer<vtkOrientedImageData>::New();
+    if (!vtkOrientedImageDataResample::ResampleOrientedImageToReferenceOrientedImage(layerLabelmap, referenceGeometry, layer.Labelmap,
+      false /* nearest neighbor interpolation */, false /* no padding */, segmentationToVolumeTransform))
+      {
+      // Segments of this layer will have no voxels
+      vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::ComputeSegmentStatistics: Failed to resample labelmap layer " << layerIndex);
+      continue;
+      }
+    if (layer.Labelmap->GetPointData() && layer.Labelmap->GetPointData()->GetScalars())
+      {
+      layer.ScalarType = layer.Labelmap->GetScalarType();
+      layer.ScalarSize = layer.Labelmap->GetScalarSize();
+      layers.push_back(layer);
+      }
+    }
+
+  // Histogram used for median and percentiles: one bin per value for integer volumes if possible
+  double* scalarRange = scalarImage->GetPointData()->GetScalars()->GetRange(0);
+  const int maximumNumberOfBins = 65536;
+  bool integerVolume = (scalarImage->GetScalarType() != VTK_FLOAT && scalarImage->GetScalarType() != VTK_DOUBLE);
+  double histogramMinimum = scalarRange[0];
+  double histogramBinWidth = 1.0;
+  int numberOfHistogramBins = 1;
+  if (integerVolume && scalarRange[1] - scalarRange[0] < maximumNumberOfBins)
+    {
+    numberOfHistogramBins = static_cast<int>(scalarRange[1] - scalarRange[0]) + 1;
+    }
+  else if (scalarRange[1] > scalarRange[0])
+    {
+    integerVolume = false;
+    numberOfHistogramBins = maximumNumberOfBins;
+    histogramBinWidth = (scalarRange[1] - scalarRange[0]) / maximumNumberOfBins;
+    }
+
+  std::vector<SegmentStatisticsAccumulator> results;
+  int numberOfSegments = static_cast<int>(outputSegmentIDs.size());
+  switch (scalarImage->GetScalarType())
+    {
+    vtkTemplateMacro(AccumulateSegmentStatistics<VTK_TT>(scalarImage, layers, numberOfSegments,
+      histogramMinimum, histogramBinWidth, numberOfHistogramBins, results));
+    default:
+      vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::ComputeSegmentStatistics: Unsupported scalar type");
+      return false;
+    }
+  results.resize(numberOfSegments);
+
+  // Fill output table
+  double* spacing = scalarVolumeNode->GetSpacing();
+  double cubicMmPerVoxel = spacing[0] * spacing[1] * spacing[2];
+  const double ccPerCubicMm = 0.001;
+
+  statistics->Initialize();
+  vtkNew<vtkStringArray> segmentIDColumn;
+  segmentIDColumn->SetName("SegmentID");
+  statistics->AddColumn(segmentIDColumn);
+  vtkNew<vtkIdTypeArray> voxelCountColumn;
+  voxelCountColumn->SetName("VoxelCount");
+  statistics->AddColumn(voxelCountColumn);
+  std::vector<std::string> doubleColumnNames = { "VolumeMm3", "VolumeCm3", "Minimum", "Maximum", "Mean", "StandardDeviation", "Median" };
+  int numberOfPercentiles = percentiles ? percentiles->GetNumberOfTuples() : 0;
+  for (int percentileIndex = 0; percentileIndex < numberOfPercentiles; ++percentileIndex)
+    {
+    std::stringstream percentileColumnName;
+    percentileColumnName << "Percentile" << percentiles->GetValue(percentileIndex);
+    doubleColumnNames.push_back(percentileColumnName.str());
+    }
+  for (const std::string& columnName : doubleColumnNames)
+    {
+    vtkNew<vtkDoubleArray> column;
+    column->SetName(columnName.c_str());
+    statistics->AddColumn(column);
+    }
+  statistics->SetNumberOfRows(numberOfSegments);
+
+  for (int segmentIndex = 0; segmentIndex < numberOfSegments; ++segmentIndex)
+    {
+    const SegmentStatisticsAccumulator& result = results[segmentIndex];
+    vtkIdType count = result.VoxelCount;
+    std::vector<double> values(doubleColumnNames.size(), vtkMath::Nan());
+    values[0] = count * cubicMmPerVoxel;
+    values[1] = count * cubicMmPerVoxel * ccPerCubicMm;
+    if (count > 0)
+      {
+      double mean = result.Sum / count;
+      values[2] = result.Minimum;
+      values[3] = result.Maximum;
+      values[4] = mean;
+      // Unbiased estimate, as in vtkImageAccumulate
+      values[5] = (count > 1 ? std::sqrt(std::max(0.0, (result.SumOfSquares - result.Sum * mean) / (count - 1))) : 0.0);
+      values[6] = GetHistogramPercentile(result, 50.0, histogramMinimum, histogramBinWidth, integerVolume);
+      for (int percentileIndex = 0; percentileIndex < numberOfPercentiles; ++percentileIndex)
+        {
+        values[7 + percentileIndex] = GetHistogramPercentile(result, percentiles->GetValue(percentileIndex),
+          histogramMinimum, histogramBinWidth, integerVolume);
+        }
+      }
+    segmentIDColumn->SetValue(segmentIndex, outputSegmentIDs[segmentIndex]);
+    voxelCountColumn->SetValue(segmentIndex, count);
+    for (size_t columnIndex = 0; columnIndex < values.size(); ++columnIndex)
+      {
+      vtkDoubleArray::SafeDownCast(statistics->GetColumn(static_cast<vtkIdType>(columnIndex) + 2))->SetValue(segmentIndex, values[columnIndex]);
+      }
+    }
+  return true;
+}
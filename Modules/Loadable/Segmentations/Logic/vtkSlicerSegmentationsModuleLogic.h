@@ -34,10 +34,12 @@
 #include "vtkMRMLSegmentationNode.h"
 
 class vtkCallbackCommand;
+class vtkDoubleArray;
 class vtkOrientedImageData;
 class vtkPolyData;
 class vtkDataObject;
 class vtkGeneralTransform;
+class vtkTable;
 
 class vtkMRMLSegmentationStorageNode;
 class vtkMRMLScalarVolumeNode;
@@ -109,6 +111,10 @@ public:
   /// Utility function that returns all non-empty label values in a labelmap
   static void GetAllLabelValues(vtkIntArray* labels, vtkImageData* labelmap);
 
+  /// Utility function that returns all non-empty label values in a labelmap (in ascending order)
+  /// and the extent that contains all non-empty voxels. The labelmap is scanned only once.
+  static void GetAllLabelValues(vtkIntArray* labels, vtkImageData* labelmap, int effectiveExtent[6]);
+
   /// Create segment from labelmap volume MRML node. The contents are set as binary labelmap representation in the segment.
   /// Returns nullptr if labelmap contains more than one label. In that case \sa ImportLabelmapToSegmentationNode needs to be used.
   /// NOTE: Need to take ownership of the created object! For example using vtkSmartPointer<vtkSegment>::Take
@@ -456,6 +462,23 @@ public:
   /// \return True if the segmentation extent is outside of the reference volume, False otherwise.
   static bool IsSegmentationExentOutsideReferenceGeometry(vtkOrientedImageData* referenceGeometry, vtkOrientedImageData* segmentationGeometry);
 
+  /// Compute statistics of the scalar volume voxel values within each segment.
+  /// Each binary labelmap layer of the segmentation is resampled to the scalar volume geometry once,
+  /// then the statistics of all segments of all layers are accumulated in a single multi-threaded
+  /// pass over the scalar volume.
+  /// \param segmentationNode Segmentation node, its binary labelmap representation is used
+  /// \param scalarVolumeNode Volume containing the voxel values. Only the first component is used.
+  /// \param statistics Output table with one row per segment and the columns SegmentID, VoxelCount,
+  ///   VolumeMm3, VolumeCm3, Minimum, Maximum, Mean, StandardDeviation, Median, and one column named
+  ///   "Percentile<value>" (for example "Percentile95") for each requested percentile.
+  /// \param percentiles Percentiles (between 0 and 100) to compute in addition to the median. Optional.
+  /// \param segmentIDs Segments to compute the statistics for. All segments are used if nullptr or empty.
+  /// \return True on success.
+  /// Median and percentiles are computed from a histogram of at most 65536 bins, therefore they are exact
+  /// for integer volumes with a scalar range of up to 65536 values.
+  static bool ComputeSegmentStatistics(vtkMRMLSegmentationNode* segmentationNode, vtkMRMLScalarVolumeNode* scalarVolumeNode,
+    vtkTable* statistics, vtkDoubleArray* percentiles=nullptr, vtkStringArray* segmentIDs=nullptr);
+
 protected:
   void SetMRMLSceneInternal(vtkMRMLScene * newScene) override;
 
@@ -56,6 +56,7 @@
 #include <vtkImageReslice.h>
 #include <vtkIntArray.h>
 #include <vtkLookupTable.h>
+#include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
@@ -65,18 +66,22 @@
 #include <vtkPolyDataMapper2D.h>
 #include <vtkProperty2D.h>
 #include <vtkRenderer.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkStringArray.h>
 #include <vtkStripper.h>
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
 #include <vtkTriangleFilter.h>
+#include <vtkWeakPointer.h>
 
 // STD includes
 #include <algorithm>
+#include <functional>
 #include <set>
 #include <map>
 #include <sstream>
+#include <vector>
 
 //---------------------------------------------------------------------------
 vtkStandardNewMacro(vtkMRMLSegmentationsDisplayableManager2D );
@@ -123,6 +128,83 @@ void SnapToPermuteMatrix(vtkTransform* transform)
     }
 }
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Identifies the intersection of a closed surface with a slice plane.
+/// Slice views that show the same surface in the same plane (e.g., linked views
+/// in a compare layout) get the same key, so the cut only has to be computed once.
+struct SliceIntersectionKey
+{
+  vtkPolyData* PolyData{ nullptr };
+  vtkMTimeType PolyDataMTime{ 0 };
+  /// Node to world matrix (16 elements), plane normal (3 elements), and plane offset along the normal
+  double Geometry[20]{};
+
+  bool operator<(const SliceIntersectionKey& other) const
+  {
+    if (this->PolyData != other.PolyData)
+      {
+      return std::less<vtkPolyData*>()(this->PolyData, other.PolyData);
+      }
+    if (this->PolyDataMTime != other.PolyDataMTime)
+      {
+      return this->PolyDataMTime < other.PolyDataMTime;
+      }
+    return std::lexicographical_compare(this->Geometry, this->Geometry + 20, other.Geometry, other.Geometry + 20);
+  }
+};
+
+//----------------------------------------------------------------------------
+/// Slice intersections shared by all the 2D segmentation displayable managers.
+/// The cache does not own the intersections: they are kept alive by the pipelines
+/// that display them, and an entry expires when no pipeline uses it anymore.
+typedef std::map<SliceIntersectionKey, vtkWeakPointer<vtkPolyData> > SliceIntersectionCacheType;
+SliceIntersectionCacheType& GetSliceIntersectionCache()
+{
+  static SliceIntersectionCacheType sliceIntersectionCache;
+  return sliceIntersectionCache;
+}
+
+//----------------------------------------------------------------------------
+vtkPolyData* FindSliceIntersection(const SliceIntersectionKey& key)
+{
+  SliceIntersectionCacheType& cache = GetSliceIntersectionCache();
+  SliceIntersectionCacheType::iterator it = cache.find(key);
+  if (it == cache.end())
+    {
+    return nullptr;
+    }
+  if (!it->second)
+    {
+    cache.erase(it);
+    return nullptr;
+    }
+  return it->second;
+}
+
+//----------------------------------------------------------------------------
+void AddSliceIntersection(const SliceIntersectionKey& key, vtkPolyData* sliceIntersection)
+{
+  SliceIntersectionCacheType& cache = GetSliceIntersectionCache();
+  // Remove expired entries
+  for (SliceIntersectionCacheType::iterator it = cache.begin(); it != cache.end();)
+    {
+    if (!it->second)
+      {
+      it = cache.erase(it);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+  cache[key] = sliceIntersection;
+}
+
+}
+
 //---------------------------------------------------------------------------
 class vtkMRMLSegmentationsDisplayableManager2D::vtkInternal
 {
@@ -148,27 +230,32 @@ public:
       this->ModelWarper = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
       this->Plane = vtkSmartPointer<vtkPlane>::New();
       this->Triangulator = vtkSmartPointer<vtkContourTriangulator>::New();
-
-      // Set up poly data outline pipeline
+      this->GeometryFilter = vtkSmartPointer<vtkCompositeDataGeometryFilter>::New();
+      this->SliceIntersection = vtkSmartPointer<vtkPolyData>::New();
+      this->PolyDataOutlineTransformer = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
+      this->PointMerger = vtkSmartPointer<vtkCleanPolyData>::New();
+
+      // Set up slice intersection pipeline. It is executed explicitly when the slice
+      // or the segment changes and its result is set as input of the display pipelines,
+      // so that it can be shared with other views.
       this->Cutter->SetInputConnection(this->ModelWarper->GetOutputPort());
       this->Cutter->SetPlane(this->Plane);
       this->Cutter->BuildTreeOff(); // the cutter crashes for complex geometries if build tree is enabled
-      vtkSmartPointer<vtkTransformPolyDataFilter> polyDataOutlineTransformer = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-      vtkNew<vtkCompositeDataGeometryFilter> geometryFilter; // merge multi-piece output of vtkPlaneCutter
-      geometryFilter->SetInputConnection(this->Cutter->GetOutputPort());
-      polyDataOutlineTransformer->SetInputConnection(geometryFilter->GetOutputPort());
-      polyDataOutlineTransformer->SetTransform(this->WorldToSliceTransform);
+      this->GeometryFilter->SetInputConnection(this->Cutter->GetOutputPort()); // merge multi-piece output of vtkPlaneCutter
+
+      // Set up poly data outline pipeline
+      this->PolyDataOutlineTransformer->SetInputData(this->SliceIntersection);
+      this->PolyDataOutlineTransformer->SetTransform(this->WorldToSliceTransform);
       vtkSmartPointer<vtkPolyDataMapper2D> polyDataOutlineMapper = vtkSmartPointer<vtkPolyDataMapper2D>::New();
-      polyDataOutlineMapper->SetInputConnection(polyDataOutlineTransformer->GetOutputPort());
+      polyDataOutlineMapper->SetInputConnection(this->PolyDataOutlineTransformer->GetOutputPort());
       polyDataOutlineMapper->ScalarVisibilityOff();
       this->PolyDataOutlineActor->SetMapper(polyDataOutlineMapper);
       this->PolyDataOutlineActor->SetVisibility(0);
 
       // Set up poly data fill pipeline
-      vtkNew<vtkCleanPolyData> pointMerger;
-      pointMerger->PointMergingOn();
-      pointMerger->SetInputConnection(geometryFilter->GetOutputPort());
-      this->Triangulator->SetInputConnection(pointMerger->GetOutputPort());
+      this->PointMerger->PointMergingOn();
+      this->PointMerger->SetInputData(this->SliceIntersection);
+      this->Triangulator->SetInputConnection(this->PointMerger->GetOutputPort());
       vtkSmartPointer<vtkTransformPolyDataFilter> polyDataFillTransformer = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
       polyDataFillTransformer->SetInputConnection(this->Triangulator->GetOutputPort());
       polyDataFillTransformer->SetTransform(this->WorldToSliceTransform);
@@ -229,6 +316,18 @@ public:
       this->ImageFillActor->SetVisibility(0);
       }
 
+    /// Set the intersection of the segment surface and the slice plane that is displayed
+    void SetSliceIntersection(vtkPolyData* sliceIntersection)
+      {
+      if (this->SliceIntersection == sliceIntersection)
+        {
+        return;
+        }
+      this->SliceIntersection = sliceIntersection;
+      this->PolyDataOutlineTransformer->SetInputData(sliceIntersection);
+      this->PointMerger->SetInputData(sliceIntersection);
+      }
+
     vtkSmartPointer<vtkTransform> WorldToSliceTransform;
     vtkSmartPointer<vtkGeneralTransform> NodeToWorldTransform;
     vtkSmartPointer<vtkGeneralTransform> WorldToNodeTransform;
@@ -238,6 +337,10 @@ public:
     vtkSmartPointer<vtkTransformPolyDataFilter> ModelWarper;
     vtkSmartPointer<vtkPlane> Plane;
     vtkSmartPointer<vtkPlaneCutter> Cutter;
+    vtkSmartPointer<vtkCompositeDataGeometryFilter> GeometryFilter;
+    vtkSmartPointer<vtkPolyData> SliceIntersection;
+    vtkSmartPointer<vtkTransformPolyDataFilter> PolyDataOutlineTransformer;
+    vtkSmartPointer<vtkCleanPolyData> PointMerger;
     vtkSmartPointer<vtkContourTriangulator> Triangulator;
 
     vtkSmartPointer<vtkActor2D> ImageOutlineActor;
@@ -271,6 +374,9 @@ public:
   void SetSliceNode(vtkMRMLSliceNode* sliceNode);
   void UpdateSliceNode();
   void SetSlicePlaneFromMatrix(vtkMatrix4x4* matrix, vtkPlane* plane);
+  /// Get the key of the slice intersection of the pipeline in the shared cache.
+  /// \return False if the intersection cannot be shared (non-linear transform).
+  bool GetSliceIntersectionKey(vtkPolyData* polyData, Pipeline* pipeline, SliceIntersectionKey& key);
 
   // Display Nodes
   void AddDisplayNode(vtkMRMLSegmentationNode*, vtkMRMLSegmentationDisplayNode*);
@@ -391,6 +497,32 @@ void vtkMRMLSegmentationsDisplayableManager2D::vtkInternal::SetSlicePlaneFromMat
   plane->SetOrigin(origin);
 }
 
+//---------------------------------------------------------------------------
+bool vtkMRMLSegmentationsDisplayableManager2D::vtkInternal::GetSliceIntersectionKey(
+  vtkPolyData* polyData, Pipeline* pipeline, SliceIntersectionKey& key)
+{
+  vtkNew<vtkTransform> nodeToWorldLinearTransform;
+  if (!vtkMRMLTransformNode::IsGeneralTransformLinear(pipeline->NodeToWorldTransform, nodeToWorldLinearTransform))
+    {
+    return false;
+    }
+  key.PolyData = polyData;
+  key.PolyDataMTime = polyData->GetMTime();
+  vtkMatrix4x4* nodeToWorldMatrix = nodeToWorldLinearTransform->GetMatrix();
+  for (int i = 0; i < 16; ++i)
+    {
+    key.Geometry[i] = nodeToWorldMatrix->GetElement(i / 4, i % 4);
+    }
+  double* normal = pipeline->Plane->GetNormal();
+  key.Geometry[16] = normal[0];
+  key.Geometry[17] = normal[1];
+  key.Geometry[18] = normal[2];
+  // The origin of the plane moves when the slice view is panned, but the intersection only
+  // depends on the offset of the plane along its normal.
+  key.Geometry[19] = vtkMath::Dot(normal, pipeline->Plane->GetOrigin());
+  return true;
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLSegmentationsDisplayableManager2D::vtkInternal::AddSegmentationNode(vtkMRMLSegmentationNode* node)
 {
@@ -747,6 +879,16 @@ void vtkMRMLSegmentationsDisplayableManager2D::vtkInternal::UpdateDisplayNodePip
     return;
     }
 
+  // Slice intersections that are not available in the shared cache, these are computed after
+  // all the pipelines are updated, in parallel
+  struct SliceIntersectionToCompute
+    {
+    Pipeline* SegmentPipeline;
+    SliceIntersectionKey Key;
+    bool Shared;
+    };
+  std::vector<SliceIntersectionToCompute> sliceIntersectionsToCompute;
+
   // For all pipelines (pipeline per segment)
   for (PipelineMapType::iterator pipelineIt=pipelines.begin(); pipelineIt!=pipelines.end(); ++pipelineIt)
     {
@@ -821,7 +963,20 @@ void vtkMRMLSegmentationsDisplayableManager2D::vtkInternal::UpdateDisplayNodePip
 
         // Set Plane transform
         this->SetSlicePlaneFromMatrix(this->SliceXYToRAS, pipeline->Plane);
-        pipeline->Plane->Modified();
+
+        // Reuse the intersection if another view has already computed it
+        SliceIntersectionToCompute sliceIntersection;
+        sliceIntersection.SegmentPipeline = pipeline;
+        sliceIntersection.Shared = this->GetSliceIntersectionKey(polyData, pipeline, sliceIntersection.Key);
+        vtkPolyData* sharedSliceIntersection = (sliceIntersection.Shared ? FindSliceIntersection(sliceIntersection.Key) : nullptr);
+        if (sharedSliceIntersection)
+          {
+          pipeline->SetSliceIntersection(sharedSliceIntersection);
+          }
+        else
+          {
+          sliceIntersectionsToCompute.push_back(sliceIntersection);
+          }
 
         // Set PolyData transform
         vtkNew<vtkMatrix4x4> rasToSliceXY;
@@ -1108,6 +1263,27 @@ void vtkMRMLSegmentationsDisplayableManager2D::vtkInternal::UpdateDisplayNodePip
       continue;
       }
     }
+
+  // Cut the segment surfaces. Each segment has its own cutting pipeline, therefore they can run in parallel.
+  auto cutSegments = [&](vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType index = begin; index < end; ++index)
+      {
+      sliceIntersectionsToCompute[index].SegmentPipeline->GeometryFilter->Update();
+      }
+    };
+  vtkSMPTools::For(0, static_cast<vtkIdType>(sliceIntersectionsToCompute.size()), cutSegments);
+
+  for (const SliceIntersectionToCompute& sliceIntersection : sliceIntersectionsToCompute)
+    {
+    vtkNew<vtkPolyData> cutPolyData;
+    cutPolyData->ShallowCopy(sliceIntersection.SegmentPipeline->GeometryFilter->GetOutput());
+    sliceIntersection.SegmentPipeline->SetSliceIntersection(cutPolyData);
+    if (sliceIntersection.Shared)
+      {
+      AddSliceIntersection(sliceIntersection.Key, cutPolyData);
+      }
+    }
 }
 
 //---------------------------------------------------------------------------
@@ -42,6 +42,7 @@ class SegmentationsModuleTest2(unittest.TestCase):
         self.TestSection_RetrieveInputData()
         self.TestSection_SetupScene()
         self.TestSection_SharedLabelmapMultipleLayerEditing()
+        self.TestSection_SegmentStatistics()
         self.TestSection_IslandEffects()
         self.TestSection_MarginEffects()
         self.TestSection_MaskingSettings()
@@ -144,6 +145,31 @@ class SegmentationsModuleTest2(unittest.TestCase):
         self.segmentEditorNode.SetOverwriteMode(oldOverwriteMode)
         logging.info('Multiple layer editing successful')
 
+    # ------------------------------------------------------------------------------
+    def TestSection_SegmentStatistics(self):
+        # Both segments cover the same 11x11x11 voxel region, in separate layers
+        import numpy as np
+        self.assertEqual(self.segmentation.GetNumberOfLayers(), 2)
+
+        percentiles = vtk.vtkDoubleArray()
+        percentiles.InsertNextValue(5)
+        percentiles.InsertNextValue(95)
+        statistics = vtk.vtkTable()
+        self.assertTrue(slicer.vtkSlicerSegmentationsModuleLogic.ComputeSegmentStatistics(
+            self.segmentationNode, self.sourceVolumeNode, statistics, percentiles))
+        self.assertEqual(statistics.GetNumberOfRows(), 2)
+
+        voxels = slicer.util.arrayFromVolume(self.sourceVolumeNode)[0:11, 0:11, 0:11].astype(float)
+        for row in range(2):
+            self.assertEqual(statistics.GetValueByName(row, "VoxelCount").ToInt(), voxels.size)
+            self.assertAlmostEqual(statistics.GetValueByName(row, "Minimum").ToDouble(), voxels.min())
+            self.assertAlmostEqual(statistics.GetValueByName(row, "Maximum").ToDouble(), voxels.max())
+            self.assertAlmostEqual(statistics.GetValueByName(row, "Mean").ToDouble(), voxels.mean(), places=3)
+            self.assertAlmostEqual(statistics.GetValueByName(row, "StandardDeviation").ToDouble(), voxels.std(ddof=1), places=3)
+            self.assertAlmostEqual(statistics.GetValueByName(row, "Median").ToDouble(), np.median(voxels))
+            self.assertAlmostEqual(statistics.GetValueByName(row, "Percentile95").ToDouble(), np.percentile(voxels, 95))
+        logging.info('Segment statistics computation successful')
+
     # ------------------------------------------------------------------------------
     def TestSection_IslandEffects(self):
         islandSizes = [1, 26, 11, 6, 8, 6, 2]
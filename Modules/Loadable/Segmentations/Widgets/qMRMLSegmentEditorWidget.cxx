@@ -114,6 +114,9 @@
 // CTK includes
 #include <ctkCollapsibleButton.h>
 
+// STD includes
+#include <algorithm>
+
 static const int BINARY_LABELMAP_SCALAR_TYPE = VTK_UNSIGNED_CHAR;
 // static const unsigned char BINARY_LABELMAP_VOXEL_FULL = 1; // unused
 static const unsigned char BINARY_LABELMAP_VOXEL_EMPTY = 0;
@@ -191,6 +194,13 @@ public:
   /// source volume intensity).
   bool updateMaskLabelmap();
 
+  /// Returns the latest modification time of all the data that the mask labelmap depends on:
+  /// the segment list, the segments that the mask is computed from, and the segment visibilities
+  /// (if the mask depends on them). The edited segment is excluded in "outside" modes, as it is
+  /// not part of the mask then, so painting in the selected segment does not invalidate the mask.
+  vtkMTimeType maskLabelmapInputMTime(vtkMRMLSegmentationNode* segmentationNode, int maskMode,
+    const std::string& editedSegmentID, const std::string& maskSegmentID);
+
   bool updateReferenceGeometryImage();
 
   static std::string getReferenceImageGeometryFromSegmentation(vtkSegmentation* segmentation);
@@ -274,6 +284,17 @@ public:
   vtkMRMLTransformNode* AlignedSourceVolumeUpdateSourceVolumeNodeTransform;
   vtkMRMLTransformNode* AlignedSourceVolumeUpdateSegmentationNodeTransform;
 
+  /// Input data that is used for computing MaskLabelmap.
+  /// It is stored so that the mask is only regenerated when the masking parameters
+  /// or the segments that the mask is computed from are changed.
+  vtkMRMLSegmentationNode* MaskLabelmapUpdateSegmentationNode;
+  std::string MaskLabelmapUpdateReferenceImageGeometry;
+  int MaskLabelmapUpdateMaskMode;
+  std::string MaskLabelmapUpdateEditedSegmentID;
+  std::string MaskLabelmapUpdateMaskSegmentID;
+  vtkMTimeType MaskLabelmapUpdateInputMTime;
+  vtkMTimeType MaskLabelmapUpdateMTime;
+
   int MaskModeComboBoxFixedItemsCount;
 
   /// If reference geometry changes compared to this value then we notify effects and
@@ -313,6 +334,10 @@ qMRMLSegmentEditorWidgetPrivate::qMRMLSegmentEditorWidgetPrivate(qMRMLSegmentEdi
   , AlignedSourceVolumeUpdateSourceVolumeNode(nullptr)
   , AlignedSourceVolumeUpdateSourceVolumeNodeTransform(nullptr)
   , AlignedSourceVolumeUpdateSegmentationNodeTransform(nullptr)
+  , MaskLabelmapUpdateSegmentationNode(nullptr)
+  , MaskLabelmapUpdateMaskMode(-1)
+  , MaskLabelmapUpdateInputMTime(0)
+  , MaskLabelmapUpdateMTime(0)
   , MaskModeComboBoxFixedItemsCount(0)
   , EffectButtonStyle(Qt::ToolButtonIconOnly)
   , RotateWarningInNodeSelectorLayout(true)
@@ -735,6 +760,25 @@ bool qMRMLSegmentEditorWidgetPrivate::updateMaskLabelmap()
     qCritical() << Q_FUNC_INFO << ": Cannot determine mask labelmap geometry";
     return false;
     }
+  int maskMode = this->ParameterSetNode->GetMaskMode();
+  std::string editedSegmentID = this->ParameterSetNode->GetSelectedSegmentID() ? this->ParameterSetNode->GetSelectedSegmentID() : "";
+  std::string maskSegmentID = this->ParameterSetNode->GetMaskSegmentID() ? this->ParameterSetNode->GetMaskSegmentID() : "";
+  vtkMTimeType inputMTime = this->maskLabelmapInputMTime(segmentationNode, maskMode, editedSegmentID, maskSegmentID);
+
+  // If masking parameters did not change and none of the segments that the mask is computed from
+  // have been modified since the last update (and the mask itself has not been modified either)
+  // then the mask does not have to be regenerated.
+  if (this->MaskLabelmapUpdateSegmentationNode == segmentationNode
+    && this->MaskLabelmapUpdateMaskMode == maskMode
+    && this->MaskLabelmapUpdateEditedSegmentID == editedSegmentID
+    && this->MaskLabelmapUpdateMaskSegmentID == maskSegmentID
+    && this->MaskLabelmapUpdateReferenceImageGeometry == referenceGeometryStr
+    && this->MaskLabelmapUpdateInputMTime >= inputMTime
+    && this->MaskLabelmapUpdateMTime == this->MaskLabelmap->GetMTime())
+    {
+    return true;
+    }
+
   vtkNew<vtkOrientedImageData> referenceGeometry;
   if (!vtkSegmentationConverter::DeserializeImageGeometry(referenceGeometryStr, referenceGeometry, false))
     {
@@ -746,16 +790,83 @@ bool qMRMLSegmentEditorWidgetPrivate::updateMaskLabelmap()
   // editable intensity range is taken into account in qSlicerSegmentEditorAbstractEffect::modifySelectedSegmentByLabelmap.
   // It would simplify implementation if we passed source volume and intensity range to GenerateEditMask here
   // and removed intensity range based masking from modifySelectedSegmentByLabelmap.
-  if (!segmentationNode->GenerateEditMask(this->MaskLabelmap, this->ParameterSetNode->GetMaskMode(), referenceGeometry,
-    this->ParameterSetNode->GetSelectedSegmentID() ? this->ParameterSetNode->GetSelectedSegmentID() : "",
-    this->ParameterSetNode->GetMaskSegmentID() ? this->ParameterSetNode->GetMaskSegmentID() : ""))
+  if (!segmentationNode->GenerateEditMask(this->MaskLabelmap, maskMode, referenceGeometry, editedSegmentID, maskSegmentID))
     {
     qCritical() << Q_FUNC_INFO << ": Mask generation failed";
+    this->MaskLabelmapUpdateSegmentationNode = nullptr;
     return false;
     }
+
+  this->MaskLabelmapUpdateSegmentationNode = segmentationNode;
+  this->MaskLabelmapUpdateMaskMode = maskMode;
+  this->MaskLabelmapUpdateEditedSegmentID = editedSegmentID;
+  this->MaskLabelmapUpdateMaskSegmentID = maskSegmentID;
+  this->MaskLabelmapUpdateReferenceImageGeometry = referenceGeometryStr;
+  this->MaskLabelmapUpdateInputMTime = inputMTime;
+  this->MaskLabelmapUpdateMTime = this->MaskLabelmap->GetMTime();
   return true;
 }
 
+//-----------------------------------------------------------------------------
+vtkMTimeType qMRMLSegmentEditorWidgetPrivate::maskLabelmapInputMTime(vtkMRMLSegmentationNode* segmentationNode,
+  int maskMode, const std::string& editedSegmentID, const std::string& maskSegmentID)
+{
+  vtkSegmentation* segmentation = segmentationNode->GetSegmentation();
+  if (!segmentation)
+    {
+    return segmentationNode->GetMTime();
+    }
+  // Segmentation MTime changes when segments are added, removed, or reordered, or the master representation is changed,
+  // but not when the contents of a segment are modified.
+  vtkMTimeType inputMTime = segmentation->GetMTime();
+
+  std::vector<std::string> maskSegmentIDs;
+  switch (maskMode)
+    {
+    case vtkMRMLSegmentationNode::EditAllowedEverywhere:
+      break;
+    case vtkMRMLSegmentationNode::EditAllowedInsideSingleSegment:
+      maskSegmentIDs.push_back(maskSegmentID);
+      break;
+    case vtkMRMLSegmentationNode::EditAllowedInsideAllSegments:
+    case vtkMRMLSegmentationNode::EditAllowedInsideVisibleSegments:
+      segmentation->GetSegmentIDs(maskSegmentIDs);
+      break;
+    default:
+      // outside all/visible segments
+      segmentation->GetSegmentIDs(maskSegmentIDs);
+      maskSegmentIDs.erase(std::remove(maskSegmentIDs.begin(), maskSegmentIDs.end(), editedSegmentID), maskSegmentIDs.end());
+      break;
+    }
+
+  if (maskMode == vtkMRMLSegmentationNode::EditAllowedInsideVisibleSegments
+    || maskMode == vtkMRMLSegmentationNode::EditAllowedOutsideVisibleSegments)
+    {
+    vtkMRMLDisplayNode* displayNode = segmentationNode->GetDisplayNode();
+    if (displayNode)
+      {
+      inputMTime = std::max(inputMTime, displayNode->GetMTime());
+      }
+    }
+
+  std::string masterRepresentationName = segmentation->GetMasterRepresentationName();
+  for (const std::string& segmentID : maskSegmentIDs)
+    {
+    vtkSegment* segment = segmentation->GetSegment(segmentID);
+    if (!segment)
+      {
+      continue;
+      }
+    inputMTime = std::max(inputMTime, segment->GetMTime());
+    vtkDataObject* representation = segment->GetRepresentation(masterRepresentationName);
+    if (representation)
+      {
+      inputMTime = std::max(inputMTime, representation->GetMTime());
+      }
+    }
+  return inputMTime;
+}
+
 //-----------------------------------------------------------------------------
 bool qMRMLSegmentEditorWidgetPrivate::updateReferenceGeometryImage()
 {
@@ -66,6 +66,7 @@ qMRMLSegmentsModelPrivate::qMRMLSegmentsModelPrivate(qMRMLSegmentsModel& object)
   , StatusColumn(-1)
   , LayerColumn(-1)
   , SegmentationNode(nullptr)
+  , NumberOfLayers(-1)
 {
   this->CallBack = vtkSmartPointer<vtkCallbackCommand>::New();
 
@@ -172,6 +173,7 @@ QStandardItem* qMRMLSegmentsModelPrivate::insertSegment(QString segmentID, int r
   q->insertRow(row, items);
 
   item = items[0];
+  this->SegmentItems[segmentID] = item;
   if (q->itemFromSegmentID(segmentID) != item)
     {
     qCritical() << Q_FUNC_INFO << ": Item mismatch when inserting segment item with ID " << segmentID;
@@ -286,25 +288,20 @@ QModelIndex qMRMLSegmentsModel::indexFromSegmentID(QString segmentID, int column
 {
   Q_D(const qMRMLSegmentsModel);
 
-  QModelIndex itemIndex;
   if (segmentID.isEmpty())
     {
-    return itemIndex;
+    return QModelIndex();
     }
 
-  QModelIndex startIndex = this->index(0, 0);
-  // QAbstractItemModel::match doesn't browse through columns, we need to do it manually
-  QModelIndexList itemIndexes = this->match(
-    startIndex, SegmentIDRole, segmentID, 1, Qt::MatchExactly | Qt::MatchRecursive);
-  if (itemIndexes.size() == 0)
+  QStandardItem* segmentItem = d->SegmentItems.value(segmentID, nullptr);
+  if (!segmentItem)
     {
     return QModelIndex();
     }
-  itemIndex = itemIndexes[0];
+  QModelIndex itemIndex = segmentItem->index();
 
   if (column == 0)
     {
-    // QAbstractItemModel::match only search through the first column
     return itemIndex;
     }
 
@@ -317,22 +314,21 @@ QModelIndex qMRMLSegmentsModel::indexFromSegmentID(QString segmentID, int column
     return QModelIndex();
     }
 
-  return this->index(row, column, itemIndex.parent());;
+  return this->index(row, column, itemIndex.parent());
 }
 
 //------------------------------------------------------------------------------
 QModelIndexList qMRMLSegmentsModel::indexes(QString segmentID) const
 {
-  QModelIndex startIndex = this->index(0, 0);
-  // QAbstractItemModel::match doesn't browse through columns, we need to do it manually
-  QModelIndexList itemIndexes = this->match(
-    startIndex, SegmentIDRole, segmentID, 1, Qt::MatchExactly | Qt::MatchRecursive);
-  if (itemIndexes.size() != 1)
+  QModelIndexList itemIndexes;
+  QModelIndex itemIndex = this->indexFromSegmentID(segmentID);
+  if (!itemIndex.isValid())
     {
-    return QModelIndexList(); // If 0 it's empty, if >1 it's invalid (one item for each UID)
+    return itemIndexes;
     }
+  itemIndexes << itemIndex;
   // Add the QModelIndexes from the other columns
-  const int row = itemIndexes[0].row();
+  const int row = itemIndex.row();
   for (int col = 1; col < this->columnCount(); ++col)
     {
     itemIndexes << this->index(row, col);
@@ -351,13 +347,16 @@ void qMRMLSegmentsModel::rebuildFromSegments()
   this->invisibleRootItem()->setFlags(Qt::ItemIsEnabled);
 
   // Remove rows before populating
+  d->SegmentItems.clear();
   this->removeRows(0, this->rowCount());
 
   if (!d->SegmentationNode)
     {
+    d->NumberOfLayers = -1;
     this->endResetModel();
     return;
     }
+  d->NumberOfLayers = d->SegmentationNode->GetSegmentation()->GetNumberOfLayers();
 
   // Populate model with the segments
   std::vector<std::string> segmentIDs;
@@ -524,7 +523,6 @@ void qMRMLSegmentsModel::updateItemDataFromSegment(QStandardItem* item, QString
       if (segmentTerminologyTagValue != item->data(qSlicerTerminologyItemDelegate::TerminologyRole).toString())
         {
         item->setData(segmentTerminologyTagValue, qSlicerTerminologyItemDelegate::TerminologyRole);
-        item->setToolTip(qMRMLSegmentsTableView::terminologyTooltipForSegment(segment));
         }
       // Set color
       double* colorArray = segment->GetColor();
@@ -674,9 +672,6 @@ void qMRMLSegmentsModel::updateSegmentFromItemData(QString segmentID, QStandardI
       // Set name auto-generated flag
       segment->SetNameAutoGenerated(
         item->data(qSlicerTerminologyItemDelegate::NameAutoGeneratedRole).toBool());
-
-      // Update tooltip
-      item->setToolTip(qMRMLSegmentsTableView::terminologyTooltipForSegment(segment));
       }
     // Opacity changed
     else if (item->column() == this->opacityColumn())
@@ -707,14 +702,19 @@ void qMRMLSegmentsModel::updateItemsFromColumnIndex(int column)
     return;
     }
 
-  std::vector<std::string> segmentIDs;
-  d->SegmentationNode->GetSegmentation()->GetSegmentIDs(segmentIDs);
-  for (std::string segmentID : segmentIDs)
+  if (!d->SegmentationNode || column >= this->columnCount())
     {
-    QStandardItem* item = this->itemFromSegmentID(segmentID.c_str(), column);
-    if (item)
+    return;
+    }
+
+  // Rows are visited directly instead of looking up each segment
+  for (int row = 0; row < this->rowCount(); ++row)
+    {
+    QString segmentID = this->segmentIDFromItem(this->item(row, 0));
+    QStandardItem* item = this->item(row, column);
+    if (item && !segmentID.isEmpty())
       {
-      this->updateItemFromSegment(item, segmentID.c_str(), column);
+      this->updateItemFromSegment(item, segmentID, column);
       }
     }
 }
@@ -808,6 +808,7 @@ void qMRMLSegmentsModel::onSegmentAdded(QString segmentID)
       }
     d->insertSegment(currentSegmentID.c_str());
     }
+  d->NumberOfLayers = d->SegmentationNode->GetSegmentation()->GetNumberOfLayers();
   this->updateItemsFromColumnIndex(this->layerColumn());
 }
 
@@ -818,7 +819,11 @@ void qMRMLSegmentsModel::onSegmentRemoved(QString removedSegmentID)
   if (!removedSegmentID.isEmpty())
     {
     QModelIndex index = this->indexFromSegmentID(removedSegmentID);
-    this->removeRow(index.row());
+    d->SegmentItems.remove(removedSegmentID);
+    if (index.isValid())
+      {
+      this->removeRow(index.row());
+      }
     return;
     }
 
@@ -833,17 +838,27 @@ void qMRMLSegmentsModel::onSegmentRemoved(QString removedSegmentID)
     std::vector<std::string>::iterator currentSegmentIt = std::find(segmentIDs.begin(), segmentIDs.end(), currentSegmentID);
     if (currentSegmentIt == segmentIDs.end())
       {
+      d->SegmentItems.remove(QString::fromStdString(currentSegmentID));
       this->removeRow(index.row());
       }
     }
+  d->NumberOfLayers = d->SegmentationNode->GetSegmentation()->GetNumberOfLayers();
   this->updateItemsFromColumnIndex(this->layerColumn());
 }
 
 //------------------------------------------------------------------------------
 void qMRMLSegmentsModel::onSegmentModified(QString segmentID)
 {
+  Q_D(qMRMLSegmentsModel);
+  // Only the row of the modified segment is updated. Layer index of other segments
+  // may only change if layers were added or removed.
   this->updateItemsFromSegmentID(segmentID);
-  this->updateItemsFromColumnIndex(this->layerColumn());
+  int numberOfLayers = d->SegmentationNode ? d->SegmentationNode->GetSegmentation()->GetNumberOfLayers() : -1;
+  if (numberOfLayers != d->NumberOfLayers)
+    {
+    d->NumberOfLayers = numberOfLayers;
+    this->updateItemsFromColumnIndex(this->layerColumn());
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -1031,6 +1046,23 @@ int qMRMLSegmentsModel::maxColumnId()const
   return maxId;
 }
 
+//------------------------------------------------------------------------------
+QVariant qMRMLSegmentsModel::data(const QModelIndex& index, int role)const
+{
+  Q_D(const qMRMLSegmentsModel);
+  if (role == Qt::ToolTipRole && index.isValid() && index.column() == this->colorColumn()
+    && d->SegmentationNode && d->SegmentationNode->GetSegmentation())
+    {
+    QString segmentID = this->segmentIDFromIndex(index);
+    vtkSegment* segment = d->SegmentationNode->GetSegmentation()->GetSegment(segmentID.toStdString());
+    if (segment)
+      {
+      return qMRMLSegmentsModel::terminologyTooltipForSegment(segment);
+      }
+    }
+  return this->Superclass::data(index, role);
+}
+
 // --------------------------------------------------------------------------
 QString qMRMLSegmentsModel::terminologyTooltipForSegment(vtkSegment* segment)
 {
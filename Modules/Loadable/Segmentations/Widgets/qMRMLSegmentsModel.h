@@ -109,6 +109,10 @@ public:
   /// Assemble terminology info string (for tooltips) from a segment's terminology tags
   Q_INVOKABLE static QString terminologyTooltipForSegment(vtkSegment* segment);
 
+  /// Reimplemented to assemble the terminology tooltip of the color column only
+  /// when it is requested (e.g., when hovering), not each time a row is updated.
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole)const override;
+
 signals:
   /// Emitted when a segment property (e.g., name) is about to be changed.
   /// Can be used for capturing the current state of the segment, before it is modified.
@@ -34,6 +34,7 @@
 
 // Qt includes
 #include <QFlags>
+#include <QHash>
 #include <QMap>
 
 // Segmentations includes
@@ -93,6 +94,13 @@ public:
 
   /// Segmentation node
   vtkSmartPointer<vtkMRMLSegmentationNode> SegmentationNode;
+
+  /// First column item of each segment, for fast lookup by segment ID
+  QHash<QString, QStandardItem*> SegmentItems;
+
+  /// Number of layers when the layer column was last updated.
+  /// Layer indices of other segments only need to be updated if it changes.
+  int NumberOfLayers;
 };
 
 #endif
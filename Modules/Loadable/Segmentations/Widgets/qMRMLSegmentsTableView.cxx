@@ -274,7 +274,9 @@ void qMRMLSegmentsTableViewPrivate::init()
   this->SegmentsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
   this->SegmentsTable->horizontalHeader()->setSectionResizeMode(this->Model->nameColumn(), QHeaderView::Stretch);
   this->SegmentsTable->horizontalHeader()->setStretchLastSection(false);
-  this->SegmentsTable->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+  // All rows have the same height. Fixed size avoids computing the size hint of every cell
+  // of every row whenever a segment is modified, which is slow when there are many segments.
+  this->SegmentsTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
 
   // Select rows
   this->SegmentsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
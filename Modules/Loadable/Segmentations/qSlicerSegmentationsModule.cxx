@@ -184,7 +184,11 @@ void qSlicerSegmentationsModule::setup()
   // Use the displayable manager class to make sure the the containing library is loaded
   vtkSmartPointer<vtkMRMLSegmentationsDisplayableManager3D> dm3d = vtkSmartPointer<vtkMRMLSegmentationsDisplayableManager3D>::New();
   vtkSmartPointer<vtkMRMLSegmentationsDisplayableManager2D> dm2d = vtkSmartPointer<vtkMRMLSegmentationsDisplayableManager2D>::New();
-  // Register displayable managers
+  // Register displayable managers. They are only instantiated in views when the scene contains segmentation display nodes.
+  vtkMRMLThreeDViewDisplayableManagerFactory::GetInstance()->AddDisplayableManagerHandledNodeClass(
+    "vtkMRMLSegmentationsDisplayableManager3D", "vtkMRMLSegmentationDisplayNode");
+  vtkMRMLSliceViewDisplayableManagerFactory::GetInstance()->AddDisplayableManagerHandledNodeClass(
+    "vtkMRMLSegmentationsDisplayableManager2D", "vtkMRMLSegmentationDisplayNode");
   vtkMRMLThreeDViewDisplayableManagerFactory::GetInstance()->RegisterDisplayableManager("vtkMRMLSegmentationsDisplayableManager3D");
   vtkMRMLSliceViewDisplayableManagerFactory::GetInstance()->RegisterDisplayableManager("vtkMRMLSegmentationsDisplayableManager2D");
 
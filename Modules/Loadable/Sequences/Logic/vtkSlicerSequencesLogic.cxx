@@ -25,6 +25,7 @@
 #include "vtkMRMLSequenceBrowserNode.h"
 #include "vtkMRMLSequenceNode.h"
 #include "vtkMRMLSequenceStorageNode.h"
+#include "vtkMRMLStreamingVolumeSequenceStorageNode.h"
 #include "vtkMRMLVolumeSequenceStorageNode.h"
 
 // MRML includes
@@ -36,6 +37,8 @@
 #include "vtkMRMLModelNode.h"
 #include "vtkMRMLScalarVolumeNode.h"
 #include "vtkMRMLScene.h"
+#include "vtkMRMLStreamingVolumeNode.h"
+#include "vtkMRMLTraceRecorder.h"
 #include "vtkMRMLTransformNode.h"
 #ifdef ENABLE_PERFORMANCE_PROFILING
 #include "vtkTimerLog.h"
@@ -51,23 +54,249 @@
 #include <vtkTimerLog.h>
 #include <vtksys/SystemTools.hxx>
 
+// vtkAddon includes
+#include <vtkStreamingVolumeCodec.h>
+#include <vtkStreamingVolumeCodecFactory.h>
+
 // STL includes
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+
+//----------------------------------------------------------------------------
+/// Decodes streaming volume frames in a background thread during playback.
+/// Requests are processed in order, which allows codecs to decode consecutive
+/// non-key frames incrementally. Each sequence has its own codec instance,
+/// which is only used by the worker thread.
+class vtkSlicerSequencesLogic::vtkInternal
+{
+public:
+  vtkInternal() = default;
+  ~vtkInternal()
+    {
+    this->StopThread();
+    }
+
+  struct PrefetchRequest
+    {
+    vtkMRMLSequenceBrowserNode* BrowserNode{nullptr};
+    vtkSmartPointer<vtkStreamingVolumeFrame> Frame;
+    vtkSmartPointer<vtkStreamingVolumeCodec> Codec;
+    };
+
+  struct PrefetchResult
+    {
+    vtkMRMLSequenceBrowserNode* BrowserNode{nullptr};
+    // Frame is kept here to make sure the pointer used as key remains valid
+    vtkSmartPointer<vtkStreamingVolumeFrame> Frame;
+    vtkSmartPointer<vtkImageData> ImageData;
+    };
+
+  //----------------------------------------------------------------------------
+  vtkStreamingVolumeCodec* GetCodec(vtkMRMLSequenceNode* sequenceNode, vtkStreamingVolumeFrame* frame)
+    {
+    vtkSmartPointer<vtkStreamingVolumeCodec>& codec = this->Codecs[sequenceNode];
+    if (!codec || codec->GetFourCC() != frame->GetCodecFourCC())
+      {
+      codec = vtkSmartPointer<vtkStreamingVolumeCodec>::Take(
+        vtkStreamingVolumeCodecFactory::GetInstance()->CreateCodecByFourCC(frame->GetCodecFourCC()));
+      }
+    return codec;
+    }
 
+  //----------------------------------------------------------------------------
+  /// Request decoding of the frames (in the order they will be displayed) for a browser node.
+  /// Previous requests and results of the browser node that are not in the list are discarded.
+  void SetRequestedFrames(vtkMRMLSequenceBrowserNode* browserNode, const std::vector<PrefetchRequest>& requests)
+    {
+    std::set<vtkStreamingVolumeFrame*> requestedFrames;
+    bool newRequest = false;
+      {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      for (const PrefetchRequest& request : requests)
+        {
+        requestedFrames.insert(request.Frame);
+        if (this->Results.find(request.Frame) != this->Results.end())
+          {
+          // already requested
+          continue;
+          }
+        PrefetchResult& result = this->Results[request.Frame];
+        result.BrowserNode = browserNode;
+        result.Frame = request.Frame;
+        this->Queue.push_back(request);
+        this->Queue.back().BrowserNode = browserNode;
+        newRequest = true;
+        }
+      for (auto resultIt = this->Results.begin(); resultIt != this->Results.end();)
+        {
+        if (resultIt->second.BrowserNode == browserNode
+          && requestedFrames.find(resultIt->first) == requestedFrames.end())
+          {
+          resultIt = this->Results.erase(resultIt);
+          }
+        else
+          {
+          ++resultIt;
+          }
+        }
+      this->Queue.erase(std::remove_if(this->Queue.begin(), this->Queue.end(),
+        [browserNode, &requestedFrames](const PrefetchRequest& request)
+          {
+          return request.BrowserNode == browserNode
+            && requestedFrames.find(request.Frame) == requestedFrames.end();
+          }),
+        this->Queue.end());
+      }
+    if (newRequest)
+      {
+      this->StartThread();
+      this->Condition.notify_one();
+      }
+    }
+
+  //----------------------------------------------------------------------------
+  /// Returns the decoded image of the frame and removes it from the results.
+  /// Returns nullptr if the frame has not been decoded (yet).
+  vtkSmartPointer<vtkImageData> TakeDecodedImageData(vtkStreamingVolumeFrame* frame)
+    {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto resultIt = this->Results.find(frame);
+    if (resultIt == this->Results.end() || !resultIt->second.ImageData)
+      {
+      return nullptr;
+      }
+    vtkSmartPointer<vtkImageData> imageData = resultIt->second.ImageData;
+    this->Results.erase(resultIt);
+    return imageData;
+    }
+
+  //----------------------------------------------------------------------------
+  void Clear()
+    {
+      {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Queue.clear();
+      this->Results.clear();
+      }
+    this->Codecs.clear();
+    }
+
+  //----------------------------------------------------------------------------
+  void RemoveSequence(vtkMRMLSequenceNode* sequenceNode)
+    {
+    this->Codecs.erase(sequenceNode);
+    }
+
+protected:
+  //----------------------------------------------------------------------------
+  void StartThread()
+    {
+    if (this->Thread.joinable())
+      {
+      return;
+      }
+    this->AbortThread = false;
+    this->Thread = std::thread(&vtkInternal::ProcessRequests, this);
+    }
+
+  //----------------------------------------------------------------------------
+  void StopThread()
+    {
+    if (!this->Thread.joinable())
+      {
+      return;
+      }
+      {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->AbortThread = true;
+      this->Queue.clear();
+      }
+    this->Condition.notify_one();
+    this->Thread.join();
+    }
+
+  //----------------------------------------------------------------------------
+  void ProcessRequests()
+    {
+    while (true)
+      {
+      PrefetchRequest request;
+        {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->Condition.wait(lock, [this] { return this->AbortThread || !this->Queue.empty(); });
+        if (this->AbortThread)
+          {
+          return;
+          }
+        request = this->Queue.front();
+        this->Queue.pop_front();
+        }
+
+      vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+      int frameDimensions[3] = { 0, 0, 0 };
+      request.Frame->GetDimensions(frameDimensions);
+      imageData->SetDimensions(frameDimensions);
+      imageData->AllocateScalars(request.Frame->GetVTKScalarType(), request.Frame->GetNumberOfComponents());
+      if (!request.Codec || !request.Codec->DecodeFrame(request.Frame, imageData))
+        {
+        // the frame will be decoded when it is displayed
+        imageData = nullptr;
+        }
+
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto resultIt = this->Results.find(request.Frame);
+      if (resultIt == this->Results.end())
+        {
+        // the request has been cancelled
+        continue;
+        }
+      if (imageData)
+        {
+        resultIt->second.ImageData = imageData;
+        }
+      else
+        {
+        this->Results.erase(resultIt);
+        }
+      }
+    }
+
+  std::map<vtkMRMLSequenceNode*, vtkSmartPointer<vtkStreamingVolumeCodec> > Codecs;
+
+  /// Members below are shared with the worker thread and protected by Mutex
+  std::deque<PrefetchRequest> Queue;
+  std::map<vtkStreamingVolumeFrame*, PrefetchResult> Results;
+  bool AbortThread{false};
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::thread Thread;
+};
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSlicerSequencesLogic);
 
 //----------------------------------------------------------------------------
-vtkSlicerSequencesLogic::vtkSlicerSequencesLogic() = default;
+vtkSlicerSequencesLogic::vtkSlicerSequencesLogic()
+{
+  this->Internal = new vtkInternal;
+}
 
 //----------------------------------------------------------------------------
-vtkSlicerSequencesLogic::~vtkSlicerSequencesLogic() = default;
+vtkSlicerSequencesLogic::~vtkSlicerSequencesLogic()
+{
+  delete this->Internal;
+}
 
 //----------------------------------------------------------------------------
 void vtkSlicerSequencesLogic::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "PlaybackPrefetchItemCount: " << this->PlaybackPrefetchItemCount << "\n";
 }
 
 //---------------------------------------------------------------------------
@@ -134,6 +363,10 @@ void vtkSlicerSequencesLogic::OnMRMLSceneNodeRemoved(vtkMRMLNode* node)
     vtkDebugMacro("OnMRMLSceneNodeRemoved: Have a vtkMRMLSequenceBrowserNode node");
     vtkUnObserveMRMLNodeMacro(node);
     }
+  else if (node->IsA("vtkMRMLSequenceNode"))
+    {
+    this->Internal->RemoveSequence(vtkMRMLSequenceNode::SafeDownCast(node));
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -146,6 +379,8 @@ vtkMRMLSequenceNode* vtkSlicerSequencesLogic::AddSequence(const char* filename,
   vtkNew<vtkMRMLSequenceNode> sequenceNode;
   vtkNew<vtkMRMLSequenceStorageNode> sequenceStorageNode;
   vtkNew<vtkMRMLVolumeSequenceStorageNode> volumeSequenceStorageNode;
+  vtkNew<vtkMRMLLinearTransformSequenceStorageNode> linearTransformSequenceStorageNode;
+  vtkNew<vtkMRMLStreamingVolumeSequenceStorageNode> streamingVolumeSequenceStorageNode;
 
   vtkMRMLStorageNode* storageNode = nullptr;
   if (sequenceStorageNode->SupportedFileType(filename))
@@ -156,6 +391,14 @@ vtkMRMLSequenceNode* vtkSlicerSequencesLogic::AddSequence(const char* filename,
     {
     storageNode = volumeSequenceStorageNode;
     }
+  else if(linearTransformSequenceStorageNode->SupportedFileType(filename))
+    {
+    storageNode = linearTransformSequenceStorageNode;
+    }
+  else if(streamingVolumeSequenceStorageNode->SupportedFileType(filename))
+    {
+    storageNode = streamingVolumeSequenceStorageNode;
+    }
   else
     {
     vtkErrorToMessageCollectionMacro(userMessages, "vtkSlicerSequencesLogic::AddSequence",
@@ -229,6 +472,73 @@ vtkMRMLSequenceNode* vtkSlicerSequencesLogic::AddSequence(const char* filename,
   return sequenceNode.GetPointer();
 }
 
+//---------------------------------------------------------------------------
+bool vtkSlicerSequencesLogic::EncodeVolumeSequence(vtkMRMLSequenceNode* sequenceNode, const std::string& codecFourCC,
+  const std::string& codecParameters/*=""*/, int keyFrameInterval/*=30*/, vtkMRMLMessageCollection* userMessages/*=nullptr*/)
+{
+  if (!sequenceNode)
+    {
+    vtkErrorToMessageCollectionMacro(userMessages, "vtkSlicerSequencesLogic::EncodeVolumeSequence",
+      "Invalid sequence node");
+    return false;
+    }
+  // The same codec is used for all the frames, as non-key frames are encoded as differences from the preceding frames
+  vtkSmartPointer<vtkStreamingVolumeCodec> codec = vtkSmartPointer<vtkStreamingVolumeCodec>::Take(
+    vtkStreamingVolumeCodecFactory::GetInstance()->CreateCodecByFourCC(codecFourCC));
+  if (!codec)
+    {
+    vtkErrorToMessageCollectionMacro(userMessages, "vtkSlicerSequencesLogic::EncodeVolumeSequence",
+      "Could not find codec \"" << codecFourCC << "\"");
+    return false;
+    }
+  if (!codecParameters.empty())
+    {
+    codec->SetParametersFromString(codecParameters);
+    }
+
+  MRMLNodeModifyBlocker blocker(sequenceNode);
+  vtkSmartPointer<vtkStreamingVolumeFrame> previousFrame;
+  int numberOfItems = sequenceNode->GetNumberOfDataNodes();
+  for (int itemIndex = 0; itemIndex < numberOfItems; ++itemIndex)
+    {
+    vtkMRMLVolumeNode* volumeNode = vtkMRMLVolumeNode::SafeDownCast(sequenceNode->GetNthDataNode(itemIndex));
+    vtkImageData* imageData = volumeNode ? volumeNode->GetImageData() : nullptr;
+    if (!imageData)
+      {
+      vtkErrorToMessageCollectionMacro(userMessages, "vtkSlicerSequencesLogic::EncodeVolumeSequence",
+        "Item " << itemIndex << " of sequence " << (sequenceNode->GetName() ? sequenceNode->GetName() : "") << " is not a volume");
+      return false;
+      }
+    vtkNew<vtkMRMLStreamingVolumeNode> streamingVolumeNode;
+    streamingVolumeNode->SetName(volumeNode->GetName());
+    vtkNew<vtkMatrix4x4> ijkToRasMatrix;
+    volumeNode->GetIJKToRASMatrix(ijkToRasMatrix);
+    streamingVolumeNode->SetIJKToRASMatrix(ijkToRasMatrix);
+    streamingVolumeNode->SetCodecFourCC(codecFourCC);
+    streamingVolumeNode->SetCodec(codec);
+    streamingVolumeNode->SetAndObserveImageData(imageData);
+    bool forceKeyFrame = (keyFrameInterval > 0 && itemIndex % keyFrameInterval == 0);
+    if (!streamingVolumeNode->EncodeImageData(forceKeyFrame))
+      {
+      vtkErrorToMessageCollectionMacro(userMessages, "vtkSlicerSequencesLogic::EncodeVolumeSequence",
+        "Failed to encode item " << itemIndex << " with codec \"" << codecFourCC << "\"");
+      return false;
+      }
+    vtkStreamingVolumeFrame* frame = streamingVolumeNode->GetFrame();
+    if (!frame->IsKeyFrame() && !frame->GetPreviousFrame())
+      {
+      // Decoding of the frame starts from the last keyframe and goes through the preceding frames
+      frame->SetPreviousFrame(previousFrame);
+      }
+    previousFrame = frame;
+    // Only the compressed frame is kept in memory
+    streamingVolumeNode->ReleaseDecodedImageData();
+    // Replace the item, so that the memory of the original volume is released right away
+    sequenceNode->SetDataNodeAtValue(streamingVolumeNode, sequenceNode->GetNthIndexValue(itemIndex), false);
+    }
+  return true;
+}
+
 //---------------------------------------------------------------------------
 void vtkSlicerSequencesLogic::UpdateAllProxyNodes()
 {
@@ -242,6 +552,7 @@ void vtkSlicerSequencesLogic::UpdateAllProxyNodes()
     }
   std::vector< vtkMRMLNode* > browserNodes;
   int numBrowserNodes = this->GetMRMLScene()->GetNodesByClass("vtkMRMLSequenceBrowserNode", browserNodes);
+  bool playbackActive = false;
   for (int i = 0; i < numBrowserNodes; i++)
     {
     vtkMRMLSequenceBrowserNode* browserNode = vtkMRMLSequenceBrowserNode::SafeDownCast(browserNodes[i]);
@@ -250,11 +561,17 @@ void vtkSlicerSequencesLogic::UpdateAllProxyNodes()
       vtkErrorMacro("Browser node is invalid");
       continue;
       }
+    if (browserNode->GetNumberOfBufferedRecordingItems() > 0)
+      {
+      // Add proxy node states that were recorded since the last update
+      browserNode->FlushRecordingBuffer();
+      }
     if (!browserNode->GetPlaybackActive())
       {
       this->LastSequenceBrowserUpdateTimeSec.erase(browserNode);
       continue;
       }
+    playbackActive = true;
     if ( this->LastSequenceBrowserUpdateTimeSec.find(browserNode) == this->LastSequenceBrowserUpdateTimeSec.end() )
       {
       // we just started to play now, no need to update output nodes yet
@@ -276,11 +593,17 @@ void vtkSlicerSequencesLogic::UpdateAllProxyNodes()
       browserNode->SelectNextItem(selectionIncrement);
       }
     }
+  if (!playbackActive)
+    {
+    // Release prefetched items
+    this->Internal->Clear();
+    }
 }
 
 //---------------------------------------------------------------------------
 void vtkSlicerSequencesLogic::UpdateProxyNodesFromSequences(vtkMRMLSequenceBrowserNode* browserNode)
 {
+  vtkMRMLTraceScopeMacro("vtkSlicerSequencesLogic::UpdateProxyNodesFromSequences");
 #ifdef ENABLE_PERFORMANCE_PROFILING
   vtkNew<vtkTimerLog> timer;
   timer->StartTimer();
@@ -320,9 +643,11 @@ void vtkSlicerSequencesLogic::UpdateProxyNodesFromSequences(vtkMRMLSequenceBrows
 
   int selectedItemNumber=browserNode->GetSelectedItemNumber();
   std::string indexValue("0");
+  double numericIndexValue = 0.0;
   if (selectedItemNumber >= 0 && selectedItemNumber < browserNode->GetNumberOfItems())
     {
     indexValue=browserNode->GetMasterSequenceNode()->GetNthIndexValue(selectedItemNumber);
+    numericIndexValue = browserNode->GetMasterSequenceNode()->GetNthNumericIndexValue(selectedItemNumber);
     }
 
   std::vector< vtkMRMLSequenceNode* > synchronizedSequenceNodes;
@@ -377,7 +702,15 @@ void vtkSlicerSequencesLogic::UpdateProxyNodesFromSequences(vtkMRMLSequenceBrows
     else
       {
       // we just want to show a node, therefore we can just use closest data node
-      sourceDataNode = synchronizedSequenceNode->GetDataNodeAtValue(indexValue, false /*closest match*/);
+      if (synchronizedSequenceNode->GetIndexType() == vtkMRMLSequenceNode::NumericIndex)
+        {
+        // avoid converting index values to/from string during playback
+        sourceDataNode = synchronizedSequenceNode->GetDataNodeAtNumericIndexValue(numericIndexValue, false /*closest match*/);
+        }
+      else
+        {
+        sourceDataNode = synchronizedSequenceNode->GetDataNodeAtValue(indexValue, false /*closest match*/);
+        }
       }
     if (sourceDataNode==nullptr)
       {
@@ -420,6 +753,13 @@ void vtkSlicerSequencesLogic::UpdateProxyNodesFromSequences(vtkMRMLSequenceBrows
     // TODO: if we really want to force non-mutable nodes in the sequence then we have to deep-copy, but that's slow.
     // Make sure that by default/most of the time shallow-copy is used.
     bool shallowCopy = browserNode->GetSaveChanges(synchronizedSequenceNode);
+    vtkMRMLStreamingVolumeNode* sourceStreamingVolumeNode = vtkMRMLStreamingVolumeNode::SafeDownCast(sourceDataNode);
+    if (sourceStreamingVolumeNode && sourceStreamingVolumeNode->GetFrame())
+      {
+      // If the frame has been decoded ahead, then the proxy node takes over the decoded image
+      sourceStreamingVolumeNode->SetPrefetchedImageData(sourceStreamingVolumeNode->GetFrame(),
+        this->Internal->TakeDecodedImageData(sourceStreamingVolumeNode->GetFrame()));
+      }
     targetProxyNode->CopyContent(sourceDataNode, !shallowCopy);
 
     // Singleton nodes must not be renamed, as they are often expected to exist by a specific name
@@ -471,12 +811,82 @@ void vtkSlicerSequencesLogic::UpdateProxyNodesFromSequences(vtkMRMLSequenceBrows
 
   this->UpdateProxyNodesFromSequencesInProgress = false;
 
+  if (browserNode->GetPlaybackActive())
+    {
+    this->UpdatePlaybackPrefetch(browserNode);
+    }
+
 #ifdef ENABLE_PERFORMANCE_PROFILING
   timer->StopTimer();
   vtkInfoMacro("UpdateProxyNodesFromSequences: " << timer->GetElapsedTime() << "sec\n");
 #endif
 }
 
+//---------------------------------------------------------------------------
+void vtkSlicerSequencesLogic::UpdatePlaybackPrefetch(vtkMRMLSequenceBrowserNode* browserNode)
+{
+  std::vector<vtkInternal::PrefetchRequest> requests;
+  vtkMRMLSequenceNode* masterSequenceNode = browserNode->GetMasterSequenceNode();
+  int numberOfItems = browserNode->GetNumberOfItems();
+  int selectedItemNumber = browserNode->GetSelectedItemNumber();
+  if (this->PlaybackPrefetchItemCount <= 0 || !masterSequenceNode || numberOfItems <= 1 || selectedItemNumber < 0)
+    {
+    this->Internal->SetRequestedFrames(browserNode, requests);
+    return;
+    }
+  int direction = (browserNode->GetPlaybackRateFps() < 0) ? -1 : 1;
+
+  std::vector< vtkMRMLSequenceNode* > synchronizedSequenceNodes;
+  browserNode->GetSynchronizedSequenceNodes(synchronizedSequenceNodes, true);
+  for (int prefetchItem = 1; prefetchItem <= this->PlaybackPrefetchItemCount; ++prefetchItem)
+    {
+    int itemNumber = selectedItemNumber + direction * prefetchItem;
+    if (itemNumber < 0 || itemNumber >= numberOfItems)
+      {
+      if (!browserNode->GetPlaybackLooped())
+        {
+        break;
+        }
+      itemNumber = (itemNumber % numberOfItems + numberOfItems) % numberOfItems;
+      }
+    if (itemNumber == selectedItemNumber)
+      {
+      // all items are requested already
+      break;
+      }
+    for (vtkMRMLSequenceNode* synchronizedSequenceNode : synchronizedSequenceNodes)
+      {
+      if (!synchronizedSequenceNode || !browserNode->GetPlayback(synchronizedSequenceNode)
+        || browserNode->GetSaveChanges(synchronizedSequenceNode))
+        {
+        continue;
+        }
+      // Same data node lookup as in UpdateProxyNodesFromSequences
+      vtkMRMLNode* dataNode = nullptr;
+      if (synchronizedSequenceNode->GetIndexType() == vtkMRMLSequenceNode::NumericIndex)
+        {
+        dataNode = synchronizedSequenceNode->GetDataNodeAtNumericIndexValue(
+          masterSequenceNode->GetNthNumericIndexValue(itemNumber), false /*closest match*/);
+        }
+      else
+        {
+        dataNode = synchronizedSequenceNode->GetDataNodeAtValue(
+          masterSequenceNode->GetNthIndexValue(itemNumber), false /*closest match*/);
+        }
+      vtkMRMLStreamingVolumeNode* streamingVolumeNode = vtkMRMLStreamingVolumeNode::SafeDownCast(dataNode);
+      if (!streamingVolumeNode || !streamingVolumeNode->GetFrame())
+        {
+        continue;
+        }
+      vtkInternal::PrefetchRequest request;
+      request.Frame = streamingVolumeNode->GetFrame();
+      request.Codec = this->Internal->GetCodec(synchronizedSequenceNode, request.Frame);
+      requests.push_back(request);
+      }
+    }
+  this->Internal->SetRequestedFrames(browserNode, requests);
+}
+
 //---------------------------------------------------------------------------
 void vtkSlicerSequencesLogic::UpdateSequencesFromProxyNodes(vtkMRMLSequenceBrowserNode* browserNode, vtkMRMLNode* proxyNode)
 {
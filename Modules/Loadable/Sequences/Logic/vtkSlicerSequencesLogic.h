@@ -57,12 +57,36 @@ public:
   /// specified.
   vtkMRMLSequenceNode* AddSequence(const char* filename, vtkMRMLMessageCollection* userMessages=nullptr);
 
+  /// Replace the volumes of a sequence by streaming volumes that store compressed frames.
+  /// Only the compressed frames are kept in memory, frames are decoded when they are displayed
+  /// (during playback the next frames can be decoded in the background, see PlaybackPrefetchItemCount).
+  /// Storage nodes that are created for the sequence after this save the compressed frames (.seq.evs).
+  /// \param codecFourCC FourCC of the codec that is used for compressing the frames.
+  ///   Available codecs are provided by vtkStreamingVolumeCodecFactory.
+  /// \param codecParameters Parameters of the codec, in the format of vtkStreamingVolumeCodec::SetParametersFromString.
+  /// \param keyFrameInterval Every keyFrameInterval-th frame is compressed as a keyframe,
+  ///   which limits the number of frames that need to be decoded when seeking to a frame.
+  ///   If 0 then keyframes are chosen by the codec.
+  /// User-displayable warning or error messages can be received if userMessages object is specified.
+  /// 
+eturn True on success.
+  bool EncodeVolumeSequence(vtkMRMLSequenceNode* sequenceNode, const std::string& codecFourCC,
+    const std::string& codecParameters = "", int keyFrameInterval = 30, vtkMRMLMessageCollection* userMessages = nullptr);
+
   /// Refreshes the output of all the active browser nodes. Called regularly by a timer.
   void UpdateAllProxyNodes();
 
   /// Updates the contents of all the proxy nodes (all the nodes copied from the master and synchronized sequences to the scene)
   void UpdateProxyNodesFromSequences(vtkMRMLSequenceBrowserNode* browserNode);
 
+  /// Number of items that are prepared ahead of time in a background thread during playback.
+  /// Items are prefetched in the play direction (determined by the sign of the playback rate).
+  /// Currently compressed frames of streaming volume sequences are decoded ahead,
+  /// so that updating the proxy node only requires swapping the image data.
+  /// 0 (default) disables prefetching.
+  vtkSetClampMacro(PlaybackPrefetchItemCount, int, 0, 1000);
+  vtkGetMacro(PlaybackPrefetchItemCount, int);
+
   /// Updates the sequence from a changed proxy node (if saving of state changes is allowed)
   void UpdateSequencesFromProxyNodes(vtkMRMLSequenceBrowserNode* browserNode, vtkMRMLNode* proxyNode);
 
@@ -119,6 +143,9 @@ protected:
 
   bool IsDataConnectorNode(vtkMRMLNode*);
 
+  /// Request decoding of the items that will be displayed next during playback
+  void UpdatePlaybackPrefetch(vtkMRMLSequenceBrowserNode* browserNode);
+
   // Time of the last update of each browser node (in universal time)
   std::map< vtkMRMLSequenceBrowserNode*, double > LastSequenceBrowserUpdateTimeSec;
 
@@ -126,6 +153,10 @@ private:
 
   bool UpdateProxyNodesFromSequencesInProgress{false};
   bool UpdateSequencesFromProxyNodesInProgress{false};
+  int PlaybackPrefetchItemCount{0};
+
+  class vtkInternal;
+  vtkInternal* Internal;
 
   vtkSlicerSequencesLogic(const vtkSlicerSequencesLogic&); // Not implemented
   void operator=(const vtkSlicerSequencesLogic&);               // Not implemented
@@ -39,6 +39,7 @@
 #include <vtksys/RegularExpression.hxx>
 #include <vtkTimerLog.h>
 #include <vtkVariant.h>
+#include <vtkWeakPointer.h>
 
 // STD includes
 #include <sstream>
@@ -142,6 +143,7 @@ void vtkMRMLSequenceBrowserNode::WriteXML(ostream& of, int nIndent)
   of << indent << " selectedItemNumber=\"" << this->SelectedItemNumber << "\"";
   of << indent << " recordingActive=\"" << (this->RecordingActive ? "true" : "false") << "\"";
   of << indent << " recordOnMasterModifiedOnly=\"" << (this->RecordMasterOnly ? "true" : "false") << "\"";
+  of << indent << " recordingBatchSize=\"" << this->RecordingBatchSize << "\"";
 
   std::string recordingSamplingModeString = this->GetRecordingSamplingModeAsString();
   if (!recordingSamplingModeString.empty())
@@ -264,6 +266,14 @@ void vtkMRMLSequenceBrowserNode::ReadXMLAttributes(const char** atts)
         this->SetRecordMasterOnly(0);
         }
       }
+    else if (!strcmp(attName, "recordingBatchSize"))
+      {
+      std::stringstream ss;
+      ss << attValue;
+      int recordingBatchSize = 1;
+      ss >> recordingBatchSize;
+      this->SetRecordingBatchSize(recordingBatchSize);
+      }
     else if (!strcmp(attName, "recordingSamplingMode"))
       {
       int recordingSamplingMode = this->GetRecordingSamplingModeFromString(attValue);
@@ -364,6 +374,7 @@ void vtkMRMLSequenceBrowserNode::Copy(vtkMRMLNode *anode)
   this->SetPlaybackLooped(node->GetPlaybackLooped());
   this->SetRecordMasterOnly(node->GetRecordMasterOnly());
   this->SetRecordingSamplingMode(node->GetRecordingSamplingMode());
+  this->SetRecordingBatchSize(node->GetRecordingBatchSize());
   this->SetIndexDisplayMode(node->GetIndexDisplayMode());
   this->SetIndexDisplayFormat(node->GetIndexDisplayFormat());
   this->SetRecordingActive(node->GetRecordingActive());
@@ -387,6 +398,8 @@ void vtkMRMLSequenceBrowserNode::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << " Recording active: " << (this->RecordingActive ? "true" : "false") << '\n';
   os << indent << " Recording on master modified only: " << (this->RecordMasterOnly ? "true" : "false") << '\n';
   os << indent << " Recording sampling mode: " << this->GetRecordingSamplingModeAsString() << "\n";
+  os << indent << " Recording batch size: " << this->RecordingBatchSize << "\n";
+  os << indent << " Number of buffered recording items: " << this->RecordingBuffer.size() << "\n";
   os << indent << " Index display mode: " << this->GetIndexDisplayModeAsString() << "\n";
   os << indent << " Index display format: " << this->GetIndexDisplayFormat() << "\n";
 
@@ -956,6 +969,8 @@ void vtkMRMLSequenceBrowserNode::GetSynchronizedSequenceNodes(vtkCollection* syn
 //---------------------------------------------------------------------------
 void vtkMRMLSequenceBrowserNode::SetRecordingActive(bool recording)
 {
+  // Add all recorded states, as the time offset is computed from the last item
+  this->FlushRecordingBuffer();
   // Before activating the recording, set the initial timestamp to be correct
   this->RecordingTimeOffsetSec = vtkTimerLog::GetUniversalTime();
   int numberOfItems = this->GetNumberOfItems();
@@ -1092,6 +1107,7 @@ void vtkMRMLSequenceBrowserNode::SaveProxyNodesState()
   else
     {
     // Recording a single snapshot
+    this->FlushRecordingBuffer();
     // TODO: add support for non-numeric index type
     double lastItemTime = 0;
     int numberOfItems = this->GetNumberOfItems();
@@ -1105,10 +1121,43 @@ void vtkMRMLSequenceBrowserNode::SaveProxyNodesState()
     currTime << lastItemTime + 1.0 / playbackRateFps;
     }
 
-  // Record into each sequence
-  int wasModified = this->StartModify();
   std::vector< vtkMRMLSequenceNode* > sequenceNodes;
   this->GetSynchronizedSequenceNodes(sequenceNodes, true);
+
+  if (continuousRecording && this->RecordingBatchSize > 1)
+    {
+    // Capture the state of the proxy nodes now, but add them to the sequences later, in a batch
+    RecordingBufferItem bufferItem;
+    bufferItem.IndexValue = currTime.str();
+    for (vtkMRMLSequenceNode* sequenceNode : sequenceNodes)
+      {
+      vtkMRMLNode* proxyNode = this->GetProxyNode(sequenceNode);
+      if (!this->GetRecording(sequenceNode) || !proxyNode)
+        {
+        continue;
+        }
+      vtkSmartPointer<vtkMRMLNode> dataNode = vtkSmartPointer<vtkMRMLNode>::Take(proxyNode->CreateNodeInstance());
+      dataNode->CopyContent(proxyNode); // deep-copy
+      dataNode->SetName(proxyNode->GetName());
+      if (proxyNode->GetAttribute("Sequences.BaseName"))
+        {
+        dataNode->SetAttribute("Sequences.BaseName", proxyNode->GetAttribute("Sequences.BaseName"));
+        }
+      bufferItem.DataNodes.emplace_back(sequenceNode, dataNode);
+      }
+    if (!bufferItem.DataNodes.empty())
+      {
+      this->RecordingBuffer.push_back(bufferItem);
+      }
+    if (static_cast<int>(this->RecordingBuffer.size()) >= this->RecordingBatchSize)
+      {
+      this->FlushRecordingBuffer();
+      }
+    return;
+    }
+
+  // Record into each sequence
+  int wasModified = this->StartModify();
   bool snapshotAdded = false;
   for (std::vector< vtkMRMLSequenceNode* >::iterator it = sequenceNodes.begin(); it != sequenceNodes.end(); it++)
     {
@@ -1127,6 +1176,52 @@ void vtkMRMLSequenceBrowserNode::SaveProxyNodesState()
   this->EndModify(wasModified);
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLSequenceBrowserNode::FlushRecordingBuffer()
+{
+  if (this->RecordingBuffer.empty())
+    {
+    return;
+    }
+  // Move out the buffer first, as adding items may trigger recording of new states
+  std::deque< RecordingBufferItem > recordingBuffer;
+  recordingBuffer.swap(this->RecordingBuffer);
+
+  int wasModified = this->StartModify();
+  // Sequence node modified events are invoked once, after all the items are added
+  std::vector< vtkMRMLSequenceNode* > sequenceNodes;
+  this->GetSynchronizedSequenceNodes(sequenceNodes, true);
+  std::vector< int > sequenceNodesWasModified;
+  for (vtkMRMLSequenceNode* sequenceNode : sequenceNodes)
+    {
+    sequenceNodesWasModified.push_back(sequenceNode->StartModify());
+    }
+  bool snapshotAdded = false;
+  for (RecordingBufferItem& bufferItem : recordingBuffer)
+    {
+    for (std::pair< vtkWeakPointer<vtkMRMLSequenceNode>, vtkSmartPointer<vtkMRMLNode> >& dataNode : bufferItem.DataNodes)
+      {
+      if (!dataNode.first)
+        {
+        // sequence node has been deleted since the state was recorded
+        continue;
+        }
+      dataNode.first->SetDataNodeAtValue(dataNode.second, bufferItem.IndexValue, false);
+      snapshotAdded = true;
+      }
+    }
+  for (size_t sequenceIndex = 0; sequenceIndex < sequenceNodes.size(); ++sequenceIndex)
+    {
+    sequenceNodes[sequenceIndex]->EndModify(sequenceNodesWasModified[sequenceIndex]);
+    }
+  if (snapshotAdded)
+    {
+    this->Modified();
+    this->SelectLastItem();
+    }
+  this->EndModify(wasModified);
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLSequenceBrowserNode::OnNodeReferenceAdded(vtkMRMLNodeReference* nodeReference)
 {
@@ -29,7 +29,12 @@
 #include <vtkMRMLNode.h>
 #include <vtkNew.h>
 
+// VTK includes
+#include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
+
 // STD includes
+#include <deque>
 #include <set>
 #include <map>
 
@@ -163,6 +168,24 @@ public:
   static std::string GetRecordingSamplingModeAsString(int recordingSamplingMode);
   static int GetRecordingSamplingModeFromString(const std::string &recordingSamplingModeString);
 
+  /// Number of proxy node states that are collected during continuous recording
+  /// before they are added to the sequences at once.
+  /// Adding many items at once reduces the number of sequence and browser node modified events
+  /// (and the GUI updates they trigger), which allows recording at higher rates.
+  /// States are captured (with their timestamps) when the proxy nodes are modified, and the
+  /// collected states are also added when recording is stopped, when FlushRecordingBuffer
+  /// is called, or when the sequences module logic processes the browser nodes (a few times per second).
+  /// Default is 1 (each state is added immediately).
+  vtkGetMacro(RecordingBatchSize, int);
+  vtkSetClampMacro(RecordingBatchSize, int, 1, VTK_INT_MAX);
+
+  /// Add the proxy node states that have been recorded but not yet added to the sequences.
+  /// \sa SetRecordingBatchSize
+  void FlushRecordingBuffer();
+
+  /// Number of recorded proxy node states that have not yet been added to the sequences.
+  int GetNumberOfBufferedRecordingItems() { return static_cast<int>(this->RecordingBuffer.size()); };
+
   /// Set index display mode
   vtkSetMacro(IndexDisplayMode, int);
   void SetIndexDisplayModeFromString(const char *indexDisplayModeString);
@@ -334,6 +357,7 @@ protected:
   double LastSaveProxyNodesStateTimeSec;
   bool RecordMasterOnly{false};
   int RecordingSamplingMode{vtkMRMLSequenceBrowserNode::SamplingLimitedToPlaybackFrameRate};
+  int RecordingBatchSize{1};
   int IndexDisplayMode{vtkMRMLSequenceBrowserNode::IndexDisplayAsIndexValue};
   std::string IndexDisplayFormat;
 
@@ -344,6 +368,14 @@ protected:
   // Counter that is used for generating the unique (only for this class) proxy node postfix strings
   int LastPostfixIndex{0};
 
+  /// Proxy node states recorded at the same index value, not yet added to the sequences
+  struct RecordingBufferItem
+    {
+    std::string IndexValue;
+    std::vector< std::pair< vtkWeakPointer<vtkMRMLSequenceNode>, vtkSmartPointer<vtkMRMLNode> > > DataNodes;
+    };
+  std::deque< RecordingBufferItem > RecordingBuffer;
+
 private:
   struct SynchronizationProperties;
   std::map< std::string, SynchronizationProperties* > SynchronizationPropertiesMap;
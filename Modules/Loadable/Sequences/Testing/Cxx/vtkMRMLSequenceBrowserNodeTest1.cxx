@@ -20,19 +20,76 @@
 
 // MRML includes
 #include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLLinearTransformNode.h"
 #include "vtkMRMLScene.h"
 #include "vtkMRMLSequenceNode.h"
 #include "vtkMRMLSequenceBrowserNode.h"
 #include "vtkMRMLTransformNode.h"
 
 // VTK includes
+#include <vtkMatrix4x4.h>
 #include <vtkNew.h>
+#include <vtksys/SystemTools.hxx>
 
 double valueForIndex(int i)
 {
   return i * 1234.567890;
 }
 
+//----------------------------------------------------------------------------
+int TestRecordingBatch()
+{
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkMRMLSequenceNode> sequenceNode;
+  scene->AddNode(sequenceNode);
+  vtkNew<vtkMRMLLinearTransformNode> transformNode;
+  scene->AddNode(transformNode);
+
+  vtkNew<vtkMRMLSequenceBrowserNode> browserNode;
+  scene->AddNode(browserNode);
+  browserNode->SetAndObserveMasterSequenceNodeID(sequenceNode->GetID());
+  browserNode->AddProxyNode(transformNode, sequenceNode, false);
+  browserNode->SetRecording(sequenceNode, true);
+  browserNode->SetRecordingSamplingMode(vtkMRMLSequenceBrowserNode::SamplingAll);
+  browserNode->SetRecordingBatchSize(3);
+  CHECK_INT(browserNode->GetRecordingBatchSize(), 3);
+  browserNode->SetRecordingActive(true);
+
+  vtkNew<vtkMatrix4x4> matrix;
+  for (int i = 0; i < 5; ++i)
+    {
+    matrix->SetElement(0, 3, i);
+    transformNode->SetMatrixTransformToParent(matrix);
+    browserNode->SaveProxyNodesState();
+    if (i == 1)
+      {
+      // states are not added until the batch is full
+      CHECK_INT(sequenceNode->GetNumberOfDataNodes(), 0);
+      CHECK_INT(browserNode->GetNumberOfBufferedRecordingItems(), 2);
+      }
+    // make sure each state gets a different timestamp
+    vtksys::SystemTools::Delay(5);
+    }
+  CHECK_INT(sequenceNode->GetNumberOfDataNodes(), 3);
+  CHECK_INT(browserNode->GetNumberOfBufferedRecordingItems(), 2);
+
+  // Remaining states are added when recording is stopped
+  browserNode->SetRecordingActive(false);
+  CHECK_INT(sequenceNode->GetNumberOfDataNodes(), 5);
+  CHECK_INT(browserNode->GetNumberOfBufferedRecordingItems(), 0);
+  CHECK_INT(browserNode->GetSelectedItemNumber(), 4);
+  for (int i = 0; i < 5; ++i)
+    {
+    vtkMRMLLinearTransformNode* recordedTransformNode = vtkMRMLLinearTransformNode::SafeDownCast(sequenceNode->GetNthDataNode(i));
+    CHECK_NOT_NULL(recordedTransformNode);
+    vtkNew<vtkMatrix4x4> recordedMatrix;
+    recordedTransformNode->GetMatrixTransformToParent(recordedMatrix);
+    CHECK_DOUBLE(recordedMatrix->GetElement(0, 3), i);
+    }
+
+  return EXIT_SUCCESS;
+}
+
 int vtkMRMLSequenceBrowserNodeTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
 {
   vtkNew<vtkMRMLScene> scene;
@@ -102,5 +159,7 @@ int vtkMRMLSequenceBrowserNodeTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)
     CHECK_STD_STRING(formattedIndexValue, expectedFormat);
     }
 
+  CHECK_EXIT_SUCCESS(TestRecordingBatch());
+
   return 0;
 }
@@ -28,6 +28,8 @@
 #include <vtkMRMLScene.h>
 #include <vtkMRMLSequenceNode.h>
 #include <vtkMRMLSequenceStorageNode.h>
+#include <vtkMRMLStreamingVolumeNode.h>
+#include <vtkMRMLStreamingVolumeSequenceStorageNode.h>
 #include <vtkMRMLTransformNode.h>
 #include <vtkMRMLVolumeSequenceStorageNode.h>
 
@@ -36,9 +38,15 @@
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkPolyData.h>
+#include <vtkStreamingVolumeFrame.h>
+#include <vtkUnsignedCharArray.h>
 
 #include "vtkMRMLCoreTestingMacros.h"
 
+// STD includes
+#include <fstream>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 int TestWriteReadSequence(const std::string& tempDir, vtkMRMLSequenceNode* sequenceNode, vtkMRMLStorageNode* storageNode, std::string fileName)
 {
@@ -70,6 +78,206 @@ int TestWriteReadSequence(const std::string& tempDir, vtkMRMLSequenceNode* seque
   return EXIT_SUCCESS;
 }
 
+//-----------------------------------------------------------------------------
+int TestWriteReadTransformSequenceFormats(const std::string& tempDir, vtkMRMLScene* scene)
+{
+  const int numberOfFrames = 5;
+  vtkSmartPointer<vtkMRMLSequenceNode> transformSequenceNode = vtkMRMLSequenceNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLSequenceNode"));
+  transformSequenceNode->SetAttribute("Sequences.Source", "ProbeToTracker");
+  vtkNew<vtkMRMLLinearTransformNode> transformNode;
+  vtkNew<vtkMatrix4x4> matrix;
+  for (int frameNumber = 0; frameNumber < numberOfFrames; ++frameNumber)
+    {
+    matrix->SetElement(0, 3, frameNumber * 10.5);
+    matrix->SetElement(1, 2, -0.25 * frameNumber);
+    transformNode->SetMatrixTransformToParent(matrix);
+    transformSequenceNode->SetDataNodeAtValue(transformNode, std::to_string(frameNumber * 0.125));
+    }
+
+  // Binary format, uncompressed and compressed, and text format
+  std::vector<std::string> fileNames = { "TestTransformSequence.seq.lts", "TestTransformSequenceCompressed.seq.lts",
+    "TestTransformSequenceText.seq.mha" };
+  for (size_t fileIndex = 0; fileIndex < fileNames.size(); ++fileIndex)
+    {
+    std::string fullFilePath = tempDir + "/" + fileNames[fileIndex];
+    vtkNew<vtkMRMLLinearTransformSequenceStorageNode> storageNode;
+    storageNode->SetUseCompression(fileIndex == 1);
+    storageNode->SetFileName(fullFilePath.c_str());
+    std::cout << "Testing transform sequence write: " << fullFilePath << std::endl;
+    CHECK_BOOL(storageNode->WriteData(transformSequenceNode), true);
+
+    vtkNew<vtkMRMLSequenceNode> readSequenceNode;
+    vtkNew<vtkMRMLLinearTransformSequenceStorageNode> readStorageNode;
+    readStorageNode->SetFileName(fullFilePath.c_str());
+    std::cout << "Testing transform sequence read: " << fullFilePath << std::endl;
+    CHECK_BOOL(readStorageNode->ReadData(readSequenceNode), true);
+    CHECK_INT(readSequenceNode->GetNumberOfDataNodes(), numberOfFrames);
+    CHECK_STRING(readSequenceNode->GetAttribute("Sequences.Source"), "ProbeToTracker");
+    for (int frameNumber = 0; frameNumber < numberOfFrames; ++frameNumber)
+      {
+      CHECK_DOUBLE_TOLERANCE(atof(readSequenceNode->GetNthIndexValue(frameNumber).c_str()), frameNumber * 0.125, 1e-6);
+      vtkMRMLLinearTransformNode* readTransformNode = vtkMRMLLinearTransformNode::SafeDownCast(readSequenceNode->GetNthDataNode(frameNumber));
+      CHECK_NOT_NULL(readTransformNode);
+      readTransformNode->GetMatrixTransformToParent(matrix);
+      CHECK_DOUBLE_TOLERANCE(matrix->GetElement(0, 3), frameNumber * 10.5, 1e-6);
+      CHECK_DOUBLE_TOLERANCE(matrix->GetElement(1, 2), -0.25 * frameNumber, 1e-6);
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+//-----------------------------------------------------------------------------
+int TestWriteReadStreamingVolumeSequence(const std::string& tempDir, vtkMRMLScene* scene)
+{
+  // Frames are written and read without decoding, so the content of the frames does not need to be valid
+  const int numberOfFrames = 4;
+  vtkSmartPointer<vtkMRMLSequenceNode> volumeSequenceNode = vtkMRMLSequenceNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLSequenceNode"));
+  volumeSequenceNode->SetName("Image");
+  volumeSequenceNode->SetIndexName("time");
+  volumeSequenceNode->SetIndexUnit("s");
+  vtkNew<vtkMatrix4x4> ijkToRasMatrix;
+  for (int frameNumber = 0; frameNumber < numberOfFrames; ++frameNumber)
+    {
+    vtkNew<vtkStreamingVolumeFrame> frame;
+    frame->SetFrameType(frameNumber % 2 == 0 ? vtkStreamingVolumeFrame::IFrame : vtkStreamingVolumeFrame::PFrame);
+    frame->SetDimensions(32, 24, 1);
+    frame->SetNumberOfComponents(3);
+    frame->SetVTKScalarType(VTK_UNSIGNED_CHAR);
+    frame->SetCodecFourCC("TEST");
+    vtkNew<vtkUnsignedCharArray> frameData;
+    frameData->SetNumberOfValues(10 + frameNumber);
+    for (vtkIdType i = 0; i < frameData->GetNumberOfValues(); ++i)
+      {
+      frameData->SetValue(i, static_cast<unsigned char>(frameNumber * 16 + i));
+      }
+    frame->SetFrameData(frameData);
+    vtkNew<vtkMRMLStreamingVolumeNode> volumeNode;
+    ijkToRasMatrix->SetElement(0, 3, frameNumber * 2.5);
+    volumeNode->SetIJKToRASMatrix(ijkToRasMatrix);
+    volumeNode->SetAndObserveFrame(frame);
+    volumeSequenceNode->SetDataNodeAtValue(volumeNode, std::to_string(frameNumber), false);
+    }
+  CHECK_STD_STRING(volumeSequenceNode->GetDefaultStorageNodeClassName(), "vtkMRMLStreamingVolumeSequenceStorageNode");
+
+  std::string fullFilePath = tempDir + "/TestStreamingVolumeSequence.seq.evs";
+  vtkNew<vtkMRMLStreamingVolumeSequenceStorageNode> storageNode;
+  CHECK_BOOL(storageNode->CanWriteFromReferenceNode(volumeSequenceNode), true);
+  storageNode->SetFileName(fullFilePath.c_str());
+  CHECK_BOOL(storageNode->WriteData(volumeSequenceNode), true);
+
+  vtkNew<vtkMRMLSequenceNode> readSequenceNode;
+  vtkNew<vtkMRMLStreamingVolumeSequenceStorageNode> readStorageNode;
+  readStorageNode->SetFileName(fullFilePath.c_str());
+  CHECK_BOOL(readStorageNode->ReadData(readSequenceNode), true);
+  CHECK_INT(readSequenceNode->GetNumberOfDataNodes(), numberOfFrames);
+  CHECK_STD_STRING(readSequenceNode->GetIndexName(), "time");
+  CHECK_STD_STRING(readSequenceNode->GetIndexUnit(), "s");
+  vtkStreamingVolumeFrame* previousReadFrame = nullptr;
+  for (int frameNumber = 0; frameNumber < numberOfFrames; ++frameNumber)
+    {
+    CHECK_STD_STRING(readSequenceNode->GetNthIndexValue(frameNumber), std::to_string(frameNumber));
+    vtkMRMLStreamingVolumeNode* readVolumeNode = vtkMRMLStreamingVolumeNode::SafeDownCast(readSequenceNode->GetNthDataNode(frameNumber));
+    CHECK_NOT_NULL(readVolumeNode);
+    readVolumeNode->GetIJKToRASMatrix(ijkToRasMatrix);
+    CHECK_DOUBLE_TOLERANCE(ijkToRasMatrix->GetElement(0, 3), frameNumber * 2.5, 1e-6);
+    vtkStreamingVolumeFrame* readFrame = readVolumeNode->GetFrame();
+    CHECK_NOT_NULL(readFrame);
+    CHECK_BOOL(readFrame->IsKeyFrame(), frameNumber % 2 == 0);
+    CHECK_STD_STRING(readFrame->GetCodecFourCC(), "TEST");
+    CHECK_INT(readFrame->GetNumberOfComponents(), 3);
+    CHECK_INT(readFrame->GetVTKScalarType(), VTK_UNSIGNED_CHAR);
+    int dimensions[3] = { 0, 0, 0 };
+    readFrame->GetDimensions(dimensions);
+    CHECK_INT(dimensions[0], 32);
+    CHECK_INT(dimensions[1], 24);
+    CHECK_INT(dimensions[2], 1);
+    // Non-key frames refer to the preceding frame, which is needed for decoding
+    CHECK_POINTER(readFrame->GetPreviousFrame(), readFrame->IsKeyFrame() ? nullptr : previousReadFrame);
+    vtkUnsignedCharArray* readFrameData = readFrame->GetFrameData();
+    CHECK_INT(readFrameData->GetNumberOfValues(), 10 + frameNumber);
+    for (vtkIdType i = 0; i < readFrameData->GetNumberOfValues(); ++i)
+      {
+      CHECK_INT(readFrameData->GetValue(i), static_cast<int>(frameNumber * 16 + i));
+      }
+    previousReadFrame = readFrame;
+    }
+
+  return EXIT_SUCCESS;
+}
+
+//-----------------------------------------------------------------------------
+int TestLazyLoadingVolumeSequence(const std::string& tempDir, vtkMRMLScene* scene)
+{
+  // Write a detached-header uncompressed NRRD file where each frame is stored contiguously
+  const int dimensions[3] = { 4, 3, 2 };
+  const int numberOfFrames = 3;
+  const int numberOfVoxels = dimensions[0] * dimensions[1] * dimensions[2];
+  std::string headerFilePath = tempDir + "/TestLazyImageSequence.nhdr";
+  std::string dataFilePath = tempDir + "/TestLazyImageSequence.raw";
+  {
+    std::ofstream headerFile(headerFilePath.c_str(), std::ios::out | std::ios::binary);
+    headerFile << "NRRD0004\n"
+      << "type: short\n"
+      << "dimension: 4\n"
+      << "space: left-posterior-superior\n"
+      << "sizes: " << dimensions[0] << " " << dimensions[1] << " " << dimensions[2] << " " << numberOfFrames << "\n"
+      << "space directions: (1,0,0) (0,1,0) (0,0,1) none\n"
+      << "kinds: domain domain domain list\n"
+      << "endian: little\n"
+      << "encoding: raw\n"
+      << "space origin: (0,0,0)\n"
+      << "data file: TestLazyImageSequence.raw\n";
+    std::ofstream dataFile(dataFilePath.c_str(), std::ios::out | std::ios::binary);
+    for (int frameIndex = 0; frameIndex < numberOfFrames; ++frameIndex)
+      {
+      for (int voxelIndex = 0; voxelIndex < numberOfVoxels; ++voxelIndex)
+        {
+        short value = static_cast<short>(frameIndex * 100 + voxelIndex);
+        dataFile.put(static_cast<char>(value & 0xff));
+        dataFile.put(static_cast<char>((value >> 8) & 0xff));
+        }
+      }
+  }
+
+  vtkNew<vtkMRMLSequenceNode> sequenceNode;
+  scene->AddNode(sequenceNode);
+  vtkNew<vtkMRMLVolumeSequenceStorageNode> storageNode;
+  scene->AddNode(storageNode);
+  storageNode->SetFileName(headerFilePath.c_str());
+  storageNode->LazyLoadingOn();
+  // Only the most recently accessed frame is kept in memory
+  storageNode->SetLazyLoadingMemoryBudgetMB(0.0);
+  CHECK_BOOL(storageNode->ReadData(sequenceNode), true);
+  CHECK_INT(sequenceNode->GetNumberOfDataNodes(), numberOfFrames);
+
+  vtkMRMLScalarVolumeNode* frame0 = vtkMRMLScalarVolumeNode::SafeDownCast(sequenceNode->GetNthDataNode(0));
+  CHECK_NOT_NULL(frame0);
+  CHECK_NOT_NULL(frame0->GetImageData());
+  CHECK_INT(frame0->GetImageData()->GetDimensions()[0], dimensions[0]);
+  CHECK_INT(frame0->GetImageData()->GetScalarType(), VTK_SHORT);
+  CHECK_DOUBLE_TOLERANCE(frame0->GetImageData()->GetScalarComponentAsDouble(1, 0, 0, 0), 1.0, 1e-9);
+
+  vtkMRMLScalarVolumeNode* frame2 = vtkMRMLScalarVolumeNode::SafeDownCast(sequenceNode->GetNthDataNode(2));
+  CHECK_NOT_NULL(frame2);
+  CHECK_DOUBLE_TOLERANCE(frame2->GetImageData()->GetScalarComponentAsDouble(3, 2, 1, 0), 200.0 + numberOfVoxels - 1, 1e-9);
+  // least recently used frame is unloaded
+  CHECK_NULL(frame0->GetImageData());
+
+  // Unloaded frame is loaded again when accessed
+  CHECK_POINTER(sequenceNode->GetNthDataNode(0), frame0);
+  CHECK_NOT_NULL(frame0->GetImageData());
+  CHECK_NULL(frame2->GetImageData());
+
+  // Modified frames are not unloaded
+  frame0->GetImageData()->SetScalarComponentFromDouble(0, 0, 0, 0, 1000.0);
+  sequenceNode->GetNthDataNode(1);
+  CHECK_NOT_NULL(frame0->GetImageData());
+  CHECK_DOUBLE_TOLERANCE(frame0->GetImageData()->GetScalarComponentAsDouble(0, 0, 0, 0), 1000.0, 1e-9);
+
+  return EXIT_SUCCESS;
+}
+
 //-----------------------------------------------------------------------------
 int vtkMRMLSequenceStorageNodeTest1( int argc, char * argv[] )
 {
@@ -110,6 +318,9 @@ int vtkMRMLSequenceStorageNodeTest1( int argc, char * argv[] )
     CHECK_EXIT_SUCCESS(TestWriteReadSequence(tempDir, imageSequenceNode, addedVolumeStorageNode, "TestImageSequence"));
   }
 
+  // Lazy loading of volume node sequence
+  CHECK_EXIT_SUCCESS(TestLazyLoadingVolumeSequence(tempDir, scene));
+
   // Add transform node sequence
   {
     vtkSmartPointer<vtkMRMLSequenceNode> transformSequenceNode = vtkMRMLSequenceNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLSequenceNode"));
@@ -123,6 +334,12 @@ int vtkMRMLSequenceStorageNodeTest1( int argc, char * argv[] )
     CHECK_EXIT_SUCCESS(TestWriteReadSequence(tempDir, transformSequenceNode, addedTransformStorageNode, "TestTransformSequence"));
   }
 
+  // Transform sequence in binary and text file formats
+  CHECK_EXIT_SUCCESS(TestWriteReadTransformSequenceFormats(tempDir, scene));
+
+  // Streaming volume sequence with compressed frames
+  CHECK_EXIT_SUCCESS(TestWriteReadStreamingVolumeSequence(tempDir, scene));
+
   // Create generic node sequence
   {
     vtkSmartPointer<vtkMRMLSequenceNode> genericSequenceNode = vtkMRMLSequenceNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLSequenceNode"));
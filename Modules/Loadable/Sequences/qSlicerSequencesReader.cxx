@@ -92,7 +92,9 @@ QStringList qSlicerSequencesReader::extensions()const
 {
   return QStringList()
     << "Sequence (*.seq.mrb *.mrb)"
-    << "Volume Sequence (*.seq.nrrd *.seq.nhdr)" << "Volume Sequence (*.nrrd *.nhdr)";
+    << "Volume Sequence (*.seq.nrrd *.seq.nhdr)" << "Volume Sequence (*.nrrd *.nhdr)"
+    << "Linear Transform Sequence (*.seq.lts)"
+    << "Streaming Volume Sequence (*.seq.evs)";
 }
 
 //-----------------------------------------------------------------------------
@@ -189,6 +189,45 @@ QStandardItem* qMRMLSubjectHierarchyModelPrivate::insertSubjectHierarchyItem(vtk
   return item;
 }
 
+//------------------------------------------------------------------------------
+QList<QStandardItem*> qMRMLSubjectHierarchyModelPrivate::createSubjectHierarchyItemBranch(vtkIdType itemID)
+{
+  Q_Q(qMRMLSubjectHierarchyModel);
+  QList<QStandardItem*> items;
+  for (int col=0; col<q->columnCount(); ++col)
+    {
+    QStandardItem* newItem = new QStandardItem();
+    q->updateItemFromSubjectHierarchyItem(newItem, itemID, col);
+    items.append(newItem);
+    }
+  // Insert an invalid item in the cache to indicate that the subject hierarchy item is in the
+  // model but we don't know its index yet (it is set in updateRowCache)
+  this->RowCache[itemID] = QModelIndex();
+
+  std::vector<vtkIdType> childItemIDs;
+  this->SubjectHierarchyNode->GetItemChildren(itemID, childItemIDs, false);
+  for (std::vector<vtkIdType>::iterator childIt=childItemIDs.begin(); childIt!=childItemIDs.end(); ++childIt)
+    {
+    items[0]->appendRow(this->createSubjectHierarchyItemBranch(*childIt));
+    }
+  return items;
+}
+
+//------------------------------------------------------------------------------
+void qMRMLSubjectHierarchyModelPrivate::updateRowCache(QStandardItem* item)
+{
+  Q_Q(qMRMLSubjectHierarchyModel);
+  vtkIdType itemID = q->subjectHierarchyItemFromItem(item);
+  if (itemID != vtkMRMLSubjectHierarchyNode::INVALID_ITEM_ID)
+    {
+    this->RowCache[itemID] = item->index();
+    }
+  for (int row=0; row<item->rowCount(); ++row)
+    {
+    this->updateRowCache(item->child(row));
+    }
+}
+
 //------------------------------------------------------------------------------
 vtkSlicerTerminologiesModuleLogic* qMRMLSubjectHierarchyModelPrivate::terminologiesModuleLogic()
 {
@@ -438,16 +477,17 @@ QModelIndexList qMRMLSubjectHierarchyModel::indexes(vtkIdType itemID)const
     {
     return QModelIndexList();
     }
-  // QAbstractItemModel::match doesn't browse through columns, we need to do it manually
-  QModelIndexList shItemIndexes = this->match(
-    scene, qMRMLSubjectHierarchyModel::SubjectHierarchyItemIDRole, QVariant(qlonglong(itemID)), 1, Qt::MatchExactly | Qt::MatchRecursive);
-  if (shItemIndexes.size() != 1)
+  // Use the row cache instead of browsing through the whole model
+  QModelIndex itemIndex = this->indexFromSubjectHierarchyItem(itemID);
+  if (!itemIndex.isValid())
     {
-    return QModelIndexList(); // If 0 it's empty, if >1 it's invalid (one item for each UID)
+    return QModelIndexList();
     }
+  QModelIndexList shItemIndexes;
+  shItemIndexes << itemIndex;
   // Add the QModelIndexes from the other columns
-  const int row = shItemIndexes[0].row();
-  QModelIndex shItemParentIndex = shItemIndexes[0].parent();
+  const int row = itemIndex.row();
+  QModelIndex shItemParentIndex = itemIndex.parent();
   const int sceneColumnCount = this->columnCount(shItemParentIndex);
   for (int col=1; col<sceneColumnCount; ++col)
     {
@@ -791,16 +831,21 @@ void qMRMLSubjectHierarchyModel::rebuildFromSubjectHierarchy()
     this->subjectHierarchySceneItem()->insertRow(0, items);
     }
 
-  // Populate subject hierarchy with the items
-  std::vector<vtkIdType> allItemIDs;
-  d->SubjectHierarchyNode->GetItemChildren(d->SubjectHierarchyNode->GetSceneItemID(), allItemIDs, true);
-  for (std::vector<vtkIdType>::iterator itemIt=allItemIDs.begin(); itemIt!=allItemIDs.end(); ++itemIt)
+  // Populate subject hierarchy with the items. Each top-level branch is built before adding it to the model,
+  // so that views and proxy models need to process only one row insertion per top-level item instead of one
+  // for every item in the hierarchy.
+  std::vector<vtkIdType> topLevelItemIDs;
+  d->SubjectHierarchyNode->GetItemChildren(d->SubjectHierarchyNode->GetSceneItemID(), topLevelItemIDs, false);
+  for (std::vector<vtkIdType>::iterator itemIt=topLevelItemIDs.begin(); itemIt!=topLevelItemIDs.end(); ++itemIt)
     {
-    vtkIdType itemID = (*itemIt);
-    int index = this->subjectHierarchyItemIndex(itemID);
-    d->insertSubjectHierarchyItem(itemID, index);
+    QList<QStandardItem*> items = d->createSubjectHierarchyItemBranch(*itemIt);
+    this->subjectHierarchySceneItem()->appendRow(items);
+    d->updateRowCache(items[0]);
     }
 
+  std::vector<vtkIdType> allItemIDs;
+  d->SubjectHierarchyNode->GetItemChildren(d->SubjectHierarchyNode->GetSceneItemID(), allItemIDs, true);
+
   // Update expanded states (during inserting the update calls did not find valid indices, so
   // expand and collapse statuses were not set in the tree view)
   for (std::vector<vtkIdType>::iterator itemIt=allItemIDs.begin(); itemIt!=allItemIDs.end(); ++itemIt)
@@ -925,16 +970,16 @@ void qMRMLSubjectHierarchyModel::updateItemFromSubjectHierarchyItem(QStandardIte
   bool itemChanged = (d->PendingItemModified > 0);
   d->PendingItemModified = -1;
 
-  if (this->canBeAChild(shItemID))
+  // If the item has no parent, then it means it hasn't been put into the hierarchy yet and it will do it automatically
+  QStandardItem* parentItem = item->parent();
+  if (parentItem && this->canBeAChild(shItemID))
     {
-    QStandardItem* parentItem = item->parent();
     QStandardItem* newParentItem = this->itemFromSubjectHierarchyItem(this->parentSubjectHierarchyItem(shItemID));
     if (!newParentItem)
       {
       newParentItem = this->subjectHierarchySceneItem();
       }
-    // If the item has no parent, then it means it hasn't been put into the hierarchy yet and it will do it automatically
-    if (parentItem && parentItem != newParentItem)
+    if (parentItem != newParentItem)
       {
       int newIndex = this->subjectHierarchyItemIndex(shItemID);
       if (parentItem != newParentItem || newIndex != item->row())
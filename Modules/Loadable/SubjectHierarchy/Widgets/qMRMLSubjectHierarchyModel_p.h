@@ -73,6 +73,16 @@ public:
   /// happening in qMRMLSubjectHierarchyModel::subjectHierarchyItemIndex(vtkIdType).
   virtual QStandardItem* insertSubjectHierarchyItem(vtkIdType itemID, int index);
 
+  /// Create the row of a subject hierarchy item together with the rows of its whole branch.
+  /// The rows are not part of the model while they are created, so when the returned row is inserted
+  /// then the views and proxy models are notified only once, and they can populate the branch
+  /// lazily (e.g. when it is expanded in the tree view).
+  /// \sa updateRowCache
+  QList<QStandardItem*> createSubjectHierarchyItemBranch(vtkIdType itemID);
+  /// Set the row cache entries of an item and its branch. Needs to be called after a branch
+  /// created by \sa createSubjectHierarchyItemBranch is inserted in the model.
+  void updateRowCache(QStandardItem* item);
+
   /// Convenience function to get name for subject hierarchy item
   QString subjectHierarchyItemName(vtkIdType itemID);
 
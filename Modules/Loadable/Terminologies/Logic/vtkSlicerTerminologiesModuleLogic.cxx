@@ -44,6 +44,7 @@
 
 // STD includes
 #include <algorithm>
+#include <unordered_map>
 
 #include "rapidjson/document.h"     // rapidjson's DOM-style API
 #include "rapidjson/prettywriter.h" // for stringify JSON
@@ -74,6 +75,18 @@ public:
   /// \return Json object if found, otherwise null Json object
   rapidjson::Value& GetCodeInArray(CodeIdentifier codeId, rapidjson::Value& jsonArray, int &foundIndex);
 
+  /// Get code in Json array of a loaded context using a hash index, which is built at the first lookup in the array
+  /// Note: Must not be used while the array is being modified (e.g., when converting segment descriptor files)
+  /// \return Json object if found, otherwise null Json object
+  rapidjson::Value& GetCodeInIndexedArray(CodeIdentifier codeId, rapidjson::Value& jsonArray);
+  /// Find codes in Json array of a loaded context that have a code meaning containing a given string (case insensitive).
+  /// A trigram index is built at the first search in the array, so that only the codes that contain a trigram of the
+  /// search string need to be checked.
+  /// \return Success flag
+  bool FindCodesInIndexedArray(rapidjson::Value& jsonArray, std::string search, std::vector<CodeIdentifier>& codes);
+  /// Remove all indexes. Must be called whenever a loaded context is modified or replaced.
+  void ClearIndexes();
+
   /// Get root Json value for the terminology with given name
   rapidjson::Value& GetTerminologyRootByName(std::string terminologyName);
 
@@ -138,8 +151,10 @@ public:
   void GetJsonCodeFromIdentifier(rapidjson::Value& code, CodeIdentifier identifier, rapidjson::Document::AllocatorType& allocator);
 
   /// Utility function for safe (memory-leak-free) setting of a document pointer in map
-  static void SetDocumentInTerminologyMap(TerminologyMap& terminologyMap, const std::string& name, rapidjson::Document* doc)
+  void SetDocumentInTerminologyMap(TerminologyMap& terminologyMap, const std::string& name, rapidjson::Document* doc)
     {
+    // Document content may have changed even if the document object is the same
+    this->ClearIndexes();
     if (terminologyMap.find(name) != terminologyMap.end())
       {
       if (doc == terminologyMap[name])
@@ -154,12 +169,50 @@ public:
     terminologyMap[name] = doc;
     }
 
+  /// Key of a code in the hash indexes
+  static std::string GetCodeKey(const std::string& codingSchemeDesignator, const std::string& codeValue)
+    {
+    // '^' is the component separator in serialized terminology entries, so it cannot occur in the code
+    return codingSchemeDesignator + "^" + codeValue;
+    }
+
+  /// Search index of code meanings in a Json array
+  struct CodeMeaningIndex
+    {
+    /// Valid codes in the array, in the order of the array
+    std::vector<CodeIdentifier> Codes;
+    /// Lowercase code meaning of each item in Codes
+    std::vector<std::string> LowerCaseCodeMeanings;
+    /// Positions (in Codes) of the items that contain a trigram (3 consecutive characters) in their lowercase code meaning
+    std::unordered_map<std::string, std::vector<size_t> > TrigramPositions;
+    };
+  CodeMeaningIndex& GetCodeMeaningIndex(rapidjson::Value& jsonArray);
+
+  /// Location of a type or type modifier that has a 3dSlicerLabel
+  struct SlicerLabelLocation
+    {
+    CodeIdentifier CategoryId;
+    CodeIdentifier TypeId;
+    CodeIdentifier TypeModifierId;
+    };
+  typedef std::unordered_map<std::string, SlicerLabelLocation> SlicerLabelIndex;
+  /// Get index of 3dSlicerLabel values in a terminology. It is built at the first lookup in the terminology.
+  /// \return nullptr if the terminology is not found
+  SlicerLabelIndex* GetSlicerLabelIndex(std::string terminologyName);
+
 public:
   /// Loaded terminologies. Key is the context name, value is the root item.
   TerminologyMap LoadedTerminologies;
 
   /// Loaded anatomical region contexts. Key is the context name, value is the root item.
   TerminologyMap LoadedAnatomicContexts;
+
+  /// Hash indexes of the code arrays of loaded contexts. Key is the array, value maps code keys to array indices.
+  std::unordered_map<const rapidjson::Value*, std::unordered_map<std::string, rapidjson::SizeType> > CodeIndexes;
+  /// Code meaning search indexes of the code arrays of loaded contexts
+  std::unordered_map<const rapidjson::Value*, CodeMeaningIndex> CodeMeaningIndexes;
+  /// 3dSlicerLabel indexes of the loaded terminologies. Key is the context name.
+  std::map<std::string, SlicerLabelIndex> SlicerLabelIndexes;
 };
 
 //---------------------------------------------------------------------------
@@ -215,6 +268,235 @@ rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetCodeInArray
   return JSON_EMPTY_VALUE;
 }
 
+//---------------------------------------------------------------------------
+rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetCodeInIndexedArray(CodeIdentifier codeId, rapidjson::Value& jsonArray)
+{
+  if (!jsonArray.IsArray())
+    {
+    return JSON_EMPTY_VALUE;
+    }
+
+  auto indexIt = this->CodeIndexes.find(&jsonArray);
+  if (indexIt == this->CodeIndexes.end())
+    {
+    std::unordered_map<std::string, rapidjson::SizeType>& index = this->CodeIndexes[&jsonArray];
+    for (rapidjson::SizeType arrayIndex = 0; arrayIndex < jsonArray.Size(); ++arrayIndex)
+      {
+      rapidjson::Value& currentObject = jsonArray[arrayIndex];
+      if (!currentObject.IsObject())
+        {
+        continue;
+        }
+      rapidjson::Value::MemberIterator codingSchemeDesignator = currentObject.FindMember("CodingSchemeDesignator");
+      rapidjson::Value::MemberIterator codeValue = currentObject.FindMember("CodeValue");
+      if ( codingSchemeDesignator != currentObject.MemberEnd() && codingSchemeDesignator->value.IsString()
+        && codeValue != currentObject.MemberEnd() && codeValue->value.IsString() )
+        {
+        // If a code occurs multiple times then the first one is found (same as in GetCodeInArray)
+        index.emplace(GetCodeKey(codingSchemeDesignator->value.GetString(), codeValue->value.GetString()), arrayIndex);
+        }
+      }
+    indexIt = this->CodeIndexes.find(&jsonArray);
+    }
+
+  auto foundIt = indexIt->second.find(GetCodeKey(codeId.CodingSchemeDesignator, codeId.CodeValue));
+  if (foundIt == indexIt->second.end())
+    {
+    return JSON_EMPTY_VALUE;
+    }
+  return jsonArray[foundIt->second];
+}
+
+//---------------------------------------------------------------------------
+vtkSlicerTerminologiesModuleLogic::vtkInternal::CodeMeaningIndex&
+  vtkSlicerTerminologiesModuleLogic::vtkInternal::GetCodeMeaningIndex(rapidjson::Value& jsonArray)
+{
+  auto indexIt = this->CodeMeaningIndexes.find(&jsonArray);
+  if (indexIt != this->CodeMeaningIndexes.end())
+    {
+    return indexIt->second;
+    }
+
+  CodeMeaningIndex& index = this->CodeMeaningIndexes[&jsonArray];
+  for (rapidjson::SizeType arrayIndex = 0; arrayIndex < jsonArray.Size(); ++arrayIndex)
+    {
+    rapidjson::Value& currentObject = jsonArray[arrayIndex];
+    if (!currentObject.IsObject())
+      {
+      continue;
+      }
+    rapidjson::Value::MemberIterator codeMeaning = currentObject.FindMember("CodeMeaning");
+    rapidjson::Value::MemberIterator codingSchemeDesignator = currentObject.FindMember("CodingSchemeDesignator");
+    rapidjson::Value::MemberIterator codeValue = currentObject.FindMember("CodeValue");
+    if ( codeMeaning == currentObject.MemberEnd() || !codeMeaning->value.IsString()
+      || codingSchemeDesignator == currentObject.MemberEnd() || !codingSchemeDesignator->value.IsString()
+      || codeValue == currentObject.MemberEnd() || !codeValue->value.IsString() )
+      {
+      vtkGenericWarningMacro("GetCodeMeaningIndex: Invalid code at index " << arrayIndex);
+      continue;
+      }
+
+    std::string codeMeaningLowerCase(codeMeaning->value.GetString());
+    std::transform(codeMeaningLowerCase.begin(), codeMeaningLowerCase.end(), codeMeaningLowerCase.begin(), ::tolower);
+    size_t position = index.Codes.size();
+    for (size_t trigramStart = 0; trigramStart + 3 <= codeMeaningLowerCase.size(); ++trigramStart)
+      {
+      std::vector<size_t>& positions = index.TrigramPositions[codeMeaningLowerCase.substr(trigramStart, 3)];
+      if (positions.empty() || positions.back() != position)
+        {
+        positions.push_back(position);
+        }
+      }
+    index.Codes.emplace_back(codingSchemeDesignator->value.GetString(), codeValue->value.GetString(), codeMeaning->value.GetString());
+    index.LowerCaseCodeMeanings.push_back(codeMeaningLowerCase);
+    }
+  return index;
+}
+
+//---------------------------------------------------------------------------
+bool vtkSlicerTerminologiesModuleLogic::vtkInternal::FindCodesInIndexedArray(
+  rapidjson::Value& jsonArray, std::string search, std::vector<CodeIdentifier>& codes)
+{
+  codes.clear();
+  if (!jsonArray.IsArray())
+    {
+    return false;
+    }
+  CodeMeaningIndex& index = this->GetCodeMeaningIndex(jsonArray);
+  if (search.empty())
+    {
+    codes = index.Codes;
+    return true;
+    }
+
+  // Make lowercase for case-insensitive comparison
+  std::transform(search.begin(), search.end(), search.begin(), ::tolower);
+
+  if (search.size() < 3)
+    {
+    for (size_t position = 0; position < index.Codes.size(); ++position)
+      {
+      if (index.LowerCaseCodeMeanings[position].find(search) != std::string::npos)
+        {
+        codes.push_back(index.Codes[position]);
+        }
+      }
+    return true;
+    }
+
+  // Only the codes that contain the least frequent trigram of the search string need to be checked
+  const std::vector<size_t>* candidatePositions = nullptr;
+  for (size_t trigramStart = 0; trigramStart + 3 <= search.size(); ++trigramStart)
+    {
+    auto trigramIt = index.TrigramPositions.find(search.substr(trigramStart, 3));
+    if (trigramIt == index.TrigramPositions.end())
+      {
+      // No code meaning contains this trigram
+      return true;
+      }
+    if (!candidatePositions || trigramIt->second.size() < candidatePositions->size())
+      {
+      candidatePositions = &(trigramIt->second);
+      }
+    }
+  for (size_t position : *candidatePositions)
+    {
+    if (index.LowerCaseCodeMeanings[position].find(search) != std::string::npos)
+      {
+      codes.push_back(index.Codes[position]);
+      }
+    }
+  return true;
+}
+
+//---------------------------------------------------------------------------
+void vtkSlicerTerminologiesModuleLogic::vtkInternal::ClearIndexes()
+{
+  this->CodeIndexes.clear();
+  this->CodeMeaningIndexes.clear();
+  this->SlicerLabelIndexes.clear();
+}
+
+//---------------------------------------------------------------------------
+vtkSlicerTerminologiesModuleLogic::vtkInternal::SlicerLabelIndex*
+  vtkSlicerTerminologiesModuleLogic::vtkInternal::GetSlicerLabelIndex(std::string terminologyName)
+{
+  auto indexIt = this->SlicerLabelIndexes.find(terminologyName);
+  if (indexIt != this->SlicerLabelIndexes.end())
+    {
+    return &(indexIt->second);
+    }
+
+  rapidjson::Value& categoryArray = this->GetCategoryArrayInTerminology(terminologyName);
+  if (categoryArray.IsNull())
+    {
+    return nullptr;
+    }
+
+  // Add labels in traversal order. If a label occurs multiple times then the first one is kept.
+  SlicerLabelIndex& index = this->SlicerLabelIndexes[terminologyName];
+  CodeMeaningIndex& categoryIndex = this->GetCodeMeaningIndex(categoryArray);
+  for (const CodeIdentifier& categoryId : categoryIndex.Codes)
+    {
+    rapidjson::Value& typeArray = this->GetTypeArrayInTerminologyCategory(terminologyName, categoryId);
+    if (typeArray.IsNull())
+      {
+      continue;
+      }
+    for (rapidjson::SizeType typeIndex = 0; typeIndex < typeArray.Size(); ++typeIndex)
+      {
+      rapidjson::Value& type = typeArray[typeIndex];
+      if (!type.IsObject())
+        {
+        continue;
+        }
+      rapidjson::Value::MemberIterator typeName = type.FindMember("CodeMeaning");
+      rapidjson::Value::MemberIterator typeCodingSchemeDesignator = type.FindMember("CodingSchemeDesignator");
+      rapidjson::Value::MemberIterator typeCodeValue = type.FindMember("CodeValue");
+      if ( typeName == type.MemberEnd() || !typeName->value.IsString()
+        || typeCodingSchemeDesignator == type.MemberEnd() || !typeCodingSchemeDesignator->value.IsString()
+        || typeCodeValue == type.MemberEnd() || !typeCodeValue->value.IsString() )
+        {
+        vtkGenericWarningMacro("GetSlicerLabelIndex: Invalid type at index " << typeIndex << " in category '"
+          << categoryId.CodeMeaning << "' in terminology '" << terminologyName << "'");
+        continue;
+        }
+      SlicerLabelLocation typeLocation;
+      typeLocation.CategoryId = categoryId;
+      typeLocation.TypeId = CodeIdentifier(typeCodingSchemeDesignator->value.GetString(),
+        typeCodeValue->value.GetString(), typeName->value.GetString());
+      rapidjson::Value::MemberIterator slicerLabel = type.FindMember("3dSlicerLabel");
+      if (slicerLabel != type.MemberEnd() && slicerLabel->value.IsString())
+        {
+        index.emplace(slicerLabel->value.GetString(), typeLocation);
+        }
+
+      rapidjson::Value::MemberIterator typeModifierArray = type.FindMember("Modifier");
+      if (typeModifierArray == type.MemberEnd() || !typeModifierArray->value.IsArray())
+        {
+        continue;
+        }
+      CodeMeaningIndex& typeModifierIndex = this->GetCodeMeaningIndex(typeModifierArray->value);
+      for (const CodeIdentifier& typeModifierId : typeModifierIndex.Codes)
+        {
+        rapidjson::Value& typeModifier = this->GetCodeInIndexedArray(typeModifierId, typeModifierArray->value);
+        if (!typeModifier.IsObject())
+          {
+          continue;
+          }
+        rapidjson::Value::MemberIterator typeModifierSlicerLabel = typeModifier.FindMember("3dSlicerLabel");
+        if (typeModifierSlicerLabel != typeModifier.MemberEnd() && typeModifierSlicerLabel->value.IsString())
+          {
+          SlicerLabelLocation typeModifierLocation(typeLocation);
+          typeModifierLocation.TypeModifierId = typeModifierId;
+          index.emplace(typeModifierSlicerLabel->value.GetString(), typeModifierLocation);
+          }
+        }
+      }
+    }
+  return &index;
+}
+
 //---------------------------------------------------------------------------
 rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetTerminologyRootByName(std::string terminologyName)
 {
@@ -271,8 +553,7 @@ rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetCategoryInT
     return JSON_EMPTY_VALUE;
     }
 
-  int index = -1;
-  return this->GetCodeInArray(categoryId, categoryArray, index);
+  return this->GetCodeInIndexedArray(categoryId, categoryArray);
 }
 
 //---------------------------------------------------------------------------
@@ -370,8 +651,7 @@ rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetTypeInTermi
     return JSON_EMPTY_VALUE;
     }
 
-  int index = -1;
-  return this->GetCodeInArray(typeId, typeArray, index);
+  return this->GetCodeInIndexedArray(typeId, typeArray);
 }
 
 //---------------------------------------------------------------------------
@@ -498,8 +778,7 @@ rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetTypeModifie
     return JSON_EMPTY_VALUE;
     }
 
-  int index = -1;
-  return this->GetCodeInArray(modifierId, typeModifierArray, index);
+  return this->GetCodeInIndexedArray(modifierId, typeModifierArray);
 }
 
 //---------------------------------------------------------------------------
@@ -558,8 +837,7 @@ rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetRegionInAna
     return JSON_EMPTY_VALUE;
     }
 
-  int index = -1;
-  return this->GetCodeInArray(regionId, regionArray, index);
+  return this->GetCodeInIndexedArray(regionId, regionArray);
 }
 
 //---------------------------------------------------------------------------
@@ -610,8 +888,7 @@ rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetRegionModif
     return JSON_EMPTY_VALUE;
     }
 
-  int index = -1;
-  return this->GetCodeInArray(modifierId, regionModifierArray, index);
+  return this->GetCodeInIndexedArray(modifierId, regionModifierArray);
 }
 
 //---------------------------------------------------------------------------
@@ -1063,7 +1340,7 @@ bool vtkSlicerTerminologiesModuleLogic::LoadContextFromFile(std::string filePath
     {
     // Store terminology
     std::string contextName = (*jsonRoot)["SegmentationCategoryTypeContextName"].GetString();
-    vtkSlicerTerminologiesModuleLogic::vtkInternal::SetDocumentInTerminologyMap(
+    this->Internal->SetDocumentInTerminologyMap(
       this->Internal->LoadedTerminologies, contextName, jsonRoot);
     vtkDebugMacro("Terminology named '" << contextName << "' successfully loaded from file " << filePath);
     }
@@ -1071,7 +1348,7 @@ bool vtkSlicerTerminologiesModuleLogic::LoadContextFromFile(std::string filePath
     {
     // Store anatomic context
     std::string contextName = (*jsonRoot)["AnatomicContextName"].GetString();
-    vtkSlicerTerminologiesModuleLogic::vtkInternal::SetDocumentInTerminologyMap(
+    this->Internal->SetDocumentInTerminologyMap(
       this->Internal->LoadedAnatomicContexts, contextName, jsonRoot);
     vtkDebugMacro("Anatomic context named '" << contextName << "' successfully loaded from file " << filePath);
     }
@@ -1130,7 +1407,7 @@ std::string vtkSlicerTerminologiesModuleLogic::LoadTerminologyFromFile(std::stri
 
   // Store terminology
   std::string contextName = (*terminologyRoot)["SegmentationCategoryTypeContextName"].GetString();
-  vtkSlicerTerminologiesModuleLogic::vtkInternal::SetDocumentInTerminologyMap(
+  this->Internal->SetDocumentInTerminologyMap(
     this->Internal->LoadedTerminologies, contextName, terminologyRoot);
 
   vtkDebugMacro("Terminology named '" << contextName << "' successfully loaded from file " << filePath);
@@ -1171,6 +1448,8 @@ bool vtkSlicerTerminologiesModuleLogic::LoadTerminologyFromSegmentDescriptorFile
     convertedDoc = new rapidjson::Document;
     }
 
+  // Loaded terminology may be modified in place
+  this->Internal->ClearIndexes();
   bool success = this->Internal->ConvertSegmentationDescriptorToTerminologyContext(descriptorDoc, *convertedDoc, contextName);
   if (!success)
     {
@@ -1180,7 +1459,7 @@ bool vtkSlicerTerminologiesModuleLogic::LoadTerminologyFromSegmentDescriptorFile
     }
 
   // Store terminology
-  vtkSlicerTerminologiesModuleLogic::vtkInternal::SetDocumentInTerminologyMap(
+  this->Internal->SetDocumentInTerminologyMap(
     this->Internal->LoadedTerminologies, contextName, convertedDoc );
 
   vtkDebugMacro("Terminology named '" << contextName << "' successfully loaded from file " << filePath);
@@ -1248,7 +1527,7 @@ std::string vtkSlicerTerminologiesModuleLogic::LoadAnatomicContextFromFile(std::
 
   // Store anatomic context
   std::string contextName = (*anatomicContextRoot)["AnatomicContextName"].GetString();
-  vtkSlicerTerminologiesModuleLogic::vtkInternal::SetDocumentInTerminologyMap(
+  this->Internal->SetDocumentInTerminologyMap(
     this->Internal->LoadedAnatomicContexts, contextName, anatomicContextRoot);
 
   vtkDebugMacro("Anatomic context named '" << contextName << "' successfully loaded from file " << filePath);
@@ -1289,6 +1568,8 @@ bool vtkSlicerTerminologiesModuleLogic::LoadAnatomicContextFromSegmentDescriptor
     convertedDoc = new rapidjson::Document;
     }
 
+  // Loaded anatomic context may be modified in place
+  this->Internal->ClearIndexes();
   bool success = this->Internal->ConvertSegmentationDescriptorToAnatomicContext(descriptorDoc, *convertedDoc, contextName);
   if (!success)
     {
@@ -1298,7 +1579,7 @@ bool vtkSlicerTerminologiesModuleLogic::LoadAnatomicContextFromSegmentDescriptor
     }
 
   // Store anatomic context
-  vtkSlicerTerminologiesModuleLogic::vtkInternal::SetDocumentInTerminologyMap(
+  this->Internal->SetDocumentInTerminologyMap(
     this->Internal->LoadedAnatomicContexts, contextName, convertedDoc );
 
   vtkDebugMacro("Anatomic context named '" << contextName << "' successfully loaded from file " << filePath);
@@ -1427,40 +1708,8 @@ bool vtkSlicerTerminologiesModuleLogic::FindCategoriesInTerminology(std::string
     return false;
     }
 
-  // Make lowercase for case-insensitive comparison
-  std::transform(search.begin(), search.end(), search.begin(), ::tolower);
-
-  // Traverse categories
-  rapidjson::SizeType index = 0;
-  while (index < categoryArray.Size())
-    {
-    rapidjson::Value& category = categoryArray[index];
-    if (category.IsObject())
-      {
-      rapidjson::Value& categoryName = category["CodeMeaning"];
-      rapidjson::Value& categoryCodingSchemeDesignator = category["CodingSchemeDesignator"];
-      rapidjson::Value& categoryCodeValue = category["CodeValue"];
-      if (categoryName.IsString() && categoryCodingSchemeDesignator.IsString() && categoryCodeValue.IsString())
-        {
-        // Add category to list if search string is empty or is contained by the current category name
-        std::string categoryNameStr = categoryName.GetString();
-        std::string categoryNameLowerCase(categoryNameStr);
-        std::transform(categoryNameLowerCase.begin(), categoryNameLowerCase.end(), categoryNameLowerCase.begin(), ::tolower);
-        if (search.empty() || categoryNameLowerCase.find(search) != std::string::npos)
-          {
-          CodeIdentifier categoryId(categoryCodingSchemeDesignator.GetString(), categoryCodeValue.GetString(), categoryNameStr);
-          categories.push_back(categoryId);
-          }
-        }
-      else
-        {
-        vtkErrorMacro("FindCategoriesInTerminology: Invalid category '" << categoryName.GetString() << "' in terminology '" << terminologyName << "'");
-        }
-      }
-    ++index;
-    }
-
-  return true;
+  // Add categories with name containing the search string (all categories if search string is empty)
+  return this->Internal->FindCodesInIndexedArray(categoryArray, search, categories);
 }
 
 //---------------------------------------------------------------------------
@@ -1553,41 +1802,8 @@ bool vtkSlicerTerminologiesModuleLogic::FindTypesInTerminologyCategory(
     return false;
     }
 
-  // Make lowercase for case-insensitive comparison
-  std::transform(search.begin(), search.end(), search.begin(), ::tolower);
-
-  // Traverse types
-  rapidjson::SizeType index = 0;
-  while (index < typeArray.Size())
-    {
-    rapidjson::Value& type = typeArray[index];
-    if (type.IsObject())
-      {
-      rapidjson::Value& typeName = type["CodeMeaning"];
-      rapidjson::Value& typeCodingSchemeDesignator = type["CodingSchemeDesignator"];
-      rapidjson::Value& typeCodeValue = type["CodeValue"];
-      if (typeName.IsString() && typeCodingSchemeDesignator.IsString() && typeCodeValue.IsString())
-        {
-        // Add type to list if search string is empty or is contained by the current type name
-        std::string typeNameStr = typeName.GetString();
-        std::string typeNameLowerCase(typeNameStr);
-        std::transform(typeNameLowerCase.begin(), typeNameLowerCase.end(), typeNameLowerCase.begin(), ::tolower);
-        if (search.empty() || typeNameLowerCase.find(search) != std::string::npos)
-          {
-          CodeIdentifier typeId(typeCodingSchemeDesignator.GetString(), typeCodeValue.GetString(), typeNameStr);
-          types.push_back(typeId);
-          }
-        }
-      else
-        {
-        vtkErrorMacro("FindTypesInTerminologyCategory: Invalid type '" << typeName.GetString() << "in category '"
-          << categoryId.CodeMeaning << "' in terminology '" << terminologyName << "'");
-        }
-      }
-    ++index;
-    }
-
-  return true;
+  // Add types with name containing the search string (all types if search string is empty)
+  return this->Internal->FindCodesInIndexedArray(typeArray, search, types);
 }
 
 //---------------------------------------------------------------------------
@@ -1787,41 +2003,8 @@ bool vtkSlicerTerminologiesModuleLogic::FindRegionsInAnatomicContext(std::string
     return false;
     }
 
-  // Make lowercase for case-insensitive comparison
-  std::transform(search.begin(), search.end(), search.begin(), ::tolower);
-
-  // Traverse regions
-  rapidjson::SizeType index = 0;
-  while (index<regionArray.Size())
-    {
-    rapidjson::Value& region = regionArray[index];
-    if (region.IsObject())
-      {
-      rapidjson::Value& regionName = region["CodeMeaning"];
-      rapidjson::Value& regionCodingSchemeDesignator = region["CodingSchemeDesignator"];
-      rapidjson::Value& regionCodeValue = region["CodeValue"];
-      if (regionName.IsString() && regionCodingSchemeDesignator.IsString() && regionCodeValue.IsString())
-        {
-        // Add region name to list if search string is empty or is contained by the current region name
-        std::string regionNameStr = regionName.GetString();
-        std::string regionNameLowerCase(regionNameStr);
-        std::transform(regionNameLowerCase.begin(), regionNameLowerCase.end(), regionNameLowerCase.begin(), ::tolower);
-        if (search.empty() || regionNameLowerCase.find(search) != std::string::npos)
-          {
-          CodeIdentifier regionId(regionCodingSchemeDesignator.GetString(), regionCodeValue.GetString(), regionNameStr);
-          regions.push_back(regionId);
-          }
-        }
-      else
-        {
-        vtkErrorMacro("FindRegionsInAnatomicContext: Invalid region '" << regionName.GetString()
-          << "' in anatomic context '" << anatomicContextName << "'");
-        }
-      }
-    ++index;
-    }
-
-  return true;
+  // Add regions with name containing the search string (all regions if search string is empty)
+  return this->Internal->FindCodesInIndexedArray(regionArray, search, regions);
 }
 
 //---------------------------------------------------------------------------
@@ -2210,147 +2393,37 @@ bool vtkSlicerTerminologiesModuleLogic::FindTypeInTerminologyBy3dSlicerLabel(std
     return false;
     }
 
-  rapidjson::Value& categoryArray = this->Internal->GetCategoryArrayInTerminology(terminologyName);
-  if (categoryArray.IsNull())
+  vtkInternal::SlicerLabelIndex* slicerLabelIndex = this->Internal->GetSlicerLabelIndex(terminologyName);
+  if (!slicerLabelIndex)
     {
     vtkErrorMacro("FindTypeInTerminologyBy3dSlicerLabel: Failed to find terminology '" << terminologyName << "'");
     return false;
     }
 
-  bool found = false;
-  CodeIdentifier foundCategoryId;
-  CodeIdentifier foundTypeId;
-  CodeIdentifier foundTypeModifierId;
-
-  // Traverse categories
-  rapidjson::SizeType categoryIndex = 0;
-  while (categoryIndex < categoryArray.Size())
-    {
-    rapidjson::Value& category = categoryArray[categoryIndex];
-    if (category.IsObject())
-      {
-      rapidjson::Value& categoryName = category["CodeMeaning"];
-      rapidjson::Value& categoryCodingSchemeDesignator = category["CodingSchemeDesignator"];
-      rapidjson::Value& categoryCodeValue = category["CodeValue"];
-      if (categoryName.IsString() && categoryCodingSchemeDesignator.IsString() && categoryCodeValue.IsString())
-        {
-        CodeIdentifier categoryId(categoryCodingSchemeDesignator.GetString(), categoryCodeValue.GetString(), categoryName.GetString());
-        rapidjson::Value& typeArray = this->Internal->GetTypeArrayInTerminologyCategory(terminologyName, categoryId);
-        if (typeArray.IsNull())
-          {
-          vtkErrorMacro("FindTypeInTerminologyBy3dSlicerLabel: Failed to find category '"
-            << categoryId.CodeMeaning << "' in terminology '" << terminologyName << "'");
-          ++categoryIndex;
-          continue;
-          }
-
-        // Traverse types
-        rapidjson::SizeType typeIndex = 0;
-        while (typeIndex < typeArray.Size())
-          {
-          rapidjson::Value& type = typeArray[typeIndex];
-          if (type.IsObject())
-            {
-            rapidjson::Value& typeName = type["CodeMeaning"];
-            rapidjson::Value& typeCodingSchemeDesignator = type["CodingSchemeDesignator"];
-            rapidjson::Value& typeCodeValue = type["CodeValue"];
-            if (typeName.IsString() && typeCodingSchemeDesignator.IsString() && typeCodeValue.IsString())
-              {
-              CodeIdentifier typeId(typeCodingSchemeDesignator.GetString(), typeCodeValue.GetString(), typeName.GetString());
-              rapidjson::Value::MemberIterator currentSlicerLabelIt = type.FindMember("3dSlicerLabel");
-              if (currentSlicerLabelIt != type.MemberEnd() && !slicerLabel.compare(currentSlicerLabelIt->value.GetString()))
-                {
-                // 3dSlicerLabel found in type
-                found = true;
-                foundCategoryId = categoryId;
-                foundTypeId = typeId;
-                break;
-                }
-
-              rapidjson::Value& typeModifierArray = this->Internal->GetTypeModifierArrayInTerminologyType(terminologyName, categoryId, typeId);
-              if (typeModifierArray.IsNull())
-                {
-                ++typeIndex;
-                continue;
-                }
-
-              // Traverse type modifiers
-              rapidjson::SizeType typeModifierIndex = 0;
-              while (typeModifierIndex < typeModifierArray.Size())
-                {
-                rapidjson::Value& typeModifier = typeModifierArray[typeModifierIndex];
-                if (typeModifier.IsObject())
-                  {
-                  rapidjson::Value& typeModifierName = typeModifier["CodeMeaning"];
-                  rapidjson::Value& typeModifierCodingSchemeDesignator = typeModifier["CodingSchemeDesignator"];
-                  rapidjson::Value& typeModifierCodeValue = typeModifier["CodeValue"];
-                  if (typeModifierName.IsString() && typeModifierCodingSchemeDesignator.IsString() && typeModifierCodeValue.IsString())
-                    {
-                    CodeIdentifier typeModifierId(typeModifierCodingSchemeDesignator.GetString(),
-                      typeModifierCodeValue.GetString(), typeModifierName.GetString());
-                    rapidjson::Value::MemberIterator currentSlicerLabelIt = typeModifier.FindMember("3dSlicerLabel");
-                    if (currentSlicerLabelIt != typeModifier.MemberEnd() && !slicerLabel.compare(currentSlicerLabelIt->value.GetString()))
-                      {
-                      // 3dSlicerLabel found in type modifier
-                      found = true;
-                      foundCategoryId = categoryId;
-                      foundTypeId = typeId;
-                      foundTypeModifierId = typeModifierId;
-                      break;
-                      }
-                    }
-                  }
-                ++typeModifierIndex;
-                } // For all type modifiers
-
-              if (found)
-                {
-                break;
-                }
-              }
-            else
-              {
-              vtkErrorMacro("FindTypeInTerminologyBy3dSlicerLabel: Invalid type '" << typeName.GetString() << "in category '"
-                << categoryId.CodeMeaning << "' in terminology '" << terminologyName << "'");
-              }
-            }
-          ++typeIndex;
-          } // For all types
-
-        if (found)
-          {
-          break;
-          }
-        }
-      else
-        {
-        vtkErrorMacro("FindTypeInTerminologyBy3dSlicerLabel: Invalid category '" << categoryName.GetString() << "' in terminology '" << terminologyName << "'");
-        }
-      }
-    ++categoryIndex;
-    } // For all categories
-
-  if (found)
+  vtkInternal::SlicerLabelIndex::iterator foundIt = slicerLabelIndex->find(slicerLabel);
+  if (foundIt == slicerLabelIndex->end())
     {
-    entry->SetTerminologyContextName(terminologyName.c_str());
+    return false;
+    }
+  const vtkInternal::SlicerLabelLocation& foundLocation = foundIt->second;
 
-    vtkSmartPointer<vtkSlicerTerminologyCategory> category = vtkSmartPointer<vtkSlicerTerminologyCategory>::New();
-    this->GetCategoryInTerminology(terminologyName, foundCategoryId, category);
-    entry->GetCategoryObject()->Copy(category);
+  entry->SetTerminologyContextName(terminologyName.c_str());
 
-    vtkSmartPointer<vtkSlicerTerminologyType> type = vtkSmartPointer<vtkSlicerTerminologyType>::New();
-    this->GetTypeInTerminologyCategory(terminologyName, foundCategoryId, foundTypeId, type);
-    entry->GetTypeObject()->Copy(type);
+  vtkSmartPointer<vtkSlicerTerminologyCategory> category = vtkSmartPointer<vtkSlicerTerminologyCategory>::New();
+  this->GetCategoryInTerminology(terminologyName, foundLocation.CategoryId, category);
+  entry->GetCategoryObject()->Copy(category);
 
-    if (!foundTypeModifierId.CodeValue.empty())
-      {
-      vtkSmartPointer<vtkSlicerTerminologyType> typeModifier = vtkSmartPointer<vtkSlicerTerminologyType>::New();
-      this->GetTypeModifierInTerminologyType(terminologyName, foundCategoryId, foundTypeId, foundTypeModifierId, typeModifier);
-      entry->GetTypeModifierObject()->Copy(typeModifier);
-      }
+  vtkSmartPointer<vtkSlicerTerminologyType> type = vtkSmartPointer<vtkSlicerTerminologyType>::New();
+  this->GetTypeInTerminologyCategory(terminologyName, foundLocation.CategoryId, foundLocation.TypeId, type);
+  entry->GetTypeObject()->Copy(type);
 
-    return true;
+  if (!foundLocation.TypeModifierId.CodeValue.empty())
+    {
+    vtkSmartPointer<vtkSlicerTerminologyType> typeModifier = vtkSmartPointer<vtkSlicerTerminologyType>::New();
+    this->GetTypeModifierInTerminologyType(terminologyName, foundLocation.CategoryId, foundLocation.TypeId,
+      foundLocation.TypeModifierId, typeModifier);
+    entry->GetTypeModifierObject()->Copy(typeModifier);
     }
 
-  return false;
+  return true;
 }
@@ -44,6 +44,7 @@
 #include <QFileInfo>
 #include <QItemSelection>
 #include <QMessageBox>
+#include <QSet>
 #include <QSettings>
 #include <QTableWidgetItem>
 #include <QTimer>
@@ -1198,6 +1199,7 @@ void qSlicerTerminologyNavigatorWidget::populateTypeTable()
 
   // Get types in selected categories containing the search string. If no search string then add every type
   std::vector<vtkSlicerTerminologiesModuleLogic::CodeIdentifier> types;
+  QSet<QString> addedTypeKeys; // for fast detection of types that exist in multiple categories
   QMap<int, int> typeIndexToCategoryIndexMap;
   int typeIndex = 0;
   int categoryIndex = 0;
@@ -1213,20 +1215,12 @@ void qSlicerTerminologyNavigatorWidget::populateTypeTable()
 
     for (idIt=typesInCategory.begin(); idIt!=typesInCategory.end(); ++idIt)
       {
-      // Determine if type already exists in list
-      bool duplicate = false;
-      std::vector<vtkSlicerTerminologiesModuleLogic::CodeIdentifier>::iterator typeIt;
-      for (typeIt=types.begin(); typeIt!=types.end(); ++typeIt)
-        {
-        if ( !idIt->CodeValue.compare(typeIt->CodeValue)
-          && !idIt->CodingSchemeDesignator.compare(typeIt->CodingSchemeDesignator) )
-          {
-          duplicate = true;
-          break;
-          }
-        }
-      if (!duplicate)
+      // Only add type if it does not exist in the list yet
+      QString typeKey = QString("%1^%2").arg(idIt->CodingSchemeDesignator.c_str()).arg(idIt->CodeValue.c_str());
+      if (!addedTypeKeys.contains(typeKey))
         {
+        addedTypeKeys.insert(typeKey);
+
         // Add type
         types.push_back(*idIt);
 
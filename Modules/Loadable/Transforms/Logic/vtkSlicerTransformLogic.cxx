@@ -54,6 +54,7 @@ or http://www.slicer.org/copyright/copyright.txt for details.
 #include <vtkPoints.h>
 #include <vtkPointSet.h>
 #include <vtkPointData.h>
+#include <vtkSMPTools.h>
 #include <vtkSphereSource.h>
 #include <vtkThinPlateSplineTransform.h>
 #include <vtkTransform.h>
@@ -79,6 +80,22 @@ or http://www.slicer.org/copyright/copyright.txt for details.
 #include "itkTranslationTransform.h"
 #include "itkTransformFactory.h"
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Get displacements of the transform to/from world sampled on the grid.
+/// Returns nullptr if the transform cannot be sampled.
+vtkImageData* GetSampledDisplacementField(vtkMRMLTransformNode* transformNode, vtkMatrix4x4* ijkToRAS,
+  const int extent[6], bool transformToWorld)
+{
+  vtkOrientedGridTransform* sampledTransform = transformToWorld ?
+    transformNode->GetBakedTransformToWorld(ijkToRAS, extent) : transformNode->GetBakedTransformFromWorld(ijkToRAS, extent);
+  return sampledTransform ? sampledTransform->GetDisplacementGrid() : nullptr;
+}
+
+}
+
 vtkStandardNewMacro(vtkSlicerTransformLogic);
 
 //----------------------------------------------------------------------------
@@ -207,21 +224,11 @@ void vtkSlicerTransformLogic::GetTransformedPointSamples(vtkPointSet* outputPoin
   vtkMRMLTransformNode* inputTransformNode, vtkMatrix4x4* gridToRAS, int* gridSize,
   bool transformToWorld /* = true */)
 {
-  vtkNew<vtkGeneralTransform> inputTransform;
-  if (transformToWorld)
-  {
-    inputTransformNode->GetTransformToWorld(inputTransform.GetPointer());
-  }
-  else
-  {
-    inputTransformNode->GetTransformFromWorld(inputTransform.GetPointer());
-  }
   // Generate sample point set on a grid
   vtkNew<vtkPoints> samplePositions_RAS;
   int numOfSamples = gridSize[0] * gridSize[1] * gridSize[2];
   samplePositions_RAS->SetNumberOfPoints(numOfSamples);
   double point_RAS[4] = { 0, 0, 0, 1 };
-  double transformedPoint_RAS[4] = { 0, 0, 0, 1 };
   double point_Grid[4] = { 0, 0, 0, 1 };
   int sampleIndex = 0;
   for (point_Grid[2] = 0; point_Grid[2]<gridSize[2]; point_Grid[2]++)
@@ -231,7 +238,6 @@ void vtkSlicerTransformLogic::GetTransformedPointSamples(vtkPointSet* outputPoin
       for (point_Grid[0] = 0; point_Grid[0]<gridSize[0]; point_Grid[0]++)
         {
         gridToRAS->MultiplyPoint(point_Grid, point_RAS);
-        inputTransform->TransformPoint(point_RAS, transformedPoint_RAS);
         samplePositions_RAS->SetPoint(sampleIndex, point_RAS[0], point_RAS[1], point_RAS[2]);
         sampleIndex++;
         }
@@ -269,20 +275,25 @@ void vtkSlicerTransformLogic::GetTransformedPointSamples(vtkPointSet* outputPoin
     inputTransformNode->GetTransformFromWorld(inputTransform.GetPointer());
     }
 
-  double transformedPoint_RAS[4] = { 0, 0, 0, 1 };
-  double pointDislocationVector_RAS[4] = { 0, 0, 0, 1 };
-  for (int sampleIndex = 0; sampleIndex < numOfSamples; sampleIndex++)
+  // Evaluate the transform at the sample points in parallel.
+  // Make sure the transform is up-to-date before it is used from multiple threads.
+  inputTransform->Update();
+  vtkSMPTools::For(0, numOfSamples, [&](vtkIdType beginSampleIndex, vtkIdType endSampleIndex)
     {
-    double* point_RAS = samplePositions_RAS->GetPoint(sampleIndex);
-
-    inputTransform->TransformPoint(point_RAS, transformedPoint_RAS);
+    double point_RAS[3] = { 0, 0, 0 };
+    double transformedPoint_RAS[3] = { 0, 0, 0 };
+    for (vtkIdType sampleIndex = beginSampleIndex; sampleIndex < endSampleIndex; sampleIndex++)
+      {
+      samplePositions_RAS->GetPoint(sampleIndex, point_RAS);
 
-    pointDislocationVector_RAS[0] = transformedPoint_RAS[0] - point_RAS[0];
-    pointDislocationVector_RAS[1] = transformedPoint_RAS[1] - point_RAS[1];
-    pointDislocationVector_RAS[2] = transformedPoint_RAS[2] - point_RAS[2];
+      inputTransform->TransformPoint(point_RAS, transformedPoint_RAS);
 
-    sampleVectors_RAS->SetTuple3(sampleIndex, pointDislocationVector_RAS[0], pointDislocationVector_RAS[1], pointDislocationVector_RAS[2]);
-    }
+      sampleVectors_RAS->SetTuple3(sampleIndex,
+        transformedPoint_RAS[0] - point_RAS[0],
+        transformedPoint_RAS[1] - point_RAS[1],
+        transformedPoint_RAS[2] - point_RAS[2]);
+      }
+    });
 
   outputPointSet->SetPoints(samplePositions_RAS);
   vtkPointData* pointData = outputPointSet->GetPointData();
@@ -390,15 +401,21 @@ bool vtkSlicerTransformLogic::GetTransformedPointSamplesAsMagnitudeImage(vtkImag
     vtkGenericWarningMacro("vtkSlicerTransformLogic::GetTransformedPointSamplesAsMagnitudeImage failed: invalid input");
     return false;
   }
-
-  vtkNew<vtkGeneralTransform> inputTransform;
-  if (transformToWorld)
+  if (magnitudeImage->GetNumberOfPoints() == 0)
   {
-    inputTransformNode->GetTransformToWorld(inputTransform.GetPointer());
+    // empty extent, nothing to sample
+    magnitudeImage->AllocateScalars(VTK_FLOAT, 1);
+    return true;
   }
-  else
+
+  // The displacements are computed in parallel and cached in the transform node,
+  // therefore if the transform and the sampling grid are not changed between updates
+  // then the displacements are not computed again.
+  vtkImageData* displacementField = GetSampledDisplacementField(inputTransformNode, ijkToRAS, magnitudeImage->GetExtent(), transformToWorld);
+  if (!displacementField)
   {
-    inputTransformNode->GetTransformFromWorld(inputTransform.GetPointer());
+    vtkGenericWarningMacro("vtkSlicerTransformLogic::GetTransformedPointSamplesAsMagnitudeImage failed: transform cannot be sampled");
+    return false;
   }
 
   // The orientation of the volume cannot be set in the image
@@ -406,34 +423,12 @@ bool vtkSlicerTransformLogic::GetTransformedPointSamplesAsMagnitudeImage(vtkImag
   // if the direction matrix is not identity.
   magnitudeImage->AllocateScalars(VTK_FLOAT, 1);
 
-  double point_RAS[4] = { 0, 0, 0, 1 };
-  double transformedPoint_RAS[4] = { 0, 0, 0, 1 };
-  double pointDislocationVector_RAS[4] = { 0, 0, 0, 1 };
-  double point_IJK[4] = { 0, 0, 0, 1 };
+  const double* displacementPtr = static_cast<double*>(displacementField->GetScalarPointer());
   float* voxelPtr = static_cast<float*>(magnitudeImage->GetScalarPointer());
-  int* extent = magnitudeImage->GetExtent();
-  for (point_IJK[2] = extent[4]; point_IJK[2] <= extent[5]; point_IJK[2]++)
+  vtkIdType numberOfVoxels = magnitudeImage->GetNumberOfPoints();
+  for (vtkIdType voxelIndex = 0; voxelIndex < numberOfVoxels; ++voxelIndex, displacementPtr += 3)
   {
-    for (point_IJK[1] = extent[2]; point_IJK[1] <= extent[3]; point_IJK[1]++)
-    {
-      for (point_IJK[0] = extent[0]; point_IJK[0] <= extent[1]; point_IJK[0]++)
-      {
-        ijkToRAS->MultiplyPoint(point_IJK, point_RAS);
-
-        inputTransform->TransformPoint(point_RAS, transformedPoint_RAS);
-
-        pointDislocationVector_RAS[0] = transformedPoint_RAS[0] - point_RAS[0];
-        pointDislocationVector_RAS[1] = transformedPoint_RAS[1] - point_RAS[1];
-        pointDislocationVector_RAS[2] = transformedPoint_RAS[2] - point_RAS[2];
-
-        float mag = sqrt(
-          pointDislocationVector_RAS[0] * pointDislocationVector_RAS[0] +
-          pointDislocationVector_RAS[1] * pointDislocationVector_RAS[1] +
-          pointDislocationVector_RAS[2] * pointDislocationVector_RAS[2]);
-
-        *(voxelPtr++) = mag;
-      }
-    }
+    *(voxelPtr++) = static_cast<float>(vtkMath::Norm(displacementPtr));
   }
 
   return true;
@@ -698,14 +693,18 @@ bool vtkSlicerTransformLogic::GetTransformedPointSamplesAsVectorImage(vtkImageDa
     vtkGenericWarningMacro("vtkSlicerTransformLogic::GetTransformedPointSamplesAsVectorImage failed: invalid input");
     return false;
   }
-  vtkNew<vtkGeneralTransform> inputTransform;
-  if (transformToWorld)
+  if (vectorImage->GetNumberOfPoints() == 0)
   {
-    inputTransformNode->GetTransformToWorld(inputTransform.GetPointer());
+    // empty extent, nothing to sample
+    vectorImage->AllocateScalars(VTK_FLOAT, 3);
+    return true;
   }
-  else
+
+  vtkImageData* displacementField = GetSampledDisplacementField(inputTransformNode, ijkToRAS, vectorImage->GetExtent(), transformToWorld);
+  if (!displacementField)
   {
-    inputTransformNode->GetTransformFromWorld(inputTransform.GetPointer());
+    vtkGenericWarningMacro("vtkSlicerTransformLogic::GetTransformedPointSamplesAsVectorImage failed: transform cannot be sampled");
+    return false;
   }
 
   // The orientation of the volume cannot be set in the image
@@ -713,27 +712,13 @@ bool vtkSlicerTransformLogic::GetTransformedPointSamplesAsVectorImage(vtkImageDa
   // if the direction matrix is not identity.
   vectorImage->AllocateScalars(VTK_FLOAT, 3);
 
-  double point_RAS[4] = { 0, 0, 0, 1 };
-  double transformedPoint_RAS[4] = { 0, 0, 0, 1 };
-  double point_IJK[4] = { 0, 0, 0, 1 };
+  // store the pointDislocationVector_RAS components in the image
+  const double* displacementPtr = static_cast<double*>(displacementField->GetScalarPointer());
   float* voxelPtr = static_cast<float*>(vectorImage->GetScalarPointer());
-  int* extent = vectorImage->GetExtent();
-  for (point_IJK[2] = extent[4]; point_IJK[2] <= extent[5]; point_IJK[2]++)
+  vtkIdType numberOfComponents = 3 * vectorImage->GetNumberOfPoints();
+  for (vtkIdType componentIndex = 0; componentIndex < numberOfComponents; ++componentIndex)
   {
-    for (point_IJK[1] = extent[2]; point_IJK[1] <= extent[3]; point_IJK[1]++)
-    {
-      for (point_IJK[0] = extent[0]; point_IJK[0] <= extent[1]; point_IJK[0]++)
-      {
-        ijkToRAS->MultiplyPoint(point_IJK, point_RAS);
-
-        inputTransform->TransformPoint(point_RAS, transformedPoint_RAS);
-
-        // store the pointDislocationVector_RAS components in the image
-        *(voxelPtr++) = static_cast<float>(transformedPoint_RAS[0] - point_RAS[0]);
-        *(voxelPtr++) = static_cast<float>(transformedPoint_RAS[1] - point_RAS[1]);
-        *(voxelPtr++) = static_cast<float>(transformedPoint_RAS[2] - point_RAS[2]);
-      }
-    }
+    *(voxelPtr++) = static_cast<float>(*(displacementPtr++));
   }
 
   return true;
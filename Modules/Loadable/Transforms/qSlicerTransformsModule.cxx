@@ -137,7 +137,13 @@ void qSlicerTransformsModule::setup()
     "Transforms", QString("TransformFile"),
     QStringList() << "vtkMRMLTransformNode", true, this));
 
-  // Register displayable managers
+  // Register displayable managers. They are only instantiated in views when the scene contains transform display nodes.
+  vtkMRMLSliceViewDisplayableManagerFactory::GetInstance()->AddDisplayableManagerHandledNodeClass(
+    "vtkMRMLTransformsDisplayableManager2D", "vtkMRMLTransformDisplayNode");
+  vtkMRMLThreeDViewDisplayableManagerFactory::GetInstance()->AddDisplayableManagerHandledNodeClass(
+    "vtkMRMLTransformsDisplayableManager3D", "vtkMRMLTransformDisplayNode");
+  vtkMRMLThreeDViewDisplayableManagerFactory::GetInstance()->AddDisplayableManagerHandledNodeClass(
+    "vtkMRMLLinearTransformsDisplayableManager3D", "vtkMRMLTransformDisplayNode");
   vtkMRMLSliceViewDisplayableManagerFactory::GetInstance()->RegisterDisplayableManager("vtkMRMLTransformsDisplayableManager2D");
   vtkMRMLThreeDViewDisplayableManagerFactory::GetInstance()->RegisterDisplayableManager("vtkMRMLTransformsDisplayableManager3D");
   vtkMRMLThreeDViewDisplayableManagerFactory::GetInstance()->RegisterDisplayableManager("vtkMRMLLinearTransformsDisplayableManager3D");
@@ -39,20 +39,54 @@ vtkMRMLGPURayCastVolumeRenderingDisplayNode::~vtkMRMLGPURayCastVolumeRenderingDi
 //----------------------------------------------------------------------------
 void vtkMRMLGPURayCastVolumeRenderingDisplayNode::ReadXMLAttributes(const char** atts)
 {
+  int disabledModify = this->StartModify();
+
   this->Superclass::ReadXMLAttributes(atts);
 
-//  vtkMRMLReadXMLBeginMacro(atts);
-//  vtkMRMLReadXMLEndMacro();
+  vtkMRMLReadXMLBeginMacro(atts);
+  vtkMRMLReadXMLVectorMacro(partitions, Partitions, int, 3);
+  vtkMRMLReadXMLBooleanMacro(autoPartitioning, AutoPartitioning);
+  vtkMRMLReadXMLBooleanMacro(emptySpaceSkipping, EmptySpaceSkipping);
+  vtkMRMLReadXMLEndMacro();
+
+  this->EndModify(disabledModify);
 }
 
 //----------------------------------------------------------------------------
 void vtkMRMLGPURayCastVolumeRenderingDisplayNode::WriteXML(ostream& of, int nIndent)
 {
   this->Superclass::WriteXML(of, nIndent);
+
+  vtkMRMLWriteXMLBeginMacro(of);
+  vtkMRMLWriteXMLVectorMacro(partitions, Partitions, int, 3);
+  vtkMRMLWriteXMLBooleanMacro(autoPartitioning, AutoPartitioning);
+  vtkMRMLWriteXMLBooleanMacro(emptySpaceSkipping, EmptySpaceSkipping);
+  vtkMRMLWriteXMLEndMacro();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLGPURayCastVolumeRenderingDisplayNode::Copy(vtkMRMLNode *anode)
+{
+  int wasModifying = this->StartModify();
+  this->Superclass::Copy(anode);
+
+  vtkMRMLCopyBeginMacro(anode);
+  vtkMRMLCopyVectorMacro(Partitions, int, 3);
+  vtkMRMLCopyBooleanMacro(AutoPartitioning);
+  vtkMRMLCopyBooleanMacro(EmptySpaceSkipping);
+  vtkMRMLCopyEndMacro();
+
+  this->EndModify(wasModifying);
 }
 
 //----------------------------------------------------------------------------
 void vtkMRMLGPURayCastVolumeRenderingDisplayNode::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+
+  vtkMRMLPrintBeginMacro(os, indent);
+  vtkMRMLPrintVectorMacro(Partitions, int, 3);
+  vtkMRMLPrintBooleanMacro(AutoPartitioning);
+  vtkMRMLPrintBooleanMacro(EmptySpaceSkipping);
+  vtkMRMLPrintEndMacro();
 }
@@ -49,15 +49,46 @@ public:
   /// \sa vtkMRMLNode::CopyContent
   vtkMRMLCopyContentDefaultMacro(vtkMRMLGPURayCastVolumeRenderingDisplayNode);
 
+  /// Copy the node's attributes to this object
+  void Copy(vtkMRMLNode *node) override;
+
   // Description:
   // Get node XML tag name (like Volume, Model)
   const char* GetNodeTagName() override {return "GPURayCastVolumeRendering";}
 
+  /// Number of bricks the volume is split into along each IJK axis.
+  /// Bricks are uploaded to the GPU and rendered one after the other, which
+  /// allows rendering volumes that do not fit into the GPU memory or the
+  /// maximum 3D texture size at full resolution. Default is (1, 1, 1),
+  /// meaning that the volume is uploaded as a single texture.
+  /// \sa AutoPartitioning
+  vtkSetVector3Macro(Partitions, int);
+  vtkGetVector3Macro(Partitions, int);
+
+  /// If enabled, the number of bricks is computed from the volume size and
+  /// the GPU memory size of the view, and Partitions is ignored.
+  /// Disabled by default.
+  vtkSetMacro(AutoPartitioning, bool);
+  vtkGetMacro(AutoPartitioning, bool);
+  vtkBooleanMacro(AutoPartitioning, bool);
+
+  /// If enabled, rays are only cast through the bounding box of the regions
+  /// of the volume that are not fully transparent according to the current
+  /// scalar opacity transfer function. It only applies to single component
+  /// volumes rendered with composite blending. Disabled by default.
+  vtkSetMacro(EmptySpaceSkipping, bool);
+  vtkGetMacro(EmptySpaceSkipping, bool);
+  vtkBooleanMacro(EmptySpaceSkipping, bool);
+
 protected:
   vtkMRMLGPURayCastVolumeRenderingDisplayNode();
   ~vtkMRMLGPURayCastVolumeRenderingDisplayNode() override;
   vtkMRMLGPURayCastVolumeRenderingDisplayNode(const vtkMRMLGPURayCastVolumeRenderingDisplayNode&);
   void operator=(const vtkMRMLGPURayCastVolumeRenderingDisplayNode&);
+
+  int Partitions[3]{1, 1, 1};
+  bool AutoPartitioning{false};
+  bool EmptySpaceSkipping{false};
 };
 
 #endif
@@ -95,6 +95,9 @@ void vtkMRMLVolumeRenderingDisplayNode::ReadXMLAttributes(const char** atts)
   vtkMRMLReadXMLIntMacro(followVolumeDisplayNode, FollowVolumeDisplayNode);
   vtkMRMLReadXMLIntMacro(ignoreVolumeDisplayNodeThreshold, IgnoreVolumeDisplayNodeThreshold);
   vtkMRMLReadXMLIntMacro(useSingleVolumeProperty, UseSingleVolumeProperty);
+  vtkMRMLReadXMLBooleanMacro(progressiveRefinement, ProgressiveRefinement);
+  vtkMRMLReadXMLFloatMacro(interactiveImageSampleDistance, InteractiveImageSampleDistance);
+  vtkMRMLReadXMLIntMacro(numberOfRefinementSteps, NumberOfRefinementSteps);
   vtkMRMLReadXMLEndMacro();
 }
 
@@ -110,6 +113,9 @@ void vtkMRMLVolumeRenderingDisplayNode::WriteXML(ostream& of, int nIndent)
   vtkMRMLWriteXMLIntMacro(followVolumeDisplayNode, FollowVolumeDisplayNode);
   vtkMRMLWriteXMLIntMacro(ignoreVolumeDisplayNodeThreshold, IgnoreVolumeDisplayNodeThreshold);
   vtkMRMLWriteXMLIntMacro(useSingleVolumeProperty, UseSingleVolumeProperty);
+  vtkMRMLWriteXMLBooleanMacro(progressiveRefinement, ProgressiveRefinement);
+  vtkMRMLWriteXMLFloatMacro(interactiveImageSampleDistance, InteractiveImageSampleDistance);
+  vtkMRMLWriteXMLIntMacro(numberOfRefinementSteps, NumberOfRefinementSteps);
   vtkMRMLWriteXMLEndMacro();
 }
 
@@ -128,6 +134,9 @@ void vtkMRMLVolumeRenderingDisplayNode::Copy(vtkMRMLNode *anode)
   vtkMRMLCopyIntMacro(FollowVolumeDisplayNode);
   vtkMRMLCopyIntMacro(IgnoreVolumeDisplayNodeThreshold);
   vtkMRMLCopyIntMacro(UseSingleVolumeProperty);
+  vtkMRMLCopyBooleanMacro(ProgressiveRefinement);
+  vtkMRMLCopyFloatMacro(InteractiveImageSampleDistance);
+  vtkMRMLCopyIntMacro(NumberOfRefinementSteps);
   vtkMRMLCopyEndMacro();
 
   this->EndModify(wasModifying);
@@ -145,6 +154,9 @@ void vtkMRMLVolumeRenderingDisplayNode::PrintSelf(ostream& os, vtkIndent indent)
   vtkMRMLPrintIntMacro(FollowVolumeDisplayNode);
   vtkMRMLPrintIntMacro(IgnoreVolumeDisplayNodeThreshold);
   vtkMRMLPrintIntMacro(UseSingleVolumeProperty);
+  vtkMRMLPrintBooleanMacro(ProgressiveRefinement);
+  vtkMRMLPrintFloatMacro(InteractiveImageSampleDistance);
+  vtkMRMLPrintIntMacro(NumberOfRefinementSteps);
   vtkMRMLPrintEndMacro();
 }
 
@@ -88,6 +88,28 @@ public:
   vtkSetVector2Macro(WindowLevel, double);
   vtkGetVectorMacro(WindowLevel, double, 2);
 
+  /// If enabled, the GPU ray cast mappers render at reduced image resolution
+  /// and with a longer ray step while the view is interacted with, then the
+  /// image is refined over \sa NumberOfRefinementSteps frames up to full
+  /// quality once the interaction stops. Each refinement frame is requested
+  /// separately, so user input is processed between frames.
+  /// It replaces the automatic sample distance adjustment of the adaptive
+  /// rendering quality. Not used by the CPU ray cast mapper. Disabled by default.
+  vtkSetMacro(ProgressiveRefinement, bool);
+  vtkGetMacro(ProgressiveRefinement, bool);
+  vtkBooleanMacro(ProgressiveRefinement, bool);
+
+  /// Image sample distance (in pixels) used during interaction when
+  /// progressive refinement is enabled. The ray step is scaled by the same
+  /// factor. Default is 2.
+  vtkSetClampMacro(InteractiveImageSampleDistance, double, 1.0, 16.0);
+  vtkGetMacro(InteractiveImageSampleDistance, double);
+
+  /// Number of frames rendered after an interaction to go from interactive
+  /// to full quality when progressive refinement is enabled. Default is 3.
+  vtkSetClampMacro(NumberOfRefinementSteps, int, 1, 20);
+  vtkGetMacro(NumberOfRefinementSteps, int);
+
 protected:
   vtkMRMLVolumeRenderingDisplayNode();
   ~vtkMRMLVolumeRenderingDisplayNode() override;
@@ -117,6 +139,10 @@ protected:
 
   /// Volume window & level
   double WindowLevel[2];
+
+  bool ProgressiveRefinement{false};
+  double InteractiveImageSampleDistance{2.0};
+  int NumberOfRefinementSteps{3};
 };
 
 #endif
@@ -46,19 +46,26 @@
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkCallbackCommand.h>
+#if defined(Slicer_VTK_RENDERING_USE_OpenGL2_BACKEND)
+#include <vtkOpenGLGPUVolumeRayCastMapper.h>
+#include <vtkOpenGLRenderTimer.h>
+#endif
 #include <vtkFixedPointVolumeRayCastMapper.h>
 #include <vtkGPUVolumeRayCastMapper.h>
 #include <vtkImageAppendComponents.h>
 #include <vtkImageChangeInformation.h>
 #include <vtkImageLuminance.h>
 #include <vtkInteractorStyle.h>
+#include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkPlane.h>
 #include <vtkPlanes.h>
 #include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
 #include <vtkRenderer.h>
+#include <vtkSMPTools.h>
 #include <vtkMultiVolume.h>
 #include <vtkVolume.h>
 #include <vtkVolumeProperty.h>
@@ -69,6 +76,12 @@
 #include <vtkTrivialProducer.h> //TODO: Used for workaround. Remove when fixed
 #include <vtkPiecewiseFunction.h> //TODO: Used for workaround. Remove when fixed
 
+// STD includes
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <vector>
+
 // Register VTK object factory overrides
 #include <vtkAutoInit.h>
 #if defined(Slicer_VTK_RENDERING_USE_OpenGL2_BACKEND)
@@ -79,6 +92,83 @@ VTK_MODULE_INIT(vtkRenderingContextOpenGL);
 VTK_MODULE_INIT(vtkRenderingVolumeOpenGL);
 #endif
 
+namespace
+{
+
+/// Size of the blocks (in voxels) used for empty space skipping
+const int EMPTY_SPACE_SKIPPING_BLOCK_SIZE = 16;
+
+//---------------------------------------------------------------------------
+// Compute the scalar range of each block of the image. Blocks include the
+// first voxel layer of the next block, so that interpolated values within a
+// block are always within the block range.
+template <class T>
+void ComputeBlockScalarRanges(vtkImageData* imageData, T* scalars, const int gridDimensions[3],
+  std::vector<double>& blockMinimum, std::vector<double>& blockMaximum)
+{
+  int dimensions[3] = { 0, 0, 0 };
+  imageData->GetDimensions(dimensions);
+  const vtkIdType rowSize = dimensions[0];
+  const vtkIdType sliceSize = rowSize * dimensions[1];
+  const int blockSize = EMPTY_SPACE_SKIPPING_BLOCK_SIZE;
+  vtkSMPTools::For(0, gridDimensions[2], [&](int firstBlockK, int lastBlockK)
+    {
+    for (int blockK = firstBlockK; blockK < lastBlockK; ++blockK)
+      {
+      for (int blockJ = 0; blockJ < gridDimensions[1]; ++blockJ)
+        {
+        for (int blockI = 0; blockI < gridDimensions[0]; ++blockI)
+          {
+          double minimum = VTK_DOUBLE_MAX;
+          double maximum = VTK_DOUBLE_MIN;
+          int kEnd = std::min((blockK + 1) * blockSize + 1, dimensions[2]);
+          int jEnd = std::min((blockJ + 1) * blockSize + 1, dimensions[1]);
+          int iEnd = std::min((blockI + 1) * blockSize + 1, dimensions[0]);
+          for (int k = blockK * blockSize; k < kEnd; ++k)
+            {
+            for (int j = blockJ * blockSize; j < jEnd; ++j)
+              {
+              const T* row = scalars + k * sliceSize + j * rowSize;
+              for (int i = blockI * blockSize; i < iEnd; ++i)
+                {
+                double value = static_cast<double>(row[i]);
+                minimum = std::min(minimum, value);
+                maximum = std::max(maximum, value);
+                }
+              }
+            }
+          vtkIdType blockIndex = (vtkIdType(blockK) * gridDimensions[1] + blockJ) * gridDimensions[0] + blockI;
+          blockMinimum[blockIndex] = minimum;
+          blockMaximum[blockIndex] = maximum;
+          }
+        }
+      }
+    });
+}
+
+//---------------------------------------------------------------------------
+// Return true if the piecewise linear function is non-zero anywhere in the [minimum, maximum] range.
+bool IsOpaqueInRange(vtkPiecewiseFunction* opacity, double minimum, double maximum)
+{
+  if (opacity->GetValue(minimum) > 0.0 || opacity->GetValue(maximum) > 0.0)
+    {
+    return true;
+    }
+  // Segments are monotonic between nodes, so checking the nodes within the range is enough
+  double node[4] = { 0.0, 0.0, 0.0, 0.0 };
+  for (int i = 0; i < opacity->GetSize(); ++i)
+    {
+    opacity->GetNodeValue(i, node);
+    if (node[0] > minimum && node[0] < maximum && node[1] > 0.0)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+} // end of anonymous namespace
+
 //---------------------------------------------------------------------------
 vtkStandardNewMacro(vtkMRMLVolumeRenderingDisplayableManager);
 
@@ -114,6 +204,10 @@ public:
     vtkSmartPointer<vtkMatrix4x4> IJKToWorldMatrix;
     vtkSmartPointer<vtkImageLuminance> ComputeAlphaChannel;
     vtkSmartPointer<vtkImageAppendComponents> MergeAlphaChannelToRGB;
+
+    // Image that was last rendered, used for detecting texture uploads
+    vtkWeakPointer<vtkImageData> RenderedImage;
+    vtkMTimeType RenderedImageMTime{0};
   };
 
   //-------------------------------------------------------------------------
@@ -135,9 +229,36 @@ public:
   public:
     PipelineGPU() : Pipeline()
     {
-      this->RayCastMapperGPU = vtkSmartPointer<vtkGPUVolumeRayCastMapper>::New();
+      this->DefaultRayCastMapperGPU = vtkSmartPointer<vtkGPUVolumeRayCastMapper>::New();
+      this->RayCastMapperGPU = this->DefaultRayCastMapperGPU;
     }
+    /// Mapper that is currently used for rendering. It is either the default mapper
+    /// (connected to the volume node's image data) or one of the frame mappers.
     vtkSmartPointer<vtkGPUVolumeRayCastMapper> RayCastMapperGPU;
+    vtkSmartPointer<vtkGPUVolumeRayCastMapper> DefaultRayCastMapperGPU;
+
+    /// Mappers of recently displayed images of a volume sequence (4D volume rendering).
+    /// Each mapper keeps the textures of its own image in graphics memory, so switching
+    /// to a frame that has a mapper changes only the mapper of the volume actor.
+    struct FrameMapper
+    {
+      vtkWeakPointer<vtkImageData> Image;
+      vtkSmartPointer<vtkGPUVolumeRayCastMapper> Mapper;
+      vtkIdType TextureMemorySizeInBytes{0};
+      // Image modification time when it was last rendered, used for detecting texture uploads
+      vtkMTimeType RenderedImageMTime{0};
+    };
+    /// Most recently used frame first
+    std::list<FrameMapper> FrameMappers;
+
+    // Scalar range of blocks of the volume, used for empty space skipping.
+    // Only recomputed when the image changes, transfer function changes only
+    // require checking the block ranges.
+    mutable vtkWeakPointer<vtkImageData> BlockRangesImage;
+    mutable vtkMTimeType BlockRangesImageMTime{0};
+    mutable int BlockGridDimensions[3]{0, 0, 0};
+    mutable std::vector<double> BlockMinimum;
+    mutable std::vector<double> BlockMaximum;
   };
   //-------------------------------------------------------------------------
   class PipelineMultiVolume : public Pipeline
@@ -171,6 +292,11 @@ public:
 
   // ROIs
   void UpdatePipelineROIs(vtkMRMLVolumeRenderingDisplayNode* displayNode, const Pipeline* pipeline);
+  /// Get the IJK extent of the region of the volume that is not fully transparent.
+  /// Returns false if empty space skipping is not applicable.
+  bool GetOpaqueExtent(vtkMRMLVolumeRenderingDisplayNode* displayNode, const Pipeline* pipeline, int opaqueExtent[6]);
+  /// Add clipping planes that restrict rendering to the non-transparent region of the volume
+  void AddEmptySpaceSkippingPlanes(vtkMRMLVolumeRenderingDisplayNode* displayNode, const Pipeline* pipeline, vtkPlanes* planes);
 
   // Display Nodes
   void AddDisplayNode(vtkMRMLVolumeRenderingDisplayNode* displayNode);
@@ -181,8 +307,44 @@ public:
 
   double GetFramerate();
   vtkIdType GetMaxMemoryInBytes(vtkMRMLVolumeRenderingDisplayNode* displayNode);
+  /// Set the number of bricks the GPU mapper splits the volume into
+  void UpdateGPUMapperPartitions(vtkGPUVolumeRayCastMapper* gpuMapper,
+    vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode, vtkImageData* imageData, int numberOfChannels);
+
+  // 4D volume rendering
+  /// Select the GPU mapper of the pipeline that renders the image. If frame caching is
+  /// enabled in the view node then a mapper is kept for each recently displayed image,
+  /// within the VolumeRenderingFrameCacheSize memory budget.
+  void UpdateGPUFrameMapper(PipelineGPU* pipeline, vtkImageData* imageData, int numberOfChannels);
+  /// Delete the frame mappers of the pipeline and free their graphics resources
+  void RemoveGPUFrameMappers(PipelineGPU* pipeline);
   void UpdateDesiredUpdateRate(vtkMRMLVolumeRenderingDisplayNode* displayNode);
 
+  // Progressive refinement
+  /// Get the factor the image and ray sample distances are multiplied with at the current refinement step
+  double GetRefinementFactor(vtkMRMLVolumeRenderingDisplayNode* displayNode);
+  /// Apply the current refinement factor to a GPU mapper
+  void ApplyRefinementFactor(vtkGPUVolumeRayCastMapper* gpuMapper, double sampleDistance, double refinementFactor);
+  /// Switch to interactive quality or start refining the image to full quality
+  void SetInteractiveRendering(bool interactive);
+  /// Render the next refinement step, called after each render
+  void OnRenderEnd();
+  static void RenderEndCallback(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+
+  // Performance statistics
+  /// Start timing the frame, called before each render
+  void OnRenderStart();
+  static void RenderStartCallback(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+  /// Collect frame times and texture sizes and store them in the view node, called after each render
+  void UpdateStatistics();
+  /// Estimated size of the textures of the volume in bytes. Returns 0 if the volume is not rendered on the GPU.
+  vtkIdType GetTextureMemorySizeInBytes(const Pipeline* pipeline);
+  /// Estimated size of the textures of an image in bytes
+  static vtkIdType GetImageTextureMemorySizeInBytes(vtkImageData* imageData);
+  /// Adjust the desired update rate of the view based on the measured frame time
+  void UpdateDesiredUpdateRateFromFrameTime(double frameTimeMs);
+  void ReleaseRenderTimers();
+
   // Observations
   void AddObservations(vtkMRMLVolumeNode* node);
   void RemoveObservations(vtkMRMLVolumeNode* node);
@@ -217,6 +379,26 @@ public:
   /// When interaction is >0, we are in interactive mode (low level of detail)
   int Interaction;
 
+  /// Number of frames left until full quality is reached with progressive refinement.
+  /// Set to InteractiveRefinementStep while the view is interacted with.
+  int RefinementStep;
+  static const int InteractiveRefinementStep = VTK_INT_MAX;
+  vtkSmartPointer<vtkCallbackCommand> RenderEndCallbackCommand;
+  vtkSmartPointer<vtkCallbackCommand> RenderStartCallbackCommand;
+
+#if defined(Slicer_VTK_RENDERING_USE_OpenGL2_BACKEND)
+  /// GPU timer queries of rendered frames. Query results become available a few frames
+  /// later, so timers are kept in the queue until their result is ready.
+  std::deque<vtkOpenGLRenderTimer*> RenderTimers;
+  static const int MaximumNumberOfRenderTimers = 5;
+#endif
+  /// Frame time of the last measured frame in milliseconds
+  double FrameTime{0.0};
+  /// Frame time of the last frame that uploaded volume textures, in milliseconds
+  double TextureUploadTime{0.0};
+  /// Set when the current frame uploads volume textures
+  bool TextureUploadInFrame{false};
+
   /// Picker of volume in renderer
   vtkSmartPointer<vtkVolumePicker> VolumePicker;
 
@@ -244,6 +426,7 @@ vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::vtkInternal(vtkMRMLVolume
 , AddingVolumeNode(false)
 , OriginalDesiredUpdateRate(0.0) // 0 fps is a special value that means it hasn't been set
 , Interaction(0)
+, RefinementStep(0)
 , PickedNodeID("")
 {
   this->MultiVolumeActor = vtkSmartPointer<vtkMultiVolume>::New();
@@ -282,6 +465,14 @@ vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::vtkInternal(vtkMRMLVolume
 
   this->VolumePicker = vtkSmartPointer<vtkVolumePicker>::New();
   this->VolumePicker->SetTolerance(0.005);
+
+  this->RenderEndCallbackCommand = vtkSmartPointer<vtkCallbackCommand>::New();
+  this->RenderEndCallbackCommand->SetCallback(vtkInternal::RenderEndCallback);
+  this->RenderEndCallbackCommand->SetClientData(this);
+
+  this->RenderStartCallbackCommand = vtkSmartPointer<vtkCallbackCommand>::New();
+  this->RenderStartCallbackCommand->SetCallback(vtkInternal::RenderStartCallback);
+  this->RenderStartCallbackCommand->SetClientData(this);
 }
 
 //---------------------------------------------------------------------------
@@ -636,6 +827,11 @@ vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::RemovePipelineIt(Pipeline
 
   if (pipeline)
   {
+    PipelineGPU* pipelineGpu = dynamic_cast<PipelineGPU*>(pipeline);
+    if (pipelineGpu)
+      {
+      this->RemoveGPUFrameMappers(pipelineGpu);
+      }
     if (pipeline->VolumeActor)
       {
       this->External->GetRenderer()->RemoveVolume(pipeline->VolumeActor);
@@ -919,6 +1115,12 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateDisplayNodePip
     {
     vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode =
       vtkMRMLGPURayCastVolumeRenderingDisplayNode::SafeDownCast(displayNode);
+    PipelineGPU* pipelineGpu = dynamic_cast<PipelineGPU*>(this->GetPipeline(displayNode));
+    if (pipelineGpu)
+      {
+      this->UpdateGPUFrameMapper(pipelineGpu, imageData, numberOfChannels);
+      mapper = pipelineGpu->RayCastMapperGPU;
+      }
     vtkGPUVolumeRayCastMapper* gpuMapper = vtkGPUVolumeRayCastMapper::SafeDownCast(mapper);
 
     switch (viewNode->GetVolumeRenderingQuality())
@@ -940,14 +1142,17 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateDisplayNodePip
         break;
       }
 
-    gpuMapper->SetSampleDistance(gpuDisplayNode->GetSampleDistance());
+    this->ApplyRefinementFactor(gpuMapper, gpuDisplayNode->GetSampleDistance(), this->GetRefinementFactor(gpuDisplayNode));
     gpuMapper->SetMaxMemoryInBytes(this->GetMaxMemoryInBytes(gpuDisplayNode));
+    this->UpdateGPUMapperPartitions(gpuMapper, gpuDisplayNode, imageData, numberOfChannels);
 
     // Make sure the correct mapper is set to the volume
     pipeline->VolumeActor->SetMapper(mapper);
-    // Make sure the correct volume is set to the mapper
+    // Make sure the correct volume is set to the mapper.
+    // Frame mappers are connected to their own image.
     // Reconnection is expensive operation, therefore only do it if needed
-    if (mapper->GetInputConnection(0, 0) != imageConnection)
+    if (mapper->GetInputConnection(0, 0) != imageConnection
+      && (!pipelineGpu || mapper == pipelineGpu->DefaultRayCastMapperGPU))
       {
       mapper->SetInputConnection(0, imageConnection);
       }
@@ -1047,29 +1252,186 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdatePipelineROIs(
     vtkErrorWithObjectMacro(this->External, "UpdatePipelineROIs: Unable to get volume mapper");
     return;
     }
-  if (!displayNode || displayNode->GetROINode() == nullptr || !displayNode->GetCroppingEnabled())
+  vtkNew<vtkPlanes> planes;
+  if (displayNode && displayNode->GetROINode() != nullptr && displayNode->GetCroppingEnabled())
+    {
+    vtkMRMLMarkupsROINode* markupsROINode = displayNode->GetMarkupsROINode();
+    vtkMRMLAnnotationROINode* annotationRoiNode = displayNode->GetAnnotationROINode();
+    if (markupsROINode)
+      {
+      // Calculate and set clipping planes
+      markupsROINode->GetTransformedPlanes(planes.GetPointer(), true);
+      }
+    else if (annotationRoiNode)
+      {
+      // Make sure the ROI node's inside out flag is on
+      annotationRoiNode->InsideOutOn();
+
+      // Calculate and set clipping planes
+      annotationRoiNode->GetTransformedPlanes(planes.GetPointer());
+      }
+    }
+  this->AddEmptySpaceSkippingPlanes(displayNode, pipeline, planes);
+  if (planes->GetNumberOfPlanes() == 0)
     {
     volumeMapper->RemoveAllClippingPlanes();
     return;
     }
+  volumeMapper->SetClippingPlanes(planes.GetPointer());
+}
 
-  vtkMRMLMarkupsROINode* markupsROINode = displayNode->GetMarkupsROINode();
-  vtkMRMLAnnotationROINode* annotationRoiNode = displayNode->GetAnnotationROINode();
-  vtkNew<vtkPlanes> planes;
-  if (markupsROINode)
+//---------------------------------------------------------------------------
+bool vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetOpaqueExtent(
+  vtkMRMLVolumeRenderingDisplayNode* displayNode, const Pipeline* pipeline, int opaqueExtent[6])
+{
+  vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode =
+    vtkMRMLGPURayCastVolumeRenderingDisplayNode::SafeDownCast(displayNode);
+  const PipelineGPU* pipelineGpu = dynamic_cast<const PipelineGPU*>(pipeline);
+  vtkMRMLViewNode* viewNode = this->External->GetMRMLViewNode();
+  if (!gpuDisplayNode || !pipelineGpu || !gpuDisplayNode->GetEmptySpaceSkipping()
+    || !viewNode || viewNode->GetRaycastTechnique() != vtkMRMLViewNode::Composite)
+    {
+    // Maximum and minimum intensity projections depend on transparent voxels too
+    return false;
+    }
+  vtkMRMLVolumeNode* volumeNode = gpuDisplayNode->GetVolumeNode();
+  vtkImageData* imageData = volumeNode ? volumeNode->GetImageData() : nullptr;
+  vtkMRMLVolumePropertyNode* volumePropertyNode = gpuDisplayNode->GetVolumePropertyNode();
+  vtkVolumeProperty* volumeProperty = volumePropertyNode ? volumePropertyNode->GetVolumeProperty() : nullptr;
+  if (!imageData || !volumeProperty || imageData->GetNumberOfScalarComponents() != 1
+    || !imageData->GetPointData() || !imageData->GetPointData()->GetScalars())
     {
-    // Calculate and set clipping planes
-    markupsROINode->GetTransformedPlanes(planes.GetPointer(), true);
+    return false;
     }
-  else if (annotationRoiNode)
+  vtkPiecewiseFunction* opacity = volumeProperty->GetScalarOpacity();
+  if (!opacity)
     {
-    // Make sure the ROI node's inside out flag is on
-    annotationRoiNode->InsideOutOn();
+    return false;
+    }
 
-    // Calculate and set clipping planes
-    annotationRoiNode->GetTransformedPlanes(planes.GetPointer());
+  // Update block scalar ranges if the image has changed
+  int dimensions[3] = { 0, 0, 0 };
+  imageData->GetDimensions(dimensions);
+  const int blockSize = EMPTY_SPACE_SKIPPING_BLOCK_SIZE;
+  if (pipelineGpu->BlockRangesImage != imageData || pipelineGpu->BlockRangesImageMTime != imageData->GetMTime())
+    {
+    vtkIdType numberOfBlocks = 1;
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      pipelineGpu->BlockGridDimensions[axis] = std::max(1, (dimensions[axis] - 1 + blockSize - 1) / blockSize);
+      numberOfBlocks *= pipelineGpu->BlockGridDimensions[axis];
+      }
+    pipelineGpu->BlockMinimum.resize(numberOfBlocks);
+    pipelineGpu->BlockMaximum.resize(numberOfBlocks);
+    switch (imageData->GetScalarType())
+      {
+      vtkTemplateMacro(ComputeBlockScalarRanges(imageData, static_cast<VTK_TT*>(imageData->GetScalarPointer()),
+        pipelineGpu->BlockGridDimensions, pipelineGpu->BlockMinimum, pipelineGpu->BlockMaximum));
+      default:
+        return false;
+      }
+    pipelineGpu->BlockRangesImage = imageData;
+    pipelineGpu->BlockRangesImageMTime = imageData->GetMTime();
+    }
+
+  // Find the bounding box of the blocks that are not fully transparent
+  int opaqueBlocks[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN };
+  const int* gridDimensions = pipelineGpu->BlockGridDimensions;
+  for (int blockK = 0; blockK < gridDimensions[2]; ++blockK)
+    {
+    for (int blockJ = 0; blockJ < gridDimensions[1]; ++blockJ)
+      {
+      for (int blockI = 0; blockI < gridDimensions[0]; ++blockI)
+        {
+        vtkIdType blockIndex = (vtkIdType(blockK) * gridDimensions[1] + blockJ) * gridDimensions[0] + blockI;
+        if (!IsOpaqueInRange(opacity, pipelineGpu->BlockMinimum[blockIndex], pipelineGpu->BlockMaximum[blockIndex]))
+          {
+          continue;
+          }
+        opaqueBlocks[0] = std::min(opaqueBlocks[0], blockI);
+        opaqueBlocks[1] = std::max(opaqueBlocks[1], blockI);
+        opaqueBlocks[2] = std::min(opaqueBlocks[2], blockJ);
+        opaqueBlocks[3] = std::max(opaqueBlocks[3], blockJ);
+        opaqueBlocks[4] = std::min(opaqueBlocks[4], blockK);
+        opaqueBlocks[5] = std::max(opaqueBlocks[5], blockK);
+        }
+      }
+    }
+  if (opaqueBlocks[0] > opaqueBlocks[1])
+    {
+    // Fully transparent volume, nothing to skip
+    return false;
+    }
+
+  int* extent = imageData->GetExtent();
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    opaqueExtent[axis * 2] = extent[axis * 2] + opaqueBlocks[axis * 2] * blockSize;
+    opaqueExtent[axis * 2 + 1] = std::min(extent[axis * 2] + (opaqueBlocks[axis * 2 + 1] + 1) * blockSize, extent[axis * 2 + 1]);
+    }
+  return true;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::AddEmptySpaceSkippingPlanes(
+  vtkMRMLVolumeRenderingDisplayNode* displayNode, const Pipeline* pipeline, vtkPlanes* planes)
+{
+  int opaqueExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  if (!this->GetOpaqueExtent(displayNode, pipeline, opaqueExtent))
+    {
+    return;
+    }
+  vtkMRMLVolumeNode* volumeNode = displayNode->GetVolumeNode();
+  vtkNew<vtkMatrix4x4> ijkToWorldMatrix;
+  if (!this->GetVolumeTransformToWorld(volumeNode, ijkToWorldMatrix))
+    {
+    return;
+    }
+  // Normals are transformed by the inverse transpose matrix
+  vtkNew<vtkMatrix4x4> worldToIJKMatrix;
+  vtkMatrix4x4::Invert(ijkToWorldMatrix, worldToIJKMatrix);
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> normals;
+  normals->SetNumberOfComponents(3);
+  if (planes->GetNumberOfPlanes() > 0)
+    {
+    points->DeepCopy(planes->GetPoints());
+    normals->DeepCopy(planes->GetNormals());
+    }
+  int* extent = volumeNode->GetImageData()->GetExtent();
+  bool planeAdded = false;
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    for (int side = 0; side < 2; ++side)
+      {
+      if (opaqueExtent[axis * 2 + side] == extent[axis * 2 + side])
+        {
+        // No empty space on this side
+        continue;
+        }
+      double pointIJK[4] = { 0.0, 0.0, 0.0, 1.0 };
+      pointIJK[axis] = opaqueExtent[axis * 2 + side];
+      double normalIJK[3] = { 0.0, 0.0, 0.0 };
+      normalIJK[axis] = (side == 0 ? 1.0 : -1.0); // pointing inside
+      double pointWorld[4] = { 0.0, 0.0, 0.0, 1.0 };
+      ijkToWorldMatrix->MultiplyPoint(pointIJK, pointWorld);
+      double normalWorld[3] = { 0.0, 0.0, 0.0 };
+      for (int row = 0; row < 3; ++row)
+        {
+        normalWorld[row] = worldToIJKMatrix->GetElement(axis, row) * normalIJK[axis];
+        }
+      vtkMath::Normalize(normalWorld);
+      points->InsertNextPoint(pointWorld);
+      normals->InsertNextTuple(normalWorld);
+      planeAdded = true;
+      }
+    }
+  if (planeAdded)
+    {
+    planes->SetPoints(points);
+    planes->SetNormals(normals);
     }
-  volumeMapper->SetClippingPlanes(planes.GetPointer());
 }
 
 //---------------------------------------------------------------------------
@@ -1121,6 +1483,162 @@ vtkIdType vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetMaxMemoryInB
   return gpuMemorySizeB;
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateGPUMapperPartitions(
+  vtkGPUVolumeRayCastMapper* gpuMapper, vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode,
+  vtkImageData* imageData, int numberOfChannels)
+{
+#if defined(Slicer_VTK_RENDERING_USE_OpenGL2_BACKEND)
+  vtkOpenGLGPUVolumeRayCastMapper* openGLMapper = vtkOpenGLGPUVolumeRayCastMapper::SafeDownCast(gpuMapper);
+  if (!openGLMapper || !gpuDisplayNode)
+    {
+    return;
+    }
+
+  int partitions[3] = { 1, 1, 1 };
+  if (!gpuDisplayNode->GetAutoPartitioning())
+    {
+    gpuDisplayNode->GetPartitions(partitions);
+    }
+  else if (imageData)
+    {
+    // Split the longest brick axis until a brick fits into the GPU memory and
+    // into the maximum 3D texture size supported by most graphics cards.
+    const int maxBrickSize = 2048;
+    const int maxNumberOfPartitions = 64;
+    int dimensions[3] = { 0, 0, 0 };
+    imageData->GetDimensions(dimensions);
+    // RGB volumes are uploaded with an additional alpha channel
+    int numberOfComponents = (numberOfChannels == 3 ? 4 : numberOfChannels);
+    vtkIdType voxelSizeInBytes = vtkIdType(imageData->GetScalarSize()) * numberOfComponents;
+    vtkIdType maxBrickSizeInBytes = this->GetMaxMemoryInBytes(gpuDisplayNode);
+    while (true)
+      {
+      int brickDimensions[3] = { 0, 0, 0 };
+      vtkIdType brickSizeInBytes = voxelSizeInBytes;
+      int longestAxis = 0;
+      for (int axis = 0; axis < 3; ++axis)
+        {
+        brickDimensions[axis] = (dimensions[axis] + partitions[axis] - 1) / partitions[axis];
+        brickSizeInBytes *= brickDimensions[axis];
+        if (brickDimensions[axis] > brickDimensions[longestAxis])
+          {
+          longestAxis = axis;
+          }
+        }
+      if (brickSizeInBytes <= maxBrickSizeInBytes && brickDimensions[longestAxis] <= maxBrickSize)
+        {
+        break;
+        }
+      if (brickDimensions[longestAxis] <= 1
+        || partitions[0] * partitions[1] * partitions[2] * 2 > maxNumberOfPartitions)
+        {
+        // Cannot split any further, the mapper will use the largest bricks we allow
+        break;
+        }
+      partitions[longestAxis] *= 2;
+      }
+    }
+
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    partitions[axis] = std::max(1, std::min(partitions[axis], static_cast<int>(VTK_UNSIGNED_SHORT_MAX)));
+    }
+  openGLMapper->SetPartitions(partitions[0], partitions[1], partitions[2]);
+#else
+  (void)gpuMapper;
+  (void)gpuDisplayNode;
+  (void)imageData;
+  (void)numberOfChannels;
+#endif
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateGPUFrameMapper(
+  PipelineGPU* pipeline, vtkImageData* imageData, int numberOfChannels)
+{
+  vtkMRMLViewNode* viewNode = this->External->GetMRMLViewNode();
+  vtkIdType frameCacheSizeInBytes = viewNode ? vtkIdType(viewNode->GetVolumeRenderingFrameCacheSize()) * 1024 * 1024 : 0;
+  // RGB volumes are rendered through the alpha channel generating pipeline, they are not cached
+  if (frameCacheSizeInBytes <= 0 || !imageData || numberOfChannels == 3)
+    {
+    this->RemoveGPUFrameMappers(pipeline);
+    return;
+    }
+
+  // Remove mappers of deleted images
+  pipeline->FrameMappers.remove_if([](const PipelineGPU::FrameMapper& frameMapper)
+    {
+    return frameMapper.Image.GetPointer() == nullptr;
+    });
+
+  std::list<PipelineGPU::FrameMapper>::iterator frameMapperIt = std::find_if(
+    pipeline->FrameMappers.begin(), pipeline->FrameMappers.end(), [imageData](const PipelineGPU::FrameMapper& frameMapper)
+    {
+    return frameMapper.Image == imageData;
+    });
+  if (frameMapperIt != pipeline->FrameMappers.end())
+    {
+    // Mark as most recently used
+    pipeline->FrameMappers.splice(pipeline->FrameMappers.begin(), pipeline->FrameMappers, frameMapperIt);
+    }
+  else
+    {
+    PipelineGPU::FrameMapper frameMapper;
+    frameMapper.Image = imageData;
+    frameMapper.Mapper = vtkSmartPointer<vtkGPUVolumeRayCastMapper>::New();
+    frameMapper.Mapper->SetInputData(imageData);
+    frameMapper.TextureMemorySizeInBytes = GetImageTextureMemorySizeInBytes(imageData);
+    pipeline->FrameMappers.push_front(frameMapper);
+    }
+
+  vtkRenderWindow* renderWindow = this->External->GetRenderer()->GetRenderWindow();
+  if (pipeline->RayCastMapperGPU == pipeline->DefaultRayCastMapperGPU && renderWindow)
+    {
+    // The default mapper is not used while frames are cached
+    pipeline->DefaultRayCastMapperGPU->ReleaseGraphicsResources(renderWindow);
+    }
+  pipeline->RayCastMapperGPU = pipeline->FrameMappers.front().Mapper;
+
+  // Delete least recently used frames that do not fit into the budget.
+  // The current frame is always kept.
+  vtkIdType textureMemorySizeInBytes = 0;
+  for (const PipelineGPU::FrameMapper& frameMapper : pipeline->FrameMappers)
+    {
+    textureMemorySizeInBytes += frameMapper.TextureMemorySizeInBytes;
+    }
+  while (textureMemorySizeInBytes > frameCacheSizeInBytes && pipeline->FrameMappers.size() > 1)
+    {
+    PipelineGPU::FrameMapper& frameMapper = pipeline->FrameMappers.back();
+    textureMemorySizeInBytes -= frameMapper.TextureMemorySizeInBytes;
+    if (renderWindow)
+      {
+      frameMapper.Mapper->ReleaseGraphicsResources(renderWindow);
+      }
+    pipeline->FrameMappers.pop_back();
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::RemoveGPUFrameMappers(PipelineGPU* pipeline)
+{
+  if (pipeline->FrameMappers.empty())
+    {
+    return;
+    }
+  vtkRenderWindow* renderWindow = this->External->GetRenderer()->GetRenderWindow();
+  if (renderWindow)
+    {
+    for (PipelineGPU::FrameMapper& frameMapper : pipeline->FrameMappers)
+      {
+      frameMapper.Mapper->ReleaseGraphicsResources(renderWindow);
+      }
+    }
+  pipeline->FrameMappers.clear();
+  pipeline->RayCastMapperGPU = pipeline->DefaultRayCastMapperGPU;
+  pipeline->VolumeActor->SetMapper(pipeline->RayCastMapperGPU);
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateDesiredUpdateRate(vtkMRMLVolumeRenderingDisplayNode* displayNode)
 {
@@ -1139,6 +1657,16 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateDesiredUpdateR
       // It will then be restored when the volume rendering is hidden
       this->OriginalDesiredUpdateRate = renderWindowInteractor->GetDesiredUpdateRate();
       }
+    else
+      {
+      vtkMRMLViewNode* viewNode = this->External->GetMRMLViewNode();
+      if (viewNode && viewNode->GetVolumeRenderingUseMeasuredFrameTime()
+        && viewNode->GetVolumeRenderingQuality() == vtkMRMLViewNode::Adaptive)
+        {
+        // The update rate is adjusted from the measured frame times, see UpdateDesiredUpdateRateFromFrameTime
+        return;
+        }
+      }
 
     // VTK is overly cautious when estimates rendering speed.
     // This usually results in lower quality and higher frame rates than requested.
@@ -1258,6 +1786,7 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateMultiVolumeMap
   double minimumSampleDistance = 1.0;
   double sumVolumeSpacing = 0.0;
   int numberOfVisibleVolumes = 0;
+  double refinementFactor = 1.0;
   for (Pipeline* pipeline : this->DisplayPipelines)
     {
     vtkMRMLMultiVolumeRenderingDisplayNode* multiDisplayNode =
@@ -1313,6 +1842,7 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateMultiVolumeMap
     //sumVolumeSpacing = (spacing[0] + spacing[1] + spacing[2]) / 3.0;
     sumVolumeSpacing += sampleDistance;
     numberOfVisibleVolumes++;
+    refinementFactor = std::max(refinementFactor, this->GetRefinementFactor(multiDisplayNode));
     }
 
   if (numberOfVisibleVolumes == 0)
@@ -1335,7 +1865,301 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateMultiVolumeMap
     this->MultiVolumeDummyTrivialProducer->SetOutput(this->MultiVolumeDummyImage);
     }
 
-  gpuMultiMapper->SetSampleDistance(minimumSampleDistance);
+  this->ApplyRefinementFactor(gpuMultiMapper, minimumSampleDistance, refinementFactor);
+}
+
+//---------------------------------------------------------------------------
+double vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetRefinementFactor(
+  vtkMRMLVolumeRenderingDisplayNode* displayNode)
+{
+  if (!displayNode || !displayNode->GetProgressiveRefinement() || this->RefinementStep <= 0)
+    {
+    return 1.0;
+    }
+  int numberOfSteps = std::max(displayNode->GetNumberOfRefinementSteps(), 1);
+  int step = std::min(this->RefinementStep, numberOfSteps);
+  return 1.0 + (displayNode->GetInteractiveImageSampleDistance() - 1.0) * step / numberOfSteps;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::ApplyRefinementFactor(
+  vtkGPUVolumeRayCastMapper* gpuMapper, double sampleDistance, double refinementFactor)
+{
+  if (refinementFactor > 1.0)
+    {
+    // Use fixed reduced quality instead of the automatic adjustment
+    gpuMapper->SetAutoAdjustSampleDistances(false);
+    gpuMapper->SetLockSampleDistanceToInputSpacing(false);
+    }
+  gpuMapper->SetImageSampleDistance(refinementFactor);
+  gpuMapper->SetSampleDistance(sampleDistance * refinementFactor);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::SetInteractiveRendering(bool interactive)
+{
+  if (interactive)
+    {
+    this->RefinementStep = InteractiveRefinementStep;
+    return;
+    }
+  int numberOfSteps = 0;
+  for (Pipeline* pipeline : this->DisplayPipelines)
+    {
+    if (pipeline->DisplayNode && pipeline->DisplayNode->GetProgressiveRefinement())
+      {
+      numberOfSteps = std::max(numberOfSteps, pipeline->DisplayNode->GetNumberOfRefinementSteps());
+      }
+    }
+  // The first frame after the interaction is already one step finer
+  this->RefinementStep = std::max(numberOfSteps - 1, 0);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::OnRenderEnd()
+{
+  this->UpdateStatistics();
+
+  if (this->RefinementStep <= 0 || this->RefinementStep == InteractiveRefinementStep)
+    {
+    return;
+    }
+  --this->RefinementStep;
+  for (Pipeline* pipeline : this->DisplayPipelines)
+    {
+    if (pipeline->DisplayNode && pipeline->DisplayNode->GetProgressiveRefinement()
+      && this->IsVisible(pipeline->DisplayNode))
+      {
+      this->UpdateDisplayNodePipeline(pipeline->DisplayNode, pipeline);
+      }
+    }
+  // Render the next step asynchronously, so that user input is processed in between
+  this->External->RequestRender();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::RenderEndCallback(
+  vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkInternal* self = reinterpret_cast<vtkInternal*>(clientData);
+  self->OnRenderEnd();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::OnRenderStart()
+{
+  // Volume image changes are uploaded to the GPU in this frame
+  this->TextureUploadInFrame = false;
+  bool volumeVisible = false;
+  for (Pipeline* pipeline : this->DisplayPipelines)
+    {
+    if (!pipeline->VolumeActor->GetVisibility())
+      {
+      continue;
+      }
+    volumeVisible = true;
+    vtkMRMLVolumeNode* volumeNode = pipeline->DisplayNode ? pipeline->DisplayNode->GetVolumeNode() : nullptr;
+    vtkImageData* imageData = volumeNode ? volumeNode->GetImageData() : nullptr;
+    if (!imageData || this->GetTextureMemorySizeInBytes(pipeline) == 0)
+      {
+      continue;
+      }
+    PipelineGPU* pipelineGpu = dynamic_cast<PipelineGPU*>(pipeline);
+    if (pipelineGpu && !pipelineGpu->FrameMappers.empty() && pipelineGpu->FrameMappers.front().Image == imageData)
+      {
+      // Cached frames are only uploaded when they are rendered first or their voxels are modified
+      PipelineGPU::FrameMapper& frameMapper = pipelineGpu->FrameMappers.front();
+      if (frameMapper.RenderedImageMTime != imageData->GetMTime())
+        {
+        this->TextureUploadInFrame = true;
+        frameMapper.RenderedImageMTime = imageData->GetMTime();
+        }
+      pipeline->RenderedImage = imageData;
+      pipeline->RenderedImageMTime = imageData->GetMTime();
+      continue;
+      }
+    if (pipeline->RenderedImage != imageData || pipeline->RenderedImageMTime != imageData->GetMTime())
+      {
+      this->TextureUploadInFrame = true;
+      pipeline->RenderedImage = imageData;
+      pipeline->RenderedImageMTime = imageData->GetMTime();
+      }
+    }
+
+#if defined(Slicer_VTK_RENDERING_USE_OpenGL2_BACKEND)
+  if (!volumeVisible || !vtkOpenGLRenderTimer::IsSupported()
+    || static_cast<int>(this->RenderTimers.size()) >= MaximumNumberOfRenderTimers)
+    {
+    // Only frames with volumes are timed. If query results are not read back
+    // fast enough then timing of the frame is skipped.
+    return;
+    }
+  // The render window's OpenGL context is current during rendering
+  vtkOpenGLRenderTimer* timer = new vtkOpenGLRenderTimer;
+  timer->Start();
+  this->RenderTimers.push_back(timer);
+#else
+  (void)volumeVisible;
+#endif
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::RenderStartCallback(
+  vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkInternal* self = reinterpret_cast<vtkInternal*>(clientData);
+  self->OnRenderStart();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateStatistics()
+{
+  vtkMRMLViewNode* viewNode = this->External->GetMRMLViewNode();
+  if (!viewNode)
+    {
+    return;
+    }
+
+  bool frameTimeMeasured = false;
+#if defined(Slicer_VTK_RENDERING_USE_OpenGL2_BACKEND)
+  // Stop the timer started for this frame
+  if (!this->RenderTimers.empty() && this->RenderTimers.back()->Started() && !this->RenderTimers.back()->Stopped())
+    {
+    this->RenderTimers.back()->Stop();
+    }
+  // Use the result of the most recent frame that is available
+  while (!this->RenderTimers.empty() && this->RenderTimers.front()->Ready())
+    {
+    vtkOpenGLRenderTimer* timer = this->RenderTimers.front();
+    this->FrameTime = timer->GetElapsedMilliseconds();
+    frameTimeMeasured = true;
+    timer->ReleaseGraphicsResources();
+    delete timer;
+    this->RenderTimers.pop_front();
+    }
+  if (!vtkOpenGLRenderTimer::IsSupported())
+#endif
+    {
+    // GPU timer queries are not available, use the CPU time of the render
+    this->FrameTime = this->External->GetRenderer()->GetLastRenderTimeInSeconds() * 1000.0;
+    frameTimeMeasured = true;
+    }
+
+  // GPU timer results arrive a few frames later, but a texture upload
+  // makes the following frame times longer too, so this is a reasonable estimate.
+  if (this->TextureUploadInFrame)
+    {
+    this->TextureUploadTime = this->FrameTime;
+    }
+
+  vtkIdType textureMemorySizeInBytes = 0;
+  bool volumeVisible = false;
+  for (Pipeline* pipeline : this->DisplayPipelines)
+    {
+    if (pipeline->VolumeActor->GetVisibility())
+      {
+      volumeVisible = true;
+      textureMemorySizeInBytes += this->GetTextureMemorySizeInBytes(pipeline);
+      }
+    }
+  viewNode->SetVolumeRenderingStatistics(volumeVisible ? this->FrameTime : 0.0,
+    textureMemorySizeInBytes / (1024.0 * 1024.0), this->TextureUploadTime);
+
+  if (frameTimeMeasured && volumeVisible)
+    {
+    this->UpdateDesiredUpdateRateFromFrameTime(this->FrameTime);
+    }
+}
+
+//---------------------------------------------------------------------------
+vtkIdType vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetTextureMemorySizeInBytes(const Pipeline* pipeline)
+{
+  if (!pipeline || !pipeline->DisplayNode || dynamic_cast<const PipelineCPU*>(pipeline))
+    {
+    return 0;
+    }
+  const PipelineGPU* pipelineGpu = dynamic_cast<const PipelineGPU*>(pipeline);
+  if (pipelineGpu && !pipelineGpu->FrameMappers.empty())
+    {
+    // Textures of all cached frames are kept in graphics memory
+    vtkIdType textureMemorySizeInBytes = 0;
+    for (const PipelineGPU::FrameMapper& frameMapper : pipelineGpu->FrameMappers)
+      {
+      textureMemorySizeInBytes += frameMapper.TextureMemorySizeInBytes;
+      }
+    return textureMemorySizeInBytes;
+    }
+  vtkMRMLVolumeNode* volumeNode = pipeline->DisplayNode->GetVolumeNode();
+  return GetImageTextureMemorySizeInBytes(volumeNode ? volumeNode->GetImageData() : nullptr);
+}
+
+//---------------------------------------------------------------------------
+vtkIdType vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetImageTextureMemorySizeInBytes(vtkImageData* imageData)
+{
+  if (!imageData)
+    {
+    return 0;
+    }
+  int dimensions[3] = { 0, 0, 0 };
+  imageData->GetDimensions(dimensions);
+  int numberOfComponents = imageData->GetNumberOfScalarComponents();
+  // RGB volumes are uploaded with an additional alpha channel
+  if (numberOfComponents == 3)
+    {
+    numberOfComponents = 4;
+    }
+  return vtkIdType(dimensions[0]) * dimensions[1] * dimensions[2]
+    * imageData->GetScalarSize() * numberOfComponents;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateDesiredUpdateRateFromFrameTime(double frameTimeMs)
+{
+  vtkMRMLViewNode* viewNode = this->External->GetMRMLViewNode();
+  vtkRenderWindow* renderWindow = this->External->GetRenderer()->GetRenderWindow();
+  vtkRenderWindowInteractor* renderWindowInteractor = renderWindow ? renderWindow->GetInteractor() : nullptr;
+  if (!viewNode || !renderWindowInteractor || frameTimeMs <= 0.0
+    || !viewNode->GetVolumeRenderingUseMeasuredFrameTime()
+    || viewNode->GetVolumeRenderingQuality() != vtkMRMLViewNode::Adaptive)
+    {
+    return;
+    }
+  if (renderWindow->GetDesiredUpdateRate() <= renderWindowInteractor->GetStillUpdateRate())
+    {
+    // Still render, the desired update rate only applies to interactive frames
+    return;
+    }
+  // Scale the update rate requested from the mappers by the ratio of the measured and the
+  // expected frame time. The change is damped to avoid oscillation of the image quality.
+  double expectedFrameTimeMs = 1000.0 / this->GetFramerate();
+  double correction = std::max(0.5, std::min(2.0, frameTimeMs / expectedFrameTimeMs));
+  double desiredUpdateRate = renderWindowInteractor->GetDesiredUpdateRate() * sqrt(correction);
+  desiredUpdateRate = std::max(0.0001, std::min(desiredUpdateRate, 1000.0));
+  renderWindowInteractor->SetDesiredUpdateRate(desiredUpdateRate);
+  // Apply it to the ongoing interaction as well
+  renderWindow->SetDesiredUpdateRate(desiredUpdateRate);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::ReleaseRenderTimers()
+{
+#if defined(Slicer_VTK_RENDERING_USE_OpenGL2_BACKEND)
+  vtkRenderWindow* renderWindow = this->External->GetRenderer() ? this->External->GetRenderer()->GetRenderWindow() : nullptr;
+  if (renderWindow && !this->RenderTimers.empty())
+    {
+    // Queries must be deleted in the context they were created in
+    renderWindow->MakeCurrent();
+    }
+  for (vtkOpenGLRenderTimer* timer : this->RenderTimers)
+    {
+    if (renderWindow)
+      {
+      timer->ReleaseGraphicsResources();
+      }
+    delete timer;
+    }
+  this->RenderTimers.clear();
+#endif
 }
 
 //---------------------------------------------------------------------------
@@ -1384,6 +2208,12 @@ vtkMRMLVolumeRenderingDisplayableManager::vtkMRMLVolumeRenderingDisplayableManag
 //---------------------------------------------------------------------------
 vtkMRMLVolumeRenderingDisplayableManager::~vtkMRMLVolumeRenderingDisplayableManager()
 {
+  if (this->GetRenderer())
+    {
+    this->GetRenderer()->RemoveObserver(this->Internal->RenderEndCallbackCommand);
+    this->GetRenderer()->RemoveObserver(this->Internal->RenderStartCallbackCommand);
+    }
+  this->Internal->ReleaseRenderTimers();
   delete this->Internal;
   this->Internal=nullptr;
 }
@@ -1571,6 +2401,20 @@ void vtkMRMLVolumeRenderingDisplayableManager::ProcessMRMLNodesEvents(vtkObject*
       }
     else if (event == vtkMRMLScalarVolumeNode::ImageDataModifiedEvent)
       {
+      // If only the voxels of a sub-extent have changed then the geometry and the pipeline
+      // are the same, the mapper uploads the modified voxels at the next render.
+      vtkImageData* imageData = volumeNode->GetImageData();
+      if (imageData)
+        {
+        int modifiedExtent[6] = { 0, -1, 0, -1, 0, -1 };
+        volumeNode->GetImageDataModifiedExtent(modifiedExtent);
+        int* wholeExtent = imageData->GetExtent();
+        if (!std::equal(modifiedExtent, modifiedExtent + 6, wholeExtent))
+          {
+          this->RequestRender();
+          return;
+          }
+        }
       int numDisplayNodes = volumeNode->GetNumberOfDisplayNodes();
       for (int i=0; i<numDisplayNodes; i++)
         {
@@ -1601,6 +2445,7 @@ void vtkMRMLVolumeRenderingDisplayableManager::ProcessMRMLNodesEvents(vtkObject*
     // so we just start the mode for the first time.
     if (this->Internal->Interaction == 1)
       {
+      this->Internal->SetInteractiveRendering(true);
       vtkInteractorStyle* interactorStyle = vtkInteractorStyle::SafeDownCast(this->GetInteractor()->GetInteractorStyle());
       if (interactorStyle->GetState() == VTKIS_NONE)
         {
@@ -1619,9 +2464,11 @@ void vtkMRMLVolumeRenderingDisplayableManager::ProcessMRMLNodesEvents(vtkObject*
         {
         interactorStyle->StopState();
         }
+      this->Internal->SetInteractiveRendering(false);
       if (caller->IsA("vtkMRMLVolumeRenderingDisplayNode"))
         {
         this->Internal->UpdateDisplayNode(vtkMRMLVolumeRenderingDisplayNode::SafeDownCast(caller));
+        this->RequestRender();
         }
       }
     }
@@ -1645,6 +2492,14 @@ void vtkMRMLVolumeRenderingDisplayableManager::ProcessMRMLNodesEvents(vtkObject*
   this->Internal->RemoveOrphanPipelines();
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::AdditionalInitializeStep()
+{
+  // Observe rendering to schedule progressive refinement frames and measure frame times
+  this->GetRenderer()->AddObserver(vtkCommand::StartEvent, this->Internal->RenderStartCallbackCommand);
+  this->GetRenderer()->AddObserver(vtkCommand::EndEvent, this->Internal->RenderEndCallbackCommand);
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLVolumeRenderingDisplayableManager::OnInteractorStyleEvent(int eventID)
 {
@@ -1652,6 +2507,7 @@ void vtkMRMLVolumeRenderingDisplayableManager::OnInteractorStyleEvent(int eventI
     {
     case vtkCommand::EndInteractionEvent:
     case vtkCommand::StartInteractionEvent:
+      this->Internal->SetInteractiveRendering(eventID == vtkCommand::StartInteractionEvent);
       this->Internal->UpdatePipelineTransforms(nullptr);
       break;
     default:
@@ -1723,6 +2579,25 @@ vtkVolumeMapper* vtkMRMLVolumeRenderingDisplayableManager::GetVolumeMapper(vtkMR
   return this->Internal->GetVolumeMapper(displayNode);
 }
 
+//---------------------------------------------------------------------------
+double vtkMRMLVolumeRenderingDisplayableManager::GetTextureMemorySize(vtkMRMLVolumeNode* volumeNode)
+{
+  if (!volumeNode)
+    {
+    return 0.0;
+    }
+  vtkIdType textureMemorySizeInBytes = 0;
+  for (auto pipeline : this->Internal->DisplayPipelines)
+    {
+    if (pipeline->DisplayNode && pipeline->DisplayNode->GetDisplayableNode() == volumeNode
+      && pipeline->VolumeActor->GetVisibility())
+      {
+      textureMemorySizeInBytes += this->Internal->GetTextureMemorySizeInBytes(pipeline);
+      }
+    }
+  return textureMemorySizeInBytes / (1024.0 * 1024.0);
+}
+
 //---------------------------------------------------------------------------
 vtkVolume* vtkMRMLVolumeRenderingDisplayableManager::GetVolumeActor(vtkMRMLVolumeNode* volumeNode)
 {
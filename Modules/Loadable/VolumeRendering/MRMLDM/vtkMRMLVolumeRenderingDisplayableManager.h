@@ -59,6 +59,12 @@ public:
   vtkVolumeMapper* GetVolumeMapper(vtkMRMLVolumeNode* volumeNode);
   vtkVolume* GetVolumeActor(vtkMRMLVolumeNode* volumeNode);
 
+  /// Estimated size of the GPU textures of the volume in this view, in MB.
+  /// Returns 0 if the volume is not visible or it is not rendered on the GPU.
+  /// Totals and frame times are available in the view node, see
+  /// vtkMRMLViewNode::GetVolumeRenderingTextureMemorySize.
+  double GetTextureMemorySize(vtkMRMLVolumeNode* volumeNode);
+
   /// Find display node managed by the displayable manager at a specified world RAS position.
   /// \return Non-zero in case a node is found at the position, 0 otherwise
   int Pick3D(double ras[3]) override;
@@ -76,6 +82,9 @@ protected:
   /// Initialize the displayable manager
   void Create() override;
 
+  /// Observe the renderer for progressive refinement
+  void AdditionalInitializeStep() override;
+
   /// Observe graphical resources created event
   void ObserveGraphicalResourcesCreatedEvent();
 
@@ -72,6 +72,7 @@ public:
   vtkWeakPointer<vtkMRMLDisplayableNode> CropROINode;
   vtkWeakPointer<vtkMRMLVolumeRenderingDisplayNode> VolumeRenderingDisplayNode;
   vtkWeakPointer<vtkMRMLVolumePropertyNode> VolumePropertyNode;
+  vtkWeakPointer<vtkMRMLViewNode> StatisticsViewNode;
 };
 
 //-----------------------------------------------------------------------------
@@ -152,6 +153,10 @@ void qSlicerVolumeRenderingModuleWidgetPrivate::setupUi(qSlicerVolumeRenderingMo
 
   QObject::connect(this->AutoReleaseGraphicsResourcesCheckBox, SIGNAL(toggled(bool)),
                    q, SLOT(onAutoReleaseGraphicsResourcesCheckBoxToggled(bool)));
+  QObject::connect(this->MeasuredFrameTimeCheckBox, SIGNAL(toggled(bool)),
+                   q, SLOT(onMeasuredFrameTimeCheckBoxToggled(bool)));
+  QObject::connect(this->FrameCacheSizeSpinBox, SIGNAL(valueChanged(int)),
+                   q, SLOT(onFrameCacheSizeChanged(int)));
 
   void onAutoReleaseGraphicsResourcesChanged(bool autoRelease);
 
@@ -461,6 +466,21 @@ void qSlicerVolumeRenderingModuleWidget::updateWidgetFromMRML()
     }
   d->FramerateSliderWidget->setEnabled(
     firstViewNode && firstViewNode->GetVolumeRenderingQuality() == vtkMRMLViewNode::Adaptive );
+
+  // Performance
+  wasBlocking = d->MeasuredFrameTimeCheckBox->blockSignals(true);
+  d->MeasuredFrameTimeCheckBox->setChecked(firstViewNode ? firstViewNode->GetVolumeRenderingUseMeasuredFrameTime() : false);
+  d->MeasuredFrameTimeCheckBox->blockSignals(wasBlocking);
+  d->MeasuredFrameTimeCheckBox->setEnabled(
+    firstViewNode && firstViewNode->GetVolumeRenderingQuality() == vtkMRMLViewNode::Adaptive );
+  wasBlocking = d->FrameCacheSizeSpinBox->blockSignals(true);
+  d->FrameCacheSizeSpinBox->setValue(firstViewNode ? firstViewNode->GetVolumeRenderingFrameCacheSize() : 0);
+  d->FrameCacheSizeSpinBox->blockSignals(wasBlocking);
+  this->qvtkReconnect(d->StatisticsViewNode, firstViewNode, vtkMRMLViewNode::VolumeRenderingStatisticsModifiedEvent,
+    this, SLOT(updateWidgetFromVolumeRenderingStatistics()));
+  d->StatisticsViewNode = firstViewNode;
+  this->updateWidgetFromVolumeRenderingStatistics();
+
   // Advanced rendering properties
   if (d->RenderingMethodWidgets[currentRenderingMethod])
     {
@@ -774,6 +794,72 @@ void qSlicerVolumeRenderingModuleWidget::onAutoReleaseGraphicsResourcesCheckBoxT
   this->updateWidgetFromMRML();
 }
 
+// --------------------------------------------------------------------------
+void qSlicerVolumeRenderingModuleWidget::onMeasuredFrameTimeCheckBoxToggled(bool useMeasuredFrameTime)
+{
+  vtkMRMLVolumeRenderingDisplayNode* displayNode = this->mrmlDisplayNode();
+  if (!displayNode)
+    {
+    return;
+    }
+
+  std::vector<vtkMRMLNode*> viewNodes;
+  displayNode->GetScene()->GetNodesByClass("vtkMRMLViewNode", viewNodes);
+  for (std::vector<vtkMRMLNode*>::iterator it=viewNodes.begin(); it!=viewNodes.end(); ++it)
+    {
+    vtkMRMLViewNode* viewNode = vtkMRMLViewNode::SafeDownCast(*it);
+    if (displayNode->IsDisplayableInView(viewNode->GetID()))
+      {
+      viewNode->SetVolumeRenderingUseMeasuredFrameTime(useMeasuredFrameTime);
+      }
+    }
+
+  this->updateWidgetFromMRML();
+}
+
+// --------------------------------------------------------------------------
+void qSlicerVolumeRenderingModuleWidget::onFrameCacheSizeChanged(int frameCacheSizeMB)
+{
+  vtkMRMLVolumeRenderingDisplayNode* displayNode = this->mrmlDisplayNode();
+  if (!displayNode)
+    {
+    return;
+    }
+
+  std::vector<vtkMRMLNode*> viewNodes;
+  displayNode->GetScene()->GetNodesByClass("vtkMRMLViewNode", viewNodes);
+  for (std::vector<vtkMRMLNode*>::iterator it=viewNodes.begin(); it!=viewNodes.end(); ++it)
+    {
+    vtkMRMLViewNode* viewNode = vtkMRMLViewNode::SafeDownCast(*it);
+    if (displayNode->IsDisplayableInView(viewNode->GetID()))
+      {
+      viewNode->SetVolumeRenderingFrameCacheSize(frameCacheSizeMB);
+      }
+    }
+
+  this->updateWidgetFromMRML();
+}
+
+// --------------------------------------------------------------------------
+void qSlicerVolumeRenderingModuleWidget::updateWidgetFromVolumeRenderingStatistics()
+{
+  Q_D(qSlicerVolumeRenderingModuleWidget);
+  vtkMRMLViewNode* viewNode = d->StatisticsViewNode;
+  if (!viewNode || viewNode->GetVolumeRenderingFrameTime() <= 0.0)
+    {
+    d->FrameTimeValueLabel->setText("-");
+    d->TextureMemoryValueLabel->setText("-");
+    d->TextureUploadTimeValueLabel->setText("-");
+    return;
+    }
+  d->FrameTimeValueLabel->setText(tr("%1 ms (%2 fps)")
+    .arg(viewNode->GetVolumeRenderingFrameTime(), 0, 'f', 1)
+    .arg(1000.0 / viewNode->GetVolumeRenderingFrameTime(), 0, 'f', 1));
+  d->TextureMemoryValueLabel->setText(tr("%1 MB").arg(viewNode->GetVolumeRenderingTextureMemorySize(), 0, 'f', 1));
+  d->TextureUploadTimeValueLabel->setText(viewNode->GetVolumeRenderingTextureUploadTime() > 0.0 ?
+    tr("%1 ms").arg(viewNode->GetVolumeRenderingTextureUploadTime(), 0, 'f', 1) : QString("-"));
+}
+
 // --------------------------------------------------------------------------
 void qSlicerVolumeRenderingModuleWidget::onCurrentFramerateChanged(double fps)
 {
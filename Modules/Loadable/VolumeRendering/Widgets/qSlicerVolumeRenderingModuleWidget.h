@@ -84,9 +84,12 @@ protected slots:
   void onCurrentQualityControlChanged(int index);
   void onCurrentFramerateChanged(double fps);
   void onAutoReleaseGraphicsResourcesCheckBoxToggled(bool autoRelease);
+  void onMeasuredFrameTimeCheckBoxToggled(bool useMeasuredFrameTime);
+  void onFrameCacheSizeChanged(int frameCacheSizeMB);
 
   void updateWidgetFromMRML();
   void updateWidgetFromROINode();
+  void updateWidgetFromVolumeRenderingStatistics();
 
   void synchronizeScalarDisplayNode();
   void setFollowVolumeDisplayNode(bool);
@@ -127,6 +127,9 @@ QStringList qSlicerVolumeRenderingModule::categories() const
 void qSlicerVolumeRenderingModule::setup()
 {
   this->Superclass::setup();
+  // Only instantiated in views when the scene contains volume rendering display nodes
+  vtkMRMLThreeDViewDisplayableManagerFactory::GetInstance()->AddDisplayableManagerHandledNodeClass(
+    "vtkMRMLVolumeRenderingDisplayableManager", "vtkMRMLVolumeRenderingDisplayNode");
   vtkMRMLThreeDViewDisplayableManagerFactory::GetInstance()->RegisterDisplayableManager(
     "vtkMRMLVolumeRenderingDisplayableManager");
 
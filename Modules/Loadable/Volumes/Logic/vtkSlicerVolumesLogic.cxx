@@ -34,6 +34,7 @@
 #include "vtkMRMLDiffusionWeightedVolumeNode.h"
 #include "vtkMRMLLabelMapVolumeDisplayNode.h"
 #include "vtkMRMLLabelMapVolumeNode.h"
+#include "vtkMRMLMessageCollection.h"
 #include "vtkMRMLNRRDStorageNode.h"
 #include "vtkMRMLScene.h"
 #include "vtkMRMLVectorVolumeDisplayNode.h"
@@ -552,16 +553,6 @@ vtkMRMLVolumeNode* vtkSlicerVolumesLogic::AddArchetypeVolume (
     return nullptr;
     }
 
-  bool labelMap = false;
-  if ( loadingOptions & 1 )    // labelMap is true
-    {
-    labelMap = true;
-    }
-
-  vtkSmartPointer<vtkMRMLVolumeNode> volumeNode;
-  vtkSmartPointer<vtkMRMLVolumeDisplayNode> displayNode;
-  vtkSmartPointer<vtkMRMLStorageNode> storageNode;
-
   // Compute volume name
   std::string volumeName = volname != nullptr ? volname : vtksys::SystemTools::GetFilenameName(filename);
   volumeName = this->GetMRMLScene()->GetUniqueNameByString(volumeName.c_str());
@@ -591,11 +582,91 @@ vtkMRMLVolumeNode* vtkSlicerVolumesLogic::AddArchetypeVolume (
   this->GetApplicationLogic()->SetMRMLSceneDataIO(testScene.GetPointer(),
                                                   remoteIOLogic, dataIOManagerLogic);
 
+  vtkSmartPointer<vtkMRMLVolumeNode> volumeNode = this->ReadArchetypeVolume(volumeRegistry, testScene,
+    filename, volumeName, loadingOptions, fileList, errorSink, true);
+
+  // display any errors
+  if (volumeNode == nullptr)
+    {
+    errorSink->DisplayMessages();
+    }
+
+  bool modified = false;
+  if (volumeNode != nullptr)
+    {
+    volumeNode = this->AddReadArchetypeVolume(testScene, filename);
+    modified = (volumeNode != nullptr);
+    }
+
+  // clean up the test scene
+  remoteIOLogic->RemoveDataIOFromScene();
+  if (testScene->GetCacheManager())
+    {
+    testScene->SetCacheManager(nullptr);
+    }
+  if (testScene->GetDataIOManager())
+    {
+    testScene->SetDataIOManager(nullptr);
+    }
+
+  if (modified)
+    {
+    this->Modified();
+    }
+  return volumeNode;
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLVolumeNode* vtkSlicerVolumesLogic::ReadArchetypeVolume(vtkMRMLScene* volumeScene,
+  const char* filename, const char* volname, int loadingOptions,
+  vtkStringArray *fileList/*=nullptr*/, vtkMRMLMessageCollection* userMessages/*=nullptr*/)
+{
+  if (this->GetMRMLScene() == nullptr || volumeScene == nullptr || filename == nullptr)
+    {
+    vtkErrorToMessageCollectionMacro(userMessages, "vtkSlicerVolumesLogic::ReadArchetypeVolume",
+      "Invalid scene or filename");
+    return nullptr;
+    }
+
+  // The unique name is determined when the volume is added to the main scene
+  std::string volumeName = volname != nullptr ? volname : vtksys::SystemTools::GetFilenameName(filename);
+
+  // Default nodes of the main scene are only read
+  this->GetMRMLScene()->CopyDefaultNodesToScene(volumeScene);
+
+  vtkMRMLVolumeNode* volumeNode = this->ReadArchetypeVolume(this->VolumeRegistry, volumeScene,
+    filename, volumeName, loadingOptions, fileList, nullptr, false);
+  if (!volumeNode)
+    {
+    vtkErrorToMessageCollectionMacro(userMessages, "vtkSlicerVolumesLogic::ReadArchetypeVolume",
+      "Failed to read volume from file '" << filename << "'.");
+    return nullptr;
+    }
+  if (userMessages && volumeNode->GetStorageNode())
+    {
+    userMessages->AddMessages(volumeNode->GetStorageNode()->GetUserMessages());
+    }
+  return volumeNode;
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLVolumeNode* vtkSlicerVolumesLogic::ReadArchetypeVolume(
+  const NodeSetFactoryRegistry& volumeRegistry, vtkMRMLScene* volumeScene,
+  const char* filename, const std::string& volumeName, int loadingOptions,
+  vtkStringArray *fileList, vtkErrorSink* errorSink, bool observeProgress)
+{
+  bool labelMap = false;
+  if ( loadingOptions & 1 )    // labelMap is true
+    {
+    labelMap = true;
+    }
+
   // Run through the factory list and test each factory until success
   for (NodeSetFactoryRegistry::const_iterator fit = volumeRegistry.begin();
        fit != volumeRegistry.end(); ++fit)
     {
-    ArchetypeVolumeNodeSet nodeSet( (*fit)(volumeName, testScene.GetPointer(), loadingOptions) );
+    std::string nodeSetVolumeName = volumeName;
+    ArchetypeVolumeNodeSet nodeSet( (*fit)(nodeSetVolumeName, volumeScene, loadingOptions) );
 
     // if the labelMap flags for reader and factory are consistent
     // (both true or both false)
@@ -603,10 +674,17 @@ vtkMRMLVolumeNode* vtkSlicerVolumesLogic::AddArchetypeVolume (
       {
 
       // connect the observers
-      errorSink->SetObservedObject(nodeSet.StorageNode);
-      nodeSet.StorageNode->AddObserver(vtkCommand::ProgressEvent,  this->GetMRMLNodesCallbackCommand());
+      if (errorSink)
+        {
+        errorSink->SetObservedObject(nodeSet.StorageNode);
+        }
 
-      this->InitializeStorageNode(nodeSet.StorageNode, filename, fileList, testScene.GetPointer());
+      this->InitializeStorageNode(nodeSet.StorageNode, filename, fileList, volumeScene);
+      // InitializeStorageNode starts forwarding progress events
+      if (!observeProgress)
+        {
+        nodeSet.StorageNode->RemoveObservers(vtkCommand::ProgressEvent, this->GetMRMLNodesCallbackCommand());
+        }
 
       vtkDebugMacro("Attempt to read file as a volume of type "
                     << nodeSet.Node->GetNodeTagName() << " using "
@@ -614,17 +692,17 @@ vtkMRMLVolumeNode* vtkSlicerVolumesLogic::AddArchetypeVolume (
       bool success = nodeSet.StorageNode->ReadData(nodeSet.Node);
 
       // disconnect the observers
-      errorSink->SetObservedObject(nullptr);
+      if (errorSink)
+        {
+        errorSink->SetObservedObject(nullptr);
+        }
       nodeSet.StorageNode->RemoveObservers(vtkCommand::ProgressEvent,  this->GetMRMLNodesCallbackCommand());
 
       if (success)
         {
-        displayNode = nodeSet.DisplayNode;
-        volumeNode =  nodeSet.Node;
-        storageNode = nodeSet.StorageNode;
         vtkDebugMacro(<< "File successfully read as " << nodeSet.Node->GetNodeTagName()
                       << " [filename = " << filename << "]");
-        break;
+        return nodeSet.Node;
         }
       }
 
@@ -635,57 +713,55 @@ vtkMRMLVolumeNode* vtkSlicerVolumesLogic::AddArchetypeVolume (
     // clean up the scene
     nodeSet.Node->SetAndObserveDisplayNodeID(nullptr);
     nodeSet.Node->SetAndObserveStorageNodeID(nullptr);
-    testScene->RemoveNode(nodeSet.DisplayNode);
-    testScene->RemoveNode(nodeSet.StorageNode);
-    testScene->RemoveNode(nodeSet.Node);
+    volumeScene->RemoveNode(nodeSet.DisplayNode);
+    volumeScene->RemoveNode(nodeSet.StorageNode);
+    volumeScene->RemoveNode(nodeSet.Node);
     }
 
-  // display any errors
-  if (volumeNode == nullptr)
-    {
-    errorSink->DisplayMessages();
-    }
-
-
-  bool modified = false;
-  if (volumeNode != nullptr)
-    {
-    // move the nodes from the test scene to the main one, removing from the
-    // test scene first to avoid missing ID/reference errors and to fix a
-    // problem found in testing an extension where the RAS to IJK matrix
-    /// was reset to identity.
-    testScene->RemoveNode(displayNode);
-    testScene->RemoveNode(storageNode);
-    testScene->RemoveNode(volumeNode);
-    this->GetMRMLScene()->AddNode(displayNode);
-    this->GetMRMLScene()->AddNode(storageNode);
-    this->GetMRMLScene()->AddNode(volumeNode);
-    volumeNode->SetAndObserveDisplayNodeID(displayNode->GetID());
-    volumeNode->SetAndObserveStorageNodeID(storageNode->GetID());
-
-    this->SetAndObserveColorToDisplayNode(displayNode, labelMap, filename);
-
-    vtkDebugMacro("Name vol node "<<volumeNode->GetClassName());
-    vtkDebugMacro("Display node "<<displayNode->GetClassName());
-
-    modified = true;
-    }
+  return nullptr;
+}
 
-  // clean up the test scene
-  remoteIOLogic->RemoveDataIOFromScene();
-  if (testScene->GetCacheManager())
+//----------------------------------------------------------------------------
+vtkMRMLVolumeNode* vtkSlicerVolumesLogic::AddReadArchetypeVolume(vtkMRMLScene* volumeScene, const char* filename)
+{
+  if (this->GetMRMLScene() == nullptr || volumeScene == nullptr)
     {
-    testScene->SetCacheManager(nullptr);
+    vtkErrorMacro("AddReadArchetypeVolume: Failed to add volume - invalid scene");
+    return nullptr;
     }
-  if (testScene->GetDataIOManager())
+  vtkSmartPointer<vtkMRMLVolumeNode> volumeNode = vtkMRMLVolumeNode::SafeDownCast(
+    volumeScene->GetFirstNodeByClass("vtkMRMLVolumeNode"));
+  vtkSmartPointer<vtkMRMLVolumeDisplayNode> displayNode = volumeNode ? volumeNode->GetVolumeDisplayNode() : nullptr;
+  vtkSmartPointer<vtkMRMLStorageNode> storageNode = volumeNode ? volumeNode->GetStorageNode() : nullptr;
+  if (!volumeNode || !displayNode || !storageNode)
     {
-    testScene->SetDataIOManager(nullptr);
+    vtkErrorMacro("AddReadArchetypeVolume: Failed to add volume - no volume was read");
+    return nullptr;
     }
 
-  if (modified)
+  // move the nodes from the test scene to the main one, removing from the
+  // test scene first to avoid missing ID/reference errors and to fix a
+  // problem found in testing an extension where the RAS to IJK matrix
+  /// was reset to identity.
+  volumeScene->RemoveNode(displayNode);
+  volumeScene->RemoveNode(storageNode);
+  volumeScene->RemoveNode(volumeNode);
+  if (volumeNode->GetName())
     {
-    this->Modified();
+    volumeNode->SetName(this->GetMRMLScene()->GetUniqueNameByString(volumeNode->GetName()).c_str());
     }
+  this->GetMRMLScene()->AddNode(displayNode);
+  this->GetMRMLScene()->AddNode(storageNode);
+  this->GetMRMLScene()->AddNode(volumeNode);
+  volumeNode->SetAndObserveDisplayNodeID(displayNode->GetID());
+  volumeNode->SetAndObserveStorageNodeID(storageNode->GetID());
+
+  bool labelMap = (vtkMRMLLabelMapVolumeNode::SafeDownCast(volumeNode) != nullptr);
+  this->SetAndObserveColorToDisplayNode(displayNode, labelMap, filename);
+
+  vtkDebugMacro("Name vol node "<<volumeNode->GetClassName());
+  vtkDebugMacro("Display node "<<displayNode->GetClassName());
+
   return volumeNode;
 }
 
@@ -898,10 +974,9 @@ vtkMRMLScalarVolumeNode* vtkSlicerVolumesLogic::CreateScalarVolumeFromVolume(
     outputVolume->SetNodeReferenceID("AssociatedNodeID", inputVolume->GetID());
     }
 
-  // Copy and set image data of the input volume to the label volume
-  vtkNew<vtkImageData> imageData;
-  imageData->DeepCopy(inputVolume->GetImageData());
-  outputVolume->SetAndObserveImageData(imageData.GetPointer());
+  // Share image data of the input volume with the output volume,
+  // voxels are copied when either of them is modified
+  outputVolume->SetAndObserveSharedImageData(inputVolume->GetImageData());
 
   vtkNew<vtkMatrix4x4> ijkToRas;
   inputVolume->GetIJKToRASMatrix(ijkToRas.GetPointer());
@@ -1029,6 +1104,17 @@ vtkSlicerVolumesLogic::CompareVolumeGeometry(vtkMRMLScalarVolumeNode *volumeNode
       }
     else
       {
+      CompareVolumeGeometryResult& lastResult = this->LastCompareVolumeGeometryResult;
+      vtkMTimeType mtime1 = std::max(volumeNode1->GetMTime(), volumeImage1->GetMTime());
+      vtkMTimeType mtime2 = std::max(volumeNode2->GetMTime(), volumeImage2->GetMTime());
+      if (lastResult.VolumeNode1 == volumeNode1 && lastResult.VolumeNode2 == volumeNode2
+        && lastResult.ImageData1 == volumeImage1 && lastResult.ImageData2 == volumeImage2
+        && lastResult.MTime1 == mtime1 && lastResult.MTime2 == mtime2
+        && lastResult.Epsilon == this->CompareVolumeGeometryEpsilon)
+        {
+        // neither the volumes nor the epsilon changed since the last comparison
+        return lastResult.Warnings;
+        }
 
       // warning if one ID is set and not the other,
       // or if both are set but have different strings
@@ -1125,6 +1211,15 @@ vtkSlicerVolumesLogic::CompareVolumeGeometry(vtkMRMLScalarVolumeNode *volumeNode
         }
       volumeIJKToRAS1->Delete();
       volumeIJKToRAS2->Delete();
+
+      lastResult.VolumeNode1 = volumeNode1;
+      lastResult.VolumeNode2 = volumeNode2;
+      lastResult.ImageData1 = volumeImage1;
+      lastResult.ImageData2 = volumeImage2;
+      lastResult.MTime1 = mtime1;
+      lastResult.MTime2 = mtime2;
+      lastResult.Epsilon = this->CompareVolumeGeometryEpsilon;
+      lastResult.Warnings = warnings.str();
       }
     }
   return (warnings.str());
@@ -1199,12 +1294,10 @@ CloneVolumeGeneric (vtkMRMLScene *scene, vtkMRMLVolumeNode *volumeNode, const ch
 
   if (cloneImageData)
     {
-    // copy over the volume's data
+    // share the volume's data, voxels are copied when either volume is modified
     if (volumeNode->GetImageData())
       {
-      vtkNew<vtkImageData> clonedVolumeData;
-      clonedVolumeData->DeepCopy(volumeNode->GetImageData());
-      clonedVolumeNode->SetAndObserveImageData( clonedVolumeData.GetPointer() );
+      clonedVolumeNode->SetAndObserveSharedImageData(volumeNode->GetImageData());
       }
     else
       {
@@ -31,13 +31,18 @@
 #include "vtkMRMLVolumeDisplayNode.h"
 #include "vtkMRMLVolumeNode.h"
 
+// VTK includes
+#include <vtkWeakPointer.h>
+
 // STD includes
 #include <cstdlib>
 #include <list>
 
 #include "vtkSlicerVolumesModuleLogicExport.h"
 
+class vtkErrorSink;
 class vtkMRMLLabelMapVolumeNode;
+class vtkMRMLMessageCollection;
 class vtkMRMLScalarVolumeNode;
 class vtkMRMLScalarVolumeDisplayNode;
 class vtkMRMLVolumeHeaderlessStorageNode;
@@ -143,6 +148,24 @@ public:
   /// \sa AddArchetypeVolume(const NodeSetFactoryRegistry& volumeRegistry, const char* filename, const char* volname, int loadingOptions, vtkStringArray *fileList)
   vtkMRMLScalarVolumeNode* AddArchetypeScalarVolume(const char* filename, const char* volname, int loadingOptions, vtkStringArray *fileList);
 
+  /// Read a volume from a local file into a separate scene, similarly to AddArchetypeVolume.
+  /// The main scene is not modified and no progress events are invoked, therefore this method
+  /// may be called from a worker thread (concurrently with other ReadArchetypeVolume calls),
+  /// while the main scene is not modified. Remote files (URIs) are not supported.
+  /// The nodes are moved into the main scene by AddReadArchetypeVolume.
+  /// \param volumeScene Scene that receives the volume node and its display and storage nodes
+  /// 
+eturn Volume node in volumeScene, nullptr on failure.
+  vtkMRMLVolumeNode* ReadArchetypeVolume(vtkMRMLScene* volumeScene,
+    const char* filename, const char* volname, int loadingOptions,
+    vtkStringArray *fileList = nullptr, vtkMRMLMessageCollection* userMessages = nullptr);
+
+  /// Move a volume that was read by ReadArchetypeVolume, along with its display and storage nodes,
+  /// into the main scene. Must be called from the main thread.
+  /// 
+eturn Volume node in the main scene, nullptr on failure.
+  vtkMRMLVolumeNode* AddReadArchetypeVolume(vtkMRMLScene* volumeScene, const char* filename);
+
   /// Write volume's image data to a specified file
   int SaveArchetypeVolume (const char* filename, vtkMRMLVolumeNode *volumeNode);
 
@@ -199,6 +222,8 @@ public:
   /// A display node will be added to it if the label node doesn't already have
   /// one, and the image data associated with the label node will be allocated
   /// according to the template volumeNode.
+  /// Voxels are shared with the input volume until either volume is modified
+  /// (see vtkMRMLVolumeNode::GetImageDataForModification).
   vtkMRMLScalarVolumeNode *CreateScalarVolumeFromVolume(vtkMRMLScene *scene,
     vtkMRMLScalarVolumeNode *outputVolume,
     vtkMRMLVolumeNode *inputVolume);
@@ -229,8 +254,9 @@ public:
                                     vtkMRMLScalarVolumeNode *volumeNode2);
 
 
-  /// Create a deep copy of a \a volumeNode and add it to the current scene.
-  /// If cloneImageData is false then the volume node is created without image data.
+  /// Create a copy of a \a volumeNode and add it to the current scene.
+  /// Voxels are shared with \a volumeNode until either volume is modified
+  /// (see vtkMRMLVolumeNode::GetImageDataForModification).
   /// \sa GetMRMLScene()
   vtkMRMLScalarVolumeNode *CloneVolume(vtkMRMLVolumeNode *volumeNode, const char *name);
 
@@ -240,7 +266,7 @@ public:
                                                               vtkMRMLVolumeNode *volumeNode,
                                                               const char *name);
 
-  /// Create a deep copy of a \a volumeNode and add it to the \a scene
+  /// Create a copy of a \a volumeNode and add it to the \a scene
   /// Only works for vtkMRMLScalarVolumeNode.
   /// The method is kept as is for background compatibility only, internally it calls CloneVolumeGeneric.
   /// \sa CloneVolumeGeneric
@@ -248,7 +274,10 @@ public:
                                               vtkMRMLVolumeNode *volumeNode,
                                               const char *name,
                                               bool cloneImageData=true);
-  /// Create a deep copy of a \a volumeNode and add it to the \a scene
+  /// Create a copy of a \a volumeNode and add it to the \a scene.
+  /// If cloneImageData is true then the voxels are shared with \a volumeNode until either
+  /// volume is modified (see vtkMRMLVolumeNode::GetImageDataForModification).
+  /// If cloneImageData is false then the volume node is created without image data.
   static vtkMRMLVolumeNode *CloneVolumeGeneric(vtkMRMLScene *scene,
     vtkMRMLVolumeNode *volumeNode,
     const char *name,
@@ -338,6 +367,15 @@ protected:
       const char* filename, const char* volname, int loadingOptions,
       vtkStringArray *fileList);
 
+  /// Try the factories of the registry until a volume is successfully read into volumeScene.
+  /// Only the nodes of the successfully read volume are kept in volumeScene.
+  /// \param errorSink If specified then errors of the storage nodes are collected in it.
+  /// \param observeProgress If true then progress events of the storage nodes are forwarded.
+  vtkMRMLVolumeNode* ReadArchetypeVolume(
+      const NodeSetFactoryRegistry& volumeRegistry, vtkMRMLScene* volumeScene,
+      const char* filename, const std::string& volumeName, int loadingOptions,
+      vtkStringArray *fileList, vtkErrorSink* errorSink, bool observeProgress);
+
 protected:
 
   NodeSetFactoryRegistry VolumeRegistry;
@@ -349,6 +387,22 @@ protected:
   /// Error print out precision, paried with CompareVolumeGeometryEpsilon.
   /// defaults to 6
   int CompareVolumeGeometryPrecision;
+
+  /// Result of the last CompareVolumeGeometry call. Module widgets check the same
+  /// pair of volumes each time a node selector changes, so the result is returned
+  /// without comparing again if neither the volumes nor the epsilon changed.
+  struct CompareVolumeGeometryResult
+    {
+    vtkWeakPointer<vtkMRMLScalarVolumeNode> VolumeNode1;
+    vtkWeakPointer<vtkMRMLScalarVolumeNode> VolumeNode2;
+    vtkWeakPointer<vtkImageData> ImageData1;
+    vtkWeakPointer<vtkImageData> ImageData2;
+    vtkMTimeType MTime1{0};
+    vtkMTimeType MTime2{0};
+    double Epsilon{0.0};
+    std::string Warnings;
+    };
+  CompareVolumeGeometryResult LastCompareVolumeGeometryResult;
 };
 
 #endif
@@ -39,6 +39,7 @@
 #include <vtkImageAlgorithm.h>
 #include <vtkInformation.h>
 #include <vtkNew.h>
+#include <vtkPointData.h>
 #include <vtkTrivialProducer.h>
 
 // ITK includes
@@ -299,5 +300,25 @@ int TestCloneVolume( vtkMRMLScalarVolumeNode* scalarVolume,
     return EXIT_FAILURE;
     }
 
+  // Result of the last comparison is not reused after a volume is modified
+  CHECK_STD_STRING(logic->CompareVolumeGeometry(scalarVolume, clonedVolume), "");
+  double spacing[3] = { 0.0, 0.0, 0.0 };
+  clonedVolume->GetSpacing(spacing);
+  clonedVolume->SetSpacing(spacing[0] * 2.0, spacing[1], spacing[2]);
+  CHECK_BOOL(logic->CompareVolumeGeometry(scalarVolume, clonedVolume).empty(), false);
+  clonedVolume->SetSpacing(spacing);
+  CHECK_STD_STRING(logic->CompareVolumeGeometry(scalarVolume, clonedVolume), "");
+
+  // Voxels are shared until the cloned volume is modified
+  CHECK_POINTER(clonedVolume->GetImageData()->GetScalarPointer(), scalarVolume->GetImageData()->GetScalarPointer());
+  vtkImageData* modifiedImageData = clonedVolume->GetImageDataForModification();
+  CHECK_NOT_NULL(modifiedImageData);
+  CHECK_POINTER_DIFFERENT(modifiedImageData->GetScalarPointer(), scalarVolume->GetImageData()->GetScalarPointer());
+  CHECK_INT(modifiedImageData->GetPointData()->GetScalars()->GetNumberOfValues(),
+    scalarVolume->GetImageData()->GetPointData()->GetScalars()->GetNumberOfValues());
+  // Voxels of the original volume are no longer shared, so they are not copied
+  void* originalVoxels = scalarVolume->GetImageData()->GetScalarPointer();
+  CHECK_POINTER(scalarVolume->GetImageDataForModification()->GetScalarPointer(), originalVoxels);
+
   return EXIT_SUCCESS;
 }
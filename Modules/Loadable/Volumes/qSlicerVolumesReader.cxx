@@ -35,9 +35,11 @@
 #include "vtkSlicerVolumesLogic.h"
 
 // MRML includes
+#include <vtkCacheManager.h>
 #include <vtkMRMLDisplayNode.h>
 #include <vtkMRMLLabelMapVolumeNode.h>
 #include <vtkMRMLScalarVolumeNode.h>
+#include <vtkMRMLScene.h>
 #include <vtkMRMLSelectionNode.h>
 
 // VTK includes
@@ -51,6 +53,11 @@
 class qSlicerVolumesReaderPrivate
 {
   public:
+  /// Get volume name from the name property or the file name
+  static QString volumeName(const qSlicerIO::IOProperties& properties);
+  /// Get vtkSlicerVolumesLogic::LoadingOptions from the properties
+  static int loadingOptions(const qSlicerIO::IOProperties& properties);
+
   vtkSmartPointer<vtkSlicerVolumesLogic> Logic;
 };
 
@@ -119,17 +126,19 @@ qSlicerIOOptions* qSlicerVolumesReader::options()const
 }
 
 //-----------------------------------------------------------------------------
-bool qSlicerVolumesReader::load(const IOProperties& properties)
+QString qSlicerVolumesReaderPrivate::volumeName(const qSlicerIO::IOProperties& properties)
 {
-  Q_D(qSlicerVolumesReader);
-  Q_ASSERT(properties.contains("fileName"));
-  QString fileName = properties["fileName"].toString();
-
-  QString name = QFileInfo(fileName).baseName();
+  QString name = QFileInfo(properties["fileName"].toString()).baseName();
   if (properties.contains("name"))
     {
     name = properties["name"].toString();
     }
+  return name;
+}
+
+//-----------------------------------------------------------------------------
+int qSlicerVolumesReaderPrivate::loadingOptions(const qSlicerIO::IOProperties& properties)
+{
   int options = 0;
   if (properties.contains("labelmap"))
     {
@@ -151,11 +160,18 @@ bool qSlicerVolumesReader::load(const IOProperties& properties)
     {
     options |= properties["discardOrientation"].toBool() ? 0x10 : 0x0;
     }
-  bool propagateVolumeSelection = true;
-  if (properties.contains("show"))
-    {
-    propagateVolumeSelection = properties["show"].toBool();
-    }
+  return options;
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerVolumesReader::load(const IOProperties& properties)
+{
+  Q_D(qSlicerVolumesReader);
+  Q_ASSERT(properties.contains("fileName"));
+  QString fileName = properties["fileName"].toString();
+
+  QString name = d->volumeName(properties);
+  int options = d->loadingOptions(properties);
   vtkSmartPointer<vtkStringArray> fileList;
   if (properties.contains("fileNames"))
     {
@@ -173,6 +189,73 @@ bool qSlicerVolumesReader::load(const IOProperties& properties)
     name.toUtf8(),
     options,
     fileList.GetPointer());
+  return this->setupLoadedVolume(node, properties);
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerVolumesReader::canDecodeInParallel(const IOProperties& properties)const
+{
+  Q_D(const qSlicerVolumesReader);
+  if (!d->Logic || !this->mrmlScene() || properties.contains("fileNames"))
+    {
+    return false;
+    }
+  // Remote files are downloaded in the main thread
+  QString fileName = properties["fileName"].toString();
+  if (this->mrmlScene()->GetCacheManager()
+    && this->mrmlScene()->GetCacheManager()->IsRemoteReference(fileName.toUtf8()))
+    {
+    return false;
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkObject> qSlicerVolumesReader::decode(const IOProperties& properties,
+  vtkMRMLMessageCollection* userMessages)const
+{
+  Q_D(const qSlicerVolumesReader);
+  Q_ASSERT(properties.contains("fileName"));
+  QString fileName = properties["fileName"].toString();
+  if (!d->Logic)
+    {
+    return nullptr;
+    }
+  vtkSmartPointer<vtkMRMLScene> volumeScene = vtkSmartPointer<vtkMRMLScene>::New();
+  vtkMRMLVolumeNode* node = d->Logic->ReadArchetypeVolume(volumeScene,
+    fileName.toUtf8(), d->volumeName(properties).toUtf8(), d->loadingOptions(properties),
+    nullptr, userMessages);
+  if (!node)
+    {
+    return nullptr;
+    }
+  return volumeScene;
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerVolumesReader::loadDecoded(const IOProperties& properties, vtkObject* decodedData)
+{
+  Q_D(qSlicerVolumesReader);
+  vtkMRMLScene* volumeScene = vtkMRMLScene::SafeDownCast(decodedData);
+  if (!d->Logic || !volumeScene)
+    {
+    this->setLoadedNodes(QStringList());
+    return false;
+    }
+  vtkWeakPointer<vtkMRMLVolumeNode> node = d->Logic->AddReadArchetypeVolume(
+    volumeScene, properties["fileName"].toString().toUtf8());
+  return this->setupLoadedVolume(node, properties);
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerVolumesReader::setupLoadedVolume(vtkMRMLVolumeNode* node, const IOProperties& properties)
+{
+  Q_D(qSlicerVolumesReader);
+  bool propagateVolumeSelection = true;
+  if (properties.contains("show"))
+    {
+    propagateVolumeSelection = properties["show"].toBool();
+    }
   if (node)
     {
     QString colorNodeID = properties.value("colorNodeID", QString()).toString();
@@ -24,6 +24,7 @@
 // Slicer includes
 #include "qSlicerFileReader.h"
 class qSlicerVolumesReaderPrivate;
+class vtkMRMLVolumeNode;
 class vtkSlicerVolumesLogic;
 
 //-----------------------------------------------------------------------------
@@ -48,12 +49,23 @@ public:
 
   bool load(const IOProperties& properties) override;
 
+  /// Local files that are not part of an explicitly specified file series can be decoded in parallel
+  bool canDecodeInParallel(const IOProperties& properties)const override;
+  /// Read the volume into a separate scene (returned as decoded data)
+  vtkSmartPointer<vtkObject> decode(const IOProperties& properties, vtkMRMLMessageCollection* userMessages)const override;
+  /// Move the volume nodes from the scene returned by decode() into the main scene
+  bool loadDecoded(const IOProperties& properties, vtkObject* decodedData) override;
+
   /// Implements the file list examination for the corresponding method in the core
   /// IO manager.
   /// \sa qSlicerCoreIOManager
   bool examineFileInfoList(QFileInfoList &fileInfoList, QFileInfo &archetypeFileInfo, qSlicerIO::IOProperties &ioProperties)const override;
 
 protected:
+  /// Apply display options of the properties on the loaded volume and set it as loaded node.
+  /// \return False if the volume node is invalid.
+  bool setupLoadedVolume(vtkMRMLVolumeNode* volumeNode, const IOProperties& properties);
+
   QScopedPointer<qSlicerVolumesReaderPrivate> d_ptr;
 
 private:
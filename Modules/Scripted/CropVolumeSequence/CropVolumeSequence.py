@@ -175,6 +175,65 @@ class CropVolumeSequenceLogic(ScriptedLoadableModuleLogic):
             return None
         return proxyVolume.GetTransformNodeID()
 
+    def showOutputSequence(self, inputVolSeq, outputVolSeq, outputVolTransformNodeID, playSuspendedForBrowserNodes):
+        """
+        Show the cropped sequence. If outputVolSeq is None then the input sequence was cropped in place.
+        """
+        # Move output sequence node in the same browser node as the input volume sequence
+        # if not in a sequence browser node already.
+        if outputVolSeq:
+
+            if slicer.modules.sequences.logic().GetFirstBrowserNodeForSequenceNode(outputVolSeq) is None:
+                # Add output sequence to a sequence browser
+                seqBrowser = slicer.modules.sequences.logic().GetFirstBrowserNodeForSequenceNode(inputVolSeq)
+                if seqBrowser:
+                    seqBrowser.AddSynchronizedSequenceNode(outputVolSeq)
+                else:
+                    seqBrowser = slicer.mrmlScene.AddNewNodeByClass("vtkMRMLSequenceBrowserNode")
+                    seqBrowser.SetAndObserveMasterSequenceNodeID(outputVolSeq.GetID())
+                seqBrowser.SetOverwriteProxyName(outputVolSeq, True)
+
+                # Show output in slice views
+                slicer.modules.sequences.logic().UpdateAllProxyNodes()
+                slicer.app.processEvents()
+                outputVolume = seqBrowser.GetProxyNode(outputVolSeq)
+                outputVolume.SetAndObserveTransformNodeID(outputVolTransformNodeID)
+                slicer.util.setSliceViewerLayers(background=outputVolume)
+
+            else:
+                # Restore play enabled states
+                for playSuspendedForBrowserNode in playSuspendedForBrowserNodes:
+                    playSuspendedForBrowserNode.SetPlayback(outputVolSeq, True)
+
+        else:
+            # Refresh proxy node
+            seqBrowser = slicer.modules.sequences.logic().GetFirstBrowserNodeForSequenceNode(inputVolSeq)
+            slicer.modules.sequences.logic().UpdateProxyNodesFromSequences(seqBrowser)
+
+    def runBatch(self, inputVolSeq, outputVolSeq, cropParameters):
+        """
+        Crop all volumes of the sequence at once, in parallel, without stepping through the items.
+        """
+        inputVolTransformNodeID = self.transformForSequence(inputVolSeq)
+        if outputVolSeq == inputVolSeq:
+            outputVolSeq = None
+        if outputVolSeq and not cropParameters.GetVoxelBased():
+            outputVolTransformNodeID = self.transformForSequence(outputVolSeq)
+        else:
+            # Voxel-based cropping does not change the coordinate system of the volumes
+            outputVolTransformNodeID = inputVolTransformNodeID
+        try:
+            qt.QApplication.setOverrideCursor(qt.Qt.WaitCursor)
+            errorCode = slicer.modules.cropvolume.logic().ApplySequence(cropParameters, inputVolSeq,
+                                                                         outputVolSeq if outputVolSeq else inputVolSeq,
+                                                                         slicer.mrmlScene.GetNodeByID(inputVolTransformNodeID) if inputVolTransformNodeID else None,
+                                                                         slicer.mrmlScene.GetNodeByID(outputVolTransformNodeID) if outputVolTransformNodeID else None)
+        finally:
+            qt.QApplication.restoreOverrideCursor()
+        if errorCode != 0:
+            raise RuntimeError(f"Failed to crop volume sequence (error code: {errorCode})")
+        self.showOutputSequence(inputVolSeq, outputVolSeq, outputVolTransformNodeID, [])
+
     def run(self, inputVolSeq, outputVolSeq, cropParameters):
         """
         Run the actual algorithm
@@ -182,6 +241,12 @@ class CropVolumeSequenceLogic(ScriptedLoadableModuleLogic):
 
         logging.info('Processing started')
 
+        # Crop all volumes at once, if the volume type and cropping settings allow it
+        if slicer.modules.cropvolume.logic().CanApplySequence(cropParameters, inputVolSeq):
+            self.runBatch(inputVolSeq, outputVolSeq, cropParameters)
+            logging.info('Processing completed')
+            return
+
         # Get original parent transform, if any (before creating the new sequence browser)
         inputVolTransformNodeID = self.transformForSequence(inputVolSeq)
         outputVolTransformNodeID = None
@@ -251,36 +316,7 @@ class CropVolumeSequenceLogic(ScriptedLoadableModuleLogic):
             # Temporary input volume proxy node
             slicer.mrmlScene.RemoveNode(inputVolume)
 
-            # Move output sequence node in the same browser node as the input volume sequence
-            # if not in a sequence browser node already.
-            if outputVolSeq:
-
-                if slicer.modules.sequences.logic().GetFirstBrowserNodeForSequenceNode(outputVolSeq) is None:
-                    # Add output sequence to a sequence browser
-                    seqBrowser = slicer.modules.sequences.logic().GetFirstBrowserNodeForSequenceNode(inputVolSeq)
-                    if seqBrowser:
-                        seqBrowser.AddSynchronizedSequenceNode(outputVolSeq)
-                    else:
-                        seqBrowser = slicer.mrmlScene.AddNewNodeByClass("vtkMRMLSequenceBrowserNode")
-                        seqBrowser.SetAndObserveMasterSequenceNodeID(outputVolSeq.GetID())
-                    seqBrowser.SetOverwriteProxyName(outputVolSeq, True)
-
-                    # Show output in slice views
-                    slicer.modules.sequences.logic().UpdateAllProxyNodes()
-                    slicer.app.processEvents()
-                    outputVolume = seqBrowser.GetProxyNode(outputVolSeq)
-                    outputVolume.SetAndObserveTransformNodeID(outputVolTransformNodeID)
-                    slicer.util.setSliceViewerLayers(background=outputVolume)
-
-                else:
-                    # Restore play enabled states
-                    for playSuspendedForBrowserNode in playSuspendedForBrowserNodes:
-                        playSuspendedForBrowserNode.SetPlayback(outputVolSeq, True)
-
-            else:
-                # Refresh proxy node
-                seqBrowser = slicer.modules.sequences.logic().GetFirstBrowserNodeForSequenceNode(inputVolSeq)
-                slicer.modules.sequences.logic().UpdateProxyNodesFromSequences(seqBrowser)
+            self.showOutputSequence(inputVolSeq, outputVolSeq, outputVolTransformNodeID, playSuspendedForBrowserNodes)
 
         logging.info('Processing completed')
 
@@ -302,6 +338,8 @@ class CropVolumeSequenceTest(ScriptedLoadableModuleTest):
         """
         self.setUp()
         self.test_CropVolumeSequence1()
+        self.setUp()
+        self.test_CropVolumeSequenceVoxelBased()
 
     def test_CropVolumeSequence1(self):
 
@@ -342,3 +380,38 @@ class CropVolumeSequenceTest(ScriptedLoadableModuleTest):
         self.assertEqual(cropVolumeNode.GetImageData().GetExtent(), (0, 41, 0, 33, 0, 40))
 
         self.delayDisplay('Test passed!')
+
+    def test_CropVolumeSequenceVoxelBased(self):
+
+        self.delayDisplay("Starting the test")
+
+        import SampleData
+        sequenceNode = SampleData.downloadSample('CTCardioSeq')
+        sequenceBrowserNode = slicer.modules.sequences.logic().GetFirstBrowserNodeForSequenceNode(sequenceNode)
+        volumeNode = sequenceBrowserNode.GetProxyNode(sequenceNode)
+
+        # Crop to the half of the volume along the first axis, without resampling
+        croppedSequenceNode = slicer.mrmlScene.AddNewNodeByClass('vtkMRMLSequenceNode')
+        cropVolumeNode = slicer.mrmlScene.AddNewNodeByClass('vtkMRMLCropVolumeParametersNode')
+        cropVolumeNode.SetVoxelBased(True)
+        roiNode = slicer.mrmlScene.AddNewNodeByClass('vtkMRMLMarkupsROINode')
+        cropVolumeNode.SetROINodeID(roiNode.GetID())
+        cropVolumeNode.SetInputVolumeNodeID(volumeNode.GetID())
+        slicer.modules.cropvolume.logic().FitROIToInputVolume(cropVolumeNode)
+        roiSize = roiNode.GetSize()
+        roiNode.SetSize(roiSize[0] / 2, roiSize[1], roiSize[2])
+
+        # All items are cropped at once
+        self.assertTrue(slicer.modules.cropvolume.logic().CanApplySequence(cropVolumeNode, sequenceNode))
+        CropVolumeSequenceLogic().run(sequenceNode, croppedSequenceNode, cropVolumeNode)
+
+        self.assertEqual(croppedSequenceNode.GetNumberOfDataNodes(), sequenceNode.GetNumberOfDataNodes())
+        for itemIndex in range(sequenceNode.GetNumberOfDataNodes()):
+            self.assertEqual(croppedSequenceNode.GetNthIndexValue(itemIndex), sequenceNode.GetNthIndexValue(itemIndex))
+            inputNumberOfPoints = sequenceNode.GetNthDataNode(itemIndex).GetImageData().GetNumberOfPoints()
+            croppedImageData = croppedSequenceNode.GetNthDataNode(itemIndex).GetImageData()
+            # Voxels are not resampled, so half of them are kept
+            self.assertEqual(croppedImageData.GetExtent()[0::2], (0, 0, 0))
+            self.assertAlmostEqual(croppedImageData.GetNumberOfPoints() / inputNumberOfPoints, 0.5, delta=0.05)
+
+        self.delayDisplay('Test passed!')
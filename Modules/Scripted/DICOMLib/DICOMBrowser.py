@@ -348,13 +348,22 @@ class SlicerDICOMBrowser(VTKObservationMixin, qt.QWidget):
         """For selected plugins, give user the option
         of what to load"""
 
-        (self.loadablesByPlugin, loadEnabled) = self.getLoadablesFromFileLists(self.fileLists)
+        # Show the loadables of each plugin as soon as the plugin has examined the files
+        examinedLoadablesByPlugin = {}
+
+        def onPluginLoadablesExamined(plugin, loadables):
+            examinedLoadablesByPlugin[plugin] = loadables
+            self.loadableTable.setLoadables(examinedLoadablesByPlugin)
+            slicer.app.processEvents()
+
+        (self.loadablesByPlugin, loadEnabled) = self.getLoadablesFromFileLists(self.fileLists, onPluginLoadablesExamined)
         DICOMLib.selectHighestConfidenceLoadables(self.loadablesByPlugin)
         self.loadableTable.setLoadables(self.loadablesByPlugin)
         self.updateButtonStates()
 
-    def getLoadablesFromFileLists(self, fileLists):
+    def getLoadablesFromFileLists(self, fileLists, loadablesCallback=None):
         """Take list of file lists, return loadables by plugin dictionary
+        loadablesCallback is called with each plugin and its loadables, see DICOMLib.getLoadablesFromFileLists.
         """
 
         loadablesByPlugin = {}
@@ -405,7 +414,7 @@ class SlicerDICOMBrowser(VTKObservationMixin, qt.QWidget):
 
             loadablesByPlugin, loadEnabled = DICOMLib.getLoadablesFromFileLists(fileLists, selectedPlugins, messages,
                                                                                 lambda progressLabel, progressValue, progressDialog=progressDialog: progressCallback(progressDialog, progressLabel, progressValue),
-                                                                                self.pluginInstances)
+                                                                                self.pluginInstances, loadablesCallback)
 
             progressDialog.close()
 
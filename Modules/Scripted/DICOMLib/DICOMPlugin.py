@@ -1,4 +1,5 @@
 import logging
+from contextlib import contextmanager
 
 import slicer
 
@@ -17,6 +18,35 @@ comment = """
 #########################################################
 
 
+#
+# Header cache shared by all plugins
+#
+
+# Dictionary of cached values while an examination is in progress (see examinationCache), None otherwise
+_examinationCache = None
+
+
+@contextmanager
+def examinationCache():
+    """Share the DICOM header values that plugins read while the code in the context manager is run.
+
+    Each plugin reads the same tags (SOP class UID, modality, etc.) of the same files, and some plugins
+    parse the whole header of the files using pydicom. Within this context, DICOMPlugin.fileValue()
+    and DICOMPlugin.readDataset() retrieve each value and each header only once, for all the plugins.
+    The cache is cleared when the outermost context exits, so that later changes of the files or of the
+    database are taken into account.
+    """
+    global _examinationCache
+    outermost = _examinationCache is None
+    if outermost:
+        _examinationCache = {"fileValues": {}, "datasets": {}}
+    try:
+        yield
+    finally:
+        if outermost:
+            _examinationCache = None
+
+
 #
 # DICOMLoadable
 #
@@ -106,6 +136,31 @@ class DICOMPlugin:
                     return dicom.tag.Tag(group, (tag.element << 8) + element)
         return None
 
+    def fileValue(self, filePath, tag):
+        """Get the value of a tag of a file from the DICOM database.
+        Values are shared between plugins while file lists are examined, see examinationCache().
+        """
+        if _examinationCache is None:
+            return slicer.dicomDatabase.fileValue(filePath, tag)
+        fileValues = _examinationCache["fileValues"]
+        key = (filePath, tag)
+        if key not in fileValues:
+            fileValues[key] = slicer.dicomDatabase.fileValue(filePath, tag)
+        return fileValues[key]
+
+    def readDataset(self, filePath):
+        """Read the header of a DICOM file (all data elements except pixel data) using pydicom.
+        Headers are shared between plugins while file lists are examined (see examinationCache()),
+        therefore the returned dataset must not be modified.
+        """
+        import pydicom
+        if _examinationCache is None:
+            return pydicom.dcmread(filePath, stop_before_pixels=True)
+        datasets = _examinationCache["datasets"]
+        if filePath not in datasets:
+            datasets[filePath] = pydicom.dcmread(filePath, stop_before_pixels=True)
+        return datasets[filePath]
+
     def isDetailedLogging(self):
         """Helper function that returns True if detailed DICOM logging is enabled.
         If enabled then the plugin can log as many details as it wants, even if it
@@ -628,16 +628,11 @@ def getSortedImageFiles(filePaths, epsilon=0.01):
             return filePaths, [], warningText
         ref[tag] = value
 
-    # Determine out-of-plane direction for first slice
-    import numpy as np
+    # Get the position of each file in the series (the orientation of the first file
+    # defines the out-of-plane direction)
     sliceAxes = [float(zz) for zz in ref[tags['orientation']].split('\\')]
-    x = np.array(sliceAxes[:3])
-    y = np.array(sliceAxes[3:])
-    scanAxis = np.cross(x, y)
-    scanOrigin = np.array([float(zz) for zz in ref[tags['position']].split('\\')])
-
-    # For each file in series, calculate the distance along the scan axis, sort files by this
-    sortList = []
+    positions = vtk.vtkDoubleArray()
+    positions.SetNumberOfComponents(3)
     missingGeometry = False
     for file in filePaths:
         positionStr = slicer.dicomDatabase.fileValue(file, tags['position'])
@@ -645,22 +640,25 @@ def getSortedImageFiles(filePaths, epsilon=0.01):
         if not positionStr or positionStr == "" or not orientationStr or orientationStr == "":
             missingGeometry = True
             break
-        position = np.array([float(zz) for zz in positionStr.split('\\')])
-        vec = position - scanOrigin
-        dist = vec.dot(scanAxis)
-        sortList.append((file, dist))
+        positions.InsertNextTuple([float(zz) for zz in positionStr.split('\\')])
 
     if missingGeometry:
         warningText += "One or more images is missing geometry information in series. Please use caution.\n"
         return filePaths, [], warningText
 
-    # Sort files names by distance from reference slice
-    sortedFiles = sorted(sortList, key=lambda x: x[1])
+    # Sort files by distance from reference slice along the scan axis and compute the spacing
+    # error, the same way as the image series reader does
+    import vtkITK
+    sortedIndices = vtk.vtkIdList()
+    sortedDistances = vtk.vtkDoubleArray()
+    maximumSpacingError = vtkITK.vtkITKArchetypeImageSeriesReader.SortSlicesAlongNormal(
+        positions, sliceAxes, sortedIndices, sortedDistances)
     files = []
     distances = {}
-    for file, dist in sortedFiles:
+    for sortedIndex in range(sortedIndices.GetNumberOfIds()):
+        file = filePaths[sortedIndices.GetId(sortedIndex)]
         files.append(file)
-        distances[file] = dist
+        distances[file] = sortedDistances.GetValue(sortedIndex)
 
     # Get acquisition geometry regularization setting value
     settings = qt.QSettings()
@@ -669,29 +667,15 @@ def getSortedImageFiles(filePaths, epsilon=0.01):
     # Confirm equal spacing between slices
     # - use variable 'epsilon' to determine the tolerance
     spaceWarnings = 0
-    if len(files) > 1:
-        file0 = files[0]
-        file1 = files[1]
-        dist0 = distances[file0]
-        dist1 = distances[file1]
-        spacing0 = dist1 - dist0
-        n = 1
-        for fileN in files[1:]:
-            fileNminus1 = files[n - 1]
-            distN = distances[fileN]
-            distNminus1 = distances[fileNminus1]
-            spacingN = distN - distNminus1
-            spaceError = spacingN - spacing0
-            if abs(spaceError) > epsilon:
-                spaceWarnings += 1
-                warningText += f"Images are not equally spaced (a difference of {spaceError:g} vs {spacing0:g} in spacings was detected)."
-                if acquisitionGeometryRegularizationEnabled:
-                    warningText += "  Slicer will apply a transform to this series trying to regularize the volume. Please use caution.\n"
-                else:
-                    warningText += ("  If loaded image appears distorted, enable 'Acquisition geometry regularization'"
-                                    " in Application settings / DICOM / DICOMScalarVolumePlugin. Please use caution.\n")
-                break
-            n += 1
+    if len(files) > 1 and maximumSpacingError > epsilon:
+        spacing0 = distances[files[1]] - distances[files[0]]
+        spaceWarnings += 1
+        warningText += f"Images are not equally spaced (a difference of {maximumSpacingError:g} vs {spacing0:g} in spacings was detected)."
+        if acquisitionGeometryRegularizationEnabled:
+            warningText += "  Slicer will apply a transform to this series trying to regularize the volume. Please use caution.\n"
+        else:
+            warningText += ("  If loaded image appears distorted, enable 'Acquisition geometry regularization'"
+                            " in Application settings / DICOM / DICOMScalarVolumePlugin. Please use caution.\n")
 
     if spaceWarnings != 0:
         logging.warning("Geometric issues were found with %d of the series. Please use caution.\n" % spaceWarnings)
@@ -714,9 +698,17 @@ def refreshDICOMWidget():
     return True
 
 
-def getLoadablesFromFileLists(fileLists, pluginClassNames=None, messages=None, progressCallback=None, pluginInstances=None):
+def getLoadablesFromFileLists(fileLists, pluginClassNames=None, messages=None, progressCallback=None, pluginInstances=None,
+                              loadablesCallback=None):
     """Take list of file lists, return loadables by plugin dictionary
+
+    The header values that the plugins read are shared between the plugins (see DICOMLib.examinationCache),
+    so that each file is read only once.
+
+    :param loadablesCallback: if specified, it is called with the plugin and its loadables as soon as
+      the plugin has examined the files, so that results can be displayed before all plugins are done.
     """
+    from DICOMLib.DICOMPlugin import examinationCache
     detailedLogging = slicer.util.settingsValue('DICOM/detailedLogging', False, converter=slicer.util.toBool)
     loadablesByPlugin = {}
     loadEnabled = False
@@ -730,29 +722,32 @@ def getLoadablesFromFileLists(fileLists, pluginClassNames=None, messages=None, p
     if pluginInstances is None:
         pluginInstances = {}
 
-    for step, pluginClassName in enumerate(pluginClassNames):
-        if pluginClassName not in pluginInstances:
-            pluginInstances[pluginClassName] = slicer.modules.dicomPlugins[pluginClassName]()
-        plugin = pluginInstances[pluginClassName]
-        if progressCallback:
-            cancelled = progressCallback(pluginClassName, step * 100 / len(pluginClassNames))
-            if cancelled:
-                break
-        try:
-            if detailedLogging:
-                logging.debug("Examine for import using " + pluginClassName)
-            loadablesByPlugin[plugin] = plugin.examineForImport(fileLists)
-            # If regular method is not overridden (so returns empty list), try old function
-            # Ensuring backwards compatibility: examineForImport used to be called examine
-            if not loadablesByPlugin[plugin]:
-                loadablesByPlugin[plugin] = plugin.examine(fileLists)
-            loadEnabled = loadEnabled or loadablesByPlugin[plugin] != []
-        except Exception as e:
-            import traceback
-            traceback.print_exc()
-            logging.error("DICOM Plugin failed: %s" % str(e))
-            if messages:
-                messages.append("Plugin failed: %s." % pluginClass)
+    with examinationCache():
+        for step, pluginClassName in enumerate(pluginClassNames):
+            if pluginClassName not in pluginInstances:
+                pluginInstances[pluginClassName] = slicer.modules.dicomPlugins[pluginClassName]()
+            plugin = pluginInstances[pluginClassName]
+            if progressCallback:
+                cancelled = progressCallback(pluginClassName, step * 100 / len(pluginClassNames))
+                if cancelled:
+                    break
+            try:
+                if detailedLogging:
+                    logging.debug("Examine for import using " + pluginClassName)
+                loadablesByPlugin[plugin] = plugin.examineForImport(fileLists)
+                # If regular method is not overridden (so returns empty list), try old function
+                # Ensuring backwards compatibility: examineForImport used to be called examine
+                if not loadablesByPlugin[plugin]:
+                    loadablesByPlugin[plugin] = plugin.examine(fileLists)
+                loadEnabled = loadEnabled or loadablesByPlugin[plugin] != []
+                if loadablesCallback:
+                    loadablesCallback(plugin, loadablesByPlugin[plugin])
+            except Exception as e:
+                import traceback
+                traceback.print_exc()
+                logging.error("DICOM Plugin failed: %s" % str(e))
+                if messages:
+                    messages.append("Plugin failed: %s." % pluginClass)
 
     return loadablesByPlugin, loadEnabled
 
@@ -819,7 +814,8 @@ def loadLoadables(loadablesByPlugin, messages=None, progressCallback=None):
     return loadedNodeIDs
 
 
-def importFromDICOMWeb(dicomWebEndpoint, studyInstanceUID, seriesInstanceUID=None, accessToken=None, bulkRetrieve=True):
+def importFromDICOMWeb(dicomWebEndpoint, studyInstanceUID, seriesInstanceUID=None, accessToken=None, bulkRetrieve=True,
+                       numberOfParallelRequests=4, seriesImportedCallback=None):
     """
     Downloads and imports DICOM series from a DICOMweb instance.
     Progress is displayed and if errors occur then they are displayed in a popup window in the end.
@@ -831,7 +827,11 @@ def importFromDICOMWeb(dicomWebEndpoint, studyInstanceUID, seriesInstanceUID=Non
     :param accessToken: Optional access token for the query
     :param bulkRetrieve: If enabled then all instances of a series is retrieved with one query. Some servers (including Slicer
         DICOMweb server) may not support bulk retrieve and require query of each instance.
-    :return: List of imported study UIDs
+    :param numberOfParallelRequests: Number of instances that are retrieved concurrently when bulk retrieve is disabled.
+    :param seriesImportedCallback: Optional function that is called with the series instance UID as soon as the series
+        is imported into the database, while the remaining series are still being retrieved. It can be used for loading
+        the first series into the scene without waiting for the entire study to be downloaded.
+    :return: List of imported series UIDs
 
     Example: calling from PythonSlicer console
 
@@ -844,8 +844,28 @@ def importFromDICOMWeb(dicomWebEndpoint, studyInstanceUID, seriesInstanceUID=Non
 
     """
 
+    import concurrent.futures
+    import threading
     from dicomweb_client.api import DICOMwebClient
 
+    def createClient():
+        if accessToken is None:
+            return DICOMwebClient(url=dicomWebEndpoint)
+        return DICOMwebClient(
+            url=dicomWebEndpoint,
+            headers={"Authorization": f"Bearer {accessToken}"},
+        )
+
+    # Each worker thread uses its own client, as the underlying HTTP session is not meant to be shared between threads
+    threadClients = threading.local()
+
+    def retrieveInstance(currentSeriesInstanceUID, sopInstanceUID, filename):
+        # Only network transfer and file writing is done here, database import remains on the main thread
+        if not hasattr(threadClients, "client"):
+            threadClients.client = createClient()
+        instance = threadClients.client.retrieve_instance(studyInstanceUID, currentSeriesInstanceUID, sopInstanceUID)
+        instance.save_as(filename)
+
     seriesImported = []
     errors = []
     clientLogger = logging.getLogger('dicomweb_client')
@@ -856,13 +876,7 @@ def importFromDICOMWeb(dicomWebEndpoint, studyInstanceUID, seriesInstanceUID=Non
         progressDialog.labelText = f'Retrieving series list...'
         slicer.app.processEvents()
 
-        if accessToken is None:
-            client = DICOMwebClient(url=dicomWebEndpoint)
-        else:
-            client = DICOMwebClient(
-                url=dicomWebEndpoint,
-                headers={"Authorization": f"Bearer {accessToken}"},
-            )
+        client = createClient()
 
         seriesList = client.search_for_series(study_instance_uid=studyInstanceUID)
         seriesInstanceUIDs = []
@@ -898,6 +912,8 @@ def importFromDICOMWeb(dicomWebEndpoint, studyInstanceUID, seriesInstanceUID=Non
                         break
                 if seriesAlreadyImported:
                     seriesImported.append(currentSeriesInstanceUID)
+                    if seriesImportedCallback:
+                        seriesImportedCallback(currentSeriesInstanceUID)
                     continue
 
                 if bulkRetrieve:
@@ -918,19 +934,38 @@ def importFromDICOMWeb(dicomWebEndpoint, studyInstanceUID, seriesInstanceUID=Non
                 outputDirectory.setAutoRemove(False)
                 outputDirectoryPath = outputDirectory.path()
 
-                for instanceIndex, instance in enumerate(instances if bulkRetrieve else seriesInfo):
-                    if not bulkRetrieve:
-                        # instance is just metadata, retrieve the dataset now
-                        sopInstanceUID = instance['00080018']['Value'][0]
-                        instance = client.retrieve_instance(studyInstanceUID, currentSeriesInstanceUID, sopInstanceUID)
-                    progressDialog.setValue(int(100 * instanceIndex / numberOfInstances))
-                    slicer.app.processEvents()
-                    cancelled = progressDialog.wasCanceled
-                    if cancelled:
-                        break
-                    filename = outputDirectoryPath + "/" + str(fileNumber) + ".dcm"
-                    instance.save_as(filename)
-                    fileNumber += 1
+                if bulkRetrieve:
+                    for instanceIndex, instance in enumerate(instances):
+                        progressDialog.setValue(int(100 * instanceIndex / numberOfInstances))
+                        slicer.app.processEvents()
+                        cancelled = progressDialog.wasCanceled
+                        if cancelled:
+                            break
+                        filename = outputDirectoryPath + "/" + str(fileNumber) + ".dcm"
+                        instance.save_as(filename)
+                        fileNumber += 1
+                else:
+                    # seriesInfo contains only metadata, retrieve the datasets now, several instances at a time
+                    with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, numberOfParallelRequests)) as executor:
+                        retrievals = []
+                        for instanceInfo in seriesInfo:
+                            sopInstanceUID = instanceInfo['00080018']['Value'][0]
+                            filename = outputDirectoryPath + "/" + str(fileNumber) + ".dcm"
+                            retrievals.append(executor.submit(retrieveInstance, currentSeriesInstanceUID, sopInstanceUID, filename))
+                            fileNumber += 1
+                        pendingRetrievals = set(retrievals)
+                        while pendingRetrievals:
+                            completedRetrievals, pendingRetrievals = concurrent.futures.wait(pendingRetrievals, timeout=0.1)
+                            for retrieval in completedRetrievals:
+                                # Raise exception if retrieval failed
+                                retrieval.result()
+                            progressDialog.setValue(int(100 * (numberOfInstances - len(pendingRetrievals)) / numberOfInstances))
+                            slicer.app.processEvents()
+                            cancelled = progressDialog.wasCanceled
+                            if cancelled:
+                                for retrieval in pendingRetrievals:
+                                    retrieval.cancel()
+                                break
 
                 if cancelled:
                     # cancel was requested in instance retrieve loop,
@@ -939,6 +974,8 @@ def importFromDICOMWeb(dicomWebEndpoint, studyInstanceUID, seriesInstanceUID=Non
 
                 importDicom(outputDirectoryPath)
                 seriesImported.append(currentSeriesInstanceUID)
+                if seriesImportedCallback:
+                    seriesImportedCallback(currentSeriesInstanceUID)
 
             except Exception as e:
                 import traceback
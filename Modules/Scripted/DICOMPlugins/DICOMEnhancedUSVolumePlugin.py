@@ -61,16 +61,16 @@ class DICOMEnhancedUSVolumePluginClass(DICOMPlugin):
 
         for filePath in files:
             # Quick check of SOP class UID without parsing the file...
-            sopClassUID = slicer.dicomDatabase.fileValue(filePath, self.tags['sopClassUID'])
+            sopClassUID = self.fileValue(filePath, self.tags['sopClassUID'])
             if not (sopClassUID in supportedSOPClassUIDs):
                 # Unsupported class
                 continue
 
-            instanceNumber = slicer.dicomDatabase.fileValue(filePath, self.tags['instanceNumber'])
-            modality = slicer.dicomDatabase.fileValue(filePath, self.tags['modality'])
-            seriesNumber = slicer.dicomDatabase.fileValue(filePath, self.tags['seriesNumber'])
-            seriesDescription = slicer.dicomDatabase.fileValue(filePath, self.tags['seriesDescription'])
-            photometricInterpretation = slicer.dicomDatabase.fileValue(filePath, self.tags['photometricInterpretation'])
+            instanceNumber = self.fileValue(filePath, self.tags['instanceNumber'])
+            modality = self.fileValue(filePath, self.tags['modality'])
+            seriesNumber = self.fileValue(filePath, self.tags['seriesNumber'])
+            seriesDescription = self.fileValue(filePath, self.tags['seriesDescription'])
+            photometricInterpretation = self.fileValue(filePath, self.tags['photometricInterpretation'])
             name = ''
             if seriesNumber:
                 name = f'{seriesNumber}:'
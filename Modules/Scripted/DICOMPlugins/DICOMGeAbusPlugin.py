@@ -64,12 +64,12 @@ class DICOMGeAbusPluginClass(DICOMPlugin):
         for filePath in files:
             # Quick check of SOP class UID without parsing the file...
             try:
-                sopClassUID = slicer.dicomDatabase.fileValue(filePath, self.tags['sopClassUID'])
+                sopClassUID = self.fileValue(filePath, self.tags['sopClassUID'])
                 if not (sopClassUID in supportedSOPClassUIDs):
                     # Unsupported class
                     continue
 
-                manufacturerModelName = slicer.dicomDatabase.fileValue(filePath, self.tags['manufacturerModelName'])
+                manufacturerModelName = self.fileValue(filePath, self.tags['manufacturerModelName'])
                 if manufacturerModelName != "Invenia":
                     if detailedLogging:
                         logging.debug("ManufacturerModelName is not Invenia, the series will not be considered as an ABUS image")
@@ -81,7 +81,7 @@ class DICOMGeAbusPluginClass(DICOMPlugin):
                 pass
 
             try:
-                ds = dicom.read_file(filePath, stop_before_pixels=True)
+                ds = self.readDataset(filePath)
             except Exception as e:
                 logging.debug(f"Failed to parse DICOM file: {str(e)}")
                 continue
@@ -123,7 +123,7 @@ class DICOMGeAbusPluginClass(DICOMPlugin):
 
     def getMetadata(self, filePath):
         try:
-            ds = dicom.read_file(filePath, stop_before_pixels=True)
+            ds = self.readDataset(filePath)
         except Exception as e:
             raise ValueError(f"Failed to parse DICOM file: {str(e)}")
 
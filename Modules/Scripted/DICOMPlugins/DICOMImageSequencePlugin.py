@@ -1,6 +1,5 @@
 import logging
 
-import pydicom as dicom
 import vtk
 
 import slicer
@@ -93,7 +92,7 @@ class DICOMImageSequencePluginClass(DICOMPlugin):
         for filePath in files:
             # Quick check of SOP class UID without parsing the file...
             try:
-                sopClassUID = slicer.dicomDatabase.fileValue(filePath, self.tags['sopClassUID'])
+                sopClassUID = self.fileValue(filePath, self.tags['sopClassUID'])
                 if not (sopClassUID in supportedSOPClassUIDs):
                     # Unsupported class
                     continue
@@ -109,7 +108,7 @@ class DICOMImageSequencePluginClass(DICOMPlugin):
                 # No problem, we'll try to parse the file and check the SOP class UID then.
                 pass
 
-            instanceNumber = slicer.dicomDatabase.fileValue(filePath, self.tags['instanceNumber'])
+            instanceNumber = self.fileValue(filePath, self.tags['instanceNumber'])
             if canBeCineMri and sopClassUID == '1.2.840.10008.5.1.4.1.1.4':  # MR Image Storage
                 if not instanceNumber:
                     # no instance number, probably not cine-MRI
@@ -118,11 +117,11 @@ class DICOMImageSequencePluginClass(DICOMPlugin):
                         logging.debug("No instance number attribute found, the series will not be considered as a cine MRI")
                     continue
                 cineMriInstanceNumberToFilenameIndex[int(instanceNumber)] = filePath
-                cineMriTriggerTimes.add(slicer.dicomDatabase.fileValue(filePath, self.tags['triggerTime']))
-                cineMriImageOrientations.add(slicer.dicomDatabase.fileValue(filePath, self.tags['orientation']))
+                cineMriTriggerTimes.add(self.fileValue(filePath, self.tags['triggerTime']))
+                cineMriImageOrientations.add(self.fileValue(filePath, self.tags['orientation']))
 
             else:
-                modality = slicer.dicomDatabase.fileValue(filePath, self.tags['modality'])
+                modality = self.fileValue(filePath, self.tags['modality'])
                 if sopClassUID == '1.2.840.10008.5.1.4.1.1.7':  # Secondary Capture Image Storage
                     if modality not in suppportedSecondaryCaptureModalities:
                         # practice of dumping secondary capture images into the same series
@@ -131,9 +130,9 @@ class DICOMImageSequencePluginClass(DICOMPlugin):
 
                 if not (instanceNumber in instanceNumberToLoadableIndex.keys()):
                     # new instance number
-                    seriesNumber = slicer.dicomDatabase.fileValue(filePath, self.tags['seriesNumber'])
-                    seriesDescription = slicer.dicomDatabase.fileValue(filePath, self.tags['seriesDescription'])
-                    photometricInterpretation = slicer.dicomDatabase.fileValue(filePath, self.tags['photometricInterpretation'])
+                    seriesNumber = self.fileValue(filePath, self.tags['seriesNumber'])
+                    seriesDescription = self.fileValue(filePath, self.tags['seriesDescription'])
+                    photometricInterpretation = self.fileValue(filePath, self.tags['photometricInterpretation'])
                     name = ''
                     if seriesNumber:
                         name = f'{seriesNumber}:'
@@ -167,7 +166,7 @@ class DICOMImageSequencePluginClass(DICOMPlugin):
 
         if canBeCineMri and len(cineMriInstanceNumberToFilenameIndex) > 1:
             # Get description from first
-            ds = dicom.read_file(cineMriInstanceNumberToFilenameIndex[next(iter(cineMriInstanceNumberToFilenameIndex))], stop_before_pixels=True)
+            ds = self.readDataset(cineMriInstanceNumberToFilenameIndex[next(iter(cineMriInstanceNumberToFilenameIndex))])
             name = ''
             if hasattr(ds, 'SeriesNumber') and ds.SeriesNumber:
                 name = f'{ds.SeriesNumber}:'
@@ -282,7 +281,7 @@ class DICOMImageSequencePluginClass(DICOMPlugin):
         if singleFileInLoadable:
             outputSequenceNode.SetName(name)
         else:
-            ds = dicom.read_file(filePath, stop_before_pixels=True)
+            ds = self.readDataset(filePath)
             if hasattr(ds, 'PositionerPrimaryAngle') and hasattr(ds, 'PositionerSecondaryAngle'):
                 outputSequenceNode.SetName(f'{name} ({ds.PositionerPrimaryAngle}/{ds.PositionerSecondaryAngle})')
             else:
@@ -362,7 +361,7 @@ class DICOMImageSequencePluginClass(DICOMPlugin):
                 # Save DICOM SOP instance UID into the sequence so DICOM metadata can be retrieved later if needed
                 tempFrameVolume.SetAttribute('DICOM.instanceUIDs', slicer.dicomDatabase.instanceForFile(filePath))
                 # Save trigger time, because it may be needed for 4D cine-MRI volume reconstruction
-                triggerTime = slicer.dicomDatabase.fileValue(filePath, self.tags['triggerTime'])
+                triggerTime = self.fileValue(filePath, self.tags['triggerTime'])
                 if triggerTime:
                     tempFrameVolume.SetAttribute('DICOM.triggerTime', triggerTime)
                 outputSequenceNode.SetDataNodeAtValue(tempFrameVolume, str(instanceNumber))
@@ -172,7 +172,7 @@ class DICOMScalarVolumePluginClass(DICOMPlugin):
         files parameter.
         """
 
-        seriesUID = slicer.dicomDatabase.fileValue(files[0], self.tags['seriesUID'])
+        seriesUID = self.fileValue(files[0], self.tags['seriesUID'])
         seriesName = self.defaultSeriesNodeName(seriesUID)
 
         # default loadable includes all files for series
@@ -217,7 +217,7 @@ class DICOMScalarVolumePluginClass(DICOMPlugin):
         for file in allFilesLoadable.files:
             # check for subseries values
             for tag in subseriesTags:
-                value = slicer.dicomDatabase.fileValue(file, self.tags[tag])
+                value = self.fileValue(file, self.tags[tag])
                 value = value.replace(",", "_")  # remove commas so it can be used as an index
                 if tag not in subseriesValues:
                     subseriesValues[tag] = []
@@ -271,17 +271,17 @@ class DICOMScalarVolumePluginClass(DICOMPlugin):
             for file in loadable.files:
                 if slicer.dicomDatabase.fileValueExists(file, self.tags['pixelData']):
                     newFiles.append(file)
-                if slicer.dicomDatabase.fileValue(file, self.tags['sopClassUID']) == '1.2.840.10008.5.1.4.1.1.66.4':
+                if self.fileValue(file, self.tags['sopClassUID']) == '1.2.840.10008.5.1.4.1.1.66.4':
                     excludedLoadable = True
                     if 'DICOMSegmentationPlugin' not in slicer.modules.dicomPlugins:
                         logging.warning('Please install Quantitative Reporting extension to enable loading of DICOM Segmentation objects')
-                elif slicer.dicomDatabase.fileValue(file, self.tags['sopClassUID']) == '1.2.840.10008.5.1.4.1.1.481.3':
+                elif self.fileValue(file, self.tags['sopClassUID']) == '1.2.840.10008.5.1.4.1.1.481.3':
                     excludedLoadable = True
                     if 'DicomRtImportExportPlugin' not in slicer.modules.dicomPlugins:
                         logging.warning('Please install SlicerRT extension to enable loading of DICOM RT Structure Set objects')
             if len(newFiles) > 0 and not excludedLoadable:
                 loadable.files = newFiles
-                loadable.grayscale = ('MONOCHROME' in slicer.dicomDatabase.fileValue(newFiles[0], self.tags['photometricInterpretation']))
+                loadable.grayscale = ('MONOCHROME' in self.fileValue(newFiles[0], self.tags['photometricInterpretation']))
                 newLoadables.append(loadable)
             elif excludedLoadable:
                 continue
@@ -291,7 +291,7 @@ class DICOMScalarVolumePluginClass(DICOMPlugin):
                 # them through with a warning and low confidence
                 loadable.warning += "There is no pixel data attribute for the DICOM objects, but they might be readable as secondary capture images.  "
                 loadable.confidence = 0.2
-                loadable.grayscale = ('MONOCHROME' in slicer.dicomDatabase.fileValue(loadable.files[0], self.tags['photometricInterpretation']))
+                loadable.grayscale = ('MONOCHROME' in self.fileValue(loadable.files[0], self.tags['photometricInterpretation']))
                 newLoadables.append(loadable)
         loadables = newLoadables
 
@@ -434,7 +434,7 @@ class DICOMScalarVolumePluginClass(DICOMPlugin):
             #
             instanceUIDs = ""
             for file in loadable.files:
-                uid = slicer.dicomDatabase.fileValue(file, self.tags['instanceUID'])
+                uid = self.fileValue(file, self.tags['instanceUID'])
                 if uid == "":
                     uid = "Unknown"
                 instanceUIDs += uid + " "
@@ -463,8 +463,8 @@ class DICOMScalarVolumePluginClass(DICOMPlugin):
             #   [2] https://github.com/Slicer/Slicer/blob/3bfa2fc2b310d41c09b7a9e8f8f6c4f43d3bd1e2/Libs/MRML/Core/vtkMRMLScalarVolumeDisplayNode.h#L172
             #
             try:
-                windowCenter = float(slicer.dicomDatabase.fileValue(file, self.tags['windowCenter']))
-                windowWidth = float(slicer.dicomDatabase.fileValue(file, self.tags['windowWidth']))
+                windowCenter = float(self.fileValue(file, self.tags['windowCenter']))
+                windowWidth = float(self.fileValue(file, self.tags['windowWidth']))
                 displayNode = volumeNode.GetDisplayNode()
                 if displayNode:
                     logging.info('Window/level found in DICOM tags (center=' + str(windowCenter) + ', width=' + str(windowWidth) + ') has been applied to volume ' + volumeNode.GetName())
@@ -475,7 +475,7 @@ class DICOMScalarVolumePluginClass(DICOMPlugin):
             except ValueError:
                 pass  # DICOM tags cannot be parsed to floating point numbers
 
-            sopClassUID = slicer.dicomDatabase.fileValue(file, self.tags['sopClassUID'])
+            sopClassUID = self.fileValue(file, self.tags['sopClassUID'])
 
             # initialize color lookup table
             modality = self.mapSOPClassUIDToModality(sopClassUID)
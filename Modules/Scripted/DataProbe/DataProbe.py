@@ -98,10 +98,17 @@ class DataProbeInfoWidget:
         # Helper class to calculate and display tensor scalars
         self.calculateTensorScalars = CalculateTensorScalars()
 
+        # Cursor position changes are compressed: the readout is updated at most once
+        # per display refresh (about 60 times per second), using the latest cursor position.
+        self.updateTimer = qt.QTimer()
+        self.updateTimer.setSingleShot(True)
+        self.updateTimer.setInterval(16)
+        self.updateTimer.connect('timeout()', self.onUpdateTimerTimeout)
+
         # Observe the crosshair node to get the current cursor position
         self.CrosshairNode = slicer.mrmlScene.GetFirstNodeByClass('vtkMRMLCrosshairNode')
         if self.CrosshairNode:
-            self.CrosshairNodeObserverTag = self.CrosshairNode.AddObserver(slicer.vtkMRMLCrosshairNode.CursorPositionModifiedEvent, self.processEvent)
+            self.CrosshairNodeObserverTag = self.CrosshairNode.AddObserver(slicer.vtkMRMLCrosshairNode.CursorPositionModifiedEvent, self.requestUpdate)
 
     def __del__(self):
         self.removeObservers()
@@ -120,6 +127,15 @@ class DataProbeInfoWidget:
         if self.CrosshairNode and self.CrosshairNodeObserverTag:
             self.CrosshairNode.RemoveObserver(self.CrosshairNodeObserverTag)
         self.CrosshairNodeObserverTag = None
+        self.updateTimer.stop()
+
+    def requestUpdate(self, observee=None, event=None):
+        """Schedule update of the readout. Multiple requests are compressed into a single update."""
+        if not self.updateTimer.isActive():
+            self.updateTimer.start()
+
+    def onUpdateTimerTimeout(self):
+        self.processEvent(self.CrosshairNode, slicer.vtkMRMLCrosshairNode.CursorPositionModifiedEvent)
 
     def getPixelString(self, volumeNode, ijk):
         """Given a volume node, create a human readable
@@ -189,7 +205,9 @@ class DataProbeInfoWidget:
         return pixel[:-2]
 
     def processEvent(self, observee, event):
-        # TODO: use a timer to delay calculation and compress events
+        """Update the readout from the current cursor position.
+        Called by requestUpdate() with a delay, to avoid updating more frequently than it can be displayed.
+        """
         insideView = False
         ras = [0.0, 0.0, 0.0]
         xyz = [0.0, 0.0, 0.0]
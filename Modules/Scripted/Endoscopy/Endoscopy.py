@@ -56,9 +56,12 @@ class EndoscopyWidget(ScriptedLoadableModuleWidget):
         # Flythough variables
         self.transform = None
         self.path = None
+        self.pathOrientations = None
         self.camera = None
         self.skip = 0
         self.timer = qt.QTimer()
+        # Precise timer is needed for smooth playback, as the default coarse timer may be off by 5%
+        self.timer.timerType = qt.Qt.PreciseTimer
         self.timer.setInterval(20)
         self.timer.connect('timeout()', self.flyToNext)
 
@@ -247,6 +250,7 @@ class EndoscopyWidget(ScriptedLoadableModuleWidget):
         self.transform = model.transform
         self.pathPlaneNormal = model.planeNormal
         self.path = result.path
+        self.pathOrientations = EndoscopyComputePath.cameraOrientations(self.path, self.pathPlaneNormal)
 
         # Enable / Disable flythrough button
         self.flythroughCollapsibleButton.enabled = len(result.path) > 0
@@ -299,33 +303,8 @@ class EndoscopyWidget(ScriptedLoadableModuleWidget):
         self.camera.SetFocalPoint(*focalPointPosition)
         self.camera.OrthogonalizeViewUp()
 
-        toParent = vtk.vtkMatrix4x4()
-        self.transform.GetMatrixTransformToParent(toParent)
-        toParent.SetElement(0, 3, cameraPosition[0])
-        toParent.SetElement(1, 3, cameraPosition[1])
-        toParent.SetElement(2, 3, cameraPosition[2])
-
-        # Set up transform orientation component so that
-        # Z axis is aligned with view direction and
-        # Y vector is aligned with the curve's plane normal.
-        # This can be used for example to show a reformatted slice
-        # using with SlicerIGT extension's VolumeResliceDriver module.
-        import numpy as np
-        zVec = (focalPointPosition - cameraPosition) / np.linalg.norm(focalPointPosition - cameraPosition)
-        yVec = self.pathPlaneNormal
-        xVec = np.cross(yVec, zVec)
-        xVec /= np.linalg.norm(xVec)
-        yVec = np.cross(zVec, xVec)
-        toParent.SetElement(0, 0, xVec[0])
-        toParent.SetElement(1, 0, xVec[1])
-        toParent.SetElement(2, 0, xVec[2])
-        toParent.SetElement(0, 1, yVec[0])
-        toParent.SetElement(1, 1, yVec[1])
-        toParent.SetElement(2, 1, yVec[2])
-        toParent.SetElement(0, 2, zVec[0])
-        toParent.SetElement(1, 2, zVec[1])
-        toParent.SetElement(2, 2, zVec[2])
-
+        # Transform orientations are precomputed for all path points (see EndoscopyComputePath.cameraOrientations)
+        toParent = slicer.util.vtkMatrixFromArray(self.pathOrientations[pathPointIndex])
         self.transform.SetMatrixTransformToParent(toParent)
 
         self.cameraNode.EndModify(wasModified)
@@ -436,22 +415,58 @@ class EndoscopyComputePath:
         """ Generate a flight path for of steps of length dl """
         #
         # calculate the actual path
-        # - take steps of self.dl in world space
-        # -- if dl steps into next segment, take a step of size "remainder" in the new segment
+        # - sample the curve densely (at about 1/10 of dl), in all segments at once
+        # - resample the sampled polyline at equal world space distances of dl
+        #   (arc-length parameterization is computed once, in vtkMRMLMarkupsCurveNode::ResamplePoints)
         # - put resulting points into self.path
         #
+        import numpy
         n = self.n
-        segment = 0  # which first point of current segment
-        t = 0  # parametric current parametric increment
-        remainder = 0  # how much of dl isn't included in current step
-        while segment < n - 1:
-            t, p, remainder = self.step(segment, t, self.dl)
-            if remainder != 0 or t == 1.:
-                segment += 1
-                t = 0
-                if segment < n - 1:
-                    t, p, remainder = self.step(segment, t, remainder)
-            self.path.append(p)
+        if n < 2:
+            self.path = numpy.array(self.path)
+            return
+        denseSegmentPoints = []
+        for segment in range(n - 1):
+            # Hermite curve segment is never longer than the sum of the control point distance and tangent lengths
+            segmentLengthEstimate = (numpy.linalg.norm(self.p[segment + 1] - self.p[segment])
+                                     + numpy.linalg.norm(self.m[segment]) + numpy.linalg.norm(self.m[segment + 1]))
+            numberOfSamples = max(10, int(10 * segmentLengthEstimate / self.dl))
+            t = numpy.linspace(0.0, 1.0, numberOfSamples, endpoint=False)[:, numpy.newaxis]
+            denseSegmentPoints.append(self.point(segment, t))
+        denseSegmentPoints.append(self.p[n - 1][numpy.newaxis, :])
+        densePoints = vtk.vtkPoints()
+        densePoints.SetData(vtk.util.numpy_support.numpy_to_vtk(numpy.concatenate(denseSegmentPoints), deep=True))
+        resampledPoints = vtk.vtkPoints()
+        slicer.vtkMRMLMarkupsCurveNode.ResamplePoints(densePoints, resampledPoints, self.dl, False)
+        self.path = numpy.array(vtk.util.numpy_support.vtk_to_numpy(resampledPoints.GetData()))
+
+    @staticmethod
+    def cameraOrientations(path, planeNormal):
+        """Compute camera transform matrices for all path points (except the last one) at once.
+
+        Transform orientation component is set up so that
+        Z axis is aligned with view direction and
+        Y vector is aligned with the curve's plane normal.
+        This can be used for example to show a reformatted slice
+        using with SlicerIGT extension's VolumeResliceDriver module.
+
+        :param path: path points as numpy array.
+        :param planeNormal: normal of the plane that is fitted to the path points.
+        :return: numpy array of 4x4 transform matrices.
+        """
+        import numpy as np
+        path = np.asarray(path, dtype=float)
+        zVec = path[1:] - path[:-1]
+        zVec /= np.linalg.norm(zVec, axis=1)[:, np.newaxis]
+        xVec = np.cross(planeNormal, zVec)
+        xVec /= np.linalg.norm(xVec, axis=1)[:, np.newaxis]
+        yVec = np.cross(zVec, xVec)
+        matrices = np.tile(np.eye(4), (len(zVec), 1, 1))
+        matrices[:, 0:3, 0] = xVec
+        matrices[:, 0:3, 1] = yVec
+        matrices[:, 0:3, 2] = zVec
+        matrices[:, 0:3, 3] = path[:-1]
+        return matrices
 
     def point(self, segment, t):
         return (self.h00(t) * self.p[segment] +
@@ -222,6 +222,68 @@ class PerformanceTestsWidget(ScriptedLoadableModuleWidget):
         self.memoryCallback()
 
 
+#
+# PerformanceTestsTest
+#
+
+class PerformanceTestsTest(ScriptedLoadableModuleTest):
+    """
+    Timed scenarios. Median times are printed as dashboard measurements, which allows
+    comparing them with baselines (see slicer_add_performance_test CMake function).
+    """
+
+    def setUp(self):
+        import numpy as np
+        slicer.mrmlScene.Clear(0)
+        voxels = np.random.RandomState(0).randint(0, 1000, size=(100, 256, 256)).astype(np.int16)
+        self.volumeNode = slicer.util.addVolumeFromArray(voxels, name="PerformanceTestsVolume")
+        slicer.util.setSliceViewerLayers(background=self.volumeNode, fit=True)
+        slicer.app.processEvents()
+
+    def runTest(self):
+        self.setUp()
+        self.test_Reslicing()
+        self.setUp()
+        self.test_CrosshairJump()
+
+    def reportMeasurement(self, name, timesSec):
+        import numpy as np
+        medianTimeMsec = 1000. * np.median(timesSec)
+        self.delayDisplay(f"{name}: {medianTimeMsec:.1f} ms per frame (median)", 0)
+        print(f'<DartMeasurement name="PerformanceTests-{name}" type="numeric/double">{medianTimeMsec:g}</DartMeasurement>')
+
+    def test_Reslicing(self, iters=100):
+        import time
+        sliceNode = slicer.util.getNode('vtkMRMLSliceNodeRed')
+        startOffset = sliceNode.GetSliceOffset()
+        renderingTimesSec = []
+        for i in range(iters):
+            # sweep back and forth, 10 slices in each direction
+            offset = 1.0 if (i // 10) % 2 == 0 else -1.0
+            startTime = time.perf_counter()
+            sliceNode.SetSliceOffset(sliceNode.GetSliceOffset() + offset)
+            slicer.app.processEvents()
+            renderingTimesSec.append(time.perf_counter() - startTime)
+        sliceNode.SetSliceOffset(startOffset)
+        self.reportMeasurement("Reslicing", renderingTimesSec)
+
+    def test_CrosshairJump(self, iters=15):
+        import time
+        sliceNode = slicer.util.getNode('vtkMRMLSliceNodeRed')
+        dims = sliceNode.GetDimensions()
+        sliceWidget = slicer.app.layoutManager().sliceWidget('Red')
+        startPoint = (int(dims[0] * 0.3), int(dims[1] * 0.3))
+        endPoint = (int(dims[0] * 0.6), int(dims[1] * 0.6))
+        jumpTimesSec = []
+        for i in range(iters):
+            for start, end in ((startPoint, endPoint), (endPoint, startPoint)):
+                startTime = time.perf_counter()
+                slicer.util.clickAndDrag(sliceWidget, button=None, modifiers=['Shift'], start=start, end=end, steps=2)
+                slicer.app.processEvents()
+                jumpTimesSec.append(time.perf_counter() - startTime)
+        self.reportMeasurement("CrosshairJump", jumpTimesSec)
+
+
 class sliceLogicTest:
     def __init__(self):
         self.step = 0
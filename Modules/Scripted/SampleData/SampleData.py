@@ -841,21 +841,136 @@ class SampleDataLogic:
             self.logMessage('<i>Downloaded %s (%d%% of %s)...</i>' % (humanSizeSoFar, percent, humanSizeTotal))
             self.downloadPercent = percent
 
+    #: Size of the byte ranges that are downloaded in parallel.
+    downloadChunkSize = 8 * 1024 * 1024
+
+    #: Maximum number of byte ranges of a file that are downloaded at the same time.
+    numberOfParallelDownloads = 4
+
+    #: Size of the blocks that are read from a download stream.
+    downloadBlockSize = 64 * 1024
+
+    def downloadToFile(self, uri, filePath, algo=None):
+        """Download ``uri`` into ``filePath`` and return the digest of the content computed using ``algo``.
+
+        If the server accepts byte range requests and the file is larger than :attr:`downloadChunkSize`,
+        then the chunks of the file are downloaded in parallel.
+        Chunks are written and hashed in order while downloading, so no separate pass over the
+        file is needed for verifying the checksum.
+
+        The content is written into a temporary file next to ``filePath``, which is renamed to ``filePath``
+        only after the download is completed, so that an interrupted download never leaves a truncated
+        file in the cache.
+
+        :raises OSError: if the download fails.
+        """
+        import hashlib
+        import urllib.request
+
+        hash = hashlib.new(algo) if algo is not None else None
+        partialFilePath = filePath + '.part'
+        try:
+            response = urllib.request.urlopen(uri)
+            try:
+                totalSize = int(response.headers.get('Content-Length', -1))
+                rangesSupported = (response.headers.get('Accept-Ranges', '').lower() == 'bytes'
+                                   and uri.lower().startswith(('http:', 'https:')))
+                with open(partialFilePath, 'wb') as partialFile:
+                    if rangesSupported and totalSize > self.downloadChunkSize:
+                        self._downloadChunksInParallel(uri, response, totalSize, partialFile, hash)
+                    else:
+                        self._downloadStream(response, totalSize, partialFile, hash)
+            finally:
+                response.close()
+            os.replace(partialFilePath, filePath)
+        except:
+            if os.path.exists(partialFilePath):
+                os.remove(partialFilePath)
+            raise
+        return hash.hexdigest() if hash is not None else None
+
+    def _writeAndHash(self, data, outputFile, hash):
+        outputFile.write(data)
+        if hash is not None:
+            hash.update(data)
+
+    def _downloadStream(self, response, totalSize, outputFile, hash):
+        """Download the content of ``response`` sequentially."""
+        bytesSoFar = 0
+        while True:
+            data = response.read(self.downloadBlockSize)
+            if not data:
+                break
+            self._writeAndHash(data, outputFile, hash)
+            bytesSoFar += len(data)
+            if totalSize > 0:
+                self.reportHook(bytesSoFar, 1, totalSize)
+        if totalSize >= 0 and bytesSoFar < totalSize:
+            raise OSError(f"retrieval incomplete: got only {bytesSoFar} out of {totalSize} bytes")
+
+    def _downloadChunksInParallel(self, uri, response, totalSize, outputFile, hash):
+        """Download the byte ranges of ``uri`` in parallel and write them in order.
+
+        The first chunk is read from the already open ``response``, the other chunks
+        are requested using HTTP range requests. At most :attr:`numberOfParallelDownloads`
+        chunks are pending at any time, which bounds the memory used for chunks that wait
+        to be written.
+        """
+        import concurrent.futures
+        import urllib.request
+
+        def readChunk(chunkResponse, size):
+            chunks = []
+            while size > 0:
+                data = chunkResponse.read(min(size, self.downloadBlockSize))
+                if not data:
+                    raise OSError(f"retrieval incomplete: {size} bytes missing from {uri}")
+                chunks.append(data)
+                size -= len(data)
+            return b''.join(chunks)
+
+        def downloadChunk(begin, end):
+            request = urllib.request.Request(uri, headers={'Range': f'bytes={begin}-{end - 1}'})
+            with urllib.request.urlopen(request) as chunkResponse:
+                if chunkResponse.status != 206:
+                    raise OSError(f"server did not return the requested byte range of {uri}")
+                return readChunk(chunkResponse, end - begin)
+
+        chunkBegins = list(range(0, totalSize, self.downloadChunkSize))
+        with concurrent.futures.ThreadPoolExecutor(max_workers=self.numberOfParallelDownloads) as executor:
+            pendingChunks = [executor.submit(readChunk, response, self.downloadChunkSize)]
+            nextChunkIndex = 1
+            bytesSoFar = 0
+            try:
+                while pendingChunks:
+                    while nextChunkIndex < len(chunkBegins) and len(pendingChunks) < self.numberOfParallelDownloads:
+                        begin = chunkBegins[nextChunkIndex]
+                        pendingChunks.append(executor.submit(downloadChunk, begin, min(begin + self.downloadChunkSize, totalSize)))
+                        nextChunkIndex += 1
+                    data = pendingChunks.pop(0).result()
+                    self._writeAndHash(data, outputFile, hash)
+                    bytesSoFar += len(data)
+                    self.reportHook(bytesSoFar, 1, totalSize)
+            finally:
+                for pendingChunk in pendingChunks:
+                    pendingChunk.cancel()
+
     def downloadFile(self, uri, destFolderPath, name, checksum=None):
         """
         :param uri: Download URL.
         :param destFolderPath: Folder to download the file into.
         :param name: File name that will be downloaded.
         :param checksum: Checksum formatted as ``<algo>:<digest>`` to verify the downloaded file. For example, ``SHA256:cc211f0dfd9a05ca3841ce1141b292898b2dd2d3f08286affadf823a7e58df93``.
+
+        The checksum of a downloaded file is computed while downloading, see :func:`downloadToFile`.
         """
         self.downloadPercent = 0
         filePath = destFolderPath + '/' + name
         (algo, digest) = extractAlgoAndDigest(checksum)
         if not os.path.exists(filePath) or os.stat(filePath).st_size == 0:
-            import urllib.request, urllib.parse, urllib.error
             self.logMessage(f'<b>Requesting download</b> <i>{name}</i> from {uri} ...')
             try:
-                urllib.request.urlretrieve(uri, filePath, self.reportHook)
+                current_digest = self.downloadToFile(uri, filePath, algo)
                 self.logMessage('<b>Download finished</b>')
             except OSError as e:
                 self.logMessage('<b>\tDownload failed: %s</b>' % e, logging.ERROR)
@@ -863,7 +978,6 @@ class SampleDataLogic:
 
             if algo is not None:
                 self.logMessage('<b>Verifying checksum</b>')
-                current_digest = computeChecksum(algo, filePath)
                 if current_digest != digest:
                     self.logMessage(f'<b>Checksum verification failed. Computed checksum {current_digest} different from expected checksum {digest}</b>')
                     qt.QFile(filePath).remove()
@@ -704,7 +704,15 @@ class ScreenCaptureWidget(ScriptedLoadableModuleWidget):
             self.logic.showViewControllers(showViewControllers)
         elif showViewControllers:
             logging.warning("View controllers are only available to be shown when capturing all views.")
+        fps = self.videoFrameRateSliderWidget.value
+        forwardBackward = self.forwardBackwardCheckBox.checked
+        numberOfRepeats = int(self.repeatSliderWidget.value)
+        # Frames are piped directly into the video encoder, unless they need to be reused
+        # (for going forward and backward or repeating)
+        streamVideo = videoOutputRequested and not forwardBackward and numberOfRepeats == 1
         try:
+            if streamVideo:
+                self.logic.startVideoEncoding(fps, self.extraVideoOptionsWidget.text, outputDir, self.videoFileNameWidget.text)
             if numberOfSteps < 2:
                 if imageFileNamePattern != self.snapshotFileNamePattern or outputDir != self.snapshotOutputDir:
                     self.snapshotIndex = 0
@@ -742,11 +750,9 @@ class ScreenCaptureWidget(ScriptedLoadableModuleWidget):
 
             import shutil
 
-            fps = self.videoFrameRateSliderWidget.value
-
-            if numberOfSteps > 1:
-                forwardBackward = self.forwardBackwardCheckBox.checked
-                numberOfRepeats = int(self.repeatSliderWidget.value)
+            if streamVideo:
+                self.logic.finishVideoEncoding()
+            elif numberOfSteps > 1:
                 filePathPattern = os.path.join(outputDir, imageFileNamePattern)
                 fileIndex = numberOfSteps
                 for repeatIndex in range(numberOfRepeats):
@@ -768,21 +774,23 @@ class ScreenCaptureWidget(ScriptedLoadableModuleWidget):
                     numberOfSteps += numberOfSteps - 2
                 numberOfSteps *= numberOfRepeats
 
-            try:
-                if videoOutputRequested:
-                    self.logic.createVideo(fps, self.extraVideoOptionsWidget.text,
-                                           outputDir, imageFileNamePattern, self.videoFileNameWidget.text)
-                elif (self.outputTypeWidget.currentText == "lightbox image"):
-                    self.logic.createLightboxImage(int(self.lightboxColumnCountSliderWidget.value),
-                                                   outputDir, imageFileNamePattern, numberOfSteps, self.lightboxImageFileNameWidget.text)
-            finally:
-                if not self.outputTypeWidget.currentText == "image series":
-                    self.logic.deleteTemporaryFiles(outputDir, imageFileNamePattern, numberOfSteps)
+            if not streamVideo:
+                try:
+                    if videoOutputRequested:
+                        self.logic.createVideo(fps, self.extraVideoOptionsWidget.text,
+                                               outputDir, imageFileNamePattern, self.videoFileNameWidget.text)
+                    elif (self.outputTypeWidget.currentText == "lightbox image"):
+                        self.logic.createLightboxImage(int(self.lightboxColumnCountSliderWidget.value),
+                                                       outputDir, imageFileNamePattern, numberOfSteps, self.lightboxImageFileNameWidget.text)
+                finally:
+                    if not self.outputTypeWidget.currentText == "image series":
+                        self.logic.deleteTemporaryFiles(outputDir, imageFileNamePattern, numberOfSteps)
 
             self.addLog("Done.")
             self.createdOutputFile = os.path.join(outputDir, self.videoFileNameWidget.text) if videoOutputRequested else outputDir
             self.showCreatedOutputFileButton.enabled = True
         except Exception as e:
+            self.logic.abortVideoEncoding()
             self.addLog(f"Error: {str(e)}")
             import traceback
             traceback.print_exc()
@@ -796,6 +804,90 @@ class ScreenCaptureWidget(ScriptedLoadableModuleWidget):
         self.enableInputOutputWidgets(True)
 
 
+#
+# FfmpegVideoEncoder
+#
+
+class FfmpegVideoEncoder:
+    """Encodes frames into a video file by sending raw pixel data to ffmpeg through a pipe.
+
+    The ffmpeg process is started when the first frame arrives, as frame size is needed
+    for interpreting the raw pixel data. All frames must have the same size.
+    """
+
+    def __init__(self, ffmpegPath, frameRate, extraOptions, outputVideoFilePath, logCallback=None):
+        self.ffmpegPath = ffmpegPath
+        self.frameRate = frameRate
+        self.extraOptions = extraOptions
+        self.outputVideoFilePath = outputVideoFilePath
+        self.logCallback = logCallback
+        self.process = None
+        self.errorOutputFile = None
+        self.frameSize = None
+
+    def start(self, frameSize, numberOfComponents):
+        import subprocess
+        import tempfile
+        self.frameSize = frameSize
+        self.numberOfComponents = numberOfComponents
+        ffmpegParams = [self.ffmpegPath,
+                        "-y",  # overwrite without asking
+                        "-f", "rawvideo",
+                        "-pix_fmt", "rgba" if numberOfComponents == 4 else "rgb24",
+                        "-s", f"{frameSize[0]}x{frameSize[1]}",
+                        "-r", str(self.frameRate),
+                        "-i", "-"]  # read frames from standard input
+        ffmpegParams += [_f for _f in self.extraOptions.split(' ') if _f]
+        ffmpegParams.append(self.outputVideoFilePath)
+        if self.logCallback:
+            self.logCallback("Start ffmpeg:\n" + ' '.join(ffmpegParams))
+        # Error output is written to a file, because a pipe could fill up and block ffmpeg
+        self.errorOutputFile = tempfile.TemporaryFile()
+        self.process = subprocess.Popen(ffmpegParams, stdin=subprocess.PIPE, stdout=subprocess.DEVNULL,
+                                        stderr=self.errorOutputFile, cwd=os.path.dirname(self.outputVideoFilePath))
+
+    def writeFrame(self, imageData):
+        import vtk.util.numpy_support
+        dimensions = imageData.GetDimensions()
+        numberOfComponents = imageData.GetNumberOfScalarComponents()
+        if self.process is None:
+            self.start(dimensions[0:2], numberOfComponents)
+        elif tuple(dimensions[0:2]) != tuple(self.frameSize) or numberOfComponents != self.numberOfComponents:
+            raise ValueError("Video creation failed: size of captured images changed during capture")
+        pixels = vtk.util.numpy_support.vtk_to_numpy(imageData.GetPointData().GetScalars())
+        # VTK images start at the bottom row, video frames start at the top row
+        pixels = pixels.reshape(dimensions[1], dimensions[0], numberOfComponents)[::-1]
+        try:
+            self.process.stdin.write(pixels.tobytes())
+        except OSError:
+            # ffmpeg exited, error is reported in finish()
+            raise ValueError("ffmpeg returned with error: " + self.errorOutput())
+
+    def errorOutput(self):
+        self.errorOutputFile.seek(0)
+        return self.errorOutputFile.read().decode(errors="replace")
+
+    def finish(self):
+        if self.process is None:
+            raise ValueError("Video creation failed: no frames were captured")
+        self.process.stdin.close()
+        returnCode = self.process.wait()
+        errorOutput = self.errorOutput()
+        self.errorOutputFile.close()
+        if returnCode != 0:
+            if self.logCallback:
+                self.logCallback("ffmpeg error output: " + errorOutput)
+            raise ValueError("ffmpeg returned with error")
+        logging.debug("ffmpeg error output: " + errorOutput)
+
+    def abort(self):
+        if self.process is None:
+            return
+        self.process.kill()
+        self.process.wait()
+        self.errorOutputFile.close()
+
+
 #
 # ScreenCaptureLogic
 #
@@ -813,10 +905,16 @@ class ScreenCaptureLogic(ScriptedLoadableModuleLogic):
     def __init__(self):
         self.logCallback = None
         self.cancelRequested = False
+        # If set then captured frames are sent to this encoder instead of writing them to image files
+        self.videoEncoder = None
 
         self.videoFormatPresets = [
             {"name": "H.264", "fileExtension": "mp4", "extraVideoOptions": "-codec libx264 -preset slower -pix_fmt yuv420p"},
             {"name": "H.264 (high-quality)", "fileExtension": "mp4", "extraVideoOptions": "-codec libx264 -preset slower -crf 18 -pix_fmt yuv420p"},
+            {"name": "H.264 (NVIDIA hardware encoder)", "fileExtension": "mp4", "extraVideoOptions": "-codec h264_nvenc -preset slow -pix_fmt yuv420p"},
+            {"name": "H.264 (Intel/AMD hardware encoder on Linux)", "fileExtension": "mp4",
+             "extraVideoOptions": "-vaapi_device /dev/dri/renderD128 -vf format=nv12,hwupload -codec h264_vaapi"},
+            {"name": "H.264 (macOS hardware encoder)", "fileExtension": "mp4", "extraVideoOptions": "-codec h264_videotoolbox -b:v 8M -pix_fmt yuv420p"},
             {"name": "MPEG-4", "fileExtension": "mp4", "extraVideoOptions": "-codec mpeg4 -qscale 5"},
             {"name": "MPEG-4 (high-quality)", "fileExtension": "mp4", "extraVideoOptions": "-codec mpeg4 -qscale 3"},
             {"name": "Animated GIF", "fileExtension": "gif", "extraVideoOptions": "-filter_complex palettegen,[v]paletteuse"},
@@ -1113,10 +1211,13 @@ class ScreenCaptureLogic(ScriptedLoadableModuleLogic):
             else:
                 raise ValueError("Invalid vector volume node.")
         if filename:
-            writer = self.createImageWriter(filename)
-            writer.SetInputData(capturedImage)
-            writer.SetFileName(filename)
-            writer.Write()
+            if self.videoEncoder is not None:
+                self.videoEncoder.writeFrame(capturedImage)
+            else:
+                writer = self.createImageWriter(filename)
+                writer.SetInputData(capturedImage)
+                writer.SetFileName(filename)
+                writer.Write()
 
     def createImageWriter(self, filename):
         name, extension = os.path.splitext(filename)
@@ -1442,6 +1543,41 @@ class ScreenCaptureLogic(ScriptedLoadableModuleLogic):
             logging.debug("ffmpeg standard output: " + stdout.decode())
             logging.debug("ffmpeg error output: " + stderr.decode())
 
+    def startVideoEncoding(self, frameRate, extraOptions, outputDir, videoFileName):
+        """
+        Start encoding of captured frames directly into a video file.
+        Until finishVideoEncoding() or abortVideoEncoding() is called, capture methods send
+        the frames to the video encoder instead of writing them into image files.
+        This avoids writing, reading, and deleting temporary image files and the video
+        is encoded while the next frames are rendered.
+        """
+        ffmpegPath = os.path.abspath(self.getFfmpegPath())
+        if not os.path.isfile(ffmpegPath):
+            raise ValueError("Video creation failed: ffmpeg executable path is invalid: " + ffmpegPath)
+        if not os.path.exists(outputDir):
+            os.makedirs(outputDir)
+        outputVideoFilePath = os.path.join(outputDir, videoFileName)
+        self.addLog("Export to video...")
+        self.videoEncoder = FfmpegVideoEncoder(ffmpegPath, frameRate, extraOptions, outputVideoFilePath, self.addLog)
+
+    def finishVideoEncoding(self):
+        """
+        Complete the video file that was started by startVideoEncoding().
+        """
+        encoder = self.videoEncoder
+        self.videoEncoder = None
+        encoder.finish()
+        self.addLog("Video export succeeded to file: " + encoder.outputVideoFilePath)
+
+    def abortVideoEncoding(self):
+        """
+        Stop video encoding that was started by startVideoEncoding(), without completing the video file.
+        """
+        if self.videoEncoder is None:
+            return
+        self.videoEncoder.abort()
+        self.videoEncoder = None
+
     def deleteTemporaryFiles(self, outputDir, imageFileNamePattern, numberOfImages):
         """
         Delete files after a video has been created from them.
@@ -40,8 +40,66 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
             "principal_axis_y": "PrincipalAxisY",
             "principal_axis_z": "PrincipalAxisZ",
         }
+        # Statistics of all labels of a labelmap layer, so that segments that share a layer are computed in one pass
+        self.layerStatisticsCache = {}
+        self.layerStatisticsCacheSegmentationNodeID = None
         # ... developer may add extra options to configure other parameters
 
+    def getLayerStatistics(self, segmentationNode, layerLabelmap, shapeStatisticFlags=None):
+        """Get voxel count and shape statistics of all labels in a (shared) labelmap layer.
+        Results are cached until the labelmap is modified.
+        :param shapeStatisticFlags: list of (shape statistic name, enabled) for vtkITKLabelShapeStatistics.
+          If None then shape statistics are not computed.
+        :return: dict with "voxelCounts" (dict of label value -> voxel count), and if shape statistics are requested
+          "shapeTable" (vtkTable) and "labelRows" (dict of label value -> row index in shapeTable).
+        """
+        if self.layerStatisticsCacheSegmentationNodeID != segmentationNode.GetID():
+            self.layerStatisticsCache = {}
+            self.layerStatisticsCacheSegmentationNodeID = segmentationNode.GetID()
+
+        layerStatistics = self.layerStatisticsCache.get(id(layerLabelmap))
+        if (layerStatistics is None or layerStatistics["labelmap"] is not layerLabelmap
+                or layerStatistics["labelmapMTime"] != layerLabelmap.GetMTime()):
+            # Voxel count of all labels, from a single histogram of the layer
+            maxLabelValue = max(int(layerLabelmap.GetScalarRange()[1]), 0)
+            accumulate = vtk.vtkImageAccumulate()
+            accumulate.SetInputData(layerLabelmap)
+            accumulate.SetComponentExtent(0, maxLabelValue, 0, 0, 0, 0)
+            accumulate.SetComponentOrigin(0, 0, 0)
+            accumulate.SetComponentSpacing(1, 1, 1)
+            accumulate.Update()
+            histogram = accumulate.GetOutput().GetPointData().GetScalars()
+            voxelCounts = {}
+            for labelValue in range(1, maxLabelValue + 1):
+                voxelCount = int(histogram.GetTuple1(labelValue))
+                if voxelCount > 0:
+                    voxelCounts[labelValue] = voxelCount
+            layerStatistics = {"labelmap": layerLabelmap, "labelmapMTime": layerLabelmap.GetMTime(),
+                               "voxelCounts": voxelCounts, "shapeStatisticFlags": None}
+            self.layerStatisticsCache[id(layerLabelmap)] = layerStatistics
+
+        if shapeStatisticFlags is not None and layerStatistics["shapeStatisticFlags"] != shapeStatisticFlags:
+            # Shape statistics of all labels are computed in one pass
+            directions = vtk.vtkMatrix4x4()
+            layerLabelmap.GetDirectionMatrix(directions)
+            shapeStat = vtkITK.vtkITKLabelShapeStatistics()
+            shapeStat.SetInputData(layerLabelmap)
+            shapeStat.SetDirections(directions)
+            for shapeStatisticName, enabled in shapeStatisticFlags:
+                shapeStat.SetComputeShapeStatistic(shapeStatisticName, enabled)
+            shapeStat.Update()
+            shapeTable = shapeStat.GetOutput()
+            labelRows = {}
+            labelValueArray = shapeTable.GetColumnByName("LabelValue")
+            if labelValueArray is not None:
+                for rowIndex in range(shapeTable.GetNumberOfRows()):
+                    labelRows[int(labelValueArray.GetTuple1(rowIndex))] = rowIndex
+            layerStatistics["shapeStatisticFlags"] = shapeStatisticFlags
+            layerStatistics["shapeTable"] = shapeTable
+            layerStatistics["labelRows"] = labelRows
+
+        return layerStatistics
+
     def computeStatistics(self, segmentID):
         import vtkSegmentationCorePython as vtkSegmentationCore
         requestedKeys = self.getRequestedKeys()
@@ -56,46 +114,29 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
         if not containsLabelmapRepresentation:
             return {}
 
-        segmentLabelmap = slicer.vtkOrientedImageData()
-        segmentationNode.GetBinaryLabelmapRepresentation(segmentID, segmentLabelmap)
-        if (not segmentLabelmap
-            or not segmentLabelmap.GetPointData()
-                or not segmentLabelmap.GetPointData().GetScalars()):
+        # Statistics are computed for all segments of the labelmap layer at once, using the label value of the segment
+        segment = segmentationNode.GetSegmentation().GetSegment(segmentID)
+        layerLabelmap = segment.GetRepresentation(
+            vtkSegmentationCore.vtkSegmentationConverter.GetSegmentationBinaryLabelmapRepresentationName()) if segment else None
+        if (not layerLabelmap
+            or not layerLabelmap.GetPointData()
+                or not layerLabelmap.GetPointData().GetScalars()):
             # No input label data
             return {}
-
-        # We need to know exactly the value of the segment voxels, apply threshold to make force the selected label value
-        labelValue = 1
-        backgroundValue = 0
-        thresh = vtk.vtkImageThreshold()
-        thresh.SetInputData(segmentLabelmap)
-        thresh.ThresholdByLower(0)
-        thresh.SetInValue(backgroundValue)
-        thresh.SetOutValue(labelValue)
-        thresh.SetOutputScalarType(vtk.VTK_UNSIGNED_CHAR)
-        thresh.Update()
-
-        #  Use binary labelmap as a stencil
-        stencil = vtk.vtkImageToImageStencil()
-        stencil.SetInputData(thresh.GetOutput())
-        stencil.ThresholdByUpper(labelValue)
-        stencil.Update()
-
-        stat = vtk.vtkImageAccumulate()
-        stat.SetInputData(thresh.GetOutput())
-        stat.SetStencilData(stencil.GetOutput())
-        stat.Update()
+        labelValue = segment.GetLabelValue()
+        layerStatistics = self.getLayerStatistics(segmentationNode, layerLabelmap)
+        voxelCount = layerStatistics["voxelCounts"].get(labelValue, 0)
 
         # Add data to statistics list
-        cubicMMPerVoxel = reduce(lambda x, y: x * y, segmentLabelmap.GetSpacing())
+        cubicMMPerVoxel = reduce(lambda x, y: x * y, layerLabelmap.GetSpacing())
         ccPerCubicMM = 0.001
         stats = {}
         if "voxel_count" in requestedKeys:
-            stats["voxel_count"] = stat.GetVoxelCount()
+            stats["voxel_count"] = voxelCount
         if "volume_mm3" in requestedKeys:
-            stats["volume_mm3"] = stat.GetVoxelCount() * cubicMMPerVoxel
+            stats["volume_mm3"] = voxelCount * cubicMMPerVoxel
         if "volume_cm3" in requestedKeys:
-            stats["volume_cm3"] = stat.GetVoxelCount() * cubicMMPerVoxel * ccPerCubicMM
+            stats["volume_cm3"] = voxelCount * cubicMMPerVoxel * ccPerCubicMM
 
         calculateShapeStats = False
         for shapeKey in self.shapeKeys:
@@ -103,10 +144,7 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 calculateShapeStats = True
                 break
 
-        if calculateShapeStats:
-            directions = vtk.vtkMatrix4x4()
-            segmentLabelmap.GetDirectionMatrix(directions)
-
+        if calculateShapeStats and voxelCount > 0:
             # Remove oriented bounding box from requested keys and replace with individual keys
             requestedOptions = requestedKeys
             statFilterOptions = self.shapeKeys
@@ -154,18 +192,18 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 requestedOptions.append("principal_axes")
                 requestedOptions.append("centroid_ras")
 
-            shapeStat = vtkITK.vtkITKLabelShapeStatistics()
-            shapeStat.SetInputData(thresh.GetOutput())
-            shapeStat.SetDirections(directions)
-            for shapeKey in statFilterOptions:
-                shapeStat.SetComputeShapeStatistic(self.keyToShapeStatisticNames[shapeKey], shapeKey in requestedOptions)
-            shapeStat.Update()
+            shapeStatisticFlags = [(self.keyToShapeStatisticNames[shapeKey], shapeKey in requestedOptions) for shapeKey in statFilterOptions]
+            layerStatistics = self.getLayerStatistics(segmentationNode, layerLabelmap, shapeStatisticFlags)
+            statTable = layerStatistics["shapeTable"]
+            rowIndex = layerStatistics["labelRows"].get(labelValue)
+            if rowIndex is None:
+                logging.error(f"Could not calculate shape statistics for segment {segmentID}!")
+                return stats
 
             # If segmentation node is transformed, apply that transform to get RAS coordinates
             transformSegmentToRas = vtk.vtkGeneralTransform()
             slicer.vtkMRMLTransformNode.GetTransformBetweenNodes(segmentationNode.GetParentTransformNode(), None, transformSegmentToRas)
 
-            statTable = shapeStat.GetOutput()
             if "centroid_ras" in requestedKeys:
                 centroidRAS = [0, 0, 0]
                 centroidTuple = None
@@ -173,7 +211,7 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if centroidArray is None:
                     logging.error("Could not calculate centroid_ras!")
                 else:
-                    centroidTuple = centroidArray.GetTuple(0)
+                    centroidTuple = centroidArray.GetTuple(rowIndex)
                 if centroidTuple is not None:
                     transformSegmentToRas.TransformPoint(centroidTuple, centroidRAS)
                     stats["centroid_ras"] = centroidRAS
@@ -184,7 +222,7 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if roundnessArray is None:
                     logging.error("Could not calculate roundness!")
                 else:
-                    roundnessTuple = roundnessArray.GetTuple(0)
+                    roundnessTuple = roundnessArray.GetTuple(rowIndex)
                 if roundnessTuple is not None:
                     roundness = roundnessTuple[0]
                     stats["roundness"] = roundness
@@ -195,7 +233,7 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if flatnessArray is None:
                     logging.error("Could not calculate flatness!")
                 else:
-                    flatnessTuple = flatnessArray.GetTuple(0)
+                    flatnessTuple = flatnessArray.GetTuple(rowIndex)
                 if flatnessTuple is not None:
                     flatness = flatnessTuple[0]
                     stats["flatness"] = flatness
@@ -206,7 +244,7 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if elongationArray is None:
                     logging.error("Could not calculate elongation!")
                 else:
-                    elongationTuple = elongationArray.GetTuple(0)
+                    elongationTuple = elongationArray.GetTuple(rowIndex)
                 if elongationTuple is not None:
                     elongation = elongationTuple[0]
                     stats["elongation"] = elongation
@@ -217,7 +255,7 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if feretDiameterArray is None:
                     logging.error("Could not calculate feret_diameter_mm!")
                 else:
-                    feretDiameterTuple = feretDiameterArray.GetTuple(0)
+                    feretDiameterTuple = feretDiameterArray.GetTuple(rowIndex)
                 if feretDiameterTuple is not None:
                     feretDiameter = feretDiameterTuple[0]
                     stats["feret_diameter_mm"] = feretDiameter
@@ -228,7 +266,7 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if perimeterArray is None:
                     logging.error("Could not calculate surface_area_mm2!")
                 else:
-                    perimeterTuple = perimeterArray.GetTuple(0)
+                    perimeterTuple = perimeterArray.GetTuple(rowIndex)
                 if perimeterTuple is not None:
                     perimeter = perimeterTuple[0]
                     stats["surface_area_mm2"] = perimeter
@@ -240,7 +278,7 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if obbOriginArray is None:
                     logging.error("Could not calculate obb_origin_ras!")
                 else:
-                    obbOriginTuple = obbOriginArray.GetTuple(0)
+                    obbOriginTuple = obbOriginArray.GetTuple(rowIndex)
                 if obbOriginTuple is not None:
                     transformSegmentToRas.TransformPoint(obbOriginTuple, obbOriginRAS)
                     stats["obb_origin_ras"] = obbOriginRAS
@@ -251,7 +289,7 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if obbDiameterArray is None:
                     logging.error("Could not calculate obb_diameter_mm!")
                 else:
-                    obbDiameterMMTuple = obbDiameterArray.GetTuple(0)
+                    obbDiameterMMTuple = obbDiameterArray.GetTuple(rowIndex)
                 if obbDiameterMMTuple is not None:
                     obbDiameterMM = list(obbDiameterMMTuple)
                     stats["obb_diameter_mm"] = obbDiameterMM
@@ -262,14 +300,14 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if obbOriginArray is None:
                     logging.error("Could not calculate obb_direction_ras_x!")
                 else:
-                    obbOriginTuple = obbOriginArray.GetTuple(0)
+                    obbOriginTuple = obbOriginArray.GetTuple(rowIndex)
 
                 obbDirectionXTuple = None
                 obbDirectionXArray = statTable.GetColumnByName(self.keyToShapeStatisticNames["obb_direction_ras_x"])
                 if obbDirectionXArray is None:
                     logging.error("Could not calculate obb_direction_ras_x!")
                 else:
-                    obbDirectionXTuple = obbDirectionXArray.GetTuple(0)
+                    obbDirectionXTuple = obbDirectionXArray.GetTuple(rowIndex)
 
                 if obbOriginTuple is not None and obbDirectionXTuple is not None:
                     obbDirectionX = list(obbDirectionXTuple)
@@ -282,14 +320,14 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if obbOriginArray is None:
                     logging.error("Could not calculate obb_direction_ras_y!")
                 else:
-                    obbOriginTuple = obbOriginArray.GetTuple(0)
+                    obbOriginTuple = obbOriginArray.GetTuple(rowIndex)
 
                 obbDirectionYTuple = None
                 obbDirectionYArray = statTable.GetColumnByName(self.keyToShapeStatisticNames["obb_direction_ras_y"])
                 if obbDirectionYArray is None:
                     logging.error("Could not calculate obb_direction_ras_y!")
                 else:
-                    obbDirectionYTuple = obbDirectionYArray.GetTuple(0)
+                    obbDirectionYTuple = obbDirectionYArray.GetTuple(rowIndex)
 
                 if obbOriginTuple is not None and obbDirectionYTuple is not None:
                     obbDirectionY = list(obbDirectionYTuple)
@@ -302,14 +340,14 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if obbOriginArray is None:
                     logging.error("Could not calculate obb_direction_ras_z!")
                 else:
-                    obbOriginTuple = obbOriginArray.GetTuple(0)
+                    obbOriginTuple = obbOriginArray.GetTuple(rowIndex)
 
                 obbDirectionZTuple = None
                 obbDirectionZArray = statTable.GetColumnByName(self.keyToShapeStatisticNames["obb_direction_ras_z"])
                 if obbDirectionZArray is None:
                     logging.error("Could not calculate obb_direction_ras_z!")
                 else:
-                    obbDirectionZTuple = obbDirectionZArray.GetTuple(0)
+                    obbDirectionZTuple = obbDirectionZArray.GetTuple(rowIndex)
 
                 if obbOriginTuple is not None and obbDirectionZTuple is not None:
                     obbDirectionZ = list(obbDirectionZTuple)
@@ -322,7 +360,7 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if principalMomentsArray is None:
                     logging.error("Could not calculate principal_moments!")
                 else:
-                    principalMomentsTuple = principalMomentsArray.GetTuple(0)
+                    principalMomentsTuple = principalMomentsArray.GetTuple(rowIndex)
                 if principalMomentsTuple is not None:
                     principalMoments = list(principalMomentsTuple)
                     stats["principal_moments"] = principalMoments
@@ -333,14 +371,14 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if centroidRASArray is None:
                     logging.error("Could not calculate principal_axis_x!")
                 else:
-                    centroidRASTuple = centroidRASArray.GetTuple(0)
+                    centroidRASTuple = centroidRASArray.GetTuple(rowIndex)
 
                 principalAxisXTuple = None
                 principalAxisXArray = statTable.GetColumnByName(self.keyToShapeStatisticNames["principal_axis_x"])
                 if principalAxisXArray is None:
                     logging.error("Could not calculate principal_axis_x!")
                 else:
-                    principalAxisXTuple = principalAxisXArray.GetTuple(0)
+                    principalAxisXTuple = principalAxisXArray.GetTuple(rowIndex)
 
                 if centroidRASTuple is not None and principalAxisXTuple is not None:
                     principalAxisX = list(principalAxisXTuple)
@@ -353,14 +391,14 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if centroidRASArray is None:
                     logging.error("Could not calculate principal_axis_y!")
                 else:
-                    centroidRASTuple = centroidRASArray.GetTuple(0)
+                    centroidRASTuple = centroidRASArray.GetTuple(rowIndex)
 
                 principalAxisYTuple = None
                 principalAxisYArray = statTable.GetColumnByName(self.keyToShapeStatisticNames["principal_axis_y"])
                 if principalAxisYArray is None:
                     logging.error("Could not calculate principal_axis_y!")
                 else:
-                    principalAxisYTuple = principalAxisYArray.GetTuple(0)
+                    principalAxisYTuple = principalAxisYArray.GetTuple(rowIndex)
 
                 if centroidRASTuple is not None and principalAxisYTuple is not None:
                     principalAxisY = list(principalAxisYTuple)
@@ -373,14 +411,14 @@ class LabelmapSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
                 if centroidRASArray is None:
                     logging.error("Could not calculate principal_axis_z!")
                 else:
-                    centroidRASTuple = centroidRASArray.GetTuple(0)
+                    centroidRASTuple = centroidRASArray.GetTuple(rowIndex)
 
                 principalAxisZTuple = None
                 principalAxisZArray = statTable.GetColumnByName(self.keyToShapeStatisticNames["principal_axis_z"])
                 if principalAxisZArray is None:
                     logging.error("Could not calculate principal_axis_z!")
                 else:
-                    principalAxisZTuple = principalAxisZArray.GetTuple(0)
+                    principalAxisZTuple = principalAxisZArray.GetTuple(rowIndex)
 
                 if centroidRASTuple is not None and principalAxisZTuple is not None:
                     principalAxisZ = list(principalAxisZTuple)
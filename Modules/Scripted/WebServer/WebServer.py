@@ -1,3 +1,5 @@
+import concurrent.futures
+import hashlib
 import logging
 import os
 import sys
@@ -263,9 +265,16 @@ class SlicerHTTPServer(HTTPServer):
     """
     This web server is configured to integrate with the Qt main loop
     by listenting activity on the fileno of the servers socket.
+
+    Image responses are sent with an ETag header. If the client sends the same
+    value in If-None-Match then "304 Not Modified" is returned without the image,
+    so polling clients only receive frames that have changed.
+
+    Request handlers run on the main thread, but they may return a concurrent.futures.Future
+    as response body. This allows computing the response of read-only requests
+    (from a snapshot of the data taken on the main thread) in a worker thread,
+    without blocking rendering and other clients. The response is sent when the future is done.
     """
-    # TODO: set header so client knows that image refreshes are needed (avoid
-    # using the &time=xxx trick)
     def __init__(self, server_address=("", 2016), requestHandlers=None, docroot='.', logMessage=None, certfile=None, enableCORS=False):
         """
         :param server_address: passed to parent class (default ("", 8070))
@@ -401,6 +410,11 @@ class SlicerHTTPServer(HTTPServer):
                 if requestLines == "":
                     self.logMessage("Assuming empty string is HTTP/1.1 GET of /.")
 
+                ifNoneMatch = None
+                for requestLine in requestLines[1:]:
+                    if requestLine.lower().startswith(b'if-none-match:'):
+                        ifNoneMatch = requestLine[len(b'if-none-match:'):].strip()
+
                 if version != b"HTTP/1.1":
                     self.logMessage("Warning, we don't speak %s", version)
                     return
@@ -425,42 +439,88 @@ class SlicerHTTPServer(HTTPServer):
                         highestConfidenceHandler = handler
                         highestConfidence = confidence
 
+                self.ifNoneMatch = ifNoneMatch
                 httpStatus = "200 OK"
                 if highestConfidenceHandler is not None and highestConfidence > 0.0:
                     try:
                         contentType, responseBody = highestConfidenceHandler.handleRequest(method, uri, requestBody)
                     except Exception as e:
-                        etype, value, tb = sys.exc_info()
-                        import traceback
-                        for frame in traceback.format_tb(tb):
-                            self.logMessage(frame)
-                        self.logMessage(etype, value)
-                        import json
-                        contentType = b'application/json'
-                        responseBody = json.dumps({"success": False, "message": "Server error: " + str(e)}).encode()
-                        httpStatus = "500 Internal Server Error"
+                        contentType, responseBody, httpStatus = self.serverErrorResponse(e)
                 else:
                     contentType = b'text/plain'
                     responseBody = b''
 
-                if responseBody:
-                    self.response = f"HTTP/1.1 {httpStatus}\r\n".encode()
-                    if self.enableCORS:
-                        self.response += b"Access-Control-Allow-Origin: *\r\n"
-                    self.response += b"Content-Type: %s\r\n" % contentType
-                    self.response += b"Content-Length: %d\r\n" % len(responseBody)
-                    self.response += b"Cache-Control: no-cache\r\n"
-                    self.response += b"\r\n"
-                    self.response += responseBody
-                else:
-                    self.response = b"HTTP/1.1 404 Not Found\r\n"
-                    self.response += b"\r\n"
-
-                self.toSend = len(self.response)
-                self.sentSoFar = 0
-                fileno = self.connectionSocket.fileno()
-                self.writeNotifier = qt.QSocketNotifier(fileno, qt.QSocketNotifier.Write)
-                self.writeNotifier.connect('activated(int)', self.onWritable)
+                if isinstance(responseBody, concurrent.futures.Future):
+                    # Response is computed in a worker thread, send it when it is ready
+                    self.pendingContentType = contentType
+                    self.pendingResponseBody = responseBody
+                    self.pendingResponseTimer = qt.QTimer()
+                    self.pendingResponseTimer.setInterval(10)
+                    self.pendingResponseTimer.connect('timeout()', self.onPendingResponseTimeout)
+                    self.pendingResponseTimer.start()
+                    return
+
+                self.sendResponse(httpStatus, contentType, responseBody)
+
+        def serverErrorResponse(self, e):
+            etype, value, tb = sys.exc_info()
+            import traceback
+            for frame in traceback.format_tb(tb):
+                self.logMessage(frame)
+            self.logMessage(etype, value)
+            import json
+            contentType = b'application/json'
+            responseBody = json.dumps({"success": False, "message": "Server error: " + str(e)}).encode()
+            return contentType, responseBody, "500 Internal Server Error"
+
+        def onPendingResponseTimeout(self):
+            if not self.pendingResponseBody.done():
+                return
+            self.pendingResponseTimer.stop()
+            self.pendingResponseTimer = None
+            httpStatus = "200 OK"
+            contentType = self.pendingContentType
+            try:
+                responseBody = self.pendingResponseBody.result()
+            except Exception as e:
+                contentType, responseBody, httpStatus = self.serverErrorResponse(e)
+            self.pendingContentType = None
+            self.pendingResponseBody = None
+            self.sendResponse(httpStatus, contentType, responseBody)
+
+        def sendResponse(self, httpStatus, contentType, responseBody):
+            entityTag = None
+            if responseBody and httpStatus == "200 OK" and contentType.startswith(b'image/'):
+                entityTag = b'"%s"' % hashlib.blake2b(responseBody, digest_size=16).hexdigest().encode()
+
+            if entityTag is not None and entityTag == self.ifNoneMatch:
+                # Frame has not changed since the client last received it
+                self.response = b"HTTP/1.1 304 Not Modified\r\n"
+                if self.enableCORS:
+                    self.response += b"Access-Control-Allow-Origin: *\r\n"
+                self.response += b"ETag: %s\r\n" % entityTag
+                self.response += b"Cache-Control: no-cache\r\n"
+                self.response += b"\r\n"
+            elif responseBody:
+                self.response = f"HTTP/1.1 {httpStatus}\r\n".encode()
+                if self.enableCORS:
+                    self.response += b"Access-Control-Allow-Origin: *\r\n"
+                self.response += b"Content-Type: %s\r\n" % contentType
+                self.response += b"Content-Length: %d\r\n" % len(responseBody)
+                if entityTag is not None:
+                    self.response += b"ETag: %s\r\n" % entityTag
+                self.response += b"Cache-Control: no-cache\r\n"
+                self.response += b"\r\n"
+                self.response += responseBody
+            else:
+                self.response = b"HTTP/1.1 404 Not Found\r\n"
+                self.response += b"\r\n"
+
+            self.toSend = len(self.response)
+            self.sentSoFar = 0
+            fileno = self.connectionSocket.fileno()
+            self.writeNotifier = qt.QSocketNotifier(fileno, qt.QSocketNotifier.Write)
+            self.writeNotifier.connect('activated(int)', self.onWritable)
 
         def onWriteableComplete(self):
             self.logMessage("writing complete, freeing notifier")
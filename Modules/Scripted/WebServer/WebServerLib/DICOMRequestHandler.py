@@ -1,3 +1,4 @@
+import concurrent.futures
 import logging
 import pydicom
 import urllib
@@ -19,6 +20,8 @@ class DICOMRequestHandler:
         self.retrieveURLTag = pydicom.tag.Tag(0x00080190)
         self.numberOfStudyRelatedSeriesTag = pydicom.tag.Tag(0x00200206)
         self.numberOfStudyRelatedInstancesTag = pydicom.tag.Tag(0x00200208)
+        # Files are read in background threads, only the database is accessed on the main thread
+        self.backgroundExecutor = concurrent.futures.ThreadPoolExecutor(max_workers=4)
 
     def logMessage(self, *args):
         logging.debug(args)
@@ -188,16 +191,13 @@ class DICOMRequestHandler:
             instanceUID = splitPath[7].decode()
             contentType = b'application/dicom'
             path = slicer.dicomDatabase.fileForInstance(instanceUID)
-            fp = open(path, 'rb')
-            responseBody = fp.read()
-            fp.close()
+            responseBody = self.backgroundExecutor.submit(self.readFile, path)
         elif len(splitPath) == 9 and splitPath[8] == b'metadata':  # .../instances/NNN/metadata
             self.logMessage('returning instance metadata')
             contentType = b'application/json'
             instanceUID = splitPath[7].decode()
-            dataset = pydicom.dcmread(slicer.dicomDatabase.fileForInstance(instanceUID), stop_before_pixels=True)
-            jsonDataset = dataset.to_json()
-            responseBody = b'[' + jsonDataset.encode() + b']'
+            path = slicer.dicomDatabase.fileForInstance(instanceUID)
+            responseBody = self.backgroundExecutor.submit(self.metadataFromFiles, [path])
         return contentType, responseBody
 
     def handleSeries(self, parsedURL, requestBody):
@@ -236,18 +236,33 @@ class DICOMRequestHandler:
         elif len(splitPath) == 7 and splitPath[6] == b'metadata':
             self.logMessage('returning series metadata')
             contentType = b'application/json'
-            responseBody = b"["
             seriesUID = splitPath[5].decode()
             seriesInstances = slicer.dicomDatabase.instancesForSeries(seriesUID)
-            for instance in seriesInstances:
-                dataset = pydicom.dcmread(slicer.dicomDatabase.fileForInstance(instance), stop_before_pixels=True)
-                jsonDataset = dataset.to_json()
-                responseBody += jsonDataset.encode() + b","
-            if responseBody.endswith(b','):
-                responseBody = responseBody[:-1]
-            responseBody += b']'
+            paths = [slicer.dicomDatabase.fileForInstance(instance) for instance in seriesInstances]
+            responseBody = self.backgroundExecutor.submit(self.metadataFromFiles, paths)
         return contentType, responseBody
 
+    @staticmethod
+    def readFile(path):
+        """Return content of a file. Safe to call from a background thread."""
+        with open(path, 'rb') as fp:
+            return fp.read()
+
+    @staticmethod
+    def metadataFromFiles(paths):
+        """Return DICOM JSON metadata of the files as a list.
+        Safe to call from a background thread, as it does not access the DICOM database.
+        """
+        responseBody = b"["
+        for path in paths:
+            dataset = pydicom.dcmread(path, stop_before_pixels=True)
+            jsonDataset = dataset.to_json()
+            responseBody += jsonDataset.encode() + b","
+        if responseBody.endswith(b','):
+            responseBody = responseBody[:-1]
+        responseBody += b']'
+        return responseBody
+
     def handleWADOURI(self, parsedURL, requestBody):
         """
         Handle wado uri by returning the binary part10 contents of the dicom file
@@ -262,7 +277,5 @@ class DICOMRequestHandler:
         self.logMessage('found uid %s' % instanceUID)
         contentType = b'application/dicom'
         path = slicer.dicomDatabase.fileForInstance(instanceUID)
-        fp = open(path, 'rb')
-        responseBody = fp.read()
-        fp.close()
+        responseBody = self.backgroundExecutor.submit(self.readFile, path)
         return contentType, responseBody
@@ -6,6 +6,8 @@ Docs/user_guide/modules/webserver.md
 """
 
 
+import concurrent.futures
+import gzip
 import json
 import logging
 import numpy
@@ -25,6 +27,8 @@ class SlicerRequestHandler:
     def __init__(self, enableExec=False):
         self.enableExec = enableExec
         self.sampleDataLogic = None  # used for progress reporting during download
+        # used for computing responses of read-only requests without blocking the main thread
+        self.backgroundExecutor = concurrent.futures.ThreadPoolExecutor(max_workers=4)
 
     def logMessage(self, *args):
         logging.debug(args)
@@ -291,11 +295,15 @@ class SlicerRequestHandler:
             volumeID = q['id'][0].strip()
         except KeyError:
             volumeID = 'vtkMRMLScalarVolumeNode*'
+        try:
+            compress = q['compress'][0].strip().lower() in ['1', 'true']
+        except KeyError:
+            compress = False
 
         if requestBody:
             return self.postNRRD(volumeID, requestBody)
         else:
-            return self.getNRRD(volumeID)
+            return self.getNRRD(volumeID, compress)
 
     def gridTransforms(self, request, requestBody):
         """
@@ -412,9 +420,11 @@ class SlicerRequestHandler:
 
         return b"{'status': 'success'}", b'application/json'
 
-    def getNRRD(self, volumeID):
+    def getNRRD(self, volumeID, compress=False):
         """Return a nrrd binary blob with contents of the volume node
         :param volumeID: must be a valid mrml id
+        :param compress: if True then voxels are gzip compressed (with fast compression level),
+          which reduces transfer time over slow networks
         """
         volumeNode = slicer.util.getNode(volumeID)
         volumeArray = slicer.util.array(volumeID)
@@ -474,12 +484,21 @@ sizes: %%sizes%%
 space directions: %%directions%%
 kinds: domain domain domain
 endian: little
-encoding: raw
+encoding: %%encoding%%
 space origin: %%origin%%
 
 """.replace("%%scalarType%%", scalarType).replace("%%sizes%%", sizes).replace("%%directions%%", directions).replace("%%origin%%", origin)
 
-        nrrdData = nrrdHeader.encode() + volumeArray.tobytes()
+        if compress:
+            # Compression is slow, therefore it is done in a background thread, on a copy of the voxels
+            # so that the volume may be modified in the scene meanwhile.
+            nrrdHeader = nrrdHeader.replace("%%encoding%%", "gzip")
+            voxels = volumeArray.tobytes()
+            nrrdData = self.backgroundExecutor.submit(
+                lambda: nrrdHeader.encode() + gzip.compress(voxels, compresslevel=1))
+        else:
+            nrrdHeader = nrrdHeader.replace("%%encoding%%", "raw")
+            nrrdData = nrrdHeader.encode() + volumeArray.tobytes()
         return nrrdData, b'application/octet-stream'
 
     def getTransformNRRD(self, transformID):
@@ -604,28 +623,27 @@ space origin: %%origin%%
         Handle requests with path: /accessDICOMwebStudy
         Access DICOMweb server to download requested study, add it to
         Slicer's dicom database, and load it into the scene.
+        Each series is loaded as soon as it is retrieved, while the rest of the study is still downloading.
         """
-        p = urllib.parse.urlparse(request.decode())
-        q = urllib.parse.parse_qs(p.query)
-
-        request = json.loads(requestBody), b'application/json'
+        request = json.loads(requestBody)
 
         dicomWebEndpoint = request['dicomWEBPrefix'] + '/' + request['dicomWEBStore']
         print(f"Loading from {dicomWebEndpoint}")
 
         from DICOMLib import DICOMUtils
+        loadedNodes = []
+
+        def loadSeries(seriesInstanceUID):
+            files = [slicer.dicomDatabase.fileForInstance(instance)
+                     for instance in slicer.dicomDatabase.instancesForSeries(seriesInstanceUID)]
+            loadablesByPlugin, loadEnabled = DICOMUtils.getLoadablesFromFileLists([files])
+            loadedNodes.extend(DICOMUtils.loadLoadables(loadablesByPlugin))
+
         loadedUIDs = DICOMUtils.importFromDICOMWeb(
-            dicomWebEndpoint=request['dicomWEBPrefix'] + '/' + request['dicomWEBStore'],
+            dicomWebEndpoint=dicomWebEndpoint,
             studyInstanceUID=request['studyUID'],
-            accessToken=request['accessToken'])
-
-        files = []
-        for studyUID in loadedUIDs:
-            for seriesUID in slicer.dicomDatabase.seriesForStudy(studyUID):
-                for instance in slicer.dicomDatabase.instancesForSeries(seriesUID):
-                    files.append(slicer.dicomDatabase.fileForInstance(instance))
-        loadables = DICOMUtils.getLoadablesFromFileLists([files])
-        loadedNodes = DICOMUtils.loadLoadables(loadLoadables)
+            accessToken=request.get('accessToken'),
+            seriesImportedCallback=loadSeries)
 
         print(f"Loaded {loadedUIDs}, and {loadedNodes}")
 
@@ -839,6 +857,7 @@ space origin: %%origin%%
             orientation = q['orientation'][0].strip()
         except (KeyError, ValueError):
             orientation = None
+        imageFormat, quality = self.getImageFormat(q)
 
         offsetKey = 'offset.' + view
         # if mode == 'start' or not self.interactionState.has_key(offsetKey):
@@ -878,11 +897,12 @@ space origin: %%origin%%
 
         imageData = sliceLogic.GetBlend().Update(0)
         imageData = sliceLogic.GetBlend().GetOutputDataObject(0)
-        pngData = []
+        imageFileData = []
+        contentType = b'image/png'
         if imageData:
-            pngData = self.vtkImageDataToPNG(imageData)
-        self.logMessage('returning an image of %d length' % len(pngData))
-        return pngData, b'image/png'
+            imageFileData, contentType = self.vtkImageDataToImageFile(imageData, imageFormat, quality)
+        self.logMessage('returning an image of %d length' % len(imageFileData))
+        return imageFileData, contentType
 
     def threeD(self, request):
         """
@@ -928,6 +948,7 @@ space origin: %%origin%%
             orbitY = float(q['orbitY'][0].strip())
         except (KeyError, ValueError):
             orbitY = None
+        imageFormat, quality = self.getImageFormat(q)
 
         layoutManager = slicer.app.layoutManager()
         view = layoutManager.threeDWidget(0).threeDView()
@@ -950,9 +971,9 @@ space origin: %%origin%%
         w2i.Update()
         imageData = w2i.GetOutput()
 
-        pngData = self.vtkImageDataToPNG(imageData)
-        self.logMessage('threeD returning an image of %d length' % len(pngData))
-        return pngData, b'image/png'
+        imageFileData, contentType = self.vtkImageDataToImageFile(imageData, imageFormat, quality)
+        self.logMessage('threeD returning an image of %d length' % len(imageFileData))
+        return imageFileData, contentType
 
     def timeimage(self, request=''):
         """
@@ -968,6 +989,7 @@ space origin: %%origin%%
             color = "#" + q['color'][0].strip().lower()
         except KeyError:
             color = "#330"
+        imageFormat, quality = self.getImageFormat(q)
 
         #
         # make a generally transparent image,
@@ -999,11 +1021,60 @@ space origin: %%origin%%
         painter.drawText(position, text)
         painter.end()
 
-        # convert the image to vtk, then to png from there
+        # convert the image to vtk, then to the requested file format from there
         vtkTimeImage = vtk.vtkImageData()
         slicer.qMRMLUtils().qImageToVtkImageData(timeImage, vtkTimeImage)
-        pngData = self.vtkImageDataToPNG(vtkTimeImage)
-        return pngData, b'image/png'
+        return self.vtkImageDataToImageFile(vtkTimeImage, imageFormat, quality)
+
+    @staticmethod
+    def getImageFormat(q):
+        """Get image file format and quality from the `format` and `quality` query parameters.
+        :param q: parsed query parameters
+        :return: tuple of file format (`png` or `jpeg`) and quality (0-100, only used for jpeg)
+        """
+        try:
+            imageFormat = q['format'][0].strip().lower()
+        except KeyError:
+            imageFormat = 'png'
+        if imageFormat == 'jpg':
+            imageFormat = 'jpeg'
+        if imageFormat not in ['png', 'jpeg']:
+            raise RuntimeError(f"Unsupported image format: {imageFormat} (must be png or jpeg)")
+        try:
+            quality = int(q['quality'][0].strip())
+        except (KeyError, ValueError):
+            quality = 85
+        return imageFormat, quality
+
+    def vtkImageDataToImageFile(self, imageData, imageFormat='png', quality=85):
+        """Return a buffer of image file data using the data
+        from the vtkImageData.
+        JPEG images are many times smaller than PNG images of rendered views,
+        therefore they are preferable for remote viewing over slow networks.
+        :param imageData: a vtkImageData instance
+        :param imageFormat: `png` or `jpeg`
+        :param quality: jpeg quality (0-100)
+        :return: tuple of bytes of the image file and content type
+        """
+        if imageFormat == 'png':
+            return self.vtkImageDataToPNG(imageData), b'image/png'
+
+        if imageData.GetNumberOfScalarComponents() == 4:
+            # jpeg does not support transparency, remove the alpha channel
+            extractComponents = vtk.vtkImageExtractComponents()
+            extractComponents.SetInputData(imageData)
+            extractComponents.SetComponents(0, 1, 2)
+            extractComponents.Update()
+            imageData = extractComponents.GetOutput()
+        writer = vtk.vtkJPEGWriter()
+        writer.SetWriteToMemory(True)
+        writer.SetInputData(imageData)
+        writer.SetQuality(max(0, min(100, quality)))
+        writer.Write()
+        result = writer.GetResult()
+        jpegData = vtk.util.numpy_support.vtk_to_numpy(result).tobytes()
+
+        return jpegData, b'image/jpeg'
 
     def vtkImageDataToPNG(self, imageData):
         """Return a buffer of png data using the data